@@ -21,6 +21,19 @@ module ao_peripheral_subsystem
     input  logic        execute_from_flash_i,
     output logic        exit_valid_o,
     output logic [31:0] exit_value_o,
+    output logic        icache_enable_o,
+    output logic        icache_prefetch_o,
+    output logic        icache_flush_o,
+    input  logic        icache_hit_i,
+    input  logic        icache_miss_i,
+    output logic        dcache_enable_o,
+    output logic        dcache_clean_o,
+    output logic        dcache_invalidate_o,
+    input  logic        dcache_busy_i,
+    input  logic        dcache_hit_i,
+    input  logic        dcache_miss_i,
+    output logic        bus_cpu_prio_o,
+    output logic [ 7:0] bus_dma_throttle_o,
 
     // Memory Map SPI Region
     input  obi_req_t  spimemio_req_i,
@@ -78,12 +91,12 @@ module ao_peripheral_subsystem
     output logic rv_timer_1_intr_o,
 
     // DMA
-    output obi_req_t  dma_read_ch0_req_o,
-    input  obi_resp_t dma_read_ch0_resp_i,
-    output obi_req_t  dma_write_ch0_req_o,
-    input  obi_resp_t dma_write_ch0_resp_i,
-    output obi_req_t  dma_addr_ch0_req_o,
-    input  obi_resp_t dma_addr_ch0_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_resp_i,
     output logic      dma_done_intr_o,
     output logic      dma_window_intr_o,
 
@@ -94,12 +107,16 @@ module ao_peripheral_subsystem
     // FAST INTR CTRL
     input  logic [14:0] fast_intr_i,
     output logic [14:0] fast_intr_o,
+    input  logic        irq_ack_i,
+    input  logic [ 4:0] irq_id_i,
 
     // GPIO
     input  logic [7:0] cio_gpio_i,
     output logic [7:0] cio_gpio_o,
     output logic [7:0] cio_gpio_en_o,
     output logic [7:0] intr_gpio_o,
+    // GPIOs of the peripheral domain, for the strobe trigger of the DMA
+    input  logic [31:8] dma_gpio_i,
 
     // UART
     input  logic uart_rx_i,
@@ -115,11 +132,26 @@ module ao_peripheral_subsystem
 
     // I2s
     input logic i2s_rx_valid_i,
+    input logic i2s_tx_ready_i,
+
+    // PDM2PCM
+    input logic pdm2pcm_rx_valid_i,
+
+    // I2C
+    input logic i2c_rx_valid_i,
+    input logic i2c_fmt_ready_i,
+
+    // CRC
+    input logic crc_ready_i,
 
     // EXTERNAL PERIPH
     output reg_req_t ext_peripheral_slave_req_o,
     input  reg_rsp_t ext_peripheral_slave_resp_i,
 
+    // BUS MONITOR, in the system bus
+    output reg_req_t bus_monitor_reg_req_o,
+    input  reg_rsp_t bus_monitor_reg_rsp_i,
+
     input logic ext_dma_slot_tx_i,
     input logic ext_dma_slot_rx_i
 );
@@ -160,6 +192,9 @@ module ao_peripheral_subsystem
   assign ext_peripheral_slave_req_o = ao_peripheral_slv_req[core_v_mini_mcu_pkg::EXT_PERIPHERAL_IDX];
   assign ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::EXT_PERIPHERAL_IDX] = ext_peripheral_slave_resp_i;
 
+  assign bus_monitor_reg_req_o = ao_peripheral_slv_req[core_v_mini_mcu_pkg::BUS_MONITOR_IDX];
+  assign ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::BUS_MONITOR_IDX] = bus_monitor_reg_rsp_i;
+
 `ifdef REMOVE_OBI_FIFO
 
   assign slave_fifo_req_sel = slave_req_i;
@@ -252,7 +287,20 @@ module ao_peripheral_subsystem
       .execute_from_flash_i,
       .use_spimemio_o(use_spimemio),
       .exit_valid_o,
-      .exit_value_o
+      .exit_value_o,
+      .icache_enable_o,
+      .icache_prefetch_o,
+      .icache_flush_o,
+      .icache_hit_i,
+      .icache_miss_i,
+      .dcache_enable_o,
+      .dcache_clean_o,
+      .dcache_invalidate_o,
+      .dcache_busy_i,
+      .dcache_hit_i,
+      .dcache_miss_i,
+      .bus_cpu_prio_o,
+      .bus_dma_throttle_o
   );
 
   boot_rom boot_rom_i (
@@ -260,7 +308,11 @@ module ao_peripheral_subsystem
       .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::BOOTROM_IDX])
   );
 
-  spi_subsystem spi_subsystem_i (
+  spi_subsystem #(
+      .CACHE_WAYS(core_v_mini_mcu_pkg::FLASH_CACHE_WAYS),
+      .CACHE_SETS(core_v_mini_mcu_pkg::FLASH_CACHE_SETS),
+      .CACHE_LINE_WORDS(core_v_mini_mcu_pkg::FLASH_CACHE_LINE_WORDS)
+  ) spi_subsystem_i (
       .clk_i,
       .rst_ni,
       .use_spimemio_i(use_spimemio),
@@ -367,7 +419,10 @@ module ao_peripheral_subsystem
       .intr_timer_expired_1_0_o(rv_timer_1_intr_o)
   );
 
-  parameter DMA_TRIGGER_SLOT_NUM = 7;
+  logic uart_rx_valid;
+  logic uart_tx_ready;
+
+  parameter DMA_TRIGGER_SLOT_NUM = 14;
   logic [DMA_TRIGGER_SLOT_NUM-1:0] dma_trigger_slots;
   assign dma_trigger_slots[0] = spi_rx_valid;
   assign dma_trigger_slots[1] = spi_tx_ready;
@@ -376,29 +431,97 @@ module ao_peripheral_subsystem
   assign dma_trigger_slots[4] = i2s_rx_valid_i;
   assign dma_trigger_slots[5] = ext_dma_slot_tx_i;
   assign dma_trigger_slots[6] = ext_dma_slot_rx_i;
+  assign dma_trigger_slots[7] = pdm2pcm_rx_valid_i;
+  assign dma_trigger_slots[8] = uart_rx_valid;
+  assign dma_trigger_slots[9] = uart_tx_ready;
+  assign dma_trigger_slots[10] = i2c_rx_valid_i;
+  assign dma_trigger_slots[11] = i2c_fmt_ready_i;
+  assign dma_trigger_slots[12] = crc_ready_i;
+  assign dma_trigger_slots[13] = i2s_tx_ready_i;
+
+  // Levels of all the GPIOs for the strobe trigger of the channels, in the
+  // clock domain of the DMA, which stays on when the peripherals are gated
+  logic [31:0] dma_gpio, dma_gpio_sync;
+  assign dma_gpio = {dma_gpio_i, cio_gpio_i};
+  for (genvar i = 0; i < 32; i++) begin : gen_dma_gpio_sync
+    sync #(
+        .STAGES(2)
+    ) dma_gpio_sync_i (
+        .clk_i,
+        .rst_ni,
+        .serial_i(dma_gpio[i]),
+        .serial_o(dma_gpio_sync[i])
+    );
+  end
+
+  // Each DMA channel has DMA_CH_SIZE bytes of registers in the DMA region and
+  // its own masters on the system bus. All the channels see every trigger slot
+  // and share the transaction done (fast) and window done (PLIC) interrupts.
+  reg_pkg::reg_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_ch_req;
+  reg_pkg::reg_rsp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_ch_rsp;
+  logic [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_ch_done_intr;
+  logic [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_ch_window_intr;
+  logic [core_v_mini_mcu_pkg::DMA_CH_PORT_SEL_WIDTH-1:0] dma_ch_select;
 
-  dma #(
-      .reg_req_t (reg_pkg::reg_req_t),
-      .reg_rsp_t (reg_pkg::reg_rsp_t),
-      .obi_req_t (obi_pkg::obi_req_t),
-      .obi_resp_t(obi_pkg::obi_resp_t),
-      .SLOT_NUM  (DMA_TRIGGER_SLOT_NUM)
-  ) dma_i (
+  addr_decode #(
+      .NoIndices(core_v_mini_mcu_pkg::DMA_CH_NUM),
+      .NoRules(core_v_mini_mcu_pkg::DMA_CH_NUM),
+      .addr_t(logic [31:0]),
+      .rule_t(addr_map_rule_pkg::addr_map_rule_t)
+  ) i_addr_decode_dma_ch (
+      .addr_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::DMA_IDX].addr),
+      .addr_map_i(core_v_mini_mcu_pkg::DMA_CH_ADDR_RULES),
+      .idx_o(dma_ch_select),
+      .dec_valid_o(),
+      .dec_error_o(),
+      .en_default_idx_i(1'b1),
+      .default_idx_i('0)
+  );
+
+  reg_demux #(
+      .NoPorts(core_v_mini_mcu_pkg::DMA_CH_NUM),
+      .req_t  (reg_pkg::reg_req_t),
+      .rsp_t  (reg_pkg::reg_rsp_t)
+  ) reg_demux_dma_ch_i (
       .clk_i,
       .rst_ni,
-      .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::DMA_IDX]),
-      .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::DMA_IDX]),
-      .dma_read_ch0_req_o,
-      .dma_read_ch0_resp_i,
-      .dma_write_ch0_req_o,
-      .dma_write_ch0_resp_i,
-      .dma_addr_ch0_req_o,
-      .dma_addr_ch0_resp_i,
-      .trigger_slot_i(dma_trigger_slots),
-      .dma_done_intr_o(dma_done_intr_o),
-      .dma_window_intr_o(dma_window_intr_o)
+      .in_select_i(dma_ch_select),
+      .in_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::DMA_IDX]),
+      .in_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::DMA_IDX]),
+      .out_req_o(dma_ch_req),
+      .out_rsp_i(dma_ch_rsp)
   );
 
+  for (genvar ch = 0; ch < core_v_mini_mcu_pkg::DMA_CH_NUM; ch++) begin : gen_dma_ch
+    dma #(
+        .reg_req_t (reg_pkg::reg_req_t),
+        .reg_rsp_t (reg_pkg::reg_rsp_t),
+        .obi_req_t (obi_pkg::obi_req_t),
+        .obi_resp_t(obi_pkg::obi_resp_t),
+        .FIFO_DEPTH(core_v_mini_mcu_pkg::DMA_FIFO_DEPTH),
+        .MAX_OUTSTANDING(core_v_mini_mcu_pkg::DMA_MAX_OUTSTANDING),
+        .SLOT_NUM  (DMA_TRIGGER_SLOT_NUM)
+    ) dma_i (
+        .clk_i,
+        .rst_ni,
+        .reg_req_i(dma_ch_req[ch]),
+        .reg_rsp_o(dma_ch_rsp[ch]),
+        .dma_read_ch0_req_o(dma_read_req_o[ch]),
+        .dma_read_ch0_resp_i(dma_read_resp_i[ch]),
+        .dma_write_ch0_req_o(dma_write_req_o[ch]),
+        .dma_write_ch0_resp_i(dma_write_resp_i[ch]),
+        .dma_addr_ch0_req_o(dma_addr_req_o[ch]),
+        .dma_addr_ch0_resp_i(dma_addr_resp_i[ch]),
+        .trigger_slot_i(dma_trigger_slots),
+        .gpio_i(dma_gpio_sync),
+        .dma_done_intr_o(dma_ch_done_intr[ch]),
+        .dma_window_intr_o(dma_ch_window_intr[ch])
+    );
+  end
+
+  assign dma_done_intr_o   = |dma_ch_done_intr;
+  assign dma_window_intr_o = |dma_ch_window_intr;
+
   assign pad_req_o = ao_peripheral_slv_req[core_v_mini_mcu_pkg::PAD_CONTROL_IDX];
   assign ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::PAD_CONTROL_IDX] = pad_resp_i;
 
@@ -411,7 +534,45 @@ module ao_peripheral_subsystem
       .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::FAST_INTR_CTRL_IDX]),
       .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::FAST_INTR_CTRL_IDX]),
       .fast_intr_i,
-      .fast_intr_o
+      .fast_intr_o,
+      .irq_ack_i,
+      .irq_id_i
+  );
+
+  atomics #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t)
+  ) atomics_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::ATOMICS_IDX]),
+      .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::ATOMICS_IDX])
+  );
+
+  // Power domains: 0 the core (on when awake), 1 the CPU subsystem, 2 the
+  // peripheral subsystem, 3 + b the memory bank b
+  event_trace #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .DEPTH(core_v_mini_mcu_pkg::EVENT_TRACE_DEPTH),
+      .DMA_CH_NUM(core_v_mini_mcu_pkg::DMA_CH_NUM),
+      .NUM_DOMAINS(3 + core_v_mini_mcu_pkg::NUM_BANKS)
+  ) event_trace_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::EVENT_TRACE_IDX]),
+      .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::EVENT_TRACE_IDX]),
+      .intr_i,
+      .irq_ack_i,
+      .irq_id_i,
+      .dma_done_i(dma_ch_done_intr),
+      .dma_window_i(dma_ch_window_intr),
+      .power_on_i({
+        memory_subsystem_banks_powergate_switch_no,
+        peripheral_subsystem_powergate_switch_no,
+        cpu_subsystem_powergate_switch_no,
+        ~core_sleep_i
+      })
   );
 
   gpio #(
@@ -462,7 +623,9 @@ module ao_peripheral_subsystem
       .intr_rx_frame_err_o(uart_intr_rx_frame_err_o),
       .intr_rx_break_err_o(uart_intr_rx_break_err_o),
       .intr_rx_timeout_o(uart_intr_rx_timeout_o),
-      .intr_rx_parity_err_o(uart_intr_rx_parity_err_o)
+      .intr_rx_parity_err_o(uart_intr_rx_parity_err_o),
+      .rx_valid_o(uart_rx_valid),
+      .tx_ready_o(uart_tx_ready)
   );
 
 endmodule : ao_peripheral_subsystem
@@ -44,12 +44,12 @@ ${pad.core_v_mini_mcu_interface}
     input  obi_resp_t ext_core_data_resp_i,
     output obi_req_t  ext_debug_master_req_o,
     input  obi_resp_t ext_debug_master_resp_i,
-    output obi_req_t  ext_dma_read_ch0_req_o,
-    input  obi_resp_t ext_dma_read_ch0_resp_i,
-    output obi_req_t  ext_dma_write_ch0_req_o,
-    input  obi_resp_t ext_dma_write_ch0_resp_i,
-    output obi_req_t  ext_dma_addr_ch0_req_o,
-    input  obi_resp_t ext_dma_addr_ch0_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_resp_i,
 
     output reg_req_t ext_peripheral_slave_req_o,
     input  reg_rsp_t ext_peripheral_slave_resp_i,
@@ -83,7 +83,7 @@ ${pad.core_v_mini_mcu_interface}
 
   localparam JTAG_IDCODE = 32'h10001c05;
   localparam BOOT_ADDR = core_v_mini_mcu_pkg::BOOTROM_START_ADDRESS;
-  localparam NUM_MHPMCOUNTERS = 1;
+  localparam NUM_MHPMCOUNTERS = core_v_mini_mcu_pkg::NUM_MHPMCOUNTERS;
 
   // Log top level parameter values
 `ifndef SYNTHESIS
@@ -95,16 +95,22 @@ ${pad.core_v_mini_mcu_interface}
   // masters signals
   obi_req_t core_instr_req;
   obi_resp_t core_instr_resp;
+  obi_req_t bus_instr_req;
+  obi_resp_t bus_instr_resp;
   obi_req_t core_data_req;
   obi_resp_t core_data_resp;
+  obi_req_t cache_data_req;
+  obi_resp_t cache_data_resp;
+  obi_req_t bus_data_req;
+  obi_resp_t bus_data_resp;
   obi_req_t debug_master_req;
   obi_resp_t debug_master_resp;
-  obi_req_t dma_read_ch0_req;
-  obi_resp_t dma_read_ch0_resp;
-  obi_req_t dma_write_ch0_req;
-  obi_resp_t dma_write_ch0_resp;
-  obi_req_t dma_addr_ch0_req;
-  obi_resp_t dma_addr_ch0_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_resp;
 
   // ram signals
   obi_req_t [core_v_mini_mcu_pkg::NUM_BANKS-1:0] ram_slave_req;
@@ -120,11 +126,40 @@ ${pad.core_v_mini_mcu_interface}
   obi_req_t peripheral_slave_req;
   obi_resp_t peripheral_slave_resp;
 
-  // signals to debug unit
-  logic debug_core_req;
+  // bus monitor registers
+  reg_pkg::reg_req_t bus_monitor_reg_req;
+  reg_pkg::reg_rsp_t bus_monitor_reg_rsp;
+
+  // signals to debug unit, one per hart
+  logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] debug_core_req;
+
+  // instruction cache
+  logic icache_enable;
+  logic icache_prefetch;
+  logic icache_flush;
+  logic icache_hit;
+  logic icache_miss;
+
+  // data cache
+  logic dcache_enable;
+  logic dcache_clean;
+  logic dcache_invalidate;
+  logic dcache_busy;
+  logic dcache_hit;
+  logic dcache_miss;
+
+  // arbitration of the system bus
+  logic bus_cpu_prio;
+  logic [7:0] bus_dma_throttle;
 
   // core
   logic core_sleep;
+  logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] hart_sleep;
+
+  // mailbox of the harts
+  logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] hart_fetch_enable;
+  logic [31:0] hart_boot_addr;
+  logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] mailbox_intr;
 
   // irq signals
   logic irq_ack;
@@ -186,9 +221,20 @@ ${pad.core_v_mini_mcu_interface}
 
   // I2s
   logic i2s_rx_valid;
+  logic i2s_tx_ready;
+
+  // PDM2PCM
+  logic pdm2pcm_rx_valid;
+
+  // I2C
+  logic i2c_rx_valid;
+  logic i2c_fmt_ready;
+
+  // CRC
+  logic crc_ready;
 
   assign intr = {
-    1'b0, irq_fast, 4'b0, irq_external, 3'b0, rv_timer_intr[0], 3'b0, irq_software, 3'b0
+    1'b0, irq_fast, 4'b0, irq_external, 3'b0, rv_timer_intr[0], 3'b0, irq_software | mailbox_intr[0], 3'b0
   };
 
   assign fast_intr = {
@@ -203,7 +249,6 @@ ${pad.core_v_mini_mcu_interface}
   };
 
   cpu_subsystem #(
-      .BOOT_ADDR(BOOT_ADDR),
       .COREV_PULP(COREV_PULP),
       .FPU(FPU),
       .ZFINX(ZFINX),
@@ -214,6 +259,8 @@ ${pad.core_v_mini_mcu_interface}
       // Clock and Reset
       .clk_i,
       .rst_ni(cpu_subsystem_rst_n),
+      .fetch_enable_i(1'b1),
+      .boot_addr_i(BOOT_ADDR),
       .core_instr_req_o(core_instr_req),
       .core_instr_resp_i(core_instr_resp),
       .core_data_req_o(core_data_req),
@@ -227,12 +274,168 @@ ${pad.core_v_mini_mcu_interface}
       .irq_i(intr),
       .irq_ack_o(irq_ack),
       .irq_id_o(irq_id_out),
-      .debug_req_i(debug_core_req),
-      .core_sleep_o(core_sleep)
+      .debug_req_i(debug_core_req[0]),
+      .core_sleep_o(hart_sleep[0])
+  );
+
+  // The power manager sees the cores asleep when all the enabled ones are
+  assign core_sleep = &(hart_sleep | ~hart_fetch_enable);
+% if cpu_num > 1:
+
+  // Secondary harts, started by hart 0 through the mailbox. They have no
+  // caches nor access to the external slaves, and their only interrupt is
+  // the one of the mailbox, as machine software interrupt.
+  obi_req_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_instr_req;
+  obi_resp_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_instr_resp;
+  obi_req_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_data_req;
+  obi_resp_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_data_resp;
+
+  for (genvar i = 1; i < core_v_mini_mcu_pkg::NUM_CORES; i++) begin : gen_hart
+
+    if_xif hart_xif ();
+
+    cpu_subsystem #(
+        .HART_ID(i),
+        .COREV_PULP(COREV_PULP),
+        .FPU(0),
+        .ZFINX(0),
+        .NUM_MHPMCOUNTERS(NUM_MHPMCOUNTERS),
+        .DM_HALTADDRESS(DM_HALTADDRESS),
+        .X_EXT(0)
+    ) cpu_subsystem_i (
+        .clk_i,
+        .rst_ni(cpu_subsystem_rst_n),
+        .fetch_enable_i(hart_fetch_enable[i]),
+        .boot_addr_i(hart_boot_addr),
+        .core_instr_req_o(hart_instr_req[i]),
+        .core_instr_resp_i(hart_instr_resp[i]),
+        .core_data_req_o(hart_data_req[i]),
+        .core_data_resp_i(hart_data_resp[i]),
+        .xif_compressed_if(hart_xif),
+        .xif_issue_if(hart_xif),
+        .xif_commit_if(hart_xif),
+        .xif_mem_if(hart_xif),
+        .xif_mem_result_if(hart_xif),
+        .xif_result_if(hart_xif),
+        .irq_i({28'b0, mailbox_intr[i], 3'b0}),
+        .irq_ack_o(),
+        .irq_id_o(),
+        .debug_req_i(debug_core_req[i]),
+        .core_sleep_o(hart_sleep[i])
+    );
+  end
+% endif
+% if spi_slave:
+
+  // SPI slave of an external host, on the spi_slave options of the spi2 pad
+  // muxes (selected at reset). Its accesses reach the internal slaves only.
+  obi_req_t spi_slave_req;
+  obi_resp_t spi_slave_resp;
+
+  obi_spi_slave obi_spi_slave_i (
+      .clk_i,
+      .rst_ni,
+      .spi_sck_i(spi_slave_sck_i),
+      .spi_cs_i(spi_slave_cs_i),
+      .spi_sd_i({spi_slave_sd_3_i, spi_slave_sd_2_i, spi_slave_sd_1_i, spi_slave_sd_0_i}),
+      .spi_sd_o({spi_slave_sd_3_o, spi_slave_sd_2_o, spi_slave_sd_1_o, spi_slave_sd_0_o}),
+      .spi_sd_oe_o({spi_slave_sd_3_oe_o, spi_slave_sd_2_oe_o, spi_slave_sd_1_oe_o, spi_slave_sd_0_oe_o}),
+      .obi_req_o(spi_slave_req),
+      .obi_resp_i(spi_slave_resp)
   );
+% else:
+
+  // No SPI slave (spi_slave in mcu_cfg.hjson), its pad mux options are unused
+  assign {spi_slave_sd_3_o, spi_slave_sd_2_o, spi_slave_sd_1_o, spi_slave_sd_0_o} = '0;
+  assign {spi_slave_sd_3_oe_o, spi_slave_sd_2_oe_o, spi_slave_sd_1_oe_o, spi_slave_sd_0_oe_o} = '0;
+% endif
+
+  // Only the RAM and the flash are cached
+  if (core_v_mini_mcu_pkg::ICACHE_WAYS > 0) begin : gen_icache
+    obi_icache #(
+        .WAYS(core_v_mini_mcu_pkg::ICACHE_WAYS),
+        .SETS(core_v_mini_mcu_pkg::ICACHE_SETS),
+        .LINE_WORDS(core_v_mini_mcu_pkg::ICACHE_LINE_WORDS),
+        .NUM_REGIONS(2),
+        .REGION_START({
+          core_v_mini_mcu_pkg::FLASH_MEM_START_ADDRESS, core_v_mini_mcu_pkg::RAM0_START_ADDRESS
+        }),
+        .REGION_END({
+          core_v_mini_mcu_pkg::FLASH_MEM_END_ADDRESS,
+          core_v_mini_mcu_pkg::RAM0_START_ADDRESS + core_v_mini_mcu_pkg::MEM_SIZE
+        })
+    ) obi_icache_i (
+        .clk_i,
+        .rst_ni,
+        .core_instr_req_i(core_instr_req),
+        .core_instr_resp_o(core_instr_resp),
+        .bus_instr_req_o(bus_instr_req),
+        .bus_instr_resp_i(bus_instr_resp),
+        .enable_i(icache_enable),
+        .prefetch_i(icache_prefetch),
+        .flush_i(icache_flush | debug_core_req[0]),
+        .hit_o(icache_hit),
+        .miss_o(icache_miss)
+    );
+  end else begin : gen_no_icache
+    assign bus_instr_req = core_instr_req;
+    assign core_instr_resp = bus_instr_resp;
+    assign icache_hit = 1'b0;
+    assign icache_miss = 1'b0;
+  end
+
+  // Private scratchpad of the core, in front of the data cache
+  if (core_v_mini_mcu_pkg::TCM_SIZE > 0) begin : gen_tcm
+    obi_tcm #(
+        .START(core_v_mini_mcu_pkg::TCM_START_ADDRESS),
+        .SIZE (core_v_mini_mcu_pkg::TCM_SIZE)
+    ) obi_tcm_i (
+        .clk_i,
+        .rst_ni,
+        .core_data_req_i(core_data_req),
+        .core_data_resp_o(core_data_resp),
+        .bus_data_req_o(cache_data_req),
+        .bus_data_resp_i(cache_data_resp)
+    );
+  end else begin : gen_no_tcm
+    assign cache_data_req = core_data_req;
+    assign core_data_resp = cache_data_resp;
+  end
+
+  // Only the external memory region of mcu_cfg.hjson is cached
+  if (core_v_mini_mcu_pkg::DCACHE_WAYS > 0) begin : gen_dcache
+    obi_dcache #(
+        .WAYS(core_v_mini_mcu_pkg::DCACHE_WAYS),
+        .SETS(core_v_mini_mcu_pkg::DCACHE_SETS),
+        .LINE_WORDS(core_v_mini_mcu_pkg::DCACHE_LINE_WORDS),
+        .NUM_REGIONS(1),
+        .REGION_START(core_v_mini_mcu_pkg::DCACHE_START_ADDRESS),
+        .REGION_END(core_v_mini_mcu_pkg::DCACHE_END_ADDRESS)
+    ) obi_dcache_i (
+        .clk_i,
+        .rst_ni,
+        .core_data_req_i(cache_data_req),
+        .core_data_resp_o(cache_data_resp),
+        .bus_data_req_o(bus_data_req),
+        .bus_data_resp_i(bus_data_resp),
+        .enable_i(dcache_enable),
+        .clean_i(dcache_clean),
+        .invalidate_i(dcache_invalidate),
+        .busy_o(dcache_busy),
+        .hit_o(dcache_hit),
+        .miss_o(dcache_miss)
+    );
+  end else begin : gen_no_dcache
+    assign bus_data_req = cache_data_req;
+    assign cache_data_resp = bus_data_resp;
+    assign dcache_busy = 1'b0;
+    assign dcache_hit = 1'b0;
+    assign dcache_miss = 1'b0;
+  end
 
   debug_subsystem #(
-      .JTAG_IDCODE(JTAG_IDCODE)
+      .JTAG_IDCODE(JTAG_IDCODE),
+      .NUM_HARTS(core_v_mini_mcu_pkg::NUM_CORES)
   ) debug_subsystem_i (
       .clk_i,
       .rst_ni,
@@ -254,18 +457,28 @@ ${pad.core_v_mini_mcu_interface}
   ) system_bus_i (
       .clk_i,
       .rst_ni,
-      .core_instr_req_i(core_instr_req),
-      .core_instr_resp_o(core_instr_resp),
-      .core_data_req_i(core_data_req),
-      .core_data_resp_o(core_data_resp),
+      .core_instr_req_i(bus_instr_req),
+      .core_instr_resp_o(bus_instr_resp),
+      .core_data_req_i(bus_data_req),
+      .core_data_resp_o(bus_data_resp),
       .debug_master_req_i(debug_master_req),
       .debug_master_resp_o(debug_master_resp),
-      .dma_read_ch0_req_i(dma_read_ch0_req),
-      .dma_read_ch0_resp_o(dma_read_ch0_resp),
-      .dma_write_ch0_req_i(dma_write_ch0_req),
-      .dma_write_ch0_resp_o(dma_write_ch0_resp),
-      .dma_addr_ch0_req_i(dma_addr_ch0_req),
-      .dma_addr_ch0_resp_o(dma_addr_ch0_resp),
+      .dma_read_req_i(dma_read_req),
+      .dma_read_resp_o(dma_read_resp),
+      .dma_write_req_i(dma_write_req),
+      .dma_write_resp_o(dma_write_resp),
+      .dma_addr_req_i(dma_addr_req),
+      .dma_addr_resp_o(dma_addr_resp),
+% if cpu_num > 1:
+      .hart_instr_req_i(hart_instr_req),
+      .hart_instr_resp_o(hart_instr_resp),
+      .hart_data_req_i(hart_data_req),
+      .hart_data_resp_o(hart_data_resp),
+% endif
+% if spi_slave:
+      .spi_slave_req_i(spi_slave_req),
+      .spi_slave_resp_o(spi_slave_resp),
+% endif
       .ext_xbar_master_req_i(ext_xbar_master_req_i),
       .ext_xbar_master_resp_o(ext_xbar_master_resp_o),
       .ram_req_o(ram_slave_req),
@@ -284,12 +497,16 @@ ${pad.core_v_mini_mcu_interface}
       .ext_core_data_resp_i(ext_core_data_resp_i),
       .ext_debug_master_req_o(ext_debug_master_req_o),
       .ext_debug_master_resp_i(ext_debug_master_resp_i),
-      .ext_dma_read_ch0_req_o(ext_dma_read_ch0_req_o),
-      .ext_dma_read_ch0_resp_i(ext_dma_read_ch0_resp_i),
-      .ext_dma_write_ch0_req_o(ext_dma_write_ch0_req_o),
-      .ext_dma_write_ch0_resp_i(ext_dma_write_ch0_resp_i),
-      .ext_dma_addr_ch0_req_o(ext_dma_addr_ch0_req_o),
-      .ext_dma_addr_ch0_resp_i(ext_dma_addr_ch0_resp_i)
+      .ext_dma_read_req_o(ext_dma_read_req_o),
+      .ext_dma_read_resp_i(ext_dma_read_resp_i),
+      .ext_dma_write_req_o(ext_dma_write_req_o),
+      .ext_dma_write_resp_i(ext_dma_write_resp_i),
+      .ext_dma_addr_req_o(ext_dma_addr_req_o),
+      .ext_dma_addr_resp_i(ext_dma_addr_resp_i),
+      .bus_monitor_reg_req_i(bus_monitor_reg_req),
+      .bus_monitor_reg_rsp_o(bus_monitor_reg_rsp),
+      .cpu_prio_i(bus_cpu_prio),
+      .dma_throttle_i(bus_dma_throttle)
   );
 
   memory_subsystem #(
@@ -312,6 +529,19 @@ ${pad.core_v_mini_mcu_interface}
       .execute_from_flash_i,
       .exit_valid_o,
       .exit_value_o,
+      .icache_enable_o(icache_enable),
+      .icache_prefetch_o(icache_prefetch),
+      .icache_flush_o(icache_flush),
+      .icache_hit_i(icache_hit),
+      .icache_miss_i(icache_miss),
+      .dcache_enable_o(dcache_enable),
+      .dcache_clean_o(dcache_clean),
+      .dcache_invalidate_o(dcache_invalidate),
+      .dcache_busy_i(dcache_busy),
+      .dcache_hit_i(dcache_hit),
+      .dcache_miss_i(dcache_miss),
+      .bus_cpu_prio_o(bus_cpu_prio),
+      .bus_dma_throttle_o(bus_dma_throttle),
       .spimemio_req_i(flash_mem_slave_req),
       .spimemio_resp_o(flash_mem_slave_resp),
       .spi_flash_sck_o,
@@ -353,12 +583,12 @@ ${pad.core_v_mini_mcu_interface}
       .external_subsystem_clkgate_en_no,
       .rv_timer_0_intr_o(rv_timer_intr[0]),
       .rv_timer_1_intr_o(rv_timer_intr[1]),
-      .dma_read_ch0_req_o(dma_read_ch0_req),
-      .dma_read_ch0_resp_i(dma_read_ch0_resp),
-      .dma_write_ch0_req_o(dma_write_ch0_req),
-      .dma_write_ch0_resp_i(dma_write_ch0_resp),
-      .dma_addr_ch0_req_o(dma_addr_ch0_req),
-      .dma_addr_ch0_resp_i(dma_addr_ch0_resp),
+      .dma_read_req_o(dma_read_req),
+      .dma_read_resp_i(dma_read_resp),
+      .dma_write_req_o(dma_write_req),
+      .dma_write_resp_i(dma_write_resp),
+      .dma_addr_req_o(dma_addr_req),
+      .dma_addr_resp_i(dma_addr_resp),
       .dma_done_intr_o(dma_done_intr),
       .dma_window_intr_o(dma_window_intr),
       .spi_intr_event_o(spi_intr),
@@ -367,10 +597,13 @@ ${pad.core_v_mini_mcu_interface}
       .pad_resp_i,
       .fast_intr_i(fast_intr),
       .fast_intr_o(irq_fast),
+      .irq_ack_i(irq_ack),
+      .irq_id_i(irq_id_out),
       .cio_gpio_i(gpio_ao_in),
       .cio_gpio_o(gpio_ao_out),
       .cio_gpio_en_o(gpio_ao_oe),
       .intr_gpio_o(gpio_ao_intr),
+      .dma_gpio_i(gpio_in),
       .uart_rx_i,
       .uart_tx_o,
       .uart_intr_tx_watermark_o(uart_intr_tx_watermark),
@@ -382,8 +615,15 @@ ${pad.core_v_mini_mcu_interface}
       .uart_intr_rx_timeout_o(uart_intr_rx_timeout),
       .uart_intr_rx_parity_err_o(uart_intr_rx_parity_err),
       .i2s_rx_valid_i(i2s_rx_valid),
+      .i2s_tx_ready_i(i2s_tx_ready),
+      .pdm2pcm_rx_valid_i(pdm2pcm_rx_valid),
+      .i2c_rx_valid_i(i2c_rx_valid),
+      .i2c_fmt_ready_i(i2c_fmt_ready),
+      .crc_ready_i(crc_ready),
       .ext_peripheral_slave_req_o,
       .ext_peripheral_slave_resp_i,
+      .bus_monitor_reg_req_o(bus_monitor_reg_req),
+      .bus_monitor_reg_rsp_i(bus_monitor_reg_rsp),
       .ext_dma_slot_tx_i,
       .ext_dma_slot_rx_i
   );
@@ -427,6 +667,13 @@ ${pad.core_v_mini_mcu_interface}
       .pdm2pcm_clk_o(pdm2pcm_clk_o),
       .pdm2pcm_clk_en_o(pdm2pcm_clk_oe_o),
       .pdm2pcm_pdm_i(pdm2pcm_pdm_i),
+      .pdm2pcm_rx_valid_o(pdm2pcm_rx_valid),
+      .i2c_rx_valid_o(i2c_rx_valid),
+      .i2c_fmt_ready_o(i2c_fmt_ready),
+      .crc_ready_o(crc_ready),
+      .hart_fetch_enable_o(hart_fetch_enable),
+      .hart_boot_addr_o(hart_boot_addr),
+      .mailbox_intr_o(mailbox_intr),
       .i2s_sck_o(i2s_sck_o),
       .i2s_sck_oe_o(i2s_sck_oe_o),
       .i2s_sck_i(i2s_sck_i),
@@ -436,7 +683,9 @@ ${pad.core_v_mini_mcu_interface}
       .i2s_sd_o(i2s_sd_o),
       .i2s_sd_oe_o(i2s_sd_oe_o),
       .i2s_sd_i(i2s_sd_i),
-      .i2s_rx_valid_o(i2s_rx_valid)
+      .i2s_sdo_o(i2s_sdo_o),
+      .i2s_rx_valid_o(i2s_rx_valid),
+      .i2s_tx_ready_o(i2s_tx_ready)
   );
 
   assign pdm2pcm_pdm_o = 0;
@@ -5,7 +5,8 @@
 module debug_subsystem
   import obi_pkg::*;
 #(
-    parameter JTAG_IDCODE = 32'h10001c05
+    parameter JTAG_IDCODE = 32'h10001c05,
+    parameter int unsigned NUM_HARTS = 1
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -16,7 +17,7 @@ module debug_subsystem
     input  logic jtag_tdi_i,
     output logic jtag_tdo_o,
 
-    output logic debug_core_req_o,
+    output logic [NUM_HARTS-1:0] debug_core_req_o,
 
     input  obi_req_t  debug_slave_req_i,
     output obi_resp_t debug_slave_resp_o,
@@ -44,6 +45,7 @@ module debug_subsystem
   logic          dmi_resp_valid;
 
 
+`ifndef TB_DMI_DPI
   dmi_jtag #(
       .IdcodeValue(JTAG_IDCODE)
   ) dmi_jtag_i (
@@ -64,16 +66,38 @@ module debug_subsystem
       .td_o            (jtag_tdo_o),
       .tdo_oe_o        ()
   );
+`else
+  // OpenOCD drives the DMI from the Verilator testbench (tb/dmi_dpi.sv)
+  dmi_dpi #(
+      .IdcodeValue(JTAG_IDCODE)
+  ) dmi_jtag_i (
+      .clk_i           (clk_i),
+      .rst_ni          (rst_ni),
+      .dmi_req_o       (dmi_req),
+      .dmi_req_valid_o (dmi_req_valid),
+      .dmi_req_ready_i (dmi_req_ready),
+      .dmi_resp_i      (dmi_resp),
+      .dmi_resp_ready_o(dmi_resp_ready),
+      .dmi_resp_valid_i(dmi_resp_valid)
+  );
+
+  assign jtag_tdo_o = 1'b0;
+`endif
 
-  dm_obi_top dm_obi_top_i (
+  // The system bus access (master port) uses 32-bit accesses with address
+  // autoincrement, used by OpenOCD for the bulk memory accesses (set_prefer_sba)
+  dm_obi_top #(
+      .NrHarts (NUM_HARTS),
+      .BusWidth(32)
+  ) dm_obi_top_i (
       .clk_i        (clk_i),
       .rst_ni       (rst_ni),
       .testmode_i   (1'b0),
       .ndmreset_o   (),
       .dmactive_o   (),
       .debug_req_o  (debug_core_req_o),
-      .unavailable_i(~(1'b01)),
-      .hartinfo_i   (hartinfo),
+      .unavailable_i('0),
+      .hartinfo_i   ({NUM_HARTS{hartinfo}}),
 
       .slave_req_i   (debug_slave_req_i.req),
       .slave_gnt_o   (debug_slave_resp_o.gnt),
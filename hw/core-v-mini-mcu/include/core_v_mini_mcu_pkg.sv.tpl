@@ -26,6 +26,9 @@ package core_v_mini_mcu_pkg;
 
   localparam cpu_type_e CpuType = ${cpu_type};
 
+  // Event counters of each core (hpm_events of mcu_cfg.hjson), from mhpmcounter3
+  localparam int unsigned NUM_MHPMCOUNTERS = ${num_mhpmcounters};
+
   typedef enum logic {
     NtoM,
     onetoM
@@ -33,19 +36,47 @@ package core_v_mini_mcu_pkg;
 
   localparam bus_type_e BusType = ${bus_type};
 
+  // Transactions in flight on the bus before their rvalid, 1 with NtoM
+  localparam int unsigned BUS_MAX_OUTSTANDING = ${bus_max_outstanding};
+
   //master idx
   localparam logic [31:0] CORE_INSTR_IDX = 0;
   localparam logic [31:0] CORE_DATA_IDX = 1;
   localparam logic [31:0] DEBUG_MASTER_IDX = 2;
-  localparam logic [31:0] DMA_READ_CH0_IDX = 3;
-  localparam logic [31:0] DMA_WRITE_CH0_IDX = 4;
-  localparam logic [31:0] DMA_ADDR_CH0_IDX = 5;
+% for ch in range(dma_ch_count):
+  localparam logic [31:0] DMA_READ_CH${ch}_IDX = ${3 + 3*ch};
+  localparam logic [31:0] DMA_WRITE_CH${ch}_IDX = ${4 + 3*ch};
+  localparam logic [31:0] DMA_ADDR_CH${ch}_IDX = ${5 + 3*ch};
+% endfor
 
-  localparam SYSTEM_XBAR_NMASTER = 6;
+  // DMA channels, each one with a read, a write and an address master
+  localparam int unsigned DMA_CH_NUM = ${dma_ch_count};
+  localparam int unsigned DMA_CH_MASTER_PORTS = 3;
+  localparam int unsigned DMA_FIFO_DEPTH = ${dma_fifo_depth};
+  localparam int unsigned DMA_MAX_OUTSTANDING = ${dma_max_outstanding};
+
+  // Cores sharing the system crossbar: hart 0 has the caches, the debug
+  // master and the external ports, the secondary harts are masters of the
+  // internal slaves only, after those forwarded to the external crossbar
+  localparam int unsigned NUM_CORES = ${cpu_num};
+% for c in range(1, cpu_num):
+  localparam logic [31:0] CORE${c}_INSTR_IDX = ${3 + 3*dma_ch_count + 2*(c-1)};
+  localparam logic [31:0] CORE${c}_DATA_IDX = ${4 + 3*dma_ch_count + 2*(c-1)};
+% endfor
+% if spi_slave:
+
+  // SPI slave of the spi2 pads (hw/ip/obi_spi_slave), a master of the internal
+  // slaves only, after the secondary harts
+  localparam logic [31:0] SPI_SLAVE_IDX = ${3 + 3*dma_ch_count + 2*(cpu_num-1)};
+% endif
+
+  // Masters with a 1-to-2 demux to the external crossbar
+  localparam SYSTEM_XBAR_NMASTER_DEMUX = ${3 + 3*dma_ch_count};
+  localparam SYSTEM_XBAR_NMASTER = ${3 + 3*dma_ch_count + 2*(cpu_num-1) + (1 if spi_slave else 0)};
 
   // Internal slave memory map and index
   // -----------------------------------
-  //must be power of two
+  //sum of the sizes of the banks
   localparam int unsigned MEM_SIZE = 32'h${ram_size_address};
 
   localparam SYSTEM_XBAR_NSLAVE = ${int(ram_numbanks) + 5};
@@ -63,14 +94,14 @@ package core_v_mini_mcu_pkg;
   localparam logic[31:0] ERROR_IDX = 32'd0;
 
 % for bank in range(ram_numbanks_cont):
-  localparam logic [31:0] RAM${bank}_START_ADDRESS = 32'h${'{:08X}'.format(int(ram_start_address) + bank*32*1024)};
-  localparam logic [31:0] RAM${bank}_SIZE = 32'h${hex(32*1024)[2:]};
+  localparam logic [31:0] RAM${bank}_START_ADDRESS = 32'h${'{:08X}'.format(ram_banks[bank][0])};
+  localparam logic [31:0] RAM${bank}_SIZE = 32'h${'{:08X}'.format(ram_banks[bank][1])};
   localparam logic [31:0] RAM${bank}_END_ADDRESS = RAM${bank}_START_ADDRESS + RAM${bank}_SIZE;
   localparam logic [31:0] RAM${bank}_IDX = 32'd${bank + 1};
 % endfor
 % if ram_numbanks_il != 0:
-  localparam logic [31:0] RAM${ram_numbanks_cont}_START_ADDRESS = 32'h${'{:08X}'.format(int(ram_start_address) + int(ram_numbanks_cont)*32*1024)};
-  localparam logic [31:0] RAM${ram_numbanks_cont}_SIZE = 32'h${hex(int(ram_numbanks_il)*32*1024)[2:]};
+  localparam logic [31:0] RAM${ram_numbanks_cont}_START_ADDRESS = 32'h${'{:08X}'.format(ram_il_start)};
+  localparam logic [31:0] RAM${ram_numbanks_cont}_SIZE = 32'h${'{:08X}'.format(ram_il_size)};
   localparam logic [31:0] RAM${ram_numbanks_cont}_END_ADDRESS = RAM${ram_numbanks_cont}_START_ADDRESS + RAM${ram_numbanks_cont}_SIZE;
   localparam logic [31:0] RAM${ram_numbanks_cont}_IDX = 32'd${ram_numbanks_cont + 1};
 % for bank in range(ram_numbanks_il - 1):
@@ -98,6 +129,29 @@ package core_v_mini_mcu_pkg;
   localparam logic[31:0] FLASH_MEM_END_ADDRESS = FLASH_MEM_START_ADDRESS + FLASH_MEM_SIZE;
   localparam logic[31:0] FLASH_MEM_IDX = 32'd${int(ram_numbanks) + 4};
 
+  // Read cache of the flash in front of obi_spimemio, no cache if 0 ways
+  localparam int unsigned FLASH_CACHE_WAYS = ${flash_cache_ways};
+  localparam int unsigned FLASH_CACHE_SETS = ${flash_cache_sets};
+  localparam int unsigned FLASH_CACHE_LINE_WORDS = ${flash_cache_line_words};
+
+  // Instruction cache of the core, no cache if 0 ways
+  localparam int unsigned ICACHE_WAYS = ${icache_ways};
+  localparam int unsigned ICACHE_SETS = ${icache_sets};
+  localparam int unsigned ICACHE_LINE_WORDS = ${icache_line_words};
+
+  // Write-back data cache of the core for a region of the external memory, no cache if 0 ways
+  localparam int unsigned DCACHE_WAYS = ${dcache_ways};
+  localparam int unsigned DCACHE_SETS = ${dcache_sets};
+  localparam int unsigned DCACHE_LINE_WORDS = ${dcache_line_words};
+  localparam logic [31:0] DCACHE_START_ADDRESS = 32'h${dcache_start_address};
+  localparam logic [31:0] DCACHE_SIZE = 32'h${dcache_size_address};
+  localparam logic [31:0] DCACHE_END_ADDRESS = DCACHE_START_ADDRESS + DCACHE_SIZE;
+
+  // Scratchpad private to the data port of the core, none if 0 bytes
+  localparam logic [31:0] TCM_START_ADDRESS = 32'h${tcm_start_address};
+  localparam logic [31:0] TCM_SIZE = 32'h${tcm_size_address};
+  localparam logic [31:0] TCM_END_ADDRESS = TCM_START_ADDRESS + TCM_SIZE;
+
   localparam addr_map_rule_t [SYSTEM_XBAR_NSLAVE-1:0] XBAR_ADDR_RULES = '{
       '{ idx: ERROR_IDX, start_addr: ERROR_START_ADDRESS, end_addr: ERROR_END_ADDRESS },
 % for bank in range(ram_numbanks_cont):
@@ -118,6 +172,30 @@ package core_v_mini_mcu_pkg;
   localparam logic [31:0] EXT_SLAVE_SIZE = 32'h${ext_slave_size_address};
   localparam logic [31:0] EXT_SLAVE_END_ADDRESS = EXT_SLAVE_START_ADDRESS + EXT_SLAVE_SIZE;
 
+  // Slaves of the external crossbar, in the external slave region, with
+  // their latency class (1 if slow) and whether they may be cached
+  localparam int unsigned EXT_NSLAVE = ${len(ext_slaves)};
+% for name, slave in ext_slaves.items():
+  localparam logic [31:0] ${name.upper()}_START_ADDRESS = EXT_SLAVE_START_ADDRESS + 32'h${slave['offset']};
+  localparam logic [31:0] ${name.upper()}_SIZE = 32'h${slave['length']};
+  localparam logic [31:0] ${name.upper()}_END_ADDRESS = ${name.upper()}_START_ADDRESS + ${name.upper()}_SIZE;
+  localparam logic [31:0] ${name.upper()}_IDX = 32'd${loop.index};
+  localparam bit ${name.upper()}_SLOW = 1'b${int(slave['slow'])};
+  localparam bit ${name.upper()}_CACHEABLE = 1'b${int(slave['cacheable'])};
+% endfor
+
+  localparam addr_map_rule_t [EXT_NSLAVE-1:0] EXT_SLAVE_ADDR_RULES = '{
+% for name in ext_slaves:
+      '{ idx: ${name.upper()}_IDX, start_addr: ${name.upper()}_START_ADDRESS, end_addr: ${name.upper()}_END_ADDRESS }${"," if not loop.last else ""}
+% endfor
+  };
+
+  // Masters of the external crossbar with a slave port on the system bus
+  localparam int unsigned EXT_NMASTER = ${len(ext_masters)};
+% for name in ext_masters:
+  localparam logic [31:0] EXT_MASTER_${name.upper()}_IDX = 32'd${loop.index};
+% endfor
+
   // Forward crossbars address map and index
   // ---------------------------------------
   // These crossbar connect each muster to the internal crossbar and to the
@@ -156,8 +234,24 @@ package core_v_mini_mcu_pkg;
 % endfor
   };
 
+  // Counters of the bus monitor
+  localparam bit BUS_MONITOR_COUNTERS = 1'b${1 if bus_monitor_counters else 0};
+
+  // Entries of the ring of the event trace unit
+  localparam int unsigned EVENT_TRACE_DEPTH = ${event_trace_depth};
+
   localparam int unsigned AO_PERIPHERALS_PORT_SEL_WIDTH = AO_PERIPHERALS > 1 ? $clog2(AO_PERIPHERALS) : 32'd1;
 
+  // Register space of each DMA channel in the DMA region
+  localparam logic [31:0] DMA_CH_SIZE = 32'h${dma_ch_size};
+  localparam addr_map_rule_t [DMA_CH_NUM-1:0] DMA_CH_ADDR_RULES = '{
+% for ch in range(dma_ch_count):
+      '{ idx: 32'd${ch}, start_addr: DMA_START_ADDRESS + ${ch} * DMA_CH_SIZE, end_addr: DMA_START_ADDRESS + ${ch + 1} * DMA_CH_SIZE }${"," if not loop.last else ""}
+% endfor
+  };
+
+  localparam int unsigned DMA_CH_PORT_SEL_WIDTH = DMA_CH_NUM > 1 ? $clog2(DMA_CH_NUM) : 32'd1;
+
 ######################################################################
 ## Automatically add all peripherals listed
 ######################################################################
@@ -180,6 +274,9 @@ package core_v_mini_mcu_pkg;
 
   localparam int unsigned PERIPHERALS_PORT_SEL_WIDTH = PERIPHERALS > 1 ? $clog2(PERIPHERALS) : 32'd1;
 
+  // Bytes processed per cycle by the CRC engine
+  localparam int unsigned CRC_BYTES_PER_CYCLE = ${crc_bytes_per_cycle};
+
   // Interrupts
   // ----------
   localparam PLIC_NINT = ${plit_n_interrupts};
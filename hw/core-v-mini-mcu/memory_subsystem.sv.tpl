@@ -22,33 +22,37 @@ module memory_subsystem
     input logic [core_v_mini_mcu_pkg::NUM_BANKS-1:0] set_retentive_ni
 );
 
-  localparam int NumWords = 32 * 1024 / 4;
-  localparam int AddrWidth = $clog2(32 * 1024);
+  // Bytes and first address of each bank (mcu_cfg.hjson), the interleaved
+  // banks share the addresses of their region
+  localparam int unsigned BankSize[NUM_BANKS] = '{${", ".join("32'h%08X" % size for start, size in ram_banks)}};
+  localparam logic [31:0] BankStart[NUM_BANKS] = '{${", ".join("32'h%08X" % start for start, size in ram_banks)}};
 % if ram_numbanks_il != 0:
-  localparam int ilAddrWidth = $clog2(${ram_numbanks_il} * 32 * 1024);
+  localparam int ilAddrWidth = $clog2(${ram_il_size});
 % endif
 
   logic [NUM_BANKS-1:0] ram_valid_q;
   // Clock-gating
   logic [NUM_BANKS-1:0] clk_cg;
+
+  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_sram
+
+    localparam int AddrWidth = $clog2(BankSize[i]);
+
+    logic [31:0] ram_req_offset;
+    logic [AddrWidth-3:0] ram_req_addr;
+
+    // The banks need not be aligned to their size
+    assign ram_req_offset = ram_req_i[i].addr - BankStart[i];
 % if ram_numbanks_il != 0:
-  logic [NUM_BANKS-1:0][AddrWidth-3:0] ram_req_addr;
-
-  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_addr_napot
-    if (i >= NUM_BANKS - ${ram_numbanks_il}) begin
-      assign ram_req_addr[i] = {
-        ram_req_i[i].addr[ilAddrWidth-1:AddrWidth] -
-        core_v_mini_mcu_pkg::RAM${ram_numbanks_cont}_START_ADDRESS[ilAddrWidth-1:AddrWidth],
-        ram_req_i[i].addr[AddrWidth-1:${2+log_ram_numbanks_il}]
-      };
-    end else begin
-      assign ram_req_addr[i] = ram_req_i[i].addr[AddrWidth-1:2];
+    if (i >= NUM_BANKS - ${ram_numbanks_il}) begin : gen_addr_il
+      assign ram_req_addr = ram_req_offset[ilAddrWidth-1:${2+log_ram_numbanks_il}];
+    end else begin : gen_addr_cont
+      assign ram_req_addr = ram_req_offset[AddrWidth-1:2];
     end
-  end
+% else:
+    assign ram_req_addr = ram_req_offset[AddrWidth-1:2];
 % endif
 
-  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_sram
-
     tc_clk_gating clk_gating_cell_i (
         .clk_i,
         .en_i(clk_gate_en_ni[i]),
@@ -67,20 +71,15 @@ module memory_subsystem
     assign ram_resp_o[i].gnt = ram_req_i[i].req;
     assign ram_resp_o[i].rvalid = ram_valid_q[i];
 
-    //Fixed to 8KWords per bank (32KB)
     sram_wrapper #(
-        .NumWords (NumWords),
+        .NumWords (BankSize[i] / 4),
         .DataWidth(32'd32)
     ) ram_i (
         .clk_i(clk_cg[i]),
         .rst_ni(rst_ni),
         .req_i(ram_req_i[i].req),
         .we_i(ram_req_i[i].we),
-% if ram_numbanks_il == 0:
-        .addr_i(ram_req_i[i].addr[AddrWidth-1:2]),
-% else:
-        .addr_i(ram_req_addr[i]),
-% endif
+        .addr_i(ram_req_addr),
         .wdata_i(ram_req_i[i].wdata),
         .be_i(ram_req_i[i].be),
         .set_retentive_ni(set_retentive_ni[i]),
@@ -72,12 +72,27 @@ module peripheral_subsystem
     output logic i2s_sd_o,
     output logic i2s_sd_oe_o,
     input  logic i2s_sd_i,
+    output logic i2s_sdo_o,
     output logic i2s_rx_valid_o,
+    output logic i2s_tx_ready_o,
 
     // PDM2PCM Interface
     output logic pdm2pcm_clk_o,
     output logic pdm2pcm_clk_en_o,
-    input  logic pdm2pcm_pdm_i
+    input  logic pdm2pcm_pdm_i,
+    output logic pdm2pcm_rx_valid_o,
+
+    // I2C DMA triggers
+    output logic i2c_rx_valid_o,
+    output logic i2c_fmt_ready_o,
+
+    // CRC DMA trigger
+    output logic crc_ready_o,
+
+    // Mailbox of the harts
+    output logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] hart_fetch_enable_o,
+    output logic [                              31:0] hart_boot_addr_o,
+    output logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] mailbox_intr_o
 );
 
   import core_v_mini_mcu_pkg::*;
@@ -127,6 +142,7 @@ module peripheral_subsystem
   logic i2c_intr_host_timeout;
   logic spi2_intr_event;
   logic i2s_intr_event;
+  logic pdm2pcm_intr_event;
 
   // this avoids lint errors
   assign unused_irq_id = irq_id;
@@ -161,6 +177,7 @@ module peripheral_subsystem
   assign intr_vector[49] = spi2_intr_event;
   assign intr_vector[50] = i2s_intr_event;
   assign intr_vector[51] = dma_window_intr_i;
+  assign intr_vector[52] = pdm2pcm_intr_event;
 
   // External interrupts assignement
   for (genvar i = 0; i < NEXT_INT; i++) begin
@@ -351,7 +368,9 @@ module peripheral_subsystem
       .intr_tx_overflow_o(i2c_intr_tx_overflow),
       .intr_acq_overflow_o(i2c_intr_acq_overflow),
       .intr_ack_stop_o(i2c_intr_ack_stop),
-      .intr_host_timeout_o(i2c_intr_host_timeout)
+      .intr_host_timeout_o(i2c_intr_host_timeout),
+      .rx_valid_o(i2c_rx_valid_o),
+      .fmt_ready_o(i2c_fmt_ready_o)
   );
 
   reg_to_tlul #(
@@ -407,6 +426,8 @@ module peripheral_subsystem
 
   assign peripheral_slv_rsp[core_v_mini_mcu_pkg::PDM2PCM_IDX] = '0;
   assign pdm2pcm_clk_o = '0;
+  assign pdm2pcm_intr_event = 1'b0;
+  assign pdm2pcm_rx_valid_o = 1'b0;
 
   assign pdm2pcm_clk_en_o = 1;
 
@@ -428,8 +449,27 @@ module peripheral_subsystem
       .i2s_sd_o(i2s_sd_o),
       .i2s_sd_oe_o(i2s_sd_oe_o),
       .i2s_sd_i(i2s_sd_i),
+      .i2s_sdo_o(i2s_sdo_o),
       .intr_i2s_event_o(i2s_intr_event),
-      .i2s_rx_valid_o(i2s_rx_valid_o)
+      .i2s_rx_valid_o(i2s_rx_valid_o),
+      .i2s_tx_ready_o(i2s_tx_ready_o)
   );
 
+  crc #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .BytesPerCycle(core_v_mini_mcu_pkg::CRC_BYTES_PER_CYCLE)
+  ) crc_i (
+      .clk_i(clk_cg),
+      .rst_ni,
+      .reg_req_i(peripheral_slv_req[core_v_mini_mcu_pkg::CRC_IDX]),
+      .reg_rsp_o(peripheral_slv_rsp[core_v_mini_mcu_pkg::CRC_IDX]),
+      .ready_o(crc_ready_o)
+  );
+
+  assign peripheral_slv_rsp[core_v_mini_mcu_pkg::MAILBOX_IDX] = '0;
+  assign hart_fetch_enable_o = 1;
+  assign hart_boot_addr_o = '0;
+  assign mailbox_intr_o = '0;
+
 endmodule : peripheral_subsystem
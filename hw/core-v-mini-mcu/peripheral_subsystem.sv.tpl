@@ -72,12 +72,27 @@ module peripheral_subsystem
     output logic i2s_sd_o,
     output logic i2s_sd_oe_o,
     input  logic i2s_sd_i,
+    output logic i2s_sdo_o,
     output logic i2s_rx_valid_o,
+    output logic i2s_tx_ready_o,
 
     // PDM2PCM Interface
     output logic pdm2pcm_clk_o,
     output logic pdm2pcm_clk_en_o,
-    input  logic pdm2pcm_pdm_i
+    input  logic pdm2pcm_pdm_i,
+    output logic pdm2pcm_rx_valid_o,
+
+    // I2C DMA triggers
+    output logic i2c_rx_valid_o,
+    output logic i2c_fmt_ready_o,
+
+    // CRC DMA trigger
+    output logic crc_ready_o,
+
+    // Mailbox of the harts
+    output logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] hart_fetch_enable_o,
+    output logic [                              31:0] hart_boot_addr_o,
+    output logic [core_v_mini_mcu_pkg::NUM_CORES-1:0] mailbox_intr_o
 );
 
   import core_v_mini_mcu_pkg::*;
@@ -127,6 +142,7 @@ module peripheral_subsystem
   logic i2c_intr_host_timeout;
   logic spi2_intr_event;
   logic i2s_intr_event;
+  logic pdm2pcm_intr_event;
 
   // this avoids lint errors
   assign unused_irq_id = irq_id;
@@ -161,6 +177,7 @@ module peripheral_subsystem
   assign intr_vector[${interrupts["spi2_intr_event"]}] = spi2_intr_event;
   assign intr_vector[${interrupts["i2s_intr_event"]}] = i2s_intr_event;
   assign intr_vector[${interrupts["dma_window_intr"]}]  = dma_window_intr_i;
+  assign intr_vector[${interrupts["pdm2pcm_intr_event"]}] = pdm2pcm_intr_event;
 
   // External interrupts assignement
   for (genvar i = 0; i < NEXT_INT; i++) begin
@@ -380,7 +397,9 @@ module peripheral_subsystem
       .intr_tx_overflow_o(i2c_intr_tx_overflow),
       .intr_acq_overflow_o(i2c_intr_acq_overflow),
       .intr_ack_stop_o(i2c_intr_ack_stop),
-      .intr_host_timeout_o(i2c_intr_host_timeout)
+      .intr_host_timeout_o(i2c_intr_host_timeout),
+      .rx_valid_o(i2c_rx_valid_o),
+      .fmt_ready_o(i2c_fmt_ready_o)
   );
 % else:
   assign i2c_tl_d2h = '0;
@@ -404,6 +423,8 @@ module peripheral_subsystem
   assign i2c_intr_acq_overflow = '0;
   assign i2c_intr_ack_stop = '0;
   assign i2c_intr_host_timeout = '0;
+  assign i2c_rx_valid_o = 1'b0;
+  assign i2c_fmt_ready_o = 1'b0;
 % endif
 % endif
 % endfor
@@ -496,11 +517,15 @@ module peripheral_subsystem
       .reg_req_i(peripheral_slv_req[core_v_mini_mcu_pkg::PDM2PCM_IDX]),
       .reg_rsp_o(peripheral_slv_rsp[core_v_mini_mcu_pkg::PDM2PCM_IDX]),
       .pdm_i(pdm2pcm_pdm_i),
-      .pdm_clk_o(pdm2pcm_clk_o)
+      .pdm_clk_o(pdm2pcm_clk_o),
+      .intr_pdm2pcm_event_o(pdm2pcm_intr_event),
+      .pdm2pcm_rx_valid_o(pdm2pcm_rx_valid_o)
   );
 % else:
   assign peripheral_slv_rsp[core_v_mini_mcu_pkg::PDM2PCM_IDX] = '0;
   assign pdm2pcm_clk_o = '0;
+  assign pdm2pcm_intr_event = 1'b0;
+  assign pdm2pcm_rx_valid_o = 1'b0;
 % endif
 % endif
 % endfor
@@ -528,8 +553,10 @@ module peripheral_subsystem
       .i2s_sd_o(i2s_sd_o),
       .i2s_sd_oe_o(i2s_sd_oe_o),
       .i2s_sd_i(i2s_sd_i),
+      .i2s_sdo_o(i2s_sdo_o),
       .intr_i2s_event_o(i2s_intr_event),
-      .i2s_rx_valid_o(i2s_rx_valid_o)
+      .i2s_rx_valid_o(i2s_rx_valid_o),
+      .i2s_tx_ready_o(i2s_tx_ready_o)
   );
 % else:
   assign peripheral_slv_rsp[core_v_mini_mcu_pkg::I2S_IDX] = '0;
@@ -540,8 +567,56 @@ module peripheral_subsystem
   assign i2s_ws_o         = 1'b0;
   assign i2s_sd_oe_o      = 1'b0;
   assign i2s_sd_o         = 1'b0;
+  assign i2s_sdo_o        = 1'b0;
   assign i2s_intr_event   = 1'b0;
   assign i2s_rx_valid_o   = 1'b0;
+  assign i2s_tx_ready_o   = 1'b0;
+% endif
+% endif
+% endfor
+
+% for peripheral in peripherals.items():
+% if peripheral[0] in ("crc"):
+% if peripheral[1]['is_included'] in ("yes"):
+  crc #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .BytesPerCycle(core_v_mini_mcu_pkg::CRC_BYTES_PER_CYCLE)
+  ) crc_i (
+      .clk_i(clk_cg),
+      .rst_ni,
+      .reg_req_i(peripheral_slv_req[core_v_mini_mcu_pkg::CRC_IDX]),
+      .reg_rsp_o(peripheral_slv_rsp[core_v_mini_mcu_pkg::CRC_IDX]),
+      .ready_o(crc_ready_o)
+  );
+% else:
+  assign peripheral_slv_rsp[core_v_mini_mcu_pkg::CRC_IDX] = '0;
+  assign crc_ready_o = 1'b0;
+% endif
+% endif
+% endfor
+
+% for peripheral in peripherals.items():
+% if peripheral[0] in ("mailbox"):
+% if peripheral[1]['is_included'] in ("yes"):
+  mailbox #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .NumHarts (core_v_mini_mcu_pkg::NUM_CORES)
+  ) mailbox_i (
+      .clk_i(clk_cg),
+      .rst_ni,
+      .reg_req_i(peripheral_slv_req[core_v_mini_mcu_pkg::MAILBOX_IDX]),
+      .reg_rsp_o(peripheral_slv_rsp[core_v_mini_mcu_pkg::MAILBOX_IDX]),
+      .fetch_enable_o(hart_fetch_enable_o),
+      .boot_addr_o(hart_boot_addr_o),
+      .irq_o(mailbox_intr_o)
+  );
+% else:
+  assign peripheral_slv_rsp[core_v_mini_mcu_pkg::MAILBOX_IDX] = '0;
+  assign hart_fetch_enable_o = 1;
+  assign hart_boot_addr_o = '0;
+  assign mailbox_intr_o = '0;
 % endif
 % endif
 % endfor
@@ -2,10 +2,34 @@
 // Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
 // SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 
+// The flash is driven by the SPI host when use_spimemio_i is 0 and by SPIMEM
+// (obi_spimemio) when it is 1. With ARBITER_CTRL.ENABLE of obi_spimemio set,
+// the SPI host also gets the flash while SPIMEM is selected, one chip select
+// session at a time:
+//
+// - a write to COMMAND of the SPI host waits until SPIMEM has no read in
+//   progress, then SPIMEM is held (chip select high) and, when it was left in
+//   continuous read mode, the flash is taken out of it with 8 clocks with all
+//   the IOs high;
+// - the SPI host then owns the pins until its chip select is high with no
+//   command segment left: the sessions queued (COMMAND with CSAAT = 0) are
+//   counted down at each rise of its chip select, and a segment with CSAAT = 1
+//   keeps the session open until the next one;
+// - SPIMEM is released and restarts with its wake-up sequence, its reads
+//   waiting meanwhile.
+//
+// A session of several segments keeps the flash from SPIMEM until its last
+// one, so its COMMAND writes must not wait for a read of the flash: they are
+// issued from code in the RAM (XHEEP_SECTION_FAST_TEXT) or in the cache.
+
 module spi_subsystem
   import obi_pkg::*;
   import reg_pkg::*;
-(
+#(
+    parameter int unsigned CACHE_WAYS = 1,
+    parameter int unsigned CACHE_SETS = 16,
+    parameter int unsigned CACHE_LINE_WORDS = 4
+) (
     input logic clk_i,
     input logic rst_ni,
 
@@ -62,9 +86,135 @@ module spi_subsystem
   logic [                        3:0] yo_spi_sd_en;
   logic [                        3:0] yo_spi_sd_in;
 
+  // Arbitration
+  typedef enum logic [1:0] {
+    ARB_MEMIO,
+    ARB_RELEASE,
+    ARB_MODE_RESET,
+    ARB_HOST
+  } arb_state_e;
+
+  arb_state_e arb_state_q, arb_state_d;
+  logic [4:0] arb_cnt_q, arb_cnt_d;
+  logic [2:0] host_sessions_q, host_sessions_d;
+  logic host_csaat_q, host_csaat_d;
+  logic host_cs_idle, host_cs_idle_q, host_busy;
+  logic arb_en, arbitrate, memio_busy, memio_cont;
+  logic host_cmd_write, host_cmd_stall, host_cmd_accept, host_sw_rst;
+  reg_req_t ot_reg_req;
+  reg_rsp_t ot_reg_rsp;
+
+  assign arbitrate = use_spimemio_i & arb_en;
+
+  assign host_cmd_write = arbitrate && ot_reg_req_i.valid && ot_reg_req_i.write &&
+      ot_reg_req_i.addr[spi_host_reg_pkg::BlockAw-1:0] == spi_host_reg_pkg::SPI_HOST_COMMAND_OFFSET;
+  assign host_sw_rst = ot_reg_req_i.valid && ot_reg_req_i.write && ot_reg_rsp.ready &&
+      ot_reg_req_i.addr[spi_host_reg_pkg::BlockAw-1:0] == spi_host_reg_pkg::SPI_HOST_CONTROL_OFFSET &&
+      ot_reg_req_i.wdata[30];
+
+  // The commands wait for the flash, the other registers are always accessed
+  assign host_cmd_stall = host_cmd_write && arb_state_q != ARB_HOST;
+  assign host_cmd_accept = host_cmd_write && arb_state_q == ARB_HOST && ot_reg_rsp.ready;
+
+  always_comb begin
+    ot_reg_req = ot_reg_req_i;
+    ot_reg_rsp_o = ot_reg_rsp;
+    if (host_cmd_stall) begin
+      ot_reg_req.valid = 1'b0;
+      ot_reg_rsp_o.ready = 1'b0;
+    end
+  end
+
+  assign host_cs_idle = &ot_spi_csb;
+  assign host_busy = host_csaat_q || host_sessions_q != '0 || !host_cs_idle;
+
+  always_comb begin
+    arb_state_d = arb_state_q;
+    arb_cnt_d = arb_cnt_q;
+    host_csaat_d = host_csaat_q;
+    host_sessions_d = host_sessions_q;
+
+    if (host_cmd_accept) begin
+      host_csaat_d = ot_reg_req_i.wdata[24];
+    end
+    if (host_cmd_accept && !ot_reg_req_i.wdata[24]) begin
+      host_sessions_d = host_sessions_d + 3'd1;
+    end
+    if (host_cs_idle && !host_cs_idle_q && host_sessions_d != '0) begin
+      host_sessions_d = host_sessions_d - 3'd1;
+    end
+
+    unique case (arb_state_q)
+      ARB_MEMIO: begin
+        // At a word boundary of SPIMEM
+        if (host_cmd_write && !memio_busy) begin
+          arb_state_d = ARB_RELEASE;
+          arb_cnt_d = '0;
+        end
+      end
+      ARB_RELEASE: begin
+        // The soft reset of SPIMEM takes a few cycles to raise its chip select
+        arb_cnt_d = arb_cnt_q + 5'd1;
+        if (arb_cnt_q >= 5'd3 && yo_spi_csb[0]) begin
+          arb_state_d = memio_cont ? ARB_MODE_RESET : ARB_HOST;
+          arb_cnt_d = '0;
+        end
+      end
+      ARB_MODE_RESET: begin
+        arb_cnt_d = arb_cnt_q + 5'd1;
+        if (arb_cnt_q == 5'd17) begin
+          arb_state_d = ARB_HOST;
+        end
+      end
+      ARB_HOST: begin
+        if (!host_busy && !host_cmd_write) begin
+          arb_state_d = ARB_MEMIO;
+        end
+      end
+      default: arb_state_d = ARB_MEMIO;
+    endcase
+
+    if (!arbitrate || host_sw_rst) begin
+      arb_state_d = ARB_MEMIO;
+      host_csaat_d = 1'b0;
+      host_sessions_d = '0;
+    end
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : arbiter
+    if (!rst_ni) begin
+      arb_state_q <= ARB_MEMIO;
+      arb_cnt_q <= '0;
+      host_csaat_q <= 1'b0;
+      host_sessions_q <= '0;
+      host_cs_idle_q <= 1'b1;
+    end else begin
+      arb_state_q <= arb_state_d;
+      arb_cnt_q <= arb_cnt_d;
+      host_csaat_q <= host_csaat_d;
+      host_sessions_q <= host_sessions_d;
+      host_cs_idle_q <= host_cs_idle;
+    end
+  end
+
   // Multiplexer
   always_comb begin
-    if (!use_spimemio_i) begin
+    if (arbitrate && arb_state_q == ARB_MODE_RESET) begin
+      // Continuous read mode reset: chip select low and 8 clocks with all the
+      // IOs high, which in a continuous read are mode bits other than 0xAx
+      spi_flash_sck_o = arb_cnt_q[0] && arb_cnt_q < 5'd17;
+      spi_flash_sck_en_o = 1'b1;
+      spi_flash_csb_o = {{(spi_host_reg_pkg::NumCS - 1) {1'b1}}, arb_cnt_q == 5'd17};
+      spi_flash_csb_en_o = yo_spi_csb_en;
+      spi_flash_sd_o = 4'hf;
+      spi_flash_sd_en_o = 4'hf;
+      ot_spi_sd_in = '0;
+      yo_spi_sd_in = '0;
+      spi_flash_intr_error_o = ot_spi_intr_error;
+      spi_flash_intr_event_o = ot_spi_intr_event;
+      spi_flash_rx_valid_o = ot_spi_rx_valid;
+      spi_flash_tx_ready_o = ot_spi_tx_ready;
+    end else if (!use_spimemio_i || (arbitrate && arb_state_q == ARB_HOST)) begin
       spi_flash_sck_o = ot_spi_sck;
       spi_flash_sck_en_o = ot_spi_sck_en;
       spi_flash_csb_o = ot_spi_csb;
@@ -86,10 +236,11 @@ module spi_subsystem
       spi_flash_sd_en_o = yo_spi_sd_en;
       ot_spi_sd_in = '0;
       yo_spi_sd_in = spi_flash_sd_i;
-      spi_flash_intr_error_o = 1'b0;
-      spi_flash_intr_event_o = 1'b0;
-      spi_flash_rx_valid_o = 1'b0;
-      spi_flash_tx_ready_o = 1'b0;
+      // The interrupts and DMA requests of the SPI host between its sessions
+      spi_flash_intr_error_o = arbitrate & ot_spi_intr_error;
+      spi_flash_intr_event_o = arbitrate & ot_spi_intr_event;
+      spi_flash_rx_valid_o = arbitrate & ot_spi_rx_valid;
+      spi_flash_tx_ready_o = arbitrate & ot_spi_tx_ready;
     end
   end
 
@@ -98,7 +249,11 @@ module spi_subsystem
   assign yo_spi_csb_en = 2'b01;
   assign yo_spi_csb[1] = 1'b1;
 
-  obi_spimemio obi_spimemio_i (
+  obi_spimemio #(
+      .CACHE_WAYS(CACHE_WAYS),
+      .CACHE_SETS(CACHE_SETS),
+      .CACHE_LINE_WORDS(CACHE_LINE_WORDS)
+  ) obi_spimemio_i (
       .clk_i,
       .rst_ni,
       .flash_csb_o(yo_spi_csb[0]),
@@ -118,7 +273,11 @@ module spi_subsystem
       .reg_req_i(yo_reg_req_i),
       .reg_rsp_o(yo_reg_rsp_o),
       .spimemio_req_i(spimemio_req_i),
-      .spimemio_resp_o(spimemio_resp_o)
+      .spimemio_resp_o(spimemio_resp_o),
+      .hold_i(arbitrate && arb_state_q != ARB_MEMIO),
+      .busy_o(memio_busy),
+      .cont_o(memio_cont),
+      .arbiter_en_o(arb_en)
   );
 
   // OpenTitan SPI Snitch Version used for booting
@@ -128,8 +287,8 @@ module spi_subsystem
   ) ot_spi_i (
       .clk_i,
       .rst_ni,
-      .reg_req_i(ot_reg_req_i),
-      .reg_rsp_o(ot_reg_rsp_o),
+      .reg_req_i(ot_reg_req),
+      .reg_rsp_o(ot_reg_rsp),
       .alert_rx_i(),
       .alert_tx_o(),
       .passthrough_i(spi_device_pkg::PASSTHROUGH_REQ_DEFAULT),
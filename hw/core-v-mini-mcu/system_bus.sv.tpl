@@ -37,15 +37,30 @@ module system_bus
     input  obi_req_t  debug_master_req_i,
     output obi_resp_t debug_master_resp_o,
 
-    input  obi_req_t  dma_read_ch0_req_i,
-    output obi_resp_t dma_read_ch0_resp_o,
+    input  obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_req_i,
+    output obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_read_resp_o,
 
-    input  obi_req_t  dma_write_ch0_req_i,
-    output obi_resp_t dma_write_ch0_resp_o,
+    input  obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_req_i,
+    output obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_write_resp_o,
 
-    input  obi_req_t  dma_addr_ch0_req_i,
-    output obi_resp_t dma_addr_ch0_resp_o,
+    input  obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_req_i,
+    output obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] dma_addr_resp_o,
 
+% if cpu_num > 1:
+    // Secondary cores, without external ports
+    input  obi_req_t  [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_instr_req_i,
+    output obi_resp_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_instr_resp_o,
+
+    input  obi_req_t  [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_data_req_i,
+    output obi_resp_t [core_v_mini_mcu_pkg::NUM_CORES-1:1] hart_data_resp_o,
+
+% endif
+% if spi_slave:
+    // SPI slave, without external ports
+    input  obi_req_t  spi_slave_req_i,
+    output obi_resp_t spi_slave_resp_o,
+
+% endif
     // External master ports
     input  obi_req_t  [EXT_XBAR_NMASTER_RND-1:0] ext_xbar_master_req_i,
     output obi_resp_t [EXT_XBAR_NMASTER_RND-1:0] ext_xbar_master_resp_o,
@@ -76,14 +91,22 @@ module system_bus
     output obi_req_t  ext_debug_master_req_o,
     input  obi_resp_t ext_debug_master_resp_i,
 
-    output obi_req_t  ext_dma_read_ch0_req_o,
-    input  obi_resp_t ext_dma_read_ch0_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_resp_i,
 
-    output obi_req_t  ext_dma_write_ch0_req_o,
-    input  obi_resp_t ext_dma_write_ch0_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_resp_i,
 
-    output obi_req_t  ext_dma_addr_ch0_req_o,
-    input  obi_resp_t ext_dma_addr_ch0_resp_i
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_resp_i,
+
+    // Registers of the bus monitor
+    input  reg_pkg::reg_req_t bus_monitor_reg_req_i,
+    output reg_pkg::reg_rsp_t bus_monitor_reg_rsp_o,
+
+    // Arbitration between the cores and the DMA (BUS_QOS of soc_ctrl)
+    input logic       cpu_prio_i,
+    input logic [7:0] dma_throttle_i
 );
 
   import core_v_mini_mcu_pkg::*;
@@ -105,8 +128,12 @@ module system_bus
   obi_resp_t error_slave_resp;
 
   // Forward crossbars ports
-  obi_req_t [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER-1:0][1:0] demux_xbar_req;
-  obi_resp_t [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER-1:0][1:0] demux_xbar_resp;
+  obi_req_t [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER_DEMUX-1:0][1:0] demux_xbar_req;
+  obi_resp_t [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER_DEMUX-1:0][1:0] demux_xbar_resp;
+
+  // Masters with priority and throttled masters of the crossbar
+  logic [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER+EXT_XBAR_NMASTER-1:0] master_prio;
+  logic [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER+EXT_XBAR_NMASTER-1:0] master_throttle;
 
   // Dummy external master port (to prevent unused warning)
   obi_req_t [EXT_XBAR_NMASTER_RND-1:0] ext_xbar_req_unused;
@@ -119,15 +146,45 @@ module system_bus
   assign int_master_req[core_v_mini_mcu_pkg::CORE_INSTR_IDX] = core_instr_req_i;
   assign int_master_req[core_v_mini_mcu_pkg::CORE_DATA_IDX] = core_data_req_i;
   assign int_master_req[core_v_mini_mcu_pkg::DEBUG_MASTER_IDX] = debug_master_req_i;
-  assign int_master_req[core_v_mini_mcu_pkg::DMA_READ_CH0_IDX] = dma_read_ch0_req_i;
-  assign int_master_req[core_v_mini_mcu_pkg::DMA_WRITE_CH0_IDX] = dma_write_ch0_req_i;
-  assign int_master_req[core_v_mini_mcu_pkg::DMA_ADDR_CH0_IDX] = dma_addr_ch0_req_i;
+% for ch in range(dma_ch_count):
+  assign int_master_req[core_v_mini_mcu_pkg::DMA_READ_CH${ch}_IDX] = dma_read_req_i[${ch}];
+  assign int_master_req[core_v_mini_mcu_pkg::DMA_WRITE_CH${ch}_IDX] = dma_write_req_i[${ch}];
+  assign int_master_req[core_v_mini_mcu_pkg::DMA_ADDR_CH${ch}_IDX] = dma_addr_req_i[${ch}];
+% endfor
+% for c in range(1, cpu_num):
+  assign int_master_req[core_v_mini_mcu_pkg::CORE${c}_INSTR_IDX] = hart_instr_req_i[${c}];
+  assign int_master_req[core_v_mini_mcu_pkg::CORE${c}_DATA_IDX] = hart_data_req_i[${c}];
+% endfor
+% if spi_slave:
+  assign int_master_req[core_v_mini_mcu_pkg::SPI_SLAVE_IDX] = spi_slave_req_i;
+% endif
+
+  // The ports of the cores have priority when CPU_PRIO is set, the ports of
+  // the DMA channels are throttled
+  always_comb begin
+    master_prio = '0;
+    master_prio[core_v_mini_mcu_pkg::CORE_INSTR_IDX] = cpu_prio_i;
+    master_prio[core_v_mini_mcu_pkg::CORE_DATA_IDX] = cpu_prio_i;
+% for c in range(1, cpu_num):
+    master_prio[core_v_mini_mcu_pkg::CORE${c}_INSTR_IDX] = cpu_prio_i;
+    master_prio[core_v_mini_mcu_pkg::CORE${c}_DATA_IDX] = cpu_prio_i;
+% endfor
+    master_throttle = '0;
+% for ch in range(dma_ch_count):
+    master_throttle[core_v_mini_mcu_pkg::DMA_READ_CH${ch}_IDX] = 1'b1;
+    master_throttle[core_v_mini_mcu_pkg::DMA_WRITE_CH${ch}_IDX] = 1'b1;
+    master_throttle[core_v_mini_mcu_pkg::DMA_ADDR_CH${ch}_IDX] = 1'b1;
+% endfor
+  end
 
   // Internal + external master requests
   generate
-    for (genvar i = 0; i < SYSTEM_XBAR_NMASTER; i++) begin: gen_sys_master_req_map
+    for (genvar i = 0; i < SYSTEM_XBAR_NMASTER_DEMUX; i++) begin: gen_sys_master_req_map
       assign master_req[i] = demux_xbar_req[i][DEMUX_XBAR_INT_SLAVE_IDX];
     end
+    for (genvar i = SYSTEM_XBAR_NMASTER_DEMUX; i < SYSTEM_XBAR_NMASTER; i++) begin: gen_hart_master_req_map
+      assign master_req[i] = int_master_req[i];
+    end
     for (genvar i = 0; i < EXT_XBAR_NMASTER; i++) begin : gen_ext_master_req_map
       assign master_req[SYSTEM_XBAR_NMASTER+i] = ext_xbar_master_req_i[i];
     end
@@ -135,16 +192,28 @@ module system_bus
 
   // Internal master responses
   generate
-    for (genvar i = 0; i < SYSTEM_XBAR_NMASTER; i++) begin: gen_demux_master_resp_map
+    for (genvar i = 0; i < SYSTEM_XBAR_NMASTER_DEMUX; i++) begin: gen_demux_master_resp_map
       assign demux_xbar_resp[i][DEMUX_XBAR_INT_SLAVE_IDX] = master_resp[i];
     end
+    for (genvar i = SYSTEM_XBAR_NMASTER_DEMUX; i < SYSTEM_XBAR_NMASTER; i++) begin: gen_hart_master_resp_map
+      assign int_master_resp[i] = master_resp[i];
+    end
   endgenerate
   assign core_instr_resp_o = int_master_resp[core_v_mini_mcu_pkg::CORE_INSTR_IDX];
   assign core_data_resp_o = int_master_resp[core_v_mini_mcu_pkg::CORE_DATA_IDX];
   assign debug_master_resp_o = int_master_resp[core_v_mini_mcu_pkg::DEBUG_MASTER_IDX];
-  assign dma_read_ch0_resp_o = int_master_resp[core_v_mini_mcu_pkg::DMA_READ_CH0_IDX];
-  assign dma_write_ch0_resp_o = int_master_resp[core_v_mini_mcu_pkg::DMA_WRITE_CH0_IDX];
-  assign dma_addr_ch0_resp_o = int_master_resp[core_v_mini_mcu_pkg::DMA_ADDR_CH0_IDX];
+% for ch in range(dma_ch_count):
+  assign dma_read_resp_o[${ch}] = int_master_resp[core_v_mini_mcu_pkg::DMA_READ_CH${ch}_IDX];
+  assign dma_write_resp_o[${ch}] = int_master_resp[core_v_mini_mcu_pkg::DMA_WRITE_CH${ch}_IDX];
+  assign dma_addr_resp_o[${ch}] = int_master_resp[core_v_mini_mcu_pkg::DMA_ADDR_CH${ch}_IDX];
+% endfor
+% for c in range(1, cpu_num):
+  assign hart_instr_resp_o[${c}] = int_master_resp[core_v_mini_mcu_pkg::CORE${c}_INSTR_IDX];
+  assign hart_data_resp_o[${c}] = int_master_resp[core_v_mini_mcu_pkg::CORE${c}_DATA_IDX];
+% endfor
+% if spi_slave:
+  assign spi_slave_resp_o = int_master_resp[core_v_mini_mcu_pkg::SPI_SLAVE_IDX];
+% endif
 
   // External master responses
   if (EXT_XBAR_NMASTER == 0) begin
@@ -169,9 +238,11 @@ module system_bus
   assign ext_core_instr_req_o = demux_xbar_req[CORE_INSTR_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
   assign ext_core_data_req_o = demux_xbar_req[CORE_DATA_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
   assign ext_debug_master_req_o = demux_xbar_req[DEBUG_MASTER_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
-  assign ext_dma_read_ch0_req_o = demux_xbar_req[DMA_READ_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
-  assign ext_dma_write_ch0_req_o = demux_xbar_req[DMA_WRITE_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
-  assign ext_dma_addr_ch0_req_o = demux_xbar_req[DMA_ADDR_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
+% for ch in range(dma_ch_count):
+  assign ext_dma_read_req_o[${ch}] = demux_xbar_req[DMA_READ_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
+  assign ext_dma_write_req_o[${ch}] = demux_xbar_req[DMA_WRITE_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
+  assign ext_dma_addr_req_o[${ch}] = demux_xbar_req[DMA_ADDR_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX];
+% endfor
 
   // Internal slave responses
   assign int_slave_resp[core_v_mini_mcu_pkg::ERROR_IDX] = error_slave_resp;
@@ -187,9 +258,11 @@ module system_bus
   assign demux_xbar_resp[CORE_INSTR_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_core_instr_resp_i;
   assign demux_xbar_resp[CORE_DATA_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_core_data_resp_i;
   assign demux_xbar_resp[DEBUG_MASTER_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_debug_master_resp_i;
-  assign demux_xbar_resp[DMA_READ_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_read_ch0_resp_i;
-  assign demux_xbar_resp[DMA_WRITE_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_write_ch0_resp_i;
-  assign demux_xbar_resp[DMA_ADDR_CH0_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_addr_ch0_resp_i;
+% for ch in range(dma_ch_count):
+  assign demux_xbar_resp[DMA_READ_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_read_resp_i[${ch}];
+  assign demux_xbar_resp[DMA_WRITE_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_write_resp_i[${ch}];
+  assign demux_xbar_resp[DMA_ADDR_CH${ch}_IDX][DEMUX_XBAR_EXT_SLAVE_IDX] = ext_dma_addr_resp_i[${ch}];
+% endfor
 
 `ifndef SYNTHESIS
   always_ff @(posedge clk_i, negedge rst_ni) begin : check_out_of_bound
@@ -211,12 +284,14 @@ module system_bus
   // 1-to-2 demux crossbars
   // ------------------------
   // These crossbars forward each master to a port on the internal crossbar or
-  // to the corresponding external master port.
+  // to the corresponding external master port. The secondary cores are
+  // connected to the internal crossbar directly.
   generate
-    for (genvar i = 0; unsigned'(i) < SYSTEM_XBAR_NMASTER; i++) begin : gen_demux_xbar
+    for (genvar i = 0; unsigned'(i) < SYSTEM_XBAR_NMASTER_DEMUX; i++) begin : gen_demux_xbar
       xbar_varlat_one_to_n #(
-          .XBAR_NSLAVE (32'd2), // internal crossbar + external crossbar
-          .NUM_RULES   (32'd1) // only the external address space is defined
+          .XBAR_NSLAVE    (32'd2), // internal crossbar + external crossbar
+          .NUM_RULES      (32'd1), // only the external address space is defined
+          .MAX_OUTSTANDING(core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
       ) demux_xbar_i (
           .clk_i        (clk_i),
           .rst_ni       (rst_ni),
@@ -243,6 +318,28 @@ module system_bus
       .master_req_i(master_req),
       .master_resp_o(master_resp),
       .slave_req_o(int_slave_req),
+      .slave_resp_i(int_slave_resp),
+      .master_prio_i(master_prio),
+      .master_throttle_i(master_throttle),
+      .throttle_cycles_i(dma_throttle_i)
+  );
+
+  // Performance monitor of the ports of the crossbar
+  // ------------------------------------------------
+  bus_monitor #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t),
+      .NUM_MASTERS(core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER + EXT_XBAR_NMASTER),
+      .NUM_SLAVES(core_v_mini_mcu_pkg::SYSTEM_XBAR_NSLAVE),
+      .COUNTERS(core_v_mini_mcu_pkg::BUS_MONITOR_COUNTERS)
+  ) bus_monitor_i (
+      .clk_i(clk_i),
+      .rst_ni(rst_ni),
+      .reg_req_i(bus_monitor_reg_req_i),
+      .reg_rsp_o(bus_monitor_reg_rsp_o),
+      .master_req_i(master_req),
+      .master_resp_i(master_resp),
+      .slave_req_i(int_slave_req),
       .slave_resp_i(int_slave_resp)
   );
 
@@ -25,7 +25,14 @@ module system_xbar
     output obi_resp_t [XBAR_NMASTER-1:0] master_resp_o,
 
     output obi_req_t  [XBAR_NSLAVE-1:0] slave_req_o,
-    input  obi_resp_t [XBAR_NSLAVE-1:0] slave_resp_i
+    input  obi_resp_t [XBAR_NSLAVE-1:0] slave_resp_i,
+
+    // Quality of service: the requests of the masters in master_prio_i win
+    // over those of the other masters for the same slave, and the masters in
+    // master_throttle_i wait throttle_cycles_i cycles after each grant
+    input logic [XBAR_NMASTER-1:0] master_prio_i,
+    input logic [XBAR_NMASTER-1:0] master_throttle_i,
+    input logic [             7:0] throttle_cycles_i
 
 );
 
@@ -64,6 +71,13 @@ module system_xbar
   logic [XBAR_NSLAVE-1:0][REQ_AGG_DATA_WIDTH-1:0] slave_req_out_data;
   obi_req_t [XBAR_NMASTER-1:0] master_req;
 
+  // Quality of service
+  logic [XBAR_NMASTER-1:0] qos_req;
+  logic [XBAR_NMASTER-1:0] qos_gnt;
+  logic [XBAR_NMASTER-1:0] master_hold;
+  logic [XBAR_NMASTER-1:0] master_qos_mask;
+  logic [XBAR_NMASTER-1:0][7:0] throttle_cnt_q;
+
   if (BUS_TYPE == NtoM) begin : gen_addr_decoders_NtoM
     for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_addr_decoders
       addr_decode #(
@@ -106,11 +120,69 @@ module system_xbar
 % endif    
   end
 
+  // Quality of service
+  // ------------------
+  // The request of a master is hidden from the arbiters while it is throttled
+  // or while a master with priority requests the same slave. The master keeps
+  // its request as OBI wants, it is only granted later.
+  for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_throttle
+    assign qos_req[i] = master_req_i[i].req;
+    assign qos_gnt[i] = master_resp_o[i].gnt;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        throttle_cnt_q[i] <= '0;
+      end else if (qos_req[i] && qos_gnt[i] && master_throttle_i[i]) begin
+        throttle_cnt_q[i] <= throttle_cycles_i;
+      end else if (throttle_cnt_q[i] != '0) begin
+        throttle_cnt_q[i] <= throttle_cnt_q[i] - 8'd1;
+      end
+    end
+    assign master_hold[i] = throttle_cnt_q[i] != '0;
+  end
+
+  if (BUS_TYPE == NtoM) begin : gen_qos_NtoM
+    // Each slave has its own arbiter, so only the masters of the slaves
+    // requested by a master with priority are hidden
+    always_comb begin
+      master_qos_mask = master_hold;
+      for (int unsigned j = 0; j < XBAR_NMASTER; j++) begin
+        for (int unsigned i = 0; i < XBAR_NMASTER; i++) begin
+          if (!master_prio_i[j] && master_prio_i[i] && qos_req[i] && !master_hold[i]
+              && port_sel[i] == port_sel[j]) begin
+            master_qos_mask[j] = 1'b1;
+          end
+        end
+      end
+    end
+  end else begin : gen_qos_1toM
+    // The arbiter of the neck locks on a request until its grant, so the
+    // mask of the priority does not change while it is locked. The throttle
+    // only hides masters after their own grant, they cannot be locked.
+    logic [XBAR_NMASTER-1:0] prio_mask, prio_mask_q;
+    logic qos_lock_q;
+    logic prio_req;
+
+    assign prio_req = |(master_prio_i & qos_req & ~master_hold);
+    assign prio_mask = qos_lock_q ? prio_mask_q : (prio_req ? ~master_prio_i : '0);
+    assign master_qos_mask = master_hold | prio_mask;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        qos_lock_q  <= 1'b0;
+        prio_mask_q <= '0;
+      end else begin
+        qos_lock_q  <= |(qos_req & ~master_qos_mask) && ~|qos_gnt;
+        prio_mask_q <= prio_mask;
+      end
+    end
+  end
+
   // Propagate interleaved address
   generate
     for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_unroll_master
       assign master_req[i] = '{
-        req: master_req_i[i].req,
+        req: master_req_i[i].req & ~master_qos_mask[i],
         we: master_req_i[i].we,
         be: master_req_i[i].be,
   % if ram_numbanks_il == 0:
@@ -176,7 +248,8 @@ module system_xbar
 
     // N-to-1 crossbar
     xbar_varlat_n_to_one #(
-      .XBAR_NMASTER (XBAR_NMASTER)
+      .XBAR_NMASTER    (XBAR_NMASTER),
+      .MAX_OUTSTANDING (core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
     ) xbar_varlat_n_to_one_i (
       .clk_i         (clk_i),
       .rst_ni        (rst_ni),
@@ -187,18 +260,14 @@ module system_xbar
     );
 
     // 1-to-N crossbar
-    // NOTE: AGGREGATE_GNT should be 0 when a single master is actually
-    // aggregating multiple master requests. This is not needed when a
-    // real-single master is used or multiple masters are used as the
-    // rr_arb_tree dispatches the grant to each corresponding master.
-    // Whereas, when the xbar_varlat is used with a single master, which is
-    // shared among severals (as in this case as an output of another
-    // xbar_varlat), the rr_arb_tree gives all the grant to the shared single
-    // master, thus granting transactions that should not be granted.
+    // NOTE: the transactions in flight on the neck, from any master, all go
+    // to the same slave, so that the responses come back in order and the
+    // N-to-1 crossbar routes each one to its master.
 
       xbar_varlat_one_to_n #(
-        .XBAR_NSLAVE   (XBAR_NSLAVE),
-        .AGGREGATE_GNT (32'd0) // the neck request is aggregating all the input masters
+        .XBAR_NSLAVE     (XBAR_NSLAVE),
+        .AGGREGATE_GNT   (32'd0), // the neck request is aggregating all the input masters
+        .MAX_OUTSTANDING (core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
       ) xbar_varlat_one_to_n_i (
         .clk_i         (clk_i),
         .rst_ni        (rst_ni),
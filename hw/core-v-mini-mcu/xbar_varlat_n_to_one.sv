@@ -8,7 +8,9 @@
 // Description: N-to-1 crossbar
 
 module xbar_varlat_n_to_one #(
-    parameter int unsigned XBAR_NMASTER = 2
+    parameter int unsigned XBAR_NMASTER = 2,
+    // Transactions in flight on the slave port, from any of the masters
+    parameter int unsigned MAX_OUTSTANDING = 1
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -24,142 +26,107 @@ module xbar_varlat_n_to_one #(
   // ARCHITECTURE
   // ------------
   //              MASTER[0] ----.
-  //            MASTER[...] --- XBAR <--> SLAVE
+  //            MASTER[...] --- ARBITER <--> SLAVE
   // MASTER[XBAR_NMASTER-1] ----'
 
   // PARAMETERS
   // ----------
   // Request width: we + be[3:0] + addr[31:0] + wdata[31:0]
   localparam int unsigned ReqDataWidth = 32'd1 + 32'd4 + 32'd32 + 32'd32;
-  // Response width: rdata[31:0]
-  localparam int unsigned RspDataWidth = 32'd32;
+  // Master index width
+  localparam int unsigned IdxWidth = XBAR_NMASTER > 1 ? $clog2(XBAR_NMASTER) : 32'd1;
+  localparam int unsigned PtrWidth = MAX_OUTSTANDING > 1 ? $clog2(MAX_OUTSTANDING) : 32'd1;
+  localparam int unsigned CountWidth = $clog2(MAX_OUTSTANDING + 1);
 
   // INTERNAL SIGNALS
   // ----------------
-  // Crossbar input and output data
-  logic [XBAR_NMASTER-1:0]                   master_xbar_req_req;
-  logic [XBAR_NMASTER-1:0]                   xbar_master_rsp_gnt;
-  logic [XBAR_NMASTER-1:0]                   xbar_master_rsp_rvalid;
-  logic [XBAR_NMASTER-1:0][ReqDataWidth-1:0] master_xbar_req_data;
-  logic [XBAR_NMASTER-1:0][RspDataWidth-1:0] xbar_master_rsp_data;
-  logic [             0:0]                   xbar_slave_req_req;
-  logic [             0:0]                   slave_xbar_rsp_gnt;
-  logic [             0:0]                   slave_xbar_rsp_rvalid;
-  logic [             0:0][ReqDataWidth-1:0] xbar_slave_req_data;
-  logic [             0:0][RspDataWidth-1:0] slave_xbar_rsp_data;
-  logic xbar_slave_req_req_outstanding, slave_xbar_rsp_gnt_outstanding;
+  logic [XBAR_NMASTER-1:0]                   master_arb_req;
+  logic [XBAR_NMASTER-1:0]                   arb_master_gnt;
+  logic [XBAR_NMASTER-1:0][ReqDataWidth-1:0] master_arb_data;
+  logic                                      arb_slave_req;
+  logic                                      slave_arb_gnt;
+  logic [    ReqDataWidth-1:0]               arb_slave_data;
+  logic [        IdxWidth-1:0]               arb_idx;
+
+  // Masters of the transactions in flight, in the order of their grants
+  logic [MAX_OUTSTANDING-1:0][IdxWidth-1:0] inflight_idx_q;
+  logic [PtrWidth-1:0] wr_ptr_q, rd_ptr_q;
+  logic [CountWidth-1:0] inflight_cnt_q;
+  logic issue, retire, can_issue;
 
   // --------
-  // CROSSBAR
+  // ARBITER
   // --------
-  // Unroll OBI master signals
+  // Unroll OBI master signals. The responses come back in the order of the
+  // grants, each one goes to the master at the head of the in-flight queue.
   generate
     for (genvar i = 0; unsigned'(i) < XBAR_NMASTER; i++) begin : gen_master_unroll
-      assign master_xbar_req_req[i] = master_req_i[i].req;
-      assign master_xbar_req_data[i] = {
+      assign master_arb_req[i] = master_req_i[i].req;
+      assign master_arb_data[i] = {
         master_req_i[i].we, master_req_i[i].be, master_req_i[i].addr, master_req_i[i].wdata
       };
       assign master_resp_o[i] = '{
-              gnt: xbar_master_rsp_gnt[i],
-              rvalid: xbar_master_rsp_rvalid[i],
-              rdata: xbar_master_rsp_data[i]
+              gnt: arb_master_gnt[i],
+              rvalid: slave_resp_i.rvalid && inflight_idx_q[rd_ptr_q] == IdxWidth'(i),
+              rdata: slave_resp_i.rdata
           };
     end
   endgenerate
 
   // Unroll OBI slave signals
-  assign slave_req_o.req = xbar_slave_req_req_outstanding;
-  assign {
-    slave_req_o.we,
-    slave_req_o.be,
-    slave_req_o.addr,
-    slave_req_o.wdata
-  } = xbar_slave_req_data[0];
-  assign {slave_xbar_rsp_gnt[0], slave_xbar_rsp_rvalid[0], slave_xbar_rsp_data[0]} = slave_resp_i;
-
-  // Instantiate crossbar
-  xbar_varlat #(
-      .AggregateGnt(32'd1),  // all the masters from X-HEEP do not aggregate multiple masters
-      .NumIn(XBAR_NMASTER),
-      .NumOut(32'd1),
-      .ReqDataWidth(ReqDataWidth),
-      .RespDataWidth(RspDataWidth),
-      .ExtPrio(1'b0)  // do not use external arbiter priority
-  ) u_xbar_varlat (
+  assign slave_req_o.req = arb_slave_req && can_issue;
+  assign {slave_req_o.we, slave_req_o.be, slave_req_o.addr, slave_req_o.wdata} = arb_slave_data;
+  assign slave_arb_gnt = slave_resp_i.gnt && can_issue;
+
+  // The arbitration is locked while the slave does not grant, so that the
+  // request on the slave port does not change before its grant
+  rr_arb_tree #(
+      .NumIn    (XBAR_NMASTER),
+      .DataWidth(ReqDataWidth),
+      .ExtPrio  (1'b0),          // do not use external arbiter priority
+      .LockIn   (1'b1)
+  ) u_rr_arb_tree (
       .clk_i  (clk_i),
       .rst_ni (rst_ni),
+      .flush_i(1'b0),
       .rr_i   ('0),
-      .req_i  (master_xbar_req_req),
-      .add_i  ('0),
-      .wdata_i(master_xbar_req_data),
-      .gnt_o  (xbar_master_rsp_gnt),
-      .vld_o  (xbar_master_rsp_rvalid),
-      .rdata_o(xbar_master_rsp_data),
-      .gnt_i  (slave_xbar_rsp_gnt_outstanding),
-      .req_o  (xbar_slave_req_req),
-      .vld_i  (slave_xbar_rsp_rvalid),
-      .wdata_o(xbar_slave_req_data),
-      .rdata_i(slave_xbar_rsp_data)
+      .req_i  (master_arb_req),
+      .gnt_o  (arb_master_gnt),
+      .data_i (master_arb_data),
+      .req_o  (arb_slave_req),
+      .gnt_i  (slave_arb_gnt),
+      .data_o (arb_slave_data),
+      .idx_o  (arb_idx)
   );
 
-  //block outstanding transactions
-  typedef enum logic {
-    OUTSTANDING_REQ,
-    OUTSTANDING_WAITFOR_VALID
-  } outstanding_req_fsm_e;
-
-  outstanding_req_fsm_e state_n, state_q;
-
-  /* block outstanding transactions
-    The Master M1 may get a GNT at cycle 1, then the Master M2
-    gets a GNT at cycle 2 (from the same or different slaves)
-    As outstanding transactions are not supported (neither in-order nor out-of-order)
-    we need to block the transaction.
-
-    The addr_dec_resp_mux_varlat gates the second request of a master until the valid of the first request returns
-    However, when different masters collides into the 1toM bus, the second part of the xbar sees a single master (the neck) issueing multiple requests (although
-    these 2 reqeusts can actually come from 2 different masters M1 and M2)
-    The second neck.req is gated by the addr_dec_resp_mux_varlat, but not its grant, thus the following FSM gates the gnt as the original master (i.e. the one before the neck)
-    The reason why we have to gate the grant is that the M2 issued a request, although the neck.req is gated by the valid of the M1 request, the grant is propagated
-    to M2, which gets its request granted without begin correct.
-  */
-  always_comb begin
-    state_n = state_q;
-    xbar_slave_req_req_outstanding = xbar_slave_req_req[0];
-    slave_xbar_rsp_gnt_outstanding = slave_xbar_rsp_gnt[0];
-
-    case (state_q)
-
-      OUTSTANDING_REQ: begin
-        if (xbar_slave_req_req_outstanding && slave_xbar_rsp_gnt_outstanding) begin
-          state_n = OUTSTANDING_WAITFOR_VALID;
-        end
-      end
-
-      OUTSTANDING_WAITFOR_VALID: begin
-        xbar_slave_req_req_outstanding = 1'b0;
-        slave_xbar_rsp_gnt_outstanding = 1'b0;
-        if (slave_xbar_rsp_rvalid[0]) begin
-          xbar_slave_req_req_outstanding = xbar_slave_req_req[0];
-          slave_xbar_rsp_gnt_outstanding = slave_xbar_rsp_gnt[0];
-          if (xbar_slave_req_req_outstanding && slave_xbar_rsp_gnt_outstanding) begin
-            state_n = OUTSTANDING_WAITFOR_VALID;
-          end else begin
-            state_n = OUTSTANDING_REQ;
-          end
-        end
-      end
-    endcase
-
-  end
+  // ---------------------
+  // IN-FLIGHT TRANSACTIONS
+  // ---------------------
+  // A new request is issued while fewer than MAX_OUTSTANDING transactions are
+  // in flight, or with the response of the oldest one, so that MAX_OUTSTANDING
+  // = 1 still issues a request per cycle to a single-cycle slave.
+  assign issue = slave_req_o.req && slave_resp_i.gnt;
+  assign retire = slave_resp_i.rvalid && inflight_cnt_q != '0;
+  assign can_issue = inflight_cnt_q < CountWidth'(MAX_OUTSTANDING) || retire;
 
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (~rst_ni) begin
-      state_q <= OUTSTANDING_REQ;
+      inflight_idx_q <= '0;
+      wr_ptr_q       <= '0;
+      rd_ptr_q       <= '0;
+      inflight_cnt_q <= '0;
     end else begin
-      state_q <= state_n;
+      if (issue) begin
+        inflight_idx_q[wr_ptr_q] <= arb_idx;
+        wr_ptr_q <= (wr_ptr_q == PtrWidth'(MAX_OUTSTANDING - 1)) ? '0 : wr_ptr_q + 1'b1;
+      end
+      if (retire) begin
+        rd_ptr_q <= (rd_ptr_q == PtrWidth'(MAX_OUTSTANDING - 1)) ? '0 : rd_ptr_q + 1'b1;
+      end
+      if (issue != retire) begin
+        inflight_cnt_q <= issue ? inflight_cnt_q + 1'b1 : inflight_cnt_q - 1'b1;
+      end
     end
   end
 
-
 endmodule
@@ -11,6 +11,8 @@ module xbar_varlat_one_to_n #(
     parameter int unsigned XBAR_NSLAVE = 2,
     parameter int unsigned NUM_RULES = XBAR_NSLAVE,  // number of ranges in the address map
     parameter int unsigned AGGREGATE_GNT = 32'd1, // the master port is not aggregating multiple masters
+    // Transactions in flight from the master port, all to the same slave
+    parameter int unsigned MAX_OUTSTANDING = 1,
     // Dependent parameters: do not override!
     localparam int unsigned IdxWidth = cf_math_pkg::idx_width(XBAR_NSLAVE)
 ) (
@@ -35,18 +37,19 @@ module xbar_varlat_one_to_n #(
 
   // ARCHITECTURE
   // ------------
-  //                ,---- SLAVE[0]
-  // MASTER <--> XBAR --- SLAVE[...]
-  //                `---- SLAVE[XBAR_NSLAVE-1]
+  //                 ,---- SLAVE[0]
+  // MASTER <--> DEMUX --- SLAVE[...]
+  //                 `---- SLAVE[XBAR_NSLAVE-1]
 
   // PARAMETERS
   // ----------
   // Slave index width
   localparam int unsigned LogXbarNSlave = XBAR_NSLAVE > 1 ? $clog2(XBAR_NSLAVE) : 32'd1;
 
+  // In-flight transaction counter width
+  localparam int unsigned CountWidth = $clog2(MAX_OUTSTANDING + 1);
+
   // Data width
-  // Request: we + be[3:0] + addr[31:0] + wdata[31:0]
-  localparam int unsigned ReqDataWidth = 32'd1 + 32'd4 + 32'd32 + 32'd32;
   // Response: rdata[31:0]
   localparam int unsigned RspDataWidth = 32'd32;
 
@@ -55,18 +58,17 @@ module xbar_varlat_one_to_n #(
   // Selected slave index
   logic [LogXbarNSlave-1:0]                   slave_idx;
 
-  // Crossbar input and output data
-  logic [              0:0]                   master_xbar_req_req;
-  logic [              0:0]                   xbar_master_rsp_gnt;
-  logic [              0:0]                   xbar_master_rsp_rvalid;
-  logic [              0:0][ReqDataWidth-1:0] master_xbar_req_data;
-  logic [              0:0][RspDataWidth-1:0] xbar_master_rsp_data;
-  logic [  XBAR_NSLAVE-1:0]                   xbar_slave_req_req;
+  // Slave responses
   logic [  XBAR_NSLAVE-1:0]                   slave_xbar_rsp_gnt;
   logic [  XBAR_NSLAVE-1:0]                   slave_xbar_rsp_rvalid;
-  logic [  XBAR_NSLAVE-1:0][ReqDataWidth-1:0] xbar_slave_req_data;
   logic [  XBAR_NSLAVE-1:0][RspDataWidth-1:0] slave_xbar_rsp_data;
 
+  // Slave and number of the transactions in flight
+  logic [LogXbarNSlave-1:0]                   inflight_idx_q;
+  logic [   CountWidth-1:0]                   inflight_cnt_q;
+  logic [   CountWidth-1:0]                   inflight_cnt;
+  logic issue, retire, can_issue;
+
   // ----------------
   // INTERNAL MODULES
   // ----------------
@@ -92,29 +94,34 @@ module xbar_varlat_one_to_n #(
       .default_idx_i   (default_idx_i)
   );
 
-  // 1-to-N crossbar
-  // ---------------
-  // Unroll OBI master signals
-  assign master_xbar_req_req[0] = master_req_i.req;
-  assign master_xbar_req_data[0] = {
-    master_req_i.we, master_req_i.be, master_req_i.addr, master_req_i.wdata
-  };
+  // 1-to-N demultiplexer
+  // --------------------
+  // The transactions in flight all go to the same slave, so that the
+  // responses come back in order: a request to another slave waits for the
+  // last response, or is issued with it. A request to the same slave is
+  // issued while fewer than MAX_OUTSTANDING transactions are in flight. The
+  // grant is the one of the selected slave, whether the master port is
+  // aggregating multiple masters or not (AGGREGATE_GNT).
+  assign retire = slave_xbar_rsp_rvalid[inflight_idx_q] && inflight_cnt_q != '0;
+  assign inflight_cnt = inflight_cnt_q - CountWidth'(retire);
+  assign can_issue = inflight_cnt == '0 ||
+                     (slave_idx == inflight_idx_q && inflight_cnt < CountWidth'(MAX_OUTSTANDING));
+  assign issue = master_req_i.req && can_issue && slave_xbar_rsp_gnt[slave_idx];
+
   assign master_resp_o = '{
-          gnt: xbar_master_rsp_gnt[0],
-          rvalid: xbar_master_rsp_rvalid[0],
-          rdata: xbar_master_rsp_data[0]
+          gnt: can_issue && slave_xbar_rsp_gnt[slave_idx],
+          rvalid: retire,
+          rdata: slave_xbar_rsp_data[inflight_idx_q]
       };
 
   // Unroll OBI slave signals
   generate
     for (genvar i = 0; unsigned'(i) < XBAR_NSLAVE; i++) begin : gen_unroll_obi
-      assign slave_req_o[i].req = xbar_slave_req_req[i];
-      assign {
-        slave_req_o[i].we,
-        slave_req_o[i].be,
-        slave_req_o[i].addr,
-        slave_req_o[i].wdata
-      } = xbar_slave_req_data[i];
+      assign slave_req_o[i].req = master_req_i.req && can_issue && slave_idx == LogXbarNSlave'(i);
+      assign slave_req_o[i].we = master_req_i.we;
+      assign slave_req_o[i].be = master_req_i.be;
+      assign slave_req_o[i].addr = master_req_i.addr;
+      assign slave_req_o[i].wdata = master_req_i.wdata;
       assign {
         slave_xbar_rsp_gnt[i],
         slave_xbar_rsp_rvalid[i],
@@ -123,28 +130,17 @@ module xbar_varlat_one_to_n #(
     end
   endgenerate
 
-  // Instantiate crossbar
-  xbar_varlat #(
-      .AggregateGnt (AGGREGATE_GNT),
-      .NumIn        (32'd1),
-      .NumOut       (XBAR_NSLAVE),
-      .ReqDataWidth (ReqDataWidth),
-      .RespDataWidth(RspDataWidth),
-      .ExtPrio      (1'b0)            // do not use external arbiter priority
-  ) u_xbar_varlat (
-      .clk_i  (clk_i),
-      .rst_ni (rst_ni),
-      .rr_i   ('0),
-      .req_i  (master_xbar_req_req),
-      .add_i  (slave_idx),
-      .wdata_i(master_xbar_req_data),
-      .gnt_o  (xbar_master_rsp_gnt),
-      .vld_o  (xbar_master_rsp_rvalid),
-      .rdata_o(xbar_master_rsp_data),
-      .gnt_i  (slave_xbar_rsp_gnt),
-      .req_o  (xbar_slave_req_req),
-      .vld_i  (slave_xbar_rsp_rvalid),
-      .wdata_o(xbar_slave_req_data),
-      .rdata_i(slave_xbar_rsp_data)
-  );
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      inflight_idx_q <= '0;
+      inflight_cnt_q <= '0;
+    end else begin
+      if (issue) begin
+        inflight_idx_q <= slave_idx;
+      end
+      if (issue != retire) begin
+        inflight_cnt_q <= issue ? inflight_cnt_q + 1'b1 : inflight_cnt_q - 1'b1;
+      end
+    end
+  end
 endmodule
@@ -0,0 +1,198 @@
+// Copyright 2022 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+/*
+  Bridge from the OBI masters of the external slave region to an AXI4 master
+  port, used on the Pynq-Z2 to reach the DDR of the Zynq PS (FPGA_PS_DDR).
+  The ports are served round-robin, one transaction at a time with single
+  beat bursts. Writes are posted: they are acknowledged once the address and
+  the data are accepted, up to MaxPostedWrites waiting for their AXI response,
+  and a read waits for all of them to keep the order of the accesses.
+*/
+
+module obi_to_axi
+  import obi_pkg::*;
+#(
+    parameter int unsigned NumPorts = 1,
+    // Added to the OBI address to get the AXI one
+    parameter logic [31:0] AddrOffset = '0,
+    parameter int unsigned MaxPostedWrites = 4,
+    // Dependent parameters, do not override
+    localparam int unsigned PortW = NumPorts > 1 ? $clog2(NumPorts) : 1
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  [NumPorts-1:0] obi_req_i,
+    output obi_resp_t [NumPorts-1:0] obi_resp_o,
+
+    // AXI4 master
+    output logic [31:0] m_axi_awaddr_o,
+    output logic [ 7:0] m_axi_awlen_o,
+    output logic [ 2:0] m_axi_awsize_o,
+    output logic [ 1:0] m_axi_awburst_o,
+    output logic [ 3:0] m_axi_awcache_o,
+    output logic [ 2:0] m_axi_awprot_o,
+    output logic        m_axi_awvalid_o,
+    input  logic        m_axi_awready_i,
+    output logic [31:0] m_axi_wdata_o,
+    output logic [ 3:0] m_axi_wstrb_o,
+    output logic        m_axi_wlast_o,
+    output logic        m_axi_wvalid_o,
+    input  logic        m_axi_wready_i,
+    input  logic [ 1:0] m_axi_bresp_i,
+    input  logic        m_axi_bvalid_i,
+    output logic        m_axi_bready_o,
+    output logic [31:0] m_axi_araddr_o,
+    output logic [ 7:0] m_axi_arlen_o,
+    output logic [ 2:0] m_axi_arsize_o,
+    output logic [ 1:0] m_axi_arburst_o,
+    output logic [ 3:0] m_axi_arcache_o,
+    output logic [ 2:0] m_axi_arprot_o,
+    output logic        m_axi_arvalid_o,
+    input  logic        m_axi_arready_i,
+    input  logic [31:0] m_axi_rdata_i,
+    input  logic [ 1:0] m_axi_rresp_i,
+    input  logic        m_axi_rlast_i,
+    input  logic        m_axi_rvalid_i,
+    output logic        m_axi_rready_o
+);
+
+  typedef enum logic [1:0] {
+    IDLE,
+    WRITE,
+    READ_ADDR,
+    READ_DATA
+  } obi_to_axi_fsm_e;
+
+  obi_to_axi_fsm_e state_q, state_n;
+
+  logic [PortW-1:0] rr_q, port_q, port_sel;
+  logic req_sel, grant;
+
+  logic [31:0] addr_q, wdata_q;
+  logic [3:0] be_q;
+  logic aw_done_q, w_done_q;
+  logic aw_done, w_done;
+
+  logic [$clog2(MaxPostedWrites+1)-1:0] posted_q;
+  logic write_acked;
+
+  logic rvalid_q;
+  logic [31:0] rdata_q;
+
+  // Round-robin choice of the next port, starting after the last one served
+  always_comb begin
+    req_sel  = 1'b0;
+    port_sel = rr_q;
+    for (int unsigned i = 0; i < NumPorts; i++) begin
+      logic [PortW-1:0] p;
+      p = PortW'((rr_q + 1 + i) % NumPorts);
+      if (!req_sel && obi_req_i[p].req) begin
+        req_sel  = 1'b1;
+        port_sel = p;
+      end
+    end
+  end
+
+  // The read waits for the posted writes, the write for a free slot
+  assign grant = state_q == IDLE && req_sel &&
+                 (obi_req_i[port_sel].we ? posted_q != MaxPostedWrites[$bits(posted_q)-1:0] : posted_q == '0);
+
+  always_comb begin
+    for (int unsigned i = 0; i < NumPorts; i++) begin
+      obi_resp_o[i].gnt    = grant && port_sel == PortW'(i);
+      obi_resp_o[i].rvalid = rvalid_q && port_q == PortW'(i);
+      obi_resp_o[i].rdata  = rdata_q;
+    end
+  end
+
+  assign aw_done = aw_done_q | m_axi_awready_i;
+  assign w_done = w_done_q | m_axi_wready_i;
+  assign write_acked = state_q == WRITE && aw_done && w_done;
+
+  always_comb begin
+    state_n = state_q;
+    unique case (state_q)
+      IDLE: if (grant) state_n = obi_req_i[port_sel].we ? WRITE : READ_ADDR;
+      WRITE: if (write_acked) state_n = IDLE;
+      READ_ADDR: if (m_axi_arready_i) state_n = READ_DATA;
+      READ_DATA: if (m_axi_rvalid_i) state_n = IDLE;
+      default: state_n = IDLE;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      state_q   <= IDLE;
+      rr_q      <= '0;
+      port_q    <= '0;
+      addr_q    <= '0;
+      wdata_q   <= '0;
+      be_q      <= '0;
+      aw_done_q <= 1'b0;
+      w_done_q  <= 1'b0;
+      posted_q  <= '0;
+      rvalid_q  <= 1'b0;
+      rdata_q   <= '0;
+    end else begin
+      state_q  <= state_n;
+      rvalid_q <= 1'b0;
+
+      if (grant) begin
+        rr_q      <= port_sel;
+        port_q    <= port_sel;
+        addr_q    <= obi_req_i[port_sel].addr + AddrOffset;
+        wdata_q   <= obi_req_i[port_sel].wdata;
+        be_q      <= obi_req_i[port_sel].be;
+        aw_done_q <= 1'b0;
+        w_done_q  <= 1'b0;
+      end
+
+      if (state_q == WRITE) begin
+        aw_done_q <= aw_done;
+        w_done_q  <= w_done;
+        if (write_acked) rvalid_q <= 1'b1;
+      end
+
+      if (state_q == READ_DATA && m_axi_rvalid_i) begin
+        rvalid_q <= 1'b1;
+        rdata_q  <= m_axi_rdata_i;
+      end
+
+      // the responses of the posted writes are not reported, OBI has no error
+      unique case ({
+        write_acked, m_axi_bvalid_i
+      })
+        2'b10:   posted_q <= posted_q + 1;
+        2'b01:   posted_q <= posted_q - 1;
+        default: posted_q <= posted_q;
+      endcase
+    end
+  end
+
+  // Single beat bursts of words, bufferable and modifiable
+  assign m_axi_awaddr_o = addr_q;
+  assign m_axi_awlen_o = '0;
+  assign m_axi_awsize_o = 3'b010;
+  assign m_axi_awburst_o = 2'b01;
+  assign m_axi_awcache_o = 4'b0011;
+  assign m_axi_awprot_o = '0;
+  assign m_axi_awvalid_o = state_q == WRITE && !aw_done_q;
+  assign m_axi_wdata_o = wdata_q;
+  assign m_axi_wstrb_o = be_q;
+  assign m_axi_wlast_o = 1'b1;
+  assign m_axi_wvalid_o = state_q == WRITE && !w_done_q;
+  assign m_axi_bready_o = 1'b1;
+
+  assign m_axi_araddr_o = addr_q;
+  assign m_axi_arlen_o = '0;
+  assign m_axi_arsize_o = 3'b010;
+  assign m_axi_arburst_o = 2'b01;
+  assign m_axi_arcache_o = 4'b0011;
+  assign m_axi_arprot_o = '0;
+  assign m_axi_arvalid_o = state_q == READ_ADDR;
+  assign m_axi_rready_o = state_q == READ_DATA;
+
+endmodule : obi_to_axi
@@ -0,0 +1,98 @@
+# Copyright 2022 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+# Zynq PS of the pynq-z2-ps-ddr target, in the X-HEEP clock domain:
+# - the AXI4 slave port S_AXI, driven by obi_to_axi, reaches the DDR through
+#   S_AXI_HP0
+# - the AXI4-Lite master port M_AXI, to axi_lite_to_obi, is the window of
+#   M_AXI_GP0 through which util/ps_loader.py sees X-HEEP
+# - x_heep_rst, the EMIO GPIO 0 of the PS, holds X-HEEP in reset
+
+set design_name      xilinx_ps_ddr
+set s_axi_freq_MHz   15
+
+# Create block design
+create_bd_design $design_name
+
+# Create instance and set properties
+set processing_system7_0 [ create_bd_cell -type ip -vlnv xilinx.com:ip:processing_system7:5.5 processing_system7_0 ]
+apply_bd_automation -rule xilinx.com:bd_rule:processing_system7 -config {make_external "FIXED_IO, DDR" apply_board_preset "1"} $processing_system7_0
+set_property -dict [ list \
+ CONFIG.PCW_USE_M_AXI_GP0 {1} \
+ CONFIG.PCW_USE_S_AXI_HP0 {1} \
+ CONFIG.PCW_S_AXI_HP0_DATA_WIDTH {32} \
+ CONFIG.PCW_GPIO_EMIO_GPIO_ENABLE {1} \
+ CONFIG.PCW_GPIO_EMIO_GPIO_IO {1} \
+] $processing_system7_0
+
+set axi_interconnect_0 [ create_bd_cell -type ip -vlnv xilinx.com:ip:axi_interconnect:2.1 axi_interconnect_0 ]
+set_property -dict [ list \
+ CONFIG.NUM_SI {1} \
+ CONFIG.NUM_MI {1} \
+] $axi_interconnect_0
+
+set axi_interconnect_1 [ create_bd_cell -type ip -vlnv xilinx.com:ip:axi_interconnect:2.1 axi_interconnect_1 ]
+set_property -dict [ list \
+ CONFIG.NUM_SI {1} \
+ CONFIG.NUM_MI {1} \
+] $axi_interconnect_1
+
+# Create ports
+set S_AXI [ create_bd_intf_port -mode Slave -vlnv xilinx.com:interface:aximm_rtl:1.0 S_AXI ]
+set_property -dict [ list \
+ CONFIG.PROTOCOL {AXI4} \
+ CONFIG.ADDR_WIDTH {32} \
+ CONFIG.DATA_WIDTH {32} \
+ CONFIG.ID_WIDTH {0} \
+ CONFIG.HAS_LOCK {0} \
+ CONFIG.HAS_QOS {0} \
+ CONFIG.HAS_REGION {0} \
+ CONFIG.MAX_BURST_LENGTH {1} \
+ CONFIG.NUM_READ_OUTSTANDING {1} \
+ CONFIG.NUM_WRITE_OUTSTANDING {4} \
+ CONFIG.FREQ_HZ [ expr $s_axi_freq_MHz * 1000000 ] \
+] $S_AXI
+set M_AXI [ create_bd_intf_port -mode Master -vlnv xilinx.com:interface:aximm_rtl:1.0 M_AXI ]
+set_property -dict [ list \
+ CONFIG.PROTOCOL {AXI4LITE} \
+ CONFIG.ADDR_WIDTH {32} \
+ CONFIG.DATA_WIDTH {32} \
+ CONFIG.FREQ_HZ [ expr $s_axi_freq_MHz * 1000000 ] \
+] $M_AXI
+set s_axi_aclk [ create_bd_port -dir I -type clk -freq_hz [ expr $s_axi_freq_MHz * 1000000 ] s_axi_aclk ]
+set_property -dict [ list CONFIG.ASSOCIATED_BUSIF {S_AXI:M_AXI} CONFIG.ASSOCIATED_RESET {s_axi_aresetn} ] $s_axi_aclk
+set s_axi_aresetn [ create_bd_port -dir I -type rst s_axi_aresetn ]
+set x_heep_rst [ create_bd_port -dir O -from 0 -to 0 x_heep_rst ]
+
+# Create interface connections
+connect_bd_intf_net -intf_net S_AXI_1 [ get_bd_intf_ports S_AXI ] [ get_bd_intf_pins axi_interconnect_0/S00_AXI ]
+connect_bd_intf_net -intf_net axi_interconnect_0_M00_AXI [ get_bd_intf_pins axi_interconnect_0/M00_AXI ] [ get_bd_intf_pins processing_system7_0/S_AXI_HP0 ]
+connect_bd_intf_net -intf_net processing_system7_0_M_AXI_GP0 [ get_bd_intf_pins processing_system7_0/M_AXI_GP0 ] [ get_bd_intf_pins axi_interconnect_1/S00_AXI ]
+connect_bd_intf_net -intf_net axi_interconnect_1_M00_AXI [ get_bd_intf_pins axi_interconnect_1/M00_AXI ] [ get_bd_intf_ports M_AXI ]
+
+# Create port connections
+connect_bd_net -net s_axi_aclk_1 [ get_bd_ports s_axi_aclk ] \
+ [ get_bd_pins axi_interconnect_0/ACLK ] [ get_bd_pins axi_interconnect_0/S00_ACLK ] \
+ [ get_bd_pins axi_interconnect_0/M00_ACLK ] [ get_bd_pins processing_system7_0/S_AXI_HP0_ACLK ] \
+ [ get_bd_pins axi_interconnect_1/ACLK ] [ get_bd_pins axi_interconnect_1/S00_ACLK ] \
+ [ get_bd_pins axi_interconnect_1/M00_ACLK ] [ get_bd_pins processing_system7_0/M_AXI_GP0_ACLK ]
+connect_bd_net -net s_axi_aresetn_1 [ get_bd_ports s_axi_aresetn ] \
+ [ get_bd_pins axi_interconnect_0/ARESETN ] [ get_bd_pins axi_interconnect_0/S00_ARESETN ] \
+ [ get_bd_pins axi_interconnect_0/M00_ARESETN ] \
+ [ get_bd_pins axi_interconnect_1/ARESETN ] [ get_bd_pins axi_interconnect_1/S00_ARESETN ] \
+ [ get_bd_pins axi_interconnect_1/M00_ARESETN ]
+connect_bd_net -net processing_system7_0_GPIO_O [ get_bd_pins processing_system7_0/GPIO_O ] [ get_bd_ports x_heep_rst ]
+
+# The whole DDR is visible, obi_to_axi adds the base of the window (PS_DDR_BASE)
+assign_bd_address -offset 0x00000000 -range 512M [ get_bd_addr_segs processing_system7_0/S_AXI_HP0/HP0_DDR_LOWOCM ]
+# X-HEEP from 0x0 to 0x3FFFFFFF (RAM and peripherals), axi_lite_to_obi removes the offset
+assign_bd_address -offset 0x40000000 -range 1G [ get_bd_addr_segs M_AXI/Reg ]
+
+# Save and close block design
+validate_bd_design
+save_bd_design
+close_bd_design $design_name
+
+# create wrapper
+set wrapper_path [ make_wrapper -fileset sources_1 -files [ get_files -norecurse xilinx_ps_ddr.bd ] -top ]
+add_files -norecurse -fileset sources_1 $wrapper_path
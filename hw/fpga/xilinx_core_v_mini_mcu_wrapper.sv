@@ -10,7 +10,9 @@ module xilinx_core_v_mini_mcu_wrapper
     parameter FPU                  = 0,
     parameter ZFINX                = 0,
     parameter X_EXT                = 0,  // eXtension interface in cv32e40x
-    parameter CLK_LED_COUNT_LENGTH = 27
+    parameter CLK_LED_COUNT_LENGTH = 27,
+    // DDR address of the external slave region (FPGA_PS_DDR)
+    parameter logic [31:0] PS_DDR_BASE = 32'h18000000
 ) (
 
     inout logic clk_i,
@@ -60,6 +62,31 @@ module xilinx_core_v_mini_mcu_wrapper
     inout logic i2s_ws_io,
     inout logic i2s_sd_io
 
+`ifdef FPGA_PS_DDR
+    ,
+    // Zynq PS, whose DDR is the external slave region
+    inout wire [14:0] DDR_addr,
+    inout wire [2:0] DDR_ba,
+    inout wire DDR_cas_n,
+    inout wire DDR_ck_n,
+    inout wire DDR_ck_p,
+    inout wire DDR_cke,
+    inout wire DDR_cs_n,
+    inout wire [3:0] DDR_dm,
+    inout wire [31:0] DDR_dq,
+    inout wire [3:0] DDR_dqs_n,
+    inout wire [3:0] DDR_dqs_p,
+    inout wire DDR_odt,
+    inout wire DDR_ras_n,
+    inout wire DDR_reset_n,
+    inout wire DDR_we_n,
+    inout wire FIXED_IO_ddr_vrn,
+    inout wire FIXED_IO_ddr_vrp,
+    inout wire [53:0] FIXED_IO_mio,
+    inout wire FIXED_IO_ps_clk,
+    inout wire FIXED_IO_ps_porb,
+    inout wire FIXED_IO_ps_srstb
+`endif
 );
 
   wire                               clk_gen;
@@ -70,6 +97,10 @@ module xilinx_core_v_mini_mcu_wrapper
   // low active reset
 `ifdef FPGA_NEXYS
   assign rst_n = rst_i;
+`elsif FPGA_PS_DDR
+  // also held by the PS while util/ps_loader.py restarts X-HEEP
+  logic [0:0] ps_rst;
+  assign rst_n = !rst_i && !ps_rst[0];
 `else
   assign rst_n = !rst_i;
 `endif
@@ -103,11 +134,28 @@ module xilinx_core_v_mini_mcu_wrapper
       .clk_out1_0(clk_gen)
   );
 
+  // Master of the system crossbar driven by the PS (FPGA_PS_DDR)
+`ifdef FPGA_PS_DDR
+  localparam int unsigned EXT_XBAR_NMASTER = 1;
+`else
+  localparam int unsigned EXT_XBAR_NMASTER = 0;
+`endif
+
+  obi_req_t  ps_master_req;
+  obi_resp_t ps_master_resp;
+
+  // Masters of the external slave region
+  localparam int unsigned EXT_NPORTS = 3 + 3 * core_v_mini_mcu_pkg::DMA_CH_NUM;
+
+  obi_req_t  [EXT_NPORTS-1:0] ext_req;
+  obi_resp_t [EXT_NPORTS-1:0] ext_resp;
+
   x_heep_system #(
       .X_EXT(X_EXT),
       .COREV_PULP(COREV_PULP),
       .FPU(FPU),
-      .ZFINX(ZFINX)
+      .ZFINX(ZFINX),
+      .EXT_XBAR_NMASTER(EXT_XBAR_NMASTER)
   ) x_heep_system_i (
       .intr_vector_ext_i('0),
       .xif_compressed_if(ext_if),
@@ -116,20 +164,20 @@ module xilinx_core_v_mini_mcu_wrapper
       .xif_mem_if(ext_if),
       .xif_mem_result_if(ext_if),
       .xif_result_if(ext_if),
-      .ext_xbar_master_req_i('0),
-      .ext_xbar_master_resp_o(),
-      .ext_core_instr_req_o(),
-      .ext_core_instr_resp_i('0),
-      .ext_core_data_req_o(),
-      .ext_core_data_resp_i('0),
-      .ext_debug_master_req_o(),
-      .ext_debug_master_resp_i('0),
-      .ext_dma_read_ch0_req_o(),
-      .ext_dma_read_ch0_resp_i('0),
-      .ext_dma_write_ch0_req_o(),
-      .ext_dma_write_ch0_resp_i('0),
-      .ext_dma_addr_ch0_req_o(),
-      .ext_dma_addr_ch0_resp_i('0),
+      .ext_xbar_master_req_i(ps_master_req),
+      .ext_xbar_master_resp_o(ps_master_resp),
+      .ext_core_instr_req_o(ext_req[0]),
+      .ext_core_instr_resp_i(ext_resp[0]),
+      .ext_core_data_req_o(ext_req[1]),
+      .ext_core_data_resp_i(ext_resp[1]),
+      .ext_debug_master_req_o(ext_req[2]),
+      .ext_debug_master_resp_i(ext_resp[2]),
+      .ext_dma_read_req_o(ext_req[3+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
+      .ext_dma_read_resp_i(ext_resp[3+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
+      .ext_dma_write_req_o(ext_req[3+core_v_mini_mcu_pkg::DMA_CH_NUM+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
+      .ext_dma_write_resp_i(ext_resp[3+core_v_mini_mcu_pkg::DMA_CH_NUM+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
+      .ext_dma_addr_req_o(ext_req[3+2*core_v_mini_mcu_pkg::DMA_CH_NUM+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
+      .ext_dma_addr_resp_i(ext_resp[3+2*core_v_mini_mcu_pkg::DMA_CH_NUM+:core_v_mini_mcu_pkg::DMA_CH_NUM]),
       .ext_peripheral_slave_req_o(),
       .ext_peripheral_slave_resp_i('0),
       .external_subsystem_powergate_switch_no(),
@@ -203,5 +251,171 @@ module xilinx_core_v_mini_mcu_wrapper
 
   assign exit_value_o = exit_value[0];
 
+`ifdef FPGA_PS_DDR
+  logic [31:0] s_axi_awaddr, s_axi_wdata, s_axi_araddr, s_axi_rdata;
+  logic [7:0] s_axi_awlen, s_axi_arlen;
+  logic [3:0] s_axi_awcache, s_axi_wstrb, s_axi_arcache;
+  logic [2:0] s_axi_awsize, s_axi_awprot, s_axi_arsize, s_axi_arprot;
+  logic [1:0] s_axi_awburst, s_axi_bresp, s_axi_arburst, s_axi_rresp;
+  logic s_axi_awvalid, s_axi_awready, s_axi_wlast, s_axi_wvalid, s_axi_wready;
+  logic s_axi_bvalid, s_axi_bready, s_axi_arvalid, s_axi_arready;
+  logic s_axi_rlast, s_axi_rvalid, s_axi_rready;
+
+  // The external slave region is mapped on the DDR from PS_DDR_BASE
+  obi_to_axi #(
+      .NumPorts  (EXT_NPORTS),
+      .AddrOffset(PS_DDR_BASE - core_v_mini_mcu_pkg::EXT_SLAVE_START_ADDRESS)
+  ) obi_to_axi_i (
+      .clk_i(clk_gen),
+      .rst_ni(rst_n),
+      .obi_req_i(ext_req),
+      .obi_resp_o(ext_resp),
+      .m_axi_awaddr_o(s_axi_awaddr),
+      .m_axi_awlen_o(s_axi_awlen),
+      .m_axi_awsize_o(s_axi_awsize),
+      .m_axi_awburst_o(s_axi_awburst),
+      .m_axi_awcache_o(s_axi_awcache),
+      .m_axi_awprot_o(s_axi_awprot),
+      .m_axi_awvalid_o(s_axi_awvalid),
+      .m_axi_awready_i(s_axi_awready),
+      .m_axi_wdata_o(s_axi_wdata),
+      .m_axi_wstrb_o(s_axi_wstrb),
+      .m_axi_wlast_o(s_axi_wlast),
+      .m_axi_wvalid_o(s_axi_wvalid),
+      .m_axi_wready_i(s_axi_wready),
+      .m_axi_bresp_i(s_axi_bresp),
+      .m_axi_bvalid_i(s_axi_bvalid),
+      .m_axi_bready_o(s_axi_bready),
+      .m_axi_araddr_o(s_axi_araddr),
+      .m_axi_arlen_o(s_axi_arlen),
+      .m_axi_arsize_o(s_axi_arsize),
+      .m_axi_arburst_o(s_axi_arburst),
+      .m_axi_arcache_o(s_axi_arcache),
+      .m_axi_arprot_o(s_axi_arprot),
+      .m_axi_arvalid_o(s_axi_arvalid),
+      .m_axi_arready_i(s_axi_arready),
+      .m_axi_rdata_i(s_axi_rdata),
+      .m_axi_rresp_i(s_axi_rresp),
+      .m_axi_rlast_i(s_axi_rlast),
+      .m_axi_rvalid_i(s_axi_rvalid),
+      .m_axi_rready_o(s_axi_rready)
+  );
+
+  logic [31:0] m_axi_awaddr, m_axi_wdata, m_axi_araddr, m_axi_rdata;
+  logic [3:0] m_axi_wstrb;
+  logic [2:0] m_axi_awprot, m_axi_arprot;
+  logic [1:0] m_axi_bresp, m_axi_rresp;
+  logic m_axi_awvalid, m_axi_awready, m_axi_wvalid, m_axi_wready;
+  logic m_axi_bvalid, m_axi_bready, m_axi_arvalid, m_axi_arready;
+  logic m_axi_rvalid, m_axi_rready;
+
+  // The PS sees X-HEEP from 0x40000000
+  axi_lite_to_obi #(
+      .AddrMask(32'h3FFFFFFF)
+  ) axi_lite_to_obi_i (
+      .clk_i(clk_gen),
+      .rst_ni(rst_n),
+      .s_axi_awaddr_i(m_axi_awaddr),
+      .s_axi_awvalid_i(m_axi_awvalid),
+      .s_axi_awready_o(m_axi_awready),
+      .s_axi_wdata_i(m_axi_wdata),
+      .s_axi_wstrb_i(m_axi_wstrb),
+      .s_axi_wvalid_i(m_axi_wvalid),
+      .s_axi_wready_o(m_axi_wready),
+      .s_axi_bresp_o(m_axi_bresp),
+      .s_axi_bvalid_o(m_axi_bvalid),
+      .s_axi_bready_i(m_axi_bready),
+      .s_axi_araddr_i(m_axi_araddr),
+      .s_axi_arvalid_i(m_axi_arvalid),
+      .s_axi_arready_o(m_axi_arready),
+      .s_axi_rdata_o(m_axi_rdata),
+      .s_axi_rresp_o(m_axi_rresp),
+      .s_axi_rvalid_o(m_axi_rvalid),
+      .s_axi_rready_i(m_axi_rready),
+      .obi_req_o(ps_master_req),
+      .obi_resp_i(ps_master_resp)
+  );
+
+  // Zynq PS block design (hw/fpga/scripts/pynq-z2/xilinx_generate_ps_ddr.tcl)
+  xilinx_ps_ddr_wrapper xilinx_ps_ddr_wrapper_i (
+      .DDR_addr,
+      .DDR_ba,
+      .DDR_cas_n,
+      .DDR_ck_n,
+      .DDR_ck_p,
+      .DDR_cke,
+      .DDR_cs_n,
+      .DDR_dm,
+      .DDR_dq,
+      .DDR_dqs_n,
+      .DDR_dqs_p,
+      .DDR_odt,
+      .DDR_ras_n,
+      .DDR_reset_n,
+      .DDR_we_n,
+      .FIXED_IO_ddr_vrn,
+      .FIXED_IO_ddr_vrp,
+      .FIXED_IO_mio,
+      .FIXED_IO_ps_clk,
+      .FIXED_IO_ps_porb,
+      .FIXED_IO_ps_srstb,
+      .s_axi_aclk(clk_gen),
+      .s_axi_aresetn(rst_n),
+      .S_AXI_awaddr(s_axi_awaddr),
+      .S_AXI_awlen(s_axi_awlen),
+      .S_AXI_awsize(s_axi_awsize),
+      .S_AXI_awburst(s_axi_awburst),
+      .S_AXI_awcache(s_axi_awcache),
+      .S_AXI_awprot(s_axi_awprot),
+      .S_AXI_awvalid(s_axi_awvalid),
+      .S_AXI_awready(s_axi_awready),
+      .S_AXI_wdata(s_axi_wdata),
+      .S_AXI_wstrb(s_axi_wstrb),
+      .S_AXI_wlast(s_axi_wlast),
+      .S_AXI_wvalid(s_axi_wvalid),
+      .S_AXI_wready(s_axi_wready),
+      .S_AXI_bresp(s_axi_bresp),
+      .S_AXI_bvalid(s_axi_bvalid),
+      .S_AXI_bready(s_axi_bready),
+      .S_AXI_araddr(s_axi_araddr),
+      .S_AXI_arlen(s_axi_arlen),
+      .S_AXI_arsize(s_axi_arsize),
+      .S_AXI_arburst(s_axi_arburst),
+      .S_AXI_arcache(s_axi_arcache),
+      .S_AXI_arprot(s_axi_arprot),
+      .S_AXI_arvalid(s_axi_arvalid),
+      .S_AXI_arready(s_axi_arready),
+      .S_AXI_rdata(s_axi_rdata),
+      .S_AXI_rresp(s_axi_rresp),
+      .S_AXI_rlast(s_axi_rlast),
+      .S_AXI_rvalid(s_axi_rvalid),
+      .S_AXI_rready(s_axi_rready),
+      .M_AXI_awaddr(m_axi_awaddr),
+      .M_AXI_awprot(m_axi_awprot),
+      .M_AXI_awvalid(m_axi_awvalid),
+      .M_AXI_awready(m_axi_awready),
+      .M_AXI_wdata(m_axi_wdata),
+      .M_AXI_wstrb(m_axi_wstrb),
+      .M_AXI_wvalid(m_axi_wvalid),
+      .M_AXI_wready(m_axi_wready),
+      .M_AXI_bresp(m_axi_bresp),
+      .M_AXI_bvalid(m_axi_bvalid),
+      .M_AXI_bready(m_axi_bready),
+      .M_AXI_araddr(m_axi_araddr),
+      .M_AXI_arprot(m_axi_arprot),
+      .M_AXI_arvalid(m_axi_arvalid),
+      .M_AXI_arready(m_axi_arready),
+      .M_AXI_rdata(m_axi_rdata),
+      .M_AXI_rresp(m_axi_rresp),
+      .M_AXI_rvalid(m_axi_rvalid),
+      .M_AXI_rready(m_axi_rready),
+      .x_heep_rst(ps_rst)
+  );
+`else
+  // Nothing in the external slave region, no master on the crossbar
+  assign ext_resp = '0;
+  assign ps_master_req = '0;
+`endif
+
 
 endmodule
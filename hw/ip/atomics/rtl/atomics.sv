@@ -0,0 +1,145 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Atomic unit of the always-on peripherals. It holds NUM_WORDS words and
+// performs an operation on a word in the single access that reads or writes
+// it, so the interrupts, the DMA and the harts can share counters, locks and
+// the indices of rings without masking the interrupts (cv32e20 has no A
+// extension). The operation is encoded in the address, in bytes:
+//   0x000 + 4 * w VALUE     read the word, write it
+//   0x080 + 4 * w TAS       read the word and set it to 1 (test-and-set)
+//   0x100 + 4 * w FETCH_INC read the word and increment it
+//   0x180 + 4 * w FETCH_DEC read the word and decrement it
+//   0x200 + 4 * w ADD       write: add the data to the word; read the word
+//   0x280 + 4 * w CAS       read: 1 and the word set to CAS_NEW if the word
+//                           is CAS_EXPECT and the CAS is armed, else 0
+//   0x300         CAS_EXPECT write: arm the CAS and set its expected value
+//   0x304         CAS_NEW   the value swapped in by the CAS
+// The compare-and-swap needs its operands before the read of CAS, so a CAS
+// read disarms it: a CAS interrupted by another CAS between its CAS_EXPECT
+// write and its CAS read fails and is retried. The writes of TAS, FETCH_INC,
+// FETCH_DEC, CAS and the other addresses return an error. The words are
+// cleared at reset.
+//
+// The unit has no data/atomics.hjson: the side effect of a read depends on
+// the address window of the operation, which reggen cannot describe, so the
+// decoder is written below and atomics_regs.h is written by hand to match it.
+
+module atomics #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    // At most 32
+    parameter int unsigned NUM_WORDS = 16
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o
+);
+
+  localparam int unsigned WordIdxW = NUM_WORDS > 1 ? $clog2(NUM_WORDS) : 1;
+
+  localparam logic [2:0] OpValue = 3'd0;
+  localparam logic [2:0] OpTas = 3'd1;
+  localparam logic [2:0] OpFetchInc = 3'd2;
+  localparam logic [2:0] OpFetchDec = 3'd3;
+  localparam logic [2:0] OpAdd = 3'd4;
+  localparam logic [2:0] OpCas = 3'd5;
+  localparam logic [2:0] OpCasOperands = 3'd6;
+
+  logic [NUM_WORDS-1:0][31:0] words_q;
+  logic cas_armed_q;
+  logic [31:0] cas_expect_q, cas_new_q;
+
+  logic [9:0] reg_addr;
+  logic [2:0] op;
+  logic [WordIdxW-1:0] word_idx;
+  logic word_valid;
+  logic reg_we;
+  logic [31:0] word;
+  logic cas_hit;
+  logic [31:0] reg_rdata;
+  logic reg_error;
+
+  // Register interface, without wait states: each valid cycle is an access
+  assign reg_addr = reg_req_i.addr[9:0];
+  assign op = reg_addr[9:7];
+  assign word_idx = WordIdxW'(reg_addr[6:2]);
+  assign word_valid = 32'(reg_addr[6:2]) < NUM_WORDS;
+  assign reg_we = reg_req_i.valid && reg_req_i.write;
+
+  assign word = words_q[word_idx];
+  assign cas_hit = cas_armed_q && word == cas_expect_q;
+
+  always_comb begin
+    reg_rdata = '0;
+    reg_error = 1'b0;
+    unique case (op)
+      OpValue, OpAdd: begin
+        reg_rdata = word;
+        reg_error = !word_valid;
+      end
+      OpTas, OpFetchInc, OpFetchDec: begin
+        reg_rdata = word;
+        reg_error = !word_valid || reg_req_i.write;
+      end
+      OpCas: begin
+        reg_rdata = 32'(cas_hit);
+        reg_error = !word_valid || reg_req_i.write;
+      end
+      OpCasOperands: begin
+        reg_rdata = reg_addr[2] ? cas_new_q : cas_expect_q;
+        reg_error = reg_addr[6:3] != '0;
+      end
+      default: begin
+        reg_error = 1'b1;
+      end
+    endcase
+  end
+
+  assign reg_rsp_o.rdata = reg_rdata;
+  assign reg_rsp_o.error = reg_req_i.valid && reg_error;
+  assign reg_rsp_o.ready = 1'b1;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      words_q      <= '0;
+      cas_armed_q  <= 1'b0;
+      cas_expect_q <= '0;
+      cas_new_q    <= '0;
+    end else if (reg_req_i.valid && !reg_error) begin
+      unique case (op)
+        OpValue: begin
+          if (reg_we) words_q[word_idx] <= reg_req_i.wdata;
+        end
+        OpTas: begin
+          words_q[word_idx] <= 32'd1;
+        end
+        OpFetchInc: begin
+          words_q[word_idx] <= word + 32'd1;
+        end
+        OpFetchDec: begin
+          words_q[word_idx] <= word - 32'd1;
+        end
+        OpAdd: begin
+          if (reg_we) words_q[word_idx] <= word + reg_req_i.wdata;
+        end
+        OpCas: begin
+          if (cas_hit) words_q[word_idx] <= cas_new_q;
+          cas_armed_q <= 1'b0;
+        end
+        OpCasOperands: begin
+          if (reg_we && !reg_addr[2]) begin
+            cas_expect_q <= reg_req_i.wdata;
+            cas_armed_q  <= 1'b1;
+          end
+          if (reg_we && reg_addr[2]) cas_new_q <= reg_req_i.wdata;
+        end
+        default: ;
+      endcase
+    end
+  end
+
+endmodule  // atomics
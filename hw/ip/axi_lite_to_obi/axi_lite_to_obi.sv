@@ -0,0 +1,125 @@
+// Copyright 2022 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+/*
+  Bridge from an AXI4-Lite slave port to an OBI master of the system crossbar,
+  used by the SPI slave (obi_spi_slave) and on the Pynq-Z2 to let the Zynq PS
+  load and run the programs of X-HEEP (util/ps_loader.py). One access at a
+  time, reads and writes alternate when both are pending. The OBI address is
+  the AXI one masked with AddrMask, e.g. the offset in the window the PS sees
+  X-HEEP through.
+*/
+
+module axi_lite_to_obi
+  import obi_pkg::*;
+#(
+    parameter logic [31:0] AddrMask = 32'h3FFFFFFF
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // AXI4-Lite slave
+    input  logic [31:0] s_axi_awaddr_i,
+    input  logic        s_axi_awvalid_i,
+    output logic        s_axi_awready_o,
+    input  logic [31:0] s_axi_wdata_i,
+    input  logic [ 3:0] s_axi_wstrb_i,
+    input  logic        s_axi_wvalid_i,
+    output logic        s_axi_wready_o,
+    output logic [ 1:0] s_axi_bresp_o,
+    output logic        s_axi_bvalid_o,
+    input  logic        s_axi_bready_i,
+    input  logic [31:0] s_axi_araddr_i,
+    input  logic        s_axi_arvalid_i,
+    output logic        s_axi_arready_o,
+    output logic [31:0] s_axi_rdata_o,
+    output logic [ 1:0] s_axi_rresp_o,
+    output logic        s_axi_rvalid_o,
+    input  logic        s_axi_rready_i,
+
+    output obi_req_t  obi_req_o,
+    input  obi_resp_t obi_resp_i
+);
+
+  typedef enum logic [2:0] {
+    IDLE,
+    REQ,
+    WAIT_RVALID,
+    WRITE_RESP,
+    READ_RESP
+  } axi_lite_to_obi_fsm_e;
+
+  axi_lite_to_obi_fsm_e state_q, state_n;
+
+  logic write_pending, read_pending, start_write, start_read;
+  logic last_write_q;
+  logic we_q;
+  logic [31:0] addr_q, wdata_q, rdata_q;
+  logic [3:0] be_q;
+
+  assign write_pending = s_axi_awvalid_i && s_axi_wvalid_i;
+  assign read_pending = s_axi_arvalid_i;
+  assign start_write = state_q == IDLE && write_pending && (!read_pending || !last_write_q);
+  assign start_read = state_q == IDLE && read_pending && !start_write;
+
+  // The address and the data of a write are taken together
+  assign s_axi_awready_o = start_write;
+  assign s_axi_wready_o = start_write;
+  assign s_axi_arready_o = start_read;
+
+  always_comb begin
+    state_n = state_q;
+    unique case (state_q)
+      IDLE: if (start_write || start_read) state_n = REQ;
+      REQ: if (obi_resp_i.gnt) state_n = obi_resp_i.rvalid ? (we_q ? WRITE_RESP : READ_RESP) : WAIT_RVALID;
+      WAIT_RVALID: if (obi_resp_i.rvalid) state_n = we_q ? WRITE_RESP : READ_RESP;
+      WRITE_RESP: if (s_axi_bready_i) state_n = IDLE;
+      READ_RESP: if (s_axi_rready_i) state_n = IDLE;
+      default: state_n = IDLE;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      state_q      <= IDLE;
+      last_write_q <= 1'b0;
+      we_q         <= 1'b0;
+      addr_q       <= '0;
+      wdata_q      <= '0;
+      be_q         <= '0;
+      rdata_q      <= '0;
+    end else begin
+      state_q <= state_n;
+      if (start_write) begin
+        last_write_q <= 1'b1;
+        we_q         <= 1'b1;
+        addr_q       <= s_axi_awaddr_i & AddrMask;
+        wdata_q      <= s_axi_wdata_i;
+        be_q         <= s_axi_wstrb_i;
+      end else if (start_read) begin
+        last_write_q <= 1'b0;
+        we_q         <= 1'b0;
+        addr_q       <= s_axi_araddr_i & AddrMask;
+        be_q         <= 4'b1111;
+      end
+      if ((state_q == REQ || state_q == WAIT_RVALID) && obi_resp_i.rvalid) begin
+        rdata_q <= obi_resp_i.rdata;
+      end
+    end
+  end
+
+  assign obi_req_o.req = state_q == REQ;
+  assign obi_req_o.we = we_q;
+  assign obi_req_o.be = be_q;
+  assign obi_req_o.addr = {addr_q[31:2], 2'b00};
+  assign obi_req_o.wdata = wdata_q;
+
+  // OBI reports no error, the bus error slave answers reads with 0
+  assign s_axi_bresp_o = 2'b00;
+  assign s_axi_bvalid_o = state_q == WRITE_RESP;
+  assign s_axi_rdata_o = rdata_q;
+  assign s_axi_rresp_o = 2'b00;
+  assign s_axi_rvalid_o = state_q == READ_RESP;
+
+endmodule : axi_lite_to_obi
@@ -1,16 +1,30 @@
 // Auto-generated code
 
-const int reset_vec_size = 59;
+const int reset_vec_size = 138;
 
 uint32_t reset_vec[reset_vec_size] = {
     0x200405b7,
     0x0005c503,
     0x41c8c119,
     0x05b79502,
-    0xc5032000,
+    0x41a82000,
+    0x57415637,
+    0x24d60613,
+    0x02c51763,
+    0x470145b4,
+    0x478196ba,
+    0x00d70a63,
+    0x96134308,
+    0x83ed0057,
+    0x97aa8fd1,
+    0xb7fd0711,
+    0x146345e8,
+    0x41e800f5,
+    0xa0239502,
+    0xc5030405,
     0xe5110085,
     0x00c5c503,
-    0x498cd175,
+    0x498cd555,
     0xc5039582,
     0xc9110145,
     0x200285b7,
@@ -24,42 +38,107 @@ uint32_t reset_vec[reset_vec_size] = {
     0x0fff0737,
     0xcd980705,
     0xd1884501,
-    0x77134998,
-    0x6713f007,
-    0xc9980087,
     0x0ab00713,
     0x0737d5d8,
     0x070d1000,
     0x49d8d1d8,
     0xfe075fe3,
-    0xd5d8470d,
+    0x70010737,
+    0xd5d8070d,
     0x49d80001,
     0xfe075fe3,
     0x11000737,
     0xd1d8070d,
-    0x49dc0001,
-    0xfe07dfe3,
-    0x40000693,
-    0x0b134481,
-    0x04371000,
-    0x0a930900,
-    0x46630ff4,
-    0x043700db,
-    0x0a930800,
-    0xa2230ff4,
-    0x00010355,
+    0x49d80001,
+    0xfe075fe3,
+    0x08000737,
+    0xd1d8073d,
+    0x17000693,
+    0x01068613,
+    0x49d84281,
+    0x4ee3071e,
+    0x559cfe07,
+    0x92bec29c,
+    0x98e30691,
+    0x0493fec6,
+    0x43054000,
+    0x00029e63,
+    0xff06a703,
+    0x484257b7,
+    0x85878793,
+    0x00f71663,
+    0xff46a483,
+    0xff86a303,
+    0x070649d8,
+    0xfe074ee3,
+    0x01031713,
+    0x07b78341,
+    0x8f5d0fff,
+    0x5313cd98,
+    0x73130103,
+    0x470d0013,
+    0x06030863,
+    0x03500713,
+    0x0001d5d8,
+    0x5fe349d8,
+    0x0737fe07,
+    0xd1d81100,
+    0x49d80001,
+    0xfe075fe3,
+    0x08000737,
+    0x49d8d1d8,
+    0x8b058361,
+    0x559cff6d,
+    0x05000713,
+    0x0001d5d8,
+    0x5fe349d8,
+    0x0737fe07,
+    0xd1d81000,
+    0x0ff7f793,
+    0x0027e793,
+    0xe79307a2,
+    0xd5dc0317,
+    0x49d80001,
+    0xfe075fe3,
+    0x10000737,
+    0xd1d80705,
+    0x49d80001,
+    0xfe075fe3,
+    0x06b00713,
+    0x0001d5d8,
+    0x5fe349d8,
+    0x0737fe07,
+    0x070d1100,
+    0x0001d1d8,
+    0x00030a63,
+    0x5fe349d8,
+    0x0737fe07,
+    0x071d0500,
+    0x0001d1d8,
     0xdfe349dc,
-    0x8b93fe07,
-    0x49dc1004,
-    0x8b8583d1,
-    0x8613dfed,
-    0xa8830204,
-    0xa0230285,
-    0x04910114,
-    0xfec49be3,
-    0xff7493e3,
-    0xf0068693,
-    0x05b7f2e9,
-    0x49902000,
-    0x00009602
+    0x0537fe07,
+    0x87132006,
+    0xc1180285,
+    0x00052223,
+    0x40000713,
+    0x4711c958,
+    0x4705cd18,
+    0x07b7d558,
+    0xa0730008,
+    0xc5443047,
+    0x01a31413,
+    0x08000737,
+    0x9726177d,
+    0xd1c08c59,
+    0x10500073,
+    0x8b054918,
+    0xb073df65,
+    0x26233047,
+    0x2c230205,
+    0x07130005,
+    0xc9584040,
+    0x20070537,
+    0xc1584721,
+    0x200005b7,
+    0x96024990
 };
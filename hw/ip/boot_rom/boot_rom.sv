@@ -22,48 +22,113 @@ module boot_rom
 );
   import core_v_mini_mcu_pkg::*;
 
-  localparam int unsigned RomSize = 59;
+  localparam int unsigned RomSize = 138;
 
   logic [RomSize-1:0][31:0] mem;
   assign mem = {
-    32'h00009602,
-    32'h49902000,
-    32'h05b7f2e9,
-    32'hf0068693,
-    32'hff7493e3,
-    32'hfec49be3,
-    32'h04910114,
-    32'ha0230285,
-    32'ha8830204,
-    32'h8613dfed,
-    32'h8b8583d1,
-    32'h49dc1004,
-    32'h8b93fe07,
+    32'h96024990,
+    32'h200005b7,
+    32'hc1584721,
+    32'h20070537,
+    32'hc9584040,
+    32'h07130005,
+    32'h2c230205,
+    32'h26233047,
+    32'hb073df65,
+    32'h8b054918,
+    32'h10500073,
+    32'hd1c08c59,
+    32'h9726177d,
+    32'h08000737,
+    32'h01a31413,
+    32'hc5443047,
+    32'ha0730008,
+    32'h07b7d558,
+    32'h4705cd18,
+    32'h4711c958,
+    32'h40000713,
+    32'h00052223,
+    32'hc1180285,
+    32'h87132006,
+    32'h0537fe07,
     32'hdfe349dc,
-    32'h00010355,
-    32'ha2230ff4,
-    32'h0a930800,
-    32'h043700db,
-    32'h46630ff4,
-    32'h0a930900,
-    32'h04371000,
-    32'h0b134481,
-    32'h40000693,
-    32'hfe07dfe3,
-    32'h49dc0001,
+    32'h0001d1d8,
+    32'h071d0500,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h00030a63,
+    32'h0001d1d8,
+    32'h070d1100,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h0001d5d8,
+    32'h06b00713,
+    32'hfe075fe3,
+    32'h49d80001,
+    32'hd1d80705,
+    32'h10000737,
+    32'hfe075fe3,
+    32'h49d80001,
+    32'hd5dc0317,
+    32'he79307a2,
+    32'h0027e793,
+    32'h0ff7f793,
+    32'hd1d81000,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h0001d5d8,
+    32'h05000713,
+    32'h559cff6d,
+    32'h8b058361,
+    32'h49d8d1d8,
+    32'h08000737,
+    32'hfe075fe3,
+    32'h49d80001,
+    32'hd1d81100,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h0001d5d8,
+    32'h03500713,
+    32'h06030863,
+    32'h470d0013,
+    32'h73130103,
+    32'h5313cd98,
+    32'h8f5d0fff,
+    32'h07b78341,
+    32'h01031713,
+    32'hfe074ee3,
+    32'h070649d8,
+    32'hff86a303,
+    32'hff46a483,
+    32'h00f71663,
+    32'h85878793,
+    32'h484257b7,
+    32'hff06a703,
+    32'h00029e63,
+    32'h43054000,
+    32'h0493fec6,
+    32'h98e30691,
+    32'h92bec29c,
+    32'h559cfe07,
+    32'h4ee3071e,
+    32'h49d84281,
+    32'h01068613,
+    32'h17000693,
+    32'hd1d8073d,
+    32'h08000737,
+    32'hfe075fe3,
+    32'h49d80001,
     32'hd1d8070d,
     32'h11000737,
     32'hfe075fe3,
     32'h49d80001,
-    32'hd5d8470d,
+    32'hd5d8070d,
+    32'h70010737,
     32'hfe075fe3,
     32'h49d8d1d8,
     32'h070d1000,
     32'h0737d5d8,
     32'h0ab00713,
-    32'hc9980087,
-    32'h6713f007,
-    32'h77134998,
     32'hd1884501,
     32'hcd980705,
     32'h0fff0737,
@@ -77,10 +142,24 @@ module boot_rom
     32'h200285b7,
     32'hc9110145,
     32'hc5039582,
-    32'h498cd175,
+    32'h498cd555,
     32'h00c5c503,
     32'he5110085,
-    32'hc5032000,
+    32'hc5030405,
+    32'ha0239502,
+    32'h41e800f5,
+    32'h146345e8,
+    32'hb7fd0711,
+    32'h97aa8fd1,
+    32'h83ed0057,
+    32'h96134308,
+    32'h00d70a63,
+    32'h478196ba,
+    32'h470145b4,
+    32'h02c51763,
+    32'h24d60613,
+    32'h57415637,
+    32'h41a82000,
     32'h05b79502,
     32'h41c8c119,
     32'h0005c503,
@@ -0,0 +1,174 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Performance monitor of the system crossbar. It watches the OBI ports of
+// the masters (core instruction and data, debug, DMA read, write and address
+// of each channel, external masters) and of the slaves (error slave, RAM
+// banks, debug, always-on peripherals, peripherals, flash) and counts, for
+// each port:
+// - GRANTS: the requests granted, i.e. the transactions, as an OBI request is
+//   held until its grant;
+// - WAITS: the cycles a request waited for its grant;
+// - LATENCY: the cycles from the grant to the rvalid, summed over the
+//   transactions (the transactions in flight are added at each cycle), so
+//   that LATENCY / RVALIDS is the average latency;
+// - RVALIDS: the responses.
+//
+// The counters wrap around. They count while CTRL.ENABLE is set, which it is
+// at reset, and are cleared by writing 1 to CTRL.CLEAR. The registers are
+// described in data/bus_monitor.hjson; the counters are read through its
+// COUNTERS window, from 0x800 + 0x10 * m for master m and from
+// 0xC00 + 0x10 * s for slave s, GRANTS, WAITS, LATENCY and RVALIDS in this
+// order, in the order of the ports of system_xbar. The writes of the window
+// and its addresses past the last port return an error. With COUNTERS = 0
+// there is no counter and all the registers read 0.
+//
+// At the end of a simulation run with +bus_monitor, the counters are printed.
+
+module bus_monitor
+  import obi_pkg::*;
+#(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int unsigned NUM_MASTERS = 1,
+    parameter int unsigned NUM_SLAVES = 1,
+    parameter bit COUNTERS = 1'b1
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    input obi_req_t  [NUM_MASTERS-1:0] master_req_i,
+    input obi_resp_t [NUM_MASTERS-1:0] master_resp_i,
+    input obi_req_t  [ NUM_SLAVES-1:0] slave_req_i,
+    input obi_resp_t [ NUM_SLAVES-1:0] slave_resp_i
+);
+
+  localparam int unsigned NumPorts = NUM_MASTERS + NUM_SLAVES;
+  localparam int unsigned NumCounters = 4;
+  // The transactions in flight on a port, more than any master issues
+  localparam int unsigned OutstandingW = 8;
+
+  import bus_monitor_reg_pkg::*;
+
+  bus_monitor_reg2hw_t reg2hw;
+  bus_monitor_hw2reg_t hw2reg;
+
+  reg_req_t [0:0] counters_win_req;
+  reg_rsp_t [0:0] counters_win_rsp;
+
+  logic [NumPorts-1:0] port_req, port_gnt, port_rvalid;
+
+  logic enable_q;
+  logic clear;
+  logic [31:0] cycles_q;
+  logic [NumPorts-1:0][NumCounters-1:0][31:0] counters_q;
+  logic [NumPorts-1:0][OutstandingW-1:0] outstanding_q;
+
+  logic [$clog2(BUS_MONITOR_COUNTERS_SIZE)-1:0] win_addr;
+  logic [6:0] port_idx;
+  logic [1:0] counter_idx;
+  logic port_valid;
+
+  for (genvar m = 0; m < NUM_MASTERS; m++) begin : gen_master_ports
+    assign port_req[m]    = master_req_i[m].req;
+    assign port_gnt[m]    = master_resp_i[m].gnt;
+    assign port_rvalid[m] = master_resp_i[m].rvalid;
+  end
+
+  for (genvar s = 0; s < NUM_SLAVES; s++) begin : gen_slave_ports
+    assign port_req[NUM_MASTERS+s]    = slave_req_i[s].req;
+    assign port_gnt[NUM_MASTERS+s]    = slave_resp_i[s].gnt;
+    assign port_rvalid[NUM_MASTERS+s] = slave_resp_i[s].rvalid;
+  end
+
+  bus_monitor_reg_top #(
+      .reg_req_t(reg_req_t),
+      .reg_rsp_t(reg_rsp_t)
+  ) bus_monitor_reg_top_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i,
+      .reg_rsp_o,
+      .reg_req_win_o(counters_win_req),
+      .reg_rsp_win_i(counters_win_rsp),
+      .reg2hw,
+      .hw2reg,
+      .devmode_i(1'b1)
+  );
+
+  assign hw2reg.ctrl.enable.d = enable_q;
+  assign hw2reg.cycles.d = COUNTERS ? cycles_q : '0;
+  assign hw2reg.info.masters.d = COUNTERS ? 8'(NUM_MASTERS) : '0;
+  assign hw2reg.info.slaves.d = COUNTERS ? 8'(NUM_SLAVES) : '0;
+
+  assign clear = reg2hw.ctrl.clear.qe && reg2hw.ctrl.clear.q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      enable_q <= 1'b1;
+    end else if (reg2hw.ctrl.enable.qe) begin
+      enable_q <= reg2hw.ctrl.enable.q;
+    end
+  end
+
+  // COUNTERS window, without wait states: the masters in its first half and
+  // the slaves in its second half
+  assign win_addr = counters_win_req[0].addr[$clog2(BUS_MONITOR_COUNTERS_SIZE)-1:0];
+  assign counter_idx = win_addr[3:2];
+  assign port_idx = win_addr[10] ? 7'(NUM_MASTERS + 32'(win_addr[9:4])) : 7'(win_addr[9:4]);
+  assign port_valid = win_addr[10] ? 32'(win_addr[9:4]) < NUM_SLAVES : 32'(win_addr[9:4]) < NUM_MASTERS;
+
+  assign counters_win_rsp[0].rdata = COUNTERS && port_valid ? counters_q[port_idx][counter_idx] : '0;
+  assign counters_win_rsp[0].error = counters_win_req[0].valid && (counters_win_req[0].write || !port_valid);
+  assign counters_win_rsp[0].ready = 1'b1;
+
+  if (COUNTERS) begin : gen_counters
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) begin
+        cycles_q      <= '0;
+        counters_q    <= '0;
+        outstanding_q <= '0;
+      end else begin
+        // The transactions in flight are tracked even while disabled
+        for (int unsigned p = 0; p < NumPorts; p++) begin
+          outstanding_q[p] <= outstanding_q[p] + OutstandingW'(port_req[p] && port_gnt[p])
+                                               - OutstandingW'(port_rvalid[p]);
+        end
+        if (clear) begin
+          cycles_q   <= '0;
+          counters_q <= '0;
+        end else if (enable_q) begin
+          cycles_q <= cycles_q + 32'd1;
+          for (int unsigned p = 0; p < NumPorts; p++) begin
+            counters_q[p][0] <= counters_q[p][0] + 32'(port_req[p] && port_gnt[p]);
+            counters_q[p][1] <= counters_q[p][1] + 32'(port_req[p] && !port_gnt[p]);
+            counters_q[p][2] <= counters_q[p][2] + 32'(outstanding_q[p]);
+            counters_q[p][3] <= counters_q[p][3] + 32'(port_rvalid[p]);
+          end
+        end
+      end
+    end
+
+`ifndef SYNTHESIS
+    final begin
+      if ($test$plusargs("bus_monitor")) begin
+        $display("[BUS MONITOR] %0d cycles", cycles_q);
+        for (int unsigned p = 0; p < NumPorts; p++) begin
+          $display("[BUS MONITOR] %s %0d: grants %0d waits %0d latency %0d rvalids %0d",
+                   p < NUM_MASTERS ? "master" : "slave", p < NUM_MASTERS ? p : p - NUM_MASTERS,
+                   counters_q[p][0], counters_q[p][1], counters_q[p][2], counters_q[p][3]);
+        end
+      end
+    end
+`endif
+  end else begin : gen_no_counters
+    assign cycles_q      = '0;
+    assign counters_q    = '0;
+    assign outstanding_q = '0;
+  end
+
+endmodule  // bus_monitor
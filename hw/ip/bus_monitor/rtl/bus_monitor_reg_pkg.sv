@@ -0,0 +1,80 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Package auto-generated by `reggen` containing data structure
+
+package bus_monitor_reg_pkg;
+
+  // Address widths within the block
+  parameter int BlockAw = 12;
+
+  ////////////////////////////
+  // Typedefs for registers //
+  ////////////////////////////
+
+  typedef struct packed {
+    struct packed {
+      logic q;
+      logic qe;
+    } enable;
+    struct packed {
+      logic q;
+      logic qe;
+    } clear;
+  } bus_monitor_reg2hw_ctrl_reg_t;
+
+  typedef struct packed {
+    struct packed {logic d;} enable;
+  } bus_monitor_hw2reg_ctrl_reg_t;
+
+  typedef struct packed {logic [31:0] d;} bus_monitor_hw2reg_cycles_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [7:0] d;} masters;
+    struct packed {logic [7:0] d;} slaves;
+  } bus_monitor_hw2reg_info_reg_t;
+
+  // Register -> HW type
+  typedef struct packed {
+    bus_monitor_reg2hw_ctrl_reg_t ctrl;  // [3:0]
+  } bus_monitor_reg2hw_t;
+
+  // HW -> register type
+  typedef struct packed {
+    bus_monitor_hw2reg_ctrl_reg_t ctrl;  // [48:48]
+    bus_monitor_hw2reg_cycles_reg_t cycles;  // [47:16]
+    bus_monitor_hw2reg_info_reg_t info;  // [15:0]
+  } bus_monitor_hw2reg_t;
+
+  // Register offsets
+  parameter logic [BlockAw-1:0] BUS_MONITOR_CTRL_OFFSET = 12'h0;
+  parameter logic [BlockAw-1:0] BUS_MONITOR_CYCLES_OFFSET = 12'h4;
+  parameter logic [BlockAw-1:0] BUS_MONITOR_INFO_OFFSET = 12'h8;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [1:0] BUS_MONITOR_CTRL_RESVAL = 2'h1;
+  parameter logic [0:0] BUS_MONITOR_CTRL_ENABLE_RESVAL = 1'h1;
+  parameter logic [31:0] BUS_MONITOR_CYCLES_RESVAL = 32'h0;
+  parameter logic [15:0] BUS_MONITOR_INFO_RESVAL = 16'h0;
+
+  // Window parameters
+  parameter logic [BlockAw-1:0] BUS_MONITOR_COUNTERS_OFFSET = 12'h800;
+  parameter int unsigned BUS_MONITOR_COUNTERS_SIZE = 'h800;
+
+  // Register index
+  typedef enum int {
+    BUS_MONITOR_CTRL,
+    BUS_MONITOR_CYCLES,
+    BUS_MONITOR_INFO
+  } bus_monitor_id_e;
+
+  // Register width information to check illegal writes
+  parameter logic [3:0] BUS_MONITOR_PERMIT[3] = '{
+      4'b0001,  // index[0] BUS_MONITOR_CTRL
+      4'b1111,  // index[1] BUS_MONITOR_CYCLES
+      4'b0011  // index[2] BUS_MONITOR_INFO
+  };
+
+endpackage
+
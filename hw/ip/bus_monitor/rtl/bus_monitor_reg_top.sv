@@ -0,0 +1,335 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Top module auto-generated by `reggen`
+
+
+`include "common_cells/assertions.svh"
+
+module bus_monitor_reg_top #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int AW = 12
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // Output port for window
+    output reg_req_t [1-1:0] reg_req_win_o,
+    input  reg_rsp_t [1-1:0] reg_rsp_win_i,
+
+    // To HW
+    output bus_monitor_reg_pkg::bus_monitor_reg2hw_t reg2hw,  // Write
+    input  bus_monitor_reg_pkg::bus_monitor_hw2reg_t hw2reg,  // Read
+
+
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+
+  import bus_monitor_reg_pkg::*;
+
+  localparam int DW = 32;
+  localparam int DBW = DW / 8;  // Byte Width
+
+  // register signals
+  logic           reg_we;
+  logic           reg_re;
+  logic [ AW-1:0] reg_addr;
+  logic [ DW-1:0] reg_wdata;
+  logic [DBW-1:0] reg_be;
+  logic [ DW-1:0] reg_rdata;
+  logic           reg_error;
+
+  logic addrmiss, wr_err;
+
+  logic [DW-1:0] reg_rdata_next;
+
+  // Below register interface can be changed
+  reg_req_t reg_intf_req;
+  reg_rsp_t reg_intf_rsp;
+
+
+  logic [0:0] reg_steer;
+
+  reg_req_t [2-1:0] reg_intf_demux_req;
+  reg_rsp_t [2-1:0] reg_intf_demux_rsp;
+
+  // demux connection
+  assign reg_intf_req = reg_intf_demux_req[1];
+  assign reg_intf_demux_rsp[1] = reg_intf_rsp;
+
+  assign reg_req_win_o[0] = reg_intf_demux_req[0];
+  assign reg_intf_demux_rsp[0] = reg_rsp_win_i[0];
+
+  // Create Socket_1n
+  reg_demux #(
+      .NoPorts(2),
+      .req_t  (reg_req_t),
+      .rsp_t  (reg_rsp_t)
+  ) i_reg_demux (
+      .clk_i,
+      .rst_ni,
+      .in_req_i(reg_req_i),
+      .in_rsp_o(reg_rsp_o),
+      .out_req_o(reg_intf_demux_req),
+      .out_rsp_i(reg_intf_demux_rsp),
+      .in_select_i(reg_steer)
+  );
+
+
+  // Create steering logic
+  always_comb begin
+    reg_steer = 1;  // Default set to register
+
+    // TODO: Can below codes be unique case () inside ?
+    if (reg_req_i.addr[AW-1:0] >= 2048) begin
+      reg_steer = 0;
+    end
+  end
+
+
+  assign reg_we = reg_intf_req.valid & reg_intf_req.write;
+  assign reg_re = reg_intf_req.valid & ~reg_intf_req.write;
+  assign reg_addr = reg_intf_req.addr;
+  assign reg_wdata = reg_intf_req.wdata;
+  assign reg_be = reg_intf_req.wstrb;
+  assign reg_intf_rsp.rdata = reg_rdata;
+  assign reg_intf_rsp.error = reg_error;
+  assign reg_intf_rsp.ready = 1'b1;
+
+  assign reg_rdata = reg_rdata_next;
+  assign reg_error = (devmode_i & addrmiss) | wr_err;
+
+
+  // Define SW related signals
+  // Format: <reg>_<field>_{wd|we|qs}
+  //        or <reg>_{wd|we|qs} if field == 1 or 0
+  logic ctrl_enable_qs;
+  logic ctrl_enable_wd;
+  logic ctrl_enable_we;
+  logic ctrl_enable_re;
+  logic ctrl_clear_wd;
+  logic ctrl_clear_we;
+  logic [31:0] cycles_qs;
+  logic cycles_re;
+  logic [7:0] info_masters_qs;
+  logic info_masters_re;
+  logic [7:0] info_slaves_qs;
+  logic info_slaves_re;
+
+  // Register instances
+  // R[ctrl]: V(True)
+
+  //   F[enable]: 0:0
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_ctrl_enable (
+      .re (ctrl_enable_re),
+      .we (ctrl_enable_we),
+      .wd (ctrl_enable_wd),
+      .d  (hw2reg.ctrl.enable.d),
+      .qre(),
+      .qe (reg2hw.ctrl.enable.qe),
+      .q  (reg2hw.ctrl.enable.q),
+      .qs (ctrl_enable_qs)
+  );
+
+
+  //   F[clear]: 1:1
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_ctrl_clear (
+      .re (1'b0),
+      .we (ctrl_clear_we),
+      .wd (ctrl_clear_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.ctrl.clear.qe),
+      .q  (reg2hw.ctrl.clear.q),
+      .qs ()
+  );
+
+
+  // R[cycles]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_cycles (
+      .re (cycles_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.cycles.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (cycles_qs)
+  );
+
+
+  // R[info]: V(True)
+
+  //   F[masters]: 7:0
+  prim_subreg_ext #(
+      .DW(8)
+  ) u_info_masters (
+      .re (info_masters_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.info.masters.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (info_masters_qs)
+  );
+
+
+  //   F[slaves]: 15:8
+  prim_subreg_ext #(
+      .DW(8)
+  ) u_info_slaves (
+      .re (info_slaves_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.info.slaves.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (info_slaves_qs)
+  );
+
+
+
+
+  logic [2:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == BUS_MONITOR_CTRL_OFFSET);
+    addr_hit[1] = (reg_addr == BUS_MONITOR_CYCLES_OFFSET);
+    addr_hit[2] = (reg_addr == BUS_MONITOR_INFO_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[0] & (|(BUS_MONITOR_PERMIT[0] & ~reg_be))) |
+               (addr_hit[1] & (|(BUS_MONITOR_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(BUS_MONITOR_PERMIT[2] & ~reg_be)))));
+  end
+
+  assign ctrl_enable_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_enable_wd = reg_wdata[0];
+  assign ctrl_enable_re = addr_hit[0] & reg_re & !reg_error;
+
+  assign ctrl_clear_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_clear_wd = reg_wdata[1];
+
+  assign cycles_re = addr_hit[1] & reg_re & !reg_error;
+
+  assign info_masters_re = addr_hit[2] & reg_re & !reg_error;
+
+  assign info_slaves_re = addr_hit[2] & reg_re & !reg_error;
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[0] = ctrl_enable_qs;
+        reg_rdata_next[1] = '0;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[31:0] = cycles_qs;
+      end
+
+      addr_hit[2]: begin
+        reg_rdata_next[7:0]  = info_masters_qs;
+        reg_rdata_next[15:8] = info_slaves_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module bus_monitor_reg_top_intf #(
+    parameter  int AW = 12,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    REG_BUS.out regbus_win_mst[1-1:0],
+    // To HW
+    output bus_monitor_reg_pkg::bus_monitor_reg2hw_t reg2hw,  // Write
+    input bus_monitor_reg_pkg::bus_monitor_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+  reg_bus_req_t s_reg_win_req[1-1:0];
+  reg_bus_rsp_t s_reg_win_rsp[1-1:0];
+  for (genvar i = 0; i < 1; i++) begin : gen_assign_window_structs
+    `REG_BUS_ASSIGN_TO_REQ(s_reg_win_req[i], regbus_win_mst[i])
+    `REG_BUS_ASSIGN_FROM_RSP(regbus_win_mst[i], s_reg_win_rsp[i])
+  end
+
+
+
+  bus_monitor_reg_top #(
+      .reg_req_t(reg_bus_req_t),
+      .reg_rsp_t(reg_bus_rsp_t),
+      .AW(AW)
+  ) i_regs (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(s_reg_req),
+      .reg_rsp_o(s_reg_rsp),
+      .reg_req_win_o(s_reg_win_req),
+      .reg_rsp_win_i(s_reg_win_rsp),
+      .reg2hw,  // Write
+      .hw2reg,  // Read
+      .devmode_i
+  );
+
+endmodule
+
+
@@ -0,0 +1,169 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Description: CRC engine with a configurable polynomial, width (32, 16 or 8
+//              bits) and bit order. The data is written to DATA_WORD,
+//              DATA_HALF or DATA_BYTE, by the CPU or by the DMA paced on the
+//              ready_o trigger slot, and the engine processes BytesPerCycle
+//              bytes per cycle, the least significant byte first. While it
+//              holds bytes of the previous write, the accesses to the
+//              registers are stalled, so the data is never dropped and
+//              RESULT is always up to date.
+//
+//              A normal CRC of W bits is computed left-aligned in the 32-bit
+//              state, a reflected one right-aligned, with the polynomial and
+//              the initial value shifted or reflected accordingly, so that
+//              the same datapath serves all the widths.
+
+module crc #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    // Bytes processed per cycle (1, 2 or 4): 4 takes a word per cycle, less
+    // shortens the combinational path of the polynomial division
+    parameter int unsigned BytesPerCycle = 4
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // Register interface
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // DMA signal: a write to the data registers is accepted
+    output logic ready_o
+);
+
+  import crc_reg_pkg::*;
+
+  crc_reg2hw_t reg2hw;
+  crc_hw2reg_t hw2reg;
+
+  reg_req_t reg_req;
+  reg_rsp_t reg_rsp;
+
+  logic [31:0] state_d, state_q;
+  logic [31:0] data_d, data_q;
+  logic [2:0] bytes_d, bytes_q;
+  logic busy;
+
+  logic [4:0] shift;
+  logic reflect;
+  logic [31:0] poly_eff;
+  logic [31:0] init_eff;
+  logic [31:0] raw;
+
+  logic [31:0] in_data;
+  logic [2:0] in_bytes;
+  logic [2:0] n_bytes;
+
+  function automatic logic [31:0] reverse(logic [31:0] value);
+    for (int i = 0; i < 32; i++) begin
+      reverse[i] = value[31-i];
+    end
+  endfunction
+
+  function automatic logic [31:0] crc_byte(logic [31:0] crc, logic [7:0] data, logic [31:0] poly,
+                                           logic refl);
+    logic feedback;
+    for (int i = 0; i < 8; i++) begin
+      if (refl) begin
+        feedback = crc[0] ^ data[i];
+        crc = {1'b0, crc[31:1]} ^ (feedback ? poly : 32'h0);
+      end else begin
+        feedback = crc[31] ^ data[7-i];
+        crc = {crc[30:0], 1'b0} ^ (feedback ? poly : 32'h0);
+      end
+    end
+    return crc;
+  endfunction
+
+  // Stall every access while bytes are pending, they are processed in at most
+  // 4 / BytesPerCycle - 1 cycles
+  assign busy = bytes_q != '0;
+  assign ready_o = ~busy;
+
+  always_comb begin
+    reg_req = reg_req_i;
+    reg_req.valid = reg_req_i.valid & ~busy;
+    reg_rsp_o = reg_rsp;
+    reg_rsp_o.ready = reg_rsp.ready & ~busy;
+  end
+
+  crc_reg_top #(
+      .reg_req_t(reg_req_t),
+      .reg_rsp_t(reg_rsp_t)
+  ) crc_reg_top_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(reg_req),
+      .reg_rsp_o(reg_rsp),
+      .reg2hw,
+      .hw2reg,
+      .devmode_i(1'b1)
+  );
+
+  always_comb begin
+    unique case (reg2hw.ctrl.width.q)
+      2'd1: shift = 5'd16;
+      2'd2: shift = 5'd24;
+      default: shift = 5'd0;
+    endcase
+  end
+
+  assign reflect  = reg2hw.ctrl.reflect.q;
+  assign poly_eff = reflect ? reverse(reg2hw.poly.q) >> shift : reg2hw.poly.q << shift;
+  assign init_eff = reflect ? reverse(reg2hw.init.q) >> shift : reg2hw.init.q << shift;
+
+  // The result is read a cycle after the last byte at the earliest, through
+  // the stall, so it comes from the state
+  assign raw = reflect ? state_q : state_q >> shift;
+  assign hw2reg.result.d = (raw ^ reg2hw.xor_out.q) & (32'hFFFFFFFF >> shift);
+
+  // A write is only accepted without pending bytes: the engine takes its
+  // first bytes at once and keeps the rest
+  always_comb begin
+    in_data  = data_q;
+    in_bytes = bytes_q;
+    if (reg2hw.data_word.qe) begin
+      in_data  = reg2hw.data_word.q;
+      in_bytes = 3'd4;
+    end else if (reg2hw.data_half.qe) begin
+      in_data  = {16'h0, reg2hw.data_half.q};
+      in_bytes = 3'd2;
+    end else if (reg2hw.data_byte.qe) begin
+      in_data  = {24'h0, reg2hw.data_byte.q};
+      in_bytes = 3'd1;
+    end
+  end
+
+  assign n_bytes = in_bytes > 3'(BytesPerCycle) ? 3'(BytesPerCycle) : in_bytes;
+
+  always_comb begin
+    state_d = state_q;
+    for (int b = 0; b < BytesPerCycle; b++) begin
+      if (b < n_bytes) begin
+        state_d = crc_byte(state_d, in_data[8*b+:8], poly_eff, reflect);
+      end
+    end
+    if (reg2hw.init.qe) begin
+      state_d = init_eff;
+    end
+  end
+
+  assign data_d  = in_data >> (8 * BytesPerCycle);
+  assign bytes_d = in_bytes - n_bytes;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      state_q <= 32'hFFFFFFFF;
+      data_q  <= '0;
+      bytes_q <= '0;
+    end else begin
+      state_q <= state_d;
+      data_q  <= data_d;
+      bytes_q <= bytes_d;
+    end
+  end
+
+endmodule : crc
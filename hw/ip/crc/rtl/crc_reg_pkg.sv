@@ -0,0 +1,104 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Package auto-generated by `reggen` containing data structure
+
+package crc_reg_pkg;
+
+  // Address widths within the block
+  parameter int BlockAw = 5;
+
+  ////////////////////////////
+  // Typedefs for registers //
+  ////////////////////////////
+
+  typedef struct packed {
+    struct packed {logic [1:0] q;} width;
+    struct packed {logic q;} reflect;
+  } crc_reg2hw_ctrl_reg_t;
+
+  typedef struct packed {logic [31:0] q;} crc_reg2hw_poly_reg_t;
+
+  typedef struct packed {
+    logic [31:0] q;
+    logic        qe;
+  } crc_reg2hw_init_reg_t;
+
+  typedef struct packed {logic [31:0] q;} crc_reg2hw_xor_out_reg_t;
+
+  typedef struct packed {
+    logic [31:0] q;
+    logic        qe;
+  } crc_reg2hw_data_word_reg_t;
+
+  typedef struct packed {
+    logic [15:0] q;
+    logic        qe;
+  } crc_reg2hw_data_half_reg_t;
+
+  typedef struct packed {
+    logic [7:0] q;
+    logic       qe;
+  } crc_reg2hw_data_byte_reg_t;
+
+  typedef struct packed {logic [31:0] d;} crc_hw2reg_result_reg_t;
+
+  // Register -> HW type
+  typedef struct packed {
+    crc_reg2hw_ctrl_reg_t ctrl;  // [158:156]
+    crc_reg2hw_poly_reg_t poly;  // [155:124]
+    crc_reg2hw_init_reg_t init;  // [123:91]
+    crc_reg2hw_xor_out_reg_t xor_out;  // [90:59]
+    crc_reg2hw_data_word_reg_t data_word;  // [58:26]
+    crc_reg2hw_data_half_reg_t data_half;  // [25:9]
+    crc_reg2hw_data_byte_reg_t data_byte;  // [8:0]
+  } crc_reg2hw_t;
+
+  // HW -> register type
+  typedef struct packed {
+    crc_hw2reg_result_reg_t result;  // [31:0]
+  } crc_hw2reg_t;
+
+  // Register offsets
+  parameter logic [BlockAw-1:0] CRC_CTRL_OFFSET = 5'h0;
+  parameter logic [BlockAw-1:0] CRC_POLY_OFFSET = 5'h4;
+  parameter logic [BlockAw-1:0] CRC_INIT_OFFSET = 5'h8;
+  parameter logic [BlockAw-1:0] CRC_XOR_OUT_OFFSET = 5'hc;
+  parameter logic [BlockAw-1:0] CRC_DATA_WORD_OFFSET = 5'h10;
+  parameter logic [BlockAw-1:0] CRC_DATA_HALF_OFFSET = 5'h14;
+  parameter logic [BlockAw-1:0] CRC_DATA_BYTE_OFFSET = 5'h18;
+  parameter logic [BlockAw-1:0] CRC_RESULT_OFFSET = 5'h1c;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [31:0] CRC_DATA_WORD_RESVAL = 32'h0;
+  parameter logic [15:0] CRC_DATA_HALF_RESVAL = 16'h0;
+  parameter logic [7:0] CRC_DATA_BYTE_RESVAL = 8'h0;
+  parameter logic [31:0] CRC_RESULT_RESVAL = 32'h0;
+
+  // Register index
+  typedef enum int {
+    CRC_CTRL,
+    CRC_POLY,
+    CRC_INIT,
+    CRC_XOR_OUT,
+    CRC_DATA_WORD,
+    CRC_DATA_HALF,
+    CRC_DATA_BYTE,
+    CRC_RESULT
+  } crc_id_e;
+
+  // Register width information to check illegal writes
+  parameter logic [3:0] CRC_PERMIT[8] = '{
+      4'b0001,  // index[0] CRC_CTRL
+      4'b1111,  // index[1] CRC_POLY
+      4'b1111,  // index[2] CRC_INIT
+      4'b1111,  // index[3] CRC_XOR_OUT
+      4'b1111,  // index[4] CRC_DATA_WORD
+      4'b0011,  // index[5] CRC_DATA_HALF
+      4'b0001,  // index[6] CRC_DATA_BYTE
+      4'b1111  // index[7] CRC_RESULT
+  };
+
+endpackage
+
@@ -0,0 +1,454 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Top module auto-generated by `reggen`
+
+
+`include "common_cells/assertions.svh"
+
+module crc_reg_top #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int AW = 5
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+    // To HW
+    output crc_reg_pkg::crc_reg2hw_t reg2hw,  // Write
+    input crc_reg_pkg::crc_hw2reg_t hw2reg,  // Read
+
+
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+
+  import crc_reg_pkg::*;
+
+  localparam int DW = 32;
+  localparam int DBW = DW / 8;  // Byte Width
+
+  // register signals
+  logic           reg_we;
+  logic           reg_re;
+  logic [ AW-1:0] reg_addr;
+  logic [ DW-1:0] reg_wdata;
+  logic [DBW-1:0] reg_be;
+  logic [ DW-1:0] reg_rdata;
+  logic           reg_error;
+
+  logic addrmiss, wr_err;
+
+  logic [DW-1:0] reg_rdata_next;
+
+  // Below register interface can be changed
+  reg_req_t reg_intf_req;
+  reg_rsp_t reg_intf_rsp;
+
+
+  assign reg_intf_req = reg_req_i;
+  assign reg_rsp_o = reg_intf_rsp;
+
+
+  assign reg_we = reg_intf_req.valid & reg_intf_req.write;
+  assign reg_re = reg_intf_req.valid & ~reg_intf_req.write;
+  assign reg_addr = reg_intf_req.addr;
+  assign reg_wdata = reg_intf_req.wdata;
+  assign reg_be = reg_intf_req.wstrb;
+  assign reg_intf_rsp.rdata = reg_rdata;
+  assign reg_intf_rsp.error = reg_error;
+  assign reg_intf_rsp.ready = 1'b1;
+
+  assign reg_rdata = reg_rdata_next;
+  assign reg_error = (devmode_i & addrmiss) | wr_err;
+
+
+  // Define SW related signals
+  // Format: <reg>_<field>_{wd|we|qs}
+  //        or <reg>_{wd|we|qs} if field == 1 or 0
+  logic [1:0] ctrl_width_qs;
+  logic [1:0] ctrl_width_wd;
+  logic ctrl_width_we;
+  logic ctrl_reflect_qs;
+  logic ctrl_reflect_wd;
+  logic ctrl_reflect_we;
+  logic [31:0] poly_qs;
+  logic [31:0] poly_wd;
+  logic poly_we;
+  logic [31:0] init_qs;
+  logic [31:0] init_wd;
+  logic init_we;
+  logic [31:0] xor_out_qs;
+  logic [31:0] xor_out_wd;
+  logic xor_out_we;
+  logic [31:0] data_word_wd;
+  logic data_word_we;
+  logic [15:0] data_half_wd;
+  logic data_half_we;
+  logic [7:0] data_byte_wd;
+  logic data_byte_we;
+  logic [31:0] result_qs;
+  logic result_re;
+
+  // Register instances
+  // R[ctrl]: V(False)
+
+  //   F[width]: 1:0
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_ctrl_width (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ctrl_width_we),
+      .wd(ctrl_width_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ctrl.width.q),
+
+      // to register interface (read)
+      .qs(ctrl_width_qs)
+  );
+
+  //   F[reflect]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_ctrl_reflect (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ctrl_reflect_we),
+      .wd(ctrl_reflect_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ctrl.reflect.q),
+
+      // to register interface (read)
+      .qs(ctrl_reflect_qs)
+  );
+
+
+  // R[poly]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h4c11db7)
+  ) u_poly (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(poly_we),
+      .wd(poly_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.poly.q),
+
+      // to register interface (read)
+      .qs(poly_qs)
+  );
+
+
+  // R[init]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'hffffffff)
+  ) u_init (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(init_we),
+      .wd(init_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.init.qe),
+      .q (reg2hw.init.q),
+
+      // to register interface (read)
+      .qs(init_qs)
+  );
+
+
+  // R[xor_out]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'hffffffff)
+  ) u_xor_out (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(xor_out_we),
+      .wd(xor_out_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.xor_out.q),
+
+      // to register interface (read)
+      .qs(xor_out_qs)
+  );
+
+
+  // R[data_word]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_data_word (
+      .re (1'b0),
+      .we (data_word_we),
+      .wd (data_word_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.data_word.qe),
+      .q  (reg2hw.data_word.q),
+      .qs ()
+  );
+
+
+  // R[data_half]: V(True)
+
+  prim_subreg_ext #(
+      .DW(16)
+  ) u_data_half (
+      .re (1'b0),
+      .we (data_half_we),
+      .wd (data_half_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.data_half.qe),
+      .q  (reg2hw.data_half.q),
+      .qs ()
+  );
+
+
+  // R[data_byte]: V(True)
+
+  prim_subreg_ext #(
+      .DW(8)
+  ) u_data_byte (
+      .re (1'b0),
+      .we (data_byte_we),
+      .wd (data_byte_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.data_byte.qe),
+      .q  (reg2hw.data_byte.q),
+      .qs ()
+  );
+
+
+  // R[result]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_result (
+      .re (result_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.result.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (result_qs)
+  );
+
+
+
+
+  logic [7:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == CRC_CTRL_OFFSET);
+    addr_hit[1] = (reg_addr == CRC_POLY_OFFSET);
+    addr_hit[2] = (reg_addr == CRC_INIT_OFFSET);
+    addr_hit[3] = (reg_addr == CRC_XOR_OUT_OFFSET);
+    addr_hit[4] = (reg_addr == CRC_DATA_WORD_OFFSET);
+    addr_hit[5] = (reg_addr == CRC_DATA_HALF_OFFSET);
+    addr_hit[6] = (reg_addr == CRC_DATA_BYTE_OFFSET);
+    addr_hit[7] = (reg_addr == CRC_RESULT_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[0] & (|(CRC_PERMIT[0] & ~reg_be))) |
+               (addr_hit[1] & (|(CRC_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(CRC_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(CRC_PERMIT[3] & ~reg_be))) |
+               (addr_hit[4] & (|(CRC_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(CRC_PERMIT[5] & ~reg_be))) |
+               (addr_hit[6] & (|(CRC_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(CRC_PERMIT[7] & ~reg_be)))));
+  end
+
+  assign ctrl_width_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_width_wd = reg_wdata[1:0];
+
+  assign ctrl_reflect_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_reflect_wd = reg_wdata[2];
+
+  assign poly_we = addr_hit[1] & reg_we & !reg_error;
+  assign poly_wd = reg_wdata[31:0];
+
+  assign init_we = addr_hit[2] & reg_we & !reg_error;
+  assign init_wd = reg_wdata[31:0];
+
+  assign xor_out_we = addr_hit[3] & reg_we & !reg_error;
+  assign xor_out_wd = reg_wdata[31:0];
+
+  assign data_word_we = addr_hit[4] & reg_we & !reg_error;
+  assign data_word_wd = reg_wdata[31:0];
+
+  assign data_half_we = addr_hit[5] & reg_we & !reg_error;
+  assign data_half_wd = reg_wdata[15:0];
+
+  assign data_byte_we = addr_hit[6] & reg_we & !reg_error;
+  assign data_byte_wd = reg_wdata[7:0];
+
+  assign result_re = addr_hit[7] & reg_re & !reg_error;
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[1:0] = ctrl_width_qs;
+        reg_rdata_next[2]   = ctrl_reflect_qs;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[31:0] = poly_qs;
+      end
+
+      addr_hit[2]: begin
+        reg_rdata_next[31:0] = init_qs;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[31:0] = xor_out_qs;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[31:0] = '0;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[15:0] = '0;
+      end
+
+      addr_hit[6]: begin
+        reg_rdata_next[7:0] = '0;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[31:0] = result_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module crc_reg_top_intf #(
+    parameter  int AW = 5,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    // To HW
+    output crc_reg_pkg::crc_reg2hw_t reg2hw,  // Write
+    input crc_reg_pkg::crc_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+
+
+  crc_reg_top #(
+      .reg_req_t(reg_bus_req_t),
+      .reg_rsp_t(reg_bus_rsp_t),
+      .AW(AW)
+  ) i_regs (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(s_reg_req),
+      .reg_rsp_o(s_reg_rsp),
+      .reg2hw,  // Write
+      .hw2reg,  // Read
+      .devmode_i
+  );
+
+endmodule
@@ -2,10 +2,74 @@
 // Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
 // SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 
-// DMA assume a read request is not granted before previous request rvalid is asserted
+// The read masters keep up to MAX_OUTSTANDING requests in flight, as long as
+// the FIFO has room for all of their data. FIFO_DEPTH and MAX_OUTSTANDING are
+// set from mcu_cfg.hjson; deeper FIFOs and more outstanding requests sustain
+// the throughput to targets with a long read latency.
+//
+// Linked-list mode: writing DESC_PTR makes the DMA fetch a descriptor from
+// memory through the read port and perform its transaction, then fetch the
+// next one, until a descriptor with a NULL next pointer. Descriptor layout
+// (32-bit words):
+//   0: next descriptor pointer, 0 for the last descriptor of the chain
+//   1: source pointer
+//   2: destination pointer
+//   3: size in bytes
+//   4: [7:0] source pointer increment, [15:8] destination pointer increment,
+//      [17:16] data type, [19:18] destination data type, [20] sign extension,
+//      [31] raise the transaction done interrupt when done
+//   5: [15:0] rx trigger slots, [31:16] tx trigger slots
+// The transactions of a chain are always linear; the transaction done
+// interrupt is only raised at the end of the chain and for the descriptors
+// with bit 31 of word 4 set.
+//
+// 2D mode: when SIZE_D1 is not zero the transaction is split in rows of
+// SIZE_D1 bytes. The pointers move by the PTR_INC increments inside a row and
+// by the PTR_INC_D2 ones after the last element of each row, so a tile of a
+// matrix can be read or written with a single transaction. It is not available
+// in address and linked-list mode.
+//
+// Data types: DATA_TYPE is the type of the reads and DST_DATA_TYPE the one of
+// the writes. Narrower source data is extended to the destination type, with
+// its sign bit if SIGN_EXT is set and with zeros otherwise, and wider source
+// data is truncated. SIZE (and SIZE_D1) are in bytes of the source.
+//
+// Fill mode: MODE 3 writes the FILL_VALUE register, taken as data of the
+// source type, to the destination instead of reading the source, so a memset
+// only takes the write bandwidth. SRC_PTR and its increments are ignored.
+//
+// Address mode: MODE 2 reads a table of 32-bit entries from ADDR_PTR through
+// the address port, one per data unit. By default the entries are the
+// destination addresses (scatter); with ADDR_CFG.GATHER they are the source
+// addresses instead, and the destination pointer moves as in linear mode.
+// With ADDR_CFG.OFFSETS the entries are offsets, shifted left by
+// ADDR_CFG.SHIFT, added to SRC_PTR (gather) or DST_PTR (scatter), e.g. the
+// indexes of a lookup table.
+//
+// Pacing timer: bit 15 of the RX or TX trigger slots is a trigger of the
+// channel itself, which ticks every TIMER cycles from the start of the
+// transaction and allows a read (RX) or a write (TX) for each tick, so memory
+// or peripherals without a trigger slot are read or written at a fixed rate.
+// A tick is dropped if the transfer of the previous one is still waiting, and
+// the trigger slots of the system use at most the bits 13:0.
+//
+// GPIO strobe: bit 14 of the RX or TX trigger slots is a trigger of the
+// channel on the edges of the GPIO STROBE.PIN, among the synchronized levels
+// of all the GPIOs in gpio_i. Each edge of the polarities enabled by
+// STROBE.RISE and STROBE.FALL allows a read (RX) or a write (TX), e.g. of
+// GPIO_IN for a parallel bus with a strobe. An edge coming while the transfer
+// of the previous one is still waiting is dropped and counted in
+// STROBE_MISSED. The edges are only taken after the start of the transaction,
+// and a circular transaction keeps them across its restarts.
+//
+// Performance counters: PERF_BUSY, PERF_READ_STALL, PERF_WRITE_STALL and
+// PERF_BEATS count the busy cycles, the cycles the read and write requests
+// wait for their grant and the data units written. They are cleared when a
+// transaction (or a chain of descriptors) starts.
 
 module dma #(
     parameter int unsigned FIFO_DEPTH = 4,
+    parameter int unsigned MAX_OUTSTANDING = 1,
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
     parameter type obi_req_t = logic,
@@ -29,6 +93,9 @@ module dma #(
 
     input logic [SLOT_NUM-1:0] trigger_slot_i,
 
+    // Synchronized levels of the GPIOs, for the strobe trigger
+    input logic [31:0] gpio_i,
+
     output dma_done_intr_o,
     output dma_window_intr_o
 );
@@ -37,6 +104,22 @@ module dma #(
 
   localparam int unsigned LastFifoUsage = FIFO_DEPTH - 1;
   localparam int unsigned Addr_Fifo_Depth = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
+  localparam int unsigned OutstandingW = $clog2(FIFO_DEPTH + 1);
+
+  localparam int unsigned DescWords = 6;
+  localparam int unsigned DescNext = 0;
+  localparam int unsigned DescSrc = 1;
+  localparam int unsigned DescDst = 2;
+  localparam int unsigned DescSize = 3;
+  localparam int unsigned DescCfg = 4;
+  localparam int unsigned DescSlot = 5;
+  localparam int unsigned DescCfgIntr = 31;
+  localparam int unsigned DescWordW = $clog2(DescWords + 1);
+
+  // Trigger slot of the pacing timer
+  localparam int unsigned TimerSlot = 15;
+  // Trigger slot of the GPIO strobe
+  localparam int unsigned StrobeSlot = 14;
 
   dma_reg2hw_t                       reg2hw;
   dma_hw2reg_t                       hw2reg;
@@ -54,12 +137,19 @@ module dma #(
   logic                              dma_window_event;
 
   logic                              window_done_q;
+  logic                              transaction_done_q;
+  logic                              dma_trans_event;
+
+  logic                              perf_clear;
 
   logic        [Addr_Fifo_Depth-1:0] fifo_usage;
-  logic                              fifo_alm_full;
+  logic                              fifo_room;
 
   logic        [Addr_Fifo_Depth-1:0] fifo_addr_usage;
-  logic                              fifo_addr_alm_full;
+  logic                              fifo_addr_room;
+
+  logic                              read_credit;
+  logic                              read_addr_credit;
 
   logic                              data_in_req;
   logic                              data_in_we;
@@ -96,8 +186,24 @@ module dma #(
 
   logic        wait_for_rx;
   logic        wait_for_tx;
+  logic        wait_for_pace;
+  logic [15:0] pace_cnt;
+
+  // Pacing timer, a credit of one transfer per tick
+  logic [31:0] timer_cnt;
+  logic        timer_tick;
+  logic        timer_credit;
+  logic        timer_take;
+
+  // GPIO strobe, a credit of one transfer per edge
+  logic        strobe_q;
+  logic        strobe_edge;
+  logic        strobe_credit;
+  logic        strobe_take;
 
   logic [ 1:0] data_type;
+  logic [ 1:0] dst_data_type;
+  logic        sign_ext;
 
   logic [31:0] fifo_input;
   logic [31:0] fifo_addr_input;
@@ -108,17 +214,63 @@ module dma #(
 
   logic        circular_mode;
   logic        address_mode;
+  logic        fill_mode;
+
+  // Address mode, the table gives the source (gather) or destination
+  // (scatter) addresses
+  logic        gather_mode;
+  logic        scatter_mode;
+  logic [31:0] table_address;
+  logic        wait_for_addr;
+  // Low bits of the source addresses of the gather reads in flight
+  logic [ 1:0] gather_lsb;
+
+  // Fill mode, the FILL_VALUE pushed in the FIFO in place of a read
+  logic        fill_push;
+  logic [31:0] fill_input;
 
   logic        dma_start_pending;
 
+  // Configuration of the transaction, from the registers or the descriptor
+  logic [31:0] src_ptr;
+  logic [31:0] dst_ptr;
+  logic [31:0] trans_size;
+  logic [ 7:0] src_ptr_inc;
+  logic [ 7:0] dst_ptr_inc;
+  logic [15:0] rx_trigger_slot;
+  logic [15:0] tx_trigger_slot;
+
+  // 2D mode, bytes left in the current row of each pointer
+  logic        dim_2d;
+  logic [31:0] read_d1_cnt;
+  logic [31:0] read_valid_d1_cnt;
+  logic [31:0] write_d1_cnt;
+  logic        read_d1_last;
+  logic        read_valid_d1_last;
+  logic        write_d1_last;
+
+  // Linked-list mode
+  logic                        desc_start_pending;
+  logic                        desc_mode_q;
+  logic [DescWords-1:0][ 31:0] desc_q;
+  logic [         31:0]        desc_addr_q;
+  logic [DescWordW-1:0]        desc_word_q;
+  logic                        desc_outstanding_q;
+  logic                        desc_fetch;
+  logic                        desc_fetch_start;
+  logic                        desc_fetch_done;
+  logic                        desc_req;
+  logic                        desc_last;
+
   enum {
     DMA_READY,
+    DMA_DESC_FETCH,
     DMA_STARTING,
     DMA_RUNNING
   }
       dma_state_q, dma_state_d;
 
-  logic [Addr_Fifo_Depth-1:0] outstanding_req, outstanding_addr_req;
+  logic [OutstandingW-1:0] outstanding_req, outstanding_addr_req;
 
   enum logic {
     DMA_READ_FSM_IDLE,
@@ -132,14 +284,15 @@ module dma #(
   }
       dma_write_fsm_state, dma_write_fsm_n_state;
 
-  assign dma_read_ch0_req_o.req = data_in_req;
-  assign dma_read_ch0_req_o.we = data_in_we;
-  assign dma_read_ch0_req_o.be = data_in_be;
-  assign dma_read_ch0_req_o.addr = data_in_addr;
+  // The read port also fetches the descriptors, while the read FSM is idle
+  assign dma_read_ch0_req_o.req = desc_fetch ? desc_req : data_in_req;
+  assign dma_read_ch0_req_o.we = desc_fetch ? 1'b0 : data_in_we;
+  assign dma_read_ch0_req_o.be = desc_fetch ? 4'b1111 : data_in_be;
+  assign dma_read_ch0_req_o.addr = desc_fetch ? desc_addr_q : data_in_addr;
   assign dma_read_ch0_req_o.wdata = 32'h0;
 
-  assign data_in_gnt = dma_read_ch0_resp_i.gnt;
-  assign data_in_rvalid = dma_read_ch0_resp_i.rvalid;
+  assign data_in_gnt = dma_read_ch0_resp_i.gnt & ~desc_fetch;
+  assign data_in_rvalid = dma_read_ch0_resp_i.rvalid & ~desc_fetch;
   assign data_in_rdata = dma_read_ch0_resp_i.rdata;
 
   assign dma_addr_ch0_req_o.req = data_addr_in_req;
@@ -162,41 +315,84 @@ module dma #(
   assign data_out_rvalid = dma_write_ch0_resp_i.rvalid;
   assign data_out_rdata = dma_write_ch0_resp_i.rdata;
 
-  assign dma_done_intr_o = dma_done & reg2hw.interrupt_en.transaction_done.q;
+  // In linked-list mode only the last and the flagged descriptors are reported
+  assign dma_trans_event = dma_done & (~desc_mode_q | desc_last | desc_q[DescCfg][DescCfgIntr]);
+
+  assign dma_done_intr_o = dma_trans_event & reg2hw.interrupt_en.transaction_done.q;
   assign dma_window_intr_o = dma_window_event & reg2hw.interrupt_en.window_done.q;
 
 
   logic [31:0] window_counter;
 
 
-  assign data_type = reg2hw.data_type.q;
+  assign src_ptr = desc_mode_q ? desc_q[DescSrc] : reg2hw.src_ptr.q;
+  assign dst_ptr = desc_mode_q ? desc_q[DescDst] : reg2hw.dst_ptr.q;
+  assign trans_size = desc_mode_q ? desc_q[DescSize] : reg2hw.size.q;
+  assign src_ptr_inc = desc_mode_q ? desc_q[DescCfg][7:0] : reg2hw.ptr_inc.src_ptr_inc.q;
+  assign dst_ptr_inc = desc_mode_q ? desc_q[DescCfg][15:8] : reg2hw.ptr_inc.dst_ptr_inc.q;
+  assign rx_trigger_slot = desc_mode_q ? desc_q[DescSlot][15:0] : reg2hw.slot.rx_trigger_slot.q;
+  assign tx_trigger_slot = desc_mode_q ? desc_q[DescSlot][31:16] : reg2hw.slot.tx_trigger_slot.q;
+
+  assign data_type = desc_mode_q ? desc_q[DescCfg][17:16] : reg2hw.data_type.q;
+  assign dst_data_type = desc_mode_q ? desc_q[DescCfg][19:18] : reg2hw.dst_data_type.q;
+  assign sign_ext = desc_mode_q ? desc_q[DescCfg][20] : reg2hw.sign_ext.q;
 
   assign hw2reg.status.ready.d = (dma_state_q == DMA_READY);
 
   assign hw2reg.status.window_done.d = window_done_q;
 
-  assign circular_mode = reg2hw.mode.q == 1;
-  assign address_mode = reg2hw.mode.q == 2;
+  assign hw2reg.status.transaction_done.d = transaction_done_q;
+
+  assign circular_mode = ~desc_mode_q && reg2hw.mode.q == 1;
+  assign address_mode = ~desc_mode_q && reg2hw.mode.q == 2;
+  assign fill_mode = ~desc_mode_q && reg2hw.mode.q == 3;
+
+  assign gather_mode = address_mode && reg2hw.addr_cfg.gather.q;
+  assign scatter_mode = address_mode && ~reg2hw.addr_cfg.gather.q;
+
+  assign table_address = reg2hw.addr_cfg.offsets.q ?
+      (gather_mode ? src_ptr : dst_ptr) + (fifo_addr_output << reg2hw.addr_cfg.shift.q) :
+      fifo_addr_output;
 
-  assign write_address = address_mode ? fifo_addr_output : write_ptr_reg;
+  assign write_address = scatter_mode ? table_address : write_ptr_reg;
 
-  assign wait_for_rx = |(reg2hw.slot.rx_trigger_slot.q[SLOT_NUM-1:0] & (~trigger_slot_i));
-  assign wait_for_tx = |(reg2hw.slot.tx_trigger_slot.q[SLOT_NUM-1:0] & (~trigger_slot_i));
+  assign dim_2d = ~desc_mode_q && ~address_mode && |reg2hw.size_d1.q;
+  assign read_d1_last = dim_2d && (read_d1_cnt <= {29'h0, dma_cnt_dec});
+  assign read_valid_d1_last = dim_2d && (read_valid_d1_cnt <= {29'h0, dma_cnt_dec});
+  assign write_d1_last = dim_2d && (write_d1_cnt <= {29'h0, dma_cnt_dec});
 
-  assign fifo_addr_empty_check = fifo_addr_empty && address_mode;
+  assign wait_for_rx = |(rx_trigger_slot[SLOT_NUM-1:0] & (~trigger_slot_i)) |
+      (rx_trigger_slot[TimerSlot] & ~timer_credit) |
+      (rx_trigger_slot[StrobeSlot] & ~strobe_credit);
+  assign wait_for_tx = |(tx_trigger_slot[SLOT_NUM-1:0] & (~trigger_slot_i)) |
+      (tx_trigger_slot[TimerSlot] & ~timer_credit) |
+      (tx_trigger_slot[StrobeSlot] & ~strobe_credit);
+  assign wait_for_pace = |pace_cnt;
 
-  assign fifo_alm_full = (fifo_usage == LastFifoUsage[Addr_Fifo_Depth-1:0]);
-  assign fifo_addr_alm_full = (fifo_addr_usage == LastFifoUsage[Addr_Fifo_Depth-1:0]);
+  assign fifo_addr_empty_check = fifo_addr_empty && scatter_mode;
+  assign wait_for_addr = fifo_addr_empty && gather_mode;
+
+  // A read is only issued if the FIFO has room for its data and for the data of
+  // the reads in flight, keeping the last entry free
+  assign fifo_room = (32'(fifo_usage) + 32'(outstanding_req)) < LastFifoUsage;
+  assign fifo_addr_room = (32'(fifo_addr_usage) + 32'(outstanding_addr_req)) < LastFifoUsage;
+
+  // Reads in flight, without the one returning in this cycle
+  assign read_credit = (32'(outstanding_req) - 32'(data_in_rvalid)) < MAX_OUTSTANDING;
+  assign read_addr_credit = (32'(outstanding_addr_req) - 32'(data_addr_in_rvalid)) < MAX_OUTSTANDING;
 
   assign dma_start = (dma_state_q == DMA_STARTING);
 
   //
   // Main DMA state machine
   //
-  // READY   : idle, waiting for a write pulse to size registered in `dma_start_pending`
-  // STARTING: load transaction data
-  // RUNNING : waiting for transaction finish
-  //           when `dma_done` rises either enter ready or restart in circular mode
+  // READY     : idle, waiting for a write pulse to size registered in `dma_start_pending`
+  //             or to the descriptor pointer registered in `desc_start_pending`
+  // DESC_FETCH: read the descriptor of the next transaction (linked-list mode)
+  // STARTING  : load transaction data
+  // RUNNING   : waiting for transaction finish
+  //             when `dma_done` rises either enter ready, restart in circular mode
+  //             or fetch the next descriptor of the chain
   //
   always_comb begin
     dma_state_d = dma_state_q;
@@ -204,6 +400,13 @@ module dma #(
       DMA_READY: begin
         if (dma_start_pending) begin
           dma_state_d = DMA_STARTING;
+        end else if (desc_start_pending) begin
+          dma_state_d = DMA_DESC_FETCH;
+        end
+      end
+      DMA_DESC_FETCH: begin
+        if (desc_fetch_done) begin
+          dma_state_d = DMA_STARTING;
         end
       end
       DMA_STARTING: begin
@@ -212,9 +415,11 @@ module dma #(
       DMA_RUNNING: begin
         if (dma_done) begin
           if (circular_mode) dma_state_d = DMA_STARTING;
+          else if (desc_mode_q && !desc_last) dma_state_d = DMA_DESC_FETCH;
           else dma_state_d = DMA_READY;
         end
       end
+      default: dma_state_d = DMA_READY;
     endcase
   end
 
@@ -241,15 +446,71 @@ module dma #(
     end
   end
 
+  // Chain start pulse when the descriptor pointer register is written
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_desc_start
+    if (~rst_ni) begin
+      desc_start_pending <= 1'b0;
+    end else begin
+      if (desc_fetch_start && dma_state_q == DMA_READY) begin
+        desc_start_pending <= 1'b0;
+      end else if (reg2hw.desc_ptr.qe & |reg2hw.desc_ptr.q) begin
+        desc_start_pending <= 1'b1;
+      end
+    end
+  end
+
+  // The transactions started from READY by a write to SIZE use the registers,
+  // the ones started by a write to DESC_PTR use the fetched descriptors
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_desc_mode
+    if (~rst_ni) begin
+      desc_mode_q <= 1'b0;
+    end else if (dma_state_q == DMA_READY) begin
+      if (dma_start_pending) desc_mode_q <= 1'b0;
+      else if (desc_start_pending) desc_mode_q <= 1'b1;
+    end
+  end
+
+  assign desc_fetch = (dma_state_q == DMA_DESC_FETCH);
+  assign desc_fetch_start = (dma_state_q != DMA_DESC_FETCH) && (dma_state_d == DMA_DESC_FETCH);
+  assign desc_fetch_done = desc_fetch && (desc_word_q == DescWordW'(DescWords));
+  assign desc_req = desc_fetch && !desc_outstanding_q && !desc_fetch_done;
+  assign desc_last = ~|desc_q[DescNext];
+
+  // Descriptor fetch, one word at a time
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_desc_fetch
+    if (~rst_ni) begin
+      desc_q             <= '0;
+      desc_addr_q        <= '0;
+      desc_word_q        <= '0;
+      desc_outstanding_q <= 1'b0;
+    end else begin
+      if (desc_fetch_start) begin
+        desc_addr_q        <= (dma_state_q == DMA_READY) ? reg2hw.desc_ptr.q : desc_q[DescNext];
+        desc_word_q        <= '0;
+        desc_outstanding_q <= 1'b0;
+      end else if (desc_fetch) begin
+        if (desc_req && dma_read_ch0_resp_i.gnt) begin
+          desc_addr_q        <= desc_addr_q + 32'h4;
+          desc_outstanding_q <= 1'b1;
+        end
+        if (desc_outstanding_q && dma_read_ch0_resp_i.rvalid) begin
+          desc_q[desc_word_q] <= dma_read_ch0_resp_i.rdata;
+          desc_word_q         <= desc_word_q + 1'b1;
+          desc_outstanding_q  <= 1'b0;
+        end
+      end
+    end
+  end
+
   // Store input data pointer and increment everytime read request is granted
   always_ff @(posedge clk_i or negedge rst_ni) begin : proc_ptr_in_reg
     if (~rst_ni) begin
       read_ptr_reg <= '0;
     end else begin
       if (dma_start == 1'b1) begin
-        read_ptr_reg <= reg2hw.src_ptr.q;
+        read_ptr_reg <= src_ptr;
       end else if (data_in_gnt == 1'b1) begin
-        read_ptr_reg <= read_ptr_reg + {24'h0, reg2hw.ptr_inc.src_ptr_inc.q};
+        read_ptr_reg <= read_ptr_reg + (read_d1_last ? {16'h0, reg2hw.ptr_inc_d2.src_ptr_inc_d2.q} : {24'h0, src_ptr_inc});
       end
     end
   end
@@ -273,9 +534,9 @@ module dma #(
       read_ptr_valid_reg <= '0;
     end else begin
       if (dma_start == 1'b1) begin
-        read_ptr_valid_reg <= reg2hw.src_ptr.q;
+        read_ptr_valid_reg <= src_ptr;
       end else if (data_in_rvalid == 1'b1) begin
-        read_ptr_valid_reg <= read_ptr_valid_reg + {24'h0, reg2hw.ptr_inc.src_ptr_inc.q};
+        read_ptr_valid_reg <= read_ptr_valid_reg + (read_valid_d1_last ? {16'h0, reg2hw.ptr_inc_d2.src_ptr_inc_d2.q} : {24'h0, src_ptr_inc});
       end
     end
   end
@@ -286,9 +547,31 @@ module dma #(
       write_ptr_reg <= '0;
     end else begin
       if (dma_start == 1'b1) begin
-        write_ptr_reg <= reg2hw.dst_ptr.q;
+        write_ptr_reg <= dst_ptr;
       end else if (data_out_gnt == 1'b1) begin
-        write_ptr_reg <= write_ptr_reg + {24'h0, reg2hw.ptr_inc.dst_ptr_inc.q};
+        write_ptr_reg <= write_ptr_reg + (write_d1_last ? {16'h0, reg2hw.ptr_inc_d2.dst_ptr_inc_d2.q} : {24'h0, dst_ptr_inc});
+      end
+    end
+  end
+
+  // Count the bytes left in the row of each pointer, reloaded at the end of each row (2D mode)
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_d1_cnt_reg
+    if (~rst_ni) begin
+      read_d1_cnt       <= '0;
+      read_valid_d1_cnt <= '0;
+      write_d1_cnt      <= '0;
+    end else begin
+      if (dma_start == 1'b1) begin
+        read_d1_cnt       <= reg2hw.size_d1.q;
+        read_valid_d1_cnt <= reg2hw.size_d1.q;
+        write_d1_cnt      <= reg2hw.size_d1.q;
+      end else begin
+        if (data_in_gnt == 1'b1)
+          read_d1_cnt <= read_d1_last ? reg2hw.size_d1.q : read_d1_cnt - {29'h0, dma_cnt_dec};
+        if (data_in_rvalid == 1'b1)
+          read_valid_d1_cnt <= read_valid_d1_last ? reg2hw.size_d1.q : read_valid_d1_cnt - {29'h0, dma_cnt_dec};
+        if (data_out_gnt == 1'b1)
+          write_d1_cnt <= write_d1_last ? reg2hw.size_d1.q : write_d1_cnt - {29'h0, dma_cnt_dec};
       end
     end
   end
@@ -299,8 +582,8 @@ module dma #(
       dma_cnt <= '0;
     end else begin
       if (dma_start == 1'b1) begin
-        dma_cnt <= reg2hw.size.q;
-      end else if (data_in_gnt == 1'b1) begin
+        dma_cnt <= trans_size;
+      end else if (data_in_gnt == 1'b1 || fill_push == 1'b1) begin
         dma_cnt <= dma_cnt - {29'h0, dma_cnt_dec};
       end
     end
@@ -314,7 +597,7 @@ module dma #(
       if (dma_start == 1'b1 && address_mode) begin
         dma_addr_cnt <= reg2hw.size.q;
       end else if (data_addr_in_gnt == 1'b1 && address_mode) begin
-        dma_addr_cnt <= dma_addr_cnt - 32'h4;  //address always 32b
+        dma_addr_cnt <= dma_addr_cnt - {29'h0, dma_cnt_dec};  // an address per data unit
       end
     end
   end
@@ -328,7 +611,7 @@ module dma #(
   end
 
   always_comb begin : proc_byte_enable_out
-    case (data_type)  // Data type 00 Word, 01 Half word, 11,10 byte
+    case (dst_data_type)  // Data type 00 Word, 01 Half word, 11,10 byte
       2'b00: byte_enable_out = 4'b1111;  // Writing a word (32 bits)
 
       2'b01: begin  // Writing a half-word (16 bits)
@@ -349,7 +632,7 @@ module dma #(
         ;  // case(write_address[1:0])
       end
     endcase
-    ;  // case (data_type)
+    ;  // case (dst_data_type)
   end
 
   // Output data shift
@@ -384,7 +667,7 @@ module dma #(
     fifo_input[23:16] = data_in_rdata[23:16];
     fifo_input[31:24] = data_in_rdata[31:24];
 
-    case (read_ptr_valid_reg[1:0])
+    case (gather_mode ? gather_lsb : read_ptr_valid_reg[1:0])
       2'b00: ;
 
       2'b01: fifo_input[7:0] = data_in_rdata[15:8];
@@ -396,6 +679,29 @@ module dma #(
 
       2'b11: fifo_input[7:0] = data_in_rdata[31:24];
     endcase
+
+    // Extend the source data to a word, for wider destination data types
+    case (data_type)
+      2'b00: ;
+
+      2'b01: fifo_input[31:16] = {16{sign_ext & fifo_input[15]}};
+
+      2'b10, 2'b11: fifo_input[31:8] = {24{sign_ext & fifo_input[7]}};
+    endcase
+  end
+
+  // Fill data: FILL_VALUE extended as the data read
+  always_comb begin : proc_fill_data
+
+    fill_input = reg2hw.fill_value.q;
+
+    case (data_type)
+      2'b00: ;
+
+      2'b01: fill_input[31:16] = {16{sign_ext & fill_input[15]}};
+
+      2'b10, 2'b11: fill_input[31:8] = {24{sign_ext & fill_input[7]}};
+    endcase
   end
 
   // FSM state update
@@ -428,6 +734,8 @@ module dma #(
     data_in_be = '0;
     data_in_addr = '0;
 
+    fill_push = 1'b0;
+
     fifo_flush = 1'b0;
 
     unique case (dma_read_fsm_state)
@@ -448,12 +756,17 @@ module dma #(
           dma_read_fsm_n_state = DMA_READ_FSM_IDLE;
         end else begin
           dma_read_fsm_n_state = DMA_READ_FSM_ON;
-          // Wait if fifo is full, almost full (last data), or if the SPI RX does not have valid data (only in SPI mode 1).
-          if (fifo_full == 1'b0 && fifo_alm_full == 1'b0 && wait_for_rx == 1'b0) begin
+          // Wait if fifo is full, has no room for the reads in flight, if there are too many of them,
+          // or if the SPI RX does not have valid data (only in SPI mode 1).
+          // In fill mode the data is pushed without reading.
+          if (fill_mode) begin
+            fill_push = fifo_full == 1'b0 && fifo_room && wait_for_rx == 1'b0;
+          end else if (fifo_full == 1'b0 && fifo_room && read_credit && wait_for_rx == 1'b0 &&
+                       wait_for_addr == 1'b0) begin
             data_in_req  = 1'b1;
             data_in_we   = 1'b0;
             data_in_be   = 4'b1111;  // always read all bytes
-            data_in_addr = read_ptr_reg;
+            data_in_addr = gather_mode ? table_address : read_ptr_reg;
           end
         end
       end
@@ -490,8 +803,8 @@ module dma #(
           dma_read_addr_fsm_n_state = DMA_READ_FSM_IDLE;
         end else begin
           dma_read_addr_fsm_n_state = DMA_READ_FSM_ON;
-          // Wait if fifo is full, almost full (last data), or if the SPI RX does not have valid data (only in SPI mode 1).
-          if (fifo_addr_full == 1'b0 && fifo_addr_alm_full == 1'b0) begin
+          // Wait if fifo is full, has no room for the reads in flight or if there are too many of them.
+          if (fifo_addr_full == 1'b0 && fifo_addr_room && read_addr_credit) begin
             data_addr_in_req  = 1'b1;
             data_addr_in_we   = 1'b0;
             data_addr_in_be   = 4'b1111;  // always read all bytes
@@ -532,7 +845,8 @@ module dma #(
         end else begin
           dma_write_fsm_n_state = DMA_WRITE_FSM_ON;
           // Wait if fifo is empty or if the SPI TX is not ready for new data (only in SPI mode 2).
-          if (fifo_empty == 1'b0 && wait_for_tx == 1'b0 && fifo_addr_empty_check == 1'b0) begin
+          if (fifo_empty == 1'b0 && wait_for_tx == 1'b0 && wait_for_pace == 1'b0 &&
+              fifo_addr_empty_check == 1'b0) begin
             data_out_req  = 1'b1;
             data_out_we   = 1'b1;
             data_out_be   = byte_enable_out;
@@ -555,8 +869,8 @@ module dma #(
       .empty_o(fifo_empty),
       .usage_o(fifo_usage),
       // as long as the queue is not full we can push new data
-      .data_i(fifo_input),
-      .push_i(data_in_rvalid),
+      .data_i(fill_mode ? fill_input : fifo_input),
+      .push_i(data_in_rvalid | fill_push),
       // as long as the queue is not empty we can pop new elements
       .data_o(fifo_output),
       .pop_i(data_out_gnt)
@@ -578,7 +892,26 @@ module dma #(
       .push_i(data_addr_in_rvalid),
       // as long as the queue is not empty we can pop new elements
       .data_o(fifo_addr_output),
-      .pop_i(data_out_gnt && address_mode)
+      .pop_i(gather_mode ? (data_in_req && data_in_gnt) : (data_out_gnt && scatter_mode))
+  );
+
+  // The data of a gather read is aligned with the address of its request,
+  // which has left the address FIFO when the data comes back
+  fifo_v3 #(
+      .DATA_WIDTH(2),
+      .DEPTH(MAX_OUTSTANDING + 1)
+  ) dma_gather_lsb_fifo_i (
+      .clk_i,
+      .rst_ni,
+      .flush_i(fifo_flush),
+      .testmode_i(1'b0),
+      .full_o(),
+      .empty_o(),
+      .usage_o(),
+      .data_i(table_address[1:0]),
+      .push_i(gather_mode && data_in_req && data_in_gnt),
+      .data_o(gather_lsb),
+      .pop_i(gather_mode && data_in_rvalid)
   );
 
   dma_reg_top #(
@@ -628,6 +961,95 @@ module dma #(
     end
   end
 
+  // WRITE PACING
+  // After each granted write, the next one waits until PACE cycles passed since
+  // its start, so the data reaches a peripheral at a fixed rate
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      pace_cnt <= '0;
+    end else begin
+      if (dma_start) begin
+        pace_cnt <= '0;
+      end else if (data_out_req & data_out_gnt & (reg2hw.pace.q > 16'h1)) begin
+        pace_cnt <= reg2hw.pace.q - 16'h1;
+      end else if (|pace_cnt) begin
+        pace_cnt <= pace_cnt - 16'h1;
+      end
+    end
+  end
+
+  // PACING TIMER
+  // The first transfer is allowed at the start, the next ones on each tick
+  assign timer_tick = (dma_state_q == DMA_RUNNING) && (timer_cnt + 32'h1 >= reg2hw.timer.q);
+  assign timer_take = (rx_trigger_slot[TimerSlot] & ((data_in_req & data_in_gnt) | fill_push)) |
+      (tx_trigger_slot[TimerSlot] & data_out_req & data_out_gnt);
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      timer_cnt    <= '0;
+      timer_credit <= 1'b0;
+    end else begin
+      if (dma_start) begin
+        timer_cnt    <= '0;
+        timer_credit <= 1'b1;
+      end else begin
+        if (timer_tick) begin
+          timer_cnt <= '0;
+        end else if (dma_state_q == DMA_RUNNING) begin
+          timer_cnt <= timer_cnt + 32'h1;
+        end
+        if (timer_tick) begin
+          timer_credit <= 1'b1;
+        end else if (timer_take) begin
+          timer_credit <= 1'b0;
+        end
+      end
+    end
+  end
+
+  // GPIO STROBE
+  // Armed when the DMA leaves the ready state, like the performance counters
+  assign strobe_edge = (dma_state_q != DMA_READY) &&
+      ((reg2hw.strobe.rise.q && gpio_i[reg2hw.strobe.pin.q] && !strobe_q) ||
+       (reg2hw.strobe.fall.q && !gpio_i[reg2hw.strobe.pin.q] && strobe_q));
+  assign strobe_take = (rx_trigger_slot[StrobeSlot] & data_in_req & data_in_gnt) |
+      (tx_trigger_slot[StrobeSlot] & data_out_req & data_out_gnt);
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      strobe_q      <= 1'b0;
+      strobe_credit <= 1'b0;
+    end else begin
+      strobe_q <= gpio_i[reg2hw.strobe.pin.q];
+      if (perf_clear) begin
+        strobe_credit <= 1'b0;
+      end else if (strobe_edge) begin
+        strobe_credit <= 1'b1;
+      end else if (strobe_take) begin
+        strobe_credit <= 1'b0;
+      end
+    end
+  end
+
+  // PERFORMANCE COUNTERS
+  // Cleared when the DMA leaves the ready state, so a chain of descriptors is
+  // measured as a whole. An edge of the strobe is missed if the credit of the
+  // previous one is still there.
+  assign perf_clear = (dma_state_q == DMA_READY) && (dma_state_d != DMA_READY);
+
+  always_comb begin
+    hw2reg.perf_busy.d         = perf_clear ? '0 : reg2hw.perf_busy.q + 'h1;
+    hw2reg.perf_busy.de        = perf_clear | (dma_state_q != DMA_READY);
+    hw2reg.perf_read_stall.d   = perf_clear ? '0 : reg2hw.perf_read_stall.q + 'h1;
+    hw2reg.perf_read_stall.de  = perf_clear | (data_in_req & ~data_in_gnt);
+    hw2reg.perf_write_stall.d  = perf_clear ? '0 : reg2hw.perf_write_stall.q + 'h1;
+    hw2reg.perf_write_stall.de = perf_clear | (data_out_req & ~data_out_gnt);
+    hw2reg.perf_beats.d        = perf_clear ? '0 : reg2hw.perf_beats.q + 'h1;
+    hw2reg.perf_beats.de       = perf_clear | data_out_gnt;
+    hw2reg.strobe_missed.d     = perf_clear ? '0 : reg2hw.strobe_missed.q + 'h1;
+    hw2reg.strobe_missed.de    = perf_clear | (strobe_edge & strobe_credit & ~strobe_take);
+  end
+
   // update window_done flag
   // set on dma_window_event
   // reset on read
@@ -640,5 +1062,17 @@ module dma #(
     end
   end
 
+  // update transaction_done flag
+  // set on dma_trans_event, tells which channel raised the shared interrupt
+  // reset on read
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      transaction_done_q <= 1'b0;
+    end else begin
+      if (dma_trans_event) transaction_done_q <= 1'b1;
+      else if (reg2hw.status.transaction_done.re) transaction_done_q <= 1'b0;
+    end
+  end
+
 
 endmodule : dma
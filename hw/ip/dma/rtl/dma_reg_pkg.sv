@@ -7,7 +7,7 @@
 package dma_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 6;
+  parameter int BlockAw = 7;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -33,6 +33,10 @@ package dma_reg_pkg;
       logic q;
       logic re;
     } window_done;
+    struct packed {
+      logic q;
+      logic re;
+    } transaction_done;
   } dma_reg2hw_status_reg_t;
 
   typedef struct packed {
@@ -58,9 +62,54 @@ package dma_reg_pkg;
     struct packed {logic q;} window_done;
   } dma_reg2hw_interrupt_en_reg_t;
 
+  typedef struct packed {
+    logic [31:0] q;
+    logic        qe;
+  } dma_reg2hw_desc_ptr_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_size_d1_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [15:0] q;} src_ptr_inc_d2;
+    struct packed {logic [15:0] q;} dst_ptr_inc_d2;
+  } dma_reg2hw_ptr_inc_d2_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_perf_busy_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_perf_read_stall_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_perf_write_stall_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_perf_beats_reg_t;
+
+  typedef struct packed {logic [1:0] q;} dma_reg2hw_dst_data_type_reg_t;
+
+  typedef struct packed {logic q;} dma_reg2hw_sign_ext_reg_t;
+
+  typedef struct packed {logic [15:0] q;} dma_reg2hw_pace_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_fill_value_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_timer_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} gather;
+    struct packed {logic q;} offsets;
+    struct packed {logic [1:0] q;} shift;
+  } dma_reg2hw_addr_cfg_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [4:0] q;} pin;
+    struct packed {logic q;} rise;
+    struct packed {logic q;} fall;
+  } dma_reg2hw_strobe_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_strobe_missed_reg_t;
+
   typedef struct packed {
     struct packed {logic d;} ready;
     struct packed {logic d;} window_done;
+    struct packed {logic d;} transaction_done;
   } dma_hw2reg_status_reg_t;
 
   typedef struct packed {
@@ -68,46 +117,107 @@ package dma_reg_pkg;
     logic        de;
   } dma_hw2reg_window_count_reg_t;
 
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } dma_hw2reg_perf_busy_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } dma_hw2reg_perf_read_stall_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } dma_hw2reg_perf_write_stall_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } dma_hw2reg_perf_beats_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } dma_hw2reg_strobe_missed_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    dma_reg2hw_src_ptr_reg_t src_ptr;  // [250:219]
-    dma_reg2hw_dst_ptr_reg_t dst_ptr;  // [218:187]
-    dma_reg2hw_addr_ptr_reg_t addr_ptr;  // [186:155]
-    dma_reg2hw_size_reg_t size;  // [154:122]
-    dma_reg2hw_status_reg_t status;  // [121:118]
-    dma_reg2hw_ptr_inc_reg_t ptr_inc;  // [117:102]
-    dma_reg2hw_slot_reg_t slot;  // [101:70]
-    dma_reg2hw_data_type_reg_t data_type;  // [69:68]
-    dma_reg2hw_mode_reg_t mode;  // [67:66]
-    dma_reg2hw_window_size_reg_t window_size;  // [65:34]
-    dma_reg2hw_window_count_reg_t window_count;  // [33:2]
-    dma_reg2hw_interrupt_en_reg_t interrupt_en;  // [1:0]
+    dma_reg2hw_src_ptr_reg_t src_ptr;  // [603:572]
+    dma_reg2hw_dst_ptr_reg_t dst_ptr;  // [571:540]
+    dma_reg2hw_addr_ptr_reg_t addr_ptr;  // [539:508]
+    dma_reg2hw_size_reg_t size;  // [507:475]
+    dma_reg2hw_status_reg_t status;  // [474:469]
+    dma_reg2hw_ptr_inc_reg_t ptr_inc;  // [468:453]
+    dma_reg2hw_slot_reg_t slot;  // [452:421]
+    dma_reg2hw_data_type_reg_t data_type;  // [420:419]
+    dma_reg2hw_mode_reg_t mode;  // [418:417]
+    dma_reg2hw_window_size_reg_t window_size;  // [416:385]
+    dma_reg2hw_window_count_reg_t window_count;  // [384:353]
+    dma_reg2hw_interrupt_en_reg_t interrupt_en;  // [352:351]
+    dma_reg2hw_desc_ptr_reg_t desc_ptr;  // [350:318]
+    dma_reg2hw_size_d1_reg_t size_d1;  // [317:286]
+    dma_reg2hw_ptr_inc_d2_reg_t ptr_inc_d2;  // [285:254]
+    dma_reg2hw_perf_busy_reg_t perf_busy;  // [253:222]
+    dma_reg2hw_perf_read_stall_reg_t perf_read_stall;  // [221:190]
+    dma_reg2hw_perf_write_stall_reg_t perf_write_stall;  // [189:158]
+    dma_reg2hw_perf_beats_reg_t perf_beats;  // [157:126]
+    dma_reg2hw_dst_data_type_reg_t dst_data_type;  // [125:124]
+    dma_reg2hw_sign_ext_reg_t sign_ext;  // [123]
+    dma_reg2hw_pace_reg_t pace;  // [122:107]
+    dma_reg2hw_fill_value_reg_t fill_value;  // [106:75]
+    dma_reg2hw_timer_reg_t timer;  // [74:43]
+    dma_reg2hw_addr_cfg_reg_t addr_cfg;  // [42:39]
+    dma_reg2hw_strobe_reg_t strobe;  // [38:32]
+    dma_reg2hw_strobe_missed_reg_t strobe_missed;  // [31:0]
   } dma_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    dma_hw2reg_status_reg_t status;  // [34:33]
-    dma_hw2reg_window_count_reg_t window_count;  // [32:0]
+    dma_hw2reg_status_reg_t status;  // [200:198]
+    dma_hw2reg_window_count_reg_t window_count;  // [197:165]
+    dma_hw2reg_perf_busy_reg_t perf_busy;  // [164:132]
+    dma_hw2reg_perf_read_stall_reg_t perf_read_stall;  // [131:99]
+    dma_hw2reg_perf_write_stall_reg_t perf_write_stall;  // [98:66]
+    dma_hw2reg_perf_beats_reg_t perf_beats;  // [65:33]
+    dma_hw2reg_strobe_missed_reg_t strobe_missed;  // [32:0]
   } dma_hw2reg_t;
 
   // Register offsets
-  parameter logic [BlockAw-1:0] DMA_SRC_PTR_OFFSET = 6'h0;
-  parameter logic [BlockAw-1:0] DMA_DST_PTR_OFFSET = 6'h4;
-  parameter logic [BlockAw-1:0] DMA_ADDR_PTR_OFFSET = 6'h8;
-  parameter logic [BlockAw-1:0] DMA_SIZE_OFFSET = 6'hc;
-  parameter logic [BlockAw-1:0] DMA_STATUS_OFFSET = 6'h10;
-  parameter logic [BlockAw-1:0] DMA_PTR_INC_OFFSET = 6'h14;
-  parameter logic [BlockAw-1:0] DMA_SLOT_OFFSET = 6'h18;
-  parameter logic [BlockAw-1:0] DMA_DATA_TYPE_OFFSET = 6'h1c;
-  parameter logic [BlockAw-1:0] DMA_MODE_OFFSET = 6'h20;
-  parameter logic [BlockAw-1:0] DMA_WINDOW_SIZE_OFFSET = 6'h24;
-  parameter logic [BlockAw-1:0] DMA_WINDOW_COUNT_OFFSET = 6'h28;
-  parameter logic [BlockAw-1:0] DMA_INTERRUPT_EN_OFFSET = 6'h2c;
+  parameter logic [BlockAw-1:0] DMA_SRC_PTR_OFFSET = 7'h0;
+  parameter logic [BlockAw-1:0] DMA_DST_PTR_OFFSET = 7'h4;
+  parameter logic [BlockAw-1:0] DMA_ADDR_PTR_OFFSET = 7'h8;
+  parameter logic [BlockAw-1:0] DMA_SIZE_OFFSET = 7'hc;
+  parameter logic [BlockAw-1:0] DMA_STATUS_OFFSET = 7'h10;
+  parameter logic [BlockAw-1:0] DMA_PTR_INC_OFFSET = 7'h14;
+  parameter logic [BlockAw-1:0] DMA_SLOT_OFFSET = 7'h18;
+  parameter logic [BlockAw-1:0] DMA_DATA_TYPE_OFFSET = 7'h1c;
+  parameter logic [BlockAw-1:0] DMA_MODE_OFFSET = 7'h20;
+  parameter logic [BlockAw-1:0] DMA_WINDOW_SIZE_OFFSET = 7'h24;
+  parameter logic [BlockAw-1:0] DMA_WINDOW_COUNT_OFFSET = 7'h28;
+  parameter logic [BlockAw-1:0] DMA_INTERRUPT_EN_OFFSET = 7'h2c;
+  parameter logic [BlockAw-1:0] DMA_DESC_PTR_OFFSET = 7'h30;
+  parameter logic [BlockAw-1:0] DMA_SIZE_D1_OFFSET = 7'h34;
+  parameter logic [BlockAw-1:0] DMA_PTR_INC_D2_OFFSET = 7'h38;
+  parameter logic [BlockAw-1:0] DMA_PERF_BUSY_OFFSET = 7'h3c;
+  parameter logic [BlockAw-1:0] DMA_PERF_READ_STALL_OFFSET = 7'h40;
+  parameter logic [BlockAw-1:0] DMA_PERF_WRITE_STALL_OFFSET = 7'h44;
+  parameter logic [BlockAw-1:0] DMA_PERF_BEATS_OFFSET = 7'h48;
+  parameter logic [BlockAw-1:0] DMA_DST_DATA_TYPE_OFFSET = 7'h4c;
+  parameter logic [BlockAw-1:0] DMA_SIGN_EXT_OFFSET = 7'h50;
+  parameter logic [BlockAw-1:0] DMA_PACE_OFFSET = 7'h54;
+  parameter logic [BlockAw-1:0] DMA_FILL_VALUE_OFFSET = 7'h58;
+  parameter logic [BlockAw-1:0] DMA_TIMER_OFFSET = 7'h5c;
+  parameter logic [BlockAw-1:0] DMA_ADDR_CFG_OFFSET = 7'h60;
+  parameter logic [BlockAw-1:0] DMA_STROBE_OFFSET = 7'h64;
+  parameter logic [BlockAw-1:0] DMA_STROBE_MISSED_OFFSET = 7'h68;
 
   // Reset values for hwext registers and their fields
-  parameter logic [1:0] DMA_STATUS_RESVAL = 2'h1;
+  parameter logic [2:0] DMA_STATUS_RESVAL = 3'h1;
   parameter logic [0:0] DMA_STATUS_READY_RESVAL = 1'h1;
   parameter logic [0:0] DMA_STATUS_WINDOW_DONE_RESVAL = 1'h0;
+  parameter logic [0:0] DMA_STATUS_TRANSACTION_DONE_RESVAL = 1'h0;
 
   // Register index
   typedef enum int {
@@ -122,11 +232,26 @@ package dma_reg_pkg;
     DMA_MODE,
     DMA_WINDOW_SIZE,
     DMA_WINDOW_COUNT,
-    DMA_INTERRUPT_EN
+    DMA_INTERRUPT_EN,
+    DMA_DESC_PTR,
+    DMA_SIZE_D1,
+    DMA_PTR_INC_D2,
+    DMA_PERF_BUSY,
+    DMA_PERF_READ_STALL,
+    DMA_PERF_WRITE_STALL,
+    DMA_PERF_BEATS,
+    DMA_DST_DATA_TYPE,
+    DMA_SIGN_EXT,
+    DMA_PACE,
+    DMA_FILL_VALUE,
+    DMA_TIMER,
+    DMA_ADDR_CFG,
+    DMA_STROBE,
+    DMA_STROBE_MISSED
   } dma_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] DMA_PERMIT[12] = '{
+  parameter logic [3:0] DMA_PERMIT[27] = '{
       4'b1111,  // index[ 0] DMA_SRC_PTR
       4'b1111,  // index[ 1] DMA_DST_PTR
       4'b1111,  // index[ 2] DMA_ADDR_PTR
@@ -138,7 +263,22 @@ package dma_reg_pkg;
       4'b0001,  // index[ 8] DMA_MODE
       4'b1111,  // index[ 9] DMA_WINDOW_SIZE
       4'b1111,  // index[10] DMA_WINDOW_COUNT
-      4'b0001  // index[11] DMA_INTERRUPT_EN
+      4'b0001,  // index[11] DMA_INTERRUPT_EN
+      4'b1111,  // index[12] DMA_DESC_PTR
+      4'b1111,  // index[13] DMA_SIZE_D1
+      4'b1111,  // index[14] DMA_PTR_INC_D2
+      4'b1111,  // index[15] DMA_PERF_BUSY
+      4'b1111,  // index[16] DMA_PERF_READ_STALL
+      4'b1111,  // index[17] DMA_PERF_WRITE_STALL
+      4'b1111,  // index[18] DMA_PERF_BEATS
+      4'b0001,  // index[19] DMA_DST_DATA_TYPE
+      4'b0001,  // index[20] DMA_SIGN_EXT
+      4'b0011,  // index[21] DMA_PACE
+      4'b1111,  // index[22] DMA_FILL_VALUE
+      4'b1111,  // index[23] DMA_TIMER
+      4'b0001,  // index[24] DMA_ADDR_CFG
+      4'b0011,  // index[25] DMA_STROBE
+      4'b1111  // index[26] DMA_STROBE_MISSED
   };
 
 endpackage
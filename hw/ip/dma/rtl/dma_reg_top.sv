@@ -10,7 +10,7 @@
 module dma_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 6
+    parameter int AW = 7
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -84,6 +84,8 @@ module dma_reg_top #(
   logic status_ready_re;
   logic status_window_done_qs;
   logic status_window_done_re;
+  logic status_transaction_done_qs;
+  logic status_transaction_done_re;
   logic [7:0] ptr_inc_src_ptr_inc_qs;
   logic [7:0] ptr_inc_src_ptr_inc_wd;
   logic ptr_inc_src_ptr_inc_we;
@@ -112,6 +114,56 @@ module dma_reg_top #(
   logic interrupt_en_window_done_qs;
   logic interrupt_en_window_done_wd;
   logic interrupt_en_window_done_we;
+  logic [31:0] desc_ptr_qs;
+  logic [31:0] desc_ptr_wd;
+  logic desc_ptr_we;
+  logic [31:0] size_d1_qs;
+  logic [31:0] size_d1_wd;
+  logic size_d1_we;
+  logic [15:0] ptr_inc_d2_src_ptr_inc_d2_qs;
+  logic [15:0] ptr_inc_d2_src_ptr_inc_d2_wd;
+  logic ptr_inc_d2_src_ptr_inc_d2_we;
+  logic [15:0] ptr_inc_d2_dst_ptr_inc_d2_qs;
+  logic [15:0] ptr_inc_d2_dst_ptr_inc_d2_wd;
+  logic ptr_inc_d2_dst_ptr_inc_d2_we;
+  logic [31:0] perf_busy_qs;
+  logic [31:0] perf_read_stall_qs;
+  logic [31:0] perf_write_stall_qs;
+  logic [31:0] perf_beats_qs;
+  logic [1:0] dst_data_type_qs;
+  logic [1:0] dst_data_type_wd;
+  logic dst_data_type_we;
+  logic sign_ext_qs;
+  logic sign_ext_wd;
+  logic sign_ext_we;
+  logic [15:0] pace_qs;
+  logic [15:0] pace_wd;
+  logic pace_we;
+  logic [31:0] fill_value_qs;
+  logic [31:0] fill_value_wd;
+  logic fill_value_we;
+  logic [31:0] timer_qs;
+  logic [31:0] timer_wd;
+  logic timer_we;
+  logic addr_cfg_gather_qs;
+  logic addr_cfg_gather_wd;
+  logic addr_cfg_gather_we;
+  logic addr_cfg_offsets_qs;
+  logic addr_cfg_offsets_wd;
+  logic addr_cfg_offsets_we;
+  logic [1:0] addr_cfg_shift_qs;
+  logic [1:0] addr_cfg_shift_wd;
+  logic addr_cfg_shift_we;
+  logic [4:0] strobe_pin_qs;
+  logic [4:0] strobe_pin_wd;
+  logic strobe_pin_we;
+  logic strobe_rise_qs;
+  logic strobe_rise_wd;
+  logic strobe_rise_we;
+  logic strobe_fall_qs;
+  logic strobe_fall_wd;
+  logic strobe_fall_we;
+  logic [31:0] strobe_missed_qs;
 
   // Register instances
   // R[src_ptr]: V(False)
@@ -254,6 +306,21 @@ module dma_reg_top #(
   );
 
 
+  //   F[transaction_done]: 2:2
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_transaction_done (
+      .re (status_transaction_done_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.transaction_done.d),
+      .qre(reg2hw.status.transaction_done.re),
+      .qe (),
+      .q  (reg2hw.status.transaction_done.q),
+      .qs (status_transaction_done_qs)
+  );
+
+
   // R[ptr_inc]: V(False)
 
   //   F[src_ptr_inc]: 7:0
@@ -523,9 +590,542 @@ module dma_reg_top #(
   );
 
 
+  // R[desc_ptr]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_desc_ptr (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(desc_ptr_we),
+      .wd(desc_ptr_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.desc_ptr.qe),
+      .q (reg2hw.desc_ptr.q),
+
+      // to register interface (read)
+      .qs(desc_ptr_qs)
+  );
+
+
+  // R[size_d1]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_size_d1 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(size_d1_we),
+      .wd(size_d1_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.size_d1.q),
+
+      // to register interface (read)
+      .qs(size_d1_qs)
+  );
+
+
+  // R[ptr_inc_d2]: V(False)
+
+  //   F[src_ptr_inc_d2]: 15:0
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_ptr_inc_d2_src_ptr_inc_d2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ptr_inc_d2_src_ptr_inc_d2_we),
+      .wd(ptr_inc_d2_src_ptr_inc_d2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ptr_inc_d2.src_ptr_inc_d2.q),
+
+      // to register interface (read)
+      .qs(ptr_inc_d2_src_ptr_inc_d2_qs)
+  );
+
+
+  //   F[dst_ptr_inc_d2]: 31:16
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_ptr_inc_d2_dst_ptr_inc_d2 (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ptr_inc_d2_dst_ptr_inc_d2_we),
+      .wd(ptr_inc_d2_dst_ptr_inc_d2_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ptr_inc_d2.dst_ptr_inc_d2.q),
+
+      // to register interface (read)
+      .qs(ptr_inc_d2_dst_ptr_inc_d2_qs)
+  );
+
+
+  // R[perf_busy]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_perf_busy (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.perf_busy.de),
+      .d (hw2reg.perf_busy.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.perf_busy.q),
+
+      // to register interface (read)
+      .qs(perf_busy_qs)
+  );
+
+
+  // R[perf_read_stall]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_perf_read_stall (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.perf_read_stall.de),
+      .d (hw2reg.perf_read_stall.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.perf_read_stall.q),
+
+      // to register interface (read)
+      .qs(perf_read_stall_qs)
+  );
+
+
+  // R[perf_write_stall]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_perf_write_stall (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.perf_write_stall.de),
+      .d (hw2reg.perf_write_stall.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.perf_write_stall.q),
+
+      // to register interface (read)
+      .qs(perf_write_stall_qs)
+  );
+
+
+  // R[perf_beats]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_perf_beats (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.perf_beats.de),
+      .d (hw2reg.perf_beats.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.perf_beats.q),
+
+      // to register interface (read)
+      .qs(perf_beats_qs)
+  );
+
+
+  // R[dst_data_type]: V(False)
+
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_dst_data_type (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dst_data_type_we),
+      .wd(dst_data_type_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dst_data_type.q),
+
+      // to register interface (read)
+      .qs(dst_data_type_qs)
+  );
+
+
+  // R[sign_ext]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_sign_ext (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(sign_ext_we),
+      .wd(sign_ext_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.sign_ext.q),
+
+      // to register interface (read)
+      .qs(sign_ext_qs)
+  );
+
+
+  // R[pace]: V(False)
+
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'h0)
+  ) u_pace (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(pace_we),
+      .wd(pace_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.pace.q),
+
+      // to register interface (read)
+      .qs(pace_qs)
+  );
 
 
-  logic [11:0] addr_hit;
+  // R[fill_value]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_fill_value (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fill_value_we),
+      .wd(fill_value_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fill_value.q),
+
+      // to register interface (read)
+      .qs(fill_value_qs)
+  );
+
+
+  // R[timer]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_timer (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(timer_we),
+      .wd(timer_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.timer.q),
+
+      // to register interface (read)
+      .qs(timer_qs)
+  );
+
+
+  // R[addr_cfg]: V(False)
+
+  //   F[gather]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_addr_cfg_gather (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(addr_cfg_gather_we),
+      .wd(addr_cfg_gather_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.addr_cfg.gather.q),
+
+      // to register interface (read)
+      .qs(addr_cfg_gather_qs)
+  );
+
+
+  //   F[offsets]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_addr_cfg_offsets (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(addr_cfg_offsets_we),
+      .wd(addr_cfg_offsets_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.addr_cfg.offsets.q),
+
+      // to register interface (read)
+      .qs(addr_cfg_offsets_qs)
+  );
+
+
+  //   F[shift]: 3:2
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_addr_cfg_shift (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(addr_cfg_shift_we),
+      .wd(addr_cfg_shift_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.addr_cfg.shift.q),
+
+      // to register interface (read)
+      .qs(addr_cfg_shift_qs)
+  );
+
+
+  // R[strobe]: V(False)
+
+  //   F[pin]: 4:0
+  prim_subreg #(
+      .DW      (5),
+      .SWACCESS("RW"),
+      .RESVAL  (5'h0)
+  ) u_strobe_pin (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(strobe_pin_we),
+      .wd(strobe_pin_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.strobe.pin.q),
+
+      // to register interface (read)
+      .qs(strobe_pin_qs)
+  );
+
+
+  //   F[rise]: 8:8
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_strobe_rise (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(strobe_rise_we),
+      .wd(strobe_rise_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.strobe.rise.q),
+
+      // to register interface (read)
+      .qs(strobe_rise_qs)
+  );
+
+
+  //   F[fall]: 9:9
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_strobe_fall (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(strobe_fall_we),
+      .wd(strobe_fall_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.strobe.fall.q),
+
+      // to register interface (read)
+      .qs(strobe_fall_qs)
+  );
+
+
+  // R[strobe_missed]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RO"),
+      .RESVAL  (32'h0)
+  ) u_strobe_missed (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.strobe_missed.de),
+      .d (hw2reg.strobe_missed.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.strobe_missed.q),
+
+      // to register interface (read)
+      .qs(strobe_missed_qs)
+  );
+
+
+
+
+  logic [26:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == DMA_SRC_PTR_OFFSET);
@@ -540,6 +1140,21 @@ module dma_reg_top #(
     addr_hit[9] = (reg_addr == DMA_WINDOW_SIZE_OFFSET);
     addr_hit[10] = (reg_addr == DMA_WINDOW_COUNT_OFFSET);
     addr_hit[11] = (reg_addr == DMA_INTERRUPT_EN_OFFSET);
+    addr_hit[12] = (reg_addr == DMA_DESC_PTR_OFFSET);
+    addr_hit[13] = (reg_addr == DMA_SIZE_D1_OFFSET);
+    addr_hit[14] = (reg_addr == DMA_PTR_INC_D2_OFFSET);
+    addr_hit[15] = (reg_addr == DMA_PERF_BUSY_OFFSET);
+    addr_hit[16] = (reg_addr == DMA_PERF_READ_STALL_OFFSET);
+    addr_hit[17] = (reg_addr == DMA_PERF_WRITE_STALL_OFFSET);
+    addr_hit[18] = (reg_addr == DMA_PERF_BEATS_OFFSET);
+    addr_hit[19] = (reg_addr == DMA_DST_DATA_TYPE_OFFSET);
+    addr_hit[20] = (reg_addr == DMA_SIGN_EXT_OFFSET);
+    addr_hit[21] = (reg_addr == DMA_PACE_OFFSET);
+    addr_hit[22] = (reg_addr == DMA_FILL_VALUE_OFFSET);
+    addr_hit[23] = (reg_addr == DMA_TIMER_OFFSET);
+    addr_hit[24] = (reg_addr == DMA_ADDR_CFG_OFFSET);
+    addr_hit[25] = (reg_addr == DMA_STROBE_OFFSET);
+    addr_hit[26] = (reg_addr == DMA_STROBE_MISSED_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -558,7 +1173,22 @@ module dma_reg_top #(
                (addr_hit[ 8] & (|(DMA_PERMIT[ 8] & ~reg_be))) |
                (addr_hit[ 9] & (|(DMA_PERMIT[ 9] & ~reg_be))) |
                (addr_hit[10] & (|(DMA_PERMIT[10] & ~reg_be))) |
-               (addr_hit[11] & (|(DMA_PERMIT[11] & ~reg_be)))));
+               (addr_hit[11] & (|(DMA_PERMIT[11] & ~reg_be))) |
+               (addr_hit[12] & (|(DMA_PERMIT[12] & ~reg_be))) |
+               (addr_hit[13] & (|(DMA_PERMIT[13] & ~reg_be))) |
+               (addr_hit[14] & (|(DMA_PERMIT[14] & ~reg_be))) |
+               (addr_hit[15] & (|(DMA_PERMIT[15] & ~reg_be))) |
+               (addr_hit[16] & (|(DMA_PERMIT[16] & ~reg_be))) |
+               (addr_hit[17] & (|(DMA_PERMIT[17] & ~reg_be))) |
+               (addr_hit[18] & (|(DMA_PERMIT[18] & ~reg_be))) |
+               (addr_hit[19] & (|(DMA_PERMIT[19] & ~reg_be))) |
+               (addr_hit[20] & (|(DMA_PERMIT[20] & ~reg_be))) |
+               (addr_hit[21] & (|(DMA_PERMIT[21] & ~reg_be))) |
+               (addr_hit[22] & (|(DMA_PERMIT[22] & ~reg_be))) |
+               (addr_hit[23] & (|(DMA_PERMIT[23] & ~reg_be))) |
+               (addr_hit[24] & (|(DMA_PERMIT[24] & ~reg_be))) |
+               (addr_hit[25] & (|(DMA_PERMIT[25] & ~reg_be))) |
+               (addr_hit[26] & (|(DMA_PERMIT[26] & ~reg_be)))));
   end
 
   assign src_ptr_we = addr_hit[0] & reg_we & !reg_error;
@@ -577,6 +1207,8 @@ module dma_reg_top #(
 
   assign status_window_done_re = addr_hit[4] & reg_re & !reg_error;
 
+  assign status_transaction_done_re = addr_hit[4] & reg_re & !reg_error;
+
   assign ptr_inc_src_ptr_inc_we = addr_hit[5] & reg_we & !reg_error;
   assign ptr_inc_src_ptr_inc_wd = reg_wdata[7:0];
 
@@ -604,6 +1236,51 @@ module dma_reg_top #(
   assign interrupt_en_window_done_we = addr_hit[11] & reg_we & !reg_error;
   assign interrupt_en_window_done_wd = reg_wdata[1];
 
+  assign desc_ptr_we = addr_hit[12] & reg_we & !reg_error;
+  assign desc_ptr_wd = reg_wdata[31:0];
+
+  assign size_d1_we = addr_hit[13] & reg_we & !reg_error;
+  assign size_d1_wd = reg_wdata[31:0];
+
+  assign ptr_inc_d2_src_ptr_inc_d2_we = addr_hit[14] & reg_we & !reg_error;
+  assign ptr_inc_d2_src_ptr_inc_d2_wd = reg_wdata[15:0];
+
+  assign ptr_inc_d2_dst_ptr_inc_d2_we = addr_hit[14] & reg_we & !reg_error;
+  assign ptr_inc_d2_dst_ptr_inc_d2_wd = reg_wdata[31:16];
+
+  assign dst_data_type_we = addr_hit[19] & reg_we & !reg_error;
+  assign dst_data_type_wd = reg_wdata[1:0];
+
+  assign sign_ext_we = addr_hit[20] & reg_we & !reg_error;
+  assign sign_ext_wd = reg_wdata[0];
+
+  assign pace_we = addr_hit[21] & reg_we & !reg_error;
+  assign pace_wd = reg_wdata[15:0];
+
+  assign fill_value_we = addr_hit[22] & reg_we & !reg_error;
+  assign fill_value_wd = reg_wdata[31:0];
+
+  assign timer_we = addr_hit[23] & reg_we & !reg_error;
+  assign timer_wd = reg_wdata[31:0];
+
+  assign addr_cfg_gather_we = addr_hit[24] & reg_we & !reg_error;
+  assign addr_cfg_gather_wd = reg_wdata[0];
+
+  assign addr_cfg_offsets_we = addr_hit[24] & reg_we & !reg_error;
+  assign addr_cfg_offsets_wd = reg_wdata[1];
+
+  assign addr_cfg_shift_we = addr_hit[24] & reg_we & !reg_error;
+  assign addr_cfg_shift_wd = reg_wdata[3:2];
+
+  assign strobe_pin_we = addr_hit[25] & reg_we & !reg_error;
+  assign strobe_pin_wd = reg_wdata[4:0];
+
+  assign strobe_rise_we = addr_hit[25] & reg_we & !reg_error;
+  assign strobe_rise_wd = reg_wdata[8];
+
+  assign strobe_fall_we = addr_hit[25] & reg_we & !reg_error;
+  assign strobe_fall_wd = reg_wdata[9];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -627,6 +1304,7 @@ module dma_reg_top #(
       addr_hit[4]: begin
         reg_rdata_next[0] = status_ready_qs;
         reg_rdata_next[1] = status_window_done_qs;
+        reg_rdata_next[2] = status_transaction_done_qs;
       end
 
       addr_hit[5]: begin
@@ -660,6 +1338,71 @@ module dma_reg_top #(
         reg_rdata_next[1] = interrupt_en_window_done_qs;
       end
 
+      addr_hit[12]: begin
+        reg_rdata_next[31:0] = desc_ptr_qs;
+      end
+
+      addr_hit[13]: begin
+        reg_rdata_next[31:0] = size_d1_qs;
+      end
+
+      addr_hit[14]: begin
+        reg_rdata_next[15:0] = ptr_inc_d2_src_ptr_inc_d2_qs;
+        reg_rdata_next[31:16] = ptr_inc_d2_dst_ptr_inc_d2_qs;
+      end
+
+      addr_hit[15]: begin
+        reg_rdata_next[31:0] = perf_busy_qs;
+      end
+
+      addr_hit[16]: begin
+        reg_rdata_next[31:0] = perf_read_stall_qs;
+      end
+
+      addr_hit[17]: begin
+        reg_rdata_next[31:0] = perf_write_stall_qs;
+      end
+
+      addr_hit[18]: begin
+        reg_rdata_next[31:0] = perf_beats_qs;
+      end
+
+      addr_hit[19]: begin
+        reg_rdata_next[1:0] = dst_data_type_qs;
+      end
+
+      addr_hit[20]: begin
+        reg_rdata_next[0] = sign_ext_qs;
+      end
+
+      addr_hit[21]: begin
+        reg_rdata_next[15:0] = pace_qs;
+      end
+
+      addr_hit[22]: begin
+        reg_rdata_next[31:0] = fill_value_qs;
+      end
+
+      addr_hit[23]: begin
+        reg_rdata_next[31:0] = timer_qs;
+      end
+
+      addr_hit[24]: begin
+        reg_rdata_next[0] = addr_cfg_gather_qs;
+        reg_rdata_next[1] = addr_cfg_offsets_qs;
+        reg_rdata_next[3:2] = addr_cfg_shift_qs;
+      end
+
+      addr_hit[25]: begin
+        reg_rdata_next[4:0] = strobe_pin_qs;
+        reg_rdata_next[8] = strobe_rise_qs;
+        reg_rdata_next[9] = strobe_fall_qs;
+      end
+
+      addr_hit[26]: begin
+        reg_rdata_next[31:0] = strobe_missed_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -681,7 +1424,7 @@ module dma_reg_top #(
 endmodule
 
 module dma_reg_top_intf #(
-    parameter  int AW = 6,
+    parameter  int AW = 7,
     localparam int DW = 32
 ) (
     input logic clk_i,
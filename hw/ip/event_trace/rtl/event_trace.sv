@@ -0,0 +1,263 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Event trace unit of the always-on peripherals. While enabled, it counts
+// the cycles and records the selected hardware events and the markers
+// written by the software in a ring of DEPTH entries of its own, without any
+// access to the bus, so the real-time behavior on FPGA or silicon is timed
+// without being perturbed. Each entry is {code[7:0], time[23:0]}:
+//   0x00              WRAP: the low 24 bits of time wrapped to 0
+//   0x20 | id         IRQ_TAKEN: the core took the interrupt id
+//   0x40 | line       IRQ_RAISED: the line of intr_i rose
+//   0x60 | ch         DMA_DONE: the done interrupt of the channel rose
+//   0x70 | ch         DMA_WINDOW: the window interrupt of the channel rose
+//   0x80 | 2 * d | on POWER: the power domain d switched off (0) or on (1)
+//   0xC0 | marker     MARKER: the software wrote the marker to MARKER
+// The ring takes an entry per cycle: the events of the same cycle are
+// recorded in the order of the list, one cycle apart. An event that comes
+// again before its first occurrence is recorded is lost and counted in
+// DROPPED. With the WRAP events, the software rebuilds the full time of all
+// the entries from the current time. The registers are described in
+// data/event_trace.hjson: CTRL (ENABLE, STOP_WHEN_FULL, CLEAR), EVENTS,
+// IRQ_MASK, MARKER, STATUS (COUNT, OVERWRITTEN), WR_IDX, DROPPED, CYCLES and
+// DEPTH, and the entry i of the ring is read at 0x1000 + 4 * i. The writes of
+// the ring and its addresses past DEPTH return an error.
+
+module event_trace #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    // Power of 2 between 16 and 1024
+    parameter int unsigned DEPTH = 64,
+    // At most 16
+    parameter int unsigned DMA_CH_NUM = 1,
+    // Power domains of power_on_i, at most 32
+    parameter int unsigned NUM_DOMAINS = 3
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // Interrupts of the core, and the interrupt it takes
+    input logic [31:0] intr_i,
+    input logic        irq_ack_i,
+    input logic [ 4:0] irq_id_i,
+
+    // Interrupts of the channels of the DMA
+    input logic [DMA_CH_NUM-1:0] dma_done_i,
+    input logic [DMA_CH_NUM-1:0] dma_window_i,
+
+    // State of the power domains, 1 when on
+    input logic [NUM_DOMAINS-1:0] power_on_i
+);
+
+  localparam int unsigned IdxW = $clog2(DEPTH);
+
+  // Sources of the events, in the order of their priority
+  localparam int unsigned SrcWrap = 0;
+  localparam int unsigned SrcMarker = 1;
+  localparam int unsigned SrcIrqTaken = 2;
+  localparam int unsigned SrcIrqRaised = 3;
+  localparam int unsigned SrcDmaDone = SrcIrqRaised + 32;
+  localparam int unsigned SrcDmaWindow = SrcDmaDone + DMA_CH_NUM;
+  localparam int unsigned SrcPower = SrcDmaWindow + DMA_CH_NUM;
+  localparam int unsigned NumSrc = SrcPower + 2 * NUM_DOMAINS;
+  localparam int unsigned SrcW = $clog2(NumSrc);
+
+  // Bits of EVENTS
+  localparam int unsigned EvWrap = 0;
+  localparam int unsigned EvMarker = 1;
+  localparam int unsigned EvIrqTaken = 2;
+  localparam int unsigned EvIrqRaised = 3;
+  localparam int unsigned EvDmaDone = 4;
+  localparam int unsigned EvDmaWindow = 5;
+  localparam int unsigned EvPower = 6;
+  localparam int unsigned NumEv = 7;
+
+  import event_trace_reg_pkg::*;
+
+  event_trace_reg2hw_t reg2hw;
+  event_trace_hw2reg_t hw2reg;
+
+  reg_req_t [0:0] ring_win_req;
+  reg_rsp_t [0:0] ring_win_rsp;
+
+  logic enable_q, stop_q;
+  logic [NumEv-1:0] events_en;
+  logic [31:0] irq_mask;
+  logic [31:0] time_q;
+  logic [31:0] dropped_q;
+  logic [5:0] marker_q;
+  logic [4:0] irq_id_q;
+
+  logic [31:0] intr_q;
+  logic [DMA_CH_NUM-1:0] dma_done_q, dma_window_q;
+  logic [NUM_DOMAINS-1:0] power_on_q;
+
+  logic [DEPTH-1:0][31:0] ring_q;
+  logic [IdxW-1:0] wr_idx_q;
+  logic [IdxW:0] count_q;
+  logic overwritten_q;
+
+  logic [NumSrc-1:0] pending_q, events, popped, held, lost;
+  logic [SrcW-1:0] sel;
+  logic sel_valid;
+  logic [7:0] code;
+  logic full, push;
+
+  logic [IdxW-1:0] ring_idx;
+  logic ring_valid;
+  logic marker_we, clear;
+
+  event_trace_reg_top #(
+      .reg_req_t(reg_req_t),
+      .reg_rsp_t(reg_rsp_t)
+  ) event_trace_reg_top_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i,
+      .reg_rsp_o,
+      .reg_req_win_o(ring_win_req),
+      .reg_rsp_win_i(ring_win_rsp),
+      .reg2hw,
+      .hw2reg,
+      .devmode_i(1'b1)
+  );
+
+  assign events_en[EvWrap] = reg2hw.events.wrap.q;
+  assign events_en[EvMarker] = reg2hw.events.marker.q;
+  assign events_en[EvIrqTaken] = reg2hw.events.irq_taken.q;
+  assign events_en[EvIrqRaised] = reg2hw.events.irq_raised.q;
+  assign events_en[EvDmaDone] = reg2hw.events.dma_done.q;
+  assign events_en[EvDmaWindow] = reg2hw.events.dma_window.q;
+  assign events_en[EvPower] = reg2hw.events.power.q;
+  assign irq_mask = reg2hw.irq_mask.q;
+
+  assign marker_we = reg2hw.marker.qe;
+  assign clear = reg2hw.ctrl.clear.qe && reg2hw.ctrl.clear.q;
+
+  assign hw2reg.ctrl.enable.d = enable_q;
+  assign hw2reg.ctrl.stop_when_full.d = stop_q;
+  assign hw2reg.status.count.d = 16'(count_q);
+  assign hw2reg.status.overwritten.d = overwritten_q;
+  assign hw2reg.wr_idx.d = 32'(wr_idx_q);
+  assign hw2reg.dropped.d = dropped_q;
+  assign hw2reg.cycles.d = time_q;
+  assign hw2reg.depth.d = 32'(DEPTH);
+
+  // Ring window, without wait states
+  assign ring_idx = ring_win_req[0].addr[IdxW+1:2];
+  assign ring_valid = 32'(ring_win_req[0].addr[11:2]) < DEPTH;
+
+  assign ring_win_rsp[0].rdata = ring_q[ring_idx];
+  assign ring_win_rsp[0].error = ring_win_req[0].valid && (ring_win_req[0].write || !ring_valid);
+  assign ring_win_rsp[0].ready = 1'b1;
+
+  // The events of the cycle, from the edges of the inputs
+  always_comb begin
+    events = '0;
+    events[SrcWrap] = events_en[EvWrap] && time_q[23:0] == '1;
+    events[SrcMarker] = events_en[EvMarker] && marker_we;
+    events[SrcIrqTaken] = events_en[EvIrqTaken] && irq_ack_i && irq_mask[irq_id_i];
+    events[SrcIrqRaised+:32] = {32{events_en[EvIrqRaised]}} & irq_mask & intr_i & ~intr_q;
+    events[SrcDmaDone+:DMA_CH_NUM] = {DMA_CH_NUM{events_en[EvDmaDone]}} & dma_done_i & ~dma_done_q;
+    events[SrcDmaWindow+:DMA_CH_NUM] =
+        {DMA_CH_NUM{events_en[EvDmaWindow]}} & dma_window_i & ~dma_window_q;
+    for (int unsigned d = 0; d < NUM_DOMAINS; d++) begin
+      events[SrcPower+2*d] = events_en[EvPower] && power_on_q[d] && !power_on_i[d];
+      events[SrcPower+2*d+1] = events_en[EvPower] && !power_on_q[d] && power_on_i[d];
+    end
+    if (!enable_q) events = '0;
+  end
+
+  // The pending event of the highest priority goes to the ring
+  always_comb begin
+    sel = '0;
+    sel_valid = 1'b0;
+    for (int i = NumSrc - 1; i >= 0; i--) begin
+      if (pending_q[i]) begin
+        sel = SrcW'(i);
+        sel_valid = 1'b1;
+      end
+    end
+  end
+
+  always_comb begin
+    if (32'(sel) == SrcWrap) code = 8'h00;
+    else if (32'(sel) == SrcMarker) code = {2'b11, marker_q};
+    else if (32'(sel) == SrcIrqTaken) code = {3'b001, irq_id_q};
+    else if (32'(sel) < SrcDmaDone) code = 8'h40 | 8'(32'(sel) - SrcIrqRaised);
+    else if (32'(sel) < SrcDmaWindow) code = 8'h60 | 8'(32'(sel) - SrcDmaDone);
+    else if (32'(sel) < SrcPower) code = 8'h70 | 8'(32'(sel) - SrcDmaWindow);
+    else code = 8'h80 | 8'(32'(sel) - SrcPower);
+  end
+
+  assign full = count_q == (IdxW + 1)'(DEPTH);
+  assign push = sel_valid && !(stop_q && full);
+  assign popped = push ? NumSrc'(1) << sel : '0;
+  assign held = pending_q & ~popped;
+  assign lost = events & held;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      intr_q       <= '0;
+      dma_done_q   <= '0;
+      dma_window_q <= '0;
+      power_on_q   <= '1;
+    end else begin
+      intr_q       <= intr_i;
+      dma_done_q   <= dma_done_i;
+      dma_window_q <= dma_window_i;
+      power_on_q   <= power_on_i;
+    end
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      enable_q      <= 1'b0;
+      stop_q        <= 1'b0;
+      time_q        <= '0;
+      dropped_q     <= '0;
+      marker_q      <= '0;
+      irq_id_q      <= '0;
+      pending_q     <= '0;
+      wr_idx_q      <= '0;
+      count_q       <= '0;
+      overwritten_q <= 1'b0;
+    end else begin
+      if (reg2hw.ctrl.enable.qe) begin
+        enable_q <= reg2hw.ctrl.enable.q;
+        stop_q   <= reg2hw.ctrl.stop_when_full.q;
+      end
+
+      if (events[SrcMarker] && !held[SrcMarker]) marker_q <= reg2hw.marker.q;
+      if (events[SrcIrqTaken] && !held[SrcIrqTaken]) irq_id_q <= irq_id_i;
+
+      if (clear) begin
+        time_q        <= '0;
+        dropped_q     <= '0;
+        pending_q     <= '0;
+        wr_idx_q      <= '0;
+        count_q       <= '0;
+        overwritten_q <= 1'b0;
+      end else begin
+        if (enable_q) time_q <= time_q + 32'd1;
+        dropped_q <= dropped_q + 32'($countones(lost));
+        pending_q <= held | events;
+        if (push) begin
+          wr_idx_q <= wr_idx_q + IdxW'(1);
+          if (full) overwritten_q <= 1'b1;
+          else count_q <= count_q + (IdxW + 1)'(1);
+        end
+      end
+    end
+  end
+
+  // The entries are only read up to COUNT, they need no reset
+  always_ff @(posedge clk_i) begin
+    if (push && !clear) ring_q[wr_idx_q] <= {code, time_q[23:0]};
+  end
+
+endmodule  // event_trace
@@ -0,0 +1,135 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Package auto-generated by `reggen` containing data structure
+
+package event_trace_reg_pkg;
+
+  // Address widths within the block
+  parameter int BlockAw = 13;
+
+  ////////////////////////////
+  // Typedefs for registers //
+  ////////////////////////////
+
+  typedef struct packed {
+    struct packed {
+      logic q;
+      logic qe;
+    } enable;
+    struct packed {
+      logic q;
+      logic qe;
+    } stop_when_full;
+    struct packed {
+      logic q;
+      logic qe;
+    } clear;
+  } event_trace_reg2hw_ctrl_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} wrap;
+    struct packed {logic q;} marker;
+    struct packed {logic q;} irq_taken;
+    struct packed {logic q;} irq_raised;
+    struct packed {logic q;} dma_done;
+    struct packed {logic q;} dma_window;
+    struct packed {logic q;} power;
+  } event_trace_reg2hw_events_reg_t;
+
+  typedef struct packed {logic [31:0] q;} event_trace_reg2hw_irq_mask_reg_t;
+
+  typedef struct packed {
+    logic [5:0] q;
+    logic       qe;
+  } event_trace_reg2hw_marker_reg_t;
+
+  typedef struct packed {
+    struct packed {logic d;} enable;
+    struct packed {logic d;} stop_when_full;
+  } event_trace_hw2reg_ctrl_reg_t;
+
+  typedef struct packed {
+    struct packed {logic [15:0] d;} count;
+    struct packed {logic d;} overwritten;
+  } event_trace_hw2reg_status_reg_t;
+
+  typedef struct packed {logic [31:0] d;} event_trace_hw2reg_wr_idx_reg_t;
+
+  typedef struct packed {logic [31:0] d;} event_trace_hw2reg_dropped_reg_t;
+
+  typedef struct packed {logic [31:0] d;} event_trace_hw2reg_cycles_reg_t;
+
+  typedef struct packed {logic [31:0] d;} event_trace_hw2reg_depth_reg_t;
+
+  // Register -> HW type
+  typedef struct packed {
+    event_trace_reg2hw_ctrl_reg_t ctrl;  // [51:46]
+    event_trace_reg2hw_events_reg_t events;  // [45:39]
+    event_trace_reg2hw_irq_mask_reg_t irq_mask;  // [38:7]
+    event_trace_reg2hw_marker_reg_t marker;  // [6:0]
+  } event_trace_reg2hw_t;
+
+  // HW -> register type
+  typedef struct packed {
+    event_trace_hw2reg_ctrl_reg_t ctrl;  // [146:145]
+    event_trace_hw2reg_status_reg_t status;  // [144:128]
+    event_trace_hw2reg_wr_idx_reg_t wr_idx;  // [127:96]
+    event_trace_hw2reg_dropped_reg_t dropped;  // [95:64]
+    event_trace_hw2reg_cycles_reg_t cycles;  // [63:32]
+    event_trace_hw2reg_depth_reg_t depth;  // [31:0]
+  } event_trace_hw2reg_t;
+
+  // Register offsets
+  parameter logic [BlockAw-1:0] EVENT_TRACE_CTRL_OFFSET = 13'h0;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_EVENTS_OFFSET = 13'h4;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_IRQ_MASK_OFFSET = 13'h8;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_MARKER_OFFSET = 13'hc;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_STATUS_OFFSET = 13'h10;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_WR_IDX_OFFSET = 13'h14;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_DROPPED_OFFSET = 13'h18;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_CYCLES_OFFSET = 13'h1c;
+  parameter logic [BlockAw-1:0] EVENT_TRACE_DEPTH_OFFSET = 13'h20;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [2:0] EVENT_TRACE_CTRL_RESVAL = 3'h0;
+  parameter logic [5:0] EVENT_TRACE_MARKER_RESVAL = 6'h0;
+  parameter logic [16:0] EVENT_TRACE_STATUS_RESVAL = 17'h0;
+  parameter logic [31:0] EVENT_TRACE_WR_IDX_RESVAL = 32'h0;
+  parameter logic [31:0] EVENT_TRACE_DROPPED_RESVAL = 32'h0;
+  parameter logic [31:0] EVENT_TRACE_CYCLES_RESVAL = 32'h0;
+  parameter logic [31:0] EVENT_TRACE_DEPTH_RESVAL = 32'h0;
+
+  // Window parameters
+  parameter logic [BlockAw-1:0] EVENT_TRACE_RING_OFFSET = 13'h1000;
+  parameter int unsigned EVENT_TRACE_RING_SIZE = 'h1000;
+
+  // Register index
+  typedef enum int {
+    EVENT_TRACE_CTRL,
+    EVENT_TRACE_EVENTS,
+    EVENT_TRACE_IRQ_MASK,
+    EVENT_TRACE_MARKER,
+    EVENT_TRACE_STATUS,
+    EVENT_TRACE_WR_IDX,
+    EVENT_TRACE_DROPPED,
+    EVENT_TRACE_CYCLES,
+    EVENT_TRACE_DEPTH
+  } event_trace_id_e;
+
+  // Register width information to check illegal writes
+  parameter logic [3:0] EVENT_TRACE_PERMIT[9] = '{
+      4'b0001,  // index[0] EVENT_TRACE_CTRL
+      4'b0001,  // index[1] EVENT_TRACE_EVENTS
+      4'b1111,  // index[2] EVENT_TRACE_IRQ_MASK
+      4'b0001,  // index[3] EVENT_TRACE_MARKER
+      4'b0111,  // index[4] EVENT_TRACE_STATUS
+      4'b1111,  // index[5] EVENT_TRACE_WR_IDX
+      4'b1111,  // index[6] EVENT_TRACE_DROPPED
+      4'b1111,  // index[7] EVENT_TRACE_CYCLES
+      4'b1111  // index[8] EVENT_TRACE_DEPTH
+  };
+
+endpackage
+
@@ -0,0 +1,741 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Top module auto-generated by `reggen`
+
+
+`include "common_cells/assertions.svh"
+
+module event_trace_reg_top #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int AW = 13
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // Output port for window
+    output reg_req_t [1-1:0] reg_req_win_o,
+    input  reg_rsp_t [1-1:0] reg_rsp_win_i,
+
+    // To HW
+    output event_trace_reg_pkg::event_trace_reg2hw_t reg2hw,  // Write
+    input  event_trace_reg_pkg::event_trace_hw2reg_t hw2reg,  // Read
+
+
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+
+  import event_trace_reg_pkg::*;
+
+  localparam int DW = 32;
+  localparam int DBW = DW / 8;  // Byte Width
+
+  // register signals
+  logic           reg_we;
+  logic           reg_re;
+  logic [ AW-1:0] reg_addr;
+  logic [ DW-1:0] reg_wdata;
+  logic [DBW-1:0] reg_be;
+  logic [ DW-1:0] reg_rdata;
+  logic           reg_error;
+
+  logic addrmiss, wr_err;
+
+  logic [DW-1:0] reg_rdata_next;
+
+  // Below register interface can be changed
+  reg_req_t reg_intf_req;
+  reg_rsp_t reg_intf_rsp;
+
+
+  logic [0:0] reg_steer;
+
+  reg_req_t [2-1:0] reg_intf_demux_req;
+  reg_rsp_t [2-1:0] reg_intf_demux_rsp;
+
+  // demux connection
+  assign reg_intf_req = reg_intf_demux_req[1];
+  assign reg_intf_demux_rsp[1] = reg_intf_rsp;
+
+  assign reg_req_win_o[0] = reg_intf_demux_req[0];
+  assign reg_intf_demux_rsp[0] = reg_rsp_win_i[0];
+
+  // Create Socket_1n
+  reg_demux #(
+      .NoPorts(2),
+      .req_t  (reg_req_t),
+      .rsp_t  (reg_rsp_t)
+  ) i_reg_demux (
+      .clk_i,
+      .rst_ni,
+      .in_req_i(reg_req_i),
+      .in_rsp_o(reg_rsp_o),
+      .out_req_o(reg_intf_demux_req),
+      .out_rsp_i(reg_intf_demux_rsp),
+      .in_select_i(reg_steer)
+  );
+
+
+  // Create steering logic
+  always_comb begin
+    reg_steer = 1;  // Default set to register
+
+    // TODO: Can below codes be unique case () inside ?
+    if (reg_req_i.addr[AW-1:0] >= 4096) begin
+      reg_steer = 0;
+    end
+  end
+
+
+  assign reg_we = reg_intf_req.valid & reg_intf_req.write;
+  assign reg_re = reg_intf_req.valid & ~reg_intf_req.write;
+  assign reg_addr = reg_intf_req.addr;
+  assign reg_wdata = reg_intf_req.wdata;
+  assign reg_be = reg_intf_req.wstrb;
+  assign reg_intf_rsp.rdata = reg_rdata;
+  assign reg_intf_rsp.error = reg_error;
+  assign reg_intf_rsp.ready = 1'b1;
+
+  assign reg_rdata = reg_rdata_next;
+  assign reg_error = (devmode_i & addrmiss) | wr_err;
+
+
+  // Define SW related signals
+  // Format: <reg>_<field>_{wd|we|qs}
+  //        or <reg>_{wd|we|qs} if field == 1 or 0
+  logic ctrl_enable_qs;
+  logic ctrl_enable_wd;
+  logic ctrl_enable_we;
+  logic ctrl_enable_re;
+  logic ctrl_stop_when_full_qs;
+  logic ctrl_stop_when_full_wd;
+  logic ctrl_stop_when_full_we;
+  logic ctrl_stop_when_full_re;
+  logic ctrl_clear_wd;
+  logic ctrl_clear_we;
+  logic events_wrap_qs;
+  logic events_wrap_wd;
+  logic events_wrap_we;
+  logic events_marker_qs;
+  logic events_marker_wd;
+  logic events_marker_we;
+  logic events_irq_taken_qs;
+  logic events_irq_taken_wd;
+  logic events_irq_taken_we;
+  logic events_irq_raised_qs;
+  logic events_irq_raised_wd;
+  logic events_irq_raised_we;
+  logic events_dma_done_qs;
+  logic events_dma_done_wd;
+  logic events_dma_done_we;
+  logic events_dma_window_qs;
+  logic events_dma_window_wd;
+  logic events_dma_window_we;
+  logic events_power_qs;
+  logic events_power_wd;
+  logic events_power_we;
+  logic [31:0] irq_mask_qs;
+  logic [31:0] irq_mask_wd;
+  logic irq_mask_we;
+  logic [5:0] marker_wd;
+  logic marker_we;
+  logic [15:0] status_count_qs;
+  logic status_count_re;
+  logic status_overwritten_qs;
+  logic status_overwritten_re;
+  logic [31:0] wr_idx_qs;
+  logic wr_idx_re;
+  logic [31:0] dropped_qs;
+  logic dropped_re;
+  logic [31:0] cycles_qs;
+  logic cycles_re;
+  logic [31:0] depth_qs;
+  logic depth_re;
+
+  // Register instances
+  // R[ctrl]: V(True)
+
+  //   F[enable]: 0:0
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_ctrl_enable (
+      .re (ctrl_enable_re),
+      .we (ctrl_enable_we),
+      .wd (ctrl_enable_wd),
+      .d  (hw2reg.ctrl.enable.d),
+      .qre(),
+      .qe (reg2hw.ctrl.enable.qe),
+      .q  (reg2hw.ctrl.enable.q),
+      .qs (ctrl_enable_qs)
+  );
+
+
+  //   F[stop_when_full]: 1:1
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_ctrl_stop_when_full (
+      .re (ctrl_stop_when_full_re),
+      .we (ctrl_stop_when_full_we),
+      .wd (ctrl_stop_when_full_wd),
+      .d  (hw2reg.ctrl.stop_when_full.d),
+      .qre(),
+      .qe (reg2hw.ctrl.stop_when_full.qe),
+      .q  (reg2hw.ctrl.stop_when_full.q),
+      .qs (ctrl_stop_when_full_qs)
+  );
+
+
+  //   F[clear]: 2:2
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_ctrl_clear (
+      .re (1'b0),
+      .we (ctrl_clear_we),
+      .wd (ctrl_clear_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.ctrl.clear.qe),
+      .q  (reg2hw.ctrl.clear.q),
+      .qs ()
+  );
+
+
+  // R[events]: V(False)
+
+  //   F[wrap]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_wrap (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_wrap_we),
+      .wd(events_wrap_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.wrap.q),
+
+      // to register interface (read)
+      .qs(events_wrap_qs)
+  );
+
+
+  //   F[marker]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_marker (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_marker_we),
+      .wd(events_marker_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.marker.q),
+
+      // to register interface (read)
+      .qs(events_marker_qs)
+  );
+
+
+  //   F[irq_taken]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_irq_taken (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_irq_taken_we),
+      .wd(events_irq_taken_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.irq_taken.q),
+
+      // to register interface (read)
+      .qs(events_irq_taken_qs)
+  );
+
+
+  //   F[irq_raised]: 3:3
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_irq_raised (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_irq_raised_we),
+      .wd(events_irq_raised_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.irq_raised.q),
+
+      // to register interface (read)
+      .qs(events_irq_raised_qs)
+  );
+
+
+  //   F[dma_done]: 4:4
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_dma_done (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_dma_done_we),
+      .wd(events_dma_done_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.dma_done.q),
+
+      // to register interface (read)
+      .qs(events_dma_done_qs)
+  );
+
+
+  //   F[dma_window]: 5:5
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_dma_window (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_dma_window_we),
+      .wd(events_dma_window_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.dma_window.q),
+
+      // to register interface (read)
+      .qs(events_dma_window_qs)
+  );
+
+
+  //   F[power]: 6:6
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_events_power (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(events_power_we),
+      .wd(events_power_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.events.power.q),
+
+      // to register interface (read)
+      .qs(events_power_qs)
+  );
+
+
+  // R[irq_mask]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'hffffffff)
+  ) u_irq_mask (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(irq_mask_we),
+      .wd(irq_mask_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.irq_mask.q),
+
+      // to register interface (read)
+      .qs(irq_mask_qs)
+  );
+
+
+  // R[marker]: V(True)
+
+  prim_subreg_ext #(
+      .DW(6)
+  ) u_marker (
+      .re (1'b0),
+      .we (marker_we),
+      .wd (marker_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.marker.qe),
+      .q  (reg2hw.marker.q),
+      .qs ()
+  );
+
+
+  // R[status]: V(True)
+
+  //   F[count]: 15:0
+  prim_subreg_ext #(
+      .DW(16)
+  ) u_status_count (
+      .re (status_count_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.count.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_count_qs)
+  );
+
+
+  //   F[overwritten]: 16:16
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_overwritten (
+      .re (status_overwritten_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.overwritten.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_overwritten_qs)
+  );
+
+
+  // R[wr_idx]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_wr_idx (
+      .re (wr_idx_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.wr_idx.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (wr_idx_qs)
+  );
+
+
+  // R[dropped]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_dropped (
+      .re (dropped_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.dropped.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (dropped_qs)
+  );
+
+
+  // R[cycles]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_cycles (
+      .re (cycles_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.cycles.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (cycles_qs)
+  );
+
+
+  // R[depth]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_depth (
+      .re (depth_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.depth.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (depth_qs)
+  );
+
+
+
+
+  logic [8:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == EVENT_TRACE_CTRL_OFFSET);
+    addr_hit[1] = (reg_addr == EVENT_TRACE_EVENTS_OFFSET);
+    addr_hit[2] = (reg_addr == EVENT_TRACE_IRQ_MASK_OFFSET);
+    addr_hit[3] = (reg_addr == EVENT_TRACE_MARKER_OFFSET);
+    addr_hit[4] = (reg_addr == EVENT_TRACE_STATUS_OFFSET);
+    addr_hit[5] = (reg_addr == EVENT_TRACE_WR_IDX_OFFSET);
+    addr_hit[6] = (reg_addr == EVENT_TRACE_DROPPED_OFFSET);
+    addr_hit[7] = (reg_addr == EVENT_TRACE_CYCLES_OFFSET);
+    addr_hit[8] = (reg_addr == EVENT_TRACE_DEPTH_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[0] & (|(EVENT_TRACE_PERMIT[0] & ~reg_be))) |
+               (addr_hit[1] & (|(EVENT_TRACE_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(EVENT_TRACE_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(EVENT_TRACE_PERMIT[3] & ~reg_be))) |
+               (addr_hit[4] & (|(EVENT_TRACE_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(EVENT_TRACE_PERMIT[5] & ~reg_be))) |
+               (addr_hit[6] & (|(EVENT_TRACE_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(EVENT_TRACE_PERMIT[7] & ~reg_be))) |
+               (addr_hit[8] & (|(EVENT_TRACE_PERMIT[8] & ~reg_be)))));
+  end
+
+  assign ctrl_enable_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_enable_wd = reg_wdata[0];
+  assign ctrl_enable_re = addr_hit[0] & reg_re & !reg_error;
+
+  assign ctrl_stop_when_full_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_stop_when_full_wd = reg_wdata[1];
+  assign ctrl_stop_when_full_re = addr_hit[0] & reg_re & !reg_error;
+
+  assign ctrl_clear_we = addr_hit[0] & reg_we & !reg_error;
+  assign ctrl_clear_wd = reg_wdata[2];
+
+  assign events_wrap_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_wrap_wd = reg_wdata[0];
+
+  assign events_marker_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_marker_wd = reg_wdata[1];
+
+  assign events_irq_taken_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_irq_taken_wd = reg_wdata[2];
+
+  assign events_irq_raised_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_irq_raised_wd = reg_wdata[3];
+
+  assign events_dma_done_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_dma_done_wd = reg_wdata[4];
+
+  assign events_dma_window_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_dma_window_wd = reg_wdata[5];
+
+  assign events_power_we = addr_hit[1] & reg_we & !reg_error;
+  assign events_power_wd = reg_wdata[6];
+
+  assign irq_mask_we = addr_hit[2] & reg_we & !reg_error;
+  assign irq_mask_wd = reg_wdata[31:0];
+
+  assign marker_we = addr_hit[3] & reg_we & !reg_error;
+  assign marker_wd = reg_wdata[5:0];
+
+  assign status_count_re = addr_hit[4] & reg_re & !reg_error;
+
+  assign status_overwritten_re = addr_hit[4] & reg_re & !reg_error;
+
+  assign wr_idx_re = addr_hit[5] & reg_re & !reg_error;
+
+  assign dropped_re = addr_hit[6] & reg_re & !reg_error;
+
+  assign cycles_re = addr_hit[7] & reg_re & !reg_error;
+
+  assign depth_re = addr_hit[8] & reg_re & !reg_error;
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[0] = ctrl_enable_qs;
+        reg_rdata_next[1] = ctrl_stop_when_full_qs;
+        reg_rdata_next[2] = '0;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[0] = events_wrap_qs;
+        reg_rdata_next[1] = events_marker_qs;
+        reg_rdata_next[2] = events_irq_taken_qs;
+        reg_rdata_next[3] = events_irq_raised_qs;
+        reg_rdata_next[4] = events_dma_done_qs;
+        reg_rdata_next[5] = events_dma_window_qs;
+        reg_rdata_next[6] = events_power_qs;
+      end
+
+      addr_hit[2]: begin
+        reg_rdata_next[31:0] = irq_mask_qs;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[5:0] = '0;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[15:0] = status_count_qs;
+        reg_rdata_next[16]   = status_overwritten_qs;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[31:0] = wr_idx_qs;
+      end
+
+      addr_hit[6]: begin
+        reg_rdata_next[31:0] = dropped_qs;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[31:0] = cycles_qs;
+      end
+
+      addr_hit[8]: begin
+        reg_rdata_next[31:0] = depth_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module event_trace_reg_top_intf #(
+    parameter  int AW = 13,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    REG_BUS.out regbus_win_mst[1-1:0],
+    // To HW
+    output event_trace_reg_pkg::event_trace_reg2hw_t reg2hw,  // Write
+    input event_trace_reg_pkg::event_trace_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+  reg_bus_req_t s_reg_win_req[1-1:0];
+  reg_bus_rsp_t s_reg_win_rsp[1-1:0];
+  for (genvar i = 0; i < 1; i++) begin : gen_assign_window_structs
+    `REG_BUS_ASSIGN_TO_REQ(s_reg_win_req[i], regbus_win_mst[i])
+    `REG_BUS_ASSIGN_FROM_RSP(regbus_win_mst[i], s_reg_win_rsp[i])
+  end
+
+
+
+  event_trace_reg_top #(
+      .reg_req_t(reg_bus_req_t),
+      .reg_rsp_t(reg_bus_rsp_t),
+      .AW(AW)
+  ) i_regs (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(s_reg_req),
+      .reg_rsp_o(s_reg_rsp),
+      .reg_req_win_o(s_reg_win_req),
+      .reg_rsp_win_i(s_reg_win_rsp),
+      .reg2hw,  // Write
+      .hw2reg,  // Read
+      .devmode_i
+  );
+
+endmodule
+
+
@@ -16,16 +16,24 @@ module fast_intr_ctrl #(
     output reg_rsp_t reg_rsp_o,
 
     input  logic [14:0] fast_intr_i,
-    output logic [14:0] fast_intr_o
+    output logic [14:0] fast_intr_o,
+
+    // Interrupt acknowledge of the core, to auto-clear the fast interrupts
+    input logic       irq_ack_i,
+    input logic [4:0] irq_id_i
 );
 
   import fast_intr_ctrl_reg_pkg::*;
 
+  // Fast interrupt i is the interrupt 16 + i of the core
+  localparam logic [4:0] FastIrqBase = 5'd16;
+
   fast_intr_ctrl_reg2hw_t reg2hw;
   fast_intr_ctrl_hw2reg_t hw2reg;
 
-  logic [14:0] fast_intr_pending_de;
   logic [14:0] fast_intr_clear_de;
+  logic [14:0] fast_intr_q;
+  logic [14:0] fast_intr_ack;
 
   fast_intr_ctrl_reg_top #(
       .reg_req_t(reg_req_t),
@@ -40,33 +48,45 @@ module fast_intr_ctrl #(
       .devmode_i(1'b1)
   );
 
+  // The sources of the auto-clear interrupts are sampled, so that they pend
+  // on their rising edge: a level source still high once acknowledged does
+  // not pend again until it falls and rises.
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      fast_intr_q <= '0;
+    end else begin
+      fast_intr_q <= fast_intr_i;
+    end
+  end
+
   for (genvar i = 0; i < 15; i++) begin : gen_fast_interrupt
 
+    assign fast_intr_ack[i] = irq_ack_i && (irq_id_i == FastIrqBase + i);
+
     always_comb begin
+      // The bits not updated keep their value, as all of them share the
+      // data enable of the pending register
+      hw2reg.fast_intr_pending.d[i] = reg2hw.fast_intr_pending.q[i];
+      fast_intr_clear_de[i] = 1'b0;
+      hw2reg.fast_intr_clear.d[i] = 1'b0;
       if (reg2hw.fast_intr_clear.q[i]) begin
-        fast_intr_pending_de[i] = 1'b1;
         hw2reg.fast_intr_pending.d[i] = 1'b0;
         fast_intr_clear_de[i] = 1'b1;
-        hw2reg.fast_intr_clear.d[i] = 1'b0;
-      end else begin
-        if (fast_intr_i[i]) begin
-          fast_intr_pending_de[i] = 1'b1;
+      end else if (reg2hw.fast_intr_auto_clear.q[i]) begin
+        if (fast_intr_i[i] && !fast_intr_q[i]) begin
           hw2reg.fast_intr_pending.d[i] = reg2hw.fast_intr_enable.q[i];
-          fast_intr_clear_de[i] = 1'b0;
-          hw2reg.fast_intr_clear.d[i] = 1'b0;
-        end else begin
-          fast_intr_pending_de[i] = 1'b0;
+        end else if (fast_intr_ack[i]) begin
           hw2reg.fast_intr_pending.d[i] = 1'b0;
-          fast_intr_clear_de[i] = 1'b0;
-          hw2reg.fast_intr_clear.d[i] = 1'b0;
         end
+      end else if (fast_intr_i[i]) begin
+        hw2reg.fast_intr_pending.d[i] = reg2hw.fast_intr_enable.q[i];
       end
     end
 
   end
 
   assign fast_intr_o = reg2hw.fast_intr_pending.q;
-  assign hw2reg.fast_intr_pending.de = |fast_intr_pending_de;
+  assign hw2reg.fast_intr_pending.de = 1'b1;
   assign hw2reg.fast_intr_clear.de = |fast_intr_clear_de;
 
 endmodule : fast_intr_ctrl
@@ -19,6 +19,8 @@ package fast_intr_ctrl_reg_pkg;
 
   typedef struct packed {logic [14:0] q;} fast_intr_ctrl_reg2hw_fast_intr_enable_reg_t;
 
+  typedef struct packed {logic [14:0] q;} fast_intr_ctrl_reg2hw_fast_intr_auto_clear_reg_t;
+
   typedef struct packed {
     logic [14:0] d;
     logic        de;
@@ -31,9 +33,10 @@ package fast_intr_ctrl_reg_pkg;
 
   // Register -> HW type
   typedef struct packed {
-    fast_intr_ctrl_reg2hw_fast_intr_pending_reg_t fast_intr_pending;  // [44:30]
-    fast_intr_ctrl_reg2hw_fast_intr_clear_reg_t   fast_intr_clear;    // [29:15]
-    fast_intr_ctrl_reg2hw_fast_intr_enable_reg_t  fast_intr_enable;   // [14:0]
+    fast_intr_ctrl_reg2hw_fast_intr_pending_reg_t    fast_intr_pending;     // [59:45]
+    fast_intr_ctrl_reg2hw_fast_intr_clear_reg_t      fast_intr_clear;       // [44:30]
+    fast_intr_ctrl_reg2hw_fast_intr_enable_reg_t     fast_intr_enable;      // [29:15]
+    fast_intr_ctrl_reg2hw_fast_intr_auto_clear_reg_t fast_intr_auto_clear;  // [14:0]
   } fast_intr_ctrl_reg2hw_t;
 
   // HW -> register type
@@ -46,19 +49,22 @@ package fast_intr_ctrl_reg_pkg;
   parameter logic [BlockAw-1:0] FAST_INTR_CTRL_FAST_INTR_PENDING_OFFSET = 4'h0;
   parameter logic [BlockAw-1:0] FAST_INTR_CTRL_FAST_INTR_CLEAR_OFFSET = 4'h4;
   parameter logic [BlockAw-1:0] FAST_INTR_CTRL_FAST_INTR_ENABLE_OFFSET = 4'h8;
+  parameter logic [BlockAw-1:0] FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_OFFSET = 4'hc;
 
   // Register index
   typedef enum int {
     FAST_INTR_CTRL_FAST_INTR_PENDING,
     FAST_INTR_CTRL_FAST_INTR_CLEAR,
-    FAST_INTR_CTRL_FAST_INTR_ENABLE
+    FAST_INTR_CTRL_FAST_INTR_ENABLE,
+    FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR
   } fast_intr_ctrl_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] FAST_INTR_CTRL_PERMIT[3] = '{
+  parameter logic [3:0] FAST_INTR_CTRL_PERMIT[4] = '{
       4'b0011,  // index[0] FAST_INTR_CTRL_FAST_INTR_PENDING
       4'b0011,  // index[1] FAST_INTR_CTRL_FAST_INTR_CLEAR
-      4'b0011  // index[2] FAST_INTR_CTRL_FAST_INTR_ENABLE
+      4'b0011,  // index[2] FAST_INTR_CTRL_FAST_INTR_ENABLE
+      4'b0011  // index[3] FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR
   };
 
 endpackage
@@ -75,6 +75,9 @@ module fast_intr_ctrl_reg_top #(
   logic [14:0] fast_intr_enable_qs;
   logic [14:0] fast_intr_enable_wd;
   logic fast_intr_enable_we;
+  logic [14:0] fast_intr_auto_clear_qs;
+  logic [14:0] fast_intr_auto_clear_wd;
+  logic fast_intr_auto_clear_we;
 
   // Register instances
   // R[fast_intr_pending]: V(False)
@@ -157,14 +160,42 @@ module fast_intr_ctrl_reg_top #(
   );
 
 
+  // R[fast_intr_auto_clear]: V(False)
 
+  prim_subreg #(
+      .DW      (15),
+      .SWACCESS("RW"),
+      .RESVAL  (15'h0)
+  ) u_fast_intr_auto_clear (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fast_intr_auto_clear_we),
+      .wd(fast_intr_auto_clear_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
 
-  logic [2:0] addr_hit;
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fast_intr_auto_clear.q),
+
+      // to register interface (read)
+      .qs(fast_intr_auto_clear_qs)
+  );
+
+
+
+
+  logic [3:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == FAST_INTR_CTRL_FAST_INTR_PENDING_OFFSET);
     addr_hit[1] = (reg_addr == FAST_INTR_CTRL_FAST_INTR_CLEAR_OFFSET);
     addr_hit[2] = (reg_addr == FAST_INTR_CTRL_FAST_INTR_ENABLE_OFFSET);
+    addr_hit[3] = (reg_addr == FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -174,15 +205,19 @@ module fast_intr_ctrl_reg_top #(
     wr_err = (reg_we &
               ((addr_hit[0] & (|(FAST_INTR_CTRL_PERMIT[0] & ~reg_be))) |
                (addr_hit[1] & (|(FAST_INTR_CTRL_PERMIT[1] & ~reg_be))) |
-               (addr_hit[2] & (|(FAST_INTR_CTRL_PERMIT[2] & ~reg_be)))));
+               (addr_hit[2] & (|(FAST_INTR_CTRL_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(FAST_INTR_CTRL_PERMIT[3] & ~reg_be)))));
   end
 
-  assign fast_intr_clear_we  = addr_hit[1] & reg_we & !reg_error;
-  assign fast_intr_clear_wd  = reg_wdata[14:0];
+  assign fast_intr_clear_we = addr_hit[1] & reg_we & !reg_error;
+  assign fast_intr_clear_wd = reg_wdata[14:0];
 
   assign fast_intr_enable_we = addr_hit[2] & reg_we & !reg_error;
   assign fast_intr_enable_wd = reg_wdata[14:0];
 
+  assign fast_intr_auto_clear_we = addr_hit[3] & reg_we & !reg_error;
+  assign fast_intr_auto_clear_wd = reg_wdata[14:0];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -199,6 +234,10 @@ module fast_intr_ctrl_reg_top #(
         reg_rdata_next[14:0] = fast_intr_enable_qs;
       end
 
+      addr_hit[3]: begin
+        reg_rdata_next[14:0] = fast_intr_auto_clear_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -28,12 +28,15 @@ module i2s #(
     output logic i2s_sd_o,
     output logic i2s_sd_oe_o,
     input  logic i2s_sd_i,
+    // Dedicated TX data line, for full duplex
+    output logic i2s_sdo_o,
 
     // Interrupt
     output logic intr_i2s_event_o,
 
-    // DMA signal
-    output logic i2s_rx_valid_o
+    // DMA signals
+    output logic i2s_rx_valid_o,
+    output logic i2s_tx_ready_o
 );
 
   import i2s_reg_pkg::*;
@@ -50,26 +53,38 @@ module i2s #(
   logic data_rx_ready;
   logic data_rx_overflow;
 
+  logic data_tx_ready;
+  logic data_tx_underflow;
+  logic sd_tx;
+
   logic event_i2s_event;
 
   logic [$clog2(MaxWordWidth)-1:0] word_width;
   assign word_width = {reg2hw.control.data_width.q, 3'h7};
 
+  logic [$clog2(MaxWordWidth)-1:0] tdm_slot_width;
+  assign tdm_slot_width = {reg2hw.tdm.slot_width.q, 3'h7};
+
 
   // I2s RX -> Bus
   assign data_rx_ready = reg2hw.rxdata.re;  // bus read signal
   assign hw2reg.rxdata.d = data_rx;
 
-  // DMA signal
+  // DMA signals
   assign i2s_rx_valid_o = data_rx_valid;
+  assign i2s_tx_ready_o = data_tx_ready;
 
   // STATUS signal
   assign hw2reg.status.rx_data_ready.d = data_rx_valid;
   assign hw2reg.status.rx_overflow.d = data_rx_overflow;
+  assign hw2reg.status.tx_ready.d = data_tx_ready;
+  assign hw2reg.status.tx_underflow.d = data_tx_underflow;
 
   // IO
-  assign i2s_sd_oe_o = 1'b0;
-  assign i2s_sd_o = 1'b0;
+  // SD is an output when only TX is enabled (half duplex), SDO always is
+  assign i2s_sd_oe_o = reg2hw.control.en_io.q & (|reg2hw.control.en_tx.q) & ~(|reg2hw.control.en_rx.q) & ~reg2hw.tdm.en.q;
+  assign i2s_sd_o = sd_tx;
+  assign i2s_sdo_o = sd_tx;
   assign i2s_sck_oe_o = reg2hw.control.en_io.q;
   assign i2s_ws_oe_o = reg2hw.control.en_io.q;
   unread _sck_i (i2s_sck_i);
@@ -80,6 +95,8 @@ module i2s #(
   assign hw2reg.control.reset_watermark.d = 1'b0;
   assign hw2reg.control.reset_rx_overflow.de = ~data_rx_overflow;
   assign hw2reg.control.reset_rx_overflow.d = 1'b0;
+  assign hw2reg.control.reset_tx_underflow.de = ~data_tx_underflow;
+  assign hw2reg.control.reset_tx_underflow.d = 1'b0;
 
 
 
@@ -110,23 +127,37 @@ module i2s #(
       .en_ws_i(reg2hw.control.en_ws.q),
       .en_rx_left_i(reg2hw.control.en_rx.q[0]),
       .en_rx_right_i(reg2hw.control.en_rx.q[1]),
+      .en_tx_left_i(reg2hw.control.en_tx.q[0]),
+      .en_tx_right_i(reg2hw.control.en_tx.q[1]),
 
       .sck_o(i2s_sck_o),
       .ws_o (i2s_ws_o),
       .sd_i (i2s_sd_i),
+      .sd_o (sd_tx),
 
       .cfg_clock_div_i(reg2hw.clkdividx.q),
       .cfg_word_width_i(word_width),
       .cfg_rx_start_channel_i(reg2hw.control.rx_start_channel.q),
+      .cfg_tdm_i(reg2hw.tdm.en.q),
+      .cfg_tdm_slots_i(reg2hw.tdm.slots.q),
+      .cfg_tdm_slot_width_i(tdm_slot_width),
+      .cfg_tdm_slot_en_i(reg2hw.tdm.slot_en.q),
+      .cfg_tdm_tag_i(reg2hw.tdm.tag.q),
 
       .data_rx_o(data_rx),
       .data_rx_valid_o(data_rx_valid),
       .data_rx_ready_i(data_rx_ready),
 
+      .data_tx_i(reg2hw.txdata.q),
+      .data_tx_valid_i(reg2hw.txdata.qe),
+      .data_tx_ready_o(data_tx_ready),
+
       .clear_rx_overflow_i(reg2hw.control.reset_rx_overflow.q),
+      .clear_tx_underflow_i(reg2hw.control.reset_tx_underflow.q),
 
       .running_o(hw2reg.status.running.d),
-      .data_rx_overflow_o(data_rx_overflow)
+      .data_rx_overflow_o(data_rx_overflow),
+      .data_tx_underflow_o(data_tx_underflow)
   );
 
 
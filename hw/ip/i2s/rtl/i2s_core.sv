@@ -16,26 +16,40 @@ module i2s_core #(
     input logic en_ws_i,
     input logic en_rx_left_i,
     input logic en_rx_right_i,
+    input logic en_tx_left_i,
+    input logic en_tx_right_i,
 
     // IO interface
     output logic sck_o,
     output logic ws_o,
     input  logic sd_i,
+    output logic sd_o,
 
     // config
     input logic [     ClkDividerWidth-1:0] cfg_clock_div_i,
     input logic [$clog2(MaxWordWidth)-1:0] cfg_word_width_i,
     input logic                            cfg_rx_start_channel_i,
+    input logic                            cfg_tdm_i,
+    input logic [                     3:0] cfg_tdm_slots_i,
+    input logic [$clog2(MaxWordWidth)-1:0] cfg_tdm_slot_width_i,
+    input logic [                    15:0] cfg_tdm_slot_en_i,
+    input logic                            cfg_tdm_tag_i,
 
     // FIFO
     output logic [MaxWordWidth-1:0] data_rx_o,
     output logic                    data_rx_valid_o,
     input  logic                    data_rx_ready_i,
 
+    input  logic [MaxWordWidth-1:0] data_tx_i,
+    input  logic                    data_tx_valid_i,
+    output logic                    data_tx_ready_o,
+
     input logic clear_rx_overflow_i,
+    input logic clear_tx_underflow_i,
 
     output logic running_o,
-    output logic data_rx_overflow_o
+    output logic data_rx_overflow_o,
+    output logic data_tx_underflow_o
 );
 
   logic                    ws;
@@ -47,6 +61,20 @@ module i2s_core #(
 
   logic                    data_rx_overflow_async;
 
+  logic [MaxWordWidth-1:0] data_rx_i2s;
+  logic                    data_rx_i2s_valid;
+  logic                    data_rx_i2s_overflow;
+
+  logic [MaxWordWidth-1:0] data_rx_tdm;
+  logic                    data_rx_tdm_valid;
+  logic                    data_rx_tdm_overflow;
+
+  logic [MaxWordWidth-1:0] data_tx_dc;
+  logic                    data_tx_dc_valid;
+  logic                    data_tx_dc_ready;
+
+  logic                    data_tx_underflow_async;
+
   assign ws_o  = ws;
   assign sck_o = sck;
 
@@ -72,7 +100,10 @@ module i2s_core #(
       .rst_ni(rst_ni),
       .en_i(en_ws_i),
       .ws_o(ws),
-      .word_width_i(cfg_word_width_i)
+      .word_width_i(cfg_word_width_i),
+      .tdm_i(cfg_tdm_i),
+      .tdm_slots_i(cfg_tdm_slots_i),
+      .tdm_slot_width_i(cfg_tdm_slot_width_i)
   );
 
   i2s_rx_channel #(
@@ -80,21 +111,47 @@ module i2s_core #(
   ) i2s_rx_channel_i (
       .sck_i(sck),
       .rst_ni(rst_ni),
-      .en_left_i(en_rx_left_i),
-      .en_right_i(en_rx_right_i),
+      .en_left_i(en_rx_left_i & ~cfg_tdm_i),
+      .en_right_i(en_rx_right_i & ~cfg_tdm_i),
       .ws_i(ws),
       .sd_i(sd_i),
 
       .word_width_i(cfg_word_width_i),
       .start_channel_i(cfg_rx_start_channel_i),
 
-      .data_o(data_rx_dc),
-      .data_valid_o(data_rx_dc_valid),
+      .data_o(data_rx_i2s),
+      .data_valid_o(data_rx_i2s_valid),
       .data_ready_i(data_rx_dc_ready),
-      .overflow_o(data_rx_overflow_async),
+      .overflow_o(data_rx_i2s_overflow),
       .clear_overflow_i(clear_rx_overflow_i)
   );
 
+  i2s_tdm_rx_channel #(
+      .MaxWordWidth(MaxWordWidth)
+  ) i2s_tdm_rx_channel_i (
+      .sck_i(sck),
+      .rst_ni(rst_ni),
+      .en_i((en_rx_left_i | en_rx_right_i) & cfg_tdm_i),
+      .ws_i(ws),
+      .sd_i(sd_i),
+
+      .word_width_i(cfg_word_width_i),
+      .slot_width_i(cfg_tdm_slot_width_i),
+      .slots_i(cfg_tdm_slots_i),
+      .slot_en_i(cfg_tdm_slot_en_i),
+      .tag_i(cfg_tdm_tag_i),
+
+      .data_o(data_rx_tdm),
+      .data_valid_o(data_rx_tdm_valid),
+      .data_ready_i(data_rx_dc_ready),
+      .overflow_o(data_rx_tdm_overflow),
+      .clear_overflow_i(clear_rx_overflow_i)
+  );
+
+  assign data_rx_dc = cfg_tdm_i ? data_rx_tdm : data_rx_i2s;
+  assign data_rx_dc_valid = cfg_tdm_i ? data_rx_tdm_valid : data_rx_i2s_valid;
+  assign data_rx_overflow_async = data_rx_i2s_overflow | data_rx_tdm_overflow;
+
   // cdc
   cdc_fifo_gray #(
       .T(logic [31:0]),
@@ -113,6 +170,43 @@ module i2s_core #(
       .dst_ready_i(data_rx_ready_i)
   );
 
+  i2s_tx_channel #(
+      .MaxWordWidth(MaxWordWidth)
+  ) i2s_tx_channel_i (
+      .sck_i(sck),
+      .rst_ni(rst_ni),
+      .en_left_i(en_tx_left_i & ~cfg_tdm_i),
+      .en_right_i(en_tx_right_i & ~cfg_tdm_i),
+      .ws_i(ws),
+      .sd_o(sd_o),
+
+      .word_width_i(cfg_word_width_i),
+
+      .data_i(data_tx_dc),
+      .data_valid_i(data_tx_dc_valid),
+      .data_ready_o(data_tx_dc_ready),
+      .underflow_o(data_tx_underflow_async),
+      .clear_underflow_i(clear_tx_underflow_i)
+  );
+
+  // cdc, filled before the tx channels are enabled
+  cdc_fifo_gray #(
+      .T(logic [31:0]),
+      .LOG_DEPTH(3)
+  ) tx_cdc_i (
+      .src_clk_i  (clk_i),
+      .src_rst_ni (rst_ni),
+      .src_ready_o(data_tx_ready_o),
+      .src_data_i (data_tx_i),
+      .src_valid_i(data_tx_valid_i),
+
+      .dst_rst_ni (rst_ni),
+      .dst_clk_i  (sck),
+      .dst_data_o (data_tx_dc),
+      .dst_valid_o(data_tx_dc_valid),
+      .dst_ready_i(data_tx_dc_ready)
+  );
+
   // SYNC rx overflow signal
   sync #(
       .STAGES(2),
@@ -124,6 +218,17 @@ module i2s_core #(
       .serial_o(data_rx_overflow_o)
   );
 
+  // SYNC tx underflow signal
+  sync #(
+      .STAGES(2),
+      .ResetValue(1'b0)
+  ) data_tx_underflow_sync_i (
+      .clk_i,
+      .rst_ni,
+      .serial_i(data_tx_underflow_async),
+      .serial_o(data_tx_underflow_o)
+  );
+
 
   logic en_q;
   always_ff @(posedge clk_i, negedge rst_ni) begin
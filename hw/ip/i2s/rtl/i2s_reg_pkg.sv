@@ -29,6 +29,8 @@ package i2s_reg_pkg;
     struct packed {logic [1:0] q;} data_width;
     struct packed {logic q;} rx_start_channel;
     struct packed {logic q;} reset_rx_overflow;
+    struct packed {logic [1:0] q;} en_tx;
+    struct packed {logic q;} reset_tx_underflow;
   } i2s_reg2hw_control_reg_t;
 
   typedef struct packed {logic [15:0] q;} i2s_reg2hw_clkdividx_reg_t;
@@ -40,6 +42,19 @@ package i2s_reg_pkg;
 
   typedef struct packed {logic [15:0] q;} i2s_reg2hw_watermark_reg_t;
 
+  typedef struct packed {
+    logic [31:0] q;
+    logic        qe;
+  } i2s_reg2hw_txdata_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} en;
+    struct packed {logic [3:0] q;} slots;
+    struct packed {logic [1:0] q;} slot_width;
+    struct packed {logic q;} tag;
+    struct packed {logic [15:0] q;} slot_en;
+  } i2s_reg2hw_tdm_reg_t;
+
   typedef struct packed {
     struct packed {
       logic d;
@@ -49,12 +64,18 @@ package i2s_reg_pkg;
       logic d;
       logic de;
     } reset_rx_overflow;
+    struct packed {
+      logic d;
+      logic de;
+    } reset_tx_underflow;
   } i2s_hw2reg_control_reg_t;
 
   typedef struct packed {
     struct packed {logic d;} running;
     struct packed {logic d;} rx_data_ready;
     struct packed {logic d;} rx_overflow;
+    struct packed {logic d;} tx_ready;
+    struct packed {logic d;} tx_underflow;
   } i2s_hw2reg_status_reg_t;
 
   typedef struct packed {logic [31:0] d;} i2s_hw2reg_rxdata_reg_t;
@@ -63,16 +84,18 @@ package i2s_reg_pkg;
 
   // Register -> HW type
   typedef struct packed {
-    i2s_reg2hw_control_reg_t control;  // [76:65]
-    i2s_reg2hw_clkdividx_reg_t clkdividx;  // [64:49]
-    i2s_reg2hw_rxdata_reg_t rxdata;  // [48:16]
-    i2s_reg2hw_watermark_reg_t watermark;  // [15:0]
+    i2s_reg2hw_control_reg_t control;  // [136:122]
+    i2s_reg2hw_clkdividx_reg_t clkdividx;  // [121:106]
+    i2s_reg2hw_rxdata_reg_t rxdata;  // [105:73]
+    i2s_reg2hw_watermark_reg_t watermark;  // [72:57]
+    i2s_reg2hw_txdata_reg_t txdata;  // [56:24]
+    i2s_reg2hw_tdm_reg_t tdm;  // [23:0]
   } i2s_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    i2s_hw2reg_control_reg_t control;  // [54:51]
-    i2s_hw2reg_status_reg_t status;  // [50:48]
+    i2s_hw2reg_control_reg_t control;  // [58:53]
+    i2s_hw2reg_status_reg_t status;  // [52:48]
     i2s_hw2reg_rxdata_reg_t rxdata;  // [47:16]
     i2s_hw2reg_waterlevel_reg_t waterlevel;  // [15:0]
   } i2s_hw2reg_t;
@@ -84,11 +107,14 @@ package i2s_reg_pkg;
   parameter logic [BlockAw-1:0] I2S_RXDATA_OFFSET = 5'hc;
   parameter logic [BlockAw-1:0] I2S_WATERMARK_OFFSET = 5'h10;
   parameter logic [BlockAw-1:0] I2S_WATERLEVEL_OFFSET = 5'h14;
+  parameter logic [BlockAw-1:0] I2S_TXDATA_OFFSET = 5'h18;
+  parameter logic [BlockAw-1:0] I2S_TDM_OFFSET = 5'h1c;
 
   // Reset values for hwext registers and their fields
-  parameter logic [2:0] I2S_STATUS_RESVAL = 3'h0;
+  parameter logic [4:0] I2S_STATUS_RESVAL = 5'h0;
   parameter logic [31:0] I2S_RXDATA_RESVAL = 32'h0;
   parameter logic [15:0] I2S_WATERLEVEL_RESVAL = 16'h0;
+  parameter logic [31:0] I2S_TXDATA_RESVAL = 32'h0;
 
   // Register index
   typedef enum int {
@@ -97,17 +123,21 @@ package i2s_reg_pkg;
     I2S_CLKDIVIDX,
     I2S_RXDATA,
     I2S_WATERMARK,
-    I2S_WATERLEVEL
+    I2S_WATERLEVEL,
+    I2S_TXDATA,
+    I2S_TDM
   } i2s_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] I2S_PERMIT[6] = '{
+  parameter logic [3:0] I2S_PERMIT[8] = '{
       4'b0011,  // index[0] I2S_CONTROL
       4'b0001,  // index[1] I2S_STATUS
       4'b0011,  // index[2] I2S_CLKDIVIDX
       4'b1111,  // index[3] I2S_RXDATA
       4'b0011,  // index[4] I2S_WATERMARK
-      4'b0011  // index[5] I2S_WATERLEVEL
+      4'b0011,  // index[5] I2S_WATERLEVEL
+      4'b1111,  // index[6] I2S_TXDATA
+      4'b1111  // index[7] I2S_TDM
   };
 
 endpackage
@@ -98,12 +98,22 @@ module i2s_reg_top #(
   logic control_reset_rx_overflow_qs;
   logic control_reset_rx_overflow_wd;
   logic control_reset_rx_overflow_we;
+  logic [1:0] control_en_tx_qs;
+  logic [1:0] control_en_tx_wd;
+  logic control_en_tx_we;
+  logic control_reset_tx_underflow_qs;
+  logic control_reset_tx_underflow_wd;
+  logic control_reset_tx_underflow_we;
   logic status_running_qs;
   logic status_running_re;
   logic status_rx_data_ready_qs;
   logic status_rx_data_ready_re;
   logic status_rx_overflow_qs;
   logic status_rx_overflow_re;
+  logic status_tx_ready_qs;
+  logic status_tx_ready_re;
+  logic status_tx_underflow_qs;
+  logic status_tx_underflow_re;
   logic [15:0] clkdividx_qs;
   logic [15:0] clkdividx_wd;
   logic clkdividx_we;
@@ -114,6 +124,23 @@ module i2s_reg_top #(
   logic watermark_we;
   logic [15:0] waterlevel_qs;
   logic waterlevel_re;
+  logic [31:0] txdata_wd;
+  logic txdata_we;
+  logic tdm_en_qs;
+  logic tdm_en_wd;
+  logic tdm_en_we;
+  logic [3:0] tdm_slots_qs;
+  logic [3:0] tdm_slots_wd;
+  logic tdm_slots_we;
+  logic [1:0] tdm_slot_width_qs;
+  logic [1:0] tdm_slot_width_wd;
+  logic tdm_slot_width_we;
+  logic tdm_tag_qs;
+  logic tdm_tag_wd;
+  logic tdm_tag_we;
+  logic [15:0] tdm_slot_en_qs;
+  logic [15:0] tdm_slot_en_wd;
+  logic tdm_slot_en_we;
 
   // Register instances
   // R[control]: V(False)
@@ -378,6 +405,58 @@ module i2s_reg_top #(
   );
 
 
+  //   F[en_tx]: 13:12
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_control_en_tx (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(control_en_tx_we),
+      .wd(control_en_tx_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.control.en_tx.q),
+
+      // to register interface (read)
+      .qs(control_en_tx_qs)
+  );
+
+
+  //   F[reset_tx_underflow]: 14:14
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_control_reset_tx_underflow (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(control_reset_tx_underflow_we),
+      .wd(control_reset_tx_underflow_wd),
+
+      // from internal hardware
+      .de(hw2reg.control.reset_tx_underflow.de),
+      .d (hw2reg.control.reset_tx_underflow.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.control.reset_tx_underflow.q),
+
+      // to register interface (read)
+      .qs(control_reset_tx_underflow_qs)
+  );
+
+
   // R[status]: V(True)
 
   //   F[running]: 0:0
@@ -425,6 +504,36 @@ module i2s_reg_top #(
   );
 
 
+  //   F[tx_ready]: 3:3
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_tx_ready (
+      .re (status_tx_ready_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.tx_ready.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_tx_ready_qs)
+  );
+
+
+  //   F[tx_underflow]: 4:4
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_tx_underflow (
+      .re (status_tx_underflow_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.tx_underflow.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_tx_underflow_qs)
+  );
+
+
   // R[clkdividx]: V(False)
 
   prim_subreg #(
@@ -511,9 +620,157 @@ module i2s_reg_top #(
   );
 
 
+  // R[txdata]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_txdata (
+      .re (1'b0),
+      .we (txdata_we),
+      .wd (txdata_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.txdata.qe),
+      .q  (reg2hw.txdata.q),
+      .qs ()
+  );
+
+
+  // R[tdm]: V(False)
+
+  //   F[en]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_tdm_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(tdm_en_we),
+      .wd(tdm_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.tdm.en.q),
+
+      // to register interface (read)
+      .qs(tdm_en_qs)
+  );
+
+
+  //   F[slots]: 4:1
+  prim_subreg #(
+      .DW      (4),
+      .SWACCESS("RW"),
+      .RESVAL  (4'h3)
+  ) u_tdm_slots (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(tdm_slots_we),
+      .wd(tdm_slots_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.tdm.slots.q),
+
+      // to register interface (read)
+      .qs(tdm_slots_qs)
+  );
+
+
+  //   F[slot_width]: 6:5
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h3)
+  ) u_tdm_slot_width (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
+      // from register interface
+      .we(tdm_slot_width_we),
+      .wd(tdm_slot_width_wd),
 
-  logic [5:0] addr_hit;
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.tdm.slot_width.q),
+
+      // to register interface (read)
+      .qs(tdm_slot_width_qs)
+  );
+
+
+  //   F[tag]: 7:7
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_tdm_tag (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(tdm_tag_we),
+      .wd(tdm_tag_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.tdm.tag.q),
+
+      // to register interface (read)
+      .qs(tdm_tag_qs)
+  );
+
+
+  //   F[slot_en]: 31:16
+  prim_subreg #(
+      .DW      (16),
+      .SWACCESS("RW"),
+      .RESVAL  (16'hffff)
+  ) u_tdm_slot_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(tdm_slot_en_we),
+      .wd(tdm_slot_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.tdm.slot_en.q),
+
+      // to register interface (read)
+      .qs(tdm_slot_en_qs)
+  );
+
+
+
+
+  logic [7:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == I2S_CONTROL_OFFSET);
@@ -522,6 +779,8 @@ module i2s_reg_top #(
     addr_hit[3] = (reg_addr == I2S_RXDATA_OFFSET);
     addr_hit[4] = (reg_addr == I2S_WATERMARK_OFFSET);
     addr_hit[5] = (reg_addr == I2S_WATERLEVEL_OFFSET);
+    addr_hit[6] = (reg_addr == I2S_TXDATA_OFFSET);
+    addr_hit[7] = (reg_addr == I2S_TDM_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -534,7 +793,9 @@ module i2s_reg_top #(
                (addr_hit[2] & (|(I2S_PERMIT[2] & ~reg_be))) |
                (addr_hit[3] & (|(I2S_PERMIT[3] & ~reg_be))) |
                (addr_hit[4] & (|(I2S_PERMIT[4] & ~reg_be))) |
-               (addr_hit[5] & (|(I2S_PERMIT[5] & ~reg_be)))));
+               (addr_hit[5] & (|(I2S_PERMIT[5] & ~reg_be))) |
+               (addr_hit[6] & (|(I2S_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(I2S_PERMIT[7] & ~reg_be)))));
   end
 
   assign control_en_we = addr_hit[0] & reg_we & !reg_error;
@@ -567,12 +828,22 @@ module i2s_reg_top #(
   assign control_reset_rx_overflow_we = addr_hit[0] & reg_we & !reg_error;
   assign control_reset_rx_overflow_wd = reg_wdata[11];
 
+  assign control_en_tx_we = addr_hit[0] & reg_we & !reg_error;
+  assign control_en_tx_wd = reg_wdata[13:12];
+
+  assign control_reset_tx_underflow_we = addr_hit[0] & reg_we & !reg_error;
+  assign control_reset_tx_underflow_wd = reg_wdata[14];
+
   assign status_running_re = addr_hit[1] & reg_re & !reg_error;
 
   assign status_rx_data_ready_re = addr_hit[1] & reg_re & !reg_error;
 
   assign status_rx_overflow_re = addr_hit[1] & reg_re & !reg_error;
 
+  assign status_tx_ready_re = addr_hit[1] & reg_re & !reg_error;
+
+  assign status_tx_underflow_re = addr_hit[1] & reg_re & !reg_error;
+
   assign clkdividx_we = addr_hit[2] & reg_we & !reg_error;
   assign clkdividx_wd = reg_wdata[15:0];
 
@@ -583,27 +854,49 @@ module i2s_reg_top #(
 
   assign waterlevel_re = addr_hit[5] & reg_re & !reg_error;
 
+  assign txdata_we = addr_hit[6] & reg_we & !reg_error;
+  assign txdata_wd = reg_wdata[31:0];
+
+  assign tdm_en_we = addr_hit[7] & reg_we & !reg_error;
+  assign tdm_en_wd = reg_wdata[0];
+
+  assign tdm_slots_we = addr_hit[7] & reg_we & !reg_error;
+  assign tdm_slots_wd = reg_wdata[4:1];
+
+  assign tdm_slot_width_we = addr_hit[7] & reg_we & !reg_error;
+  assign tdm_slot_width_wd = reg_wdata[6:5];
+
+  assign tdm_tag_we = addr_hit[7] & reg_we & !reg_error;
+  assign tdm_tag_wd = reg_wdata[7];
+
+  assign tdm_slot_en_we = addr_hit[7] & reg_we & !reg_error;
+  assign tdm_slot_en_wd = reg_wdata[31:16];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
     unique case (1'b1)
       addr_hit[0]: begin
-        reg_rdata_next[0]   = control_en_qs;
-        reg_rdata_next[1]   = control_en_ws_qs;
-        reg_rdata_next[3:2] = control_en_rx_qs;
-        reg_rdata_next[4]   = control_intr_en_qs;
-        reg_rdata_next[5]   = control_en_watermark_qs;
-        reg_rdata_next[6]   = control_reset_watermark_qs;
-        reg_rdata_next[7]   = control_en_io_qs;
-        reg_rdata_next[9:8] = control_data_width_qs;
-        reg_rdata_next[10]  = control_rx_start_channel_qs;
-        reg_rdata_next[11]  = control_reset_rx_overflow_qs;
+        reg_rdata_next[0]     = control_en_qs;
+        reg_rdata_next[1]     = control_en_ws_qs;
+        reg_rdata_next[3:2]   = control_en_rx_qs;
+        reg_rdata_next[4]     = control_intr_en_qs;
+        reg_rdata_next[5]     = control_en_watermark_qs;
+        reg_rdata_next[6]     = control_reset_watermark_qs;
+        reg_rdata_next[7]     = control_en_io_qs;
+        reg_rdata_next[9:8]   = control_data_width_qs;
+        reg_rdata_next[10]    = control_rx_start_channel_qs;
+        reg_rdata_next[11]    = control_reset_rx_overflow_qs;
+        reg_rdata_next[13:12] = control_en_tx_qs;
+        reg_rdata_next[14]    = control_reset_tx_underflow_qs;
       end
 
       addr_hit[1]: begin
         reg_rdata_next[0] = status_running_qs;
         reg_rdata_next[1] = status_rx_data_ready_qs;
         reg_rdata_next[2] = status_rx_overflow_qs;
+        reg_rdata_next[3] = status_tx_ready_qs;
+        reg_rdata_next[4] = status_tx_underflow_qs;
       end
 
       addr_hit[2]: begin
@@ -622,6 +915,18 @@ module i2s_reg_top #(
         reg_rdata_next[15:0] = waterlevel_qs;
       end
 
+      addr_hit[6]: begin
+        reg_rdata_next[31:0] = '0;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[0]     = tdm_en_qs;
+        reg_rdata_next[4:1]   = tdm_slots_qs;
+        reg_rdata_next[6:5]   = tdm_slot_width_qs;
+        reg_rdata_next[7]     = tdm_tag_qs;
+        reg_rdata_next[31:16] = tdm_slot_en_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
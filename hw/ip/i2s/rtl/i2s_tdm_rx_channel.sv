@@ -0,0 +1,155 @@
+// Copyright 2022 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Description: I2s TDM rx_channel processing the SDIN signal of a
+//              microphone array. A frame of up to 16 slots starts one SCK
+//              after the WS pulse, as a word after a WS edge in I2S mode.
+//              The samples of the enabled slots are forwarded in slot order.
+
+module i2s_tdm_rx_channel #(
+    parameter  int unsigned MaxWordWidth = 32,
+    localparam int unsigned CounterWidth = $clog2(MaxWordWidth)
+) (
+    input logic sck_i,
+    input logic rst_ni,
+    input logic en_i,
+    input logic ws_i,
+    input logic sd_i,
+
+    // config, must not be changed while en_i = 1
+    input logic [CounterWidth-1:0] word_width_i,
+    input logic [CounterWidth-1:0] slot_width_i,  // at least word_width_i
+    input logic [             3:0] slots_i,       // slots per frame minus one
+    input logic [            15:0] slot_en_i,
+    input logic                    tag_i,         // slot in the 4 MSBs of the data
+
+    // read data out (stream interface)
+    output logic [MaxWordWidth-1:0] data_o,
+    output logic                    data_valid_o,
+    input  logic                    data_ready_i,
+
+    output logic overflow_o,
+    input  logic clear_overflow_i
+);
+
+  logic r_ws_old;
+  logic s_frame_start;
+
+  logic r_in_frame;
+  logic s_slot_end;
+  logic s_slot_en;
+
+  logic [MaxWordWidth-1:0] r_shiftreg;
+  logic [MaxWordWidth-1:0] s_shiftreg;
+  logic [MaxWordWidth-1:0] r_shadow;
+
+  logic [CounterWidth-1:0] r_count_bit;
+  logic [3:0] r_slot;
+
+  logic r_valid;
+
+  assign s_frame_start = ws_i & ~r_ws_old;
+  assign s_slot_end = r_in_frame & (r_count_bit == slot_width_i);
+  assign s_slot_en = slot_en_i[r_slot];
+
+  assign data_o = r_shadow;
+  assign data_valid_o = r_valid;
+
+  // read next bit from SD, the bits after the word width are ignored
+  always_comb begin
+    s_shiftreg = r_shiftreg;
+    if (r_count_bit <= word_width_i) begin
+      s_shiftreg[word_width_i-r_count_bit] = sd_i;
+    end
+  end
+
+  // latch ws
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_ws_old <= 1'b0;
+    end else begin
+      r_ws_old <= en_i & ws_i;
+    end
+  end
+
+  // count bits and slots from the start of each frame
+  // after the last slot, wait for the next frame
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_in_frame  <= 1'b0;
+      r_count_bit <= 'h0;
+      r_slot      <= 'h0;
+    end else begin
+      if (~en_i) begin
+        r_in_frame  <= 1'b0;
+        r_count_bit <= 'h0;
+        r_slot      <= 'h0;
+      end else if (s_frame_start) begin
+        r_in_frame  <= 1'b1;
+        r_count_bit <= 'h0;
+        r_slot      <= 'h0;
+      end else if (s_slot_end) begin
+        r_count_bit <= 'h0;
+        if (r_slot == slots_i) begin
+          r_in_frame <= 1'b0;
+        end else begin
+          r_slot <= r_slot + 1;
+        end
+      end else if (r_in_frame) begin
+        r_count_bit <= r_count_bit + 1;
+      end
+    end
+  end
+
+  // store and forward the samples of the enabled slots
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_shiftreg <= 'h0;
+      r_shadow   <= 'h0;
+      r_valid    <= 1'b0;
+    end else begin
+      if (r_in_frame) begin
+        if (s_slot_end) begin
+          r_shiftreg <= 'h0;
+          if (s_slot_en) begin
+            r_shadow <= tag_i ? {r_slot, s_shiftreg[MaxWordWidth-5:0]} : s_shiftreg;
+            r_valid  <= 1'b1;
+          end else if (data_ready_i) begin
+            r_valid <= 1'b0;
+          end
+        end else begin
+          r_shiftreg <= s_shiftreg;
+          if (data_ready_i) begin
+            r_valid <= 1'b0;
+          end
+        end
+      end else begin
+        r_shiftreg <= 'h0;
+        if (~en_i) begin
+          r_shadow <= 'h0;
+          r_valid  <= 1'b0;
+        end else if (data_ready_i) begin
+          r_valid <= 1'b0;
+        end
+      end
+    end
+  end
+
+
+  // detect overflow
+  // disable the module to reset
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      overflow_o <= 1'b0;
+    end else begin
+      if (clear_overflow_i) begin
+        overflow_o <= 1'b0;
+      end else if (s_slot_end & s_slot_en & r_valid & ~data_ready_i) begin
+        overflow_o <= 1'b1;
+      end
+    end
+  end
+
+
+endmodule : i2s_tdm_rx_channel
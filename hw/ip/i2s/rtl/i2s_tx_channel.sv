@@ -0,0 +1,113 @@
+// Copyright 2022 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Description: I2s tx_channel driving the SDOUT signal
+//              Mirrors i2s_rx_channel: the MSB of a word is sent one SCK
+//              after the WS edge, SD changes on the falling edge of SCK.
+
+module i2s_tx_channel #(
+    parameter  int unsigned MaxWordWidth = 32,
+    localparam int unsigned CounterWidth = $clog2(MaxWordWidth)
+) (
+    input  logic sck_i,
+    input  logic rst_ni,
+    input  logic en_left_i,
+    input  logic en_right_i,
+    input  logic ws_i,
+    output logic sd_o,
+
+    // config
+    input logic [CounterWidth-1:0] word_width_i,  // must not be changed while either channel is enabled
+
+    // write data in (stream interface), left first
+    input  logic [MaxWordWidth-1:0] data_i,
+    input  logic                    data_valid_i,
+    output logic                    data_ready_o,
+
+    output logic underflow_o,
+    input  logic clear_underflow_i
+);
+
+  logic en;
+
+  logic r_ws_old;
+  logic s_ws_edge;
+
+  logic r_started;
+  logic s_word_start;
+  logic s_channel_en;
+
+  logic [MaxWordWidth-1:0] r_shiftreg;
+
+  assign en = en_left_i | en_right_i;
+
+  assign s_ws_edge = ws_i ^ r_ws_old;
+
+  // a word starts on each WS edge, from the first left one (WS low)
+  assign s_word_start = en & s_ws_edge & (r_started | ~ws_i);
+  assign s_channel_en = ws_i ? en_right_i : en_left_i;
+
+  // pop a sample for each word of an enabled channel
+  assign data_ready_o = s_word_start & s_channel_en;
+
+  // latch ws
+  // start only after an edge to the left channel
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_ws_old  <= 1'b0;
+      r_started <= 1'b0;
+    end else begin
+      if (en) begin
+        r_ws_old <= ws_i;
+        if (s_ws_edge & ~ws_i) begin
+          r_started <= 1'b1;
+        end
+      end else begin
+        r_started <= 1'b0;
+        r_ws_old  <= 1'b0;
+      end
+    end
+  end
+
+  // load the sample at the start of a word (0 for a disabled channel or an
+  // empty FIFO), then shift it MSB first
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_shiftreg <= 'h0;
+    end else begin
+      if (s_word_start) begin
+        r_shiftreg <= (s_channel_en & data_valid_i) ? data_i : 'h0;
+      end else if (r_started) begin
+        r_shiftreg <= {r_shiftreg[MaxWordWidth-2:0], 1'b0};
+      end else begin
+        r_shiftreg <= 'h0;
+      end
+    end
+  end
+
+  // SD changes on the falling edge, so that it is stable when sampled
+  always_ff @(negedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      sd_o <= 1'b0;
+    end else begin
+      sd_o <= r_started & r_shiftreg[word_width_i];
+    end
+  end
+
+
+  // detect underflow: a sample was due and the FIFO was empty
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      underflow_o <= 1'b0;
+    end else begin
+      if (clear_underflow_i) begin
+        underflow_o <= 1'b0;
+      end else if (data_ready_o & ~data_valid_i) begin
+        underflow_o <= 1'b1;
+      end
+    end
+  end
+
+
+endmodule : i2s_tx_channel
@@ -5,6 +5,8 @@
 // Author: Tim Frey <tim.frey@epfl.ch>, EPFL, STI-SEL
 // Date: 13.02.2023
 // Description: I2s WS (word select) signal generation
+//              In TDM mode WS is a pulse of one SCK during the last bit of
+//              the last slot of each frame.
 
 // Adapted from github.com/pulp-platform/udma_i2s/blob/master/rtl/i2s_ws_gen.sv 
 // by Antonio Pullini (pullinia@iis.ee.ethz.ch)
@@ -19,12 +21,21 @@ module i2s_ws_gen #(
 
     output logic ws_o,
 
-    input logic [CounterWidth-1:0] word_width_i  // must not be changed while en_i = 1
+    input logic [CounterWidth-1:0] word_width_i,  // must not be changed while en_i = 1
+
+    // TDM config, must not be changed while en_i = 1
+    input logic                    tdm_i,
+    input logic [             3:0] tdm_slots_i,       // slots per frame minus one
+    input logic [CounterWidth-1:0] tdm_slot_width_i
 );
 
   logic [CounterWidth-1:0] r_counter;
+  logic [CounterWidth-1:0] s_width;
+  logic [3:0] r_slot;
   logic ws;
 
+  assign s_width = tdm_i ? tdm_slot_width_i : word_width_i;
+
   assign ws_o = en_i & ws;
 
   always_ff @(posedge sck_i, negedge rst_ni) begin
@@ -32,7 +43,7 @@ module i2s_ws_gen #(
       r_counter <= 'h0;
     end else begin
       if (en_i) begin
-        if (r_counter == word_width_i) r_counter <= 'h0;
+        if (r_counter == s_width) r_counter <= 'h0;
         else r_counter <= r_counter + 1;
       end else begin
         r_counter <= 0;
@@ -40,12 +51,30 @@ module i2s_ws_gen #(
     end
   end
 
+  // count the slots of a TDM frame
+  always_ff @(posedge sck_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_slot <= 'h0;
+    end else begin
+      if (en_i & tdm_i) begin
+        if (r_counter == s_width) begin
+          if (r_slot == tdm_slots_i) r_slot <= 'h0;
+          else r_slot <= r_slot + 1;
+        end
+      end else begin
+        r_slot <= 0;
+      end
+    end
+  end
+
   //Generate the internal WS signal
   always_ff @(negedge sck_i, negedge rst_ni) begin
     if (~rst_ni) begin
       ws <= 1'b0;
     end else begin
-      if (en_i) begin
+      if (en_i & tdm_i) begin
+        ws <= (r_counter == s_width) & (r_slot == tdm_slots_i);
+      end else if (en_i) begin
         if (r_counter == word_width_i) ws <= ~ws;
       end else begin
         ws <= 0;
@@ -0,0 +1,101 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Description: start-up, interrupts and semaphores of the harts of a
+//              multi-core X-HEEP. Hart 0 boots from the boot ROM as usual
+//              and starts the secondary harts by setting their HART_ENABLE
+//              bit with HART_BOOT_ADDR pointing to their entry point. Each
+//              hart has a mailbox interrupt, raised by IRQ_SET and cleared
+//              by IRQ_CLEAR, wired to its machine software interrupt. The
+//              semaphores are taken by a read that returns 1: all the
+//              accesses to the registers go through the single peripheral
+//              bus, so the test and the set are atomic without the A
+//              extension.
+
+module mailbox #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    // Harts started and interrupted by the mailbox, hart 0 included (1 to 4)
+    parameter int unsigned NumHarts = 2
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // Register interface
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // Fetch enable and boot address of the harts, bit 0 always set
+    output logic [NumHarts-1:0] fetch_enable_o,
+    output logic [        31:0] boot_addr_o,
+
+    // Mailbox interrupt of each hart
+    output logic [NumHarts-1:0] irq_o
+);
+
+  import mailbox_reg_pkg::*;
+
+  localparam int unsigned NumSem = 4;
+
+  mailbox_reg2hw_t reg2hw;
+  mailbox_hw2reg_t hw2reg;
+
+  logic [3:0] pending_d, pending_q;
+  logic [NumSem-1:0] sem_d, sem_q;
+  logic [NumSem-1:0] sem_re;
+
+  mailbox_reg_top #(
+      .reg_req_t(reg_req_t),
+      .reg_rsp_t(reg_rsp_t)
+  ) mailbox_reg_top_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i,
+      .reg_rsp_o,
+      .reg2hw,
+      .hw2reg,
+      .devmode_i(1'b1)
+  );
+
+  if (NumHarts > 1) begin : gen_fetch_enable
+    assign fetch_enable_o = {reg2hw.hart_enable.q[NumHarts-1:1], 1'b1};
+  end else begin : gen_no_fetch_enable
+    assign fetch_enable_o = 1'b1;
+  end
+  assign boot_addr_o = reg2hw.hart_boot_addr.q;
+
+  // Interrupts
+  always_comb begin
+    pending_d = pending_q;
+    if (reg2hw.irq_set.qe) pending_d = pending_d | reg2hw.irq_set.q;
+    if (reg2hw.irq_clear.qe) pending_d = pending_d & ~reg2hw.irq_clear.q;
+  end
+
+  assign irq_o = pending_q[NumHarts-1:0];
+  assign hw2reg.irq_pending.d = pending_q;
+
+  // Semaphores: a read returns 1 if the semaphore was free and takes it
+  assign sem_re = {reg2hw.sem_3.re, reg2hw.sem_2.re, reg2hw.sem_1.re, reg2hw.sem_0.re};
+
+  assign hw2reg.sem_0.d = ~sem_q[0];
+  assign hw2reg.sem_1.d = ~sem_q[1];
+  assign hw2reg.sem_2.d = ~sem_q[2];
+  assign hw2reg.sem_3.d = ~sem_q[3];
+
+  always_comb begin
+    sem_d = sem_q | sem_re;
+    if (reg2hw.sem_release.qe) sem_d = sem_d & ~reg2hw.sem_release.q;
+  end
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (!rst_ni) begin
+      pending_q <= '0;
+      sem_q     <= '0;
+    end else begin
+      pending_q <= pending_d;
+      sem_q     <= sem_d;
+    end
+  end
+
+endmodule : mailbox
@@ -0,0 +1,138 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Package auto-generated by `reggen` containing data structure
+
+package mailbox_reg_pkg;
+
+  // Address widths within the block
+  parameter int BlockAw = 6;
+
+  ////////////////////////////
+  // Typedefs for registers //
+  ////////////////////////////
+
+  typedef struct packed {logic [3:0] q;} mailbox_reg2hw_hart_enable_reg_t;
+
+  typedef struct packed {logic [31:0] q;} mailbox_reg2hw_hart_boot_addr_reg_t;
+
+  typedef struct packed {
+    logic [3:0] q;
+    logic       qe;
+  } mailbox_reg2hw_irq_set_reg_t;
+
+  typedef struct packed {
+    logic [3:0] q;
+    logic       qe;
+  } mailbox_reg2hw_irq_clear_reg_t;
+
+  typedef struct packed {
+    logic [3:0] q;
+    logic       qe;
+  } mailbox_reg2hw_sem_release_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic re;
+  } mailbox_reg2hw_sem_0_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic re;
+  } mailbox_reg2hw_sem_1_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic re;
+  } mailbox_reg2hw_sem_2_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic re;
+  } mailbox_reg2hw_sem_3_reg_t;
+
+  typedef struct packed {logic [3:0] d;} mailbox_hw2reg_irq_pending_reg_t;
+
+  typedef struct packed {logic d;} mailbox_hw2reg_sem_0_reg_t;
+
+  typedef struct packed {logic d;} mailbox_hw2reg_sem_1_reg_t;
+
+  typedef struct packed {logic d;} mailbox_hw2reg_sem_2_reg_t;
+
+  typedef struct packed {logic d;} mailbox_hw2reg_sem_3_reg_t;
+
+  // Register -> HW type
+  typedef struct packed {
+    mailbox_reg2hw_hart_enable_reg_t hart_enable;  // [58:55]
+    mailbox_reg2hw_hart_boot_addr_reg_t hart_boot_addr;  // [54:23]
+    mailbox_reg2hw_irq_set_reg_t irq_set;  // [22:18]
+    mailbox_reg2hw_irq_clear_reg_t irq_clear;  // [17:13]
+    mailbox_reg2hw_sem_release_reg_t sem_release;  // [12:8]
+    mailbox_reg2hw_sem_0_reg_t sem_0;  // [7:6]
+    mailbox_reg2hw_sem_1_reg_t sem_1;  // [5:4]
+    mailbox_reg2hw_sem_2_reg_t sem_2;  // [3:2]
+    mailbox_reg2hw_sem_3_reg_t sem_3;  // [1:0]
+  } mailbox_reg2hw_t;
+
+  // HW -> register type
+  typedef struct packed {
+    mailbox_hw2reg_irq_pending_reg_t irq_pending;  // [7:4]
+    mailbox_hw2reg_sem_0_reg_t sem_0;  // [3:3]
+    mailbox_hw2reg_sem_1_reg_t sem_1;  // [2:2]
+    mailbox_hw2reg_sem_2_reg_t sem_2;  // [1:1]
+    mailbox_hw2reg_sem_3_reg_t sem_3;  // [0:0]
+  } mailbox_hw2reg_t;
+
+  // Register offsets
+  parameter logic [BlockAw-1:0] MAILBOX_HART_ENABLE_OFFSET = 6'h0;
+  parameter logic [BlockAw-1:0] MAILBOX_HART_BOOT_ADDR_OFFSET = 6'h4;
+  parameter logic [BlockAw-1:0] MAILBOX_IRQ_SET_OFFSET = 6'h8;
+  parameter logic [BlockAw-1:0] MAILBOX_IRQ_CLEAR_OFFSET = 6'hc;
+  parameter logic [BlockAw-1:0] MAILBOX_IRQ_PENDING_OFFSET = 6'h10;
+  parameter logic [BlockAw-1:0] MAILBOX_SEM_RELEASE_OFFSET = 6'h14;
+  parameter logic [BlockAw-1:0] MAILBOX_SEM_0_OFFSET = 6'h18;
+  parameter logic [BlockAw-1:0] MAILBOX_SEM_1_OFFSET = 6'h1c;
+  parameter logic [BlockAw-1:0] MAILBOX_SEM_2_OFFSET = 6'h20;
+  parameter logic [BlockAw-1:0] MAILBOX_SEM_3_OFFSET = 6'h24;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [3:0] MAILBOX_IRQ_SET_RESVAL = 4'h0;
+  parameter logic [3:0] MAILBOX_IRQ_CLEAR_RESVAL = 4'h0;
+  parameter logic [3:0] MAILBOX_IRQ_PENDING_RESVAL = 4'h0;
+  parameter logic [3:0] MAILBOX_SEM_RELEASE_RESVAL = 4'h0;
+  parameter logic [0:0] MAILBOX_SEM_0_RESVAL = 1'h0;
+  parameter logic [0:0] MAILBOX_SEM_1_RESVAL = 1'h0;
+  parameter logic [0:0] MAILBOX_SEM_2_RESVAL = 1'h0;
+  parameter logic [0:0] MAILBOX_SEM_3_RESVAL = 1'h0;
+
+  // Register index
+  typedef enum int {
+    MAILBOX_HART_ENABLE,
+    MAILBOX_HART_BOOT_ADDR,
+    MAILBOX_IRQ_SET,
+    MAILBOX_IRQ_CLEAR,
+    MAILBOX_IRQ_PENDING,
+    MAILBOX_SEM_RELEASE,
+    MAILBOX_SEM_0,
+    MAILBOX_SEM_1,
+    MAILBOX_SEM_2,
+    MAILBOX_SEM_3
+  } mailbox_id_e;
+
+  // Register width information to check illegal writes
+  parameter logic [3:0] MAILBOX_PERMIT[10] = '{
+      4'b0001,  // index[0] MAILBOX_HART_ENABLE
+      4'b1111,  // index[1] MAILBOX_HART_BOOT_ADDR
+      4'b0001,  // index[2] MAILBOX_IRQ_SET
+      4'b0001,  // index[3] MAILBOX_IRQ_CLEAR
+      4'b0001,  // index[4] MAILBOX_IRQ_PENDING
+      4'b0001,  // index[5] MAILBOX_SEM_RELEASE
+      4'b0001,  // index[6] MAILBOX_SEM_0
+      4'b0001,  // index[7] MAILBOX_SEM_1
+      4'b0001,  // index[8] MAILBOX_SEM_2
+      4'b0001  // index[9] MAILBOX_SEM_3
+  };
+
+endpackage
+
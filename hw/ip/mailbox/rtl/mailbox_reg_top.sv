@@ -0,0 +1,447 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Register Top module auto-generated by `reggen`
+
+
+`include "common_cells/assertions.svh"
+
+module mailbox_reg_top #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter int AW = 6
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+    // To HW
+    output mailbox_reg_pkg::mailbox_reg2hw_t reg2hw,  // Write
+    input mailbox_reg_pkg::mailbox_hw2reg_t hw2reg,  // Read
+
+
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+
+  import mailbox_reg_pkg::*;
+
+  localparam int DW = 32;
+  localparam int DBW = DW / 8;  // Byte Width
+
+  // register signals
+  logic           reg_we;
+  logic           reg_re;
+  logic [ AW-1:0] reg_addr;
+  logic [ DW-1:0] reg_wdata;
+  logic [DBW-1:0] reg_be;
+  logic [ DW-1:0] reg_rdata;
+  logic           reg_error;
+
+  logic addrmiss, wr_err;
+
+  logic [DW-1:0] reg_rdata_next;
+
+  // Below register interface can be changed
+  reg_req_t reg_intf_req;
+  reg_rsp_t reg_intf_rsp;
+
+
+  assign reg_intf_req = reg_req_i;
+  assign reg_rsp_o = reg_intf_rsp;
+
+
+  assign reg_we = reg_intf_req.valid & reg_intf_req.write;
+  assign reg_re = reg_intf_req.valid & ~reg_intf_req.write;
+  assign reg_addr = reg_intf_req.addr;
+  assign reg_wdata = reg_intf_req.wdata;
+  assign reg_be = reg_intf_req.wstrb;
+  assign reg_intf_rsp.rdata = reg_rdata;
+  assign reg_intf_rsp.error = reg_error;
+  assign reg_intf_rsp.ready = 1'b1;
+
+  assign reg_rdata = reg_rdata_next;
+  assign reg_error = (devmode_i & addrmiss) | wr_err;
+
+
+  // Define SW related signals
+  // Format: <reg>_<field>_{wd|we|qs}
+  //        or <reg>_{wd|we|qs} if field == 1 or 0
+  logic [3:0] hart_enable_qs;
+  logic [3:0] hart_enable_wd;
+  logic hart_enable_we;
+  logic [31:0] hart_boot_addr_qs;
+  logic [31:0] hart_boot_addr_wd;
+  logic hart_boot_addr_we;
+  logic [3:0] irq_set_wd;
+  logic irq_set_we;
+  logic [3:0] irq_clear_wd;
+  logic irq_clear_we;
+  logic [3:0] irq_pending_qs;
+  logic irq_pending_re;
+  logic [3:0] sem_release_wd;
+  logic sem_release_we;
+  logic sem_0_qs;
+  logic sem_0_re;
+  logic sem_1_qs;
+  logic sem_1_re;
+  logic sem_2_qs;
+  logic sem_2_re;
+  logic sem_3_qs;
+  logic sem_3_re;
+
+  // Register instances
+  // R[hart_enable]: V(False)
+
+  prim_subreg #(
+      .DW      (4),
+      .SWACCESS("RW"),
+      .RESVAL  (4'h1)
+  ) u_hart_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(hart_enable_we),
+      .wd(hart_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.hart_enable.q),
+
+      // to register interface (read)
+      .qs(hart_enable_qs)
+  );
+
+
+  // R[hart_boot_addr]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_hart_boot_addr (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(hart_boot_addr_we),
+      .wd(hart_boot_addr_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.hart_boot_addr.q),
+
+      // to register interface (read)
+      .qs(hart_boot_addr_qs)
+  );
+
+
+  // R[irq_set]: V(True)
+
+  prim_subreg_ext #(
+      .DW(4)
+  ) u_irq_set (
+      .re (1'b0),
+      .we (irq_set_we),
+      .wd (irq_set_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.irq_set.qe),
+      .q  (reg2hw.irq_set.q),
+      .qs ()
+  );
+
+
+  // R[irq_clear]: V(True)
+
+  prim_subreg_ext #(
+      .DW(4)
+  ) u_irq_clear (
+      .re (1'b0),
+      .we (irq_clear_we),
+      .wd (irq_clear_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.irq_clear.qe),
+      .q  (reg2hw.irq_clear.q),
+      .qs ()
+  );
+
+
+  // R[irq_pending]: V(True)
+
+  prim_subreg_ext #(
+      .DW(4)
+  ) u_irq_pending (
+      .re (irq_pending_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.irq_pending.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (irq_pending_qs)
+  );
+
+
+  // R[sem_release]: V(True)
+
+  prim_subreg_ext #(
+      .DW(4)
+  ) u_sem_release (
+      .re (1'b0),
+      .we (sem_release_we),
+      .wd (sem_release_wd),
+      .d  ('0),
+      .qre(),
+      .qe (reg2hw.sem_release.qe),
+      .q  (reg2hw.sem_release.q),
+      .qs ()
+  );
+
+
+  // R[sem_0]: V(True)
+
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_sem_0 (
+      .re (sem_0_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.sem_0.d),
+      .qre(reg2hw.sem_0.re),
+      .qe (),
+      .q  (reg2hw.sem_0.q),
+      .qs (sem_0_qs)
+  );
+
+
+  // R[sem_1]: V(True)
+
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_sem_1 (
+      .re (sem_1_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.sem_1.d),
+      .qre(reg2hw.sem_1.re),
+      .qe (),
+      .q  (reg2hw.sem_1.q),
+      .qs (sem_1_qs)
+  );
+
+
+  // R[sem_2]: V(True)
+
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_sem_2 (
+      .re (sem_2_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.sem_2.d),
+      .qre(reg2hw.sem_2.re),
+      .qe (),
+      .q  (reg2hw.sem_2.q),
+      .qs (sem_2_qs)
+  );
+
+
+  // R[sem_3]: V(True)
+
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_sem_3 (
+      .re (sem_3_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.sem_3.d),
+      .qre(reg2hw.sem_3.re),
+      .qe (),
+      .q  (reg2hw.sem_3.q),
+      .qs (sem_3_qs)
+  );
+
+
+
+
+  logic [9:0] addr_hit;
+  always_comb begin
+    addr_hit = '0;
+    addr_hit[0] = (reg_addr == MAILBOX_HART_ENABLE_OFFSET);
+    addr_hit[1] = (reg_addr == MAILBOX_HART_BOOT_ADDR_OFFSET);
+    addr_hit[2] = (reg_addr == MAILBOX_IRQ_SET_OFFSET);
+    addr_hit[3] = (reg_addr == MAILBOX_IRQ_CLEAR_OFFSET);
+    addr_hit[4] = (reg_addr == MAILBOX_IRQ_PENDING_OFFSET);
+    addr_hit[5] = (reg_addr == MAILBOX_SEM_RELEASE_OFFSET);
+    addr_hit[6] = (reg_addr == MAILBOX_SEM_0_OFFSET);
+    addr_hit[7] = (reg_addr == MAILBOX_SEM_1_OFFSET);
+    addr_hit[8] = (reg_addr == MAILBOX_SEM_2_OFFSET);
+    addr_hit[9] = (reg_addr == MAILBOX_SEM_3_OFFSET);
+  end
+
+  assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
+
+  // Check sub-word write is permitted
+  always_comb begin
+    wr_err = (reg_we &
+              ((addr_hit[0] & (|(MAILBOX_PERMIT[0] & ~reg_be))) |
+               (addr_hit[1] & (|(MAILBOX_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(MAILBOX_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(MAILBOX_PERMIT[3] & ~reg_be))) |
+               (addr_hit[4] & (|(MAILBOX_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(MAILBOX_PERMIT[5] & ~reg_be))) |
+               (addr_hit[6] & (|(MAILBOX_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(MAILBOX_PERMIT[7] & ~reg_be))) |
+               (addr_hit[8] & (|(MAILBOX_PERMIT[8] & ~reg_be))) |
+               (addr_hit[9] & (|(MAILBOX_PERMIT[9] & ~reg_be)))));
+  end
+
+  assign hart_enable_we = addr_hit[0] & reg_we & !reg_error;
+  assign hart_enable_wd = reg_wdata[3:0];
+
+  assign hart_boot_addr_we = addr_hit[1] & reg_we & !reg_error;
+  assign hart_boot_addr_wd = reg_wdata[31:0];
+
+  assign irq_set_we = addr_hit[2] & reg_we & !reg_error;
+  assign irq_set_wd = reg_wdata[3:0];
+
+  assign irq_clear_we = addr_hit[3] & reg_we & !reg_error;
+  assign irq_clear_wd = reg_wdata[3:0];
+
+  assign irq_pending_re = addr_hit[4] & reg_re & !reg_error;
+
+  assign sem_release_we = addr_hit[5] & reg_we & !reg_error;
+  assign sem_release_wd = reg_wdata[3:0];
+
+  assign sem_0_re = addr_hit[6] & reg_re & !reg_error;
+
+  assign sem_1_re = addr_hit[7] & reg_re & !reg_error;
+
+  assign sem_2_re = addr_hit[8] & reg_re & !reg_error;
+
+  assign sem_3_re = addr_hit[9] & reg_re & !reg_error;
+
+  // Read data return
+  always_comb begin
+    reg_rdata_next = '0;
+    unique case (1'b1)
+      addr_hit[0]: begin
+        reg_rdata_next[3:0] = hart_enable_qs;
+      end
+
+      addr_hit[1]: begin
+        reg_rdata_next[31:0] = hart_boot_addr_qs;
+      end
+
+      addr_hit[2]: begin
+        reg_rdata_next[3:0] = '0;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[3:0] = '0;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[3:0] = irq_pending_qs;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[3:0] = '0;
+      end
+
+      addr_hit[6]: begin
+        reg_rdata_next[0] = sem_0_qs;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[0] = sem_1_qs;
+      end
+
+      addr_hit[8]: begin
+        reg_rdata_next[0] = sem_2_qs;
+      end
+
+      addr_hit[9]: begin
+        reg_rdata_next[0] = sem_3_qs;
+      end
+
+      default: begin
+        reg_rdata_next = '1;
+      end
+    endcase
+  end
+
+  // Unused signal tieoff
+
+  // wdata / byte enable are not always fully used
+  // add a blanket unused statement to handle lint waivers
+  logic unused_wdata;
+  logic unused_be;
+  assign unused_wdata = ^reg_wdata;
+  assign unused_be = ^reg_be;
+
+  // Assertions for Register Interface
+  `ASSERT(en2addrHit, (reg_we || reg_re) |-> $onehot0(addr_hit))
+
+endmodule
+
+module mailbox_reg_top_intf #(
+    parameter  int AW = 6,
+    localparam int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    REG_BUS.in regbus_slave,
+    // To HW
+    output mailbox_reg_pkg::mailbox_reg2hw_t reg2hw,  // Write
+    input mailbox_reg_pkg::mailbox_hw2reg_t hw2reg,  // Read
+    // Config
+    input devmode_i  // If 1, explicit error return for unmapped register access
+);
+  localparam int unsigned STRB_WIDTH = DW / 8;
+
+  `include "register_interface/typedef.svh"
+  `include "register_interface/assign.svh"
+
+  // Define structs for reg_bus
+  typedef logic [AW-1:0] addr_t;
+  typedef logic [DW-1:0] data_t;
+  typedef logic [STRB_WIDTH-1:0] strb_t;
+  `REG_BUS_TYPEDEF_ALL(reg_bus, addr_t, data_t, strb_t)
+
+  reg_bus_req_t s_reg_req;
+  reg_bus_rsp_t s_reg_rsp;
+
+  // Assign SV interface to structs
+  `REG_BUS_ASSIGN_TO_REQ(s_reg_req, regbus_slave)
+  `REG_BUS_ASSIGN_FROM_RSP(regbus_slave, s_reg_rsp)
+
+
+
+  mailbox_reg_top #(
+      .reg_req_t(reg_bus_req_t),
+      .reg_rsp_t(reg_bus_rsp_t),
+      .AW(AW)
+  ) i_regs (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(s_reg_req),
+      .reg_rsp_o(s_reg_rsp),
+      .reg2hw,  // Write
+      .hw2reg,  // Read
+      .devmode_i
+  );
+
+endmodule
@@ -0,0 +1,403 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Write-back data cache between the data port of the core and the system
+// bus, for the external memories, whose accesses wait for the whole latency
+// of the memory and of the external bus at each load and store. It is
+// direct-mapped (WAYS = 1) or 2-way set associative with a LRU bit per set,
+// and holds SETS * WAYS lines of LINE_WORDS words in flip-flops. SETS and
+// LINE_WORDS are powers of 2 of at least 2.
+//
+// Only the accesses to the NUM_REGIONS regions [REGION_START, REGION_END)
+// are cached. The others go straight to the bus, without any wait state, up
+// to 3 of them in flight; a cached access waits for their responses.
+//
+// A miss, load or store, allocates a line: the victim line is written back
+// if it is dirty, then the line is fetched starting from the requested word,
+// which is returned (or merged with the stored bytes) as soon as it arrives.
+// A store hit only writes the cache and marks the line dirty.
+//
+// The DMA and the other masters do not see the cache, so the software cleans
+// it (clean_i: the dirty lines are written back) before a master reads the
+// cached memory and invalidates it (invalidate_i) after a master wrote it.
+// Both walk all the lines, during which the core accesses wait; busy_o is set
+// from the request to the end. An invalidation alone drops the dirty lines.
+// When enable_i is cleared the accesses go to the bus, the software cleans
+// and invalidates the cache before. hit_o and miss_o pulse for each access
+// served by the cache and each line fetched for an access.
+
+module obi_dcache
+  import obi_pkg::*;
+#(
+    parameter int unsigned WAYS = 1,
+    parameter int unsigned SETS = 16,
+    parameter int unsigned LINE_WORDS = 4,
+    parameter int unsigned NUM_REGIONS = 1,
+    parameter logic [NUM_REGIONS-1:0][31:0] REGION_START = '0,
+    parameter logic [NUM_REGIONS-1:0][31:0] REGION_END = '0
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  core_data_req_i,
+    output obi_resp_t core_data_resp_o,
+
+    output obi_req_t  bus_data_req_o,
+    input  obi_resp_t bus_data_resp_i,
+
+    input  logic enable_i,
+    input  logic clean_i,
+    input  logic invalidate_i,
+    output logic busy_o,
+
+    output logic hit_o,
+    output logic miss_o
+);
+
+  localparam int unsigned WordW = $clog2(LINE_WORDS);
+  localparam int unsigned SetW = $clog2(SETS);
+  localparam int unsigned LineW = 30 - WordW;
+  localparam int unsigned TagW = LineW - SetW;
+  localparam int unsigned WayW = (WAYS > 1) ? $clog2(WAYS) : 1;
+  // Accesses in flight to the bus outside of the cached regions
+  localparam int unsigned PassW = 2;
+
+  typedef enum logic [1:0] {
+    IDLE,
+    WRITEBACK,
+    FILL,
+    MAINT
+  } cache_state_e;
+
+  cache_state_e state_q, state_d;
+
+  logic [TagW-1:0] tag_q[SETS][WAYS];
+  logic [31:0] data_q[SETS][WAYS][LINE_WORDS];
+  logic [SETS-1:0][WAYS-1:0] valid_q;
+  logic [SETS-1:0][WAYS-1:0] dirty_q;
+  // Way to replace next in each set
+  logic [SETS-1:0] lru_q;
+
+  // Line being fetched and its way, line being written back, next word of
+  // both and the words done
+  logic [LineW-1:0] line_q;
+  logic [WayW-1:0] way_q;
+  logic [LineW-1:0] wb_line_q;
+  logic [WordW-1:0] word_q;
+  logic [WordW-1:0] count_q;
+  logic outstanding_q;
+  logic [PassW-1:0] pass_cnt_q;
+
+  // The access waiting for its line
+  obi_req_t miss_req_q;
+  logic rvalid_q;
+  logic [31:0] rdata_q;
+
+  // Maintenance requested, running, and the line it is at
+  logic clean_pending_q, inval_pending_q;
+  logic maint_clean_q, maint_inval_q;
+  logic [SetW-1:0] maint_set_q;
+  logic [WayW-1:0] maint_way_q;
+  logic maint_last;
+  logic maint_wb;
+
+  logic [LineW-1:0] req_line;
+  logic [WordW-1:0] req_word;
+  logic [SetW-1:0] req_set;
+  logic [WayW-1:0] req_way;
+  logic req_hit;
+  logic req_cacheable;
+  logic req_pass;
+
+  logic [SetW-1:0] victim_set;
+  logic [WayW-1:0] victim;
+  logic victim_dirty;
+
+  logic [SetW-1:0] fill_set;
+  logic fill_word;
+  logic fill_last;
+  logic wb_word;
+  logic wb_last;
+
+  logic pass_issue;
+  logic pass_retire;
+
+  // Whether a line is entirely in one of the cached regions
+  function automatic logic in_regions(input logic [LineW-1:0] line);
+    logic [31:0] start_addr, end_addr;
+    start_addr = {line, WordW'(0), 2'b00};
+    end_addr   = start_addr + 4 * LINE_WORDS;
+    in_regions = 1'b0;
+    for (int unsigned r = 0; r < NUM_REGIONS; r++) begin
+      if (start_addr >= REGION_START[r] && end_addr <= REGION_END[r] && end_addr > start_addr) begin
+        in_regions = 1'b1;
+      end
+    end
+  endfunction
+
+  // Returns the way holding a line, with the hit flag as MSB
+  function automatic logic [WayW:0] find_line(input logic [LineW-1:0] line);
+    find_line = '0;
+    for (int unsigned w = 0; w < WAYS; w++) begin
+      if (valid_q[line[SetW-1:0]][w] && tag_q[line[SetW-1:0]][w] == line[SetW+:TagW]) begin
+        find_line = {1'b1, WayW'(w)};
+      end
+    end
+  endfunction
+
+  // Returns an invalid way of a set if any, the least recently used one otherwise
+  function automatic logic [WayW-1:0] victim_way(input logic [SetW-1:0] set);
+    victim_way = (WAYS > 1) ? WayW'(lru_q[set]) : '0;
+    for (int w = WAYS - 1; w >= 0; w--) begin
+      if (!valid_q[set][w]) begin
+        victim_way = WayW'(w);
+      end
+    end
+  endfunction
+
+  // Merges the bytes of a store into a word
+  function automatic logic [31:0] merge(input logic [31:0] word, input logic [31:0] wdata,
+                                        input logic [3:0] be);
+    merge = word;
+    for (int unsigned b = 0; b < 4; b++) begin
+      if (be[b]) begin
+        merge[8*b+:8] = wdata[8*b+:8];
+      end
+    end
+  endfunction
+
+  assign req_line = core_data_req_i.addr[2+WordW+:LineW];
+  assign req_word = core_data_req_i.addr[2+:WordW];
+  assign req_set = req_line[SetW-1:0];
+  assign {req_hit, req_way} = find_line(req_line);
+  assign req_cacheable = enable_i && in_regions(req_line);
+
+  assign victim_set = req_set;
+  assign victim = victim_way(victim_set);
+  assign victim_dirty = valid_q[victim_set][victim] && dirty_q[victim_set][victim];
+
+  assign fill_set = line_q[SetW-1:0];
+  assign fill_word = state_q == FILL && bus_data_resp_i.rvalid;
+  assign fill_last = fill_word && count_q == WordW'(LINE_WORDS - 1);
+  assign wb_word = state_q == WRITEBACK && bus_data_resp_i.rvalid;
+  assign wb_last = wb_word && count_q == WordW'(LINE_WORDS - 1);
+
+  assign maint_last = maint_set_q == SetW'(SETS - 1) && maint_way_q == WayW'(WAYS - 1);
+  assign maint_wb = maint_clean_q && valid_q[maint_set_q][maint_way_q] &&
+                    dirty_q[maint_set_q][maint_way_q];
+
+  // The accesses outside of the cached regions are passed through, also
+  // while others are in flight, as their responses come back in order
+  assign req_pass = state_q == IDLE && !clean_pending_q && !inval_pending_q &&
+                    core_data_req_i.req && !req_cacheable && pass_cnt_q != '1;
+  assign pass_issue = req_pass && bus_data_resp_i.gnt;
+  assign pass_retire = pass_cnt_q != '0 && bus_data_resp_i.rvalid;
+
+  assign busy_o = clean_pending_q || inval_pending_q || state_q == MAINT;
+
+  always_comb begin
+    state_d = state_q;
+    core_data_resp_o.gnt = 1'b0;
+    core_data_resp_o.rvalid = rvalid_q || pass_retire;
+    core_data_resp_o.rdata = pass_retire ? bus_data_resp_i.rdata : rdata_q;
+    bus_data_req_o.req = 1'b0;
+    bus_data_req_o.we = 1'b0;
+    bus_data_req_o.be = 4'b1111;
+    bus_data_req_o.addr = {line_q, word_q, 2'b00};
+    bus_data_req_o.wdata = '0;
+    hit_o = 1'b0;
+    miss_o = 1'b0;
+
+    case (state_q)
+      IDLE: begin
+        if (req_pass) begin
+          bus_data_req_o = core_data_req_i;
+          core_data_resp_o.gnt = bus_data_resp_i.gnt;
+        end else if (pass_cnt_q != '0) begin
+          // wait for the accesses passed through
+        end else if (clean_pending_q || inval_pending_q) begin
+          state_d = MAINT;
+        end else if (core_data_req_i.req && req_cacheable) begin
+          core_data_resp_o.gnt = 1'b1;
+          if (req_hit) begin
+            hit_o = 1'b1;
+          end else begin
+            miss_o  = 1'b1;
+            state_d = victim_dirty ? WRITEBACK : FILL;
+          end
+        end
+      end
+      WRITEBACK: begin
+        bus_data_req_o.req = !outstanding_q;
+        bus_data_req_o.we = 1'b1;
+        bus_data_req_o.addr = {wb_line_q, word_q, 2'b00};
+        bus_data_req_o.wdata = data_q[wb_line_q[SetW-1:0]][way_q][word_q];
+        if (wb_last) begin
+          state_d = maint_clean_q ? MAINT : FILL;
+        end
+      end
+      FILL: begin
+        bus_data_req_o.req = !outstanding_q;
+        if (fill_last) begin
+          state_d = IDLE;
+        end
+      end
+      MAINT: begin
+        if (maint_wb) begin
+          state_d = WRITEBACK;
+        end else if (maint_last) begin
+          state_d = IDLE;
+        end
+      end
+      default: begin
+        state_d = IDLE;
+      end
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      state_q         <= IDLE;
+      valid_q         <= '0;
+      dirty_q         <= '0;
+      lru_q           <= '0;
+      line_q          <= '0;
+      way_q           <= '0;
+      wb_line_q       <= '0;
+      word_q          <= '0;
+      count_q         <= '0;
+      outstanding_q   <= 1'b0;
+      pass_cnt_q      <= '0;
+      miss_req_q      <= '0;
+      rvalid_q        <= 1'b0;
+      rdata_q         <= '0;
+      clean_pending_q <= 1'b0;
+      inval_pending_q <= 1'b0;
+      maint_clean_q   <= 1'b0;
+      maint_inval_q   <= 1'b0;
+      maint_set_q     <= '0;
+      maint_way_q     <= '0;
+    end else begin
+      state_q  <= state_d;
+      rvalid_q <= 1'b0;
+
+      if (pass_issue != pass_retire) begin
+        pass_cnt_q <= pass_issue ? pass_cnt_q + 1'b1 : pass_cnt_q - 1'b1;
+      end
+
+      if ((state_q == WRITEBACK || state_q == FILL) && bus_data_req_o.req && bus_data_resp_i.gnt) begin
+        outstanding_q <= 1'b1;
+      end else if (wb_word || fill_word) begin
+        outstanding_q <= 1'b0;
+      end
+
+      // Maintenance
+      if (clean_i) begin
+        clean_pending_q <= 1'b1;
+      end
+      if (invalidate_i) begin
+        inval_pending_q <= 1'b1;
+      end
+      if (state_q == IDLE && state_d == MAINT) begin
+        clean_pending_q <= clean_i;
+        inval_pending_q <= invalidate_i;
+        maint_clean_q   <= clean_pending_q;
+        maint_inval_q   <= inval_pending_q;
+        maint_set_q     <= '0;
+        maint_way_q     <= '0;
+      end
+      if (state_q == MAINT) begin
+        if (maint_wb) begin
+          wb_line_q <= {tag_q[maint_set_q][maint_way_q], maint_set_q};
+          way_q     <= maint_way_q;
+          word_q    <= '0;
+          count_q   <= '0;
+        end else begin
+          if (maint_inval_q) begin
+            valid_q[maint_set_q][maint_way_q] <= 1'b0;
+          end
+          if (maint_last) begin
+            maint_clean_q <= 1'b0;
+            maint_inval_q <= 1'b0;
+          end else if (maint_way_q == WayW'(WAYS - 1)) begin
+            maint_way_q <= '0;
+            maint_set_q <= maint_set_q + 1'b1;
+          end else begin
+            maint_way_q <= maint_way_q + 1'b1;
+          end
+        end
+      end
+
+      // Hits and misses
+      if (state_q == IDLE && core_data_resp_o.gnt && !req_pass) begin
+        if (req_hit) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= data_q[req_set][req_way][req_word];
+          if (core_data_req_i.we) begin
+            dirty_q[req_set][req_way] <= 1'b1;
+          end
+          if (WAYS > 1) begin
+            lru_q[req_set] <= ~req_way[0];
+          end
+        end else begin
+          miss_req_q <= core_data_req_i;
+          line_q     <= req_line;
+          way_q      <= victim;
+          wb_line_q  <= {tag_q[victim_set][victim], victim_set};
+          word_q     <= victim_dirty ? '0 : req_word;
+          count_q    <= '0;
+          valid_q[victim_set][victim] <= 1'b0;
+        end
+      end
+
+      if (wb_word) begin
+        word_q  <= word_q + 1'b1;
+        count_q <= count_q + 1'b1;
+        if (wb_last) begin
+          dirty_q[wb_line_q[SetW-1:0]][way_q] <= 1'b0;
+          if (!maint_clean_q) begin
+            // The line of the miss is fetched next
+            word_q  <= miss_req_q.addr[2+:WordW];
+            count_q <= '0;
+          end
+        end
+      end
+
+      if (fill_word) begin
+        word_q  <= word_q + 1'b1;
+        count_q <= count_q + 1'b1;
+        // The requested word comes first
+        if (count_q == '0) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= bus_data_resp_i.rdata;
+        end
+        if (fill_last) begin
+          valid_q[fill_set][way_q] <= 1'b1;
+          dirty_q[fill_set][way_q] <= miss_req_q.we;
+          if (WAYS > 1) begin
+            lru_q[fill_set] <= ~way_q[0];
+          end
+        end
+      end
+    end
+  end
+
+  // Tags and data have no reset, the valid bits cover them
+  always_ff @(posedge clk_i) begin
+    if (state_q == IDLE && core_data_resp_o.gnt && !req_pass) begin
+      if (req_hit && core_data_req_i.we) begin
+        data_q[req_set][req_way][req_word] <= merge(
+            data_q[req_set][req_way][req_word], core_data_req_i.wdata, core_data_req_i.be
+        );
+      end else if (!req_hit) begin
+        tag_q[victim_set][victim] <= req_line[SetW+:TagW];
+      end
+    end
+    if (fill_word) begin
+      data_q[fill_set][way_q][word_q] <= (count_q == '0 && miss_req_q.we) ?
+          merge(bus_data_resp_i.rdata, miss_req_q.wdata, miss_req_q.be) : bus_data_resp_i.rdata;
+    end
+  end
+
+endmodule  // obi_dcache
@@ -2,12 +2,23 @@
 // Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
 // SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 
-//This module relies on the fact that the variable latency XBAR does not rise a new REQ if the previous one has not been granted
+// Decouples an OBI slave from the bus with a request and a response FIFO of
+// DEPTH entries. Up to DEPTH transactions are granted to the producer before
+// their rvalid, so a slow slave does not hold the bus for the whole latency of
+// each transaction: the next requests wait in the FIFO.
+//
+// With DEPTH = 1 the next request is granted with the rvalid of the previous
+// one, which the variable latency XBAR (NtoM bus) relies on: it does not know
+// to which master a response belongs when a slave has several transactions in
+// flight. DEPTH > 1 requires a producer that routes the responses in order,
+// such as the onetoM bus or a single master.
 
 
 module obi_fifo
   import obi_pkg::*;
-(
+#(
+    parameter int unsigned DEPTH = 1
+) (
     input logic clk_i,
     input logic rst_ni,
 
@@ -18,19 +29,7 @@ module obi_fifo
     input  obi_resp_t consumer_resp_i
 );
 
-  typedef enum logic {
-    CONSUMER_REQUEST,
-    CONSUMER_WAIT_FOR_GNT
-  } consumer_obi_req_fsm_e;
-
-  consumer_obi_req_fsm_e consumer_state_n, consumer_state_q;
-
-  typedef enum logic {
-    PRODUCER_REQUEST,
-    PRODUCER_WAIT_FOR_VALID
-  } producer_obi_req_fsm_e;
-
-  producer_obi_req_fsm_e producer_state_n, producer_state_q;
+  localparam int unsigned CountWidth = $clog2(DEPTH + 1);
 
   typedef struct packed {
     logic        we;
@@ -39,7 +38,7 @@ module obi_fifo
     logic [31:0] wdata;
   } obi_data_req_t;
 
-  obi_data_req_t producer_data_req, consumer_data_req, consumer_data_req_q;
+  obi_data_req_t producer_data_req, consumer_data_req;
 
   // remove .req from here if not it stays at 1
   assign {producer_data_req.we, producer_data_req.be, producer_data_req.addr, producer_data_req.wdata} =
@@ -49,91 +48,32 @@ module obi_fifo
 
   logic fifo_req_full, fifo_req_empty, fifo_req_push, fifo_req_pop;
   logic fifo_resp_full, fifo_resp_empty, fifo_resp_push, fifo_resp_pop;
-  logic save_request;
-
-  assign fifo_req_pop = !fifo_req_empty;
-
-  //block consumer outstanding transactions
-  always_comb begin
-    consumer_state_n = consumer_state_q;
-    consumer_req_o.req = ~fifo_req_empty;
-    save_request = 1'b0;
-    {consumer_req_o.we, consumer_req_o.be, consumer_req_o.addr, consumer_req_o.wdata} = {
-      consumer_data_req.we, consumer_data_req.be, consumer_data_req.addr, consumer_data_req.wdata
-    };
-
-    case (consumer_state_q)
-
-      CONSUMER_REQUEST: begin
-        if (!consumer_resp_i.gnt && consumer_req_o.req) begin
-          consumer_state_n = CONSUMER_WAIT_FOR_GNT;
-          save_request = 1'b1;
-        end
-      end
-
-      CONSUMER_WAIT_FOR_GNT: begin
-        consumer_req_o.req = 1'b1;
-        {consumer_req_o.we, consumer_req_o.be, consumer_req_o.addr, consumer_req_o.wdata} = {
-          consumer_data_req_q.we,
-          consumer_data_req_q.be,
-          consumer_data_req_q.addr,
-          consumer_data_req_q.wdata
-        };
-        if (consumer_resp_i.gnt) begin
-          save_request = 1'b0;
-          consumer_state_n = CONSUMER_REQUEST;
-        end
-      end
-    endcase
-  end
 
-  //block producer outstanding transactions, the FIFO in theory can support more request at a time
-  //but the bus won't dispatch the results depending on ID issues, so OBI slaves that have longer gnt/rvalid latency cannot support
-  //back to back requests
-  always_comb begin
-    producer_state_n    = producer_state_q;
-    producer_resp_o.gnt = !fifo_req_full;
-    fifo_req_push       = producer_req_i.req && !fifo_req_full;
-
-    case (producer_state_q)
-
-      PRODUCER_REQUEST: begin
-        if (producer_req_i.req && !fifo_req_full) begin
-          producer_state_n = PRODUCER_WAIT_FOR_VALID;
-        end
-      end
-
-      PRODUCER_WAIT_FOR_VALID: begin
-        fifo_req_push       = 1'b0;
-        producer_resp_o.gnt = 1'b0;
-        if (producer_resp_o.rvalid) begin
-          fifo_req_push = producer_req_i.req && !fifo_req_full;
-          producer_resp_o.gnt = !fifo_req_full;
-          if (producer_req_i.req && producer_resp_o.gnt) begin
-            producer_state_n = PRODUCER_WAIT_FOR_VALID;
-          end else begin
-            producer_state_n = PRODUCER_REQUEST;
-          end
-        end
-      end
-    endcase
-  end
+  // Transactions granted to the producer and not returned yet
+  logic [CountWidth-1:0] outstanding_q;
+
+  // The head of the request FIFO is held on the consumer port until its grant
+  assign consumer_req_o.req = !fifo_req_empty;
+  assign {consumer_req_o.we, consumer_req_o.be, consumer_req_o.addr, consumer_req_o.wdata} = {
+    consumer_data_req.we, consumer_data_req.be, consumer_data_req.addr, consumer_data_req.wdata
+  };
+  assign fifo_req_pop = consumer_req_o.req && consumer_resp_i.gnt;
+
+  // At most DEPTH transactions in flight, the response FIFO then cannot overflow
+  assign producer_resp_o.gnt = !fifo_req_full &&
+                               (outstanding_q < CountWidth'(DEPTH) || producer_resp_o.rvalid);
+  assign fifo_req_push = producer_req_i.req && producer_resp_o.gnt;
 
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (~rst_ni) begin
-      consumer_state_q <= CONSUMER_REQUEST;
-      producer_state_q <= PRODUCER_REQUEST;
-      consumer_data_req_q <= '0;
-    end else begin
-      consumer_state_q <= consumer_state_n;
-      producer_state_q <= producer_state_n;
-      if (save_request) consumer_data_req_q <= consumer_data_req;
+      outstanding_q <= '0;
+    end else if (fifo_req_push != producer_resp_o.rvalid) begin
+      outstanding_q <= fifo_req_push ? outstanding_q + 1'b1 : outstanding_q - 1'b1;
     end
   end
 
-
   fifo_v3 #(
-      .DEPTH(1),
+      .DEPTH(DEPTH),
       .dtype(obi_data_req_t)
   ) obi_req_fifo_i (
       .clk_i,
@@ -149,13 +89,13 @@ module obi_fifo
       .pop_i(fifo_req_pop)
   );
 
-  //todo add asserts - it cannot be full as we are popping all the time
+  //todo add asserts - it cannot be full as the transactions in flight are bounded
   assign fifo_resp_push = consumer_resp_i.rvalid & !fifo_resp_full;
   assign fifo_resp_pop = !fifo_resp_empty;
   assign producer_resp_o.rvalid = fifo_resp_pop;
 
   fifo_v3 #(
-      .DEPTH(1),
+      .DEPTH(DEPTH),
       .dtype(logic [31:0])
   ) obi_resp_fifo_i (
       .clk_i,
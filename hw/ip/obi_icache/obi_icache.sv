@@ -0,0 +1,309 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Instruction cache between the instruction port of the core and the system
+// bus, so that the loops do not fetch their code from the memory banks at
+// each iteration, where the fetches wait for the data and DMA accesses to the
+// same bank, and that the code executed in place from the flash does not go
+// out on the SPI. It is direct-mapped (WAYS = 1) or 2-way set associative
+// with a LRU bit per set, and holds SETS * WAYS lines of LINE_WORDS words in
+// flip-flops. SETS and LINE_WORDS are powers of 2 of at least 2.
+//
+// Only the fetches from the NUM_REGIONS regions [REGION_START, REGION_END)
+// are cached, e.g. the RAM and the flash; the others (boot ROM, debug ROM and
+// program buffer, external memories) go straight to the bus.
+//
+// A miss fetches its line starting from the requested word, which is returned
+// as soon as it arrives, and wraps around to the start of the line. When
+// prefetch_i is set, the next line is then fetched too if it is not cached
+// and is in the same region. A prefetch is dropped, before its next word,
+// when a request for another line arrives; a request for the line being
+// prefetched waits for it.
+//
+// The cache only sees the fetches, so it has to be flushed (or disabled)
+// after code has been written to the memory; flush_i is also raised by the
+// debug requests, so that the software breakpoints written by the debugger
+// are fetched. hit_o and miss_o pulse for each fetch served by the cache and
+// each line fetched for a fetch.
+
+module obi_icache
+  import obi_pkg::*;
+#(
+    parameter int unsigned WAYS = 1,
+    parameter int unsigned SETS = 16,
+    parameter int unsigned LINE_WORDS = 4,
+    parameter int unsigned NUM_REGIONS = 1,
+    parameter logic [NUM_REGIONS-1:0][31:0] REGION_START = '0,
+    parameter logic [NUM_REGIONS-1:0][31:0] REGION_END = '0
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  core_instr_req_i,
+    output obi_resp_t core_instr_resp_o,
+
+    output obi_req_t  bus_instr_req_o,
+    input  obi_resp_t bus_instr_resp_i,
+
+    input logic enable_i,
+    input logic prefetch_i,
+    input logic flush_i,
+
+    output logic hit_o,
+    output logic miss_o
+);
+
+  localparam int unsigned WordW = $clog2(LINE_WORDS);
+  localparam int unsigned SetW = $clog2(SETS);
+  localparam int unsigned LineW = 30 - WordW;
+  localparam int unsigned TagW = LineW - SetW;
+  localparam int unsigned WayW = (WAYS > 1) ? $clog2(WAYS) : 1;
+
+  typedef enum logic [2:0] {
+    IDLE,
+    FILL,
+    PREFETCH_CHECK,
+    PREFETCH,
+    BYPASS
+  } cache_state_e;
+
+  cache_state_e state_q, state_d;
+
+  logic [TagW-1:0] tag_q[SETS][WAYS];
+  logic [31:0] data_q[SETS][WAYS][LINE_WORDS];
+  logic [SETS-1:0][WAYS-1:0] valid_q;
+  // Way to replace next in each set
+  logic [SETS-1:0] lru_q;
+
+  // Line being fetched, its way and the next word to fetch
+  logic [LineW-1:0] line_q;
+  logic [WayW-1:0] way_q;
+  logic [WordW-1:0] word_q;
+  logic [WordW-1:0] count_q;
+  logic outstanding_q;
+  logic flush_q;
+
+  obi_req_t bypass_req_q;
+  logic rvalid_q;
+  logic [31:0] rdata_q;
+
+  logic [LineW-1:0] req_line;
+  logic [WordW-1:0] req_word;
+  logic [SetW-1:0] req_set;
+  logic [WayW-1:0] req_way;
+  logic req_hit;
+  logic req_cacheable;
+
+  logic [LineW-1:0] next_line;
+  logic [WayW-1:0] next_way;
+  logic next_hit;
+  logic next_cacheable;
+
+  logic [LineW-1:0] alloc_line;
+  logic [SetW-1:0] alloc_set;
+  logic [WayW-1:0] alloc_way;
+  logic alloc;
+
+  logic [SetW-1:0] fill_set;
+  logic fill_word;
+  logic fill_last;
+  logic prefetch_abort;
+
+  // Whether a line is entirely in one of the cached regions
+  function automatic logic in_regions(input logic [LineW-1:0] line);
+    logic [31:0] start_addr, end_addr;
+    start_addr = {line, WordW'(0), 2'b00};
+    end_addr   = start_addr + 4 * LINE_WORDS;
+    in_regions = 1'b0;
+    for (int unsigned r = 0; r < NUM_REGIONS; r++) begin
+      if (start_addr >= REGION_START[r] && end_addr <= REGION_END[r] && end_addr > start_addr) begin
+        in_regions = 1'b1;
+      end
+    end
+  endfunction
+
+  // Returns the way holding a line, with the hit flag as MSB
+  function automatic logic [WayW:0] find_line(input logic [LineW-1:0] line);
+    find_line = '0;
+    for (int unsigned w = 0; w < WAYS; w++) begin
+      if (valid_q[line[SetW-1:0]][w] && tag_q[line[SetW-1:0]][w] == line[SetW+:TagW]) begin
+        find_line = {1'b1, WayW'(w)};
+      end
+    end
+  endfunction
+
+  // Returns an invalid way of a set if any, the least recently used one otherwise
+  function automatic logic [WayW-1:0] victim_way(input logic [SetW-1:0] set);
+    victim_way = (WAYS > 1) ? WayW'(lru_q[set]) : '0;
+    for (int w = WAYS - 1; w >= 0; w--) begin
+      if (!valid_q[set][w]) begin
+        victim_way = WayW'(w);
+      end
+    end
+  endfunction
+
+  assign req_line = core_instr_req_i.addr[2+WordW+:LineW];
+  assign req_word = core_instr_req_i.addr[2+:WordW];
+  assign req_set = req_line[SetW-1:0];
+  assign {req_hit, req_way} = find_line(req_line);
+  assign req_cacheable = enable_i && !flush_q && !core_instr_req_i.we && in_regions(req_line);
+
+  assign next_line = line_q + 1'b1;
+  assign {next_hit, next_way} = find_line(next_line);
+  assign next_cacheable = in_regions(next_line);
+
+  assign fill_set = line_q[SetW-1:0];
+  assign fill_word = (state_q == FILL || state_q == PREFETCH) && bus_instr_resp_i.rvalid;
+  assign fill_last = fill_word && count_q == WordW'(LINE_WORDS - 1);
+  assign prefetch_abort = core_instr_req_i.req && (!req_cacheable || req_line != line_q);
+
+  // A line is allocated on a miss and at the start of a prefetch
+  assign alloc = (state_q == IDLE && core_instr_req_i.req && req_cacheable && !req_hit) ||
+                 (state_q == PREFETCH_CHECK && prefetch_i && enable_i && !flush_q && next_cacheable && !next_hit);
+  assign alloc_line = (state_q == IDLE) ? req_line : next_line;
+  assign alloc_set = alloc_line[SetW-1:0];
+  assign alloc_way = victim_way(alloc_set);
+
+  always_comb begin
+    state_d = state_q;
+    core_instr_resp_o.gnt = 1'b0;
+    core_instr_resp_o.rvalid = rvalid_q;
+    core_instr_resp_o.rdata = rdata_q;
+    bus_instr_req_o.req = 1'b0;
+    bus_instr_req_o.we = 1'b0;
+    bus_instr_req_o.be = 4'b1111;
+    bus_instr_req_o.addr = {line_q, word_q, 2'b00};
+    bus_instr_req_o.wdata = '0;
+    hit_o = 1'b0;
+    miss_o = 1'b0;
+
+    case (state_q)
+      IDLE: begin
+        if (core_instr_req_i.req) begin
+          core_instr_resp_o.gnt = 1'b1;
+          if (!req_cacheable) begin
+            state_d = BYPASS;
+          end else if (req_hit) begin
+            hit_o = 1'b1;
+          end else begin
+            miss_o  = 1'b1;
+            state_d = FILL;
+          end
+        end
+      end
+      FILL: begin
+        bus_instr_req_o.req = !outstanding_q;
+        if (fill_last) begin
+          state_d = prefetch_i ? PREFETCH_CHECK : IDLE;
+        end
+      end
+      PREFETCH_CHECK: begin
+        state_d = alloc ? PREFETCH : IDLE;
+      end
+      PREFETCH: begin
+        bus_instr_req_o.req = !outstanding_q && !prefetch_abort;
+        if (fill_last || (!outstanding_q && prefetch_abort)) begin
+          state_d = IDLE;
+        end
+      end
+      BYPASS: begin
+        bus_instr_req_o = bypass_req_q;
+        bus_instr_req_o.req = !outstanding_q;
+        if (bus_instr_resp_i.rvalid) begin
+          state_d = IDLE;
+        end
+      end
+      default: begin
+        state_d = IDLE;
+      end
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      state_q       <= IDLE;
+      valid_q       <= '0;
+      lru_q         <= '0;
+      line_q        <= '0;
+      way_q         <= '0;
+      word_q        <= '0;
+      count_q       <= '0;
+      outstanding_q <= 1'b0;
+      flush_q       <= 1'b0;
+      bypass_req_q  <= '0;
+      rvalid_q      <= 1'b0;
+      rdata_q       <= '0;
+    end else begin
+      state_q  <= state_d;
+      rvalid_q <= 1'b0;
+
+      if (flush_i) begin
+        flush_q <= 1'b1;
+      end else if (state_q == IDLE) begin
+        flush_q <= 1'b0;
+      end
+      if (state_q == IDLE && (flush_q || !enable_i)) begin
+        valid_q <= '0;
+      end
+
+      if (bus_instr_req_o.req && bus_instr_resp_i.gnt) begin
+        outstanding_q <= 1'b1;
+      end else if (bus_instr_resp_i.rvalid) begin
+        outstanding_q <= 1'b0;
+      end
+
+      if (state_q == IDLE && core_instr_req_i.req) begin
+        if (!req_cacheable) begin
+          bypass_req_q <= core_instr_req_i;
+        end else if (req_hit) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= data_q[req_set][req_way][req_word];
+          if (WAYS > 1) begin
+            lru_q[req_set] <= ~req_way[0];
+          end
+        end
+      end
+
+      if (alloc) begin
+        valid_q[alloc_set][alloc_way] <= 1'b0;
+        line_q  <= alloc_line;
+        way_q   <= alloc_way;
+        word_q  <= (state_q == IDLE) ? req_word : '0;
+        count_q <= '0;
+      end
+
+      if (fill_word) begin
+        word_q  <= word_q + 1'b1;
+        count_q <= count_q + 1'b1;
+        // The requested word comes first
+        if (state_q == FILL && count_q == '0) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= bus_instr_resp_i.rdata;
+        end
+        if (fill_last) begin
+          valid_q[fill_set][way_q] <= 1'b1;
+          if (WAYS > 1) begin
+            lru_q[fill_set] <= ~way_q[0];
+          end
+        end
+      end
+
+      if (state_q == BYPASS && bus_instr_resp_i.rvalid) begin
+        rvalid_q <= 1'b1;
+        rdata_q  <= bus_instr_resp_i.rdata;
+      end
+    end
+  end
+
+  // Tags and data have no reset, the valid bits cover them
+  always_ff @(posedge clk_i) begin
+    if (alloc) begin
+      tag_q[alloc_set][alloc_way] <= alloc_line[SetW+:TagW];
+    end
+    if (fill_word) begin
+      data_q[fill_set][way_q][word_q] <= bus_instr_resp_i.rdata;
+    end
+  end
+
+endmodule  // obi_icache
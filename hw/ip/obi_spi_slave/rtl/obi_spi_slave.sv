@@ -0,0 +1,136 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+/*
+  SPI slave master of the system crossbar (spi_slave in mcu_cfg.hjson): the
+  vendored axi_spi_slave, with a 32-bit AXI port, behind axi_lite_to_obi. An
+  external host reads and writes the whole address space of X-HEEP, in
+  standard or quad SPI, without the CPU. The AXI plug of axi_spi_slave does
+  one single beat transaction at a time per direction, so AXI4-Lite is
+  enough. The chip select is active low, the output enables of the pads are
+  active high.
+*/
+
+module obi_spi_slave
+  import obi_pkg::*;
+(
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  logic       spi_sck_i,
+    input  logic       spi_cs_i,
+    input  logic [3:0] spi_sd_i,
+    output logic [3:0] spi_sd_o,
+    output logic [3:0] spi_sd_oe_o,
+
+    output obi_req_t  obi_req_o,
+    input  obi_resp_t obi_resp_i
+);
+
+  logic [3:0] spi_sd_oen;
+
+  logic [31:0] aw_addr, w_data, ar_addr, r_data;
+  logic [3:0] w_strb;
+  logic [1:0] b_resp, r_resp;
+  logic aw_valid, aw_ready, w_valid, w_ready, b_valid, b_ready;
+  logic ar_valid, ar_ready, r_valid, r_ready;
+
+  axi_spi_slave #(
+      .AXI_ADDR_WIDTH(32),
+      .AXI_DATA_WIDTH(32),
+      .AXI_USER_WIDTH(1),
+      .AXI_ID_WIDTH  (1)
+  ) axi_spi_slave_i (
+      .test_mode           (1'b0),
+      .spi_sclk            (spi_sck_i),
+      .spi_cs              (spi_cs_i),
+      .spi_oen0_o          (spi_sd_oen[0]),
+      .spi_oen1_o          (spi_sd_oen[1]),
+      .spi_oen2_o          (spi_sd_oen[2]),
+      .spi_oen3_o          (spi_sd_oen[3]),
+      .spi_sdi0            (spi_sd_i[0]),
+      .spi_sdi1            (spi_sd_i[1]),
+      .spi_sdi2            (spi_sd_i[2]),
+      .spi_sdi3            (spi_sd_i[3]),
+      .spi_sdo0            (spi_sd_o[0]),
+      .spi_sdo1            (spi_sd_o[1]),
+      .spi_sdo2            (spi_sd_o[2]),
+      .spi_sdo3            (spi_sd_o[3]),
+      .axi_aclk            (clk_i),
+      .axi_aresetn         (rst_ni),
+      .axi_master_aw_valid (aw_valid),
+      .axi_master_aw_addr  (aw_addr),
+      .axi_master_aw_prot  (),
+      .axi_master_aw_region(),
+      .axi_master_aw_len   (),
+      .axi_master_aw_size  (),
+      .axi_master_aw_burst (),
+      .axi_master_aw_lock  (),
+      .axi_master_aw_cache (),
+      .axi_master_aw_qos   (),
+      .axi_master_aw_id    (),
+      .axi_master_aw_user  (),
+      .axi_master_aw_ready (aw_ready),
+      .axi_master_ar_valid (ar_valid),
+      .axi_master_ar_addr  (ar_addr),
+      .axi_master_ar_prot  (),
+      .axi_master_ar_region(),
+      .axi_master_ar_len   (),
+      .axi_master_ar_size  (),
+      .axi_master_ar_burst (),
+      .axi_master_ar_lock  (),
+      .axi_master_ar_cache (),
+      .axi_master_ar_qos   (),
+      .axi_master_ar_id    (),
+      .axi_master_ar_user  (),
+      .axi_master_ar_ready (ar_ready),
+      .axi_master_w_valid  (w_valid),
+      .axi_master_w_data   (w_data),
+      .axi_master_w_strb   (w_strb),
+      .axi_master_w_user   (),
+      .axi_master_w_last   (),
+      .axi_master_w_ready  (w_ready),
+      .axi_master_r_valid  (r_valid),
+      .axi_master_r_data   (r_data),
+      .axi_master_r_resp   (r_resp),
+      .axi_master_r_last   (1'b1),
+      .axi_master_r_id     (1'b0),
+      .axi_master_r_user   (1'b0),
+      .axi_master_r_ready  (r_ready),
+      .axi_master_b_valid  (b_valid),
+      .axi_master_b_resp   (b_resp),
+      .axi_master_b_id     (1'b0),
+      .axi_master_b_user   (1'b0),
+      .axi_master_b_ready  (b_ready)
+  );
+
+  assign spi_sd_oe_o = ~spi_sd_oen;
+
+  axi_lite_to_obi #(
+      .AddrMask(32'hFFFFFFFF)
+  ) axi_lite_to_obi_i (
+      .clk_i,
+      .rst_ni,
+      .s_axi_awaddr_i (aw_addr),
+      .s_axi_awvalid_i(aw_valid),
+      .s_axi_awready_o(aw_ready),
+      .s_axi_wdata_i  (w_data),
+      .s_axi_wstrb_i  (w_strb),
+      .s_axi_wvalid_i (w_valid),
+      .s_axi_wready_o (w_ready),
+      .s_axi_bresp_o  (b_resp),
+      .s_axi_bvalid_o (b_valid),
+      .s_axi_bready_i (b_ready),
+      .s_axi_araddr_i (ar_addr),
+      .s_axi_arvalid_i(ar_valid),
+      .s_axi_arready_o(ar_ready),
+      .s_axi_rdata_o  (r_data),
+      .s_axi_rresp_o  (r_resp),
+      .s_axi_rvalid_o (r_valid),
+      .s_axi_rready_i (r_ready),
+      .obi_req_o,
+      .obi_resp_i
+  );
+
+endmodule : obi_spi_slave
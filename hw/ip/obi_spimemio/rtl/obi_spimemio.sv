@@ -4,10 +4,22 @@
 *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 */
 
+// CACHE_WAYS = 0 removes the read cache, see obi_spimemio_cache.sv for the
+// other parameters.
+//
+// hold_i stops SPIMEM and keeps its chip select high, for the SPI host to
+// use the flash (spi_subsystem.sv): SPIMEM is soft reset as by a write of
+// its configuration, the same one, as long as hold_i is set, and restarts
+// from its wake-up sequence after. A read in progress is started again.
+
 module obi_spimemio
   import obi_pkg::*;
   import reg_pkg::*;
-(
+#(
+    parameter int unsigned CACHE_WAYS = 1,
+    parameter int unsigned CACHE_SETS = 16,
+    parameter int unsigned CACHE_LINE_WORDS = 4
+) (
     input  logic clk_i,
     input  logic rst_ni,
     output logic flash_csb_o,
@@ -32,7 +44,13 @@ module obi_spimemio
     output reg_rsp_t reg_rsp_o,
 
     input  obi_req_t  spimemio_req_i,
-    output obi_resp_t spimemio_resp_o
+    output obi_resp_t spimemio_resp_o,
+
+    // Sharing of the flash with the SPI host
+    input  logic hold_i,
+    output logic busy_o,
+    output logic cont_o,
+    output logic arbiter_en_o
 );
 
   import picorv32_pkg::*;
@@ -43,18 +61,54 @@ module obi_spimemio
 
   reg_rsp_t reg_rsp_reg, reg_rsp_spimem;
 
-  logic [31:0] cfgreg_do;
+  logic [31:0] cfgreg_do, spimem_cfg_di;
+  logic [3:0] spimem_cfg_we;
   logic cfgreg_we, cfgreg_rd;
 
   obi_spimemio_reg2hw_t reg2hw;
+  obi_spimemio_hw2reg_t hw2reg;
+
+  obi_req_t  flash_req;
+  obi_resp_t flash_resp;
+  logic cache_hit, cache_miss;
+
+  if (CACHE_WAYS > 0) begin : gen_cache
+    obi_spimemio_cache #(
+        .WAYS(CACHE_WAYS),
+        .SETS(CACHE_SETS),
+        .LINE_WORDS(CACHE_LINE_WORDS)
+    ) obi_spimemio_cache_i (
+        .clk_i,
+        .rst_ni,
+        .obi_req_i(spimemio_req_i),
+        .obi_resp_o(spimemio_resp_o),
+        .flash_req_o(flash_req),
+        .flash_resp_i(flash_resp),
+        .enable_i(reg2hw.cache_ctrl.enable.q),
+        .prefetch_i(reg2hw.cache_ctrl.prefetch.q),
+        .flush_i(reg2hw.cache_flush.qe & reg2hw.cache_flush.q),
+        .hit_o(cache_hit),
+        .miss_o(cache_miss)
+    );
+  end else begin : gen_no_cache
+    assign flash_req = spimemio_req_i;
+    assign spimemio_resp_o = flash_resp;
+    assign cache_hit = 1'b0;
+    assign cache_miss = 1'b0;
+  end
+
+  assign hw2reg.cache_hits.d = reg2hw.cache_hits.q + 32'd1;
+  assign hw2reg.cache_hits.de = cache_hit;
+  assign hw2reg.cache_misses.d = reg2hw.cache_misses.q + 32'd1;
+  assign hw2reg.cache_misses.de = cache_miss;
 
   obi_to_picorv32 obi_to_picorv32_i (
       .clk_i(clk_i),
       .rst_ni(rst_ni),
       .picorv32_req_o(picorv32_req),
       .picorv32_resp_i(picorv32_resp),
-      .obi_req_i(spimemio_req_i),
-      .obi_resp_o(spimemio_resp_o)
+      .obi_req_i(flash_req),
+      .obi_resp_o(flash_resp)
   );
 
   obi_spimemio_reg_top #(
@@ -66,12 +120,22 @@ module obi_spimemio
       .reg_req_i,
       .reg_rsp_o(reg_rsp_reg),
       .reg2hw,
+      .hw2reg,
       .devmode_i(1'b1)
   );
 
   assign cfgreg_we = reg_req_i.valid & reg_req_i.write && reg_req_i.addr[obi_spimemio_reg_pkg::BlockAw-1:0] == OBI_SPIMEMIO_CFG_SPIMEM_OFFSET;
   assign cfgreg_rd = reg_req_i.valid & ~reg_req_i.write && reg_req_i.addr[obi_spimemio_reg_pkg::BlockAw-1:0] == OBI_SPIMEMIO_CFG_SPIMEM_OFFSET;
 
+  // The hold writes back byte 2 of the configuration (read command, dummy
+  // cycles), the only one read back as written, which soft resets SPIMEM
+  assign spimem_cfg_we = {4{cfgreg_we}} | {1'b0, hold_i, 2'b00};
+  assign spimem_cfg_di = cfgreg_we ? reg_req_i.wdata : {8'h00, cfgreg_do[23:16], 16'h0000};
+
+  assign busy_o = picorv32_req.valid;
+  assign cont_o = cfgreg_do[20];
+  assign arbiter_en_o = reg2hw.arbiter_ctrl.q;
+
   always_comb begin
     reg_rsp_spimem.rdata = cfgreg_do;
     reg_rsp_spimem.error = 1'b0;
@@ -111,8 +175,8 @@ module obi_spimemio
       .flash_io2_di(flash_io2_di_i),
       .flash_io3_di(flash_io3_di_i),
 
-      .cfgreg_we({4{cfgreg_we}}),
-      .cfgreg_di(reg_req_i.wdata),
+      .cfgreg_we(spimem_cfg_we),
+      .cfgreg_di(spimem_cfg_di),
       .cfgreg_do(cfgreg_do)
   );
 
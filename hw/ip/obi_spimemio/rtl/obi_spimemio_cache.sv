@@ -0,0 +1,290 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Read cache between the system bus and obi_to_picorv32, so that the code and
+// the constants executed in place from the flash do not go out on the SPI at
+// each access. It is direct-mapped (WAYS = 1) or 2-way set associative with a
+// LRU bit per set, and holds SETS * WAYS lines of LINE_WORDS words in
+// flip-flops. SETS and LINE_WORDS are powers of 2 of at least 2.
+//
+// A miss fetches its line starting from the requested word, which is returned
+// as soon as it arrives, and wraps around to the start of the line. When
+// prefetch_i is set, the next line is then fetched too if it is not cached:
+// after a miss on the first word of a line, both lines are read in the same
+// continuous spimemio transfer. A prefetch is dropped, before its next word,
+// when a request for another line arrives; a request for the line being
+// prefetched waits for it.
+//
+// The cache only sees its own reads, so it has to be flushed (or disabled)
+// after the flash has been written through the SPI host. Writes and the
+// accesses while it is disabled go straight to the flash. hit_o and miss_o
+// pulse for each read served by the cache and each line fetched for a read.
+
+module obi_spimemio_cache
+  import obi_pkg::*;
+#(
+    parameter int unsigned WAYS = 1,
+    parameter int unsigned SETS = 16,
+    parameter int unsigned LINE_WORDS = 4
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  obi_req_i,
+    output obi_resp_t obi_resp_o,
+
+    output obi_req_t  flash_req_o,
+    input  obi_resp_t flash_resp_i,
+
+    input logic enable_i,
+    input logic prefetch_i,
+    input logic flush_i,
+
+    output logic hit_o,
+    output logic miss_o
+);
+
+  // spimemio only decodes the lower 24 bits of the address
+  localparam int unsigned AddrW = 24;
+  localparam int unsigned WordW = $clog2(LINE_WORDS);
+  localparam int unsigned SetW = $clog2(SETS);
+  localparam int unsigned LineW = AddrW - 2 - WordW;
+  localparam int unsigned TagW = LineW - SetW;
+  localparam int unsigned WayW = (WAYS > 1) ? $clog2(WAYS) : 1;
+
+  typedef enum logic [2:0] {
+    IDLE,
+    FILL,
+    PREFETCH_CHECK,
+    PREFETCH,
+    BYPASS
+  } cache_state_e;
+
+  cache_state_e state_q, state_d;
+
+  logic [TagW-1:0] tag_q[SETS][WAYS];
+  logic [31:0] data_q[SETS][WAYS][LINE_WORDS];
+  logic [SETS-1:0][WAYS-1:0] valid_q;
+  // Way to replace next in each set
+  logic [SETS-1:0] lru_q;
+
+  // Line being fetched, its way and the next word to fetch
+  logic [LineW-1:0] line_q;
+  logic [31:AddrW] addr_hi_q;
+  logic [WayW-1:0] way_q;
+  logic [WordW-1:0] word_q;
+  logic [WordW-1:0] count_q;
+  logic outstanding_q;
+  logic flush_q;
+
+  obi_req_t bypass_req_q;
+  logic rvalid_q;
+  logic [31:0] rdata_q;
+
+  logic [LineW-1:0] req_line;
+  logic [WordW-1:0] req_word;
+  logic [SetW-1:0] req_set;
+  logic [WayW-1:0] req_way;
+  logic req_hit;
+  logic req_cacheable;
+
+  logic [LineW-1:0] next_line;
+  logic [WayW-1:0] next_way;
+  logic next_hit;
+
+  logic [LineW-1:0] alloc_line;
+  logic [SetW-1:0] alloc_set;
+  logic [WayW-1:0] alloc_way;
+  logic alloc;
+
+  logic [SetW-1:0] fill_set;
+  logic fill_word;
+  logic fill_last;
+  logic prefetch_abort;
+
+  // Returns the way holding a line, with the hit flag as MSB
+  function automatic logic [WayW:0] find_line(input logic [LineW-1:0] line);
+    find_line = '0;
+    for (int unsigned w = 0; w < WAYS; w++) begin
+      if (valid_q[line[SetW-1:0]][w] && tag_q[line[SetW-1:0]][w] == line[SetW+:TagW]) begin
+        find_line = {1'b1, WayW'(w)};
+      end
+    end
+  endfunction
+
+  // Returns an invalid way of a set if any, the least recently used one otherwise
+  function automatic logic [WayW-1:0] victim_way(input logic [SetW-1:0] set);
+    victim_way = (WAYS > 1) ? WayW'(lru_q[set]) : '0;
+    for (int w = WAYS - 1; w >= 0; w--) begin
+      if (!valid_q[set][w]) begin
+        victim_way = WayW'(w);
+      end
+    end
+  endfunction
+
+  assign req_line = obi_req_i.addr[2+WordW+:LineW];
+  assign req_word = obi_req_i.addr[2+:WordW];
+  assign req_set = req_line[SetW-1:0];
+  assign {req_hit, req_way} = find_line(req_line);
+  assign req_cacheable = enable_i && !flush_q && !obi_req_i.we;
+
+  assign next_line = line_q + 1'b1;
+  assign {next_hit, next_way} = find_line(next_line);
+
+  assign fill_set = line_q[SetW-1:0];
+  assign fill_word = (state_q == FILL || state_q == PREFETCH) && flash_resp_i.rvalid;
+  assign fill_last = fill_word && count_q == WordW'(LINE_WORDS - 1);
+  assign prefetch_abort = obi_req_i.req && (!req_cacheable || req_line != line_q);
+
+  // A line is allocated on a miss and at the start of a prefetch
+  assign alloc = (state_q == IDLE && obi_req_i.req && req_cacheable && !req_hit) ||
+                 (state_q == PREFETCH_CHECK && prefetch_i && enable_i && !flush_q && !next_hit);
+  assign alloc_line = (state_q == IDLE) ? req_line : next_line;
+  assign alloc_set = alloc_line[SetW-1:0];
+  assign alloc_way = victim_way(alloc_set);
+
+  always_comb begin
+    state_d = state_q;
+    obi_resp_o.gnt = 1'b0;
+    obi_resp_o.rvalid = rvalid_q;
+    obi_resp_o.rdata = rdata_q;
+    flash_req_o.req = 1'b0;
+    flash_req_o.we = 1'b0;
+    flash_req_o.be = 4'b1111;
+    flash_req_o.addr = {addr_hi_q, line_q, word_q, 2'b00};
+    flash_req_o.wdata = '0;
+    hit_o = 1'b0;
+    miss_o = 1'b0;
+
+    case (state_q)
+      IDLE: begin
+        if (obi_req_i.req) begin
+          obi_resp_o.gnt = 1'b1;
+          if (!req_cacheable) begin
+            state_d = BYPASS;
+          end else if (req_hit) begin
+            hit_o = 1'b1;
+          end else begin
+            miss_o  = 1'b1;
+            state_d = FILL;
+          end
+        end
+      end
+      FILL: begin
+        flash_req_o.req = !outstanding_q;
+        if (fill_last) begin
+          state_d = prefetch_i ? PREFETCH_CHECK : IDLE;
+        end
+      end
+      PREFETCH_CHECK: begin
+        state_d = alloc ? PREFETCH : IDLE;
+      end
+      PREFETCH: begin
+        flash_req_o.req = !outstanding_q && !prefetch_abort;
+        if (fill_last || (!outstanding_q && prefetch_abort)) begin
+          state_d = IDLE;
+        end
+      end
+      BYPASS: begin
+        flash_req_o = bypass_req_q;
+        flash_req_o.req = !outstanding_q;
+        if (flash_resp_i.rvalid) begin
+          state_d = IDLE;
+        end
+      end
+      default: begin
+        state_d = IDLE;
+      end
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      state_q       <= IDLE;
+      valid_q       <= '0;
+      lru_q         <= '0;
+      line_q        <= '0;
+      addr_hi_q     <= '0;
+      way_q         <= '0;
+      word_q        <= '0;
+      count_q       <= '0;
+      outstanding_q <= 1'b0;
+      flush_q       <= 1'b0;
+      bypass_req_q  <= '0;
+      rvalid_q      <= 1'b0;
+      rdata_q       <= '0;
+    end else begin
+      state_q  <= state_d;
+      rvalid_q <= 1'b0;
+
+      if (flush_i) begin
+        flush_q <= 1'b1;
+      end else if (state_q == IDLE) begin
+        flush_q <= 1'b0;
+      end
+      if (state_q == IDLE && (flush_q || !enable_i)) begin
+        valid_q <= '0;
+      end
+
+      if (flash_req_o.req && flash_resp_i.gnt) begin
+        outstanding_q <= 1'b1;
+      end else if (flash_resp_i.rvalid) begin
+        outstanding_q <= 1'b0;
+      end
+
+      if (state_q == IDLE && obi_req_i.req) begin
+        addr_hi_q <= obi_req_i.addr[31:AddrW];
+        if (!req_cacheable) begin
+          bypass_req_q <= obi_req_i;
+        end else if (req_hit) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= data_q[req_set][req_way][req_word];
+          if (WAYS > 1) begin
+            lru_q[req_set] <= ~req_way[0];
+          end
+        end
+      end
+
+      if (alloc) begin
+        valid_q[alloc_set][alloc_way] <= 1'b0;
+        line_q  <= alloc_line;
+        way_q   <= alloc_way;
+        word_q  <= (state_q == IDLE) ? req_word : '0;
+        count_q <= '0;
+      end
+
+      if (fill_word) begin
+        word_q  <= word_q + 1'b1;
+        count_q <= count_q + 1'b1;
+        // The requested word comes first
+        if (state_q == FILL && count_q == '0) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= flash_resp_i.rdata;
+        end
+        if (fill_last) begin
+          valid_q[fill_set][way_q] <= 1'b1;
+          if (WAYS > 1) begin
+            lru_q[fill_set] <= ~way_q[0];
+          end
+        end
+      end
+
+      if (state_q == BYPASS && flash_resp_i.rvalid) begin
+        rvalid_q <= 1'b1;
+        rdata_q  <= flash_resp_i.rdata;
+      end
+    end
+  end
+
+  // Tags and data have no reset, the valid bits cover them
+  always_ff @(posedge clk_i) begin
+    if (alloc) begin
+      tag_q[alloc_set][alloc_way] <= alloc_line[SetW+:TagW];
+    end
+    if (fill_word) begin
+      data_q[fill_set][way_q][word_q] <= flash_resp_i.rdata;
+    end
+  end
+
+endmodule  // obi_spimemio_cache
@@ -0,0 +1,90 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Tightly coupled memory: a scratchpad private to the data port of the core,
+// in front of the system bus. The accesses to [START, START + SIZE) are
+// granted at once and answered at the next cycle, as by a RAM bank, but
+// without the arbitration of the crossbar, so that the DMA and the other
+// masters never delay them; the other accesses go to the bus.
+//
+// Only the data port of the core sees the scratchpad: the instruction port,
+// the DMA, the debugger and the external masters get a bus error there. SIZE
+// is a power of 2 of at least 4 bytes.
+//
+// The responses come back in the order of the requests: an access to the
+// scratchpad waits for the responses of the bus accesses in flight, at most
+// a cycle after the last one, to never overtake them.
+
+module obi_tcm
+  import obi_pkg::*;
+#(
+    parameter logic [31:0] START = '0,
+    parameter int unsigned SIZE = 4096
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  core_data_req_i,
+    output obi_resp_t core_data_resp_o,
+
+    output obi_req_t  bus_data_req_o,
+    input  obi_resp_t bus_data_resp_i
+);
+
+  localparam int unsigned AddrWidth = $clog2(SIZE);
+  // Data accesses to the bus in flight, the core has at most 2
+  localparam int unsigned OutstandingW = 2;
+
+  logic [31:0] tcm_offset;
+  logic tcm_sel;
+  logic tcm_req;
+  logic tcm_rvalid_q;
+  logic [31:0] tcm_rdata;
+  logic [OutstandingW-1:0] bus_cnt_q;
+  logic bus_drained;
+
+  assign tcm_offset = core_data_req_i.addr - START;
+  assign tcm_sel = core_data_req_i.addr >= START && tcm_offset < SIZE;
+
+  // The last bus response, if any, arrives at the latest in this cycle
+  assign bus_drained = bus_cnt_q == '0 || (bus_cnt_q == OutstandingW'(1) && bus_data_resp_i.rvalid);
+
+  assign tcm_req = core_data_req_i.req && tcm_sel && bus_drained;
+
+  always_comb begin
+    bus_data_req_o            = core_data_req_i;
+    bus_data_req_o.req        = core_data_req_i.req && !tcm_sel;
+
+    core_data_resp_o.gnt      = tcm_sel ? tcm_req : bus_data_resp_i.gnt;
+    core_data_resp_o.rvalid   = tcm_rvalid_q | bus_data_resp_i.rvalid;
+    core_data_resp_o.rdata    = tcm_rvalid_q ? tcm_rdata : bus_data_resp_i.rdata;
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      tcm_rvalid_q <= 1'b0;
+      bus_cnt_q    <= '0;
+    end else begin
+      tcm_rvalid_q <= tcm_req;
+      bus_cnt_q    <= bus_cnt_q + OutstandingW'(bus_data_req_o.req && bus_data_resp_i.gnt)
+                                - OutstandingW'(bus_data_resp_i.rvalid);
+    end
+  end
+
+  sram_wrapper #(
+      .NumWords (SIZE / 4),
+      .DataWidth(32'd32)
+  ) tcm_i (
+      .clk_i,
+      .rst_ni,
+      .req_i(tcm_req),
+      .we_i(core_data_req_i.we),
+      .addr_i(tcm_offset[AddrWidth-1:2]),
+      .wdata_i(core_data_req_i.wdata),
+      .be_i(core_data_req_i.be),
+      .set_retentive_ni(1'b1),
+      .rdata_o(tcm_rdata)
+  );
+
+endmodule  // obi_tcm
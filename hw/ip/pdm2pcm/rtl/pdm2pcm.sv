@@ -5,12 +5,18 @@
 // Author: Pierre Guillod <pierre.guillod@epfl.ch>, EPFL, STI-SEL
 // Date: 19.02.2022
 // Description: Top wrapper for the PDM2PCM acquisition peripheral
+//              The CONTROL.CHANNELS+1 first channels of each PCM output are
+//              pushed into the FIFO one after the other, as a whole or not
+//              at all so that the channels stay interleaved in order.
 
 module pdm2pcm #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int unsigned FIFO_DEPTH = 4,
+    parameter int unsigned FIFO_DEPTH = 16,
     parameter int unsigned FIFO_WIDTH = 18,
+    // PDM lines, each carrying 2 channels (at most 4 lines)
+    parameter int unsigned NUM_LINES = 1,
+    localparam int unsigned NUM_CHANNELS = 2 * NUM_LINES,
     localparam int unsigned FIFO_ADDR_WIDTH = $clog2(FIFO_DEPTH)
 ) (
     input logic clk_i,
@@ -21,8 +27,14 @@ module pdm2pcm #(
     output reg_rsp_t reg_rsp_o,
 
     // PDM interface
-    input  logic pdm_i,
-    output logic pdm_clk_o
+    input  logic [NUM_LINES-1:0] pdm_i,
+    output logic                 pdm_clk_o,
+
+    // Watermark interrupt
+    output logic intr_pdm2pcm_event_o,
+
+    // DMA trigger, a sample can be read
+    output logic pdm2pcm_rx_valid_o
 );
 
   import pdm2pcm_reg_pkg::*;
@@ -36,12 +48,20 @@ module pdm2pcm #(
   logic              [               17:0]     coeffs_fir          [0:13];
 
   logic              [FIFO_ADDR_WIDTH-1:0]     fifo_usage;
+  logic              [  FIFO_ADDR_WIDTH:0]     fifo_count;
 
   logic                                        pcm_data_valid;
 
   logic                                        rx_ready;
 
-  logic              [               17:0]     pcm;
+  logic              [ NUM_CHANNELS-1:0][17:0] pcm;
+
+  // Channels serializer related signals
+  logic              [ NUM_CHANNELS-1:0][17:0] pcm_frame;
+  logic              [                2:0]     channels;
+  logic              [                2:0]     push_ch;
+  logic                                        pushing;
+  logic                                        frame_fits;
 
   // FIFO/window related signals
   logic              [               31:0]     rx_data;
@@ -59,7 +79,10 @@ module pdm2pcm #(
 
   assign rx_data = ({{{32 - FIFO_WIDTH} {1'b0}}, rx_fifo});
 
-  assign hw2reg.status.reach.d  = ({{{32-FIFO_ADDR_WIDTH}{1'b0}},fifo_usage}) > {{26{1'b0}},reg2hw.reachcount.q};
+  // the usage of the FIFO wraps to 0 when it is full
+  assign fifo_count = full ? FIFO_DEPTH[FIFO_ADDR_WIDTH:0] : {1'b0, fifo_usage};
+
+  assign hw2reg.status.reach.d  = ({{{31-FIFO_ADDR_WIDTH}{1'b0}},fifo_count}) > {{26{1'b0}},reg2hw.reachcount.q};
   assign hw2reg.status.reach.de = 1;
   assign hw2reg.status.fulll.de = 1;
   assign hw2reg.status.empty.de = 1;
@@ -102,7 +125,9 @@ module pdm2pcm #(
           reg2hw.fircoef13.q
       };
 
-  pdm_core #() pdm_core_i (
+  pdm_core #(
+      .NUM_CHANNELS(NUM_CHANNELS)
+  ) pdm_core_i (
       .clk_i,
       .rstn_i(rst_ni),
       .en_i(reg2hw.control.enabl.q),
@@ -119,12 +144,44 @@ module pdm2pcm #(
       .pcm_data_valid_o(pcm_data_valid)
   );
 
-  assign push                  = pcm_data_valid & ~full;
+  // channels above the ones of the core are not pushed
+  assign channels = (reg2hw.control.channels.q > NUM_CHANNELS - 1) ?
+      3'(NUM_CHANNELS - 1) : reg2hw.control.channels.q;
+
+  // room in the FIFO for all the channels of a PCM output, the FIFO can only
+  // be popped while they are pushed
+  assign frame_fits = ({{{31-FIFO_ADDR_WIDTH}{1'b0}},fifo_count}) + {29'b0, channels} < FIFO_DEPTH;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_serializer
+    if (~rst_ni) begin
+      pcm_frame <= '0;
+      push_ch   <= '0;
+      pushing   <= 1'b0;
+    end else begin
+      if (reg2hw.control.clear.q) begin
+        pushing <= 1'b0;
+      end else if (pushing) begin
+        if (push_ch == channels) begin
+          pushing <= 1'b0;
+        end
+        push_ch <= push_ch + 1;
+      end else if (pcm_data_valid & frame_fits) begin
+        pcm_frame <= pcm;
+        push_ch   <= '0;
+        pushing   <= 1'b1;
+      end
+    end
+  end
+
+  assign push                  = pushing & ~full;
   assign pop                   = rx_ready & ~empty;
 
   assign hw2reg.status.fulll.d = full;
   assign hw2reg.status.empty.d = empty;
 
+  assign intr_pdm2pcm_event_o  = hw2reg.status.reach.d & reg2hw.control.intr_en.q;
+  assign pdm2pcm_rx_valid_o    = ~empty;
+
   fifo_v3 #(
       .DEPTH(FIFO_DEPTH),
       .DATA_WIDTH(FIFO_WIDTH)
@@ -136,7 +193,7 @@ module pdm2pcm #(
       .full_o(full),
       .empty_o(empty),
       .usage_o(fifo_usage),
-      .data_i(pcm),
+      .data_i(pcm_frame[push_ch]),
       .push_i(push),
       .data_o(rx_fifo),
       .pop_i(pop)
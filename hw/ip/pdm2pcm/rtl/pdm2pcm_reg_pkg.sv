@@ -18,6 +18,8 @@ package pdm2pcm_reg_pkg;
   typedef struct packed {
     struct packed {logic q;} enabl;
     struct packed {logic q;} clear;
+    struct packed {logic q;} intr_en;
+    struct packed {logic [2:0] q;} channels;
   } pdm2pcm_reg2hw_control_reg_t;
 
   typedef struct packed {
@@ -101,8 +103,8 @@ package pdm2pcm_reg_pkg;
 
   // Register -> HW type
   typedef struct packed {
-    pdm2pcm_reg2hw_clkdividx_reg_t clkdividx;  // [491:476]
-    pdm2pcm_reg2hw_control_reg_t control;  // [475:474]
+    pdm2pcm_reg2hw_clkdividx_reg_t clkdividx;  // [495:480]
+    pdm2pcm_reg2hw_control_reg_t control;  // [479:474]
     pdm2pcm_reg2hw_status_reg_t status;  // [473:471]
     pdm2pcm_reg2hw_reachcount_reg_t reachcount;  // [470:465]
     pdm2pcm_reg2hw_decimcic_reg_t decimcic;  // [464:461]
@@ -117,6 +117,12 @@ module pdm2pcm_reg_top #(
   logic control_clear_qs;
   logic control_clear_wd;
   logic control_clear_we;
+  logic control_intr_en_qs;
+  logic control_intr_en_wd;
+  logic control_intr_en_we;
+  logic [2:0] control_channels_qs;
+  logic [2:0] control_channels_wd;
+  logic control_channels_we;
   logic status_empty_qs;
   logic status_reach_qs;
   logic status_fulll_qs;
@@ -290,6 +296,58 @@ module pdm2pcm_reg_top #(
   );
 
 
+  //   F[intr_en]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_control_intr_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(control_intr_en_we),
+      .wd(control_intr_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.control.intr_en.q),
+
+      // to register interface (read)
+      .qs(control_intr_en_qs)
+  );
+
+
+  //   F[channels]: 5:3
+  prim_subreg #(
+      .DW      (3),
+      .SWACCESS("RW"),
+      .RESVAL  (3'h0)
+  ) u_control_channels (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(control_channels_we),
+      .wd(control_channels_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.control.channels.q),
+
+      // to register interface (read)
+      .qs(control_channels_qs)
+  );
+
+
   // R[status]: V(False)
 
   //   F[empty]: 0:0
@@ -1237,6 +1295,12 @@ module pdm2pcm_reg_top #(
   assign control_clear_we = addr_hit[1] & reg_we & !reg_error;
   assign control_clear_wd = reg_wdata[1];
 
+  assign control_intr_en_we = addr_hit[1] & reg_we & !reg_error;
+  assign control_intr_en_wd = reg_wdata[2];
+
+  assign control_channels_we = addr_hit[1] & reg_we & !reg_error;
+  assign control_channels_wd = reg_wdata[5:3];
+
   assign reachcount_we = addr_hit[3] & reg_we & !reg_error;
   assign reachcount_wd = reg_wdata[5:0];
 
@@ -1333,8 +1397,10 @@ module pdm2pcm_reg_top #(
       end
 
       addr_hit[1]: begin
-        reg_rdata_next[0] = control_enabl_qs;
-        reg_rdata_next[1] = control_clear_qs;
+        reg_rdata_next[0]   = control_enabl_qs;
+        reg_rdata_next[1]   = control_clear_qs;
+        reg_rdata_next[2]   = control_intr_en_qs;
+        reg_rdata_next[5:3] = control_channels_qs;
       end
 
       addr_hit[2]: begin
@@ -5,8 +5,14 @@
 // Author: Pierre Guillod <pierre.guillod@epfl.ch>, EPFL, STI-SEL
 // Date: 14.12.2022
 // Description: PDM to PCM converter core
+//              Each PDM line carries two channels, sampled before the rising
+//              and the falling edges of the PDM clock. The channels share the
+//              decimators and the coefficients, and have their own filters.
 
 module pdm_core #(
+    // Number of channels, 2 per PDM line (1 for a single mono line)
+    parameter NUM_CHANNELS = 1,
+    localparam NUM_LINES = (NUM_CHANNELS + 1) / 2,
     // Number of stages of the CIC filter
     localparam STAGES_CIC = 4,
     // Width of the datapath
@@ -57,27 +63,22 @@ module pdm_core #(
     // FIR filter coefficients array
     input logic [COEFFSWIDTH-1:0] coeffs_fir[0:COEFFS_FIR-1],
     // Input signal (PDM)
-    input logic pdm_i,
-    // Output signal (PCM)
-    output logic [WIDTH-1:0] pcm_o,
+    input logic [NUM_LINES-1:0] pdm_i,
+    // Output signal (PCM) of each channel
+    output logic [NUM_CHANNELS-1:0][WIDTH-1:0] pcm_o,
     // Valid output data flag
     output logic pcm_data_valid_o
 );
 
-  logic             r_store;
-  logic             r_send;
-  logic             r_data;
+  logic                 r_store;
+  logic                 r_send;
+  logic [NUM_LINES-1:0] r_data;
+  logic [NUM_LINES-1:0] r_data_fall;
 
   logic             div_clk;
   logic             div_clk_p;
   logic             div_clk_e;
 
-  // Auxiliary signals to link the filter blocks
-  logic [WIDTH-1:0] data;
-  logic [WIDTH-1:0] integr_to_comb;
-  logic [WIDTH-1:0] combs_to_hb1;
-  logic [WIDTH-1:0] hb1_to_hb2;
-  logic [WIDTH-1:0] hb2_to_fir;
 
   logic             r_en;
   logic             s_clr;
@@ -120,10 +121,11 @@ module pdm_core #(
 
   always_ff @(posedge div_clk or negedge rstn_i) begin : proc_r_store
     if (~rstn_i) begin
-      r_store   <= 1;
-      r_send    <= 0;
-      r_data    <= 0;
-      pdm_clk_o <= 0;
+      r_store     <= 1;
+      r_send      <= 0;
+      r_data      <= 0;
+      r_data_fall <= 0;
+      pdm_clk_o   <= 0;
     end else begin
       if (en_i) begin
         r_store <= ~r_store;
@@ -132,9 +134,10 @@ module pdm_core #(
           r_data    <= pdm_i;
           pdm_clk_o <= ~pdm_clk_o;
         end else begin
-          r_store   <= 1'b1;
-          r_send    <= 0;
-          pdm_clk_o <= 0;
+          r_data_fall <= pdm_i;
+          r_store     <= 1'b1;
+          r_send      <= 0;
+          pdm_clk_o   <= 0;
         end
       end
     end
@@ -147,30 +150,16 @@ module pdm_core #(
     else r_en <= en_i;
   end
 
-  assign pcm_o = combs_to_hb1;
-
   ///////////////////////////////////////////////////////////////////////////
   ////// END OF THE PIECE OF CODE I NEED TO MAKE EASIER TO UNDERSTAND ///////
   ///////////////////////////////////////////////////////////////////////////
 
-  // Converts binary PDM {0,1} to bipolar PDM {-1,1}
-  assign data  = r_data ? 'h1 : {WIDTH{1'b1}};
-
   // Instantiation sequence
   // ┌─────┐ ┌─────┐ ┌─────┐ ┌─────┐ ┌─────┐ ┌─────┐ ┌─────┐ ┌─────┐
   // │Intgs├─►Decim├─►Combs├─►Hlfbd├─►Decim├─►Hlfbd├─►Decim├─► FIR │
   // └─────┘ └─────┘ └─────┘ └─────┘ └─────┘ └─────┘ └─────┘ └─────┘
   // (made with asciiflow.com)
 
-  cic_integrators #(STAGES_CIC, WIDTH) cic_integrators_inst (
-      .clk_i (div_clk),
-      .rstn_i(rstn_i),
-      .clr_i (s_clr),
-      .en_i  (r_send),
-      .data_i(data),
-      .data_o(integr_to_comb)
-  );
-
   decimator #(DECIM_COMBS_CNT_W) decimator_before_hb1 (
       .clk_i(div_clk),
       .rst_i(rstn_i),
@@ -180,25 +169,6 @@ module pdm_core #(
       .en_o(combs_en)
   );
 
-  cic_combs #(STAGES_CIC, WIDTH) cic_combs_inst (
-      .clk_i (div_clk),
-      .rstn_i(rstn_i),
-      .clr_i (s_clr),
-      .en_i  (combs_en),
-      .data_i(integr_to_comb),
-      .data_o(combs_to_hb1)
-  );
-
-  halfband #(WIDTH, COEFFSWIDTH, STAGES_HB1) halfband_inst1 (
-      .clk_i(div_clk),
-      .rstn_i(rstn_i),
-      .clr_i(s_clr),
-      .en_i(combs_en),
-      .data_i(combs_to_hb1),
-      .data_o(hb1_to_hb2),
-      .freecoeffs(coeffs_hb1)
-  );
-
   decimator #(DECIM_HFBD1_CNT_W) decimator_before_hb2 (
       .clk_i(div_clk),
       .rst_i(rstn_i),
@@ -208,16 +178,6 @@ module pdm_core #(
       .en_o(hb2_en)
   );
 
-  halfband #(WIDTH, COEFFSWIDTH, STAGES_HB2) halfband_inst2 (
-      .clk_i(div_clk),
-      .rstn_i(rstn_i),
-      .clr_i(s_clr),
-      .en_i(hb2_en),
-      .data_i(hb1_to_hb2),
-      .data_o(hb2_to_fir),
-      .freecoeffs(coeffs_hb2)
-  );
-
   decimator #(DECIM_HFBD2_CNT_W) decimator_before_fir (
       .clk_i(div_clk),
       .rst_i(rstn_i),
@@ -227,15 +187,74 @@ module pdm_core #(
       .en_o(fir_en)
   );
 
-  fir #(WIDTH, COEFFSWIDTH, STAGES_FIR) fir_inst (
-      .clk_i(div_clk),
-      .rstn_i(rstn_i),
-      .clr_i(s_clr),
-      .en_i(fir_en),
-      .data_i(hb2_to_fir),
-      .data_o(),
-      .freecoeffs(coeffs_fir)
-  );
+  for (genvar c = 0; c < NUM_CHANNELS; c++) begin : gen_channel
+
+    // Auxiliary signals to link the filter blocks
+    logic [WIDTH-1:0] data;
+    logic [WIDTH-1:0] integr_to_comb;
+    logic [WIDTH-1:0] combs_to_hb1;
+    logic [WIDTH-1:0] hb1_to_hb2;
+    logic [WIDTH-1:0] hb2_to_fir;
+
+    // Even channels before the rising edge, odd ones before the falling edge
+    // Converts binary PDM {0,1} to bipolar PDM {-1,1}
+    if (c % 2 == 0) begin : gen_rise
+      assign data = r_data[c/2] ? 'h1 : {WIDTH{1'b1}};
+    end else begin : gen_fall
+      assign data = r_data_fall[c/2] ? 'h1 : {WIDTH{1'b1}};
+    end
+
+    assign pcm_o[c] = combs_to_hb1;
+
+    cic_integrators #(STAGES_CIC, WIDTH) cic_integrators_inst (
+        .clk_i (div_clk),
+        .rstn_i(rstn_i),
+        .clr_i (s_clr),
+        .en_i  (r_send),
+        .data_i(data),
+        .data_o(integr_to_comb)
+    );
+
+    cic_combs #(STAGES_CIC, WIDTH) cic_combs_inst (
+        .clk_i (div_clk),
+        .rstn_i(rstn_i),
+        .clr_i (s_clr),
+        .en_i  (combs_en),
+        .data_i(integr_to_comb),
+        .data_o(combs_to_hb1)
+    );
+
+    halfband #(WIDTH, COEFFSWIDTH, STAGES_HB1) halfband_inst1 (
+        .clk_i(div_clk),
+        .rstn_i(rstn_i),
+        .clr_i(s_clr),
+        .en_i(combs_en),
+        .data_i(combs_to_hb1),
+        .data_o(hb1_to_hb2),
+        .freecoeffs(coeffs_hb1)
+    );
+
+    halfband #(WIDTH, COEFFSWIDTH, STAGES_HB2) halfband_inst2 (
+        .clk_i(div_clk),
+        .rstn_i(rstn_i),
+        .clr_i(s_clr),
+        .en_i(hb2_en),
+        .data_i(hb1_to_hb2),
+        .data_o(hb2_to_fir),
+        .freecoeffs(coeffs_hb2)
+    );
+
+    fir #(WIDTH, COEFFSWIDTH, STAGES_FIR) fir_inst (
+        .clk_i(div_clk),
+        .rstn_i(rstn_i),
+        .clr_i(s_clr),
+        .en_i(fir_en),
+        .data_i(hb2_to_fir),
+        .data_o(),
+        .freecoeffs(coeffs_fir)
+    );
+
+  end
 
   //
   // Some of the finest debugging goodness
@@ -452,5 +452,170 @@
       ]
     }
 
+    { name:     "RESIDENCY_EN",
+      desc:     "Enables the residency counters",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hro",
+      fields: [
+        { bits: "0", name: "RESIDENCY_EN", desc: "Count the cycles spent in each power state" }
+      ]
+    }
+
+    { name:     "RESIDENCY_CLEAR",
+      desc:     "Clears the residency counters",
+      resval:   "0x00000000"
+      swaccess: "wo",
+      hwaccess: "hro",
+      hwqe:     "true",
+      fields: [
+        { bits: "0", name: "RESIDENCY_CLEAR", desc: "Writing 1 sets all the residency counters to 0" }
+      ]
+    }
+
+    { name:     "CPU_ACTIVE_CYCLES",
+      desc:     "Cycles spent by the CPU domain running",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "CPU_ACTIVE_CYCLES", desc: "Cycles running" }
+      ]
+    }
+
+    { name:     "CPU_CLK_GATE_CYCLES",
+      desc:     "Cycles spent by the CPU domain sleeping with its clock gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "CPU_CLK_GATE_CYCLES", desc: "Cycles sleeping with its clock gated" }
+      ]
+    }
+
+    { name:     "CPU_POWER_GATE_CYCLES",
+      desc:     "Cycles spent by the CPU domain power-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "CPU_POWER_GATE_CYCLES", desc: "Cycles power-gated" }
+      ]
+    }
+
+    { name:     "PERIPH_ACTIVE_CYCLES",
+      desc:     "Cycles spent by the PERIPH domain clocked",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "PERIPH_ACTIVE_CYCLES", desc: "Cycles clocked" }
+      ]
+    }
+
+    { name:     "PERIPH_CLK_GATE_CYCLES",
+      desc:     "Cycles spent by the PERIPH domain clock-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "PERIPH_CLK_GATE_CYCLES", desc: "Cycles clock-gated" }
+      ]
+    }
+
+    { name:     "PERIPH_POWER_GATE_CYCLES",
+      desc:     "Cycles spent by the PERIPH domain power-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "PERIPH_POWER_GATE_CYCLES", desc: "Cycles power-gated" }
+      ]
+    }
+
+% for bank in range(ram_numbanks):
+    { name:     "RAM_${bank}_ACTIVE_CYCLES",
+      desc:     "Cycles spent by the RAM_${bank} domain clocked",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "RAM_${bank}_ACTIVE_CYCLES", desc: "Cycles clocked" }
+      ]
+    }
+
+    { name:     "RAM_${bank}_CLK_GATE_CYCLES",
+      desc:     "Cycles spent by the RAM_${bank} domain clock-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "RAM_${bank}_CLK_GATE_CYCLES", desc: "Cycles clock-gated" }
+      ]
+    }
+
+    { name:     "RAM_${bank}_POWER_GATE_CYCLES",
+      desc:     "Cycles spent by the RAM_${bank} domain power-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "RAM_${bank}_POWER_GATE_CYCLES", desc: "Cycles power-gated" }
+      ]
+    }
+
+    { name:     "RAM_${bank}_RETENTIVE_CYCLES",
+      desc:     "Cycles spent by the RAM_${bank} domain in retentive mode",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "RAM_${bank}_RETENTIVE_CYCLES", desc: "Cycles in retentive mode" }
+      ]
+    }
+
+% endfor
+% for ext in range(external_domains):
+    { name:     "EXTERNAL_${ext}_ACTIVE_CYCLES",
+      desc:     "Cycles spent by the EXTERNAL_${ext} domain clocked",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "EXTERNAL_${ext}_ACTIVE_CYCLES", desc: "Cycles clocked" }
+      ]
+    }
+
+    { name:     "EXTERNAL_${ext}_CLK_GATE_CYCLES",
+      desc:     "Cycles spent by the EXTERNAL_${ext} domain clock-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "EXTERNAL_${ext}_CLK_GATE_CYCLES", desc: "Cycles clock-gated" }
+      ]
+    }
+
+    { name:     "EXTERNAL_${ext}_POWER_GATE_CYCLES",
+      desc:     "Cycles spent by the EXTERNAL_${ext} domain power-gated",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "EXTERNAL_${ext}_POWER_GATE_CYCLES", desc: "Cycles power-gated" }
+      ]
+    }
+
+    { name:     "EXTERNAL_${ext}_RETENTIVE_CYCLES",
+      desc:     "Cycles spent by the EXTERNAL_${ext} domain with its RAM in retentive mode",
+      resval:   "0x00000000"
+      swaccess: "ro",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "31:0", name: "EXTERNAL_${ext}_RETENTIVE_CYCLES", desc: "Cycles with its RAM in retentive mode" }
+      ]
+    }
+
+% endfor
    ]
 }
@@ -599,4 +599,184 @@ module power_manager #(
 
 % endfor
 
+  // --------------------------------------------------------------------------------------
+  // RESIDENCY
+  // --------------------------------------------------------------------------------------
+
+  // each domain is in exactly one state at a time: power-gated when its switch is off,
+  // then retentive, clock-gated or active
+  logic residency_en, residency_clear;
+  assign residency_en = reg2hw.residency_en.q;
+  assign residency_clear = reg2hw.residency_clear.qe & reg2hw.residency_clear.q;
+
+  logic cpu_on, periph_on;
+  assign cpu_on = cpu_subsystem_powergate_switch_n == SWITCH_IDLE_VALUE;
+  assign periph_on = peripheral_subsystem_powergate_switch_n == SWITCH_IDLE_VALUE;
+
+  residency_counter residency_counter_cpu_active_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(cpu_on & ~core_sleep_i),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.cpu_active_cycles.d),
+      .hw2reg_de_o(hw2reg.cpu_active_cycles.de),
+      .hw2reg_q_i(reg2hw.cpu_active_cycles.q)
+  );
+
+  residency_counter residency_counter_cpu_clk_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(cpu_on & core_sleep_i),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.cpu_clk_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.cpu_clk_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.cpu_clk_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_cpu_power_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(~cpu_on),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.cpu_power_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.cpu_power_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.cpu_power_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_periph_active_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(periph_on & ~reg2hw.periph_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.periph_active_cycles.d),
+      .hw2reg_de_o(hw2reg.periph_active_cycles.de),
+      .hw2reg_q_i(reg2hw.periph_active_cycles.q)
+  );
+
+  residency_counter residency_counter_periph_clk_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(periph_on & reg2hw.periph_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.periph_clk_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.periph_clk_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.periph_clk_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_periph_power_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(~periph_on),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.periph_power_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.periph_power_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.periph_power_gate_cycles.q)
+  );
+
+% for bank in range(ram_numbanks):
+  logic ram_${bank}_on, ram_${bank}_retentive;
+  assign ram_${bank}_on = memory_subsystem_banks_powergate_switch_n[${bank}] == SWITCH_IDLE_VALUE;
+  assign ram_${bank}_retentive = memory_subsystem_banks_set_retentive_no[${bank}] != ISO_IDLE_VALUE;
+
+  residency_counter residency_counter_ram_${bank}_active_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(ram_${bank}_on & ~ram_${bank}_retentive & ~reg2hw.ram_${bank}_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.ram_${bank}_active_cycles.d),
+      .hw2reg_de_o(hw2reg.ram_${bank}_active_cycles.de),
+      .hw2reg_q_i(reg2hw.ram_${bank}_active_cycles.q)
+  );
+
+  residency_counter residency_counter_ram_${bank}_clk_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(ram_${bank}_on & ~ram_${bank}_retentive & reg2hw.ram_${bank}_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.ram_${bank}_clk_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.ram_${bank}_clk_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.ram_${bank}_clk_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_ram_${bank}_power_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(~ram_${bank}_on),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.ram_${bank}_power_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.ram_${bank}_power_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.ram_${bank}_power_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_ram_${bank}_retentive_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(ram_${bank}_on & ram_${bank}_retentive),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.ram_${bank}_retentive_cycles.d),
+      .hw2reg_de_o(hw2reg.ram_${bank}_retentive_cycles.de),
+      .hw2reg_q_i(reg2hw.ram_${bank}_retentive_cycles.q)
+  );
+
+% endfor
+% for ext in range(external_domains):
+  logic external_${ext}_on, external_${ext}_retentive;
+  assign external_${ext}_on = external_subsystem_powergate_switch_n[${ext}] == SWITCH_IDLE_VALUE;
+  assign external_${ext}_retentive = external_ram_banks_set_retentive_no[${ext}] != ISO_IDLE_VALUE;
+
+  residency_counter residency_counter_external_${ext}_active_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(external_${ext}_on & ~external_${ext}_retentive & ~reg2hw.external_${ext}_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.external_${ext}_active_cycles.d),
+      .hw2reg_de_o(hw2reg.external_${ext}_active_cycles.de),
+      .hw2reg_q_i(reg2hw.external_${ext}_active_cycles.q)
+  );
+
+  residency_counter residency_counter_external_${ext}_clk_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(external_${ext}_on & ~external_${ext}_retentive & reg2hw.external_${ext}_clk_gate.q),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.external_${ext}_clk_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.external_${ext}_clk_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.external_${ext}_clk_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_external_${ext}_power_gate_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(~external_${ext}_on),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.external_${ext}_power_gate_cycles.d),
+      .hw2reg_de_o(hw2reg.external_${ext}_power_gate_cycles.de),
+      .hw2reg_q_i(reg2hw.external_${ext}_power_gate_cycles.q)
+  );
+
+  residency_counter residency_counter_external_${ext}_retentive_i (
+      .clk_i,
+      .rst_ni,
+      .en_i(residency_en),
+      .in_state_i(external_${ext}_on & external_${ext}_retentive),
+      .clear_i(residency_clear),
+      .hw2reg_d_o(hw2reg.external_${ext}_retentive_cycles.d),
+      .hw2reg_de_o(hw2reg.external_${ext}_retentive_cycles.de),
+      .hw2reg_q_i(reg2hw.external_${ext}_retentive_cycles.q)
+  );
+
+% endfor
 endmodule : power_manager
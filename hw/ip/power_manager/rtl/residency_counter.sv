@@ -0,0 +1,43 @@
+// Copyright 2022 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+/*
+  this module counts the cycles spent in a power state in a OpenTitan RegTool made register
+  It uses the hw2reg d and de signals generated by regtool, the count wraps around
+*/
+
+module residency_counter #(
+    parameter int DW = 32
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // count the cycles while en_i and in_state_i are high
+    input logic en_i,
+    input logic in_state_i,
+    // set the count to 0, has priority over counting
+    input logic clear_i,
+
+    output logic [DW-1:0] hw2reg_d_o,
+    output logic hw2reg_de_o,
+
+    input logic [DW-1:0] hw2reg_q_i
+);
+
+  logic in_state_q;
+
+  // the state signals cross the domain boundaries, they are sampled once to
+  // keep them off the register write path
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      in_state_q <= 1'b0;
+    end else begin
+      in_state_q <= in_state_i;
+    end
+  end
+
+  assign hw2reg_d_o  = clear_i ? '0 : hw2reg_q_i + 1;
+  assign hw2reg_de_o = clear_i | (en_i & in_state_q);
+
+endmodule : residency_counter
@@ -20,7 +20,26 @@ module soc_ctrl #(
     output logic use_spimemio_o,
 
     output logic        exit_valid_o,
-    output logic [31:0] exit_value_o
+    output logic [31:0] exit_value_o,
+
+    // Instruction cache
+    output logic icache_enable_o,
+    output logic icache_prefetch_o,
+    output logic icache_flush_o,
+    input  logic icache_hit_i,
+    input  logic icache_miss_i,
+
+    // Data cache
+    output logic dcache_enable_o,
+    output logic dcache_clean_o,
+    output logic dcache_invalidate_o,
+    input  logic dcache_busy_i,
+    input  logic dcache_hit_i,
+    input  logic dcache_miss_i,
+
+    // System bus
+    output logic       bus_cpu_prio_o,
+    output logic [7:0] bus_dma_throttle_o
 );
 
   import soc_ctrl_reg_pkg::*;
@@ -53,6 +72,18 @@ module soc_ctrl #(
   assign hw2reg.use_spimemio.de = ~enable_spi_sel;
   assign hw2reg.use_spimemio.d  = execute_from_flash_i;
 
+  assign hw2reg.icache_hits.d = reg2hw.icache_hits.q + 32'd1;
+  assign hw2reg.icache_hits.de = icache_hit_i;
+  assign hw2reg.icache_misses.d = reg2hw.icache_misses.q + 32'd1;
+  assign hw2reg.icache_misses.de = icache_miss_i;
+
+  assign hw2reg.dcache_ctrl.busy.d = dcache_busy_i;
+  assign hw2reg.dcache_ctrl.busy.de = 1'b1;
+  assign hw2reg.dcache_hits.d = reg2hw.dcache_hits.q + 32'd1;
+  assign hw2reg.dcache_hits.de = dcache_hit_i;
+  assign hw2reg.dcache_misses.d = reg2hw.dcache_misses.q + 32'd1;
+  assign hw2reg.dcache_misses.de = dcache_miss_i;
+
   soc_ctrl_reg_top #(
       .reg_req_t(reg_req_t),
       .reg_rsp_t(reg_rsp_t)
@@ -71,4 +102,15 @@ module soc_ctrl #(
   assign use_spimemio_o = reg2hw.use_spimemio.q;
   assign enable_spi_sel = reg2hw.enable_spi_sel.q;
 
+  assign icache_enable_o = reg2hw.icache_ctrl.enable.q;
+  assign icache_prefetch_o = reg2hw.icache_ctrl.prefetch.q;
+  assign icache_flush_o = reg2hw.icache_flush.qe & reg2hw.icache_flush.q;
+
+  assign dcache_enable_o = reg2hw.dcache_ctrl.enable.q;
+  assign dcache_clean_o = reg2hw.dcache_maint.clean.qe & reg2hw.dcache_maint.clean.q;
+  assign dcache_invalidate_o = reg2hw.dcache_maint.invalidate.qe & reg2hw.dcache_maint.invalidate.q;
+
+  assign bus_cpu_prio_o = reg2hw.bus_qos.cpu_prio.q;
+  assign bus_dma_throttle_o = reg2hw.bus_qos.dma_throttle.q;
+
 endmodule : soc_ctrl
@@ -6,8 +6,11 @@
 
 package soc_ctrl_reg_pkg;
 
+  // Param list
+  parameter int WarmBootMagic = 1463898701;
+
   // Address widths within the block
-  parameter int BlockAw = 5;
+  parameter int BlockAw = 7;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -27,6 +30,42 @@ package soc_ctrl_reg_pkg;
 
   typedef struct packed {logic q;} soc_ctrl_reg2hw_enable_spi_sel_reg_t;
 
+  typedef struct packed {
+    struct packed {logic q;} enable;
+    struct packed {logic q;} prefetch;
+  } soc_ctrl_reg2hw_icache_ctrl_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic qe;
+  } soc_ctrl_reg2hw_icache_flush_reg_t;
+
+  typedef struct packed {logic [31:0] q;} soc_ctrl_reg2hw_icache_hits_reg_t;
+
+  typedef struct packed {logic [31:0] q;} soc_ctrl_reg2hw_icache_misses_reg_t;
+
+  typedef struct packed {struct packed {logic q;} enable;} soc_ctrl_reg2hw_dcache_ctrl_reg_t;
+
+  typedef struct packed {
+    struct packed {
+      logic q;
+      logic qe;
+    } clean;
+    struct packed {
+      logic q;
+      logic qe;
+    } invalidate;
+  } soc_ctrl_reg2hw_dcache_maint_reg_t;
+
+  typedef struct packed {logic [31:0] q;} soc_ctrl_reg2hw_dcache_hits_reg_t;
+
+  typedef struct packed {logic [31:0] q;} soc_ctrl_reg2hw_dcache_misses_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} cpu_prio;
+    struct packed {logic [7:0] q;} dma_throttle;
+  } soc_ctrl_reg2hw_bus_qos_reg_t;
+
   typedef struct packed {
     logic d;
     logic de;
@@ -42,33 +81,87 @@ package soc_ctrl_reg_pkg;
     logic de;
   } soc_ctrl_hw2reg_use_spimemio_reg_t;
 
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } soc_ctrl_hw2reg_icache_hits_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } soc_ctrl_hw2reg_icache_misses_reg_t;
+
+  typedef struct packed {
+    struct packed {
+      logic d;
+      logic de;
+    } busy;
+  } soc_ctrl_hw2reg_dcache_ctrl_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } soc_ctrl_hw2reg_dcache_hits_reg_t;
+
+  typedef struct packed {
+    logic [31:0] d;
+    logic        de;
+  } soc_ctrl_hw2reg_dcache_misses_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    soc_ctrl_reg2hw_exit_valid_reg_t exit_valid;  // [68:68]
-    soc_ctrl_reg2hw_exit_value_reg_t exit_value;  // [67:36]
-    soc_ctrl_reg2hw_boot_select_reg_t boot_select;  // [35:35]
-    soc_ctrl_reg2hw_boot_exit_loop_reg_t boot_exit_loop;  // [34:34]
-    soc_ctrl_reg2hw_boot_address_reg_t boot_address;  // [33:2]
-    soc_ctrl_reg2hw_use_spimemio_reg_t use_spimemio;  // [1:1]
-    soc_ctrl_reg2hw_enable_spi_sel_reg_t enable_spi_sel;  // [0:0]
+    soc_ctrl_reg2hw_exit_valid_reg_t exit_valid;  // [214:214]
+    soc_ctrl_reg2hw_exit_value_reg_t exit_value;  // [213:182]
+    soc_ctrl_reg2hw_boot_select_reg_t boot_select;  // [181:181]
+    soc_ctrl_reg2hw_boot_exit_loop_reg_t boot_exit_loop;  // [180:180]
+    soc_ctrl_reg2hw_boot_address_reg_t boot_address;  // [179:148]
+    soc_ctrl_reg2hw_use_spimemio_reg_t use_spimemio;  // [147:147]
+    soc_ctrl_reg2hw_enable_spi_sel_reg_t enable_spi_sel;  // [146:146]
+    soc_ctrl_reg2hw_icache_ctrl_reg_t icache_ctrl;  // [145:144]
+    soc_ctrl_reg2hw_icache_flush_reg_t icache_flush;  // [143:142]
+    soc_ctrl_reg2hw_icache_hits_reg_t icache_hits;  // [141:110]
+    soc_ctrl_reg2hw_icache_misses_reg_t icache_misses;  // [109:78]
+    soc_ctrl_reg2hw_dcache_ctrl_reg_t dcache_ctrl;  // [77:77]
+    soc_ctrl_reg2hw_dcache_maint_reg_t dcache_maint;  // [76:73]
+    soc_ctrl_reg2hw_dcache_hits_reg_t dcache_hits;  // [72:41]
+    soc_ctrl_reg2hw_dcache_misses_reg_t dcache_misses;  // [40:9]
+    soc_ctrl_reg2hw_bus_qos_reg_t bus_qos;  // [8:0]
   } soc_ctrl_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    soc_ctrl_hw2reg_boot_select_reg_t boot_select;  // [5:4]
-    soc_ctrl_hw2reg_boot_exit_loop_reg_t boot_exit_loop;  // [3:2]
-    soc_ctrl_hw2reg_use_spimemio_reg_t use_spimemio;  // [1:0]
+    soc_ctrl_hw2reg_boot_select_reg_t boot_select;  // [139:138]
+    soc_ctrl_hw2reg_boot_exit_loop_reg_t boot_exit_loop;  // [137:136]
+    soc_ctrl_hw2reg_use_spimemio_reg_t use_spimemio;  // [135:134]
+    soc_ctrl_hw2reg_icache_hits_reg_t icache_hits;  // [133:101]
+    soc_ctrl_hw2reg_icache_misses_reg_t icache_misses;  // [100:68]
+    soc_ctrl_hw2reg_dcache_ctrl_reg_t dcache_ctrl;  // [67:66]
+    soc_ctrl_hw2reg_dcache_hits_reg_t dcache_hits;  // [65:33]
+    soc_ctrl_hw2reg_dcache_misses_reg_t dcache_misses;  // [32:0]
   } soc_ctrl_hw2reg_t;
 
   // Register offsets
-  parameter logic [BlockAw-1:0] SOC_CTRL_EXIT_VALID_OFFSET = 5'h0;
-  parameter logic [BlockAw-1:0] SOC_CTRL_EXIT_VALUE_OFFSET = 5'h4;
-  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_SELECT_OFFSET = 5'h8;
-  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_EXIT_LOOP_OFFSET = 5'hc;
-  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_ADDRESS_OFFSET = 5'h10;
-  parameter logic [BlockAw-1:0] SOC_CTRL_USE_SPIMEMIO_OFFSET = 5'h14;
-  parameter logic [BlockAw-1:0] SOC_CTRL_ENABLE_SPI_SEL_OFFSET = 5'h18;
-  parameter logic [BlockAw-1:0] SOC_CTRL_SYSTEM_FREQUENCY_HZ_OFFSET = 5'h1c;
+  parameter logic [BlockAw-1:0] SOC_CTRL_EXIT_VALID_OFFSET = 7'h0;
+  parameter logic [BlockAw-1:0] SOC_CTRL_EXIT_VALUE_OFFSET = 7'h4;
+  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_SELECT_OFFSET = 7'h8;
+  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_EXIT_LOOP_OFFSET = 7'hc;
+  parameter logic [BlockAw-1:0] SOC_CTRL_BOOT_ADDRESS_OFFSET = 7'h10;
+  parameter logic [BlockAw-1:0] SOC_CTRL_USE_SPIMEMIO_OFFSET = 7'h14;
+  parameter logic [BlockAw-1:0] SOC_CTRL_ENABLE_SPI_SEL_OFFSET = 7'h18;
+  parameter logic [BlockAw-1:0] SOC_CTRL_SYSTEM_FREQUENCY_HZ_OFFSET = 7'h1c;
+  parameter logic [BlockAw-1:0] SOC_CTRL_ICACHE_CTRL_OFFSET = 7'h20;
+  parameter logic [BlockAw-1:0] SOC_CTRL_ICACHE_FLUSH_OFFSET = 7'h24;
+  parameter logic [BlockAw-1:0] SOC_CTRL_ICACHE_HITS_OFFSET = 7'h28;
+  parameter logic [BlockAw-1:0] SOC_CTRL_ICACHE_MISSES_OFFSET = 7'h2c;
+  parameter logic [BlockAw-1:0] SOC_CTRL_DCACHE_CTRL_OFFSET = 7'h30;
+  parameter logic [BlockAw-1:0] SOC_CTRL_DCACHE_MAINT_OFFSET = 7'h34;
+  parameter logic [BlockAw-1:0] SOC_CTRL_DCACHE_HITS_OFFSET = 7'h38;
+  parameter logic [BlockAw-1:0] SOC_CTRL_DCACHE_MISSES_OFFSET = 7'h3c;
+  parameter logic [BlockAw-1:0] SOC_CTRL_WARM_BOOT_MAGIC_OFFSET = 7'h40;
+  parameter logic [BlockAw-1:0] SOC_CTRL_WARM_BOOT_ENTRY_OFFSET = 7'h44;
+  parameter logic [BlockAw-1:0] SOC_CTRL_WARM_BOOT_SIZE_OFFSET = 7'h48;
+  parameter logic [BlockAw-1:0] SOC_CTRL_WARM_BOOT_CHECKSUM_OFFSET = 7'h4c;
+  parameter logic [BlockAw-1:0] SOC_CTRL_BUS_QOS_OFFSET = 7'h50;
 
   // Register index
   typedef enum int {
@@ -79,11 +172,24 @@ package soc_ctrl_reg_pkg;
     SOC_CTRL_BOOT_ADDRESS,
     SOC_CTRL_USE_SPIMEMIO,
     SOC_CTRL_ENABLE_SPI_SEL,
-    SOC_CTRL_SYSTEM_FREQUENCY_HZ
+    SOC_CTRL_SYSTEM_FREQUENCY_HZ,
+    SOC_CTRL_ICACHE_CTRL,
+    SOC_CTRL_ICACHE_FLUSH,
+    SOC_CTRL_ICACHE_HITS,
+    SOC_CTRL_ICACHE_MISSES,
+    SOC_CTRL_DCACHE_CTRL,
+    SOC_CTRL_DCACHE_MAINT,
+    SOC_CTRL_DCACHE_HITS,
+    SOC_CTRL_DCACHE_MISSES,
+    SOC_CTRL_WARM_BOOT_MAGIC,
+    SOC_CTRL_WARM_BOOT_ENTRY,
+    SOC_CTRL_WARM_BOOT_SIZE,
+    SOC_CTRL_WARM_BOOT_CHECKSUM,
+    SOC_CTRL_BUS_QOS
   } soc_ctrl_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] SOC_CTRL_PERMIT[8] = '{
+  parameter logic [3:0] SOC_CTRL_PERMIT[21] = '{
       4'b0001,  // index[0] SOC_CTRL_EXIT_VALID
       4'b1111,  // index[1] SOC_CTRL_EXIT_VALUE
       4'b0001,  // index[2] SOC_CTRL_BOOT_SELECT
@@ -91,7 +197,20 @@ package soc_ctrl_reg_pkg;
       4'b1111,  // index[4] SOC_CTRL_BOOT_ADDRESS
       4'b0001,  // index[5] SOC_CTRL_USE_SPIMEMIO
       4'b0001,  // index[6] SOC_CTRL_ENABLE_SPI_SEL
-      4'b1111  // index[7] SOC_CTRL_SYSTEM_FREQUENCY_HZ
+      4'b1111,  // index[7] SOC_CTRL_SYSTEM_FREQUENCY_HZ
+      4'b0001,  // index[8] SOC_CTRL_ICACHE_CTRL
+      4'b0001,  // index[9] SOC_CTRL_ICACHE_FLUSH
+      4'b1111,  // index[10] SOC_CTRL_ICACHE_HITS
+      4'b1111,  // index[11] SOC_CTRL_ICACHE_MISSES
+      4'b0001,  // index[12] SOC_CTRL_DCACHE_CTRL
+      4'b0001,  // index[13] SOC_CTRL_DCACHE_MAINT
+      4'b1111,  // index[14] SOC_CTRL_DCACHE_HITS
+      4'b1111,  // index[15] SOC_CTRL_DCACHE_MISSES
+      4'b1111,  // index[16] SOC_CTRL_WARM_BOOT_MAGIC
+      4'b1111,  // index[17] SOC_CTRL_WARM_BOOT_ENTRY
+      4'b1111,  // index[18] SOC_CTRL_WARM_BOOT_SIZE
+      4'b1111,  // index[19] SOC_CTRL_WARM_BOOT_CHECKSUM
+      4'b0011  // index[20] SOC_CTRL_BUS_QOS
   };
 
 endpackage
@@ -10,7 +10,7 @@
 module soc_ctrl_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 5
+    parameter int AW = 7
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -90,6 +90,52 @@ module soc_ctrl_reg_top #(
   logic [31:0] system_frequency_hz_qs;
   logic [31:0] system_frequency_hz_wd;
   logic system_frequency_hz_we;
+  logic icache_ctrl_enable_qs;
+  logic icache_ctrl_enable_wd;
+  logic icache_ctrl_enable_we;
+  logic icache_ctrl_prefetch_qs;
+  logic icache_ctrl_prefetch_wd;
+  logic icache_ctrl_prefetch_we;
+  logic icache_flush_wd;
+  logic icache_flush_we;
+  logic [31:0] icache_hits_qs;
+  logic [31:0] icache_hits_wd;
+  logic icache_hits_we;
+  logic [31:0] icache_misses_qs;
+  logic [31:0] icache_misses_wd;
+  logic icache_misses_we;
+  logic dcache_ctrl_enable_qs;
+  logic dcache_ctrl_enable_wd;
+  logic dcache_ctrl_enable_we;
+  logic dcache_ctrl_busy_qs;
+  logic dcache_maint_clean_wd;
+  logic dcache_maint_clean_we;
+  logic dcache_maint_invalidate_wd;
+  logic dcache_maint_invalidate_we;
+  logic [31:0] dcache_hits_qs;
+  logic [31:0] dcache_hits_wd;
+  logic dcache_hits_we;
+  logic [31:0] dcache_misses_qs;
+  logic [31:0] dcache_misses_wd;
+  logic dcache_misses_we;
+  logic [31:0] warm_boot_magic_qs;
+  logic [31:0] warm_boot_magic_wd;
+  logic warm_boot_magic_we;
+  logic [31:0] warm_boot_entry_qs;
+  logic [31:0] warm_boot_entry_wd;
+  logic warm_boot_entry_we;
+  logic [31:0] warm_boot_size_qs;
+  logic [31:0] warm_boot_size_wd;
+  logic warm_boot_size_we;
+  logic [31:0] warm_boot_checksum_qs;
+  logic [31:0] warm_boot_checksum_wd;
+  logic warm_boot_checksum_we;
+  logic bus_qos_cpu_prio_qs;
+  logic bus_qos_cpu_prio_wd;
+  logic bus_qos_cpu_prio_we;
+  logic [7:0] bus_qos_dma_throttle_qs;
+  logic [7:0] bus_qos_dma_throttle_wd;
+  logic bus_qos_dma_throttle_we;
 
   // Register instances
   // R[exit_valid]: V(False)
@@ -307,9 +353,464 @@ module soc_ctrl_reg_top #(
   );
 
 
+  // R[icache_ctrl]: V(False)
+
+  //   F[enable]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_icache_ctrl_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(icache_ctrl_enable_we),
+      .wd(icache_ctrl_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.icache_ctrl.enable.q),
+
+      // to register interface (read)
+      .qs(icache_ctrl_enable_qs)
+  );
+
+
+  //   F[prefetch]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_icache_ctrl_prefetch (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(icache_ctrl_prefetch_we),
+      .wd(icache_ctrl_prefetch_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.icache_ctrl.prefetch.q),
+
+      // to register interface (read)
+      .qs(icache_ctrl_prefetch_qs)
+  );
+
+
+  // R[icache_flush]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_icache_flush (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(icache_flush_we),
+      .wd(icache_flush_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.icache_flush.qe),
+      .q (reg2hw.icache_flush.q),
+
+      .qs()
+  );
+
+
+  // R[icache_hits]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_icache_hits (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(icache_hits_we),
+      .wd(icache_hits_wd),
+
+      // from internal hardware
+      .de(hw2reg.icache_hits.de),
+      .d (hw2reg.icache_hits.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.icache_hits.q),
+
+      // to register interface (read)
+      .qs(icache_hits_qs)
+  );
+
+
+  // R[icache_misses]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_icache_misses (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(icache_misses_we),
+      .wd(icache_misses_wd),
+
+      // from internal hardware
+      .de(hw2reg.icache_misses.de),
+      .d (hw2reg.icache_misses.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.icache_misses.q),
+
+      // to register interface (read)
+      .qs(icache_misses_qs)
+  );
+
+
+  // R[dcache_ctrl]: V(False)
+
+  //   F[enable]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_dcache_ctrl_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dcache_ctrl_enable_we),
+      .wd(dcache_ctrl_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dcache_ctrl.enable.q),
+
+      // to register interface (read)
+      .qs(dcache_ctrl_enable_qs)
+  );
+
+
+  //   F[busy]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RO"),
+      .RESVAL  (1'h0)
+  ) u_dcache_ctrl_busy (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      .we(1'b0),
+      .wd('0),
+
+      // from internal hardware
+      .de(hw2reg.dcache_ctrl.busy.de),
+      .d (hw2reg.dcache_ctrl.busy.d),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(dcache_ctrl_busy_qs)
+  );
+
+
+  // R[dcache_maint]: V(False)
+
+  //   F[clean]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_dcache_maint_clean (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dcache_maint_clean_we),
+      .wd(dcache_maint_clean_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.dcache_maint.clean.qe),
+      .q (reg2hw.dcache_maint.clean.q),
+
+      .qs()
+  );
+
+
+  //   F[invalidate]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_dcache_maint_invalidate (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dcache_maint_invalidate_we),
+      .wd(dcache_maint_invalidate_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.dcache_maint.invalidate.qe),
+      .q (reg2hw.dcache_maint.invalidate.q),
+
+      .qs()
+  );
+
+
+  // R[dcache_hits]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dcache_hits (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dcache_hits_we),
+      .wd(dcache_hits_wd),
+
+      // from internal hardware
+      .de(hw2reg.dcache_hits.de),
+      .d (hw2reg.dcache_hits.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dcache_hits.q),
+
+      // to register interface (read)
+      .qs(dcache_hits_qs)
+  );
 
 
-  logic [7:0] addr_hit;
+  // R[dcache_misses]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_dcache_misses (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dcache_misses_we),
+      .wd(dcache_misses_wd),
+
+      // from internal hardware
+      .de(hw2reg.dcache_misses.de),
+      .d (hw2reg.dcache_misses.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dcache_misses.q),
+
+      // to register interface (read)
+      .qs(dcache_misses_qs)
+  );
+
+
+
+  // R[warm_boot_magic]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_warm_boot_magic (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(warm_boot_magic_we),
+      .wd(warm_boot_magic_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(warm_boot_magic_qs)
+  );
+
+
+  // R[warm_boot_entry]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_warm_boot_entry (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(warm_boot_entry_we),
+      .wd(warm_boot_entry_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(warm_boot_entry_qs)
+  );
+
+
+  // R[warm_boot_size]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_warm_boot_size (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(warm_boot_size_we),
+      .wd(warm_boot_size_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(warm_boot_size_qs)
+  );
+
+
+  // R[warm_boot_checksum]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_warm_boot_checksum (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(warm_boot_checksum_we),
+      .wd(warm_boot_checksum_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (),
+
+      // to register interface (read)
+      .qs(warm_boot_checksum_qs)
+  );
+
+
+  // R[bus_qos]: V(False)
+
+  //   F[cpu_prio]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_bus_qos_cpu_prio (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_cpu_prio_we),
+      .wd(bus_qos_cpu_prio_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.cpu_prio.q),
+
+      // to register interface (read)
+      .qs(bus_qos_cpu_prio_qs)
+  );
+
+
+  //   F[dma_throttle]: 15:8
+  prim_subreg #(
+      .DW      (8),
+      .SWACCESS("RW"),
+      .RESVAL  (8'h0)
+  ) u_bus_qos_dma_throttle (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_dma_throttle_we),
+      .wd(bus_qos_dma_throttle_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.dma_throttle.q),
+
+      // to register interface (read)
+      .qs(bus_qos_dma_throttle_qs)
+  );
+
+
+
+  logic [20:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == SOC_CTRL_EXIT_VALID_OFFSET);
@@ -320,6 +821,19 @@ module soc_ctrl_reg_top #(
     addr_hit[5] = (reg_addr == SOC_CTRL_USE_SPIMEMIO_OFFSET);
     addr_hit[6] = (reg_addr == SOC_CTRL_ENABLE_SPI_SEL_OFFSET);
     addr_hit[7] = (reg_addr == SOC_CTRL_SYSTEM_FREQUENCY_HZ_OFFSET);
+    addr_hit[8] = (reg_addr == SOC_CTRL_ICACHE_CTRL_OFFSET);
+    addr_hit[9] = (reg_addr == SOC_CTRL_ICACHE_FLUSH_OFFSET);
+    addr_hit[10] = (reg_addr == SOC_CTRL_ICACHE_HITS_OFFSET);
+    addr_hit[11] = (reg_addr == SOC_CTRL_ICACHE_MISSES_OFFSET);
+    addr_hit[12] = (reg_addr == SOC_CTRL_DCACHE_CTRL_OFFSET);
+    addr_hit[13] = (reg_addr == SOC_CTRL_DCACHE_MAINT_OFFSET);
+    addr_hit[14] = (reg_addr == SOC_CTRL_DCACHE_HITS_OFFSET);
+    addr_hit[15] = (reg_addr == SOC_CTRL_DCACHE_MISSES_OFFSET);
+    addr_hit[16] = (reg_addr == SOC_CTRL_WARM_BOOT_MAGIC_OFFSET);
+    addr_hit[17] = (reg_addr == SOC_CTRL_WARM_BOOT_ENTRY_OFFSET);
+    addr_hit[18] = (reg_addr == SOC_CTRL_WARM_BOOT_SIZE_OFFSET);
+    addr_hit[19] = (reg_addr == SOC_CTRL_WARM_BOOT_CHECKSUM_OFFSET);
+    addr_hit[20] = (reg_addr == SOC_CTRL_BUS_QOS_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -334,7 +848,20 @@ module soc_ctrl_reg_top #(
                (addr_hit[4] & (|(SOC_CTRL_PERMIT[4] & ~reg_be))) |
                (addr_hit[5] & (|(SOC_CTRL_PERMIT[5] & ~reg_be))) |
                (addr_hit[6] & (|(SOC_CTRL_PERMIT[6] & ~reg_be))) |
-               (addr_hit[7] & (|(SOC_CTRL_PERMIT[7] & ~reg_be)))));
+               (addr_hit[7] & (|(SOC_CTRL_PERMIT[7] & ~reg_be))) |
+               (addr_hit[8] & (|(SOC_CTRL_PERMIT[8] & ~reg_be))) |
+               (addr_hit[9] & (|(SOC_CTRL_PERMIT[9] & ~reg_be))) |
+               (addr_hit[10] & (|(SOC_CTRL_PERMIT[10] & ~reg_be))) |
+               (addr_hit[11] & (|(SOC_CTRL_PERMIT[11] & ~reg_be))) |
+               (addr_hit[12] & (|(SOC_CTRL_PERMIT[12] & ~reg_be))) |
+               (addr_hit[13] & (|(SOC_CTRL_PERMIT[13] & ~reg_be))) |
+               (addr_hit[14] & (|(SOC_CTRL_PERMIT[14] & ~reg_be))) |
+               (addr_hit[15] & (|(SOC_CTRL_PERMIT[15] & ~reg_be))) |
+               (addr_hit[16] & (|(SOC_CTRL_PERMIT[16] & ~reg_be))) |
+               (addr_hit[17] & (|(SOC_CTRL_PERMIT[17] & ~reg_be))) |
+               (addr_hit[18] & (|(SOC_CTRL_PERMIT[18] & ~reg_be))) |
+               (addr_hit[19] & (|(SOC_CTRL_PERMIT[19] & ~reg_be))) |
+               (addr_hit[20] & (|(SOC_CTRL_PERMIT[20] & ~reg_be)))));
   end
 
   assign exit_valid_we = addr_hit[0] & reg_we & !reg_error;
@@ -358,6 +885,54 @@ module soc_ctrl_reg_top #(
   assign system_frequency_hz_we = addr_hit[7] & reg_we & !reg_error;
   assign system_frequency_hz_wd = reg_wdata[31:0];
 
+  assign icache_ctrl_enable_we = addr_hit[8] & reg_we & !reg_error;
+  assign icache_ctrl_enable_wd = reg_wdata[0];
+
+  assign icache_ctrl_prefetch_we = addr_hit[8] & reg_we & !reg_error;
+  assign icache_ctrl_prefetch_wd = reg_wdata[1];
+
+  assign icache_flush_we = addr_hit[9] & reg_we & !reg_error;
+  assign icache_flush_wd = reg_wdata[0];
+
+  assign icache_hits_we = addr_hit[10] & reg_we & !reg_error;
+  assign icache_hits_wd = reg_wdata[31:0];
+
+  assign icache_misses_we = addr_hit[11] & reg_we & !reg_error;
+  assign icache_misses_wd = reg_wdata[31:0];
+
+  assign dcache_ctrl_enable_we = addr_hit[12] & reg_we & !reg_error;
+  assign dcache_ctrl_enable_wd = reg_wdata[0];
+
+  assign dcache_maint_clean_we = addr_hit[13] & reg_we & !reg_error;
+  assign dcache_maint_clean_wd = reg_wdata[0];
+
+  assign dcache_maint_invalidate_we = addr_hit[13] & reg_we & !reg_error;
+  assign dcache_maint_invalidate_wd = reg_wdata[1];
+
+  assign dcache_hits_we = addr_hit[14] & reg_we & !reg_error;
+  assign dcache_hits_wd = reg_wdata[31:0];
+
+  assign dcache_misses_we = addr_hit[15] & reg_we & !reg_error;
+  assign dcache_misses_wd = reg_wdata[31:0];
+
+  assign warm_boot_magic_we = addr_hit[16] & reg_we & !reg_error;
+  assign warm_boot_magic_wd = reg_wdata[31:0];
+
+  assign warm_boot_entry_we = addr_hit[17] & reg_we & !reg_error;
+  assign warm_boot_entry_wd = reg_wdata[31:0];
+
+  assign warm_boot_size_we = addr_hit[18] & reg_we & !reg_error;
+  assign warm_boot_size_wd = reg_wdata[31:0];
+
+  assign warm_boot_checksum_we = addr_hit[19] & reg_we & !reg_error;
+  assign warm_boot_checksum_wd = reg_wdata[31:0];
+
+  assign bus_qos_cpu_prio_we = addr_hit[20] & reg_we & !reg_error;
+  assign bus_qos_cpu_prio_wd = reg_wdata[0];
+
+  assign bus_qos_dma_throttle_we = addr_hit[20] & reg_we & !reg_error;
+  assign bus_qos_dma_throttle_wd = reg_wdata[15:8];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -394,6 +969,62 @@ module soc_ctrl_reg_top #(
         reg_rdata_next[31:0] = system_frequency_hz_qs;
       end
 
+      addr_hit[8]: begin
+        reg_rdata_next[0] = icache_ctrl_enable_qs;
+        reg_rdata_next[1] = icache_ctrl_prefetch_qs;
+      end
+
+      addr_hit[9]: begin
+        reg_rdata_next[0] = '0;
+      end
+
+      addr_hit[10]: begin
+        reg_rdata_next[31:0] = icache_hits_qs;
+      end
+
+      addr_hit[11]: begin
+        reg_rdata_next[31:0] = icache_misses_qs;
+      end
+
+      addr_hit[12]: begin
+        reg_rdata_next[0] = dcache_ctrl_enable_qs;
+        reg_rdata_next[1] = dcache_ctrl_busy_qs;
+      end
+
+      addr_hit[13]: begin
+        reg_rdata_next[0] = '0;
+        reg_rdata_next[1] = '0;
+      end
+
+      addr_hit[14]: begin
+        reg_rdata_next[31:0] = dcache_hits_qs;
+      end
+
+      addr_hit[15]: begin
+        reg_rdata_next[31:0] = dcache_misses_qs;
+      end
+
+      addr_hit[16]: begin
+        reg_rdata_next[31:0] = warm_boot_magic_qs;
+      end
+
+      addr_hit[17]: begin
+        reg_rdata_next[31:0] = warm_boot_entry_qs;
+      end
+
+      addr_hit[18]: begin
+        reg_rdata_next[31:0] = warm_boot_size_qs;
+      end
+
+      addr_hit[19]: begin
+        reg_rdata_next[31:0] = warm_boot_checksum_qs;
+      end
+
+      addr_hit[20]: begin
+        reg_rdata_next[0] = bus_qos_cpu_prio_qs;
+        reg_rdata_next[15:8] = bus_qos_dma_throttle_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -415,7 +1046,7 @@ module soc_ctrl_reg_top #(
 endmodule
 
 module soc_ctrl_reg_top_intf #(
-    parameter  int AW = 5,
+    parameter  int AW = 7,
     localparam int DW = 32
 ) (
     input logic clk_i,
@@ -2,6 +2,12 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+// Description: AMS peripheral with a 1-bit ADC. The ADC output is read in GET,
+//              or sampled every PERIOD + 1 cycles into SAMPLE while CTRL.EN
+//              is set. ams_sample_valid_o, the DMA trigger, is set until the
+//              sample is read, and ams_intr_o wakes up the CPU when a sample
+//              is above the threshold.
+
 module ams #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic
@@ -9,19 +15,102 @@ module ams #(
     input logic clk_i,
     input logic rst_ni,
     input reg_req_t reg_req_i,
-    output reg_rsp_t reg_rsp_o
+    output reg_rsp_t reg_rsp_o,
+
+    // DMA trigger, a sample can be read
+    output logic ams_sample_valid_o,
+
+    // Threshold interrupt
+    output logic ams_intr_o
 );
 
   import ams_reg_pkg::*;
 
-  ams_reg2hw_t reg2hw;
-  ams_hw2reg_t hw2reg;
+  ams_reg2hw_t        reg2hw;
+  ams_hw2reg_t        hw2reg;
+
+  logic               adc_out;
+
+  logic        [31:0] r_period_cnt;
+  logic               s_tick;
+  logic               r_sample;
+  logic        [15:0] r_index;
+  logic               r_valid;
+  logic               r_overrun;
+  logic               r_alert;
 
   assign hw2reg.get.de = 1;
+  assign hw2reg.get.d = adc_out;
+
+  assign s_tick = reg2hw.ctrl.en.q & (r_period_cnt == reg2hw.period.q);
+
+  // sampling period
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_period_cnt <= '0;
+    end else begin
+      if (~reg2hw.ctrl.en.q | s_tick) begin
+        r_period_cnt <= '0;
+      end else begin
+        r_period_cnt <= r_period_cnt + 1;
+      end
+    end
+  end
+
+  // latch the ADC output at each tick, until it is read
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_sample  <= 1'b0;
+      r_index   <= '0;
+      r_valid   <= 1'b0;
+      r_overrun <= 1'b0;
+    end else begin
+      if (~reg2hw.ctrl.en.q) begin
+        r_index   <= '0;
+        r_valid   <= 1'b0;
+        r_overrun <= 1'b0;
+      end else if (s_tick) begin
+        r_sample <= adc_out;
+        r_index  <= r_index + 1;
+        r_valid  <= 1'b1;
+        if (r_valid & ~reg2hw.sample.re) begin
+          r_overrun <= 1'b1;
+        end
+      end else if (reg2hw.sample.re) begin
+        r_valid <= 1'b0;
+      end
+    end
+  end
+
+  // sticky until CTRL.CLEAR_ALERT
+  always_ff @(posedge clk_i, negedge rst_ni) begin
+    if (~rst_ni) begin
+      r_alert <= 1'b0;
+    end else begin
+      if (reg2hw.ctrl.clear_alert.q) begin
+        r_alert <= 1'b0;
+      end else if (s_tick & adc_out) begin
+        r_alert <= 1'b1;
+      end
+    end
+  end
+
+  // the index is the one of the sample since EN, from 0
+  assign hw2reg.sample.d = {r_index - 16'h1, 15'h0, r_sample};
+
+  assign hw2reg.status.valid.d = r_valid;
+  assign hw2reg.status.overrun.d = r_overrun;
+  assign hw2reg.status.alert.d = r_alert;
+
+  assign hw2reg.ctrl.clear_alert.d = 1'b0;
+  assign hw2reg.ctrl.clear_alert.de = reg2hw.ctrl.clear_alert.q;
+
+  assign ams_sample_valid_o = r_valid;
+  assign ams_intr_o = reg2hw.ctrl.intr_en.q & r_alert;
 
   ams_adc_1b ams_adc_1b_i (
       .sel(reg2hw.sel.q),
-      .out(hw2reg.get.d)
+      .out(adc_out)
   );
 
   ams_reg_top #(
@@ -38,4 +127,3 @@ module ams #(
   );
 
 endmodule : ams
-
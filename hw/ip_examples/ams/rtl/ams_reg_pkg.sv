@@ -7,7 +7,7 @@
 package ams_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 3;
+  parameter int BlockAw = 5;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -17,36 +17,86 @@ package ams_reg_pkg;
 
   typedef struct packed {logic q;} ams_reg2hw_get_reg_t;
 
+  typedef struct packed {
+    struct packed {logic q;} en;
+    struct packed {logic q;} intr_en;
+    struct packed {logic q;} clear_alert;
+  } ams_reg2hw_ctrl_reg_t;
+
+  typedef struct packed {logic [31:0] q;} ams_reg2hw_period_reg_t;
+
+  typedef struct packed {
+    logic [31:0] q;
+    logic        re;
+  } ams_reg2hw_sample_reg_t;
+
   typedef struct packed {
     logic d;
     logic de;
   } ams_hw2reg_get_reg_t;
 
+  typedef struct packed {
+    struct packed {
+      logic d;
+      logic de;
+    } clear_alert;
+  } ams_hw2reg_ctrl_reg_t;
+
+  typedef struct packed {logic [31:0] d;} ams_hw2reg_sample_reg_t;
+
+  typedef struct packed {
+    struct packed {logic d;} valid;
+    struct packed {logic d;} overrun;
+    struct packed {logic d;} alert;
+  } ams_hw2reg_status_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    ams_reg2hw_sel_reg_t sel;  // [2:1]
-    ams_reg2hw_get_reg_t get;  // [0:0]
+    ams_reg2hw_sel_reg_t sel;  // [70:69]
+    ams_reg2hw_get_reg_t get;  // [68:68]
+    ams_reg2hw_ctrl_reg_t ctrl;  // [67:65]
+    ams_reg2hw_period_reg_t period;  // [64:33]
+    ams_reg2hw_sample_reg_t sample;  // [32:0]
   } ams_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    ams_hw2reg_get_reg_t get;  // [1:0]
+    ams_hw2reg_get_reg_t get;  // [38:37]
+    ams_hw2reg_ctrl_reg_t ctrl;  // [36:35]
+    ams_hw2reg_sample_reg_t sample;  // [34:3]
+    ams_hw2reg_status_reg_t status;  // [2:0]
   } ams_hw2reg_t;
 
   // Register offsets
-  parameter logic [BlockAw-1:0] AMS_SEL_OFFSET = 3'h0;
-  parameter logic [BlockAw-1:0] AMS_GET_OFFSET = 3'h4;
+  parameter logic [BlockAw-1:0] AMS_SEL_OFFSET = 5'h0;
+  parameter logic [BlockAw-1:0] AMS_GET_OFFSET = 5'h4;
+  parameter logic [BlockAw-1:0] AMS_CTRL_OFFSET = 5'h8;
+  parameter logic [BlockAw-1:0] AMS_PERIOD_OFFSET = 5'hc;
+  parameter logic [BlockAw-1:0] AMS_SAMPLE_OFFSET = 5'h10;
+  parameter logic [BlockAw-1:0] AMS_STATUS_OFFSET = 5'h14;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [31:0] AMS_SAMPLE_RESVAL = 32'h0;
+  parameter logic [2:0] AMS_STATUS_RESVAL = 3'h0;
 
   // Register index
   typedef enum int {
     AMS_SEL,
-    AMS_GET
+    AMS_GET,
+    AMS_CTRL,
+    AMS_PERIOD,
+    AMS_SAMPLE,
+    AMS_STATUS
   } ams_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] AMS_PERMIT[2] = '{
+  parameter logic [3:0] AMS_PERMIT[6] = '{
       4'b0001,  // index[0] AMS_SEL
-      4'b0001  // index[1] AMS_GET
+      4'b0001,  // index[1] AMS_GET
+      4'b0001,  // index[2] AMS_CTRL
+      4'b1111,  // index[3] AMS_PERIOD
+      4'b1111,  // index[4] AMS_SAMPLE
+      4'b0001  // index[5] AMS_STATUS
   };
 
 endpackage
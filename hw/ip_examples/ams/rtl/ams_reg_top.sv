@@ -10,7 +10,7 @@
 module ams_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 3
+    parameter int AW = 5
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -72,6 +72,26 @@ module ams_reg_top #(
   logic [1:0] sel_wd;
   logic sel_we;
   logic get_qs;
+  logic ctrl_en_qs;
+  logic ctrl_en_wd;
+  logic ctrl_en_we;
+  logic ctrl_intr_en_qs;
+  logic ctrl_intr_en_wd;
+  logic ctrl_intr_en_we;
+  logic ctrl_clear_alert_qs;
+  logic ctrl_clear_alert_wd;
+  logic ctrl_clear_alert_we;
+  logic [31:0] period_qs;
+  logic [31:0] period_wd;
+  logic period_we;
+  logic [31:0] sample_qs;
+  logic sample_re;
+  logic status_valid_qs;
+  logic status_valid_re;
+  logic status_overrun_qs;
+  logic status_overrun_re;
+  logic status_alert_qs;
+  logic status_alert_re;
 
   // Register instances
   // R[sel]: V(False)
@@ -127,13 +147,183 @@ module ams_reg_top #(
   );
 
 
+  // R[ctrl]: V(False)
 
+  //   F[en]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_ctrl_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ctrl_en_we),
+      .wd(ctrl_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ctrl.en.q),
+
+      // to register interface (read)
+      .qs(ctrl_en_qs)
+  );
+
+  //   F[intr_en]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_ctrl_intr_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ctrl_intr_en_we),
+      .wd(ctrl_intr_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ctrl.intr_en.q),
+
+      // to register interface (read)
+      .qs(ctrl_intr_en_qs)
+  );
+
+  //   F[clear_alert]: 2:2
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_ctrl_clear_alert (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ctrl_clear_alert_we),
+      .wd(ctrl_clear_alert_wd),
 
-  logic [1:0] addr_hit;
+      // from internal hardware
+      .de(hw2reg.ctrl.clear_alert.de),
+      .d (hw2reg.ctrl.clear_alert.d),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ctrl.clear_alert.q),
+
+      // to register interface (read)
+      .qs(ctrl_clear_alert_qs)
+  );
+
+
+  // R[period]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_period (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(period_we),
+      .wd(period_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.period.q),
+
+      // to register interface (read)
+      .qs(period_qs)
+  );
+
+
+  // R[sample]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_sample (
+      .re (sample_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.sample.d),
+      .qre(reg2hw.sample.re),
+      .qe (),
+      .q  (reg2hw.sample.q),
+      .qs (sample_qs)
+  );
+
+
+  // R[status]: V(True)
+
+  //   F[valid]: 0:0
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_valid (
+      .re (status_valid_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.valid.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_valid_qs)
+  );
+
+  //   F[overrun]: 1:1
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_overrun (
+      .re (status_overrun_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.overrun.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_overrun_qs)
+  );
+
+  //   F[alert]: 2:2
+  prim_subreg_ext #(
+      .DW(1)
+  ) u_status_alert (
+      .re (status_alert_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.status.alert.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (status_alert_qs)
+  );
+
+
+
+
+  logic [5:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == AMS_SEL_OFFSET);
     addr_hit[1] = (reg_addr == AMS_GET_OFFSET);
+    addr_hit[2] = (reg_addr == AMS_CTRL_OFFSET);
+    addr_hit[3] = (reg_addr == AMS_PERIOD_OFFSET);
+    addr_hit[4] = (reg_addr == AMS_SAMPLE_OFFSET);
+    addr_hit[5] = (reg_addr == AMS_STATUS_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -142,12 +332,36 @@ module ams_reg_top #(
   always_comb begin
     wr_err = (reg_we &
               ((addr_hit[0] & (|(AMS_PERMIT[0] & ~reg_be))) |
-               (addr_hit[1] & (|(AMS_PERMIT[1] & ~reg_be)))));
+               (addr_hit[1] & (|(AMS_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(AMS_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(AMS_PERMIT[3] & ~reg_be))) |
+               (addr_hit[4] & (|(AMS_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(AMS_PERMIT[5] & ~reg_be)))));
   end
 
   assign sel_we = addr_hit[0] & reg_we & !reg_error;
   assign sel_wd = reg_wdata[1:0];
 
+  assign ctrl_en_we = addr_hit[2] & reg_we & !reg_error;
+  assign ctrl_en_wd = reg_wdata[0];
+
+  assign ctrl_intr_en_we = addr_hit[2] & reg_we & !reg_error;
+  assign ctrl_intr_en_wd = reg_wdata[1];
+
+  assign ctrl_clear_alert_we = addr_hit[2] & reg_we & !reg_error;
+  assign ctrl_clear_alert_wd = reg_wdata[2];
+
+  assign period_we = addr_hit[3] & reg_we & !reg_error;
+  assign period_wd = reg_wdata[31:0];
+
+  assign sample_re = addr_hit[4] & reg_re & !reg_error;
+
+  assign status_valid_re = addr_hit[5] & reg_re & !reg_error;
+
+  assign status_overrun_re = addr_hit[5] & reg_re & !reg_error;
+
+  assign status_alert_re = addr_hit[5] & reg_re & !reg_error;
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -160,6 +374,26 @@ module ams_reg_top #(
         reg_rdata_next[0] = get_qs;
       end
 
+      addr_hit[2]: begin
+        reg_rdata_next[0] = ctrl_en_qs;
+        reg_rdata_next[1] = ctrl_intr_en_qs;
+        reg_rdata_next[2] = ctrl_clear_alert_qs;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[31:0] = period_qs;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[31:0] = sample_qs;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[0] = status_valid_qs;
+        reg_rdata_next[1] = status_overrun_qs;
+        reg_rdata_next[2] = status_alert_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -181,7 +415,7 @@ module ams_reg_top #(
 endmodule
 
 module ams_reg_top_intf #(
-    parameter  int AW = 3,
+    parameter  int AW = 5,
     localparam int DW = 32
 ) (
     input logic clk_i,
@@ -8,6 +8,9 @@
 module iffifo #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
+    // Minimum cycles between two words read by the DMA, to model the
+    // throughput of an accelerator behind the FIFO (1: a word per cycle)
+    parameter int unsigned OUT_INTERVAL = 1,
     localparam int WIDTH = 32,
     localparam int DEPTH = 4,
     localparam int DEPTHw = $clog2(DEPTH + 1)
@@ -33,6 +36,8 @@ module iffifo #(
   logic [WIDTH-1:0] fifout;
   logic [DEPTHw-1:0] occupancy;
   logic empty, full, reached, available;
+  logic fifo_rvalid;
+  logic [15:0] interval_q;
 
   assign hw2reg.fifo_out.d = fifout + 1;
 
@@ -51,6 +56,22 @@ module iffifo #(
   assign hw2reg.occupancy.d = {{32 - DEPTHw{1'b0}}, occupancy};
   assign reached = ({{32 - DEPTHw{1'b0}}, occupancy} >= reg2hw.watermark.q);
 
+  // Output pacing: the DMA slot is only raised OUT_INTERVAL cycles after the
+  // previous word was read
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      interval_q <= '0;
+    end else begin
+      if (reg2hw.fifo_out.re) begin
+        interval_q <= 16'(OUT_INTERVAL - 1);
+      end else if (interval_q != '0) begin
+        interval_q <= interval_q - 1;
+      end
+    end
+  end
+
+  assign iffifo_out_valid_o = fifo_rvalid & (interval_q == '0);
+
   // Interrupts circuitry
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (~rst_ni) begin
@@ -102,7 +123,7 @@ module iffifo #(
       .wdata_i (reg2hw.fifo_in.q),
 
       // From FIFO (output) to DMA (input, RX)
-      .rvalid_o(iffifo_out_valid_o),
+      .rvalid_o(fifo_rvalid),
       .rready_i(reg2hw.fifo_out.re),
       .rdata_o (fifout),
 
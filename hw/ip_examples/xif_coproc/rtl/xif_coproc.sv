@@ -0,0 +1,207 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Description: Template of a coprocessor of the eXtension interface (CORE-V-XIF)
+// of the cv32e40x and cv32e40px, plugged where the fpu_ss_wrapper is. Its
+// functional unit is coupled to the register file of the core: the operands
+// come with the issue of an instruction and the result is written back to rd.
+// The instructions are listed in xif_coproc_pkg.
+//
+// A single instruction is in flight, through the transactions of the interface:
+//   issue:      the instructions of the coprocessor are accepted once their
+//               operands are valid, the other ones are refused right away.
+//   commit:     the instruction waits for its commit, in the cycle of its
+//               issue or later; a killed one is dropped without any effect.
+//   mem:        a load instruction reads its word through xif_mem_if once
+//               committed, never speculatively; an exception of the core
+//               (e.g. from the PMA) ends the instruction with it.
+//   mem_result: the word read, or a bus error.
+//   result:     EXEC_CYCLES cycles later, rd and the accumulator are written.
+// To add an instruction, decode it in xif_coproc_pkg::decode and compute it
+// with the ones of its group below; a pipelined unit would keep the state of
+// each id in flight instead of the registers of the single one.
+
+module xif_coproc
+  import xif_coproc_pkg::*;
+#(
+    parameter int unsigned X_ID_WIDTH  = 4,               // Width of the id of the if_xif
+    parameter logic [6:0]  OPCODE      = OPCODE_CUSTOM0,  // Major opcode of the instructions
+    parameter int unsigned EXEC_CYCLES = 0,               // Cycles of the functional unit
+    parameter bit          MEM_EN      = 1'b1             // The loads through xif_mem_if
+) (
+    // Clock and Reset
+    input logic clk_i,
+    input logic rst_ni,
+
+    // eXtension interface
+    if_xif.coproc_compressed xif_compressed_if,
+    if_xif.coproc_issue      xif_issue_if,
+    if_xif.coproc_commit     xif_commit_if,
+    if_xif.coproc_mem        xif_mem_if,
+    if_xif.coproc_mem_result xif_mem_result_if,
+    if_xif.coproc_result     xif_result_if
+);
+
+  localparam int unsigned CNT_W = EXEC_CYCLES > 1 ? $clog2(EXEC_CYCLES) : 1;
+
+  typedef enum logic [2:0] {
+    IDLE,
+    COMMIT,
+    MEM_REQ,
+    MEM_RESULT,
+    EXEC,
+    RESULT
+  } state_e;
+
+  state_e state_q, state_d, exec_state;
+
+  decode_t dec, dec_q;
+  logic [X_ID_WIDTH-1:0] id_q, commit_id;
+  logic [1:0] mode_q;
+  logic [4:0] rd_q;
+  logic [31:0] op_a_q, op_b_q, acc_q;
+  logic exc_q, err_q;
+  logic [5:0] exccode_q;
+  logic [CNT_W-1:0] cnt_q;
+
+  logic operands_valid, issue_hs, commit_hs;
+  logic [31:0] bit_result, mac_result;
+
+  // No compressed instruction
+  assign xif_compressed_if.compressed_ready = 1'b1;
+  assign xif_compressed_if.compressed_resp.instr = '0;
+  assign xif_compressed_if.compressed_resp.accept = 1'b0;
+
+  // Issue
+  assign dec = decode(xif_issue_if.issue_req.instr, OPCODE, MEM_EN);
+  assign operands_valid = xif_issue_if.issue_req.rs_valid[0] &
+                          (~dec.rs2 | xif_issue_if.issue_req.rs_valid[1]);
+  assign xif_issue_if.issue_ready = ~dec.valid | (state_q == IDLE & operands_valid);
+  assign issue_hs = xif_issue_if.issue_valid & xif_issue_if.issue_ready & dec.valid;
+
+  assign xif_issue_if.issue_resp.accept = dec.valid;
+  assign xif_issue_if.issue_resp.writeback = dec.valid & dec.we;
+  assign xif_issue_if.issue_resp.dualwrite = 1'b0;
+  assign xif_issue_if.issue_resp.dualread = '0;
+  assign xif_issue_if.issue_resp.loadstore = dec.valid & dec.mem;
+  assign xif_issue_if.issue_resp.ecswrite = 1'b0;
+  assign xif_issue_if.issue_resp.exc = dec.valid & dec.mem;
+
+  // Commit of the instruction issued, in the cycle of its issue or after
+  assign commit_id = issue_hs ? xif_issue_if.issue_req.id : id_q;
+  assign commit_hs = xif_commit_if.commit_valid & xif_commit_if.commit.id == commit_id &
+                     (issue_hs | state_q == COMMIT);
+
+  assign exec_state = EXEC_CYCLES != 0 ? EXEC : RESULT;
+
+  always_comb begin
+    state_d = state_q;
+    unique case (state_q)
+      IDLE, COMMIT: begin
+        if (commit_hs) begin
+          if (xif_commit_if.commit.commit_kill) state_d = IDLE;
+          else state_d = (issue_hs ? dec.mem : dec_q.mem) ? MEM_REQ : exec_state;
+        end else if (issue_hs) begin
+          state_d = COMMIT;
+        end
+      end
+      MEM_REQ: begin
+        if (xif_mem_if.mem_ready) state_d = xif_mem_if.mem_resp.exc ? RESULT : MEM_RESULT;
+      end
+      MEM_RESULT: begin
+        if (xif_mem_result_if.mem_result_valid && xif_mem_result_if.mem_result.id == id_q)
+          state_d = exec_state;
+      end
+      EXEC: begin
+        if (cnt_q == CNT_W'(EXEC_CYCLES - 1)) state_d = RESULT;
+      end
+      RESULT: begin
+        if (xif_result_if.result_ready) state_d = IDLE;
+      end
+      default: state_d = IDLE;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      state_q   <= IDLE;
+      dec_q     <= '0;
+      id_q      <= '0;
+      mode_q    <= '0;
+      rd_q      <= '0;
+      op_a_q    <= '0;
+      op_b_q    <= '0;
+      acc_q     <= '0;
+      exc_q     <= 1'b0;
+      err_q     <= 1'b0;
+      exccode_q <= '0;
+      cnt_q     <= '0;
+    end else begin
+      state_q <= state_d;
+      if (issue_hs) begin
+        dec_q  <= dec;
+        id_q   <= xif_issue_if.issue_req.id;
+        mode_q <= xif_issue_if.issue_req.mode;
+        rd_q   <= xif_issue_if.issue_req.instr[11:7];
+        op_a_q <= xif_issue_if.issue_req.rs[0];
+        op_b_q <= dec.rs2 ? xif_issue_if.issue_req.rs[1] : '0;
+        exc_q  <= 1'b0;
+        err_q  <= 1'b0;
+      end
+      if (state_q == MEM_REQ && xif_mem_if.mem_ready) begin
+        exc_q     <= xif_mem_if.mem_resp.exc;
+        exccode_q <= xif_mem_if.mem_resp.exccode;
+      end
+      // The word read replaces its address
+      if (state_q == MEM_RESULT && state_d != MEM_RESULT) begin
+        op_a_q <= xif_mem_result_if.mem_result.rdata;
+        err_q  <= xif_mem_result_if.mem_result.err;
+      end
+      cnt_q <= state_q == EXEC ? cnt_q + 1'b1 : '0;
+      // The accumulator, only by the instructions completed without errors
+      if (state_q == RESULT && xif_result_if.result_ready && dec_q.group != F3_BIT &&
+          !exc_q && !err_q)
+        acc_q <= mac_result;
+    end
+  end
+
+  // Functional unit
+  always_comb begin
+    unique case (dec_q.sel)
+      BIT_POPCNT: bit_result = popcount(op_a_q);
+      BIT_CLZ:    bit_result = clz(op_a_q);
+      BIT_BREV:   bit_result = brev(op_a_q);
+      default:    bit_result = bext(op_a_q, op_b_q);
+    endcase
+  end
+
+  assign mac_result = (dec_q.sel[MAC_Z] ? 32'd0 : acc_q) + dot(op_a_q, op_b_q, dec_q.sel[MAC_16]);
+
+  // Memory request, a word
+  assign xif_mem_if.mem_valid = state_q == MEM_REQ;
+  assign xif_mem_if.mem_req.id = id_q;
+  assign xif_mem_if.mem_req.addr = op_a_q;
+  assign xif_mem_if.mem_req.mode = mode_q;
+  assign xif_mem_if.mem_req.we = 1'b0;
+  assign xif_mem_if.mem_req.size = 3'd2;
+  assign xif_mem_if.mem_req.be = '1;
+  assign xif_mem_if.mem_req.attr = '0;
+  assign xif_mem_if.mem_req.wdata = '0;
+  assign xif_mem_if.mem_req.last = 1'b1;
+  assign xif_mem_if.mem_req.spec = 1'b0;
+
+  // Result
+  assign xif_result_if.result_valid = state_q == RESULT;
+  assign xif_result_if.result.id = id_q;
+  assign xif_result_if.result.data = dec_q.group == F3_BIT ? bit_result : mac_result;
+  assign xif_result_if.result.rd = rd_q;
+  assign xif_result_if.result.we = dec_q.we & ~exc_q & ~err_q;
+  assign xif_result_if.result.ecsdata = '0;
+  assign xif_result_if.result.ecswe = '0;
+  assign xif_result_if.result.exc = exc_q;
+  assign xif_result_if.result.exccode = exccode_q;
+  assign xif_result_if.result.err = err_q;
+  assign xif_result_if.result.dbg = 1'b0;
+
+endmodule
@@ -0,0 +1,127 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Description: Encoding and datapath of the instructions of xif_coproc.
+//
+// All are R-type instructions of the custom-0 opcode with funct7[6:2] = 0,
+// funct3 selecting the group and funct7[1:0] the instruction of the group:
+//
+//   funct3  funct7  instruction              result
+//   0       0       cx.popcnt rd, rs1        ones of rs1
+//   0       1       cx.clz    rd, rs1        leading zeros of rs1, 32 for 0
+//   0       2       cx.brev   rd, rs1        bits of rs1 reversed
+//   0       3       cx.bext   rd, rs1, rs2   rs1[pos +: len], pos = rs2[4:0],
+//                                            len = rs2[9:5] + 1, zero-extended
+//   1       0       cx.mac8   rd, rs1, rs2   acc += 4 products of the signed
+//                                            bytes of rs1 and rs2, rd = acc
+//   1       1       cx.mac16  rd, rs1, rs2   same with 2 signed halfwords
+//   1       2, 3    cx.macz8, cx.macz16      same, acc restarted from 0
+//   2       0..3    cx.lmac8 ... cx.lmacz16  same as 1, with the word at the
+//                                            address rs1 instead of rs1
+//
+// acc is the 32-bit accumulator of the coprocessor, changed only by the
+// instructions committed.
+
+package xif_coproc_pkg;
+
+  // custom-0, the major opcode left to the extensions by the RISC-V ISA
+  localparam logic [6:0] OPCODE_CUSTOM0 = 7'b0001011;
+
+  // funct3, the groups of instructions
+  localparam logic [2:0] F3_BIT = 3'd0;
+  localparam logic [2:0] F3_MAC = 3'd1;
+  localparam logic [2:0] F3_LMAC = 3'd2;
+
+  // funct7[1:0] of F3_BIT
+  localparam logic [1:0] BIT_POPCNT = 2'd0;
+  localparam logic [1:0] BIT_CLZ = 2'd1;
+  localparam logic [1:0] BIT_BREV = 2'd2;
+  localparam logic [1:0] BIT_BEXT = 2'd3;
+
+  // funct7[1:0] of F3_MAC and F3_LMAC, as flags
+  localparam int unsigned MAC_16 = 0;  // Halfword lanes instead of bytes
+  localparam int unsigned MAC_Z = 1;  // acc restarted from 0
+
+  typedef struct packed {
+    logic       valid;  // An instruction of the coprocessor
+    logic [2:0] group;  // funct3
+    logic [1:0] sel;    // funct7[1:0]
+    logic       rs2;    // Reads rs2
+    logic       mem;    // Loads its first operand from the address rs1
+    logic       we;     // Writes rd, not x0
+  } decode_t;
+
+  function automatic decode_t decode(logic [31:0] instr, logic [6:0] opcode, bit mem_en);
+    decode_t d;
+    d       = '0;
+    d.group = instr[14:12];
+    d.sel   = instr[26:25];
+    d.we    = instr[11:7] != 5'd0;
+    if (instr[6:0] == opcode && instr[31:27] == 5'd0) begin
+      unique case (instr[14:12])
+        F3_BIT: begin
+          d.valid = 1'b1;
+          d.rs2   = instr[26:25] == BIT_BEXT;
+        end
+        F3_MAC: begin
+          d.valid = 1'b1;
+          d.rs2   = 1'b1;
+        end
+        F3_LMAC: begin
+          d.valid = mem_en;
+          d.rs2   = 1'b1;
+          d.mem   = 1'b1;
+        end
+        default: ;
+      endcase
+    end
+    return d;
+  endfunction
+
+  function automatic logic [31:0] popcount(logic [31:0] x);
+    logic [31:0] n;
+    n = '0;
+    for (int i = 0; i < 32; i++) n += {31'd0, x[i]};
+    return n;
+  endfunction
+
+  function automatic logic [31:0] clz(logic [31:0] x);
+    logic [31:0] n;
+    n = 32'd32;
+    for (int i = 0; i < 32; i++) if (x[i]) n = 32'(31 - i);
+    return n;
+  endfunction
+
+  function automatic logic [31:0] brev(logic [31:0] x);
+    logic [31:0] r;
+    for (int i = 0; i < 32; i++) r[i] = x[31-i];
+    return r;
+  endfunction
+
+  function automatic logic [31:0] bext(logic [31:0] x, logic [31:0] field);
+    // len = field[9:5] + 1 ones
+    return (x >> field[4:0]) & ~(32'hFFFF_FFFE << field[9:5]);
+  endfunction
+
+  // Dot product of the signed lanes of a and b
+  function automatic logic [31:0] dot(logic [31:0] a, logic [31:0] b, logic lanes16);
+    logic signed [31:0] s;
+    logic signed [15:0] p8;
+    logic signed [31:0] p16;
+    s = '0;
+    if (lanes16) begin
+      for (int i = 0; i < 2; i++) begin
+        p16 = $signed(a[16*i+:16]) * $signed(b[16*i+:16]);
+        s += p16;
+      end
+    end else begin
+      for (int i = 0; i < 4; i++) begin
+        p8 = $signed(a[8*i+:8]) * $signed(b[8*i+:8]);
+        s += 32'(p8);
+      end
+    end
+    return s;
+  endfunction
+
+endpackage
@@ -12,7 +12,7 @@
 % for pad in pad_muxed_list:
     { name:     "PAD_MUX_${pad.name.upper()}",
       desc:     "Used to mux pad ${pad.name.upper()}",
-      resval:   "0x0"
+      resval:   "${hex(pad.mux_resval)}"
       swaccess: "rw",
       hwaccess: "hro",
       fields: [
@@ -29,12 +29,12 @@ module x_heep_system
     input  obi_resp_t ext_core_data_resp_i,
     output obi_req_t  ext_debug_master_req_o,
     input  obi_resp_t ext_debug_master_resp_i,
-    output obi_req_t  ext_dma_read_ch0_req_o,
-    input  obi_resp_t ext_dma_read_ch0_resp_i,
-    output obi_req_t  ext_dma_write_ch0_req_o,
-    input  obi_resp_t ext_dma_write_ch0_resp_i,
-    output obi_req_t  ext_dma_addr_ch0_req_o,
-    input  obi_resp_t ext_dma_addr_ch0_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_read_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_write_resp_i,
+    output obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_req_o,
+    input  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] ext_dma_addr_resp_i,
 
     output reg_req_t ext_peripheral_slave_req_o,
     input  reg_rsp_t ext_peripheral_slave_resp_i,
@@ -120,12 +120,12 @@ ${pad.core_v_mini_mcu_bonding}
     .ext_core_data_resp_i,
     .ext_debug_master_req_o,
     .ext_debug_master_resp_i,
-    .ext_dma_read_ch0_req_o,
-    .ext_dma_read_ch0_resp_i,
-    .ext_dma_write_ch0_req_o,
-    .ext_dma_write_ch0_resp_i,
-    .ext_dma_addr_ch0_req_o,
-    .ext_dma_addr_ch0_resp_i,
+    .ext_dma_read_req_o,
+    .ext_dma_read_resp_i,
+    .ext_dma_write_req_o,
+    .ext_dma_write_resp_i,
+    .ext_dma_addr_req_o,
+    .ext_dma_addr_resp_i,
     .ext_peripheral_slave_req_o,
     .ext_peripheral_slave_resp_i,
     .cpu_subsystem_powergate_switch_no(cpu_subsystem_powergate_switch_n),
@@ -0,0 +1,87 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Port of CoreMark (sw/vendor/eembc_coremark) to X-HEEP: a single context,
+// the data blocks in a static array, the time in cycles of mcycle and the
+// output on the UART with printf. The seeds of the performance run are
+// volatile, so the compiler cannot fold the benchmark.
+
+#ifndef CORE_PORTME_H
+#define CORE_PORTME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// No floats: the cores may have no FPU, and the score is computed from the
+// ticks and the iterations (util/benchmarks.py)
+#define HAS_FLOAT   0
+#define HAS_TIME_H  0
+#define USE_CLOCK   0
+#define HAS_STDIO   1
+#define HAS_PRINTF  1
+
+// Iterations of the run, the default takes about 3.5M cycles on the
+// cv32e20. 0 would calibrate them for 10 s, too long for a simulation.
+#ifndef ITERATIONS
+#define ITERATIONS  10
+#endif
+
+#ifndef COMPILER_VERSION
+#ifdef __clang__
+#define COMPILER_VERSION "clang " __clang_version__
+#elif defined(__GNUC__)
+#define COMPILER_VERSION "GCC " __VERSION__
+#else
+#define COMPILER_VERSION "unknown"
+#endif
+#endif
+#ifndef COMPILER_FLAGS
+#define COMPILER_FLAGS "-Os (sw/CMakeLists.txt) and APP_CFLAGS"
+#endif
+#ifndef MEM_LOCATION
+#define MEM_LOCATION "STATIC"
+#endif
+
+typedef int16_t   ee_s16;
+typedef uint16_t  ee_u16;
+typedef int32_t   ee_s32;
+typedef float     ee_f32;
+typedef uint8_t   ee_u8;
+typedef uint32_t  ee_u32;
+typedef uintptr_t ee_ptr_int;
+typedef size_t    ee_size_t;
+
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x) - 1) & ~3))
+
+// The ticks are the cycles of mcycle, read as 32 bits: up to 4G cycles
+#define CORETIMETYPE     ee_u32
+typedef ee_u32 CORE_TICKS;
+
+#define SEED_METHOD      SEED_VOLATILE
+#define MEM_METHOD       MEM_STATIC
+#define MULTITHREAD      1
+#define MAIN_HAS_NOARGC  1
+#define MAIN_HAS_NORETURN 0
+
+typedef struct CORE_PORTABLE_S {
+    ee_u8 portable_id;
+} core_portable;
+
+extern ee_u32 default_num_contexts;
+
+void portable_init(core_portable *p, int *argc, char *argv[]);
+void portable_fini(core_portable *p);
+
+// The validated data size with the seeds of the performance run
+#if !defined(PROFILE_RUN) && !defined(PERFORMANCE_RUN) && !defined(VALIDATION_RUN)
+#if (TOTAL_DATA_SIZE == 1200)
+#define PROFILE_RUN 1
+#elif (TOTAL_DATA_SIZE == 2000)
+#define PERFORMANCE_RUN 1
+#else
+#define VALIDATION_RUN 1
+#endif
+#endif
+
+#endif // CORE_PORTME_H
@@ -0,0 +1,98 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// CoreMark on X-HEEP: the port of core_portme.h and the sources of the
+// vendored CoreMark (util/vendor.py sw/vendor/eembc_coremark.vendor.hjson),
+// built in this single file so that COMPILER=clang compiles them too (the
+// other files of an app are built by the gcc linking command).
+//
+// The run prints the report of CoreMark, whose "Total ticks" are the cycles
+// of the timed part: CoreMark/MHz is Iterations * 10^6 / Total ticks. The
+// runs of a simulation are far shorter than the 10 s of the run rules, so
+// core_main reports that error; the checks of the CRCs still validate the
+// results. util/benchmarks.py builds and runs it for each core and compiler.
+
+#include <stdio.h>
+
+#include "csr.h"
+#include "x-heep.h"
+
+#if !__has_include("../../vendor/eembc_coremark/core_main.c")
+#error "CoreMark is not vendored: run util/vendor.py sw/vendor/eembc_coremark.vendor.hjson"
+#endif
+
+// Includes core_portme.h after the definition of TOTAL_DATA_SIZE
+#include "../../vendor/eembc_coremark/coremark.h"
+
+#define EE_TICKS_PER_SEC REFERENCE_CLOCK_Hz
+
+#if VALIDATION_RUN
+volatile ee_s32 seed1_volatile = 0x3415;
+volatile ee_s32 seed2_volatile = 0x3415;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PERFORMANCE_RUN
+volatile ee_s32 seed1_volatile = 0x0;
+volatile ee_s32 seed2_volatile = 0x0;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PROFILE_RUN
+volatile ee_s32 seed1_volatile = 0x8;
+volatile ee_s32 seed2_volatile = 0x8;
+volatile ee_s32 seed3_volatile = 0x8;
+#endif
+volatile ee_s32 seed4_volatile = ITERATIONS;
+volatile ee_s32 seed5_volatile = 0;
+
+ee_u32 default_num_contexts = 1;
+
+static CORETIMETYPE start_time_val, stop_time_val;
+
+void start_time(void)
+{
+    CSR_READ(CSR_REG_MCYCLE, &start_time_val);
+}
+
+void stop_time(void)
+{
+    CSR_READ(CSR_REG_MCYCLE, &stop_time_val);
+}
+
+CORE_TICKS get_time(void)
+{
+    return (CORE_TICKS)(stop_time_val - start_time_val);
+}
+
+secs_ret time_in_secs(CORE_TICKS ticks)
+{
+    return (secs_ret)ticks / (secs_ret)EE_TICKS_PER_SEC;
+}
+
+void portable_init(core_portable *p, int *argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    // enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    if (sizeof(ee_ptr_int) != sizeof(ee_u8 *)) {
+        printf("ERROR! Please define ee_ptr_int to a type that holds a pointer!\n");
+    }
+    if (sizeof(ee_u32) != 4) {
+        printf("ERROR! Please define ee_u32 to a 32b unsigned type!\n");
+    }
+    p->portable_id = 1;
+}
+
+void portable_fini(core_portable *p)
+{
+    p->portable_id = 0;
+}
+
+#include "../../vendor/eembc_coremark/core_list_join.c"
+#include "../../vendor/eembc_coremark/core_matrix.c"
+#include "../../vendor/eembc_coremark/core_state.c"
+#include "../../vendor/eembc_coremark/core_util.c"
+#include "../../vendor/eembc_coremark/core_main.c"
@@ -0,0 +1,18 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Board support of Embench-IoT for X-HEEP, included by its support.h.
+//
+// The workload of the benchmarks is scaled by CPU_MHZ. With 1, a run takes
+// about the baseline time of Embench at 1 MHz, and the cycles it takes give
+// the speed per MHz (util/benchmarks.py): baseline ms * 1000 / cycles.
+
+#ifndef BOARDSUPPORT_H
+#define BOARDSUPPORT_H
+
+#ifndef CPU_MHZ
+#define CPU_MHZ 1
+#endif
+
+#endif // BOARDSUPPORT_H
@@ -0,0 +1,118 @@
+// Copyright 2026 EPFL
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// A benchmark of Embench-IoT on X-HEEP, from the vendored sources
+// (util/vendor.py sw/vendor/embench_iot.vendor.hjson). The benchmark is
+// selected with APP_CFLAGS, e.g.
+//
+//     make app PROJECT=embench APP_CFLAGS=-DEMBENCH_EDN
+//
+// (crc32 by default) among the subset of the integer ones built from a
+// single file. It is built into this file with the support of Embench, so
+// that COMPILER=clang compiles it too.
+//
+// As the main of Embench, it warms the caches, times benchmark() with mcycle
+// and returns 0 if verify_benchmark accepts the result. It prints
+//
+//     EMBENCH,<benchmark>,<cycles>,<correct>
+//
+// for util/benchmarks.py, which turns the cycles into the relative speed of
+// Embench (see boardsupport.h).
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "x-heep.h"
+
+#if !__has_include("../../vendor/embench_iot/support/beebsc.c")
+#error "Embench-IoT is not vendored: run util/vendor.py sw/vendor/embench_iot.vendor.hjson"
+#endif
+
+#if defined(EMBENCH_AHA_MONT64)
+#define EMBENCH_NAME "aha-mont64"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/aha-mont64/mont64.c"
+#elif defined(EMBENCH_EDN)
+#define EMBENCH_NAME "edn"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/edn/libedn.c"
+#elif defined(EMBENCH_HUFFBENCH)
+#define EMBENCH_NAME "huffbench"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/huffbench/libhuffbench.c"
+#elif defined(EMBENCH_MATMULT_INT)
+#define EMBENCH_NAME "matmult-int"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/matmult-int/matmult-int.c"
+#elif defined(EMBENCH_NETTLE_AES)
+#define EMBENCH_NAME "nettle-aes"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/nettle-aes/nettle-aes.c"
+#elif defined(EMBENCH_NETTLE_SHA256)
+#define EMBENCH_NAME "nettle-sha256"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/nettle-sha256/nettle-sha256.c"
+#elif defined(EMBENCH_NSICHNEU)
+#define EMBENCH_NAME "nsichneu"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/nsichneu/libnsichneu.c"
+#elif defined(EMBENCH_SGLIB_COMBINED)
+#define EMBENCH_NAME "sglib-combined"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/sglib-combined/combined.c"
+#elif defined(EMBENCH_SLRE)
+#define EMBENCH_NAME "slre"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/slre/libslre.c"
+#elif defined(EMBENCH_STATEMATE)
+#define EMBENCH_NAME "statemate"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/statemate/libstatemate.c"
+#elif defined(EMBENCH_UD)
+#define EMBENCH_NAME "ud"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/ud/libud.c"
+#else
+#define EMBENCH_NAME "crc32"
+#define EMBENCH_SRC  "../../vendor/embench_iot/src/crc32/crc_32.c"
+#endif
+
+// support.h includes boardsupport.h, found in the directory of this app
+#define HAVE_BOARDSUPPORT_H 1
+#include "../../vendor/embench_iot/support/support.h"
+#include "../../vendor/embench_iot/support/beebsc.c"
+#include EMBENCH_SRC
+
+// Runs of benchmark() before the timed one, as in Embench
+#ifndef WARMUP_HEAT
+#define WARMUP_HEAT 1
+#endif
+
+static uint32_t start_cycles, stop_cycles;
+
+void initialise_board(void)
+{
+    // enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+}
+
+void __attribute__ ((noinline)) start_trigger(void)
+{
+    CSR_READ(CSR_REG_MCYCLE, &start_cycles);
+}
+
+void __attribute__ ((noinline)) stop_trigger(void)
+{
+    CSR_READ(CSR_REG_MCYCLE, &stop_cycles);
+}
+
+int main(int argc, char *argv[])
+{
+    volatile int result;
+    int correct;
+
+    initialise_board();
+    initialise_benchmark();
+    warm_caches(WARMUP_HEAT);
+
+    start_trigger();
+    result = benchmark();
+    stop_trigger();
+
+    correct = verify_benchmark(result);
+
+    printf("EMBENCH,%s,%u,%d\n", EMBENCH_NAME, stop_cycles - start_cycles, correct);
+
+    return !correct;
+}
@@ -0,0 +1,109 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Exercises the arena and pool allocators: per-frame scratch buffers in an
+// arena and message blocks from a pool, and reports their high-water marks.
+// The arena uses the .arena region of the linker script when arena_size is
+// set in mcu_cfg.hjson, and a static buffer otherwise.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "pool.h"
+#include "x-heep.h"
+
+#define FRAMES_N        8
+#define FRAME_BUF_B     100     // Not a multiple of ALLOC_ALIGN_B
+#define MSG_B           24
+#define MSGS_N          6
+
+/* By default printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+ALLOC_BUFFER(arena_buf, 1024, ".bss.arena_buf");
+ALLOC_BUFFER(pool_buf, MSG_B * MSGS_N, ".bss.pool_buf");
+
+static arena_t arena;
+static pool_t  pool;
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    void *msgs[MSGS_N + 1];
+
+    if (ALLOC_REGION_SIZE_B(arena) > 0) {
+        arena_init(&arena, ALLOC_REGION(arena));
+    } else {
+        arena_init(&arena, arena_buf, sizeof(arena_buf));
+    }
+
+    for (uint32_t f = 0; f < FRAMES_N; f++) {
+        // Each frame uses more buffers, the arena is emptied at its end
+        uint8_t *bufs[FRAMES_N];
+        for (uint32_t i = 0; i <= f; i++) {
+            bufs[i] = arena_alloc(&arena, FRAME_BUF_B);
+            if (bufs[i] == NULL || ((uintptr_t)bufs[i] & (ALLOC_ALIGN_B - 1))) {
+                errors++;
+                break;
+            }
+            for (uint32_t j = 0; j < FRAME_BUF_B; j++) bufs[i][j] = f + i;
+        }
+
+        // A scratch buffer released right away, and one with a larger alignment
+        size_t mark = arena_mark(&arena);
+        errors += arena_alloc_aligned(&arena, 16, 64) == NULL;
+        arena_release(&arena, mark);
+        errors += arena_mark(&arena) != mark;
+
+        for (uint32_t i = 0; i <= f; i++) {
+            for (uint32_t j = 0; j < FRAME_BUF_B; j++) errors += bufs[i][j] != (uint8_t)(f + i);
+        }
+        arena_reset(&arena);
+    }
+
+    // More than the arena can hold must fail without changing it
+    errors += arena_alloc(&arena, arena_free_b(&arena) + 1) != NULL;
+    errors += arena_alloc(&arena, (size_t)-1) != NULL;
+    errors += arena_mark(&arena) != 0;
+
+    errors += pool_init(&pool, pool_buf, sizeof(pool_buf), MSG_B) != MSGS_N;
+    for (uint32_t i = 0; i < MSGS_N; i++) {
+        msgs[i] = pool_alloc(&pool);
+        errors += msgs[i] == NULL;
+    }
+    // The pool is empty
+    msgs[MSGS_N] = pool_alloc(&pool);
+    errors += msgs[MSGS_N] != NULL;
+    // Free in another order and allocate again
+    for (uint32_t i = 0; i < MSGS_N; i += 2) pool_free(&pool, msgs[i]);
+    for (uint32_t i = 1; i < MSGS_N; i += 2) pool_free(&pool, msgs[i]);
+    errors += pool_free_n(&pool) != MSGS_N;
+    errors += pool_alloc(&pool) == NULL;
+
+#if ALLOC_USAGE_TRACKING
+    PRINTF("arena: %u B, peak %u B, %u failures\n\r", arena.size_b, arena_peak_b(&arena), arena_failures(&arena));
+    PRINTF("pool: %u blocks of %u B, peak %u, %u failures\n\r", pool.blocks_n, pool.block_b, pool_peak_n(&pool), pool_failures(&pool));
+    errors += arena_peak_b(&arena) < FRAMES_N * ALLOC_ROUND_UP(FRAME_BUF_B, ALLOC_ALIGN_B);
+    errors += arena_failures(&arena) != 2;
+    errors += pool_peak_n(&pool) != MSGS_N || pool_failures(&pool) != 1;
+#endif
+
+    if (errors == 0) {
+        PRINTF("Allocators test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Allocators test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
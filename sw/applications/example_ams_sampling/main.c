@@ -0,0 +1,109 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Periodic sampling of the ADC of the AMS peripheral: the pacing counter of
+// the AMS takes a sample every period and the DMA moves it to a ring of
+// frames, while the CPU sleeps until the end of each frame. The CPU checks
+// that no sample was lost from the indexes of the samples.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "ams.h"
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+#ifdef TARGET_PYNQ_Z2
+  #error ( "This app does NOT work on the FPGA as it relies on the simulator testbench" )
+#endif
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// a sample every 256 cycles of the system clock
+#define PERIOD_CYCLES   256
+#define FRAME_LEN       8
+#define FRAMES_N        6
+#define RING_FRAMES     3
+#define DMA_CH          0
+
+static ams_capture_t capture;
+static uint32_t ring[RING_FRAMES][FRAME_LEN] __attribute__ ((aligned (4)));
+
+int main(int argc, char *argv[])
+{
+    bool success = true;
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    dma_init(NULL);
+
+    ams_capture_cfg_t cfg = {
+        .threshold = kAmsThreshold40,
+        .sample_rate_hz = soc_ctrl_get_frequency(&soc_ctrl) / PERIOD_CYCLES,
+        .frame_len = FRAME_LEN,
+        .frames = RING_FRAMES,
+        .buffer = &ring[0][0],
+        .dma_ch = DMA_CH,
+        .wake_on_alert = false,
+        .cb = NULL,
+    };
+
+    if (ams_capture_start(&capture, &cfg) != kAmsOk) {
+        PRINTF("AMS capture start failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    uint32_t index = 0;
+    for (uint32_t n = 0; n < FRAMES_N; n++) {
+        const uint32_t *frame;
+        // the interrupts are disabled around the check so that the frame
+        // interrupt cannot arrive between the check and the wfi
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        while ((frame = ams_capture_peek(&capture)) == NULL) {
+            wait_for_interrupt();
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+        for (int i = 0; i < FRAME_LEN; i++) {
+            if (AMS_SAMPLE_INDEX(frame[i]) != (index & 0xffff)) {
+                PRINTF("ERROR frame %d sample %d index %d\n\r", n, i, AMS_SAMPLE_INDEX(frame[i]));
+                success = false;
+            }
+            index++;
+        }
+        ams_capture_release(&capture);
+    }
+
+    ams_capture_stats_t stats;
+    ams_capture_get_stats(&capture, &stats);
+    PRINTF("Frames %d, overruns %d, sample overrun %d\n\r", stats.frames, stats.overruns, stats.sample_overrun);
+    if (stats.sample_overrun) {
+        success = false;
+    }
+    ams_capture_stop(&capture);
+
+    if (success) {
+        PRINTF("Success.\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure.\n\r");
+        return EXIT_FAILURE;
+    }
+}
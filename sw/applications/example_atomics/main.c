@@ -0,0 +1,145 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the operations of the atomic unit, then updates two of its words
+// from the main loop and from a fast interrupt (timer 1, raised by its
+// INTR_TEST register right before each update of the main loop) without
+// masking the interrupts, and compares the cycles of an increment with the
+// interrupts masked and of an atomic one.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"  // Generated.
+#include "atomics.h"
+
+/* The cycles are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define RUNS_N      64
+#define ISR_ADDEND  1000
+
+// The words of the unit used by the test
+#define WORD_OPS    0
+#define WORD_COUNT  1
+#define WORD_SUM    2
+#define WORD_LOCK   3
+
+// The INTR_TEST register of the hart 1 of the AO timer
+#define TIMER_1_INTR_TEST \
+    ((volatile uint32_t *)(RV_TIMER_AO_START_ADDRESS + RV_TIMER_INTR_TEST0_REG_OFFSET + 0x100))
+
+static rv_timer_t timer_0_1;
+static volatile uint32_t isr_runs;
+static volatile uint32_t plain_count;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static void timer_1_handler(uint32_t id)
+{
+    rv_timer_irq_clear(&timer_0_1, 1, 0);
+    clear_fast_interrupt(kTimer_1_fic_e);
+
+    atomics_fetch_inc(WORD_COUNT);
+    // Lands in the middle of the compare-and-swap of the main loop, which retries
+    atomics_fetch_add(WORD_SUM, ISR_ADDEND);
+    isr_runs++;
+}
+
+static int check_ops(void)
+{
+    int errors = 0;
+
+    atomics_store(WORD_OPS, 5);
+    errors += atomics_fetch_inc(WORD_OPS) != 5;
+    errors += atomics_fetch_dec(WORD_OPS) != 6;
+    atomics_add(WORD_OPS, (uint32_t)-3);
+    errors += atomics_load(WORD_OPS) != 2;
+    errors += atomics_compare_and_swap(WORD_OPS, 3, 7);
+    errors += !atomics_compare_and_swap(WORD_OPS, 2, 7);
+    errors += atomics_load(WORD_OPS) != 7;
+
+    errors += atomics_test_and_set(WORD_LOCK) != 0;
+    errors += atomics_test_and_set(WORD_LOCK) != 1;
+    atomics_unlock(WORD_LOCK);
+    atomics_lock(WORD_LOCK);
+    errors += atomics_load(WORD_LOCK) != 1;
+    atomics_unlock(WORD_LOCK);
+
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t expected_sum = 0;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    if (check_ops() != 0) {
+        PRINTF("Atomic operations failure\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // The counter of the timer stays disabled, only the test raises its interrupt
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_irq_enable(&timer_0_1, 1, 0, kRvTimerEnabled);
+    irq_register(IRQ_SRC_FAST(kTimer_1_fic_e), timer_1_handler);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), true);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    atomics_store(WORD_COUNT, 0);
+    atomics_store(WORD_SUM, 0);
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        *TIMER_1_INTR_TEST = 1;
+        atomics_fetch_add(WORD_SUM, i);
+        atomics_fetch_inc(WORD_COUNT);
+        expected_sum += i + ISR_ADDEND;
+        while (isr_runs != i + 1) {
+        }
+    }
+
+    // The increment of a shared variable in RAM needs the interrupts masked
+    TIME(for (uint32_t i = 0; i < RUNS_N; i++) {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        plain_count++;
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    });
+    uint32_t masked_cycles = cycles;
+    TIME(for (uint32_t i = 0; i < RUNS_N; i++) {
+        atomics_fetch_inc(WORD_OPS);
+    });
+    uint32_t atomic_cycles = cycles;
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), false);
+
+    PRINTF("%u increments: masked %u cycles, atomic %u cycles\n\r", RUNS_N, masked_cycles, atomic_cycles);
+
+    if (atomics_load(WORD_COUNT) == 2 * RUNS_N && atomics_load(WORD_SUM) == expected_sum) {
+        PRINTF("Atomics test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Atomics test failure: count %u sum %u\n\r", atomics_load(WORD_COUNT), atomics_load(WORD_SUM));
+        return EXIT_FAILURE;
+    }
+}
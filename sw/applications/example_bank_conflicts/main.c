@@ -0,0 +1,207 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Bank conflict benchmark: the CPU sums a buffer while the DMA copies
+// another one, with the buffers in the same bank, in banks of their own and
+// in the interleaved banks. It reports the cycles of each alone and both at
+// once: the difference is the time lost waiting for a bank taken by the
+// other master. The buffers in the same bank are then measured again with
+// the priority of the CPU over the DMA, and with the DMA throttled.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bank_sections.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "ram_banks.h"
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+#define BENCH_WORDS     1024    // Words of each buffer
+#define BENCH_BYTES     (BENCH_WORDS * 4)
+#define BENCH_PASSES    4       // Passes of the CPU over its buffer, to last about as long as the copy
+#define BENCH_THROTTLE  3       // Cycles of the DMA ports after each grant, in the throttled run
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+typedef struct {
+    const char *name;
+    uint32_t   *cpu;
+    uint32_t   *src;
+    uint32_t   *dst;
+} bench_placement_t;
+
+// All in the data bank, with the stack
+static uint32_t default_cpu[BENCH_WORDS];
+static uint32_t default_src[BENCH_WORDS];
+static uint32_t default_dst[BENCH_WORDS];
+
+#if MEMORY_BANKS_CONT >= 4
+// The CPU and the DMA source in banks of their own
+static uint32_t split_cpu[BENCH_WORDS] XHEEP_SECTION_BANK(3);
+static uint32_t split_src[BENCH_WORDS] XHEEP_SECTION_BANK(2);
+#endif
+
+#if MEMORY_BANKS_IL > 0 && MEMORY_BANKS_CONT > 1
+static uint32_t il_cpu[BENCH_WORDS] XHEEP_SECTION_INTERLEAVED;
+static uint32_t il_src[BENCH_WORDS] XHEEP_SECTION_INTERLEAVED;
+static uint32_t il_dst[BENCH_WORDS] XHEEP_SECTION_INTERLEAVED;
+#endif
+
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+static volatile uint32_t sum;
+
+static void bench_dma_load(uint32_t *src, uint32_t *dst)
+{
+    tgt_src.env     = NULL;
+    tgt_src.ptr     = (uint8_t *)src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = BENCH_WORDS;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.env     = NULL;
+    tgt_dst.ptr     = (uint8_t *)dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.win_du    = 0;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+    trans.size_d2   = 0;
+
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+}
+
+// Streams through the buffer, returns the cycles
+static uint32_t bench_cpu(const uint32_t *buf)
+{
+    uint32_t start, end;
+    uint32_t acc = 0;
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    for (uint32_t p = 0; p < BENCH_PASSES; p++) {
+        for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+            acc += buf[i];
+        }
+    }
+    CSR_READ(CSR_REG_MCYCLE, &end);
+
+    sum = acc;
+    return end - start;
+}
+
+// Runs the CPU alone, the DMA alone and both, returns the errors in the copies
+static uint32_t bench_run(const bench_placement_t *pl)
+{
+    dma_perf_t alone, both;
+    uint32_t cpu_alone, cpu_both;
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        pl->cpu[i] = i;
+        pl->src[i] = i * 7;
+    }
+
+    PRINTF("%s: banks cpu 0x%x src 0x%x dst 0x%x\n\r", pl->name,
+           ram_banks_holding(pl->cpu, BENCH_BYTES),
+           ram_banks_holding(pl->src, BENCH_BYTES),
+           ram_banks_holding(pl->dst, BENCH_BYTES));
+
+    cpu_alone = bench_cpu(pl->cpu);
+
+    bench_dma_load(pl->src, pl->dst);
+    dma_launch(&trans);
+    while (!dma_is_ready(0));
+    dma_get_perf(0, &alone);
+
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        pl->dst[i] = 0;
+    }
+
+    bench_dma_load(pl->src, pl->dst);
+    dma_launch(&trans);
+    cpu_both = bench_cpu(pl->cpu);
+    while (!dma_is_ready(0));
+    dma_get_perf(0, &both);
+
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        if (pl->dst[i] != pl->src[i]) errors++;
+    }
+
+    // Bytes per 100 cycles, to print the bandwidth without floats
+    PRINTF("%s: cpu %u -> %u (+%u) | dma busy %u -> %u rstall %u -> %u wstall %u -> %u | B/100cyc dma %u -> %u%s\n\r",
+           pl->name, cpu_alone, cpu_both, cpu_both > cpu_alone ? cpu_both - cpu_alone : 0,
+           alone.busy, both.busy, alone.read_stall, both.read_stall, alone.write_stall, both.write_stall,
+           alone.busy ? (100 * BENCH_BYTES) / alone.busy : 0,
+           both.busy ? (100 * BENCH_BYTES) / both.busy : 0,
+           errors ? " ERROR" : "");
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    bench_placement_t placements[] = {
+        { "default", default_cpu, default_src, default_dst },
+#if MEMORY_BANKS_CONT >= 4
+        { "split", split_cpu, split_src, default_dst },
+#endif
+#if MEMORY_BANKS_IL > 0 && MEMORY_BANKS_CONT > 1
+        { "interleaved", il_cpu, il_src, il_dst },
+#endif
+    };
+
+#ifdef BUS_TYPE_ONETOM
+    PRINTF("onetoM bus: the masters share the bus, the placement does not matter\n\r");
+#endif
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_init(NULL);
+
+    for (uint32_t p = 0; p < sizeof(placements) / sizeof(placements[0]); p++) {
+        errors += bench_run(&placements[p]);
+    }
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    // The buffers in the same bank, the CPU first then the DMA throttled
+    bench_placement_t qos = placements[0];
+    qos.name = "cpu prio";
+    soc_ctrl_set_bus_qos(&soc_ctrl, true, 0);
+    errors += bench_run(&qos);
+    qos.name = "dma throttle";
+    soc_ctrl_set_bus_qos(&soc_ctrl, false, BENCH_THROTTLE);
+    errors += bench_run(&qos);
+    soc_ctrl_set_bus_qos(&soc_ctrl, false, 0);
+
+    if (errors == 0) {
+        PRINTF("Bank conflict benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Bank conflict benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,245 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Synthetic traffic on the system bus, to compare the onetoM and NtoM bus
+// types (util/bus_bench.py runs it under both). Three masters generate it:
+// - cpu: the CPU streams through a buffer, a load per word;
+// - dma: the DMA copies a buffer;
+// - ext: the DMA of the testbench (memcopy controller at
+//   EXT_PERIPHERAL_START_ADDRESS) copies a buffer through ext_xbar, in
+//   simulation only.
+// Each phase runs some of them at once and prints a line
+//   BUS_BENCH,<phase>,<cycles>,<bytes>,<cpu waits>,<cpu latency>,<dma waits>,<dma latency>,<ext waits>,<ext latency>
+// with the bytes moved by the masters, the cycles their requests waited for
+// a grant and their average latency x100, both from the bus monitor (0
+// without its counters).
+//
+// With at least 6 contiguous banks, the buffers of each master are in banks
+// of their own (MEMORY_BANKS=6 in mcu-gen), so that the NtoM bus can serve
+// them in parallel; otherwise they share the data bank.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bank_sections.h"
+#include "bus_monitor.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "x-heep.h"
+
+#define BENCH_WORDS     1024    // Words of each buffer
+#define BENCH_BYTES     (BENCH_WORDS * 4)
+#define BENCH_PASSES    2       // Passes of the CPU over its buffer
+
+#define BENCH_CPU       0x1
+#define BENCH_DMA       0x2
+#define BENCH_EXT       0x4
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#if MEMORY_BANKS_CONT >= 6
+static uint32_t dma_src[BENCH_WORDS] XHEEP_SECTION_BANK(2);
+static uint32_t dma_dst[BENCH_WORDS] XHEEP_SECTION_BANK(3);
+static uint32_t ext_src[BENCH_WORDS] XHEEP_SECTION_BANK(4);
+static uint32_t ext_dst[BENCH_WORDS] XHEEP_SECTION_BANK(5);
+#else
+static uint32_t dma_src[BENCH_WORDS];
+static uint32_t dma_dst[BENCH_WORDS];
+static uint32_t ext_src[BENCH_WORDS];
+static uint32_t ext_dst[BENCH_WORDS];
+#endif
+static uint32_t cpu_buf[BENCH_WORDS];
+
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+static volatile uint32_t sum;
+
+static const bus_monitor_t bus_monitor = {
+    .base_addr = { .base = (void *)BUS_MONITOR_START_ADDRESS },
+};
+
+typedef struct {
+    uint32_t waits;
+    uint32_t latency_x100;
+} bench_port_t;
+
+static void bench_dma_load(void)
+{
+    tgt_src.ptr     = (uint8_t *)dma_src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = BENCH_WORDS;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.ptr     = (uint8_t *)dma_dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+}
+
+#if TARGET_SIM
+// The testbench DMA is programmed directly: the driver drives one DMA per channel.
+static volatile dma *const ext_dma = (volatile dma *)EXT_PERIPHERAL_START_ADDRESS;
+
+static void bench_ext_launch(void)
+{
+    ext_dma->SRC_PTR       = (uint32_t)ext_src;
+    ext_dma->DST_PTR       = (uint32_t)ext_dst;
+    ext_dma->PTR_INC       = (4 << DMA_PTR_INC_SRC_PTR_INC_OFFSET) | (4 << DMA_PTR_INC_DST_PTR_INC_OFFSET);
+    ext_dma->SLOT          = 0;
+    ext_dma->DATA_TYPE     = DMA_DATA_TYPE_WORD;
+    ext_dma->DST_DATA_TYPE = DMA_DATA_TYPE_WORD;
+    ext_dma->MODE          = DMA_TRANS_MODE_SINGLE;
+    ext_dma->INTERRUPT_EN  = 0;
+    ext_dma->SIZE          = BENCH_BYTES;
+}
+
+static bool bench_ext_done(void)
+{
+    return ext_dma->STATUS & (1 << DMA_STATUS_READY_BIT);
+}
+#else
+static void bench_ext_launch(void) {}
+static bool bench_ext_done(void) { return true; }
+#endif
+
+static void bench_cpu(void)
+{
+    uint32_t acc = 0;
+
+    for (uint32_t p = 0; p < BENCH_PASSES; p++) {
+        for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+            acc += cpu_buf[i];
+        }
+    }
+    sum = acc;
+}
+
+// Waits and average latency x100 of a set of master ports
+static bench_port_t bench_ports(uint32_t first, uint32_t count)
+{
+    bus_monitor_stats_t stats;
+    uint32_t latency = 0, rvalids = 0;
+    bench_port_t port = { 0, 0 };
+
+    for (uint32_t m = first; m < first + count; m++) {
+        bus_monitor_get_master(&bus_monitor, m, &stats);
+        port.waits += stats.waits;
+        latency    += stats.latency;
+        rvalids    += stats.rvalids;
+    }
+    port.latency_x100 = rvalids ? (uint32_t)((100ULL * latency) / rvalids) : 0;
+    return port;
+}
+
+// Runs the masters of a phase at once, returns the errors in the copies
+static uint32_t bench_phase(const char *name, uint32_t masters)
+{
+    uint32_t start, end;
+    uint32_t bytes = 0;
+    uint32_t errors = 0;
+    bench_port_t cpu, dmap, ext;
+
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        dma_dst[i] = 0;
+        ext_dst[i] = 0;
+    }
+    if (masters & BENCH_DMA) {
+        bench_dma_load();
+    }
+
+    bus_monitor_clear(&bus_monitor);
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    if (masters & BENCH_EXT) {
+        bench_ext_launch();
+    }
+    if (masters & BENCH_DMA) {
+        dma_launch(&trans);
+    }
+    if (masters & BENCH_CPU) {
+        bench_cpu();
+    }
+    while ((masters & BENCH_DMA) && !dma_is_ready(0));
+    while ((masters & BENCH_EXT) && !bench_ext_done());
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    bus_monitor_enable(&bus_monitor, false);
+
+    cpu  = bench_ports(BUS_MONITOR_CORE_DATA_IDX, 1);
+    dmap = bench_ports(BUS_MONITOR_DMA_READ_IDX(0), 2);
+    ext  = bench_ports(BUS_MONITOR_EXT_MASTER_IDX(0), 2);
+    bus_monitor_enable(&bus_monitor, true);
+
+    if (masters & BENCH_CPU) {
+        bytes += BENCH_BYTES * BENCH_PASSES;
+    }
+    if (masters & BENCH_DMA) {
+        bytes += BENCH_BYTES;
+        for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+            if (dma_dst[i] != dma_src[i]) errors++;
+        }
+    }
+    if (masters & BENCH_EXT) {
+        bytes += BENCH_BYTES;
+        for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+            if (ext_dst[i] != ext_src[i]) errors++;
+        }
+    }
+
+    PRINTF("BUS_BENCH,%s,%u,%u,%u,%u,%u,%u,%u,%u\n\r", name, end - start, bytes,
+           cpu.waits, cpu.latency_x100, dmap.waits, dmap.latency_x100, ext.waits, ext.latency_x100);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        cpu_buf[i] = i;
+        dma_src[i] = i * 3;
+        ext_src[i] = i * 5;
+    }
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_init(NULL);
+
+    PRINTF("BUS_BENCH,phase,cycles,bytes,cpu_waits,cpu_latency_x100,dma_waits,dma_latency_x100,ext_waits,ext_latency_x100\n\r");
+    errors += bench_phase("cpu", BENCH_CPU);
+    errors += bench_phase("dma", BENCH_DMA);
+    errors += bench_phase("cpu+dma", BENCH_CPU | BENCH_DMA);
+#if TARGET_SIM
+    errors += bench_phase("ext", BENCH_EXT);
+    errors += bench_phase("dma+ext", BENCH_DMA | BENCH_EXT);
+    errors += bench_phase("cpu+dma+ext", BENCH_CPU | BENCH_DMA | BENCH_EXT);
+#endif
+
+    if (errors == 0) {
+        PRINTF("Bus benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Bus benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Reads the bus monitor around a DMA copy run while the CPU reads another
+// buffer, and prints the counters of each port of the system crossbar: the
+// transactions, the cycles waited for a grant and the average latency.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bus_monitor.h"
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "x-heep.h"
+
+#define TEST_WORDS      512
+
+/* The counters are the output of the example, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static uint32_t src[TEST_WORDS];
+static uint32_t dst[TEST_WORDS];
+static uint32_t cpu_buf[TEST_WORDS];
+static volatile uint32_t sum;
+
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+
+static void print_port(const bus_monitor_t *bus_monitor, const char *name, bool master, uint32_t idx)
+{
+    bus_monitor_stats_t stats;
+
+    if (master) {
+        bus_monitor_get_master(bus_monitor, idx, &stats);
+    } else {
+        bus_monitor_get_slave(bus_monitor, idx, &stats);
+    }
+    // Latency in hundredths of cycles, to print it without floats
+    PRINTF("%s: grants %u waits %u rvalids %u latency/100 %u\n\r", name,
+           stats.grants, stats.waits, stats.rvalids,
+           stats.rvalids ? (uint32_t)((100ULL * stats.latency) / stats.rvalids) : 0);
+}
+
+int main(int argc, char *argv[])
+{
+    bus_monitor_t bus_monitor = { .base_addr = mmio_region_from_addr((uintptr_t)BUS_MONITOR_START_ADDRESS) };
+    uint32_t masters, slaves;
+    uint32_t acc = 0;
+    uint32_t errors = 0;
+    char name[16];
+
+    bus_monitor_get_ports(&bus_monitor, &masters, &slaves);
+    if (masters == 0) {
+        PRINTF("The bus monitor has no counters, set counters to \"yes\" in mcu_cfg.hjson\n\r");
+        return EXIT_SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < TEST_WORDS; i++) {
+        src[i] = i * 3;
+        cpu_buf[i] = i;
+    }
+
+    tgt_src.ptr     = (uint8_t *)src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = TEST_WORDS;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.ptr     = (uint8_t *)dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+
+    dma_init(NULL);
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+
+    bus_monitor_clear(&bus_monitor);
+    dma_launch(&trans);
+    for (uint32_t i = 0; i < TEST_WORDS; i++) {
+        acc += cpu_buf[i];
+    }
+    while (!dma_is_ready(0));
+    bus_monitor_enable(&bus_monitor, false);
+    sum = acc;
+
+    for (uint32_t i = 0; i < TEST_WORDS; i++) {
+        if (dst[i] != src[i]) errors++;
+    }
+
+    PRINTF("%u cycles, %u masters, %u slaves\n\r", bus_monitor_get_cycles(&bus_monitor), masters, slaves);
+    print_port(&bus_monitor, "core instr", true, BUS_MONITOR_CORE_INSTR_IDX);
+    print_port(&bus_monitor, "core data", true, BUS_MONITOR_CORE_DATA_IDX);
+    print_port(&bus_monitor, "dma read", true, BUS_MONITOR_DMA_READ_IDX(0));
+    print_port(&bus_monitor, "dma write", true, BUS_MONITOR_DMA_WRITE_IDX(0));
+    for (uint32_t b = 0; b < MEMORY_BANKS; b++) {
+        snprintf(name, sizeof(name), "ram%u", (unsigned int)b);
+        print_port(&bus_monitor, name, false, BUS_MONITOR_RAM_IDX(b));
+    }
+    print_port(&bus_monitor, "ao periph", false, BUS_MONITOR_AO_PERIPHERAL_IDX);
+
+    bus_monitor_enable(&bus_monitor, true);
+
+    if (errors == 0) {
+        PRINTF("Bus monitor example done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Bus monitor example failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,112 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Uses the gpio, the spi2 and the i2c of the peripheral domain one after the
+// other and together, and checks that the clock of the domain is enabled while
+// any of them is in use and gated as soon as none is, without the application
+// touching the clock gates as example_clock_gating does.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "power_manager.h"
+#include "clock_gate.h"
+#include "gpio.h"
+#include "spi_host.h"
+#include "i2c.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define GPIO_PERIPH_PIN 8
+
+static power_manager_t power_manager;
+static uint32_t errors = 0;
+
+// the register of the power manager, not the bookkeeping of the manager
+static void check_gated(const char *step, bool gated, uint32_t users)
+{
+    uint32_t reg = mmio_region_read32(power_manager.base_addr, (ptrdiff_t)(POWER_MANAGER_PERIPH_CLK_GATE_REG_OFFSET));
+
+    PRINTF("%s: %u users, %s\n\r", step, clock_gate_count(CLOCK_GATE_PERIPH), reg ? "gated" : "clocked");
+    if ((reg != 0) != gated || clock_gate_count(CLOCK_GATE_PERIPH) != users)
+    {
+        PRINTF("Error: %s\n\r", step);
+        errors++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    spi_host_t spi2;
+    i2c_t i2c;
+    const gpio_cfg_t gpio_cfg = {.pin = GPIO_PERIPH_PIN, .mode = GpioModeOutPushPull};
+
+    power_manager.base_addr = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+    spi2.base_addr = mmio_region_from_addr((uintptr_t)SPI2_START_ADDRESS);
+    i2c_init((i2c_params_t){.base_addr = mmio_region_from_addr((uintptr_t)I2C_START_ADDRESS)}, &i2c);
+
+    if (clock_gate_init(&power_manager) != kPowerManagerOk_e)
+    {
+        PRINTF("Error: clock gate init fail.\n\r");
+        return EXIT_FAILURE;
+    }
+    check_gated("init", true, 0);
+
+    // one user at a time
+    gpio_config(gpio_cfg);
+    gpio_write(GPIO_PERIPH_PIN, true);
+    check_gated("gpio configured", false, 1);
+    gpio_reset(GPIO_PERIPH_PIN);
+    check_gated("gpio reset", true, 0);
+
+    spi_set_enable(&spi2, true);
+    spi_set_enable(&spi2, true);
+    check_gated("spi2 enabled", false, 1);
+    spi_set_enable(&spi2, false);
+    check_gated("spi2 disabled", true, 0);
+
+    // the registers of a disabled i2c are clocked for the access only
+    i2c_irq_disable_all(&i2c, NULL);
+    check_gated("i2c access", true, 0);
+    i2c_host_set_enabled(&i2c, kDifI2cToggleEnabled);
+    check_gated("i2c enabled", false, 1);
+
+    // overlapping users: the clock stays on until the last one is done
+    spi_set_enable(&spi2, true);
+    gpio_config(gpio_cfg);
+    check_gated("i2c, spi2, gpio", false, 3);
+    i2c_host_set_enabled(&i2c, kDifI2cToggleDisabled);
+    spi_set_enable(&spi2, false);
+    check_gated("gpio only", false, 1);
+    gpio_reset(GPIO_PERIPH_PIN);
+    check_gated("none", true, 0);
+
+    if (clock_gate_release(CLOCK_GATE_PERIPH) == kPowerManagerOk_e)
+    {
+        PRINTF("Error: release of a free domain.\n\r");
+        errors++;
+    }
+
+    if (errors)
+    {
+        PRINTF("Error: %u wrong clock gates.\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+    /* write something to stdout */
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Changes the frequency of the system clock at runtime and checks that the
+// registered drivers follow it: the always-on rv_timer keeps counting at 1 MHz
+// and the UART keeps its baudrate. The notifiers must be called
+// before the change, then after it, in the order of their registration.
+//
+// Without a clock generator (soc_clock_apply() is not replaced) the clock does
+// not actually change, so the console is garbled until the original frequency
+// is restored: the printfs are disabled in simulation.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csr.h"
+#include "bitfield.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"
+#include "uart.h"
+#include "uart_regs.h"
+#include "soc_ctrl.h"
+#include "soc_ctrl_clock.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static rv_timer_t timer_0_1;
+static rv_timer_clock_t timer_clock;
+static const uint64_t kTickFreqHz = 1000 * 1000; // 1 MHz
+
+static uart_t uart;
+
+static soc_clock_notifier_t timer_notifier;
+static soc_clock_notifier_t uart_notifier;
+static soc_clock_notifier_t order_notifier;
+
+// the events seen by order_cb, registered after the timer
+static volatile uint32_t pre_calls, post_calls, order_errors;
+
+static void order_cb(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz, void *ctx)
+{
+    if (event == kSocClockPreChange_e) {
+        // interrupts are enabled before the change
+        uint32_t mstatus;
+        CSR_READ(CSR_REG_MSTATUS, &mstatus);
+        if (!(mstatus & 0x8) || pre_calls != post_calls)
+            order_errors++;
+        pre_calls++;
+    } else {
+        // the timer has already been re-timed
+        rv_timer_tick_params_t p;
+        uint32_t cfg = mmio_region_read32(timer_0_1.base_addr, RV_TIMER_CFG0_REG_OFFSET);
+        rv_timer_approximate_tick_params(new_hz, kTickFreqHz, &p);
+        if (pre_calls != post_calls + 1 ||
+            bitfield_field32_read(cfg, RV_TIMER_CFG0_PRESCALE_FIELD) != p.prescale ||
+            bitfield_field32_read(cfg, RV_TIMER_CFG0_STEP_FIELD) != p.tick_step)
+            order_errors++;
+        post_calls++;
+    }
+}
+
+// the NCO of the UART at freq_hz: 16 * 2^16 * baud / fclk
+static uint32_t expected_nco(uint32_t freq_hz)
+{
+    return (((uint64_t)UART_BAUDRATE << 20) / freq_hz) & UART_CTRL_NCO_MASK;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t nominal_hz = soc_clock_get_frequency();
+    const uint32_t freqs[] = {nominal_hz / 2, nominal_hz / 4, nominal_hz};
+
+    PRINTF("Clock scaling from %u Hz\n\r", nominal_hz);
+
+    // the UART of the console, which also follows the clock once printf has
+    // initialized it
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = nominal_hz;
+    if (uart_init(&uart) != kErrorOk) {
+        PRINTF("Error: uart init fail.\n\r");
+        return EXIT_FAILURE;
+    }
+
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS), (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_tick_params_t tick_params;
+    rv_timer_approximate_tick_params(nominal_hz, kTickFreqHz, &tick_params);
+    rv_timer_set_tick_params(&timer_0_1, 0, tick_params);
+    rv_timer_counter_set_enabled(&timer_0_1, 0, kRvTimerEnabled);
+
+    timer_clock.timer = &timer_0_1;
+    timer_clock.hart_id = 0;
+    timer_clock.tick_hz = kTickFreqHz;
+    soc_clock_register(&timer_notifier, rv_timer_clock_notifier, &timer_clock);
+    soc_clock_register(&uart_notifier, uart_clock_notifier, &uart);
+    soc_clock_register(&order_notifier, order_cb, NULL);
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    for (int i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++)
+    {
+        if (soc_clock_set_frequency(freqs[i]) != kSocClockOk_e) {
+            errors++;
+            continue;
+        }
+        if (soc_clock_get_frequency() != freqs[i])
+            errors++;
+
+        uint32_t ctrl = mmio_region_read32(uart.base_addr, UART_CTRL_REG_OFFSET);
+        if (uart.clk_freq_hz != freqs[i] ||
+            bitfield_field32_read(ctrl, UART_CTRL_NCO_FIELD) != expected_nco(freqs[i]))
+            errors++;
+
+        PRINTF("%u Hz: nco 0x%x\n\r", freqs[i], bitfield_field32_read(ctrl, UART_CTRL_NCO_FIELD));
+    }
+
+    soc_clock_unregister(&order_notifier);
+    soc_clock_unregister(&uart_notifier);
+    soc_clock_unregister(&timer_notifier);
+
+    errors += order_errors;
+    if (pre_calls != sizeof(freqs) / sizeof(freqs[0]) || post_calls != pre_calls)
+        errors++;
+
+    if (errors)
+    {
+        PRINTF("Error: %u drivers not re-timed.\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Benchmarks the streaming compressors: the predictor and Rice codes of
+// rice.h on audio samples, in 32-bit words like the buffers of I2S or PDM2PCM
+// filled by the DMA, and the LZSS of lzss.h on log lines. The inputs are
+// encoded a block at a time, as they would be while a DMA fills the next
+// block, then the streams are decoded and compared with them. The cycles per
+// byte and the ratios are of the payload: the bits of the samples, here 16.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csr.h"
+#include "lzss.h"
+#include "rice.h"
+#include "x-heep.h"
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define N_SAMPLES   1024
+#define BLOCK       256     // Samples of a DMA buffer
+#define BITS        16
+#define TEXT_B      2048
+#define TEXT_BLOCK  256     // Bytes of a log buffer
+
+static int32_t samples[N_SAMPLES];
+static int32_t decoded[N_SAMPLES];
+static uint8_t stream[RICE_BOUND_B(N_SAMPLES, BITS, RICE_ORDER_MAX) + LZSS_BOUND_B(TEXT_B)];
+static char text[TEXT_B];
+static uint8_t text_out[TEXT_B];
+static rice_enc_t rice;
+static lzss_enc_t lzss;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static uint32_t seed = 1;
+
+static uint32_t rand_lcg(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 16;
+}
+
+// Two tones from Q15 resonators, of amplitudes about 20000 and 15000, and
+// some noise, the channels interleaved
+static void make_audio(uint32_t channels)
+{
+    int32_t y1[2] = {0, 0}, y2[2] = {-1956, -4134};
+    const int32_t c[2] = {32610, 31500};
+    for (uint32_t i = 0; i < N_SAMPLES; i++) {
+        uint32_t ch = i % channels;
+        int32_t y = ((2 * c[ch] * y1[ch]) >> 15) - y2[ch];
+        y2[ch] = y1[ch];
+        y1[ch] = y;
+        // The bits above the sample are not used, as in a word of I2S
+        samples[i] = (y + (int32_t)(rand_lcg() & 31) - 16) | 0x5A0000;
+    }
+}
+
+static void make_text(void)
+{
+    uint32_t n = 0;
+    for (uint32_t t = 0; n + 64 < TEXT_B; t += 10) {
+        n += snprintf(text + n, TEXT_B - n, "t=%u temp=%u.%u hum=%u%% batt=%umV %s\n",
+                      (unsigned)t, (unsigned)(20 + rand_lcg() % 5), (unsigned)(rand_lcg() % 10),
+                      (unsigned)(40 + rand_lcg() % 3), (unsigned)(3700 - t / 10),
+                      rand_lcg() % 8 ? "ok" : "warn");
+    }
+    memset(text + n, ' ', TEXT_B - n);
+}
+
+// Prints cycles per byte and the ratio with one decimal
+static void report(const char *name, uint32_t in_b, uint32_t out_b, uint32_t enc, uint32_t dec, uint32_t errors)
+{
+    PRINTF("%s: %u -> %u bytes, ratio %u.%u, encode %u.%u cycles/byte, decode %u.%u cycles/byte%s\n\r",
+           name, in_b, out_b, in_b / out_b, (in_b * 10 / out_b) % 10,
+           enc / in_b, (enc * 10 / in_b) % 10, dec / in_b, (dec * 10 / in_b) % 10,
+           errors ? " ERROR" : "");
+}
+
+static uint32_t bench_rice(const char *name, uint8_t order, uint8_t channels)
+{
+    rice_cfg_t cfg = {.bits = BITS, .order = order, .channels = channels};
+    size_t out_b = 0;
+    uint32_t enc, dec, errors = 0;
+
+    make_audio(channels);
+    TIME(
+        rice_enc_init(&rice, &cfg);
+        for (uint32_t i = 0; i < N_SAMPLES; i += BLOCK) {
+            out_b += rice_encode(&rice, samples + i, BLOCK, stream + out_b);
+        }
+        out_b += rice_flush(&rice, stream + out_b)
+    );
+    enc = cycles;
+    TIME(errors = rice_decode(&cfg, stream, out_b, decoded, N_SAMPLES) != N_SAMPLES);
+    dec = cycles;
+
+    for (uint32_t i = 0; i < N_SAMPLES; i++) {
+        errors += decoded[i] != (int16_t)samples[i];
+    }
+    report(name, N_SAMPLES * BITS / 8, out_b, enc, dec, errors);
+    return errors;
+}
+
+static uint32_t bench_lzss(const char *name, const uint8_t *in, uint32_t in_b)
+{
+    size_t out_b = 0;
+    uint32_t enc, dec, errors;
+
+    TIME(
+        lzss_enc_init(&lzss);
+        for (uint32_t i = 0; i < in_b; i += TEXT_BLOCK) {
+            out_b += lzss_encode(&lzss, in + i, TEXT_BLOCK, stream + out_b);
+        }
+        out_b += lzss_flush(&lzss, stream + out_b)
+    );
+    enc = cycles;
+    TIME(errors = lzss_decode(stream, out_b, text_out, in_b) != in_b);
+    dec = cycles;
+
+    errors += memcmp(in, text_out, in_b) != 0;
+    report(name, in_b, out_b, enc, dec, errors);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    // enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("Streaming compression, blocks of %u samples and %u bytes\n\r", BLOCK, TEXT_BLOCK);
+
+    errors += bench_rice("rice mono order 1", 1, 1);
+    errors += bench_rice("rice mono order 2", 2, 1);
+    errors += bench_rice("rice stereo order 2", 2, 2);
+
+    make_text();
+    errors += bench_lzss("lzss log lines", (const uint8_t *)text, TEXT_B);
+    // The same audio as bytes, for comparison: LZ finds few repeats in it
+    make_audio(1);
+    errors += bench_lzss("lzss audio words", (const uint8_t *)samples, TEXT_B);
+
+    if (errors == 0) {
+        PRINTF("Success\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
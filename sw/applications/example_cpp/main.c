@@ -19,9 +19,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "test_cpp.h"
+
 int main(int argc, char *argv[])
 {
     /* write something to stdout */
     printf("hello world!\n");
+
+    /* a DMA transaction checked at compile time */
+    if (test_dma_static() != 0) return EXIT_FAILURE;
+
+    /* the coroutines of test_async.cpp, with CXX_STD=c++20 */
+    if (test_async() != 0) return EXIT_FAILURE;
+
     return EXIT_SUCCESS;
 }
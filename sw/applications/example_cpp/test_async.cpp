@@ -0,0 +1,108 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Two coroutines share the DMA and the AO timer through async.hpp: the copy
+// task copies blocks with the DMA, one every DELAY_CYCLES, and checks them,
+// while the tick task counts delays. Built with CXX_STD=c++20 only, else
+// test_async() does nothing.
+
+extern "C" {
+    #include <stdio.h>
+    #include <stdint.h>
+    #include "test_cpp.h"
+}
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include "async.hpp"
+
+#define BLOCKS_N      4
+#define BLOCK_WORDS   32
+#define DELAY_CYCLES  1000
+#define DMA_CH        0
+
+XHEEP_ASYNC_DEFINE_HOOKS()
+
+namespace async = xheep::async;
+
+static uint32_t src[BLOCKS_N][BLOCK_WORDS];
+static uint32_t dst[BLOCK_WORDS];
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+
+static async::task copy_block(uint32_t block, uint32_t *errors)
+{
+    tgt_src.ptr = (uint8_t *)src[block];
+    if (co_await async::dma_transfer(&trans) & DMA_CONFIG_CRITICAL_ERROR) {
+        (*errors)++;
+        co_return;
+    }
+    for (uint32_t i = 0; i < BLOCK_WORDS; i++) {
+        *errors += dst[i] != src[block][i];
+    }
+}
+
+static async::task copy_task(uint32_t *errors)
+{
+    for (uint32_t b = 0; b < BLOCKS_N; b++) {
+        co_await async::delay(DELAY_CYCLES);
+        co_await copy_block(b, errors);
+    }
+}
+
+static async::task tick_task(uint32_t *ticks)
+{
+    while (*ticks < 2 * BLOCKS_N) {
+        co_await async::delay(DELAY_CYCLES / 2);
+        (*ticks)++;
+    }
+}
+
+int test_async(void)
+{
+    uint32_t errors = 0;
+    uint32_t ticks = 0;
+
+    for (uint32_t b = 0; b < BLOCKS_N; b++) {
+        for (uint32_t i = 0; i < BLOCK_WORDS; i++) {
+            src[b][i] = (b << 16) | i;
+        }
+    }
+
+    dma_init(NULL);
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = BLOCK_WORDS;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst         = tgt_src;
+    tgt_dst.ptr     = (uint8_t *)dst;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.channel   = DMA_CH;
+    trans.end       = DMA_TRANS_END_INTR;
+
+    async::timer_init();
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    {
+        async::task copy = copy_task(&errors);
+        async::task tick = tick_task(&ticks);
+        if (!copy || !tick) return 1;
+        async::run();
+    }
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), false);
+
+    printf("Coroutines: %u ticks, %u errors\n", (unsigned)ticks, (unsigned)errors);
+    return errors != 0 || ticks != 2 * BLOCKS_N;
+}
+
+#else
+
+int test_async(void)
+{
+    return 0;
+}
+
+#endif
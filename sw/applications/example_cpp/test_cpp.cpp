@@ -22,6 +22,9 @@ extern "C" {
     #include "test_cpp.h"
 }
 
+#include "soc_ctrl_regs.hpp"
+#include "dma_static.hpp"
+
 #define LOOPS 5
 template <typename T> 
 T mySum(T x, T y)
@@ -41,3 +44,48 @@ int test_numbers(void)
 	
     return 0;
 }
+
+typedef xheep::soc_ctrl::periph soc_ctrl;
+
+int test_hal(void)
+{
+    // Single loads, the addresses are constants
+    printf("Boot select %u, frequency %u Hz\n",
+           (unsigned)soc_ctrl::BOOT_SELECT::BOOT_SELECT_FIELD::get(),
+           (unsigned)soc_ctrl::SYSTEM_FREQUENCY_HZ::read());
+
+    return 0;
+}
+
+namespace ds = xheep::dma_static;
+
+#define DMA_WORDS 16
+
+static uint32_t dma_src[DMA_WORDS];
+static uint32_t dma_dst[DMA_WORDS];
+
+// Checked by the compiler: a copy of words that fits in dma_dst
+static constexpr ds::trans dma_copy_desc =
+    ds::trans(ds::memory<uint32_t>(DMA_WORDS), ds::memory<uint32_t>(0, 1, DMA_WORDS));
+static dma_compiled_trans_t dma_copy = ds::compile<dma_copy_desc>();
+
+int test_dma_static(void)
+{
+    int errors = 0;
+
+    for (uint32_t i = 0; i < DMA_WORDS; i++) {
+        dma_src[i] = 0xc0de0000 | i;
+    }
+
+    dma_init(NULL);
+    if (dma_launch_compiled(&dma_copy, (uint8_t *)dma_src, (uint8_t *)dma_dst) != DMA_CONFIG_OK) {
+        return 1;
+    }
+    while (!dma_is_ready(0));
+
+    for (uint32_t i = 0; i < DMA_WORDS; i++) {
+        errors += dma_dst[i] != dma_src[i];
+    }
+    printf("Constant DMA copy, %d errors\n", errors);
+    return errors;
+}
@@ -1,4 +1,17 @@
 /// @brief 
 /// @param  
 /// @return 
-int test_numbers(void);
\ No newline at end of file
+int test_numbers(void);
+
+/// @brief Reads registers of the SoC controller through the C++ HAL
+/// @return 0
+int test_hal(void);
+
+/// @brief Copies words with a DMA transaction compiled by the compiler
+/// @return The number of words copied wrong
+int test_dma_static(void);
+
+/// @brief Copies blocks with the DMA and waits for the AO timer from C++20
+/// coroutines, built with CXX_STD=c++20 only
+/// @return 0 if the copies are right, or if it is not built
+int test_async(void);
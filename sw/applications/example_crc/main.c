@@ -0,0 +1,138 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the CRC engine against the check values of CRC-32 and
+// CRC-16/CCITT-FALSE and against a bitwise software CRC, then times the CRC-32
+// of a buffer computed by the software loop, by the engine fed by the CPU and
+// by the engine fed by the DMA.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "dma.h"
+#include "crc.h"
+
+#ifndef CRC_IS_INCLUDED
+  #error ( "This app does NOT work as the CRC peripheral is not included" )
+#endif
+
+/* The cycles are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define TEST_BYTES  1024
+
+static uint8_t buf[TEST_BYTES] __attribute__ ((aligned (4)));
+static const uint8_t check[] = "123456789";
+
+static crc_dma_t crc_dma;
+static volatile uint32_t dma_done;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// Bitwise reference of a reflected or normal CRC, as in the catalogues
+static uint32_t crc_sw(const crc_cfg_t *cfg, const uint8_t *data, size_t len)
+{
+    uint32_t width = cfg->width == kCrcWidth32 ? 32 : cfg->width == kCrcWidth16 ? 16 : 8;
+    uint32_t top = 1u << (width - 1);
+    uint32_t mask = 0xFFFFFFFF >> (32 - width);
+    uint32_t poly = cfg->poly, crc = cfg->init;
+
+    if (cfg->reflect) {
+        uint32_t refl = 0;
+        for (uint32_t i = 0; i < width; i++) {
+            refl |= ((poly >> i) & 1) << (width - 1 - i);
+        }
+        poly = refl;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (cfg->reflect) {
+            crc ^= data[i];
+            for (int b = 0; b < 8; b++) {
+                crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+            }
+        } else {
+            crc ^= (uint32_t)data[i] << (width - 8);
+            for (int b = 0; b < 8; b++) {
+                crc = (crc & top) ? (crc << 1) ^ poly : crc << 1;
+            }
+            crc &= mask;
+        }
+    }
+    return (crc ^ cfg->xor_out) & mask;
+}
+
+static void crc_dma_done(dma_queue_entry_t *entry)
+{
+    dma_done = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t sw, hw, hw_dma;
+    uint32_t ref;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    for (uint32_t i = 0; i < TEST_BYTES; i++) {
+        buf[i] = (uint8_t)(i * 7 + (i >> 5));
+    }
+
+    // Check values, the string is not aligned so it tests the head and tail
+    errors += crc_compute(&crc_cfg_crc32, check, 9) != 0xCBF43926;
+    errors += crc_compute(&crc_cfg_crc16_ccitt, check, 9) != 0x29B1;
+    errors += crc_sw(&crc_cfg_crc32, check, 9) != 0xCBF43926;
+    PRINTF("check values: %u errors\n\r", errors);
+
+    // Unaligned pieces added to the same CRC
+    ref = crc_sw(&crc_cfg_crc16_ccitt, buf + 1, 101);
+    crc_start(&crc_cfg_crc16_ccitt);
+    crc_update(buf + 1, 50);
+    crc_update(buf + 51, 51);
+    errors += crc_get_result() != ref;
+
+    TIME(ref = crc_sw(&crc_cfg_crc32, buf, TEST_BYTES));
+    sw = cycles;
+
+    TIME(errors += crc_compute(&crc_cfg_crc32, buf, TEST_BYTES) != ref);
+    hw = cycles;
+
+    dma_init(NULL);
+    crc_start(&crc_cfg_crc32);
+    TIME(
+        errors += crc_dma_update(&crc_dma, buf, TEST_BYTES, 0, crc_dma_done, NULL) != DMA_CONFIG_OK;
+        while (!dma_done) { wait_for_interrupt(); }
+    );
+    hw_dma = cycles;
+    errors += crc_get_result() != ref;
+
+    PRINTF("CRC-32 of %u bytes: 0x%08x\n\r", TEST_BYTES, ref);
+    PRINTF("software: %u cycles\n\r", sw);
+    PRINTF("engine, CPU: %u cycles\n\r", hw);
+    PRINTF("engine, DMA: %u cycles\n\r", hw_dma);
+
+    if (errors == 0) {
+        PRINTF("CRC test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("CRC test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
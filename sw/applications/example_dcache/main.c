@@ -0,0 +1,154 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Walks a linked list and updates small counters in the slow memory of the
+// testbench with the data cache disabled and enabled, and prints the cycles
+// of both. Then checks the coherence with the DMA: the CPU writes a buffer in
+// the cached region, cleans the cache and the DMA copies it to the RAM; the
+// DMA writes the buffer back and the CPU reads it after an invalidation.
+// Needs a configuration with a data cache (dcache ways > 0 in mcu_cfg.hjson).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+#define LIST_NODES      32
+#define LIST_PASSES     8
+#define COPY_WORDS      32
+
+/* The cycles are the output of the example, printfs are activated by default. */
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+typedef struct node {
+    struct node *next;
+    uint32_t    value;
+} node_t;
+
+// The list and the copied buffer share the cached region of the slow memory
+#define LIST        ((node_t *)DCACHE_START_ADDRESS)
+#define EXT_BUF     ((volatile uint32_t *)(DCACHE_START_ADDRESS + LIST_NODES * sizeof(node_t)))
+
+static uint32_t ram_buf[COPY_WORDS];
+
+static uint32_t cycles(void)
+{
+    uint32_t c;
+    CSR_READ(CSR_REG_MCYCLE, &c);
+    return c;
+}
+
+// Follows the list, whose nodes are scattered over the region, and counts
+// the visits of each node in it
+static uint32_t walk(void)
+{
+    uint32_t start = cycles();
+    for (uint32_t p = 0; p < LIST_PASSES; p++) {
+        for (volatile node_t *n = LIST; n != NULL; n = n->next) {
+            n->value++;
+        }
+    }
+    return cycles() - start;
+}
+
+static void dma_copy_words(uint32_t *dst, const uint32_t *src)
+{
+    static dma_target_t tgt_src;
+    static dma_target_t tgt_dst;
+    static dma_trans_t trans;
+
+    tgt_src.ptr     = (uint8_t *)src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = COPY_WORDS;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.ptr     = (uint8_t *)dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+    dma_launch(&trans);
+    while (!dma_is_ready(0));
+}
+
+int main(int argc, char *argv[])
+{
+#if DCACHE_WAYS == 0 || !defined(TARGET_SIM)
+    PRINTF("No data cache or no slow memory, set the dcache ways in mcu_cfg.hjson and run in simulation\n\r");
+    return EXIT_SUCCESS;
+#else
+    soc_ctrl_t soc_ctrl = { .base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS) };
+    uint32_t uncached, cached, hits, misses;
+    uint32_t errors = 0;
+
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // Node i links to node i + 7 modulo LIST_NODES, 7 and LIST_NODES being coprime
+    soc_ctrl_dcache_enable(&soc_ctrl, false);
+    for (uint32_t i = 0, n = 0; i < LIST_NODES; i++, n = (n + 7) % LIST_NODES) {
+        uint32_t next = (n + 7) % LIST_NODES;
+        LIST[n].next  = i == LIST_NODES - 1 ? NULL : &LIST[next];
+        LIST[n].value = 0;
+    }
+
+    uncached = walk();
+    soc_ctrl_dcache_enable(&soc_ctrl, true);
+    soc_ctrl_dcache_clear_stats(&soc_ctrl);
+    cached = walk();
+    soc_ctrl_dcache_get_stats(&soc_ctrl, &hits, &misses);
+
+    PRINTF("list walk: %u cycles uncached, %u cycles cached, %u hits, %u misses\n\r",
+           uncached, cached, hits, misses);
+
+    // The cached values are written back before a master reads them
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        EXT_BUF[i] = 0xCAFE0000 + i;
+    }
+    soc_ctrl_dcache_clean(&soc_ctrl);
+    dma_init(NULL);
+    dma_copy_words(ram_buf, (const uint32_t *)EXT_BUF);
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        if (ram_buf[i] != 0xCAFE0000 + i) errors++;
+        ram_buf[i] = 0xBEEF0000 + i;
+    }
+
+    // and the stale lines are invalidated after a master wrote the memory
+    dma_copy_words((uint32_t *)EXT_BUF, ram_buf);
+    soc_ctrl_dcache_invalidate(&soc_ctrl);
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        if (EXT_BUF[i] != 0xBEEF0000 + i) errors++;
+    }
+
+    // Each of the two walks visited every node once per pass
+    soc_ctrl_dcache_enable(&soc_ctrl, false);
+    for (uint32_t n = 0; n < LIST_NODES; n++) {
+        if (LIST[n].value != 2 * LIST_PASSES) errors++;
+    }
+
+    if (errors == 0) {
+        PRINTF("Data cache example done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Data cache example failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+#endif
+}
@@ -7,6 +7,7 @@
 
 
 #include "dma.h"
+#include "dma_memcpy.h"
 #include "core_v_mini_mcu.h"
 #include "x-heep.h"
 #include "csr.h"
@@ -17,11 +18,30 @@
 #define TEST_WINDOW
 #define TEST_ADDRESS_MODE
 #define TEST_ADDRESS_MODE_EXTERNAL_DEVICE
+#define TEST_CHAIN
+#define TEST_2D
+#define TEST_FILL
+#define TEST_COMPILED
+#define TEST_MEMCPY
+#define TEST_QUEUE
+#define TEST_WIDENING
+#define TEST_TIMER
+#define TEST_GATHER
 
 #define TEST_DATA_SIZE      16
 #define TEST_DATA_LARGE     1024
 #define TRANSACTIONS_N      3       // Only possible to perform transaction at a time, others should be blocked
 #define TEST_WINDOW_SIZE_DU  1024    // if put at <=71 the isr is too slow to react to the interrupt
+#define TEST_CHAIN_N        3       // Descriptors of the chain, each one copies TEST_DATA_SIZE words
+#define TEST_2D_N           16      // The 2D test copies a tile out of a TEST_2D_N x TEST_2D_N matrix
+#define TEST_2D_TILE        4
+#define TEST_2D_ROW         2       // Position of the tile in the matrix
+#define TEST_2D_COL         3
+#define TEST_FILL_VALUE     0x5a5aa5a5  // The fill test writes it to the TEST_2D tile of the matrix
+#define TEST_COMPILED_N     4       // Launches of the compiled transaction, each one to another slice
+#define TEST_MEMCPY_OFFSET  3       // Byte offset of the memcpy buffers, so that they have a head and a tail
+#define TEST_QUEUE_N        3       // Queued transactions, each one copies TEST_DATA_SIZE words
+#define TEST_TIMER_PERIOD   64      // Cycles between two reads of the timer test
 
 
 
@@ -45,7 +65,7 @@
 int32_t errors = 0;
 int8_t cycles = 0;
 
-void dma_intr_handler_trans_done()
+void dma_intr_handler_trans_done(uint8_t channel)
 {
     cycles++;
 }
@@ -55,7 +75,7 @@ void dma_intr_handler_trans_done()
 
 int32_t window_intr_flag;
 
-void dma_intr_handler_window_done(void) {
+void dma_intr_handler_window_done(uint8_t channel) {
     window_intr_flag ++;
 }
 
@@ -66,6 +86,23 @@ uint8_t dma_window_ratio_warning_threshold()
 
 #endif // TEST_WINDOW
 
+#ifdef TEST_QUEUE
+
+volatile uint32_t queue_done_mask = 0;
+volatile uint32_t queue_order_errors = 0;
+
+void queue_done(dma_queue_entry_t *entry)
+{
+    uint32_t idx = (uint32_t)entry->ctx;
+    // The callbacks are called in the order of submission
+    if (queue_done_mask != (1u << idx) - 1) {
+        queue_order_errors++;
+    }
+    queue_done_mask |= 1u << idx;
+}
+
+#endif // TEST_QUEUE
+
 
 int main(int argc, char *argv[])
 {
@@ -127,11 +164,11 @@ int main(int argc, char *argv[])
     res = dma_launch(&trans);
     PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
 
-    while( ! dma_is_ready()) {
+    while( ! dma_is_ready( 0 )) {
         // disable_interrupts
         // this does not prevent waking up the core as this is controlled by the MIP register
         CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
-        if ( dma_is_ready() == 0 ) {
+        if ( dma_is_ready( 0 ) == 0 ) {
             wait_for_interrupt();
             //from here we wake up even if we did not jump to the ISR
         }
@@ -175,11 +212,11 @@ int main(int argc, char *argv[])
     res = dma_launch(&trans);
     PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
 
-    while( ! dma_is_ready()) {
+    while( ! dma_is_ready( 0 )) {
         // disable_interrupts
         // this does not prevent waking up the core as this is controlled by the MIP register
         CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
-        if ( dma_is_ready() == 0 ) {
+        if ( dma_is_ready( 0 ) == 0 ) {
             wait_for_interrupt();
             //from here we wake up even if we did not jump to the ISR
         }
@@ -242,11 +279,11 @@ int main(int argc, char *argv[])
     res = dma_launch(&trans);
     PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
 
-    while( ! dma_is_ready()) {
+    while( ! dma_is_ready( 0 )) {
         // disable_interrupts
         // this does not prevent waking up the core as this is controlled by the MIP register
         CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
-        if ( dma_is_ready() == 0 ) {
+        if ( dma_is_ready( 0 ) == 0 ) {
             wait_for_interrupt();
             //from here we wake up even if we did not jump to the ISR
         }
@@ -309,7 +346,7 @@ int main(int argc, char *argv[])
 
     if( trans.end == DMA_TRANS_END_POLLING ){
         while( cycles < consecutive_trans ){
-            while( ! dma_is_ready() );
+            while( ! dma_is_ready( 0 ) );
             cycles++;
         }
     } else {
@@ -372,10 +409,10 @@ int main(int argc, char *argv[])
     dma_launch(&trans);
 
     if( trans.end == DMA_TRANS_END_POLLING ){ //There will be no interrupts whatsoever!
-        while( ! dma_is_ready() );
+        while( ! dma_is_ready( 0 ) );
         PRINTF("?\n\r");
     } else {
-        while( !dma_is_ready() ){
+        while( !dma_is_ready( 0 ) ){
             wait_for_interrupt();
             PRINTF("i\n\r");
         }
@@ -400,5 +437,537 @@ int main(int argc, char *argv[])
 #endif // TEST_WINDOW
 
 
+#ifdef TEST_CHAIN
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING LINKED-LIST MODE   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    static dma_desc_t chain[TEST_CHAIN_N] __attribute__ ((aligned (4)));
+
+    for (uint32_t i = 0; i < TEST_CHAIN_N * TEST_DATA_SIZE; i++) {
+        test_data_large [i] = 0xc0de0000 + i;
+        copied_data_4B  [i] = 0;
+    }
+
+    tgt_src.size_du = TEST_DATA_SIZE;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    trans.win_du    = 0;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.end       = DMA_TRANS_END_POLLING;
+
+    // Each descriptor copies one slice of test_data_large to the mirrored slice of copied_data_4B
+    for (uint32_t i = 0; i < TEST_CHAIN_N; i++) {
+        tgt_src.ptr = (uint8_t*)&test_data_large[ i * TEST_DATA_SIZE ];
+        tgt_dst.ptr = (uint8_t*)&copied_data_4B[ (TEST_CHAIN_N - 1 - i) * TEST_DATA_SIZE ];
+        res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+        res |= dma_fill_descriptor( &chain[i], &trans, i + 1 < TEST_CHAIN_N ? &chain[i + 1] : NULL, 0 );
+        PRINTF("desc: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    }
+
+    res = dma_launch_chain( 0, &chain[0], DMA_TRANS_END_POLLING );
+    PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+
+    while( ! dma_is_ready( 0 ) );
+    PRINTF(">> Finished chain. \n\r");
+
+    for (uint32_t i = 0; i < TEST_CHAIN_N; i++) {
+        for (uint32_t j = 0; j < TEST_DATA_SIZE; j++) {
+            uint32_t expected = test_data_large[ i * TEST_DATA_SIZE + j ];
+            uint32_t copied   = copied_data_4B[ (TEST_CHAIN_N - 1 - i) * TEST_DATA_SIZE + j ];
+            if (copied != expected) {
+                PRINTF("[%d][%d] %08x\tvs.\t%08x\n\r", i, j, copied, expected);
+                errors++;
+            }
+        }
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA linked-list success\n\r");
+    } else {
+        PRINTF("DMA linked-list failure: %d errors out of %d words checked\n\r", errors, TEST_CHAIN_N * TEST_DATA_SIZE);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_CHAIN
+
+
+#ifdef TEST_2D
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING 2D MODE   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    for (uint32_t i = 0; i < TEST_2D_N * TEST_2D_N; i++) {
+        test_data_large [i] = 0x2d000000 + i;
+        copied_data_4B  [i] = 0;
+    }
+
+    // The rows of the tile are TEST_2D_N words apart in the matrix, and packed in the destination
+    tgt_src.ptr             = (uint8_t*)&test_data_large[ TEST_2D_ROW * TEST_2D_N + TEST_2D_COL ];
+    tgt_src.size_du         = TEST_2D_TILE;
+    tgt_src.stride_d2_du    = TEST_2D_N;
+    tgt_src.type            = DMA_DATA_TYPE_WORD;
+    tgt_dst.ptr             = (uint8_t*)copied_data_4B;
+    tgt_dst.stride_d2_du    = 0;
+    tgt_dst.type            = DMA_DATA_TYPE_WORD;
+    trans.size_d2           = TEST_2D_TILE;
+    trans.win_du            = 0;
+    trans.mode              = DMA_TRANS_MODE_SINGLE;
+    trans.end               = DMA_TRANS_END_POLLING;
+
+    res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    PRINTF("tran: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    res = dma_load_transaction(&trans);
+    PRINTF("load: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    res = dma_launch(&trans);
+    PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+
+    while( ! dma_is_ready( 0 ) );
+    PRINTF(">> Finished 2D transaction. \n\r");
+
+    for (uint32_t i = 0; i < TEST_2D_TILE; i++) {
+        for (uint32_t j = 0; j < TEST_2D_TILE; j++) {
+            uint32_t expected = test_data_large[ (TEST_2D_ROW + i) * TEST_2D_N + TEST_2D_COL + j ];
+            uint32_t copied   = copied_data_4B[ i * TEST_2D_TILE + j ];
+            if (copied != expected) {
+                PRINTF("[%d][%d] %08x\tvs.\t%08x\n\r", i, j, copied, expected);
+                errors++;
+            }
+        }
+    }
+    // Nothing is written beyond the tile
+    if (copied_data_4B[ TEST_2D_TILE * TEST_2D_TILE ] != 0) {
+        errors++;
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA 2D success\n\r");
+    } else {
+        PRINTF("DMA 2D failure: %d errors out of %d words checked\n\r", errors, TEST_2D_TILE * TEST_2D_TILE);
+        return EXIT_FAILURE;
+    }
+
+    trans.size_d2 = 0;
+
+#endif // TEST_2D
+
+
+#ifdef TEST_FILL
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING FILL MODE   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    for (uint32_t i = 0; i < TEST_2D_N * TEST_2D_N; i++) {
+        test_data_large [i] = 0;
+    }
+
+    // Nothing is read: the source only gives the data type and the size of each row
+    tgt_src.ptr             = NULL;
+    tgt_src.size_du         = TEST_2D_TILE;
+    tgt_src.stride_d2_du    = 0;
+    tgt_src.type            = DMA_DATA_TYPE_WORD;
+    tgt_dst.ptr             = (uint8_t*)&test_data_large[ TEST_2D_ROW * TEST_2D_N + TEST_2D_COL ];
+    tgt_dst.stride_d2_du    = TEST_2D_N;
+    tgt_dst.type            = DMA_DATA_TYPE_WORD;
+    trans.size_d2           = TEST_2D_TILE;
+    trans.win_du            = 0;
+    trans.mode              = DMA_TRANS_MODE_FILL;
+    trans.fill              = TEST_FILL_VALUE;
+    trans.end               = DMA_TRANS_END_POLLING;
+
+    res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    PRINTF("tran: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    res = dma_load_transaction(&trans);
+    PRINTF("load: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    res = dma_launch(&trans);
+    PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+
+    while( ! dma_is_ready( 0 ) );
+    PRINTF(">> Finished fill transaction. \n\r");
+
+    // Only the tile is written
+    for (uint32_t i = 0; i < TEST_2D_N; i++) {
+        for (uint32_t j = 0; j < TEST_2D_N; j++) {
+            uint32_t in_tile  = i >= TEST_2D_ROW && i < TEST_2D_ROW + TEST_2D_TILE
+                             && j >= TEST_2D_COL && j < TEST_2D_COL + TEST_2D_TILE;
+            uint32_t expected = in_tile ? TEST_FILL_VALUE : 0;
+            if (test_data_large[ i * TEST_2D_N + j ] != expected) {
+                PRINTF("[%d][%d] %08x\tvs.\t%08x\n\r", i, j, test_data_large[ i * TEST_2D_N + j ], expected);
+                errors++;
+            }
+        }
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA fill success\n\r");
+    } else {
+        PRINTF("DMA fill failure: %d errors out of %d words checked\n\r", errors, TEST_2D_N * TEST_2D_N);
+        return EXIT_FAILURE;
+    }
+
+    tgt_dst.stride_d2_du = 0;
+    trans.size_d2        = 0;
+    trans.mode           = DMA_TRANS_MODE_SINGLE;
+
+#endif // TEST_FILL
+
+
+#ifdef TEST_COMPILED
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING COMPILED TRANSACTIONS   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    static dma_compiled_trans_t comp;
+    // The same copy, its image checked and built by the compiler
+    static dma_compiled_trans_t comp_const = DMA_COMPILED_COPY( 0, DMA_DATA_TYPE_WORD, TEST_DATA_SIZE, DMA_TRANS_END_POLLING );
+
+    for (uint32_t i = 0; i < TEST_COMPILED_N * TEST_DATA_SIZE; i++) {
+        copied_data_4B[i] = 0;
+    }
+
+    tgt_src.ptr             = (uint8_t*)test_data_4B;
+    tgt_src.size_du         = TEST_DATA_SIZE;
+    tgt_src.stride_d2_du    = 0;
+    tgt_src.type            = DMA_DATA_TYPE_WORD;
+    tgt_dst.ptr             = (uint8_t*)copied_data_4B;
+    tgt_dst.type            = DMA_DATA_TYPE_WORD;
+    trans.size_d2           = 0;
+    trans.win_du            = 0;
+    trans.mode              = DMA_TRANS_MODE_SINGLE;
+    trans.end               = DMA_TRANS_END_POLLING;
+
+    // Validated and compiled once, then only the destination is patched
+    res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    res |= dma_compile_transaction( &trans, &comp );
+    PRINTF("comp: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+
+    for (uint32_t i = 0; i < TEST_COMPILED_N; i++) {
+        res = dma_launch_compiled( &comp, NULL, (uint8_t*)&copied_data_4B[ i * TEST_DATA_SIZE ] );
+        if (res != DMA_CONFIG_OK) {
+            PRINTF("laun: %u \tError!\n\r", res);
+            errors++;
+        }
+        while( ! dma_is_ready( 0 ) );
+    }
+
+    // The constant image has no pointers, both are given at its first launch.
+    // It copies the last slice again
+    for (uint32_t i = 0; i < TEST_DATA_SIZE; i++) {
+        copied_data_4B[ ( TEST_COMPILED_N - 1 ) * TEST_DATA_SIZE + i ] = 0;
+    }
+    res = dma_launch_compiled( &comp_const, (uint8_t*)test_data_4B, (uint8_t*)&copied_data_4B[ ( TEST_COMPILED_N - 1 ) * TEST_DATA_SIZE ] );
+    if (res != DMA_CONFIG_OK) {
+        PRINTF("laun: %u \tError!\n\r", res);
+        errors++;
+    }
+    while( ! dma_is_ready( 0 ) );
+    PRINTF(">> Finished compiled transactions. \n\r");
+
+    for (uint32_t i = 0; i < TEST_COMPILED_N; i++) {
+        for (uint32_t j = 0; j < TEST_DATA_SIZE; j++) {
+            if (copied_data_4B[ i * TEST_DATA_SIZE + j ] != test_data_4B[j]) {
+                PRINTF("[%d][%d] %08x\tvs.\t%08x\n\r", i, j, copied_data_4B[ i * TEST_DATA_SIZE + j ], test_data_4B[j]);
+                errors++;
+            }
+        }
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA compiled transactions success\n\r");
+    } else {
+        PRINTF("DMA compiled transactions failure: %d errors out of %d words checked\n\r", errors, TEST_COMPILED_N * TEST_DATA_SIZE);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_COMPILED
+
+
+#ifdef TEST_MEMCPY
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING MEMCPY AND MEMSET   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    uint8_t *memcpy_src = (uint8_t*)test_data_large + TEST_MEMCPY_OFFSET;
+    uint8_t *memcpy_dst = (uint8_t*)copied_data_4B + TEST_MEMCPY_OFFSET;
+    uint32_t memcpy_len = TEST_DATA_LARGE + 5;   // Two copies fit in copied_data_4B
+
+    for (uint32_t i = 0; i < TEST_DATA_LARGE * 4; i++) {
+        ((uint8_t*)test_data_large)[i] = i;
+        ((uint8_t*)copied_data_4B)[i]  = 0;
+    }
+
+    // The CPU checks the previous copy while the DMA fills the next region
+    dma_memcpy( memcpy_dst, memcpy_src, memcpy_len );
+    dma_copy_token_t token = dma_memset_async( memcpy_dst + memcpy_len, 0xa5, memcpy_len );
+    for (uint32_t i = 0; i < memcpy_len; i++) {
+        if (memcpy_dst[i] != memcpy_src[i]) {
+            errors++;
+        }
+    }
+    dma_copy_wait( token );
+    PRINTF(">> Finished memcpy and memset. \n\r");
+
+    for (uint32_t i = 0; i < memcpy_len; i++) {
+        if (memcpy_dst[ memcpy_len + i ] != 0xa5) {
+            errors++;
+        }
+    }
+    // Nothing is written around the buffers
+    if (((uint8_t*)copied_data_4B)[ TEST_MEMCPY_OFFSET - 1 ] != 0 || memcpy_dst[ 2 * memcpy_len ] != 0) {
+        errors++;
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA memcpy and memset success\n\r");
+    } else {
+        PRINTF("DMA memcpy and memset failure: %d errors out of %d bytes checked\n\r", errors, 2 * memcpy_len);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_MEMCPY
+
+
+#ifdef TEST_QUEUE
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING SUBMISSION QUEUE   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    static dma_target_t queue_dst[TEST_QUEUE_N];
+    static dma_trans_t queue_trans[TEST_QUEUE_N];
+    static dma_queue_entry_t queue_entry[TEST_QUEUE_N];
+
+    for (uint32_t i = 0; i < TEST_QUEUE_N * TEST_DATA_SIZE; i++) {
+        copied_data_4B[i] = 0;
+    }
+
+    tgt_src.ptr     = (uint8_t*)test_data_4B;
+    tgt_src.size_du = TEST_DATA_SIZE;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+
+    // All the transactions are submitted at once, the interrupt launches each one when the previous is done
+    for (uint32_t i = 0; i < TEST_QUEUE_N; i++) {
+        queue_dst[i]            = tgt_dst;
+        queue_dst[i].ptr        = (uint8_t*)&copied_data_4B[ i * TEST_DATA_SIZE ];
+        queue_dst[i].type       = DMA_DATA_TYPE_WORD;
+        queue_trans[i]          = trans;
+        queue_trans[i].src      = &tgt_src;
+        queue_trans[i].dst      = &queue_dst[i];
+        queue_trans[i].mode     = DMA_TRANS_MODE_SINGLE;
+        queue_trans[i].win_du   = 0;
+        queue_trans[i].size_d2  = 0;
+        queue_entry[i].trans    = &queue_trans[i];
+        queue_entry[i].cb       = queue_done;
+        queue_entry[i].ctx      = (void*)i;
+
+        res = dma_validate_transaction( &queue_trans[i], DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+        res |= dma_submit( &queue_entry[i] );
+        PRINTF("subm: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    }
+
+    // Interrupts are disabled between the check and the wfi so that the last one is not missed
+    while( ! dma_queue_is_empty( 0 ) ) {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        if( ! dma_queue_is_empty( 0 ) ) {
+            wait_for_interrupt();
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    }
+    PRINTF(">> Finished queued transactions. \n\r");
+
+    for (uint32_t i = 0; i < TEST_QUEUE_N; i++) {
+        for (uint32_t j = 0; j < TEST_DATA_SIZE; j++) {
+            if (copied_data_4B[ i * TEST_DATA_SIZE + j ] != test_data_4B[j]) {
+                PRINTF("[%d][%d] %08x\tvs.\t%08x\n\r", i, j, copied_data_4B[ i * TEST_DATA_SIZE + j ], test_data_4B[j]);
+                errors++;
+            }
+        }
+    }
+    if (queue_done_mask != (1u << TEST_QUEUE_N) - 1 || queue_order_errors) {
+        errors++;
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA submission queue success\n\r");
+    } else {
+        PRINTF("DMA submission queue failure: %d errors out of %d words checked\n\r", errors, TEST_QUEUE_N * TEST_DATA_SIZE);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_QUEUE
+
+
+#ifdef TEST_WIDENING
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING DATA TYPE WIDENING   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    // The words of test_data_4B are read as half words and written as words, first with sign extension then with zeros
+    int16_t *samples = (int16_t*)test_data_4B;
+
+    tgt_src.ptr     = (uint8_t*)test_data_4B;
+    tgt_src.size_du = 2 * TEST_DATA_SIZE;
+    tgt_src.type    = DMA_DATA_TYPE_HALF_WORD;
+    tgt_dst.ptr     = (uint8_t*)copied_data_4B;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.win_du    = 0;
+    trans.size_d2   = 0;
+    trans.end       = DMA_TRANS_END_POLLING;
+
+    for (uint32_t ext = 0; ext < 2; ext++) {
+        for (uint32_t i = 0; i < 2 * TEST_DATA_SIZE; i++) {
+            copied_data_4B[i] = 0;
+        }
+        trans.conv = ext == 0 ? DMA_TYPE_CONV_SIGN_EXT : DMA_TYPE_CONV_ZERO_EXT;
+
+        res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+        res |= dma_load_transaction( &trans );
+        res |= dma_launch( &trans );
+        PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+        while( ! dma_is_ready( 0 ) );
+
+        for (uint32_t i = 0; i < 2 * TEST_DATA_SIZE; i++) {
+            uint32_t expected = trans.conv == DMA_TYPE_CONV_SIGN_EXT ? (uint32_t)(int32_t)samples[i] : (uint16_t)samples[i];
+            if (copied_data_4B[i] != expected) {
+                PRINTF("[%d] %08x\tvs.\t%08x\n\r", i, copied_data_4B[i], expected);
+                errors++;
+            }
+        }
+    }
+    PRINTF(">> Finished widening transactions. \n\r");
+
+    trans.conv     = DMA_TYPE_CONV_NONE;
+    tgt_src.type   = DMA_DATA_TYPE_WORD;
+
+    if (errors == 0) {
+        PRINTF("DMA widening success\n\r");
+    } else {
+        PRINTF("DMA widening failure: %d errors out of %d words checked\n\r", errors, 4 * TEST_DATA_SIZE);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_WIDENING
+
+
+#ifdef TEST_TIMER
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING PACING TIMER   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    for (uint32_t i = 0; i < TEST_DATA_SIZE; i++) {
+        copied_data_4B[i] = 0;
+    }
+
+    // The reads are paced by the timer of the channel, one every TEST_TIMER_PERIOD cycles
+    tgt_src.ptr     = (uint8_t*)test_data_4B;
+    tgt_src.size_du = TEST_DATA_SIZE;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_SLOT_TIMER;
+    tgt_dst.ptr     = (uint8_t*)copied_data_4B;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.win_du    = 0;
+    trans.size_d2   = 0;
+    trans.timer     = TEST_TIMER_PERIOD;
+    trans.end       = DMA_TRANS_END_POLLING;
+
+    uint32_t timer_start, timer_cycles;
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    res |= dma_load_transaction( &trans );
+    CSR_READ(CSR_REG_MCYCLE, &timer_start);
+    res |= dma_launch( &trans );
+    PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    while( ! dma_is_ready( 0 ) );
+    CSR_READ(CSR_REG_MCYCLE, &timer_cycles);
+    timer_cycles -= timer_start;
+    PRINTF(">> Finished paced transaction in %d cycles. \n\r", timer_cycles);
+
+    for (uint32_t i = 0; i < TEST_DATA_SIZE; i++) {
+        if (copied_data_4B[i] != test_data_4B[i]) {
+            PRINTF("[%d] %08x\tvs.\t%08x\n\r", i, copied_data_4B[i], test_data_4B[i]);
+            errors++;
+        }
+    }
+    // The first read is not paced
+    if (timer_cycles < (TEST_DATA_SIZE - 1) * TEST_TIMER_PERIOD) {
+        PRINTF("Too fast: %d cycles, expected at least %d\n\r", timer_cycles, (TEST_DATA_SIZE - 1) * TEST_TIMER_PERIOD);
+        errors++;
+    }
+
+    tgt_src.trig = DMA_TRIG_MEMORY;
+    trans.timer  = 0;
+
+    if (errors == 0) {
+        PRINTF("DMA pacing timer success\n\r");
+    } else {
+        PRINTF("DMA pacing timer failure: %d errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_TIMER
+
+
+#ifdef TEST_GATHER
+
+    PRINTF("\n\n\r===================================\n\n\r");
+    PRINTF("    TESTING GATHER   ");
+    PRINTF("\n\n\r===================================\n\n\r");
+
+    // The table holds the indexes of the words of test_data_4B to be read,
+    // in reverse order, which are shifted by 2 and added to the source pointer
+    for (uint32_t i = 0; i < TEST_DATA_SIZE; i++) {
+        test_data_large[i] = TEST_DATA_SIZE - 1 - i;
+        copied_data_4B[i]  = 0;
+    }
+
+    tgt_src.ptr     = (uint8_t*)test_data_4B;
+    tgt_src.size_du = TEST_DATA_SIZE;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.ptr     = (uint8_t*)copied_data_4B;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_addr.ptr    = (uint8_t*)test_data_large;
+    trans.src_addr  = &tgt_addr;
+    trans.mode      = DMA_TRANS_MODE_ADDRESS;
+    trans.addr_table = DMA_ADDR_TABLE_SRC_OFFSETS;
+    trans.addr_shift = 2;
+    trans.end       = DMA_TRANS_END_POLLING;
+
+    res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    res |= dma_load_transaction( &trans );
+    res |= dma_launch( &trans );
+    PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
+    while( ! dma_is_ready( 0 ) );
+
+    for (uint32_t i = 0; i < TEST_DATA_SIZE; i++) {
+        if (copied_data_4B[i] != test_data_4B[TEST_DATA_SIZE - 1 - i]) {
+            PRINTF("[%d] %08x\tvs.\t%08x\n\r", i, copied_data_4B[i], test_data_4B[TEST_DATA_SIZE - 1 - i]);
+            errors++;
+        }
+    }
+
+    trans.mode       = DMA_TRANS_MODE_SINGLE;
+    trans.addr_table = DMA_ADDR_TABLE_DST_PTRS;
+    trans.addr_shift = 0;
+
+    if (errors == 0) {
+        PRINTF("DMA gather success\n\r");
+    } else {
+        PRINTF("DMA gather failure: %d errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+#endif // TEST_GATHER
+
+
     return EXIT_SUCCESS;
 }
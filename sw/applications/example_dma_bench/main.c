@@ -0,0 +1,156 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// DMA throughput benchmark: sweeps the transfer size, data type, alignment
+// and source/destination pair, and reports the performance counters of the
+// DMA and the cycles seen by the CPU from the validation to the end of the
+// transaction (i.e. including the HAL overhead).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dma.h"
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+
+#define BENCH_MAX_B         2048    // Largest transfer, in bytes (it must fit in the external slow memory)
+#define BENCH_MAX_OFFSET    3       // Misalignments swept, in bytes
+#define BENCH_SIZES_N       4
+#define BENCH_TYPES_N       3
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+typedef struct {
+    const char *name;
+    uint8_t    *src;
+    uint8_t    *dst;
+} bench_pair_t;
+
+static uint8_t bench_src[BENCH_MAX_B + BENCH_MAX_OFFSET] __attribute__ ((aligned (4)));
+static uint8_t bench_dst[BENCH_MAX_B + BENCH_MAX_OFFSET] __attribute__ ((aligned (4)));
+
+static const uint32_t bench_sizes_b[BENCH_SIZES_N] = { 64, 256, 1024, BENCH_MAX_B };
+static const dma_data_type_t bench_types[BENCH_TYPES_N] = { DMA_DATA_TYPE_WORD, DMA_DATA_TYPE_HALF_WORD, DMA_DATA_TYPE_BYTE };
+static const char *bench_type_names[BENCH_TYPES_N] = { "word", "half", "byte" };
+
+// Runs one transfer, returns the errors found in the copied data
+static uint32_t bench_run(const bench_pair_t *pair, uint32_t size_b, dma_data_type_t type, uint32_t offset, const char *type_name)
+{
+    static dma_target_t tgt_src;
+    static dma_target_t tgt_dst;
+    static dma_trans_t trans;
+    dma_perf_t perf;
+    uint32_t cycles;
+    uint32_t errors = 0;
+
+    uint8_t *src = pair->src + offset;
+    uint8_t *dst = pair->dst + offset;
+
+    for (uint32_t i = 0; i < size_b; i++) {
+        src[i] = i * 7 + offset;
+        dst[i] = 0;
+    }
+
+    tgt_src.env     = NULL;
+    tgt_src.ptr     = src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = size_b / DMA_DATA_TYPE_2_SIZE(type);
+    tgt_src.type    = type;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.env     = NULL;
+    tgt_dst.ptr     = dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = type;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.win_du    = 0;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+    trans.size_d2   = 0;
+
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+
+    // Misaligned pointers make the HAL fall back to a smaller data type
+    dma_config_flags_t res = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY );
+    res |= dma_load_transaction( &trans );
+    res |= dma_launch( &trans );
+    while( ! dma_is_ready( 0 ) );
+
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    dma_get_perf( 0, &perf );
+
+    if (res & DMA_CONFIG_CRITICAL_ERROR) {
+        PRINTF("%s %s %u +%u: error %u\n\r", pair->name, type_name, size_b, offset, res);
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < size_b; i++) {
+        if (dst[i] != src[i]) errors++;
+    }
+
+    // Bytes per 100 cycles, to print the bandwidth without floats
+    uint32_t bw_dma = perf.busy ? (100 * size_b) / perf.busy : 0;
+    uint32_t bw_cpu = cycles ? (100 * size_b) / cycles : 0;
+    PRINTF("%s %s %u +%u: busy %u rstall %u wstall %u beats %u cpu %u | B/100cyc dma %u cpu %u%s\n\r",
+           pair->name, type_name, size_b, offset,
+           perf.busy, perf.read_stall, perf.write_stall, perf.beats, cycles,
+           bw_dma, bw_cpu, errors ? " ERROR" : "");
+    return errors;
+}
+
+#ifndef TARGET_PYNQ_Z2
+#pragma message ( "this application should not be ran in a system integrating x-heep as in the external \
+    slave can be plugged something else than a slow memory as in our testbench" )
+#endif
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    bench_pair_t pairs[] = {
+        { "ram>ram", bench_src, bench_dst },
+#ifndef TARGET_PYNQ_Z2
+        // The slow memory of the testbench, a target with a long latency
+        { "ram>ext", bench_src, (uint8_t*)EXT_SLAVE_START_ADDRESS },
+        { "ext>ram", (uint8_t*)EXT_SLAVE_START_ADDRESS, bench_dst },
+#endif
+    };
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_init(NULL);
+
+    for (uint32_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        for (uint32_t t = 0; t < BENCH_TYPES_N; t++) {
+            for (uint32_t s = 0; s < BENCH_SIZES_N; s++) {
+                // Byte transfers are run at every misalignment, the rest aligned and misaligned by BENCH_MAX_OFFSET
+                for (uint32_t o = 0; o <= BENCH_MAX_OFFSET; o += DMA_DATA_TYPE_2_SIZE(bench_types[t]) == 1 ? 1 : BENCH_MAX_OFFSET) {
+                    errors += bench_run(&pairs[p], bench_sizes_b[s], bench_types[t], o, bench_type_names[t]);
+                }
+            }
+        }
+    }
+
+    if (errors == 0) {
+        PRINTF("DMA benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("DMA benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
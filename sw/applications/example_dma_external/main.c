@@ -29,7 +29,7 @@
 
 int32_t errors = 0;
 
-void dma_intr_handler_trans_done()
+void dma_intr_handler_trans_done(uint8_t channel)
 {
     PRINTF("D");
 }
@@ -82,11 +82,11 @@ int main(int argc, char *argv[])
     res = dma_launch(&trans);
     PRINTF("laun: %u \t%s\n\r", res, res == DMA_CONFIG_OK ?  "Ok!" : "Error!");
 
-    while( ! dma_is_ready() ){
+    while( ! dma_is_ready( 0 ) ){
         // disable_interrupts
         // this does not prevent waking up the core as this is controlled by the MIP register
         CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
-        if ( dma_is_ready() == 0 ) {
+        if ( dma_is_ready( 0 ) == 0 ) {
             wait_for_interrupt();
             //from here we wake up even if we did not jump to the ISR
         }
@@ -0,0 +1,164 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the kernels of the DSP library against plain C loops and reports the
+// cycles of both. Build it with CPU=cv32e40px and an ARCH with the Xpulp
+// extensions to compare the Xpulp versions with the portable ones.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dsp.h"
+#include "csr.h"
+#include "x-heep.h"
+
+#define DSP_TEST_N  255     // Not a multiple of 4, to also run the tails
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static int32_t a32[DSP_TEST_N], b32[DSP_TEST_N], c32[DSP_TEST_N], r32[DSP_TEST_N];
+static int16_t a16[DSP_TEST_N] __attribute__ ((aligned (4)));
+static int16_t b16[DSP_TEST_N] __attribute__ ((aligned (4)));
+static int16_t c16[DSP_TEST_N] __attribute__ ((aligned (4)));
+static int8_t  a8[DSP_TEST_N]  __attribute__ ((aligned (4)));
+static int8_t  b8[DSP_TEST_N]  __attribute__ ((aligned (4)));
+static int8_t  c8[DSP_TEST_N]  __attribute__ ((aligned (4)));
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static void print_result(const char *name, uint32_t ref, uint32_t lib, uint32_t errors)
+{
+    PRINTF("%s: cycles C loop %u library %u%s\n\r", name, ref, lib, errors ? " ERROR" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t err, ref, lib;
+    int32_t dot_ref, dot_lib;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("DSP kernels, Xpulp %s\n\r", DSP_XPULP ? "on" : "off");
+
+    // Positive and negative values, and sums that overflow the 8 and 16-bit types
+    for (int32_t i = 0; i < DSP_TEST_N; i++) {
+        a32[i] = i * 12345 - 1000000;
+        b32[i] = 777 - i * 31;
+        a16[i] = (int16_t)(i * 257 - 30000);
+        b16[i] = (int16_t)(i * 131 + 20000);
+        a8[i]  = (int8_t)(i * 3 - 100);
+        b8[i]  = (int8_t)(i * 5 + 60);
+    }
+
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) r32[i] = a32[i]);
+    ref = cycles;
+    TIME(dsp_copy_w((uint32_t *)c32, (const uint32_t *)a32, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c32[i] != a32[i];
+    print_result("copy_w ", ref, lib, err);
+    errors += err;
+
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) r32[i] = 0x5a5a5a5a);
+    ref = cycles;
+    TIME(dsp_fill_w((uint32_t *)c32, 0x5a5a5a5a, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c32[i] != 0x5a5a5a5a;
+    print_result("fill_w ", ref, lib, err);
+    errors += err;
+
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) r32[i] = a32[i] + b32[i]);
+    ref = cycles;
+    TIME(dsp_add_i32(a32, b32, c32, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c32[i] != r32[i];
+    print_result("add_i32", ref, lib, err);
+    errors += err;
+
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) r32[i] = a32[i] * b32[i]);
+    ref = cycles;
+    TIME(dsp_mul_i32(a32, b32, c32, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c32[i] != r32[i];
+    print_result("mul_i32", ref, lib, err);
+    errors += err;
+
+    TIME(dsp_add_i16(a16, b16, c16, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c16[i] != (int16_t)(a16[i] + b16[i]);
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) c16[i] = a16[i] + b16[i]);
+    print_result("add_i16", cycles, lib, err);
+    errors += err;
+
+    TIME(dsp_sub_i16(a16, b16, c16, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c16[i] != (int16_t)(a16[i] - b16[i]);
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) c16[i] = a16[i] - b16[i]);
+    print_result("sub_i16", cycles, lib, err);
+    errors += err;
+
+    TIME(dsp_add_i8(a8, b8, c8, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c8[i] != (int8_t)(a8[i] + b8[i]);
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) c8[i] = a8[i] + b8[i]);
+    print_result("add_i8 ", cycles, lib, err);
+    errors += err;
+
+    TIME(dsp_sub_i8(a8, b8, c8, DSP_TEST_N));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < DSP_TEST_N; i++) err += c8[i] != (int8_t)(a8[i] - b8[i]);
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) c8[i] = a8[i] - b8[i]);
+    print_result("sub_i8 ", cycles, lib, err);
+    errors += err;
+
+    dot_ref = 0;
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) dot_ref += a32[i] * b32[i]);
+    ref = cycles;
+    TIME(dot_lib = dsp_dot_i32(a32, b32, DSP_TEST_N));
+    print_result("dot_i32", ref, cycles, dot_lib != dot_ref);
+    errors += dot_lib != dot_ref;
+
+    dot_ref = 0;
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) dot_ref += a16[i] * b16[i]);
+    ref = cycles;
+    TIME(dot_lib = dsp_dot_i16(a16, b16, DSP_TEST_N));
+    print_result("dot_i16", ref, cycles, dot_lib != dot_ref);
+    errors += dot_lib != dot_ref;
+
+    dot_ref = 0;
+    TIME(for (int i = 0; i < DSP_TEST_N; i++) dot_ref += a8[i] * b8[i]);
+    ref = cycles;
+    TIME(dot_lib = dsp_dot_i8(a8, b8, DSP_TEST_N));
+    print_result("dot_i8 ", ref, cycles, dot_lib != dot_ref);
+    errors += dot_lib != dot_ref;
+
+    if (errors == 0) {
+        PRINTF("DSP test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("DSP test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,297 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the audio kernels of the DSP library (FIR filters, biquads, FFTs and
+// magnitudes) and reports their cycles. The filters are compared with plain C
+// loops, the FFTs with the spectrum of a known signal. Build it with
+// CPU=cv32e40px and an ARCH with the Xpulp extensions to compare the Xpulp
+// versions with the portable ones.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dsp.h"
+#include "dsp_filter.h"
+#include "dsp_fft.h"
+#include "csr.h"
+#include "x-heep.h"
+
+#define BLOCK       64      // Samples filtered per call
+#define N_BLOCKS    2       // The state is carried from a block to the next
+#define N_SAMPLES   ( BLOCK * N_BLOCKS )
+#define N_TAPS      15      // Odd, to also run the tail of the Xpulp FIR
+#define N_STAGES    2
+#define FFT_LEN     256
+#define FFT_BIN     8       // Bin of the test tone
+#define FFT_TOL     4       // Tolerance on the magnitudes, in LSBs
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// A low-pass FIR, in time-reversed order (it is symmetric)
+static const int16_t fir_q15[N_TAPS] __attribute__ ((aligned (4))) = {
+    -300, -500, 0, 1500, 3800, 6200, 7900, 8500, 7900, 6200, 3800, 1500, 0, -500, -300
+};
+static int32_t fir_q31[N_TAPS];
+
+// Two low-pass stages, b0 b1 b2 a1 a2 in Q14
+static const int16_t biquad_q15[N_STAGES * DSP_BIQUAD_COEFFS] = {
+    1034, 2068, 1034, 21342, -9095,
+    1034, 2068, 1034, 24152, -12328,
+};
+static int32_t biquad_q31[N_STAGES * DSP_BIQUAD_COEFFS];
+
+static int16_t in16[N_SAMPLES] __attribute__ ((aligned (4)));
+static int16_t out16[N_SAMPLES] __attribute__ ((aligned (4)));
+static int16_t ref16[N_SAMPLES];
+static int32_t in32[N_SAMPLES], out32[N_SAMPLES], ref32[N_SAMPLES];
+
+static int16_t fir_state16[DSP_FIR_STATE_LEN(N_TAPS, BLOCK)] __attribute__ ((aligned (4)));
+static int32_t fir_state32[DSP_FIR_STATE_LEN(N_TAPS, BLOCK)];
+static int16_t bq_state16[N_STAGES * DSP_BIQUAD_STATE];
+static int32_t bq_state32[N_STAGES * DSP_BIQUAD_STATE];
+
+// A period of the tone of the FFTs: a sine of amplitude 0.5 in Q15
+#define TONE_PERIOD ( FFT_LEN / FFT_BIN )
+static const int16_t tone[TONE_PERIOD] = {
+    0, 3196, 6270, 9102, 11585, 13623, 15137, 16069, 16384, 16069, 15137, 13623, 11585, 9102, 6270, 3196,
+    0, -3196, -6270, -9102, -11585, -13623, -15137, -16069, -16384, -16069, -15137, -13623, -11585, -9102, -6270, -3196
+};
+
+static int16_t fft16[FFT_LEN] __attribute__ ((aligned (4)));
+static int32_t fft32[FFT_LEN];
+static int16_t mag16[FFT_LEN / 2];
+static int32_t mag32[FFT_LEN / 2];
+static uint32_t mag_sq16[FFT_LEN / 2];
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static void print_result(const char *name, uint32_t ref, uint32_t lib, uint32_t errors)
+{
+    PRINTF("%s: cycles C loop %u library %u%s\n\r", name, ref, lib, errors ? " ERROR" : "");
+}
+
+static void print_cycles(const char *name, uint32_t lib, uint32_t errors)
+{
+    PRINTF("%s: cycles library %u%s\n\r", name, lib, errors ? " ERROR" : "");
+}
+
+static int32_t sat(int64_t val, int32_t max)
+{
+    return val > max ? max : val < -max - 1 ? -max - 1 : val;
+}
+
+// The filters as plain C loops, on the whole input at once
+static void ref_fir_q15(void)
+{
+    for (int i = 0; i < N_SAMPLES; i++) {
+        int32_t acc = 0;
+        for (int k = 0; k < N_TAPS; k++) {
+            int j = i - (N_TAPS - 1) + k;
+            acc += j >= 0 ? fir_q15[k] * in16[j] : 0;
+        }
+        ref16[i] = sat(acc >> 15, INT16_MAX);
+    }
+}
+
+static void ref_fir_q31(void)
+{
+    for (int i = 0; i < N_SAMPLES; i++) {
+        int64_t acc = 0;
+        for (int k = 0; k < N_TAPS; k++) {
+            int j = i - (N_TAPS - 1) + k;
+            acc += j >= 0 ? (int64_t)fir_q31[k] * in32[j] : 0;
+        }
+        ref32[i] = sat(acc >> 31, INT32_MAX);
+    }
+}
+
+static void ref_biquad_q15(void)
+{
+    for (int i = 0; i < N_SAMPLES; i++) ref16[i] = in16[i];
+    for (int s = 0; s < N_STAGES; s++) {
+        const int16_t *c = &biquad_q15[s * DSP_BIQUAD_COEFFS];
+        int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (int i = 0; i < N_SAMPLES; i++) {
+            int32_t x0 = ref16[i];
+            int32_t y0 = sat((c[0] * x0 + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2) >> 14, INT16_MAX);
+            x2 = x1; x1 = x0; y2 = y1; y1 = y0;
+            ref16[i] = y0;
+        }
+    }
+}
+
+static void ref_biquad_q31(void)
+{
+    for (int i = 0; i < N_SAMPLES; i++) ref32[i] = in32[i];
+    for (int s = 0; s < N_STAGES; s++) {
+        const int32_t *c = &biquad_q31[s * DSP_BIQUAD_COEFFS];
+        int64_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (int i = 0; i < N_SAMPLES; i++) {
+            int64_t x0 = ref32[i];
+            int64_t y0 = sat((c[0] * x0 + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2) >> 30, INT32_MAX);
+            x2 = x1; x1 = x0; y2 = y1; y1 = y0;
+            ref32[i] = y0;
+        }
+    }
+}
+
+// Number of magnitudes that are off by more than tol from a tone of magnitude
+// peak at the bins k1 and k2
+static uint32_t check_tone(const int32_t *mag, int n, int k1, int k2, int32_t peak, int32_t tol)
+{
+    uint32_t err = 0;
+    for (int k = 0; k < n; k++) {
+        int32_t diff = mag[k] - (k == k1 || k == k2 ? peak : 0);
+        err += diff > tol || diff < -tol;
+    }
+    return err;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t err, ref, lib;
+    dsp_fir_q15_t fir16;
+    dsp_fir_q31_t fir32;
+    dsp_biquad_q15_t bq16;
+    dsp_biquad_q31_t bq32;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("DSP audio kernels, Xpulp %s\n\r", DSP_XPULP ? "on" : "off");
+
+    // A square wave with a step, so that the filters ring and saturate
+    for (int i = 0; i < N_SAMPLES; i++) {
+        in16[i] = (i / 9) & 1 ? 30000 : -20000 + i * 100;
+        in32[i] = (int32_t)in16[i] << 16;
+    }
+    for (int i = 0; i < N_TAPS; i++) fir_q31[i] = (int32_t)fir_q15[i] << 16;
+    for (int i = 0; i < N_STAGES * DSP_BIQUAD_COEFFS; i++) biquad_q31[i] = (int32_t)biquad_q15[i] << 16;
+
+    // FIR
+    TIME(ref_fir_q15());
+    ref = cycles;
+    dsp_fir_init_q15(&fir16, fir_q15, N_TAPS, fir_state16, BLOCK);
+    TIME(for (int b = 0; b < N_BLOCKS; b++) dsp_fir_q15(&fir16, &in16[b * BLOCK], &out16[b * BLOCK], BLOCK));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < N_SAMPLES; i++) err += out16[i] != ref16[i];
+    print_result("fir_q15   ", ref, lib, err);
+    errors += err;
+
+    TIME(ref_fir_q31());
+    ref = cycles;
+    dsp_fir_init_q31(&fir32, fir_q31, N_TAPS, fir_state32, BLOCK);
+    TIME(for (int b = 0; b < N_BLOCKS; b++) dsp_fir_q31(&fir32, &in32[b * BLOCK], &out32[b * BLOCK], BLOCK));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < N_SAMPLES; i++) err += out32[i] != ref32[i];
+    print_result("fir_q31   ", ref, lib, err);
+    errors += err;
+
+    // Biquads
+    TIME(ref_biquad_q15());
+    ref = cycles;
+    dsp_biquad_init_q15(&bq16, biquad_q15, bq_state16, N_STAGES);
+    TIME(for (int b = 0; b < N_BLOCKS; b++) dsp_biquad_q15(&bq16, &in16[b * BLOCK], &out16[b * BLOCK], BLOCK));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < N_SAMPLES; i++) err += out16[i] != ref16[i];
+    print_result("biquad_q15", ref, lib, err);
+    errors += err;
+
+    TIME(ref_biquad_q31());
+    ref = cycles;
+    dsp_biquad_init_q31(&bq32, biquad_q31, bq_state32, N_STAGES);
+    TIME(for (int b = 0; b < N_BLOCKS; b++) dsp_biquad_q31(&bq32, &in32[b * BLOCK], &out32[b * BLOCK], BLOCK));
+    lib = cycles;
+    err = 0;
+    for (int i = 0; i < N_SAMPLES; i++) err += out32[i] != ref32[i];
+    print_result("biquad_q31", ref, lib, err);
+    errors += err;
+
+    // FFTs of a sine of amplitude 0.5, in the bin FFT_BIN of the real FFT: the
+    // spectra scaled by 1/N have a magnitude of 0.25 in the bins of the tone.
+    // The complex FFT of FFT_LEN / 2 points has its real parts as input.
+    for (int i = 0; i < FFT_LEN / 2; i++) {
+        fft16[2 * i] = tone[i % TONE_PERIOD];
+        fft16[2 * i + 1] = 0;
+    }
+    TIME(dsp_cfft_q15(fft16, FFT_LEN / 2));
+    lib = cycles;
+    dsp_cmplx_mag_q15(fft16, mag16, FFT_LEN / 2);
+    for (int k = 0; k < FFT_LEN / 2; k++) mag32[k] = mag16[k];
+    err = check_tone(mag32, FFT_LEN / 2, FFT_BIN / 2, FFT_LEN / 2 - FFT_BIN / 2, 8192, FFT_TOL);
+    print_cycles("cfft_q15  ", lib, err);
+    errors += err;
+
+    for (int i = 0; i < FFT_LEN / 2; i++) {
+        fft32[2 * i] = (int32_t)tone[i % TONE_PERIOD] << 16;
+        fft32[2 * i + 1] = 0;
+    }
+    TIME(dsp_cfft_q31(fft32, FFT_LEN / 2));
+    lib = cycles;
+    dsp_cmplx_mag_q31(fft32, mag32, FFT_LEN / 2);
+    err = check_tone(mag32, FFT_LEN / 2, FFT_BIN / 2, FFT_LEN / 2 - FFT_BIN / 2, 8192 << 16, FFT_TOL << 16);
+    print_cycles("cfft_q31  ", lib, err);
+    errors += err;
+
+    // The bin 0 of the real FFTs holds the DC and the Nyquist bins, both 0
+    for (int i = 0; i < FFT_LEN; i++) fft16[i] = tone[i % TONE_PERIOD];
+    TIME(dsp_rfft_q15(fft16, FFT_LEN));
+    lib = cycles;
+    TIME(dsp_cmplx_mag_q15(fft16, mag16, FFT_LEN / 2));
+    ref = cycles;
+    for (int k = 0; k < FFT_LEN / 2; k++) mag32[k] = mag16[k];
+    err = check_tone(mag32, FFT_LEN / 2, FFT_BIN, FFT_BIN, 8192, FFT_TOL);
+    print_cycles("rfft_q15  ", lib, err);
+    print_cycles("mag_q15   ", ref, err);
+    errors += err;
+
+    TIME(dsp_cmplx_mag_sq_q15(fft16, mag_sq16, FFT_LEN / 2));
+    lib = cycles;
+    err = 0;
+    for (int k = 0; k < FFT_LEN / 2; k++) {
+        uint32_t m = mag16[k];
+        err += mag_sq16[k] < m * m || mag_sq16[k] > (m + 1) * (m + 1);
+    }
+    print_cycles("mag_sq_q15", lib, err);
+    errors += err;
+
+    for (int i = 0; i < FFT_LEN; i++) fft32[i] = (int32_t)tone[i % TONE_PERIOD] << 16;
+    TIME(dsp_rfft_q31(fft32, FFT_LEN));
+    lib = cycles;
+    TIME(dsp_cmplx_mag_q31(fft32, mag32, FFT_LEN / 2));
+    ref = cycles;
+    err = check_tone(mag32, FFT_LEN / 2, FFT_BIN, FFT_BIN, 8192 << 16, FFT_TOL << 16);
+    print_cycles("rfft_q31  ", lib, err);
+    print_cycles("mag_q31   ", ref, err);
+    errors += err;
+
+    // The lengths that are not powers of 2
+    err = dsp_rfft_q15(fft16, 48) + dsp_cfft_q31(fft32, 1) + dsp_rfft_q31(fft32, 2 * DSP_FFT_MAX_LEN);
+    PRINTF("fft_len   : %s\n\r", err ? "ERROR" : "rejected");
+    errors += err;
+
+    if (errors == 0) {
+        PRINTF("DSP audio test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("DSP audio test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
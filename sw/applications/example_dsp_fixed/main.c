@@ -0,0 +1,267 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Fixed-point math benchmark: the functions of dsp_fixed.h against the float
+// functions of the C library they replace. It reports the cycles per call of
+// both and the largest error of the fixed-point results in LSBs, checked
+// against the bounds of dsp_fixed.h. The exact results are computed in
+// double, since the Q31 results are more accurate than the float ones. The
+// errors of atan2_q31 and sqrt_q31 also cover the edges of their ranges: the
+// axes, the small angles and magnitudes and the inputs near full scale. Build
+// it with a plain ARCH, e.g. rv32imc, to compare with soft-float on the
+// cv32e20 or the cv32e40x without fpu_ss.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dsp_fixed.h"
+#include "x-heep.h"
+
+#define FS_INITIAL  0x01
+
+#define N           32      // Inputs of each function
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#if defined(__riscv_flen) || defined(__riscv_zfinx)
+#define FLOAT_HW "hardware"
+#else
+#define FLOAT_HW "soft-float"
+#endif
+
+#define TWO_PI      6.283185307179586
+
+static float fa[N], fb[N], fout[N], fout2[N];
+static int32_t qa[N], qb[N], qout[N], qout2[N];
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// Largest error of the function being checked, in LSBs
+static double max_err;
+
+static void check(double lib, double exact, double scale)
+{
+    double d = fabs(lib - exact * scale);
+    if (d > max_err) max_err = d;
+}
+
+static void check_angle(double lib, double exact, double turn)
+{
+    double d = lib - exact / TWO_PI * turn;
+    while (d > turn / 2) d -= turn;
+    while (d < -turn / 2) d += turn;
+    if (fabs(d) > max_err) max_err = fabs(d);
+}
+
+// The points near the axes, the small angles and the small and full-scale
+// magnitudes, in the four quadrants
+static void check_atan2_q31_edges(void)
+{
+    static const int32_t xs[] = {INT32_MIN, INT32_MAX, 1078698534, 65536, 1};
+
+    for (int i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        for (int k = 0; k < 32; k++) {
+            for (int q = 0; q < 4; q++) {
+                // -INT32_MIN is taken as INT32_MAX
+                int32_t x = q & 1 ? -(xs[i] + (xs[i] == INT32_MIN)) : xs[i];
+                int32_t y = q & 2 ? -((xs[i] >> k) + (xs[i] == INT32_MIN && k == 0)) : xs[i] >> k;
+                check_angle(dsp_atan2_q31(y, x), atan2(y, x), 4294967296.0);
+                check_angle(dsp_atan2_q31(x, y), atan2(x, y), 4294967296.0);
+            }
+        }
+    }
+    check_angle(dsp_atan2_q31(116906249, 1078698534), atan2(116906249, 1078698534), 4294967296.0);
+}
+
+// The powers of 2 and their neighbours, the small inputs and the inputs near
+// full scale
+static void check_sqrt_q31_edges(void)
+{
+    for (int k = 0; k < 31; k++) {
+        for (int32_t d = -1; d <= 1; d++) {
+            int32_t x = (int32_t)(1u << k) + d;
+            check(dsp_sqrt_q31(x), sqrt(x / 2147483648.0), 2147483648.0);
+        }
+    }
+    for (int32_t i = 0; i < 256; i++) {
+        int32_t x = i < 64 ? i + 1 : INT32_MAX - (i - 64) * 4093;
+        check(dsp_sqrt_q31(x), sqrt(x / 2147483648.0), 2147483648.0);
+    }
+    check(dsp_sqrt_q31(2147069229), sqrt(2147069229 / 2147483648.0), 2147483648.0);
+}
+
+static uint32_t report(const char *name, uint32_t ref, uint32_t lib, uint32_t tol)
+{
+    uint32_t err = (uint32_t)ceil(max_err);
+
+    // Speedup in hundredths, to print it without floats
+    PRINTF("%s: cycles per call float %u fixed %u speedup x%u.%02u, error %u LSB%s\n\r", name,
+           ref / N, lib / N, lib ? ref / lib : 0, lib ? (100 * ref / lib) % 100 : 0, err,
+           err > tol ? " ERROR" : "");
+    max_err = 0;
+    return err > tol;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t ref, lib;
+
+    //enable FP operations, if any
+    CSR_SET_BITS(CSR_REG_MSTATUS, (FS_INITIAL << 13));
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("Fixed-point math against the float functions, %s\n\r", FLOAT_HW);
+
+    // Sine and cosine
+    for (int i = 0; i < N; i++) {
+        qa[i] = (uint16_t)(i * 2053 + 17);
+        fa[i] = (float)(qa[i] * (TWO_PI / 65536));
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = sinf(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_sin_q15(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check(qout[i], fmin(sin(qa[i] * TWO_PI / 65536) * 32768, 32767), 1);
+    errors += report("sin_q15   ", ref, lib, 2);
+
+    TIME(for (int i = 0; i < N; i++) fout[i] = cosf(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_cos_q15(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check(qout[i], fmin(cos(qa[i] * TWO_PI / 65536) * 32768, 32767), 1);
+    errors += report("cos_q15   ", ref, lib, 2);
+
+    for (int i = 0; i < N; i++) {
+        qa[i] = (int32_t)(i * 0x0813c9d5u + 0x1234567u);
+        fa[i] = (float)((uint32_t)qa[i] * (TWO_PI / 4294967296.0));
+    }
+    TIME(for (int i = 0; i < N; i++) { fout[i] = sinf(fa[i]); fout2[i] = cosf(fa[i]); });
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) dsp_sincos_q31(qa[i], &qout[i], &qout2[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) {
+        double a = (uint32_t)qa[i] * (TWO_PI / 4294967296.0);
+        check(qout[i], sin(a), 2147483648.0);
+        check(qout2[i], cos(a), 2147483648.0);
+    }
+    errors += report("sincos_q31", ref, lib, 64);
+
+    // atan2, over the four quadrants
+    for (int i = 0; i < N; i++) {
+        qa[i] = (int16_t)(i * 7919 + 101);
+        qb[i] = (int16_t)(i * 4271 - 3000);
+        fa[i] = qa[i];
+        fb[i] = qb[i];
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = atan2f(fa[i], fb[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_atan2_q15(qa[i], qb[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check_angle(qout[i], atan2(qa[i], qb[i]), 65536);
+    errors += report("atan2_q15 ", ref, lib, 2);
+
+    for (int i = 0; i < N; i++) {
+        qa[i] = (int32_t)(i * 0x9e3779b1u);
+        qb[i] = (int32_t)(i * 0x7f4a7c15u + 0x2545f491u);
+        fa[i] = qa[i];
+        fb[i] = qb[i];
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = atan2f(fa[i], fb[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_atan2_q31(qa[i], qb[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check_angle(qout[i], atan2(qa[i], qb[i]), 4294967296.0);
+    check_atan2_q31_edges();
+    errors += report("atan2_q31 ", ref, lib, 8);
+
+    // Square roots
+    for (int i = 0; i < N; i++) {
+        qa[i] = (i * 1021 + 7) & 0x7fff;
+        fa[i] = qa[i] / 32768.0f;
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = sqrtf(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_sqrt_q15(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check(qout[i], sqrt(qa[i] / 32768.0), 32768);
+    errors += report("sqrt_q15  ", ref, lib, 1);
+
+    for (int i = 0; i < N; i++) {
+        qa[i] = (int32_t)((i * 0x9e3779b1u) >> (1 + i % 24));
+        fa[i] = qa[i] / 2147483648.0f;
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = sqrtf(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_sqrt_q31(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check(qout[i], sqrt(qa[i] / 2147483648.0), 2147483648.0);
+    check_sqrt_q31_edges();
+    errors += report("sqrt_q31  ", ref, lib, 1);
+
+    // Inverse square root, log2 and exp2 in Q16.16
+    for (int i = 0; i < N; i++) {
+        qa[i] = (int32_t)(((i + 1) * 0x9e3779b1u) >> (i % 31));
+        fa[i] = (uint32_t)qa[i] / 65536.0f;
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = 1.0f / sqrtf(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_rsqrt_q16(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check((uint32_t)qout[i], 1 / sqrt((uint32_t)qa[i] / 65536.0), 65536);
+    errors += report("rsqrt_q16 ", ref, lib, 1);
+
+    TIME(for (int i = 0; i < N; i++) fout[i] = log2f(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_log2_q16(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check(qout[i], log2((uint32_t)qa[i] / 65536.0), 65536);
+    errors += report("log2_q16  ", ref, lib, 1);
+
+    // exp2 up to 1, where the bound is 1 LSB
+    for (int i = 0; i < N; i++) {
+        qa[i] = -(int32_t)((i * 0x2f1u * 65536 / N) % (16 * 65536));
+        fa[i] = qa[i] / 65536.0f;
+    }
+    TIME(for (int i = 0; i < N; i++) fout[i] = exp2f(fa[i]));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) qout[i] = dsp_exp2_q16(qa[i]));
+    lib = cycles;
+    for (int i = 0; i < N; i++) check((uint32_t)qout[i], exp2(qa[i] / 65536.0), 65536);
+    errors += report("exp2_q16  ", ref, lib, 1);
+
+    // Conversions
+    for (int i = 0; i < N; i++) fa[i] = (float)(i - N / 2) / N;
+    TIME(dsp_f32_to_q15_vec(fa, (int16_t *)qout, N));
+    lib = cycles;
+    dsp_q15_to_f32_vec((const int16_t *)qout, fout, N);
+    for (int i = 0; i < N; i++) check(fout[i], fa[i], 1);
+    PRINTF("f32_to_q15: cycles per call %u%s\n\r", lib / N, max_err != 0 ? " ERROR" : "");
+    errors += max_err != 0;
+
+    if (errors == 0) {
+        PRINTF("Fixed-point math benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Fixed-point math benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
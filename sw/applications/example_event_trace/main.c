@@ -0,0 +1,171 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Traces a section of the app with the event trace unit: markers written by
+// the CPU, the fast interrupt of timer 1 (raised by its INTR_TEST register)
+// from the raise of the line to the entry of the core, and a register script
+// the DMA writes to the MARKER register while the CPU sleeps, which gives its
+// markers, the done interrupt of the channel and the sleep of the core. The
+// trace is then read back, printed and checked, with the interrupt latency.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "dma.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "reg_script.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"  // Generated.
+#include "event_trace.h"
+
+/* The trace is the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define RUNS_N          4
+
+// Markers of the CPU and of the DMA
+#define MARKER_START    1
+#define MARKER_DMA      2
+#define MARKER_END      3
+#define MARKER_SCRIPT   10
+
+#define TIMER_1_IRQ     EVENT_TRACE_IRQ_FAST(kTimer_1_fic_e)
+
+// The INTR_TEST register of the hart 1 of the AO timer
+#define TIMER_1_INTR_TEST \
+    ((volatile uint32_t *)(RV_TIMER_AO_START_ADDRESS + RV_TIMER_INTR_TEST0_REG_OFFSET + 0x100))
+
+static rv_timer_t timer_0_1;
+static volatile uint32_t isr_runs;
+
+static const uint32_t script_offsets[] = {
+    EVENT_TRACE_MARKER_REG_OFFSET, EVENT_TRACE_MARKER_REG_OFFSET, EVENT_TRACE_MARKER_REG_OFFSET
+};
+static const uint32_t script_values[] = {MARKER_SCRIPT, MARKER_SCRIPT + 1, MARKER_SCRIPT + 2};
+static const mmio_region_script_t script = REG_SCRIPT_INIT(script_offsets, script_values);
+
+static event_trace_entry_t trace[EVENT_TRACE_DEPTH];
+
+static void timer_1_handler(uint32_t id)
+{
+    rv_timer_irq_clear(&timer_0_1, 1, 0);
+    clear_fast_interrupt(kTimer_1_fic_e);
+    isr_runs++;
+}
+
+static void print_entry(const event_trace_entry_t *e)
+{
+    uint32_t c = e->code;
+
+    if (c == EVENT_TRACE_CODE_WRAP) {
+        PRINTF("%10u wrap\n\r", e->time);
+    } else if (EVENT_TRACE_IS_IRQ_TAKEN(c)) {
+        PRINTF("%10u irq %u taken\n\r", e->time, c & 0x1f);
+    } else if (EVENT_TRACE_IS_IRQ_RAISED(c)) {
+        PRINTF("%10u irq %u raised\n\r", e->time, c & 0x1f);
+    } else if (EVENT_TRACE_IS_DMA_DONE(c)) {
+        PRINTF("%10u dma %u done\n\r", e->time, c & 0xf);
+    } else if (EVENT_TRACE_IS_DMA_WINDOW(c)) {
+        PRINTF("%10u dma %u window\n\r", e->time, c & 0xf);
+    } else if (EVENT_TRACE_IS_POWER(c)) {
+        PRINTF("%10u domain %u %s\n\r", e->time, (c >> 1) & 0x1f, c & 1 ? "on" : "off");
+    } else {
+        PRINTF("%10u marker %u\n\r", e->time, c & EVENT_TRACE_MARKER_MARKER_MASK);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_irq_enable(&timer_0_1, 1, 0, kRvTimerEnabled);
+    irq_register(IRQ_SRC_FAST(kTimer_1_fic_e), timer_1_handler);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), true);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    dma_init(NULL);
+
+    event_trace_start(EVENT_TRACE_ALL, 1u << TIMER_1_IRQ, false);
+    event_trace_marker(MARKER_START);
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        *TIMER_1_INTR_TEST = 1;
+        while (isr_runs != i + 1) {
+        }
+    }
+    event_trace_marker(MARKER_DMA);
+    if (reg_script_apply(0, event_trace_base, &script) != REG_SCRIPT_OK) {
+        PRINTF("DMA script failure\n\r");
+        return EXIT_FAILURE;
+    }
+    event_trace_marker(MARKER_END);
+    event_trace_stop();
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), false);
+
+    uint32_t n = event_trace_read(trace, EVENT_TRACE_DEPTH);
+    PRINTF("%u entries, %u dropped:\n\r", n, event_trace_dropped());
+
+    // The markers in order, an entry of the core for each raise of the line
+    uint32_t next_marker = 0;
+    static const uint32_t markers[] = {
+        MARKER_START, MARKER_DMA, MARKER_SCRIPT, MARKER_SCRIPT + 1, MARKER_SCRIPT + 2, MARKER_END
+    };
+    uint32_t raised = 0, taken = 0, raised_time = 0, latency = 0;
+    uint32_t dma_done = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        const event_trace_entry_t *e = &trace[k];
+        print_entry(e);
+        if (k > 0 && e->time < trace[k - 1].time) {
+            errors++;
+        }
+        if (EVENT_TRACE_IS_MARKER(e->code)) {
+            if (next_marker >= sizeof(markers) / sizeof(markers[0]) ||
+                e->code != EVENT_TRACE_CODE_MARKER(markers[next_marker])) {
+                errors++;
+            }
+            next_marker++;
+        } else if (e->code == EVENT_TRACE_CODE_IRQ_RAISED(TIMER_1_IRQ)) {
+            raised++;
+            raised_time = e->time;
+        } else if (e->code == EVENT_TRACE_CODE_IRQ_TAKEN(TIMER_1_IRQ)) {
+            taken++;
+            latency += e->time - raised_time;
+            if (taken != raised) {
+                errors++;
+            }
+        } else if (e->code == EVENT_TRACE_CODE_DMA_DONE(0)) {
+            dma_done++;
+        }
+    }
+    errors += next_marker != sizeof(markers) / sizeof(markers[0]);
+    errors += raised != RUNS_N || taken != RUNS_N || dma_done != 1;
+    errors += event_trace_dropped() != 0 || event_trace_overwritten();
+
+    if (taken != 0) {
+        PRINTF("Timer 1 interrupt latency: %u cycles\n\r", latency / taken);
+    }
+
+    if (errors == 0) {
+        PRINTF("Event trace test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Event trace test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Runs two stackless tasks on the executor of exec.h, without an RTOS. The
+// AO timer 1 ticks periodically and its handler posts a tick to both tasks:
+// the counter task counts the ticks, the copy task starts a DMA copy at each
+// tick and waits for its callback. The core sleeps in wfi in between.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "irq.h"
+#include "fast_intr_ctrl.h"
+#include "rv_timer.h"
+#include "soc_ctrl.h"
+#include "dma.h"
+#include "exec.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define TICKS_N         8
+#define TICK_CYCLES     2000
+#define BLOCK_WORDS     64
+#define DMA_CH          0
+
+// The events of the tasks
+#define EV_TICK         0x1
+#define EV_DMA_DONE     0x2
+
+// What the copy task keeps across its waits
+typedef struct {
+    uint32_t block;
+    uint32_t errors;
+} copy_ctx_t;
+
+static rv_timer_t timer_0_1;
+static uint64_t next_tick;
+
+static exec_task_t count_task;
+static exec_task_t copy_task;
+static uint32_t ticks;
+static copy_ctx_t copy_ctx;
+
+static uint32_t src[TICKS_N][BLOCK_WORDS];
+static uint32_t dst[BLOCK_WORDS];
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+static dma_queue_entry_t entry;
+
+// The tick, posted to both tasks
+void fic_irq_timer_1(void)
+{
+    rv_timer_irq_clear(&timer_0_1, 1, 0);
+    next_tick += TICK_CYCLES;
+    rv_timer_arm(&timer_0_1, 1, 0, next_tick);
+
+    exec_post(&count_task, EV_TICK);
+    exec_post(&copy_task, EV_TICK);
+}
+
+static void copy_done(dma_queue_entry_t *p_entry)
+{
+    exec_post(&copy_task, EV_DMA_DONE);
+}
+
+static exec_state_t count_fn(exec_task_t *task)
+{
+    EXEC_BEGIN(task);
+    while (ticks < TICKS_N) {
+        EXEC_WAIT(task, EV_TICK);
+        ticks++;
+    }
+    EXEC_END(task);
+}
+
+static exec_state_t copy_fn(exec_task_t *task)
+{
+    copy_ctx_t *ctx = (copy_ctx_t *)task->ctx;
+
+    EXEC_BEGIN(task);
+    for (ctx->block = 0; ctx->block < TICKS_N; ctx->block++) {
+        EXEC_WAIT(task, EV_TICK);
+
+        tgt_src.ptr = (uint8_t *)src[ctx->block];
+        if (dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY)
+            | dma_submit(&entry)) {
+            ctx->errors++;
+            continue;
+        }
+        EXEC_WAIT(task, EV_DMA_DONE);
+
+        for (uint32_t i = 0; i < BLOCK_WORDS; i++) {
+            ctx->errors += dst[i] != src[ctx->block][i];
+        }
+    }
+    EXEC_END(task);
+}
+
+int main(int argc, char *argv[])
+{
+    for (uint32_t b = 0; b < TICKS_N; b++) {
+        for (uint32_t i = 0; i < BLOCK_WORDS; i++) {
+            src[b][i] = (b << 16) | i;
+        }
+    }
+
+    dma_init(NULL);
+    tgt_src = (dma_target_t){.inc_du = 1, .size_du = BLOCK_WORDS, .trig = DMA_TRIG_MEMORY, .type = DMA_DATA_TYPE_WORD};
+    tgt_dst = (dma_target_t){.ptr = (uint8_t *)dst, .inc_du = 1, .size_du = BLOCK_WORDS, .trig = DMA_TRIG_MEMORY, .type = DMA_DATA_TYPE_WORD};
+    trans = (dma_trans_t){.src = &tgt_src, .dst = &tgt_dst, .mode = DMA_TRANS_MODE_SINGLE, .channel = DMA_CH, .end = DMA_TRANS_END_INTR};
+    entry = (dma_queue_entry_t){.trans = &trans, .cb = copy_done};
+
+    // The counter of the hart 1 of the AO timer counts the cycles
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_set_tick_params(&timer_0_1, 1, (rv_timer_tick_params_t){.prescale = 0, .tick_step = 1});
+    next_tick = TICK_CYCLES;
+    rv_timer_arm(&timer_0_1, 1, 0, next_tick);
+    rv_timer_irq_enable(&timer_0_1, 1, 0, kRvTimerEnabled);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), true);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    exec_start(&count_task, count_fn, NULL);
+    exec_start(&copy_task, copy_fn, &copy_ctx);
+    rv_timer_counter_set_enabled(&timer_0_1, 1, kRvTimerEnabled);
+
+    exec_run();
+
+    rv_timer_counter_set_enabled(&timer_0_1, 1, kRvTimerDisabled);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), false);
+
+    PRINTF("%u ticks, %u blocks copied, %u B of tasks\n\r", ticks, copy_ctx.block,
+           (unsigned)(2 * sizeof(exec_task_t) + sizeof(copy_ctx_t)));
+
+    if (ticks == TICKS_N && copy_ctx.block == TICKS_N && copy_ctx.errors == 0) {
+        PRINTF("Executor test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Executor test failure: %u errors\n\r", copy_ctx.errors);
+        return EXIT_FAILURE;
+    }
+}
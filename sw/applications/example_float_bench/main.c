@@ -0,0 +1,203 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Float kernel benchmark: the dot product, AXPY, GEMM and softmax of
+// dsp_float.h against plain loops accumulating in a single variable. It
+// checks that both agree within rounding and reports their cycles and the
+// speedup of the library. To compare the floating-point units, build it with
+// ARCH=rv32imfc for
+// - the internal FPU of the cv32e40p: CPU=cv32e40p, FUSESOC_PARAM="--FPU=1";
+// - the fpu_ss of the cv32e40x: CPU=cv32e40x, FUSESOC_PARAM="--X_EXT=1".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dsp_float.h"
+#include "x-heep.h"
+
+#define FS_INITIAL  0x01
+
+#define VEC_N       64      // Elements of the vectors
+#define GEMM_N      12      // Rows and columns of the matrices
+#define SOFTMAX_N   32      // Inputs of the softmax
+#define TOLERANCE   1e-4f   // Relative difference allowed between the kernels
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#if defined(CPU_TYPE_CV32E40P)
+#define CPU_NAME "cv32e40p"
+#elif defined(CPU_TYPE_CV32E40PX)
+#define CPU_NAME "cv32e40px"
+#elif defined(CPU_TYPE_CV32E40X)
+#define CPU_NAME "cv32e40x"
+#else
+#define CPU_NAME "cv32e20"
+#endif
+
+#if defined(__riscv_flen) || defined(__riscv_zfinx)
+#define FLOAT_HW "hardware"
+#else
+#define FLOAT_HW "soft-float"
+#endif
+
+static float va[VEC_N], vb[VEC_N], vref[VEC_N], vlib[VEC_N];
+static float ma[GEMM_N * GEMM_N], mb[GEMM_N * GEMM_N];
+static float mref[GEMM_N * GEMM_N], mlib[GEMM_N * GEMM_N];
+static float sx[SOFTMAX_N], sref[SOFTMAX_N], slib[SOFTMAX_N];
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// The baseline kernels, each result waits for the previous one
+
+static float __attribute__ ((noinline)) dot_ref(const float *a, const float *b, int n)
+{
+    float acc = 0.0f;
+
+    for (int i = 0; i < n; i++) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+static void __attribute__ ((noinline)) axpy_ref(float alpha, const float *x, float *y, int n)
+{
+    for (int i = 0; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+static void __attribute__ ((noinline)) gemm_ref(const float *A, const float *B, float *C, int N)
+{
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            float acc = 0.0f;
+            for (int k = 0; k < N; k++) {
+                acc += A[i*N+k] * B[k*N+j];
+            }
+            C[i*N+j] = acc;
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) softmax_ref(const float *x, float *y, int n)
+{
+    float max = x[0];
+    float sum = 0.0f;
+
+    for (int i = 1; i < n; i++) {
+        if (x[i] > max) max = x[i];
+    }
+    for (int i = 0; i < n; i++) {
+        y[i] = expf(x[i] - max);
+        sum += y[i];
+    }
+    for (int i = 0; i < n; i++) {
+        y[i] /= sum;
+    }
+}
+
+static uint32_t compare(const float *ref, const float *lib, uint32_t n)
+{
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        float scale = fabsf(ref[i]) > 1.0f ? fabsf(ref[i]) : 1.0f;
+        if (fabsf(ref[i] - lib[i]) > TOLERANCE * scale) errors++;
+    }
+    return errors;
+}
+
+static void print_result(const char *name, uint32_t ref, uint32_t lib, uint32_t errors)
+{
+    // Speedup in hundredths, to print it without floats
+    PRINTF("%s: cycles C loop %u library %u speedup x%u.%02u%s\n\r", name, ref, lib,
+           lib ? ref / lib : 0, lib ? (100 * ref / lib) % 100 : 0, errors ? " ERROR" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t err, ref, lib;
+    float dref, dlib;
+
+    //enable FP operations
+    CSR_SET_BITS(CSR_REG_MSTATUS, (FS_INITIAL << 13));
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("Float kernels on the %s, %s, fused multiply-add %s\n\r", CPU_NAME, FLOAT_HW,
+           DSP_FMA ? "on" : "off");
+
+    for (int i = 0; i < VEC_N; i++) {
+        va[i] = (float)((i * 37) % 41 - 20) * 0.125f;
+        vb[i] = (float)((i * 53) % 29 - 14) * 0.25f;
+    }
+    for (int i = 0; i < GEMM_N * GEMM_N; i++) {
+        ma[i] = (float)((i * 7) % 19 - 9) * 0.5f;
+        mb[i] = (float)((i * 11) % 23 - 11) * 0.25f;
+    }
+    for (int i = 0; i < SOFTMAX_N; i++) {
+        sx[i] = (float)((i * 13) % 17 - 8) * 0.75f;
+    }
+
+    TIME(dref = dot_ref(va, vb, VEC_N));
+    ref = cycles;
+    TIME(dlib = dsp_dot_f32(va, vb, VEC_N));
+    lib = cycles;
+    err = compare(&dref, &dlib, 1);
+    print_result("dot", ref, lib, err);
+    errors += err;
+
+    for (int i = 0; i < VEC_N; i++) {
+        vref[i] = vb[i];
+        vlib[i] = vb[i];
+    }
+    TIME(axpy_ref(1.5f, va, vref, VEC_N));
+    ref = cycles;
+    TIME(dsp_axpy_f32(1.5f, va, vlib, VEC_N));
+    lib = cycles;
+    err = compare(vref, vlib, VEC_N);
+    print_result("axpy", ref, lib, err);
+    errors += err;
+
+    TIME(gemm_ref(ma, mb, mref, GEMM_N));
+    ref = cycles;
+    TIME(dsp_gemm_f32(ma, mb, mlib, GEMM_N, GEMM_N, GEMM_N));
+    lib = cycles;
+    err = compare(mref, mlib, GEMM_N * GEMM_N);
+    print_result("gemm", ref, lib, err);
+    errors += err;
+
+    TIME(softmax_ref(sx, sref, SOFTMAX_N));
+    ref = cycles;
+    TIME(dsp_softmax_f32(sx, slib, SOFTMAX_N));
+    lib = cycles;
+    err = compare(sref, slib, SOFTMAX_N);
+    print_result("softmax", ref, lib, err);
+    errors += err;
+
+    if (errors == 0) {
+        PRINTF("Float kernel benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Float kernel benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Formatting benchmark: the cycles of a line formatted by the snprintf of
+// newlib, by fmt_snprintf (fmt.h) and logged by FMT_LOG (fmt_log.h). The
+// outputs of fmt_snprintf are checked against the expected strings, then the
+// log is formatted on the chip and dumped. Decode the dump with
+//   python3 util/fmt_log_decode.py sw/build/main.elf uart0.log
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "fmt.h"
+#include "fmt_log.h"
+#include "x-heep.h"
+
+#define N           16      // Lines of each benchmark
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static char line[80];
+
+static fmt_log_rec_t log_buf[2 * N] __attribute__((aligned(4)));
+static fmt_log_t trace_log;
+
+static uint32_t check(const char *expected, int n)
+{
+    if (n != (int)strlen(expected) || strcmp(line, expected) != 0) {
+        PRINTF("fmt_snprintf: got \"%s\" (%d) instead of \"%s\"\n\r", line, n, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static void report(const char *name, uint32_t ref, uint32_t lib)
+{
+    // Speedup in hundredths, to print it without floats
+    PRINTF("%s: cycles per line snprintf %u, this one %u, speedup x%u.%02u\n\r", name, ref / N,
+           lib / N, lib ? ref / lib : 0, lib ? (100 * ref / lib) % 100 : 0);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t ref, lib;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // The conversions of fmt.h
+    errors += check("-42 42 4294967254", fmt_snprintf(line, sizeof(line), "%d %i %u", -42, 42, -42));
+    errors += check("[   7|7   |-0007]", fmt_snprintf(line, sizeof(line), "[%4d|%-4d|%05d]", 7, 7, -7));
+    errors += check("+5  5 0x1f 0X1F 017", fmt_snprintf(line, sizeof(line), "%+d % d %#x %#X %#o", 5, 5, 31, 31, 15));
+    errors += check("00042 0000beef |  ab|", fmt_snprintf(line, sizeof(line), "%.5d %08x |%*s|", 42, 0xbeef, 4, "ab"));
+    errors += check("x% hel", fmt_snprintf(line, sizeof(line), "%c%% %.3s", 'x', "hello"));
+    errors += check("255 65535 -1 18446744073709551615", fmt_snprintf(line, sizeof(line), "%hhu %hu %ld %llu",
+                                                                      (unsigned char)255, (unsigned short)65535, -1L, ~0ULL));
+    errors += check("0x20000000 %f", fmt_snprintf(line, sizeof(line), "%p %f", (void *)0x20000000));
+    // Truncated, the return value is the whole length
+    int n = fmt_snprintf(line, 6, "%d", 123456789);
+    errors += n != 9 || strcmp(line, "12345") != 0;
+
+    PRINTF("Formatting of a line of three integers and a string\n\r");
+
+    TIME(for (int i = 0; i < N; i++) snprintf(line, sizeof(line), "sample %d: x=%d y=%08x %s", i, -i * 1000, i * 0x1234567, "ok"));
+    ref = cycles;
+    TIME(for (int i = 0; i < N; i++) fmt_snprintf(line, sizeof(line), "sample %d: x=%d y=%08x %s", i, -i * 1000, i * 0x1234567, "ok"));
+    lib = cycles;
+    report("fmt_snprintf", ref, lib);
+
+    fmt_log_init(&trace_log, log_buf, sizeof(log_buf));
+    TIME(for (int i = 0; i < N; i++) FMT_LOG(&trace_log, "sample %d: x=%d y=%08x %s", i, -i * 1000, i * 0x1234567, "ok"));
+    lib = cycles;
+    report("FMT_LOG     ", ref, lib);
+
+    // The log is formatted later, e.g. at idle, or on the host
+    FMT_LOG(&trace_log, "records logged: %u, dropped: %u", N, trace_log.dropped);
+    TIME(fmt_log_print(&trace_log, N / 2));
+    PRINTF("fmt_log_print: cycles per line %u\n\r", cycles / (N / 2));
+    fmt_log_dump(&trace_log, 2 * N);
+    errors += fmt_log_pending(&trace_log) != 0 || trace_log.dropped != 0;
+
+    if (errors == 0) {
+        PRINTF("Formatting benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Formatting benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,421 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Latencies of the FreeRTOS port, in cycles of mcycle, from the instant a task
+// or an interrupt acts to the first instruction of the task it wakes:
+// - yield: taskYIELD between two tasks of the same priority;
+// - yield FP: the same between two tasks using the FPU, with the context
+//   selected by rtosFPU_CONTEXT (freertos_risc_v_chip_specific_extensions.h);
+// - raise to ISR: the interrupt of timer 3, raised by a write of its INTR_TEST,
+//   to its handler set by irq_register;
+// - ISR to task: xTaskNotifyFromISR and portYIELD_FROM_ISR in the handler to
+//   the task waiting in xTaskNotifyWait;
+// - queue: xQueueSend of a task to a task of a higher priority in xQueueReceive;
+// - mutex: xSemaphoreGive of a task to a task of a higher priority waiting in
+//   xSemaphoreTake, the giver having inherited its priority.
+// The minimum is the latency of the path, the maximum may hold a tick. Run
+// it on each core (make mcu-gen CPU=...) and, with an FPU, with
+// APP_CFLAGS=-DrtosFPU_CONTEXT=0, 1 or 2 to compare the contexts. The FP tasks
+// check that a register of the FPU survives their switches, which fails with
+// rtosFPU_CONTEXT=0, the port without the FPU context.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"  // Generated.
+#include "freertos_risc_v_chip_specific_extensions.h"
+#include "x-heep.h"
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define mainCONTROL_TASK_PRIORITY   ( tskIDLE_PRIORITY + 1 )
+#define mainBENCH_TASK_PRIORITY     ( tskIDLE_PRIORITY + 3 )
+
+#define mainRUNS                    ( 32 )
+
+#define FS_INITIAL                  0x01
+
+// The interrupt registers of the hart h of a timer are 0x100 bytes apart
+#define TIMER_REG(reg, h) \
+    ((volatile uint32_t *)(RV_TIMER_START_ADDRESS + (reg) + 0x100 * (h)))
+
+typedef struct
+{
+    const char *pcName;
+    uint32_t    ulMin;
+    uint32_t    ulMax;
+    uint32_t    ulSum;
+    uint32_t    ulCount;
+} Stat_t;
+
+enum
+{
+    statYIELD,
+    statYIELD_FP,
+    statRAISE_TO_ISR,
+    statISR_TO_TASK,
+    statQUEUE,
+    statMUTEX,
+    statN
+};
+
+static Stat_t xStats[ statN ] = {
+    [ statYIELD ]        = { .pcName = "yield" },
+    [ statYIELD_FP ]     = { .pcName = "yield FP" },
+    [ statRAISE_TO_ISR ] = { .pcName = "raise to ISR" },
+    [ statISR_TO_TASK ]  = { .pcName = "ISR to task" },
+    [ statQUEUE ]        = { .pcName = "queue" },
+    [ statMUTEX ]        = { .pcName = "mutex" },
+};
+
+static rv_timer_t timer_0_1;
+static rv_timer_t timer_2_3;
+
+static TaskHandle_t xBenchTask;
+static QueueHandle_t xQueue;
+static SemaphoreHandle_t xMutex;
+
+/* The mcycle of the last action, 0 once a sample is taken */
+static volatile uint32_t ulStamp;
+static volatile uint32_t ulFpErrors = 0;
+
+void vApplicationMallocFailedHook( void );
+void vApplicationIdleHook( void );
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+static inline uint32_t prvCycles( void )
+{
+    uint32_t ulCycles;
+    CSR_READ( CSR_REG_MCYCLE, &ulCycles );
+    return ulCycles;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( Stat_t *pxStat, uint32_t ulCycles )
+{
+    if( pxStat->ulCount == 0 || ulCycles < pxStat->ulMin )
+    {
+        pxStat->ulMin = ulCycles;
+    }
+    if( ulCycles > pxStat->ulMax )
+    {
+        pxStat->ulMax = ulCycles;
+    }
+    pxStat->ulSum += ulCycles;
+    pxStat->ulCount++;
+}
+/*-----------------------------------------------------------*/
+
+/* Waits for the task of the benchmark: it has a higher priority, so it has
+ended once this one runs again. The idle task frees it. */
+static void prvEndBench( void )
+{
+    vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+    BaseType_t xFp = ( BaseType_t ) pvParameters;
+    Stat_t *pxStat = &xStats[ xFp ? statYIELD_FP : statYIELD ];
+    /* Tells the two tasks apart in the register of the FPU */
+    uint32_t ulTag = ( uint32_t ) xTaskGetCurrentTaskHandle();
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+#ifdef __riscv_flen
+        if( xFp )
+        {
+            __asm volatile( "fmv.w.x ft0, %0" : : "r"( ulTag ) );
+        }
+#endif
+        ulStamp = prvCycles();
+        taskYIELD();
+        uint32_t ulEnd = prvCycles();
+
+        /* The other task started or ended in between otherwise */
+        if( ulStamp != 0 )
+        {
+            prvRecord( pxStat, ulEnd - ulStamp );
+            ulStamp = 0;
+        }
+#ifdef __riscv_flen
+        if( xFp )
+        {
+            uint32_t ulReg;
+            __asm volatile( "fmv.x.w %0, ft0" : "=r"( ulReg ) );
+            if( ulReg != ulTag )
+            {
+                ulFpErrors++;
+            }
+        }
+#endif
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchYield( BaseType_t xFp )
+{
+    ulStamp = 0;
+
+    /* Both are created before the first runs */
+    vTaskSuspendAll();
+    xTaskCreate( prvYieldTask, "Yield0", configMINIMAL_STACK_SIZE * 2U, ( void * ) xFp, mainBENCH_TASK_PRIORITY, NULL );
+    xTaskCreate( prvYieldTask, "Yield1", configMINIMAL_STACK_SIZE * 2U, ( void * ) xFp, mainBENCH_TASK_PRIORITY, NULL );
+    xTaskResumeAll();
+
+    prvEndBench();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerHandler( uint32_t id )
+{
+    uint32_t ulIsr = prvCycles();
+    BaseType_t xWoken = pdFALSE;
+
+    ( void ) id;
+    rv_timer_irq_clear( &timer_2_3, 1, 0 );
+    // The timer kept it pending until now
+    clear_fast_interrupt( kTimer_3_fic_e );
+
+    xTaskNotifyFromISR( xBenchTask, ulIsr, eSetValueWithOverwrite, &xWoken );
+    portYIELD_FROM_ISR( xWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIsrTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        uint32_t ulIsr;
+
+        xTaskNotifyWait( 0, 0, &ulIsr, portMAX_DELAY );
+        uint32_t ulEnd = prvCycles();
+        prvRecord( &xStats[ statRAISE_TO_ISR ], ulIsr - ulStamp );
+        prvRecord( &xStats[ statISR_TO_TASK ], ulEnd - ulIsr );
+        ulStamp = 0;
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchIsr( void )
+{
+    xTaskCreate( prvIsrTask, "Isr", configMINIMAL_STACK_SIZE * 2U, NULL, mainBENCH_TASK_PRIORITY, &xBenchTask );
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        ulStamp = prvCycles();
+        *TIMER_REG( RV_TIMER_INTR_TEST0_REG_OFFSET, 1 ) = 1;
+        /* Until the task has taken the sample */
+        while( ulStamp != 0 );
+    }
+
+    prvEndBench();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        uint32_t ulSent;
+
+        xQueueReceive( xQueue, &ulSent, portMAX_DELAY );
+        prvRecord( &xStats[ statQUEUE ], prvCycles() - ulSent );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueue( void )
+{
+    xTaskCreate( prvQueueTask, "Queue", configMINIMAL_STACK_SIZE * 2U, NULL, mainBENCH_TASK_PRIORITY, NULL );
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        uint32_t ulSent = prvCycles();
+        xQueueSend( xQueue, &ulSent, portMAX_DELAY );
+    }
+
+    prvEndBench();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        /* Held by the control task, which inherits the priority */
+        xSemaphoreTake( xMutex, portMAX_DELAY );
+        prvRecord( &xStats[ statMUTEX ], prvCycles() - ulStamp );
+        xSemaphoreGive( xMutex );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchMutex( void )
+{
+    xTaskCreate( prvMutexTask, "Mutex", configMINIMAL_STACK_SIZE * 2U, NULL, mainBENCH_TASK_PRIORITY, &xBenchTask );
+
+    for( uint32_t i = 0; i < mainRUNS; i++ )
+    {
+        xSemaphoreTake( xMutex, portMAX_DELAY );
+        /* The task blocks on the mutex before this one goes on */
+        xTaskNotifyGive( xBenchTask );
+        ulStamp = prvCycles();
+        xSemaphoreGive( xMutex );
+    }
+
+    prvEndBench();
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvBenchYield( pdFALSE );
+#ifdef __riscv_flen
+    prvBenchYield( pdTRUE );
+#endif
+    prvBenchIsr();
+    prvBenchQueue();
+    prvBenchMutex();
+
+    PRINTF( "FPU context %d\n\r", rtosFPU_CONTEXT );
+    for( uint32_t i = 0; i < statN; i++ )
+    {
+        Stat_t *pxStat = &xStats[ i ];
+        if( pxStat->ulCount != 0 )
+        {
+            PRINTF( "%s: min %u avg %u max %u cycles\n\r", pxStat->pcName, pxStat->ulMin,
+                    pxStat->ulSum / pxStat->ulCount, pxStat->ulMax );
+        }
+    }
+
+    if( xStats[ statYIELD ].ulCount == 0 || xStats[ statISR_TO_TASK ].ulCount != mainRUNS ||
+        xStats[ statQUEUE ].ulCount != mainRUNS || xStats[ statMUTEX ].ulCount != mainRUNS )
+    {
+        PRINTF( "Error: samples missing\n\r" );
+        exit( EXIT_FAILURE );
+    }
+
+    if( ulFpErrors != 0 )
+    {
+        PRINTF( "FPU registers lost in %u switches\n\r", ulFpErrors );
+#if ( rtosFPU_CONTEXT != 0 )
+        exit( EXIT_FAILURE );
+#endif
+    }
+
+    PRINTF( "Success.\n\r" );
+    exit( EXIT_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupHardware( void )
+{
+    /* The tick of the port, see example_freertos_blinky. */
+    rv_timer_init( mmio_region_from_addr( RV_TIMER_AO_START_ADDRESS ), ( rv_timer_config_t ) { .hart_count = 2, .comparator_count = 1 }, &timer_0_1 );
+    CSR_SET_BITS( CSR_REG_MIE, 1 << 7 );
+    configASSERT( rv_timer_irq_enable( &timer_0_1, 0, 0, kRvTimerEnabled ) == kRvTimerOk );
+    configASSERT( rv_timer_counter_set_enabled( &timer_0_1, 0, kRvTimerEnabled ) == kRvTimerOk );
+
+    /* Timer 3 is only raised by its INTR_TEST, its counter stays disabled */
+    rv_timer_init( mmio_region_from_addr( RV_TIMER_START_ADDRESS ), ( rv_timer_config_t ) { .hart_count = 2, .comparator_count = 1 }, &timer_2_3 );
+    rv_timer_irq_enable( &timer_2_3, 1, 0, kRvTimerEnabled );
+    configASSERT( irq_register( IRQ_SRC_FAST( kTimer_3_fic_e ), prvTimerHandler ) == IRQ_OK );
+    configASSERT( irq_set_enabled( IRQ_SRC_FAST( kTimer_3_fic_e ), true ) == IRQ_OK );
+
+    CSR_CLEAR_BITS( CSR_REG_MCOUNTINHIBIT, 0x1 );
+#ifdef __riscv_flen
+    /* The tasks inherit FS Initial, see rtosFPU_CONTEXT */
+    CSR_SET_BITS( CSR_REG_MSTATUS, ( FS_INITIAL << 13 ) );
+#endif
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    prvSetupHardware();
+
+    xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( xQueue != NULL && xMutex != NULL );
+
+    xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4U, NULL, mainCONTROL_TASK_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    /* Not enough heap for the idle and timer tasks. */
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    taskDISABLE_INTERRUPTS();
+    printf( "error: application malloc failed\n\r" );
+    __asm volatile( "ebreak" );
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
+{
+    ( void ) pcTaskName;
+    ( void ) pxTask;
+
+    taskDISABLE_INTERRUPTS();
+    __asm volatile( "ebreak" );
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
@@ -201,13 +201,6 @@ void vSendString( const char * const pcString );
 /**                                                                        **/
 /****************************************************************************/
 
-/* Allocate heap to special section. Note that we have no references in the
- * whole program to this variable (since its just here to allocate space in the
- * section for our heap), so when using LTO it will be removed. We force it to
- * stay with the "used" attribute
- */
-__attribute__((section(".heap"), used)) uint8_t ucHeap[configTOTAL_HEAP_SIZE];
-
 /* Timer 0 AO Domain as Tick Counter */
 static rv_timer_t timer_0_1;
 
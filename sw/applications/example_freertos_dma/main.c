@@ -0,0 +1,226 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Two tasks copy buffers with the DMA through rtos_dma on the same channel,
+// while a task of a lower priority counts. The copying tasks block during
+// their transfers, so the counter must advance while they run, and their
+// transfers are serialized by the mutex of the channel. The DMA is paced to
+// make each transfer last a few thousand cycles. On the FPGA, the run-time
+// stats of the tasks are printed at the end.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer.h"
+#include "dma.h"
+#include "rtos_dma.h"
+#include "port_stats.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define mainCOPY_TASK_PRIORITY      ( tskIDLE_PRIORITY + 2 )
+#define mainCOUNT_TASK_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+
+#define mainWORDS                   ( 256 )
+#define mainCOPIES                  ( 4 )
+#define mainPACE_CYCLES             ( 8 )
+
+typedef struct
+{
+    uint32_t     src[ mainWORDS ];
+    uint32_t     dst[ mainWORDS ];
+    dma_target_t xSrc;
+    dma_target_t xDst;
+    dma_trans_t  xTrans;
+    uint32_t     ulSeed;
+} CopyJob_t;
+
+static rv_timer_t timer_0_1;
+
+static CopyJob_t xJobs[ 2 ];
+
+static volatile uint32_t ulCount = 0;
+static volatile uint32_t ulErrors = 0;
+static volatile uint32_t ulDone = 0;
+
+void vApplicationMallocFailedHook( void );
+void vApplicationIdleHook( void );
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvCopyTask( void *pvParameters )
+{
+    CopyJob_t *pxJob = ( CopyJob_t * ) pvParameters;
+
+    for( uint32_t n = 0; n < mainCOPIES; n++ )
+    {
+        for( uint32_t i = 0; i < mainWORDS; i++ )
+        {
+            pxJob->src[ i ] = pxJob->ulSeed + n * mainWORDS + i;
+            pxJob->dst[ i ] = 0;
+        }
+
+        uint32_t ulBefore = ulCount;
+
+        if( xRtosDmaTransfer( &pxJob->xTrans, portMAX_DELAY ) != DMA_CONFIG_OK )
+        {
+            ulErrors++;
+        }
+
+        /* The counting task ran during the transfer. */
+        if( ulCount == ulBefore )
+        {
+            PRINTF( "Error: no overlap\n\r" );
+            ulErrors++;
+        }
+
+        for( uint32_t i = 0; i < mainWORDS; i++ )
+        {
+            if( pxJob->dst[ i ] != pxJob->src[ i ] )
+            {
+                ulErrors++;
+                break;
+            }
+        }
+    }
+
+    taskENTER_CRITICAL();
+    ulDone++;
+    taskEXIT_CRITICAL();
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    while( ulDone < 2 )
+    {
+        ulCount++;
+    }
+
+    if( ulErrors != 0 )
+    {
+        PRINTF( "Error: %u failed copies\n\r", ulErrors );
+        exit( EXIT_FAILURE );
+    }
+
+    PRINTF( "Success, %u counts during the copies.\n\r", ulCount );
+#if TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    /* The share of each task, see port_stats.h. */
+    vPortPrintRunTimeStats();
+#endif
+    exit( EXIT_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupJob( CopyJob_t *pxJob, uint32_t ulSeed )
+{
+    pxJob->ulSeed = ulSeed;
+    pxJob->xSrc = ( dma_target_t ) {
+        .ptr     = ( uint8_t * ) pxJob->src,
+        .inc_du  = 1,
+        .size_du = mainWORDS,
+        .trig    = DMA_TRIG_MEMORY,
+        .type    = DMA_DATA_TYPE_WORD,
+    };
+    pxJob->xDst = ( dma_target_t ) {
+        .ptr     = ( uint8_t * ) pxJob->dst,
+        .inc_du  = 1,
+        .size_du = mainWORDS,
+        .trig    = DMA_TRIG_MEMORY,
+        .type    = DMA_DATA_TYPE_WORD,
+    };
+    pxJob->xTrans = ( dma_trans_t ) {
+        .src     = &pxJob->xSrc,
+        .dst     = &pxJob->xDst,
+        .mode    = DMA_TRANS_MODE_SINGLE,
+        .end     = DMA_TRANS_END_INTR,
+        .channel = 0,
+        .pace    = mainPACE_CYCLES,
+    };
+    configASSERT( dma_validate_transaction( &pxJob->xTrans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY ) == DMA_CONFIG_OK );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupHardware( void )
+{
+    /* The tick of the port, see example_freertos_blinky. */
+    rv_timer_init( mmio_region_from_addr( RV_TIMER_AO_START_ADDRESS ), ( rv_timer_config_t ) { .hart_count = 2, .comparator_count = 1 }, &timer_0_1 );
+    CSR_SET_BITS( CSR_REG_MIE, 1 << 7 );
+    configASSERT( rv_timer_irq_enable( &timer_0_1, 0, 0, kRvTimerEnabled ) == kRvTimerOk );
+    configASSERT( rv_timer_counter_set_enabled( &timer_0_1, 0, kRvTimerEnabled ) == kRvTimerOk );
+
+    dma_init( NULL );
+    configASSERT( xRtosDmaInit() == pdPASS );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    prvSetupHardware();
+
+    prvSetupJob( &xJobs[ 0 ], 0x10000 );
+    prvSetupJob( &xJobs[ 1 ], 0x20000 );
+
+    xTaskCreate( prvCopyTask, "Copy0", configMINIMAL_STACK_SIZE * 2U, &xJobs[ 0 ], mainCOPY_TASK_PRIORITY, NULL );
+    xTaskCreate( prvCopyTask, "Copy1", configMINIMAL_STACK_SIZE * 2U, &xJobs[ 1 ], mainCOPY_TASK_PRIORITY, NULL );
+    xTaskCreate( prvCountTask, "Count", configMINIMAL_STACK_SIZE * 4U, NULL, mainCOUNT_TASK_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    /* Not enough heap for the idle and timer tasks. */
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    taskDISABLE_INTERRUPTS();
+    printf( "error: application malloc failed\n\r" );
+    __asm volatile( "ebreak" );
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
+{
+    ( void ) pcTaskName;
+    ( void ) pxTask;
+
+    taskDISABLE_INTERRUPTS();
+    __asm volatile( "ebreak" );
+    for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
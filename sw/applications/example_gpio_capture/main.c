@@ -0,0 +1,156 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Captures the edges of a GPIO driven by another one: the events are
+// timestamped by the timer 2 (the hart 0 of the peripheral rv_timer) and
+// notified by batches. The last, incomplete batch is notified by the timeout.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "gpio.h"
+#include "gpio_capture.h"
+#include "pad_control.h"
+#include "pad_control_regs.h"  // Generated.
+#include "rv_plic.h"
+#include "rv_timer.h"
+#include "x-heep.h"
+
+/*
+Notes:
+ - Ports 30 and 31 are connected in questasim testbench, but in the FPGA version they are connected to the EPFL programmer and should not be used
+ - Connect a cable between the two pins for the application to work
+*/
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifndef RV_PLIC_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_PLIC peripheral is not included" )
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+    #define GPIO_TB_OUT 8
+    #define GPIO_TB_IN  9
+    #pragma message ( "Connect a cable between GPIOs IN and OUT" )
+#else
+    #define GPIO_TB_OUT 30
+    #define GPIO_TB_IN  31
+#endif
+
+#define EDGES_N     10
+#define BATCH_N     4
+#define EVENTS_N    16
+// Enough timer cycles for an edge to be captured
+#define TIMEOUT_TICKS   2000
+
+static rv_timer_t timer_2_3;
+static gpio_capture_t capture;
+static gpio_capture_event_t events[EVENTS_N];
+static volatile uint32_t notified_n;
+
+static void capture_cb(gpio_capture_t *cap)
+{
+    (void)cap;
+    notified_n++;
+}
+
+int main(int argc, char *argv[])
+{
+    pad_control_t pad_control;
+    pad_control.base_addr = mmio_region_from_addr((uintptr_t)PAD_CONTROL_START_ADDRESS);
+
+    if (plic_Init() != kPlicOk) {
+        PRINTF("Init PLIC failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // In case GPIOs 30 and 31 are used:
+#if GPIO_TB_OUT == 31 || GPIO_TB_IN == 31
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SCL_REG_OFFSET), 1);
+#endif
+#if GPIO_TB_OUT == 30 || GPIO_TB_IN == 30
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SDA_REG_OFFSET), 1);
+#endif
+
+    // The timestamps count the clock cycles
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_2_3);
+    rv_timer_set_tick_params(&timer_2_3, 0, (rv_timer_tick_params_t){.prescale = 0, .tick_step = 1});
+    rv_timer_counter_set_enabled(&timer_2_3, 0, kRvTimerEnabled);
+
+    gpio_cfg_t cfg_out = {
+        .pin = GPIO_TB_OUT,
+        .mode = GpioModeOutPushPull
+    };
+    if (gpio_config(cfg_out) != GpioOk) {
+        PRINTF("Failed\n\r");
+        return EXIT_FAILURE;
+    }
+    gpio_write(GPIO_TB_OUT, false);
+
+    gpio_capture_cfg_t cfg = {
+        .events = events,
+        .events_n = EVENTS_N,
+        .batch_n = BATCH_N,
+        .timeout_ticks = TIMEOUT_TICKS,
+        .timer = &timer_2_3,
+        .hart_id = 0,
+        .timeout_fic = kTimer_2_fic_e,
+        .cb = capture_cb,
+    };
+    if (gpio_capture_init(&capture, &cfg) != GpioOk
+        || gpio_capture_add_pin(&capture, GPIO_TB_IN) != GpioOk) {
+        PRINTF("Init capture failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    PRINTF("Toggle GPIO %u %u times...\n\r", GPIO_TB_OUT, EDGES_N);
+    for (uint32_t i = 0; i < EDGES_N; i++) {
+        uint32_t head = capture.head;
+        gpio_toggle(GPIO_TB_OUT);
+        while (capture.head == head) {
+        }
+    }
+    // The last batch is incomplete, and notified by the timeout
+    while (notified_n < (EDGES_N + BATCH_N - 1) / BATCH_N) {
+    }
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    gpio_capture_remove_pin(&capture, GPIO_TB_IN);
+
+    gpio_capture_event_t read[EVENTS_N];
+    size_t read_n = gpio_capture_read(&capture, read, EVENTS_N);
+    uint32_t errors = 0;
+    for (size_t i = 0; i < read_n; i++) {
+        // The first edge rises, then they alternate
+        if (read[i].pin != GPIO_TB_IN || read[i].level != !(i & 1)
+            || (i > 0 && (int32_t)(read[i].time - read[i - 1].time) <= 0)) {
+            errors++;
+        }
+        PRINTF("%u: %u at %u\n\r", i, read[i].level, read[i].time);
+    }
+
+    if (read_n == EDGES_N && errors == 0 && capture.dropped == 0) {
+        PRINTF("Success\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure: %u events, %u errors\n\r", read_n, errors);
+        return EXIT_FAILURE;
+    }
+}
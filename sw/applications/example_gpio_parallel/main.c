@@ -0,0 +1,139 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Captures bytes from eight GPIOs with the DMA, one per edge of a strobe on
+// another GPIO, and checks them. The CPU plays the parallel source: it drives
+// the data pins as outputs, read back through their pads, and toggles the
+// strobe on a GPIO connected to the strobe input. Both edges carry a sample.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "gpio.h"
+#include "gpio_parallel.h"
+#include "pad_control.h"
+#include "pad_control_regs.h"  // Generated.
+#include "x-heep.h"
+
+/*
+Notes:
+ - Ports 30 and 31 are connected in questasim testbench, but in the FPGA version they are connected to the EPFL programmer and should not be used
+ - Connect a cable between the two pins for the application to work
+*/
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+    #define GPIO_TB_OUT 8
+    #define GPIO_TB_IN  9
+    #pragma message ( "Connect a cable between GPIOs IN and OUT" )
+#else
+    #define GPIO_TB_OUT 30
+    #define GPIO_TB_IN  31
+#endif
+
+// The data pins, the AO ones
+#define GPIO_DATA   0
+#define DATA_WIDTH  8
+#define SAMPLES_N   32
+// Cycles the data are held after an edge, longer than the read of the DMA
+#define HOLD        20
+
+static gpio_parallel_t parallel;
+static uint8_t samples[SAMPLES_N];
+
+static uint8_t expected(uint32_t i)
+{
+    return (uint8_t)(0x5A ^ (i * 37));
+}
+
+int main(int argc, char *argv[])
+{
+    pad_control_t pad_control;
+    pad_control.base_addr = mmio_region_from_addr((uintptr_t)PAD_CONTROL_START_ADDRESS);
+
+    dma_init(NULL);
+
+    // In case GPIOs 30 and 31 are used:
+#if GPIO_TB_OUT == 31 || GPIO_TB_IN == 31
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SCL_REG_OFFSET), 1);
+#endif
+#if GPIO_TB_OUT == 30 || GPIO_TB_IN == 30
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SDA_REG_OFFSET), 1);
+#endif
+
+    // The data pins are outputs, sampled back in GPIO_IN
+    for (uint32_t pin = GPIO_DATA; pin < GPIO_DATA + DATA_WIDTH; pin++) {
+        gpio_cfg_t cfg_data = {
+            .pin = pin,
+            .mode = GpioModeOutPushPull,
+            .en_input_sampling = true
+        };
+        if (gpio_config(cfg_data) != GpioOk) {
+            PRINTF("Failed\n\r");
+            return EXIT_FAILURE;
+        }
+    }
+    gpio_cfg_t cfg_out = {
+        .pin = GPIO_TB_OUT,
+        .mode = GpioModeOutPushPull
+    };
+    gpio_cfg_t cfg_in = {
+        .pin = GPIO_TB_IN,
+        .mode = GpioModeIn
+    };
+    if (gpio_config(cfg_out) != GpioOk || gpio_config(cfg_in) != GpioOk) {
+        PRINTF("Failed\n\r");
+        return EXIT_FAILURE;
+    }
+    const uint32_t data_mask = ((1u << DATA_WIDTH) - 1) << GPIO_DATA;
+    const uint32_t strobe_mask = 1u << GPIO_TB_OUT;
+    gpio_port_clear(data_mask | strobe_mask);
+
+    PRINTF("Capture %u bytes from GPIO %u, strobe on GPIO %u...\n\r", SAMPLES_N, GPIO_DATA, GPIO_TB_IN);
+    if (gpio_parallel_start(&parallel, samples, SAMPLES_N, GPIO_DATA, DATA_WIDTH,
+                            GPIO_TB_IN, GpioParallelBoth, 0) != GpioOk) {
+        PRINTF("Start capture failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // The data are set up before the edge and held after it
+    for (uint32_t i = 0; i < SAMPLES_N; i++) {
+        gpio_port_write(data_mask, (uint32_t)expected(i) << GPIO_DATA);
+        gpio_port_toggle(strobe_mask);
+        for (volatile uint32_t t = 0; t < HOLD; t++) {
+        }
+    }
+    while (!gpio_parallel_is_done(&parallel)) {
+    }
+
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < SAMPLES_N; i++) {
+        if (samples[i] != expected(i)) {
+            PRINTF("%u: 0x%02x instead of 0x%02x\n\r", i, samples[i], expected(i));
+            errors++;
+        }
+    }
+    uint32_t missed = gpio_parallel_missed(&parallel);
+
+    if (errors == 0 && missed == 0) {
+        PRINTF("Success\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure: %u errors, %u edges missed\n\r", errors, missed);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Outputs a WS2812-like frame on a GPIO with the DMA, one sample every PACE
+// cycles, and checks the spacing of its edges with the capture mode on another
+// GPIO connected to it. Each bit of the frame is three samples: high, the bit,
+// low. The port functions set the pins before and after the waveform.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "gpio.h"
+#include "gpio_capture.h"
+#include "gpio_wave.h"
+#include "pad_control.h"
+#include "pad_control_regs.h"  // Generated.
+#include "rv_plic.h"
+#include "rv_timer.h"
+#include "x-heep.h"
+
+/*
+Notes:
+ - Ports 30 and 31 are connected in questasim testbench, but in the FPGA version they are connected to the EPFL programmer and should not be used
+ - Connect a cable between the two pins for the application to work
+*/
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifndef RV_PLIC_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_PLIC peripheral is not included" )
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+    #define GPIO_TB_OUT 8
+    #define GPIO_TB_IN  9
+    #pragma message ( "Connect a cable between GPIOs IN and OUT" )
+#else
+    #define GPIO_TB_OUT 30
+    #define GPIO_TB_IN  31
+#endif
+
+#define FRAME       0xA5
+#define FRAME_BITS  8
+#define SAMPLES_N   (3 * FRAME_BITS)
+#define EVENTS_N    32
+// Cycles between two samples, longer than the capture handler
+#define PACE        1000
+// The edges may be off by the latency of the capture handler
+#define TOLERANCE   (PACE / 4)
+
+static rv_timer_t timer_2_3;
+static gpio_capture_t capture;
+static gpio_capture_event_t events[EVENTS_N];
+static gpio_wave_t wave;
+static uint32_t samples[SAMPLES_N];
+
+int main(int argc, char *argv[])
+{
+    pad_control_t pad_control;
+    pad_control.base_addr = mmio_region_from_addr((uintptr_t)PAD_CONTROL_START_ADDRESS);
+
+    if (plic_Init() != kPlicOk) {
+        PRINTF("Init PLIC failed\n\r");
+        return EXIT_FAILURE;
+    }
+    dma_init(NULL);
+
+    // In case GPIOs 30 and 31 are used:
+#if GPIO_TB_OUT == 31 || GPIO_TB_IN == 31
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SCL_REG_OFFSET), 1);
+#endif
+#if GPIO_TB_OUT == 30 || GPIO_TB_IN == 30
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SDA_REG_OFFSET), 1);
+#endif
+
+    // The timestamps count the clock cycles
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_2_3);
+    rv_timer_set_tick_params(&timer_2_3, 0, (rv_timer_tick_params_t){.prescale = 0, .tick_step = 1});
+    rv_timer_counter_set_enabled(&timer_2_3, 0, kRvTimerEnabled);
+
+    gpio_cfg_t cfg_out = {
+        .pin = GPIO_TB_OUT,
+        .mode = GpioModeOutPushPull
+    };
+    if (gpio_config(cfg_out) != GpioOk) {
+        PRINTF("Failed\n\r");
+        return EXIT_FAILURE;
+    }
+    const uint32_t mask = 1u << GPIO_TB_OUT;
+    gpio_port_clear(mask);
+
+    gpio_capture_cfg_t cfg = {
+        .events = events,
+        .events_n = EVENTS_N,
+        .batch_n = EVENTS_N,
+        .timer = &timer_2_3,
+        .hart_id = 0,
+    };
+    if (gpio_capture_init(&capture, &cfg) != GpioOk
+        || gpio_capture_add_pin(&capture, GPIO_TB_IN) != GpioOk) {
+        PRINTF("Init capture failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // The levels, most significant bit first, then the toggles
+    for (uint32_t b = 0; b < FRAME_BITS; b++) {
+        uint32_t bit = (FRAME >> (FRAME_BITS - 1 - b)) & 1;
+        samples[3 * b] = mask;
+        samples[3 * b + 1] = bit ? mask : 0;
+        samples[3 * b + 2] = 0;
+    }
+    gpio_wave_encode(samples, samples, SAMPLES_N, mask, 0);
+
+    PRINTF("Output 0x%x on GPIO %u...\n\r", FRAME, GPIO_TB_OUT);
+    if (gpio_wave_start(&wave, samples, SAMPLES_N, mask, PACE, 0) != GpioOk) {
+        PRINTF("Start waveform failed\n\r");
+        return EXIT_FAILURE;
+    }
+    while (!gpio_wave_is_done(&wave)) {
+    }
+    // Wait for the handler of the last edge
+    for (volatile uint32_t i = 0; i < PACE; i++) {
+    }
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    gpio_capture_remove_pin(&capture, GPIO_TB_IN);
+
+    // A bit 0 falls one sample after its rise and a bit 1 two
+    gpio_capture_event_t read[EVENTS_N];
+    size_t read_n = gpio_capture_read(&capture, read, EVENTS_N);
+    uint32_t errors = (read_n != 2 * FRAME_BITS);
+    for (size_t i = 0; i + 1 < read_n; i++) {
+        uint32_t bit = (FRAME >> (FRAME_BITS - 1 - i / 2)) & 1;
+        uint32_t expected = (i & 1) ? (3 - 1 - bit) * PACE : (1 + bit) * PACE;
+        uint32_t delta = read[i + 1].time - read[i].time;
+        if (read[i].level != !(i & 1) || delta + TOLERANCE < expected || delta > expected + TOLERANCE) {
+            errors++;
+        }
+        PRINTF("%u: %u, %u cycles to the next edge\n\r", i, read[i].level, delta);
+    }
+
+    // The pins outside the waveform were not touched, the captured one is low
+    uint32_t levels;
+    gpio_port_read(&levels);
+    if (levels & (1u << GPIO_TB_IN)) {
+        errors++;
+    }
+
+    if (errors == 0) {
+        PRINTF("Success\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure: %u events, %u errors\n\r", read_n, errors);
+        return EXIT_FAILURE;
+    }
+}
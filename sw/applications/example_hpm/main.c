@@ -0,0 +1,94 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Counts the events of hpm_events (mcu_cfg.hjson) in a kernel with loads,
+// data-dependent branches and a division, then checks that stopped counters
+// keep their counts.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "hpm.h"
+
+/* The counts are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define TEST_WORDS  256
+
+static int32_t data[TEST_WORDS];
+
+static int32_t __attribute__ ((noinline)) kernel(const int32_t *a, uint32_t n)
+{
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        // The branch depends on the loaded value, right after its load
+        if (a[i] & 1) {
+            sum += a[i];
+        } else {
+            sum -= a[i] / 3;
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    int32_t expected = 0;
+#if HPM_COUNTERS > 0
+    uint64_t start[HPM_COUNTERS], end[HPM_COUNTERS];
+#endif
+
+    for (uint32_t i = 0; i < TEST_WORDS; i++) {
+        data[i] = (int32_t)(i * 2654435761u >> 7);
+        expected += (data[i] & 1) ? data[i] : -(data[i] / 3);
+    }
+
+    hpm_init();
+
+#if HPM_COUNTERS > 0
+    hpm_read_all(start);
+    int32_t sum = kernel(data, TEST_WORDS);
+    hpm_read_all(end);
+
+    PRINTF("%u words:\n\r", TEST_WORDS);
+    for (uint32_t c = 0; c < HPM_COUNTERS; c++) {
+        PRINTF("mhpmcounter%u: %u\n\r", HPM_FIRST_COUNTER + c, (uint32_t)(end[c] - start[c]));
+    }
+
+    // Stopped, the counters keep their counts
+    hpm_enable(false);
+    hpm_read_all(start);
+    kernel(data, TEST_WORDS);
+    hpm_read_all(end);
+    for (uint32_t c = 0; c < HPM_COUNTERS; c++) {
+        if (end[c] != start[c]) {
+            PRINTF("mhpmcounter%u counted while stopped\n\r", HPM_FIRST_COUNTER + c);
+            return EXIT_FAILURE;
+        }
+    }
+#else
+    int32_t sum = kernel(data, TEST_WORDS);
+    PRINTF("No event counter, hpm_events is empty\n\r");
+#endif
+
+    if (sum == expected) {
+        PRINTF("HPM test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("HPM test failure\n\r");
+        return EXIT_FAILURE;
+    }
+}
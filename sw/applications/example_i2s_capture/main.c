@@ -0,0 +1,132 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Continuous capture of both channels of an I2S microphone into a ring of
+// frames filled by the DMA. The CPU sleeps between frames, checks each frame
+// as it arrives and releases it. In simulation, the testbench microphone
+// sends 0x8765431 on the left channel and 0xfedcba9 on the right one.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "i2s_capture.h"
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+#define SAMPLE_RATE_HZ  16000
+#define FRAME_LEN       160
+#define FRAMES_N        100
+#else
+// SCK at a 32th of the system clock, as in example_i2s
+#define SCK_DIV         32
+#define FRAME_LEN       4
+#define FRAMES_N        8
+#endif
+
+#define RING_FRAMES     4
+#define DMA_CH          0
+
+static i2s_capture_t capture;
+static int32_t ring[RING_FRAMES][FRAME_LEN * 2] __attribute__ ((aligned (4)));
+static volatile uint32_t frames_ready;
+
+static void frame_ready(i2s_capture_t *capture, const void *frame)
+{
+    frames_ready++;
+}
+
+int main(int argc, char *argv[])
+{
+    bool success = true;
+    bool mic_connected = false;
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    dma_init(NULL);
+
+    i2s_capture_cfg_t cfg = {
+#ifdef TARGET_PYNQ_Z2
+        .sample_rate_hz = SAMPLE_RATE_HZ,
+#else
+        .sample_rate_hz = soc_ctrl_get_frequency(&soc_ctrl) / (SCK_DIV * 2 * 32),
+#endif
+        .word_length = I2S_32_BITS,
+        .channels = I2S_BOTH_CH,
+        .frame_len = FRAME_LEN,
+        .frames = RING_FRAMES,
+        .buffer = ring,
+        .dma_ch = DMA_CH,
+        .cb = frame_ready,
+    };
+
+    if (i2s_capture_start(&capture, &cfg) != kI2sOk) {
+        PRINTF("I2S capture start failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t n = 0; n < FRAMES_N; n++) {
+        const int32_t *frame;
+        // the interrupts are disabled around the check so that the frame
+        // interrupt cannot arrive between the check and the wfi
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        while ((frame = i2s_capture_peek(&capture)) == NULL) {
+            wait_for_interrupt();
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+        for (int i = 0; i < FRAME_LEN * 2; i += 2) {
+#ifdef TARGET_PYNQ_Z2
+            PRINTF("%d\r\n", (int16_t) (frame[i] >> 16));
+#else
+            if (frame[i] != 0 || frame[i + 1] != 0) {
+                mic_connected = true;
+                if (frame[i] != 0x8765431 || frame[i + 1] != 0xfedcba9) {
+                    PRINTF("ERROR frame %d sample %d = 0x%08x 0x%08x\n\r", n, i / 2, frame[i], frame[i + 1]);
+                    success = false;
+                }
+            }
+#endif
+        }
+        i2s_capture_release(&capture);
+    }
+
+    i2s_capture_stats_t stats;
+    i2s_capture_get_stats(&capture, &stats);
+    PRINTF("Frames %d, overruns %d, FIFO overflow %d\n\r", stats.frames, stats.overruns, stats.fifo_overflow);
+    if (i2s_capture_stop(&capture) != kI2sOk) {
+        PRINTF("I2S rx FIFO overflowed\n\r");
+        success = false;
+    }
+
+    if (!mic_connected) {
+        PRINTF("WARNING: Microphone not connected!\n\r");
+    }
+
+    if (success) {
+        PRINTF("Success. %d frames\n\r", frames_ready);
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure.\n\r");
+        return EXIT_FAILURE;
+    }
+}
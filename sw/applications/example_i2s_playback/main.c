@@ -0,0 +1,214 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Continuous playback of a triangle tone on both channels of an I2S DAC from
+// a ring of frames read by the DMA. Each frame is written again with the next
+// samples of the tone in the frame interrupt, as soon as it has been played.
+// With two DMA channels, the microphone of example_i2s_capture is captured at
+// the same time (full duplex): the data of the I2S TX is then only on the
+// i2s_sdo option of the pdm2pcm_clk pad, the SD pad being the RX input.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "i2s_capture.h"
+#include "i2s_playback.h"
+#include "pad_control.h"
+#include "pad_control_regs.h"  // Generated.
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+#define SAMPLE_RATE_HZ  16000
+#define FRAME_LEN       160
+#define FRAMES_N        100
+// 500 Hz at 16 kHz
+#define TONE_PERIOD     32
+#else
+// SCK at a 32th of the system clock, as in example_i2s
+#define SCK_DIV         32
+#define FRAME_LEN       4
+#define FRAMES_N        8
+#define TONE_PERIOD     8
+#endif
+
+#define RING_FRAMES     4
+#define TONE_AMPLITUDE  0x40000000
+#define DMA_CH_TX       0
+
+#if DMA_CH_NUM > 1
+#define FULL_DUPLEX
+#define DMA_CH_RX       1
+#endif
+
+static i2s_playback_t playback;
+static int32_t tx_ring[RING_FRAMES][FRAME_LEN * 2] __attribute__ ((aligned (4)));
+static volatile uint32_t frames_played;
+static uint32_t tone_phase;
+
+#ifdef FULL_DUPLEX
+static i2s_capture_t capture;
+static int32_t rx_ring[RING_FRAMES][FRAME_LEN * 2] __attribute__ ((aligned (4)));
+#endif
+
+// triangle from -TONE_AMPLITUDE to TONE_AMPLITUDE, the same on both channels
+static void tone_fill(int32_t *frame)
+{
+    const int32_t step = 4 * (TONE_AMPLITUDE / TONE_PERIOD);
+    for (int i = 0; i < FRAME_LEN * 2; i += 2) {
+        int32_t t = (int32_t) (tone_phase % TONE_PERIOD);
+        int32_t s = (t < TONE_PERIOD / 2) ? -TONE_AMPLITUDE + t * step
+                                          : TONE_AMPLITUDE - (t - TONE_PERIOD / 2) * step;
+        frame[i] = s;
+        frame[i + 1] = s;
+        tone_phase++;
+    }
+}
+
+static void frame_played(i2s_playback_t *playback, void *frame)
+{
+    tone_fill((int32_t *) frame);
+    i2s_playback_release(playback);
+    frames_played++;
+}
+
+int main(int argc, char *argv[])
+{
+    bool success = true;
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    pad_control_t pad_control;
+    pad_control.base_addr = mmio_region_from_addr((uintptr_t)PAD_CONTROL_START_ADDRESS);
+    // the TX data on the i2s_sdo option of the pdm2pcm_clk pad
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_PDM2PCM_CLK_REG_OFFSET), 2);
+#ifndef FULL_DUPLEX
+    // the SD pad is driven by the microphone of the testbench, keep it as a
+    // GPIO input instead of the TX data
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2S_SD_REG_OFFSET), 1);
+#endif
+
+    dma_init(NULL);
+
+    for (int f = 0; f < RING_FRAMES; f++) {
+        tone_fill(tx_ring[f]);
+    }
+
+    i2s_playback_cfg_t tx_cfg = {
+#ifdef TARGET_PYNQ_Z2
+        .sample_rate_hz = SAMPLE_RATE_HZ,
+#else
+        .sample_rate_hz = soc_ctrl_get_frequency(&soc_ctrl) / (SCK_DIV * 2 * 32),
+#endif
+        .word_length = I2S_32_BITS,
+        .channels = I2S_BOTH_CH,
+        .frame_len = FRAME_LEN,
+        .frames = RING_FRAMES,
+        .buffer = tx_ring,
+        .dma_ch = DMA_CH_TX,
+        .cb = frame_played,
+    };
+
+    if (i2s_playback_start(&playback, &tx_cfg) != kI2sOk) {
+        PRINTF("I2S playback start failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+#ifdef FULL_DUPLEX
+    // same sample rate and word length, the I2S clocks are shared
+    i2s_capture_cfg_t rx_cfg = {
+        .sample_rate_hz = tx_cfg.sample_rate_hz,
+        .word_length = tx_cfg.word_length,
+        .channels = I2S_BOTH_CH,
+        .frame_len = FRAME_LEN,
+        .frames = RING_FRAMES,
+        .buffer = rx_ring,
+        .dma_ch = DMA_CH_RX,
+        .cb = NULL,
+    };
+
+    if (i2s_capture_start(&capture, &rx_cfg) != kI2sOk) {
+        PRINTF("I2S capture start failed\n\r");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    uint32_t n = 0;
+    while (n < FRAMES_N) {
+        // the interrupts are disabled around the check so that the frame
+        // interrupt cannot arrive between the check and the wfi
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+#ifdef FULL_DUPLEX
+        const int32_t *frame;
+        while ((frame = i2s_capture_peek(&capture)) == NULL) {
+            wait_for_interrupt();
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+#ifndef TARGET_PYNQ_Z2
+        for (int i = 0; i < FRAME_LEN * 2; i += 2) {
+            if ((frame[i] != 0 || frame[i + 1] != 0)
+                && (frame[i] != 0x8765431 || frame[i + 1] != 0xfedcba9)) {
+                PRINTF("ERROR frame %d sample %d = 0x%08x 0x%08x\n\r", n, i / 2, frame[i], frame[i + 1]);
+                success = false;
+            }
+        }
+#endif
+        i2s_capture_release(&capture);
+        n++;
+#else
+        while (frames_played == n) {
+            wait_for_interrupt();
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+        n = frames_played;
+#endif
+    }
+
+    i2s_playback_stats_t stats;
+    i2s_playback_get_stats(&playback, &stats);
+    PRINTF("Frames %d, underruns %d, FIFO underflow %d\n\r", stats.frames, stats.underruns, stats.fifo_underflow);
+    if (stats.underruns != 0) {
+        success = false;
+    }
+
+    if (i2s_playback_stop(&playback) != kI2sOk) {
+        PRINTF("I2S tx FIFO underflowed\n\r");
+        success = false;
+    }
+#ifdef FULL_DUPLEX
+    if (i2s_capture_stop(&capture) != kI2sOk) {
+        PRINTF("I2S rx FIFO overflowed\n\r");
+        success = false;
+    }
+#endif
+
+    if (success) {
+        PRINTF("Success. %d frames played\n\r", frames_played);
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure.\n\r");
+        return EXIT_FAILURE;
+    }
+}
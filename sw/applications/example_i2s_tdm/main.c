@@ -0,0 +1,134 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Continuous capture of a microphone array on a TDM bus: 4 slots of 32 bits
+// per frame, 24-bit samples, of which slots 0, 1 and 3 are captured by the
+// DMA into a ring of frames. The samples are tagged with their slot, and
+// the CPU checks the slot order of each frame as it arrives. The testbench
+// microphone is not a TDM one, so only the tags are checked in simulation.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "i2s_capture.h"
+#include "soc_ctrl.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+#define SAMPLE_RATE_HZ  16000
+#define FRAME_LEN       160
+#define FRAMES_N        100
+#else
+// SCK at a 32th of the system clock, as in example_i2s
+#define SCK_DIV         32
+#define FRAME_LEN       4
+#define FRAMES_N        8
+#endif
+
+#define SLOTS           4
+#define SLOT_EN         0xb
+#define SLOTS_EN_N      3
+#define RING_FRAMES     4
+#define DMA_CH          0
+
+static const uint8_t slot_order[SLOTS_EN_N] = {0, 1, 3};
+
+static i2s_capture_t capture;
+static int32_t ring[RING_FRAMES][FRAME_LEN * SLOTS_EN_N] __attribute__ ((aligned (4)));
+
+int main(int argc, char *argv[])
+{
+    bool success = true;
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    dma_init(NULL);
+
+    i2s_capture_cfg_t cfg = {
+#ifdef TARGET_PYNQ_Z2
+        .sample_rate_hz = SAMPLE_RATE_HZ,
+#else
+        .sample_rate_hz = soc_ctrl_get_frequency(&soc_ctrl) / (SCK_DIV * SLOTS * 32),
+#endif
+        .word_length = I2S_24_BITS,
+        .tdm = {
+            .slots = SLOTS,
+            .slot_width = I2S_32_BITS,
+            .slot_en = SLOT_EN,
+            .tag = true,
+        },
+        .frame_len = FRAME_LEN,
+        .frames = RING_FRAMES,
+        .buffer = ring,
+        .dma_ch = DMA_CH,
+    };
+
+    if (i2s_capture_frame_size(&cfg) != sizeof(ring[0])) {
+        PRINTF("Wrong frame size\n\r");
+        return EXIT_FAILURE;
+    }
+
+    if (i2s_capture_start(&capture, &cfg) != kI2sOk) {
+        PRINTF("I2S capture start failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t n = 0; n < FRAMES_N; n++) {
+        const int32_t *frame;
+        // the interrupts are disabled around the check so that the frame
+        // interrupt cannot arrive between the check and the wfi
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        while ((frame = i2s_capture_peek(&capture)) == NULL) {
+            wait_for_interrupt();
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+        for (int i = 0; i < FRAME_LEN * SLOTS_EN_N; i++) {
+            uint32_t slot = I2S_TDM_SLOT(frame[i]);
+            if (slot != slot_order[i % SLOTS_EN_N]) {
+                PRINTF("ERROR frame %d sample %d from slot %d\n\r", n, i, slot);
+                success = false;
+            }
+#ifdef TARGET_PYNQ_Z2
+            // 24-bit sample, sign extended
+            PRINTF("%d%s", (int32_t) ((uint32_t) frame[i] << 8) >> 8, (i % SLOTS_EN_N) == SLOTS_EN_N - 1 ? "\r\n" : " ");
+#endif
+        }
+        i2s_capture_release(&capture);
+    }
+
+    i2s_capture_stats_t stats;
+    i2s_capture_get_stats(&capture, &stats);
+    PRINTF("Frames %d, overruns %d, FIFO overflow %d\n\r", stats.frames, stats.overruns, stats.fifo_overflow);
+    if (i2s_capture_stop(&capture) != kI2sOk) {
+        PRINTF("I2S rx FIFO overflowed\n\r");
+        success = false;
+    }
+
+    if (success) {
+        PRINTF("Success.\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Failure.\n\r");
+        return EXIT_FAILURE;
+    }
+}
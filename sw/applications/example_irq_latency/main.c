@@ -0,0 +1,279 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the interrupt latency, in cycles from the write that raises the
+// interrupt to the first instruction of the handler (its mcycle read), on
+// three paths:
+// - a PLIC source (the UART RX timeout) with a handler set by irq_register;
+// - a fast interrupt (timer 3) with a handler set by irq_register;
+// - a fast interrupt (timer 2) whose vector entry is a leaf handler of the
+//   application, which saves only the registers it uses;
+// - the fast interrupt of timer 3 again, with a leaf handler installed in its
+//   vector slot at run time by fic_install_vector. On the cores that
+//   acknowledge their interrupts to FIC, its pending bit is auto-cleared.
+// Then, with the nesting enabled, the same latency for an interrupt raised by
+// a handler of a lower priority, which waits for it:
+// - the UART RX parity error over the RX timeout, in the PLIC;
+// - timer 2 over timer 3, with fast interrupt priorities.
+// The interrupts are raised by the INTR_TEST registers of the peripherals.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "fast_intr_ctrl.h"
+#include "fast_intr_ctrl_regs.h"  // Generated.
+#include "handler.h"
+#include "irq.h"
+#include "rv_plic.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"  // Generated.
+#include "uart.h"
+#include "uart_regs.h"  // Generated.
+#include "x-heep.h"
+
+#define RUNS_N 16
+// Iterations of the wait in a preempted handler, more cycles than a latency
+#define NESTED_WAIT_N 1000
+
+// The interrupt registers of the hart h of a timer are 0x100 bytes apart
+#define TIMER_REG(reg, h) \
+    ((volatile uint32_t *)(RV_TIMER_START_ADDRESS + (reg) + 0x100 * (h)))
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifndef RV_PLIC_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_PLIC peripheral is not included" )
+#endif
+
+typedef struct {
+    const char *name;
+    volatile uint32_t *trigger;
+    uint32_t value;
+    uint32_t min;
+    uint32_t max;
+} path_t;
+
+static uart_t uart;
+static rv_timer_t timer_2_3;
+
+static volatile uint32_t irq_cycles;
+static volatile uint8_t  irq_done;
+
+// The interrupt raised by the preempted handler in the nested runs
+static path_t *volatile nested;
+static volatile uint32_t nested_start;
+
+// Raises the nested interrupt and waits for it, which is only quick if it
+// preempts the caller
+static void raise_nested(void)
+{
+    uint32_t start;
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    nested_start = start;
+    *nested->trigger = nested->value;
+    for (volatile uint32_t i = 0; i < NESTED_WAIT_N && !irq_done; i++) {
+    }
+}
+
+static void plic_handler(uint32_t id)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+
+    // The UART interrupts are in the order of their bits
+    uart_irq_clear(&uart, id - UART_INTR_TX_WATERMARK);
+    if (id == UART_INTR_RX_TIMEOUT && nested != NULL) {
+        raise_nested();
+    } else {
+        irq_cycles = cycles;
+        irq_done = 1;
+    }
+}
+
+static void fast_handler(uint32_t id)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+
+    rv_timer_irq_clear(&timer_2_3, 1, 0);
+    // The timer kept it pending until now
+    clear_fast_interrupt(kTimer_3_fic_e);
+    if (nested != NULL) {
+        raise_nested();
+    } else {
+        irq_cycles = cycles;
+        irq_done = 1;
+    }
+}
+
+// Takes the vector slot of timer 2: it calls no function, so that only the
+// registers it uses are saved
+INTERRUPT_HANDLER_ABI void handler_irq_fast_timer_2(void)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    irq_cycles = cycles;
+
+    *TIMER_REG(RV_TIMER_INTR_STATE0_REG_OFFSET, 0) = 1;
+    *(volatile uint32_t *)(FAST_INTR_CTRL_START_ADDRESS +
+        FAST_INTR_CTRL_FAST_INTR_CLEAR_REG_OFFSET) = 1 << kTimer_2_fic_e;
+    irq_done = 1;
+}
+
+// Installed in the vector slot of timer 3 by fic_install_vector
+INTERRUPT_HANDLER_ABI void installed_handler(void)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    irq_cycles = cycles;
+
+    *TIMER_REG(RV_TIMER_INTR_STATE0_REG_OFFSET, 1) = 1;
+#if !FIC_AUTO_CLEAR
+    *(volatile uint32_t *)(FAST_INTR_CTRL_START_ADDRESS +
+        FAST_INTR_CTRL_FAST_INTR_CLEAR_REG_OFFSET) = 1 << kTimer_3_fic_e;
+#endif
+    irq_done = 1;
+}
+
+static void measure(path_t *path)
+{
+    path->min = UINT32_MAX;
+    path->max = 0;
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        uint32_t start;
+        irq_done = 0;
+        CSR_READ(CSR_REG_MCYCLE, &start);
+        *path->trigger = path->value;
+        while (!irq_done) {
+        }
+        uint32_t cycles = irq_cycles - start;
+        if (cycles < path->min) path->min = cycles;
+        if (cycles > path->max) path->max = cycles;
+    }
+}
+
+// Measures the latency of a path raised by the handler of another one
+static void measure_nested(path_t *path, const path_t *preempted)
+{
+    path->min = UINT32_MAX;
+    path->max = 0;
+    nested = path;
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        irq_done = 0;
+        *preempted->trigger = preempted->value;
+        while (!irq_done) {
+        }
+        uint32_t cycles = irq_cycles - nested_start;
+        if (cycles < path->min) path->min = cycles;
+        if (cycles > path->max) path->max = cycles;
+    }
+    nested = NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    uart.base_addr = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_2_3);
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    if (plic_Init() != kPlicOk) {
+        PRINTF("Init PLIC failed\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // PLIC: the UART RX timeout and parity error, which are off, so only the test raises them
+    uart_irq_clear(&uart, UART_INTR_STATE_RX_TIMEOUT_BIT);
+    uart_irq_clear(&uart, UART_INTR_STATE_RX_PARITY_ERR_BIT);
+    uart_irq_set_enabled(&uart, UART_INTR_ENABLE_RX_TIMEOUT_BIT, true);
+    uart_irq_set_enabled(&uart, UART_INTR_ENABLE_RX_PARITY_ERR_BIT, true);
+    irq_set_priority(IRQ_SRC_PLIC(UART_INTR_RX_TIMEOUT), 1);
+    irq_set_priority(IRQ_SRC_PLIC(UART_INTR_RX_PARITY_ERR), 2);
+    irq_register(IRQ_SRC_PLIC(UART_INTR_RX_TIMEOUT), plic_handler);
+    irq_register(IRQ_SRC_PLIC(UART_INTR_RX_PARITY_ERR), plic_handler);
+    irq_set_enabled(IRQ_SRC_PLIC(UART_INTR_RX_TIMEOUT), true);
+    irq_set_enabled(IRQ_SRC_PLIC(UART_INTR_RX_PARITY_ERR), true);
+
+    // Fast: the timers 2 and 3, their counters stay disabled
+    rv_timer_irq_enable(&timer_2_3, 0, 0, kRvTimerEnabled);
+    rv_timer_irq_enable(&timer_2_3, 1, 0, kRvTimerEnabled);
+    irq_register(IRQ_SRC_FAST(kTimer_3_fic_e), fast_handler);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_3_fic_e), true);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_2_fic_e), true);
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    path_t paths[] = {
+        {"plic, registered", (volatile uint32_t *)(UART_START_ADDRESS + UART_INTR_TEST_REG_OFFSET),
+         1 << UART_INTR_TEST_RX_TIMEOUT_BIT},
+        {"fast, registered", TIMER_REG(RV_TIMER_INTR_TEST0_REG_OFFSET, 1), 1},
+        {"fast, leaf entry", TIMER_REG(RV_TIMER_INTR_TEST0_REG_OFFSET, 0), 1},
+        {"fast, installed vector", TIMER_REG(RV_TIMER_INTR_TEST0_REG_OFFSET, 1), 1},
+        {"plic, nested", (volatile uint32_t *)(UART_START_ADDRESS + UART_INTR_TEST_REG_OFFSET),
+         1 << UART_INTR_TEST_RX_PARITY_ERR_BIT},
+        {"fast, nested", TIMER_REG(RV_TIMER_INTR_TEST0_REG_OFFSET, 0), 1},
+    };
+    const uint32_t paths_n = sizeof(paths) / sizeof(paths[0]);
+
+    for (uint32_t p = 0; p < 3; p++) {
+        measure(&paths[p]);
+    }
+
+    // The vector table is not in RAM with LINKER=flash_exec
+    bool installed = fic_install_vector(kTimer_3_fic_e, installed_handler) == kFastIntrCtrlOk_e;
+    if (installed) {
+#if FIC_AUTO_CLEAR
+        fic_set_auto_clear(kTimer_3_fic_e, true);
+#endif
+        measure(&paths[3]);
+        fic_set_auto_clear(kTimer_3_fic_e, false);
+        fic_install_vector(kTimer_3_fic_e, NULL);
+    } else {
+        PRINTF("No vector installed, the vector table is not in RAM\n\r");
+    }
+
+    // The handlers of a higher priority preempt the others
+    irq_set_nesting(true);
+    irq_set_priority(IRQ_SRC_FAST(kTimer_3_fic_e), 1);
+    irq_set_priority(IRQ_SRC_FAST(kTimer_2_fic_e), 2);
+    measure_nested(&paths[4], &paths[0]);
+    measure_nested(&paths[5], &paths[1]);
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    irq_set_nesting(false);
+    uart_irq_set_enabled(&uart, UART_INTR_ENABLE_RX_TIMEOUT_BIT, false);
+    uart_irq_set_enabled(&uart, UART_INTR_ENABLE_RX_PARITY_ERR_BIT, false);
+
+    PRINTF("Cycles from the trigger to the handler, min/max of %u runs:\n\r", RUNS_N);
+    for (uint32_t p = 0; p < paths_n; p++) {
+        if (p == 3 && !installed) continue;
+        PRINTF("%s: %u/%u\n\r", paths[p].name, paths[p].min, paths[p].max);
+    }
+
+    // The leaf entries skip the dispatch and most of the register saving, the
+    // nested interrupts do not wait for the handlers they preempt
+    if (paths[2].max < paths[1].min && (!installed || paths[3].max < paths[1].min) &&
+        paths[4].max < NESTED_WAIT_N && paths[5].max < NESTED_WAIT_N) {
+        PRINTF("IRQ latency test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("IRQ latency test failure\n\r");
+        return EXIT_FAILURE;
+    }
+}
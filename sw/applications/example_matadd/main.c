@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include "csr.h"
 #include "matrixAdd32.h"
+#include "perf.h"
 #include "x-heep.h"
 
 /* By default, printfs are activated for FPGA and disabled for simulation. */
@@ -30,17 +31,18 @@ int main()
     int N = WIDTH;
     int M = HEIGHT;
     uint32_t errors = 0;
-    unsigned int instr, cycles;
+    unsigned int cycles;
 
-    //enable mcycle csr
-    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
-
-    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    //start the performance counters, the regions are printed at exit
+    perf_init(PERF_EVENT_DEFAULT);
+    perf_dump_at_exit();
 
     //execute the kernel
-    matrixAdd(m_a, m_b, m_c, N, M);
+    PERF_REGION("matadd") {
+        matrixAdd(m_a, m_b, m_c, N, M);
+    }
 
-    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    cycles = perf_get("matadd")->cycles.max;
 
     errors = check_results(m_c, N, M);
 
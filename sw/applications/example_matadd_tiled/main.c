@@ -0,0 +1,149 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// example_matadd scaled up and tiled with dma_tile.h: the matrices are added
+// tile by tile, the DMA loading the next tiles of A and B and storing the
+// previous tile of C while the CPU adds the current one. The same tiling is
+// run with each copy waited for (serialized) and with the copies overlapped,
+// and compared with the plain loop on the whole matrices. The overlap
+// efficiency is the share of the cycles of the run spent computing.
+// The matrix is not a multiple of the tile, so that the last tiles are
+// smaller.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "dma.h"
+#include "dma_tile.h"
+#include "dsp_matrix.h"
+#include "x-heep.h"
+
+#define MAT_ROWS    48      // Size of the matrices
+#define MAT_COLS    44
+#define TILE_ROWS   16      // Size of the tiles
+#define TILE_COLS   16
+#define TILE_CH     0       // First DMA channel of the tiling
+
+/* The results are the output of the example, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static int32_t m_a[MAT_ROWS * MAT_COLS];
+static int32_t m_b[MAT_ROWS * MAT_COLS];
+static int32_t m_c[MAT_ROWS * MAT_COLS];
+static uint8_t work[DMA_TILE_WORK_B(2, TILE_ROWS, TILE_COLS, sizeof(int32_t))] __attribute__ ((aligned (4)));
+static dma_tile_t tiling;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+void __attribute__ ((noinline)) matrixAdd(int32_t *A, int32_t *B, int32_t *C, int N, int M)
+{
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < M; j++) {
+            C[i*M+j] = A[i*M+j] + B[i*M+j];
+        }
+    }
+}
+
+// The compute callback: the tiles are dense
+static void add_tile(const dma_tile_pos_t *pos, void * const *in, void *out, void *ctx)
+{
+    dsp_mat_add_i32((const int32_t *)in[0], (const int32_t *)in[1], (int32_t *)out, pos->rows, pos->cols);
+}
+
+static uint32_t check_results(void)
+{
+    uint32_t errors = 0;
+
+    for (int i = 0; i < MAT_ROWS * MAT_COLS; i++) {
+        if (m_c[i] != m_a[i] + m_b[i]) errors++;
+        m_c[i] = 0;
+    }
+    return errors;
+}
+
+static void print_stats(const char *name, const dma_tile_stats_t *s, uint32_t errors)
+{
+    PRINTF("%s: %u tiles, %u cycles, compute %u, DMA wait %u, overlap efficiency %u%%%s\n\r",
+           name, s->tiles, s->total, s->compute, s->wait,
+           s->total ? 100 * s->compute / s->total : 0, errors ? " ERROR" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    dma_tile_stats_t serial, overlap;
+    uint32_t errors = 0;
+    uint32_t err;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_init(NULL);
+
+    for (int32_t i = 0; i < MAT_ROWS * MAT_COLS; i++) {
+        m_a[i] = (i * 37) % 2001 - 1000;
+        m_b[i] = (i * 53) % 1501 - 750;
+    }
+
+    TIME(matrixAdd(m_a, m_b, m_c, MAT_ROWS, MAT_COLS));
+    err = check_results();
+    PRINTF("matadd %ux%u: %u cycles%s\n\r", MAT_ROWS, MAT_COLS, cycles, err ? " ERROR" : "");
+    errors += err;
+
+    tiling.rows      = MAT_ROWS;
+    tiling.cols      = MAT_COLS;
+    tiling.stride    = 0;
+    tiling.tile_rows = TILE_ROWS;
+    tiling.tile_cols = TILE_COLS;
+    tiling.elem_b    = sizeof(int32_t);
+    tiling.n_in      = 2;
+    tiling.in[0]     = m_a;
+    tiling.in[1]     = m_b;
+    tiling.out       = m_c;
+    tiling.work      = work;
+    tiling.ch        = TILE_CH;
+    tiling.fn        = add_tile;
+    tiling.ctx       = NULL;
+
+    if (dma_tile_init(&tiling) != DMA_CONFIG_OK) {
+        PRINTF("Tiling failure: the copies are not valid\n\r");
+        return EXIT_FAILURE;
+    }
+    PRINTF("tiles %ux%u, channels %u %u %u\n\r", TILE_ROWS, TILE_COLS,
+           tiling.stream_ch[0], tiling.stream_ch[1], tiling.stream_ch[2]);
+
+    tiling.serialize = 1;
+    dma_tile_run(&tiling, &serial);
+    err = check_results();
+    print_stats("serialized", &serial, err);
+    errors += err;
+
+    tiling.serialize = 0;
+    dma_tile_run(&tiling, &overlap);
+    err = check_results();
+    print_stats("overlapped", &overlap, err);
+    errors += err;
+
+    PRINTF("speedup of the overlap x%u.%02u\n\r", overlap.total ? serial.total / overlap.total : 0,
+           overlap.total ? (100 * serial.total / overlap.total) % 100 : 0);
+
+    if (errors == 0) {
+        PRINTF("Tiled matadd done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Tiled matadd failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
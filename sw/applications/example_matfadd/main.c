@@ -7,6 +7,7 @@
 #include <math.h>
 #include "matrixAdd32.h"
 #include "csr.h"
+#include "perf.h"
 #include "x-heep.h"
 
 #define FS_INITIAL 0x01
@@ -117,22 +118,21 @@ int main()
     int N = WIDTH;
     int M = HEIGHT;
     uint32_t errors = 0;
-    unsigned int instr, cycles;
+    unsigned int cycles;
 
     //enable FP operations
     CSR_SET_BITS(CSR_REG_MSTATUS, (FS_INITIAL << 13));
 
-    //enable mcycle csr
-    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
-
-    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    //start the performance counters, the regions are printed at exit
+    perf_init(PERF_EVENT_DEFAULT);
+    perf_dump_at_exit();
 
     //execute the kernel
-    matrixAdd(m_a, m_b, m_c, N, M);
-
-    CSR_READ(CSR_REG_MCYCLE, &cycles) ;
+    PERF_REGION("matfadd") {
+        matrixAdd(m_a, m_b, m_c, N, M);
+    }
 
-    //stop the HW counter used for monitoring
+    cycles = perf_get("matfadd")->cycles.max;
 
     errors = check_results(m_c, N, M);
 
@@ -0,0 +1,183 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Matrix kernel benchmark: the matadd and matfadd kernels of example_matadd
+// and example_matfadd, a matrix multiplication and a 2D convolution, as plain
+// loops indexing the matrices with i * N + j and as the kernels of
+// dsp_matrix.h. It checks that both give the same results and reports their
+// cycles and the speedup of the library. Build it with and without XPULP=1
+// (and the cv32e40px, or the cv32e40p with COREV_PULP=1) to tell the gain of
+// the Xpulp extensions from the gain of the code.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "dsp_matrix.h"
+#include "x-heep.h"
+
+#define MAT_N       16      // Rows and columns of the matrices
+#define CONV_K      3       // Rows and columns of the kernel of the convolution
+#define CONV_OUT    (MAT_N - CONV_K + 1)
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static int32_t a32[MAT_N * MAT_N], b32[MAT_N * MAT_N];
+static int32_t ref32[MAT_N * MAT_N], lib32[MAT_N * MAT_N];
+static float af[MAT_N * MAT_N], bf[MAT_N * MAT_N];
+static float reff[MAT_N * MAT_N], libf[MAT_N * MAT_N];
+static int32_t kernel[CONV_K * CONV_K];
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// The baseline kernels, as in example_matadd and example_matfadd
+
+static void __attribute__ ((noinline)) matadd_ref(int32_t *A, int32_t *B, int32_t *C, int N, int M)
+{
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < M; j++) {
+            C[i*M+j] = A[i*M+j] + B[i*M+j];
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) matfadd_ref(float *A, float *B, float *C, int N, int M)
+{
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < M; j++) {
+            C[i*M+j] = A[i*M+j] + B[i*M+j];
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) matmul_ref(int32_t *A, int32_t *B, int32_t *C, int N)
+{
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            int32_t acc = 0;
+            for (int k = 0; k < N; k++) {
+                acc += A[i*N+k] * B[k*N+j];
+            }
+            C[i*N+j] = acc;
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) conv2d_ref(int32_t *A, int N, int32_t *K, int KN, int32_t *C)
+{
+    int O = N - KN + 1;
+
+    for (int i = 0; i < O; i++) {
+        for (int j = 0; j < O; j++) {
+            int32_t acc = 0;
+            for (int u = 0; u < KN; u++) {
+                for (int v = 0; v < KN; v++) {
+                    acc += A[(i+u)*N+j+v] * K[u*KN+v];
+                }
+            }
+            C[i*O+j] = acc;
+        }
+    }
+}
+
+static uint32_t compare_i32(const int32_t *ref, const int32_t *lib, uint32_t n)
+{
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (ref[i] != lib[i]) errors++;
+    }
+    return errors;
+}
+
+static uint32_t compare_f32(const float *ref, const float *lib, uint32_t n)
+{
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (ref[i] != lib[i]) errors++;
+    }
+    return errors;
+}
+
+static void print_result(const char *name, uint32_t ref, uint32_t lib, uint32_t errors)
+{
+    // Speedup in hundredths, to print it without floats
+    PRINTF("%s: cycles C loop %u library %u speedup x%u.%02u%s\n\r", name, ref, lib,
+           lib ? ref / lib : 0, lib ? (100 * ref / lib) % 100 : 0, errors ? " ERROR" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t err, ref, lib;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    PRINTF("Matrix kernels %ux%u, Xpulp %s\n\r", MAT_N, MAT_N, DSP_XPULP ? "on" : "off");
+
+    // Positive and negative values, exact in float
+    for (int32_t i = 0; i < MAT_N * MAT_N; i++) {
+        a32[i] = (i * 37) % 201 - 100;
+        b32[i] = (i * 53) % 151 - 75;
+        af[i]  = (float)a32[i] * 0.5f;
+        bf[i]  = (float)b32[i] * 0.25f;
+    }
+    for (int32_t i = 0; i < CONV_K * CONV_K; i++) {
+        kernel[i] = i - CONV_K * CONV_K / 2;
+    }
+
+    TIME(matadd_ref(a32, b32, ref32, MAT_N, MAT_N));
+    ref = cycles;
+    TIME(dsp_mat_add_i32(a32, b32, lib32, MAT_N, MAT_N));
+    lib = cycles;
+    err = compare_i32(ref32, lib32, MAT_N * MAT_N);
+    print_result("matadd", ref, lib, err);
+    errors += err;
+
+    TIME(matfadd_ref(af, bf, reff, MAT_N, MAT_N));
+    ref = cycles;
+    TIME(dsp_mat_add_f32(af, bf, libf, MAT_N, MAT_N));
+    lib = cycles;
+    err = compare_f32(reff, libf, MAT_N * MAT_N);
+    print_result("matfadd", ref, lib, err);
+    errors += err;
+
+    TIME(matmul_ref(a32, b32, ref32, MAT_N));
+    ref = cycles;
+    TIME(dsp_mat_mul_i32(a32, b32, lib32, MAT_N, MAT_N, MAT_N));
+    lib = cycles;
+    err = compare_i32(ref32, lib32, MAT_N * MAT_N);
+    print_result("matmul", ref, lib, err);
+    errors += err;
+
+    TIME(conv2d_ref(a32, MAT_N, kernel, CONV_K, ref32));
+    ref = cycles;
+    TIME(dsp_conv2d_i32(a32, MAT_N, MAT_N, kernel, CONV_K, CONV_K, lib32));
+    lib = cycles;
+    err = compare_i32(ref32, lib32, CONV_OUT * CONV_OUT);
+    print_result("conv2d", ref, lib, err);
+    errors += err;
+
+    if (errors == 0) {
+        PRINTF("Matrix kernel benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Matrix kernel benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,182 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Microbenchmark of the memory functions of the base library: reports the
+// cycles per byte (x100) of memcpy, memset, memcmp, memchr and memrchr next to
+// the byte loops they replaced, for several sizes and misalignments. Build it
+// with CPU=cv32e20, cv32e40p or cv32e40x to compare the cores.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "memory.h"
+#include "csr.h"
+#include "x-heep.h"
+
+#define BENCH_MAX_B     1024    // Largest region, in bytes
+#define BENCH_SIZES_N   4
+#define BENCH_OFFSETS_N 2
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+static uint8_t bench_a[BENCH_MAX_B + 4] __attribute__ ((aligned (4)));
+static uint8_t bench_b[BENCH_MAX_B + 4] __attribute__ ((aligned (4)));
+
+static const uint32_t bench_sizes_b[BENCH_SIZES_N] = { 16, 64, 256, BENCH_MAX_B };
+// Offsets of the second buffer: the same alignment as the first one, and a different one
+static const uint32_t bench_offsets_b[BENCH_OFFSETS_N] = { 0, 1 };
+
+// The byte loops of the previous implementation. The volatile accesses keep
+// the compiler from turning them back into library calls.
+static void * __attribute__ ((noinline)) ref_memcpy(void *dest, const void *src, size_t len)
+{
+    volatile uint8_t *dest8 = (volatile uint8_t *)dest;
+    const volatile uint8_t *src8 = (const volatile uint8_t *)src;
+    for (size_t i = 0; i < len; ++i) dest8[i] = src8[i];
+    return dest;
+}
+
+static void * __attribute__ ((noinline)) ref_memset(void *dest, int value, size_t len)
+{
+    volatile uint8_t *dest8 = (volatile uint8_t *)dest;
+    for (size_t i = 0; i < len; ++i) dest8[i] = (uint8_t)value;
+    return dest;
+}
+
+static int __attribute__ ((noinline)) ref_memcmp(const void *lhs, const void *rhs, size_t len)
+{
+    const volatile uint8_t *lhs8 = (const volatile uint8_t *)lhs;
+    const volatile uint8_t *rhs8 = (const volatile uint8_t *)rhs;
+    for (size_t i = 0; i < len; ++i) {
+        if (lhs8[i] != rhs8[i]) return lhs8[i] < rhs8[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static void * __attribute__ ((noinline)) ref_memchr(const void *ptr, int value, size_t len)
+{
+    const volatile uint8_t *ptr8 = (const volatile uint8_t *)ptr;
+    for (size_t i = 0; i < len; ++i) {
+        if (ptr8[i] == (uint8_t)value) return (void *)(ptr8 + i);
+    }
+    return NULL;
+}
+
+static void * __attribute__ ((noinline)) ref_memrchr(const void *ptr, int value, size_t len)
+{
+    const volatile uint8_t *ptr8 = (const volatile uint8_t *)ptr;
+    for (size_t i = len; i > 0; --i) {
+        if (ptr8[i - 1] == (uint8_t)value) return (void *)(ptr8 + i - 1);
+    }
+    return NULL;
+}
+
+static void cycles_start(void)
+{
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+}
+
+static uint32_t cycles_stop(void)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    return cycles;
+}
+
+static void print_result(const char *name, uint32_t size_b, uint32_t offset, uint32_t ref, uint32_t lib)
+{
+    PRINTF("%s %u +%u: cyc/B x100 byte loop %u library %u\n\r", name, size_b, offset,
+           (100 * ref) / size_b, (100 * lib) / size_b);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t ref, lib;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (uint32_t s = 0; s < BENCH_SIZES_N; s++) {
+        for (uint32_t o = 0; o < BENCH_OFFSETS_N; o++) {
+            uint32_t size_b = bench_sizes_b[s];
+            uint32_t offset = bench_offsets_b[o];
+            uint8_t *a = bench_a;
+            uint8_t *b = bench_b + offset;
+
+            for (uint32_t i = 0; i < size_b; i++) {
+                a[i] = i * 7 + 1;   // Never 0
+            }
+
+            cycles_start();
+            ref_memcpy(b, a, size_b);
+            ref = cycles_stop();
+            ref_memset(b, 0, size_b);
+            cycles_start();
+            memcpy(b, a, size_b);
+            lib = cycles_stop();
+            errors += ref_memcmp(a, b, size_b) != 0;
+            print_result("memcpy ", size_b, offset, ref, lib);
+
+            cycles_start();
+            ref_memset(b, 0, size_b);
+            ref = cycles_stop();
+            cycles_start();
+            memset(b, 0, size_b);
+            lib = cycles_stop();
+            errors += ref_memchr(b, 0, size_b) != b || ref_memrchr(b, 1, size_b) != NULL;
+            print_result("memset ", size_b, offset, ref, lib);
+
+            // Equal regions, the worst case of the comparisons and searches
+            memcpy(b, a, size_b);
+            cycles_start();
+            ref_memcmp(a, b, size_b);
+            ref = cycles_stop();
+            cycles_start();
+            errors += memcmp(a, b, size_b) != 0;
+            lib = cycles_stop();
+            print_result("memcmp ", size_b, offset, ref, lib);
+
+            cycles_start();
+            ref_memchr(b, 0, size_b);
+            ref = cycles_stop();
+            cycles_start();
+            errors += memchr(b, 0, size_b) != NULL;
+            lib = cycles_stop();
+            print_result("memchr ", size_b, offset, ref, lib);
+
+            cycles_start();
+            ref_memrchr(b, 0, size_b);
+            ref = cycles_stop();
+            cycles_start();
+            errors += memrchr(b, 0, size_b) != NULL;
+            lib = cycles_stop();
+            print_result("memrchr", size_b, offset, ref, lib);
+
+            // The results must match the byte loops
+            b[size_b / 2] = 0;
+            errors += (memcmp(a, b, size_b) > 0) != (ref_memcmp(a, b, size_b) > 0);
+            errors += memchr(b, 0, size_b) != &b[size_b / 2];
+            errors += memrchr(b, 0, size_b) != &b[size_b / 2];
+        }
+    }
+
+    if (errors == 0) {
+        PRINTF("Memory benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Memory benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Splits a sum of squares over the harts of a multi-core X-HEEP
+// (cpu_num > 1 in mcu_cfg.hjson). Hart 0 starts the secondary harts through
+// the mailbox, each hart adds its slice to the shared total under a
+// semaphore and notifies hart 0 with its mailbox interrupt. The result and
+// the cycles are compared with those of hart 0 alone.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "hart.h"
+#include "mailbox.h"
+
+#ifndef MAILBOX_IS_INCLUDED
+  #error ( "This app does NOT work as the MAILBOX peripheral is not included" )
+#endif
+
+#if CPU_NUM < 2
+  #error ( "This app needs a multi-core X-HEEP, set cpu_num in mcu_cfg.hjson" )
+#endif
+
+/* The cycles are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define TEST_WORDS  2048
+#define SEM_TOTAL   0
+
+static uint32_t data[TEST_WORDS];
+
+// Shared by the harts, the total and the count under SEM_TOTAL
+static volatile uint32_t total;
+static volatile uint32_t harts_done;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static uint32_t sum_squares(uint32_t hart)
+{
+    uint32_t first = hart * TEST_WORDS / CPU_NUM;
+    uint32_t last = (hart + 1) * TEST_WORDS / CPU_NUM;
+    uint32_t sum = 0;
+
+    for (uint32_t i = first; i < last; i++) {
+        sum += data[i] * data[i];
+    }
+    return sum;
+}
+
+static void add_to_total(uint32_t sum)
+{
+    mailbox_sem_take(SEM_TOTAL);
+    total += sum;
+    harts_done++;
+    mailbox_sem_release(SEM_TOTAL);
+}
+
+// Entry point of the secondary harts, they park when it returns
+void hart_main(uint32_t hart_id)
+{
+    add_to_total(sum_squares(hart_id));
+    mailbox_notify(0);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t expected = 0;
+
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (uint32_t i = 0; i < TEST_WORDS; i++) {
+        data[i] = i * 7 + 3;
+    }
+
+    TIME(for (uint32_t i = 0; i < TEST_WORDS; i++) { expected += data[i] * data[i]; });
+    PRINTF("hart 0 alone: %u cycles\n\r", cycles);
+
+    // The mailbox interrupt only wakes hart 0 from wfi, mstatus.MIE is 0 so
+    // it is not taken
+    CSR_SET_BITS(CSR_REG_MIE, 1 << 3);
+
+    TIME(
+        for (uint32_t hart = 1; hart < CPU_NUM; hart++) {
+            mailbox_hart_start(hart);
+        }
+        add_to_total(sum_squares(0));
+        while (1) {
+            // cleared before the check, so that a later notify wakes the wfi
+            mailbox_irq_clear();
+            if (harts_done == CPU_NUM) {
+                break;
+            }
+            wait_for_interrupt();
+        }
+    );
+    PRINTF("%u harts: %u cycles\n\r", CPU_NUM, cycles);
+
+    CSR_CLEAR_BITS(CSR_REG_MIE, 1 << 3);
+
+    if (total != expected) {
+        PRINTF("wrong sum: 0x%08x instead of 0x%08x\n\r", total, expected);
+        return EXIT_FAILURE;
+    }
+
+    PRINTF("success\n\r");
+    return EXIT_SUCCESS;
+}
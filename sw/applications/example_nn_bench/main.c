@@ -0,0 +1,379 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// int8 inference benchmark: a small keyword-spotting style network (conv 3x3,
+// depthwise conv 3x3, pointwise conv, max pooling, global average pooling,
+// fully connected) run with the kernels of dsp_nn.h.
+//
+// First each layer is run as plain loops and with the library, on the same
+// input, to check that they agree and report the speedup. Then the whole
+// inference is run NN_RUNS times with the weights of the next layer copied by
+// the DMA to a RAM buffer while the current layer computes (double
+// buffering). The weights are in the flash with the flash_exec and flash_load
+// linkers, in the RAM and used in place with the on_chip one.
+//
+// For each inference it reports the latency in cycles, the cycles spent
+// waiting for the weights, and, as the energy proxy, the cycles the core spends
+// computing (the latency without the waits, which the core could sleep
+// through) with the instructions retired and the stalls (mhpmcounter3).
+// Build it with and without XPULP=1 (and the cv32e40px) to see the gain of
+// the packed-SIMD dot products.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "dsp_nn.h"
+#include "perf.h"
+#include "soc_ctrl.h"
+#include "spi_memio.h"
+#include "x-heep.h"
+
+#include "weights.h"
+
+#define NN_RUNS     4       // Inferences measured
+#define POOL_H      (IN_H / 2)
+#define POOL_W      (IN_W / 2)
+#define ACT_SIZE    (IN_H * IN_W * CONV_C)
+#define W_MAX       (CONV_C * 3 * 3 * IN_C)     // Largest weights of a layer
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// The weights of a layer, where they are stored
+typedef struct {
+    const int8_t  *w;
+    size_t        w_len;
+    const int32_t *b;
+    size_t        b_len;
+} layer_weights_t;
+
+// A RAM buffer for the weights of a layer
+typedef struct {
+    int8_t  w[W_MAX];
+    int32_t b[CONV_C];
+} weight_slot_t;
+
+// The weights of a layer being copied, and where to read them
+typedef struct {
+    const int8_t     *w;
+    const int32_t    *b;
+    dma_copy_token_t tok_w;
+    dma_copy_token_t tok_b;
+} weight_load_t;
+
+static const layer_weights_t layer_weights[] = {
+    { conv1_w, sizeof(conv1_w), conv1_b, sizeof(conv1_b) },
+    { dw2_w,   sizeof(dw2_w),   dw2_b,   sizeof(dw2_b)   },
+    { pw3_w,   sizeof(pw3_w),   pw3_b,   sizeof(pw3_b)   },
+    { fc6_w,   sizeof(fc6_w),   fc6_b,   sizeof(fc6_b)   },
+};
+
+static const dsp_nn_conv_t conv1 = { IN_H, IN_W, IN_C,   CONV_C, 3, 3, 1, 1 };
+static const dsp_nn_conv_t dw2   = { IN_H, IN_W, CONV_C, CONV_C, 3, 3, 1, 1 };
+static const dsp_nn_conv_t pw3   = { IN_H, IN_W, CONV_C, CONV_C, 1, 1, 1, 0 };
+static const dsp_nn_pool_t pool4 = { IN_H, IN_W, CONV_C, 2, 2 };
+static const dsp_nn_pool_t gap5  = { POOL_H, POOL_W, CONV_C, POOL_H, 1 };
+
+static dsp_nn_quant_t q1, q2, q3, q6;
+
+static int8_t input[IN_H * IN_W * IN_C] __attribute__ ((aligned (4)));
+static int8_t act_a[ACT_SIZE] __attribute__ ((aligned (4)));
+static int8_t act_b[ACT_SIZE] __attribute__ ((aligned (4)));
+static int8_t ref_a[ACT_SIZE] __attribute__ ((aligned (4)));
+static int8_t ref_b[ACT_SIZE] __attribute__ ((aligned (4)));
+static weight_slot_t slots[2];
+
+static uint32_t cycles;
+static uint32_t wait_cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// The baseline kernels, with the bounds of the input checked at each tap
+
+static void __attribute__ ((noinline)) conv_ref(const dsp_nn_conv_t *c, const int8_t *in, const int8_t *w,
+                                                const int32_t *b, const dsp_nn_quant_t *q, int8_t *out)
+{
+    int oh = (c->in_h + 2 * c->pad - c->k_h) / c->stride + 1;
+    int ow = (c->in_w + 2 * c->pad - c->k_w) / c->stride + 1;
+
+    for (int y = 0; y < oh; y++) {
+        for (int x = 0; x < ow; x++) {
+            for (int oc = 0; oc < c->out_c; oc++) {
+                int32_t acc = b[oc];
+                for (int ky = 0; ky < c->k_h; ky++) {
+                    for (int kx = 0; kx < c->k_w; kx++) {
+                        int iy = y * c->stride - c->pad + ky;
+                        int ix = x * c->stride - c->pad + kx;
+                        if (iy < 0 || ix < 0 || iy >= c->in_h || ix >= c->in_w) continue;
+                        for (int ic = 0; ic < c->in_c; ic++) {
+                            acc += in[(iy * c->in_w + ix) * c->in_c + ic] *
+                                   w[((oc * c->k_h + ky) * c->k_w + kx) * c->in_c + ic];
+                        }
+                    }
+                }
+                out[(y * ow + x) * c->out_c + oc] = dsp_nn_requant(acc, q);
+            }
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) dwconv_ref(const dsp_nn_conv_t *c, const int8_t *in, const int8_t *w,
+                                                  const int32_t *b, const dsp_nn_quant_t *q, int8_t *out)
+{
+    int oh = (c->in_h + 2 * c->pad - c->k_h) / c->stride + 1;
+    int ow = (c->in_w + 2 * c->pad - c->k_w) / c->stride + 1;
+
+    for (int y = 0; y < oh; y++) {
+        for (int x = 0; x < ow; x++) {
+            for (int ch = 0; ch < c->in_c; ch++) {
+                int32_t acc = b[ch];
+                for (int ky = 0; ky < c->k_h; ky++) {
+                    for (int kx = 0; kx < c->k_w; kx++) {
+                        int iy = y * c->stride - c->pad + ky;
+                        int ix = x * c->stride - c->pad + kx;
+                        if (iy < 0 || ix < 0 || iy >= c->in_h || ix >= c->in_w) continue;
+                        acc += in[(iy * c->in_w + ix) * c->in_c + ch] * w[(ky * c->k_w + kx) * c->in_c + ch];
+                    }
+                }
+                out[(y * ow + x) * c->in_c + ch] = dsp_nn_requant(acc, q);
+            }
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) pool_ref(const dsp_nn_pool_t *p, const int8_t *in, int8_t *out, int max)
+{
+    int oh = (p->in_h - p->k) / p->stride + 1;
+    int ow = (p->in_w - p->k) / p->stride + 1;
+    int n = p->k * p->k;
+
+    for (int y = 0; y < oh; y++) {
+        for (int x = 0; x < ow; x++) {
+            for (int ch = 0; ch < p->c; ch++) {
+                int32_t acc = max ? -128 : 0;
+                for (int ky = 0; ky < p->k; ky++) {
+                    for (int kx = 0; kx < p->k; kx++) {
+                        int8_t v = in[((y * p->stride + ky) * p->in_w + x * p->stride + kx) * p->c + ch];
+                        if (max) {
+                            if (v > acc) acc = v;
+                        } else {
+                            acc += v;
+                        }
+                    }
+                }
+                if (!max) acc = acc >= 0 ? (acc + n / 2) / n : -((-acc + n / 2) / n);
+                out[(y * ow + x) * p->c + ch] = (int8_t)acc;
+            }
+        }
+    }
+}
+
+static void __attribute__ ((noinline)) fc_ref(const int8_t *in, int n_in, const int8_t *w, const int32_t *b,
+                                              int n_out, const dsp_nn_quant_t *q, int8_t *out)
+{
+    for (int o = 0; o < n_out; o++) {
+        int32_t acc = b[o];
+        for (int i = 0; i < n_in; i++) {
+            acc += in[i] * w[o * n_in + i];
+        }
+        out[o] = dsp_nn_requant(acc, q);
+    }
+}
+
+// Weights prefetch: the DMA copies the weights of a layer from the flash to a
+// slot, nothing is copied when they are in the RAM
+
+static void weights_start(uint32_t layer, weight_slot_t *slot, weight_load_t *load)
+{
+    const layer_weights_t *lw = &layer_weights[layer];
+
+    load->b = spi_memio_load_async(slot->b, lw->b, lw->b_len, &load->tok_b);
+    load->w = spi_memio_load_async(slot->w, lw->w, lw->w_len, &load->tok_w);
+}
+
+static void weights_wait(weight_load_t *load)
+{
+    uint32_t start, end;
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    dma_copy_wait(load->tok_b);
+    dma_copy_wait(load->tok_w);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    wait_cycles += end - start;
+}
+
+// One inference with the library, returns the class
+static size_t infer(const int8_t *in)
+{
+    weight_load_t load[2];
+
+    weights_start(0, &slots[0], &load[0]);
+    weights_wait(&load[0]);
+    weights_start(1, &slots[1], &load[1]);
+    dsp_nn_conv2d_i8(&conv1, in, load[0].w, load[0].b, &q1, act_a);
+
+    weights_wait(&load[1]);
+    weights_start(2, &slots[0], &load[0]);
+    dsp_nn_dwconv2d_i8(&dw2, act_a, load[1].w, load[1].b, &q2, act_b);
+
+    weights_wait(&load[0]);
+    weights_start(3, &slots[1], &load[1]);
+    dsp_nn_conv2d_i8(&pw3, act_b, load[0].w, load[0].b, &q3, act_a);
+    dsp_nn_maxpool_i8(&pool4, act_a, act_b);
+    dsp_nn_avgpool_i8(&gap5, act_b, act_a);
+
+    weights_wait(&load[1]);
+    dsp_nn_fc_i8(act_a, CONV_C, load[1].w, load[1].b, CLASSES, &q6, act_b);
+
+    return dsp_nn_argmax_i8(act_b, CLASSES);
+}
+
+static uint32_t compare(const int8_t *ref, const int8_t *lib, uint32_t n)
+{
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (ref[i] != lib[i]) errors++;
+    }
+    return errors;
+}
+
+static void print_result(const char *name, uint32_t ref, uint32_t lib, uint32_t errors)
+{
+    // Speedup in hundredths, to print it without floats
+    PRINTF("%s: cycles C loop %u library %u speedup x%u.%02u%s\n\r", name, ref, lib,
+           lib ? ref / lib : 0, lib ? (100 * ref / lib) % 100 : 0, errors ? " ERROR" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    weight_slot_t *s = &slots[0];
+    uint32_t errors = 0;
+    uint32_t err, ref, lib;
+    size_t expected, label;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    if (spi_memio_is_mapped(conv1_w)) {
+        soc_ctrl_select_spi_memio(&soc_ctrl);
+    }
+    dma_init(NULL);
+
+    PRINTF("int8 network, Xpulp %s, weights in the %s\n\r", DSP_XPULP ? "on" : "off",
+           spi_memio_is_mapped(conv1_w) ? "flash" : "RAM");
+
+    for (int32_t i = 0; i < IN_H * IN_W * IN_C; i++) {
+        input[i] = (int8_t)((i * 37) % 201 - 100);
+    }
+    dsp_nn_quant_init(&q1, 0.004f, 0, 127);
+    dsp_nn_quant_init(&q2, 0.01f, 0, 127);
+    dsp_nn_quant_init(&q3, 0.008f, 0, 127);
+    dsp_nn_quant_init(&q6, 0.01f, -128, 127);
+
+    // Layer by layer, the library against the plain loops, with the weights
+    // loaded beforehand
+
+    spi_memio_load(s->w, conv1_w, sizeof(conv1_w));
+    spi_memio_load(s->b, conv1_b, sizeof(conv1_b));
+    TIME(conv_ref(&conv1, input, s->w, s->b, &q1, ref_a));
+    ref = cycles;
+    TIME(dsp_nn_conv2d_i8(&conv1, input, s->w, s->b, &q1, act_a));
+    lib = cycles;
+    err = compare(ref_a, act_a, ACT_SIZE);
+    print_result("conv 3x3", ref, lib, err);
+    errors += err;
+
+    spi_memio_load(s->w, dw2_w, sizeof(dw2_w));
+    spi_memio_load(s->b, dw2_b, sizeof(dw2_b));
+    TIME(dwconv_ref(&dw2, ref_a, s->w, s->b, &q2, ref_b));
+    ref = cycles;
+    TIME(dsp_nn_dwconv2d_i8(&dw2, act_a, s->w, s->b, &q2, act_b));
+    lib = cycles;
+    err = compare(ref_b, act_b, ACT_SIZE);
+    print_result("depthwise 3x3", ref, lib, err);
+    errors += err;
+
+    spi_memio_load(s->w, pw3_w, sizeof(pw3_w));
+    spi_memio_load(s->b, pw3_b, sizeof(pw3_b));
+    TIME(conv_ref(&pw3, ref_b, s->w, s->b, &q3, ref_a));
+    ref = cycles;
+    TIME(dsp_nn_conv2d_i8(&pw3, act_b, s->w, s->b, &q3, act_a));
+    lib = cycles;
+    err = compare(ref_a, act_a, ACT_SIZE);
+    print_result("pointwise", ref, lib, err);
+    errors += err;
+
+    TIME(pool_ref(&pool4, ref_a, ref_b, 1));
+    ref = cycles;
+    TIME(dsp_nn_maxpool_i8(&pool4, act_a, act_b));
+    lib = cycles;
+    err = compare(ref_b, act_b, POOL_H * POOL_W * CONV_C);
+    print_result("maxpool 2x2", ref, lib, err);
+    errors += err;
+
+    TIME(pool_ref(&gap5, ref_b, ref_a, 0));
+    ref = cycles;
+    TIME(dsp_nn_avgpool_i8(&gap5, act_b, act_a));
+    lib = cycles;
+    err = compare(ref_a, act_a, CONV_C);
+    print_result("global avgpool", ref, lib, err);
+    errors += err;
+
+    spi_memio_load(s->w, fc6_w, sizeof(fc6_w));
+    spi_memio_load(s->b, fc6_b, sizeof(fc6_b));
+    TIME(fc_ref(ref_a, CONV_C, s->w, s->b, CLASSES, &q6, ref_b));
+    ref = cycles;
+    TIME(dsp_nn_fc_i8(act_a, CONV_C, s->w, s->b, CLASSES, &q6, act_b));
+    lib = cycles;
+    err = compare(ref_b, act_b, CLASSES);
+    print_result("fully connected", ref, lib, err);
+    errors += err;
+
+    expected = dsp_nn_argmax_i8(ref_b, CLASSES);
+
+    // The whole inference, with the weights prefetched
+
+    perf_init(PERF_EVENT_DEFAULT);
+    wait_cycles = 0;
+    for (uint32_t r = 0; r < NN_RUNS; r++) {
+        PERF_REGION("inference") {
+            label = infer(input);
+        }
+        if (label != expected) errors++;
+    }
+
+    const perf_region_t *pr = perf_get("inference");
+    if (pr != NULL) {
+        uint32_t latency = (uint32_t)(pr->cycles.total / pr->count);
+        uint32_t wait = wait_cycles / pr->count;
+        PRINTF("inference: class %u latency %u cycles, weight waits %u cycles\n\r",
+               (uint32_t)label, latency, wait);
+        PRINTF("energy proxy: %u compute cycles, %u instructions, %u stall cycles\n\r",
+               latency - wait, (uint32_t)(pr->instr.total / pr->count),
+               (uint32_t)(pr->event.total / pr->count));
+    }
+
+    if (errors == 0) {
+        PRINTF("int8 inference benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("int8 inference benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Weights of the network of example_nn_bench, pseudo-random int8 values.
+// They are in the flash with the flash_exec and flash_load linkers.
+
+#ifndef NN_WEIGHTS_H_
+#define NN_WEIGHTS_H_
+
+#include <stdint.h>
+
+#include "spi_memio.h"
+
+#define IN_H        12
+#define IN_W        12
+#define IN_C        4
+#define CONV_C      16      // Channels of the hidden layers
+#define CLASSES     8
+
+// conv 3x3, IN_C -> CONV_C, filters out_c x k_h x k_w x in_c
+FLASH_RODATA const int8_t conv1_w[CONV_C * 3 * 3 * IN_C] = {
+     -42,  -25,  -36,  -42,  -36,   34,   15,  -19,   55,  -13,    4,  -17,  -14,  -10,   41,  -39,  -37,    6,
+      40,  -25,   -4,  -64,  -18,   20,   34,    0,   38,   30,  -40,  -30,   62,   -1,  -21,  -63,  -32,  -13,
+     -25,   58,   -7,   -8,   24,   41,   53,  -56,   10,   42,   -1,  -32,    8,   24,    4,   -4,   31,   16,
+      48,   23,   27,  -18,   47,  -18,    7,  -50,  -20,   -3,   49,   11,   20,    0,   35,  -62,   19,  -13,
+      42,  -49,   21,   17,  -47,  -50,    5,  -41,  -27,   26,   17,    1,  -14,  -48,   35,   10,  -60,  -52,
+     -25,   47,  -25,   42,  -53,  -20,   38,  -59,   -7,   -3,   14,   58,  -34,  -34,  -21,  -27,   37,  -54,
+     -55,  -30,   60,   62,  -13,   12,  -51,  -10,  -10,    0,  -59,  -19,   30,   26,  -48,  -32,  -10,  -10,
+     -39,  -53,  -53,  -17,   13,  -22,   42,   34,  -40,   56,  -36,  -21,  -26,  -13,  -16,  -27,   34,   21,
+      48,  -18,   57,  -38,   41,   32,   23,  -64,   39,  -40,  -24,    1,   54,   49,   23,   26,   33,    9,
+     -46,  -57,  -11,   -6,    2,    3,   -2,  -31,  -42,   12,  -57,  -39,   57,  -36,   30,  -64,  -42,   47,
+      13,   48,   26,    3,  -32,    6,   48,   18,   37,  -35,    6,  -39,   38,   19,  -58,   20,  -16,  -62,
+     -35,   62,  -49,  -57,   -9,   20,  -49,   61,   -1,   18,   59,    2,   34,  -12,   32,   48,  -52,   54,
+     -54,   36,   41,   19,  -60,   -7,   36,    8,  -36,   12,  -22,  -47,   28,   -6,  -25,  -23,  -48,   28,
+     -57,   13,    6,   17,  -11,   57,    8,   51,   30,   41,  -29,   32,   46,  -39,  -29,   49,  -47,    4,
+      20,    5,  -13,   39,  -63,  -10,   63,   -3,   -9,   33,   34,    4,    2,  -30,  -57,  -10,  -19,  -43,
+      28,  -48,    6,  -43,  -53,  -50,  -41,   -1,  -63,  -21,   45,   47,   41,  -27,   19,    1,  -15,   54,
+     -42,  -48,  -61,   26,    2,   57,   12,   15,  -29,   24,   -8,  -49,    5,    9,  -14,  -41,   51,  -25,
+      39,  -29,   -6,  -49,    3,  -18,   38,   29,   50,   53,  -62,  -19,   31,   52,   28,   26,   -9,   39,
+      62,  -63,   38,   10,  -11,   62,  -40,   24,  -52,   45,   -8,  -50,   16,  -23,   52,  -24,  -51,   15,
+     -10,  -31,  -49,   -5,  -22,  -10,   34,  -55,   -2,   35,   17,  -44,  -36,   36,   41,   57,  -15,  -11,
+      54,  -44,  -24,  -47,  -60,  -63,   47,   53,   30,  -37,  -16,  -35,  -47,   63,   24,  -60,   41,  -55,
+     -45,   39,   49,   21,   12,    2,   54,   -2,  -16,   17,  -59,   33,  -21,  -49,   39,  -38,   41,   -6,
+     -21,  -60,   21,   12,  -37,   61,  -36,  -63,    4,  -33,  -22,   23,   50,    7,  -21,  -56,  -15,  -48,
+     -54,  -47,   12,   24,   53,  -18,   16,   -7,   21,   26,  -55,  -48,   25,   19,  -62,   56,   44,  -45,
+     -55,   15,   -7,   22,  -24,  -17,  -19,  -38,  -21,   53,   51,  -39,  -32,   -4,   57,   16,   17,   34,
+      41,   59,   11,  -63,  -16,  -43,   26,   54,   58,   27,  -54,   28,  -14,    9,  -26,  -47,  -59,  -37,
+      -5,  -17,   31,   13,  -43,  -45,   44,  -38,   -1,   24,  -41,   63,  -57,   27,  -51,   -8,   55,   -7,
+      -6,    0,   27,   11,   10,   20,    1,  -16,  -24,   48,   51,    2,  -63,   16,   62,  -33,    1,   48,
+     -18,  -32,  -44,  -53,  -49,   36,   38,  -34,   44,    5,   34,   36,   18,   32,   53,   27,  -51,  -47,
+      10,   -3,  -24,   52,   15,  -57,   49,   36,  -18,   53,   50,   62,   20,  -62,   56,  -34,   44,   44,
+     -50,   32,   36,  -19,  -63,  -33,   38,  -63,   29,   56,   31,   38,   46,    7,   59,  -42,    0,  -24,
+     -27,  -50,  -34,   54,  -54,  -54,  -43,   14,  -42,  -59,   49,  -52,   53,   -4,   -3,   12,  -46,  -21
+};
+FLASH_RODATA const int32_t conv1_b[CONV_C] = {
+     880, 1094, -1738, -1749, 1014,  -25, 1949,  896,
+    -1435, -1625, 1476,  795, -627, 1502, -499, 1260
+};
+
+// depthwise conv 3x3, k_h x k_w x CONV_C
+FLASH_RODATA const int8_t dw2_w[3 * 3 * CONV_C] = {
+      59,   56,  -41,  -49,   40,  -50,  -55,   56,  -38,   42,  -19,   61,  -35,  -24,   49,  -38,
+      -4,  -29,   63,  -53,  -60,   56,    4,   12,    1,  -61,   43,  -40,   63,   32,   34,   44,
+     -55,   42,   19,  -60,   44,   -2,  -21,   27,   52,   -8,  -42,  -18,  -20,   52,   63,   57,
+      33,   13,  -45,   56,  -32,   32,   -2,  -26,  -14,  -55,  -20,    1,  -26,   35,    8,    3,
+       6,   12,   -1,   40,  -33,   30,   61,  -18,   61,   54,  -18,   15,   44,  -17,   -3,    8,
+      -9,   39,   24,   21,   43,   -8,   40,   49,   20,   63,  -36,   26,   61,   23,   31,  -54,
+     -12,  -34,   28,   -3,  -61,   46,  -64,   49,  -10,  -28,   54,   32,   27,   27,  -20,  -57,
+      -4,   49,   12,  -30,   38,  -64,    3,  -20,  -27,   37,   -3,   34,  -59,   -5,  -27,    0,
+      17,   32,  -24,  -62,  -42,   46,  -14,  -28,  -32,    2,   47,   33,   58,   55,   10,  -10
+};
+FLASH_RODATA const int32_t dw2_b[CONV_C] = {
+    -237, -459, -396, -423, -311, -265,  346,  181,
+    -142,  409,  295, -132,  274,  141,  283, -401
+};
+
+// pointwise conv 1x1, CONV_C -> CONV_C
+FLASH_RODATA const int8_t pw3_w[CONV_C * CONV_C] = {
+     -34,  -47,  -28,   -9,   25,   30,  -44,    7,   -7,   15,  -41,   18,   10,  -61,  -39,   21,
+      23,   20,    5,  -53,   45,   31,  -56,   50,   24,  -64,  -51,    4,  -29,   19,    2,   62,
+     -36,  -13,   17,   28,   13,   -3,  -25,   25,  -61,   13,   47,  -13,    9,   63,  -41,   36,
+      44,  -18,    9,  -24,   56,   55,   50,   61,   -7,  -10,   -2,  -35,   -5,  -57,  -40,  -59,
+       9,    5,  -19,   49,   48,  -51,   41,   28,   60,   -5,   56,  -61,   56,   43,    5,   34,
+     -14,   56,   61,  -11,  -12,   63,  -52,   56,   11,   28,  -34,   38,  -62,  -21,  -34,   60,
+     -26,    7,   -6,   54,    3,   13,   28,   15,  -27,  -39,  -16,    4,   24,    7,  -28,   17,
+     -25,  -14,   34,  -14,  -33,   55,   23,   35,  -52,   50,  -18,  -33,   58,   -1,   21,   35,
+     -12,   -7,   54,   43,    7,   61,   62,  -14,   63,   39,  -39,   53,   39,  -45,  -14,  -16,
+      12,   28,   54,  -33,   -5,   31,   17,   -3,   61,   56,   47,    8,  -31,    2,   -5,   -6,
+      49,  -37,   34,   15,   58,  -35,   16,  -59,  -56,  -27,  -15,  -42,  -25,   14,   48,   63,
+     -30,   54,   -5,   60,  -58,   -9,   59,  -56,  -33,   46,   31,   33,   56,  -10,   18,  -63,
+      31,   45,   63,  -28,   30,  -19,   19,    8,    1,   19,   57,  -25,  -42,   58,   31,   -2,
+     -25,  -64,  -17,    9,  -63,   63,   22,    3,   48,   20,  -64,   41,  -64,  -38,  -40,   -9,
+      60,  -17,   11,   41,   49,  -19,  -59,   59,  -21,   49,   50,  -24,  -11,  -42,   61,   45,
+      29,   57,   19,  -58,  -19,   -9,   32,   46,   49,  -23,   16,   34,   -9,   46,  -50,   30
+};
+FLASH_RODATA const int32_t pw3_b[CONV_C] = {
+    -736, -587, -950, -337,  701,  542, -591,  737,
+    -509,  943,  671, -687, -339, -248, -941,  626
+};
+
+// fully connected, CONV_C -> CLASSES
+FLASH_RODATA const int8_t fc6_w[CLASSES * CONV_C] = {
+       2,   35,  -24,  -14,  -56,   30,  -37,  -55,  -29,   47,   16,   11,  -34,  -14,  -11,   53,
+       7,  -62,   52,    3,  -24,   60,   58,  -16,  -50,   60,   50,   58,  -60,  -34,   10,  -37,
+      23,   -3,  -20,   15,  -45,   54,  -59,  -44,  -60,  -27,  -63,  -28,  -10,   38,  -53,   60,
+      52,  -44,   16,   24,   11,   12,   -4,  -13,  -57,   42,   59,   10,  -13,  -54,   56,  -39,
+     -35,  -57,   32,   28,   15,   62,  -33,  -49,  -42,   11,   33,   45,   61,  -54,  -47,   51,
+      17,  -42,   29,   29,  -34,  -52,  -17,  -26,  -16,    8,  -13,  -53,  -45,   38,   23,  -56,
+     -46,    1,    5,   25,   -6,   54,   42,   58,   23,   33,   49,  -26,   53,  -34,    8,   26,
+      31,  -56,  -39,   18,  -30,   -4,   17,  -55,  -54,  -42,  -36,   -4,  -30,  -14,   37,   39
+};
+FLASH_RODATA const int32_t fc6_b[CLASSES] = {
+     309,  458,  448, -179,  255, -435,  418,   43
+};
+
+#endif  // NN_WEIGHTS_H_
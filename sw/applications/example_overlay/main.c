@@ -0,0 +1,150 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Calls the functions of two code overlays (overlay.h) in turn: a CRC-32 in
+// overlay 0 and a checksum in overlay 1, with their tables in their own
+// section. Set overlays: 2 in the linker_script of mcu_cfg.hjson and build
+// with LINKER=flash_load or flash_exec: each switch copies the overlay from
+// the flash into the window, and a call to the overlay already there copies
+// nothing. With the on_chip linker or without overlays, both are linked with
+// the rest of the code and the results are the same.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "dma.h"
+#include "soc_ctrl.h"
+#include "overlay.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define OVL_CRC         0
+#define OVL_SUM         1
+#define DATA_BYTES      256
+#define ROUNDS          3
+
+static uint8_t data[DATA_BYTES];
+
+// Overlay 0: CRC-32 (reflected, 0xEDB88320) with a 16-entry table
+__attribute__((section(".xheep_overlay0.rodata"))) static const uint32_t crc_nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+XHEEP_SECTION_OVERLAY(0) uint32_t ovl_crc32(const uint8_t *p, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ crc_nibble[crc & 0xF];
+        crc = (crc >> 4) ^ crc_nibble[crc & 0xF];
+    }
+    return ~crc;
+}
+
+// Overlay 1: Fletcher-32 over bytes
+XHEEP_SECTION_OVERLAY(1) uint32_t ovl_fletcher32(const uint8_t *p, uint32_t len)
+{
+    uint32_t a = 0xFFFF, b = 0xFFFF;
+    for (uint32_t i = 0; i < len; i++) {
+        a = (a + p[i]) % 0xFFFF;
+        b = (b + a) % 0xFFFF;
+    }
+    return (b << 16) | a;
+}
+
+// The same, resident, as references
+static uint32_t ref_crc32(const uint8_t *p, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t ref_fletcher32(const uint8_t *p, uint32_t len)
+{
+    uint64_t a = 0xFFFF, b = 0xFFFF;
+    for (uint32_t i = 0; i < len; i++) {
+        a += p[i];
+        b += a;
+    }
+    return (uint32_t)((b % 0xFFFF) << 16) | (uint32_t)(a % 0xFFFF);
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    uint32_t errors = 0;
+    uint32_t t0, t1, cycles_switch = 0, cycles_hit = 0;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (uint32_t i = 0; i < DATA_BYTES; i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    if (overlay_count() > 0) {
+        soc_ctrl_select_spi_memio(&soc_ctrl);
+    }
+    dma_init(NULL);
+
+    PRINTF("%u overlays, window of %u B\n\r", overlay_count(), overlay_window_size());
+
+    uint32_t crc = ref_crc32(data, DATA_BYTES);
+    uint32_t sum = ref_fletcher32(data, DATA_BYTES);
+
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        CSR_READ(CSR_REG_MCYCLE, &t0);
+        errors += OVERLAY_CALL(OVL_CRC, ovl_crc32, data, DATA_BYTES) != crc;
+        CSR_READ(CSR_REG_MCYCLE, &t1);
+        cycles_switch += t1 - t0;
+
+        // Already in the window, nothing is copied
+        CSR_READ(CSR_REG_MCYCLE, &t0);
+        errors += OVERLAY_CALL(OVL_CRC, ovl_crc32, data, DATA_BYTES) != crc;
+        CSR_READ(CSR_REG_MCYCLE, &t1);
+        cycles_hit += t1 - t0;
+
+        errors += OVERLAY_CALL(OVL_SUM, ovl_fletcher32, data, DATA_BYTES) != sum;
+        if (overlay_count() > 0 && overlay_resident() != OVL_SUM) {
+            errors++;
+        }
+    }
+
+    // An overlay that does not exist is refused, unless they are all linked with the code
+    if (overlay_count() > 0 && overlay_load(overlay_count())) {
+        errors++;
+    }
+
+    PRINTF("crc 0x%08x sum 0x%08x, %u cycles with a load, %u without\n\r", crc, sum,
+           cycles_switch / ROUNDS, cycles_hit / ROUNDS);
+
+    if (errors == 0) {
+        PRINTF("Overlay test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Overlay test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
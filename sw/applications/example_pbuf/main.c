@@ -0,0 +1,155 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Passes a packet of buffers from the DMA to the UART without copying it:
+// the DMA fills the buffers of the packet from a source frame, a header is
+// prepended in the headroom of its first buffer, and the buffered UART sends
+// it from the buffers (on uart0.log in simulation) while the application
+// keeps a reference to check it. The pool must then be full again.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_plic.h"
+#include "soc_ctrl.h"
+#include "uart.h"
+#include "uart_buffered.h"
+#include "uart_regs.h"  // Generated.
+#include "dma.h"
+#include "dma_memcpy.h"
+#include "pbuf.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifndef RV_PLIC_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_PLIC peripheral is not included" )
+#endif
+
+#define PBUFS_N     6
+#define PBUF_DATA_B 136     // Room for a DMA copy and the headroom
+#define HEADROOM_B  8
+#define FRAME_B     300     // Three buffers
+
+// The UART uses its own channel, the copies use DMA_MEMCPY_CH
+#define UART_DMA_CH ((DMA_CH_NUM > 1) ? DMA_MEMCPY_CH + 1 : UART_BUFFERED_NO_DMA)
+
+ALLOC_BUFFER(pbuf_region, PBUF_POOL_SIZE_B(PBUFS_N, PBUF_DATA_B), ".bss.pbuf_region");
+
+static pbuf_pool_t pool;
+static uart_buffered_t ub;
+static uint8_t frame[FRAME_B] __attribute__((aligned(4)));
+
+static const char header[HEADROOM_B] = "frame:\n\r";
+
+void handler_irq_uart(uint32_t id)
+{
+    uart_buffered_irq_handler(&ub, id);
+}
+
+// The DMA fills each buffer of the packet from the frame
+static void fill(pbuf_t *pkt)
+{
+    uint32_t offset = 0;
+    for (pbuf_t *pb = pkt; pb != NULL; pb = pb->next) {
+        dma_copy_wait(dma_memcpy_async(pb->payload, &frame[offset], pb->len));
+        offset += pb->len;
+    }
+}
+
+// Checks the packet against the header and the frame, reading it in pieces
+// that cross the buffers
+static int check(const pbuf_t *pkt)
+{
+    uint8_t piece[50];
+    int errors = pbuf_total_len(pkt) != HEADROOM_B + FRAME_B;
+
+    errors += pbuf_copy_out(pkt, 0, piece, HEADROOM_B) != HEADROOM_B;
+    errors += memcmp(piece, header, HEADROOM_B) != 0;
+    for (uint32_t offset = 0; offset < FRAME_B; offset += sizeof(piece)) {
+        uint32_t n = pbuf_copy_out(pkt, HEADROOM_B + offset, piece, sizeof(piece));
+        errors += n != ((FRAME_B - offset < sizeof(piece)) ? FRAME_B - offset : sizeof(piece));
+        errors += memcmp(piece, &frame[offset], n) != 0;
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    uart_t uart;
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    if (plic_Init() != kPlicOk) {
+        PRINTF("Init PLIC failed\n\r");
+        return EXIT_FAILURE;
+    }
+    dma_init(NULL);
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    // Set mie.MEIE bit to one to enable machine-level external interrupts
+    CSR_SET_BITS(CSR_REG_MIE, 1 << 11);
+
+    // Printable bytes, so that the UART log can be read
+    for (uint32_t i = 0; i < FRAME_B; i++) {
+        frame[i] = (i % 64 == 63) ? '\n' : 'a' + i % 26;
+    }
+
+    int errors = pbuf_pool_init(&pool, pbuf_region, sizeof(pbuf_region), PBUF_DATA_B, HEADROOM_B) != PBUFS_N;
+
+    // The UART has no TX ring, only packets are sent
+    uart_buffered_init(&ub, &uart, NULL, 0, NULL, 0, UART_DMA_CH);
+
+    pbuf_t *pkt = pbuf_alloc_chain(&pool, FRAME_B);
+    if (errors || pkt == NULL) {
+        PRINTF("Pool init failure\n\r");
+        return EXIT_FAILURE;
+    }
+    fill(pkt);
+    errors += !pbuf_header(pkt, HEADROOM_B);
+    memcpy(pkt->payload, header, HEADROOM_B);
+    // There is no room for another header
+    errors += pbuf_header(pkt, 1);
+
+    // The UART takes over one reference, the application keeps the other
+    pbuf_ref(pkt);
+    uart_buffered_write_pbuf(&ub, pkt);
+    errors += check(pkt);
+    uart_buffered_flush(&ub);
+    errors += uart_buffered_tx_pbufs(&ub) != 0;
+    errors += pkt->ref != 1;
+    pbuf_free(pkt);
+
+    // Every buffer went back to the pool, no copy was made on the way
+    errors += pbuf_pool_free_n(&pool) != PBUFS_N;
+
+    // The buffered driver is done, printf takes the UART back
+    uart_irq_set_enabled(&ub.uart, UART_INTR_ENABLE_RX_WATERMARK_BIT, false);
+
+    if (errors == 0) {
+        PRINTF("Packet buffers test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Packet buffers test failure: %d errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -21,8 +21,11 @@
 
 #include "core_v_mini_mcu.h"
 #include "x-heep.h"
-#include "pdm2pcm_regs.h"
+#include "csr.h"
+#include "dma.h"
 #include "mmio.h"
+#include "pdm2pcm.h"
+#include "reg_script.h"
 #include "groundtruth.h"
 
 #ifndef PDM2PCM_IS_INCLUDED
@@ -41,6 +44,20 @@
     #define PRINTF(...)
 #endif
 
+/* Passthrough filters: the first coefficient of each at 1. */
+static const pdm2pcm_cfg_t pdm2pcm_cfg = {
+    .clkdiv    = 15,
+    .decim_cic = 15,
+    .decim_hb1 = 31,
+    .decim_hb2 = 63,
+    .hb1       = { 1 },
+    .hb2       = { 1 },
+    .fir       = { 1 },
+};
+
+/* The configuration as a register script, for the DMA. */
+static pdm2pcm_cfg_script_t pdm2pcm_script;
+
 int main(int argc, char *argv[])
 {
 
@@ -48,70 +65,62 @@ int main(int argc, char *argv[])
     PRINTF("PDM2PCM DEMO\n\r");
     PRINTF(" > Start\n\r");
 
-    mmio_region_t pdm2pcm_base_addr = mmio_region_from_addr((uintptr_t)PDM2PCM_START_ADDRESS);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CLKDIVIDX_REG_OFFSET ,15);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_REACHCOUNT_REG_OFFSET, 1);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMCIC_REG_OFFSET, 15);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMHB1_REG_OFFSET, 31);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_DECIMHB2_REG_OFFSET, 63);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB1COEF00_REG_OFFSET, 1);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB1COEF01_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB1COEF02_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB1COEF03_REG_OFFSET, 0);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF00_REG_OFFSET, 1);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF01_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF02_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF03_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF04_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF05_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_HB2COEF06_REG_OFFSET, 0);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF00_REG_OFFSET, 1);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF01_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF02_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF03_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF04_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF05_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF06_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF07_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF08_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF09_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF10_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF11_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF12_REG_OFFSET, 0);
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_FIRCOEF13_REG_OFFSET, 0);
-
-    mmio_region_write32(pdm2pcm_base_addr, PDM2PCM_CONTROL_REG_OFFSET  , 1);
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    uint32_t cycles_cpu, cycles_dma;
+
+    /* The configuration written by the CPU, one register after the other */
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    if (pdm2pcm_load_config(&pdm2pcm_cfg) != kPdm2pcmOk) {
+        PRINTF("ERROR: wrong configuration.\n\r");
+        return EXIT_FAILURE;
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles_cpu);
+
+    /* The same configuration written again by the DMA in address mode, as a
+       register script, while the core sleeps */
+    dma_init(NULL);
+    if (pdm2pcm_config_script(&pdm2pcm_cfg, &pdm2pcm_script) != kPdm2pcmOk) {
+        PRINTF("ERROR: wrong configuration.\n\r");
+        return EXIT_FAILURE;
+    }
+    mmio_region_t pdm2pcm_regs = mmio_region_from_addr(PDM2PCM_START_ADDRESS);
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    if (reg_script_apply(0, pdm2pcm_regs, &pdm2pcm_script.script) != REG_SCRIPT_OK) {
+        PRINTF("ERROR: the DMA did not apply the configuration.\n\r");
+        return EXIT_FAILURE;
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles_dma);
+    for (size_t i = 0; i < pdm2pcm_script.script.count; i++) {
+        if (mmio_region_read32(pdm2pcm_regs, pdm2pcm_script.offsets[i]) != pdm2pcm_script.values[i]) {
+            PRINTF("ERROR: register 0x%x not written by the DMA.\n\r", (unsigned)pdm2pcm_script.offsets[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    PRINTF(" > %d registers: %u cycles by the CPU, %u by the DMA\n\r",
+           (int)pdm2pcm_script.script.count, (unsigned)cycles_cpu, (unsigned)cycles_dma);
+    pdm2pcm_set_watermark(1);
+    pdm2pcm_start();
 
     int const COUNT = 5;
 
     int count = 0;
-    int finish = 0;
     int fed = 0;
 
-    while(finish == 0) {
-        uint32_t status = mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_STATUS_REG_OFFSET);
-        if (!(status & 1)) {
-            int32_t read = mmio_region_read32(pdm2pcm_base_addr, PDM2PCM_RXDATA_REG_OFFSET);
-            if (fed == 1 || read != 0) {
-                fed = 1;
-                if(pdm2pcm_groundtruth[count] != (int)read) {
-                    PRINTF("ERROR: at index %d. read != groundtruth (resp. %d != %d).\n\r",count,(int)read,pdm2pcm_groundtruth[count]);
-                    return EXIT_FAILURE;
-                }
-                ++count;
-                if (count >= COUNT) {
-                    finish = 1;
-                    PRINTF("SUCCESS: Readings correspond to ground truth.\n\r");
-                }
+    while(count < COUNT) {
+        uint32_t read;
+        pdm2pcm_read(&read, 1);
+        if (fed == 1 || read != 0) {
+            fed = 1;
+            if(pdm2pcm_groundtruth[count] != (int)read) {
+                PRINTF("ERROR: at index %d. read != groundtruth (resp. %d != %d).\n\r",count,(int)read,pdm2pcm_groundtruth[count]);
+                pdm2pcm_stop();
+                return EXIT_FAILURE;
             }
+            ++count;
         }
     }
+    pdm2pcm_stop();
+    PRINTF("SUCCESS: Readings correspond to ground truth.\n\r");
     return EXIT_SUCCESS;
 
 }
-
@@ -0,0 +1,164 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the cost of the power transitions of each domain for several
+// settings of the power manager counters, in clock cycles:
+// - the CPU: the always-on rv_timer counts the cycles while the core is off
+//   and wakes it up, the wake-up latency is the time from the timer interrupt
+//   to the return of power_gate_core(), including the restore of the context,
+// - the peripheral domain and a free RAM bank: mcycle around the off and on
+//   sequences, which the core runs.
+// The testbench logs the hardware side of the same transitions, each edge of
+// the switch, isolation and reset signals and the entry and exit latencies,
+// in power_monitor.log (tb/power_monitor.sv).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer.h"
+#include "power_manager.h"
+#include "ram_banks.h"
+#include "x-heep.h"
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// cycles the core stays off
+#define SLEEP_CYCLES    2000
+
+static rv_timer_t timer_0_1;
+static power_manager_t power_manager;
+
+// Delays of the sequences, in cycles, scaled by each setting: first the
+// isolation, then the reset, then the switch to turn off, the reverse to turn on
+#define ISO_OFF     1
+#define RESET_OFF   (ISO_OFF + 1)
+#define SWITCH_OFF  (RESET_OFF + 1)
+#define SWITCH_ON   1
+#define RESET_ON    (SWITCH_ON + 1)
+#define ISO_ON      (RESET_ON + 1)
+#define RETENTIVE   1
+
+static const uint32_t scales[] = {1, 4, 16, 64};
+#define N_SCALES (sizeof(scales) / sizeof(scales[0]))
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static void init_counters(power_manager_counters_t *counters, uint32_t scale)
+{
+    power_gate_counters_init(counters, RESET_OFF * scale, RESET_ON * scale, SWITCH_OFF * scale, SWITCH_ON * scale,
+                             ISO_OFF * scale, ISO_ON * scale, RETENTIVE * scale, RETENTIVE * scale);
+}
+
+static uint64_t timer_now(void)
+{
+    uint64_t now;
+    rv_timer_counter_read(&timer_0_1, 0, &now);
+    return now;
+}
+
+static int measure_core(power_manager_counters_t *counters, uint32_t *total, uint32_t *wakeup)
+{
+    uint64_t start, fire, end;
+
+    start = timer_now();
+    fire = start + SLEEP_CYCLES;
+    rv_timer_arm(&timer_0_1, 0, 0, fire);
+    rv_timer_irq_enable(&timer_0_1, 0, 0, kRvTimerEnabled);
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    if (power_gate_core(&power_manager, kTimer_0_pm_e, counters) != kPowerManagerOk_e)
+        return -1;
+    end = timer_now();
+
+    rv_timer_irq_enable(&timer_0_1, 0, 0, kRvTimerDisabled);
+    rv_timer_irq_clear(&timer_0_1, 0, 0);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    *total = (uint32_t)(end - start);
+    *wakeup = (uint32_t)(end - fire);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    power_manager_counters_t counters;
+    uint32_t total, wakeup, off, on;
+    int ram_bank = -1;
+
+    // Setup power_manager
+    mmio_region_t power_manager_reg = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+    power_manager.base_addr = power_manager_reg;
+
+    // The always-on rv_timer counts the clock cycles: one tick per cycle
+    mmio_region_t timer_0_1_reg = mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS);
+    rv_timer_init(timer_0_1_reg, (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_set_tick_params(&timer_0_1, 0, (rv_timer_tick_params_t){.prescale = 0, .tick_step = 1});
+    rv_timer_counter_set_enabled(&timer_0_1, 0, kRvTimerEnabled);
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // a bank that holds nothing of the program
+    for (int i = MEMORY_BANKS - 1; i >= 0; i--)
+    {
+        if (ram_banks_unused() & (1u << i))
+        {
+            ram_bank = i;
+            break;
+        }
+    }
+
+    PRINTF("domain scale: off on [cycles], the core sleeps %u\n\r", SLEEP_CYCLES);
+
+    for (int s = 0; s < N_SCALES; s++)
+    {
+        init_counters(&counters, scales[s]);
+
+        if (measure_core(&counters, &total, &wakeup) != 0)
+        {
+            PRINTF("Error: power manager fail.\n\r");
+            return EXIT_FAILURE;
+        }
+        // the entry is not visible from the core, see power_monitor.log
+        PRINTF("core %u: - %u, %u in total\n\r", scales[s], wakeup, total);
+
+        TIME(power_gate_periph(&power_manager, kOff_e, &counters); while(!periph_power_domain_is_off(&power_manager)));
+        off = cycles;
+        TIME(power_gate_periph(&power_manager, kOn_e, &counters); while(periph_power_domain_is_off(&power_manager)));
+        on = cycles;
+        PRINTF("periph %u: %u %u\n\r", scales[s], off, on);
+
+        if (ram_bank >= 0)
+        {
+            TIME(power_gate_ram_block(&power_manager, ram_bank, kOff_e, &counters); while(!ram_block_power_domain_is_off(&power_manager, ram_bank)));
+            off = cycles;
+            TIME(power_gate_ram_block(&power_manager, ram_bank, kOn_e, &counters); while(ram_block_power_domain_is_off(&power_manager, ram_bank)));
+            on = cycles;
+            PRINTF("ram%d %u: %u %u\n\r", ram_bank, scales[s], off, on);
+
+            TIME(power_gate_ram_block(&power_manager, ram_bank, kRetOn_e, &counters));
+            off = cycles;
+            TIME(power_gate_ram_block(&power_manager, ram_bank, kRetOff_e, &counters));
+            on = cycles;
+            PRINTF("ram%d retention %u: %u %u\n\r", ram_bank, scales[s], off, on);
+        }
+    }
+
+    /* write something to stdout */
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Idles for periods of increasing length with the idle power policy and checks
+// that it enters the deepest state worth entering for each of them and that,
+// once the wake-up latency of a state has been measured, the core is running
+// again by the end of the period. The residency counters of the power manager
+// check that the core and the peripheral domain were really gated.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer.h"
+#include "soc_ctrl.h"
+#include "power_manager.h"
+#include "power_policy.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// ticks of the timer spent outside of the sleep by the calls of the test
+#define DEADLINE_SLACK  2
+
+static rv_timer_t timer_0_1;
+static const uint64_t kTickFreqHz = 1000 * 1000; // 1 MHz
+static power_manager_t power_manager;
+static power_policy_t policy;
+
+static const char *state_names[kPowerPolicyNumStates_e] = {
+    "wfi", "clock gating", "core gating", "core and periph gating"
+};
+
+// idle periods in us, and the state expected for each of them
+static const uint32_t idle_periods[] = {4, 40, 400, 2000};
+static const power_policy_state_t expected[] = {
+    kPowerPolicyWfi_e, kPowerPolicyClkGate_e, kPowerPolicyCoreGate_e, kPowerPolicyPeriphGate_e
+};
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    power_policy_cfg_t cfg;
+
+    // Setup power_manager
+    power_manager.base_addr = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+
+    // Get current Frequency
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    uint32_t freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    // Setup the always-on rv_timer, timer 0 is the time base of the policy
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS), (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_tick_params_t tick_params;
+    rv_timer_approximate_tick_params(freq_hz, kTickFreqHz, &tick_params);
+    rv_timer_set_tick_params(&timer_0_1, 0, tick_params);
+    rv_timer_counter_set_enabled(&timer_0_1, 0, kRvTimerEnabled);
+
+    cfg.power_manager = &power_manager;
+    cfg.timer = &timer_0_1;
+    // same sequences as example_power_gating_core and example_power_gating_periph
+    power_gate_counters_init(&cfg.cpu_counters, 15, 30, 20, 10, 10, 35, 0, 0);
+    power_gate_counters_init(&cfg.periph_counters, 30, 30, 30, 30, 30, 30, 0, 0);
+    // break-even times and first latency estimates in us, these depend on the
+    // technology and are only examples here
+    cfg.states[kPowerPolicyWfi_e]        = (power_policy_state_cfg_t){.break_even = 0,    .latency = 1};
+    cfg.states[kPowerPolicyClkGate_e]    = (power_policy_state_cfg_t){.break_even = 10,   .latency = 1};
+    cfg.states[kPowerPolicyCoreGate_e]   = (power_policy_state_cfg_t){.break_even = 200,  .latency = 10};
+    cfg.states[kPowerPolicyPeriphGate_e] = (power_policy_state_cfg_t){.break_even = 1000, .latency = 20};
+    cfg.allowed = POWER_POLICY_STATE_MASK(kPowerPolicyClkGate_e) | POWER_POLICY_STATE_MASK(kPowerPolicyCoreGate_e) |
+                  POWER_POLICY_STATE_MASK(kPowerPolicyPeriphGate_e);
+    cfg.periph_restore = NULL;
+
+    if (power_policy_init(&policy, &cfg) != kPowerManagerOk_e)
+    {
+        PRINTF("Error: power policy fail.\n\r");
+        return EXIT_FAILURE;
+    }
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    residency_counters_clear(&power_manager);
+    residency_counters_enable(&power_manager, 1);
+
+    // the first pass measures the latencies, the second one checks the deadlines
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < sizeof(idle_periods) / sizeof(idle_periods[0]); i++)
+        {
+            uint64_t start, end;
+            power_policy_state_t state;
+
+            rv_timer_counter_read(&timer_0_1, 0, &start);
+            state = power_policy_idle(&policy, idle_periods[i]);
+            rv_timer_counter_read(&timer_0_1, 0, &end);
+
+            PRINTF("%u us: %s, %u us, latency %u us\n\r", idle_periods[i], state_names[state],
+                   (uint32_t)(end - start), power_policy_latency(&policy, state));
+
+            if (state != expected[i])
+                errors++;
+            if (pass == 1 && end - start > idle_periods[i] + DEADLINE_SLACK)
+                errors++;
+        }
+    }
+
+    for (int s = 0; s < kPowerPolicyNumStates_e; s++)
+    {
+        const power_policy_stats_t *stats = power_policy_get_stats(&policy, s);
+        PRINTF("%s: %u entries, %u early, %u us\n\r", state_names[s], stats->entries, stats->early_wakeups, (uint32_t)stats->ticks);
+    }
+
+    residency_counters_enable(&power_manager, 0);
+    power_manager_residency_t cpu = residency_core(&power_manager);
+    power_manager_residency_t periph = residency_periph(&power_manager);
+
+    PRINTF("cpu cycles: %u active, %u clock-gated, %u power-gated\n\r", cpu.cycles[kResidencyActive_e],
+           cpu.cycles[kResidencyClkGate_e], cpu.cycles[kResidencyPowerGate_e]);
+    PRINTF("periph cycles: %u active, %u clock-gated, %u power-gated\n\r", periph.cycles[kResidencyActive_e],
+           periph.cycles[kResidencyClkGate_e], periph.cycles[kResidencyPowerGate_e]);
+
+    // every state was entered, each must have left cycles in the counters
+    if (cpu.cycles[kResidencyActive_e] == 0 || cpu.cycles[kResidencyClkGate_e] == 0 || cpu.cycles[kResidencyPowerGate_e] == 0)
+        errors++;
+    if (periph.cycles[kResidencyClkGate_e] == 0 || periph.cycles[kResidencyPowerGate_e] == 0)
+        errors++;
+
+    if (errors)
+    {
+        PRINTF("Error: %u wrong states, missed deadlines or empty residencies.\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+    /* write something to stdout */
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
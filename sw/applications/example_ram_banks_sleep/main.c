@@ -0,0 +1,105 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Prints the RAM banks holding each part of the program, then switches off
+// the banks it does not use and puts in retention the ones that only hold a
+// buffer of the heap, and powers them on again.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "power_manager.h"
+#include "ram_banks.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define BUF_LEN 256
+
+static power_manager_t power_manager;
+
+int main(int argc, char *argv[])
+{
+    power_manager_counters_t power_manager_ram_blocks_counters;
+    ram_banks_usage_t usage;
+    ram_banks_sleep_t sleep;
+    uint32_t *buf;
+
+    // Setup power_manager
+    mmio_region_t power_manager_reg = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+    power_manager.base_addr = power_manager_reg;
+
+    // Init ram blocks' counters, for both the switch and the retention
+    if (power_gate_counters_init(&power_manager_ram_blocks_counters, 30, 30, 30, 30, 30, 30, 30, 30) != kPowerManagerOk_e)
+    {
+        PRINTF("Error: power manager fail. Check the reset and powergate counters value\n\r");
+        return EXIT_FAILURE;
+    }
+
+    buf = malloc(BUF_LEN * sizeof(uint32_t));
+    if (buf == NULL)
+    {
+        PRINTF("Error: malloc fail.\n\r");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < BUF_LEN; i++) buf[i] = i;
+
+    ram_banks_get_usage(&usage);
+    PRINTF("banks: code %x, data %x, heap %x, arena %x, stack %x, interleaved %x, fast %x, unused %x\n\r",
+           usage.code, usage.data, usage.heap, usage.arena, usage.stack, usage.interleaved, usage.fast, ram_banks_unused());
+
+    // The buffer is not accessed until the banks are on again
+    if (ram_banks_sleep(&power_manager, ram_banks_holding(buf, BUF_LEN * sizeof(uint32_t)), &power_manager_ram_blocks_counters, &sleep) != kPowerManagerOk_e)
+    {
+        PRINTF("Error: power manager fail.\n\r");
+        return EXIT_FAILURE;
+    }
+
+    // Check that the unused banks are actually OFF
+    for (int i = 0; i < MEMORY_BANKS; i++)
+    {
+        if ((sleep.off & (1u << i)) && !ram_block_power_domain_is_off(&power_manager, i))
+        {
+            PRINTF("Error: bank %d is on.\n\r", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Wait some time
+    for (int i=0; i<100; i++) asm volatile("nop");
+
+    if (ram_banks_wake(&power_manager, &power_manager_ram_blocks_counters, &sleep) != kPowerManagerOk_e)
+    {
+        PRINTF("Error: power manager fail.\n\r");
+        return EXIT_FAILURE;
+    }
+
+    PRINTF("banks off %x, retained %x\n\r", sleep.off, sleep.retained);
+
+    // The retained buffer kept its content
+    for (int i = 0; i < BUF_LEN; i++)
+    {
+        if (buf[i] != i)
+        {
+            PRINTF("Error: the buffer is lost.\n\r");
+            return EXIT_FAILURE;
+        }
+    }
+    free(buf);
+
+    /* write something to stdout */
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
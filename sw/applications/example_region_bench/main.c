@@ -0,0 +1,314 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Latency and bandwidth of each region of the address space, for the CPU and
+// the DMA, to guide the placement of the data (bank_sections.h) and the
+// choice of the linker script. The regions are:
+// - bank<n>: a buffer in each contiguous RAM bank (XHEEP_SECTION_BANK);
+// - interleaved: a buffer in the interleaved banks, with MEMORY_BANKS_IL and
+//   LINKER=on_chip;
+// - tcm: the scratchpad of the core, the CPU only;
+// - ao_periph: a register of the always-on peripherals (SOC_CTRL EXIT_VALID);
+// - periph: a register of the peripheral subsystem (GPIO INFO);
+// - flash: the flash through the SPI MEMIO, with its read cache disabled, and
+//   flash_cached with it enabled when FLASH_CACHE_WAYS > 0;
+// - slow_memory: the slow memory of the testbench (XHEEP_SECTION_EXT), with
+//   the dcache disabled, in simulation only.
+// Each region prints a line
+//   REGION_BENCH,<region>,<cpu chase>,<cpu seq>,<cpu stride>,<dma word>,<dma seq>,<dma stride>
+// with:
+// - chase: the cycles per load x100 of a chain of dependent loads, each
+//   index read giving the next one (the index arithmetic, an and, a shift
+//   and an add, is the same in all the regions);
+// - seq and stride: the read bandwidth in bytes per cycle x100 of the words
+//   in order and with a stride of BENCH_STRIDE words, by the CPU (loads) and
+//   by the DMA (copy to a RAM buffer);
+// - dma word: the cycles of the copy of a single word, from the launch to the
+//   end of the transaction.
+// The registers are a single word: their chase reads it again and again, and
+// so do their CPU reads and DMA copies. The columns a master cannot measure
+// are 0.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bank_sections.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "gpio_regs.h"
+#include "soc_ctrl.h"
+#include "soc_ctrl_regs.h"
+#include "spi_memio.h"
+#include "x-heep.h"
+
+#define BENCH_WORDS     128     // Words of each buffer, the size of the slow memory
+#define BENCH_STRIDE    4       // Words between the reads of the strided pass
+#define BENCH_CHASE     256     // Loads of the chain
+#define BENCH_STEP      37      // Words between two links of the chain, odd to visit all the words
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// What a region is and who reaches it
+#define REGION_RAM      0x1     // Writable buffer of BENCH_WORDS words, else a single register or read-only words
+#define REGION_DMA      0x2     // The DMA reaches it
+#define REGION_CACHED   0x4     // With the read cache of the flash
+
+typedef struct {
+    const char *name;
+    volatile uint32_t *base;
+    uint32_t words;
+    uint32_t flags;
+} bench_region_t;
+
+#define BENCH_BANK( n )   static uint32_t bench_bank##n[BENCH_WORDS] XHEEP_SECTION_BANK(n)
+
+BENCH_BANK(0);
+BENCH_BANK(1);
+#if MEMORY_BANKS_CONT > 2
+BENCH_BANK(2);
+#endif
+#if MEMORY_BANKS_CONT > 3
+BENCH_BANK(3);
+#endif
+#if MEMORY_BANKS_CONT > 4
+BENCH_BANK(4);
+#endif
+#if MEMORY_BANKS_CONT > 5
+BENCH_BANK(5);
+#endif
+#if MEMORY_BANKS_CONT > 6
+BENCH_BANK(6);
+#endif
+#if MEMORY_BANKS_CONT > 7
+BENCH_BANK(7);
+#endif
+#if MEMORY_BANKS_IL > 0
+static uint32_t bench_il[BENCH_WORDS] XHEEP_SECTION_INTERLEAVED;
+#endif
+#if TCM_SIZE > 0
+static uint32_t bench_tcm[BENCH_WORDS] XHEEP_SECTION_TCM;
+#endif
+#if TARGET_SIM && defined(SLOW_MEMORY_START_ADDRESS)
+static uint32_t bench_slow[BENCH_WORDS] XHEEP_SECTION_EXT(slow_memory);
+#endif
+
+static uint32_t bench_dst[BENCH_WORDS];
+
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+static volatile uint32_t sum;
+
+static const bench_region_t regions[] = {
+    { "bank0", bench_bank0, BENCH_WORDS, REGION_RAM | REGION_DMA },
+    { "bank1", bench_bank1, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#if MEMORY_BANKS_CONT > 2
+    { "bank2", bench_bank2, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_CONT > 3
+    { "bank3", bench_bank3, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_CONT > 4
+    { "bank4", bench_bank4, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_CONT > 5
+    { "bank5", bench_bank5, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_CONT > 6
+    { "bank6", bench_bank6, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_CONT > 7
+    { "bank7", bench_bank7, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if MEMORY_BANKS_IL > 0
+    { "interleaved", bench_il, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+#if TCM_SIZE > 0
+    { "tcm", bench_tcm, BENCH_WORDS, REGION_RAM },
+#endif
+    { "ao_periph", (volatile uint32_t *)(SOC_CTRL_START_ADDRESS + SOC_CTRL_EXIT_VALID_REG_OFFSET), 1, REGION_DMA },
+#ifdef GPIO_IS_INCLUDED
+    { "periph", (volatile uint32_t *)(GPIO_START_ADDRESS + GPIO_INFO_REG_OFFSET), 1, REGION_DMA },
+#endif
+    { "flash", (volatile uint32_t *)FLASH_MEM_START_ADDRESS, BENCH_WORDS, REGION_DMA },
+#if FLASH_CACHE_WAYS > 0
+    { "flash_cached", (volatile uint32_t *)FLASH_MEM_START_ADDRESS, BENCH_WORDS, REGION_DMA | REGION_CACHED },
+#endif
+#if TARGET_SIM && defined(SLOW_MEMORY_START_ADDRESS)
+    { "slow_memory", bench_slow, BENCH_WORDS, REGION_RAM | REGION_DMA },
+#endif
+};
+
+#define BENCH_REGIONS   (sizeof(regions) / sizeof(regions[0]))
+
+// Follows the chain of indices from 0, unrolled to keep the loop out of the
+// cycles per load
+static uint32_t __attribute__ ((noinline)) bench_chase(const volatile uint32_t *base, uint32_t mask)
+{
+    uint32_t i = 0;
+
+    for (uint32_t k = 0; k < BENCH_CHASE; k += 4) {
+        i = base[i & mask];
+        i = base[i & mask];
+        i = base[i & mask];
+        i = base[i & mask];
+    }
+    return i;
+}
+
+// Reads the words in passes of step words, each pass from the next word:
+// step 1 reads them in order, step BENCH_STRIDE with a stride, step 0 reads
+// the first word again and again
+static void __attribute__ ((noinline)) bench_read(const volatile uint32_t *base, uint32_t step, uint32_t passes)
+{
+    uint32_t acc = 0;
+
+    for (uint32_t o = 0; o < passes; o++) {
+        const volatile uint32_t *p = base + (step ? o : 0);
+        for (uint32_t k = 0; k < BENCH_WORDS / passes; k += 4) {
+            acc += p[0];
+            acc += p[step];
+            acc += p[2 * step];
+            acc += p[3 * step];
+            p += 4 * step;
+        }
+    }
+    sum = acc;
+}
+
+// Cycles of a copy of words words to bench_dst, reading every inc words
+static uint32_t bench_dma(const bench_region_t *r, uint32_t words, uint32_t inc)
+{
+    uint32_t start, end;
+
+    tgt_src.ptr     = (uint8_t *)r->base;
+    tgt_src.inc_du  = r->words > 1 ? inc : 0;
+    tgt_src.size_du = words;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.ptr     = (uint8_t *)bench_dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    dma_launch(&trans);
+    while (!dma_is_ready(0));
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    return end - start;
+}
+
+// Bytes per cycle x100
+static uint32_t bench_bw(uint32_t bytes, uint32_t cycles)
+{
+    return cycles ? (100 * bytes) / cycles : 0;
+}
+
+// Measures a region, returns the errors of its chain and copies
+static uint32_t bench_region(const bench_region_t *r)
+{
+    uint32_t start, end;
+    uint32_t chase, seq, stride;
+    uint32_t dma_word = 0, dma_seq = 0, dma_stride = 0;
+    uint32_t mask = r->flags & REGION_RAM ? BENCH_WORDS - 1 : 0;
+    uint32_t step = r->words > 1 ? 1 : 0;
+    uint32_t errors = 0;
+    uint32_t i;
+
+    if (r->flags & REGION_RAM) {
+        for (uint32_t k = 0; k < BENCH_WORDS; k++) {
+            r->base[k] = (k + BENCH_STEP) & mask;
+        }
+    }
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    i = bench_chase(r->base, mask);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    chase = (100 * (end - start)) / BENCH_CHASE;
+    if ((r->flags & REGION_RAM) && i != ((BENCH_CHASE * BENCH_STEP) & mask)) {
+        errors++;
+    }
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    bench_read(r->base, step, 1);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    seq = bench_bw(BENCH_WORDS * 4, end - start);
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    bench_read(r->base, step * BENCH_STRIDE, BENCH_STRIDE);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    stride = bench_bw(BENCH_WORDS * 4, end - start);
+
+    if (r->flags & REGION_DMA) {
+        dma_word   = bench_dma(r, 1, 1);
+        dma_stride = bench_bw(BENCH_WORDS / BENCH_STRIDE * 4, bench_dma(r, BENCH_WORDS / BENCH_STRIDE, BENCH_STRIDE));
+        dma_seq    = bench_bw(BENCH_WORDS * 4, bench_dma(r, BENCH_WORDS, 1));
+        if (r->flags & REGION_RAM) {
+            for (uint32_t k = 0; k < BENCH_WORDS; k++) {
+                if (bench_dst[k] != r->base[k]) errors++;
+            }
+        }
+    }
+
+    PRINTF("REGION_BENCH,%s,%u,%u,%u,%u,%u,%u\n\r", r->name, chase, seq, stride, dma_word, dma_seq, dma_stride);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    uint32_t errors = 0;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    soc_ctrl_select_spi_memio(&soc_ctrl);
+#if DCACHE_WAYS > 0
+    soc_ctrl_dcache_enable(&soc_ctrl, false);
+#endif
+#if FLASH_CACHE_WAYS > 0
+    spi_memio_t spi_memio = { .base_addr = mmio_region_from_addr((uintptr_t)SPI_MEMIO_START_ADDRESS) };
+#endif
+
+    dma_init(NULL);
+
+    PRINTF("REGION_BENCH,region,cpu_chase_x100,cpu_seq_x100,cpu_stride_x100,dma_word,dma_seq_x100,dma_stride_x100\n\r");
+    for (uint32_t n = 0; n < BENCH_REGIONS; n++) {
+#if FLASH_CACHE_WAYS > 0
+        if (regions[n].base == (volatile uint32_t *)FLASH_MEM_START_ADDRESS) {
+            bool cached = regions[n].flags & REGION_CACHED;
+            spi_memio_cache_enable(&spi_memio, cached, cached);
+        }
+#endif
+        errors += bench_region(&regions[n]);
+    }
+
+    if (errors == 0) {
+        PRINTF("Region benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Region benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,140 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Passes words through two rings without masking the interrupts: a fast
+// interrupt (timer 1, raised by its INTR_TEST register) pushes into one ring,
+// the main loop pushes into the other, then fills the segments of the first
+// one in place with the DMA, and drains both with ring_pop_any.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "rv_timer.h"
+#include "rv_timer_regs.h"  // Generated.
+#include "dma_memcpy.h"
+#include "ring.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define RUNS_N      64
+#define RING_SIZE   64
+#define ISR_TAG     0x80000000
+
+// The INTR_TEST register of the hart 1 of the AO timer
+#define TIMER_1_INTR_TEST \
+    ((volatile uint32_t *)(RV_TIMER_AO_START_ADDRESS + RV_TIMER_INTR_TEST0_REG_OFFSET + 0x100))
+
+#define RING_ISR    0
+#define RING_MAIN   1
+
+static rv_timer_t timer_0_1;
+static uint8_t ring_bufs[2][RING_SIZE] __attribute__((aligned(4)));
+static ring_t rings[2];
+static volatile uint32_t isr_runs;
+static uint32_t dma_src[RUNS_N];
+
+static void timer_1_handler(uint32_t id)
+{
+    rv_timer_irq_clear(&timer_0_1, 1, 0);
+    clear_fast_interrupt(kTimer_1_fic_e);
+
+    uint32_t word = ISR_TAG | isr_runs;
+    ring_push_all(&rings[RING_ISR], &word, sizeof(word));
+    isr_runs++;
+}
+
+// Drains the rings, checking that the words of each producer come in order
+static int drain(uint32_t *next, uint32_t *expected)
+{
+    int errors = 0;
+    uint32_t word;
+    int32_t r;
+
+    while ((r = ring_pop_any(rings, 2, next, &word, sizeof(word))) >= 0) {
+        errors += word != expected[r];
+        expected[r]++;
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t expected[2] = {ISR_TAG, 0};
+    uint32_t next = 0;
+    int errors = 0;
+
+    for (int i = 0; i < 2; i++) {
+        if (!ring_init(&rings[i], ring_bufs[i], RING_SIZE)) {
+            PRINTF("Ring init failure\n\r");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The counter of the timer stays disabled, only the test raises its interrupt
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+    rv_timer_irq_enable(&timer_0_1, 1, 0, kRvTimerEnabled);
+    irq_register(IRQ_SRC_FAST(kTimer_1_fic_e), timer_1_handler);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), true);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        *TIMER_1_INTR_TEST = 1;
+        while (!ring_push_all(&rings[RING_MAIN], &i, sizeof(i))) {
+            errors += drain(&next, expected);
+        }
+        // Drain every few words, so that the rings wrap around
+        if (i % 5 == 4) {
+            errors += drain(&next, expected);
+        }
+    }
+    while (isr_runs != RUNS_N) {
+    }
+    errors += drain(&next, expected);
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), false);
+
+    // The DMA fills the free segments of the ring, which never wrap around
+    for (uint32_t i = 0; i < RUNS_N; i++) {
+        dma_src[i] = ISR_TAG | (RUNS_N + i);
+    }
+    uint32_t copied = 0;
+    while (copied < sizeof(dma_src)) {
+        void *ptr;
+        uint32_t n = ring_reserve(&rings[RING_ISR], &ptr);
+        if (n > sizeof(dma_src) - copied) {
+            n = sizeof(dma_src) - copied;
+        }
+        if (n > 0) {
+            dma_memcpy(ptr, (uint8_t *)dma_src + copied, n);
+            ring_commit(&rings[RING_ISR], n);
+            copied += n;
+        }
+        errors += drain(&next, expected);
+    }
+
+    if (errors == 0 && expected[RING_ISR] == (ISR_TAG | 2 * RUNS_N) && expected[RING_MAIN] == RUNS_N) {
+        PRINTF("Ring test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Ring test failure: %d errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
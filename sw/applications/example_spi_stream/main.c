@@ -0,0 +1,163 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Reads the flash with the streaming transfers of spi_stream.h and checks
+// them against the read of the BSP:
+// - full duplex, in interrupt mode: the first word sends the read command
+//   and its address, the flash sends the data during the next words;
+// - in DMA mode, full duplex if there are two DMA channels, else the command
+//   as a TX only transfer that keeps the chip select, then a RX only one.
+// The transfers are longer than the FIFOs, so that they are topped up and
+// drained while the SPI clock runs.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "spi_stream.h"
+#include "w25q128jw.h"
+#include "x-heep.h"
+
+/* By default, PRINTFs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+    #define USE_SPI_FLASH
+#endif
+
+// Words read, more than the FIFOs hold
+#define WORDS_N 256
+// Flash address of the data
+#define FLASH_ADDR 0x0
+
+static spi_stream_t stream;
+
+static uint32_t expected[WORDS_N];
+// The command and its address, then don't care words
+static uint32_t tx[WORDS_N + 1];
+static uint32_t rx[WORDS_N + 1];
+
+void fic_irq_spi(void)
+{
+    spi_stream_irq_handler(&stream);
+}
+
+void fic_irq_spi_flash(void)
+{
+    spi_stream_irq_handler(&stream);
+}
+
+static uint32_t check(const uint32_t *data, const char *name)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < WORDS_N; i++) {
+        if (data[i] != expected[i]) {
+            PRINTF("%s: error at word %u, expected %x, got %x\n", name, i, expected[i], data[i]);
+            errors++;
+        }
+    }
+    PRINTF("%s: %s\n", name, errors == 0 ? "success" : "failure");
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    if ( get_spi_flash_mode(&soc_ctrl) == SOC_CTRL_SPI_FLASH_MODE_SPIMEMIO ) {
+        PRINTF("This application cannot work with the memory mapped SPI FLASH"
+            "module - do not use the FLASH_EXEC linker script for this application\n");
+        return EXIT_SUCCESS;
+    }
+
+    spi_host_t spi;
+    #ifndef USE_SPI_FLASH
+    spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_HOST_START_ADDRESS);
+    fast_intr_ctrl_fast_interrupt_t spi_irq = kSpi_fic_e;
+    #else
+    spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS);
+    fast_intr_ctrl_fast_interrupt_t spi_irq = kSpiFlash_fic_e;
+    #endif
+
+    // The clock, chip select and output of the host are set by the BSP
+    if (w25q128jw_init(spi) != FLASH_OK) return EXIT_FAILURE;
+    if (w25q128jw_read_standard(FLASH_ADDR, expected, sizeof(expected)) != FLASH_OK) return EXIT_FAILURE;
+
+    dma_init(NULL);
+    irq_set_enabled(IRQ_SRC_FAST(spi_irq), true);
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // Read Data, with the address MSB first after the command
+    const uint32_t addr = FLASH_ADDR;
+    tx[0] = 0x03 | ((addr >> 16) & 0xff) << 8 | ((addr >> 8) & 0xff) << 16 | (addr & 0xff) << 24;
+
+    uint32_t errors = 0;
+    spi_stream_cfg_t cfg = {
+        .mode         = kSpiStreamModeIntr,
+        .csid         = 0,
+        .speed        = kSpiSpeedStandard,
+        .tx_watermark = SPI_HOST_PARAM_TX_DEPTH / 2,
+        .rx_watermark = SPI_HOST_PARAM_RX_DEPTH / 2,
+        .cb           = NULL,
+    };
+
+    if (spi_stream_init(&stream, &spi, &cfg) != kSpiStreamOk
+        || spi_stream_transfer(&stream, tx, rx, WORDS_N + 1, false) != kSpiStreamOk) {
+        return EXIT_FAILURE;
+    }
+    spi_stream_wait(&stream);
+    errors += check(&rx[1], "full duplex, interrupts");
+
+    memset(rx, 0, sizeof(rx));
+    cfg.mode = kSpiStreamModeDma;
+    cfg.dma_tx_ch = 0;
+    cfg.dma_rx_ch = DMA_CH_NUM > 1 ? 1 : 0;
+    if (spi_stream_init(&stream, &spi, &cfg) != kSpiStreamOk) {
+        return EXIT_FAILURE;
+    }
+#if DMA_CH_NUM > 1
+    if (spi_stream_transfer(&stream, tx, rx, WORDS_N + 1, false) != kSpiStreamOk) {
+        return EXIT_FAILURE;
+    }
+    spi_stream_wait(&stream);
+    errors += check(&rx[1], "full duplex, DMA");
+#else
+    if (spi_stream_transfer(&stream, tx, NULL, 1, true) != kSpiStreamOk) {
+        return EXIT_FAILURE;
+    }
+    spi_stream_wait(&stream);
+    if (spi_stream_transfer(&stream, NULL, rx, WORDS_N, false) != kSpiStreamOk) {
+        return EXIT_FAILURE;
+    }
+    spi_stream_wait(&stream);
+    errors += check(rx, "TX then RX, DMA");
+#endif
+
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    irq_set_enabled(IRQ_SRC_FAST(spi_irq), false);
+
+    if (errors == 0) {
+        PRINTF("SPI stream test done\n");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("SPI stream test failure\n");
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,143 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Streams tiles through the IFFIFO of the testbench, the reference streaming
+// accelerator (it returns each word incremented by one), and measures how the
+// DMA overlaps the tiles: first each tile is pushed and pulled back before the
+// next one is submitted, then all the tiles are submitted at once. Set
+// OUT_INTERVAL in the IFFIFO of tb/testharness.sv to model a slower
+// accelerator. The overlap needs two DMA channels (num_channels in
+// mcu_cfg.hjson).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "dma.h"
+#include "iffifo.h"
+#include "stream_accel.h"
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// With a single channel the pushes and the pulls alternate, so a tile must fit
+// in the FIFO
+#if DMA_CH_NUM > 1
+#define TILE_LEN    64
+#define RX_CH       1
+#else
+#define TILE_LEN    IFFIFO_DEPTH
+#define RX_CH       0
+#endif
+#define N_TILES     8
+
+static uint32_t in[N_TILES][TILE_LEN]  __attribute__ ((aligned (4)));
+static uint32_t out[N_TILES][TILE_LEN] __attribute__ ((aligned (4)));
+
+static stream_accel_t accel;
+static stream_accel_tile_t tiles[N_TILES];
+
+static volatile uint32_t tile_order_errors = 0;
+static volatile uint32_t next_tile = 0;
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+// The tiles must complete in order
+static void tile_done(stream_accel_tile_t *tile)
+{
+    uint32_t idx = (uint32_t)(uintptr_t)tile->ctx;
+    if (idx != next_tile) {
+        tile_order_errors++;
+    }
+    next_tile = idx + 1;
+}
+
+static uint32_t check_and_clear(void)
+{
+    uint32_t errors = 0;
+    for (int t = 0; t < N_TILES; t++) {
+        for (int i = 0; i < TILE_LEN; i++) {
+            errors += out[t][i] != in[t][i] + 1;
+            out[t][i] = 0;
+        }
+    }
+    return errors;
+}
+
+static uint32_t submit(int t)
+{
+    tiles[t].ctx = (void *)(uintptr_t)t;
+    return stream_accel_submit(&accel, &tiles[t], in[t], TILE_LEN, out[t], TILE_LEN, tile_done) != kStreamAccelOk;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t serial, overlapped;
+    const stream_accel_cfg_t cfg = {
+        .in_addr  = IFFIFO_FIFO_IN_ADDRESS,
+        .out_addr = IFFIFO_FIFO_OUT_ADDRESS,
+        .in_slot  = DMA_TRIG_SLOT_EXT_TX,
+        .out_slot = DMA_TRIG_SLOT_EXT_RX,
+        .tx_ch    = 0,
+        .rx_ch    = RX_CH,
+    };
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    for (int t = 0; t < N_TILES; t++) {
+        for (int i = 0; i < TILE_LEN; i++) {
+            in[t][i] = t * TILE_LEN + i;
+        }
+    }
+
+    dma_init(NULL);
+    if (stream_accel_init(&accel, &cfg) != kStreamAccelOk) {
+        return EXIT_FAILURE;
+    }
+
+    PRINTF("%d tiles of %d words, %d DMA channels\n\r", N_TILES, TILE_LEN, DMA_CH_NUM);
+
+    // Serial: a tile is only submitted once the previous one is back
+    TIME(for (int t = 0; t < N_TILES; t++) { errors += submit(t); stream_accel_wait(&accel); });
+    serial = cycles;
+    errors += check_and_clear();
+
+    // Overlapped: the DMA pushes the next tiles while the results of the
+    // previous ones stream back
+    next_tile = 0;
+    TIME(for (int t = 0; t < N_TILES; t++) errors += submit(t); stream_accel_wait(&accel));
+    overlapped = cycles;
+    errors += check_and_clear();
+    errors += tile_order_errors;
+
+    PRINTF("serial: %u cycles, %u per tile\n\r", serial, serial / N_TILES);
+    PRINTF("overlapped: %u cycles, %u per tile\n\r", overlapped, overlapped / N_TILES);
+    if (overlapped < serial) {
+        PRINTF("overlap saves %u%% of the cycles\n\r", (serial - overlapped) * 100 / serial);
+    }
+
+    if (errors == 0) {
+        PRINTF("Stream accelerator test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Stream accelerator test failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,150 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Private scratchpad benchmark: the CPU updates the state of a control loop,
+// kept in the RAM next to a buffer the DMA is writing and in the scratchpad
+// of the core (tcm of mcu_cfg.hjson), alone and while the DMA copies. In the
+// RAM the loop waits for the bank taken by the DMA; in the scratchpad it
+// takes the same cycles with and without the DMA. Without scratchpad the
+// state stays in the RAM and both runs are alike.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bank_sections.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "x-heep.h"
+
+#define STATE_WORDS     64      // Words of the state of the loop
+#define LOOP_STEPS      8       // Updates of the whole state
+#define COPY_WORDS      1024    // Words copied by the DMA, to last longer than the loop
+
+/* The results are the output of the benchmark, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+// In the data bank, with the buffers of the DMA
+static uint32_t ram_state[STATE_WORDS];
+static uint32_t copy_src[COPY_WORDS];
+static uint32_t copy_dst[COPY_WORDS];
+
+static uint32_t tcm_state[STATE_WORDS] XHEEP_SECTION_TCM;
+
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+
+static void bench_dma_launch(void)
+{
+    tgt_src.env     = NULL;
+    tgt_src.ptr     = (uint8_t *)copy_src;
+    tgt_src.inc_du  = 1;
+    tgt_src.size_du = COPY_WORDS;
+    tgt_src.type    = DMA_DATA_TYPE_WORD;
+    tgt_src.trig    = DMA_TRIG_MEMORY;
+    tgt_dst.env     = NULL;
+    tgt_dst.ptr     = (uint8_t *)copy_dst;
+    tgt_dst.inc_du  = 1;
+    tgt_dst.type    = DMA_DATA_TYPE_WORD;
+    tgt_dst.trig    = DMA_TRIG_MEMORY;
+    trans.src       = &tgt_src;
+    trans.dst       = &tgt_dst;
+    trans.mode      = DMA_TRANS_MODE_SINGLE;
+    trans.win_du    = 0;
+    trans.end       = DMA_TRANS_END_POLLING;
+    trans.channel   = 0;
+    trans.size_d2   = 0;
+
+    dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY);
+    dma_load_transaction(&trans);
+    dma_launch(&trans);
+}
+
+// Runs the loop from a zeroed state, returns the cycles
+static uint32_t bench_loop(volatile uint32_t *state)
+{
+    uint32_t start, end;
+
+    for (uint32_t i = 0; i < STATE_WORDS; i++) {
+        state[i] = 0;
+    }
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    for (uint32_t s = 0; s < LOOP_STEPS; s++) {
+        for (uint32_t i = 0; i < STATE_WORDS; i++) {
+            state[i] = state[i] + i + 1;
+        }
+    }
+    CSR_READ(CSR_REG_MCYCLE, &end);
+
+    return end - start;
+}
+
+// Runs the loop alone and during a copy, returns the errors
+static uint32_t bench_run(const char *name, uint32_t *state)
+{
+    uint32_t alone, both;
+    uint32_t errors = 0;
+
+    alone = bench_loop(state);
+
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        copy_dst[i] = 0;
+    }
+    bench_dma_launch();
+    both = bench_loop(state);
+    while (!dma_is_ready(0));
+
+    for (uint32_t i = 0; i < STATE_WORDS; i++) {
+        if (state[i] != LOOP_STEPS * (i + 1)) errors++;
+    }
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        if (copy_dst[i] != copy_src[i]) errors++;
+    }
+
+    PRINTF("%s: loop %u cycles alone, %u with the DMA (+%u)%s\n\r", name, alone, both,
+           both > alone ? both - alone : 0, errors ? " ERROR" : "");
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+#if TCM_SIZE == 0
+    PRINTF("No scratchpad: the tcm state stays in the RAM\n\r");
+#else
+    PRINTF("Scratchpad of %u bytes at 0x%08x\n\r", TCM_SIZE, TCM_START_ADDRESS);
+#endif
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_init(NULL);
+
+    for (uint32_t i = 0; i < COPY_WORDS; i++) {
+        copy_src[i] = i * 3;
+    }
+
+    errors += bench_run("ram", ram_state);
+    errors += bench_run("tcm", tcm_state);
+
+    if (errors == 0) {
+        PRINTF("Scratchpad benchmark done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Scratchpad benchmark failure: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,128 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Runs a periodic and a one-shot software timer of the timekeeping service
+// while sleeping with nanosleep, and checks that they fired the expected
+// number of times, that the sleep lasted at least its duration and that
+// gettimeofday follows the counter. It also checks on a wheel of its own that
+// a periodic timer advanced late fires once and skips the periods missed.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer.h"
+#include "timekeeping.h"
+#include "timer_wheel.h"
+#include "x-heep.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define SLEEP_US    1000
+#define PERIOD_US   100
+#define ONESHOT_US  250
+#define LATE_US     ( 100000 * PERIOD_US + PERIOD_US / 2 )
+
+static rv_timer_t timer_0_1;
+static timekeeping_timer_t periodic, oneshot;
+static volatile uint32_t periodic_count, oneshot_count;
+static volatile uint64_t oneshot_at;
+static timer_wheel_t wheel;
+static timer_wheel_timer_t late;
+static uint32_t late_count;
+
+static void periodic_cb(timekeeping_timer_t *timer, void *ctx)
+{
+    periodic_count++;
+}
+
+static void oneshot_cb(timekeeping_timer_t *timer, void *ctx)
+{
+    oneshot_at = timekeeping_us();
+    oneshot_count++;
+}
+
+static void late_cb(timer_wheel_timer_t *timer, void *ctx)
+{
+    late_count++;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint64_t start, end;
+    struct timespec req = {.tv_sec = 0, .tv_nsec = SLEEP_US * 1000};
+    struct timeval tv;
+
+    // Setup the always-on rv_timer, the service takes its timer 1
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS), (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer_0_1);
+
+    if (timekeeping_init(&timer_0_1) != TIMEKEEPING_OK)
+    {
+        PRINTF("Error: timekeeping fail.\n\r");
+        return EXIT_FAILURE;
+    }
+
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    timekeeping_timer_init(&periodic, periodic_cb, NULL);
+    timekeeping_timer_init(&oneshot, oneshot_cb, NULL);
+
+    start = timekeeping_us();
+    timekeeping_timer_start(&periodic, PERIOD_US, PERIOD_US);
+    timekeeping_timer_start(&oneshot, ONESHOT_US, 0);
+
+    if (nanosleep(&req, NULL) != 0)
+        errors++;
+
+    end = timekeeping_us();
+    timekeeping_timer_stop(&periodic);
+
+    PRINTF("slept %u us, periodic %u, one-shot %u at %u us\n\r", (uint32_t)(end - start), periodic_count,
+           oneshot_count, (uint32_t)(oneshot_at - start));
+
+    if (end - start < SLEEP_US)
+        errors++;
+    // the first period may end right after the sleep
+    if (periodic_count < SLEEP_US / PERIOD_US - 1 || periodic_count > SLEEP_US / PERIOD_US)
+        errors++;
+    if (oneshot_count != 1 || oneshot_at - start < ONESHOT_US)
+        errors++;
+    if (timekeeping_timer_running(&periodic) || timekeeping_timer_running(&oneshot))
+        errors++;
+
+    if (gettimeofday(&tv, NULL) != 0 || (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec < end)
+        errors++;
+
+    // A single call long after the first expiry: the periods before it are skipped
+    timer_wheel_init(&wheel, 0);
+    timer_wheel_timer_init(&late, late_cb, NULL);
+    timer_wheel_add(&wheel, &late, PERIOD_US, PERIOD_US);
+    if (timer_wheel_advance(&wheel, LATE_US) != 1 || late_count != 1)
+        errors++;
+    if (timer_wheel_next(&wheel) != LATE_US - LATE_US % PERIOD_US + PERIOD_US)
+        errors++;
+
+    if (errors)
+    {
+        PRINTF("Error: %u wrong timers or sleeps.\n\r", errors);
+        return EXIT_FAILURE;
+    }
+
+    /* write something to stdout */
+    PRINTF("Success.\n\r");
+    return EXIT_SUCCESS;
+}
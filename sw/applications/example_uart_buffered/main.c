@@ -0,0 +1,128 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Sends telemetry lines through the buffered UART driver, first with the CPU
+// and then with a DMA channel, and compares the cycles spent in the write
+// calls with the polled uart_write. The lines are printed twice on the UART
+// (uart0.log in simulation), the results once at the end.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_plic.h"
+#include "soc_ctrl.h"
+#include "uart.h"
+#include "uart_buffered.h"
+#include "uart_regs.h"  // Generated.
+#include "dma.h"
+#include "x-heep.h"
+
+#define LINES_N     8
+#define TX_BUF_B    1024    // Holds all the lines, the writes never wait
+#define RX_BUF_B    64
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#ifndef RV_PLIC_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_PLIC peripheral is not included" )
+#endif
+
+static uint8_t tx_buf[TX_BUF_B];
+static uint8_t rx_buf[RX_BUF_B];
+static uart_buffered_t ub;
+
+static const char line[] = "telemetry: t=000123 x=+0.512 y=-1.024 z=+9.810\n\r";
+
+void handler_irq_uart(uint32_t id)
+{
+    uart_buffered_irq_handler(&ub, id);
+}
+
+static uint32_t cycles_read(void)
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    return cycles;
+}
+
+// Writes the lines through the buffered driver and returns the cycles spent in the calls
+static uint32_t send_buffered(uint8_t dma_ch, const uart_t *uart)
+{
+    uint32_t cycles = 0;
+
+    uart_buffered_init(&ub, uart, tx_buf, TX_BUF_B, rx_buf, RX_BUF_B, dma_ch);
+    for (uint32_t i = 0; i < LINES_N; i++) {
+        uint32_t start = cycles_read();
+        uart_buffered_write(&ub, (const uint8_t *)line, sizeof(line) - 1);
+        cycles += cycles_read() - start;
+    }
+    uart_buffered_flush(&ub);
+    return cycles;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    uart_t uart;
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    if (plic_Init() != kPlicOk) {
+        PRINTF("Init PLIC failed\n\r");
+        return EXIT_FAILURE;
+    }
+    dma_init(NULL);
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    // Set mie.MEIE bit to one to enable machine-level external interrupts
+    CSR_SET_BITS(CSR_REG_MIE, 1 << 11);
+
+    // The reference: the polled driver waits for every byte to be sent
+    uint32_t polled = 0;
+    uart_init(&uart);
+    for (uint32_t i = 0; i < LINES_N; i++) {
+        uint32_t start = cycles_read();
+        uart_write(&uart, (const uint8_t *)line, sizeof(line) - 1);
+        polled += cycles_read() - start;
+    }
+
+    uint32_t cpu = send_buffered(UART_BUFFERED_NO_DMA, &uart);
+    uint32_t dma = send_buffered(0, &uart);
+    uint8_t  dma_used = ub.dma_ch == 0;
+
+    // The buffered driver is done, printf takes the UART back
+    uart_irq_set_enabled(&ub.uart, UART_INTR_ENABLE_RX_WATERMARK_BIT, false);
+
+    PRINTF("%u lines of %u B, cycles in the writes:\n\r", LINES_N, sizeof(line) - 1);
+    PRINTF("polled %u, buffered cpu %u, buffered dma %u%s\n\r", polled, cpu, dma,
+           dma_used ? "" : " (fell back to the cpu)");
+
+    if (cpu < polled && dma < polled && dma_used) {
+        PRINTF("UART buffered test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("UART buffered test failure\n\r");
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Warm boot (soc_ctrl_warm_boot_arm in soc_ctrl.h). On the first run the
+// program arms the warm boot over its code and initial data, up to _edata,
+// then jumps to the boot rom with the interrupts disabled, as the core does
+// after a power cycle. The boot rom finds the program intact in the RAM and
+// starts it again at _start without loading it, from the flash with the
+// flash_load linker. The second run checks that it went through the warm
+// boot, with its data as at the start, and reports the cycles from the jump
+// to main. The time of the jump is kept in bank 1, which is neither loaded,
+// checked nor zeroed.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "x-heep.h"
+#include "csr.h"
+#include "soc_ctrl.h"
+#include "bank_sections.h"
+
+/* By default, printfs are activated for FPGA and disabled for simulation. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   0
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define DATA_PATTERN 0x600DB007
+
+extern void _start(void);
+extern char _edata[];
+
+// Initial data, checked by the boot rom
+static volatile uint32_t data_pattern = DATA_PATTERN;
+
+#if MEMORY_BANKS_CONT > 1
+// Retained across the warm boot: the time of the jump, and DATA_PATTERN
+// once the program jumped to the boot rom
+static volatile uint32_t jump_cycle XHEEP_SECTION_BANK(1);
+static volatile uint32_t jumped XHEEP_SECTION_BANK(1);
+#endif
+
+int main(int argc, char *argv[])
+{
+#if MEMORY_BANKS_CONT > 1
+    soc_ctrl_t soc_ctrl;
+    uint32_t cycle;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    if (!soc_ctrl_warm_boot_armed(&soc_ctrl)) {
+        if (jumped == DATA_PATTERN) {
+            // The boot rom disarmed it and booted as after a reset
+            jumped = 0;
+            PRINTF("Warm boot test failure: cold boot after the jump\n\r");
+            return EXIT_FAILURE;
+        }
+
+        // Armed before anything writes the data, the printfs included
+        soc_ctrl_warm_boot_arm(&soc_ctrl, (uintptr_t)_start, (uint32_t)((uintptr_t)_edata - RAM_START_ADDRESS));
+
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+        jumped = DATA_PATTERN;
+        CSR_READ(CSR_REG_MCYCLE, &cycle);
+        jump_cycle = cycle;
+        ((void (*)(void))BOOTROM_START_ADDRESS)();
+        return EXIT_FAILURE;
+    }
+
+    CSR_READ(CSR_REG_MCYCLE, &cycle);
+    soc_ctrl_warm_boot_disarm(&soc_ctrl);
+    jumped = 0;
+
+    PRINTF("Warm boot over %u B, %u cycles from the boot rom to main\n\r",
+           (unsigned)((uintptr_t)_edata - RAM_START_ADDRESS), cycle - jump_cycle);
+
+    if (data_pattern == DATA_PATTERN) {
+        PRINTF("Warm boot test done\n\r");
+        return EXIT_SUCCESS;
+    } else {
+        PRINTF("Warm boot test failure: data 0x%08x\n\r", data_pattern);
+        return EXIT_FAILURE;
+    }
+#else
+    #pragma message ( "this application can run only when MEMORY_BANKS_CONT > 1" )
+    return EXIT_SUCCESS;
+#endif
+}
@@ -0,0 +1,205 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Checks the custom instructions of xif_coproc, the template of a CORE-V-XIF
+// coprocessor, against their C references, then times an int8 and an int16
+// dot product with and without them. Needs a cv32e40x or cv32e40px and the
+// coprocessor in the testbench:
+//   make mcu-gen CPU=cv32e40px
+//   make verilator-sim FUSESOC_PARAM="--X_EXT=1 --X_COPROC=1"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "x-heep.h"
+#include "csr.h"
+#include "xif_coproc.h"
+
+/* The results are the output of the test, printfs are activated by default. */
+#define PRINTF_IN_FPGA  1
+#define PRINTF_IN_SIM   1
+
+#if TARGET_SIM && PRINTF_IN_SIM
+        #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#elif TARGET_PYNQ_Z2 && PRINTF_IN_FPGA
+    #define PRINTF(fmt, ...)    printf(fmt, ## __VA_ARGS__)
+#else
+    #define PRINTF(...)
+#endif
+
+#define LEN 256
+
+static int8_t a8[LEN] __attribute__ ((aligned (4)));
+static int8_t b8[LEN] __attribute__ ((aligned (4)));
+static int16_t a16[LEN] __attribute__ ((aligned (4)));
+static int16_t b16[LEN] __attribute__ ((aligned (4)));
+
+static uint32_t cycles;
+
+#define TIME(x) do { CSR_WRITE(CSR_REG_MCYCLE, 0); x; CSR_READ(CSR_REG_MCYCLE, &cycles); } while (0)
+
+static uint32_t ref_popcnt(uint32_t x)
+{
+    uint32_t n = 0;
+    for (; x; x &= x - 1) {
+        n++;
+    }
+    return n;
+}
+
+static uint32_t ref_clz(uint32_t x)
+{
+    uint32_t n = 0;
+    for (uint32_t m = 0x80000000; m && !(x & m); m >>= 1) {
+        n++;
+    }
+    return n;
+}
+
+static uint32_t ref_brev(uint32_t x)
+{
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) {
+        r |= ((x >> i) & 1) << (31 - i);
+    }
+    return r;
+}
+
+static uint32_t ref_bext(uint32_t x, uint32_t pos, uint32_t len)
+{
+    return (x >> pos) & (len == 32 ? 0xffffffff : (1u << len) - 1);
+}
+
+// The accumulator wraps around, as unsigned arithmetic
+static uint32_t ref_dot8(uint32_t a, uint32_t b)
+{
+    uint32_t s = 0;
+    for (int i = 0; i < 4; i++) {
+        s += (uint32_t)((int8_t)(a >> 8 * i) * (int8_t)(b >> 8 * i));
+    }
+    return s;
+}
+
+static uint32_t ref_dot16(uint32_t a, uint32_t b)
+{
+    return (uint32_t)((int16_t)a * (int16_t)b) + (uint32_t)((int16_t)(a >> 16) * (int16_t)(b >> 16));
+}
+
+// The kernels timed, in C and with the intrinsics
+static int32_t __attribute__ ((noinline)) dot8_c(const int8_t *a, const int8_t *b, int n)
+{
+    int32_t s = 0;
+    for (int i = 0; i < n; i++) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+static int32_t __attribute__ ((noinline)) dot8_cx(const int8_t *a, const int8_t *b, int n)
+{
+    const uint32_t *a4 = (const uint32_t *)a;
+    const uint32_t *b4 = (const uint32_t *)b;
+    int32_t s = cx_lmacz8(&a4[0], b4[0]);
+    for (int i = 1; i < n / 4; i++) {
+        s = cx_lmac8(&a4[i], b4[i]);
+    }
+    return s;
+}
+
+static int32_t __attribute__ ((noinline)) dot16_c(const int16_t *a, const int16_t *b, int n)
+{
+    int32_t s = 0;
+    for (int i = 0; i < n; i++) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+static int32_t __attribute__ ((noinline)) dot16_cx(const int16_t *a, const int16_t *b, int n)
+{
+    const uint32_t *a2 = (const uint32_t *)a;
+    const uint32_t *b2 = (const uint32_t *)b;
+    int32_t s = cx_macz16(a2[0], b2[0]);
+    for (int i = 1; i < n / 2; i++) {
+        s = cx_mac16(a2[i], b2[i]);
+    }
+    return s;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+    uint32_t x = 0x12345678;
+    uint32_t acc;
+    int32_t ref, res;
+
+    //enable mcycle csr
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // Bit manipulation, on pseudo-random words and the corner cases
+    for (int i = 0; i < 64; i++) {
+        uint32_t pos = x & 0x1f, len = ((x >> 8) & 0x1f) + 1;
+        x = i == 0 ? 0 : i == 1 ? 0xffffffff : x * 1664525 + 1013904223;
+        errors += cx_popcnt(x) != ref_popcnt(x);
+        errors += cx_clz(x) != ref_clz(x);
+        errors += cx_brev(x) != ref_brev(x);
+        errors += cx_bext(x, pos, len) != ref_bext(x, pos, len);
+    }
+    errors += cx_bext(0xdeadbeef, 0, 32) != 0xdeadbeef;
+    errors += cx_bext(0xdeadbeef, 31, 1) != 1;
+    PRINTF("bit manipulation: %u errors\n\r", errors);
+
+    // The MAC instructions, the accumulator chained through them
+    acc = 0;
+    for (int i = 0; i < 16; i++) {
+        uint32_t y = x * 22695477 + 1;
+        if (i % 4 == 0) {
+            acc = ref_dot8(x, y);
+            res = cx_macz8(x, y);
+        } else if (i % 4 == 1) {
+            acc += ref_dot16(x, y);
+            res = cx_mac16(x, y);
+        } else if (i % 4 == 2) {
+            acc += ref_dot8(x, y);
+            res = cx_lmac8(&x, y);
+        } else {
+            acc += ref_dot16(x, y) + ref_dot16(y, x);
+            cx_lmac16(&x, y);
+            res = cx_mac16(y, x);
+        }
+        errors += (uint32_t)res != acc;
+        x = y;
+    }
+    errors += (uint32_t)cx_macz16(0x80008000, 0x80008000) != 0x80000000;
+    errors += cx_macz8(0x80808080, 0x7f7f7f7f) != -4 * 128 * 127;
+    PRINTF("mac: %u errors\n\r", errors);
+
+    for (int i = 0; i < LEN; i++) {
+        x = x * 1664525 + 1013904223;
+        a8[i] = x >> 24;
+        b8[i] = x >> 16;
+        // 12 bits, the sums fit in 32 bits
+        a16[i] = (int16_t)(x >> 16) >> 4;
+        b16[i] = (int16_t)x >> 4;
+    }
+
+    TIME(ref = dot8_c(a8, b8, LEN));
+    PRINTF("dot int8 x %d, C: %u cycles\n\r", LEN, cycles);
+    TIME(res = dot8_cx(a8, b8, LEN));
+    PRINTF("dot int8 x %d, cx.lmac8: %u cycles\n\r", LEN, cycles);
+    errors += res != ref;
+
+    TIME(ref = dot16_c(a16, b16, LEN));
+    PRINTF("dot int16 x %d, C: %u cycles\n\r", LEN, cycles);
+    TIME(res = dot16_cx(a16, b16, LEN));
+    PRINTF("dot int16 x %d, cx.mac16: %u cycles\n\r", LEN, cycles);
+    errors += res != ref;
+
+    if (errors) {
+        PRINTF("FAIL: %u errors\n\r", errors);
+        return EXIT_FAILURE;
+    }
+    PRINTF("PASS\n\r");
+    return EXIT_SUCCESS;
+}
@@ -54,6 +54,19 @@ endif()
 set( CMAKE_SYSTEM_NAME          Generic )
 set( CMAKE_SYSTEM_PROCESSOR     $ENV{ARCH} 
      CACHE STRING "Generate code for given RISC-V ISA string")
+
+# XPULP=1 adds the Xpulp extensions of the cv32e40p (with COREV_PULP=1) and the
+# cv32e40px to the ISA string: hardware loops, post-increment load/stores,
+# multiply-accumulate, ALU, packed-SIMD and bit manipulation. It needs the
+# CORE-V toolchain (COMPILER_PREFIX=riscv32-corev-)
+if ("$ENV{XPULP}" STREQUAL "1" AND NOT CMAKE_SYSTEM_PROCESSOR MATCHES "xcv")
+     if (NOT CMAKE_SYSTEM_PROCESSOR MATCHES "zicsr")
+          set( CMAKE_SYSTEM_PROCESSOR "${CMAKE_SYSTEM_PROCESSOR}_zicsr_zifencei"
+               CACHE STRING "Generate code for given RISC-V ISA string" FORCE)
+     endif()
+     set( CMAKE_SYSTEM_PROCESSOR "${CMAKE_SYSTEM_PROCESSOR}_xcvhwlp1p0_xcvmem1p0_xcvmac1p0_xcvbi1p0_xcvalu1p0_xcvsimd1p0_xcvbitmanip1p0"
+          CACHE STRING "Generate code for given RISC-V ISA string" FORCE)
+endif()
 set( CMAKE_EXECUTABLE_SUFFIX    ".elf")
 
 # specify the cross compiler. We force the compiler so that CMake doesn't
@@ -35,6 +35,12 @@ build/Makefile : CMakeLists.txt ${CMAKE_DIR}/riscv.cmake
 			-DINC_FOLDERS:STRING=${INC_FOLDERS} \
 			-DLINK_FOLDER:STRING=${LINK_FOLDER} \
 			-DLINKER:STRING=${LINKER} \
+			-DCOMPRESS:STRING=${COMPRESS} \
+			-DCRT_DMA:STRING=${CRT_DMA} \
+			-DCRT_PAINT:STRING=${CRT_PAINT} \
+			-DCXX_STD:STRING=${CXX_STD} \
+			-DAPP_CFLAGS:STRING="${APP_CFLAGS}" \
+			-DPROFILE:STRING=${PROFILE} \
 			-DCOMPILER:STRING=${COMPILER} \
 			-DCOMPILER_PREFIX:STRING=${COMPILER_PREFIX} \
 		    ../ 
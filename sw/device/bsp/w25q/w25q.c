@@ -172,6 +172,18 @@ static w25q_error_codes_t dma_send_toflash(uint8_t *data, uint32_t length);
 */
 static void flash_write_enable(void);
 
+/**
+ * @brief Queue the segments of a read back to back.
+ *
+ * The command and the address, plus the dummy clocks of the quad read, then
+ * the read segment of length bytes. The data is left in the SPI RX FIFO.
+ *
+ * @param addr 24-bit address to read from.
+ * @param length number of bytes to read.
+ * @param quad if 1, the read is performed at quad speed.
+*/
+static void read_segments(uint32_t addr, uint32_t length, uint8_t quad);
+
 /**
  * @brief Performs sanity checks on the input parameters.
  * 
@@ -277,7 +289,7 @@ w25q_error_codes_t w25q128jw_read(uint32_t addr, void *data, uint32_t length) {
         if (status != FLASH_OK) return status;
     } else {
         // Wait DMA to be free
-        while(!dma_is_ready());
+        while(!dma_is_ready( 0 ));
         status = w25q128jw_read_quad_dma(addr, data, length);
         if (status != FLASH_OK) return status;
     }
@@ -296,7 +308,7 @@ w25q_error_codes_t w25q128jw_write(uint32_t addr, void *data, uint32_t length, u
         status = erase_and_write(addr, data, length);
     } else {
         // Wait DMA to be free
-        while(!dma_is_ready());
+        while(!dma_is_ready( 0 ));
         status = w25q128jw_write_quad_dma(addr, data, length);
     }
 
@@ -307,32 +319,8 @@ w25q_error_codes_t w25q128jw_read_standard(uint32_t addr, void* data, uint32_t l
     // Sanity checks
     if (sanity_checks(addr, data, length) != FLASH_OK) return FLASH_ERROR;
 
-    // Address + Read command
-    uint32_t read_byte_cmd = ((REVERT_24b_ADDR(addr & 0x00ffffff) << 8) | FC_RD);
-    // Load command to TX FIFO
-    spi_write_word(&spi, read_byte_cmd);
-    spi_wait_for_ready(&spi);
-
-    // Set up segment parameters -> send command and address
-    const uint32_t cmd_read_1 = spi_create_command((spi_command_t){
-        .len        = 3,                 // 4 Bytes
-        .csaat      = true,              // Command not finished
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirTxOnly      // Write only
-    });
-    // Load segment parameters to COMMAND register
-    spi_set_command(&spi, cmd_read_1);
-    spi_wait_for_ready(&spi);
-
-    // Set up segment parameters -> read length bytes
-    const uint32_t cmd_read_2 = spi_create_command((spi_command_t){
-        .len        = length-1,          // len bytes
-        .csaat      = false,             // End command
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirRxOnly      // Read only
-    });
-    spi_set_command(&spi, cmd_read_2);
-    spi_wait_for_ready(&spi);
+    // Read command, address and read segments
+    read_segments(addr, length, 0);
 
     /*
      * Set RX watermark to length. The watermark is in words.
@@ -435,35 +423,11 @@ w25q_error_codes_t w25q128jw_read_standard_dma(uint32_t addr, void *data, uint32
     res = dma_load_transaction(&trans);
     res = dma_launch(&trans);
 
-    // Address + Read command
-    uint32_t read_byte_cmd = ((REVERT_24b_ADDR(addr & 0x00ffffff) << 8) | FC_RD);
-    // Load command to TX FIFO
-    spi_write_word(&spi, read_byte_cmd);
-    spi_wait_for_ready(&spi);
-
-    // Set up segment parameters -> send command and address
-    const uint32_t cmd_read_1 = spi_create_command((spi_command_t){
-        .len        = 3,                 // 4 Bytes
-        .csaat      = true,              // Command not finished
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirTxOnly      // Write only
-    });
-    // Load segment parameters to COMMAND register
-    spi_set_command(&spi, cmd_read_1);
-    spi_wait_for_ready(&spi);
-
-    // Set up segment parameters -> read length bytes
-    const uint32_t cmd_read_2 = spi_create_command((spi_command_t){
-        .len        = length-1,          // len bytes
-        .csaat      = false,             // End command
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirRxOnly      // Read only
-    });
-    spi_set_command(&spi, cmd_read_2);
-    spi_wait_for_ready(&spi);
+    // Read command, address and read segments
+    read_segments(addr, length, 0);
 
     // Wait for DMA to finish transaction
-    while(!dma_is_ready());
+    while(!dma_is_ready( 0 ));
 
     // Take into account the extra bytes (if any)
     if (length % 4 != 0) {
@@ -484,56 +448,8 @@ w25q_error_codes_t w25q128jw_read_quad(uint32_t addr, void *data, uint32_t lengt
     // Sanity checks
     if (sanity_checks(addr, data, length) != FLASH_OK) return FLASH_ERROR;
 
-    // Send quad read command at standard speed
-    uint32_t cmd_read_quadIO = FC_RDQIO;
-    spi_write_word(&spi, cmd_read_quadIO);
-    const uint32_t cmd_read = spi_create_command((spi_command_t){
-        .len        = 0,                 // 1 Byte
-        .csaat      = true,              // Command not finished
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirTxOnly      // Write only
-    });
-    spi_set_command(&spi, cmd_read);
-    spi_wait_for_ready(&spi);
-
-    /*
-     * Send address at quad speed.
-     * Last byte is Fxh (here FFh) required by W25Q128JW
-    */
-    uint32_t read_byte_cmd = (REVERT_24b_ADDR(addr) | (0xFF << 24));
-    spi_write_word(&spi, read_byte_cmd);
-    const uint32_t cmd_address = spi_create_command((spi_command_t){
-        .len        = 3,                // 3 Byte
-        .csaat      = true,             // Command not finished
-        .speed      = kSpiSpeedQuad,    // Quad speed
-        .direction  = kSpiDirTxOnly     // Write only
-    });
-    spi_set_command(&spi, cmd_address);
-    spi_wait_for_ready(&spi);
-
-    // Quad read requires dummy clocks
-    const uint32_t dummy_clocks_cmd = spi_create_command((spi_command_t){
-        #ifdef TARGET_PYNQ_Z2
-        .len        = DUMMY_CLOCKS_FAST_READ_QUAD_IO-1,
-        #else
-        .len        = DUMMY_CLOCKS_SIM-1,               
-        #endif
-        .csaat      = true,            // Command not finished
-        .speed      = kSpiSpeedQuad,   // Quad speed
-        .direction  = kSpiDirDummy     // Dummy
-    });
-    spi_set_command(&spi, dummy_clocks_cmd);
-    spi_wait_for_ready(&spi);
-
-    // Read back the requested data at quad speed
-    const uint32_t cmd_read_rx = spi_create_command((spi_command_t){
-        .len        = length-1,        // 32 Byte
-        .csaat      = false,           // End command
-        .speed      = kSpiSpeedQuad,   // Quad speed
-        .direction  = kSpiDirRxOnly    // Read only
-    });
-    spi_set_command(&spi, cmd_read_rx);
-    spi_wait_for_ready(&spi);
+    // Quad read command, address, dummy clocks and quad read segments
+    read_segments(addr, length, 1);
 
     /* COMMAND FINISHED */
 
@@ -589,56 +505,8 @@ w25q_error_codes_t w25q128jw_read_quad_dma(uint32_t addr, void *data, uint32_t l
     // Sanity checks
     if (sanity_checks(addr, data, length) != FLASH_OK) return FLASH_ERROR;
 
-    // Send quad read command at standard speed
-    uint32_t cmd_read_quadIO = FC_RDQIO;
-    spi_write_word(&spi, cmd_read_quadIO);
-    const uint32_t cmd_read = spi_create_command((spi_command_t){
-        .len        = 0,                 // 1 Byte
-        .csaat      = true,              // Command not finished
-        .speed      = kSpiSpeedStandard, // Single speed
-        .direction  = kSpiDirTxOnly      // Write only
-    });
-    spi_set_command(&spi, cmd_read);
-    spi_wait_for_ready(&spi);
-
-    /*
-     * Send address at quad speed.
-     * Last byte is Fxh (here FFh) required by W25Q128JW
-    */
-    uint32_t read_byte_cmd = (REVERT_24b_ADDR(addr) | (0xFF << 24));
-    spi_write_word(&spi, read_byte_cmd);
-    const uint32_t cmd_address = spi_create_command((spi_command_t){
-        .len        = 3,                // 3 Byte
-        .csaat      = true,             // Command not finished
-        .speed      = kSpiSpeedQuad,    // Quad speed
-        .direction  = kSpiDirTxOnly     // Write only
-    });
-    spi_set_command(&spi, cmd_address);
-    spi_wait_for_ready(&spi);
-
-    // Quad read requires dummy clocks
-    const uint32_t dummy_clocks_cmd = spi_create_command((spi_command_t){
-        #ifdef TARGET_PYNQ_Z2
-        .len        = DUMMY_CLOCKS_FAST_READ_QUAD_IO-1, // W25Q128JW flash needs 4 dummy cycles
-        #else
-        .len        = DUMMY_CLOCKS_SIM-1, // SPI flash simulation model needs 8 dummy cycles
-        #endif
-        .csaat      = true,              // Command not finished
-        .speed      = kSpiSpeedQuad,     // Quad speed
-        .direction  = kSpiDirDummy       // Dummy
-    });
-    spi_set_command(&spi, dummy_clocks_cmd);
-    spi_wait_for_ready(&spi);
-
-    // Read back the requested data at quad speed
-    const uint32_t cmd_read_rx = spi_create_command((spi_command_t){
-        .len        = length-1,        // length bytes
-        .csaat      = false,           // End command
-        .speed      = kSpiSpeedQuad,   // Quad speed
-        .direction  = kSpiDirRxOnly    // Read only
-    });
-    spi_set_command(&spi, cmd_read_rx);
-    spi_wait_for_ready(&spi);
+    // Quad read command, address, dummy clocks and quad read segments
+    read_segments(addr, length, 1);
 
     /* COMMAND FINISHED */
 
@@ -692,7 +560,7 @@ w25q_error_codes_t w25q128jw_read_quad_dma(uint32_t addr, void *data, uint32_t l
     res = dma_launch(&trans);
 
     // Wait for DMA to finish transaction
-    while(!dma_is_ready());
+    while(!dma_is_ready( 0 ));
 
     // Take into account the extra bytes (if any)
     if (length % 4 != 0) {
@@ -1221,7 +1089,7 @@ static w25q_error_codes_t dma_send_toflash(uint8_t *data, uint32_t length) {
     if (res != DMA_CONFIG_OK) return FLASH_ERROR_DMA;
 
     // Wait for DMA to finish transaction
-    while(!dma_is_ready());
+    while(!dma_is_ready( 0 ));
 
     // Take into account the extra bytes (if any)
     if (length % 4 != 0) {
@@ -1244,6 +1112,83 @@ static void flash_write_enable(void) {
     spi_wait_for_ready(&spi);
 }
 
+static void read_segments(uint32_t addr, uint32_t length, uint8_t quad) {
+    if (quad) {
+        /*
+         * Quad read command at standard speed, then address at quad speed.
+         * Last byte is Fxh (here FFh) required by W25Q128JW
+        */
+        const uint32_t txdata[2] = {FC_RDQIO, REVERT_24b_ADDR(addr) | (0xFF << 24)};
+        const spi_segment_t segments[4] = {
+            {
+                .command = {
+                    .len        = 0,                 // 1 Byte
+                    .csaat      = true,              // Command not finished
+                    .speed      = kSpiSpeedStandard, // Single speed
+                    .direction  = kSpiDirTxOnly      // Write only
+                },
+                .txdata = &txdata[0]
+            },
+            {
+                .command = {
+                    .len        = 3,                 // 3 Bytes + Fxh
+                    .csaat      = true,              // Command not finished
+                    .speed      = kSpiSpeedQuad,     // Quad speed
+                    .direction  = kSpiDirTxOnly      // Write only
+                },
+                .txdata = &txdata[1]
+            },
+            {
+                .command = {
+                    #ifdef TARGET_PYNQ_Z2
+                    .len        = DUMMY_CLOCKS_FAST_READ_QUAD_IO-1, // W25Q128JW flash needs 4 dummy cycles
+                    #else
+                    .len        = DUMMY_CLOCKS_SIM-1, // SPI flash simulation model needs 8 dummy cycles
+                    #endif
+                    .csaat      = true,              // Command not finished
+                    .speed      = kSpiSpeedQuad,     // Quad speed
+                    .direction  = kSpiDirDummy       // Dummy
+                },
+                .txdata = NULL
+            },
+            {
+                .command = {
+                    .len        = length-1,          // length bytes
+                    .csaat      = false,             // End command
+                    .speed      = kSpiSpeedQuad,     // Quad speed
+                    .direction  = kSpiDirRxOnly      // Read only
+                },
+                .txdata = NULL
+            }
+        };
+        spi_issue_segments(&spi, segments, 4);
+    } else {
+        // Address + Read command
+        const uint32_t txdata = ((REVERT_24b_ADDR(addr & 0x00ffffff) << 8) | FC_RD);
+        const spi_segment_t segments[2] = {
+            {
+                .command = {
+                    .len        = 3,                 // 4 Bytes
+                    .csaat      = true,              // Command not finished
+                    .speed      = kSpiSpeedStandard, // Single speed
+                    .direction  = kSpiDirTxOnly      // Write only
+                },
+                .txdata = &txdata
+            },
+            {
+                .command = {
+                    .len        = length-1,          // length bytes
+                    .csaat      = false,             // End command
+                    .speed      = kSpiSpeedStandard, // Single speed
+                    .direction  = kSpiDirRxOnly      // Read only
+                },
+                .txdata = NULL
+            }
+        };
+        spi_issue_segments(&spi, segments, 2);
+    }
+}
+
 static w25q_error_codes_t sanity_checks(uint32_t addr, uint8_t *data, uint32_t length) {
     // Check if address is out of range
     if (addr > MAX_FLASH_ADDR || addr < 0) return FLASH_ERROR;
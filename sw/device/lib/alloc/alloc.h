@@ -0,0 +1,114 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : alloc.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   alloc.h
+* @date   14/10/26
+* @brief  Definitions shared by the arena (arena.h) and pool (pool.h)
+* allocators, and the macros to back them with linker regions.
+*
+* Both allocators manage a region given at initialization. The region can be:
+* - The .arena section of the linker scripts, sized by arena_size in the
+*   linker_script section of mcu_cfg.hjson (0 by default) or with
+*   -Wl,--defsym=__arena_size=<bytes>. It comes after the heap in the data RAM.
+*   Use ALLOC_REGION(arena).
+* - Any region a custom linker script defines with __<name>_start and
+*   __<name>_end symbols. Declare it with ALLOC_REGION_DECLARE(<name>) and use
+*   ALLOC_REGION(<name>).
+* - A static buffer placed with ALLOC_BUFFER in a chosen output section, e.g.
+*   ".xheep_data_interleaved" to pin it in the interleaved banks, when the
+*   configuration has some.
+*/
+
+#ifndef _ALLOC_H
+#define _ALLOC_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Alignment of the returned blocks, enough for any type of the ABI.
+ */
+#ifndef ALLOC_ALIGN_B
+#define ALLOC_ALIGN_B 8
+#endif
+
+/**
+ * If 1, the allocators keep their high-water mark and the number of failed
+ * allocations. Set to 0 to save the few cycles and bytes they cost.
+ */
+#ifndef ALLOC_USAGE_TRACKING
+#define ALLOC_USAGE_TRACKING 1
+#endif
+
+/**
+ * Rounds a size up to a multiple of p_align_b, which must be a power of 2.
+ */
+#define ALLOC_ROUND_UP( p_size_b, p_align_b ) \
+    ( ( (p_size_b) + (p_align_b) - 1 ) & ~( (size_t)(p_align_b) - 1 ) )
+
+/**
+ * Declares the start and end symbols of a linker region.
+ */
+#define ALLOC_REGION_DECLARE( name ) \
+    extern uint8_t __##name##_start[]; \
+    extern uint8_t __##name##_end[]
+
+/**
+ * Size of a linker region, in bytes.
+ */
+#define ALLOC_REGION_SIZE_B( name ) \
+    ( (size_t)( __##name##_end - __##name##_start ) )
+
+/**
+ * Base and size of a linker region, to pass to arena_init or pool_init.
+ */
+#define ALLOC_REGION( name ) \
+    __##name##_start, ALLOC_REGION_SIZE_B( name )
+
+/**
+ * Defines a static buffer usable as a region, placed in p_section.
+ */
+#define ALLOC_BUFFER( name, p_size_b, p_section ) \
+    static uint8_t name[ ALLOC_ROUND_UP( p_size_b, ALLOC_ALIGN_B ) ] \
+    __attribute__ ((section ( p_section ), aligned ( ALLOC_ALIGN_B )))
+
+/* The region of the linker scripts. */
+ALLOC_REGION_DECLARE( arena );
+
+#endif /* _ALLOC_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,88 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : arena.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   arena.c
+* @date   14/10/26
+* @brief  Arena allocator.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "arena.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void arena_init( arena_t *p_arena, void *p_base, size_t p_size_b )
+{
+    uintptr_t base = (uintptr_t) p_base;
+    size_t    pad_b = ALLOC_ROUND_UP( base, ALLOC_ALIGN_B ) - base;
+
+    p_arena->base   = (uint8_t*) ( base + pad_b );
+    p_arena->size_b = p_size_b > pad_b ? p_size_b - pad_b : 0;
+    p_arena->used_b = 0;
+#if ALLOC_USAGE_TRACKING
+    p_arena->peak_b   = 0;
+    p_arena->failures = 0;
+#endif
+}
+
+void *arena_alloc( arena_t *p_arena, size_t p_size_b )
+{
+    return arena_alloc_aligned( p_arena, p_size_b, ALLOC_ALIGN_B );
+}
+
+void *arena_alloc_aligned( arena_t *p_arena, size_t p_size_b, size_t p_align_b )
+{
+    /* used_b stays a multiple of ALLOC_ALIGN_B, only larger alignments pad. */
+    uintptr_t next   = (uintptr_t) p_arena->base + p_arena->used_b;
+    size_t    pad_b  = ALLOC_ROUND_UP( next, p_align_b ) - next;
+    size_t    end_b  = ALLOC_ROUND_UP( p_size_b, ALLOC_ALIGN_B );
+    size_t    free_b = arena_free_b( p_arena );
+
+    /* Written so that a huge p_size_b cannot wrap around. */
+    if( pad_b > free_b || p_size_b > free_b - pad_b || end_b > free_b - pad_b )
+    {
+#if ALLOC_USAGE_TRACKING
+        p_arena->failures++;
+#endif
+        return NULL;
+    }
+
+    p_arena->used_b += pad_b + end_b;
+#if ALLOC_USAGE_TRACKING
+    if( p_arena->used_b > p_arena->peak_b ) p_arena->peak_b = p_arena->used_b;
+#endif
+    return (void*) ( next + pad_b );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
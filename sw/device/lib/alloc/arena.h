@@ -0,0 +1,159 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : arena.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   arena.h
+* @date   14/10/26
+* @brief  Arena allocator: allocations move a pointer forward in a region and
+* are all freed at once, e.g. at the end of a frame.
+*
+* An allocation costs a few instructions and never fragments the region.
+* arena_mark and arena_release free everything allocated after a point, for
+* scratch buffers of a single function.
+*/
+
+#ifndef _ARENA_H
+#define _ARENA_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include "alloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * An arena. Its fields are only to be read through the functions below.
+ */
+typedef struct
+{
+    uint8_t *base;      /*!< Start of the region, aligned to ALLOC_ALIGN_B. */
+    size_t  size_b;     /*!< Size of the region, in bytes. */
+    size_t  used_b;     /*!< Bytes allocated since the last reset. */
+#if ALLOC_USAGE_TRACKING
+    size_t   peak_b;    /*!< Largest used_b since the initialization. */
+    uint32_t failures;  /*!< Allocations that did not fit. */
+#endif
+} arena_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes an arena over a region.
+ * @param p_arena The arena.
+ * @param p_base Start of the region. If it is not aligned, the bytes before
+ * the first aligned address are not used.
+ * @param p_size_b Size of the region, in bytes.
+ */
+void arena_init( arena_t *p_arena, void *p_base, size_t p_size_b );
+
+/**
+ * @brief Allocates a block aligned to ALLOC_ALIGN_B.
+ * @param p_arena The arena.
+ * @param p_size_b Size of the block, in bytes.
+ * @return The block, or NULL if it does not fit.
+ */
+void *arena_alloc( arena_t *p_arena, size_t p_size_b );
+
+/**
+ * @brief Allocates a block with a larger alignment, e.g. for a DMA window.
+ * @param p_arena The arena.
+ * @param p_size_b Size of the block, in bytes.
+ * @param p_align_b Alignment of the block, a power of 2.
+ * @return The block, or NULL if it does not fit.
+ */
+void *arena_alloc_aligned( arena_t *p_arena, size_t p_size_b, size_t p_align_b );
+
+/**
+ * @brief Frees every block of the arena.
+ */
+static inline void arena_reset( arena_t *p_arena )
+{
+    p_arena->used_b = 0;
+}
+
+/**
+ * @brief Returns a mark of the current use of the arena, for arena_release.
+ */
+static inline size_t arena_mark( const arena_t *p_arena )
+{
+    return p_arena->used_b;
+}
+
+/**
+ * @brief Frees the blocks allocated since p_mark was taken.
+ */
+static inline void arena_release( arena_t *p_arena, size_t p_mark )
+{
+    if( p_mark < p_arena->used_b ) p_arena->used_b = p_mark;
+}
+
+/**
+ * @brief Returns the bytes left in the arena.
+ */
+static inline size_t arena_free_b( const arena_t *p_arena )
+{
+    return p_arena->size_b - p_arena->used_b;
+}
+
+#if ALLOC_USAGE_TRACKING
+/**
+ * @brief Returns the most bytes the arena has had allocated at once.
+ */
+static inline size_t arena_peak_b( const arena_t *p_arena )
+{
+    return p_arena->peak_b;
+}
+
+/**
+ * @brief Returns the number of allocations that did not fit.
+ */
+static inline uint32_t arena_failures( const arena_t *p_arena )
+{
+    return p_arena->failures;
+}
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _ARENA_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
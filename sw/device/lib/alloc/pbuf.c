@@ -0,0 +1,247 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : pbuf.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   pbuf.c
+* @date   14/10/26
+* @brief  Packet buffers.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <string.h>
+
+#include "pbuf.h"
+#include "csr.h"
+#include "irq.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * First byte of the data of a buffer of the pool.
+ */
+#define PBUF_DATA( p_pbuf ) ( (uint8_t*) (p_pbuf) + PBUF_HEADER_B )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Takes a block of the pool and fills in the header, with one
+ * reference. It disables the interrupts itself.
+ */
+static pbuf_t *pbuf_take( pbuf_pool_t *p_pool );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+uint32_t pbuf_pool_init( pbuf_pool_t *p_pool,
+                         void        *p_base,
+                         size_t      p_size_b,
+                         uint16_t    p_data_b,
+                         uint16_t    p_headroom_b )
+{
+    p_pool->data_b     = ALLOC_ROUND_UP( p_data_b, ALLOC_ALIGN_B );
+    p_pool->headroom_b = ALLOC_ROUND_UP( p_headroom_b, ALLOC_ALIGN_B );
+    if( p_pool->headroom_b > p_pool->data_b ) p_pool->headroom_b = p_pool->data_b;
+
+    return pool_init( &p_pool->pool, p_base, p_size_b, PBUF_HEADER_B + p_pool->data_b );
+}
+
+pbuf_t *pbuf_alloc( pbuf_pool_t *p_pool )
+{
+    pbuf_t *pbuf = pbuf_take( p_pool );
+    if( pbuf == NULL ) return NULL;
+
+    pbuf->payload = PBUF_DATA( pbuf ) + p_pool->headroom_b;
+    pbuf->size    = p_pool->data_b - p_pool->headroom_b;
+    return pbuf;
+}
+
+pbuf_t *pbuf_alloc_chain( pbuf_pool_t *p_pool, uint32_t p_len )
+{
+    pbuf_t   *head = NULL;
+    pbuf_t   *last = NULL;
+    uint32_t left  = p_len;
+
+    do
+    {
+        pbuf_t *pbuf = pbuf_alloc( p_pool );
+        if( pbuf == NULL || pbuf->size == 0 )
+        {
+            pbuf_free( pbuf );
+            pbuf_free( head );
+            return NULL;
+        }
+        pbuf->len = ( left < pbuf->size ) ? left : pbuf->size;
+        left     -= pbuf->len;
+
+        if( last != NULL ) last->next = pbuf;
+        else               head       = pbuf;
+        last = pbuf;
+    } while( left > 0 );
+
+    return head;
+}
+
+pbuf_t *pbuf_alloc_ref( pbuf_pool_t    *p_pool,
+                        void           *p_payload,
+                        uint16_t       p_len,
+                        pbuf_free_cb_t p_free_cb,
+                        void           *p_ctx )
+{
+    pbuf_t *pbuf = pbuf_take( p_pool );
+    if( pbuf == NULL ) return NULL;
+
+    pbuf->payload = (uint8_t*) p_payload;
+    pbuf->len     = p_len;
+    pbuf->size    = p_len;
+    pbuf->free_cb = p_free_cb;
+    pbuf->ctx     = p_ctx;
+    return pbuf;
+}
+
+void pbuf_ref( pbuf_t *p_pbuf )
+{
+    uint32_t mstatus = irq_save();
+    p_pbuf->ref++;
+    irq_restore( mstatus );
+}
+
+void pbuf_free( pbuf_t *p_pbuf )
+{
+    while( p_pbuf != NULL )
+    {
+        uint32_t mstatus = irq_save();
+        uint16_t ref     = --p_pbuf->ref;
+        irq_restore( mstatus );
+
+        /* The rest of the chain belongs to whoever still holds this buffer. */
+        if( ref != 0 ) return;
+
+        pbuf_t *next = p_pbuf->next;
+        if( p_pbuf->free_cb != NULL ) p_pbuf->free_cb( p_pbuf );
+
+        mstatus = irq_save();
+        pool_free( &p_pbuf->pool->pool, p_pbuf );
+        irq_restore( mstatus );
+
+        p_pbuf = next;
+    }
+}
+
+void pbuf_cat( pbuf_t *p_head, pbuf_t *p_tail )
+{
+    while( p_head->next != NULL ) p_head = p_head->next;
+    p_head->next = p_tail;
+}
+
+uint32_t pbuf_total_len( const pbuf_t *p_pbuf )
+{
+    uint32_t len = 0;
+    for( ; p_pbuf != NULL; p_pbuf = p_pbuf->next ) len += p_pbuf->len;
+    return len;
+}
+
+bool pbuf_header( pbuf_t *p_pbuf, int32_t p_delta )
+{
+    if( p_delta < 0 )
+    {
+        if( (uint32_t) -p_delta > p_pbuf->len ) return false;
+    }
+    else if(    p_pbuf->free_cb != NULL
+             || p_pbuf->payload - p_delta < PBUF_DATA( p_pbuf )
+             || p_pbuf->len + p_delta > 0xFFFF )
+    {
+        return false;
+    }
+
+    p_pbuf->payload -= p_delta;
+    p_pbuf->len     += p_delta;
+    p_pbuf->size    += p_delta;
+    return true;
+}
+
+uint32_t pbuf_copy_out( const pbuf_t *p_pbuf,
+                        uint32_t     p_offset,
+                        void         *p_dst,
+                        uint32_t     p_len )
+{
+    uint32_t done = 0;
+
+    for( ; p_pbuf != NULL && done < p_len; p_pbuf = p_pbuf->next )
+    {
+        if( p_offset >= p_pbuf->len )
+        {
+            p_offset -= p_pbuf->len;
+            continue;
+        }
+        uint32_t n = p_pbuf->len - p_offset;
+        if( n > p_len - done ) n = p_len - done;
+        memcpy( (uint8_t*) p_dst + done, p_pbuf->payload + p_offset, n );
+        done     += n;
+        p_offset  = 0;
+    }
+    return done;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static pbuf_t *pbuf_take( pbuf_pool_t *p_pool )
+{
+    uint32_t mstatus = irq_save();
+    pbuf_t   *pbuf   = (pbuf_t*) pool_alloc( &p_pool->pool );
+    irq_restore( mstatus );
+
+    if( pbuf == NULL ) return NULL;
+
+    pbuf->next     = NULL;
+    pbuf->next_pkt = NULL;
+    pbuf->pool     = p_pool;
+    pbuf->len      = 0;
+    pbuf->ref      = 1;
+    pbuf->free_cb  = NULL;
+    pbuf->ctx      = NULL;
+    pbuf->tag      = 0;
+    return pbuf;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
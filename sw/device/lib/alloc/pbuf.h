@@ -0,0 +1,283 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : pbuf.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pbuf.h
+* @date   14/10/26
+* @brief  Packet buffers: blocks of a pool holding a header and the data of a
+* packet, counted by reference and chained, so that a packet goes from a
+* peripheral through its processing to the flash without being copied.
+*
+* A packet is a chain of buffers linked by next. Each buffer holds len bytes
+* at payload, which is aligned to ALLOC_ALIGN_B, so the DMA can fill or drain
+* it with word transfers, e.g. with dma_memcpy_async or spi_flash_read_async.
+* The payload can be moved back into the headroom to prepend a header, or
+* forward to strip one, with pbuf_header. A buffer can also refer to data it
+* does not own, e.g. a frame of i2s_capture, which is given back by a
+* callback when the buffer is freed.
+*
+* Each buffer has a reference count: whoever keeps a packet, e.g. a driver
+* sending it while the application also writes it to the flash, takes a
+* reference with pbuf_ref and drops it with pbuf_free. The drivers that take
+* packets free them once they are done:
+* - uart_buffered_write_pbuf sends a packet with the DMA from its buffers.
+* - spi_flash_program_pbuf_async programs a packet, buffer after buffer.
+* - i2s_capture_take gives the oldest frame of a capture as a buffer.
+*
+* The allocation, the references and the frees disable the interrupts for a
+* few instructions, so packets can be freed from the DMA callbacks. The
+* queues of packets are not protected: a queue shared with a handler must
+* be accessed with the interrupts disabled.
+*/
+
+#ifndef _PBUF_H
+#define _PBUF_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+
+#include "alloc.h"
+#include "pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+struct pbuf;
+
+/**
+ * Called when the last reference to a buffer referring to external data is
+ * freed, possibly from a handler.
+ */
+typedef void (*pbuf_free_cb_t)( struct pbuf *p_pbuf );
+
+/**
+ * A pool of packet buffers.
+ */
+typedef struct
+{
+    pool_t   pool;
+    uint16_t data_b;        /*!< Bytes of data of each buffer, headroom included. */
+    uint16_t headroom_b;    /*!< Bytes before the payload of a new buffer. */
+} pbuf_pool_t;
+
+/**
+ * A buffer, followed by its data in its block of the pool.
+ */
+typedef struct pbuf
+{
+    struct pbuf       *next;      /*!< Next buffer of the packet, NULL at the end. */
+    struct pbuf       *next_pkt;  /*!< Next packet of a queue. */
+    pbuf_pool_t       *pool;
+    uint8_t           *payload;   /*!< First byte of the data. */
+    uint16_t          len;        /*!< Bytes of data at payload. */
+    uint16_t          size;       /*!< Bytes available from payload. */
+    volatile uint16_t ref;        /*!< References to the buffer. */
+    pbuf_free_cb_t    free_cb;    /*!< NULL if the data is in the block. */
+    void              *ctx;       /*!< Context of free_cb. */
+    uint32_t          tag;        /*!< Free for the current owner, e.g. the
+    driver a packet is queued in. */
+} pbuf_t;
+
+/**
+ * A FIFO of packets, linked by next_pkt.
+ */
+typedef struct
+{
+    pbuf_t   *head;
+    pbuf_t   *tail;
+    uint32_t count;
+} pbuf_queue_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Bytes of a block taken by the header of a buffer.
+ */
+#define PBUF_HEADER_B ALLOC_ROUND_UP( sizeof( pbuf_t ), ALLOC_ALIGN_B )
+
+/**
+ * Size of a region holding p_n buffers of p_data_b bytes of data.
+ */
+#define PBUF_POOL_SIZE_B( p_n, p_data_b ) \
+    ( (p_n) * ( PBUF_HEADER_B + ALLOC_ROUND_UP( p_data_b, ALLOC_ALIGN_B ) ) )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes a pool of buffers over a region.
+ * @param p_pool The pool.
+ * @param p_base Start of the region, see pool_init.
+ * @param p_size_b Size of the region, in bytes.
+ * @param p_data_b Bytes of data of each buffer, rounded up to ALLOC_ALIGN_B.
+ * @param p_headroom_b Bytes kept before the payload of each new buffer for the
+ * headers prepended with pbuf_header, rounded up to ALLOC_ALIGN_B and at most
+ * p_data_b.
+ * @return The number of buffers of the pool.
+ */
+uint32_t pbuf_pool_init( pbuf_pool_t *p_pool,
+                         void        *p_base,
+                         size_t      p_size_b,
+                         uint16_t    p_data_b,
+                         uint16_t    p_headroom_b );
+
+/**
+ * @brief Allocates an empty buffer, with one reference.
+ * @return The buffer, or NULL if the pool is empty.
+ */
+pbuf_t *pbuf_alloc( pbuf_pool_t *p_pool );
+
+/**
+ * @brief Allocates a packet of the buffers needed to hold p_len bytes, all of
+ * them full but the last one, e.g. to be filled by a DMA transaction each.
+ * @return The packet, or NULL if the pool does not have enough buffers.
+ */
+pbuf_t *pbuf_alloc_chain( pbuf_pool_t *p_pool, uint32_t p_len );
+
+/**
+ * @brief Allocates a buffer referring to external data, with one reference.
+ * The data of its block is not used.
+ * @param p_payload The data, it must stay valid until p_free_cb is called.
+ * @param p_len Its size in bytes.
+ * @param p_free_cb Called when the buffer is freed, it may be NULL.
+ * @param p_ctx Stored in the ctx field of the buffer.
+ * @return The buffer, or NULL if the pool is empty.
+ */
+pbuf_t *pbuf_alloc_ref( pbuf_pool_t    *p_pool,
+                        void           *p_payload,
+                        uint16_t       p_len,
+                        pbuf_free_cb_t p_free_cb,
+                        void           *p_ctx );
+
+/**
+ * @brief Takes one more reference to a packet. Only its first buffer is
+ * counted: the following ones are freed with it.
+ */
+void pbuf_ref( pbuf_t *p_pbuf );
+
+/**
+ * @brief Drops a reference to a packet. The buffers whose count reaches 0
+ * are given back to their pool, up to the first one still referenced by
+ * another packet. NULL is ignored.
+ */
+void pbuf_free( pbuf_t *p_pbuf );
+
+/**
+ * @brief Appends a packet to another one, whose reference is taken over.
+ */
+void pbuf_cat( pbuf_t *p_head, pbuf_t *p_tail );
+
+/**
+ * @brief Returns the bytes of a packet, from the given buffer.
+ */
+uint32_t pbuf_total_len( const pbuf_t *p_pbuf );
+
+/**
+ * @brief Moves the payload of a buffer of the pool back by p_delta bytes to
+ * prepend a header, or forward by -p_delta bytes to strip one.
+ * @return false if the payload would leave the data of the block, or the
+ * buffer refers to external data and p_delta is positive.
+ */
+bool pbuf_header( pbuf_t *p_pbuf, int32_t p_delta );
+
+/**
+ * @brief Copies bytes of a packet, from p_offset, to a buffer, e.g. to read
+ * a header split across two buffers.
+ * @return The bytes copied, fewer than p_len at the end of the packet.
+ */
+uint32_t pbuf_copy_out( const pbuf_t *p_pbuf,
+                        uint32_t     p_offset,
+                        void         *p_dst,
+                        uint32_t     p_len );
+
+/**
+ * @brief Appends a packet to a queue.
+ */
+static inline void pbuf_queue_push( pbuf_queue_t *p_queue, pbuf_t *p_pbuf )
+{
+    p_pbuf->next_pkt = NULL;
+    if( p_queue->tail != NULL ) p_queue->tail->next_pkt = p_pbuf;
+    else                        p_queue->head           = p_pbuf;
+    p_queue->tail = p_pbuf;
+    p_queue->count++;
+}
+
+/**
+ * @brief Removes the oldest packet of a queue.
+ * @return The packet, or NULL if the queue is empty.
+ */
+static inline pbuf_t *pbuf_queue_pop( pbuf_queue_t *p_queue )
+{
+    pbuf_t *pbuf = p_queue->head;
+    if( pbuf == NULL ) return NULL;
+
+    p_queue->head = pbuf->next_pkt;
+    if( p_queue->head == NULL ) p_queue->tail = NULL;
+    p_queue->count--;
+    pbuf->next_pkt = NULL;
+    return pbuf;
+}
+
+/**
+ * @brief Returns the oldest packet of a queue, NULL if it is empty.
+ */
+static inline pbuf_t *pbuf_queue_peek( const pbuf_queue_t *p_queue )
+{
+    return p_queue->head;
+}
+
+/**
+ * @brief Returns the number of free buffers of a pool.
+ */
+static inline uint32_t pbuf_pool_free_n( const pbuf_pool_t *p_pool )
+{
+    return pool_free_n( &p_pool->pool );
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _PBUF_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
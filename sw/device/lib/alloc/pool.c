@@ -0,0 +1,104 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : pool.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   pool.c
+* @date   14/10/26
+* @brief  Pool allocator.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "pool.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+uint32_t pool_init( pool_t *p_pool, void *p_base, size_t p_size_b, size_t p_block_b )
+{
+    uintptr_t base  = (uintptr_t) p_base;
+    size_t    pad_b = ALLOC_ROUND_UP( base, ALLOC_ALIGN_B ) - base;
+
+    /* A block must be able to hold the link of the free list. */
+    if( p_block_b < sizeof( pool_block_t ) ) p_block_b = sizeof( pool_block_t );
+
+    p_pool->base     = (uint8_t*) ( base + pad_b );
+    p_pool->block_b  = ALLOC_ROUND_UP( p_block_b, ALLOC_ALIGN_B );
+    p_pool->blocks_n = p_size_b > pad_b ? ( p_size_b - pad_b ) / p_pool->block_b : 0;
+    p_pool->used_n   = 0;
+#if ALLOC_USAGE_TRACKING
+    p_pool->peak_n   = 0;
+    p_pool->failures = 0;
+#endif
+
+    /* The list starts with the lowest block, the order they are allocated in. */
+    p_pool->free_list = NULL;
+    for( uint32_t i = p_pool->blocks_n; i > 0; i-- )
+    {
+        pool_block_t *block = (pool_block_t*) ( p_pool->base + ( i - 1 ) * p_pool->block_b );
+        block->next       = p_pool->free_list;
+        p_pool->free_list = block;
+    }
+
+    return p_pool->blocks_n;
+}
+
+void *pool_alloc( pool_t *p_pool )
+{
+    pool_block_t *block = p_pool->free_list;
+
+    if( block == NULL )
+    {
+#if ALLOC_USAGE_TRACKING
+        p_pool->failures++;
+#endif
+        return NULL;
+    }
+
+    p_pool->free_list = block->next;
+    p_pool->used_n++;
+#if ALLOC_USAGE_TRACKING
+    if( p_pool->used_n > p_pool->peak_n ) p_pool->peak_n = p_pool->used_n;
+#endif
+    return block;
+}
+
+void pool_free( pool_t *p_pool, void *p_block )
+{
+    if( p_block == NULL ) return;
+
+    pool_block_t *block = (pool_block_t*) p_block;
+    block->next       = p_pool->free_list;
+    p_pool->free_list = block;
+    p_pool->used_n--;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
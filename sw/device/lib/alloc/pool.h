@@ -0,0 +1,143 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : pool.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pool.h
+* @date   14/10/26
+* @brief  Pool allocator: a region split in blocks of a fixed size, allocated
+* and freed in constant time.
+*
+* The free blocks are kept in a list threaded through the blocks themselves,
+* so the pool has no overhead per block. Blocks can be freed in any order.
+* The pool is not protected against interrupts: a pool shared with a handler
+* must be accessed with the interrupts disabled.
+*/
+
+#ifndef _POOL_H
+#define _POOL_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include "alloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A free block, holding the next one.
+ */
+typedef struct pool_block
+{
+    struct pool_block *next;
+} pool_block_t;
+
+/**
+ * A pool. Its fields are only to be read through the functions below.
+ */
+typedef struct
+{
+    pool_block_t *free_list; /*!< First free block, NULL if there are none. */
+    uint8_t      *base;      /*!< First block. */
+    size_t       block_b;    /*!< Size of the blocks, in bytes. */
+    uint32_t     blocks_n;   /*!< Number of blocks. */
+    uint32_t     used_n;     /*!< Blocks allocated. */
+#if ALLOC_USAGE_TRACKING
+    uint32_t     peak_n;     /*!< Largest used_n since the initialization. */
+    uint32_t     failures;   /*!< Allocations with no free block. */
+#endif
+} pool_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes a pool over a region, with all its blocks free.
+ * @param p_pool The pool.
+ * @param p_base Start of the region. If it is not aligned, the bytes before
+ * the first aligned address are not used.
+ * @param p_size_b Size of the region, in bytes.
+ * @param p_block_b Size of the blocks, in bytes. It is rounded up to
+ * ALLOC_ALIGN_B.
+ * @return The number of blocks of the pool.
+ */
+uint32_t pool_init( pool_t *p_pool, void *p_base, size_t p_size_b, size_t p_block_b );
+
+/**
+ * @brief Allocates a block.
+ * @return The block, or NULL if they are all allocated.
+ */
+void *pool_alloc( pool_t *p_pool );
+
+/**
+ * @brief Frees a block allocated from the pool. NULL is ignored.
+ */
+void pool_free( pool_t *p_pool, void *p_block );
+
+/**
+ * @brief Returns the number of free blocks.
+ */
+static inline uint32_t pool_free_n( const pool_t *p_pool )
+{
+    return p_pool->blocks_n - p_pool->used_n;
+}
+
+#if ALLOC_USAGE_TRACKING
+/**
+ * @brief Returns the most blocks the pool has had allocated at once.
+ */
+static inline uint32_t pool_peak_n( const pool_t *p_pool )
+{
+    return p_pool->peak_n;
+}
+
+/**
+ * @brief Returns the number of allocations with no free block.
+ */
+static inline uint32_t pool_failures( const pool_t *p_pool )
+{
+    return p_pool->failures;
+}
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _POOL_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
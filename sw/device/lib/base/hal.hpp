@@ -0,0 +1,223 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef XHEEP_SW_DEVICE_LIB_BASE_HAL_HPP_
+#define XHEEP_SW_DEVICE_LIB_BASE_HAL_HPP_
+
+#include <stdint.h>
+
+/**
+ * @file
+ * @brief Compile-time register access for C++ code.
+ *
+ * The registers of the peripherals are types whose address is a template
+ * parameter, and their fields are types whose mask and shift are template
+ * parameters too: everything except the value written is known by the
+ * compiler, so that
+ *
+ *   soc_ctrl::periph::EXIT_VALUE::write(0);
+ *   gpio::periph::GPIO_MODE_0::modify(
+ *       gpio::periph::GPIO_MODE_0::MODE_3::val<1>() |
+ *       gpio::periph::GPIO_MODE_0::MODE_4::value(mode));
+ *
+ * compile to a single store, and a load and a store, without the function
+ * calls of `mmio_region_*()` and `bitfield_*()`.
+ *
+ * The `<name>_regs.hpp` headers describing the peripherals are generated from
+ * their hjson by `util/hal_cpp_gen.py` during `make mcu-gen`, next to the
+ * `<name>_structs.h` ones. Each one declares, in the `xheep::<name>`
+ * namespace, a `block<Base>` template with one type per register and, inside
+ * it, one type per field, and `periph`, the block at the address of the
+ * peripheral in `core_v_mini_mcu.h`.
+ *
+ * The types check what can be checked at compile time:
+ * - a field value can only be written to the register of the field, and
+ *   values of fields of different registers cannot be combined;
+ * - a constant value must fit its field (`val<V>()`);
+ * - read-only registers cannot be written and write-only ones read;
+ * - registers where writing has side effects (e.g. write 1 to clear) cannot
+ *   be read-modified-written, as that would write back the bits read.
+ *
+ * The header only uses the freestanding `stdint.h` and no exceptions, RTTI or
+ * static constructors, so it can be used in the C++ files of the
+ * applications with the same flags as C.
+ */
+
+namespace xheep {
+namespace hal {
+
+/**
+ * Software access of a register, from the `swaccess` of the hjson.
+ */
+enum class access {
+  rw,  // Read and write.
+  ro,  // Read only.
+  wo,  // Write only.
+  w1,  // Read and write, but the writes have side effects (rw1c, rw1s, ...).
+};
+
+namespace detail {
+
+template <typename A, typename B>
+struct is_same {
+  static constexpr bool value = false;
+};
+
+template <typename A>
+struct is_same<A, A> {
+  static constexpr bool value = true;
+};
+
+}  // namespace detail
+
+/**
+ * A value for some fields of the register `Reg`: the bits of the fields in
+ * `mask`, and their new value in `bits`.
+ *
+ * Values of fields of the same register are combined with `|`.
+ */
+template <typename Reg>
+struct field_value {
+  uint32_t mask;
+  uint32_t bits;
+};
+
+template <typename Reg>
+constexpr field_value<Reg> operator|(field_value<Reg> a, field_value<Reg> b) {
+  return field_value<Reg>{a.mask | b.mask, a.bits | b.bits};
+}
+
+/**
+ * A field of `Width` bits from bit `Lsb` of the register `Reg`.
+ */
+template <typename Reg, unsigned Lsb, unsigned Width>
+struct field {
+  static_assert(Width > 0 && Lsb + Width <= 32,
+                "The field does not fit in the register");
+
+  typedef Reg reg_type;
+
+  static constexpr unsigned shift = Lsb;
+  static constexpr unsigned width = Width;
+  // The largest value of the field, and its bits in the register.
+  static constexpr uint32_t max = Width == 32 ? 0xffffffffu : (1u << Width) - 1u;
+  static constexpr uint32_t mask = max << Lsb;
+
+  /**
+   * The constant `V` in the field, checked at compile time.
+   */
+  template <uint32_t V>
+  static constexpr field_value<Reg> val() {
+    static_assert(V <= max, "The value does not fit in the field");
+    return field_value<Reg>{mask, V << Lsb};
+  }
+
+  /**
+   * `v` in the field, truncated to its width.
+   */
+  static constexpr field_value<Reg> value(uint32_t v) {
+    return field_value<Reg>{mask, (v << Lsb) & mask};
+  }
+
+  /**
+   * The field in the value `r` of the register.
+   */
+  static constexpr uint32_t extract(uint32_t r) { return (r & mask) >> Lsb; }
+
+  /**
+   * Reads the register and returns the field.
+   */
+  static inline uint32_t get() { return extract(Reg::read()); }
+
+  /**
+   * Sets the field to `v`, leaving the others unchanged.
+   */
+  static inline void set(uint32_t v) { Reg::modify(value(v)); }
+};
+
+template <typename Reg, unsigned Lsb, unsigned Width>
+constexpr unsigned field<Reg, Lsb, Width>::shift;
+template <typename Reg, unsigned Lsb, unsigned Width>
+constexpr unsigned field<Reg, Lsb, Width>::width;
+template <typename Reg, unsigned Lsb, unsigned Width>
+constexpr uint32_t field<Reg, Lsb, Width>::max;
+template <typename Reg, unsigned Lsb, unsigned Width>
+constexpr uint32_t field<Reg, Lsb, Width>::mask;
+
+/**
+ * A 32-bit register at `Addr`. `Self` is the type deriving from it, which
+ * tags the values of its fields.
+ */
+template <typename Self, uintptr_t Addr, access Acc = access::rw>
+struct reg {
+  static_assert((Addr & 3) == 0, "The register is not word aligned");
+
+  static constexpr uintptr_t address = Addr;
+
+  static inline volatile uint32_t &ref() {
+    return *reinterpret_cast<volatile uint32_t *>(Addr);
+  }
+
+  static inline uint32_t read() {
+    static_assert(Acc != access::wo, "The register is write only");
+    return ref();
+  }
+
+  static inline void write(uint32_t v) {
+    static_assert(Acc != access::ro, "The register is read only");
+    ref() = v;
+  }
+
+  /**
+   * Writes the fields of `v`, and 0 to the others.
+   */
+  static inline void write(field_value<Self> v) { write(v.bits); }
+
+  /**
+   * Writes the fields of `v`, leaving the others unchanged.
+   */
+  static inline void modify(field_value<Self> v) {
+    static_assert(Acc == access::rw,
+                  "The register cannot be read-modified-written");
+    ref() = (ref() & ~v.mask) | v.bits;
+  }
+
+  /**
+   * Reads the register and returns the field `F`.
+   */
+  template <typename F>
+  static inline uint32_t get() {
+    static_assert(detail::is_same<typename F::reg_type, Self>::value,
+                  "The field is not in this register");
+    return F::extract(read());
+  }
+};
+
+template <typename Self, uintptr_t Addr, access Acc>
+constexpr uintptr_t reg<Self, Addr, Acc>::address;
+
+/**
+ * A window of `Items` words at `Addr`, e.g. the FIFO of a peripheral.
+ */
+template <uintptr_t Addr, uint32_t Items>
+struct window {
+  static_assert((Addr & 3) == 0, "The window is not word aligned");
+
+  static constexpr uintptr_t address = Addr;
+  static constexpr uint32_t items = Items;
+
+  static inline volatile uint32_t &at(uint32_t i) {
+    return reinterpret_cast<volatile uint32_t *>(Addr)[i];
+  }
+};
+
+template <uintptr_t Addr, uint32_t Items>
+constexpr uintptr_t window<Addr, Items>::address;
+template <uintptr_t Addr, uint32_t Items>
+constexpr uint32_t window<Addr, Items>::items;
+
+}  // namespace hal
+}  // namespace xheep
+
+#endif  // XHEEP_SW_DEVICE_LIB_BASE_HAL_HPP_
@@ -4,9 +4,51 @@
 
 #include "memory.h"
 
+#if !defined(HOST_BUILD)
+#include "core_v_mini_mcu.h"
+#endif  // !defined(HOST_BUILD)
+
 extern uint32_t read_32(const void *);
 extern void write_32(uint32_t, void *);
 
+// Words handled by each iteration of the main loops. The cv32e40p, cv32e40px
+// and cv32e40x pipelines hide the load latency when several independent loads
+// are issued back to back, while the two-stage cv32e20 gains little beyond
+// halving the loop overhead and favours the smaller code. It can be overridden
+// with -DMEMORY_UNROLL=<n>.
+#ifndef MEMORY_UNROLL
+#if defined(CPU_TYPE_CV32E20)
+#define MEMORY_UNROLL 2
+#else
+#define MEMORY_UNROLL 4
+#endif
+#endif  // MEMORY_UNROLL
+
+enum {
+  kWordBytes = sizeof(uint32_t),
+  kWordMask = sizeof(uint32_t) - 1,
+  kBlockBytes = MEMORY_UNROLL * sizeof(uint32_t),
+};
+
+// From -O2, GCC recognizes the byte loops of memcpy and memset as copies and
+// fills and turns them into calls to memcpy and memset, i.e. into calls to
+// themselves. The pattern distribution is disabled for these two functions.
+#if defined(__GNUC__) && !defined(__clang__)
+#define MEMORY_NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define MEMORY_NO_LIBCALL
+#endif
+
+// A byte repeated in the four bytes of a word.
+static inline uint32_t splat_8(uint8_t value) {
+  return (uint32_t)value * 0x01010101u;
+}
+
+// Non-zero if any byte of `word` is zero.
+static inline uint32_t has_zero_byte(uint32_t word) {
+  return (word - 0x01010101u) & ~word & 0x80808080u;
+}
+
 // Some symbols below are only defined for device builds. For host builds, we
 // their implementations will be provided by the host's libc implementation.
 //
@@ -16,11 +58,39 @@ extern void write_32(uint32_t, void *);
 //
 // This approach is used so that DIFs can depend on `memory.h`, but also be
 // built for host-side software.
+//
+// The functions work on whole words once the pointers are aligned, with the
+// unaligned head and tail handled a byte at a time.
 
 #if !defined(HOST_BUILD)
+MEMORY_NO_LIBCALL
 void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
   uint8_t *dest8 = (uint8_t *)dest;
-  uint8_t *src8 = (uint8_t *)src;
+  const uint8_t *src8 = (const uint8_t *)src;
+
+  // Word copies need both pointers to share their misalignment.
+  if (len >= kWordBytes && (((uintptr_t)dest8 ^ (uintptr_t)src8) & kWordMask) == 0) {
+    while ((uintptr_t)dest8 & kWordMask) {
+      *dest8++ = *src8++;
+      --len;
+    }
+    for (; len >= kBlockBytes; len -= kBlockBytes) {
+      uint32_t block[MEMORY_UNROLL];
+      for (size_t i = 0; i < MEMORY_UNROLL; ++i) {
+        block[i] = read_32(src8 + i * kWordBytes);
+      }
+      for (size_t i = 0; i < MEMORY_UNROLL; ++i) {
+        write_32(block[i], dest8 + i * kWordBytes);
+      }
+      dest8 += kBlockBytes;
+      src8 += kBlockBytes;
+    }
+    for (; len >= kWordBytes; len -= kWordBytes) {
+      write_32(read_32(src8), dest8);
+      dest8 += kWordBytes;
+      src8 += kWordBytes;
+    }
+  }
   for (size_t i = 0; i < len; ++i) {
     dest8[i] = src8[i];
   }
@@ -29,9 +99,28 @@ void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
 #endif  // !defined(HOST_BUILD)
 
 #if !defined(HOST_BUILD)
+MEMORY_NO_LIBCALL
 void *memset(void *dest, int value, size_t len) {
   uint8_t *dest8 = (uint8_t *)dest;
   uint8_t value8 = (uint8_t)value;
+
+  if (len >= kWordBytes) {
+    uint32_t value32 = splat_8(value8);
+    while ((uintptr_t)dest8 & kWordMask) {
+      *dest8++ = value8;
+      --len;
+    }
+    for (; len >= kBlockBytes; len -= kBlockBytes) {
+      for (size_t i = 0; i < MEMORY_UNROLL; ++i) {
+        write_32(value32, dest8 + i * kWordBytes);
+      }
+      dest8 += kBlockBytes;
+    }
+    for (; len >= kWordBytes; len -= kWordBytes) {
+      write_32(value32, dest8);
+      dest8 += kWordBytes;
+    }
+  }
   for (size_t i = 0; i < len; ++i) {
     dest8[i] = value8;
   }
@@ -49,6 +138,37 @@ enum {
 int memcmp(const void *lhs, const void *rhs, size_t len) {
   const uint8_t *lhs8 = (uint8_t *)lhs;
   const uint8_t *rhs8 = (uint8_t *)rhs;
+
+  // Equal words are skipped, the first different one is compared bytewise
+  // below.
+  if (len >= kWordBytes && (((uintptr_t)lhs8 ^ (uintptr_t)rhs8) & kWordMask) == 0) {
+    while ((uintptr_t)lhs8 & kWordMask) {
+      if (*lhs8 != *rhs8) {
+        return *lhs8 < *rhs8 ? kMemCmpLt : kMemCmpGt;
+      }
+      ++lhs8;
+      ++rhs8;
+      --len;
+    }
+    for (; len >= kBlockBytes; len -= kBlockBytes) {
+      uint32_t diff = 0;
+      for (size_t i = 0; i < MEMORY_UNROLL; ++i) {
+        diff |= read_32(lhs8 + i * kWordBytes) ^ read_32(rhs8 + i * kWordBytes);
+      }
+      if (diff != 0) {
+        break;
+      }
+      lhs8 += kBlockBytes;
+      rhs8 += kBlockBytes;
+    }
+    for (; len >= kWordBytes; len -= kWordBytes) {
+      if (read_32(lhs8) != read_32(rhs8)) {
+        break;
+      }
+      lhs8 += kWordBytes;
+      rhs8 += kWordBytes;
+    }
+  }
   for (size_t i = 0; i < len; ++i) {
     if (lhs8[i] < rhs8[i]) {
       return kMemCmpLt;
@@ -64,6 +184,24 @@ int memcmp(const void *lhs, const void *rhs, size_t len) {
 void *memchr(const void *ptr, int value, size_t len) {
   uint8_t *ptr8 = (uint8_t *)ptr;
   uint8_t value8 = (uint8_t)value;
+
+  if (len >= kWordBytes) {
+    uint32_t value32 = splat_8(value8);
+    while ((uintptr_t)ptr8 & kWordMask) {
+      if (*ptr8 == value8) {
+        return ptr8;
+      }
+      ++ptr8;
+      --len;
+    }
+    // Words without the value are skipped, the byte is located below.
+    for (; len >= kWordBytes; len -= kWordBytes) {
+      if (has_zero_byte(read_32(ptr8) ^ value32)) {
+        break;
+      }
+      ptr8 += kWordBytes;
+    }
+  }
   for (size_t i = 0; i < len; ++i) {
     if (ptr8[i] == value8) {
       return ptr8 + i;
@@ -76,6 +214,22 @@ void *memchr(const void *ptr, int value, size_t len) {
 void *memrchr(const void *ptr, int value, size_t len) {
   uint8_t *ptr8 = (uint8_t *)ptr;
   uint8_t value8 = (uint8_t)value;
+
+  // The region is searched from its end, `len` is the length still to search.
+  if (len >= kWordBytes) {
+    uint32_t value32 = splat_8(value8);
+    while ((uintptr_t)(ptr8 + len) & kWordMask) {
+      --len;
+      if (ptr8[len] == value8) {
+        return ptr8 + len;
+      }
+    }
+    for (; len >= kWordBytes; len -= kWordBytes) {
+      if (has_zero_byte(read_32(ptr8 + len - kWordBytes) ^ value32)) {
+        break;
+      }
+    }
+  }
   for (size_t i = 0; i < len; ++i) {
     size_t idx = len - i - 1;
     if (ptr8[idx] == value8) {
@@ -120,6 +120,13 @@ void mmio_region_memcpy_to_mmio32(mmio_region_t base, uint32_t offset,
   mmio_region_memcpy32(base, offset, (void *)src, len, false);
 }
 
+void mmio_region_write_script32(mmio_region_t base,
+                                const mmio_region_script_t *script) {
+  for (size_t i = 0; i < script->count; ++i) {
+    mmio_region_write32(base, (ptrdiff_t)script->offsets[i], script->values[i]);
+  }
+}
+
 // `extern` declarations to give the inline functions in the
 // corresponding header a link location.
 extern uint8_t mmio_region_read8(mmio_region_t base, ptrdiff_t offset);
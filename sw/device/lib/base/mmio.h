@@ -396,6 +396,30 @@ void mmio_region_memcpy_from_mmio32(mmio_region_t base, uint32_t offset,
 void mmio_region_memcpy_to_mmio32(mmio_region_t base, uint32_t offset,
                                   const void *src, size_t len);
 
+/**
+ * A register script: the register at `offsets[i]` (in bytes, word-aligned)
+ * of an MMIO region is written with `values[i]`, in the order of the tables.
+ *
+ * Both tables are also the format of the DMA in address mode, which applies
+ * the same script without the CPU (see `reg_script.h`).
+ */
+typedef struct mmio_region_script {
+  const uint32_t *offsets;
+  const uint32_t *values;
+  size_t count;
+} mmio_region_script_t;
+
+/**
+ * Writes the registers of a script with word-sized accesses, one after the
+ * other, as `mmio_region_memcpy_to_mmio32` for registers that are not
+ * consecutive.
+ *
+ * @param base the MMIO region to write to.
+ * @param script the offsets and values to write.
+ */
+void mmio_region_write_script32(mmio_region_t base,
+                                const mmio_region_script_t *script);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,255 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _BASE_RING_H_
+#define _BASE_RING_H_
+
+/**
+ * @file
+ * @brief Lock-free ring buffers of bytes
+ *
+ * A ring has one producer and one consumer, e.g. an interrupt handler and the
+ * main loop, or the main loop and a DMA transaction. The producer only moves
+ * the head and the consumer only moves the tail, each with a single store of
+ * its index, so neither side masks the interrupts. The indexes run freely
+ * and are masked with the size, a power of 2: the ring holds head - tail
+ * bytes and can be full.
+ *
+ * Besides the copies of ring_push and ring_pop, each side can work in place:
+ * ring_reserve gives the contiguous free space at the head, to be filled, by
+ * the CPU or by the DMA, and published with ring_commit; ring_peek gives the
+ * contiguous data at the tail, to be consumed and freed with ring_release.
+ * The segments end at the end of the buffer, so a DMA transaction on a
+ * segment needs no wrap around. Elements whose size is a power of 2, no
+ * larger than the ring, are never split.
+ *
+ * Several producers use a ring each, and the consumer drains them with
+ * ring_pop_any.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Orders the accesses to the data and to the indexes, for the compiler and
+ * the other harts.
+ */
+#define RING_BARRIER() asm volatile("fence" ::: "memory")
+
+/**
+ * A ring. Its fields are managed by the functions below.
+ */
+typedef struct ring {
+  uint8_t *buf;
+  uint32_t size;
+  volatile uint32_t head; /*!< Moved by the producer only. */
+  volatile uint32_t tail; /*!< Moved by the consumer only. */
+} ring_t;
+
+/**
+ * Initializes an empty ring.
+ * @param ring The ring.
+ * @param buf Its buffer, of size bytes.
+ * @param size A power of 2.
+ * @return false if size is not a power of 2.
+ */
+static inline bool ring_init(ring_t *ring, void *buf, uint32_t size) {
+  if (size == 0 || (size & (size - 1)) != 0) {
+    return false;
+  }
+  ring->buf = (uint8_t *)buf;
+  ring->size = size;
+  ring->head = 0;
+  ring->tail = 0;
+  return true;
+}
+
+/**
+ * The bytes in a ring. Exact for the consumer, a lower bound for the
+ * producer.
+ */
+static inline uint32_t ring_used(const ring_t *ring) {
+  return ring->head - ring->tail;
+}
+
+/**
+ * The free bytes of a ring. Exact for the producer, a lower bound for the
+ * consumer.
+ */
+static inline uint32_t ring_free(const ring_t *ring) {
+  return ring->size - (ring->head - ring->tail);
+}
+
+static inline bool ring_empty(const ring_t *ring) {
+  return ring->head == ring->tail;
+}
+
+static inline bool ring_full(const ring_t *ring) {
+  return ring->head - ring->tail == ring->size;
+}
+
+/**
+ * Producer: gives the contiguous free space at the head.
+ * @param ring The ring.
+ * @param[out] ptr The start of the space.
+ * @return Its size in bytes, 0 if the ring is full.
+ */
+static inline uint32_t ring_reserve(ring_t *ring, void **ptr) {
+  uint32_t head = ring->head;
+  uint32_t idx = head & (ring->size - 1);
+  uint32_t n = ring->size - (head - ring->tail);
+  if (n > ring->size - idx) {
+    n = ring->size - idx;
+  }
+  *ptr = &ring->buf[idx];
+  RING_BARRIER();
+  return n;
+}
+
+/**
+ * Producer: publishes bytes written to the space given by ring_reserve.
+ * @param ring The ring.
+ * @param len The bytes, at most the size of the space.
+ */
+static inline void ring_commit(ring_t *ring, uint32_t len) {
+  RING_BARRIER();
+  ring->head = ring->head + len;
+}
+
+/**
+ * Consumer: gives the contiguous data at the tail.
+ * @param ring The ring.
+ * @param[out] ptr The start of the data.
+ * @return Its size in bytes, 0 if the ring is empty.
+ */
+static inline uint32_t ring_peek(ring_t *ring, void **ptr) {
+  uint32_t tail = ring->tail;
+  uint32_t idx = tail & (ring->size - 1);
+  uint32_t n = ring->head - tail;
+  if (n > ring->size - idx) {
+    n = ring->size - idx;
+  }
+  *ptr = &ring->buf[idx];
+  RING_BARRIER();
+  return n;
+}
+
+/**
+ * Consumer: frees bytes of the data given by ring_peek.
+ * @param ring The ring.
+ * @param len The bytes, at most the size of the data.
+ */
+static inline void ring_release(ring_t *ring, uint32_t len) {
+  RING_BARRIER();
+  ring->tail = ring->tail + len;
+}
+
+/**
+ * Producer: copies as much of a buffer as fits, in at most two segments.
+ * @param ring The ring.
+ * @param data The bytes.
+ * @param len Their number.
+ * @return The bytes copied.
+ */
+static inline uint32_t ring_push(ring_t *ring, const void *data, uint32_t len) {
+  uint32_t done = 0;
+  while (done < len) {
+    void *ptr;
+    uint32_t n = ring_reserve(ring, &ptr);
+    if (n == 0) {
+      break;
+    }
+    if (n > len - done) {
+      n = len - done;
+    }
+    memcpy(ptr, (const uint8_t *)data + done, n);
+    ring_commit(ring, n);
+    done += n;
+  }
+  return done;
+}
+
+/**
+ * Consumer: copies and frees as many bytes as available, up to len.
+ * @param ring The ring.
+ * @param[out] data The bytes.
+ * @param len The most bytes to pop.
+ * @return The bytes copied.
+ */
+static inline uint32_t ring_pop(ring_t *ring, void *data, uint32_t len) {
+  uint32_t done = 0;
+  while (done < len) {
+    void *ptr;
+    uint32_t n = ring_peek(ring, &ptr);
+    if (n == 0) {
+      break;
+    }
+    if (n > len - done) {
+      n = len - done;
+    }
+    memcpy((uint8_t *)data + done, ptr, n);
+    ring_release(ring, n);
+    done += n;
+  }
+  return done;
+}
+
+/**
+ * Producer: pushes a whole element, or nothing if it does not fit.
+ * @return true if pushed.
+ */
+static inline bool ring_push_all(ring_t *ring, const void *data, uint32_t len) {
+  if (ring_free(ring) < len) {
+    return false;
+  }
+  ring_push(ring, data, len);
+  return true;
+}
+
+/**
+ * Consumer: pops a whole element, or nothing if it is not all there.
+ * @return true if popped.
+ */
+static inline bool ring_pop_all(ring_t *ring, void *data, uint32_t len) {
+  if (ring_used(ring) < len) {
+    return false;
+  }
+  ring_pop(ring, data, len);
+  return true;
+}
+
+/**
+ * Consumer of several rings: pops an element of len bytes from the first
+ * ring holding one, starting after the ring of the last call, so that a busy
+ * producer does not starve the others.
+ * @param rings The rings, one per producer.
+ * @param rings_n Their number.
+ * @param[in,out] next The ring to start with, updated; 0 on the first call.
+ * @param[out] data The element.
+ * @param len Its size.
+ * @return The index of the ring popped, or -1 if none holds an element.
+ */
+static inline int32_t ring_pop_any(ring_t *rings, uint32_t rings_n,
+                                   uint32_t *next, void *data, uint32_t len) {
+  for (uint32_t i = 0; i < rings_n; i++) {
+    uint32_t r = (*next + i) % rings_n;
+    if (ring_pop_all(&rings[r], data, len)) {
+      *next = (r + 1) % rings_n;
+      return (int32_t)r;
+    }
+  }
+  return -1;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // _BASE_RING_H_
@@ -0,0 +1,244 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : lzss.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   lzss.c
+* @date   14/10/26
+* @brief  Streaming compression of bytes with an LZ77 family code (LZSS) and
+* a fixed working set.
+*
+* A match is compared with the bytes before the buffer in the window and with
+* the buffer itself after, so the window only takes the end of each buffer
+* once it is encoded. The table keeps the low 16 bits of the positions: an
+* entry older than 64 KB may point anywhere in the window, which is harmless
+* since the bytes of the match are compared anyway.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "lzss.h"
+
+#include <string.h>
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#if LZSS_WINDOW_B > 4096 || ( LZSS_WINDOW_B & ( LZSS_WINDOW_B - 1 ) ) != 0
+#error "LZSS_WINDOW_B must be a power of 2 up to 4096"
+#endif
+
+#define LZSS_WINDOW_MASK    ( LZSS_WINDOW_B - 1 )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Returns the hash of the 3 bytes at p_in.
+ */
+static inline uint32_t hash3( const uint8_t *p_in );
+
+/**
+ * @brief Adds a token to the group, and writes the group once full.
+ * @param p_match 1 for a match, 0 for a literal.
+ * @param p_val The byte of a literal, or the two bytes of a match.
+ */
+static inline uint8_t *put_token( lzss_enc_t *p_enc, uint8_t *p_out, uint32_t p_match, uint32_t p_val );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void lzss_enc_init( lzss_enc_t *p_enc )
+{
+    memset( p_enc->hash, 0, sizeof( p_enc->hash ) );
+    p_enc->group_b = 0;
+    p_enc->group_n = 0;
+    p_enc->pos     = 0;
+}
+
+size_t lzss_encode( lzss_enc_t *p_enc, const uint8_t *p_in, size_t p_n, uint8_t *p_out )
+{
+    uint8_t  *out  = p_out;
+    uint32_t base  = p_enc->pos;
+    size_t   i     = 0;
+
+    while( i < p_n )
+    {
+        uint32_t cur = base + i;
+        uint32_t len = 0;
+        uint32_t dist;
+
+        if( i + LZSS_MATCH_MIN <= p_n )
+        {
+            uint32_t h = hash3( p_in + i );
+            dist = ( cur - p_enc->hash[ h ] ) & 0xFFFF;
+            p_enc->hash[ h ] = (uint16_t) cur;
+
+            if( dist != 0 && dist <= LZSS_WINDOW_B && dist <= cur )
+            {
+                size_t max = p_n - i < LZSS_MATCH_MAX ? p_n - i : LZSS_MATCH_MAX;
+                for( ; len < max; len++ )
+                {
+                    /* The bytes before the buffer are in the window. */
+                    size_t  j = i + len;
+                    uint8_t c = j >= dist ? p_in[ j - dist ]
+                                          : p_enc->window[ ( cur - dist + len ) & LZSS_WINDOW_MASK ];
+                    if( c != p_in[ j ] )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if( len >= LZSS_MATCH_MIN )
+        {
+            out = put_token( p_enc, out, 1, ( ( dist - 1 ) << 4 ) | ( len - LZSS_MATCH_MIN ) );
+            /* The positions inside the match are found by the next ones. */
+            for( size_t j = i + 1; j < i + len && j + LZSS_MATCH_MIN <= p_n; j++ )
+            {
+                p_enc->hash[ hash3( p_in + j ) ] = (uint16_t)( base + j );
+            }
+            i += len;
+        }
+        else
+        {
+            out = put_token( p_enc, out, 0, p_in[ i ] );
+            i++;
+        }
+    }
+
+    /* The window takes the end of the buffer. */
+    size_t keep = p_n < LZSS_WINDOW_B ? p_n : LZSS_WINDOW_B;
+    for( size_t j = p_n - keep; j < p_n; j++ )
+    {
+        p_enc->window[ ( base + j ) & LZSS_WINDOW_MASK ] = p_in[ j ];
+    }
+    p_enc->pos = base + p_n;
+
+    return (size_t)( out - p_out );
+}
+
+size_t lzss_flush( lzss_enc_t *p_enc, uint8_t *p_out )
+{
+    size_t n = p_enc->group_n ? p_enc->group_b : 0;
+    memcpy( p_out, p_enc->group, n );
+    p_enc->group_b = 0;
+    p_enc->group_n = 0;
+    return n;
+}
+
+size_t lzss_decode( const uint8_t *p_in, size_t p_in_b, uint8_t *p_out, size_t p_out_b )
+{
+    const uint8_t *end = p_in + p_in_b;
+    size_t   n     = 0;
+    uint32_t flags = 0;
+    uint32_t left  = 0;
+
+    while( p_in < end && n < p_out_b )
+    {
+        if( left == 0 )
+        {
+            flags = *p_in++;
+            left  = 8;
+            continue;
+        }
+        if( ( flags & 1 ) == 0 )
+        {
+            p_out[ n++ ] = *p_in++;
+        }
+        else
+        {
+            if( end - p_in < 2 )
+            {
+                break;
+            }
+            uint32_t val  = ( (uint32_t)p_in[ 0 ] << 8 ) | p_in[ 1 ];
+            uint32_t dist = ( val >> 4 ) + 1;
+            uint32_t len  = ( val & 0xF ) + LZSS_MATCH_MIN;
+            p_in += 2;
+            if( dist > n )
+            {
+                break;
+            }
+            /* Byte by byte, a match can overlap its own output. */
+            for( ; len > 0 && n < p_out_b; len--, n++ )
+            {
+                p_out[ n ] = p_out[ n - dist ];
+            }
+        }
+        flags >>= 1;
+        left--;
+    }
+    return n;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline uint32_t hash3( const uint8_t *p_in )
+{
+    uint32_t v = p_in[ 0 ] | ( (uint32_t)p_in[ 1 ] << 8 ) | ( (uint32_t)p_in[ 2 ] << 16 );
+    return ( v * 2654435761u ) >> ( 32 - LZSS_HASH_BITS );
+}
+
+static inline uint8_t *put_token( lzss_enc_t *p_enc, uint8_t *p_out, uint32_t p_match, uint32_t p_val )
+{
+    if( p_enc->group_n == 0 )
+    {
+        p_enc->group[ 0 ] = 0;
+        p_enc->group_b    = 1;
+    }
+    p_enc->group[ 0 ] |= (uint8_t)( p_match << p_enc->group_n );
+    if( p_match )
+    {
+        p_enc->group[ p_enc->group_b++ ] = (uint8_t)( p_val >> 8 );
+    }
+    p_enc->group[ p_enc->group_b++ ] = (uint8_t) p_val;
+
+    if( ++p_enc->group_n == 8 )
+    {
+        memcpy( p_out, p_enc->group, p_enc->group_b );
+        p_out += p_enc->group_b;
+        p_enc->group_n = 0;
+    }
+    return p_out;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
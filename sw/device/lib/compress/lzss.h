@@ -0,0 +1,166 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : lzss.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   lzss.h
+* @date   14/10/26
+* @brief  Streaming compression of bytes, e.g. logs or telemetry records,
+* with an LZ77 family code (LZSS) and a fixed working set.
+*
+* The encoder keeps the last LZSS_WINDOW_B bytes of the input, so the
+* buffers can be reused as soon as they are encoded, e.g. the one a DMA is
+* filling next, and a table of the last position of 2^LZSS_HASH_BITS hashes
+* of 3 bytes. The matches are searched greedily at a single position, the
+* last one with the same hash, and do not go past the end of a buffer. With
+* the defaults the encoder takes about 1.5 KB.
+*
+* Format: groups of a flag byte and up to 8 tokens. Bit i of the flag byte,
+* from the LSB, is 0 if token i is a literal, one byte, and 1 if it is a
+* match, two bytes: (distance - 1) << 4 | (length - LZSS_MATCH_MIN), MSB
+* first, which copies length bytes from distance bytes back in the output.
+* The stream ends with the last token: the decoder stops with the input.
+*/
+
+#ifndef _LZSS_H
+#define _LZSS_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The farthest a match can reach back, a power of 2 up to 4096.
+ */
+#ifndef LZSS_WINDOW_B
+#define LZSS_WINDOW_B       1024
+#endif
+
+/**
+ * The bits of the hashes, the table has 2^LZSS_HASH_BITS entries of 2 bytes.
+ */
+#ifndef LZSS_HASH_BITS
+#define LZSS_HASH_BITS      8
+#endif
+
+/**
+ * The lengths of the matches.
+ */
+#define LZSS_MATCH_MIN      3
+#define LZSS_MATCH_MAX      ( LZSS_MATCH_MIN + 15 )
+
+/**
+ * The bytes of a group, all tokens matches.
+ */
+#define LZSS_GROUP_B        ( 1 + 8 * 2 )
+
+/**
+ * Bytes written at most by lzss_encode for p_n bytes, including the group
+ * left by the previous call.
+ */
+#define LZSS_BOUND_B( p_n ) ( (p_n) + ( (p_n) + 7 ) / 8 + LZSS_GROUP_B )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * An encoder. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    uint8_t  window[ LZSS_WINDOW_B ];       /*!< The last bytes, at their
+    position modulo LZSS_WINDOW_B. */
+    uint16_t hash[ 1 << LZSS_HASH_BITS ];   /*!< The low bits of the last
+    position of each hash. */
+    uint8_t  group[ LZSS_GROUP_B ];         /*!< The group being filled. */
+    uint8_t  group_b;   /*!< Bytes in group, its flags included. */
+    uint8_t  group_n;   /*!< Tokens in group. */
+    uint32_t pos;       /*!< The bytes encoded so far. */
+} lzss_enc_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts a stream.
+ */
+void lzss_enc_init( lzss_enc_t *p_enc );
+
+/**
+ * @brief Encodes bytes. The tokens of a group are kept until it is full,
+ * so they are written by a later call or by lzss_flush.
+ * @param p_enc The encoder.
+ * @param p_in The bytes.
+ * @param p_n The number of bytes.
+ * @param p_out The bytes of the stream, at least LZSS_BOUND_B( p_n ).
+ * @return The number of bytes written.
+ */
+size_t lzss_encode( lzss_enc_t *p_enc, const uint8_t *p_in, size_t p_n, uint8_t *p_out );
+
+/**
+ * @brief Ends a stream, with the group being filled.
+ * @param p_enc The encoder, to be initialized again for a new stream.
+ * @param p_out The end of the stream, at least LZSS_GROUP_B bytes.
+ * @return The number of bytes written.
+ */
+size_t lzss_flush( lzss_enc_t *p_enc, uint8_t *p_out );
+
+/**
+ * @brief Decodes a whole stream.
+ * @param p_in The stream.
+ * @param p_in_b The bytes of the stream.
+ * @param p_out The bytes decoded.
+ * @param p_out_b The size of p_out.
+ * @return The number of bytes decoded, up to p_out_b, or up to the first
+ * match reaching before the start of the output in a corrupted stream.
+ */
+size_t lzss_decode( const uint8_t *p_in, size_t p_in_b, uint8_t *p_out, size_t p_out_b );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _LZSS_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,319 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : rice.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   rice.c
+* @date   14/10/26
+* @brief  Streaming compression of sensor samples: a fixed linear predictor
+* followed by adaptive Rice codes of the residuals.
+*
+* The bits are gathered in a word and written a byte at a time, so a write
+* of up to 25 bits never overflows the word with the 7 bits left of the
+* previous one. The long fields, the full residuals, are written in two.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "rice.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Largest code parameter, so that the low bits of u fit in one write.
+ */
+#define RICE_K_MAX  24
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Returns the prediction of the next sample of a channel and shifts
+ * the sample into its predictor.
+ */
+static inline int32_t predict( rice_chan_t *p_chan, uint8_t p_order, int32_t p_x );
+
+/**
+ * @brief Returns the code parameter of the next sample of a channel.
+ */
+static inline uint32_t param( const rice_chan_t *p_chan );
+
+/**
+ * @brief Adds the mapped residual of a sample to the statistics of its
+ * channel.
+ */
+static inline void update( rice_chan_t *p_chan, uint32_t p_u );
+
+/**
+ * @brief Returns true if a format is in its limits and starts the channels.
+ */
+static bool start( const rice_cfg_t *p_cfg, rice_chan_t *p_chan );
+
+/**
+ * @brief Writes the p_bits low bits of p_val, at most 25.
+ */
+static inline uint8_t *put_bits( rice_enc_t *p_enc, uint8_t *p_out, uint32_t p_val, uint32_t p_bits );
+
+/**
+ * @brief Encodes a sample, sign-extended from the bits of the stream.
+ */
+static inline uint8_t *encode_sample( rice_enc_t *p_enc, uint8_t *p_out, int32_t p_x );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+bool rice_enc_init( rice_enc_t *p_enc, const rice_cfg_t *p_cfg )
+{
+    if( !start( p_cfg, p_enc->chan ) )
+    {
+        return false;
+    }
+    p_enc->cfg   = *p_cfg;
+    p_enc->ch    = 0;
+    p_enc->acc_n = 0;
+    p_enc->acc   = 0;
+    return true;
+}
+
+size_t rice_encode( rice_enc_t *p_enc, const int32_t *p_in, size_t p_n, uint8_t *p_out )
+{
+    uint8_t *out = p_out;
+    uint32_t shift = 32 - p_enc->cfg.bits;
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        out = encode_sample( p_enc, out, (int32_t)( (uint32_t)p_in[ i ] << shift ) >> shift );
+    }
+    return (size_t)( out - p_out );
+}
+
+size_t rice_encode16( rice_enc_t *p_enc, const int16_t *p_in, size_t p_n, uint8_t *p_out )
+{
+    uint8_t *out = p_out;
+    uint32_t shift = 32 - p_enc->cfg.bits;
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        out = encode_sample( p_enc, out, (int32_t)( (uint32_t)p_in[ i ] << shift ) >> shift );
+    }
+    return (size_t)( out - p_out );
+}
+
+size_t rice_flush( rice_enc_t *p_enc, uint8_t *p_out )
+{
+    if( p_enc->acc_n == 0 )
+    {
+        return 0;
+    }
+    /* Zeros up to the byte. */
+    put_bits( p_enc, p_out, 0, 8 - p_enc->acc_n );
+    return 1;
+}
+
+size_t rice_decode( const rice_cfg_t *p_cfg,
+                    const uint8_t    *p_in,
+                    size_t           p_in_b,
+                    int32_t          *p_out,
+                    size_t           p_n )
+{
+    rice_chan_t chans[ RICE_CHANNELS_MAX ];
+    if( !start( p_cfg, chans ) )
+    {
+        return 0;
+    }
+
+    const uint8_t  *end = p_in + p_in_b;
+    const uint32_t raw  = p_cfg->bits + p_cfg->order;
+    const uint32_t hi   = raw > 16 ? raw - 16 : 0;
+    uint32_t acc   = 0;
+    uint32_t acc_n = 0;
+    uint32_t ch    = 0;
+
+    /* Makes sure acc holds at least p_bits bits, at most 25, or leaves. */
+#define RICE_NEED( p_bits )                                             \
+    while( acc_n < (p_bits) )                                           \
+    {                                                                   \
+        if( p_in == end ) { return i; }                                 \
+        acc    = ( acc << 8 ) | *p_in++;                                \
+        acc_n += 8;                                                     \
+    }
+#define RICE_TAKE( p_bits ) \
+    ( acc_n -= (p_bits), ( acc >> acc_n ) & ( ( 1u << (p_bits) ) - 1 ) )
+
+    size_t i;
+    for( i = 0; i < p_n; i++ )
+    {
+        rice_chan_t *chan = &chans[ ch ];
+        uint32_t k = param( chan );
+        uint32_t q = 0;
+        uint32_t u;
+
+        /* The unary quotient, up to its zero or to RICE_Q_MAX ones. */
+        for( ;; )
+        {
+            RICE_NEED( 1 );
+            if( RICE_TAKE( 1 ) == 0 )
+            {
+                break;
+            }
+            if( ++q == RICE_Q_MAX )
+            {
+                break;
+            }
+        }
+        if( q < RICE_Q_MAX )
+        {
+            RICE_NEED( k );
+            u = ( q << k ) | ( k ? RICE_TAKE( k ) : 0 );
+        }
+        else
+        {
+            RICE_NEED( hi );
+            u = hi ? RICE_TAKE( hi ) << ( raw - hi ) : 0;
+            RICE_NEED( raw - hi );
+            u |= RICE_TAKE( raw - hi );
+        }
+        update( chan, u );
+
+        int32_t r = (int32_t)( u >> 1 ) ^ -(int32_t)( u & 1 );
+        int32_t x = predict( chan, p_cfg->order, 0 ) + r;
+        chan->prev[ 0 ] = x;
+        p_out[ i ] = x;
+        ch = ( ch + 1 == p_cfg->channels ) ? 0 : ch + 1;
+    }
+#undef RICE_NEED
+#undef RICE_TAKE
+    return i;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline int32_t predict( rice_chan_t *p_chan, uint8_t p_order, int32_t p_x )
+{
+    int32_t pred;
+    switch( p_order )
+    {
+        case 0:  pred = 0;                                          break;
+        case 1:  pred = p_chan->prev[ 0 ];                          break;
+        default: pred = 2 * p_chan->prev[ 0 ] - p_chan->prev[ 1 ];  break;
+    }
+    p_chan->prev[ 1 ] = p_chan->prev[ 0 ];
+    p_chan->prev[ 0 ] = p_x;
+    return pred;
+}
+
+static inline uint32_t param( const rice_chan_t *p_chan )
+{
+    uint32_t k = 0;
+    while( k < RICE_K_MAX && ( p_chan->n << k ) < p_chan->a )
+    {
+        k++;
+    }
+    return k;
+}
+
+static inline void update( rice_chan_t *p_chan, uint32_t p_u )
+{
+    p_chan->a += p_u;
+    if( ++p_chan->n == RICE_RESET )
+    {
+        p_chan->a >>= 1;
+        p_chan->n >>= 1;
+    }
+}
+
+static bool start( const rice_cfg_t *p_cfg, rice_chan_t *p_chan )
+{
+    if(     p_cfg->bits < 2 || p_cfg->bits > RICE_BITS_MAX
+        ||  p_cfg->order > RICE_ORDER_MAX
+        ||  p_cfg->channels < 1 || p_cfg->channels > RICE_CHANNELS_MAX )
+    {
+        return false;
+    }
+    for( uint32_t c = 0; c < RICE_CHANNELS_MAX; c++ )
+    {
+        p_chan[ c ] = (rice_chan_t){ .prev = { 0 }, .a = RICE_A_INIT, .n = 1 };
+    }
+    return true;
+}
+
+static inline uint8_t *put_bits( rice_enc_t *p_enc, uint8_t *p_out, uint32_t p_val, uint32_t p_bits )
+{
+    uint32_t acc = ( p_enc->acc << p_bits ) | p_val;
+    uint32_t n   = p_enc->acc_n + p_bits;
+    while( n >= 8 )
+    {
+        n -= 8;
+        *p_out++ = (uint8_t)( acc >> n );
+    }
+    p_enc->acc   = acc & ( ( 1u << n ) - 1 );
+    p_enc->acc_n = (uint8_t)n;
+    return p_out;
+}
+
+static inline uint8_t *encode_sample( rice_enc_t *p_enc, uint8_t *p_out, int32_t p_x )
+{
+    rice_chan_t *chan = &p_enc->chan[ p_enc->ch ];
+    int32_t  r = p_x - predict( chan, p_enc->cfg.order, p_x );
+    uint32_t u = ( (uint32_t)r << 1 ) ^ (uint32_t)( r >> 31 );
+    uint32_t k = param( chan );
+    uint32_t q = u >> k;
+
+    if( q < RICE_Q_MAX )
+    {
+        /* q ones and a zero, then the k low bits. */
+        p_out = put_bits( p_enc, p_out, ( 1u << ( q + 1 ) ) - 2, q + 1 );
+        p_out = put_bits( p_enc, p_out, u & ( ( 1u << k ) - 1 ), k );
+    }
+    else
+    {
+        /* RICE_Q_MAX ones, then u in two writes of at most 16 bits. */
+        uint32_t raw = p_enc->cfg.bits + p_enc->cfg.order;
+        uint32_t lo  = raw > 16 ? 16 : raw;
+        p_out = put_bits( p_enc, p_out, ( 1u << RICE_Q_MAX ) - 1, RICE_Q_MAX );
+        p_out = put_bits( p_enc, p_out, u >> lo, raw - lo );
+        p_out = put_bits( p_enc, p_out, u & ( ( 1u << lo ) - 1 ), lo );
+    }
+    update( chan, u );
+
+    p_enc->ch = ( p_enc->ch + 1 == p_enc->cfg.channels ) ? 0 : p_enc->ch + 1;
+    return p_out;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
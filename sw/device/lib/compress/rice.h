@@ -0,0 +1,202 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : rice.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   rice.h
+* @date   14/10/26
+* @brief  Streaming compression of sensor samples: a fixed linear predictor
+* followed by adaptive Rice codes of the residuals.
+*
+* The samples are the low bits of 32-bit words, e.g. of the buffers of I2S or
+* PDM2PCM filled by the DMA, or 16-bit integers. Each channel of interleaved
+* samples (e.g. left and right) has its own predictor, of order 0 (none), 1
+* (the previous sample) or 2 (the line through the two previous samples), and
+* its own code parameter. The buffers are encoded one after the other, the
+* state of about 40 bytes carries the predictors from one to the next.
+*
+* Format, MSB first: each residual r, mapped to u = 2r for r >= 0 and
+* -2r - 1 otherwise, is coded as q = u >> k ones, a zero and the k low bits
+* of u. If q reaches RICE_Q_MAX, RICE_Q_MAX ones are followed by the bits +
+* order bits of u instead. k is the smallest value with n << k >= a, with a
+* the sum of the last u of the channel and n their number, both halved every
+* RICE_RESET samples and starting at RICE_A_INIT and 1. The stream ends with
+* zeros up to a byte, and has no header: the decoder is given the
+* configuration and the number of samples.
+*
+* Slowly varying signals take a few bits per sample; white noise takes about
+* its number of bits plus one.
+*/
+
+#ifndef _RICE_H
+#define _RICE_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Limits of the configuration.
+ */
+#define RICE_BITS_MAX       24
+#define RICE_ORDER_MAX      2
+#define RICE_CHANNELS_MAX   2
+
+/**
+ * Quotient from which a residual is written in full.
+ */
+#define RICE_Q_MAX          16
+
+/**
+ * Samples of a channel after which its statistics are halved.
+ */
+#define RICE_RESET          32
+
+/**
+ * Initial sum of the statistics of a channel.
+ */
+#define RICE_A_INIT         16
+
+/**
+ * Bytes written at most by rice_encode for p_n samples, including the bits
+ * left by the previous call.
+ */
+#define RICE_BOUND_B( p_n, p_bits, p_order ) \
+    ( ( (p_n) * ( RICE_Q_MAX + (p_bits) + (p_order) ) + 7 ) / 8 + 1 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The format of a stream, the same for the encoder and the decoder.
+ */
+typedef struct
+{
+    uint8_t bits;       /*!< Bits of the samples, 2 to RICE_BITS_MAX. */
+    uint8_t order;      /*!< Order of the predictor, 0 to RICE_ORDER_MAX. */
+    uint8_t channels;   /*!< Interleaved channels, 1 to RICE_CHANNELS_MAX. */
+} rice_cfg_t;
+
+/**
+ * The predictor and statistics of a channel.
+ */
+typedef struct
+{
+    int32_t  prev[ RICE_ORDER_MAX ];    /*!< The last samples, newest first. */
+    uint32_t a;         /*!< Sum of the last mapped residuals. */
+    uint32_t n;         /*!< Number of the last mapped residuals. */
+} rice_chan_t;
+
+/**
+ * An encoder. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    rice_cfg_t  cfg;
+    uint8_t     ch;         /*!< Channel of the next sample. */
+    uint8_t     acc_n;      /*!< Bits pending in acc, fewer than 8. */
+    uint32_t    acc;        /*!< Bits not written yet, in the low bits. */
+    rice_chan_t chan[ RICE_CHANNELS_MAX ];
+} rice_enc_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts a stream.
+ * @param p_enc The encoder.
+ * @param p_cfg The format of the stream.
+ * @return false if the format is out of its limits.
+ */
+bool rice_enc_init( rice_enc_t *p_enc, const rice_cfg_t *p_cfg );
+
+/**
+ * @brief Encodes samples, the low bits of 32-bit words. The bits above are
+ * ignored.
+ * @param p_enc The encoder.
+ * @param p_in The samples, interleaved if there are several channels.
+ * @param p_n The number of samples.
+ * @param p_out The bytes of the stream, at least RICE_BOUND_B( p_n, bits,
+ * order ).
+ * @return The number of bytes written.
+ */
+size_t rice_encode( rice_enc_t *p_enc, const int32_t *p_in, size_t p_n, uint8_t *p_out );
+
+/**
+ * @brief Encodes 16-bit samples, like rice_encode.
+ */
+size_t rice_encode16( rice_enc_t *p_enc, const int16_t *p_in, size_t p_n, uint8_t *p_out );
+
+/**
+ * @brief Ends a stream, with the bits still pending.
+ * @param p_enc The encoder, to be initialized again for a new stream.
+ * @param p_out The last byte of the stream.
+ * @return The number of bytes written, 0 or 1.
+ */
+size_t rice_flush( rice_enc_t *p_enc, uint8_t *p_out );
+
+/**
+ * @brief Decodes a whole stream.
+ * @param p_cfg The format of the stream.
+ * @param p_in The stream.
+ * @param p_in_b The bytes of the stream.
+ * @param p_out The samples, sign-extended from their bits.
+ * @param p_n The number of samples of the stream.
+ * @return The number of samples decoded, fewer than p_n if the stream is
+ * short or the format out of its limits.
+ */
+size_t rice_decode( const rice_cfg_t *p_cfg,
+                    const uint8_t    *p_in,
+                    size_t           p_in_b,
+                    int32_t          *p_out,
+                    size_t           p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _RICE_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,251 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : ams.c                                                        **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   ams.c
+* @date   14/10/2026
+* @brief  HAL of the AMS peripheral
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "ams.h"
+
+#include "mmio.h"
+#include "bitfield.h"
+#include "soc_ctrl.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define ams_base mmio_region_from_addr((uintptr_t)AMS_START_ADDRESS)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Sets or clears a bit of the CTRL register
+ */
+static void ams_ctrl_write_bit(uint32_t bit, bool value);
+
+/**
+ * Window done callback of the stream, calls the frame callback
+ */
+static void ams_capture_frame_done(dma_stream_t *stream, uint32_t slot);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+__attribute__((weak)) void handler_irq_ams(uint32_t id)
+{
+  // Replace this function with a non-weak implementation, the interrupt is
+  // raised again as long as the alert is not cleared
+  ams_set_alert_interrupt(false);
+}
+
+void ams_set_threshold(ams_threshold_t threshold)
+{
+  mmio_region_write32(ams_base, AMS_SEL_REG_OFFSET, threshold & AMS_SEL_VALUE_MASK);
+}
+
+bool ams_read(void)
+{
+  return mmio_region_get_bit32(ams_base, AMS_GET_REG_OFFSET, AMS_GET_VALUE_BIT);
+}
+
+ams_result_t ams_sampling_start(uint32_t period_cycles)
+{
+  if (ams_is_sampling()) {
+    return kAmsBusy;
+  }
+  if (period_cycles == 0) {
+    return kAmsError;
+  }
+  mmio_region_write32(ams_base, AMS_PERIOD_REG_OFFSET, period_cycles - 1);
+  ams_ctrl_write_bit(AMS_CTRL_EN_BIT, true);
+  return kAmsOk;
+}
+
+void ams_sampling_stop(void)
+{
+  ams_ctrl_write_bit(AMS_CTRL_EN_BIT, false);
+}
+
+bool ams_is_sampling(void)
+{
+  return mmio_region_get_bit32(ams_base, AMS_CTRL_REG_OFFSET, AMS_CTRL_EN_BIT);
+}
+
+bool ams_sample_valid(void)
+{
+  return mmio_region_get_bit32(ams_base, AMS_STATUS_REG_OFFSET, AMS_STATUS_VALID_BIT);
+}
+
+uint32_t ams_read_sample(void)
+{
+  return mmio_region_read32(ams_base, AMS_SAMPLE_REG_OFFSET);
+}
+
+bool ams_sample_overrun(void)
+{
+  return mmio_region_get_bit32(ams_base, AMS_STATUS_REG_OFFSET, AMS_STATUS_OVERRUN_BIT);
+}
+
+void ams_set_alert_interrupt(bool enable)
+{
+  ams_clear_alert();
+  ams_ctrl_write_bit(AMS_CTRL_INTR_EN_BIT, enable);
+}
+
+bool ams_alert(void)
+{
+  return mmio_region_get_bit32(ams_base, AMS_STATUS_REG_OFFSET, AMS_STATUS_ALERT_BIT);
+}
+
+void ams_clear_alert(void)
+{
+  // CLEAR_ALERT is cleared by the hardware
+  ams_ctrl_write_bit(AMS_CTRL_CLEAR_ALERT_BIT, true);
+}
+
+ams_result_t ams_capture_start(ams_capture_t *capture, const ams_capture_cfg_t *cfg)
+{
+  if (ams_is_sampling()) {
+    return kAmsBusy;
+  }
+  if (cfg->frames < 2 || cfg->frame_len == 0 || cfg->sample_rate_hz == 0
+      || cfg->buffer == NULL || ((uint32_t) cfg->buffer & 3)) {
+    return kAmsError;
+  }
+  capture->cfg = *cfg;
+
+  soc_ctrl_t soc_ctrl;
+  soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+  uint32_t period = (soc_ctrl_get_frequency(&soc_ctrl) + cfg->sample_rate_hz / 2) / cfg->sample_rate_hz;
+  if (period == 0) {
+    return kAmsError;
+  }
+
+  ams_set_threshold(cfg->threshold);
+
+  capture->src = (dma_target_t) {
+    .ptr     = (uint8_t *) AMS_SAMPLE_ADDRESS,
+    .inc_du  = 0,
+    .size_du = cfg->frames * cfg->frame_len,
+    .trig    = DMA_TRIG_SLOT_EXT_RX,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  capture->dst = (dma_target_t) {
+    .ptr    = (uint8_t *) cfg->buffer,
+    .inc_du = 1,
+    .trig   = DMA_TRIG_MEMORY,
+    .type   = DMA_DATA_TYPE_WORD,
+  };
+  capture->trans = (dma_trans_t) {
+    .src     = &capture->src,
+    .dst     = &capture->dst,
+    .channel = cfg->dma_ch,
+  };
+
+  // the DMA waits for the first sample before the sampling is started
+  if (dma_stream_start(&capture->stream, &capture->trans, cfg->frames,
+                       ams_capture_frame_done, capture) & DMA_CONFIG_CRITICAL_ERROR) {
+    return kAmsError;
+  }
+
+  ams_set_alert_interrupt(cfg->wake_on_alert);
+  return ams_sampling_start(period);
+}
+
+void ams_capture_stop(ams_capture_t *capture)
+{
+  // the DMA cannot be aborted, so it fills the ring buffer up to its end
+  // before the sampling is stopped
+  dma_stream_stop(&capture->stream);
+  while (!dma_is_ready(capture->cfg.dma_ch)) ;
+  ams_set_alert_interrupt(false);
+  ams_sampling_stop();
+}
+
+const uint32_t *ams_capture_peek(ams_capture_t *capture)
+{
+  return (const uint32_t *) dma_stream_peek(&capture->stream);
+}
+
+void ams_capture_release(ams_capture_t *capture)
+{
+  dma_stream_release(&capture->stream);
+}
+
+void ams_capture_get_stats(ams_capture_t *capture, ams_capture_stats_t *stats)
+{
+  stats->frames = capture->stream.produced;
+  stats->overruns = capture->stream.overruns;
+  stats->sample_overrun = ams_sample_overrun();
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void ams_ctrl_write_bit(uint32_t bit, bool value)
+{
+  uint32_t ctrl = mmio_region_read32(ams_base, AMS_CTRL_REG_OFFSET);
+  // CLEAR_ALERT reads as 0 once applied, so it is not written again
+  ctrl = bitfield_bit32_write(ctrl, bit, value);
+  mmio_region_write32(ams_base, AMS_CTRL_REG_OFFSET, ctrl);
+}
+
+static void ams_capture_frame_done(dma_stream_t *stream, uint32_t slot)
+{
+  ams_capture_t *capture = (ams_capture_t *) stream->ctx;
+  if (capture->cfg.cb != NULL) {
+    capture->cfg.cb(capture, (const uint32_t *) (stream->trans->dst->ptr + slot * stream->slot_b));
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
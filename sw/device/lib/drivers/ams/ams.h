@@ -0,0 +1,341 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : ams.h                                                        **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   ams.h
+* @date   14/10/2026
+* @brief  HAL of the AMS peripheral
+*
+* The AMS is an external peripheral of the testbench with a 1-bit ADC: its
+* output is 1 while the analog input is above the threshold selected by
+* ams_set_threshold (20%, 40%, 60% or 80% of VDD). It is read once with
+* ams_read, or sampled every period by the pacing counter of the peripheral,
+* with no CPU involved: the latest sample triggers the DMA_TRIG_SLOT_EXT_RX
+* slot of the DMA until it is read.
+*
+* The capture moves the samples to a ring buffer of frames with the DMA, as a
+* dma_stream_t: the CPU can sleep, and the other peripherals be clock or power
+* gated, until the window done interrupt of the DMA at the end of each frame.
+* The application reads the oldest frames with ams_capture_peek and gives them
+* back with ams_capture_release. With wake_on_alert, the first sample above
+* the threshold also raises the interrupt AMS_INTR_ID of the PLIC, whose
+* handler is handler_irq_ams, so that a threshold crossing wakes up the CPU
+* before the end of the frame.
+*
+* dma_init() must be called before the capture, and the handler of the window
+* done interrupt of the DMA must not be overridden.
+*/
+
+#ifndef _DRIVERS_AMS_H_
+#define _DRIVERS_AMS_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "core_v_mini_mcu.h"
+#include "ams_regs.h"
+#include "dma.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Address of the AMS in the external peripherals of the testbench
+ */
+#define AMS_START_ADDRESS (EXT_PERIPHERAL_START_ADDRESS + 0x1000)
+
+/**
+ * Address of the latest sample, to be passed to the DMA
+ */
+#define AMS_SAMPLE_ADDRESS (uint32_t)(AMS_SAMPLE_REG_OFFSET+AMS_START_ADDRESS)
+
+/**
+ * Interrupt of the PLIC the testbench connects the AMS to
+ */
+#define AMS_INTR_ID EXT_INTR_2
+
+/**
+ * ADC output and index from the start of the sampling of a sample, the
+ * index wraps every 65536 samples
+ */
+#define AMS_SAMPLE_VALUE(sample) ((sample) & 0x1)
+#define AMS_SAMPLE_INDEX(sample) ((sample) >> 16)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The result of an AMS operation.
+ */
+typedef enum ams_result {
+  /**
+   * Indicates that the operation succeeded.
+   */
+  kAmsOk = 0,
+  /**
+   * The sampling is running.
+   */
+  kAmsBusy = 1,
+  /**
+   * A parameter is not valid, or the DMA rejected the transfer.
+   */
+  kAmsError = 2,
+} ams_result_t;
+
+/**
+ * Threshold of the ADC, in VDD.
+ */
+typedef enum ams_threshold {
+  kAmsThreshold20 = 0,
+  kAmsThreshold40 = 1,
+  kAmsThreshold60 = 2,
+  kAmsThreshold80 = 3,
+} ams_threshold_t;
+
+
+struct ams_capture;
+
+/**
+ * Called from the DMA interrupt when a frame has been filled.
+ *
+ * @param capture the capture
+ * @param frame the samples of the frame
+ */
+typedef void (*ams_capture_cb_t)(struct ams_capture *capture, const uint32_t *frame);
+
+
+typedef struct ams_capture_cfg {
+  /**
+   * Threshold of the ADC.
+   */
+  ams_threshold_t threshold;
+  /**
+   * Samples per second, from the system clock.
+   */
+  uint32_t sample_rate_hz;
+  /**
+   * Samples in a frame.
+   */
+  uint32_t frame_len;
+  /**
+   * Frames of the ring buffer, at least 2.
+   */
+  uint32_t frames;
+  /**
+   * The ring buffer, of frames * frame_len words.
+   */
+  uint32_t *buffer;
+  /**
+   * DMA channel of the capture.
+   */
+  uint8_t dma_ch;
+  /**
+   * Enables the interrupt of the first sample above the threshold.
+   */
+  bool wake_on_alert;
+  /**
+   * Frame callback, it may be NULL.
+   */
+  ams_capture_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+} ams_capture_cfg_t;
+
+
+typedef struct ams_capture_stats {
+  /**
+   * Frames filled since the start.
+   */
+  uint32_t frames;
+  /**
+   * Frames overwritten by the DMA before they were released.
+   */
+  uint32_t overruns;
+  /**
+   * A sample was taken before the DMA had read the previous one.
+   */
+  bool sample_overrun;
+} ams_capture_stats_t;
+
+
+/**
+ * A capture. Its fields are managed by the functions below.
+ */
+typedef struct ams_capture {
+  ams_capture_cfg_t cfg;
+  dma_target_t src;
+  dma_target_t dst;
+  dma_trans_t trans;
+  dma_stream_t stream;
+} ams_capture_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Attends the plic interrupt.
+ */
+__attribute__((weak)) void handler_irq_ams(uint32_t id);
+
+/**
+ * Selects the threshold of the ADC
+ */
+void ams_set_threshold(ams_threshold_t threshold);
+
+/**
+ * @return the ADC output, true above the threshold
+ */
+bool ams_read(void);
+
+/**
+ * Starts the sampling of the ADC output by the pacing counter
+ *
+ * The first sample is taken period_cycles after the start.
+ *
+ * @param period_cycles cycles of the system clock between two samples
+ *
+ * @return kAmsOk success
+ * @return kAmsBusy the sampling is already running
+ * @return kAmsError period_cycles is 0
+ */
+ams_result_t ams_sampling_start(uint32_t period_cycles);
+
+/**
+ * Stops the sampling, and clears the latest sample and the overrun
+ */
+void ams_sampling_stop(void);
+
+/**
+ * @return true if the sampling runs
+ */
+bool ams_is_sampling(void);
+
+/**
+ * @return true if the latest sample has not been read
+ */
+bool ams_sample_valid(void);
+
+/**
+ * Reads the latest sample, see AMS_SAMPLE_VALUE and AMS_SAMPLE_INDEX
+ */
+uint32_t ams_read_sample(void);
+
+/**
+ * @return true if a sample was taken before the previous one was read
+ */
+bool ams_sample_overrun(void);
+
+/**
+ * Enables or disables the interrupt raised once a sample is above the
+ * threshold, and clears the alert
+ *
+ * The interrupt is a level: the handler must clear the alert with
+ * ams_clear_alert, or disable it.
+ */
+void ams_set_alert_interrupt(bool enable);
+
+/**
+ * @return true if a sample was above the threshold since the alert was cleared
+ */
+bool ams_alert(void);
+
+/**
+ * Clears the alert
+ */
+void ams_clear_alert(void);
+
+/**
+ * Starts the stream of the DMA and the sampling
+ *
+ * @param capture the capture, it must be a static variable
+ * @param cfg configuration, copied
+ *
+ * @return kAmsOk success
+ * @return kAmsBusy the sampling is already running
+ * @return kAmsError wrong configuration or DMA error
+ */
+ams_result_t ams_capture_start(ams_capture_t *capture, const ams_capture_cfg_t *cfg);
+
+/**
+ * Stops the DMA and the sampling
+ *
+ * Returns once the DMA has filled the ring buffer up to its end, the frames
+ * filled in the meantime are delivered as usual.
+ */
+void ams_capture_stop(ams_capture_t *capture);
+
+/**
+ * Gets the oldest frame filled and not released yet
+ *
+ * @return pointer to the samples, NULL if there is none
+ */
+const uint32_t *ams_capture_peek(ams_capture_t *capture);
+
+/**
+ * Releases the oldest filled frame, so that the DMA can fill it again
+ */
+void ams_capture_release(ams_capture_t *capture);
+
+/**
+ * Reads the counters of the capture
+ *
+ * @param stats the counters
+ */
+void ams_capture_get_stats(ams_capture_t *capture, ams_capture_stats_t *stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_AMS_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
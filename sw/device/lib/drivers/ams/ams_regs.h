@@ -27,6 +27,24 @@ extern "C" {
 #define AMS_GET_REG_OFFSET 0x4
 #define AMS_GET_VALUE_BIT 0
 
+// Periodic sampling control
+#define AMS_CTRL_REG_OFFSET 0x8
+#define AMS_CTRL_EN_BIT 0
+#define AMS_CTRL_INTR_EN_BIT 1
+#define AMS_CTRL_CLEAR_ALERT_BIT 2
+
+// Sampling period
+#define AMS_PERIOD_REG_OFFSET 0xc
+
+// Latest sample, the DMA trigger is set while it has not been read
+#define AMS_SAMPLE_REG_OFFSET 0x10
+
+// Status of the periodic sampling
+#define AMS_STATUS_REG_OFFSET 0x14
+#define AMS_STATUS_VALID_BIT 0
+#define AMS_STATUS_OVERRUN_BIT 1
+#define AMS_STATUS_ALERT_BIT 2
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
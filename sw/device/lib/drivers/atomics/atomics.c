@@ -0,0 +1,20 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "atomics.h"
+
+bool atomics_compare_and_swap(uint32_t word, uint32_t expected, uint32_t desired) {
+  // Writing the expected value arms the CAS, any CAS read disarms it
+  mmio_region_write32(atomics_base, ATOMICS_CAS_EXPECT_REG_OFFSET, expected);
+  mmio_region_write32(atomics_base, ATOMICS_CAS_NEW_REG_OFFSET, desired);
+  return mmio_region_read32(atomics_base, ATOMICS_CAS_REG_OFFSET + 4 * word) & 1;
+}
+
+uint32_t atomics_fetch_add(uint32_t word, uint32_t value) {
+  uint32_t old;
+  do {
+    old = atomics_load(word);
+  } while (!atomics_compare_and_swap(word, old, old + value));
+  return old;
+}
@@ -0,0 +1,127 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DRIVERS_ATOMICS_H_
+#define _DRIVERS_ATOMICS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mmio.h"
+#include "core_v_mini_mcu.h"
+#include "atomics_regs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The atomic unit holds ATOMICS_WORDS words in the always-on peripherals,
+ * at ATOMICS_START_ADDRESS. Each operation below but the compare-and-swap
+ * is a single load or store, so it is atomic with respect to the
+ * interrupts, the DMA and the other harts without masking the interrupts:
+ * the interrupts and the main loop can share counters, locks and the
+ * indices of rings. The words are cleared at reset, unsigned and wrap
+ * around. The application chooses the use of each word.
+ */
+#define ATOMICS_WORDS ATOMICS_PARAM_NUM_WORDS
+
+#define atomics_base mmio_region_from_addr((uintptr_t)ATOMICS_START_ADDRESS)
+
+/**
+ * Read a word.
+ * @param word Index of the word, less than ATOMICS_WORDS.
+ */
+static inline uint32_t atomics_load(uint32_t word) {
+  return mmio_region_read32(atomics_base, ATOMICS_VALUE_REG_OFFSET + 4 * word);
+}
+
+/**
+ * Write a word.
+ * @param word Index of the word.
+ * @param value The new value.
+ */
+static inline void atomics_store(uint32_t word, uint32_t value) {
+  mmio_region_write32(atomics_base, ATOMICS_VALUE_REG_OFFSET + 4 * word, value);
+}
+
+/**
+ * Set a word to 1 and return its previous value, 0 if the caller set it.
+ * @param word Index of the word.
+ */
+static inline uint32_t atomics_test_and_set(uint32_t word) {
+  return mmio_region_read32(atomics_base, ATOMICS_TAS_REG_OFFSET + 4 * word);
+}
+
+/**
+ * Increment a word and return its previous value.
+ * @param word Index of the word.
+ */
+static inline uint32_t atomics_fetch_inc(uint32_t word) {
+  return mmio_region_read32(atomics_base, ATOMICS_FETCH_INC_REG_OFFSET + 4 * word);
+}
+
+/**
+ * Decrement a word and return its previous value.
+ * @param word Index of the word.
+ */
+static inline uint32_t atomics_fetch_dec(uint32_t word) {
+  return mmio_region_read32(atomics_base, ATOMICS_FETCH_DEC_REG_OFFSET + 4 * word);
+}
+
+/**
+ * Add a value to a word, e.g. the bytes a DMA transaction wrote to a ring.
+ * @param word Index of the word.
+ * @param value Value added, subtracted if negative in two's complement.
+ */
+static inline void atomics_add(uint32_t word, uint32_t value) {
+  mmio_region_write32(atomics_base, ATOMICS_ADD_REG_OFFSET + 4 * word, value);
+}
+
+/**
+ * Take a lock held in a word, spinning while another context holds it. An
+ * interrupt handler must only try it with atomics_test_and_set, as the
+ * context it interrupted may hold the lock.
+ * @param word Index of the word, 0 when the lock is free.
+ */
+static inline void atomics_lock(uint32_t word) {
+  while (atomics_test_and_set(word) != 0) {
+  }
+}
+
+/**
+ * Release a lock taken with atomics_lock or atomics_test_and_set.
+ * @param word Index of the word.
+ */
+static inline void atomics_unlock(uint32_t word) {
+  atomics_store(word, 0);
+}
+
+/**
+ * Set a word to desired if it is expected. It takes three accesses and fails
+ * if it is interrupted by another compare-and-swap, so it is atomic with
+ * respect to the interrupts of the calling hart; the callers retry on
+ * failure. The harts must not use it concurrently, their locks are the
+ * semaphores of the mailbox or atomics_lock.
+ * @param word Index of the word.
+ * @param expected The value the word must have.
+ * @param desired The new value.
+ * @return true if the word was swapped.
+ */
+bool atomics_compare_and_swap(uint32_t word, uint32_t expected, uint32_t desired);
+
+/**
+ * Add a value to a word and return its previous value, with a
+ * compare-and-swap loop. atomics_add and atomics_fetch_inc are faster when
+ * the previous value is not needed or the value is 1.
+ * @param word Index of the word.
+ * @param value Value added.
+ */
+uint32_t atomics_fetch_add(uint32_t word, uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DRIVERS_ATOMICS_H_
@@ -0,0 +1,39 @@
+// Register defines of the atomic unit, hw/ip/atomics/rtl/atomics.sv
+//
+// Written by hand, not generated by regtool: a read of TAS, FETCH_INC,
+// FETCH_DEC or CAS changes the word, a side effect that depends on the
+// address window of the access and that reggen registers and windows cannot
+// describe. Keep these offsets in sync with the decoder of atomics.sv.
+
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _ATOMICS_REG_DEFS_
+#define _ATOMICS_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define ATOMICS_PARAM_REG_WIDTH 32
+
+// Words of the unit
+#define ATOMICS_PARAM_NUM_WORDS 16
+
+// Operations, each on the word at 4 * word bytes from its offset
+#define ATOMICS_VALUE_REG_OFFSET 0x0
+#define ATOMICS_TAS_REG_OFFSET 0x80
+#define ATOMICS_FETCH_INC_REG_OFFSET 0x100
+#define ATOMICS_FETCH_DEC_REG_OFFSET 0x180
+#define ATOMICS_ADD_REG_OFFSET 0x200
+#define ATOMICS_CAS_REG_OFFSET 0x280
+
+// Operands of the compare-and-swap, writing the expected value arms it
+#define ATOMICS_CAS_EXPECT_REG_OFFSET 0x300
+#define ATOMICS_CAS_NEW_REG_OFFSET 0x304
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _ATOMICS_REG_DEFS_
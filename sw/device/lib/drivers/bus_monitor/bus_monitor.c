@@ -0,0 +1,65 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bus_monitor.h"
+
+#include "bitfield.h"
+#include "bus_monitor_regs.h"
+
+// Layout of the COUNTERS window: the masters in its first half and the slaves
+// in its second half, BUS_MONITOR_PORT_SIZE bytes per port
+#define BUS_MONITOR_MASTERS_OFFSET BUS_MONITOR_COUNTERS_REG_OFFSET
+#define BUS_MONITOR_SLAVES_OFFSET \
+  (BUS_MONITOR_COUNTERS_REG_OFFSET + BUS_MONITOR_COUNTERS_SIZE_BYTES / 2)
+#define BUS_MONITOR_PORT_SIZE 0x10
+#define BUS_MONITOR_GRANTS_OFFSET 0x0
+#define BUS_MONITOR_WAITS_OFFSET 0x4
+#define BUS_MONITOR_LATENCY_OFFSET 0x8
+#define BUS_MONITOR_RVALIDS_OFFSET 0xc
+
+static void bus_monitor_get_port(const bus_monitor_t *bus_monitor,
+                                 ptrdiff_t offset, bus_monitor_stats_t *stats) {
+  stats->grants = mmio_region_read32(bus_monitor->base_addr,
+                                     offset + BUS_MONITOR_GRANTS_OFFSET);
+  stats->waits = mmio_region_read32(bus_monitor->base_addr,
+                                    offset + BUS_MONITOR_WAITS_OFFSET);
+  stats->latency = mmio_region_read32(bus_monitor->base_addr,
+                                      offset + BUS_MONITOR_LATENCY_OFFSET);
+  stats->rvalids = mmio_region_read32(bus_monitor->base_addr,
+                                      offset + BUS_MONITOR_RVALIDS_OFFSET);
+}
+
+void bus_monitor_enable(const bus_monitor_t *bus_monitor, bool enable) {
+  mmio_region_write32(bus_monitor->base_addr, BUS_MONITOR_CTRL_REG_OFFSET,
+                      bitfield_bit32_write(0, BUS_MONITOR_CTRL_ENABLE_BIT, enable));
+}
+
+void bus_monitor_clear(const bus_monitor_t *bus_monitor) {
+  uint32_t ctrl = mmio_region_read32(bus_monitor->base_addr, BUS_MONITOR_CTRL_REG_OFFSET);
+  ctrl = bitfield_bit32_write(ctrl, BUS_MONITOR_CTRL_CLEAR_BIT, true);
+  mmio_region_write32(bus_monitor->base_addr, BUS_MONITOR_CTRL_REG_OFFSET, ctrl);
+}
+
+uint32_t bus_monitor_get_cycles(const bus_monitor_t *bus_monitor) {
+  return mmio_region_read32(bus_monitor->base_addr, BUS_MONITOR_CYCLES_REG_OFFSET);
+}
+
+void bus_monitor_get_ports(const bus_monitor_t *bus_monitor, uint32_t *masters,
+                           uint32_t *slaves) {
+  uint32_t info = mmio_region_read32(bus_monitor->base_addr, BUS_MONITOR_INFO_REG_OFFSET);
+  *masters = bitfield_field32_read(info, BUS_MONITOR_INFO_MASTERS_FIELD);
+  *slaves = bitfield_field32_read(info, BUS_MONITOR_INFO_SLAVES_FIELD);
+}
+
+void bus_monitor_get_master(const bus_monitor_t *bus_monitor, uint32_t master,
+                            bus_monitor_stats_t *stats) {
+  bus_monitor_get_port(bus_monitor,
+                       BUS_MONITOR_MASTERS_OFFSET + master * BUS_MONITOR_PORT_SIZE, stats);
+}
+
+void bus_monitor_get_slave(const bus_monitor_t *bus_monitor, uint32_t slave,
+                           bus_monitor_stats_t *stats) {
+  bus_monitor_get_port(bus_monitor,
+                       BUS_MONITOR_SLAVES_OFFSET + slave * BUS_MONITOR_PORT_SIZE, stats);
+}
@@ -0,0 +1,103 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DRIVERS_BUS_MONITOR_H_
+#define _DRIVERS_BUS_MONITOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mmio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The bus monitor counts the transactions on each port of the system
+ * crossbar (see BUS_MONITOR_*_IDX in core_v_mini_mcu.h for the order of the
+ * ports). It is in the always-on peripherals, at BUS_MONITOR_START_ADDRESS,
+ * and has counters if BUS_MONITOR_COUNTERS is 1. The counters are 32-bit and
+ * wrap around.
+ */
+typedef struct bus_monitor {
+  /**
+   * The base address for the bus monitor hardware registers.
+   */
+  mmio_region_t base_addr;
+} bus_monitor_t;
+
+/**
+ * The counters of a port.
+ */
+typedef struct bus_monitor_stats {
+  /**
+   * Requests granted, i.e. transactions.
+   */
+  uint32_t grants;
+  /**
+   * Cycles the requests waited for their grant.
+   */
+  uint32_t waits;
+  /**
+   * Cycles from the grants to the responses, summed over the transactions.
+   */
+  uint32_t latency;
+  /**
+   * Responses.
+   */
+  uint32_t rvalids;
+} bus_monitor_stats_t;
+
+/**
+ * Start or stop the counters, which run from the reset on.
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ * @param enable Whether to count.
+ */
+void bus_monitor_enable(const bus_monitor_t *bus_monitor, bool enable);
+
+/**
+ * Clear the counters, keeping them enabled or not.
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ */
+void bus_monitor_clear(const bus_monitor_t *bus_monitor);
+
+/**
+ * Get the cycles counted since the counters were cleared.
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ */
+uint32_t bus_monitor_get_cycles(const bus_monitor_t *bus_monitor);
+
+/**
+ * Get the number of master and slave ports, both 0 without counters.
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ * @param[out] masters Ports of the masters.
+ * @param[out] slaves Ports of the slaves.
+ */
+void bus_monitor_get_ports(const bus_monitor_t *bus_monitor, uint32_t *masters,
+                           uint32_t *slaves);
+
+/**
+ * Get the counters of a master port, e.g. BUS_MONITOR_CORE_DATA_IDX.
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ * @param master Index of the master.
+ * @param[out] stats The counters.
+ */
+void bus_monitor_get_master(const bus_monitor_t *bus_monitor, uint32_t master,
+                            bus_monitor_stats_t *stats);
+
+/**
+ * Get the counters of a slave port, e.g. BUS_MONITOR_RAM_IDX(0).
+ * @param bus_monitor Pointer to bus_monitor_t representing the bus monitor.
+ * @param slave Index of the slave.
+ * @param[out] stats The counters.
+ */
+void bus_monitor_get_slave(const bus_monitor_t *bus_monitor, uint32_t slave,
+                           bus_monitor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DRIVERS_BUS_MONITOR_H_
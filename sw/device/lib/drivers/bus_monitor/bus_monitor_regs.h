@@ -0,0 +1,47 @@
+// Generated register defines for bus_monitor
+
+// Copyright information found in source file:
+// Copyright 2026 EPFL
+
+// Licensing information found in source file:
+// 
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#ifndef _BUS_MONITOR_REG_DEFS_
+#define _BUS_MONITOR_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define BUS_MONITOR_PARAM_REG_WIDTH 32
+
+// Control of the counters
+#define BUS_MONITOR_CTRL_REG_OFFSET 0x0
+#define BUS_MONITOR_CTRL_ENABLE_BIT 0
+#define BUS_MONITOR_CTRL_CLEAR_BIT 1
+
+// Cycles counted while enabled
+#define BUS_MONITOR_CYCLES_REG_OFFSET 0x4
+
+// Ports of the crossbar, 0 without counters
+#define BUS_MONITOR_INFO_REG_OFFSET 0x8
+#define BUS_MONITOR_INFO_MASTERS_MASK 0xff
+#define BUS_MONITOR_INFO_MASTERS_OFFSET 0
+#define BUS_MONITOR_INFO_MASTERS_FIELD \
+  ((bitfield_field32_t) { .mask = BUS_MONITOR_INFO_MASTERS_MASK, .index = BUS_MONITOR_INFO_MASTERS_OFFSET })
+#define BUS_MONITOR_INFO_SLAVES_MASK 0xff
+#define BUS_MONITOR_INFO_SLAVES_OFFSET 8
+#define BUS_MONITOR_INFO_SLAVES_FIELD \
+  ((bitfield_field32_t) { .mask = BUS_MONITOR_INFO_SLAVES_MASK, .index = BUS_MONITOR_INFO_SLAVES_OFFSET })
+
+// Memory area: Counters of the ports, in the order of the ports of
+// system_xbar.
+#define BUS_MONITOR_COUNTERS_REG_OFFSET 0x800
+#define BUS_MONITOR_COUNTERS_SIZE_WORDS 512
+#define BUS_MONITOR_COUNTERS_SIZE_BYTES 2048
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _BUS_MONITOR_REG_DEFS_
+// End generated register defines for bus_monitor
\ No newline at end of file
@@ -0,0 +1,185 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : crc.c                                                        **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   crc.c
+* @date   14/10/2026
+* @brief  HAL of the CRC peripheral
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "crc.h"
+
+#include "core_v_mini_mcu.h"
+#include "mmio.h"
+#include "bitfield.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define crc_base mmio_region_from_addr((uintptr_t)CRC_START_ADDRESS)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED VARIABLES                             */
+/**                                                                        **/
+/****************************************************************************/
+
+const crc_cfg_t crc_cfg_crc32 = {
+  .width   = kCrcWidth32,
+  .reflect = true,
+  .poly    = 0x04C11DB7,
+  .init    = 0xFFFFFFFF,
+  .xor_out = 0xFFFFFFFF,
+};
+
+const crc_cfg_t crc_cfg_crc16_ccitt = {
+  .width   = kCrcWidth16,
+  .reflect = false,
+  .poly    = 0x1021,
+  .init    = 0xFFFF,
+  .xor_out = 0x0000,
+};
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void crc_start(const crc_cfg_t *cfg)
+{
+  uint32_t ctrl = bitfield_field32_write(0, CRC_CTRL_WIDTH_FIELD, cfg->width);
+  ctrl = bitfield_bit32_write(ctrl, CRC_CTRL_REFLECT_BIT, cfg->reflect);
+
+  mmio_region_write32(crc_base, CRC_CTRL_REG_OFFSET, ctrl);
+  mmio_region_write32(crc_base, CRC_POLY_REG_OFFSET, cfg->poly);
+  mmio_region_write32(crc_base, CRC_XOR_OUT_REG_OFFSET, cfg->xor_out);
+  // INIT last, it starts the CRC with the configuration
+  mmio_region_write32(crc_base, CRC_INIT_REG_OFFSET, cfg->init);
+}
+
+void crc_update(const void *data, size_t len)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+
+  // the engine stalls the writes while it is busy, nothing to poll
+  while (len > 0 && ((uintptr_t)bytes & 3) != 0) {
+    mmio_region_write32(crc_base, CRC_DATA_BYTE_REG_OFFSET, *bytes++);
+    len--;
+  }
+  for (; len >= 4; len -= 4, bytes += 4) {
+    mmio_region_write32(crc_base, CRC_DATA_WORD_REG_OFFSET, *(const uint32_t *)bytes);
+  }
+  if (len >= 2) {
+    mmio_region_write32(crc_base, CRC_DATA_HALF_REG_OFFSET, *(const uint16_t *)bytes);
+    bytes += 2;
+    len -= 2;
+  }
+  if (len > 0) {
+    mmio_region_write32(crc_base, CRC_DATA_BYTE_REG_OFFSET, *bytes);
+  }
+}
+
+dma_config_flags_t crc_dma_update(crc_dma_t *dma, const void *data, size_t len,
+                                  uint8_t channel, dma_queue_cb_t cb, void *ctx)
+{
+  uintptr_t align = (uintptr_t)data | len;
+  dma_data_type_t type;
+  ptrdiff_t offset;
+
+  // the data register of the type, so that the DMA writes whole registers
+  if ((align & 3) == 0) {
+    type = DMA_DATA_TYPE_WORD;
+    offset = CRC_DATA_WORD_REG_OFFSET;
+  } else if ((align & 1) == 0) {
+    type = DMA_DATA_TYPE_HALF_WORD;
+    offset = CRC_DATA_HALF_REG_OFFSET;
+  } else {
+    type = DMA_DATA_TYPE_BYTE;
+    offset = CRC_DATA_BYTE_REG_OFFSET;
+  }
+
+  dma->src = (dma_target_t) {
+    .ptr     = (uint8_t *)data,
+    .inc_du  = 1,
+    .size_du = len / DMA_DATA_TYPE_2_SIZE(type),
+    .type    = type,
+    .trig    = DMA_TRIG_MEMORY,
+  };
+  dma->dst = (dma_target_t) {
+    .ptr    = (uint8_t *)CRC_START_ADDRESS + offset,
+    .inc_du = 0,
+    .type   = type,
+    .trig   = DMA_TRIG_SLOT_CRC,
+  };
+  dma->trans = (dma_trans_t) {
+    .src     = &dma->src,
+    .dst     = &dma->dst,
+    .mode    = DMA_TRANS_MODE_SINGLE,
+    .end     = DMA_TRANS_END_INTR,
+    .channel = channel,
+  };
+  dma->entry.trans = &dma->trans;
+  dma->entry.cb    = cb;
+  dma->entry.ctx   = ctx;
+
+  dma_config_flags_t flags = dma_validate_transaction(&dma->trans,
+                                                      DMA_DO_NOT_ENABLE_REALIGN,
+                                                      DMA_PERFORM_CHECKS_ONLY_SANITY);
+  if (flags & DMA_CONFIG_CRITICAL_ERROR) {
+    return flags;
+  }
+  return flags | dma_submit(&dma->entry);
+}
+
+uint32_t crc_get_result(void)
+{
+  // the read is held until the last data is processed
+  return mmio_region_read32(crc_base, CRC_RESULT_REG_OFFSET);
+}
+
+uint32_t crc_compute(const crc_cfg_t *cfg, const void *data, size_t len)
+{
+  crc_start(cfg);
+  crc_update(data, len);
+  return crc_get_result();
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
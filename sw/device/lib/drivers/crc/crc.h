@@ -0,0 +1,211 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : crc.h                                                        **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   crc.h
+* @date   14/10/2026
+* @brief  HAL of the CRC peripheral
+*
+* The CRC engine computes 32, 16 and 8-bit CRCs of any polynomial, described
+* by a crc_cfg_t as in the usual CRC catalogues (poly, init, refin = refout,
+* xorout). crc_start loads a configuration and starts a new CRC, the data is
+* then added by the CPU with crc_update or by a DMA channel with
+* crc_dma_update, and the CRC is read with crc_get_result. Several buffers
+* can be added one after the other to the same CRC.
+*
+* The engine takes up to a word per cycle (bytes_per_cycle of the crc entry
+* in mcu_cfg.hjson) and stalls the bus while it processes the previous data,
+* so the CPU writes with no checks. The DMA is paced on the
+* DMA_TRIG_SLOT_CRC slot instead, which leaves the peripheral bus free
+* between its writes. With two channels, a buffer can be checked while
+* another channel moves it, e.g. a flash page to the SPI host.
+*/
+
+#ifndef _DRIVERS_CRC_H_
+#define _DRIVERS_CRC_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "crc_regs.h"
+#include "dma.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Width of the CRC.
+ */
+typedef enum crc_width {
+  kCrcWidth32 = CRC_CTRL_WIDTH_VALUE_CRC32,
+  kCrcWidth16 = CRC_CTRL_WIDTH_VALUE_CRC16,
+  kCrcWidth8  = CRC_CTRL_WIDTH_VALUE_CRC8,
+} crc_width_t;
+
+
+/**
+ * Parameters of a CRC, in the form of the CRC catalogues.
+ */
+typedef struct crc_cfg {
+  /**
+   * Width of the CRC.
+   */
+  crc_width_t width;
+  /**
+   * The bytes are processed LSB first and the CRC is reflected (refin and
+   * refout). The polynomial and the initial value keep their normal form.
+   */
+  bool reflect;
+  /**
+   * Polynomial in the normal form, without the top bit (0x04C11DB7).
+   */
+  uint32_t poly;
+  /**
+   * Initial value.
+   */
+  uint32_t init;
+  /**
+   * Value XORed to the CRC at the end.
+   */
+  uint32_t xor_out;
+} crc_cfg_t;
+
+
+/**
+ * A transaction feeding the CRC from memory. It must stay in memory until the
+ * transaction is done.
+ */
+typedef struct crc_dma {
+  dma_target_t src;
+  dma_target_t dst;
+  dma_trans_t trans;
+  dma_queue_entry_t entry;
+} crc_dma_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED VARIABLES                             */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * CRC-32 of Ethernet, zlib and PNG (CRC-32/ISO-HDLC): 0xCBF43926 for
+ * "123456789".
+ */
+extern const crc_cfg_t crc_cfg_crc32;
+
+/**
+ * CRC-16/CCITT-FALSE, the CRC-16 of most packet protocols: 0x29B1 for
+ * "123456789".
+ */
+extern const crc_cfg_t crc_cfg_crc16_ccitt;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Loads a configuration and starts a new CRC
+ *
+ * It must not be called while a DMA transaction feeds the CRC.
+ *
+ * @param cfg the parameters of the CRC
+ */
+void crc_start(const crc_cfg_t *cfg);
+
+/**
+ * Adds data to the CRC with the CPU, by words except for the unaligned head
+ * and tail
+ *
+ * @param data the data
+ * @param len its size in bytes
+ */
+void crc_update(const void *data, size_t len);
+
+/**
+ * Adds data to the CRC with a DMA channel, through the submission queue of
+ * the channel
+ *
+ * The DMA writes the widest data type to which the pointer and the size are
+ * aligned. The callback is called from the transaction done interrupt, then
+ * crc_get_result may be read or other data added.
+ *
+ * @param dma the transaction, which must stay in memory until it is done
+ * @param data the data
+ * @param len its size in bytes
+ * @param channel the DMA channel
+ * @param cb called when the data is added, it may be NULL
+ * @param ctx context of the callback, in dma->entry.ctx
+ *
+ * @return the flags of the validation and of the submission of the
+ * transaction
+ */
+dma_config_flags_t crc_dma_update(crc_dma_t *dma, const void *data, size_t len,
+                                  uint8_t channel, dma_queue_cb_t cb, void *ctx);
+
+/**
+ * @return the CRC of the data added since crc_start
+ */
+uint32_t crc_get_result(void);
+
+/**
+ * Computes the CRC of a buffer with the CPU
+ *
+ * @param cfg the parameters of the CRC
+ * @param data the data
+ * @param len its size in bytes
+ *
+ * @return the CRC
+ */
+uint32_t crc_compute(const crc_cfg_t *cfg, const void *data, size_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_CRC_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
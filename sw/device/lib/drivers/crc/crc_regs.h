@@ -0,0 +1,65 @@
+// Generated register defines for crc
+
+// Copyright information found in source file:
+// Copyright EPFL contributors.
+
+// Licensing information found in source file:
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _CRC_REG_DEFS_
+#define _CRC_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define CRC_PARAM_REG_WIDTH 32
+
+// Width and bit order of the CRC, to be set before INIT
+#define CRC_CTRL_REG_OFFSET 0x0
+#define CRC_CTRL_WIDTH_MASK 0x3
+#define CRC_CTRL_WIDTH_OFFSET 0
+#define CRC_CTRL_WIDTH_FIELD \
+  ((bitfield_field32_t) { .mask = CRC_CTRL_WIDTH_MASK, .index = CRC_CTRL_WIDTH_OFFSET })
+#define CRC_CTRL_WIDTH_VALUE_CRC32 0x0
+#define CRC_CTRL_WIDTH_VALUE_CRC16 0x1
+#define CRC_CTRL_WIDTH_VALUE_CRC8 0x2
+#define CRC_CTRL_REFLECT_BIT 2
+
+// Polynomial, in the normal form without the top bit (e.g. 0x04C11DB7 or
+// 0x1021)
+#define CRC_POLY_REG_OFFSET 0x4
+
+// Initial value of the CRC.
+#define CRC_INIT_REG_OFFSET 0x8
+
+// Value XORed to the CRC when RESULT is read
+#define CRC_XOR_OUT_REG_OFFSET 0xc
+
+// Four bytes to add to the CRC, the least significant first.
+#define CRC_DATA_WORD_REG_OFFSET 0x10
+
+// Two bytes to add to the CRC, the least significant first
+#define CRC_DATA_HALF_REG_OFFSET 0x14
+#define CRC_DATA_HALF_DATA_HALF_MASK 0xffff
+#define CRC_DATA_HALF_DATA_HALF_OFFSET 0
+#define CRC_DATA_HALF_DATA_HALF_FIELD \
+  ((bitfield_field32_t) { .mask = CRC_DATA_HALF_DATA_HALF_MASK, .index = CRC_DATA_HALF_DATA_HALF_OFFSET })
+
+// One byte to add to the CRC
+#define CRC_DATA_BYTE_REG_OFFSET 0x18
+#define CRC_DATA_BYTE_DATA_BYTE_MASK 0xff
+#define CRC_DATA_BYTE_DATA_BYTE_OFFSET 0
+#define CRC_DATA_BYTE_DATA_BYTE_FIELD \
+  ((bitfield_field32_t) { .mask = CRC_DATA_BYTE_DATA_BYTE_MASK, .index = CRC_DATA_BYTE_DATA_BYTE_OFFSET })
+
+// CRC of the data written since INIT, reflected if REFLECT is set and XORed
+// with XOR_OUT.
+#define CRC_RESULT_REG_OFFSET 0x1c
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _CRC_REG_DEFS_
+// End generated register defines for crc
\ No newline at end of file
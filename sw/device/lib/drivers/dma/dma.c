@@ -39,6 +39,7 @@
 /* To manage interrupts. */
 #include "fast_intr_ctrl.h"
 #include "csr.h"
+#include "irq.h"
 #include "stdasm.h"
 
 /****************************************************************************/
@@ -175,6 +176,7 @@ static inline uint8_t is_region_outbound(   uint8_t  *p_start,
  * @brief Writes a given value into the specified register. Its operation
  * mimics that of bitfield_field32_write(), but does not require the use of
  * a field structure, that is not always provided in the _regs.h file.
+ * @param p_peri The registers of the channel to write.
  * @param p_val The value to be written.
  * @param p_offset The register's offset from the peripheral's base address
  *  where the target register is located.
@@ -183,18 +185,91 @@ static inline uint8_t is_region_outbound(   uint8_t  *p_start,
  * @param p_sel The selection index (i.e. From which bit inside the register
  * the value is to be written).
  */
-static inline void write_register(  uint32_t p_val,
+static inline void write_register(  dma      *p_peri,
+                                    uint32_t p_val,
                                     uint32_t p_offset,
                                     uint32_t p_mask,
                                     uint8_t  p_sel );
 
+/**
+ * @brief Reads the status register of a channel. The events it reports
+ * (transaction and window done) are cleared by the read, so they are kept in
+ * the control block of the channel until the interrupt handlers attend them.
+ * @param p_ch The channel to read.
+ * @return The value of the status register.
+ */
+static inline uint32_t read_status( uint8_t p_ch );
+
+/**
+ * @brief Updates the stream of a channel after a window done interrupt. The
+ * window count of the channel tells how many slots were filled since the
+ * previous call, in case an interrupt was missed.
+ * @param p_stream The stream to update.
+ * @param p_ch The channel of the stream.
+ */
+static void stream_window_done( dma_stream_t *p_stream, uint8_t p_ch );
+
+/**
+ * @brief Launches the first transaction of the submission queue of a channel.
+ * The transactions that cannot be launched are removed from the queue and
+ * their callbacks called, so that the following ones are launched.
+ * @param p_ch The channel of the queue.
+ */
+static void queue_launch( uint8_t p_ch );
+
+/**
+ * @brief Removes the first, finished, entry of the submission queue of a
+ * channel, launches the next one and calls the callback of the finished one.
+ * @param p_ch The channel of the queue.
+ */
+static void queue_done( uint8_t p_ch );
+
 
 /**
  * @brief Analyzes a target to determine the size of its increment (in bytes).
+ * @param p_trans A pointer to the transaction the target belongs to.
  * @param p_tgt A pointer to the target to analyze.
  * @return The number of bytes of the increment.
  */
-static inline uint32_t get_increment_b( dma_target_t * p_tgt );
+static inline uint32_t get_increment_b( dma_trans_t  *p_trans,
+                                        dma_target_t *p_tgt );
+
+/**
+ * @brief Computes the increment of a target after the last element of each
+ * row of a 2D transaction, so that consecutive rows start stride_d2_du data
+ * units apart.
+ * @param p_trans A pointer to the transaction the target belongs to.
+ * @param p_tgt A pointer to the target to analyze.
+ * @return The number of bytes of the increment. It is negative if the stride
+ * is smaller than the row.
+ */
+static inline int32_t get_increment_d2_b(   dma_trans_t  *p_trans,
+                                            dma_target_t *p_tgt );
+
+/**
+ * @brief Gets the size of the data units in which the 2D stride of a target
+ * is given.
+ * @param p_trans A pointer to the transaction the target belongs to.
+ * @param p_tgt A pointer to the target to analyze.
+ * @return The number of bytes of a data unit of the stride.
+ */
+static inline uint8_t get_stride_unit_b(    dma_trans_t  *p_trans,
+                                            dma_target_t *p_tgt );
+
+/**
+ * @brief Tells whether the destination pointer is used, i.e. the transaction
+ * is not in address mode or the table does not hold destination addresses.
+ * @param p_trans A pointer to the transaction.
+ * @return 1 if the destination pointer and increment are written.
+ */
+static inline uint8_t uses_dst_ptr( dma_trans_t *p_trans );
+
+/**
+ * @brief Computes the ADDR_CFG register of a transaction.
+ * @param p_trans A pointer to the transaction.
+ * @return The value of the register, 0 if not in address mode.
+ */
+static inline uint32_t get_addr_cfg( dma_trans_t *p_trans );
 
 
 /****************************************************************************/
@@ -210,10 +285,10 @@ static inline uint32_t get_increment_b( dma_target_t * p_tgt );
 /****************************************************************************/
 
 /**
- * Control Block (CB) of the DMA peripheral.
+ * Control Block (CB) of each DMA channel.
  * Has variables and constant necessary/useful for its control.
  */
-static struct
+static struct dma_ch_cb
 {
     /**
     * Pointer to the transaction to be performed.
@@ -227,12 +302,36 @@ static struct
     */
     uint8_t intrFlag;
 
+    /**
+     * Status events (DMA_STATUS_*_DONE_BIT) read from the status register and
+     * not attended yet by the interrupt handlers.
+     */
+    uint32_t events;
+
+    /**
+     * Compiled transaction whose image is loaded in the registers, NULL if
+     * they were written by another function.
+     */
+    dma_compiled_trans_t *comp;
+
+    /**
+     * Stream running in the channel, NULL if none.
+     */
+    dma_stream_t *stream;
+
+    /**
+     * First and last entries of the submission queue, NULL if it is empty.
+     * The transaction of the first one is the one running.
+     */
+    dma_queue_entry_t *head;
+    dma_queue_entry_t *tail;
+
     /**
      * memory mapped structure of a DMA.
      */
     dma *peri;
 
-}dma_cb;
+}dma_cb[DMA_CH_NUM];
 
 
 /****************************************************************************/
@@ -244,44 +343,95 @@ static struct
 void handler_irq_dma(uint32_t id)
 {
     /*
-     * Call the weak implementation provided in this module,
-     * or the non-weak implementation.
+     * All the channels share the interrupt line, the status register tells
+     * which ones finished a window.
      */
-    dma_intr_handler_window_done();
+    for( uint8_t ch = 0; ch < DMA_CH_NUM; ch++ )
+    {
+        read_status( ch );
+        if( dma_cb[ch].events & ( 1 << DMA_STATUS_WINDOW_DONE_BIT ) )
+        {
+            dma_cb[ch].events &= ~( 1 << DMA_STATUS_WINDOW_DONE_BIT );
+            if( dma_cb[ch].stream != NULL )
+            {
+                stream_window_done( dma_cb[ch].stream, ch );
+            }
+            /*
+             * Call the weak implementation provided in this module,
+             * or the non-weak implementation.
+             */
+            dma_intr_handler_window_done( ch );
+        }
+    }
 }
 
 void fic_irq_dma(void)
 {
-    /* The flag is raised so the waiting loop can be broken.*/
-    dma_cb.intrFlag = 1;
-
-    /*
-     * Call the weak implementation provided in this module,
-     * or the non-weak implementation.
-     */
-    dma_intr_handler_trans_done();
+    for( uint8_t ch = 0; ch < DMA_CH_NUM; ch++ )
+    {
+        read_status( ch );
+        if( dma_cb[ch].events & ( 1 << DMA_STATUS_TRANSACTION_DONE_BIT ) )
+        {
+            dma_cb[ch].events &= ~( 1 << DMA_STATUS_TRANSACTION_DONE_BIT );
+            /* The flag is raised so the waiting loop can be broken.*/
+            dma_cb[ch].intrFlag = 1;
+            /*
+             * Queued transactions have their own callbacks, the rest call
+             * the weak implementation provided in this module, or the
+             * non-weak implementation.
+             */
+            if(     ( dma_cb[ch].head != NULL )
+                &&  ( dma_cb[ch].trans == dma_cb[ch].head->trans ) )
+            {
+                queue_done( ch );
+            }
+            else
+            {
+                dma_intr_handler_trans_done( ch );
+            }
+        }
+    }
 }
 
 void dma_init( dma *peri )
 {
-    /*
-     * If a DMA peripheral was provided, use that one, otherwise use the
-     * integrated one.
-     */
-    dma_cb.peri = peri ? peri : dma_peri;
-
-    /* Clear the loaded transaction */
-    dma_cb.trans = NULL;
-    /* Clear all values in the DMA registers. */
-    dma_cb.peri->SRC_PTR       = 0;
-    dma_cb.peri->DST_PTR       = 0;
-    dma_cb.peri->SIZE          = 0;
-    dma_cb.peri->PTR_INC       = 0;
-    dma_cb.peri->SLOT          = 0;
-    dma_cb.peri->DATA_TYPE     = 0;
-    dma_cb.peri->MODE          = 0;
-    dma_cb.peri->WINDOW_SIZE   = 0;
-    dma_cb.peri->INTERRUPT_EN  = 0;
+    for( uint8_t ch = 0; ch < DMA_CH_NUM; ch++ )
+    {
+        /*
+         * If a DMA peripheral was provided, it replaces the first channel,
+         * otherwise the integrated channels are used.
+         */
+        dma_cb[ch].peri = ( peri && ch == 0 )
+                        ? peri
+                        : (dma *)( DMA_START_ADDRESS + ch * DMA_CH_SIZE );
+
+        /* Clear the loaded transaction */
+        dma_cb[ch].trans  = NULL;
+        dma_cb[ch].comp   = NULL;
+        dma_cb[ch].stream = NULL;
+        dma_cb[ch].head   = NULL;
+        dma_cb[ch].tail   = NULL;
+        /* Clear all values in the DMA registers. */
+        dma_cb[ch].peri->SRC_PTR       = 0;
+        dma_cb[ch].peri->DST_PTR       = 0;
+        dma_cb[ch].peri->SIZE          = 0;
+        dma_cb[ch].peri->PTR_INC       = 0;
+        dma_cb[ch].peri->SLOT          = 0;
+        dma_cb[ch].peri->DATA_TYPE     = 0;
+        dma_cb[ch].peri->DST_DATA_TYPE = 0;
+        dma_cb[ch].peri->SIGN_EXT      = 0;
+        dma_cb[ch].peri->PACE          = 0;
+        dma_cb[ch].peri->MODE          = 0;
+        dma_cb[ch].peri->WINDOW_SIZE   = 0;
+        dma_cb[ch].peri->INTERRUPT_EN  = 0;
+        dma_cb[ch].peri->DESC_PTR      = 0;
+        dma_cb[ch].peri->SIZE_D1       = 0;
+        dma_cb[ch].peri->PTR_INC_D2    = 0;
+        /* Discard the events of previous transactions. */
+        dma_cb[ch].events = 0;
+        read_status( ch );
+        dma_cb[ch].events = 0;
+    }
 }
 
 dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
@@ -296,6 +446,9 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
      be valid.*/
     DMA_STATIC_ASSERT( p_trans->type   < DMA_DATA_TYPE__size,
                        "Data type not valid");
+    /* The data type conversion should be a valid conversion. */
+    DMA_STATIC_ASSERT( p_trans->conv   < DMA_TYPE_CONV__size,
+                       "Data type conversion not valid");
     /* Transaction mode should be a valid mode. */
     DMA_STATIC_ASSERT( p_trans->mode   < DMA_TRANS_MODE__size,
                        "Transaction mode not valid");
@@ -309,6 +462,16 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
     DMA_STATIC_ASSERT( p_check         < DMA_PERFORM_CHECKS__size,
                        "Check request not valid");
 
+    /*
+     * The channel indexes the control blocks, so it is always checked.
+     */
+    p_trans->flags = DMA_CONFIG_OK;
+    if( p_trans->channel >= DMA_CH_NUM )
+    {
+        p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+        return p_trans->flags;
+    }
+
     /*
      * CHECK IF TARGETS HAVE ERRORS
      */
@@ -317,8 +480,12 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
      * The transaction is NOT created if the targets include errors.
      * A successful target validation has to be done before loading it to the
      * DMA.
+     * In fill mode nothing is read, the source only gives the data type and
+     * the size.
      */
-    uint8_t errorSrc = validate_target( p_trans->src );
+    uint8_t errorSrc = ( p_trans->mode == DMA_TRANS_MODE_FILL )
+                       ? DMA_CONFIG_OK
+                       : validate_target( p_trans->src );
     uint8_t errorDst = validate_target( p_trans->dst );
 
     /*
@@ -391,8 +558,15 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
     transformed to bytes, to be used as default size.*/
     uint8_t dataSize_b = DMA_DATA_TYPE_2_SIZE(p_trans->src->type);
     p_trans->size_b = p_trans->src->size_du * dataSize_b;
-    /* By default, the source defines the data type.*/
-    p_trans->type = p_trans->src->type;
+    /* In 2D transactions the source size is the size of each row. */
+    if( p_trans->size_d2 > 1 )
+    {
+        p_trans->size_b *= p_trans->size_d2;
+    }
+    /* By default, the source defines the data type. The destination only
+    defines the one of the writes if the data type is converted.*/
+    p_trans->type     = p_trans->src->type;
+    p_trans->dst_type = p_trans->conv ? p_trans->dst->type : p_trans->type;
     /*
      * By default, the transaction increment is set to 0 and, if required,
      * it will be changed to 1 (in which case both src and dst will have an
@@ -414,14 +588,15 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
         uint8_t misalignment = 0;
         uint8_t dstMisalignment = 0;
 
-        if( p_trans->src->trig == DMA_TRIG_MEMORY )
+        if(     p_trans->src->trig == DMA_TRIG_MEMORY
+            &&  p_trans->mode      != DMA_TRANS_MODE_FILL )
         {
             misalignment = get_misalignment_b( p_trans->src->ptr, p_trans->type );
         }
 
         if( p_trans->dst->trig == DMA_TRIG_MEMORY )
         {
-            dstMisalignment = get_misalignment_b( p_trans->dst->ptr, p_trans->type );
+            dstMisalignment = get_misalignment_b( p_trans->dst->ptr, p_trans->dst_type );
         }
 
         p_trans->flags  |= ( misalignment ? DMA_CONFIG_SRC : DMA_CONFIG_OK );
@@ -499,6 +674,19 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
                 return p_trans->flags;
             }
 
+            /*
+             * A smaller data type would split each data unit in several
+             * ones, so the data cannot be extended or truncated anymore,
+             * and only the low bits of a fill value would be written.
+             */
+            if(     ( p_trans->type != p_trans->dst_type )
+                ||  ( p_trans->mode == DMA_TRANS_MODE_FILL ) )
+            {
+                p_trans->flags |= DMA_CONFIG_INCOMPATIBLE;
+                p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+                return p_trans->flags;
+            }
+
             /*
              * PERFORM THE REALIGNMENT
              */
@@ -509,6 +697,7 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
              * misalignment in order to overcome it.
              */
             p_trans->type += misalignment;
+            p_trans->dst_type = p_trans->type;
             /*
              * Source and destination increment should now be of the size
              * of the data.
@@ -562,12 +751,31 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
          * No further operations are done to prevent corrupting information
          * that could be useful for debugging purposes.
          */
+        /*
+         * In 2D transactions the last row is checked, or the whole
+         * transaction if the rows are contiguous in the destination.
+         */
+        uint8_t  *dstLast   = p_trans->dst->ptr;
+        uint32_t dstSize_du = p_trans->src->size_du;
+        if( p_trans->size_d2 > 1 )
+        {
+            if( p_trans->dst->stride_d2_du != 0 )
+            {
+                dstLast += ( p_trans->size_d2 - 1 )
+                            * p_trans->dst->stride_d2_du
+                            * get_stride_unit_b( p_trans, p_trans->dst );
+            }
+            else
+            {
+                dstSize_du *= p_trans->size_d2;
+            }
+        }
         uint8_t isEnv = p_trans->dst->env;
         uint8_t isOutb = is_region_outbound(
-                                    p_trans->dst->ptr,
+                                    dstLast,
                                     p_trans->dst->env->end,
-                                    p_trans->type,
-                                    p_trans->src->size_du,
+                                    p_trans->dst_type,
+                                    dstSize_du,
                                     p_trans->dst->inc_du );
         if( isEnv && isOutb )
         {
@@ -582,6 +790,56 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
         // @ToDo: Consider if (when a destination target has no environment)
         // the destination size should be used as limit.
 
+        /*
+         * The table of the address mode holds addresses or offsets, which
+         * are shifted by at most 3 bits.
+         */
+        if(     ( p_trans->mode == DMA_TRANS_MODE_ADDRESS )
+            &&  (     ( p_trans->addr_table >= DMA_ADDR_TABLE__size )
+                  ||  ( p_trans->addr_shift > DMA_ADDR_CFG_SHIFT_MASK )
+                  ||  ( p_trans->src_addr == NULL ) ) )
+        {
+            p_trans->flags |= DMA_CONFIG_INCOMPATIBLE;
+            p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+            return p_trans->flags;
+        }
+
+        /*
+         * CHECK IF THE 2D CONFIGURATION IS VALID
+         */
+
+        /*
+         * The address mode has no rows, and the strides cannot be smaller
+         * than the rows nor exceed the increment register.
+         */
+        if( p_trans->size_d2 > 1 )
+        {
+            if( p_trans->mode == DMA_TRANS_MODE_ADDRESS )
+            {
+                p_trans->flags |= DMA_CONFIG_INCOMPATIBLE;
+                p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+                return p_trans->flags;
+            }
+
+            int32_t srcInc_b = get_increment_d2_b( p_trans, p_trans->src );
+            if(     ( srcInc_b < 0 )
+                ||  ( srcInc_b > DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK ) )
+            {
+                p_trans->flags |= DMA_CONFIG_SRC;
+                p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+                return p_trans->flags;
+            }
+
+            int32_t dstInc_b = get_increment_d2_b( p_trans, p_trans->dst );
+            if(     ( dstInc_b < 0 )
+                ||  ( dstInc_b > DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK ) )
+            {
+                p_trans->flags |= DMA_CONFIG_DST;
+                p_trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+                return p_trans->flags;
+            }
+        }
+
         /*
          * CHECK IF THE WINDOW SIZE IS ADEQUATE
          */
@@ -624,6 +882,13 @@ dma_config_flags_t dma_validate_transaction(    dma_trans_t        *p_trans,
 
 dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
 {
+    /* The channel selects the control block, so it is checked first. */
+    if( p_trans->channel >= DMA_CH_NUM )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+    struct dma_ch_cb *cb = &dma_cb[ p_trans->channel ];
+
     /*
      * CHECK FOR CRITICAL ERRORS
      */
@@ -635,7 +900,7 @@ dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
      */
     if( p_trans->flags & DMA_CONFIG_CRITICAL_ERROR )
     {
-        dma_cb.trans = NULL;
+        cb->trans = NULL;
         return DMA_CONFIG_CRITICAL_ERROR;
     }
 
@@ -650,13 +915,15 @@ dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
      * until it has ended.
      * Transactions can still be validated in the meantime.
      */
-    if( !dma_is_ready() )
+    if( !dma_is_ready( p_trans->channel ) )
     {
         return DMA_CONFIG_TRANS_OVERRIDE;
     }
 
     /* Save the current transaction */
-    dma_cb.trans = p_trans;
+    cb->trans  = p_trans;
+    cb->comp   = NULL;
+    cb->stream = NULL;
 
     /*
      * ENABLE/DISABLE INTERRUPTS
@@ -667,57 +934,44 @@ dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
      * Otherwise the mie.MEIE bit is set to one to enable machine-level
      * fast DMA interrupt.
      */
-    dma_cb.peri->INTERRUPT_EN = INTR_EN_NONE;
+    cb->peri->INTERRUPT_EN = INTR_EN_NONE;
     CSR_CLEAR_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
 
-    if( dma_cb.trans->end != DMA_TRANS_END_POLLING )
+    if( cb->trans->end != DMA_TRANS_END_POLLING )
     {
         /* Enable global interrupt for machine-level interrupts. */
         CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
         /* @ToDo: What does this do? */
         CSR_SET_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
 
-        dma_cb.peri->INTERRUPT_EN |= INTR_EN_TRANS_DONE;
+        cb->peri->INTERRUPT_EN |= INTR_EN_TRANS_DONE;
 
         /* Only if a window is used should the window interrupt be set. */
         if( p_trans->win_du > 0 )
         {
-            dma_cb.peri->INTERRUPT_EN |= INTR_EN_WINDOW_DONE;
+            cb->peri->INTERRUPT_EN |= INTR_EN_WINDOW_DONE;
         }
     }
 
     /*
      * SET THE POINTERS
      */
-    dma_cb.peri->SRC_PTR = dma_cb.trans->src->ptr;
+    cb->peri->SRC_PTR = cb->trans->src->ptr;
 
-    if(dma_cb.trans->mode != DMA_TRANS_MODE_ADDRESS)
+    if( uses_dst_ptr( cb->trans ) )
     {
         /*
-            Write to the destination pointers only if we are not in address mode,
-            otherwise the destination address is read in a separate port in parallel with the data
-            from the address port
+            Write to the destination pointers only if they are not read from
+            the address port, in parallel with the data. In address mode they
+            are the base of the offsets, or written linearly with a gather.
         */
-        dma_cb.peri->DST_PTR = dma_cb.trans->dst->ptr;
-     }
-     else
-     {
-        dma_cb.peri->ADDR_PTR = dma_cb.trans->src_addr->ptr;
-     }
-
-    if(dma_cb.trans->mode != DMA_TRANS_MODE_ADDRESS)
+        cb->peri->DST_PTR = cb->trans->dst->ptr;
+    }
+
+    if( cb->trans->mode == DMA_TRANS_MODE_ADDRESS )
     {
-        /*
-            Write to the destination pointers only if we are not in address mode,
-            otherwise the destination address is read in a separate port in parallel with the data
-            from the address port
-        */
-        dma_cb.peri->DST_PTR = dma_cb.trans->dst->ptr;
-     }
-     else
-     {
-        dma_cb.peri->ADDR_PTR = dma_cb.trans->src_addr->ptr;
-     }
+        cb->peri->ADDR_PTR = cb->trans->src_addr->ptr;
+    }
 
     /*
      * SET THE INCREMENTS
@@ -733,16 +987,18 @@ dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
      * as the values read from the second port are instead used.
      */
 
-    write_register(  get_increment_b( dma_cb.trans->src ),
+    write_register(  cb->peri,
+                    get_increment_b( cb->trans, cb->trans->src ),
                     DMA_PTR_INC_REG_OFFSET,
                     DMA_PTR_INC_SRC_PTR_INC_MASK,
                     DMA_PTR_INC_SRC_PTR_INC_OFFSET );
 
 
 
-    if(dma_cb.trans->mode != DMA_TRANS_MODE_ADDRESS)
+    if( uses_dst_ptr( cb->trans ) )
     {
-        write_register(  get_increment_b( dma_cb.trans->dst ),
+        write_register(  cb->peri,
+                        get_increment_b( cb->trans, cb->trans->dst ),
                         DMA_PTR_INC_REG_OFFSET,
                         DMA_PTR_INC_DST_PTR_INC_MASK,
                         DMA_PTR_INC_DST_PTR_INC_OFFSET );
@@ -753,32 +1009,73 @@ dma_config_flags_t dma_load_transaction( dma_trans_t *p_trans )
      * SET THE OPERATION MODE AND WINDOW SIZE
      */
 
-    dma_cb.peri->MODE = dma_cb.trans->mode;
+    cb->peri->MODE = cb->trans->mode;
+
+    /*
+     * SET THE ROWS OF 2D TRANSACTIONS
+     */
+
+    /* A row size of 0 keeps the transaction linear. */
+    if( cb->trans->size_d2 > 1 )
+    {
+        cb->peri->SIZE_D1 = cb->trans->size_b / cb->trans->size_d2;
+        write_register(  cb->peri,
+                        get_increment_d2_b( cb->trans, cb->trans->src ),
+                        DMA_PTR_INC_D2_REG_OFFSET,
+                        DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK,
+                        DMA_PTR_INC_D2_SRC_PTR_INC_D2_OFFSET );
+        write_register(  cb->peri,
+                        get_increment_d2_b( cb->trans, cb->trans->dst ),
+                        DMA_PTR_INC_D2_REG_OFFSET,
+                        DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK,
+                        DMA_PTR_INC_D2_DST_PTR_INC_D2_OFFSET );
+    }
+    else
+    {
+        cb->peri->SIZE_D1 = 0;
+    }
+
     /* The window size is set to the transaction size if it was set to 0 in
     order to disable the functionality (it will never be triggered). */
 
-    dma_cb.peri->WINDOW_SIZE =   dma_cb.trans->win_du
-                            ? dma_cb.trans->win_du
-                            : dma_cb.trans->size_b;
+    cb->peri->WINDOW_SIZE =   cb->trans->win_du
+                            ? cb->trans->win_du
+                            : cb->trans->size_b;
 
     /*
      * SET TRIGGER SLOTS AND DATA TYPE
      */
-    write_register(  dma_cb.trans->src->trig,
+    write_register(  cb->peri,
+                    cb->trans->src->trig,
                     DMA_SLOT_REG_OFFSET,
                     DMA_SLOT_RX_TRIGGER_SLOT_MASK,
                     DMA_SLOT_RX_TRIGGER_SLOT_OFFSET );
 
-    write_register(  dma_cb.trans->dst->trig,
+    write_register(  cb->peri,
+                    cb->trans->dst->trig,
                     DMA_SLOT_REG_OFFSET,
                     DMA_SLOT_TX_TRIGGER_SLOT_MASK,
                     DMA_SLOT_TX_TRIGGER_SLOT_OFFSET );
 
-    write_register(  dma_cb.trans->type,
+    write_register(  cb->peri,
+                    cb->trans->type,
                     DMA_DATA_TYPE_REG_OFFSET,
                     DMA_DATA_TYPE_DATA_TYPE_MASK,
                     DMA_SELECTION_OFFSET_START );
 
+    write_register(  cb->peri,
+                    cb->trans->dst_type,
+                    DMA_DST_DATA_TYPE_REG_OFFSET,
+                    DMA_DST_DATA_TYPE_DATA_TYPE_MASK,
+                    DMA_SELECTION_OFFSET_START );
+
+    cb->peri->SIGN_EXT = ( cb->trans->conv == DMA_TYPE_CONV_SIGN_EXT ) << DMA_SIGN_EXT_SIGN_EXT_BIT;
+    cb->peri->PACE     = cb->trans->pace;
+    cb->peri->FILL_VALUE = cb->trans->fill;
+    cb->peri->TIMER    = cb->trans->timer;
+    cb->peri->STROBE   = cb->trans->strobe;
+    cb->peri->ADDR_CFG = get_addr_cfg( cb->trans );
+
     return DMA_CONFIG_OK;
 }
 
@@ -790,10 +1087,12 @@ dma_config_flags_t dma_launch( dma_trans_t *p_trans )
      * launched.
      */
     if(     ( p_trans == NULL )
-        ||  ( dma_cb.trans != p_trans ) ) // @ToDo: Check per-element.
+        ||  ( p_trans->channel >= DMA_CH_NUM )
+        ||  ( dma_cb[ p_trans->channel ].trans != p_trans ) ) // @ToDo: Check per-element.
     {
         return DMA_CONFIG_CRITICAL_ERROR;
     }
+    struct dma_ch_cb *cb = &dma_cb[ p_trans->channel ];
 
     /*
      * CHECK IF THERE IS A TRANSACTION RUNNING
@@ -806,7 +1105,7 @@ dma_config_flags_t dma_launch( dma_trans_t *p_trans )
      * until it has ended.
      * Transactions can still be validated in the meantime.
      */
-    if( !dma_is_ready() )
+    if( !dma_is_ready( p_trans->channel ) )
     {
         return DMA_CONFIG_TRANS_OVERRIDE;
     }
@@ -815,28 +1114,430 @@ dma_config_flags_t dma_launch( dma_trans_t *p_trans )
      * This has to be done prior to writing the register because otherwise
      * the interrupt could arrive before it is lowered.
      */
-    dma_cb.intrFlag = 0;
+    cb->intrFlag = 0;
 
     /* Load the size and start the transaction. */
-    dma_cb.peri->SIZE = dma_cb.trans->size_b;
+    cb->peri->SIZE = cb->trans->size_b;
 
     /*
      * If the end event was set to wait for the interrupt, the dma_launch
-     * will not return until the interrupt arrives.
+     * will not return until the interrupt arrives. Interrupts are disabled
+     * between the check and the wfi so that the interrupt cannot be missed.
+     */
+    volatile uint8_t *intrFlag = &cb->intrFlag;
+    while( p_trans->end == DMA_TRANS_END_INTR_WAIT && *intrFlag == 0 )
+    {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8 );
+        if( *intrFlag == 0 )
+        {
+            wait_for_interrupt();
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
+    }
+
+    return DMA_CONFIG_OK;
+}
+
+dma_config_flags_t dma_compile_transaction( dma_trans_t          *p_trans,
+                                            dma_compiled_trans_t *p_comp )
+{
+    if(     ( p_comp == NULL )
+        ||  ( p_trans->channel >= DMA_CH_NUM )
+        ||  ( p_trans->flags & DMA_CONFIG_CRITICAL_ERROR ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+
+    /* The values are the same that dma_load_transaction() writes. */
+    p_comp->channel     = p_trans->channel;
+    p_comp->end         = p_trans->end;
+    p_comp->size_b      = p_trans->size_b;
+    p_comp->mode        = p_trans->mode;
+    p_comp->data_type   = p_trans->type & DMA_DATA_TYPE_DATA_TYPE_MASK;
+    p_comp->dst_data_type = p_trans->dst_type & DMA_DST_DATA_TYPE_DATA_TYPE_MASK;
+    p_comp->sign_ext    = ( p_trans->conv == DMA_TYPE_CONV_SIGN_EXT ) << DMA_SIGN_EXT_SIGN_EXT_BIT;
+    p_comp->pace        = p_trans->pace;
+    p_comp->fill        = p_trans->fill;
+    p_comp->timer       = p_trans->timer;
+    p_comp->strobe      = p_trans->strobe;
+    p_comp->addr_cfg    = get_addr_cfg( p_trans );
+    p_comp->win_size    = p_trans->win_du ? p_trans->win_du : p_trans->size_b;
+
+    p_comp->intr_en = INTR_EN_NONE;
+    if( p_trans->end != DMA_TRANS_END_POLLING )
+    {
+        p_comp->intr_en = INTR_EN_TRANS_DONE;
+        if( p_trans->win_du > 0 )
+        {
+            p_comp->intr_en |= INTR_EN_WINDOW_DONE;
+        }
+    }
+
+    p_comp->src_ptr  = (uint32_t)p_trans->src->ptr;
+    p_comp->dst_ptr  = 0;
+    p_comp->addr_ptr = 0;
+    p_comp->ptr_inc  = ( get_increment_b( p_trans, p_trans->src )
+                         & DMA_PTR_INC_SRC_PTR_INC_MASK )
+                       << DMA_PTR_INC_SRC_PTR_INC_OFFSET;
+    if( uses_dst_ptr( p_trans ) )
+    {
+        p_comp->dst_ptr  = (uint32_t)p_trans->dst->ptr;
+        p_comp->ptr_inc |= ( get_increment_b( p_trans, p_trans->dst )
+                             & DMA_PTR_INC_DST_PTR_INC_MASK )
+                           << DMA_PTR_INC_DST_PTR_INC_OFFSET;
+    }
+    if( p_trans->mode == DMA_TRANS_MODE_ADDRESS )
+    {
+        p_comp->addr_ptr = (uint32_t)p_trans->src_addr->ptr;
+    }
+
+    p_comp->slot    = ( ( p_trans->src->trig & DMA_SLOT_RX_TRIGGER_SLOT_MASK )
+                        << DMA_SLOT_RX_TRIGGER_SLOT_OFFSET )
+                    | ( ( p_trans->dst->trig & DMA_SLOT_TX_TRIGGER_SLOT_MASK )
+                        << DMA_SLOT_TX_TRIGGER_SLOT_OFFSET );
+
+    p_comp->size_d1    = 0;
+    p_comp->ptr_inc_d2 = 0;
+    if( p_trans->size_d2 > 1 )
+    {
+        p_comp->size_d1    = p_trans->size_b / p_trans->size_d2;
+        p_comp->ptr_inc_d2 =
+              ( ( get_increment_d2_b( p_trans, p_trans->src )
+                  & DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK )
+                << DMA_PTR_INC_D2_SRC_PTR_INC_D2_OFFSET )
+            | ( ( get_increment_d2_b( p_trans, p_trans->dst )
+                  & DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK )
+                << DMA_PTR_INC_D2_DST_PTR_INC_D2_OFFSET );
+    }
+
+    return DMA_CONFIG_OK;
+}
+
+dma_config_flags_t dma_launch_compiled( dma_compiled_trans_t *p_comp,
+                                        uint8_t              *p_src,
+                                        uint8_t              *p_dst )
+{
+    struct dma_ch_cb *cb = &dma_cb[ p_comp->channel ];
+
+    if( !dma_is_ready( p_comp->channel ) )
+    {
+        return DMA_CONFIG_TRANS_OVERRIDE;
+    }
+
+    if( cb->comp != p_comp )
+    {
+        /*
+         * The registers hold another transaction, the whole image is
+         * written. The size is left for the end as it starts the transaction.
+         */
+        cb->trans  = NULL;
+        cb->comp   = p_comp;
+        cb->stream = NULL;
+
+        cb->peri->INTERRUPT_EN = INTR_EN_NONE;
+        CSR_CLEAR_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
+        if( p_comp->intr_en != INTR_EN_NONE )
+        {
+            CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
+            CSR_SET_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
+        }
+
+        cb->peri->SRC_PTR       = p_comp->src_ptr;
+        cb->peri->DST_PTR       = p_comp->dst_ptr;
+        cb->peri->ADDR_PTR      = p_comp->addr_ptr;
+        cb->peri->PTR_INC       = p_comp->ptr_inc;
+        cb->peri->SLOT          = p_comp->slot;
+        cb->peri->DATA_TYPE     = p_comp->data_type;
+        cb->peri->DST_DATA_TYPE = p_comp->dst_data_type;
+        cb->peri->SIGN_EXT      = p_comp->sign_ext;
+        cb->peri->PACE          = p_comp->pace;
+        cb->peri->FILL_VALUE    = p_comp->fill;
+        cb->peri->TIMER         = p_comp->timer;
+        cb->peri->STROBE        = p_comp->strobe;
+        cb->peri->ADDR_CFG      = p_comp->addr_cfg;
+        cb->peri->MODE          = p_comp->mode;
+        cb->peri->WINDOW_SIZE   = p_comp->win_size;
+        cb->peri->SIZE_D1       = p_comp->size_d1;
+        cb->peri->PTR_INC_D2    = p_comp->ptr_inc_d2;
+        cb->peri->INTERRUPT_EN  = p_comp->intr_en;
+    }
+
+    if( p_src != NULL )
+    {
+        cb->peri->SRC_PTR = (uint32_t)p_src;
+    }
+    if( p_dst != NULL )
+    {
+        cb->peri->DST_PTR = (uint32_t)p_dst;
+    }
+
+    cb->intrFlag = 0;
+    cb->peri->SIZE = p_comp->size_b;
+
+    /*
+     * Interrupts are disabled between the check and the wfi so that the
+     * interrupt cannot be missed.
      */
-    while(    p_trans->end == DMA_TRANS_END_INTR_WAIT
-          && ( dma_cb.intrFlag != 0 ) ) { // @ToDo: add a label for this 0
-        wait_for_interrupt();
+    volatile uint8_t *intrFlag = &cb->intrFlag;
+    while( p_comp->end == DMA_TRANS_END_INTR_WAIT && *intrFlag == 0 )
+    {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8 );
+        if( *intrFlag == 0 )
+        {
+            wait_for_interrupt();
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
     }
 
     return DMA_CONFIG_OK;
 }
 
+dma_config_flags_t dma_stream_start(    dma_stream_t    *p_stream,
+                                        dma_trans_t     *p_trans,
+                                        uint32_t        p_slots,
+                                        dma_stream_cb_t p_cb,
+                                        void            *p_ctx )
+{
+    if(     ( p_stream == NULL )
+        ||  ( p_slots < 2 )
+        ||  ( p_trans->channel >= DMA_CH_NUM ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+
+    p_trans->mode   = DMA_TRANS_MODE_CIRCULAR;
+    p_trans->end    = DMA_TRANS_END_INTR;
+    p_trans->win_du = 0;
+    dma_config_flags_t flags = dma_validate_transaction( p_trans,
+                                                  DMA_ENABLE_REALIGN,
+                                                  DMA_PERFORM_CHECKS_INTEGRITY );
+    if( flags & DMA_CONFIG_CRITICAL_ERROR )
+    {
+        return flags;
+    }
+
+    /* Each slot is a window, counted in data units of the transaction. */
+    uint8_t dataSize_b = DMA_DATA_TYPE_2_SIZE( p_trans->type );
+    if( p_trans->size_b % ( p_slots * dataSize_b ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+    p_trans->win_du = p_trans->size_b / p_slots / dataSize_b;
+
+    p_stream->trans     = p_trans;
+    p_stream->slots     = p_slots;
+    p_stream->slot_b    = p_trans->size_b / p_slots;
+    p_stream->cb        = p_cb;
+    p_stream->ctx       = p_ctx;
+    p_stream->produced  = 0;
+    p_stream->consumed  = 0;
+    p_stream->overruns  = 0;
+
+    flags |= dma_load_transaction( p_trans );
+    if( flags & ( DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE ) )
+    {
+        return flags;
+    }
+    /* The stream is attached after loading, which detaches any previous one. */
+    dma_cb[ p_trans->channel ].stream = p_stream;
+    return flags | dma_launch( p_trans );
+}
+
+uint8_t* dma_stream_ring( dma_stream_t *p_stream )
+{
+    return  p_stream->trans->dst->trig == DMA_TRIG_MEMORY
+          ? p_stream->trans->dst->ptr
+          : p_stream->trans->src->ptr;
+}
+
+uint8_t* dma_stream_peek( dma_stream_t *p_stream )
+{
+    if( p_stream->consumed == p_stream->produced )
+    {
+        return NULL;
+    }
+    return  dma_stream_ring( p_stream )
+          + ( p_stream->consumed % p_stream->slots ) * p_stream->slot_b;
+}
+
+void dma_stream_release( dma_stream_t *p_stream )
+{
+    /*
+     * The interrupt may move the consumed count forward on overruns, so the
+     * update is done with interrupts disabled. They are only enabled again if
+     * they were enabled before, as a slot can be released from a callback,
+     * e.g. when the packet buffer of a frame of i2s_capture is freed.
+     */
+    uint32_t mstatus = irq_save();
+    if( p_stream->consumed != p_stream->produced )
+    {
+        p_stream->consumed++;
+    }
+    irq_restore( mstatus );
+}
+
+void dma_stream_stop( dma_stream_t *p_stream )
+{
+    dma_stop_circular( p_stream->trans->channel );
+}
+
+dma_config_flags_t dma_submit( dma_queue_entry_t *p_entry )
+{
+    if(     ( p_entry == NULL )
+        ||  ( p_entry->trans == NULL )
+        ||  ( p_entry->trans->channel >= DMA_CH_NUM )
+        ||  ( p_entry->trans->flags & DMA_CONFIG_CRITICAL_ERROR ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+    uint8_t ch = p_entry->trans->channel;
+    struct dma_ch_cb *cb = &dma_cb[ ch ];
+
+    /* The transaction done interrupt is the one that moves the queue. */
+    p_entry->trans->end = DMA_TRANS_END_INTR;
+    p_entry->next       = NULL;
+
+    /*
+     * The queue is also modified by the interrupt, so interrupts are disabled
+     * while the entry is added. They are only enabled again if they were
+     * enabled before, as this function can be called from the callbacks.
+     */
+    uint32_t mstatus = irq_save();
+
+    dma_config_flags_t flags = DMA_CONFIG_OK;
+    if( cb->head == NULL )
+    {
+        if( !dma_is_ready( ch ) )
+        {
+            flags = DMA_CONFIG_TRANS_OVERRIDE;
+        }
+        else
+        {
+            cb->head = p_entry;
+            cb->tail = p_entry;
+            queue_launch( ch );
+        }
+    }
+    else
+    {
+        cb->tail->next = p_entry;
+        cb->tail       = p_entry;
+    }
+
+    irq_restore( mstatus );
+    return flags;
+}
+
+uint32_t dma_queue_is_empty( uint8_t p_ch )
+{
+    return dma_cb[ p_ch ].head == NULL;
+}
+
+dma_config_flags_t dma_fill_descriptor( dma_desc_t  *p_desc,
+                                        dma_trans_t *p_trans,
+                                        dma_desc_t  *p_next,
+                                        uint8_t     p_intr )
+{
+    /*
+     * The transaction must have been validated, and the DMA only performs
+     * linear transactions in linked-list mode.
+     */
+    if(     ( p_desc == NULL )
+        ||  ( (uint32_t)p_desc & DMA_WORD_ALIGN_MASK )
+        ||  ( (uint32_t)p_next & DMA_WORD_ALIGN_MASK )
+        ||  ( p_trans->flags & DMA_CONFIG_CRITICAL_ERROR )
+        ||  ( p_trans->mode != DMA_TRANS_MODE_SINGLE )
+        ||  ( p_trans->size_d2 > 1 ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+
+    p_desc->next    = p_next;
+    p_desc->src     = (uint32_t)p_trans->src->ptr;
+    p_desc->dst     = (uint32_t)p_trans->dst->ptr;
+    p_desc->size_b  = p_trans->size_b;
+    p_desc->cfg     = ( ( get_increment_b( p_trans, p_trans->src )
+                          & DMA_PTR_INC_SRC_PTR_INC_MASK )
+                        << DMA_DESC_CFG_SRC_INC_OFFSET )
+                    | ( ( get_increment_b( p_trans, p_trans->dst )
+                          & DMA_PTR_INC_DST_PTR_INC_MASK )
+                        << DMA_DESC_CFG_DST_INC_OFFSET )
+                    | ( ( p_trans->type & DMA_DATA_TYPE_DATA_TYPE_MASK )
+                        << DMA_DESC_CFG_DATA_TYPE_OFFSET )
+                    | ( ( p_trans->dst_type & DMA_DST_DATA_TYPE_DATA_TYPE_MASK )
+                        << DMA_DESC_CFG_DST_DATA_TYPE_OFFSET )
+                    | ( ( p_trans->conv == DMA_TYPE_CONV_SIGN_EXT ) << DMA_DESC_CFG_SIGN_EXT_BIT )
+                    | ( ( p_intr ? 1 : 0 ) << DMA_DESC_CFG_INTR_BIT );
+    p_desc->slot    = ( ( p_trans->src->trig & DMA_SLOT_RX_TRIGGER_SLOT_MASK )
+                        << DMA_SLOT_RX_TRIGGER_SLOT_OFFSET )
+                    | ( ( p_trans->dst->trig & DMA_SLOT_TX_TRIGGER_SLOT_MASK )
+                        << DMA_SLOT_TX_TRIGGER_SLOT_OFFSET );
+
+    return DMA_CONFIG_OK;
+}
 
-__attribute__((optimize("O0"))) uint32_t dma_is_ready(void)
+dma_config_flags_t dma_launch_chain(    uint8_t             p_ch,
+                                        dma_desc_t          *p_first,
+                                        dma_trans_end_evt_t p_end )
+{
+    if(     ( p_ch >= DMA_CH_NUM )
+        ||  ( p_first == NULL )
+        ||  ( (uint32_t)p_first & DMA_WORD_ALIGN_MASK ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+    struct dma_ch_cb *cb = &dma_cb[ p_ch ];
+
+    if( !dma_is_ready( p_ch ) )
+    {
+        return DMA_CONFIG_TRANS_OVERRIDE;
+    }
+
+    /* The registers of the loaded transaction are not used by the chain. */
+    cb->trans  = NULL;
+    cb->comp   = NULL;
+    cb->stream = NULL;
+
+    cb->peri->INTERRUPT_EN = INTR_EN_NONE;
+    cb->peri->WINDOW_SIZE  = 0;
+    cb->peri->PACE         = 0;
+    CSR_CLEAR_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
+
+    if( p_end != DMA_TRANS_END_POLLING )
+    {
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
+        CSR_SET_BITS(CSR_REG_MIE, DMA_CSR_REG_MIE_MASK );
+        cb->peri->INTERRUPT_EN = INTR_EN_TRANS_DONE;
+    }
+
+    cb->intrFlag = 0;
+
+    /* Writing the pointer of the first descriptor starts the chain. */
+    cb->peri->DESC_PTR = (uint32_t)p_first;
+
+    /*
+     * Flagged descriptors also raise the interrupt, so wait for the whole
+     * chain to be done. Interrupts are disabled between the check and the
+     * wfi so that the last one cannot be missed.
+     */
+    while( p_end == DMA_TRANS_END_INTR_WAIT && !dma_is_ready( p_ch ) )
+    {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8 );
+        if( !dma_is_ready( p_ch ) )
+        {
+            wait_for_interrupt();
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8 );
+    }
+
+    return DMA_CONFIG_OK;
+}
+
+
+__attribute__((optimize("O0"))) uint32_t dma_is_ready( uint8_t p_ch )
 {
     /* The transaction READY bit is read from the status register*/
-    uint32_t ret = ( dma_cb.peri->STATUS & (1<<DMA_STATUS_READY_BIT) );
+    uint32_t ret = ( read_status( p_ch ) & (1<<DMA_STATUS_READY_BIT) );
     return ret;
 }
 /* @ToDo: Reconsider this decision.
@@ -850,40 +1551,60 @@ __attribute__((optimize("O0"))) uint32_t dma_is_ready(void)
  */
 
 
-uint32_t dma_get_window_count()
+uint32_t dma_get_window_count( uint8_t p_ch )
+{
+    return dma_cb[ p_ch ].peri->WINDOW_COUNT;
+}
+
+
+void dma_get_perf( uint8_t p_ch, dma_perf_t *p_perf )
 {
-    return dma_cb.peri->WINDOW_COUNT;
+    p_perf->busy        = dma_cb[ p_ch ].peri->PERF_BUSY;
+    p_perf->read_stall  = dma_cb[ p_ch ].peri->PERF_READ_STALL;
+    p_perf->write_stall = dma_cb[ p_ch ].peri->PERF_WRITE_STALL;
+    p_perf->beats       = dma_cb[ p_ch ].peri->PERF_BEATS;
 }
 
 
-void dma_stop_circular()
+void dma_stop_circular( uint8_t p_ch )
 {
     /*
      * The DMA finishes the current transaction before and does not start
      * a new one.
      */
-    dma_cb.peri->MODE = DMA_TRANS_MODE_SINGLE;
+    dma_cb[ p_ch ].peri->MODE = DMA_TRANS_MODE_SINGLE;
+}
+
+void dma_release_triggers( uint8_t p_ch )
+{
+    /* The DMA checks the slots on every access, not only at the start. */
+    dma_cb[ p_ch ].peri->SLOT = 0;
+}
+
+uint32_t dma_get_strobe_missed( uint8_t p_ch )
+{
+    return dma_cb[ p_ch ].peri->STROBE_MISSED;
 }
 
 
-__attribute__((weak, optimize("O0"))) void dma_intr_handler_trans_done()
+__attribute__((weak, optimize("O0"))) void dma_intr_handler_trans_done( uint8_t p_ch )
 {
     /*
      * The DMA transaction has finished!
      * This is a weak implementation.
      * Create your own function called
-     * void dma_intr_handler_trans_done()
+     * void dma_intr_handler_trans_done( uint8_t p_ch )
      * to override this one.
      */
 }
 
-__attribute__((weak, optimize("O0"))) void dma_intr_handler_window_done()
+__attribute__((weak, optimize("O0"))) void dma_intr_handler_window_done( uint8_t p_ch )
 {
     /*
      * The DMA has copied another window.
      * This is a weak implementation.
      * Create your own function called
-     * void dma_intr_handler_window_done()
+     * void dma_intr_handler_window_done( uint8_t p_ch )
      * to override this one.
      */
 }
@@ -979,7 +1700,7 @@ dma_config_flags_t validate_target( dma_target_t *p_tgt )
             flags |= DMA_CONFIG_INCOMPATIBLE;
         }
     }
-    else /* If it is a peripheral. */
+    else if( p_tgt->trig != DMA_TRIG_SLOT_TIMER ) /* If it is a peripheral. */
     {
         /* It should not have neither an environment nor an increment. */
         if( (     (p_tgt->env != NULL)
@@ -1114,7 +1835,8 @@ static inline uint8_t is_region_outbound(   uint8_t  *p_start,
 
 /* @ToDo: Consider changing the "mask" parameter for a bitfield definition
 (see dma_regs.h) */
-static inline void write_register( uint32_t  p_val,
+static inline void write_register( dma       *p_peri,
+                                  uint32_t  p_val,
                                   uint32_t  p_offset,
                                   uint32_t  p_mask,
                                   uint8_t   p_sel )
@@ -1128,26 +1850,144 @@ static inline void write_register( uint32_t  p_val,
      * An intermediate variable "value" is used to prevent writing twice into
      * the register.
      */
-    uint32_t value  =  (( uint32_t * ) dma_cb.peri ) [ index ];
+    uint32_t value  =  (( uint32_t * ) p_peri ) [ index ];
     value           &= ~( p_mask << p_sel );
     value           |= (p_val & p_mask) << p_sel;
-    (( uint32_t * ) dma_cb.peri ) [ index ] = value;
+    (( uint32_t * ) p_peri ) [ index ] = value;
 
 // @ToDo: mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_SLOT_REG_OFFSET), (tx_slot_mask << DMA_SLOT_TX_TRIGGER_SLOT_OFFSET) + rx_slot_mask)
 
 }
 
-static inline uint32_t get_increment_b( dma_target_t * p_tgt )
+static void stream_window_done( dma_stream_t *p_stream, uint8_t p_ch )
+{
+    /*
+     * The window count restarts on every lap of the ring buffer, so it is 0
+     * if the last slot was just filled and the DMA already restarted.
+     */
+    uint32_t count  = dma_cb[ p_ch ].peri->WINDOW_COUNT;
+    uint32_t slot   = ( count == 0 ? p_stream->slots : count ) - 1;
+    uint32_t next   = p_stream->produced % p_stream->slots;
+    /* Slots filled since the previous call. 0 if already counted. */
+    uint32_t filled = ( slot + 1 + p_stream->slots - next ) % p_stream->slots;
+
+    for( uint32_t i = 0; i < filled; i++ )
+    {
+        p_stream->produced++;
+        /* The oldest slot is lost if it was not released in time. */
+        if( p_stream->produced - p_stream->consumed > p_stream->slots )
+        {
+            p_stream->consumed++;
+            p_stream->overruns++;
+        }
+        if( p_stream->cb != NULL )
+        {
+            p_stream->cb( p_stream, ( next + i ) % p_stream->slots );
+        }
+    }
+}
+
+static inline uint32_t read_status( uint8_t p_ch )
+{
+    uint32_t status = dma_cb[ p_ch ].peri->STATUS;
+    /*
+     * The control block is only written if an event arrived, so that polling
+     * does not race with the interrupt handlers attending the others.
+     */
+    if( status & ( ( 1 << DMA_STATUS_TRANSACTION_DONE_BIT )
+                 | ( 1 << DMA_STATUS_WINDOW_DONE_BIT ) ) )
+    {
+        dma_cb[ p_ch ].events |= status
+                               & ( ( 1 << DMA_STATUS_TRANSACTION_DONE_BIT )
+                                 | ( 1 << DMA_STATUS_WINDOW_DONE_BIT ) );
+    }
+    return status;
+}
+
+static void queue_launch( uint8_t p_ch )
+{
+    struct dma_ch_cb *cb = &dma_cb[ p_ch ];
+
+    /*
+     * Loading the transaction enables the global interrupts, they are
+     * disabled again if they were disabled by the caller (the interrupt
+     * handler or dma_submit()).
+     */
+    uint32_t mstatus;
+    CSR_READ(CSR_REG_MSTATUS, &mstatus);
+
+    while( cb->head != NULL )
+    {
+        dma_queue_entry_t *entry = cb->head;
+        dma_config_flags_t flags = dma_load_transaction( entry->trans );
+        if( ( mstatus & 0x8 ) == 0 )
+        {
+            CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8 );
+        }
+        if(     ( flags == DMA_CONFIG_OK )
+            &&  ( dma_launch( entry->trans ) == DMA_CONFIG_OK ) )
+        {
+            return;
+        }
+
+        /*
+         * The transaction could not be launched. It is reported as done, so
+         * its callback can find the error in the transaction flags.
+         */
+        entry->trans->flags |= DMA_CONFIG_CRITICAL_ERROR;
+        cb->head = entry->next;
+        if( cb->head == NULL )
+        {
+            cb->tail = NULL;
+        }
+        if( entry->cb != NULL )
+        {
+            entry->cb( entry );
+        }
+    }
+}
+
+static void queue_done( uint8_t p_ch )
+{
+    struct dma_ch_cb *cb = &dma_cb[ p_ch ];
+    dma_queue_entry_t *entry = cb->head;
+
+    /*
+     * The next transaction is launched before calling the callback, so that
+     * the DMA is idle for the shortest time.
+     */
+    cb->head = entry->next;
+    if( cb->head == NULL )
+    {
+        cb->tail = NULL;
+    }
+    else
+    {
+        queue_launch( p_ch );
+    }
+
+    if( entry->cb != NULL )
+    {
+        entry->cb( entry );
+    }
+}
+
+static inline uint32_t get_increment_b( dma_trans_t  *p_trans,
+                                        dma_target_t *p_tgt )
 {
     uint32_t inc_b = 0;
-    /* If the target uses a trigger, the increment remains 0. */
-    if(  p_tgt->trig  == DMA_TRIG_MEMORY )
+    /*
+     * If the target uses a trigger, the increment remains 0. The pacing timer
+     * only times the transfers, so it keeps the increment of the target.
+     */
+    if(     p_tgt->trig  == DMA_TRIG_MEMORY
+        ||  p_tgt->trig  == DMA_TRIG_SLOT_TIMER )
     {
         /*
          * If the transaction increment has been overriden (due to
          * misalignments), then that value is used (it's always set to 1).
          */
-        inc_b = dma_cb.trans->inc_b;
+        inc_b = p_trans->inc_b;
 
         /*
         * Otherwise, the target-specific increment is used transformed into
@@ -1155,13 +1995,66 @@ static inline uint32_t get_increment_b( dma_target_t * p_tgt )
         */
         if( inc_b == 0 )
         {
-            uint8_t dataSize_b = DMA_DATA_TYPE_2_SIZE( dma_cb.trans->type );
+            dma_data_type_t type = ( p_tgt == p_trans->dst ) ? p_trans->dst_type
+                                                             : p_trans->type;
+            uint8_t dataSize_b = DMA_DATA_TYPE_2_SIZE( type );
             inc_b = ( p_tgt->inc_du * dataSize_b );
         }
     }
     return inc_b;
 }
 
+static inline int32_t get_increment_d2_b(   dma_trans_t  *p_trans,
+                                            dma_target_t *p_tgt )
+{
+    int32_t inc_b = get_increment_b( p_trans, p_tgt );
+    /* Peripherals and targets with contiguous rows keep the row increment. */
+    if(     ( p_tgt->trig  != DMA_TRIG_MEMORY )
+        ||  ( p_tgt->stride_d2_du == 0 ) )
+    {
+        return inc_b;
+    }
+    /*
+     * The stride is given in data units of the source (or of the converted
+     * destination), while the increment is applied after each data unit of
+     * the (maybe realigned) transaction.
+     */
+    uint8_t  srcSize_b  = DMA_DATA_TYPE_2_SIZE( p_trans->src->type );
+    uint32_t rowSize_du = ( p_trans->src->size_du * srcSize_b )
+                          / DMA_DATA_TYPE_2_SIZE( p_trans->type );
+    return  (int32_t)( p_tgt->stride_d2_du * get_stride_unit_b( p_trans, p_tgt ) )
+          - (int32_t)( ( rowSize_du - 1 ) * inc_b );
+}
+
+static inline uint8_t get_stride_unit_b(    dma_trans_t  *p_trans,
+                                            dma_target_t *p_tgt )
+{
+    /* Only a converted destination has its own data units. */
+    if( ( p_tgt == p_trans->dst ) && p_trans->conv )
+    {
+        return DMA_DATA_TYPE_2_SIZE( p_trans->dst->type );
+    }
+    return DMA_DATA_TYPE_2_SIZE( p_trans->src->type );
+}
+
+static inline uint8_t uses_dst_ptr( dma_trans_t *p_trans )
+{
+    return  ( p_trans->mode != DMA_TRANS_MODE_ADDRESS )
+        ||  ( p_trans->addr_table != DMA_ADDR_TABLE_DST_PTRS );
+}
+
+static inline uint32_t get_addr_cfg( dma_trans_t *p_trans )
+{
+    if( p_trans->mode != DMA_TRANS_MODE_ADDRESS )
+    {
+        return 0;
+    }
+    /* The values of the table enumeration are the GATHER and OFFSETS bits. */
+    return  (uint32_t)p_trans->addr_table
+          | ( ( p_trans->addr_shift & DMA_ADDR_CFG_SHIFT_MASK )
+              << DMA_ADDR_CFG_SHIFT_OFFSET );
+}
+
 /****************************************************************************/
 /**                                                                        **/
 /*                                 EOF                                      */
@@ -77,6 +77,78 @@ extern "C" {
  */
 #define DMA_DATA_TYPE_2_SIZE(type) (0b00000100 >> (type) )
 
+/**
+ * Fields of the configuration word of a descriptor (see dma_desc_t).
+ */
+#define DMA_DESC_CFG_SRC_INC_OFFSET     0
+#define DMA_DESC_CFG_DST_INC_OFFSET     8
+#define DMA_DESC_CFG_DATA_TYPE_OFFSET   16
+#define DMA_DESC_CFG_DST_DATA_TYPE_OFFSET 18
+#define DMA_DESC_CFG_SIGN_EXT_BIT       20
+#define DMA_DESC_CFG_INTR_BIT           31
+
+/**
+ * The STROBE register of a channel (see dma_trans_t): the GPIO of the strobe
+ * and the edges that trigger DMA_TRIG_SLOT_GPIO_STROBE.
+ */
+#define DMA_STROBE_RISE                 ( 1 << DMA_STROBE_RISE_BIT )
+#define DMA_STROBE_FALL                 ( 1 << DMA_STROBE_FALL_BIT )
+#define DMA_STROBE( p_pin, p_edges )    ( ( ( p_pin ) & DMA_STROBE_PIN_MASK ) | ( p_edges ) )
+
+/**
+ * Zero if p_cond holds, else a compilation error (a negative array size) when
+ * p_cond is a constant expression.
+ */
+#define DMA_STATIC_CHECK_ZERO( p_cond ) \
+    ( 0 * sizeof( char[ ( p_cond ) ? 1 : -1 ] ) )
+
+/**
+ * Initializer of the compiled transaction (see dma_compiled_trans_t) of a
+ * memory to memory copy of p_size_du contiguous data units of p_type, checked
+ * at compile time instead of by dma_validate_transaction() when the
+ * arguments are constants:
+ *
+ *   static dma_compiled_trans_t copy = DMA_COMPILED_COPY( 0,
+ *          DMA_DATA_TYPE_WORD, 64, DMA_TRANS_END_POLLING );
+ *   dma_launch_compiled( &copy, src, dst );
+ *
+ * The pointers are given to dma_launch_compiled(), at least the first time,
+ * and must be aligned to the data type: they are not checked.
+ * See dma_static.hpp for the other transactions, from C++.
+ */
+#define DMA_COMPILED_COPY( p_ch, p_type, p_size_du, p_end )                  \
+    {                                                                       \
+        .src_ptr        = 0,                                                \
+        .dst_ptr        = 0,                                                \
+        .addr_ptr       = 0,                                                \
+        .size_b         = ( p_size_du ) * DMA_DATA_TYPE_2_SIZE( p_type )    \
+                          + DMA_STATIC_CHECK_ZERO( ( p_size_du ) > 0 )      \
+                          + DMA_STATIC_CHECK_ZERO( ( p_type ) < DMA_DATA_TYPE__size ), \
+        .ptr_inc        = ( DMA_DATA_TYPE_2_SIZE( p_type )                  \
+                            << DMA_PTR_INC_SRC_PTR_INC_OFFSET )             \
+                        | ( DMA_DATA_TYPE_2_SIZE( p_type )                  \
+                            << DMA_PTR_INC_DST_PTR_INC_OFFSET ),            \
+        .slot           = 0,                                                \
+        .data_type      = ( p_type ),                                       \
+        .dst_data_type  = ( p_type ),                                       \
+        .sign_ext       = 0,                                                \
+        .mode           = DMA_TRANS_MODE_SINGLE,                            \
+        .win_size       = ( p_size_du ) * DMA_DATA_TYPE_2_SIZE( p_type ),   \
+        .intr_en        = ( ( p_end ) != DMA_TRANS_END_POLLING )            \
+                          << DMA_INTERRUPT_EN_TRANSACTION_DONE_BIT,         \
+        .size_d1        = 0,                                                \
+        .ptr_inc_d2     = 0,                                                \
+        .pace           = 0,                                                \
+        .fill           = 0,                                                \
+        .timer          = 0,                                                \
+        .strobe         = 0,                                                \
+        .addr_cfg       = 0,                                                \
+        .channel        = ( p_ch )                                          \
+                          + DMA_STATIC_CHECK_ZERO( ( p_ch ) < DMA_CH_NUM ), \
+        .end            = (dma_trans_end_evt_t)( ( p_end )                  \
+                          + DMA_STATIC_CHECK_ZERO( ( p_end ) < DMA_TRANS_END__size ) ), \
+    }
+
 /****************************************************************************/
 /**                                                                        **/
 /**                       TYPEDEFS AND STRUCTURES                          **/
@@ -106,6 +178,17 @@ typedef enum
     DMA_TRIG_SLOT_I2S           = 16,/*!< Slot 5 (I2S). */
     DMA_TRIG_SLOT_EXT_TX        = 32,/*!< Slot 6 (External peripherals TX). */
     DMA_TRIG_SLOT_EXT_RX        = 64,/*!< Slot 7 (External peripherals RX). */
+    DMA_TRIG_SLOT_PDM2PCM       = 128,/*!< Slot 8 (PDM2PCM). */
+    DMA_TRIG_SLOT_UART_RX       = 256,/*!< Slot 9 (MEM < UART). */
+    DMA_TRIG_SLOT_UART_TX       = 512,/*!< Slot 10 (MEM > UART). */
+    DMA_TRIG_SLOT_I2C_RX        = 1024,/*!< Slot 11 (MEM < I2C). */
+    DMA_TRIG_SLOT_I2C_FMT       = 2048,/*!< Slot 12 (MEM > I2C FMT). */
+    DMA_TRIG_SLOT_CRC           = 4096,/*!< Slot 13 (MEM > CRC). */
+    DMA_TRIG_SLOT_I2S_TX        = 8192,/*!< Slot 14 (MEM > I2S TX). */
+    DMA_TRIG_SLOT_GPIO_STROBE   = 16384,/*!< Slot 15 (edges of the GPIO
+    strobe of the channel, one transfer per edge, see dma_trans_t). */
+    DMA_TRIG_SLOT_TIMER         = 32768,/*!< Slot 16 (pacing timer of the
+    channel, one transfer every timer cycles, see dma_trans_t). */
     DMA_TRIG__size,      /*!< Not used, only for sanity checks. */
     DMA_TRIG__undef,     /*!< DMA will not be used. */
 } dma_trigger_slot_mask_t;
@@ -134,6 +217,23 @@ typedef enum
     DMA_DATA_TYPE__undef,   /*!< DMA will not be used. */
 } dma_data_type_t;
 
+/**
+ * The DMA can write the data with a different type than the one it is read
+ * with, e.g. to turn 16-bit samples into 32-bit words. When the destination
+ * type is wider the data is extended, and when it is narrower the upper bits
+ * are dropped. The size of the transaction is given in bytes of the source.
+ */
+typedef enum
+{
+    DMA_TYPE_CONV_NONE      = 0, /*!< The data is written with the type of the
+    source, the type of the destination is not used. */
+    DMA_TYPE_CONV_ZERO_EXT  = 1, /*!< The data is written with the type of the
+    destination, extended with zeros. */
+    DMA_TYPE_CONV_SIGN_EXT  = 2, /*!< The data is written with the type of the
+    destination, extended with its sign bit. */
+    DMA_TYPE_CONV__size,    /*!< Not used, only for sanity checks. */
+} dma_type_conv_t;
+
 /**
  * It is possible to choose the level of safety with which the DMA operation
  * should be configured.
@@ -181,11 +281,36 @@ typedef enum
     re-loaded automatically (no need to call dma_trans_load), with the same
     parameters. This generates a circular mode in the source and/or destination
     pointing to memory.  */
-    DMA_TRANS_MODE_ADDRESS = DMA_MODE_MODE_VALUE_ADDRESS_MODE, /*!< In this mode, the destination address is read from the address port! */
+    DMA_TRANS_MODE_ADDRESS = DMA_MODE_MODE_VALUE_ADDRESS_MODE, /*!< In this mode, the destination address is read from the address port!
+    The table of src_addr can also give the source addresses, or offsets,
+    see dma_addr_table_t. */
+    DMA_TRANS_MODE_FILL = DMA_MODE_MODE_VALUE_FILL_MODE, /*!< The fill value
+    of the transaction is written to the destination, nothing is read. The
+    source only gives the data type and the size, its pointer is ignored. */
 
     DMA_TRANS_MODE__size,       /*!< Not used, only for sanity checks. */
 } dma_trans_mode_t;
 
+/**
+ * What the table of src_addr holds in address mode: a 32-bit entry per data
+ * unit, either addresses or offsets from the pointer of a target. The
+ * offsets are shifted left by the addr_shift of the transaction, so that
+ * they can be the indexes of the elements of an array.
+ * The values are those of the GATHER and OFFSETS bits of ADDR_CFG.
+ */
+typedef enum
+{
+    DMA_ADDR_TABLE_DST_PTRS     = 0, /*!< The destination addresses (scatter),
+    the source is read as in single mode. */
+    DMA_ADDR_TABLE_SRC_PTRS     = 1, /*!< The source addresses (gather), the
+    destination is written as in single mode. */
+    DMA_ADDR_TABLE_DST_OFFSETS  = 2, /*!< Offsets of the destination addresses
+    from dst->ptr. */
+    DMA_ADDR_TABLE_SRC_OFFSETS  = 3, /*!< Offsets of the source addresses from
+    src->ptr. */
+    DMA_ADDR_TABLE__size,       /*!< Not used, only for sanity checks. */
+} dma_addr_table_t;
+
 /**
  * Different possible actions that determine the end of the DMA transaction.
  * This choice does not affect the transaction, but only the way the
@@ -283,9 +408,15 @@ typedef struct
     every time a read/write operation is done. It is a multiple of the data units.
     Can be left blank if the target is a peripheral. */
     uint32_t                size_du; /*!< The size (in data units) of the data to
-    be copied. Can be left blank if the target will only be used as destination.*/
+    be copied. Can be left blank if the target will only be used as destination.
+    In 2D transactions it is the size of each row. */
+    uint32_t                stride_d2_du; /*!< The distance (in data units of
+    the source, or of the destination in a destination target if the data type
+    is converted) between the start of two consecutive rows of a 2D transaction.
+    It can be left blank if the rows are contiguous in this target. */
     dma_data_type_t         type;    /*!< The type of data to be transferred.
-    Can be left blank if the target will only be used as destination. */
+    Can be left blank if the target will only be used as destination, unless
+    the transaction converts the data type (see dma_type_conv_t). */
     dma_trigger_slot_mask_t trig;    /*!< If the target is a peripheral, a
     trigger can be set to control the data flow.  */
 } dma_target_t;
@@ -308,8 +439,13 @@ typedef struct
     need to use one same increment. */
     uint32_t            size_b; /*!< The size of the transfer, in bytes (in
     contrast, the size stored in the targets is in data units). */
-    dma_data_type_t     type;   /*!< The data type to use. One is chosen among
-    the targets. */
+    dma_data_type_t     type;   /*!< The data type of the reads. It is the type
+    of the source, or a smaller one if a realignment was needed. */
+    dma_data_type_t     dst_type; /*!< The data type of the writes. It is the
+    same as type, unless the data type is converted. */
+    dma_type_conv_t     conv;   /*!< Whether the data is written with the type
+    of the destination, and how it is extended. It can be left blank to write
+    it with the type of the source. */
     dma_trans_mode_t    mode;   /*!< The copy mode to use. */
     uint32_t            win_du;  /*!< The amount of data units every which the
     WINDOW_DONE flag is raised and its corresponding interrupt triggered. It
@@ -318,8 +454,166 @@ typedef struct
     is launched. */
     dma_config_flags_t  flags;  /*!< A mask with possible issues aroused from
     the creation of the transaction. */
+    uint8_t             channel; /*!< The DMA channel that performs the
+    transaction, from 0 to DMA_CH_NUM - 1. */
+    uint32_t            size_d2; /*!< The number of rows of a 2D transaction,
+    each one of src->size_du data units. It can be left blank (or set to 1)
+    for linear transactions. */
+    uint16_t            pace;   /*!< The minimum number of cycles between the
+    starts of two writes, to output the data at a fixed rate, e.g. a waveform
+    to the GPIOs. It can be left blank (or set to 1) to write as fast as
+    possible. Chains of descriptors are not paced. */
+    uint32_t            fill;   /*!< The value written in fill mode, in the
+    low bits for the data type of the source. It is extended or truncated as
+    the data read if the data type is converted. */
+    uint32_t            timer;  /*!< The period in cycles of the pacing timer
+    of the channel, for the target triggered by DMA_TRIG_SLOT_TIMER: the
+    target is read or written once at the start, then once per period, e.g.
+    to sample a register or drive a DAC at a fixed rate. A tick is dropped if
+    the bus was too slow for the transfer of the previous one. Unlike with
+    the other slots, the target keeps its increment. */
+    uint32_t            strobe; /*!< The strobe of the channel, for the target
+    triggered by DMA_TRIG_SLOT_GPIO_STROBE: DMA_STROBE( pin, edges ), with the
+    GPIO of the pin (0 to 31) and DMA_STROBE_RISE and/or DMA_STROBE_FALL. The
+    target is read or written once per edge, a few cycles after it, e.g. to
+    capture the data of a parallel sensor from GPIO_IN. An edge arriving
+    before the transfer of the previous one is counted as missed. */
+    dma_addr_table_t    addr_table; /*!< In address mode, what the table of
+    src_addr holds. It can be left blank for destination addresses. */
+    uint8_t             addr_shift; /*!< In address mode, the left shift of
+    the offsets of the table, from 0 to 3. */
 } dma_trans_t;
 
+/**
+ * A descriptor is a transaction stored in memory, in the format read by the
+ * DMA in linked-list mode. Descriptors are chained through their next pointer
+ * and the DMA performs them one after the other without any intervention of
+ * the CPU. They are filled from validated transactions with
+ * dma_fill_descriptor() and must stay in memory until the chain is done.
+ */
+typedef struct dma_desc
+{
+    struct dma_desc*    next;   /*!< Next descriptor of the chain, NULL for the
+    last one. */
+    uint32_t            src;    /*!< Source pointer. */
+    uint32_t            dst;    /*!< Destination pointer. */
+    uint32_t            size_b; /*!< The size of the transfer, in bytes. */
+    uint32_t            cfg;    /*!< Source and destination increments (in
+    bytes), data types, sign extension and interrupt flag, see
+    DMA_DESC_CFG_*. */
+    uint32_t            slot;   /*!< Rx (lower half) and Tx (upper half)
+    trigger slots. */
+} dma_desc_t;
+
+/**
+ * A compiled transaction is the image of the DMA registers of a validated
+ * transaction. It is filled once with dma_compile_transaction() and can then
+ * be launched repeatedly with dma_launch_compiled(), skipping the validation
+ * and, while it stays loaded in its channel, all the register writes but the
+ * pointers and the size.
+ */
+typedef struct
+{
+    uint32_t            src_ptr;    /*!< SRC_PTR register. */
+    uint32_t            dst_ptr;    /*!< DST_PTR register. */
+    uint32_t            addr_ptr;   /*!< ADDR_PTR register. */
+    uint32_t            size_b;     /*!< SIZE register, written last as it
+    starts the transaction. */
+    uint32_t            ptr_inc;    /*!< PTR_INC register. */
+    uint32_t            slot;       /*!< SLOT register. */
+    uint32_t            data_type;  /*!< DATA_TYPE register. */
+    uint32_t            dst_data_type; /*!< DST_DATA_TYPE register. */
+    uint32_t            sign_ext;   /*!< SIGN_EXT register. */
+    uint32_t            mode;       /*!< MODE register. */
+    uint32_t            win_size;   /*!< WINDOW_SIZE register. */
+    uint32_t            intr_en;    /*!< INTERRUPT_EN register. */
+    uint32_t            size_d1;    /*!< SIZE_D1 register. */
+    uint32_t            ptr_inc_d2; /*!< PTR_INC_D2 register. */
+    uint32_t            pace;       /*!< PACE register. */
+    uint32_t            fill;       /*!< FILL_VALUE register. */
+    uint32_t            timer;      /*!< TIMER register. */
+    uint32_t            strobe;     /*!< STROBE register. */
+    uint32_t            addr_cfg;   /*!< ADDR_CFG register. */
+    uint8_t             channel;    /*!< The channel of the transaction. */
+    dma_trans_end_evt_t end;        /*!< The end event of the transaction. */
+} dma_compiled_trans_t;
+
+struct dma_stream;
+
+/**
+ * Function called from the window done interrupt when a slot of a stream has
+ * been filled.
+ */
+typedef void (*dma_stream_cb_t)( struct dma_stream *p_stream, uint32_t p_slot );
+
+/**
+ * A stream is a circular transaction whose destination is a ring buffer of
+ * equally sized slots. The DMA raises the window done interrupt after each
+ * slot, and the HAL keeps count of the filled (produced) and released
+ * (consumed) slots so the application can process each slot while the next
+ * ones are filled.
+ * The ring buffer can also be the source of a transaction to a peripheral,
+ * then a slot is produced when the DMA has read it, and the application
+ * releases it once it has written it again.
+ */
+typedef struct dma_stream
+{
+    dma_trans_t*        trans;      /*!< The circular transaction, its
+    destination is the ring buffer, or its source if the destination is a
+    peripheral. */
+    uint32_t            slots;      /*!< Number of slots of the ring buffer. */
+    uint32_t            slot_b;     /*!< Size of each slot, in bytes. */
+    dma_stream_cb_t     cb;         /*!< Called when a slot is filled, it may be
+    NULL. */
+    void*               ctx;        /*!< User context, not used by the HAL. */
+    volatile uint32_t   produced;   /*!< Number of slots filled since the
+    start. */
+    volatile uint32_t   consumed;   /*!< Number of slots released since the
+    start. */
+    volatile uint32_t   overruns;   /*!< Number of slots overwritten by the DMA
+    before they were released. */
+} dma_stream_t;
+
+struct dma_queue_entry;
+
+/**
+ * Function called when a queued transaction is done, from the transaction
+ * done interrupt. It may submit new transactions.
+ */
+typedef void (*dma_queue_cb_t)( struct dma_queue_entry *p_entry );
+
+/**
+ * An entry of the submission queue of a channel. The queued transactions are
+ * performed one after the other: the transaction done interrupt launches the
+ * next one and then calls the callback of the finished one.
+ */
+typedef struct dma_queue_entry
+{
+    dma_trans_t*            trans;  /*!< The transaction, validated with
+    dma_validate_transaction(). Its end event is set to DMA_TRANS_END_INTR when
+    submitted. */
+    dma_queue_cb_t          cb;     /*!< Called when the transaction is done,
+    it may be NULL. */
+    void*                   ctx;    /*!< User context, not used by the HAL. */
+    struct dma_queue_entry* next;   /*!< Next entry of the queue, set by the
+    HAL. */
+} dma_queue_entry_t;
+
+/**
+ * Performance counters of a channel. The DMA clears them when a transaction
+ * (or a chain of descriptors) starts.
+ */
+typedef struct
+{
+    uint32_t busy;          /*!< Cycles the channel was busy. */
+    uint32_t read_stall;    /*!< Cycles a read request waited for its
+    grant. */
+    uint32_t write_stall;   /*!< Cycles a write request waited for its
+    grant. */
+    uint32_t beats;         /*!< Data units written. The bandwidth is
+    beats * data type size / busy bytes per cycle. */
+} dma_perf_t;
+
 /****************************************************************************/
 /**                                                                        **/
 /**                          EXPORTED VARIABLES                            **/
@@ -346,9 +640,11 @@ void fic_irq_dma(void);
 /**
  *@brief Takes all DMA configurations to a state where no accidental
  * transaction can be performed.
- * It can be called anytime to reset the DMA control block.
+ * It can be called anytime to reset the DMA control blocks of all the
+ * channels.
  * @param peri Pointer to a register address following the dma structure. By
- * default (peri == NULL), the integrated DMA will be used.
+ * default (peri == NULL), the integrated DMA will be used. Otherwise it
+ * replaces channel 0.
  */
 void dma_init( dma *peri );
 
@@ -395,6 +691,146 @@ dma_config_flags_t dma_load_transaction( dma_trans_t* p_trans );
  */
 dma_config_flags_t dma_launch( dma_trans_t* p_trans );
 
+/**
+ * @brief Compiles a validated transaction into the image of the DMA registers,
+ * to be launched with dma_launch_compiled(). The transaction is not needed
+ * after this call.
+ * @param p_trans Pointer to a transaction validated with
+ * dma_validate_transaction().
+ * @param p_comp Pointer to the compiled transaction to fill.
+ * @retval DMA_CONFIG_CRITICAL_ERROR if the transaction was not validated.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_compile_transaction( dma_trans_t          *p_trans,
+                                            dma_compiled_trans_t *p_comp );
+
+/**
+ * @brief Launches a compiled transaction with the minimum number of register
+ * writes. The whole image is only written if another transaction was loaded
+ * in the channel since the last launch of this one, otherwise only the
+ * patched pointers and the size are.
+ * @param p_comp Pointer to the compiled transaction. It must not be modified
+ * between launches, it is recognized by its address.
+ * @param p_src If not NULL, replaces the source pointer of the transaction.
+ * @param p_dst If not NULL, replaces the destination pointer of the
+ * transaction.
+ * @note The patched pointers are not checked against the environments, and
+ * they are kept by the following launches that do not patch them.
+ * @retval DMA_CONFIG_TRANS_OVERRIDE if a transaction is running.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_launch_compiled( dma_compiled_trans_t *p_comp,
+                                        uint8_t              *p_src,
+                                        uint8_t              *p_dst );
+
+/**
+ * @brief Starts a stream: the transaction is run in circular mode with a
+ * window for each slot of its destination, and the window done interrupt
+ * updates the stream.
+ * @param p_stream Pointer to the stream to start. It must be a static
+ * variable.
+ * @param p_trans Pointer to the transaction. Its source size is the size of the
+ * whole ring buffer, and mode, window and end event are set by this function.
+ * @param p_slots Number of slots of the ring buffer, at least 2. The size of
+ * the transaction must be a multiple of it.
+ * @param p_cb Function called when a slot is filled, or NULL.
+ * @param p_ctx User context stored in the stream.
+ * @return The configuration flags of the transaction, or
+ * DMA_CONFIG_CRITICAL_ERROR if the slots are not valid.
+ */
+dma_config_flags_t dma_stream_start(    dma_stream_t    *p_stream,
+                                        dma_trans_t     *p_trans,
+                                        uint32_t        p_slots,
+                                        dma_stream_cb_t p_cb,
+                                        void            *p_ctx );
+
+/**
+ * @brief Gets the oldest slot filled and not released yet.
+ * @param p_stream Pointer to the stream.
+ * @return A pointer to the slot, NULL if there is none.
+ */
+uint8_t* dma_stream_peek( dma_stream_t *p_stream );
+
+/**
+ * @brief Gets the ring buffer of a stream: the destination of its
+ * transaction, or its source if the destination is a peripheral.
+ * @param p_stream Pointer to the stream.
+ * @return A pointer to the first slot.
+ */
+uint8_t* dma_stream_ring( dma_stream_t *p_stream );
+
+/**
+ * @brief Releases the oldest filled slot, so that the DMA can fill it again.
+ * @param p_stream Pointer to the stream.
+ */
+void dma_stream_release( dma_stream_t *p_stream );
+
+/**
+ * @brief Stops a stream after the current lap of the ring buffer.
+ * @param p_stream Pointer to the stream.
+ */
+void dma_stream_stop( dma_stream_t *p_stream );
+
+/**
+ * @brief Adds a transaction to the submission queue of its channel. It is
+ * launched right away if the queue was empty, otherwise when the transactions
+ * before it are done. It can be called from the callbacks.
+ * @param p_entry Pointer to the entry to submit. It must be a static variable
+ * and not be modified until its callback is called.
+ * @note The channel must not be used by other functions while its queue is
+ * not empty.
+ * @retval DMA_CONFIG_TRANS_OVERRIDE if the queue is empty and a transaction
+ * that was not queued is running.
+ * @retval DMA_CONFIG_CRITICAL_ERROR if the transaction was not validated.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_submit( dma_queue_entry_t *p_entry );
+
+/**
+ * @brief Checks whether the submission queue of a channel is empty, i.e. all
+ * the submitted transactions are done and their callbacks were called.
+ * @param p_ch The channel to check.
+ * @retval 0 - There are transactions in the queue.
+ * @retval 1 - The queue is empty.
+ */
+uint32_t dma_queue_is_empty( uint8_t p_ch );
+
+/**
+ * @brief Stores a validated transaction in a descriptor, to be performed as
+ * part of a chain.
+ * @param p_desc Pointer to the descriptor to fill. It must be word aligned.
+ * @param p_trans Pointer to a transaction validated with
+ * dma_validate_transaction(). Only single mode transactions can be chained,
+ * and the window and end event of the transaction are ignored.
+ * @param p_next The descriptor to perform after this one, NULL to end the
+ * chain.
+ * @param p_intr If non-zero, the transaction done interrupt is also raised
+ * when this descriptor is done, not only at the end of the chain.
+ * @retval DMA_CONFIG_CRITICAL_ERROR if the transaction cannot be chained.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_fill_descriptor( dma_desc_t  *p_desc,
+                                        dma_trans_t *p_trans,
+                                        dma_desc_t  *p_next,
+                                        uint8_t     p_intr );
+
+/**
+ * @brief Launches a chain of descriptors. The DMA fetches each descriptor
+ * when the previous transaction is done, and raises the transaction done
+ * interrupt at the end of the chain and after the flagged descriptors.
+ * dma_is_ready() returns 1 once the whole chain is done.
+ * @param p_ch The channel that performs the chain.
+ * @param p_first The first descriptor of the chain.
+ * @param p_end What should happen after the chain is launched.
+ * @retval DMA_CONFIG_TRANS_OVERRIDE if a transaction is running.
+ * @retval DMA_CONFIG_CRITICAL_ERROR if the channel is not valid or p_first is
+ * NULL or not word aligned.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_launch_chain(    uint8_t             p_ch,
+                                        dma_desc_t          *p_first,
+                                        dma_trans_end_evt_t p_end );
+
 /**
  * @brief Read from the done register of the DMA. Additionally decreases the
  * count of simultaneously-launched transactions. Be careful when calling this
@@ -404,39 +840,69 @@ dma_config_flags_t dma_launch( dma_trans_t* p_trans );
  * event.
  * @return Whether the DMA is working or not. It starts returning 0 as soon as
  * the dma_launch function has returned.
+ * @param p_ch The channel to check.
  * @retval 0 - DMA is working.
  * @retval 1 - DMA has finished the transmission. DMA is idle.
  */
-uint32_t dma_is_ready(void);
+uint32_t dma_is_ready( uint8_t p_ch );
 
 /**
  * @brief Get the number of windows that have already been written. Resets on
  * the start of each transaction.
+ * @param p_ch The channel to check.
  * @return The number of windows that have been written from this transaction.
  */
-uint32_t dma_get_window_count(void);
+uint32_t dma_get_window_count( uint8_t p_ch );
+
+/**
+ * @brief Reads the performance counters of a channel, of the current or last
+ * transaction.
+ * @param p_ch The channel to read.
+ * @param p_perf Pointer to the structure to fill.
+ */
+void dma_get_perf( uint8_t p_ch, dma_perf_t *p_perf );
 
 /**
  * @brief Prevent the DMA from relaunching the transaction automatically after
  * finishing the current one. It does not affect the currently running
  * transaction. It has no effect if the DMA is operating in SINGULAR
  * transaction mode.
+ * @param p_ch The channel to stop.
+ */
+void dma_stop_circular( uint8_t p_ch );
+
+/**
+ * @brief Clears the trigger slots of a channel, so that a transaction waiting
+ * for a peripheral that will not provide its data (e.g. after a bus error)
+ * runs to its end. The data it moves from then on is not valid.
+ * @param p_ch The channel to release.
+ */
+void dma_release_triggers( uint8_t p_ch );
+
+/**
+ * @brief Reads the number of strobe edges missed by a channel since the start
+ * of its transaction, the edges arriving while the transfer of the previous
+ * one was still pending.
+ * @param p_ch The channel to read.
+ * @return The number of edges missed.
  */
-void dma_stop_circular(void);
+uint32_t dma_get_strobe_missed( uint8_t p_ch );
 
 /**
 * @brief DMA interrupt handler.
 * `dma.c` provides a weak definition of this symbol, which can be overridden
 * at link-time by providing an additional non-weak definition.
+* @param p_ch The channel that finished its transaction.
 */
-void dma_intr_handler_trans_done(void);
+void dma_intr_handler_trans_done( uint8_t p_ch );
 
 /**
 * @brief DMA interrupt handler.
 * `dma.c` provides a weak definition of this symbol, which can be overridden
 * at link-time by providing an additional non-weak definition.
+* @param p_ch The channel that finished a window.
 */
-void dma_intr_handler_window_done(void);
+void dma_intr_handler_window_done( uint8_t p_ch );
 
 /**
  * @brief This weak implementation allows the user to override the threshold
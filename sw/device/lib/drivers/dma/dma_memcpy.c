@@ -0,0 +1,342 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_memcpy.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dma_memcpy.c
+* @date   14/10/26
+* @brief  Drop-in replacements of memcpy, memset and memmove that perform the
+* large copies with the DMA.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dma_memcpy.h"
+
+/* CPU copies. */
+#include "memory.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Mask to determine if an address is multiple of 4 (Word aligned).
+ */
+#define DMA_MEMCPY_WORD_ALIGN_MASK 3
+
+/**
+ * Mask to determine if an address is multiple of 2 (Half Word aligned).
+ */
+#define DMA_MEMCPY_HALF_WORD_ALIGN_MASK 1
+
+#if DMA_MEMCPY_CH >= DMA_CH_NUM
+#error "DMA_MEMCPY_CH is not a channel of the DMA"
+#endif
+
+#if DMA_MEMCPY_STRIPES < 1 || DMA_MEMCPY_CH + DMA_MEMCPY_STRIPES > DMA_CH_NUM
+#error "DMA_MEMCPY_STRIPES channels from DMA_MEMCPY_CH are not channels of the DMA"
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Copies or fills a region, the body with the DMA and the misaligned
+ * head and tail with the CPU.
+ * @param p_dst The destination of the copy.
+ * @param p_src The source of the copy, NULL for a fill.
+ * @param p_value The byte to fill with, if p_src is NULL.
+ * @param p_len The number of bytes to copy.
+ * @return The completion token of the copy.
+ */
+static dma_copy_token_t copy_async( uint8_t       *p_dst,
+                                    const uint8_t *p_src,
+                                    uint8_t       p_value,
+                                    size_t        p_len );
+
+/**
+ * @brief Whether a region is in the interleaved banks.
+ */
+static uint32_t in_interleaved( const uint8_t *p_ptr, size_t p_len );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            GLOBAL VARIABLES                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Transactions of the copies, one per stripe. They are kept until the next
+ * copy because they are the loaded transactions of the channels.
+ */
+static struct
+{
+    struct
+    {
+        dma_target_t src;
+        dma_target_t dst;
+        dma_trans_t  trans;
+    } stripe[ DMA_MEMCPY_STRIPES ];
+} copy;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+dma_copy_token_t dma_memcpy_async( void *dst, const void *src, size_t len )
+{
+    return copy_async( (uint8_t*) dst, (const uint8_t*) src, 0, len );
+}
+
+dma_copy_token_t dma_memset_async( void *dst, int value, size_t len )
+{
+    return copy_async( (uint8_t*) dst, NULL, (uint8_t) value, len );
+}
+
+dma_copy_token_t dma_memmove_async( void *dst, const void *src, size_t len )
+{
+    uint8_t       *d = (uint8_t*) dst;
+    const uint8_t *s = (const uint8_t*) src;
+
+    if( d + len <= s || s + len <= d )
+    {
+        return copy_async( d, s, 0, len );
+    }
+
+    /*
+     * The DMA reads ahead of its writes, so it could overwrite the source
+     * before reading it. Overlapping moves are done by the CPU, in the
+     * direction that reads every byte before it is overwritten.
+     */
+    if( d < s )
+    {
+        for( size_t i = 0; i < len; i++ ) d[i] = s[i];
+    }
+    else
+    {
+        for( size_t i = len; i > 0; i-- ) d[i - 1] = s[i - 1];
+    }
+    return DMA_COPY_TOKEN_CPU;
+}
+
+uint32_t dma_copy_done( dma_copy_token_t token )
+{
+    if( token == DMA_COPY_TOKEN_CPU )
+    {
+        return 1;
+    }
+    for( uint8_t ch = (uint8_t) token; ch < token + DMA_MEMCPY_STRIPES; ch++ )
+    {
+        if( !dma_is_ready( ch ) )
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void dma_copy_wait( dma_copy_token_t token )
+{
+    while( !dma_copy_done( token ) ) {}
+}
+
+void *dma_memcpy( void *dst, const void *src, size_t len )
+{
+    dma_copy_wait( dma_memcpy_async( dst, src, len ) );
+    return dst;
+}
+
+void *dma_memset( void *dst, int value, size_t len )
+{
+    dma_copy_wait( dma_memset_async( dst, value, len ) );
+    return dst;
+}
+
+void *dma_memmove( void *dst, const void *src, size_t len )
+{
+    dma_copy_wait( dma_memmove_async( dst, src, len ) );
+    return dst;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static dma_copy_token_t copy_async( uint8_t       *p_dst,
+                                    const uint8_t *p_src,
+                                    uint8_t       p_value,
+                                    size_t        p_len )
+{
+    if( p_len < DMA_MEMCPY_THRESHOLD_B )
+    {
+        if( p_src ) memcpy( p_dst, p_src, p_len );
+        else        memset( p_dst, p_value, p_len );
+        return DMA_COPY_TOKEN_CPU;
+    }
+
+    /*
+     * Copies are done in order: the previous copy has to finish before its
+     * transactions are replaced.
+     */
+    dma_copy_wait( DMA_MEMCPY_CH );
+
+    /*
+     * The widest data type is chosen for which the source and destination
+     * have the same misalignment. The head brings both pointers to that
+     * alignment, and the tail is what is left of the last data unit.
+     * The fills read nothing, so only the destination counts.
+     */
+    uint32_t dstMis = (uint32_t) p_dst;
+    uint32_t srcMis = p_src ? (uint32_t) p_src : dstMis;
+    dma_data_type_t type;
+    uint32_t mask;
+
+    if( ( ( dstMis ^ srcMis ) & DMA_MEMCPY_WORD_ALIGN_MASK ) == 0 )
+    {
+        type = DMA_DATA_TYPE_WORD;
+        mask = DMA_MEMCPY_WORD_ALIGN_MASK;
+    }
+    else if( ( ( dstMis ^ srcMis ) & DMA_MEMCPY_HALF_WORD_ALIGN_MASK ) == 0 )
+    {
+        type = DMA_DATA_TYPE_HALF_WORD;
+        mask = DMA_MEMCPY_HALF_WORD_ALIGN_MASK;
+    }
+    else
+    {
+        type = DMA_DATA_TYPE_BYTE;
+        mask = 0;
+    }
+
+    size_t head_b = ( mask + 1 - ( dstMis & mask ) ) & mask;
+    size_t body_b = ( p_len - head_b ) & ~( (size_t) mask );
+    size_t tail_b = p_len - head_b - body_b;
+
+    /*
+     * Word copies and fills of interleaved buffers are striped over the
+     * channels, each one taking every DMA_MEMCPY_STRIPES-th word. The others
+     * take a single channel: all the channels would wait for the same bank.
+     */
+    uint32_t body_du = body_b / DMA_DATA_TYPE_2_SIZE( type );
+    uint32_t stripes = 1;
+    if( DMA_MEMCPY_STRIPES > 1
+        && type == DMA_DATA_TYPE_WORD
+        && body_du >= DMA_MEMCPY_STRIPES
+        && in_interleaved( p_dst + head_b, body_b )
+        && ( !p_src || in_interleaved( p_src + head_b, body_b ) ) )
+    {
+        stripes = DMA_MEMCPY_STRIPES;
+    }
+
+    /*
+     * The pointers are aligned by construction, only the sanity checks are
+     * needed. All the stripes are loaded before any is launched: if the DMA
+     * cannot take one, the CPU does the copy.
+     */
+    dma_config_flags_t flags = DMA_CONFIG_OK;
+    for( uint32_t k = 0; k < stripes; k++ )
+    {
+        dma_target_t *src   = &copy.stripe[ k ].src;
+        dma_target_t *dst   = &copy.stripe[ k ].dst;
+        dma_trans_t  *trans = &copy.stripe[ k ].trans;
+        uint32_t     offset = k * DMA_DATA_TYPE_2_SIZE( type );
+
+        src->env      = NULL;
+        src->ptr      = p_src ? (uint8_t*) p_src + head_b + offset : NULL;
+        src->inc_du   = stripes;
+        src->size_du  = ( body_du - k + stripes - 1 ) / stripes;
+        src->stride_d2_du = 0;
+        src->type     = type;
+        src->trig     = DMA_TRIG_MEMORY;
+
+        dst->env      = NULL;
+        dst->ptr      = p_dst + head_b + offset;
+        dst->inc_du   = stripes;
+        dst->size_du  = 0;
+        dst->stride_d2_du = 0;
+        dst->type     = type;
+        dst->trig     = DMA_TRIG_MEMORY;
+
+        trans->src      = src;
+        trans->dst      = dst;
+        trans->src_addr = NULL;
+        /* The fills write the byte repeated in the data unit, reading nothing. */
+        trans->mode     = p_src ? DMA_TRANS_MODE_SINGLE : DMA_TRANS_MODE_FILL;
+        trans->fill     = p_value * 0x01010101u;
+        trans->win_du   = 0;
+        trans->end      = DMA_TRANS_END_POLLING;
+        trans->channel  = DMA_MEMCPY_CH + k;
+        trans->size_d2  = 0;
+        trans->conv     = DMA_TYPE_CONV_NONE;
+
+        flags |= dma_validate_transaction(  trans,
+                                            DMA_DO_NOT_ENABLE_REALIGN,
+                                            DMA_PERFORM_CHECKS_ONLY_SANITY );
+        flags |= dma_load_transaction( trans );
+    }
+    if( flags & ( DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE ) )
+    {
+        if( p_src ) memcpy( p_dst, p_src, p_len );
+        else        memset( p_dst, p_value, p_len );
+        return DMA_COPY_TOKEN_CPU;
+    }
+    for( uint32_t k = 0; k < stripes; k++ )
+    {
+        dma_launch( &copy.stripe[ k ].trans );
+    }
+
+    /* The head and tail are copied while the DMA copies the body. */
+    if( p_src )
+    {
+        memcpy( p_dst, p_src, head_b );
+        memcpy( p_dst + p_len - tail_b, p_src + p_len - tail_b, tail_b );
+    }
+    else
+    {
+        memset( p_dst, p_value, head_b );
+        memset( p_dst + p_len - tail_b, p_value, tail_b );
+    }
+
+    return DMA_MEMCPY_CH;
+}
+
+static uint32_t in_interleaved( const uint8_t *p_ptr, size_t p_len )
+{
+    return (uint32_t) p_ptr >= RAM_IL_START_ADDRESS
+        && (uint32_t) p_ptr + p_len <= RAM_IL_START_ADDRESS + RAM_IL_SIZE;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
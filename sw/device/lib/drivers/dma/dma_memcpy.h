@@ -0,0 +1,181 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_memcpy.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dma_memcpy.h
+* @date   14/10/26
+* @brief  Drop-in replacements of memcpy, memset and memmove that perform the
+* large copies with the DMA.
+*
+* Copies shorter than DMA_MEMCPY_THRESHOLD_B are done by the CPU. Longer ones
+* are split in a head and a tail, copied by the CPU while the DMA runs, and a
+* body copied by the DMA with the widest data type allowed by the alignment of
+* the pointers. All the copies use the DMA_MEMCPY_CH channel, that must not be
+* used by other transactions, and need dma_init() to be called before.
+*
+* A single channel moves at most a word per cycle. When the source and the
+* destination are in the interleaved banks, a word copy is striped over
+* DMA_MEMCPY_STRIPES channels from DMA_MEMCPY_CH on: the channel k copies the
+* words k, k + DMA_MEMCPY_STRIPES, ... so that with the NtoM bus the channels
+* access different banks in the same cycle.
+*/
+
+#ifndef _DMA_MEMCPY_H
+#define _DMA_MEMCPY_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Smallest copy performed by the DMA, in bytes. Below it, validating and
+ * loading the transaction takes longer than the byte loop of the CPU.
+ */
+#ifndef DMA_MEMCPY_THRESHOLD_B
+#define DMA_MEMCPY_THRESHOLD_B  128
+#endif
+
+/**
+ * Channel used for the copies.
+ */
+#ifndef DMA_MEMCPY_CH
+#define DMA_MEMCPY_CH           0
+#endif
+
+/**
+ * Channels sharing a copy in the interleaved banks, from DMA_MEMCPY_CH on.
+ * By default the memcpy_channels of the dma in mcu_cfg.hjson, up to one per
+ * interleaved bank, with the NtoM bus, where the channels can access several
+ * banks at once; 1 otherwise. The channels must not be used by other
+ * transactions.
+ */
+#ifndef DMA_MEMCPY_STRIPES
+#if defined( BUS_TYPE_NTOM ) && RAM_IL_SIZE != 0
+#define DMA_MEMCPY_STRIPES      DMA_MEMCPY_CHANNELS
+#else
+#define DMA_MEMCPY_STRIPES      1
+#endif
+#endif
+
+/**
+ * Token of the copies done by the CPU, which are already finished when the
+ * function returns.
+ */
+#define DMA_COPY_TOKEN_CPU      (-1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Completion token of an asynchronous copy: the first channel that performs
+ * it, or DMA_COPY_TOKEN_CPU.
+ */
+typedef int32_t dma_copy_token_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts copying len bytes from src to dst. The buffers must not
+ * overlap and must not be modified until the copy is done.
+ * @return The completion token of the copy.
+ */
+dma_copy_token_t dma_memcpy_async( void *dst, const void *src, size_t len );
+
+/**
+ * @brief Starts filling len bytes of dst with the byte value. dst must not be
+ * modified until the fill is done.
+ * @return The completion token of the fill.
+ */
+dma_copy_token_t dma_memset_async( void *dst, int value, size_t len );
+
+/**
+ * @brief Same as dma_memcpy_async(), but the buffers can overlap. Overlapping
+ * moves are done by the CPU.
+ * @return The completion token of the move.
+ */
+dma_copy_token_t dma_memmove_async( void *dst, const void *src, size_t len );
+
+/**
+ * @brief Checks whether an asynchronous copy is done.
+ * @param token The token returned by the copy.
+ * @retval 0 - The DMA is still copying.
+ * @retval 1 - The copy is done.
+ */
+uint32_t dma_copy_done( dma_copy_token_t token );
+
+/**
+ * @brief Waits until an asynchronous copy is done.
+ * @param token The token returned by the copy.
+ */
+void dma_copy_wait( dma_copy_token_t token );
+
+/**
+ * @brief Drop-in replacement of memcpy(), returns when the copy is done.
+ * @return dst.
+ */
+void *dma_memcpy( void *dst, const void *src, size_t len );
+
+/**
+ * @brief Drop-in replacement of memset(), returns when the fill is done.
+ * @return dst.
+ */
+void *dma_memset( void *dst, int value, size_t len );
+
+/**
+ * @brief Drop-in replacement of memmove(), returns when the move is done.
+ * @return dst.
+ */
+void *dma_memmove( void *dst, const void *src, size_t len );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DMA_MEMCPY_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
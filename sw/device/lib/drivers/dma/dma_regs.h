@@ -32,6 +32,7 @@ extern "C" {
 #define DMA_STATUS_REG_OFFSET 0x10
 #define DMA_STATUS_READY_BIT 0
 #define DMA_STATUS_WINDOW_DONE_BIT 1
+#define DMA_STATUS_TRANSACTION_DONE_BIT 2
 
 // Increment number of src/dst pointer every time a word is copied
 #define DMA_PTR_INC_REG_OFFSET 0x14
@@ -75,6 +76,7 @@ extern "C" {
 #define DMA_MODE_MODE_VALUE_LINEAR_MODE 0x0
 #define DMA_MODE_MODE_VALUE_CIRCULAR_MODE 0x1
 #define DMA_MODE_MODE_VALUE_ADDRESS_MODE 0x2
+#define DMA_MODE_MODE_VALUE_FILL_MODE 0x3
 
 // Will trigger a every "WINDOW_SIZE" writes
 #define DMA_WINDOW_SIZE_REG_OFFSET 0x24
@@ -87,6 +89,86 @@ extern "C" {
 #define DMA_INTERRUPT_EN_TRANSACTION_DONE_BIT 0
 #define DMA_INTERRUPT_EN_WINDOW_DONE_BIT 1
 
+// Pointer to the first descriptor of a linked list (word aligned).
+#define DMA_DESC_PTR_REG_OFFSET 0x30
+
+// Size of the first dimension (row) of a 2D transaction in bytes.
+#define DMA_SIZE_D1_REG_OFFSET 0x34
+
+// Pointer increments applied after the last element of each row of a 2D
+// transaction.
+#define DMA_PTR_INC_D2_REG_OFFSET 0x38
+#define DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK 0xffff
+#define DMA_PTR_INC_D2_SRC_PTR_INC_D2_OFFSET 0
+#define DMA_PTR_INC_D2_SRC_PTR_INC_D2_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK, .index = DMA_PTR_INC_D2_SRC_PTR_INC_D2_OFFSET })
+#define DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK 0xffff
+#define DMA_PTR_INC_D2_DST_PTR_INC_D2_OFFSET 16
+#define DMA_PTR_INC_D2_DST_PTR_INC_D2_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK, .index = DMA_PTR_INC_D2_DST_PTR_INC_D2_OFFSET })
+
+// Number of cycles the DMA was busy since the start of the transaction.
+#define DMA_PERF_BUSY_REG_OFFSET 0x3c
+
+// Number of cycles a read request waited for its grant since the start of
+// the transaction.
+#define DMA_PERF_READ_STALL_REG_OFFSET 0x40
+
+// Number of cycles a write request waited for its grant since the start of
+// the transaction.
+#define DMA_PERF_WRITE_STALL_REG_OFFSET 0x44
+
+// Number of data units written since the start of the transaction.
+#define DMA_PERF_BEATS_REG_OFFSET 0x48
+
+// Width/type of the data written to the destination, same encoding as
+// DATA_TYPE.
+#define DMA_DST_DATA_TYPE_REG_OFFSET 0x4c
+#define DMA_DST_DATA_TYPE_DATA_TYPE_MASK 0x3
+#define DMA_DST_DATA_TYPE_DATA_TYPE_OFFSET 0
+#define DMA_DST_DATA_TYPE_DATA_TYPE_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_DST_DATA_TYPE_DATA_TYPE_MASK, .index = DMA_DST_DATA_TYPE_DATA_TYPE_OFFSET })
+
+// Extend the sign of the source data when the destination data type is wider
+#define DMA_SIGN_EXT_REG_OFFSET 0x50
+#define DMA_SIGN_EXT_SIGN_EXT_BIT 0
+
+// Minimum number of cycles between the starts of two writes.
+#define DMA_PACE_REG_OFFSET 0x54
+#define DMA_PACE_PACE_MASK 0xffff
+#define DMA_PACE_PACE_OFFSET 0
+#define DMA_PACE_PACE_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_PACE_PACE_MASK, .index = DMA_PACE_PACE_OFFSET })
+
+// Pattern written in fill mode.
+#define DMA_FILL_VALUE_REG_OFFSET 0x58
+
+// Period of the pacing timer of the channel.
+#define DMA_TIMER_REG_OFFSET 0x5c
+
+// Use of the table of ADDR_PTR in address mode.
+#define DMA_ADDR_CFG_REG_OFFSET 0x60
+#define DMA_ADDR_CFG_GATHER_BIT 0
+#define DMA_ADDR_CFG_OFFSETS_BIT 1
+#define DMA_ADDR_CFG_SHIFT_MASK 0x3
+#define DMA_ADDR_CFG_SHIFT_OFFSET 2
+#define DMA_ADDR_CFG_SHIFT_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_ADDR_CFG_SHIFT_MASK, .index = DMA_ADDR_CFG_SHIFT_OFFSET })
+
+// GPIO strobe of the channel, selected by bit 14 of RX_TRIGGER_SLOT or
+// TX_TRIGGER_SLOT.
+#define DMA_STROBE_REG_OFFSET 0x64
+#define DMA_STROBE_PIN_MASK 0x1f
+#define DMA_STROBE_PIN_OFFSET 0
+#define DMA_STROBE_PIN_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_STROBE_PIN_MASK, .index = DMA_STROBE_PIN_OFFSET })
+#define DMA_STROBE_RISE_BIT 8
+#define DMA_STROBE_FALL_BIT 9
+
+// Number of edges of the GPIO strobe dropped while the previous one was
+// waiting.
+#define DMA_STROBE_MISSED_REG_OFFSET 0x68
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,399 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef XHEEP_SW_DEVICE_LIB_DRIVERS_DMA_DMA_STATIC_HPP_
+#define XHEEP_SW_DEVICE_LIB_DRIVERS_DMA_DMA_STATIC_HPP_
+
+/**
+ * @file
+ * @brief DMA transactions validated and compiled at compile time, for C++.
+ *
+ * The parameters of most transactions are constants, but
+ * `dma_validate_transaction()` and `dma_compile_transaction()` check and
+ * translate them at run time. Here a transaction is described by a
+ * `constexpr` value, and `compile<T>()` makes the same checks with
+ * `static_assert` and returns its register image, a `dma_compiled_trans_t`
+ * launched with `dma_launch_compiled()`:
+ *
+ *   namespace ds = xheep::dma_static;
+ *   static constexpr ds::trans copy_desc =
+ *       ds::trans(ds::memory<uint32_t>(64), ds::memory<uint32_t>(0, 1, 256))
+ *           .with_window(64);
+ *   static dma_compiled_trans_t copy = ds::compile<copy_desc>();
+ *   ...
+ *   dma_launch_compiled(&copy, (uint8_t *)src, (uint8_t *)dst);
+ *
+ * The image is a constant, in the .data section: nothing is checked or
+ * computed at run time. An invalid transaction does not compile, with the
+ * message of the check that failed.
+ *
+ * The pointers of the memory targets are not known at compile time, they are
+ * given at the first launch and may change at each one. Instead, a target
+ * made with `memory<T>()` tells its buffer is aligned as `T`, which replaces
+ * the check of the misalignment of the pointer, and the size of its buffer,
+ * which replaces its environment. The peripheral targets have the constant
+ * address of their register in the image. The address mode is not supported,
+ * as the address pointer cannot be given at launch.
+ *
+ * The checks are the ones of `dma_validate_transaction()` with
+ * `DMA_PERFORM_CHECKS_INTEGRITY`, plus the ranges of the increments. The
+ * window ratio warning is an error above the threshold given to `compile`,
+ * 4 by default as `dma_window_ratio_warning_threshold()`, or 0 to disable it.
+ *
+ * Only `constexpr` functions of C++14 are used, with the flags of C.
+ */
+
+#include <stdint.h>
+
+extern "C" {
+#include "dma.h"
+}
+
+namespace xheep {
+namespace dma_static {
+
+/**
+ * A target of a transaction, without its pointer.
+ */
+struct target {
+  dma_data_type_t type = DMA_DATA_TYPE_WORD;
+  uint16_t inc_du = 1;        // 0 for the peripherals.
+  uint32_t size_du = 0;       // Of the source, 0 for a destination.
+  uint32_t stride_d2_du = 0;  // Between the rows, 0 if they are contiguous.
+  dma_trigger_slot_mask_t trig = DMA_TRIG_MEMORY;
+  uint32_t align_b = 4;       // Alignment of the buffer.
+  uint32_t buffer_b = 0;      // Size of the buffer, 0 if it is not checked.
+  uint32_t addr = 0;          // Address of a peripheral register.
+};
+
+/**
+ * A memory target of `T` elements. Its buffer is aligned as `T` and, if
+ * `buffer_du` is not 0, holds that many elements, which the transaction must
+ * not go beyond.
+ */
+template <typename T>
+constexpr target memory(uint32_t size_du, uint16_t inc_du = 1,
+                        uint32_t buffer_du = 0) {
+  static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4,
+                "the DMA moves bytes, half words and words");
+  target tgt;
+  tgt.type = sizeof(T) == 4   ? DMA_DATA_TYPE_WORD
+             : sizeof(T) == 2 ? DMA_DATA_TYPE_HALF_WORD
+                              : DMA_DATA_TYPE_BYTE;
+  tgt.inc_du = inc_du;
+  tgt.size_du = size_du;
+  tgt.align_b = alignof(T);
+  tgt.buffer_b = buffer_du * sizeof(T);
+  return tgt;
+}
+
+/**
+ * A peripheral target: the register at `addr`, whose trigger slot paces the
+ * transaction. `size_du` is only needed for a source.
+ */
+constexpr target peripheral(uint32_t addr, dma_trigger_slot_mask_t trig,
+                            dma_data_type_t type, uint32_t size_du = 0) {
+  target tgt;
+  tgt.type = type;
+  tgt.inc_du = 0;
+  tgt.size_du = size_du;
+  tgt.trig = trig;
+  tgt.align_b = 4;
+  tgt.addr = addr;
+  return tgt;
+}
+
+/**
+ * A transaction, with the fields of `dma_trans_t` but the pointers. The
+ * `with_*` functions return a copy with one field changed.
+ */
+struct trans {
+  target src;
+  target dst;
+  dma_trans_mode_t mode = DMA_TRANS_MODE_SINGLE;
+  dma_type_conv_t conv = DMA_TYPE_CONV_NONE;
+  uint32_t win_du = 0;
+  dma_trans_end_evt_t end = DMA_TRANS_END_POLLING;
+  uint8_t channel = 0;
+  uint32_t size_d2 = 0;
+  uint16_t pace = 0;
+  uint32_t fill = 0;
+  bool realign = true;  // As DMA_ENABLE_REALIGN.
+
+  constexpr trans(target s, target d) : src(s), dst(d) {}
+
+  constexpr trans with_mode(dma_trans_mode_t v) const { trans t = *this; t.mode = v; return t; }
+  constexpr trans with_conv(dma_type_conv_t v) const { trans t = *this; t.conv = v; return t; }
+  constexpr trans with_window(uint32_t v) const { trans t = *this; t.win_du = v; return t; }
+  constexpr trans with_end(dma_trans_end_evt_t v) const { trans t = *this; t.end = v; return t; }
+  constexpr trans with_channel(uint8_t v) const { trans t = *this; t.channel = v; return t; }
+  constexpr trans with_rows(uint32_t v) const { trans t = *this; t.size_d2 = v; return t; }
+  constexpr trans with_pace(uint16_t v) const { trans t = *this; t.pace = v; return t; }
+  constexpr trans with_fill(uint32_t v) const { trans t = *this; t.fill = v; return t; }
+  constexpr trans with_realign(bool v) const { trans t = *this; t.realign = v; return t; }
+};
+
+namespace detail {
+
+constexpr uint32_t size_b(dma_data_type_t type) {
+  return DMA_DATA_TYPE_2_SIZE(type);
+}
+
+constexpr dma_config_flags_t operator|(dma_config_flags_t a, dma_config_flags_t b) {
+  return (dma_config_flags_t)((uint32_t)a | (uint32_t)b);
+}
+
+// What dma_validate_transaction() sets in the transaction.
+struct validated {
+  dma_config_flags_t flags = DMA_CONFIG_OK;
+  dma_data_type_t type = DMA_DATA_TYPE_WORD;
+  dma_data_type_t dst_type = DMA_DATA_TYPE_WORD;
+  uint32_t inc_b = 0;
+  uint32_t size_b = 0;
+};
+
+// The data type steps down to a buffer aligned on align_b, as
+// get_misalignment_b() for a pointer.
+constexpr uint32_t misalignment(dma_data_type_t type, uint32_t align_b) {
+  uint32_t m = 0;
+  if (type == DMA_DATA_TYPE_WORD && (align_b & 3) != 0) m++;
+  if (type <= DMA_DATA_TYPE_HALF_WORD && (align_b & 1) != 0) m++;
+  return m;
+}
+
+// As get_increment_b().
+constexpr uint32_t increment_b(const trans &t, const validated &v, bool dst) {
+  const target &tgt = dst ? t.dst : t.src;
+  if (tgt.trig != DMA_TRIG_MEMORY) return 0;
+  if (v.inc_b != 0) return v.inc_b;
+  return tgt.inc_du * size_b(dst ? v.dst_type : v.type);
+}
+
+// As get_stride_unit_b().
+constexpr uint32_t stride_unit_b(const trans &t, bool dst) {
+  return (dst && t.conv) ? size_b(t.dst.type) : size_b(t.src.type);
+}
+
+// As get_increment_d2_b().
+constexpr int32_t increment_d2_b(const trans &t, const validated &v, bool dst) {
+  const target &tgt = dst ? t.dst : t.src;
+  int32_t inc_b = (int32_t)increment_b(t, v, dst);
+  if (tgt.trig != DMA_TRIG_MEMORY || tgt.stride_d2_du == 0) return inc_b;
+  uint32_t row_du = t.src.size_du * size_b(t.src.type) / size_b(v.type);
+  return (int32_t)(tgt.stride_d2_du * stride_unit_b(t, dst)) -
+         (int32_t)((row_du - 1) * inc_b);
+}
+
+// Whether the transaction goes beyond the buffer of a target.
+constexpr bool outbound(const trans &t, const validated &v, bool dst) {
+  const target &tgt = dst ? t.dst : t.src;
+  if (tgt.buffer_b == 0 || tgt.trig != DMA_TRIG_MEMORY) return false;
+  uint32_t unit_b = size_b(dst ? v.dst_type : v.type);
+  uint32_t units = v.size_b / size_b(v.type);
+  uint32_t last_b = 0;
+  if (t.size_d2 > 1 && tgt.stride_d2_du != 0) {
+    last_b = (t.size_d2 - 1) * tgt.stride_d2_du * stride_unit_b(t, dst);
+    units /= t.size_d2;
+  }
+  uint32_t inc_du = v.inc_b != 0 ? 1 : tgt.inc_du;
+  return last_b + ((units - 1) * inc_du + 1) * unit_b > tgt.buffer_b;
+}
+
+// The checks of dma_validate_transaction(), returning at the first error.
+constexpr validated validate(const trans &t, uint32_t ratio_threshold) {
+  validated v;
+
+  if (t.channel >= DMA_CH_NUM) {
+    v.flags = DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+
+  if (t.src.trig != DMA_TRIG_MEMORY && t.dst.trig != DMA_TRIG_MEMORY) {
+    v.flags = DMA_CONFIG_INCOMPATIBLE | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+  if (t.src.trig == DMA_TRIG_MEMORY && t.dst.trig == DMA_TRIG_MEMORY &&
+      t.mode == DMA_TRANS_MODE_CIRCULAR) {
+    v.flags = DMA_CONFIG_INCOMPATIBLE | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+
+  v.size_b = t.src.size_du * size_b(t.src.type);
+  if (t.size_d2 > 1) v.size_b *= t.size_d2;
+  v.type = t.src.type;
+  v.dst_type = t.conv ? t.dst.type : v.type;
+
+  uint32_t m = 0;
+  uint32_t dst_m = 0;
+  if (t.src.trig == DMA_TRIG_MEMORY && t.mode != DMA_TRANS_MODE_FILL) {
+    m = misalignment(v.type, t.src.align_b);
+  }
+  if (t.dst.trig == DMA_TRIG_MEMORY) {
+    dst_m = misalignment(v.dst_type, t.dst.align_b);
+  }
+  if (m != 0) v.flags = v.flags | DMA_CONFIG_SRC;
+  if (dst_m != 0) v.flags = v.flags | DMA_CONFIG_DST;
+  if (m < dst_m) m = dst_m;
+
+  if (m != 0) {
+    v.flags = v.flags | DMA_CONFIG_MISALIGN;
+    if (!t.realign) {
+      v.flags = v.flags | DMA_CONFIG_CRITICAL_ERROR;
+      return v;
+    }
+    if (t.src.inc_du > 1 || t.dst.inc_du > 1) {
+      v.flags = v.flags | DMA_CONFIG_DISCONTINUOUS | DMA_CONFIG_CRITICAL_ERROR;
+      return v;
+    }
+    if (v.type != v.dst_type || t.mode == DMA_TRANS_MODE_FILL) {
+      v.flags = v.flags | DMA_CONFIG_INCOMPATIBLE | DMA_CONFIG_CRITICAL_ERROR;
+      return v;
+    }
+    v.type = (dma_data_type_t)(v.type + m);
+    v.dst_type = v.type;
+    v.inc_b = size_b(v.type);
+  }
+
+  if (t.src.size_du == 0) {
+    v.flags = v.flags | DMA_CONFIG_SRC | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+
+  if (outbound(t, v, false) && t.mode != DMA_TRANS_MODE_FILL) {
+    v.flags = v.flags | DMA_CONFIG_SRC | DMA_CONFIG_OUTBOUNDS | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+  if (outbound(t, v, true)) {
+    v.flags = v.flags | DMA_CONFIG_DST | DMA_CONFIG_OUTBOUNDS | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+
+  // The increments must fit their registers
+  if (increment_b(t, v, false) > DMA_PTR_INC_SRC_PTR_INC_MASK) {
+    v.flags = v.flags | DMA_CONFIG_SRC | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+  if (increment_b(t, v, true) > DMA_PTR_INC_DST_PTR_INC_MASK) {
+    v.flags = v.flags | DMA_CONFIG_DST | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+  if (t.size_d2 > 1) {
+    int32_t src_inc_b = increment_d2_b(t, v, false);
+    if (src_inc_b < 0 || src_inc_b > DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK) {
+      v.flags = v.flags | DMA_CONFIG_SRC | DMA_CONFIG_CRITICAL_ERROR;
+      return v;
+    }
+    int32_t dst_inc_b = increment_d2_b(t, v, true);
+    if (dst_inc_b < 0 || dst_inc_b > DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK) {
+      v.flags = v.flags | DMA_CONFIG_DST | DMA_CONFIG_CRITICAL_ERROR;
+      return v;
+    }
+  }
+
+  if (t.win_du > v.size_b) {
+    v.flags = v.flags | DMA_CONFIG_WINDOW_SIZE | DMA_CONFIG_CRITICAL_ERROR;
+    return v;
+  }
+  if (t.win_du != 0 && ratio_threshold != 0 &&
+      v.size_b / t.win_du > ratio_threshold) {
+    v.flags = v.flags | DMA_CONFIG_WINDOW_SIZE;
+  }
+  return v;
+}
+
+// The image of dma_compile_transaction(), from a valid transaction.
+constexpr dma_compiled_trans_t image(const trans &t, const validated &v) {
+  dma_compiled_trans_t c = {};
+  c.channel = t.channel;
+  c.end = t.end;
+  c.size_b = v.size_b;
+  c.mode = t.mode;
+  c.data_type = v.type & DMA_DATA_TYPE_DATA_TYPE_MASK;
+  c.dst_data_type = v.dst_type & DMA_DST_DATA_TYPE_DATA_TYPE_MASK;
+  c.sign_ext = (uint32_t)(t.conv == DMA_TYPE_CONV_SIGN_EXT) << DMA_SIGN_EXT_SIGN_EXT_BIT;
+  c.pace = t.pace;
+  c.fill = t.fill;
+  c.win_size = t.win_du ? t.win_du : v.size_b;
+
+  c.intr_en = 0;
+  if (t.end != DMA_TRANS_END_POLLING) {
+    c.intr_en = 1u << DMA_INTERRUPT_EN_TRANSACTION_DONE_BIT;
+    if (t.win_du > 0) c.intr_en |= 1u << DMA_INTERRUPT_EN_WINDOW_DONE_BIT;
+  }
+
+  c.src_ptr = t.src.addr;
+  c.dst_ptr = t.dst.addr;
+  c.addr_ptr = 0;
+  c.ptr_inc = ((increment_b(t, v, false) & DMA_PTR_INC_SRC_PTR_INC_MASK)
+               << DMA_PTR_INC_SRC_PTR_INC_OFFSET) |
+              ((increment_b(t, v, true) & DMA_PTR_INC_DST_PTR_INC_MASK)
+               << DMA_PTR_INC_DST_PTR_INC_OFFSET);
+  c.slot = ((t.src.trig & DMA_SLOT_RX_TRIGGER_SLOT_MASK)
+            << DMA_SLOT_RX_TRIGGER_SLOT_OFFSET) |
+           ((t.dst.trig & DMA_SLOT_TX_TRIGGER_SLOT_MASK)
+            << DMA_SLOT_TX_TRIGGER_SLOT_OFFSET);
+
+  c.size_d1 = 0;
+  c.ptr_inc_d2 = 0;
+  if (t.size_d2 > 1) {
+    c.size_d1 = v.size_b / t.size_d2;
+    c.ptr_inc_d2 = (((uint32_t)increment_d2_b(t, v, false) &
+                     DMA_PTR_INC_D2_SRC_PTR_INC_D2_MASK)
+                    << DMA_PTR_INC_D2_SRC_PTR_INC_D2_OFFSET) |
+                   (((uint32_t)increment_d2_b(t, v, true) &
+                     DMA_PTR_INC_D2_DST_PTR_INC_D2_MASK)
+                    << DMA_PTR_INC_D2_DST_PTR_INC_D2_OFFSET);
+  }
+  return c;
+}
+
+}  // namespace detail
+
+/**
+ * The flags that `dma_validate_transaction()` would return for `t`, e.g. to
+ * check the warnings with a `static_assert` of the application.
+ */
+constexpr dma_config_flags_t validate(const trans &t, uint32_t ratio_threshold = 4) {
+  return detail::validate(t, ratio_threshold).flags;
+}
+
+/**
+ * The register image of the transaction `T`, a `constexpr` variable, after
+ * its checks at compile time. `RatioThreshold` is the largest ratio of the
+ * size of the transaction to its window, 0 to accept any.
+ */
+template <const trans &T, uint32_t RatioThreshold = 4>
+constexpr dma_compiled_trans_t compile() {
+  constexpr detail::validated v = detail::validate(T, RatioThreshold);
+
+  static_assert(T.mode != DMA_TRANS_MODE_ADDRESS,
+                "the address mode needs dma_compile_transaction()");
+  static_assert(T.channel < DMA_CH_NUM, "the DMA has no such channel");
+  static_assert(!(v.flags & DMA_CONFIG_INCOMPATIBLE),
+                "incompatible transaction: two peripherals, a circular copy "
+                "in memory, or a data type conversion realigned");
+  static_assert(T.realign || !(v.flags & DMA_CONFIG_MISALIGN),
+                "a buffer is misaligned for the data type, and the "
+                "realignment is not allowed");
+  static_assert(!(v.flags & DMA_CONFIG_DISCONTINUOUS),
+                "a misaligned buffer cannot have an increment larger than 1");
+  static_assert(!(v.flags & DMA_CONFIG_OUTBOUNDS),
+                "the transaction goes beyond the buffer of a target");
+  static_assert(!(v.flags & DMA_CONFIG_WINDOW_SIZE),
+                "the window is larger than the transaction, or too small "
+                "for it");
+  static_assert(!(v.flags & DMA_CONFIG_CRITICAL_ERROR) ||
+                    (v.flags & (DMA_CONFIG_INCOMPATIBLE | DMA_CONFIG_MISALIGN |
+                                DMA_CONFIG_DISCONTINUOUS | DMA_CONFIG_OUTBOUNDS |
+                                DMA_CONFIG_WINDOW_SIZE)),
+                "invalid transaction: empty source, or an increment that "
+                "does not fit its register");
+
+  return detail::image(T, v);
+}
+
+}  // namespace dma_static
+}  // namespace xheep
+
+#endif  // XHEEP_SW_DEVICE_LIB_DRIVERS_DMA_DMA_STATIC_HPP_
@@ -0,0 +1,351 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_tile.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dma_tile.c
+* @date   14/10/26
+* @brief  Tiling of kernels on matrices, with the DMA moving the tiles while
+* the CPU computes.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dma_tile.h"
+
+#include "csr.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Bits of the size of a tile: last column and last row.
+ */
+#define TILE_SIZE_LAST_COL  1
+#define TILE_SIZE_LAST_ROW  2
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Compiles the copy of a stream for one size of tile.
+ * @param p_tile The tiling.
+ * @param p_k The stream: an input, or n_in for the output.
+ * @param p_rows The size of the tile.
+ * @param p_cols
+ * @param p_comp The compiled copy to fill.
+ */
+static dma_config_flags_t compile_copy( dma_tile_t *p_tile, uint32_t p_k,
+                                        uint32_t p_rows, uint32_t p_cols,
+                                        dma_compiled_trans_t *p_comp );
+
+/**
+ * @brief Launches a copy once its channel is free.
+ * @return The cycles waited for the channel.
+ */
+static uint32_t launch( dma_compiled_trans_t *p_comp, uint8_t *p_src, uint8_t *p_dst );
+
+/**
+ * @brief Waits for a channel to be free.
+ * @return The cycles waited.
+ */
+static uint32_t wait_ch( uint8_t p_ch );
+
+/**
+ * @brief The size of a tile (TILE_SIZE_* bits) and its offset in the
+ * matrices, in bytes.
+ */
+static inline uint32_t tile_size( dma_tile_t *p_tile, uint32_t p_t, uint32_t p_tiles_r,
+                                  uint32_t p_tiles_c, uint32_t *p_offset_b );
+
+/**
+ * @brief The buffer of a stream in one of the two halves of the workspace.
+ */
+static inline uint8_t *tile_buf( dma_tile_t *p_tile, uint32_t p_k, uint32_t p_half );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+dma_config_flags_t dma_tile_init( dma_tile_t *p_tile )
+{
+    dma_config_flags_t flags = DMA_CONFIG_OK;
+    uint32_t streams = p_tile->n_in + ( p_tile->out != NULL );
+
+    if(     ( p_tile->n_in == 0 ) || ( p_tile->n_in > DMA_TILE_MAX_IN )
+        ||  ( p_tile->tile_rows == 0 ) || ( p_tile->tile_cols == 0 )
+        ||  ( p_tile->rows == 0 ) || ( p_tile->cols == 0 )
+        ||  ( p_tile->elem_b != 1 && p_tile->elem_b != 2 && p_tile->elem_b != 4 )
+        ||  ( ( (uintptr_t)p_tile->work & 3 ) != 0 )
+        ||  ( p_tile->fn == NULL )
+        ||  ( p_tile->ch >= DMA_CH_NUM ) )
+    {
+        return DMA_CONFIG_CRITICAL_ERROR;
+    }
+    if( p_tile->stride == 0 )
+    {
+        p_tile->stride = p_tile->cols;
+    }
+    if( p_tile->tile_rows > p_tile->rows )
+    {
+        p_tile->tile_rows = p_tile->rows;
+    }
+    if( p_tile->tile_cols > p_tile->cols )
+    {
+        p_tile->tile_cols = p_tile->cols;
+    }
+
+    /* One channel per stream if there are enough of them. */
+    for( uint32_t k = 0; k < streams; k++ )
+    {
+        p_tile->stream_ch[ k ] = ( p_tile->ch + streams <= DMA_CH_NUM )
+                                 ? p_tile->ch + k : p_tile->ch;
+    }
+
+    uint32_t last_rows = p_tile->rows - ( ( p_tile->rows - 1 ) / p_tile->tile_rows ) * p_tile->tile_rows;
+    uint32_t last_cols = p_tile->cols - ( ( p_tile->cols - 1 ) / p_tile->tile_cols ) * p_tile->tile_cols;
+
+    for( uint32_t k = 0; k < streams; k++ )
+    {
+        for( uint32_t s = 0; s < DMA_TILE_SIZES; s++ )
+        {
+            uint32_t rows = ( s & TILE_SIZE_LAST_ROW ) ? last_rows : p_tile->tile_rows;
+            uint32_t cols = ( s & TILE_SIZE_LAST_COL ) ? last_cols : p_tile->tile_cols;
+            flags |= compile_copy( p_tile, k, rows, cols, &p_tile->comp[ k ][ s ] );
+        }
+    }
+
+    return ( flags & DMA_CONFIG_CRITICAL_ERROR ) ? DMA_CONFIG_CRITICAL_ERROR : DMA_CONFIG_OK;
+}
+
+void dma_tile_run( dma_tile_t *p_tile, dma_tile_stats_t *p_stats )
+{
+    uint32_t n_in     = p_tile->n_in;
+    uint32_t tiles_r  = ( p_tile->rows + p_tile->tile_rows - 1 ) / p_tile->tile_rows;
+    uint32_t tiles_c  = ( p_tile->cols + p_tile->tile_cols - 1 ) / p_tile->tile_cols;
+    uint32_t tiles    = tiles_r * tiles_c;
+    uint32_t wait     = 0;
+    uint32_t compute  = 0;
+    uint32_t size, offset_b;
+    uint32_t start, end, t0, t1;
+    uint8_t  *in_buf[ DMA_TILE_MAX_IN ];
+    dma_tile_pos_t pos;
+
+    CSR_READ( CSR_REG_MCYCLE, &start );
+
+    /* The first tile has nothing to overlap with. */
+    size = tile_size( p_tile, 0, tiles_r, tiles_c, &offset_b );
+    for( uint32_t k = 0; k < n_in; k++ )
+    {
+        wait += launch( &p_tile->comp[ k ][ size ], (uint8_t*)p_tile->in[ k ],
+                        tile_buf( p_tile, k, 0 ) );
+    }
+
+    for( uint32_t t = 0; t < tiles; t++ )
+    {
+        uint32_t half = t & 1;
+        uint32_t tr = t / tiles_c;
+
+        size = tile_size( p_tile, t, tiles_r, tiles_c, &offset_b );
+        pos.row  = tr * p_tile->tile_rows;
+        pos.col  = ( t - tr * tiles_c ) * p_tile->tile_cols;
+        pos.rows = ( size & TILE_SIZE_LAST_ROW ) ? p_tile->rows - pos.row : p_tile->tile_rows;
+        pos.cols = ( size & TILE_SIZE_LAST_COL ) ? p_tile->cols - pos.col : p_tile->tile_cols;
+
+        for( uint32_t k = 0; k < n_in; k++ )
+        {
+            wait += wait_ch( p_tile->stream_ch[ k ] );
+            in_buf[ k ] = tile_buf( p_tile, k, half );
+        }
+
+        /*
+         * The next inputs go to the other half, whose previous tile is
+         * computed.
+         */
+        if( t + 1 < tiles )
+        {
+            uint32_t noffset_b;
+            uint32_t nsize = tile_size( p_tile, t + 1, tiles_r, tiles_c, &noffset_b );
+
+            for( uint32_t k = 0; k < n_in; k++ )
+            {
+                wait += launch( &p_tile->comp[ k ][ nsize ],
+                                (uint8_t*)p_tile->in[ k ] + noffset_b,
+                                tile_buf( p_tile, k, half ^ 1 ) );
+                if( p_tile->serialize )
+                {
+                    wait += wait_ch( p_tile->stream_ch[ k ] );
+                }
+            }
+        }
+
+        /*
+         * The output buffer of this half was stored two tiles ago: the store
+         * of the previous tile was launched on the same channel after it was
+         * done.
+         */
+        uint8_t *out_buf = p_tile->out ? tile_buf( p_tile, n_in, half ) : NULL;
+
+        CSR_READ( CSR_REG_MCYCLE, &t0 );
+        p_tile->fn( &pos, (void * const *)in_buf, out_buf, p_tile->ctx );
+        CSR_READ( CSR_REG_MCYCLE, &t1 );
+        compute += t1 - t0;
+
+        if( p_tile->out )
+        {
+            wait += launch( &p_tile->comp[ n_in ][ size ], out_buf,
+                            (uint8_t*)p_tile->out + offset_b );
+            if( p_tile->serialize )
+            {
+                wait += wait_ch( p_tile->stream_ch[ n_in ] );
+            }
+        }
+    }
+
+    if( p_tile->out )
+    {
+        wait += wait_ch( p_tile->stream_ch[ n_in ] );
+    }
+
+    CSR_READ( CSR_REG_MCYCLE, &end );
+
+    if( p_stats != NULL )
+    {
+        p_stats->total   = end - start;
+        p_stats->compute = compute;
+        p_stats->wait    = wait;
+        p_stats->tiles   = tiles;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static dma_config_flags_t compile_copy( dma_tile_t *p_tile, uint32_t p_k,
+                                        uint32_t p_rows, uint32_t p_cols,
+                                        dma_compiled_trans_t *p_comp )
+{
+    dma_target_t matrix;
+    dma_target_t buffer;
+    dma_trans_t  trans;
+    dma_data_type_t type = p_tile->elem_b == 4 ? DMA_DATA_TYPE_WORD
+                         : p_tile->elem_b == 2 ? DMA_DATA_TYPE_HALF_WORD
+                         : DMA_DATA_TYPE_BYTE;
+    uint32_t out = ( p_k == p_tile->n_in );
+
+    /* The matrix is strided, the buffer dense. */
+    matrix.env          = NULL;
+    matrix.ptr          = out ? (uint8_t*)p_tile->out : (uint8_t*)p_tile->in[ p_k ];
+    matrix.inc_du       = 1;
+    matrix.size_du      = p_cols;
+    matrix.stride_d2_du = p_tile->stride;
+    matrix.type         = type;
+    matrix.trig         = DMA_TRIG_MEMORY;
+
+    buffer.env          = NULL;
+    buffer.ptr          = tile_buf( p_tile, p_k, 0 );
+    buffer.inc_du       = 1;
+    buffer.size_du      = p_cols;
+    buffer.stride_d2_du = 0;
+    buffer.type         = type;
+    buffer.trig         = DMA_TRIG_MEMORY;
+
+    trans.src      = out ? &buffer : &matrix;
+    trans.dst      = out ? &matrix : &buffer;
+    trans.src_addr = NULL;
+    trans.inc_b    = 0;
+    trans.size_b   = 0;
+    trans.conv     = DMA_TYPE_CONV_NONE;
+    trans.mode     = DMA_TRANS_MODE_SINGLE;
+    trans.win_du   = 0;
+    trans.end      = DMA_TRANS_END_POLLING;
+    trans.channel  = p_tile->stream_ch[ p_k ];
+    trans.size_d2  = p_rows;
+    trans.pace     = 0;
+
+    dma_config_flags_t flags = dma_validate_transaction( &trans, DMA_ENABLE_REALIGN,
+                                                         DMA_PERFORM_CHECKS_INTEGRITY );
+    if( flags & DMA_CONFIG_CRITICAL_ERROR )
+    {
+        return flags;
+    }
+    return dma_compile_transaction( &trans, p_comp );
+}
+
+static uint32_t launch( dma_compiled_trans_t *p_comp, uint8_t *p_src, uint8_t *p_dst )
+{
+    uint32_t waited = wait_ch( p_comp->channel );
+
+    dma_launch_compiled( p_comp, p_src, p_dst );
+    return waited;
+}
+
+static uint32_t wait_ch( uint8_t p_ch )
+{
+    uint32_t t0, t1;
+
+    if( dma_is_ready( p_ch ) )
+    {
+        return 0;
+    }
+    CSR_READ( CSR_REG_MCYCLE, &t0 );
+    while( !dma_is_ready( p_ch ) );
+    CSR_READ( CSR_REG_MCYCLE, &t1 );
+    return t1 - t0;
+}
+
+static inline uint32_t tile_size( dma_tile_t *p_tile, uint32_t p_t, uint32_t p_tiles_r,
+                                  uint32_t p_tiles_c, uint32_t *p_offset_b )
+{
+    uint32_t tr = p_t / p_tiles_c;
+    uint32_t tc = p_t - tr * p_tiles_c;
+
+    *p_offset_b = ( tr * p_tile->tile_rows * p_tile->stride + tc * p_tile->tile_cols )
+                  * p_tile->elem_b;
+    return ( tr == p_tiles_r - 1 ? TILE_SIZE_LAST_ROW : 0 )
+         | ( tc == p_tiles_c - 1 ? TILE_SIZE_LAST_COL : 0 );
+}
+
+static inline uint8_t *tile_buf( dma_tile_t *p_tile, uint32_t p_k, uint32_t p_half )
+{
+    uint32_t buf_b = DMA_TILE_BUF_B( p_tile->tile_rows, p_tile->tile_cols, p_tile->elem_b );
+
+    return p_tile->work + ( p_half * ( p_tile->n_in + 1 ) + p_k ) * buf_b;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,200 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_tile.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dma_tile.h
+* @date   14/10/26
+* @brief  Tiling of kernels on matrices, with the DMA moving the tiles while
+* the CPU computes.
+*
+* The matrices (up to DMA_TILE_MAX_IN inputs and one output, of the same
+* size) are split in tiles of tile_rows x tile_cols elements, the last ones
+* smaller if the matrix is not a multiple of the tile. For each tile, the DMA
+* copies the tiles of the inputs to a dense buffer in a workspace, a compute
+* callback produces the output tile in another buffer, and the DMA copies it
+* back to the output matrix. The buffers are doubled: while the callback
+* computes the tile N, the inputs of the tile N + 1 are being loaded and the
+* output of the tile N - 1 stored.
+*
+* The copies are 2D transactions compiled once by dma_tile_init() for each
+* size of tile, and then launched by patching their pointers. Each input and
+* the output have their own channel from the given one on if the DMA has
+* enough channels, so that they run at the same time; otherwise they all share
+* the given channel and are performed one after the other. The
+* channels must not be used by other transactions during dma_tile_run().
+*
+* dma_tile_run() measures with mcycle the cycles of the whole run, of the
+* callbacks and of the waits for the DMA: compute / total is the overlap
+* efficiency, 1 when the copies are completely hidden behind the
+* computation. mcycle must be counting (mcountinhibit).
+*/
+
+#ifndef _DMA_TILE_H
+#define _DMA_TILE_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Maximum number of input matrices.
+ */
+#ifndef DMA_TILE_MAX_IN
+#define DMA_TILE_MAX_IN     3
+#endif
+
+/**
+ * Sizes of tile: full, last column, last row and last corner.
+ */
+#define DMA_TILE_SIZES      4
+
+/**
+ * Bytes of a tile buffer, rounded up to a word.
+ */
+#define DMA_TILE_BUF_B( tile_rows, tile_cols, elem_b ) \
+    ( ( ( tile_rows ) * ( tile_cols ) * ( elem_b ) + 3u ) & ~3u )
+
+/**
+ * Bytes of the workspace: two buffers for each input and for the output.
+ */
+#define DMA_TILE_WORK_B( n_in, tile_rows, tile_cols, elem_b ) \
+    ( 2u * ( ( n_in ) + 1u ) * DMA_TILE_BUF_B( tile_rows, tile_cols, elem_b ) )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Position and size of a tile, in elements of the matrices.
+ */
+typedef struct
+{
+    uint32_t    row;
+    uint32_t    col;
+    uint32_t    rows;
+    uint32_t    cols;
+} dma_tile_pos_t;
+
+/**
+ * Computes a tile.
+ * @param p_pos The tile.
+ * @param p_in The tiles of the inputs, dense: p_pos->rows rows of
+ * p_pos->cols elements.
+ * @param p_out The output tile to fill, dense as well, or NULL if there is no
+ * output matrix.
+ * @param p_ctx The context of the tiling.
+ */
+typedef void (*dma_tile_fn_t)( const dma_tile_pos_t *p_pos, void * const *p_in,
+                               void *p_out, void *p_ctx );
+
+/**
+ * A tiling. The fields up to ctx are set by the application before
+ * dma_tile_init(), the others by dma_tile_init().
+ */
+typedef struct
+{
+    uint32_t        rows;       /*!< Size of the matrices, in elements. */
+    uint32_t        cols;
+    uint32_t        stride;     /*!< Elements between the starts of two rows of
+    the matrices, 0 if they are dense (cols). */
+    uint32_t        tile_rows;  /*!< Size of the tiles, in elements. */
+    uint32_t        tile_cols;
+    uint8_t         elem_b;     /*!< Size of an element: 1, 2 or 4 bytes. */
+    uint8_t         n_in;       /*!< Number of inputs, 1 to DMA_TILE_MAX_IN. */
+    const void*     in[ DMA_TILE_MAX_IN ]; /*!< The input matrices. */
+    void*           out;        /*!< The output matrix, or NULL. */
+    uint8_t*        work;       /*!< The workspace, word aligned, of
+    DMA_TILE_WORK_B bytes. */
+    uint8_t         ch;         /*!< The first channel. */
+    uint8_t         serialize;  /*!< If non-zero, each copy is waited for right
+    after it is launched: the baseline without overlap. */
+    dma_tile_fn_t   fn;         /*!< The compute callback. */
+    void*           ctx;        /*!< User context, not used by the runtime. */
+    uint8_t         stream_ch[ DMA_TILE_MAX_IN + 1 ]; /*!< The channel of each
+    input, then of the output. */
+    dma_compiled_trans_t comp[ DMA_TILE_MAX_IN + 1 ][ DMA_TILE_SIZES ]; /*!<
+    The copies of each input, then of the output, for each size of tile. */
+} dma_tile_t;
+
+/**
+ * The cycles of a run.
+ */
+typedef struct
+{
+    uint32_t    total;      /*!< The whole run. */
+    uint32_t    compute;    /*!< In the compute callback. */
+    uint32_t    wait;       /*!< Waiting for the DMA. */
+    uint32_t    tiles;      /*!< Number of tiles. */
+} dma_tile_stats_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Checks the geometry and compiles the copies of a tiling. dma_init()
+ * must have been called before.
+ * @param p_tile The tiling. It must stay valid until the last run.
+ * @retval DMA_CONFIG_CRITICAL_ERROR if the geometry is not valid or the DMA
+ * cannot perform a copy, e.g. a stride too large for its increment register.
+ * @retval DMA_CONFIG_OK == 0 otherwise.
+ */
+dma_config_flags_t dma_tile_init( dma_tile_t *p_tile );
+
+/**
+ * @brief Runs the compute callback on all the tiles, row of tiles by row of
+ * tiles, and returns when the last output tile is stored.
+ * @param p_tile The tiling, initialized by dma_tile_init().
+ * @param p_stats The cycles of the run, or NULL.
+ */
+void dma_tile_run( dma_tile_t *p_tile, dma_tile_stats_t *p_stats );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DMA_TILE_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
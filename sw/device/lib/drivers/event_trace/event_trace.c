@@ -0,0 +1,35 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_trace.h"
+
+#define EVENT_TRACE_STAMP_MASK 0xffffff
+
+void event_trace_start(uint32_t events, uint32_t irq_mask, bool stop_when_full) {
+  mmio_region_write32(event_trace_base, EVENT_TRACE_CTRL_REG_OFFSET, 1u << EVENT_TRACE_CTRL_CLEAR_BIT);
+  mmio_region_write32(event_trace_base, EVENT_TRACE_EVENTS_REG_OFFSET, events);
+  mmio_region_write32(event_trace_base, EVENT_TRACE_IRQ_MASK_REG_OFFSET, irq_mask);
+  mmio_region_write32(event_trace_base, EVENT_TRACE_CTRL_REG_OFFSET,
+                      (1u << EVENT_TRACE_CTRL_ENABLE_BIT) |
+                          ((uint32_t)stop_when_full << EVENT_TRACE_CTRL_STOP_WHEN_FULL_BIT));
+}
+
+uint32_t event_trace_read(event_trace_entry_t *entries, uint32_t max) {
+  uint32_t count = event_trace_count();
+  uint32_t idx = mmio_region_read32(event_trace_base, EVENT_TRACE_WR_IDX_REG_OFFSET);
+  uint32_t time = event_trace_time();
+  uint32_t n = count < max ? count : max;
+
+  // From the newest entry, whose time is at most 2^24 cycles before the
+  // current one with the WRAP events, each entry is at most 2^24 cycles
+  // before the next one
+  for (uint32_t k = n; k-- > 0;) {
+    idx = (idx - 1) & (EVENT_TRACE_DEPTH - 1);
+    uint32_t word = mmio_region_read32(event_trace_base, EVENT_TRACE_RING_REG_OFFSET + 4 * idx);
+    time -= (time - word) & EVENT_TRACE_STAMP_MASK;
+    entries[k].time = time;
+    entries[k].code = word >> 24;
+  }
+  return n;
+}
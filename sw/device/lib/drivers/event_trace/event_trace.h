@@ -0,0 +1,156 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DRIVERS_EVENT_TRACE_H_
+#define _DRIVERS_EVENT_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mmio.h"
+#include "core_v_mini_mcu.h"
+#include "event_trace_regs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The event trace unit, in the always-on peripherals at
+ * EVENT_TRACE_START_ADDRESS, counts the cycles while it is enabled and
+ * records the selected events in a ring of EVENT_TRACE_DEPTH entries of its
+ * own, without any access to the bus: the interrupts raised and taken, the
+ * done and window interrupts of the DMA channels, the power domains switched
+ * off and on, and the markers written by the software. Each entry holds the
+ * code of the event and the low 24 bits of the time; the WRAP events let
+ * event_trace_read() rebuild the full time.
+ */
+#define event_trace_base mmio_region_from_addr((uintptr_t)EVENT_TRACE_START_ADDRESS)
+
+/**
+ * Codes of the events.
+ */
+#define EVENT_TRACE_CODE_WRAP 0x00
+#define EVENT_TRACE_CODE_IRQ_TAKEN(irq) (0x20 | (irq))
+#define EVENT_TRACE_CODE_IRQ_RAISED(irq) (0x40 | (irq))
+#define EVENT_TRACE_CODE_DMA_DONE(ch) (0x60 | (ch))
+#define EVENT_TRACE_CODE_DMA_WINDOW(ch) (0x70 | (ch))
+#define EVENT_TRACE_CODE_POWER(domain, on) (0x80 | ((domain) << 1) | ((on) ? 1 : 0))
+#define EVENT_TRACE_CODE_MARKER(marker) (0xc0 | (marker))
+
+#define EVENT_TRACE_IS_IRQ_TAKEN(code) (((code) & 0xe0) == 0x20)
+#define EVENT_TRACE_IS_IRQ_RAISED(code) (((code) & 0xe0) == 0x40)
+#define EVENT_TRACE_IS_DMA_DONE(code) (((code) & 0xf0) == 0x60)
+#define EVENT_TRACE_IS_DMA_WINDOW(code) (((code) & 0xf0) == 0x70)
+#define EVENT_TRACE_IS_POWER(code) (((code) & 0xc0) == 0x80)
+#define EVENT_TRACE_IS_MARKER(code) (((code) & 0xc0) == 0xc0)
+
+/**
+ * Interrupt lines of the core, in the codes and the mask of the lines.
+ */
+#define EVENT_TRACE_IRQ_SOFTWARE 3
+#define EVENT_TRACE_IRQ_TIMER 7
+#define EVENT_TRACE_IRQ_EXTERNAL 11
+#define EVENT_TRACE_IRQ_FAST(fic) (16 + (fic))
+
+/**
+ * Power domains, in the codes of the POWER events. The core is on when it
+ * is awake.
+ */
+#define EVENT_TRACE_DOMAIN_CORE 0
+#define EVENT_TRACE_DOMAIN_CPU 1
+#define EVENT_TRACE_DOMAIN_PERIPHERAL 2
+#define EVENT_TRACE_DOMAIN_BANK(bank) (3 + (bank))
+
+/**
+ * Classes of events, for event_trace_start().
+ */
+#define EVENT_TRACE_WRAP (1u << EVENT_TRACE_EVENTS_WRAP_BIT)
+#define EVENT_TRACE_MARKER (1u << EVENT_TRACE_EVENTS_MARKER_BIT)
+#define EVENT_TRACE_IRQ_TAKEN (1u << EVENT_TRACE_EVENTS_IRQ_TAKEN_BIT)
+#define EVENT_TRACE_IRQ_RAISED (1u << EVENT_TRACE_EVENTS_IRQ_RAISED_BIT)
+#define EVENT_TRACE_DMA_DONE (1u << EVENT_TRACE_EVENTS_DMA_DONE_BIT)
+#define EVENT_TRACE_DMA_WINDOW (1u << EVENT_TRACE_EVENTS_DMA_WINDOW_BIT)
+#define EVENT_TRACE_POWER (1u << EVENT_TRACE_EVENTS_POWER_BIT)
+#define EVENT_TRACE_ALL 0x7fu
+
+/**
+ * An entry of the trace.
+ */
+typedef struct {
+  uint32_t time;  // cycles since event_trace_start(), modulo 2^32
+  uint8_t code;   // EVENT_TRACE_CODE_*
+} event_trace_entry_t;
+
+/**
+ * Empty the ring, clear the time and start tracing.
+ * @param events The classes of events traced, EVENT_TRACE_WRAP for
+ * event_trace_read() to rebuild the time over more than 2^24 cycles.
+ * @param irq_mask The traced interrupt lines, raised and taken.
+ * @param stop_when_full Stop recording when the ring is full, else the
+ * oldest entries are overwritten.
+ */
+void event_trace_start(uint32_t events, uint32_t irq_mask, bool stop_when_full);
+
+/**
+ * Stop tracing: the time stops and no event is recorded.
+ */
+static inline void event_trace_stop(void) {
+  mmio_region_write32(event_trace_base, EVENT_TRACE_CTRL_REG_OFFSET, 0);
+}
+
+/**
+ * Record a marker, e.g. at the start and at the end of a section.
+ * @param marker The marker, of 6 bits.
+ */
+static inline void event_trace_marker(uint32_t marker) {
+  mmio_region_write32(event_trace_base, EVENT_TRACE_MARKER_REG_OFFSET, marker & EVENT_TRACE_MARKER_MARKER_MASK);
+}
+
+/**
+ * Cycles counted since event_trace_start() while tracing, modulo 2^32.
+ */
+static inline uint32_t event_trace_time(void) {
+  return mmio_region_read32(event_trace_base, EVENT_TRACE_CYCLES_REG_OFFSET);
+}
+
+/**
+ * Entries in the ring, at most EVENT_TRACE_DEPTH.
+ */
+static inline uint32_t event_trace_count(void) {
+  return (mmio_region_read32(event_trace_base, EVENT_TRACE_STATUS_REG_OFFSET) >> EVENT_TRACE_STATUS_COUNT_OFFSET) &
+         EVENT_TRACE_STATUS_COUNT_MASK;
+}
+
+/**
+ * Whether the oldest entries were overwritten.
+ */
+static inline bool event_trace_overwritten(void) {
+  return (mmio_region_read32(event_trace_base, EVENT_TRACE_STATUS_REG_OFFSET) >> EVENT_TRACE_STATUS_OVERWRITTEN_BIT) & 1;
+}
+
+/**
+ * Events lost since event_trace_start(): they came again before being
+ * recorded, or the ring was full with stop_when_full.
+ */
+static inline uint32_t event_trace_dropped(void) {
+  return mmio_region_read32(event_trace_base, EVENT_TRACE_DROPPED_REG_OFFSET);
+}
+
+/**
+ * Read the newest entries of the trace, the oldest first, with their full
+ * time rebuilt from the current time. Tracing should be stopped, else the
+ * newest entries may be missed. Without the WRAP events, the time between
+ * two entries is modulo 2^24 cycles.
+ * @param entries The entries read.
+ * @param max The size of entries.
+ * @return The number of entries read.
+ */
+uint32_t event_trace_read(event_trace_entry_t *entries, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DRIVERS_EVENT_TRACE_H_
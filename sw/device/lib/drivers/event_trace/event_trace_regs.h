@@ -0,0 +1,73 @@
+// Generated register defines for event_trace
+
+// Copyright information found in source file:
+// Copyright 2026 EPFL
+
+// Licensing information found in source file:
+// 
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#ifndef _EVENT_TRACE_REG_DEFS_
+#define _EVENT_TRACE_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define EVENT_TRACE_PARAM_REG_WIDTH 32
+
+// Control of the trace, CLEAR reads as 0
+#define EVENT_TRACE_CTRL_REG_OFFSET 0x0
+#define EVENT_TRACE_CTRL_ENABLE_BIT 0
+#define EVENT_TRACE_CTRL_STOP_WHEN_FULL_BIT 1
+#define EVENT_TRACE_CTRL_CLEAR_BIT 2
+
+// Enabled events, all at reset
+#define EVENT_TRACE_EVENTS_REG_OFFSET 0x4
+#define EVENT_TRACE_EVENTS_WRAP_BIT 0
+#define EVENT_TRACE_EVENTS_MARKER_BIT 1
+#define EVENT_TRACE_EVENTS_IRQ_TAKEN_BIT 2
+#define EVENT_TRACE_EVENTS_IRQ_RAISED_BIT 3
+#define EVENT_TRACE_EVENTS_DMA_DONE_BIT 4
+#define EVENT_TRACE_EVENTS_DMA_WINDOW_BIT 5
+#define EVENT_TRACE_EVENTS_POWER_BIT 6
+
+// Traced lines of the interrupts of the core, all at reset
+#define EVENT_TRACE_IRQ_MASK_REG_OFFSET 0x8
+
+// Write: records the marker
+#define EVENT_TRACE_MARKER_REG_OFFSET 0xc
+#define EVENT_TRACE_MARKER_MARKER_MASK 0x3f
+#define EVENT_TRACE_MARKER_MARKER_OFFSET 0
+#define EVENT_TRACE_MARKER_MARKER_FIELD \
+  ((bitfield_field32_t) { .mask = EVENT_TRACE_MARKER_MARKER_MASK, .index = EVENT_TRACE_MARKER_MARKER_OFFSET })
+
+// Status, read-only
+#define EVENT_TRACE_STATUS_REG_OFFSET 0x10
+#define EVENT_TRACE_STATUS_COUNT_MASK 0xffff
+#define EVENT_TRACE_STATUS_COUNT_OFFSET 0
+#define EVENT_TRACE_STATUS_COUNT_FIELD \
+  ((bitfield_field32_t) { .mask = EVENT_TRACE_STATUS_COUNT_MASK, .index = EVENT_TRACE_STATUS_COUNT_OFFSET })
+#define EVENT_TRACE_STATUS_OVERWRITTEN_BIT 16
+
+// Index of the next entry written, read-only
+#define EVENT_TRACE_WR_IDX_REG_OFFSET 0x14
+
+// Events lost, read-only
+#define EVENT_TRACE_DROPPED_REG_OFFSET 0x18
+
+// Cycles counted while enabled, read-only
+#define EVENT_TRACE_CYCLES_REG_OFFSET 0x1c
+
+// Entries of the ring, read-only
+#define EVENT_TRACE_DEPTH_REG_OFFSET 0x20
+
+// Memory area: Entry i of the ring at 4 * i bytes, read-only.
+#define EVENT_TRACE_RING_REG_OFFSET 0x1000
+#define EVENT_TRACE_RING_SIZE_WORDS 1024
+#define EVENT_TRACE_RING_SIZE_BYTES 4096
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _EVENT_TRACE_REG_DEFS_
+// End generated register defines for event_trace
\ No newline at end of file
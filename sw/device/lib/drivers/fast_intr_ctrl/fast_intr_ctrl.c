@@ -34,6 +34,10 @@
 #include "core_v_mini_mcu.h"
 #include "fast_intr_ctrl_regs.h"  // Generated.
 #include "fast_intr_ctrl_structs.h"
+#include "csr.h"
+#if ICACHE_WAYS > 0
+#include "soc_ctrl.h"
+#endif
 
 /****************************************************************************/
 /**                                                                        **/
@@ -58,8 +62,28 @@
  * You only need to use this ABI for handlers that are the first function called
  * in an interrupt handler. Subsequent functions can just use the regular RISC-V
  * calling convention.
+ *
+ * As in handler.h, the handlers go to the section .xheep_isr, in the RAM with
+ * the vector table.
  */
-#define INTERRUPT_HANDLER_ABI __attribute__((aligned(4), interrupt))
+#define INTERRUPT_HANDLER_ABI \
+  __attribute__((aligned(4), interrupt, section(".xheep_isr")))
+
+/**
+ * The machine interrupt enable bit of mstatus.
+ */
+#define FIC_MSTATUS_MIE 0x8
+
+/**
+ * The bit of the first fast interrupt in mie.
+ */
+#define FIC_MIE_FAST_FIRST 16
+
+/**
+ * The opcode of jal, and the reach of its offset.
+ */
+#define FIC_JAL_OPCODE 0x6F
+#define FIC_JAL_REACH  0x100000
 
 /****************************************************************************/
 /**                                                                        **/
@@ -76,115 +100,140 @@
 /**
  * @brief Fast timer 1 irq handler. The first entry point when timer 1 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_timer_1(void);
 
 /**
  * @brief Fast timer 2 irq handler. The first entry point when timer 2 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_timer_2(void);
 
 /**
  * @brief Fast timer 3 irq handler. The first entry point when timer 3 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_timer_3(void);
 
 /**
  * @brief Fast dma irq handler. The first entry point when dma interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_dma(void);
 
 /**
  * @brief Fast spi irq handler. The first entry point when spi interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_spi(void);
 
 /**
  * @brief Fast spi flash irq handler. The first entry point when spi flash 
  * interrupt is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_spi_flash(void);
 
 /**
  * @brief Fast gpio 0 irq handler. The first entry point when gpio 0 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_0(void);
 
 /**
  * @brief Fast gpio 1 irq handler. The first entry point when gpio 1 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_1(void);
 
 /**
  * @brief Fast gpio 2 irq handler. The first entry point when gpio 2 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_2(void);
 
 /**
  * @brief Fast gpio 3 irq handler. The first entry point when gpio 3 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_3(void);
 
 /**
  * @brief Fast gpio 4 irq handler. The first entry point when gpio 4 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_4(void);
 
 /**
  * @brief Fast gpio 5 irq handler. The first entry point when gpio 5 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_5(void);
 
 /**
  * @brief Fast gpio 6 irq handler. The first entry point when gpio 6 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_6(void);
 
 /**
  * @brief Fast gpio 7 irq handler. The first entry point when gpio 7 interrupt
  * is recieved through fic.
- * This function clear the responsible bit in FAST_INTR_PENDING then call a 
- * function that can be overriden inside peripherals.
+ * This function clears the responsible bit in FAST_INTR_PENDING then calls
+ * the registered handler, or else a function that can be overriden inside
+ * peripherals. It is weak, see fic_assign_irq_handler.
  */
 INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_7(void);
 
+/**
+ * @brief Clears a fast interrupt and calls its registered handler, or else
+ * its weak fic handler, with the fast interrupts of a higher priority enabled.
+ * Inlined in each handler_irq_fast_*, so that the weak handler is a direct
+ * call.
+ * @param p_irq The fast interrupt.
+ * @param p_fic_irq The weak fic handler.
+ */
+static inline void fic_dispatch( fast_intr_ctrl_fast_interrupt_t p_irq,
+                                 void (*p_fic_irq)(void) );
+
 /****************************************************************************/
 /**                                                                        **/
 /*                           EXPORTED VARIABLES                             */
@@ -197,6 +246,36 @@ INTERRUPT_HANDLER_ABI void handler_irq_fast_gpio_7(void);
 /**                                                                        **/
 /****************************************************************************/
 
+/**
+ * Handlers registered with fic_assign_irq_handler, NULL for the weak fic
+ * handlers.
+ */
+static fic_handler_t fic_handlers[FAST_INTR_CTRL_IRQ_N];
+
+/**
+ * Priorities set with fic_set_priority, 0 for the handlers that are not
+ * preempted.
+ */
+static uint8_t fic_priorities[FAST_INTR_CTRL_IRQ_N];
+
+/**
+ * For each fast interrupt, the mie bits of the fast interrupts that preempt
+ * its handler, i.e. of a higher priority. 0 if it is not preempted.
+ */
+static uint32_t fic_preempt_mie[FAST_INTR_CTRL_IRQ_N];
+
+/**
+ * The fast interrupts set with fic_set_auto_clear, which are not cleared by
+ * the software.
+ */
+static uint32_t fic_auto_clear;
+
+/**
+ * The words of the vector slots replaced by fic_install_vector, 0 for the
+ * slots that are not.
+ */
+static uint32_t fic_vector_words[FAST_INTR_CTRL_IRQ_N];
+
 /****************************************************************************/
 /**                                                                        **/
 /*                           EXPORTED FUNCTIONS                             */
@@ -231,6 +310,120 @@ fast_intr_ctrl_result_t clear_fast_interrupt(fast_intr_ctrl_fast_interrupt_t\
     return kFastIntrCtrlOk_e;
 }
 
+fast_intr_ctrl_result_t fic_assign_irq_handler(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, fic_handler_t handler)
+{
+    if (fast_interrupt >= FAST_INTR_CTRL_IRQ_N) {
+        return kFastIntrCtrlError_e;
+    }
+    fic_handlers[fast_interrupt] = handler;
+    return kFastIntrCtrlOk_e;
+}
+
+fast_intr_ctrl_result_t fic_set_priority(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, uint8_t priority)
+{
+    if (fast_interrupt >= FAST_INTR_CTRL_IRQ_N) {
+        return kFastIntrCtrlError_e;
+    }
+    fic_priorities[fast_interrupt] = priority;
+
+    // The masks of all the handlers depend on this priority
+    for (uint32_t i = 0; i < FAST_INTR_CTRL_IRQ_N; i++) {
+        uint32_t mask = 0;
+        if (fic_priorities[i] != 0) {
+            for (uint32_t j = 0; j < FAST_INTR_CTRL_IRQ_N; j++) {
+                if (fic_priorities[j] > fic_priorities[i]) {
+                    mask |= 1u << (FIC_MIE_FAST_FIRST + j);
+                }
+            }
+        }
+        fic_preempt_mie[i] = mask;
+    }
+    return kFastIntrCtrlOk_e;
+}
+
+void fic_irq_dispatch(fast_intr_ctrl_fast_interrupt_t fast_interrupt)
+{
+    static void (* const fic_irqs[FAST_INTR_CTRL_IRQ_N])(void) = {
+        fic_irq_timer_1, fic_irq_timer_2, fic_irq_timer_3, fic_irq_dma,
+        fic_irq_spi, fic_irq_spi_flash, fic_irq_gpio_0, fic_irq_gpio_1,
+        fic_irq_gpio_2, fic_irq_gpio_3, fic_irq_gpio_4, fic_irq_gpio_5,
+        fic_irq_gpio_6, fic_irq_gpio_7
+    };
+
+    if (fast_interrupt >= FAST_INTR_CTRL_IRQ_N) {
+        return;
+    }
+    // The interrupt is cleared, unless FIC did on the acknowledge.
+    if ((fic_auto_clear & (1 << fast_interrupt)) == 0) {
+        fast_intr_ctrl_peri->FAST_INTR_CLEAR = 1 << fast_interrupt;
+    }
+    if (fic_handlers[fast_interrupt] != NULL) {
+        fic_handlers[fast_interrupt](fast_interrupt);
+    } else {
+        fic_irqs[fast_interrupt]();
+    }
+}
+
+fast_intr_ctrl_result_t fic_install_vector(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, fic_vector_t handler)
+{
+    uint32_t mtvec;
+
+    if (fast_interrupt >= FAST_INTR_CTRL_IRQ_N) {
+        return kFastIntrCtrlError_e;
+    }
+    CSR_READ(CSR_REG_MTVEC, &mtvec);
+    // The slot of the interrupt 16 + i of the core in the vector table
+    volatile uint32_t *slot = (volatile uint32_t *)((mtvec & ~0x3) +
+        4 * (FIC_MIE_FAST_FIRST + fast_interrupt));
+    if ((uint32_t)slot - RAM_START_ADDRESS >= RAM_SIZE) {
+        return kFastIntrCtrlError_e;
+    }
+
+    if (handler == NULL) {
+        if (fic_vector_words[fast_interrupt] == 0) {
+            return kFastIntrCtrlOk_e;
+        }
+        *slot = fic_vector_words[fast_interrupt];
+        fic_vector_words[fast_interrupt] = 0;
+    } else {
+        int32_t offset = (int32_t)((uint32_t)handler - (uint32_t)slot);
+        if (offset < -FIC_JAL_REACH || offset >= FIC_JAL_REACH) {
+            return kFastIntrCtrlError_e;
+        }
+        if (fic_vector_words[fast_interrupt] == 0) {
+            fic_vector_words[fast_interrupt] = *slot;
+        }
+        // jal x0, offset
+        uint32_t off = (uint32_t)offset;
+        *slot = ((off & 0x100000) << 11) | ((off & 0x7FE) << 20) |
+                ((off & 0x800) << 9) | (off & 0xFF000) | FIC_JAL_OPCODE;
+    }
+
+    // fence.i, encoded as a word so that it builds without _zifencei
+    asm volatile( ".word 0x0000100f" ::: "memory" );
+#if ICACHE_WAYS > 0
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    soc_ctrl_icache_flush(&soc_ctrl);
+#endif
+    return kFastIntrCtrlOk_e;
+}
+
+fast_intr_ctrl_result_t fic_set_auto_clear(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, bool enable)
+{
+    if (fast_interrupt >= FAST_INTR_CTRL_IRQ_N || (enable && !FIC_AUTO_CLEAR)) {
+        return kFastIntrCtrlError_e;
+    }
+    fic_auto_clear = bitfield_bit32_write(fic_auto_clear, fast_interrupt,
+                                          enable);
+    fast_intr_ctrl_peri->FAST_INTR_AUTO_CLEAR = fic_auto_clear;
+    return kFastIntrCtrlOk_e;
+}
+
 __attribute__((weak, optimize("O0"))) void fic_irq_timer_1(void)
 {
     /* Users should implement their non-weak version */
@@ -307,116 +500,112 @@ __attribute__((weak, optimize("O0"))) void fic_irq_gpio_7(void)
 /**                                                                        **/
 /****************************************************************************/
 
-void handler_irq_fast_timer_1(void)
+static inline void fic_dispatch( fast_intr_ctrl_fast_interrupt_t p_irq,
+                                 void (*p_fic_irq)(void) )
+{
+    // The interrupt is cleared, unless FIC did on the acknowledge.
+    if ((fic_auto_clear & (1 << p_irq)) == 0) {
+        fast_intr_ctrl_peri->FAST_INTR_CLEAR = 1 << p_irq;
+    }
+    fic_handler_t handler = fic_handlers[p_irq];
+    uint32_t preempt = fic_preempt_mie[p_irq];
+    uint32_t mepc, mstatus, mie;
+
+    if (preempt != 0) {
+        // A nested trap overwrites mepc and mstatus.MPIE/MPP, the mret of
+        // this handler needs them back
+        CSR_READ(CSR_REG_MEPC, &mepc);
+        CSR_READ(CSR_REG_MSTATUS, &mstatus);
+        CSR_READ(CSR_REG_MIE, &mie);
+        // Only the fast interrupts of a higher priority stay enabled
+        CSR_CLEAR_BITS(CSR_REG_MIE, mie & ~preempt);
+        CSR_SET_BITS(CSR_REG_MSTATUS, FIC_MSTATUS_MIE);
+    }
+
+    if (handler != NULL) {
+        handler(p_irq);
+    } else {
+        // call the weak fic handler
+        p_fic_irq();
+    }
+
+    if (preempt != 0) {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, FIC_MSTATUS_MIE);
+        // The bits that the handler may have changed are left as they are
+        CSR_SET_BITS(CSR_REG_MIE, mie & ~preempt);
+        CSR_WRITE(CSR_REG_MEPC, mepc);
+        CSR_WRITE(CSR_REG_MSTATUS, mstatus);
+    }
+}
+
+__attribute__((weak)) void handler_irq_fast_timer_1(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kTimer_1_fic_e);
-    // call the weak fic handler
-    fic_irq_timer_1();
+    fic_dispatch(kTimer_1_fic_e, fic_irq_timer_1);
 }
 
-void handler_irq_fast_timer_2(void)
+__attribute__((weak)) void handler_irq_fast_timer_2(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kTimer_2_fic_e);
-    // call the weak fic handler
-    fic_irq_timer_2();
+    fic_dispatch(kTimer_2_fic_e, fic_irq_timer_2);
 }
 
-void handler_irq_fast_timer_3(void)
+__attribute__((weak)) void handler_irq_fast_timer_3(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kTimer_3_fic_e);
-    // call the weak fic handler
-    fic_irq_timer_3();
+    fic_dispatch(kTimer_3_fic_e, fic_irq_timer_3);
 }
 
-void handler_irq_fast_dma(void)
+__attribute__((weak)) void handler_irq_fast_dma(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kDma_fic_e);
-    // call the weak fic handler
-    fic_irq_dma();
+    fic_dispatch(kDma_fic_e, fic_irq_dma);
 }
 
-void handler_irq_fast_spi(void)
+__attribute__((weak)) void handler_irq_fast_spi(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kSpi_fic_e);
-    // call the weak fic handler
-    fic_irq_spi();
+    fic_dispatch(kSpi_fic_e, fic_irq_spi);
 }
 
-void handler_irq_fast_spi_flash(void)
+__attribute__((weak)) void handler_irq_fast_spi_flash(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kSpiFlash_fic_e);
-    // call the weak fic handler
-    fic_irq_spi_flash();
+    fic_dispatch(kSpiFlash_fic_e, fic_irq_spi_flash);
 }
 
-void handler_irq_fast_gpio_0(void)
+__attribute__((weak)) void handler_irq_fast_gpio_0(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_0_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_0();
+    fic_dispatch(kGpio_0_fic_e, fic_irq_gpio_0);
 }
 
-void handler_irq_fast_gpio_1(void)
+__attribute__((weak)) void handler_irq_fast_gpio_1(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_1_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_1();
+    fic_dispatch(kGpio_1_fic_e, fic_irq_gpio_1);
 }
 
-void handler_irq_fast_gpio_2(void)
+__attribute__((weak)) void handler_irq_fast_gpio_2(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_2_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_2();
+    fic_dispatch(kGpio_2_fic_e, fic_irq_gpio_2);
 }
 
-void handler_irq_fast_gpio_3(void)
+__attribute__((weak)) void handler_irq_fast_gpio_3(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_3_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_3();
+    fic_dispatch(kGpio_3_fic_e, fic_irq_gpio_3);
 }
 
-void handler_irq_fast_gpio_4(void)
+__attribute__((weak)) void handler_irq_fast_gpio_4(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_4_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_4();
+    fic_dispatch(kGpio_4_fic_e, fic_irq_gpio_4);
 }
 
-void handler_irq_fast_gpio_5(void)
+__attribute__((weak)) void handler_irq_fast_gpio_5(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_5_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_5();
+    fic_dispatch(kGpio_5_fic_e, fic_irq_gpio_5);
 }
 
-void handler_irq_fast_gpio_6(void)
+__attribute__((weak)) void handler_irq_fast_gpio_6(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_6_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_6();
+    fic_dispatch(kGpio_6_fic_e, fic_irq_gpio_6);
 }
 
-void handler_irq_fast_gpio_7(void)
+__attribute__((weak)) void handler_irq_fast_gpio_7(void)
 {
-    // The interrupt is cleared.
-    clear_fast_interrupt(kGpio_7_fic_e);
-    // call the weak fic handler
-    fic_irq_gpio_7();
+    fic_dispatch(kGpio_7_fic_e, fic_irq_gpio_7);
 }
 
 /****************************************************************************/
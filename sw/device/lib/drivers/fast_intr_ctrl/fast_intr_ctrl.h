@@ -36,6 +36,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "mmio.h"
+#include "core_v_mini_mcu.h"
 
 /****************************************************************************/
 /**                                                                        **/
@@ -43,6 +44,21 @@
 /**                                                                        **/
 /****************************************************************************/
 
+/**
+ * Number of fast interrupts connected to FIC.
+ */
+#define FAST_INTR_CTRL_IRQ_N 14
+
+/**
+ * 1 if the core acknowledges its interrupts to FIC, so that the fast
+ * interrupts set with fic_set_auto_clear are cleared by the hardware. Only
+ * the cv32e40p and the cv32e40px drive the acknowledge.
+ */
+#if defined(CPU_TYPE_CV32E40P) || defined(CPU_TYPE_CV32E40PX)
+#define FIC_AUTO_CLEAR 1
+#else
+#define FIC_AUTO_CLEAR 0
+#endif
 
 
 /****************************************************************************/
@@ -81,6 +97,18 @@ typedef enum fast_intr_ctrl_fast_interrupt {
   kGpio_7_fic_e   = 13,/*!< GPIO 7. */
 } fast_intr_ctrl_fast_interrupt_t;
 
+/**
+ * A handler registered with fic_assign_irq_handler. It receives the fast
+ * interrupt that called it.
+ */
+typedef void (*fic_handler_t)(uint32_t);
+
+/**
+ * An entry of the vector table installed with fic_install_vector. It must be
+ * defined with the INTERRUPT_HANDLER_ABI of handler.h.
+ */
+typedef void (*fic_vector_t)(void);
+
 /****************************************************************************/
 /**                                                                        **/
 /**                          EXPORTED VARIABLES                            **/
@@ -124,6 +152,93 @@ fast_intr_ctrl_result_t enable_all_fast_interrupts(bool enable);
 fast_intr_ctrl_result_t clear_fast_interrupt(fast_intr_ctrl_fast_interrupt_t\
  fast_interrupt);
 
+/**
+ * @brief Register the handler of a fast interrupt. It is called by
+ * handler_irq_fast_* after the bit in FAST_INTR_PENDING is cleared, instead of
+ * the weak fic_irq_* function.
+ *
+ * handler_irq_fast_* are the entries of the vector table. They save all the
+ * caller-saved registers as they call the handler. For the shortest latency,
+ * an application can instead define handler_irq_fast_* with the
+ * INTERRUPT_HANDLER_ABI of handler.h: the vector slot then jumps straight to
+ * it and, if it calls no function, only the registers it uses are saved. It
+ * must clear its bit with clear_fast_interrupt or FAST_INTR_CLEAR.
+ * @param fast_interrupt specify the peripheral
+ * @param handler the handler, NULL to call the fic_irq_* function again
+ * @retval kFastIntrCtrlOk_e (= 0) if successfully registered
+ * @retval kFastIntrCtrlError_e (= 1) if fast_interrupt is not valid
+ */
+fast_intr_ctrl_result_t fic_assign_irq_handler(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, fic_handler_t handler);
+
+/**
+ * @brief Set the priority of a fast interrupt. The handler of a fast
+ * interrupt with a priority above 0 is preempted by the fast interrupts of a
+ * higher priority: handler_irq_fast_* disables the others in mie and enables
+ * the interrupts while it runs. The handlers of priority 0, the default, run
+ * with the interrupts disabled.
+ *
+ * Once a handler is nested, mepc and mstatus are saved and restored around
+ * it, and the mie bits it disabled are set again. The PLIC interrupts (mie.MEIE)
+ * do not preempt the fast ones. A nested handler runs on the same stack as the
+ * one it preempts. The vector entries defined by the application, see
+ * fic_assign_irq_handler, are preempted only if they enable the interrupts
+ * themselves.
+ * @param fast_interrupt specify the peripheral
+ * @param priority the priority, 0 for a handler that is not preempted
+ * @retval kFastIntrCtrlOk_e (= 0) if successfully set
+ * @retval kFastIntrCtrlError_e (= 1) if fast_interrupt is not valid
+ */
+fast_intr_ctrl_result_t fic_set_priority(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, uint8_t priority);
+
+/**
+ * @brief Clear a fast interrupt and call its registered handler, or else its
+ * weak fic_irq_* function, from C. It is the dispatch of handler_irq_fast_*
+ * for the trap handlers that save the context themselves, e.g. the one of
+ * FreeRTOS: the priorities of fic_set_priority are not applied, the handler
+ * runs with the interrupts disabled.
+ * @param fast_interrupt specify the peripheral, ignored if not valid
+ */
+void fic_irq_dispatch(fast_intr_ctrl_fast_interrupt_t fast_interrupt);
+
+/**
+ * @brief Install a handler straight in the slot of a fast interrupt in the
+ * vector table of mtvec, instead of its handler_irq_fast_* entry: the slot
+ * then jumps to it with no dispatch. The handler must be defined with the
+ * INTERRUPT_HANDLER_ABI of handler.h and clear its bit in FAST_INTR_PENDING,
+ * unless it is auto-cleared (fic_set_auto_clear).
+ *
+ * The slot is rewritten, so the vector table must be in RAM: it is not with
+ * LINKER=flash_exec. The handler must be within the +-1 MiB of a jal from
+ * the slot. The instruction stream is synchronized with a fence.i, and the
+ * instruction cache flushed if there is one.
+ * @param fast_interrupt specify the peripheral
+ * @param handler the handler, NULL to restore the handler_irq_fast_* entry
+ * @retval kFastIntrCtrlOk_e (= 0) if successfully installed
+ * @retval kFastIntrCtrlError_e (= 1) if fast_interrupt is not valid, the
+ * vector table is not in RAM or the handler is out of reach
+ */
+fast_intr_ctrl_result_t fic_install_vector(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, fic_vector_t handler);
+
+/**
+ * @brief Let FIC clear the pending bit of a fast interrupt when the core
+ * acknowledges it, instead of the software with FAST_INTR_CLEAR. The
+ * interrupt is then pended on the rising edge of its source, and not while
+ * it is high, so that a source still high once acknowledged does not trap
+ * again: its handler must clear the source before it rises again.
+ * handler_irq_fast_* and fic_irq_dispatch skip the write of FAST_INTR_CLEAR
+ * for it.
+ * @param fast_interrupt specify the peripheral
+ * @param enable enable value
+ * @retval kFastIntrCtrlOk_e (= 0) if successfully set
+ * @retval kFastIntrCtrlError_e (= 1) if fast_interrupt is not valid, or the
+ * core does not acknowledge its interrupts (FIC_AUTO_CLEAR is 0)
+ */
+fast_intr_ctrl_result_t fic_set_auto_clear(fast_intr_ctrl_fast_interrupt_t\
+ fast_interrupt, bool enable);
+
 /**
  * @brief fast interrupt controller irq for timer 1 
  * `fast_intr_ctrl.c` provides a weak definition of this symbol, which can 
@@ -37,6 +37,13 @@ extern "C" {
 #define FAST_INTR_CTRL_FAST_INTR_ENABLE_FAST_INTR_ENABLE_FIELD \
   ((bitfield_field32_t) { .mask = FAST_INTR_CTRL_FAST_INTR_ENABLE_FAST_INTR_ENABLE_MASK, .index = FAST_INTR_CTRL_FAST_INTR_ENABLE_FAST_INTR_ENABLE_OFFSET })
 
+// Clear the pending fast interrupt when the core acknowledges it
+#define FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_REG_OFFSET 0xc
+#define FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_FAST_INTR_AUTO_CLEAR_MASK 0x7fff
+#define FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_FAST_INTR_AUTO_CLEAR_OFFSET 0
+#define FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_FAST_INTR_AUTO_CLEAR_FIELD \
+  ((bitfield_field32_t) { .mask = FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_FAST_INTR_AUTO_CLEAR_MASK, .index = FAST_INTR_CTRL_FAST_INTR_AUTO_CLEAR_FAST_INTR_AUTO_CLEAR_OFFSET })
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -35,6 +35,9 @@
 #include "gpio_structs.h"
 #include "core_v_mini_mcu.h"
 #include "bitfield.h"
+#include "csr.h"
+#include "irq.h"
+#include "clock_gate.h"
 #include "x-heep.h"
 
 /****************************************************************************/
@@ -82,19 +85,30 @@
 #define GPIO_INTR_IS_NOT_TRIGGERED  0
 
 /**
- * Clearing the status bit by writing one into int
+ * Clearing the status bit by writing one into int. Only the bit of the pin is
+ * written: writing back the other pending bits would clear them too.
  */
 #define GPIO_INTR_CLEAR     1
 
 /**
- * GPIO intr mode configration index inside GPIO_CFG register.
+ * The pins of the AO domain in a port mask, the others are in the peripheral
+ * domain.
  */
-#define GPIO_CFG_INTR_MODE_INDEX    0
+#define GPIO_PORT_AO_MASK   ( ( 1u << GPIO_AO_DOMAIN_LIMIT ) - 1 )
 
 /**
- * GPIO mode, number of pins it includes
+ * The pins that exist in a port mask.
  */
-#define GPIO_MODE_NUM_PINS      16
+#if MAX_PIN >= 32
+#define GPIO_PORT_MASK      0xFFFFFFFF
+#else
+#define GPIO_PORT_MASK      ( ( 1u << MAX_PIN ) - 1 )
+#endif
+
+/**
+ * GPIO intr mode configration index inside GPIO_CFG register.
+ */
+#define GPIO_CFG_INTR_MODE_INDEX    0
 
 /**
  * The first interrupt ID for the GPIOS
@@ -129,12 +143,48 @@ void (*gpio_handlers[ GPIO_INTR_QTY ])( void );
 
 volatile gpio * gpio_perif;
 
+/**
+ * The pins of the peripheral domain in use, from their first access to their
+ * reset. The clock of the peripheral domain (clock_gate.h) is held while
+ * there is any.
+ */
+static uint32_t gpio_periph_pins = 0;
+
 __attribute__((optimize("O0"))) static void gpio_handler_irq_dummy( uint32_t dummy );
 
+static void gpio_periph_hold(uint32_t pins)
+{
+    uint32_t mstatus;
+
+    if ((gpio_periph_pins & pins) == pins)
+        return;
+
+    mstatus = irq_save();
+    if (gpio_periph_pins == 0)
+        clock_gate_acquire(CLOCK_GATE_PERIPH);
+    gpio_periph_pins |= pins;
+    irq_restore(mstatus);
+}
+
+static void gpio_periph_drop(uint32_t pins)
+{
+    uint32_t mstatus;
+
+    if ((gpio_periph_pins & pins) == 0)
+        return;
+
+    mstatus = irq_save();
+    gpio_periph_pins &= ~pins;
+    if (gpio_periph_pins == 0)
+        clock_gate_release(CLOCK_GATE_PERIPH);
+    irq_restore(mstatus);
+}
 
 __attribute__((always_inline)) void select_gpio_domain(gpio_pin_number_t pin)
 {
 
+    if (pin >= GPIO_AO_DOMAIN_LIMIT)
+        gpio_periph_hold(1u << pin);
     gpio_perif = pin < GPIO_AO_DOMAIN_LIMIT ? gpio_ao_peri : gpio_peri;
     return;
 }
@@ -198,12 +248,7 @@ gpio_result_t gpio_set_mode (gpio_pin_number_t pin, gpio_mode_t mode)
 
     select_gpio_domain(pin);
 
-    if (pin >= 0 && pin < 1*GPIO_MODE_NUM_PINS)
-        gpio_perif->GPIO_MODE0 = bitfield_write(gpio_perif->GPIO_MODE0,
-                                               BIT_MASK_3, 2*pin, mode);
-    else
-        gpio_perif->GPIO_MODE1 = bitfield_write(gpio_perif->GPIO_MODE1,
-                                               BIT_MASK_3, 2*(pin-GPIO_MODE_NUM_PINS), mode);
+    gpio_gpio_mode_mode_set(gpio_perif, pin, mode);
     return GpioOk;
 }
 
@@ -242,6 +287,7 @@ gpio_result_t gpio_reset (gpio_pin_number_t pin)
                                          BIT_MASK_1, pin, GPIO_REMOVE_MASK);
     gpio_intr_dis_all(pin);
     gpio_intr_clear_stat(pin);
+    gpio_periph_drop(1u << pin);
     return GpioOk;
 }
 
@@ -274,6 +320,7 @@ gpio_result_t gpio_reset_all (void)
     gpio_perif->INTRPT_LVL_HIGH_EN0 = 0;
     gpio_perif->INTRPT_LVL_LOW_EN0 = 0;
     gpio_perif->INTRPT_STATUS0 = 0xFFFFFFFF;
+    gpio_periph_drop(~GPIO_PORT_AO_MASK);
 
     gpio_reset_handlers_list( );
 }
@@ -292,8 +339,7 @@ gpio_result_t gpio_toggle (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->GPIO_OUT0 = bitfield_write(gpio_perif->GPIO_OUT0, BIT_MASK_1,
-        pin, !(bitfield_read(gpio_perif->GPIO_OUT0, BIT_MASK_1, pin)));
+    gpio_perif->GPIO_TOGGLE0 = GPIO_PUT_MASK << pin;
     return GpioOk;
 }
 
@@ -302,8 +348,10 @@ gpio_result_t gpio_write (gpio_pin_number_t pin, bool val)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->GPIO_OUT0 = bitfield_write(gpio_perif->GPIO_OUT0,
-        BIT_MASK_1, pin, val);
+    if (val)
+        gpio_perif->GPIO_SET0 = GPIO_PUT_MASK << pin;
+    else
+        gpio_perif->GPIO_CLEAR0 = GPIO_PUT_MASK << pin;
     return GpioOk;
 
 }
@@ -504,8 +552,7 @@ gpio_result_t gpio_intr_clear_stat_rise (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->INTRPT_RISE_STATUS0 = bitfield_write(
-        gpio_perif->INTRPT_RISE_STATUS0, BIT_MASK_1, pin, GPIO_INTR_CLEAR);
+    gpio_perif->INTRPT_RISE_STATUS0 = GPIO_INTR_CLEAR << pin;
     return GpioOk;
 
 }
@@ -515,8 +562,7 @@ gpio_result_t gpio_intr_clear_stat_fall (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->INTRPT_FALL_STATUS0 = bitfield_write(
-        gpio_perif->INTRPT_FALL_STATUS0, BIT_MASK_1, pin, GPIO_INTR_CLEAR);
+    gpio_perif->INTRPT_FALL_STATUS0 = GPIO_INTR_CLEAR << pin;
     return GpioOk;
 }
 
@@ -525,8 +571,7 @@ gpio_result_t gpio_intr_clear_stat_lvl_low (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->INTRPT_LVL_LOW_STATUS0 = bitfield_write(
-        gpio_perif->INTRPT_LVL_LOW_STATUS0, BIT_MASK_1, pin, GPIO_INTR_CLEAR);
+    gpio_perif->INTRPT_LVL_LOW_STATUS0 = GPIO_INTR_CLEAR << pin;
     return GpioOk;
 }
 
@@ -535,8 +580,7 @@ gpio_result_t gpio_intr_clear_stat_lvl_high (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->INTRPT_LVL_HIGH_STATUS0 = bitfield_write(
-        gpio_perif->INTRPT_LVL_HIGH_STATUS0, BIT_MASK_1, pin, GPIO_INTR_CLEAR);
+    gpio_perif->INTRPT_LVL_HIGH_STATUS0 = GPIO_INTR_CLEAR << pin;
     return GpioOk;
 }
 
@@ -545,8 +589,7 @@ gpio_result_t gpio_intr_clear_stat (gpio_pin_number_t pin)
     if (pin > (MAX_PIN-1) || pin < 0)
         return GpioPinNotAcceptable;
     select_gpio_domain(pin);
-    gpio_perif->INTRPT_STATUS0 = bitfield_write(
-        gpio_perif->INTRPT_STATUS0, BIT_MASK_1, pin, GPIO_INTR_CLEAR);
+    gpio_perif->INTRPT_STATUS0 = GPIO_INTR_CLEAR << pin;
     return GpioOk;
 }
 
@@ -557,6 +600,72 @@ void gpio_intr_set_mode (gpio_pin_number_t pin, gpio_intr_general_mode_t mode)
         gpio_perif->CFG, BIT_MASK_1, GPIO_CFG_INTR_MODE_INDEX, mode);
 }
 
+gpio_result_t gpio_port_set (uint32_t mask)
+{
+    if (mask & ~GPIO_PORT_MASK)
+        return GpioPinNotAcceptable;
+    /* The bits of the pins of the other domain are left at 0. */
+    if (mask & GPIO_PORT_AO_MASK)
+        gpio_ao_peri->GPIO_SET0 = mask & GPIO_PORT_AO_MASK;
+    if (mask & ~GPIO_PORT_AO_MASK) {
+        gpio_periph_hold(mask & ~GPIO_PORT_AO_MASK);
+        gpio_peri->GPIO_SET0 = mask & ~GPIO_PORT_AO_MASK;
+    }
+    return GpioOk;
+}
+
+gpio_result_t gpio_port_clear (uint32_t mask)
+{
+    if (mask & ~GPIO_PORT_MASK)
+        return GpioPinNotAcceptable;
+    if (mask & GPIO_PORT_AO_MASK)
+        gpio_ao_peri->GPIO_CLEAR0 = mask & GPIO_PORT_AO_MASK;
+    if (mask & ~GPIO_PORT_AO_MASK) {
+        gpio_periph_hold(mask & ~GPIO_PORT_AO_MASK);
+        gpio_peri->GPIO_CLEAR0 = mask & ~GPIO_PORT_AO_MASK;
+    }
+    return GpioOk;
+}
+
+gpio_result_t gpio_port_toggle (uint32_t mask)
+{
+    if (mask & ~GPIO_PORT_MASK)
+        return GpioPinNotAcceptable;
+    if (mask & GPIO_PORT_AO_MASK)
+        gpio_ao_peri->GPIO_TOGGLE0 = mask & GPIO_PORT_AO_MASK;
+    if (mask & ~GPIO_PORT_AO_MASK) {
+        gpio_periph_hold(mask & ~GPIO_PORT_AO_MASK);
+        gpio_peri->GPIO_TOGGLE0 = mask & ~GPIO_PORT_AO_MASK;
+    }
+    return GpioOk;
+}
+
+gpio_result_t gpio_port_write (uint32_t mask, uint32_t val)
+{
+    if (mask & ~GPIO_PORT_MASK)
+        return GpioPinNotAcceptable;
+    uint32_t m = mask & GPIO_PORT_AO_MASK;
+    if (m)
+        gpio_ao_peri->GPIO_OUT0 = (gpio_ao_peri->GPIO_OUT0 & ~m) | (val & m);
+    m = mask & ~GPIO_PORT_AO_MASK;
+    if (m) {
+        gpio_periph_hold(m);
+        gpio_peri->GPIO_OUT0 = (gpio_peri->GPIO_OUT0 & ~m) | (val & m);
+    }
+    return GpioOk;
+}
+
+gpio_result_t gpio_port_read (uint32_t *val)
+{
+    /* The pins of the peripheral domain not in use are read with the clock
+    held for the access only. */
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+    *val = (gpio_ao_peri->GPIO_IN0 & GPIO_PORT_AO_MASK)
+         | (gpio_peri->GPIO_IN0 & ~GPIO_PORT_AO_MASK & GPIO_PORT_MASK);
+    clock_gate_release(CLOCK_GATE_PERIPH);
+    return GpioOk;
+}
+
 /****************************************************************************/
 /**                                                                        **/
 /*                            LOCAL FUNCTIONS                               */
@@ -197,14 +197,14 @@ gpio_result_t gpio_dis_input_sampling (gpio_pin_number_t pin);
 gpio_result_t gpio_read (gpio_pin_number_t pin, bool *val);
 
 /**
- * @brief toggle a pin. Using masking through GPIO_TOGGLE, and then
- * writing to GPIO_OUT
+ * @brief toggle a pin. Using masking through GPIO_TOGGLE, with a single
+ * write that does not race with the other pins.
  * @param gpio_pin_number_t specify pin number
  */
 gpio_result_t gpio_toggle (gpio_pin_number_t pin);
 
 /**
- * @brief write to a pin. using gpio_set and gpio_clear functions.
+ * @brief write to a pin. using a single write to GPIO_SET or GPIO_CLEAR.
  * @param gpio_pin_number_t specify pin number
  */
 gpio_result_t gpio_write (gpio_pin_number_t pin, bool val);
@@ -349,6 +349,40 @@ gpio_result_t gpio_intr_clear_stat (gpio_pin_number_t pin);
  */
 void gpio_intr_set_mode (gpio_pin_number_t pin, gpio_intr_general_mode_t mode);
 
+/**
+ * @brief set all the pins of a mask, with one write to GPIO_SET in each
+ * domain of the mask (the pins below GPIO_AO_DOMAIN_LIMIT are in the AO one).
+ * @param mask the pins, bit i for pin i.
+ * @return GpioOk, or GpioPinNotAcceptable if the mask has a pin above MAX_PIN.
+ */
+gpio_result_t gpio_port_set (uint32_t mask);
+
+/**
+ * @brief clear all the pins of a mask, with one write to GPIO_CLEAR in each
+ * domain of the mask.
+ */
+gpio_result_t gpio_port_clear (uint32_t mask);
+
+/**
+ * @brief toggle all the pins of a mask, with one write to GPIO_TOGGLE in each
+ * domain of the mask.
+ */
+gpio_result_t gpio_port_toggle (uint32_t mask);
+
+/**
+ * @brief write the pins of a mask at once: each domain of the mask gets one
+ * write to GPIO_OUT, the pins outside the mask keep their value.
+ * @param mask the pins, bit i for pin i.
+ * @param val their values, bit i for pin i.
+ */
+gpio_result_t gpio_port_write (uint32_t mask, uint32_t val);
+
+/**
+ * @brief read all the pins, from GPIO_IN of both domains.
+ * @param val the values, bit i for pin i.
+ */
+gpio_result_t gpio_port_read (uint32_t *val);
+
 #endif  // _GPIO_H_
 /****************************************************************************/
 /**                                                                        **/
@@ -0,0 +1,318 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_capture.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   gpio_capture.c
+* @date   14/10/26
+* @brief  Capture mode of the GPIO driver: the edges of the input pins are
+* timestamped against an rv_timer and batched in a ring.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "gpio_capture.h"
+
+#include "core_v_mini_mcu.h"
+#include "irq.h"
+#include "x-heep.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The pins below this one have a fast interrupt, the others a PLIC one.
+ */
+#define GPIO_CAPTURE_FAST_PIN_N 8
+
+/**
+ * The comparator of the timeout.
+ */
+#define GPIO_CAPTURE_COMP       0
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The interrupt source of the edges of a pin.
+ */
+static uint32_t capture_src( gpio_pin_number_t p_pin );
+
+/**
+ * @brief Stores the edge of a pin.
+ */
+static void capture_edge( gpio_pin_number_t p_pin );
+
+/**
+ * @brief The handlers of the fast and PLIC interrupts of the pins, whose IDs
+ * overlap.
+ */
+static void capture_fast_handler( uint32_t p_id );
+static void capture_plic_handler( uint32_t p_id );
+
+/**
+ * @brief Calls the callback once the timeout of a batch expired.
+ */
+static void capture_timeout_handler( uint32_t p_id );
+
+/**
+ * @brief Stops the timeout and calls the callback.
+ */
+static void capture_notify( gpio_capture_t *p_cap );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           GLOBAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The capture served by the handlers.
+ */
+static gpio_capture_t *capture;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+gpio_result_t gpio_capture_init( gpio_capture_t           *p_cap,
+                                 const gpio_capture_cfg_t *p_cfg )
+{
+    if( p_cfg->events == NULL || p_cfg->events_n == 0
+        || ( p_cfg->events_n & ( p_cfg->events_n - 1 ) ) != 0
+        || p_cfg->batch_n == 0 || p_cfg->batch_n > p_cfg->events_n
+        || p_cfg->timer == NULL )
+    {
+        return GpioError;
+    }
+
+    p_cap->cfg          = *p_cfg;
+    p_cap->head         = 0;
+    p_cap->tail         = 0;
+    p_cap->batch_count  = 0;
+    p_cap->dropped      = 0;
+    capture             = p_cap;
+
+    if( p_cfg->timeout_ticks > 0 )
+    {
+        /* The comparator stays disarmed until the first edge of a batch. */
+        if( rv_timer_arm( p_cfg->timer, p_cfg->hart_id, GPIO_CAPTURE_COMP,
+                          UINT64_MAX ) != kRvTimerOk
+            || rv_timer_irq_clear( p_cfg->timer, p_cfg->hart_id,
+                                   GPIO_CAPTURE_COMP ) != kRvTimerOk
+            || rv_timer_irq_enable( p_cfg->timer, p_cfg->hart_id,
+                                    GPIO_CAPTURE_COMP, kRvTimerEnabled )
+               != kRvTimerOk
+            || irq_register( IRQ_SRC_FAST( p_cfg->timeout_fic ),
+                             capture_timeout_handler ) != IRQ_OK )
+        {
+            return GpioError;
+        }
+        irq_set_enabled( IRQ_SRC_FAST( p_cfg->timeout_fic ), true );
+    }
+    return GpioOk;
+}
+
+gpio_result_t gpio_capture_add_pin( gpio_capture_t    *p_cap,
+                                    gpio_pin_number_t p_pin )
+{
+    (void)p_cap;
+    if( p_pin > ( MAX_PIN - 1 ) )
+    {
+        return GpioPinNotAcceptable;
+    }
+
+    gpio_cfg_t cfg = {
+        .pin                = p_pin,
+        .mode               = GpioModeIn,
+        .en_input_sampling  = true,
+        .en_intr            = true,
+        .intr_type          = GpioIntrEdgeRisingFalling,
+    };
+    gpio_result_t res = gpio_config( cfg );
+    if( res != GpioOk )
+    {
+        return res;
+    }
+
+    uint32_t src = capture_src( p_pin );
+    if( p_pin < GPIO_CAPTURE_FAST_PIN_N )
+    {
+        irq_register( src, capture_fast_handler );
+    }
+    else
+    {
+        irq_register( src, capture_plic_handler );
+        irq_set_priority( src, 1 );
+    }
+    irq_set_enabled( src, true );
+    return GpioOk;
+}
+
+gpio_result_t gpio_capture_remove_pin( gpio_capture_t    *p_cap,
+                                       gpio_pin_number_t p_pin )
+{
+    (void)p_cap;
+    if( p_pin > ( MAX_PIN - 1 ) )
+    {
+        return GpioPinNotAcceptable;
+    }
+
+    uint32_t src = capture_src( p_pin );
+    irq_set_enabled( src, false );
+    gpio_intr_dis_all( p_pin );
+    gpio_intr_clear_stat( p_pin );
+    irq_register( src, NULL );
+    return GpioOk;
+}
+
+size_t gpio_capture_read( gpio_capture_t       *p_cap,
+                          gpio_capture_event_t *p_events,
+                          size_t               p_max )
+{
+    uint32_t tail   = p_cap->tail;
+    uint32_t mask   = p_cap->cfg.events_n - 1;
+    size_t   n      = p_cap->head - tail;
+
+    if( n > p_max )
+    {
+        n = p_max;
+    }
+    for( size_t i = 0; i < n; i++ )
+    {
+        p_events[ i ] = p_cap->cfg.events[ ( tail + i ) & mask ];
+    }
+    /* The slots are only given back to the handlers once copied. */
+    p_cap->tail = tail + n;
+    return n;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static uint32_t capture_src( gpio_pin_number_t p_pin )
+{
+    if( p_pin < GPIO_CAPTURE_FAST_PIN_N )
+    {
+        return IRQ_SRC_FAST( kGpio_0_fic_e + p_pin );
+    }
+    return IRQ_SRC_PLIC( GPIO_INTR_8 + p_pin - GPIO_CAPTURE_FAST_PIN_N );
+}
+
+static void capture_fast_handler( uint32_t p_id )
+{
+    capture_edge( (gpio_pin_number_t)( p_id - kGpio_0_fic_e ) );
+}
+
+static void capture_plic_handler( uint32_t p_id )
+{
+    capture_edge( (gpio_pin_number_t)( p_id - GPIO_INTR_8
+                                       + GPIO_CAPTURE_FAST_PIN_N ) );
+}
+
+static void capture_edge( gpio_pin_number_t p_pin )
+{
+    gpio_capture_t *cap = capture;
+    /* The timestamp first, as close to the edge as possible. */
+    uint32_t time = rv_timer_counter_read32( cap->cfg.timer, cap->cfg.hart_id );
+
+    /* An edge after the clear raises the interrupt again, so the level read
+     * next is never older than the last event. */
+    gpio_intr_clear_stat( p_pin );
+    bool level;
+    gpio_read( p_pin, &level );
+
+    uint32_t head = cap->head;
+    if( head - cap->tail >= cap->cfg.events_n )
+    {
+        cap->dropped++;
+        return;
+    }
+    gpio_capture_event_t *event =
+        &cap->cfg.events[ head & ( cap->cfg.events_n - 1 ) ];
+    event->time  = time;
+    event->pin   = p_pin;
+    event->level = level;
+    cap->head    = head + 1;
+
+    uint32_t count = cap->batch_count + 1;
+    cap->batch_count = count;
+    if( count >= cap->cfg.batch_n )
+    {
+        capture_notify( cap );
+    }
+    else if( count == 1 && cap->cfg.timeout_ticks > 0 )
+    {
+        uint64_t now;
+        rv_timer_counter_read( cap->cfg.timer, cap->cfg.hart_id, &now );
+        rv_timer_arm( cap->cfg.timer, cap->cfg.hart_id, GPIO_CAPTURE_COMP,
+                      now + cap->cfg.timeout_ticks );
+    }
+}
+
+static void capture_timeout_handler( uint32_t p_id )
+{
+    gpio_capture_t *cap = capture;
+
+    rv_timer_irq_clear( cap->cfg.timer, cap->cfg.hart_id, GPIO_CAPTURE_COMP );
+    /* The timer kept it pending until now. */
+    clear_fast_interrupt( (fast_intr_ctrl_fast_interrupt_t)p_id );
+    if( cap->batch_count > 0 )
+    {
+        capture_notify( cap );
+    }
+}
+
+static void capture_notify( gpio_capture_t *p_cap )
+{
+    if( p_cap->cfg.timeout_ticks > 0 )
+    {
+        rv_timer_arm( p_cap->cfg.timer, p_cap->cfg.hart_id, GPIO_CAPTURE_COMP,
+                      UINT64_MAX );
+        rv_timer_irq_clear( p_cap->cfg.timer, p_cap->cfg.hart_id,
+                            GPIO_CAPTURE_COMP );
+        clear_fast_interrupt( p_cap->cfg.timeout_fic );
+    }
+    p_cap->batch_count = 0;
+    if( p_cap->cfg.cb != NULL )
+    {
+        p_cap->cfg.cb( p_cap );
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,181 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_capture.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   gpio_capture.h
+* @date   14/10/26
+* @brief  Capture mode of the GPIO driver: the edges of the input pins are
+* timestamped against an rv_timer and batched in a ring.
+*
+* Each edge (rising and falling) of a captured pin is served by a short
+* handler that reads the timer counter, clears the pin and stores the event.
+* The callback of the application only runs once a batch of events is stored,
+* or when the timeout expires after the first event of a batch, so a burst of
+* edges costs one callback instead of one per edge.
+*
+* Neither the GPIO nor the DMA can timestamp the edges by themselves (the
+* strobe trigger of the DMA, see gpio_parallel.h, only moves the data pins on
+* an edge), so the handler runs on each edge. An edge
+* arriving on a pin before the handler cleared the previous one is merged
+* with it: the ring makes the handler short enough to keep up with bursts.
+*
+* The timeout uses comparator 0 of the hart of the timer, whose interrupt is
+* a fast interrupt: kTimer_1_fic_e for the hart 1 of the AO timer,
+* kTimer_2_fic_e and kTimer_3_fic_e for the harts 0 and 1 of the other one.
+* The application has to:
+* - call gpio_capture_init after plic_Init, with the counter of the hart
+*   running;
+* - enable the machine interrupts (mstatus.MIE).
+* Only one capture can be used at a time.
+*/
+
+#ifndef _GPIO_CAPTURE_H_
+#define _GPIO_CAPTURE_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio.h"
+#include "rv_timer.h"
+#include "fast_intr_ctrl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A captured edge.
+ */
+typedef struct
+{
+    uint32_t          time;     /*!< Lower 32 bits of the timer counter. */
+    gpio_pin_number_t pin;
+    uint8_t           level;    /*!< Level of the pin after the edge. */
+} gpio_capture_event_t;
+
+typedef struct gpio_capture gpio_capture_t;
+
+/**
+ * Called from the interrupts when a batch is stored or the timeout expired.
+ */
+typedef void (*gpio_capture_cb_t)( gpio_capture_t *p_cap );
+
+/**
+ * The configuration of a capture.
+ */
+typedef struct
+{
+    gpio_capture_event_t *events;   /*!< The ring of events. */
+    uint32_t          events_n;     /*!< Size of the ring, a power of 2. */
+    uint32_t          batch_n;      /*!< Events per callback, at most events_n. */
+    uint32_t          timeout_ticks;/*!< Timer ticks from the first event of a
+    batch to the callback, 0 to only call it when the batch is full. */
+    const rv_timer_t  *timer;       /*!< The timer of the timestamps. */
+    uint32_t          hart_id;      /*!< The hart of the timer. */
+    fast_intr_ctrl_fast_interrupt_t timeout_fic; /*!< Fast interrupt of the
+    hart, unused without timeout. */
+    gpio_capture_cb_t cb;           /*!< The callback. */
+} gpio_capture_cfg_t;
+
+/**
+ * A capture. Its fields are managed by the functions below.
+ */
+struct gpio_capture
+{
+    gpio_capture_cfg_t cfg;
+    volatile uint32_t  head;        /*!< Moved by the handlers only. */
+    volatile uint32_t  tail;        /*!< Moved by gpio_capture_read only. */
+    volatile uint32_t  batch_count; /*!< Events since the last callback. */
+    volatile uint32_t  dropped;     /*!< Edges lost with the ring full. */
+};
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes a capture, without pins, and enables its timeout
+ * interrupt.
+ * @param p_cap The capture.
+ * @param p_cfg Its configuration, copied.
+ * @return GpioOk, or GpioError if the configuration is not valid.
+ */
+gpio_result_t gpio_capture_init( gpio_capture_t           *p_cap,
+                                 const gpio_capture_cfg_t *p_cfg );
+
+/**
+ * @brief Configures a pin as an input and captures its edges. The pins 0 to 7
+ * use their fast interrupt, the others the PLIC, with priority 1.
+ * @param p_cap The capture.
+ * @param p_pin The pin.
+ * @return GpioOk, or GpioPinNotAcceptable.
+ */
+gpio_result_t gpio_capture_add_pin( gpio_capture_t    *p_cap,
+                                    gpio_pin_number_t p_pin );
+
+/**
+ * @brief Stops capturing the edges of a pin and restores its handler.
+ * @return GpioOk, or GpioPinNotAcceptable.
+ */
+gpio_result_t gpio_capture_remove_pin( gpio_capture_t    *p_cap,
+                                       gpio_pin_number_t p_pin );
+
+/**
+ * @brief Copies the oldest events out of the ring, without waiting.
+ * @return The number of events copied, at most p_max.
+ */
+size_t gpio_capture_read( gpio_capture_t       *p_cap,
+                          gpio_capture_event_t *p_events,
+                          size_t               p_max );
+
+/**
+ * @brief Returns the number of events waiting to be read.
+ */
+static inline size_t gpio_capture_available( const gpio_capture_t *p_cap )
+{
+    return p_cap->head - p_cap->tail;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _GPIO_CAPTURE_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,134 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_parallel.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   gpio_parallel.c
+* @date   14/10/26
+* @brief  Parallel capture of the GPIO driver: on each edge of a strobe pin, a
+* DMA channel reads the data pins from GPIO_IN into a buffer, without the CPU.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "gpio_parallel.h"
+
+#include "core_v_mini_mcu.h"
+#include "gpio_regs.h"  // Generated.
+#include "x-heep.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+gpio_result_t gpio_parallel_start( gpio_parallel_t      *p_par,
+                                   void                 *p_buf,
+                                   uint32_t             p_n,
+                                   gpio_pin_number_t    p_data,
+                                   uint8_t              p_width,
+                                   gpio_pin_number_t    p_strobe,
+                                   gpio_parallel_edge_t p_edges,
+                                   uint8_t              p_ch )
+{
+    dma_data_type_t type;
+    if( p_width == 8 )
+    {
+        type = DMA_DATA_TYPE_BYTE;
+    }
+    else if( p_width == 16 )
+    {
+        type = DMA_DATA_TYPE_HALF_WORD;
+    }
+    else
+    {
+        return GpioPinNotAcceptable;
+    }
+
+    /* The data are one lane of GPIO_IN, all in the same domain. */
+    uintptr_t base = p_data < GPIO_AO_DOMAIN_LIMIT ? GPIO_AO_START_ADDRESS
+                                                   : GPIO_START_ADDRESS;
+    if(     p_data % p_width != 0
+        ||  p_data + p_width > MAX_PIN
+        ||  ( p_data < GPIO_AO_DOMAIN_LIMIT ) != ( p_data + p_width <= GPIO_AO_DOMAIN_LIMIT )
+        ||  p_strobe >= MAX_PIN )
+    {
+        return GpioPinNotAcceptable;
+    }
+
+    p_par->src.env          = NULL;
+    p_par->src.ptr          = (uint8_t*)( base + GPIO_GPIO_IN_REG_OFFSET + p_data / 8 );
+    p_par->src.inc_du       = 0;
+    p_par->src.size_du      = p_n;
+    p_par->src.stride_d2_du = 0;
+    p_par->src.type         = type;
+    p_par->src.trig         = DMA_TRIG_SLOT_GPIO_STROBE;
+    p_par->dst.env          = NULL;
+    p_par->dst.ptr          = (uint8_t*) p_buf;
+    p_par->dst.inc_du       = 1;
+    p_par->dst.size_du      = 0;
+    p_par->dst.stride_d2_du = 0;
+    p_par->dst.type         = type;
+    p_par->dst.trig         = DMA_TRIG_MEMORY;
+
+    p_par->trans = (dma_trans_t){
+        .src        = &p_par->src,
+        .dst        = &p_par->dst,
+        .src_addr   = NULL,
+        .mode       = DMA_TRANS_MODE_SINGLE,
+        .win_du     = 0,
+        .end        = DMA_TRANS_END_POLLING,
+        .channel    = p_ch,
+        .strobe     = DMA_STROBE( p_strobe, p_edges ),
+    };
+
+    /* The source does not move, integrity checks would reject it. */
+    dma_config_flags_t flags;
+    flags  = dma_validate_transaction( &p_par->trans,
+                                       DMA_DO_NOT_ENABLE_REALIGN,
+                                       DMA_PERFORM_CHECKS_ONLY_SANITY );
+    if(     ( flags & DMA_CONFIG_CRITICAL_ERROR )
+        ||  dma_load_transaction( &p_par->trans ) != DMA_CONFIG_OK
+        ||  dma_launch( &p_par->trans ) != DMA_CONFIG_OK )
+    {
+        return GpioError;
+    }
+    return GpioOk;
+}
+
+bool gpio_parallel_is_done( const gpio_parallel_t *p_par )
+{
+    return dma_is_ready( p_par->trans.channel ) != 0;
+}
+
+uint32_t gpio_parallel_missed( const gpio_parallel_t *p_par )
+{
+    return dma_get_strobe_missed( p_par->trans.channel );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
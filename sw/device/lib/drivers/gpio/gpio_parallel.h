@@ -0,0 +1,143 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_parallel.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   gpio_parallel.h
+* @date   14/10/26
+* @brief  Parallel capture of the GPIO driver: on each edge of a strobe pin, a
+* DMA channel reads the data pins from GPIO_IN into a buffer, without the CPU,
+* e.g. for a camera or an ADC with a parallel bus.
+*
+* The strobe can be any GPIO: the DMA samples the pads of both domains itself
+* (trigger slot DMA_TRIG_SLOT_GPIO_STROBE). The data are 8 or 16 pins of one
+* domain, starting at a multiple of their width, read with a byte or a half
+* word access to GPIO_IN: pins 0 to 7 in the AO domain, pins 8 to 15, 16 to 23,
+* 24 to 31 or 16 to 31 in the peripheral one.
+*
+* The data are read a few cycles after the edge (two to synchronize the
+* strobe, then the bus), so the source has to hold them for about ten cycles
+* after its edge. An edge arriving before the data of the previous one were
+* read is missed: the buffer gets one sample less and gpio_parallel_missed
+* counts it.
+*
+* The data pins have to be configured as inputs with the input sampling
+* enabled, and the application has to call dma_init before
+* gpio_parallel_start.
+*/
+
+#ifndef _GPIO_PARALLEL_H_
+#define _GPIO_PARALLEL_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio.h"
+#include "dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The edges of the strobe that carry a sample.
+ */
+typedef enum
+{
+    GpioParallelRise = DMA_STROBE_RISE,                     /*!< Rising. */
+    GpioParallelFall = DMA_STROBE_FALL,                     /*!< Falling. */
+    GpioParallelBoth = DMA_STROBE_RISE | DMA_STROBE_FALL,   /*!< Both, e.g.
+    for a double data rate source. */
+} gpio_parallel_edge_t;
+
+/**
+ * A parallel capture. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    dma_target_t src;     /*!< GPIO_IN of the domain of the data pins. */
+    dma_target_t dst;     /*!< The buffer. */
+    dma_trans_t  trans;
+} gpio_parallel_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts capturing p_n samples of the data pins, one per edge of the
+ * strobe.
+ * @param p_par The capture, it must stay in memory until it is done.
+ * @param p_buf The samples, of bytes or of half words (aligned) as the width
+ * of the data. It must stay in memory until the capture is done.
+ * @param p_n The number of samples.
+ * @param p_data The first data pin, a multiple of p_width.
+ * @param p_width The number of data pins, 8 or 16.
+ * @param p_strobe The strobe pin.
+ * @param p_edges The edges of the strobe that carry a sample.
+ * @param p_ch The DMA channel.
+ * @return GpioOk, GpioPinNotAcceptable if the data pins are not one byte or
+ * half word of a domain or the strobe is above MAX_PIN, or GpioError if the
+ * DMA refused the transaction.
+ */
+gpio_result_t gpio_parallel_start( gpio_parallel_t      *p_par,
+                                   void                 *p_buf,
+                                   uint32_t             p_n,
+                                   gpio_pin_number_t    p_data,
+                                   uint8_t              p_width,
+                                   gpio_pin_number_t    p_strobe,
+                                   gpio_parallel_edge_t p_edges,
+                                   uint8_t              p_ch );
+
+/**
+ * @brief Returns true once the last sample of a capture has been written.
+ */
+bool gpio_parallel_is_done( const gpio_parallel_t *p_par );
+
+/**
+ * @brief Returns the number of edges of the strobe missed since the start of
+ * a capture.
+ */
+uint32_t gpio_parallel_missed( const gpio_parallel_t *p_par );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _GPIO_PARALLEL_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,141 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_wave.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   gpio_wave.c
+* @date   14/10/26
+* @brief  Waveform output of the GPIO driver: a DMA channel writes a buffer of
+* samples to the GPIOs at a fixed rate, without the CPU.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "gpio_wave.h"
+
+#include "core_v_mini_mcu.h"
+#include "gpio_regs.h"  // Generated.
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The pins of the AO domain in a mask.
+ */
+#define GPIO_WAVE_AO_MASK   ( ( 1u << GPIO_AO_DOMAIN_LIMIT ) - 1 )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void gpio_wave_encode( const uint32_t *p_levels,
+                       uint32_t       *p_samples,
+                       uint32_t       p_n,
+                       uint32_t       p_mask,
+                       uint32_t       p_initial )
+{
+    uint32_t prev = p_initial;
+    for( uint32_t i = 0; i < p_n; i++ )
+    {
+        uint32_t level  = p_levels[ i ];
+        p_samples[ i ]  = ( level ^ prev ) & p_mask;
+        prev            = level;
+    }
+}
+
+gpio_result_t gpio_wave_start( gpio_wave_t    *p_wave,
+                               const uint32_t *p_samples,
+                               uint32_t       p_n,
+                               uint32_t       p_mask,
+                               uint16_t       p_pace,
+                               uint8_t        p_ch )
+{
+    uintptr_t base;
+    if( ( p_mask & ~GPIO_WAVE_AO_MASK ) == 0 )
+    {
+        base = GPIO_AO_START_ADDRESS;
+    }
+    else if( ( p_mask & GPIO_WAVE_AO_MASK ) == 0 )
+    {
+        base = GPIO_START_ADDRESS;
+    }
+    else
+    {
+        return GpioPinNotAcceptable;
+    }
+
+    p_wave->src.env          = NULL;
+    p_wave->src.ptr          = (uint8_t*) p_samples;
+    p_wave->src.inc_du       = 1;
+    p_wave->src.size_du      = p_n;
+    p_wave->src.stride_d2_du = 0;
+    p_wave->src.type         = DMA_DATA_TYPE_WORD;
+    p_wave->src.trig         = DMA_TRIG_MEMORY;
+    p_wave->dst.env          = NULL;
+    p_wave->dst.ptr          = (uint8_t*)( base + GPIO_GPIO_TOGGLE_REG_OFFSET );
+    p_wave->dst.inc_du       = 0;
+    p_wave->dst.size_du      = 0;
+    p_wave->dst.stride_d2_du = 0;
+    p_wave->dst.type         = DMA_DATA_TYPE_WORD;
+    p_wave->dst.trig         = DMA_TRIG_MEMORY;
+
+    p_wave->trans = (dma_trans_t){
+        .src        = &p_wave->src,
+        .dst        = &p_wave->dst,
+        .src_addr   = NULL,
+        .mode       = DMA_TRANS_MODE_SINGLE,
+        .win_du     = 0,
+        .end        = DMA_TRANS_END_POLLING,
+        .channel    = p_ch,
+        .pace       = p_pace,
+    };
+
+    /* The destination does not move, integrity checks would reject it. */
+    dma_config_flags_t flags;
+    flags  = dma_validate_transaction( &p_wave->trans,
+                                       DMA_DO_NOT_ENABLE_REALIGN,
+                                       DMA_PERFORM_CHECKS_ONLY_SANITY );
+    if(     ( flags & DMA_CONFIG_CRITICAL_ERROR )
+        ||  dma_load_transaction( &p_wave->trans ) != DMA_CONFIG_OK
+        ||  dma_launch( &p_wave->trans ) != DMA_CONFIG_OK )
+    {
+        return GpioError;
+    }
+    return GpioOk;
+}
+
+bool gpio_wave_is_done( const gpio_wave_t *p_wave )
+{
+    return dma_is_ready( p_wave->trans.channel ) != 0;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,133 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : gpio_wave.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   gpio_wave.h
+* @date   14/10/26
+* @brief  Waveform output of the GPIO driver: a DMA channel writes a buffer of
+* samples to the GPIOs at a fixed rate, without the CPU.
+*
+* Each sample is the word written to GPIO_TOGGLE of one domain: it toggles
+* the pins of its set bits, so the pins outside the waveform keep their value
+* and can still be driven by the CPU. gpio_wave_encode turns a buffer of
+* levels into such samples.
+*
+* The DMA has no trigger from the timers, so the rate is set by the pacing of
+* the DMA channel: one sample every pace clock cycles. The bus adds no jitter
+* as long as pace is larger than the latency of a write to the GPIOs, and the
+* other masters leave the bus to the DMA.
+*
+* The application has to call dma_init before gpio_wave_start.
+*/
+
+#ifndef _GPIO_WAVE_H_
+#define _GPIO_WAVE_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio.h"
+#include "dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A waveform output. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    dma_target_t src;     /*!< The samples. */
+    dma_target_t dst;     /*!< GPIO_TOGGLE of the domain of the pins. */
+    dma_trans_t  trans;
+} gpio_wave_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Turns levels into the samples of gpio_wave_start. It can work in
+ * place.
+ * @param p_levels The levels of the pins after each sample, bit i for pin i.
+ * @param p_samples The samples, p_n words.
+ * @param p_n The number of samples.
+ * @param p_mask The pins of the waveform, all in the same domain.
+ * @param p_initial The levels of the pins before the first sample, e.g. from
+ * GPIO_OUT.
+ */
+void gpio_wave_encode( const uint32_t *p_levels,
+                       uint32_t       *p_samples,
+                       uint32_t       p_n,
+                       uint32_t       p_mask,
+                       uint32_t       p_initial );
+
+/**
+ * @brief Starts writing samples to the GPIOs, one every p_pace cycles. The
+ * pins have to be configured as outputs.
+ * @param p_wave The waveform, it must stay in memory until it is done.
+ * @param p_samples The samples, from gpio_wave_encode, word aligned. They
+ * must stay in memory until the waveform is done.
+ * @param p_n The number of samples.
+ * @param p_mask The pins of the waveform, all in the AO domain (below
+ * GPIO_AO_DOMAIN_LIMIT) or all in the peripheral one.
+ * @param p_pace The clock cycles between two samples.
+ * @param p_ch The DMA channel.
+ * @return GpioOk, GpioPinNotAcceptable if the pins are in both domains, or
+ * GpioError if the DMA refused the transaction.
+ */
+gpio_result_t gpio_wave_start( gpio_wave_t    *p_wave,
+                               const uint32_t *p_samples,
+                               uint32_t       p_n,
+                               uint32_t       p_mask,
+                               uint16_t       p_pace,
+                               uint8_t        p_ch );
+
+/**
+ * @brief Returns true once the last sample of a waveform has been written.
+ */
+bool gpio_wave_is_done( const gpio_wave_t *p_wave );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _GPIO_WAVE_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
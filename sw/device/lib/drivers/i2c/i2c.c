@@ -6,6 +6,27 @@
 
 #include "bitfield.h"
 #include "i2c_regs.h"  // Generated
+#include "clock_gate.h"
+
+/**
+ * Register accesses, with the clock of the I2C enabled (clock_gate.h). The
+ * host holds one more reference while it is enabled, so that the clock stays
+ * on between the accesses of a transfer.
+ */
+static uint32_t i2c_read32(const i2c_t *i2c, ptrdiff_t offset) {
+  uint32_t domain = clock_gate_domain_of((uintptr_t)i2c->params.base_addr.base);
+  clock_gate_acquire(domain);
+  uint32_t value = mmio_region_read32(i2c->params.base_addr, offset);
+  clock_gate_release(domain);
+  return value;
+}
+
+static void i2c_write32(const i2c_t *i2c, ptrdiff_t offset, uint32_t value) {
+  uint32_t domain = clock_gate_domain_of((uintptr_t)i2c->params.base_addr.base);
+  clock_gate_acquire(domain);
+  mmio_region_write32(i2c->params.base_addr, offset, value);
+  clock_gate_release(domain);
+}
 
 /**
  * Performs a 32-bit integer unsigned division, rounding up. The bottom
@@ -146,35 +167,35 @@ i2c_result_t i2c_configure(const i2c_t *i2c,
                                    config.scl_time_high_cycles);
   timing0 = bitfield_field32_write(timing0, I2C_TIMING0_TLOW_FIELD,
                                    config.scl_time_low_cycles);
-  mmio_region_write32(i2c->params.base_addr, I2C_TIMING0_REG_OFFSET, timing0);
+  i2c_write32(i2c, I2C_TIMING0_REG_OFFSET, timing0);
 
   uint32_t timing1 = 0;
   timing1 = bitfield_field32_write(timing1, I2C_TIMING1_T_R_FIELD,
                                    config.rise_cycles);
   timing1 = bitfield_field32_write(timing1, I2C_TIMING1_T_F_FIELD,
                                    config.fall_cycles);
-  mmio_region_write32(i2c->params.base_addr, I2C_TIMING1_REG_OFFSET, timing1);
+  i2c_write32(i2c, I2C_TIMING1_REG_OFFSET, timing1);
 
   uint32_t timing2 = 0;
   timing2 = bitfield_field32_write(timing2, I2C_TIMING2_TSU_STA_FIELD,
                                    config.start_signal_setup_cycles);
   timing2 = bitfield_field32_write(timing2, I2C_TIMING2_THD_STA_FIELD,
                                    config.start_signal_hold_cycles);
-  mmio_region_write32(i2c->params.base_addr, I2C_TIMING2_REG_OFFSET, timing2);
+  i2c_write32(i2c, I2C_TIMING2_REG_OFFSET, timing2);
 
   uint32_t timing3 = 0;
   timing3 = bitfield_field32_write(timing3, I2C_TIMING3_TSU_DAT_FIELD,
                                    config.data_signal_setup_cycles);
   timing3 = bitfield_field32_write(timing3, I2C_TIMING3_THD_DAT_FIELD,
                                    config.data_signal_hold_cycles);
-  mmio_region_write32(i2c->params.base_addr, I2C_TIMING3_REG_OFFSET, timing3);
+  i2c_write32(i2c, I2C_TIMING3_REG_OFFSET, timing3);
 
   uint32_t timing4 = 0;
   timing4 = bitfield_field32_write(timing4, I2C_TIMING4_TSU_STO_FIELD,
                                    config.stop_signal_setup_cycles);
   timing4 = bitfield_field32_write(timing4, I2C_TIMING4_T_BUF_FIELD,
                                    config.stop_signal_hold_cycles);
-  mmio_region_write32(i2c->params.base_addr, I2C_TIMING4_REG_OFFSET, timing4);
+  i2c_write32(i2c, I2C_TIMING4_REG_OFFSET, timing4);
 
   return kDifI2cOk;
 }
@@ -184,10 +205,9 @@ i2c_result_t i2c_reset_rx_fifo(const i2c_t *i2c) {
     return kDifI2cBadArg;
   }
 
-  uint32_t reg =
-      mmio_region_read32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_FIFO_CTRL_REG_OFFSET);
   reg = bitfield_bit32_write(reg, I2C_FIFO_CTRL_RXRST_BIT, true);
-  mmio_region_write32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_FIFO_CTRL_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -197,10 +217,9 @@ i2c_result_t i2c_reset_fmt_fifo(const i2c_t *i2c) {
     return kDifI2cBadArg;
   }
 
-  uint32_t reg =
-      mmio_region_read32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_FIFO_CTRL_REG_OFFSET);
   reg = bitfield_bit32_write(reg, I2C_FIFO_CTRL_FMTRST_BIT, true);
-  mmio_region_write32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_FIFO_CTRL_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -251,14 +270,12 @@ i2c_result_t i2c_set_watermarks(const i2c_t *i2c,
       return kDifI2cBadArg;
   }
 
-  uint32_t ctrl_value =
-      mmio_region_read32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET);
+  uint32_t ctrl_value = i2c_read32(i2c, I2C_FIFO_CTRL_REG_OFFSET);
   ctrl_value = bitfield_field32_write(ctrl_value, I2C_FIFO_CTRL_RXILVL_FIELD,
                                       rx_level_value);
   ctrl_value = bitfield_field32_write(ctrl_value, I2C_FIFO_CTRL_FMTILVL_FIELD,
                                       fmt_level_value);
-  mmio_region_write32(i2c->params.base_addr, I2C_FIFO_CTRL_REG_OFFSET,
-                      ctrl_value);
+  i2c_write32(i2c, I2C_FIFO_CTRL_REG_OFFSET, ctrl_value);
 
   return kDifI2cOk;
 }
@@ -292,6 +309,9 @@ static bool irq_index(i2c_irq_t irq, bitfield_bit32_index_t *bit_index) {
     case kDifI2cIrqSdaUnstable:
       *bit_index = I2C_INTR_COMMON_SDA_UNSTABLE_BIT;
       break;
+    case kDifI2cIrqTransComplete:
+      *bit_index = I2C_INTR_COMMON_TRANS_COMPLETE_BIT;
+      break;
     default:
       return false;
   }
@@ -309,8 +329,7 @@ i2c_result_t i2c_irq_is_pending(const i2c_t *i2c, i2c_irq_t irq,
     return kDifI2cBadArg;
   }
 
-  uint32_t reg =
-      mmio_region_read32(i2c->params.base_addr, I2C_INTR_STATE_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_INTR_STATE_REG_OFFSET);
   *is_pending = bitfield_bit32_read(reg, index);
 
   return kDifI2cOk;
@@ -328,7 +347,7 @@ i2c_result_t i2c_irq_acknowledge(const i2c_t *i2c,
   }
 
   uint32_t reg = bitfield_bit32_write(0, index, true);
-  mmio_region_write32(i2c->params.base_addr, I2C_INTR_STATE_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_INTR_STATE_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -345,8 +364,7 @@ i2c_result_t i2c_irq_get_enabled(const i2c_t *i2c,
     return kDifI2cBadArg;
   }
 
-  uint32_t reg =
-      mmio_region_read32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_INTR_ENABLE_REG_OFFSET);
   bool is_enabled = bitfield_bit32_read(reg, index);
   *state = is_enabled ? kDifI2cToggleEnabled : kDifI2cToggleDisabled;
 
@@ -377,10 +395,9 @@ i2c_result_t i2c_irq_set_enabled(const i2c_t *i2c,
       return kDifI2cBadArg;
   }
 
-  uint32_t reg =
-      mmio_region_read32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_INTR_ENABLE_REG_OFFSET);
   reg = bitfield_bit32_write(reg, index, flag);
-  mmio_region_write32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_INTR_ENABLE_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -396,7 +413,7 @@ i2c_result_t i2c_irq_force(const i2c_t *i2c, i2c_irq_t irq) {
   }
 
   uint32_t reg = bitfield_bit32_write(0, index, true);
-  mmio_region_write32(i2c->params.base_addr, I2C_INTR_TEST_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_INTR_TEST_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -408,11 +425,10 @@ i2c_result_t i2c_irq_disable_all(const i2c_t *i2c,
   }
 
   if (snapshot != NULL) {
-    *snapshot =
-        mmio_region_read32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET);
+    *snapshot = i2c_read32(i2c, I2C_INTR_ENABLE_REG_OFFSET);
   }
 
-  mmio_region_write32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET, 0);
+  i2c_write32(i2c, I2C_INTR_ENABLE_REG_OFFSET, 0);
 
   return kDifI2cOk;
 }
@@ -423,8 +439,7 @@ i2c_result_t i2c_irq_restore_all(
     return kDifI2cBadArg;
   }
 
-  mmio_region_write32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET,
-                      *snapshot);
+  i2c_write32(i2c, I2C_INTR_ENABLE_REG_OFFSET, *snapshot);
 
   return kDifI2cOk;
 }
@@ -447,9 +462,18 @@ i2c_result_t i2c_host_set_enabled(const i2c_t *i2c,
       return kDifI2cBadArg;
   }
 
-  uint32_t reg = mmio_region_read32(i2c->params.base_addr, I2C_CTRL_REG_OFFSET);
+  uint32_t domain = clock_gate_domain_of((uintptr_t)i2c->params.base_addr.base);
+  clock_gate_acquire(domain);
+  uint32_t reg = i2c_read32(i2c, I2C_CTRL_REG_OFFSET);
+  bool was_enabled = bitfield_bit32_read(reg, I2C_CTRL_ENABLEHOST_BIT);
   reg = bitfield_bit32_write(reg, I2C_CTRL_ENABLEHOST_BIT, flag);
-  mmio_region_write32(i2c->params.base_addr, I2C_CTRL_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_CTRL_REG_OFFSET, reg);
+  if (!flag && was_enabled) {
+    clock_gate_release(domain);
+  }
+  if (!flag || was_enabled) {
+    clock_gate_release(domain);
+  }
 
   return kDifI2cOk;
 }
@@ -472,9 +496,9 @@ i2c_result_t i2c_override_set_enabled(const i2c_t *i2c,
       return kDifI2cBadArg;
   }
 
-  uint32_t reg = mmio_region_read32(i2c->params.base_addr, I2C_OVRD_REG_OFFSET);
+  uint32_t reg = i2c_read32(i2c, I2C_OVRD_REG_OFFSET);
   reg = bitfield_bit32_write(reg, I2C_OVRD_TXOVRDEN_BIT, flag);
-  mmio_region_write32(i2c->params.base_addr, I2C_OVRD_REG_OFFSET, reg);
+  i2c_write32(i2c, I2C_OVRD_REG_OFFSET, reg);
 
   return kDifI2cOk;
 }
@@ -485,11 +509,10 @@ i2c_result_t i2c_override_drive_pins(const i2c_t *i2c, bool scl,
     return kDifI2cBadArg;
   }
 
-  uint32_t override_val =
-      mmio_region_read32(i2c->params.base_addr, I2C_OVRD_REG_OFFSET);
+  uint32_t override_val = i2c_read32(i2c, I2C_OVRD_REG_OFFSET);
   override_val = bitfield_bit32_write(override_val, I2C_OVRD_SCLVAL_BIT, scl);
   override_val = bitfield_bit32_write(override_val, I2C_OVRD_SDAVAL_BIT, sda);
-  mmio_region_write32(i2c->params.base_addr, I2C_OVRD_REG_OFFSET, override_val);
+  i2c_write32(i2c, I2C_OVRD_REG_OFFSET, override_val);
 
   return kDifI2cOk;
 }
@@ -501,8 +524,7 @@ i2c_result_t i2c_override_sample_pins(const i2c_t *i2c,
     return kDifI2cBadArg;
   }
 
-  uint32_t samples =
-      mmio_region_read32(i2c->params.base_addr, I2C_VAL_REG_OFFSET);
+  uint32_t samples = i2c_read32(i2c, I2C_VAL_REG_OFFSET);
   if (scl_samples != NULL) {
     *scl_samples = bitfield_field32_read(samples, I2C_VAL_SCL_RX_FIELD);
   }
@@ -521,8 +543,7 @@ i2c_result_t i2c_get_fifo_levels(const i2c_t *i2c,
     return kDifI2cBadArg;
   }
 
-  uint32_t values =
-      mmio_region_read32(i2c->params.base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+  uint32_t values = i2c_read32(i2c, I2C_FIFO_STATUS_REG_OFFSET);
   if (fmt_fifo_level != NULL) {
     *fmt_fifo_level =
         bitfield_field32_read(values, I2C_FIFO_STATUS_FMTLVL_FIELD);
@@ -539,8 +560,7 @@ i2c_result_t i2c_read_byte(const i2c_t *i2c, uint8_t *byte) {
     return kDifI2cBadArg;
   }
 
-  uint32_t values =
-      mmio_region_read32(i2c->params.base_addr, I2C_RDATA_REG_OFFSET);
+  uint32_t values = i2c_read32(i2c, I2C_RDATA_REG_OFFSET);
   if (byte != NULL) {
     *byte = bitfield_field32_read(values, I2C_RDATA_RDATA_FIELD);
   }
@@ -554,12 +574,15 @@ i2c_result_t i2c_write_byte_raw(const i2c_t *i2c, uint8_t byte,
     return kDifI2cBadArg;
   }
   // Validate that "write only" flags and "read only" flags are not set
-  // simultaneously.
-  bool has_write_flags = flags.start || flags.stop || flags.suppress_nak_irq;
+  // simultaneously. A stop may end a read, but not a continued one.
+  bool has_write_flags = flags.start || flags.suppress_nak_irq;
   bool has_read_flags = flags.read || flags.read_cont;
   if (has_write_flags && has_read_flags) {
     return kDifI2cBadArg;
   }
+  if (flags.stop && flags.read_cont) {
+    return kDifI2cBadArg;
+  }
   // Also, read_cont requires read.
   if (flags.read_cont && !flags.read) {
     return kDifI2cBadArg;
@@ -574,7 +597,7 @@ i2c_result_t i2c_write_byte_raw(const i2c_t *i2c, uint8_t byte,
       bitfield_bit32_write(fmt_byte, I2C_FDATA_RCONT_BIT, flags.read_cont);
   fmt_byte = bitfield_bit32_write(fmt_byte, I2C_FDATA_NAKOK_BIT,
                                   flags.suppress_nak_irq);
-  mmio_region_write32(i2c->params.base_addr, I2C_FDATA_REG_OFFSET, fmt_byte);
+  i2c_write32(i2c, I2C_FDATA_REG_OFFSET, fmt_byte);
 
   return kDifI2cOk;
 }
@@ -626,6 +649,25 @@ i2c_result_t i2c_write_byte(const i2c_t *i2c, uint8_t byte,
   return i2c_write_byte_raw(i2c, byte, flags);
 }
 
+void i2c_clock_notifier(soc_clock_event_t event, uint32_t old_hz,
+                        uint32_t new_hz, void *ctx) {
+  i2c_clock_t *clock = ctx;
+  i2c_config_t config;
+
+  if (event != kSocClockPostChange_e || new_hz == old_hz || new_hz == 0) {
+    return;
+  }
+
+  clock->timing.clock_period_nanos = 1000000000 / new_hz;
+  if (clock->timing.clock_period_nanos == 0) {
+    clock->timing.clock_period_nanos = 1;
+  }
+
+  if (i2c_compute_timing(clock->timing, &config) == kDifI2cOk) {
+    i2c_configure(clock->i2c, config);
+  }
+}
+
 __attribute__((weak, optimize("O0"))) void handler_irq_i2c(uint32_t id)
 {
  // Replace this function with a non-weak implementation
@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include "mmio.h"
+#include "soc_ctrl_clock.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -214,6 +215,10 @@ typedef enum i2c_irq {
    * Fired when the target does not maintain a stable SDA line.
    */
   kDifI2cIrqSdaUnstable,
+  /**
+   * Fired when the host has sent a stop signal, ending a transaction.
+   */
+  kDifI2cIrqTransComplete,
 } i2c_irq_t;
 
 /**
@@ -501,7 +506,8 @@ i2c_result_t i2c_set_watermarks(const i2c_t *i2c,
 /**
  * Enables or disables the "Host I2C" functionality, effectively turning the
  * I2C device on or off. This function should be called to enable the device
- * once timings, interrupts, and watermarks are all configured.
+ * once timings, interrupts, and watermarks are all configured. The host
+ * holds the clock of the I2C (clock_gate.h) while it is enabled.
  *
  * @param i2c An I2C handle.
  * @param state The new toggle state for the host functionality.
@@ -603,6 +609,28 @@ i2c_result_t i2c_write_byte_raw(const i2c_t *i2c, uint8_t byte,
 i2c_result_t i2c_write_byte(const i2c_t *i2c, uint8_t byte,
                                     i2c_fmt_t code, bool suppress_nak_irq);
 
+/**
+ * An I2C kept at the same bus timing across the changes of the system clock,
+ * see `i2c_clock_notifier()`.
+ */
+typedef struct i2c_clock {
+  const i2c_t *i2c;
+  /**
+   * The timing requirements of the bus, its `clock_period_nanos` is updated
+   * by the notifier.
+   */
+  i2c_timing_config_t timing;
+} i2c_clock_t;
+
+/**
+ * soc_clock notifier (soc_ctrl_clock.h) of an I2C, ctx is an i2c_clock_t:
+ * after the change of the system clock, it recomputes the timing parameters
+ * for the new clock period and reconfigures the I2C. The period is rounded
+ * down, so the bus is never faster than requested. The clock must not change
+ * during a transfer.
+ */
+void i2c_clock_notifier(soc_clock_event_t event, uint32_t old_hz,
+                        uint32_t new_hz, void *ctx);
 
 /**
  * @brief Attends the plic interrupt.
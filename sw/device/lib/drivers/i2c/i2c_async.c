@@ -0,0 +1,577 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : i2c_async.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   i2c_async.c
+* @date   14/10/26
+* @brief  Interrupt-driven I2C host transactions.
+*
+* The FMT entries of a transaction are generated on the fly, from its phase
+* and position, so no program of the transaction is kept in memory.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "i2c_async.h"
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "i2c_regs.h"
+#include "irq.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The most bytes a single read entry requests.
+ */
+#define I2C_ASYNC_RX_CHUNK      256
+
+/****************************************************************************/
+/**                                                                        **/
+/*                       TYPEDEFS AND STRUCTURES                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The FMT entries of a transaction, in order.
+ */
+enum
+{
+    PHASE_ADDR_W,   /*!< START and the address for writing. */
+    PHASE_TX,       /*!< The TX bytes, the last one with STOP without RX. */
+    PHASE_ADDR_R,   /*!< (repeated) START and the address for reading. */
+    PHASE_RX,       /*!< Read entries, the last one with STOP. */
+    PHASE_DONE,
+};
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts the transaction at the head of the queue.
+ */
+static void xfer_start( i2c_async_t *p_ia );
+
+/**
+ * @brief Launches the DMA transaction of the RX bytes of the running
+ * transaction, if a channel is selected and it has some.
+ */
+static void rx_dma_start( i2c_async_t *p_ia );
+
+/**
+ * @brief Callback of the RX DMA transactions.
+ */
+static void rx_dma_done( dma_queue_entry_t *p_entry );
+
+/**
+ * @brief Pushes the next FMT entries of the running transaction, as many as
+ * the FMT FIFO has room for.
+ */
+static void fmt_fill( i2c_async_t *p_ia );
+
+/**
+ * @brief Pushes the next FMT entry of the running transaction.
+ */
+static void fmt_push( i2c_async_t *p_ia );
+
+/**
+ * @brief Takes the received bytes out of the RX FIFO.
+ */
+static void rx_drain( i2c_async_t *p_ia );
+
+/**
+ * @brief Ends the running transaction and starts the next one.
+ */
+static void xfer_end( i2c_async_t *p_ia );
+
+/**
+ * @brief The handler of all the interrupts of the I2C host.
+ */
+static void i2c_async_irq( uint32_t p_id );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           LOCAL VARIABLES                                */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The instance served by the handler.
+ */
+static i2c_async_t *async = NULL;
+
+/**
+ * The interrupts of the host, and the event each one stands for.
+ */
+static const struct
+{
+    uint32_t    id;
+    i2c_irq_t   irq;
+} async_irqs[] = {
+    { INTR_FMT_WATERMARK,       kDifI2cIrqFmtWatermarkUnderflow },
+    { INTR_RX_WATERMARK,        kDifI2cIrqRxWatermarkOverflow },
+    { INTR_FMT_OVERFLOW,        kDifI2cIrqFmtFifoOverflow },
+    { INTR_RX_OVERFLOW,         kDifI2cIrqRxFifoOverflow },
+    { INTR_NAK,                 kDifI2cIrqNak },
+    { INTR_SCL_INTERFERENCE,    kDifI2cIrqSclInterference },
+    { INTR_SDA_INTERFERENCE,    kDifI2cIrqSdaInterference },
+    { INTR_STRETCH_TIMEOUT,     kDifI2cIrqClockStretchTimeout },
+    { INTR_SDA_UNSTABLE,        kDifI2cIrqSdaUnstable },
+    { INTR_TRANS_COMPLETE,      kDifI2cIrqTransComplete },
+};
+
+#define ASYNC_IRQS_N    ( sizeof( async_irqs ) / sizeof( async_irqs[ 0 ] ) )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+i2c_result_t i2c_async_init( i2c_async_t *p_ia,
+                             const i2c_t *p_i2c,
+                             i2c_level_t p_rx_level,
+                             i2c_level_t p_fmt_level )
+{
+    if( p_ia == NULL || p_i2c == NULL
+        || i2c_set_watermarks( p_i2c, p_rx_level, p_fmt_level ) != kDifI2cOk )
+    {
+        return kDifI2cBadArg;
+    }
+
+    p_ia->i2c         = p_i2c;
+    p_ia->head        = NULL;
+    p_ia->tail        = NULL;
+    p_ia->phase       = PHASE_DONE;
+    p_ia->fmt_pos     = 0;
+    p_ia->rx_pos      = 0;
+    p_ia->result      = I2C_ASYNC_DONE;
+    p_ia->dma_ch      = I2C_ASYNC_NO_DMA;
+    p_ia->dma_busy    = false;
+    p_ia->end_pending = false;
+    async             = p_ia;
+
+    i2c_reset_fmt_fifo( p_i2c );
+    i2c_reset_rx_fifo( p_i2c );
+
+    for( uint32_t i = 0; i < ASYNC_IRQS_N; i++ )
+    {
+        uint32_t src = IRQ_SRC_PLIC( async_irqs[ i ].id );
+
+        i2c_irq_acknowledge( p_i2c, async_irqs[ i ].irq );
+        i2c_irq_set_enabled( p_i2c, async_irqs[ i ].irq, kDifI2cToggleEnabled );
+        irq_register( src, i2c_async_irq );
+        irq_set_priority( src, 1 );
+        irq_set_enabled( src, true );
+    }
+
+    return kDifI2cOk;
+}
+
+i2c_result_t i2c_async_set_dma( i2c_async_t *p_ia, uint8_t p_dma_ch )
+{
+    if( p_ia == NULL || p_ia->i2c == NULL || p_ia->head != NULL
+        || ( p_dma_ch != I2C_ASYNC_NO_DMA && p_dma_ch >= DMA_CH_NUM ) )
+    {
+        return kDifI2cBadArg;
+    }
+
+    /*
+     * The parts of the DMA transaction that do not change: bytes from the
+     * data register of the RX FIFO to the buffer of the transaction.
+     */
+    p_ia->dma_src.env          = NULL;
+    p_ia->dma_src.ptr          = (uint8_t*) p_ia->i2c->params.base_addr.base + I2C_RDATA_REG_OFFSET;
+    p_ia->dma_src.inc_du       = 0;
+    p_ia->dma_src.stride_d2_du = 0;
+    p_ia->dma_src.type         = DMA_DATA_TYPE_BYTE;
+    p_ia->dma_src.trig         = DMA_TRIG_SLOT_I2C_RX;
+    p_ia->dma_dst.env          = NULL;
+    p_ia->dma_dst.inc_du       = 1;
+    p_ia->dma_dst.size_du      = 0;
+    p_ia->dma_dst.stride_d2_du = 0;
+    p_ia->dma_dst.type         = DMA_DATA_TYPE_BYTE;
+    p_ia->dma_dst.trig         = DMA_TRIG_MEMORY;
+    p_ia->dma_trans.src        = &p_ia->dma_src;
+    p_ia->dma_trans.dst        = &p_ia->dma_dst;
+    p_ia->dma_trans.src_addr   = NULL;
+    p_ia->dma_trans.mode       = DMA_TRANS_MODE_SINGLE;
+    p_ia->dma_trans.win_du     = 0;
+    p_ia->dma_trans.end        = DMA_TRANS_END_INTR;
+    p_ia->dma_trans.channel    = p_dma_ch;
+    p_ia->dma_trans.size_d2    = 0;
+    p_ia->dma_trans.conv       = DMA_TYPE_CONV_NONE;
+    p_ia->dma_entry.trans      = &p_ia->dma_trans;
+    p_ia->dma_entry.cb         = rx_dma_done;
+    p_ia->dma_entry.ctx        = p_ia;
+    p_ia->dma_ch               = p_dma_ch;
+
+    return kDifI2cOk;
+}
+
+i2c_result_t i2c_async_submit( i2c_async_t *p_ia, i2c_async_xfer_t *p_xfer )
+{
+    uint32_t mstatus;
+
+    if( p_ia == NULL || p_xfer == NULL || p_xfer->addr > 0x7F
+        || ( p_xfer->tx_len > 0 && p_xfer->tx == NULL )
+        || ( p_xfer->rx_len > 0 && p_xfer->rx == NULL ) )
+    {
+        return kDifI2cBadArg;
+    }
+
+    mstatus = irq_save();
+
+    if( p_xfer->status == I2C_ASYNC_PENDING )
+    {
+        irq_restore( mstatus );
+        return kDifI2cBadArg;
+    }
+
+    p_xfer->status = I2C_ASYNC_PENDING;
+    p_xfer->next   = NULL;
+
+    if( p_ia->head == NULL )
+    {
+        p_ia->head = p_xfer;
+        p_ia->tail = p_xfer;
+        xfer_start( p_ia );
+    }
+    else
+    {
+        p_ia->tail->next = p_xfer;
+        p_ia->tail       = p_xfer;
+    }
+
+    irq_restore( mstatus );
+    return kDifI2cOk;
+}
+
+i2c_async_status_t i2c_async_wait( const i2c_async_xfer_t *p_xfer )
+{
+    /* The status is checked with the interrupts disabled, wfi still returns
+       on the interrupt that ends the transaction. */
+    for( ;; )
+    {
+        uint32_t mstatus = irq_save();
+        if( p_xfer->status != I2C_ASYNC_PENDING )
+        {
+            irq_restore( mstatus );
+            return p_xfer->status;
+        }
+        asm volatile( "wfi" );
+        irq_restore( mstatus );
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void xfer_start( i2c_async_t *p_ia )
+{
+    p_ia->phase       = PHASE_ADDR_W;
+    p_ia->fmt_pos     = 0;
+    p_ia->rx_pos      = 0;
+    p_ia->result      = I2C_ASYNC_DONE;
+    p_ia->end_pending = false;
+    rx_dma_start( p_ia );
+    fmt_fill( p_ia );
+}
+
+static void rx_dma_start( i2c_async_t *p_ia )
+{
+    i2c_async_xfer_t *xfer = p_ia->head;
+
+    if( p_ia->dma_ch != I2C_ASYNC_NO_DMA && xfer->rx_len > 0 )
+    {
+        dma_config_flags_t flags;
+
+        p_ia->dma_src.size_du = xfer->rx_len;
+        p_ia->dma_dst.ptr     = xfer->rx;
+        p_ia->dma_busy        = true;
+        flags  = dma_validate_transaction( &p_ia->dma_trans,
+                                           DMA_DO_NOT_ENABLE_REALIGN,
+                                           DMA_PERFORM_CHECKS_ONLY_SANITY );
+        flags |= dma_submit( &p_ia->dma_entry );
+        if( flags & ( DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE ) )
+        {
+            /* The channel cannot be used, the CPU takes over. */
+            p_ia->dma_busy = false;
+            p_ia->dma_ch   = I2C_ASYNC_NO_DMA;
+        }
+    }
+
+    /* The DMA empties the RX FIFO, the watermark would fire for nothing. */
+    i2c_irq_set_enabled( p_ia->i2c, kDifI2cIrqRxWatermarkOverflow,
+                         p_ia->dma_busy ? kDifI2cToggleDisabled : kDifI2cToggleEnabled );
+}
+
+static void rx_dma_done( dma_queue_entry_t *p_entry )
+{
+    i2c_async_t *ia = (i2c_async_t*) p_entry->ctx;
+
+    ia->dma_busy = false;
+    if( ( p_entry->trans->flags & DMA_CONFIG_CRITICAL_ERROR ) == 0 && ia->head != NULL )
+    {
+        ia->rx_pos = ia->head->rx_len;
+    }
+    if( ia->end_pending )
+    {
+        xfer_end( ia );
+    }
+}
+
+static void fmt_fill( i2c_async_t *p_ia )
+{
+    uint8_t fmt_level;
+
+    if( i2c_get_fifo_levels( p_ia->i2c, &fmt_level, NULL ) != kDifI2cOk )
+    {
+        return;
+    }
+
+    for( uint32_t room = I2C_ASYNC_FIFO_DEPTH - fmt_level;
+         room > 0 && p_ia->phase != PHASE_DONE; room-- )
+    {
+        fmt_push( p_ia );
+    }
+}
+
+static void fmt_push( i2c_async_t *p_ia )
+{
+    i2c_async_xfer_t *xfer = p_ia->head;
+
+    switch( p_ia->phase )
+    {
+        case PHASE_ADDR_W:
+            if( xfer->tx_len == 0 && xfer->rx_len == 0 )
+            {
+                /* The address only, START and STOP around it. */
+                i2c_write_byte_raw( p_ia->i2c, xfer->addr << 1,
+                                    (i2c_fmt_flags_t){ .start = true, .stop = true } );
+                p_ia->phase = PHASE_DONE;
+                break;
+            }
+            if( xfer->tx_len == 0 )
+            {
+                p_ia->phase = PHASE_ADDR_R;
+                fmt_push( p_ia );
+                break;
+            }
+            i2c_write_byte( p_ia->i2c, xfer->addr << 1, kDifI2cFmtStart, false );
+            p_ia->phase = PHASE_TX;
+            break;
+
+        case PHASE_TX:
+        {
+            bool last = p_ia->fmt_pos + 1 == xfer->tx_len;
+            i2c_write_byte( p_ia->i2c, xfer->tx[ p_ia->fmt_pos++ ],
+                            last && xfer->rx_len == 0 ? kDifI2cFmtTxStop : kDifI2cFmtTx,
+                            false );
+            if( last )
+            {
+                p_ia->fmt_pos = 0;
+                p_ia->phase   = xfer->rx_len == 0 ? PHASE_DONE : PHASE_ADDR_R;
+            }
+            break;
+        }
+
+        case PHASE_ADDR_R:
+            i2c_write_byte( p_ia->i2c, ( xfer->addr << 1 ) | 1, kDifI2cFmtStart, false );
+            p_ia->phase = PHASE_RX;
+            break;
+
+        case PHASE_RX:
+        {
+            size_t left = xfer->rx_len - p_ia->fmt_pos;
+            size_t n    = left > I2C_ASYNC_RX_CHUNK ? I2C_ASYNC_RX_CHUNK : left;
+
+            /* A count of 256 is written as 0. */
+            i2c_write_byte( p_ia->i2c, (uint8_t) n,
+                            n == left ? kDifI2cFmtRxStop : kDifI2cFmtRxContinue,
+                            false );
+            p_ia->fmt_pos += n;
+            if( n == left )
+            {
+                p_ia->phase = PHASE_DONE;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void rx_drain( i2c_async_t *p_ia )
+{
+    i2c_async_xfer_t    *xfer = p_ia->head;
+    uint8_t             rx_level;
+
+    if( p_ia->dma_busy
+        || i2c_get_fifo_levels( p_ia->i2c, NULL, &rx_level ) != kDifI2cOk )
+    {
+        return;
+    }
+
+    for( ; rx_level > 0; rx_level-- )
+    {
+        if( xfer != NULL && p_ia->rx_pos < xfer->rx_len )
+        {
+            i2c_read_byte( p_ia->i2c, &xfer->rx[ p_ia->rx_pos++ ] );
+        }
+        else
+        {
+            i2c_read_byte( p_ia->i2c, NULL );
+        }
+    }
+}
+
+static void xfer_end( i2c_async_t *p_ia )
+{
+    i2c_async_xfer_t *xfer = p_ia->head;
+
+    if( xfer == NULL )
+    {
+        return;
+    }
+
+    if( p_ia->result == I2C_ASYNC_DONE && p_ia->phase != PHASE_DONE )
+    {
+        p_ia->result = I2C_ASYNC_ERROR;
+    }
+    if( p_ia->dma_busy )
+    {
+        /*
+         * After the STOP the last bytes are in the FIFO and the DMA takes
+         * them, its callback ends the transaction. After an error they may
+         * never come.
+         */
+        if( p_ia->result != I2C_ASYNC_DONE )
+        {
+            dma_release_triggers( p_ia->dma_ch );
+        }
+        p_ia->end_pending = true;
+        return;
+    }
+
+    rx_drain( p_ia );
+    if( p_ia->result == I2C_ASYNC_DONE && p_ia->rx_pos != xfer->rx_len )
+    {
+        p_ia->result = I2C_ASYNC_ERROR;
+    }
+    if( p_ia->result != I2C_ASYNC_DONE )
+    {
+        /* Drops what is left of the transaction. */
+        i2c_reset_fmt_fifo( p_ia->i2c );
+        i2c_reset_rx_fifo( p_ia->i2c );
+    }
+
+    p_ia->head  = xfer->next;
+    xfer->next  = NULL;
+    p_ia->phase = PHASE_DONE;
+    if( p_ia->head == NULL )
+    {
+        p_ia->tail = NULL;
+    }
+    else
+    {
+        xfer_start( p_ia );
+    }
+
+    /* Last, so that the callback may submit it again. */
+    xfer->status = p_ia->result;
+    if( xfer->cb != NULL )
+    {
+        xfer->cb( xfer );
+    }
+}
+
+static void i2c_async_irq( uint32_t p_id )
+{
+    i2c_async_t *ia = async;
+
+    for( uint32_t i = 0; i < ASYNC_IRQS_N; i++ )
+    {
+        if( async_irqs[ i ].id == p_id )
+        {
+            i2c_irq_acknowledge( ia->i2c, async_irqs[ i ].irq );
+            break;
+        }
+    }
+
+    if( ia->head == NULL )
+    {
+        return;
+    }
+
+    switch( p_id )
+    {
+        case INTR_FMT_WATERMARK:
+            fmt_fill( ia );
+            break;
+
+        case INTR_RX_WATERMARK:
+            rx_drain( ia );
+            break;
+
+        case INTR_TRANS_COMPLETE:
+            xfer_end( ia );
+            break;
+
+        case INTR_NAK:
+            /* The host goes on to the STOP, the transaction ends there. */
+            if( ia->result == I2C_ASYNC_DONE )
+            {
+                ia->result = I2C_ASYNC_NAK;
+            }
+            break;
+
+        default:
+            ia->result = I2C_ASYNC_ERROR;
+            if( p_id == INTR_RX_OVERFLOW || p_id == INTR_FMT_OVERFLOW )
+            {
+                break;
+            }
+            /* The bus is in an unknown state: the STOP may never come. */
+            xfer_end( ia );
+            break;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
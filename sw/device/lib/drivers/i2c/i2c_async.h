@@ -0,0 +1,216 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : i2c_async.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   i2c_async.h
+* @date   14/10/26
+* @brief  Interrupt-driven I2C host transactions.
+*
+* A transaction writes bytes to a target, reads bytes from it after a
+* repeated start, or both: START addr+W, the TX bytes, START addr+R, the RX
+* bytes, STOP. Its FMT entries are pushed in batches: as many as the FMT FIFO
+* holds when it starts, then more on each FMT watermark interrupt. The RX
+* bytes are taken on the RX watermark interrupt and at the end, which is the
+* "transaction complete" interrupt raised by the STOP.
+*
+* Transactions are queued: the next one starts from the interrupt handler
+* when one ends, so a set of sensors can be read with no CPU time besides the
+* interrupts. The callback of a transaction is called from the handler.
+*
+* With a DMA channel (i2c_async_set_dma), the RX bytes are moved by the DMA,
+* paced by the I2C RX trigger slot, instead of the RX watermark interrupt: a
+* bulk read then only costs the FMT refills, one per 256 bytes, and the end.
+*
+* The application has to:
+* - configure the I2C (i2c_configure) and enable the host;
+* - call i2c_async_init after plic_Init;
+* - enable the machine external interrupts (mstatus.MIE and mie.MEIE).
+* Only one instance can be used, the SoC has a single I2C.
+*/
+
+#ifndef _I2C_ASYNC_H_
+#define _I2C_ASYNC_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma.h"
+#include "i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The depth of the FMT and RX FIFOs.
+ */
+#define I2C_ASYNC_FIFO_DEPTH    32
+
+/**
+ * Value of the DMA channel to take the RX bytes with the CPU.
+ */
+#define I2C_ASYNC_NO_DMA        0xFF
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The status of a transaction.
+ */
+typedef enum
+{
+    I2C_ASYNC_DONE      = 0,    /*!< Ended, all bytes were transferred. */
+    I2C_ASYNC_PENDING   = 1,    /*!< Queued or running. */
+    I2C_ASYNC_NAK       = 2,    /*!< The target did not acknowledge a byte. */
+    I2C_ASYNC_ERROR     = 3,    /*!< A FIFO overflowed, the bus had
+    interference or the target stretched the clock too long. */
+} i2c_async_status_t;
+
+struct i2c_async_xfer;
+
+/**
+ * The callback of a transaction, called from the interrupt handler when it
+ * ends. It may submit transactions.
+ */
+typedef void (*i2c_async_cb_t)( struct i2c_async_xfer *p_xfer );
+
+/**
+ * A transaction, allocated by the caller, which fills the first fields. It
+ * must stay in memory until it ends. Its status must not be
+ * I2C_ASYNC_PENDING when it is first submitted, e.g. zero-initialize it.
+ */
+typedef struct i2c_async_xfer
+{
+    uint8_t                     addr;       /*!< 7-bit address of the target. */
+    const uint8_t               *tx;        /*!< Bytes written first. */
+    size_t                      tx_len;     /*!< May be 0. */
+    uint8_t                     *rx;        /*!< Bytes read then. */
+    size_t                      rx_len;     /*!< May be 0. Both 0 only
+    address the target, e.g. to probe it. */
+    i2c_async_cb_t              cb;         /*!< May be NULL. */
+    void                        *ctx;       /*!< For the callback. */
+    volatile i2c_async_status_t status;     /*!< Set by the driver. */
+    struct i2c_async_xfer       *next;      /*!< Managed by the driver. */
+} i2c_async_xfer_t;
+
+/**
+ * The asynchronous host. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    const i2c_t         *i2c;
+    i2c_async_xfer_t    *volatile head; /*!< The running transaction. */
+    i2c_async_xfer_t    *tail;
+    uint8_t             phase;      /*!< The next FMT entries to push. */
+    size_t              fmt_pos;    /*!< TX bytes or RX bytes requested. */
+    size_t              rx_pos;     /*!< RX bytes received. */
+    i2c_async_status_t  result;     /*!< Of the running transaction. */
+    uint8_t             dma_ch;     /*!< Channel of the RX, or I2C_ASYNC_NO_DMA. */
+    volatile bool       dma_busy;   /*!< The RX DMA transaction is running. */
+    bool                end_pending;/*!< The transaction ended before it. */
+    dma_target_t        dma_src;
+    dma_target_t        dma_dst;
+    dma_trans_t         dma_trans;
+    dma_queue_entry_t   dma_entry;
+} i2c_async_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Sets the watermarks, resets the FIFOs and registers and enables the
+ * interrupts of the I2C (irq.h).
+ * @param p_ia The asynchronous host.
+ * @param p_i2c The I2C, configured. It must stay in memory.
+ * @param p_rx_level The RX watermark: the bytes received before the handler
+ * takes them. Lower levels leave more time to the handler before the RX FIFO
+ * overflows.
+ * @param p_fmt_level The FMT watermark: the entries left when the handler
+ * refills the FIFO, not the 30-byte level.
+ * @return kDifI2cOk, or kDifI2cBadArg for a bad argument.
+ */
+i2c_result_t i2c_async_init( i2c_async_t *p_ia,
+                             const i2c_t *p_i2c,
+                             i2c_level_t p_rx_level,
+                             i2c_level_t p_fmt_level );
+
+/**
+ * @brief Selects the DMA channel that takes the RX bytes, from the next
+ * transaction on. dma_init must have been called.
+ * @param p_ia The asynchronous host, initialized and idle.
+ * @param p_dma_ch The channel, or I2C_ASYNC_NO_DMA for the CPU.
+ * @return kDifI2cOk, or kDifI2cBadArg for a bad argument or a busy host.
+ */
+i2c_result_t i2c_async_set_dma( i2c_async_t *p_ia, uint8_t p_dma_ch );
+
+/**
+ * @brief Queues a transaction, and starts it if the host is idle.
+ * @param p_ia The asynchronous host.
+ * @param p_xfer The transaction, its status becomes I2C_ASYNC_PENDING.
+ * @return kDifI2cOk, or kDifI2cBadArg for a bad argument or a transaction
+ * already pending.
+ */
+i2c_result_t i2c_async_submit( i2c_async_t *p_ia, i2c_async_xfer_t *p_xfer );
+
+/**
+ * @brief Waits in wfi until a transaction ends. The interrupts must be
+ * enabled.
+ * @return Its status.
+ */
+i2c_async_status_t i2c_async_wait( const i2c_async_xfer_t *p_xfer );
+
+/**
+ * @brief Whether transactions are queued or running.
+ */
+static inline bool i2c_async_busy( const i2c_async_t *p_ia )
+{
+    return p_ia->head != NULL;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _I2C_ASYNC_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
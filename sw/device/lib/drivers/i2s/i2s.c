@@ -37,6 +37,20 @@
 
 #include "i2s.h"
 #include "i2s_structs.h"
+#include "clock_gate.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The I2S holds the clock of the peripheral domain (clock_gate.h) from
+ * i2s_init() to i2s_terminate().
+ */
+static bool i2s_clock_held = false;
 
 
 /****************************************************************************/
@@ -53,6 +67,11 @@ __attribute__((weak, optimize("O0"))) void handler_irq_i2s(uint32_t id)
 // i2s base functions
 i2s_result_t i2s_init(uint16_t div_value, i2s_word_length_t word_length)
 {
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+    i2s_clock_held = true;
+  }
+
   // already on ?
   if (i2s_is_running()) {
     //printf("ERROR: [I2S HAL] I2S peripheral already running");
@@ -62,16 +81,14 @@ i2s_result_t i2s_init(uint16_t div_value, i2s_word_length_t word_length)
   // write clock divider value to register
   i2s_peri->CLKDIVIDX = div_value;
 
-  // write word_length to register
-  uint32_t control = i2s_peri->CONTROL;
-  control = bitfield_field32_write(control, I2S_CONTROL_DATA_WIDTH_FIELD, word_length);
-
-  // enable base modules
-  control |= (
-    + (1 << I2S_CONTROL_EN_BIT)     // enable SCK
-    + (1 << I2S_CONTROL_EN_IO_BIT)  // connect signals to IO
+  // write word_length to register and enable base modules, in one store
+  structs_write_fields(&i2s_peri->CONTROL,
+    I2S_CONTROL_DATA_WIDTH_FMASK | I2S_CONTROL_EN_FMASK | I2S_CONTROL_EN_IO_FMASK,
+    I2S_CONTROL_DATA_WIDTH_FVAL(word_length)
+    | I2S_CONTROL_EN_FVAL(1)      // enable SCK
+    | I2S_CONTROL_EN_IO_FVAL(1)   // connect signals to IO
   );
-  i2s_peri->CONTROL = control;
+  uint32_t control = i2s_peri->CONTROL;
 
   // wait for I2S clock domain to acknowledge startup
   while (! i2s_is_running()) ;
@@ -84,17 +101,59 @@ i2s_result_t i2s_init(uint16_t div_value, i2s_word_length_t word_length)
 
 void i2s_terminate(void)
 {
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+  }
+
   i2s_peri->CONTROL &= ~(
     (1 << I2S_CONTROL_EN_WS_BIT)    // disable WS gen
     + (1 << I2S_CONTROL_EN_BIT)     // disable SCK
     + (1 << I2S_CONTROL_EN_IO_BIT)  // disconnect IO
   );
+
+  clock_gate_release(CLOCK_GATE_PERIPH);
+  i2s_clock_held = false;
+}
+
+i2s_result_t i2s_init_shared(uint16_t div_value, i2s_word_length_t word_length)
+{
+  if (! i2s_is_running()) {
+    return i2s_init(div_value, word_length);
+  }
+
+  // started by the other channel, it must use the same clock and word length
+  uint32_t control = i2s_peri->CONTROL;
+  if (i2s_peri->CLKDIVIDX != div_value
+      || bitfield_field32_read(control, I2S_CONTROL_DATA_WIDTH_FIELD) != word_length) {
+    return kI2sError;
+  }
+  return kI2sOk;
+}
+
+void i2s_terminate_if_idle(void)
+{
+  uint32_t control = i2s_peri->CONTROL;
+  if (bitfield_field32_read(control, I2S_CONTROL_EN_RX_FIELD) == 0x00
+      && bitfield_field32_read(control, I2S_CONTROL_EN_TX_FIELD) == 0x00) {
+    i2s_terminate();
+  }
 }
 
 bool i2s_is_running(void)
 {
+  bool running;
+
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+  }
+
   // check "running" bit in the STATUS register
-  return (i2s_peri->STATUS & (1 << I2S_STATUS_RUNNING_BIT));
+  running = (i2s_peri->STATUS & (1 << I2S_STATUS_RUNNING_BIT));
+
+  if (!i2s_clock_held) {
+    clock_gate_release(CLOCK_GATE_PERIPH);
+  }
+  return running;
 }
 
 //
@@ -188,6 +247,151 @@ bool i2s_rx_overflow(void)
 }
 
 
+//
+// TX Channel
+//
+
+i2s_result_t i2s_tx_start(i2s_channel_sel_t channels)
+{
+  if (! i2s_is_running()) {
+    //printf("ERROR: [I2S HAL] I2S peripheral not running");
+    return kI2sErrUninit;
+  }
+
+  if (channels == I2S_DISABLE) {
+    // no channels selected -> disable
+    return i2s_tx_stop();
+  }
+
+  uint32_t control = i2s_peri->CONTROL;
+
+  if (bitfield_field32_read(control, I2S_CONTROL_EN_TX_FIELD) != 0x00 || i2s_tdm_enabled()) {
+    //printf("ERROR: [I2S HAL] I2S tx was already running");
+    return kI2sError;
+  }
+
+  // an underflow of a previous playback is not reported
+  if (i2s_tx_underflow()) {
+    i2s_peri->CONTROL = control | (1 << I2S_CONTROL_RESET_TX_UNDERFLOW_BIT);
+    while (i2s_tx_underflow()) ;
+  }
+
+  control = bitfield_field32_write(control, I2S_CONTROL_EN_TX_FIELD, channels);
+  i2s_peri->CONTROL = control;
+  return kI2sOk;
+}
+
+i2s_result_t i2s_tx_stop(void)
+{
+  if (! i2s_is_running()) {
+    //printf("ERROR: [I2S HAL] I2S peripheral not running");
+    return kI2sErrUninit;
+  }
+
+  uint32_t control = i2s_peri->CONTROL;
+  if (bitfield_field32_read(control, I2S_CONTROL_EN_TX_FIELD) == 0x00) {
+    return kI2sOk;
+  }
+
+  bool underflow = i2s_tx_underflow();
+
+  // CDC FIFO is not clearable, so it is played out: the underflow flag is
+  // cleared, and raised again once the FIFO is empty and a sample is due
+  if (underflow) {
+    i2s_peri->CONTROL = control | (1 << I2S_CONTROL_RESET_TX_UNDERFLOW_BIT);
+    // the flag is reset by the tx channel on a SCK rise
+    while (i2s_tx_underflow()) ;
+  }
+  while (! i2s_tx_underflow()) ;
+
+  // disable tx channel
+  control &= ~(I2S_CONTROL_EN_TX_MASK << I2S_CONTROL_EN_TX_OFFSET);
+  i2s_peri->CONTROL = control;
+
+  // trigger reset of the underflow flag
+  i2s_peri->CONTROL = control | (1 << I2S_CONTROL_RESET_TX_UNDERFLOW_BIT);
+  while (i2s_tx_underflow()) ;
+
+  return underflow ? kI2sUnderflow : kI2sOk;
+}
+
+bool i2s_tx_ready(void)
+{
+  // read tx ready bit from STATUS register
+  return (i2s_peri->STATUS & (1 << I2S_STATUS_TX_READY_BIT));
+}
+
+void i2s_tx_write_data(uint32_t data)
+{
+  // write TXDATA register
+  i2s_peri->TXDATA = data;
+}
+
+bool i2s_tx_underflow(void)
+{
+  // read underflow bit from STATUS register
+  return (i2s_peri->STATUS & (1 << I2S_STATUS_TX_UNDERFLOW_BIT));
+}
+
+
+//
+// TDM
+//
+
+i2s_result_t i2s_tdm_enable(const i2s_tdm_cfg_t *cfg)
+{
+  if (i2s_is_running() || cfg->slots < 2 || cfg->slots > 16 || cfg->slot_en == 0) {
+    return kI2sError;
+  }
+
+  uint32_t tdm = 0;
+  tdm = bitfield_field32_write(tdm, I2S_TDM_SLOTS_FIELD, cfg->slots - 1);
+  tdm = bitfield_field32_write(tdm, I2S_TDM_SLOT_WIDTH_FIELD, cfg->slot_width);
+  tdm = bitfield_field32_write(tdm, I2S_TDM_SLOT_EN_FIELD, cfg->slot_en);
+  tdm = bitfield_bit32_write(tdm, I2S_TDM_TAG_BIT, cfg->tag);
+  tdm = bitfield_bit32_write(tdm, I2S_TDM_EN_BIT, true);
+
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+  }
+  i2s_peri->TDM = tdm;
+  if (!i2s_clock_held) {
+    clock_gate_release(CLOCK_GATE_PERIPH);
+  }
+  return kI2sOk;
+}
+
+i2s_result_t i2s_tdm_disable(void)
+{
+  if (i2s_is_running()) {
+    return kI2sError;
+  }
+
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+  }
+  i2s_peri->TDM &= ~(1 << I2S_TDM_EN_BIT);
+  if (!i2s_clock_held) {
+    clock_gate_release(CLOCK_GATE_PERIPH);
+  }
+  return kI2sOk;
+}
+
+bool i2s_tdm_enabled(void)
+{
+  bool enabled;
+
+  if (!i2s_clock_held) {
+    clock_gate_acquire(CLOCK_GATE_PERIPH);
+  }
+  enabled = (i2s_peri->TDM & (1 << I2S_TDM_EN_BIT));
+  if (!i2s_clock_held) {
+    clock_gate_release(CLOCK_GATE_PERIPH);
+  }
+  return enabled;
+}
+
+
 //
 // RX Watermark
 //
@@ -196,12 +400,10 @@ void i2s_rx_enable_watermark(uint16_t watermark, bool interrupt_en)
   // set watermark (= max of counter) triggers an interrupt if enabled
   i2s_peri->WATERMARK = watermark;
 
-  uint32_t control = i2s_peri->CONTROL;
-  // enable/disable interrupt
-  control = bitfield_bit32_write(control, I2S_CONTROL_INTR_EN_BIT, interrupt_en);
-  // enable counter
-  control |= (1 << I2S_CONTROL_EN_WATERMARK_BIT);
-  i2s_peri->CONTROL = control;
+  // enable/disable interrupt and enable counter
+  structs_write_fields(&i2s_peri->CONTROL,
+    I2S_CONTROL_INTR_EN_FMASK | I2S_CONTROL_EN_WATERMARK_FMASK,
+    I2S_CONTROL_INTR_EN_FVAL(interrupt_en) | I2S_CONTROL_EN_WATERMARK_FVAL(1));
 }
 
 void i2s_rx_disable_watermark(void)
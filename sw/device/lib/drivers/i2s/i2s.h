@@ -35,6 +35,11 @@
  */
 #define I2S_RX_DATA_ADDRESS (uint32_t)(I2S_RXDATA_REG_OFFSET+I2S_START_ADDRESS)
 
+/**
+ * Address of the I2S data of the write channel to be passed as address to the DMA
+ */
+#define I2S_TX_DATA_ADDRESS (uint32_t)(I2S_TXDATA_REG_OFFSET+I2S_START_ADDRESS)
+
 
 /****************************************************************************/
 /**                                                                        **/
@@ -78,6 +83,10 @@ typedef enum i2s_result {
    * Indicates overflow.
    */
   kI2sOverflow = 2,
+  /**
+   * Indicates underflow.
+   */
+  kI2sUnderflow = 3,
   /**
    * Indicates some unspecified failure.
    */
@@ -101,6 +110,39 @@ typedef enum i2s_channel_sel {
 } i2s_channel_sel_t;
 
 
+/**
+ * Slot of a sample received in TDM mode with tags (see i2s_tdm_cfg_t)
+ */
+#define I2S_TDM_SLOT(sample) ((uint32_t)(sample) >> 28)
+
+/**
+ * TDM frame of the RX channel, for microphone arrays on a single data line.
+ * A frame holds up to 16 slots, and WS is a pulse of one SCK at the end of
+ * each frame, before the first bit of slot 0.
+ */
+typedef struct i2s_tdm_cfg {
+  /**
+   * Slots per frame, from 2 to 16.
+   */
+  uint8_t slots;
+  /**
+   * Bits per slot, at least the word length of the samples, which are the
+   * first bits of their slot (see i2s_word_length_t).
+   */
+  i2s_word_length_t slot_width;
+  /**
+   * Slots received, bit n for slot n. Their samples are received in slot
+   * order, from the start of a frame.
+   */
+  uint16_t slot_en;
+  /**
+   * Tag each sample with its slot in bits 31:28 (see I2S_TDM_SLOT), for word
+   * lengths up to 24 bits.
+   */
+  bool tag;
+} i2s_tdm_cfg_t;
+
+
 /****************************************************************************/
 /**                                                                        **/
 /*                          EXPORTED FUNCTIONS                              */
@@ -121,6 +163,8 @@ __attribute__((weak, optimize("O0"))) void handler_irq_i2s(uint32_t id);
  * (with the given parameters frequency and word length)
  *
  * @note to change clock freq or word length call `i2s_terminate` first
+ * @note the clock of the peripheral domain is held until `i2s_terminate`
+ *       (see clock_gate.h)
  *
  * @param div_value Divider value = src_clk_freq / gen_clk_freq
  *        (odd values are allowed, for 0 and 1 the src clock is used)
@@ -139,6 +183,23 @@ i2s_result_t i2s_init(uint16_t div_value, i2s_word_length_t word_length);
 void i2s_terminate(void);
 
 
+/**
+ * Initialize I2S peripheral, or check that it already runs with the same
+ * parameters, so that the RX and TX channels can be used together
+ *
+ * @param div_value (see i2s_init)
+ * @param word_length (see i2s_word_length_t)
+ * @return kI2sOk initialized successful or already running with these parameters
+ * @return kI2sError if peripheral was running with other parameters
+ */
+i2s_result_t i2s_init_shared(uint16_t div_value, i2s_word_length_t word_length);
+
+/**
+ * Terminate I2S peripheral if neither the RX nor the TX channels are enabled
+ */
+void i2s_terminate_if_idle(void);
+
+
 /**
  * check if i2s peripheral has been initialized
  *
@@ -209,6 +270,102 @@ bool i2s_rx_overflow(void);
 
 
 
+//
+// TX Channel
+//
+
+/**
+ * I2S start tx channels
+ *
+ * (Start the DMA or write the first samples before, the TX FIFO is not
+ * played while the channels are disabled)
+ *
+ * The samples of both channels are interleaved, left first, and the MSBs
+ * outside of word_length are not sent. A word of a channel with no sample in
+ * the TX FIFO is sent as 0 and raises the underflow flag.
+ *
+ * @param channels to be enabled (see i2s_channel_sel_t) (I2S_DISABLE calls i2s_tx_stop())
+ *
+ * @return kI2sOk success
+ * @return kI2sError TX already started or TDM mode
+ * @return kI2sErrUninit error peripheral was not initialized
+ */
+i2s_result_t i2s_tx_start(i2s_channel_sel_t channels);
+
+/**
+ * I2S stop tx channels and cleans underflow
+ *
+ * Returns once the samples of the TX FIFO have been sent.
+ * (DMA must not be writing to I2S TX data)
+ *
+ * @return kI2sOk success
+ * @return kI2sErrUninit error peripheral was not initialized
+ * @return kI2sUnderflow the TX-FIFO underflowed since the TX has been started.
+ */
+i2s_result_t i2s_tx_stop(void);
+
+/**
+ * I2S check TX FIFO space
+ *
+ * @return true if the TX FIFO can take a sample
+ */
+bool i2s_tx_ready(void);
+
+/**
+ * I2S write TX word
+ *
+ * @note The word is dropped if the TX FIFO is full (see i2s_tx_ready()).
+ *
+ * @param data TX word
+ */
+void i2s_tx_write_data(uint32_t data);
+
+/**
+ * I2S check TX FIFO underflow
+ *
+ * @return true if a sample was due while the TX FIFO was empty
+ * @return false
+ */
+bool i2s_tx_underflow(void);
+
+
+
+//
+// TDM
+//
+
+/**
+ * I2S enable the TDM mode of the RX channel
+ *
+ * Call before i2s_init(): the WS signal is generated for the frame, at
+ * SCK = sample rate * slots * slot width. The RX channels are then enabled
+ * with any i2s_channel_sel_t but I2S_DISABLE, and the TX channels cannot be
+ * started.
+ *
+ * @param cfg the TDM frame
+ *
+ * @return kI2sOk success
+ * @return kI2sError peripheral already running or wrong configuration
+ */
+i2s_result_t i2s_tdm_enable(const i2s_tdm_cfg_t *cfg);
+
+/**
+ * I2S disable the TDM mode, back to left and right channels
+ *
+ * @return kI2sOk success
+ * @return kI2sError peripheral still running
+ */
+i2s_result_t i2s_tdm_disable(void);
+
+/**
+ * check if the TDM mode is enabled
+ *
+ * @return true if TDM mode
+ */
+bool i2s_tdm_enabled(void);
+
+
+
 // Watermark
 
 /**
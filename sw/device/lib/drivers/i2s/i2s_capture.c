@@ -0,0 +1,262 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : i2s_capture.c                                                **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   i2s_capture.c
+* @date   14/10/2026
+* @brief  Continuous audio capture from the I2S peripheral with the DMA
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "i2s_capture.h"
+
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Window done callback of the stream, calls the frame callback
+ */
+static void i2s_capture_frame_done(dma_stream_t *stream, uint32_t slot);
+
+/**
+ * Free callback of the buffers of i2s_capture_take, releases their frame
+ */
+static void i2s_capture_frame_free(pbuf_t *pbuf);
+
+/**
+ * Stops the I2S clocks if no playback runs, and leaves the TDM mode
+ */
+static void i2s_capture_terminate(i2s_capture_t *capture);
+
+/**
+ * DMA data type of the samples of a configuration
+ */
+static dma_data_type_t i2s_capture_type(const i2s_capture_cfg_t *cfg);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+size_t i2s_capture_frame_size(const i2s_capture_cfg_t *cfg)
+{
+  size_t channels = (cfg->channels == I2S_BOTH_CH) ? 2 : 1;
+  if (cfg->tdm.slots != 0) {
+    // the enabled slots of the frame
+    uint32_t slot_en = cfg->tdm.slot_en & ((1u << cfg->tdm.slots) - 1);
+    channels = __builtin_popcount(slot_en);
+  }
+  return cfg->frame_len * channels * DMA_DATA_TYPE_2_SIZE(i2s_capture_type(cfg));
+}
+
+i2s_result_t i2s_capture_start(i2s_capture_t *capture, const i2s_capture_cfg_t *cfg)
+{
+  if ((cfg->channels == I2S_DISABLE && cfg->tdm.slots == 0) || cfg->frames < 2 || cfg->frame_len == 0
+      || cfg->sample_rate_hz == 0 || cfg->buffer == NULL || ((uint32_t) cfg->buffer & 3)) {
+    return kI2sError;
+  }
+  capture->cfg = *cfg;
+  capture->taken = 0;
+
+  // each channel takes word_length SCK periods of the WS period, each slot
+  // of a TDM frame its slot width
+  soc_ctrl_t soc_ctrl;
+  soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+  uint32_t word_bits = 8 * (cfg->word_length + 1);
+  uint32_t sck_hz = cfg->sample_rate_hz * 2 * word_bits;
+  if (cfg->tdm.slots != 0) {
+    sck_hz = cfg->sample_rate_hz * cfg->tdm.slots * 8 * (cfg->tdm.slot_width + 1);
+  }
+  uint32_t div = (soc_ctrl_get_frequency(&soc_ctrl) + sck_hz / 2) / sck_hz;
+  if (div > I2S_CLKDIVIDX_COUNT_MASK) {
+    return kI2sError;
+  }
+
+  i2s_result_t res;
+  if (cfg->tdm.slots != 0) {
+    // the WS of the frame is generated from the start, so the I2S cannot be
+    // shared with a playback
+    if (cfg->tdm.slot_width < cfg->word_length
+        || (cfg->tdm.tag && cfg->word_length == I2S_32_BITS)
+        || i2s_tdm_enable(&cfg->tdm) != kI2sOk) {
+      return kI2sError;
+    }
+    res = i2s_init((uint16_t) div, cfg->word_length);
+  } else {
+    res = i2s_init_shared((uint16_t) div, cfg->word_length);
+  }
+  if (res != kI2sOk) {
+    return res;
+  }
+
+  dma_data_type_t type = i2s_capture_type(cfg);
+  size_t frame_size = i2s_capture_frame_size(cfg);
+
+  capture->src = (dma_target_t) {
+    .ptr     = (uint8_t *) I2S_RX_DATA_ADDRESS,
+    .inc_du  = 0,
+    .size_du = cfg->frames * frame_size / DMA_DATA_TYPE_2_SIZE(type),
+    .trig    = DMA_TRIG_SLOT_I2S,
+    .type    = type,
+  };
+  capture->dst = (dma_target_t) {
+    .ptr    = cfg->buffer,
+    .inc_du = 1,
+    .trig   = DMA_TRIG_MEMORY,
+    .type   = type,
+  };
+  capture->trans = (dma_trans_t) {
+    .src     = &capture->src,
+    .dst     = &capture->dst,
+    .channel = cfg->dma_ch,
+  };
+
+  // the DMA waits for the first sample before the RX channels are enabled
+  if (dma_stream_start(&capture->stream, &capture->trans, cfg->frames,
+                       i2s_capture_frame_done, capture) & DMA_CONFIG_CRITICAL_ERROR) {
+    i2s_capture_terminate(capture);
+    return kI2sError;
+  }
+
+  // in TDM mode the slots are selected by the frame, any channel enables them
+  res = i2s_rx_start(cfg->tdm.slots != 0 ? I2S_BOTH_CH : cfg->channels);
+  if (res != kI2sOk) {
+    dma_stream_stop(&capture->stream);
+    i2s_capture_terminate(capture);
+  }
+  return res;
+}
+
+i2s_result_t i2s_capture_stop(i2s_capture_t *capture)
+{
+  // the DMA cannot be aborted, so it fills the ring buffer up to its end
+  // before the RX channels are stopped
+  dma_stream_stop(&capture->stream);
+  while (!dma_is_ready(capture->cfg.dma_ch)) ;
+  i2s_result_t res = i2s_rx_stop();
+  i2s_capture_terminate(capture);
+  return res;
+}
+
+const void *i2s_capture_peek(i2s_capture_t *capture)
+{
+  return dma_stream_peek(&capture->stream);
+}
+
+void i2s_capture_release(i2s_capture_t *capture)
+{
+  dma_stream_release(&capture->stream);
+}
+
+pbuf_t *i2s_capture_take(i2s_capture_t *capture, pbuf_pool_t *pool)
+{
+  dma_stream_t *stream = &capture->stream;
+
+  // the frames overwritten by the DMA have been released by its interrupt
+  if ((int32_t)(capture->taken - stream->consumed) < 0) {
+    capture->taken = stream->consumed;
+  }
+  if (capture->taken == stream->produced || stream->slot_b > 0xFFFF) {
+    return NULL;
+  }
+
+  uint32_t slot = capture->taken % stream->slots;
+  pbuf_t *pbuf = pbuf_alloc_ref(pool, stream->trans->dst->ptr + slot * stream->slot_b,
+                                (uint16_t) stream->slot_b, i2s_capture_frame_free, capture);
+  if (pbuf != NULL) {
+    capture->taken++;
+  }
+  return pbuf;
+}
+
+void i2s_capture_get_stats(i2s_capture_t *capture, i2s_capture_stats_t *stats)
+{
+  stats->frames = capture->stream.produced;
+  stats->overruns = capture->stream.overruns;
+  stats->fifo_overflow = i2s_rx_overflow();
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void i2s_capture_frame_done(dma_stream_t *stream, uint32_t slot)
+{
+  i2s_capture_t *capture = (i2s_capture_t *) stream->ctx;
+  if (capture->cfg.cb != NULL) {
+    capture->cfg.cb(capture, stream->trans->dst->ptr + slot * stream->slot_b);
+  }
+}
+
+static void i2s_capture_frame_free(pbuf_t *pbuf)
+{
+  i2s_capture_release((i2s_capture_t *) pbuf->ctx);
+}
+
+static void i2s_capture_terminate(i2s_capture_t *capture)
+{
+  i2s_terminate_if_idle();
+  if (capture->cfg.tdm.slots != 0) {
+    i2s_tdm_disable();
+  }
+}
+
+static dma_data_type_t i2s_capture_type(const i2s_capture_cfg_t *cfg)
+{
+  // the tags are in the MSBs of the words
+  if (cfg->tdm.slots != 0 && cfg->tdm.tag) {
+    return DMA_DATA_TYPE_WORD;
+  }
+  switch (cfg->word_length) {
+    case I2S_08_BITS:
+      return DMA_DATA_TYPE_BYTE;
+    case I2S_16_BITS:
+      return DMA_DATA_TYPE_HALF_WORD;
+    default:
+      return DMA_DATA_TYPE_WORD;
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,256 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : i2s_capture.h                                                **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   i2s_capture.h
+* @date   14/10/2026
+* @brief  Continuous audio capture from the I2S peripheral with the DMA
+*
+* The DMA moves the samples from the RX FIFO of the I2S to a ring buffer of
+* frames, triggered by the I2S slot, as a dma_stream_t: the CPU reads no
+* sample. At the end of each frame the window done interrupt of the DMA calls
+* the frame callback, and the application reads the oldest frames with
+* i2s_capture_peek and gives them back with i2s_capture_release. The frames
+* that are not released in time are overwritten and counted.
+*
+* The samples of both channels are interleaved, left first. They are stored
+* in 8, 16 or 32-bit words depending on the word length, with the MSBs
+* outside of it at 0, as returned by i2s_rx_read_data.
+*
+* Instead of peeking them, the frames can be taken with i2s_capture_take as
+* packet buffers (pbuf.h) that refer to the ring buffer, to be handed to
+* other drivers without a copy. Freeing the buffer of a frame releases it,
+* so the buffers must be freed in the order they were taken, before the DMA
+* comes back to their frame.
+*
+* dma_init() must be called before, and the handler of the window done
+* interrupt of the DMA must not be overridden.
+*
+* A capture can run together with a playback (i2s_playback.h) of the same
+* sample rate and word length, each on its own DMA channel: the I2S clocks
+* are started by the first one and stopped by the last one.
+*
+* A microphone array on a TDM bus is captured by setting the TDM frame in
+* the configuration: the samples of the enabled slots are interleaved in slot
+* order, and can be tagged with their slot (I2S_TDM_SLOT) to check the
+* order after a lost sample. The DMA cannot de-interleave them, its 2D
+* increments are only forward. A TDM capture cannot run with a playback.
+*/
+
+#ifndef _DRIVERS_I2S_CAPTURE_H_
+#define _DRIVERS_I2S_CAPTURE_H_
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2s.h"
+#include "dma.h"
+#include "pbuf.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+struct i2s_capture;
+
+/**
+ * Called from the DMA interrupt when a frame has been filled.
+ *
+ * @param capture the capture
+ * @param frame the samples of the frame
+ */
+typedef void (*i2s_capture_cb_t)(struct i2s_capture *capture, const void *frame);
+
+
+typedef struct i2s_capture_cfg {
+  /**
+   * Sample rate of each channel or slot, the I2S clock is divided from the system
+   * clock to the closest one.
+   */
+  uint32_t sample_rate_hz;
+  /**
+   * Word length of the samples (see i2s_word_length_t).
+   */
+  i2s_word_length_t word_length;
+  /**
+   * Channels to capture, not I2S_DISABLE (see i2s_channel_sel_t), ignored in
+   * TDM mode.
+   */
+  i2s_channel_sel_t channels;
+  /**
+   * TDM frame, or 0 slots (the default) for the left and right channels.
+   * The slot width is at least the word length, and the samples are stored
+   * in 32-bit words when tagged.
+   */
+  i2s_tdm_cfg_t tdm;
+  /**
+   * Samples per channel or slot in a frame.
+   */
+  uint32_t frame_len;
+  /**
+   * Frames of the ring buffer, at least 2.
+   */
+  uint32_t frames;
+  /**
+   * The ring buffer, of frames * i2s_capture_frame_size() bytes, word aligned.
+   */
+  void *buffer;
+  /**
+   * DMA channel of the capture.
+   */
+  uint8_t dma_ch;
+  /**
+   * Frame callback, it may be NULL.
+   */
+  i2s_capture_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+} i2s_capture_cfg_t;
+
+
+typedef struct i2s_capture_stats {
+  /**
+   * Frames filled since the start.
+   */
+  uint32_t frames;
+  /**
+   * Frames overwritten by the DMA before they were released.
+   */
+  uint32_t overruns;
+  /**
+   * The RX FIFO of the I2S overflowed, i.e. samples were lost because the
+   * DMA could not keep up. It is sticky until i2s_capture_stop.
+   */
+  bool fifo_overflow;
+} i2s_capture_stats_t;
+
+
+/**
+ * A capture. Its fields are managed by the functions below.
+ */
+typedef struct i2s_capture {
+  i2s_capture_cfg_t cfg;
+  dma_target_t src;
+  dma_target_t dst;
+  dma_trans_t trans;
+  dma_stream_t stream;
+  uint32_t taken;  /*!< Frames taken with i2s_capture_take. */
+} i2s_capture_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Size of a frame in the ring buffer
+ *
+ * @param cfg the configuration of the capture
+ * @return size_t size in bytes
+ */
+size_t i2s_capture_frame_size(const i2s_capture_cfg_t *cfg);
+
+/**
+ * Starts the I2S clocks, the stream of the DMA and the RX channels
+ *
+ * @param capture the capture, it must be a static variable
+ * @param cfg configuration, copied
+ *
+ * @return kI2sOk success
+ * @return kI2sError I2S already running with other parameters, wrong
+ * configuration or DMA error
+ */
+i2s_result_t i2s_capture_start(i2s_capture_t *capture, const i2s_capture_cfg_t *cfg);
+
+/**
+ * Stops the DMA, the RX channels and the I2S clocks if no playback runs
+ *
+ * Returns once the DMA has filled the ring buffer up to its end, the frames
+ * filled in the meantime are delivered as usual.
+ *
+ * @return kI2sOk success
+ * @return kI2sOverflow the RX FIFO overflowed during the capture
+ */
+i2s_result_t i2s_capture_stop(i2s_capture_t *capture);
+
+/**
+ * Gets the oldest frame filled and not released yet
+ *
+ * @return pointer to the samples, NULL if there is none
+ */
+const void *i2s_capture_peek(i2s_capture_t *capture);
+
+/**
+ * Releases the oldest filled frame, so that the DMA can fill it again
+ */
+void i2s_capture_release(i2s_capture_t *capture);
+
+/**
+ * Takes the oldest frame filled and not taken yet as a packet buffer
+ *
+ * The buffer refers to the frame in the ring buffer, which is released when
+ * the buffer is freed. Do not mix it with i2s_capture_peek.
+ *
+ * @param pool the pool of the buffer, its data is not used
+ * @return the buffer, NULL if there is no frame or no free buffer, or if the
+ * frames are larger than 65535 bytes
+ */
+pbuf_t *i2s_capture_take(i2s_capture_t *capture, pbuf_pool_t *pool);
+
+/**
+ * Reads the counters of the capture
+ *
+ * @param stats the counters
+ */
+void i2s_capture_get_stats(i2s_capture_t *capture, i2s_capture_stats_t *stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_I2S_CAPTURE_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
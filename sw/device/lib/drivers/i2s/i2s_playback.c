@@ -0,0 +1,193 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : i2s_playback.c                                               **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   i2s_playback.c
+* @date   14/10/2026
+* @brief  Continuous audio playback to the I2S peripheral with the DMA
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "i2s_playback.h"
+
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Window done callback of the stream, calls the frame callback
+ */
+static void i2s_playback_frame_done(dma_stream_t *stream, uint32_t slot);
+
+/**
+ * DMA data type of the samples of a word length
+ */
+static dma_data_type_t i2s_playback_type(i2s_word_length_t word_length);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+size_t i2s_playback_frame_size(const i2s_playback_cfg_t *cfg)
+{
+  size_t channels = (cfg->channels == I2S_BOTH_CH) ? 2 : 1;
+  return cfg->frame_len * channels * DMA_DATA_TYPE_2_SIZE(i2s_playback_type(cfg->word_length));
+}
+
+i2s_result_t i2s_playback_start(i2s_playback_t *playback, const i2s_playback_cfg_t *cfg)
+{
+  if (cfg->channels == I2S_DISABLE || cfg->frames < 2 || cfg->frame_len == 0
+      || cfg->sample_rate_hz == 0 || cfg->buffer == NULL || ((uint32_t) cfg->buffer & 3)) {
+    return kI2sError;
+  }
+  playback->cfg = *cfg;
+
+  // each channel takes word_length SCK periods of the WS period
+  soc_ctrl_t soc_ctrl;
+  soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+  uint32_t word_bits = 8 * (cfg->word_length + 1);
+  uint32_t sck_hz = cfg->sample_rate_hz * 2 * word_bits;
+  uint32_t div = (soc_ctrl_get_frequency(&soc_ctrl) + sck_hz / 2) / sck_hz;
+  if (div > I2S_CLKDIVIDX_COUNT_MASK) {
+    return kI2sError;
+  }
+
+  i2s_result_t res = i2s_init_shared((uint16_t) div, cfg->word_length);
+  if (res != kI2sOk) {
+    return res;
+  }
+
+  dma_data_type_t type = i2s_playback_type(cfg->word_length);
+  size_t frame_size = i2s_playback_frame_size(cfg);
+
+  playback->src = (dma_target_t) {
+    .ptr     = cfg->buffer,
+    .inc_du  = 1,
+    .size_du = cfg->frames * frame_size / DMA_DATA_TYPE_2_SIZE(type),
+    .trig    = DMA_TRIG_MEMORY,
+    .type    = type,
+  };
+  // TXDATA only takes whole words
+  playback->dst = (dma_target_t) {
+    .ptr    = (uint8_t *) I2S_TX_DATA_ADDRESS,
+    .inc_du = 0,
+    .trig   = DMA_TRIG_SLOT_I2S_TX,
+    .type   = DMA_DATA_TYPE_WORD,
+  };
+  playback->trans = (dma_trans_t) {
+    .src     = &playback->src,
+    .dst     = &playback->dst,
+    .conv    = (type == DMA_DATA_TYPE_WORD) ? DMA_TYPE_CONV_NONE : DMA_TYPE_CONV_ZERO_EXT,
+    .channel = cfg->dma_ch,
+  };
+
+  // the DMA fills the TX FIFO before the TX channels are enabled
+  if (dma_stream_start(&playback->stream, &playback->trans, cfg->frames,
+                       i2s_playback_frame_done, playback) & DMA_CONFIG_CRITICAL_ERROR) {
+    i2s_terminate_if_idle();
+    return kI2sError;
+  }
+
+  res = i2s_tx_start(cfg->channels);
+  if (res != kI2sOk) {
+    dma_stream_stop(&playback->stream);
+    i2s_terminate_if_idle();
+  }
+  return res;
+}
+
+i2s_result_t i2s_playback_stop(i2s_playback_t *playback)
+{
+  // the DMA cannot be aborted, so it plays the ring buffer up to its end
+  // before the TX channels are stopped
+  dma_stream_stop(&playback->stream);
+  while (!dma_is_ready(playback->cfg.dma_ch)) ;
+  i2s_result_t res = i2s_tx_stop();
+  i2s_terminate_if_idle();
+  return res;
+}
+
+void *i2s_playback_peek(i2s_playback_t *playback)
+{
+  return dma_stream_peek(&playback->stream);
+}
+
+void i2s_playback_release(i2s_playback_t *playback)
+{
+  dma_stream_release(&playback->stream);
+}
+
+void i2s_playback_get_stats(i2s_playback_t *playback, i2s_playback_stats_t *stats)
+{
+  stats->frames = playback->stream.produced;
+  stats->underruns = playback->stream.overruns;
+  stats->fifo_underflow = i2s_tx_underflow();
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void i2s_playback_frame_done(dma_stream_t *stream, uint32_t slot)
+{
+  i2s_playback_t *playback = (i2s_playback_t *) stream->ctx;
+  if (playback->cfg.cb != NULL) {
+    playback->cfg.cb(playback, dma_stream_ring(stream) + slot * stream->slot_b);
+  }
+}
+
+static dma_data_type_t i2s_playback_type(i2s_word_length_t word_length)
+{
+  switch (word_length) {
+    case I2S_08_BITS:
+      return DMA_DATA_TYPE_BYTE;
+    case I2S_16_BITS:
+      return DMA_DATA_TYPE_HALF_WORD;
+    default:
+      return DMA_DATA_TYPE_WORD;
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
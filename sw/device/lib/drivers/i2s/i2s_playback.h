@@ -0,0 +1,227 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : i2s_playback.h                                               **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   i2s_playback.h
+* @date   14/10/2026
+* @brief  Continuous audio playback to the I2S peripheral with the DMA
+*
+* The DMA moves the samples from a ring buffer of frames to the TX FIFO of
+* the I2S, triggered by the I2S TX slot, as a dma_stream_t: the CPU writes no
+* sample. At the end of each frame the window done interrupt of the DMA calls
+* the frame callback, and the application gets the oldest played frames with
+* i2s_playback_peek, writes the next samples in them and gives them back with
+* i2s_playback_release, from the callback or later. The frames that are not
+* released in time are played again and counted.
+*
+* The samples of both channels are interleaved, left first. They are stored
+* in 8, 16 or 32-bit words depending on the word length, as for i2s_capture,
+* and the DMA writes them to the I2S as 32-bit words.
+*
+* A playback can run together with a capture (i2s_capture.h) of the same
+* sample rate and word length, each on its own DMA channel, e.g. to cancel
+* the echo of the played samples in the captured ones. The data of the I2S
+* TX is on the SD pad when the RX is not enabled, and always on the i2s_sdo
+* option of the pad mux of pdm2pcm_clk.
+*
+* dma_init() must be called before, and the handler of the window done
+* interrupt of the DMA must not be overridden.
+*/
+
+#ifndef _DRIVERS_I2S_PLAYBACK_H_
+#define _DRIVERS_I2S_PLAYBACK_H_
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2s.h"
+#include "dma.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+struct i2s_playback;
+
+/**
+ * Called from the DMA interrupt when a frame has been played.
+ *
+ * @param playback the playback
+ * @param frame the samples of the frame, to be written again
+ */
+typedef void (*i2s_playback_cb_t)(struct i2s_playback *playback, void *frame);
+
+
+typedef struct i2s_playback_cfg {
+  /**
+   * Sample rate of each channel, the I2S clock is divided from the system
+   * clock to the closest one.
+   */
+  uint32_t sample_rate_hz;
+  /**
+   * Word length of the samples (see i2s_word_length_t).
+   */
+  i2s_word_length_t word_length;
+  /**
+   * Channels to play, not I2S_DISABLE (see i2s_channel_sel_t).
+   */
+  i2s_channel_sel_t channels;
+  /**
+   * Samples per channel in a frame.
+   */
+  uint32_t frame_len;
+  /**
+   * Frames of the ring buffer, at least 2.
+   */
+  uint32_t frames;
+  /**
+   * The ring buffer, of frames * i2s_playback_frame_size() bytes, word
+   * aligned. It holds the first frames to play when the playback starts.
+   */
+  void *buffer;
+  /**
+   * DMA channel of the playback.
+   */
+  uint8_t dma_ch;
+  /**
+   * Frame callback, it may be NULL.
+   */
+  i2s_playback_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+} i2s_playback_cfg_t;
+
+
+typedef struct i2s_playback_stats {
+  /**
+   * Frames played since the start.
+   */
+  uint32_t frames;
+  /**
+   * Frames played again because they were not released in time.
+   */
+  uint32_t underruns;
+  /**
+   * The TX FIFO of the I2S underflowed, i.e. zeros were sent because the
+   * DMA could not keep up. It is sticky until i2s_playback_stop.
+   */
+  bool fifo_underflow;
+} i2s_playback_stats_t;
+
+
+/**
+ * A playback. Its fields are managed by the functions below.
+ */
+typedef struct i2s_playback {
+  i2s_playback_cfg_t cfg;
+  dma_target_t src;
+  dma_target_t dst;
+  dma_trans_t trans;
+  dma_stream_t stream;
+} i2s_playback_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Size of a frame in the ring buffer
+ *
+ * @param cfg the configuration of the playback
+ * @return size_t size in bytes
+ */
+size_t i2s_playback_frame_size(const i2s_playback_cfg_t *cfg);
+
+/**
+ * Starts the I2S clocks, the stream of the DMA and the TX channels
+ *
+ * @param playback the playback, it must be a static variable
+ * @param cfg configuration, copied
+ *
+ * @return kI2sOk success
+ * @return kI2sError I2S already running with other parameters, wrong
+ * configuration or DMA error
+ */
+i2s_result_t i2s_playback_start(i2s_playback_t *playback, const i2s_playback_cfg_t *cfg);
+
+/**
+ * Stops the DMA, the TX channels and the I2S clocks if no capture runs
+ *
+ * Returns once the ring buffer has been played up to its end, the frames
+ * played in the meantime are delivered as usual.
+ *
+ * @return kI2sOk success
+ * @return kI2sUnderflow the TX FIFO underflowed during the playback
+ */
+i2s_result_t i2s_playback_stop(i2s_playback_t *playback);
+
+/**
+ * Gets the oldest frame played and not released yet
+ *
+ * @return pointer to the samples, NULL if there is none
+ */
+void *i2s_playback_peek(i2s_playback_t *playback);
+
+/**
+ * Releases the oldest played frame, once its next samples are written
+ */
+void i2s_playback_release(i2s_playback_t *playback);
+
+/**
+ * Reads the counters of the playback
+ *
+ * @param stats the counters
+ */
+void i2s_playback_get_stats(i2s_playback_t *playback, i2s_playback_stats_t *stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_I2S_PLAYBACK_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -51,12 +51,23 @@ extern "C" {
 #define I2S_CONTROL_DATA_WIDTH_VALUE_32_BITS 0x3
 #define I2S_CONTROL_RX_START_CHANNEL_BIT 10
 #define I2S_CONTROL_RESET_RX_OVERFLOW_BIT 11
+#define I2S_CONTROL_EN_TX_MASK 0x3
+#define I2S_CONTROL_EN_TX_OFFSET 12
+#define I2S_CONTROL_EN_TX_FIELD \
+  ((bitfield_field32_t) { .mask = I2S_CONTROL_EN_TX_MASK, .index = I2S_CONTROL_EN_TX_OFFSET })
+#define I2S_CONTROL_EN_TX_VALUE_DISABLED 0x0
+#define I2S_CONTROL_EN_TX_VALUE_ONLY_LEFT 0x1
+#define I2S_CONTROL_EN_TX_VALUE_ONLY_RIGHT 0x2
+#define I2S_CONTROL_EN_TX_VALUE_BOTH_CHANNELS 0x3
+#define I2S_CONTROL_RESET_TX_UNDERFLOW_BIT 14
 
 // Status flags of the I2s peripheral
 #define I2S_STATUS_REG_OFFSET 0x4
 #define I2S_STATUS_RUNNING_BIT 0
 #define I2S_STATUS_RX_DATA_READY_BIT 1
 #define I2S_STATUS_RX_OVERFLOW_BIT 2
+#define I2S_STATUS_TX_READY_BIT 3
+#define I2S_STATUS_TX_UNDERFLOW_BIT 4
 
 // Control register
 #define I2S_CLKDIVIDX_REG_OFFSET 0x8
@@ -82,6 +93,30 @@ extern "C" {
 #define I2S_WATERLEVEL_WATERLEVEL_FIELD \
   ((bitfield_field32_t) { .mask = I2S_WATERLEVEL_WATERLEVEL_MASK, .index = I2S_WATERLEVEL_WATERLEVEL_OFFSET })
 
+// I2s Transmit data
+#define I2S_TXDATA_REG_OFFSET 0x18
+
+// Time division multiplexing of the rx channel
+#define I2S_TDM_REG_OFFSET 0x1c
+#define I2S_TDM_EN_BIT 0
+#define I2S_TDM_SLOTS_MASK 0xf
+#define I2S_TDM_SLOTS_OFFSET 1
+#define I2S_TDM_SLOTS_FIELD \
+  ((bitfield_field32_t) { .mask = I2S_TDM_SLOTS_MASK, .index = I2S_TDM_SLOTS_OFFSET })
+#define I2S_TDM_SLOT_WIDTH_MASK 0x3
+#define I2S_TDM_SLOT_WIDTH_OFFSET 5
+#define I2S_TDM_SLOT_WIDTH_FIELD \
+  ((bitfield_field32_t) { .mask = I2S_TDM_SLOT_WIDTH_MASK, .index = I2S_TDM_SLOT_WIDTH_OFFSET })
+#define I2S_TDM_SLOT_WIDTH_VALUE_8_BITS 0x0
+#define I2S_TDM_SLOT_WIDTH_VALUE_16_BITS 0x1
+#define I2S_TDM_SLOT_WIDTH_VALUE_24_BITS 0x2
+#define I2S_TDM_SLOT_WIDTH_VALUE_32_BITS 0x3
+#define I2S_TDM_TAG_BIT 7
+#define I2S_TDM_SLOT_EN_MASK 0xffff
+#define I2S_TDM_SLOT_EN_OFFSET 16
+#define I2S_TDM_SLOT_EN_FIELD \
+  ((bitfield_field32_t) { .mask = I2S_TDM_SLOT_EN_MASK, .index = I2S_TDM_SLOT_EN_OFFSET })
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
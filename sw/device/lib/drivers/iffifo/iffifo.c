@@ -0,0 +1,245 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : iffifo.c                                                     **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   iffifo.c
+* @date   14/10/2026
+* @brief  HAL of the IFFIFO peripheral
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "iffifo.h"
+
+#include "mmio.h"
+#include "csr.h"
+#include "hart.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define iffifo_base mmio_region_from_addr((uintptr_t)IFFIFO_START_ADDRESS)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Validates and queues a transfer whose targets are set
+ */
+static iffifo_result_t iffifo_xfer_submit(iffifo_xfer_t *xfer, uint8_t dma_ch, iffifo_xfer_cb_t cb);
+
+/**
+ * Callback of the submission queue of the DMA, calls the transfer callback
+ */
+static void iffifo_xfer_end(dma_queue_entry_t *entry);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+__attribute__((weak)) void handler_irq_iffifo(uint32_t id)
+{
+  // Replace this function with a non-weak implementation, the interrupt is
+  // raised again as long as the watermark is reached
+  iffifo_set_interrupt(false);
+}
+
+iffifo_result_t iffifo_set_watermark(uint32_t count)
+{
+  if (count == 0 || count > IFFIFO_DEPTH) {
+    return kIffifoError;
+  }
+  mmio_region_write32(iffifo_base, IFFIFO_WATERMARK_REG_OFFSET, count);
+  return kIffifoOk;
+}
+
+void iffifo_set_interrupt(bool enable)
+{
+  // any write clears the pending interrupt
+  mmio_region_write32(iffifo_base, IFFIFO_INTERRUPTS_REG_OFFSET,
+                      enable << IFFIFO_INTERRUPTS_REACHED_BIT);
+}
+
+uint32_t iffifo_occupancy(void)
+{
+  return mmio_region_read32(iffifo_base, IFFIFO_OCCUPANCY_REG_OFFSET);
+}
+
+bool iffifo_is_empty(void)
+{
+  return mmio_region_get_bit32(iffifo_base, IFFIFO_STATUS_REG_OFFSET, IFFIFO_STATUS_EMPTY_BIT);
+}
+
+bool iffifo_is_full(void)
+{
+  return mmio_region_get_bit32(iffifo_base, IFFIFO_STATUS_REG_OFFSET, IFFIFO_STATUS_FULL_BIT);
+}
+
+bool iffifo_watermark_reached(void)
+{
+  return mmio_region_get_bit32(iffifo_base, IFFIFO_STATUS_REG_OFFSET, IFFIFO_STATUS_REACHED_BIT);
+}
+
+void iffifo_push(uint32_t word)
+{
+  mmio_region_write32(iffifo_base, IFFIFO_FIFO_IN_REG_OFFSET, word);
+}
+
+uint32_t iffifo_pop(void)
+{
+  return mmio_region_read32(iffifo_base, IFFIFO_FIFO_OUT_REG_OFFSET);
+}
+
+iffifo_result_t iffifo_push_buffer(iffifo_xfer_t *xfer, uint8_t dma_ch,
+                                   const uint32_t *buf, size_t len, iffifo_xfer_cb_t cb)
+{
+  if (buf == NULL || len == 0 || ((uintptr_t) buf & 3)) {
+    return kIffifoError;
+  }
+
+  xfer->mem = (dma_target_t) {
+    .ptr     = (uint8_t *) buf,
+    .inc_du  = 1,
+    .size_du = len,
+    .trig    = DMA_TRIG_MEMORY,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  // the DMA writes to the input while the FIFO is not full
+  xfer->fifo = (dma_target_t) {
+    .ptr     = (uint8_t *) IFFIFO_FIFO_IN_ADDRESS,
+    .inc_du  = 0,
+    .trig    = DMA_TRIG_SLOT_EXT_TX,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  xfer->trans = (dma_trans_t) {
+    .src     = &xfer->mem,
+    .dst     = &xfer->fifo,
+  };
+  return iffifo_xfer_submit(xfer, dma_ch, cb);
+}
+
+iffifo_result_t iffifo_pull_buffer(iffifo_xfer_t *xfer, uint8_t dma_ch,
+                                   uint32_t *buf, size_t len, iffifo_xfer_cb_t cb)
+{
+  if (buf == NULL || len == 0 || ((uintptr_t) buf & 3)) {
+    return kIffifoError;
+  }
+
+  // the DMA reads from the output while the FIFO is not empty
+  xfer->fifo = (dma_target_t) {
+    .ptr     = (uint8_t *) IFFIFO_FIFO_OUT_ADDRESS,
+    .inc_du  = 0,
+    .size_du = len,
+    .trig    = DMA_TRIG_SLOT_EXT_RX,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  xfer->mem = (dma_target_t) {
+    .ptr     = (uint8_t *) buf,
+    .inc_du  = 1,
+    .trig    = DMA_TRIG_MEMORY,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  xfer->trans = (dma_trans_t) {
+    .src     = &xfer->fifo,
+    .dst     = &xfer->mem,
+  };
+  return iffifo_xfer_submit(xfer, dma_ch, cb);
+}
+
+iffifo_result_t iffifo_xfer_status(const iffifo_xfer_t *xfer)
+{
+  return xfer->done ? kIffifoOk : kIffifoBusy;
+}
+
+void iffifo_xfer_wait(const iffifo_xfer_t *xfer)
+{
+  // interrupts are disabled between the check and the wfi so that the end of
+  // the transfer cannot be missed
+  while (!xfer->done) {
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    if (!xfer->done) {
+      wait_for_interrupt();
+    }
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static iffifo_result_t iffifo_xfer_submit(iffifo_xfer_t *xfer, uint8_t dma_ch, iffifo_xfer_cb_t cb)
+{
+  xfer->trans.channel = dma_ch;
+  xfer->cb = cb;
+  xfer->done = false;
+
+  if (dma_validate_transaction(&xfer->trans, DMA_DO_NOT_ENABLE_REALIGN,
+                               DMA_PERFORM_CHECKS_INTEGRITY) & DMA_CONFIG_CRITICAL_ERROR) {
+    return kIffifoError;
+  }
+
+  xfer->entry = (dma_queue_entry_t) {
+    .trans = &xfer->trans,
+    .cb    = iffifo_xfer_end,
+    .ctx   = xfer,
+  };
+  if (dma_submit(&xfer->entry) != DMA_CONFIG_OK) {
+    return kIffifoError;
+  }
+  return kIffifoOk;
+}
+
+static void iffifo_xfer_end(dma_queue_entry_t *entry)
+{
+  iffifo_xfer_t *xfer = entry->ctx;
+  xfer->done = true;
+  if (xfer->cb != NULL) {
+    xfer->cb(xfer);
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -4,7 +4,7 @@
 **                            *******************                          **
 **                                                                         **
 ** project  : x-heep                                                       **
-** filename : i2s.h                                                        **
+** filename : iffifo.h                                                     **
 ** date     : 28/10/2023                                                   **
 **                                                                         **
 *****************************************************************************
@@ -25,6 +25,26 @@
 * @author Pierre Guillod
 * @brief  HAL of the IFFIFO peripheral
 *
+* The IFFIFO is an external peripheral of the testbench: the words written to
+* its input go through a FIFO of IFFIFO_DEPTH words and are read back from its
+* output incremented by one, as an accelerator attached to the DMA would
+* process them. The input triggers the DMA_TRIG_SLOT_EXT_TX slot of the DMA
+* while it is not full, the output the DMA_TRIG_SLOT_EXT_RX slot while it is
+* not empty.
+*
+* iffifo_push_buffer and iffifo_pull_buffer move whole buffers with the DMA,
+* through the submission queue of a channel (see dma_submit), so several
+* buffers can be queued in each direction. With a channel for each direction,
+* the input is fed while the output is drained, at the rate of the FIFO. With
+* a single channel, the transfers are performed one after the other, and a
+* push cannot be larger than the free words of the FIFO.
+*
+* The REACHED status is set while the FIFO holds at least the watermark words.
+* It raises the interrupt IFFIFO_INTR_ID of the PLIC when enabled by
+* iffifo_set_interrupt, whose handler is handler_irq_iffifo.
+*
+* dma_init() must be called before the transfers, and the handler of the
+* transaction done interrupt of the DMA must not be overridden.
 */
 
 #ifndef _DRIVERS_IFFIFO_H_
@@ -36,13 +56,208 @@
 /**                                                                        **/
 /****************************************************************************/
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "core_v_mini_mcu.h"
+#include "iffifo_regs.h"
+#include "dma.h"
+
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Address of the IFFIFO in the external peripherals of the testbench
+ */
+#define IFFIFO_START_ADDRESS (EXT_PERIPHERAL_START_ADDRESS + 0x2000)
+
+/**
+ * Addresses of the input and the output of the FIFO, to be passed to the DMA
+ */
+#define IFFIFO_FIFO_IN_ADDRESS  (uint32_t)(IFFIFO_FIFO_IN_REG_OFFSET+IFFIFO_START_ADDRESS)
+#define IFFIFO_FIFO_OUT_ADDRESS (uint32_t)(IFFIFO_FIFO_OUT_REG_OFFSET+IFFIFO_START_ADDRESS)
+
+/**
+ * Words of the FIFO
+ */
+#define IFFIFO_DEPTH 4
+
+/**
+ * Interrupt of the PLIC the testbench connects the IFFIFO to
+ */
+#define IFFIFO_INTR_ID EXT_INTR_1
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The result of an IFFIFO operation.
+ */
+typedef enum iffifo_result {
+  /**
+   * Indicates that the operation succeeded.
+   */
+  kIffifoOk = 0,
+  /**
+   * The transfer is still queued or running.
+   */
+  kIffifoBusy = 1,
+  /**
+   * A parameter is not valid, or the DMA rejected the transfer.
+   */
+  kIffifoError = 2,
+} iffifo_result_t;
+
+
+struct iffifo_xfer;
+
+/**
+ * Called from the DMA interrupt when a transfer is done. It may queue new
+ * transfers.
+ *
+ * @param xfer the transfer
+ */
+typedef void (*iffifo_xfer_cb_t)(struct iffifo_xfer *xfer);
+
+
+/**
+ * A transfer of a buffer to or from the FIFO. Its fields are managed by the
+ * functions below, except ctx.
+ */
+typedef struct iffifo_xfer {
+  dma_target_t mem;
+  dma_target_t fifo;
+  dma_trans_t trans;
+  dma_queue_entry_t entry;
+  iffifo_xfer_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+  volatile bool done;
+} iffifo_xfer_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Attends the plic interrupt. The default one disables the interrupt.
+ */
 __attribute__((weak)) void handler_irq_iffifo(uint32_t id);
 
+/**
+ * Sets the words in the FIFO from which the REACHED status is set
+ *
+ * @param count from 1 to IFFIFO_DEPTH
+ *
+ * @return kIffifoOk success
+ * @return kIffifoError count is not valid
+ */
+iffifo_result_t iffifo_set_watermark(uint32_t count);
+
+/**
+ * Enables or disables the interrupt raised when the watermark is reached
+ *
+ * A pending interrupt is cleared in both cases. It is raised again while the
+ * watermark is reached and the interrupt enabled.
+ */
+void iffifo_set_interrupt(bool enable);
+
+/**
+ * @return the words in the FIFO
+ */
+uint32_t iffifo_occupancy(void);
+
+/**
+ * @return true if the FIFO holds no word
+ */
+bool iffifo_is_empty(void);
+
+/**
+ * @return true if the FIFO holds IFFIFO_DEPTH words
+ */
+bool iffifo_is_full(void);
+
+/**
+ * @return true if the FIFO holds at least the watermark words
+ */
+bool iffifo_watermark_reached(void);
+
+/**
+ * Writes a word to the FIFO, without checking that it is not full
+ */
+void iffifo_push(uint32_t word);
+
+/**
+ * Reads a word from the FIFO, without checking that it is not empty
+ */
+uint32_t iffifo_pop(void);
+
+/**
+ * Queues the transfer of a buffer to the FIFO, triggered by the FIFO
+ *
+ * @param xfer the transfer, it must be a static variable and not be modified
+ * until it is done
+ * @param dma_ch DMA channel of the transfer
+ * @param buf the words to push, word aligned
+ * @param len the words to push, at least 1
+ * @param cb called when the buffer has been pushed, it may be NULL
+ *
+ * @return kIffifoOk success
+ * @return kIffifoError wrong parameters, or a transaction that was not queued
+ * runs on the channel
+ */
+iffifo_result_t iffifo_push_buffer(iffifo_xfer_t *xfer, uint8_t dma_ch,
+                                   const uint32_t *buf, size_t len, iffifo_xfer_cb_t cb);
+
+/**
+ * Queues the transfer of words from the FIFO to a buffer, triggered by the
+ * FIFO
+ *
+ * @param xfer the transfer, it must be a static variable and not be modified
+ * until it is done
+ * @param dma_ch DMA channel of the transfer
+ * @param buf the buffer, word aligned
+ * @param len the words to pull, at least 1
+ * @param cb called when the buffer has been filled, it may be NULL
+ *
+ * @return kIffifoOk success
+ * @return kIffifoError wrong parameters, or a transaction that was not queued
+ * runs on the channel
+ */
+iffifo_result_t iffifo_pull_buffer(iffifo_xfer_t *xfer, uint8_t dma_ch,
+                                   uint32_t *buf, size_t len, iffifo_xfer_cb_t cb);
+
+/**
+ * @return kIffifoOk the transfer is done
+ * @return kIffifoBusy the transfer is queued or running
+ */
+iffifo_result_t iffifo_xfer_status(const iffifo_xfer_t *xfer);
+
+/**
+ * Waits for a transfer to be done, with the core asleep in the meantime
+ */
+void iffifo_xfer_wait(const iffifo_xfer_t *xfer);
+
+
 #ifdef __cplusplus
 }
 #endif
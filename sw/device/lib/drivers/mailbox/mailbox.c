@@ -0,0 +1,126 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : mailbox.c                                                    **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   mailbox.c
+* @date   14/10/2026
+* @brief  HAL of the mailbox of the harts
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "mailbox.h"
+
+#include "core_v_mini_mcu.h"
+#include "mmio.h"
+#include "hart.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define mailbox_base mmio_region_from_addr((uintptr_t)MAILBOX_START_ADDRESS)
+
+/**
+ * The cv32e20 fetches its first instruction at 0x80 from the boot address,
+ * the other cores at the boot address.
+ */
+#ifdef CPU_TYPE_CV32E20
+#define MAILBOX_BOOT_OFFSET 0x80
+#else
+#define MAILBOX_BOOT_OFFSET 0
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            GLOBAL VARIABLES                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Entry point of crt0, which sends the secondary harts to hart_main.
+ */
+extern char _start[];
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void mailbox_hart_start(uint32_t hart)
+{
+  mmio_region_write32(mailbox_base, MAILBOX_HART_BOOT_ADDR_REG_OFFSET,
+                      (uint32_t)(uintptr_t)_start - MAILBOX_BOOT_OFFSET);
+  uint32_t enable = mmio_region_read32(mailbox_base, MAILBOX_HART_ENABLE_REG_OFFSET);
+  mmio_region_write32(mailbox_base, MAILBOX_HART_ENABLE_REG_OFFSET, enable | (1u << hart));
+}
+
+void mailbox_notify(uint32_t hart)
+{
+  mmio_region_write32(mailbox_base, MAILBOX_IRQ_SET_REG_OFFSET, 1u << hart);
+}
+
+void mailbox_irq_clear(void)
+{
+  mmio_region_write32(mailbox_base, MAILBOX_IRQ_CLEAR_REG_OFFSET, 1u << hart_get_id());
+}
+
+bool mailbox_irq_pending(void)
+{
+  uint32_t pending = mmio_region_read32(mailbox_base, MAILBOX_IRQ_PENDING_REG_OFFSET);
+  return (pending >> hart_get_id()) & 1;
+}
+
+bool mailbox_sem_try_take(uint32_t sem)
+{
+  // the read takes the semaphore if it returns 1
+  return mmio_region_read32(mailbox_base, MAILBOX_SEM_0_REG_OFFSET + 4 * sem) & 1;
+}
+
+void mailbox_sem_take(uint32_t sem)
+{
+  while (!mailbox_sem_try_take(sem)) {
+  }
+}
+
+void mailbox_sem_release(uint32_t sem)
+{
+  mmio_region_write32(mailbox_base, MAILBOX_SEM_RELEASE_REG_OFFSET, 1u << sem);
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
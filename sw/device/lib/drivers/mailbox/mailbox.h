@@ -0,0 +1,139 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : mailbox.h                                                    **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   mailbox.h
+* @date   14/10/2026
+* @brief  HAL of the mailbox of the harts
+*
+* In a multi-core X-HEEP (cpu_num of mcu_cfg.hjson greater than 1), hart 0
+* boots as usual and runs main, while the secondary harts wait for
+* mailbox_hart_start. A started hart goes through crt0, which gives it its
+* own stack, and then calls hart_main(hart_id) (see hart.h).
+*
+* The harts share the RAM through the system crossbar. They signal each
+* other with the mailbox interrupt of each hart, its machine software
+* interrupt (handler_irq_software), and protect the shared data with the
+* MAILBOX_SEM_NUM semaphores of the mailbox, which need no atomic
+* instructions.
+*/
+
+#ifndef _DRIVERS_MAILBOX_H_
+#define _DRIVERS_MAILBOX_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mailbox_regs.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                       DEFINITIONS AND MACROS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Semaphores of the mailbox.
+ */
+#define MAILBOX_SEM_NUM 4
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Starts a secondary hart, which calls hart_main(hart) with its own stack
+ *
+ * The data the hart reads must be written before, the hart starts right
+ * away. A hart is started once.
+ *
+ * @param hart the hart, from 1 to CPU_NUM - 1
+ */
+void mailbox_hart_start(uint32_t hart);
+
+/**
+ * Raises the mailbox interrupt of a hart
+ *
+ * @param hart the hart, from 0 to CPU_NUM - 1
+ */
+void mailbox_notify(uint32_t hart);
+
+/**
+ * Clears the mailbox interrupt of the calling hart, e.g. in its
+ * handler_irq_software
+ */
+void mailbox_irq_clear(void);
+
+/**
+ * @return true if the mailbox interrupt of the calling hart is pending
+ */
+bool mailbox_irq_pending(void);
+
+/**
+ * Takes a semaphore if it is free
+ *
+ * @param sem the semaphore, from 0 to MAILBOX_SEM_NUM - 1
+ *
+ * @return true if the semaphore is taken by the call
+ */
+bool mailbox_sem_try_take(uint32_t sem);
+
+/**
+ * Takes a semaphore, waiting for it to be released
+ *
+ * @param sem the semaphore, from 0 to MAILBOX_SEM_NUM - 1
+ */
+void mailbox_sem_take(uint32_t sem);
+
+/**
+ * Releases a semaphore
+ *
+ * @param sem the semaphore, from 0 to MAILBOX_SEM_NUM - 1
+ */
+void mailbox_sem_release(uint32_t sem);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_MAILBOX_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
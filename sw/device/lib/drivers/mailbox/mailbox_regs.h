@@ -0,0 +1,78 @@
+// Generated register defines for mailbox
+
+// Copyright information found in source file:
+// Copyright EPFL contributors.
+
+// Licensing information found in source file:
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _MAILBOX_REG_DEFS_
+#define _MAILBOX_REG_DEFS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Register width
+#define MAILBOX_PARAM_REG_WIDTH 32
+
+// Fetch enable of the secondary harts, one bit per hart.
+#define MAILBOX_HART_ENABLE_REG_OFFSET 0x0
+#define MAILBOX_HART_ENABLE_HART_ENABLE_MASK 0xf
+#define MAILBOX_HART_ENABLE_HART_ENABLE_OFFSET 0
+#define MAILBOX_HART_ENABLE_HART_ENABLE_FIELD \
+  ((bitfield_field32_t) { .mask = MAILBOX_HART_ENABLE_HART_ENABLE_MASK, .index = MAILBOX_HART_ENABLE_HART_ENABLE_OFFSET })
+
+// Boot address of the secondary harts, sampled when they are enabled
+#define MAILBOX_HART_BOOT_ADDR_REG_OFFSET 0x4
+
+// Raises the mailbox interrupt (machine software interrupt) of the harts
+// written 1
+#define MAILBOX_IRQ_SET_REG_OFFSET 0x8
+#define MAILBOX_IRQ_SET_IRQ_SET_MASK 0xf
+#define MAILBOX_IRQ_SET_IRQ_SET_OFFSET 0
+#define MAILBOX_IRQ_SET_IRQ_SET_FIELD \
+  ((bitfield_field32_t) { .mask = MAILBOX_IRQ_SET_IRQ_SET_MASK, .index = MAILBOX_IRQ_SET_IRQ_SET_OFFSET })
+
+// Clears the mailbox interrupt of the harts written 1
+#define MAILBOX_IRQ_CLEAR_REG_OFFSET 0xc
+#define MAILBOX_IRQ_CLEAR_IRQ_CLEAR_MASK 0xf
+#define MAILBOX_IRQ_CLEAR_IRQ_CLEAR_OFFSET 0
+#define MAILBOX_IRQ_CLEAR_IRQ_CLEAR_FIELD \
+  ((bitfield_field32_t) { .mask = MAILBOX_IRQ_CLEAR_IRQ_CLEAR_MASK, .index = MAILBOX_IRQ_CLEAR_IRQ_CLEAR_OFFSET })
+
+// Pending mailbox interrupts
+#define MAILBOX_IRQ_PENDING_REG_OFFSET 0x10
+#define MAILBOX_IRQ_PENDING_IRQ_PENDING_MASK 0xf
+#define MAILBOX_IRQ_PENDING_IRQ_PENDING_OFFSET 0
+#define MAILBOX_IRQ_PENDING_IRQ_PENDING_FIELD \
+  ((bitfield_field32_t) { .mask = MAILBOX_IRQ_PENDING_IRQ_PENDING_MASK, .index = MAILBOX_IRQ_PENDING_IRQ_PENDING_OFFSET })
+
+// Releases the semaphores written 1
+#define MAILBOX_SEM_RELEASE_REG_OFFSET 0x14
+#define MAILBOX_SEM_RELEASE_SEM_RELEASE_MASK 0xf
+#define MAILBOX_SEM_RELEASE_SEM_RELEASE_OFFSET 0
+#define MAILBOX_SEM_RELEASE_SEM_RELEASE_FIELD \
+  ((bitfield_field32_t) { .mask = MAILBOX_SEM_RELEASE_SEM_RELEASE_MASK, .index = MAILBOX_SEM_RELEASE_SEM_RELEASE_OFFSET })
+
+// Semaphore 0: reads 1 and takes it if it was free, 0 if it is taken.
+#define MAILBOX_SEM_0_REG_OFFSET 0x18
+#define MAILBOX_SEM_0_SEM_0_BIT 0
+
+// Semaphore 1, as SEM_0
+#define MAILBOX_SEM_1_REG_OFFSET 0x1c
+#define MAILBOX_SEM_1_SEM_1_BIT 0
+
+// Semaphore 2, as SEM_0
+#define MAILBOX_SEM_2_REG_OFFSET 0x20
+#define MAILBOX_SEM_2_SEM_2_BIT 0
+
+// Semaphore 3, as SEM_0
+#define MAILBOX_SEM_3_REG_OFFSET 0x24
+#define MAILBOX_SEM_3_SEM_3_BIT 0
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // _MAILBOX_REG_DEFS_
+// End generated register defines for mailbox
\ No newline at end of file
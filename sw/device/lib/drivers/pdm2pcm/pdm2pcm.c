@@ -0,0 +1,264 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : pdm2pcm.c                                                    **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pdm2pcm.c
+* @date   14/10/2026
+* @brief  HAL of the PDM2PCM peripheral
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "pdm2pcm.h"
+
+#include "core_v_mini_mcu.h"
+#include "mmio.h"
+#include "bitfield.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define PDM2PCM_COEFF_MASK 0x3ffff
+
+#define pdm2pcm_base mmio_region_from_addr((uintptr_t)PDM2PCM_START_ADDRESS)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Adds a register to a script
+ */
+static void pdm2pcm_script_add(pdm2pcm_cfg_script_t *script, ptrdiff_t offset, uint32_t value);
+
+/**
+ * Adds the coefficients of a filter, in its consecutive registers, to a script
+ */
+static void pdm2pcm_script_add_coeffs(pdm2pcm_cfg_script_t *script, ptrdiff_t offset,
+                                      const uint32_t *coeffs, size_t len);
+
+/**
+ * true if all the coefficients fit in 18 bits
+ */
+static bool pdm2pcm_coeffs_fit(const uint32_t *coeffs, size_t len);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+__attribute__((weak, optimize("O0"))) void handler_irq_pdm2pcm(uint32_t id)
+{
+ // Replace this function with a non-weak implementation
+}
+
+pdm2pcm_result_t pdm2pcm_load_config(const pdm2pcm_cfg_t *cfg)
+{
+  if (pdm2pcm_is_running()) {
+    return kPdm2pcmBusy;
+  }
+
+  pdm2pcm_cfg_script_t script;
+  if (pdm2pcm_config_script(cfg, &script) != kPdm2pcmOk) {
+    return kPdm2pcmError;
+  }
+  mmio_region_write_script32(pdm2pcm_base, &script.script);
+
+  return kPdm2pcmOk;
+}
+
+pdm2pcm_result_t pdm2pcm_config_script(const pdm2pcm_cfg_t *cfg, pdm2pcm_cfg_script_t *script)
+{
+  if (cfg->decim_cic > PDM2PCM_DECIMCIC_COUNT_MASK
+      || cfg->decim_hb1 > PDM2PCM_DECIMHB1_COUNT_MASK
+      || cfg->decim_hb2 > PDM2PCM_DECIMHB2_COUNT_MASK
+      || !pdm2pcm_coeffs_fit(cfg->hb1, PDM2PCM_HB1_COEFFS)
+      || !pdm2pcm_coeffs_fit(cfg->hb2, PDM2PCM_HB2_COEFFS)
+      || !pdm2pcm_coeffs_fit(cfg->fir, PDM2PCM_FIR_COEFFS)) {
+    return kPdm2pcmError;
+  }
+
+  script->script.offsets = script->offsets;
+  script->script.values = script->values;
+  script->script.count = 0;
+
+  pdm2pcm_script_add(script, PDM2PCM_CLKDIVIDX_REG_OFFSET, cfg->clkdiv);
+  pdm2pcm_script_add(script, PDM2PCM_DECIMCIC_REG_OFFSET, cfg->decim_cic);
+  pdm2pcm_script_add(script, PDM2PCM_DECIMHB1_REG_OFFSET, cfg->decim_hb1);
+  pdm2pcm_script_add(script, PDM2PCM_DECIMHB2_REG_OFFSET, cfg->decim_hb2);
+
+  pdm2pcm_script_add_coeffs(script, PDM2PCM_HB1COEF00_REG_OFFSET, cfg->hb1, PDM2PCM_HB1_COEFFS);
+  pdm2pcm_script_add_coeffs(script, PDM2PCM_HB2COEF00_REG_OFFSET, cfg->hb2, PDM2PCM_HB2_COEFFS);
+  pdm2pcm_script_add_coeffs(script, PDM2PCM_FIRCOEF00_REG_OFFSET, cfg->fir, PDM2PCM_FIR_COEFFS);
+
+  return kPdm2pcmOk;
+}
+
+pdm2pcm_result_t pdm2pcm_set_watermark(uint8_t count)
+{
+  if (count >= PDM2PCM_FIFO_DEPTH) {
+    return kPdm2pcmError;
+  }
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_REACHCOUNT_REG_OFFSET, count);
+  return kPdm2pcmOk;
+}
+
+pdm2pcm_result_t pdm2pcm_set_channels(uint8_t channels)
+{
+  if (pdm2pcm_is_running()) {
+    return kPdm2pcmBusy;
+  }
+  if (channels == 0 || channels > PDM2PCM_MAX_CHANNELS) {
+    return kPdm2pcmError;
+  }
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  control = bitfield_field32_write(control, PDM2PCM_CONTROL_CHANNELS_FIELD, channels - 1);
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control);
+  return kPdm2pcmOk;
+}
+
+uint8_t pdm2pcm_get_channels(void)
+{
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  return bitfield_field32_read(control, PDM2PCM_CONTROL_CHANNELS_FIELD) + 1;
+}
+
+void pdm2pcm_set_interrupt(bool enable)
+{
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  control = bitfield_bit32_write(control, PDM2PCM_CONTROL_INTR_EN_BIT, enable);
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control);
+}
+
+void pdm2pcm_start(void)
+{
+  pdm2pcm_clear();
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control | (1 << PDM2PCM_CONTROL_ENABL_BIT));
+}
+
+void pdm2pcm_stop(void)
+{
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control & ~(1 << PDM2PCM_CONTROL_ENABL_BIT));
+}
+
+void pdm2pcm_clear(void)
+{
+  // the FIFO is flushed while CLEAR is set
+  uint32_t control = mmio_region_read32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET);
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control | (1 << PDM2PCM_CONTROL_CLEAR_BIT));
+  mmio_region_write32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, control & ~(1 << PDM2PCM_CONTROL_CLEAR_BIT));
+}
+
+bool pdm2pcm_is_running(void)
+{
+  return mmio_region_get_bit32(pdm2pcm_base, PDM2PCM_CONTROL_REG_OFFSET, PDM2PCM_CONTROL_ENABL_BIT);
+}
+
+bool pdm2pcm_watermark_reached(void)
+{
+  return mmio_region_get_bit32(pdm2pcm_base, PDM2PCM_STATUS_REG_OFFSET, PDM2PCM_STATUS_REACH_BIT);
+}
+
+bool pdm2pcm_fifo_empty(void)
+{
+  return mmio_region_get_bit32(pdm2pcm_base, PDM2PCM_STATUS_REG_OFFSET, PDM2PCM_STATUS_EMPTY_BIT);
+}
+
+uint32_t pdm2pcm_read_sample(void)
+{
+  return mmio_region_read32(pdm2pcm_base, PDM2PCM_RXDATA_REG_OFFSET);
+}
+
+void pdm2pcm_read(uint32_t *samples, size_t len)
+{
+  size_t burst = mmio_region_read32(pdm2pcm_base, PDM2PCM_REACHCOUNT_REG_OFFSET) + 1;
+
+  while (len >= burst) {
+    while (!pdm2pcm_watermark_reached()) ;
+    for (size_t i = 0; i < burst; i++) {
+      *samples++ = pdm2pcm_read_sample();
+    }
+    len -= burst;
+  }
+
+  // the tail is shorter than a burst
+  while (len > 0) {
+    while (pdm2pcm_fifo_empty()) ;
+    *samples++ = pdm2pcm_read_sample();
+    len--;
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void pdm2pcm_script_add(pdm2pcm_cfg_script_t *script, ptrdiff_t offset, uint32_t value)
+{
+  script->offsets[script->script.count] = (uint32_t)offset;
+  script->values[script->script.count] = value;
+  script->script.count++;
+}
+
+static void pdm2pcm_script_add_coeffs(pdm2pcm_cfg_script_t *script, ptrdiff_t offset,
+                                      const uint32_t *coeffs, size_t len)
+{
+  for (size_t i = 0; i < len; i++) {
+    pdm2pcm_script_add(script, offset + i * sizeof(uint32_t), coeffs[i]);
+  }
+}
+
+static bool pdm2pcm_coeffs_fit(const uint32_t *coeffs, size_t len)
+{
+  for (size_t i = 0; i < len; i++) {
+    if (coeffs[i] & ~PDM2PCM_COEFF_MASK) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,289 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : pdm2pcm.h                                                    **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pdm2pcm.h
+* @date   14/10/2026
+* @brief  HAL of the PDM2PCM peripheral
+*
+* The decimation chain (CIC, two halfband filters and a FIR) is configured at
+* once from a pdm2pcm_cfg_t, typically a const table, by pdm2pcm_load_config.
+* The PCM samples are pushed in a FIFO of PDM2PCM_FIFO_DEPTH words, which is
+* read by bursts of the watermark set by pdm2pcm_set_watermark: once the
+* REACH status is set, the burst is read without polling the status between
+* the samples. The same status raises the PDM2PCM interrupt of the PLIC when
+* enabled by pdm2pcm_set_interrupt, and the FIFO triggers the
+* DMA_TRIG_SLOT_PDM2PCM slot of the DMA while it is not empty (see
+* pdm2pcm_capture.h). The samples are 18-bit, with the upper bits at 0.
+*
+* The PDM line carries two microphones, one driving it while the PDM clock is
+* low (channel 0, sampled before the rising edge), the other one while it is
+* high (channel 1). With pdm2pcm_set_channels(2), both channels are decimated
+* with the same filters and each PCM output is pushed as a frame of interleaved
+* samples, channel 0 first: a frame is pushed only if the FIFO has room for it
+* as a whole, so the samples of the FIFO always start with channel 0.
+*/
+
+#ifndef _DRIVERS_PDM2PCM_H_
+#define _DRIVERS_PDM2PCM_H_
+
+/**
+ * Address of the PCM data to be passed as address to the DMA
+ */
+#define PDM2PCM_RX_DATA_ADDRESS (uint32_t)(PDM2PCM_RXDATA_REG_OFFSET+PDM2PCM_START_ADDRESS)
+
+/**
+ * Words of the output FIFO
+ */
+#define PDM2PCM_FIFO_DEPTH 16
+
+/**
+ * Channels decimated by the peripheral, two on each PDM line
+ */
+#define PDM2PCM_MAX_CHANNELS 2
+
+/**
+ * Coefficients of each filter, in consecutive registers
+ */
+#define PDM2PCM_HB1_COEFFS 4
+#define PDM2PCM_HB2_COEFFS 7
+#define PDM2PCM_FIR_COEFFS 14
+
+/**
+ * Registers written by pdm2pcm_load_config
+ */
+#define PDM2PCM_CONFIG_REGS (4 + PDM2PCM_HB1_COEFFS + PDM2PCM_HB2_COEFFS + PDM2PCM_FIR_COEFFS)
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mmio.h"
+#include "pdm2pcm_regs.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The result of a PDM2PCM operation.
+ */
+typedef enum pdm2pcm_result {
+  /**
+   * Indicates that the operation succeeded.
+   */
+  kPdm2pcmOk = 0,
+  /**
+   * The peripheral is running.
+   */
+  kPdm2pcmBusy = 1,
+  /**
+   * A field of the configuration does not fit in its register.
+   */
+  kPdm2pcmError = 2,
+} pdm2pcm_result_t;
+
+
+/**
+ * Configuration of the decimation chain. All the fields are written to the
+ * registers by pdm2pcm_load_config.
+ */
+typedef struct pdm2pcm_cfg {
+  /**
+   * Division of the system clock to the PDM clock.
+   */
+  uint16_t clkdiv;
+  /**
+   * Samples counts after which to decimate after the CIC and each halfband
+   * filter.
+   */
+  uint8_t decim_cic;
+  uint8_t decim_hb1;
+  uint8_t decim_hb2;
+  /**
+   * The 18-bit coefficients of the filters.
+   */
+  uint32_t hb1[PDM2PCM_HB1_COEFFS];
+  uint32_t hb2[PDM2PCM_HB2_COEFFS];
+  uint32_t fir[PDM2PCM_FIR_COEFFS];
+} pdm2pcm_cfg_t;
+
+
+/**
+ * A configuration as a register script of the peripheral, e.g. for the DMA to
+ * write it with reg_script_apply (reg_script.h).
+ */
+typedef struct pdm2pcm_cfg_script {
+  uint32_t offsets[PDM2PCM_CONFIG_REGS];
+  uint32_t values[PDM2PCM_CONFIG_REGS];
+  /**
+   * The script of the two tables above.
+   */
+  mmio_region_script_t script;
+} pdm2pcm_cfg_script_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Attends the plic interrupt.
+ */
+__attribute__((weak, optimize("O0"))) void handler_irq_pdm2pcm(uint32_t id);
+
+/**
+ * Writes the clock divider, the decimations and the coefficients of all the
+ * filters
+ *
+ * @param cfg the configuration
+ *
+ * @return kPdm2pcmOk success
+ * @return kPdm2pcmBusy the peripheral is running, nothing is written
+ * @return kPdm2pcmError a field does not fit, nothing is written
+ */
+pdm2pcm_result_t pdm2pcm_load_config(const pdm2pcm_cfg_t *cfg);
+
+/**
+ * Builds the script of the registers written by pdm2pcm_load_config
+ *
+ * The script must only be applied while the peripheral is stopped, with the
+ * base PDM2PCM_START_ADDRESS.
+ *
+ * @param cfg the configuration
+ * @param script the script to fill, which points to its own tables
+ *
+ * @return kPdm2pcmOk success
+ * @return kPdm2pcmError a field does not fit
+ */
+pdm2pcm_result_t pdm2pcm_config_script(const pdm2pcm_cfg_t *cfg, pdm2pcm_cfg_script_t *script);
+
+/**
+ * Sets the samples in the FIFO above which the REACH status is set
+ *
+ * A burst of pdm2pcm_read is count + 1 samples.
+ *
+ * @param count less than PDM2PCM_FIFO_DEPTH
+ *
+ * @return kPdm2pcmOk success
+ * @return kPdm2pcmError count is too large
+ */
+pdm2pcm_result_t pdm2pcm_set_watermark(uint8_t count);
+
+/**
+ * Sets the channels interleaved in the FIFO
+ *
+ * With several channels, the watermark is best set to a multiple of the
+ * channels minus one, so that each burst of pdm2pcm_read holds whole frames.
+ *
+ * @param channels 1 (default) to PDM2PCM_MAX_CHANNELS
+ *
+ * @return kPdm2pcmOk success
+ * @return kPdm2pcmBusy the peripheral is running, nothing is written
+ * @return kPdm2pcmError wrong count of channels
+ */
+pdm2pcm_result_t pdm2pcm_set_channels(uint8_t channels);
+
+/**
+ * @return the channels interleaved in the FIFO
+ */
+uint8_t pdm2pcm_get_channels(void);
+
+/**
+ * Enables or disables the interrupt raised while the FIFO holds more samples
+ * than the watermark
+ *
+ * The interrupt is a level: the handler must read the samples, or disable it.
+ */
+void pdm2pcm_set_interrupt(bool enable);
+
+/**
+ * Flushes the FIFO and starts the decimation
+ */
+void pdm2pcm_start(void);
+
+/**
+ * Stops the decimation, the samples left in the FIFO can still be read
+ */
+void pdm2pcm_stop(void);
+
+/**
+ * Empties the FIFO
+ */
+void pdm2pcm_clear(void);
+
+/**
+ * @return true if the decimation runs
+ */
+bool pdm2pcm_is_running(void);
+
+/**
+ * @return true if the FIFO holds more samples than the watermark
+ */
+bool pdm2pcm_watermark_reached(void);
+
+/**
+ * @return true if the FIFO holds no sample
+ */
+bool pdm2pcm_fifo_empty(void);
+
+/**
+ * Reads a sample from the FIFO, without checking that it is not empty
+ */
+uint32_t pdm2pcm_read_sample(void);
+
+/**
+ * Reads samples, blocking, by bursts of the watermark
+ *
+ * @param samples the buffer
+ * @param len the samples to read
+ */
+void pdm2pcm_read(uint32_t *samples, size_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_PDM2PCM_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,152 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : pdm2pcm_capture.c                                            **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pdm2pcm_capture.c
+* @date   14/10/2026
+* @brief  Continuous PCM capture from the PDM2PCM peripheral with the DMA
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "pdm2pcm_capture.h"
+
+#include "core_v_mini_mcu.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Window done callback of the stream, calls the frame callback
+ */
+static void pdm2pcm_capture_frame_done(dma_stream_t *stream, uint32_t slot);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+pdm2pcm_result_t pdm2pcm_capture_start(pdm2pcm_capture_t *capture, const pdm2pcm_capture_cfg_t *cfg)
+{
+  if (cfg->filters == NULL || cfg->frames < 2 || cfg->frame_len == 0 || cfg->buffer == NULL) {
+    return kPdm2pcmError;
+  }
+  capture->cfg = *cfg;
+  if (capture->cfg.channels == 0) {
+    capture->cfg.channels = 1;
+  }
+
+  pdm2pcm_result_t res = pdm2pcm_load_config(cfg->filters);
+  if (res != kPdm2pcmOk) {
+    return res;
+  }
+  res = pdm2pcm_set_channels(capture->cfg.channels);
+  if (res != kPdm2pcmOk) {
+    return res;
+  }
+
+  capture->src = (dma_target_t) {
+    .ptr     = (uint8_t *) PDM2PCM_RX_DATA_ADDRESS,
+    .inc_du  = 0,
+    .size_du = cfg->frames * cfg->frame_len * capture->cfg.channels,
+    .trig    = DMA_TRIG_SLOT_PDM2PCM,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  capture->dst = (dma_target_t) {
+    .ptr    = (uint8_t *) cfg->buffer,
+    .inc_du = 1,
+    .trig   = DMA_TRIG_MEMORY,
+    .type   = DMA_DATA_TYPE_WORD,
+  };
+  capture->trans = (dma_trans_t) {
+    .src     = &capture->src,
+    .dst     = &capture->dst,
+    .channel = cfg->dma_ch,
+  };
+
+  // the DMA waits for the first sample before the decimation is started
+  if (dma_stream_start(&capture->stream, &capture->trans, cfg->frames,
+                       pdm2pcm_capture_frame_done, capture) & DMA_CONFIG_CRITICAL_ERROR) {
+    return kPdm2pcmError;
+  }
+
+  pdm2pcm_start();
+  return kPdm2pcmOk;
+}
+
+void pdm2pcm_capture_stop(pdm2pcm_capture_t *capture)
+{
+  // the DMA cannot be aborted, so it fills the ring buffer up to its end
+  // before the decimation is stopped
+  dma_stream_stop(&capture->stream);
+  while (!dma_is_ready(capture->cfg.dma_ch)) ;
+  pdm2pcm_stop();
+}
+
+const uint32_t *pdm2pcm_capture_peek(pdm2pcm_capture_t *capture)
+{
+  return (const uint32_t *) dma_stream_peek(&capture->stream);
+}
+
+void pdm2pcm_capture_release(pdm2pcm_capture_t *capture)
+{
+  dma_stream_release(&capture->stream);
+}
+
+void pdm2pcm_capture_get_stats(pdm2pcm_capture_t *capture, pdm2pcm_capture_stats_t *stats)
+{
+  stats->frames = capture->stream.produced;
+  stats->overruns = capture->stream.overruns;
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void pdm2pcm_capture_frame_done(dma_stream_t *stream, uint32_t slot)
+{
+  pdm2pcm_capture_t *capture = (pdm2pcm_capture_t *) stream->ctx;
+  if (capture->cfg.cb != NULL) {
+    capture->cfg.cb(capture, (const uint32_t *) (stream->trans->dst->ptr + slot * stream->slot_b));
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,199 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : pdm2pcm_capture.h                                            **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   pdm2pcm_capture.h
+* @date   14/10/2026
+* @brief  Continuous PCM capture from the PDM2PCM peripheral with the DMA
+*
+* The DMA moves the samples from the FIFO of the PDM2PCM to a ring buffer of
+* frames, triggered by the DMA_TRIG_SLOT_PDM2PCM slot while the FIFO is not
+* empty, as a dma_stream_t: the CPU reads no sample and can sleep between
+* the frames. At the end of each frame the window done interrupt of the DMA
+* calls the frame callback, and the application reads the oldest frames with
+* pdm2pcm_capture_peek and gives them back with pdm2pcm_capture_release. The
+* frames that are not released in time are overwritten and counted.
+*
+* The samples are stored in 32-bit words, as returned by pdm2pcm_read_sample.
+* With several channels, the samples of the channels are interleaved in each
+* frame, channel 0 first.
+*
+* dma_init() must be called before, and the handler of the window done
+* interrupt of the DMA must not be overridden.
+*/
+
+#ifndef _DRIVERS_PDM2PCM_CAPTURE_H_
+#define _DRIVERS_PDM2PCM_CAPTURE_H_
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pdm2pcm.h"
+#include "dma.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+struct pdm2pcm_capture;
+
+/**
+ * Called from the DMA interrupt when a frame has been filled.
+ *
+ * @param capture the capture
+ * @param frame the samples of the frame
+ */
+typedef void (*pdm2pcm_capture_cb_t)(struct pdm2pcm_capture *capture, const uint32_t *frame);
+
+
+typedef struct pdm2pcm_capture_cfg {
+  /**
+   * Configuration of the decimation chain, loaded by pdm2pcm_capture_start.
+   */
+  const pdm2pcm_cfg_t *filters;
+  /**
+   * Channels, see pdm2pcm_set_channels. 0 is taken as 1.
+   */
+  uint8_t channels;
+  /**
+   * Samples of each channel in a frame.
+   */
+  uint32_t frame_len;
+  /**
+   * Frames of the ring buffer, at least 2.
+   */
+  uint32_t frames;
+  /**
+   * The ring buffer, of frames * frame_len * channels words.
+   */
+  uint32_t *buffer;
+  /**
+   * DMA channel of the capture.
+   */
+  uint8_t dma_ch;
+  /**
+   * Frame callback, it may be NULL.
+   */
+  pdm2pcm_capture_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+} pdm2pcm_capture_cfg_t;
+
+
+typedef struct pdm2pcm_capture_stats {
+  /**
+   * Frames filled since the start.
+   */
+  uint32_t frames;
+  /**
+   * Frames overwritten by the DMA before they were released.
+   */
+  uint32_t overruns;
+} pdm2pcm_capture_stats_t;
+
+
+/**
+ * A capture. Its fields are managed by the functions below.
+ */
+typedef struct pdm2pcm_capture {
+  pdm2pcm_capture_cfg_t cfg;
+  dma_target_t src;
+  dma_target_t dst;
+  dma_trans_t trans;
+  dma_stream_t stream;
+} pdm2pcm_capture_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Loads the filters, starts the stream of the DMA and the decimation
+ *
+ * @param capture the capture, it must be a static variable
+ * @param cfg configuration, copied
+ *
+ * @return kPdm2pcmOk success
+ * @return kPdm2pcmBusy the peripheral is already running
+ * @return kPdm2pcmError wrong configuration or DMA error
+ */
+pdm2pcm_result_t pdm2pcm_capture_start(pdm2pcm_capture_t *capture, const pdm2pcm_capture_cfg_t *cfg);
+
+/**
+ * Stops the DMA and the decimation
+ *
+ * Returns once the DMA has filled the ring buffer up to its end, the frames
+ * filled in the meantime are delivered as usual.
+ */
+void pdm2pcm_capture_stop(pdm2pcm_capture_t *capture);
+
+/**
+ * Gets the oldest frame filled and not released yet
+ *
+ * @return pointer to the samples, NULL if there is none
+ */
+const uint32_t *pdm2pcm_capture_peek(pdm2pcm_capture_t *capture);
+
+/**
+ * Releases the oldest filled frame, so that the DMA can fill it again
+ */
+void pdm2pcm_capture_release(pdm2pcm_capture_t *capture);
+
+/**
+ * Reads the counters of the capture
+ *
+ * @param stats the counters
+ */
+void pdm2pcm_capture_get_stats(pdm2pcm_capture_t *capture, pdm2pcm_capture_stats_t *stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_PDM2PCM_CAPTURE_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
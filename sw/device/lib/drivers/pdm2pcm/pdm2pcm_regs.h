@@ -27,6 +27,11 @@ extern "C" {
 #define PDM2PCM_CONTROL_REG_OFFSET 0x4
 #define PDM2PCM_CONTROL_ENABL_BIT 0
 #define PDM2PCM_CONTROL_CLEAR_BIT 1
+#define PDM2PCM_CONTROL_INTR_EN_BIT 2
+#define PDM2PCM_CONTROL_CHANNELS_MASK 0x7
+#define PDM2PCM_CONTROL_CHANNELS_OFFSET 3
+#define PDM2PCM_CONTROL_CHANNELS_FIELD \
+  ((bitfield_field32_t) { .mask = PDM2PCM_CONTROL_CHANNELS_MASK, .index = PDM2PCM_CONTROL_CHANNELS_OFFSET })
 
 // Status register
 #define PDM2PCM_STATUS_REG_OFFSET 0x8
@@ -0,0 +1,111 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "clock_gate.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mmio.h"
+#include "csr.h"
+#include "irq.h"
+
+#include "power_manager_regs.h"  // Generated.
+
+static const power_manager_t *clock_gate_pm = NULL;
+static uint16_t clock_gate_refs[CLOCK_GATE_NUM_DOMAINS];
+static bool clock_gate_gated[CLOCK_GATE_NUM_DOMAINS];
+
+
+static ptrdiff_t clock_gate_reg(uint32_t domain)
+{
+    if (domain == CLOCK_GATE_PERIPH)
+        return (ptrdiff_t)POWER_MANAGER_PERIPH_CLK_GATE_REG_OFFSET;
+    if (domain < CLOCK_GATE_EXTERNAL(0))
+        return (ptrdiff_t)power_manager_ram_map[domain - CLOCK_GATE_RAM_BANK(0)].clk_gate;
+    return (ptrdiff_t)power_manager_external_map[domain - CLOCK_GATE_EXTERNAL(0)].clk_gate;
+}
+
+static void clock_gate_set(uint32_t domain, bool gated)
+{
+    mmio_region_write32(clock_gate_pm->base_addr, clock_gate_reg(domain), gated ? 0x1 : 0x0);
+    clock_gate_gated[domain] = gated;
+}
+
+power_manager_result_t clock_gate_init(const power_manager_t *power_manager)
+{
+    uint32_t mstatus;
+
+    if (power_manager == NULL)
+        return kPowerManagerError_e;
+
+    mstatus = irq_save();
+
+    clock_gate_pm = power_manager;
+    if (clock_gate_refs[CLOCK_GATE_PERIPH] == 0)
+        clock_gate_set(CLOCK_GATE_PERIPH, true);
+
+    irq_restore(mstatus);
+
+    return kPowerManagerOk_e;
+}
+
+power_manager_result_t clock_gate_acquire(uint32_t domain)
+{
+    uint32_t mstatus;
+
+    if (domain == CLOCK_GATE_NONE)
+        return kPowerManagerOk_e;
+    if (domain > CLOCK_GATE_NONE)
+        return kPowerManagerError_e;
+
+    mstatus = irq_save();
+
+    if (clock_gate_refs[domain]++ == 0 && clock_gate_gated[domain])
+        clock_gate_set(domain, false);
+
+    irq_restore(mstatus);
+
+    return kPowerManagerOk_e;
+}
+
+power_manager_result_t clock_gate_release(uint32_t domain)
+{
+    uint32_t mstatus;
+    power_manager_result_t res = kPowerManagerOk_e;
+
+    if (domain == CLOCK_GATE_NONE)
+        return kPowerManagerOk_e;
+    if (domain > CLOCK_GATE_NONE)
+        return kPowerManagerError_e;
+
+    mstatus = irq_save();
+
+    if (clock_gate_refs[domain] == 0)
+        res = kPowerManagerError_e;
+    else if (--clock_gate_refs[domain] == 0 && clock_gate_pm != NULL)
+        clock_gate_set(domain, true);
+
+    irq_restore(mstatus);
+
+    return res;
+}
+
+uint32_t clock_gate_count(uint32_t domain)
+{
+    return domain < CLOCK_GATE_NONE ? clock_gate_refs[domain] : 0;
+}
+
+bool clock_gate_is_gated(uint32_t domain)
+{
+    return domain < CLOCK_GATE_NONE && clock_gate_gated[domain];
+}
+
+uint32_t clock_gate_domain_of(uintptr_t address)
+{
+    if (address >= PERIPHERAL_START_ADDRESS && address < PERIPHERAL_END_ADDRESS)
+        return CLOCK_GATE_PERIPH;
+    return CLOCK_GATE_NONE;
+}
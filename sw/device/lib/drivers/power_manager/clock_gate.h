@@ -0,0 +1,92 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Reference-counted clock gating of the domains of the power manager.
+//
+// Each user of a domain, a driver or the application, acquires its clock
+// before using it and releases it when done: the clock of the domain is
+// enabled on the first acquisition and gated on the last release. The spi_host,
+// i2c, i2s and gpio drivers acquire the peripheral domain themselves while
+// their peripheral is enabled or configured, so an application only needs to
+// call clock_gate_init(): the peripheral domain is then gated whenever none of
+// them is in use.
+//
+// Before clock_gate_init() the references are counted but the clocks are never
+// gated, so the drivers behave as before for the applications that do not use
+// the manager. clock_gate_init() gates the peripheral domain if no one holds it;
+// the RAM banks and the external domains are only gated after their first
+// release, the program must not release a bank it runs from.
+//
+// The plic, the periph rv_timer and the spi2, i2c, i2s, gpio 8-31 are in the
+// peripheral domain: while it is gated, their registers must not be accessed
+// and the interrupts that go through the plic, e.g. of the UART, are not
+// delivered. An application that waits for such an interrupt holds the domain.
+
+#ifndef _CLOCK_GATE_H_
+#define _CLOCK_GATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "core_v_mini_mcu.h"
+#include "power_manager.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Domains: the peripheral domain, then the RAM banks, then the external
+ * domains.
+ */
+#define CLOCK_GATE_PERIPH           0
+#define CLOCK_GATE_RAM_BANK(bank)   (1 + (bank))
+#define CLOCK_GATE_EXTERNAL(ext)    (1 + MEMORY_BANKS + (ext))
+#define CLOCK_GATE_NUM_DOMAINS      (1 + MEMORY_BANKS + EXTERNAL_DOMAINS)
+
+/**
+ * Returned by clock_gate_domain_of() for an always-on address.
+ */
+#define CLOCK_GATE_NONE             CLOCK_GATE_NUM_DOMAINS
+
+/**
+ * Starts gating the clocks, the peripheral domain is gated now if it is not
+ * held.
+ */
+power_manager_result_t clock_gate_init(const power_manager_t *power_manager);
+
+/**
+ * Takes a reference on the clock of a domain, enabling it if it was gated.
+ * CLOCK_GATE_NONE is accepted and does nothing. Interrupt safe.
+ */
+power_manager_result_t clock_gate_acquire(uint32_t domain);
+
+/**
+ * Drops a reference, the clock is gated when none is left and the manager is
+ * initialized. Interrupt safe.
+ * @return kPowerManagerError_e if the domain is not held.
+ */
+power_manager_result_t clock_gate_release(uint32_t domain);
+
+uint32_t clock_gate_count(uint32_t domain);
+
+/**
+ * True if the clock of the domain is gated by the manager.
+ */
+bool clock_gate_is_gated(uint32_t domain);
+
+/**
+ * The domain of a peripheral from its address: CLOCK_GATE_PERIPH in the
+ * peripheral domain, CLOCK_GATE_NONE otherwise.
+ */
+uint32_t clock_gate_domain_of(uintptr_t address);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _CLOCK_GATE_H_
@@ -70,6 +70,28 @@ typedef struct monitor_signals {
   uint32_t kReset_e;
 } monitor_signals_t;
 
+/**
+ * States counted by the residency counters. The counters of a domain are
+ * consecutive registers in this order, the CPU and PERIPH domains have no
+ * retentive state.
+ */
+typedef enum power_manager_residency_state {
+  kResidencyActive_e    = 0, // clocked, for the CPU running
+  kResidencyClkGate_e   = 1, // clock-gated, for the CPU sleeping in wfi
+  kResidencyPowerGate_e = 2, // switched off
+  kResidencyRetentive_e = 3, // RAM in retentive mode
+  kResidencyNumStates_e = 4,
+} power_manager_residency_state_t;
+
+/**
+ * Cycles spent by a domain in each state since the counters were cleared.
+ * The counters wrap around at 2^32 cycles, the difference of two readings is
+ * right as long as they are less than that apart.
+ */
+typedef struct power_manager_residency {
+  uint32_t cycles[kResidencyNumStates_e];
+} power_manager_residency_t;
+
 /**
  * Initialization parameters for POWER MANAGER.
  *
@@ -103,6 +125,13 @@ typedef struct power_manager_ram_map_t {
   uint32_t iso;
   uint32_t retentive;
   uint32_t monitor_power_gate;
+  uint32_t residency;
+  /**
+   * Addresses held by the bank. The interleaved banks all hold the whole
+   * interleaved region.
+   */
+  uint32_t start_address;
+  uint32_t end_address;
 } power_manager_ram_map_t;
 
 static power_manager_ram_map_t power_manager_ram_map[${ram_numbanks}] = {
@@ -114,7 +143,15 @@ static power_manager_ram_map_t power_manager_ram_map[${ram_numbanks}] = {
     .wait_ack_switch = POWER_MANAGER_RAM_${bank}_WAIT_ACK_SWITCH_ON_REG_OFFSET,
     .iso = POWER_MANAGER_RAM_${bank}_ISO_REG_OFFSET,
     .retentive = POWER_MANAGER_RAM_${bank}_RETENTIVE_REG_OFFSET,
-    .monitor_power_gate = POWER_MANAGER_MONITOR_POWER_GATE_RAM_BLOCK_${bank}_REG_OFFSET
+    .monitor_power_gate = POWER_MANAGER_MONITOR_POWER_GATE_RAM_BLOCK_${bank}_REG_OFFSET,
+    .residency = POWER_MANAGER_RAM_${bank}_ACTIVE_CYCLES_REG_OFFSET,
+% if bank < ram_numbanks_cont:
+    .start_address = 0x${'{:08X}'.format(ram_banks[bank][0])},
+    .end_address = 0x${'{:08X}'.format(ram_banks[bank][0] + ram_banks[bank][1])}
+% else:
+    .start_address = 0x${'{:08X}'.format(ram_il_start)},
+    .end_address = 0x${'{:08X}'.format(ram_il_start + ram_il_size)}
+% endif
   },
 % endfor
 };
@@ -128,6 +165,7 @@ typedef struct power_manager_external_map_t {
   uint32_t iso;
   uint32_t retentive;
   uint32_t monitor_power_gate;
+  uint32_t residency;
 } power_manager_external_map_t;
 
 static power_manager_external_map_t power_manager_external_map[${external_domains}] = {
@@ -141,6 +179,7 @@ static power_manager_external_map_t power_manager_external_map[${external_domain
     .iso = POWER_MANAGER_EXTERNAL_${ext}_ISO_REG_OFFSET,
     .retentive = POWER_MANAGER_EXTERNAL_RAM_${ext}_RETENTIVE_REG_OFFSET,
     .monitor_power_gate = POWER_MANAGER_MONITOR_POWER_GATE_EXTERNAL_${ext}_REG_OFFSET,
+    .residency = POWER_MANAGER_EXTERNAL_${ext}_ACTIVE_CYCLES_REG_OFFSET,
   },
 % endfor
 };
@@ -169,6 +208,25 @@ monitor_signals_t monitor_power_gate_ram_block(const power_manager_t *power_mana
 
 monitor_signals_t monitor_power_gate_external(const power_manager_t *power_manager, uint32_t sel_external);
 
+/**
+ * Starts or stops the residency counters, they keep their values when
+ * stopped. They are stopped at reset.
+ */
+void residency_counters_enable(const power_manager_t *power_manager, uint32_t enable);
+
+/**
+ * Sets all the residency counters to 0, running or not.
+ */
+void residency_counters_clear(const power_manager_t *power_manager);
+
+power_manager_residency_t residency_core(const power_manager_t *power_manager);
+
+power_manager_residency_t residency_periph(const power_manager_t *power_manager);
+
+power_manager_residency_t residency_ram_block(const power_manager_t *power_manager, uint32_t sel_block);
+
+power_manager_residency_t residency_external(const power_manager_t *power_manager, uint32_t sel_external);
+
 
 #ifdef __cplusplus
 }
@@ -447,3 +447,44 @@ monitor_signals_t monitor_power_gate_external(const power_manager_t *power_manag
 
     return monitor_signals;
 }
+
+void residency_counters_enable(const power_manager_t *power_manager, uint32_t enable)
+{
+    mmio_region_write32(power_manager->base_addr, (ptrdiff_t)(POWER_MANAGER_RESIDENCY_EN_REG_OFFSET), enable ? 1 << POWER_MANAGER_RESIDENCY_EN_RESIDENCY_EN_BIT : 0x0);
+}
+
+void residency_counters_clear(const power_manager_t *power_manager)
+{
+    mmio_region_write32(power_manager->base_addr, (ptrdiff_t)(POWER_MANAGER_RESIDENCY_CLEAR_REG_OFFSET), 1 << POWER_MANAGER_RESIDENCY_CLEAR_RESIDENCY_CLEAR_BIT);
+}
+
+static power_manager_residency_t residency_read(const power_manager_t *power_manager, uint32_t first_offset, uint32_t num_states)
+{
+    power_manager_residency_t residency = {0};
+
+    for (uint32_t state = 0; state < num_states; state++) {
+        residency.cycles[state] = mmio_region_read32(power_manager->base_addr, (ptrdiff_t)(first_offset + state * sizeof(uint32_t)));
+    }
+
+    return residency;
+}
+
+power_manager_residency_t residency_core(const power_manager_t *power_manager)
+{
+    return residency_read(power_manager, POWER_MANAGER_CPU_ACTIVE_CYCLES_REG_OFFSET, kResidencyRetentive_e);
+}
+
+power_manager_residency_t residency_periph(const power_manager_t *power_manager)
+{
+    return residency_read(power_manager, POWER_MANAGER_PERIPH_ACTIVE_CYCLES_REG_OFFSET, kResidencyRetentive_e);
+}
+
+power_manager_residency_t residency_ram_block(const power_manager_t *power_manager, uint32_t sel_block)
+{
+    return residency_read(power_manager, power_manager_ram_map[sel_block].residency, kResidencyNumStates_e);
+}
+
+power_manager_residency_t residency_external(const power_manager_t *power_manager, uint32_t sel_external)
+{
+    return residency_read(power_manager, power_manager_external_map[sel_external].residency, kResidencyNumStates_e);
+}
@@ -0,0 +1,171 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "power_policy.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mmio.h"
+#include "csr.h"
+#include "irq.h"
+#include "hart.h"
+#include "clock_gate.h"
+
+#include "power_manager_regs.h"  // Generated.
+
+// the timer of the policy: hart 0, comparator 0, i.e. irq_timer of the core
+#define POWER_POLICY_TIMER_HART 0
+#define POWER_POLICY_TIMER_COMP 0
+#define POWER_POLICY_MIE_MTIE   (1 << 7)
+
+
+power_manager_result_t power_policy_init(power_policy_t *policy, const power_policy_cfg_t *cfg)
+{
+    if (cfg->power_manager == NULL || cfg->timer == NULL)
+        return kPowerManagerError_e;
+
+    policy->cfg = *cfg;
+    policy->cfg.allowed |= POWER_POLICY_STATE_MASK(kPowerPolicyWfi_e);
+
+    for (int s = 0; s < kPowerPolicyNumStates_e; s++)
+    {
+        // a deeper state cannot be cheaper to enter than a shallower one
+        if (s > 0 && cfg->states[s].break_even < cfg->states[s-1].break_even)
+            return kPowerManagerError_e;
+
+        policy->latency[s]             = cfg->states[s].latency;
+        policy->stats[s].entries       = 0;
+        policy->stats[s].early_wakeups = 0;
+        policy->stats[s].ticks         = 0;
+    }
+
+    return kPowerManagerOk_e;
+}
+
+power_policy_state_t power_policy_select(const power_policy_t *policy, uint32_t idle_ticks)
+{
+    // the peripheral domain is not gated while a driver holds its clock
+    bool periph_busy = clock_gate_count(CLOCK_GATE_PERIPH) > 0;
+
+    for (int s = kPowerPolicyNumStates_e - 1; s > kPowerPolicyWfi_e; s--)
+    {
+        if (periph_busy && (s == kPowerPolicyClkGate_e || s == kPowerPolicyPeriphGate_e))
+            continue;
+        if ((policy->cfg.allowed & POWER_POLICY_STATE_MASK(s)) &&
+            policy->cfg.states[s].break_even <= idle_ticks &&
+            policy->latency[s] < idle_ticks)
+            return (power_policy_state_t)s;
+    }
+
+    return kPowerPolicyWfi_e;
+}
+
+static void power_policy_wfi(void)
+{
+    uint32_t mie;
+
+    // wfi wakes up on a pending interrupt enabled in mie, even with
+    // mstatus.MIE cleared
+    CSR_READ(CSR_REG_MIE, &mie);
+    CSR_SET_BITS(CSR_REG_MIE, POWER_POLICY_MIE_MTIE);
+    wait_for_interrupt();
+    CSR_WRITE(CSR_REG_MIE, mie);
+}
+
+static void power_policy_enter(power_policy_t *policy, power_policy_state_t state)
+{
+    const power_manager_t *pm = policy->cfg.power_manager;
+
+    switch (state)
+    {
+        case kPowerPolicyClkGate_e:
+            mmio_region_write32(pm->base_addr, (ptrdiff_t)(POWER_MANAGER_PERIPH_CLK_GATE_REG_OFFSET), 0x1);
+            power_policy_wfi();
+            if (!clock_gate_is_gated(CLOCK_GATE_PERIPH))
+                mmio_region_write32(pm->base_addr, (ptrdiff_t)(POWER_MANAGER_PERIPH_CLK_GATE_REG_OFFSET), 0x0);
+            break;
+
+        case kPowerPolicyCoreGate_e:
+            if (power_gate_core(pm, kTimer_0_pm_e, &policy->cfg.cpu_counters) != kPowerManagerOk_e)
+                power_policy_wfi();
+            break;
+
+        case kPowerPolicyPeriphGate_e:
+            if (power_gate_periph(pm, kOff_e, &policy->cfg.periph_counters) != kPowerManagerOk_e)
+            {
+                power_policy_wfi();
+                break;
+            }
+            if (power_gate_core(pm, kTimer_0_pm_e, &policy->cfg.cpu_counters) != kPowerManagerOk_e)
+                power_policy_wfi();
+            power_gate_periph(pm, kOn_e, &policy->cfg.periph_counters);
+            if (policy->cfg.periph_restore != NULL)
+                policy->cfg.periph_restore();
+            break;
+
+        default:
+            power_policy_wfi();
+            break;
+    }
+}
+
+power_policy_state_t power_policy_idle(power_policy_t *policy, uint32_t idle_ticks)
+{
+    rv_timer_t *timer = policy->cfg.timer;
+    power_policy_state_t state;
+    uint64_t start, wakeup, end;
+    uint32_t mstatus;
+    bool expired = false;
+
+    mstatus = irq_save();
+
+    state = power_policy_select(policy, idle_ticks);
+
+    // wake up early enough to be running again at the end of the period
+    rv_timer_counter_read(timer, POWER_POLICY_TIMER_HART, &start);
+    wakeup = start + idle_ticks;
+    wakeup -= policy->latency[state] < idle_ticks ? policy->latency[state] : idle_ticks;
+
+    rv_timer_irq_clear(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP);
+    rv_timer_arm(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP, wakeup);
+    rv_timer_irq_enable(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP, kRvTimerEnabled);
+
+    power_policy_enter(policy, state);
+
+    rv_timer_counter_read(timer, POWER_POLICY_TIMER_HART, &end);
+    rv_timer_irq_get(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP, &expired);
+    rv_timer_irq_enable(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP, kRvTimerDisabled);
+    rv_timer_irq_clear(timer, POWER_POLICY_TIMER_HART, POWER_POLICY_TIMER_COMP);
+
+    // the time from the expiry of the timer to here is the wake-up latency,
+    // the largest one is kept so that the next deadlines are met
+    if (expired)
+    {
+        if (end > wakeup && end - wakeup > policy->latency[state])
+            policy->latency[state] = (uint32_t)(end - wakeup);
+    }
+    else
+    {
+        policy->stats[state].early_wakeups++;
+    }
+
+    policy->stats[state].entries++;
+    policy->stats[state].ticks += end - start;
+
+    irq_restore(mstatus);
+
+    return state;
+}
+
+uint32_t power_policy_latency(const power_policy_t *policy, power_policy_state_t state)
+{
+    return policy->latency[state];
+}
+
+const power_policy_stats_t *power_policy_get_stats(const power_policy_t *policy, power_policy_state_t state)
+{
+    return &policy->stats[state];
+}
@@ -0,0 +1,151 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Idle power policy on top of the power manager.
+//
+// Given how long the core is going to be idle, e.g. until the next event of
+// the application or the next tick of FreeRTOS, the policy enters the deepest
+// low-power state whose break-even time fits in the idle period, and programs
+// the timer 0 of the always-on rv_timer so that the core is running again at
+// the end of the period. The wake-up latency of each state is measured on
+// every wake-up, and the policy anticipates the wake-up by the largest
+// latency measured so far, so the deadline is met. With FreeRTOS, it is called
+// from portSUPPRESS_TICKS_AND_SLEEP() with the expected idle time converted to
+// ticks of the rv_timer.
+//
+// The timer 0 (hart 0, comparator 0) of the always-on rv_timer is the time
+// base and the wake-up source of the policy and must not be used by the
+// application. Its tick parameters must be set and its counter enabled
+// before the first call. In the gated states only the timer wakes the core up:
+// an application that must react to other interrupts while idle restricts
+// the policy to kPowerPolicyWfi_e with the allowed mask. The states that gate
+// the peripheral domain are skipped while a driver holds its clock
+// (clock_gate.h).
+
+#ifndef _POWER_POLICY_H_
+#define _POWER_POLICY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "power_manager.h"
+#include "rv_timer.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Low-power states, from the shallowest to the deepest.
+ */
+typedef enum power_policy_state {
+  kPowerPolicyWfi_e         = 0, // wfi, any enabled interrupt wakes up
+  kPowerPolicyClkGate_e     = 1, // wfi with the peripheral domain clock-gated
+  kPowerPolicyCoreGate_e    = 2, // core power-gated, its state retained in memory
+  kPowerPolicyPeriphGate_e  = 3, // core and peripheral domain power-gated
+  kPowerPolicyNumStates_e   = 4,
+} power_policy_state_t;
+
+#define POWER_POLICY_STATE_MASK(state) (1u << (state))
+
+/**
+ * Characterization of a state, in ticks of the rv_timer.
+ */
+typedef struct power_policy_state_cfg {
+  /**
+   * Shortest idle period for which the state saves energy compared to wfi:
+   * the energy of entering and leaving it divided by the power it saves.
+   */
+  uint32_t break_even;
+  /**
+   * Initial estimate of the wake-up latency, from the expiry of the timer to
+   * the return of power_policy_idle(). It is raised by the measurements.
+   */
+  uint32_t latency;
+} power_policy_state_cfg_t;
+
+/**
+ * Configuration of the policy.
+ */
+typedef struct power_policy_cfg {
+  const power_manager_t *power_manager;
+  /**
+   * The always-on rv_timer, initialized by the application.
+   */
+  rv_timer_t *timer;
+  /**
+   * Counters of the CPU and of the peripheral domain for the power manager.
+   */
+  power_manager_counters_t cpu_counters;
+  power_manager_counters_t periph_counters;
+  power_policy_state_cfg_t states[kPowerPolicyNumStates_e];
+  /**
+   * POWER_POLICY_STATE_MASK of the states the policy may enter. wfi is always
+   * allowed.
+   */
+  uint32_t allowed;
+  /**
+   * Called after the peripheral domain has been powered on again, to
+   * reconfigure its peripherals. It may be NULL.
+   */
+  void (*periph_restore)(void);
+} power_policy_cfg_t;
+
+/**
+ * Statistics of a state.
+ */
+typedef struct power_policy_stats {
+  uint32_t entries;
+  /**
+   * Wake-ups before the timer, by another interrupt.
+   */
+  uint32_t early_wakeups;
+  /**
+   * Ticks spent in the state, including the transitions.
+   */
+  uint64_t ticks;
+} power_policy_stats_t;
+
+/**
+ * A policy. Its fields are managed by the functions below.
+ */
+typedef struct power_policy {
+  power_policy_cfg_t cfg;
+  /**
+   * Largest wake-up latency measured, or the initial estimate.
+   */
+  uint32_t latency[kPowerPolicyNumStates_e];
+  power_policy_stats_t stats[kPowerPolicyNumStates_e];
+} power_policy_t;
+
+
+power_manager_result_t power_policy_init(power_policy_t *policy, const power_policy_cfg_t *cfg);
+
+/**
+ * Returns the deepest allowed state worth entering for idle_ticks: its
+ * break-even time and its wake-up latency both fit in the idle period.
+ */
+power_policy_state_t power_policy_select(const power_policy_t *policy, uint32_t idle_ticks);
+
+/**
+ * Sleeps for idle_ticks in the state chosen by power_policy_select() and
+ * returns it. The core is running again at the latest idle_ticks after the
+ * call, unless the wake-up latency of the state grew beyond its estimate, in
+ * which case the new latency is used from the next call on. In wfi, another
+ * enabled interrupt ends the sleep early; it is taken when this returns if
+ * mstatus.MIE was set, which is restored on return.
+ */
+power_policy_state_t power_policy_idle(power_policy_t *policy, uint32_t idle_ticks);
+
+uint32_t power_policy_latency(const power_policy_t *policy, power_policy_state_t state);
+
+const power_policy_stats_t *power_policy_get_stats(const power_policy_t *policy, power_policy_state_t state);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _POWER_POLICY_H_
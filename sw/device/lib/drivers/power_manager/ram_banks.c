@@ -0,0 +1,113 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ram_banks.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+#include "syscalls.h"
+
+#define RAM_BANKS_ALL ((uint32_t)((1ull << MEMORY_BANKS) - 1))
+
+// Provided by the linker scripts
+extern char __ram_code_start[], __ram_code_end[];
+extern char __ram_data_start[], __ram_data_end[];
+extern char __ram_il_start[], __ram_il_end[];
+extern char __heap_start[];
+extern char __arena_start[], __arena_end[];
+extern char __stack_start[], __stack_end[];
+extern char __fast_start[], __fast_end[];
+
+
+static uint32_t ram_banks_range(const char *start, const char *end)
+{
+    uint32_t banks = 0;
+
+    if (end <= start)
+        return 0;
+
+    for (int i = 0; i < MEMORY_BANKS; i++)
+    {
+        if ((uintptr_t)start < power_manager_ram_map[i].end_address &&
+            (uintptr_t)end > power_manager_ram_map[i].start_address)
+            banks |= 1u << i;
+    }
+
+    return banks;
+}
+
+void ram_banks_get_usage(ram_banks_usage_t *usage)
+{
+    usage->code        = ram_banks_range(__ram_code_start, __ram_code_end);
+    usage->data        = ram_banks_range(__ram_data_start, __ram_data_end);
+    usage->heap        = ram_banks_range(__heap_start, heap_high_water());
+    usage->arena       = ram_banks_range(__arena_start, __arena_end);
+    usage->stack       = ram_banks_range(__stack_start, __stack_end);
+    usage->interleaved = ram_banks_range(__ram_il_start, __ram_il_end);
+    usage->fast        = ram_banks_range(__fast_start, __fast_end);
+}
+
+uint32_t ram_banks_used(void)
+{
+    ram_banks_usage_t usage;
+
+    ram_banks_get_usage(&usage);
+
+    return usage.code | usage.data | usage.heap | usage.arena | usage.stack | usage.interleaved | usage.fast;
+}
+
+uint32_t ram_banks_unused(void)
+{
+    return ~ram_banks_used() & RAM_BANKS_ALL;
+}
+
+uint32_t ram_banks_holding(const void *start, size_t size)
+{
+    return ram_banks_range(start, (const char *)start + size);
+}
+
+power_manager_result_t power_gate_ram_banks(const power_manager_t *power_manager, uint32_t banks, power_manager_sel_state_t sel_state, power_manager_counters_t* ram_block_counters)
+{
+    for (int i = 0; i < MEMORY_BANKS; i++)
+    {
+        if ((banks & (1u << i)) &&
+            power_gate_ram_block(power_manager, i, sel_state, ram_block_counters) != kPowerManagerOk_e)
+            return kPowerManagerError_e;
+    }
+
+    return kPowerManagerOk_e;
+}
+
+power_manager_result_t ram_banks_sleep(const power_manager_t *power_manager, uint32_t idle_banks, power_manager_counters_t* ram_block_counters, ram_banks_sleep_t *sleep)
+{
+    ram_banks_usage_t usage;
+    uint32_t active;
+
+    ram_banks_get_usage(&usage);
+
+    // what ram_banks_wake() and the handlers access must stay accessible: the
+    // code, the stack, the static data (power_manager_ram_map among others)
+    active = usage.code | usage.data | usage.stack |
+             ram_banks_holding(sleep, sizeof(*sleep)) |
+             ram_banks_holding(ram_block_counters, sizeof(*ram_block_counters)) |
+             ram_banks_holding(power_manager, sizeof(*power_manager));
+
+    sleep->off = ram_banks_unused();
+    sleep->retained = idle_banks & ~sleep->off & ~active & RAM_BANKS_ALL;
+
+    if (power_gate_ram_banks(power_manager, sleep->off, kOff_e, ram_block_counters) != kPowerManagerOk_e)
+        return kPowerManagerError_e;
+
+    return power_gate_ram_banks(power_manager, sleep->retained, kRetOn_e, ram_block_counters);
+}
+
+power_manager_result_t ram_banks_wake(const power_manager_t *power_manager, power_manager_counters_t* ram_block_counters, const ram_banks_sleep_t *sleep)
+{
+    if (power_gate_ram_banks(power_manager, sleep->retained, kRetOff_e, ram_block_counters) != kPowerManagerOk_e)
+        return kPowerManagerError_e;
+
+    return power_gate_ram_banks(power_manager, sleep->off, kOn_e, ram_block_counters);
+}
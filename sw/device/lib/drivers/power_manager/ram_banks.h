@@ -0,0 +1,93 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Power states of the RAM banks derived from what the program uses.
+//
+// The linker scripts provide the ranges of the RAM used by the code, the
+// static data, the heap, the arena, the stack and the hot code and data, and power_manager_ram_map,
+// generated by mcu_gen.py with the linker scripts, provides the addresses of
+// each bank. The banks are masks: bit i is the bank i of the power manager.
+//
+// The heap is only counted up to its high-water mark (heap_high_water() of
+// syscalls.h): after ram_banks_sleep() switched off the banks above, malloc must
+// not grow the heap until ram_banks_wake().
+
+#ifndef _RAM_BANKS_H_
+#define _RAM_BANKS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "power_manager.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Banks holding each part of the program.
+ */
+typedef struct ram_banks_usage {
+  uint32_t code;
+  uint32_t data;
+  uint32_t heap;
+  uint32_t arena;
+  uint32_t stack;
+  uint32_t interleaved;
+  uint32_t fast;
+} ram_banks_usage_t;
+
+/**
+ * Banks put to sleep by ram_banks_sleep().
+ */
+typedef struct ram_banks_sleep {
+  uint32_t off;
+  uint32_t retained;
+} ram_banks_sleep_t;
+
+
+void ram_banks_get_usage(ram_banks_usage_t *usage);
+
+/**
+ * Returns the banks holding anything of the program.
+ */
+uint32_t ram_banks_used(void);
+
+/**
+ * Returns the banks holding nothing of the program.
+ */
+uint32_t ram_banks_unused(void);
+
+/**
+ * Returns the banks holding a part of [start, start + size).
+ */
+uint32_t ram_banks_holding(const void *start, size_t size);
+
+/**
+ * Sets the state of each bank of the mask.
+ */
+power_manager_result_t power_gate_ram_banks(const power_manager_t *power_manager, uint32_t banks, power_manager_sel_state_t sel_state, power_manager_counters_t* ram_block_counters);
+
+/**
+ * In one call, switches off the unused banks and puts in retention the
+ * banks of idle_banks, e.g. ram_banks_holding() of buffers of the heap or of
+ * the arena that are not accessed until ram_banks_wake(). The banks of the
+ * code, of the static data and of the stack, and those of the arguments, stay
+ * on. The counters must set both the switch and the retentive sequences.
+ */
+power_manager_result_t ram_banks_sleep(const power_manager_t *power_manager, uint32_t idle_banks, power_manager_counters_t* ram_block_counters, ram_banks_sleep_t *sleep);
+
+/**
+ * Powers on the banks of ram_banks_sleep() again. The content of the banks
+ * that were off is lost.
+ */
+power_manager_result_t ram_banks_wake(const power_manager_t *power_manager, power_manager_counters_t* ram_block_counters, const ram_banks_sleep_t *sleep);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _RAM_BANKS_H_
@@ -41,6 +41,7 @@
 #include "bitfield.h"
 #include "rv_plic_regs.h"  // Generated.
 #include "handler.h"
+#include "csr.h"
 
 // Peripheral modules from where to obtain the irq handlers
 #include "uart.h"
@@ -48,6 +49,7 @@
 #include "i2c.h"
 #include "i2s.h"
 #include "dma.h"
+#include "pdm2pcm.h"
 #include "spi_host.h"
 
 /****************************************************************************/
@@ -62,6 +64,11 @@
 const uint32_t plicMinPriority = 0;
 const uint32_t plicMaxPriority = RV_PLIC_PRIO0_PRIO0_MASK;
 
+/**
+ * The machine interrupt enable bit of mstatus.
+*/
+#define PLIC_MSTATUS_MIE 0x8
+
 /****************************************************************************/
 /**                                                                        **/
 /*                        TYPEDEFS AND STRUCTURES                           */
@@ -103,6 +110,14 @@ static ptrdiff_t plic_offset_from_reg0( uint32_t irq);
  */
 static uint8_t plic_irq_bit_index( uint32_t irq);
 
+/**
+ * @brief Get the pre-set handler of an IRQ source: the weak handler_irq_*
+ * function of its peripheral, or the dummy handler for the external ones.
+ *
+ * @param id An interrupt source identification
+ */
+static handler_funct_t plic_default_handler( uint32_t id );
+
 /**
  * @brief A dummy function to prevent unassigned irq to access a null pointer.
  */
@@ -129,6 +144,18 @@ __attribute__((optimize("O0"))) static void handler_irq_dummy( uint32_t dummy );
 */
 handler_funct_t handlers[QTY_INTR];
 
+/**
+ * Whether handler_irq_external lets the higher priorities preempt the
+ * handlers, set by plic_set_nested_irq.
+*/
+static bool plic_nested = false;
+
+/**
+ * The most interrupts handler_irq_external serves before returning, set by
+ * plic_set_irq_budget, 0 for no limit.
+*/
+static uint32_t plic_budget = 0;
+
 /****************************************************************************/
 /**                                                                        **/
 /*                           EXPORTED FUNCTIONS                             */
@@ -137,12 +164,54 @@ handler_funct_t handlers[QTY_INTR];
 
 void handler_irq_external(void)
 {
-  uint32_t int_id = NULL_INTR;
-  plic_result_t res = plic_irq_claim(&int_id);
+  uint32_t int_id;
+  uint32_t served = 0;
+  uint32_t mepc, mstatus, threshold;
+
+  if( plic_nested )
+  {
+    // A nested trap overwrites mepc and mstatus.MPIE/MPP, the mret of this
+    // handler needs them back
+    threshold = rv_plic_peri->THRESHOLD0;
+    CSR_READ(CSR_REG_MEPC, &mepc);
+    CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  }
+
+  // Claims the interrupts straight from CC0 until none is pending, the
+  // handler has no error to handle. The sources raised meanwhile are served
+  // without another trap entry and exit.
+  while( ( int_id = rv_plic_peri->CC0 ) != NULL_INTR )
+  {
+    if( plic_nested )
+    {
+      // Only the sources of a higher priority can preempt the handler
+      rv_plic_peri->THRESHOLD0 = (&rv_plic_peri->PRIO0)[int_id];
+      CSR_SET_BITS(CSR_REG_MSTATUS, PLIC_MSTATUS_MIE);
+
+      handlers[int_id](int_id);
 
-    // Calls the proper handler
-    handlers[int_id](int_id);
-    plic_irq_complete(&int_id);
+      CSR_CLEAR_BITS(CSR_REG_MSTATUS, PLIC_MSTATUS_MIE);
+      rv_plic_peri->THRESHOLD0 = threshold;
+    }
+    else
+    {
+      // Calls the proper handler
+      handlers[int_id](int_id);
+    }
+    rv_plic_peri->CC0 = int_id;
+
+    // The claims left pending past the budget raise a new trap
+    if( ++served == plic_budget )
+    {
+      break;
+    }
+  }
+
+  if( plic_nested )
+  {
+    CSR_WRITE(CSR_REG_MEPC, mepc);
+    CSR_WRITE(CSR_REG_MSTATUS, mstatus);
+  }
 }
 
 /*!
@@ -369,48 +438,43 @@ plic_result_t plic_software_irq_is_pending(void)
 plic_result_t plic_assign_external_irq_handler( uint32_t id,
                                                 void *handler )
 {
-  if( id >= EXT_IRQ_START && id <= QTY_INTR )
+  if( id >= EXT_IRQ_START && id < QTY_INTR )
+  {
+    handlers[ id ] = (handler_funct_t) handler;
+    return kPlicOk;
+  }
+  return kPlicBadArg;
+}
+
+plic_result_t plic_assign_irq_handler( uint32_t id,
+                                       void *handler )
+{
+  if( id > NULL_INTR && id < QTY_INTR )
   {
-    handlers[ id ] = (handler_funct_t*) handler;
+    handlers[ id ] = handler != NULL ? (handler_funct_t) handler
+                                     : plic_default_handler( id );
     return kPlicOk;
   }
   return kPlicBadArg;
 }
 
+void plic_set_nested_irq(bool enable)
+{
+  plic_nested = enable;
+}
+
+void plic_set_irq_budget(uint32_t budget)
+{
+  plic_budget = budget;
+}
+
 void plic_reset_handlers_list(void)
 {
   handlers[NULL_INTR] = &handler_irq_dummy;
 
   for( uint8_t i = NULL_INTR +1; i < QTY_INTR; i++ )
   {
-    if ( i <= UART_ID_END)
-    {
-      handlers[i] = &handler_irq_uart;
-    }
-    else if ( i <= GPIO_ID_END)
-    {
-      handlers[i] = &handler_irq_gpio;
-    }
-    else if ( i <= I2C_ID_END)
-    {
-      handlers[i] = &handler_irq_i2c;
-    }
-    else if ( i == SPI_ID)
-    {
-      handlers[i] = &handler_irq_spi;
-    }
-    else if ( i == I2S_ID)
-    {
-      handlers[i] = &handler_irq_i2s;
-    }
-    else if ( i == DMA_ID)
-    {
-      handlers[i] = &handler_irq_dma;
-    }
-    else
-    {
-      handlers[i] = &handler_irq_dummy;
-    }
+    handlers[i] = plic_default_handler(i);
   }
 }
 
@@ -424,6 +488,46 @@ __attribute__((optimize("O0"))) static void handler_irq_dummy( uint32_t dummy )
 {
 }
 
+static handler_funct_t plic_default_handler( uint32_t id )
+{
+  if ( id == NULL_INTR)
+  {
+    return &handler_irq_dummy;
+  }
+  else if ( id <= UART_ID_END)
+  {
+    return &handler_irq_uart;
+  }
+  else if ( id <= GPIO_ID_END)
+  {
+    return &handler_irq_gpio;
+  }
+  else if ( id <= I2C_ID_END)
+  {
+    return &handler_irq_i2c;
+  }
+  else if ( id == SPI_ID)
+  {
+    return &handler_irq_spi;
+  }
+  else if ( id == I2S_ID)
+  {
+    return &handler_irq_i2s;
+  }
+  else if ( id == DMA_ID)
+  {
+    return &handler_irq_dma;
+  }
+  else if ( id == PDM2PCM_ID)
+  {
+    return &handler_irq_pdm2pcm;
+  }
+  else
+  {
+    return &handler_irq_dummy;
+  }
+}
+
 static ptrdiff_t plic_offset_from_reg0( uint32_t irq)
 {
   return irq / RV_PLIC_PARAM_REG_WIDTH;
@@ -81,6 +81,11 @@
 */
 #define DMA_ID          DMA_WINDOW_INTR
 
+/**
+ * ID of the PDM2PCM interrupt request line
+*/
+#define PDM2PCM_ID      PDM2PCM_INTR_EVENT
+
 /**
  * ID of the external interrupt request lines
 */
@@ -171,10 +176,11 @@ typedef enum plic_irq_trigger {
  * Its basic purpose is to understand which source generated
  * the interrupt and call the proper specific handler. The source
  * is detected by reading the CC0 register (claim interrupt), containing
- * the ID of the source.
- * Once the interrupt routine is finished, this function sets to 1 the
- * external_intr_flag and calls plic_irq_complete() function to conclude
- * the handling.
+ * the ID of the source, and completed by writing it back once its handler
+ * returns.
+ * It then claims again until no source is pending, highest priority first,
+ * so that interrupts raised together cost a single trap entry and exit,
+ * at most plic_set_irq_budget of them.
 */
 void handler_irq_external(void);
 
@@ -347,6 +353,43 @@ plic_result_t plic_software_irq_is_pending(void);
 plic_result_t plic_assign_external_irq_handler( uint32_t id,
                                                 void  *handler );
 
+/**
+ * Replaces the handler of any interrupt source, e.g. to serve a peripheral
+ * interrupt without overriding its weak handler_irq_* function. The pre-set
+ * handlers are restored by plic_reset_handlers_list (and plic_Init).
+ * @param id The interrupt ID (from core_v_mini_mcu.h), not NULL_INTR
+ * @param handler A pointer to a function that will be called upon interrupt,
+ * with the ID as argument, NULL to restore the pre-set handler.
+ * @return The result of the operation
+*/
+plic_result_t plic_assign_irq_handler( uint32_t id,
+                                       void  *handler );
+
+/**
+ * Enables the nesting of the PLIC interrupts. handler_irq_external then
+ * raises the threshold to the priority of the claimed source and enables the
+ * interrupts while its handler runs: the sources of a higher priority preempt
+ * it, so their latency no longer depends on the handlers of lower priority.
+ * The fast interrupts enabled in mie preempt it too.
+ *
+ * The threshold is restored after the handler, which must not change it, and
+ * sources of the same priority still wait for each other. A nested handler
+ * runs on the same stack as the one it preempts.
+ * @param enable true to nest the interrupts, false (the default) to run each
+ * handler with the interrupts disabled.
+*/
+void plic_set_nested_irq(bool enable);
+
+/**
+ * Bounds the interrupts served by each call of handler_irq_external. Past
+ * the budget the handler returns and the pending sources raise a new trap,
+ * so that the code they interrupt runs between the bursts of a source that
+ * keeps firing.
+ * @param budget The most interrupts served before returning, 0 (the default)
+ * to serve them until none is pending.
+*/
+void plic_set_irq_budget(uint32_t budget);
+
 /**
  * Resets all peripheral handlers to their pre-set ones. All external handlers
  * are re-set to the dummy handler.
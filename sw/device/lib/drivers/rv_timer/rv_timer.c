@@ -161,6 +161,12 @@ rv_timer_result_t rv_timer_counter_read(const rv_timer_t *timer,
   }
 }
 
+uint32_t rv_timer_counter_read32(const rv_timer_t *timer, uint32_t hart_id) {
+  return mmio_region_read32(
+      timer->base_addr,
+      reg_for_hart(hart_id, RV_TIMER_TIMER_V_LOWER0_REG_OFFSET));
+}
+
 rv_timer_result_t rv_timer_arm(const rv_timer_t *timer,
                                        uint32_t hart_id, uint32_t comp_id,
                                        uint64_t threshold) {
@@ -373,3 +379,18 @@ rv_timer_result_t rv_timer_reset(const rv_timer_t *timer) {
 
   return kRvTimerOk;
 }
+
+void rv_timer_clock_notifier(soc_clock_event_t event, uint32_t old_hz,
+                             uint32_t new_hz, void *ctx) {
+  const rv_timer_clock_t *clock = ctx;
+  rv_timer_tick_params_t params;
+
+  if (event != kSocClockPostChange_e || new_hz == old_hz) {
+    return;
+  }
+
+  if (rv_timer_approximate_tick_params(new_hz, clock->tick_hz, &params) ==
+      kRvTimerApproximateTickParamsOk) {
+    rv_timer_set_tick_params(clock->timer, clock->hart_id, params);
+  }
+}
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "mmio.h"
+#include "soc_ctrl_clock.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -209,6 +210,17 @@ rv_timer_result_t rv_timer_counter_read(const rv_timer_t *timer,
                                                 uint32_t hart_id,
                                                 uint64_t *out);
 
+/**
+ * Reads the lower 32 bits of a particular hart's timer, with a single load.
+ * Meant to timestamp events from an interrupt handler: the arguments are not
+ * checked.
+ *
+ * @param timer A timer device.
+ * @param hart_id The hart counter to read.
+ * @return The lower 32 bits of the counter value.
+ */
+uint32_t rv_timer_counter_read32(const rv_timer_t *timer, uint32_t hart_id);
+
 /**
  * Arms the timer to go off once the counter value is greater than
  * or equal to `threshold`, by setting up the given comparator.
@@ -320,6 +332,29 @@ rv_timer_result_t rv_timer_irq_restore(const rv_timer_t *timer,
                                                uint32_t hart_id,
                                                uint32_t state);
 
+/**
+ * Counter of a hart kept at the same tick frequency across the changes of the
+ * system clock, see `rv_timer_clock_notifier()`.
+ */
+typedef struct rv_timer_clock {
+  const rv_timer_t *timer;
+  uint32_t hart_id;
+  /**
+   * The frequency the counter ticks at, in Hz.
+   */
+  uint64_t tick_hz;
+} rv_timer_clock_t;
+
+/**
+ * soc_clock notifier (soc_ctrl_clock.h) of the counter of a hart, ctx is a
+ * rv_timer_clock_t: after the change of the system clock, it sets the tick
+ * params approximating `tick_hz` at the new frequency. The counter keeps its
+ * value. If the tick frequency is not representable at the new frequency,
+ * the counter keeps its previous tick params.
+ */
+void rv_timer_clock_notifier(soc_clock_event_t event, uint32_t old_hz,
+                             uint32_t new_hz, void *ctx);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -7,6 +7,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "bitfield.h"
+#include "core_v_mini_mcu.h"
 #include "mmio.h"
 
 #include "soc_ctrl.h"
@@ -40,4 +42,104 @@ void soc_ctrl_select_spi_host(const soc_ctrl_t *soc_ctrl) {
 
 uint32_t get_spi_flash_mode(const soc_ctrl_t *soc_ctrl) {
   return mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_USE_SPIMEMIO_REG_OFFSET));
-}
\ No newline at end of file
+}
+void soc_ctrl_icache_enable(const soc_ctrl_t *soc_ctrl, bool enable, bool prefetch) {
+  uint32_t ctrl = 0;
+  ctrl = bitfield_bit32_write(ctrl, SOC_CTRL_ICACHE_CTRL_ENABLE_BIT, enable);
+  ctrl = bitfield_bit32_write(ctrl, SOC_CTRL_ICACHE_CTRL_PREFETCH_BIT, prefetch);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_CTRL_REG_OFFSET), ctrl);
+}
+
+void soc_ctrl_icache_flush(const soc_ctrl_t *soc_ctrl) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_FLUSH_REG_OFFSET),
+                      1 << SOC_CTRL_ICACHE_FLUSH_ICACHE_FLUSH_BIT);
+}
+
+void soc_ctrl_icache_get_stats(const soc_ctrl_t *soc_ctrl, uint32_t *hits, uint32_t *misses) {
+  *hits = mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_HITS_REG_OFFSET));
+  *misses = mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_MISSES_REG_OFFSET));
+}
+
+void soc_ctrl_icache_clear_stats(const soc_ctrl_t *soc_ctrl) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_HITS_REG_OFFSET), 0);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ICACHE_MISSES_REG_OFFSET), 0);
+}
+
+static void soc_ctrl_dcache_maint(const soc_ctrl_t *soc_ctrl, bool clean, bool invalidate) {
+  uint32_t maint = 0;
+  maint = bitfield_bit32_write(maint, SOC_CTRL_DCACHE_MAINT_CLEAN_BIT, clean);
+  maint = bitfield_bit32_write(maint, SOC_CTRL_DCACHE_MAINT_INVALIDATE_BIT, invalidate);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_MAINT_REG_OFFSET), maint);
+  // The accesses of the core wait for the end, the read returns when it is done
+  while (mmio_region_get_bit32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_CTRL_REG_OFFSET),
+                               SOC_CTRL_DCACHE_CTRL_BUSY_BIT)) {
+  }
+}
+
+void soc_ctrl_dcache_enable(const soc_ctrl_t *soc_ctrl, bool enable) {
+  if (!enable) {
+    soc_ctrl_dcache_maint(soc_ctrl, true, true);
+  }
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_CTRL_REG_OFFSET),
+                      bitfield_bit32_write(0, SOC_CTRL_DCACHE_CTRL_ENABLE_BIT, enable));
+}
+
+void soc_ctrl_dcache_clean(const soc_ctrl_t *soc_ctrl) {
+  soc_ctrl_dcache_maint(soc_ctrl, true, false);
+}
+
+void soc_ctrl_dcache_invalidate(const soc_ctrl_t *soc_ctrl) {
+  soc_ctrl_dcache_maint(soc_ctrl, false, true);
+}
+
+void soc_ctrl_dcache_flush(const soc_ctrl_t *soc_ctrl) {
+  soc_ctrl_dcache_maint(soc_ctrl, true, true);
+}
+
+void soc_ctrl_dcache_get_stats(const soc_ctrl_t *soc_ctrl, uint32_t *hits, uint32_t *misses) {
+  *hits = mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_HITS_REG_OFFSET));
+  *misses = mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_MISSES_REG_OFFSET));
+}
+
+void soc_ctrl_dcache_clear_stats(const soc_ctrl_t *soc_ctrl) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_HITS_REG_OFFSET), 0);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_DCACHE_MISSES_REG_OFFSET), 0);
+}
+
+void soc_ctrl_warm_boot_arm(const soc_ctrl_t *soc_ctrl, uintptr_t entry, uint32_t size) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_ENTRY_REG_OFFSET), (uint32_t)entry);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_SIZE_REG_OFFSET), size);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_CHECKSUM_REG_OFFSET),
+                      soc_ctrl_warm_boot_checksum(size));
+  // The magic last, the descriptor is complete when the boot rom sees it
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_MAGIC_REG_OFFSET),
+                      SOC_CTRL_PARAM_WARM_BOOT_MAGIC);
+}
+
+void soc_ctrl_warm_boot_disarm(const soc_ctrl_t *soc_ctrl) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_MAGIC_REG_OFFSET), 0);
+}
+
+bool soc_ctrl_warm_boot_armed(const soc_ctrl_t *soc_ctrl) {
+  return mmio_region_read32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_WARM_BOOT_MAGIC_REG_OFFSET)) ==
+         SOC_CTRL_PARAM_WARM_BOOT_MAGIC;
+}
+
+void soc_ctrl_set_bus_qos(const soc_ctrl_t *soc_ctrl, bool cpu_prio, uint8_t dma_throttle) {
+  uint32_t qos = bitfield_bit32_write(0, SOC_CTRL_BUS_QOS_CPU_PRIO_BIT, cpu_prio);
+  qos = bitfield_field32_write(qos, SOC_CTRL_BUS_QOS_DMA_THROTTLE_FIELD, dma_throttle);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_BUS_QOS_REG_OFFSET), qos);
+}
+
+uint32_t soc_ctrl_warm_boot_checksum(uint32_t size) {
+  uintptr_t addr = RAM_START_ADDRESS;
+  // The RAM starts at address 0, hidden from the compiler so that it does
+  // not take the reads for null pointer dereferences
+  asm("" : "+r"(addr));
+  const volatile uint32_t *word = (const volatile uint32_t *)addr;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < size / 4; i++) {
+    sum = ((sum << 5) | (sum >> 27)) + word[i];
+  }
+  return sum;
+}
@@ -5,6 +5,7 @@
 #ifndef _DRIVERS_SOC_CTRL_H_
 #define _DRIVERS_SOC_CTRL_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -66,6 +67,137 @@ void soc_ctrl_select_spi_host(const soc_ctrl_t *soc_ctrl);
 
 uint32_t get_spi_flash_mode(const soc_ctrl_t *soc_ctrl);
 
+/**
+ * Enables or disables the instruction cache of the core, present when
+ * ICACHE_WAYS > 0. Disabling it also invalidates it.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param enable Serve the fetches from the cache.
+ * @param prefetch Fetch the next line after each miss.
+ */
+void soc_ctrl_icache_enable(const soc_ctrl_t *soc_ctrl, bool enable, bool prefetch);
+
+/**
+ * Invalidates all the lines of the instruction cache, to be called after
+ * writing code to the memory (e.g. loading an overlay or an application).
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_icache_flush(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Reads the counters of the instruction cache.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param hits Fetches served by the cache.
+ * @param misses Fetches that fetched their line from the bus.
+ */
+void soc_ctrl_icache_get_stats(const soc_ctrl_t *soc_ctrl, uint32_t *hits, uint32_t *misses);
+
+/**
+ * Clears the counters of the instruction cache.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_icache_clear_stats(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Enables or disables the write-back data cache of the external memory
+ * region DCACHE_START_ADDRESS..DCACHE_END_ADDRESS, present when
+ * DCACHE_WAYS > 0. Disabling it first writes back and invalidates all the
+ * lines.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param enable Serve the accesses to the region from the cache.
+ */
+void soc_ctrl_dcache_enable(const soc_ctrl_t *soc_ctrl, bool enable);
+
+/**
+ * Writes the dirty lines of the data cache back to the memory and waits for
+ * the end, to be called before the DMA or another master reads the region.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_dcache_clean(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Invalidates all the lines of the data cache, dropping the dirty ones, and
+ * waits for the end, to be called after the DMA or another master wrote the
+ * region.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_dcache_invalidate(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Writes back then invalidates all the lines of the data cache, and waits
+ * for the end.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_dcache_flush(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Reads the counters of the data cache.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param hits Accesses served by the cache.
+ * @param misses Accesses that fetched their line from the bus.
+ */
+void soc_ctrl_dcache_get_stats(const soc_ctrl_t *soc_ctrl, uint32_t *hits, uint32_t *misses);
+
+/**
+ * Clears the counters of the data cache.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_dcache_clear_stats(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Arms the warm boot. After a power cycle of the core that kept the RAM
+ * (e.g. a deep sleep with the banks in retention), the boot rom jumps to
+ * entry without loading the program again, from the flash or through JTAG,
+ * if the first size bytes of the RAM still have the checksum they have now.
+ * Otherwise it disarms the warm boot and boots as after a reset. A reset of
+ * the SoC disarms it too.
+ * With entry the boot address of crt0 (_start), the program starts again
+ * without being copied from the flash, so the bytes checked should go up to
+ * _edata: the initial values of the data, which the program must not write
+ * after arming, are checked along with the code. The entry must be in the
+ * RAM, so not with the flash_exec linker.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param entry The address the boot rom jumps to.
+ * @param size Bytes checked from RAM_START_ADDRESS, a multiple of 4, 0 to not
+ * check them.
+ */
+void soc_ctrl_warm_boot_arm(const soc_ctrl_t *soc_ctrl, uintptr_t entry, uint32_t size);
+
+/**
+ * Disarms the warm boot, the next power cycle of the core boots as after a
+ * reset.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_warm_boot_disarm(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Tells whether the warm boot is armed, which is the case after a warm boot
+ * as the boot rom leaves it armed.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+bool soc_ctrl_warm_boot_armed(const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Computes the checksum of the first bytes of the RAM that the boot rom
+ * checks: each word is added to the sum rotated left by 5 bits.
+ * @param size Bytes from RAM_START_ADDRESS, a multiple of 4.
+ */
+uint32_t soc_ctrl_warm_boot_checksum(uint32_t size);
+
+/**
+ * Sets the arbitration of the system bus between the cores and the DMA.
+ * With cpu_prio, a request of a core wins over the requests of the DMA
+ * channels for the same slave, e.g. a bank of the RAM, instead of the round
+ * robin, so that the response time of the interrupt handlers does not depend
+ * on the DMA traffic. The DMA waits as long as a core keeps requesting the
+ * slave, so it is meant for the latency-critical phases. Independently,
+ * each port of the DMA channels waits dma_throttle cycles after each grant,
+ * which bounds the bandwidth they take, 0 gives them the full bandwidth.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param cpu_prio The cores have priority over the DMA.
+ * @param dma_throttle Cycles between two requests of a port of the DMA.
+ */
+void soc_ctrl_set_bus_qos(const soc_ctrl_t *soc_ctrl, bool cpu_prio, uint8_t dma_throttle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,82 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "soc_ctrl_clock.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mmio.h"
+#include "csr.h"
+#include "irq.h"
+
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+
+static soc_clock_notifier_t *soc_clock_notifiers = NULL;
+
+#define soc_ctrl_base mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS)
+
+static void soc_clock_notify(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz) {
+  for (soc_clock_notifier_t *n = soc_clock_notifiers; n != NULL; n = n->next) {
+    n->cb(event, old_hz, new_hz, n->ctx);
+  }
+}
+
+__attribute__((weak)) bool soc_clock_apply(uint32_t frequency) {
+  return true;
+}
+
+void soc_clock_register(soc_clock_notifier_t *notifier, soc_clock_cb_t cb, void *ctx) {
+  soc_clock_notifier_t **last = &soc_clock_notifiers;
+
+  notifier->cb = cb;
+  notifier->ctx = ctx;
+  notifier->next = NULL;
+  while (*last != NULL) {
+    last = &(*last)->next;
+  }
+  *last = notifier;
+}
+
+void soc_clock_unregister(soc_clock_notifier_t *notifier) {
+  for (soc_clock_notifier_t **n = &soc_clock_notifiers; *n != NULL; n = &(*n)->next) {
+    if (*n == notifier) {
+      *n = notifier->next;
+      return;
+    }
+  }
+}
+
+uint32_t soc_clock_get_frequency(void) {
+  soc_ctrl_t soc_ctrl = {.base_addr = soc_ctrl_base};
+  return soc_ctrl_get_frequency(&soc_ctrl);
+}
+
+soc_clock_result_t soc_clock_set_frequency(uint32_t frequency) {
+  soc_ctrl_t soc_ctrl = {.base_addr = soc_ctrl_base};
+  uint32_t old_hz = soc_ctrl_get_frequency(&soc_ctrl);
+  uint32_t new_hz = frequency;
+  uint32_t mstatus;
+
+  if (frequency == 0) {
+    return kSocClockError_e;
+  }
+
+  soc_clock_notify(kSocClockPreChange_e, old_hz, frequency);
+
+  // no interrupt may run with dividers computed for the other frequency
+  mstatus = irq_save();
+
+  if (soc_clock_apply(frequency)) {
+    soc_ctrl_set_frequency(&soc_ctrl, frequency);
+  } else {
+    new_hz = old_hz;
+  }
+  soc_clock_notify(kSocClockPostChange_e, old_hz, new_hz);
+
+  irq_restore(mstatus);
+
+  return new_hz == frequency ? kSocClockOk_e : kSocClockError_e;
+}
@@ -0,0 +1,91 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DRIVERS_SOC_CTRL_CLOCK_H_
+#define _DRIVERS_SOC_CTRL_CLOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Changes of the system clock frequency at runtime.
+//
+// The drivers whose timing derives from the system clock (the UART divider,
+// the I2C timings, the rv_timer prescalers, ...) register a notifier.
+// soc_clock_set_frequency() then calls every notifier with
+// kSocClockPreChange, with the interrupts enabled so that they can wait for
+// their transfers to end, changes the clock with the interrupts disabled,
+// and calls them again with kSocClockPostChange to reprogram their dividers
+// before any interrupt is taken at the new frequency.
+//
+// On a target with a controllable clock (a PLL, an MMCM), soc_clock_apply()
+// programs it; the default one only records the new frequency in soc_ctrl,
+// which is what the simulation and the FPGA without a clock generator do.
+
+typedef enum soc_clock_result {
+  kSocClockOk_e    = 0,
+  kSocClockError_e = 1,
+} soc_clock_result_t;
+
+typedef enum soc_clock_event {
+  /**
+   * The clock is about to change: finish or pause the ongoing transfers.
+   */
+  kSocClockPreChange_e  = 0,
+  /**
+   * The clock runs at new_hz: reprogram the dividers. If the change failed,
+   * new_hz is old_hz.
+   */
+  kSocClockPostChange_e = 1,
+} soc_clock_event_t;
+
+typedef void (*soc_clock_cb_t)(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz, void *ctx);
+
+/**
+ * A registered notifier. Its fields are managed by the functions below.
+ */
+typedef struct soc_clock_notifier {
+  soc_clock_cb_t cb;
+  void *ctx;
+  struct soc_clock_notifier *next;
+} soc_clock_notifier_t;
+
+/**
+ * Registers a notifier, called on the next changes, in the order of the
+ * registrations.
+ * @param notifier Notifier, which must stay allocated while registered.
+ * @param cb Callback.
+ * @param ctx Passed to the callback, e.g. the driver handle.
+ */
+void soc_clock_register(soc_clock_notifier_t *notifier, soc_clock_cb_t cb, void *ctx);
+
+void soc_clock_unregister(soc_clock_notifier_t *notifier);
+
+/**
+ * Changes the frequency of the system clock and notifies the drivers.
+ * @param frequency New frequency in Hz.
+ * @return kSocClockError_e if the clock cannot run at this frequency, the
+ * notifiers are then called with kSocClockPostChange_e and the old frequency.
+ */
+soc_clock_result_t soc_clock_set_frequency(uint32_t frequency);
+
+uint32_t soc_clock_get_frequency(void);
+
+/**
+ * Programs the clock generator of the target, called with the interrupts
+ * disabled. It is weak: the default one does nothing and succeeds.
+ * @param frequency New frequency in Hz.
+ * @return false if the clock cannot run at this frequency.
+ */
+bool soc_clock_apply(uint32_t frequency);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DRIVERS_SOC_CTRL_CLOCK_H_
@@ -13,6 +13,9 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+// Value of WARM_BOOT_MAGIC that arms the warm boot, 0x5741524D
+#define SOC_CTRL_PARAM_WARM_BOOT_MAGIC 1463898701
+
 // Register width
 #define SOC_CTRL_PARAM_REG_WIDTH 32
 
@@ -48,6 +51,63 @@ extern "C" {
 // system is running (in Hz)
 #define SOC_CTRL_SYSTEM_FREQUENCY_HZ_REG_OFFSET 0x1c
 
+// Control of the instruction cache of the core, when the configuration has
+// one
+#define SOC_CTRL_ICACHE_CTRL_REG_OFFSET 0x20
+#define SOC_CTRL_ICACHE_CTRL_ENABLE_BIT 0
+#define SOC_CTRL_ICACHE_CTRL_PREFETCH_BIT 1
+
+// Flush of the instruction cache
+#define SOC_CTRL_ICACHE_FLUSH_REG_OFFSET 0x24
+#define SOC_CTRL_ICACHE_FLUSH_ICACHE_FLUSH_BIT 0
+
+// Number of fetches served by the instruction cache, can be written
+#define SOC_CTRL_ICACHE_HITS_REG_OFFSET 0x28
+
+// Number of fetches that fetched their line from the bus, can be written
+#define SOC_CTRL_ICACHE_MISSES_REG_OFFSET 0x2c
+
+// Control of the data cache of the external memory, when the configuration
+// has one
+#define SOC_CTRL_DCACHE_CTRL_REG_OFFSET 0x30
+#define SOC_CTRL_DCACHE_CTRL_ENABLE_BIT 0
+#define SOC_CTRL_DCACHE_CTRL_BUSY_BIT 1
+
+// Maintenance of the data cache, the core accesses wait until it ends
+#define SOC_CTRL_DCACHE_MAINT_REG_OFFSET 0x34
+#define SOC_CTRL_DCACHE_MAINT_CLEAN_BIT 0
+#define SOC_CTRL_DCACHE_MAINT_INVALIDATE_BIT 1
+
+// Number of accesses served by the data cache, can be written
+#define SOC_CTRL_DCACHE_HITS_REG_OFFSET 0x38
+
+// Number of accesses that fetched their line from the bus, can be written
+#define SOC_CTRL_DCACHE_MISSES_REG_OFFSET 0x3c
+
+// Warm boot - WarmBootMagic when the program in the RAM is armed to be
+// started again by the boot rom, without reloading it, after a power cycle
+// of the core. The boot rom clears it if the checksum does not match
+#define SOC_CTRL_WARM_BOOT_MAGIC_REG_OFFSET 0x40
+
+// Warm boot - Address in the RAM that the boot rom jumps to
+#define SOC_CTRL_WARM_BOOT_ENTRY_REG_OFFSET 0x44
+
+// Warm boot - Bytes of the RAM checked from its start, a multiple of 4, 0 to
+// not check
+#define SOC_CTRL_WARM_BOOT_SIZE_REG_OFFSET 0x48
+
+// Warm boot - Checksum of the RAM checked, each word added to the sum
+// rotated left by 5 bits
+#define SOC_CTRL_WARM_BOOT_CHECKSUM_REG_OFFSET 0x4c
+
+// Arbitration of the system bus between the core and the DMA
+#define SOC_CTRL_BUS_QOS_REG_OFFSET 0x50
+#define SOC_CTRL_BUS_QOS_CPU_PRIO_BIT 0
+#define SOC_CTRL_BUS_QOS_DMA_THROTTLE_MASK 0xff
+#define SOC_CTRL_BUS_QOS_DMA_THROTTLE_OFFSET 8
+#define SOC_CTRL_BUS_QOS_DMA_THROTTLE_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_DMA_THROTTLE_MASK, .index = SOC_CTRL_BUS_QOS_DMA_THROTTLE_OFFSET })
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,768 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : spi_flash.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   spi_flash.c
+* @date   14/10/26
+* @brief  Driver for the SPI NOR flash memories connected to a SPI host.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "spi_flash.h"
+
+#include <string.h>
+
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "bitfield.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The flash expects the address MSB first, right after the command byte.
+ */
+#define SPI_FLASH_HEADER( cmd, addr ) \
+    ( ( bitfield_byteswap32( ( addr ) & SPI_FLASH_MAX_ADDR ) ) | ( cmd ) )
+
+/**
+ * The progress of an operation.
+ */
+#define STAGE_DATA  0   /*!< The DMA is moving the data. */
+#define STAGE_BUSY  1   /*!< The flash is programming or erasing. */
+#define STAGE_DONE  2   /*!< Nothing left but the callback. */
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Queues a segment of p_len bytes in the command FIFO.
+ */
+static void flash_segment( spi_flash_t *p_flash,
+                           uint32_t    p_len,
+                           bool        p_csaat,
+                           spi_dir_e   p_dir,
+                           spi_speed_e p_speed );
+
+/**
+ * @brief Queues a command followed by an address, keeping the chip select.
+ */
+static void flash_header( spi_flash_t *p_flash,
+                          uint8_t     p_cmd,
+                          uint32_t    p_addr );
+
+/**
+ * @brief Queues the command, address and dummy cycles of a read of the
+ * configured mode, then its p_len bytes of data.
+ */
+static void flash_read_header( spi_flash_t *p_flash,
+                               uint32_t    p_addr,
+                               uint32_t    p_len );
+
+/**
+ * @brief Sets the QE bit of the flash for the quad reads, blocking.
+ */
+static spi_flash_result_t flash_quad_enable( spi_flash_t *p_flash );
+
+/**
+ * @brief Queues a command without address nor data.
+ */
+static void flash_command( spi_flash_t *p_flash, uint8_t p_cmd );
+
+/**
+ * @brief Reads a register of the flash, blocking.
+ */
+static uint8_t flash_read_reg( spi_flash_t *p_flash, uint8_t p_cmd );
+
+/**
+ * @brief Returns true while the SPI host has segments to run.
+ */
+static bool flash_spi_busy( spi_flash_t *p_flash );
+
+/**
+ * @brief Returns true while the last program or erase is ongoing.
+ */
+static bool flash_busy( spi_flash_t *p_flash );
+
+/**
+ * @brief Loads the DMA transaction between p_data and a FIFO of the SPI host.
+ */
+static spi_flash_result_t flash_dma( spi_flash_t *p_flash,
+                                     uint8_t     *p_data,
+                                     uint32_t    p_words,
+                                     bool        p_to_flash );
+
+/**
+ * @brief Queues the program of the next page, up to the end of the data or
+ * of the page.
+ */
+static spi_flash_result_t flash_page( spi_flash_t *p_flash );
+
+/**
+ * @brief Ends the ongoing operation and calls its callback.
+ */
+static spi_flash_result_t flash_finish( spi_flash_t        *p_flash,
+                                        spi_flash_result_t p_res );
+
+/**
+ * @brief Moves a packet program to its next buffer that is not empty.
+ * @return false at the end of the packet, or without packet.
+ */
+static bool flash_next_seg( spi_flash_t *p_flash );
+
+/**
+ * @brief Checks the parameters of a read or a program.
+ */
+static spi_flash_result_t flash_check( spi_flash_t *p_flash,
+                                       uint32_t    p_addr,
+                                       const void  *p_data,
+                                       uint32_t    p_len );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+spi_flash_result_t spi_flash_init( spi_flash_t           *p_flash,
+                                   const spi_host_t      *p_spi,
+                                   const spi_flash_cfg_t *p_cfg )
+{
+    if( p_spi == NULL || p_cfg->clk_max_hz == 0
+        || p_cfg->csid >= SPI_HOST_PARAM_NUM_C_S
+        || p_cfg->dma_ch >= DMA_CH_NUM
+        || p_cfg->read_mode > SPI_FLASH_READ_QUAD_IO )
+    {
+        return SPI_FLASH_ERROR;
+    }
+
+    p_flash->spi    = p_spi;
+    p_flash->cfg    = *p_cfg;
+    p_flash->op     = SPI_FLASH_OP_NONE;
+    p_flash->cb     = NULL;
+    p_flash->pbuf   = NULL;
+    p_flash->seg    = NULL;
+
+    /* SPI host and SPI flash are the same IP, but with their own triggers. */
+    if( (uintptr_t)p_spi->base_addr.base == SPI_FLASH_START_ADDRESS )
+    {
+        p_flash->rx_slot = DMA_TRIG_SLOT_SPI_FLASH_RX;
+        p_flash->tx_slot = DMA_TRIG_SLOT_SPI_FLASH_TX;
+    }
+    else
+    {
+        p_flash->rx_slot = DMA_TRIG_SLOT_SPI_RX;
+        p_flash->tx_slot = DMA_TRIG_SLOT_SPI_TX;
+    }
+
+    /* SPI_CLK = CORE_CLK/(2 + 2 * CLK_DIV) <= CLK_MAX */
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr( (uintptr_t)SOC_CTRL_START_ADDRESS );
+    uint32_t core_clk  = soc_ctrl_get_frequency( &soc_ctrl );
+    uint16_t clk_div   = 0;
+    if( p_cfg->clk_max_hz < core_clk / 2 )
+    {
+        clk_div = ( core_clk / p_cfg->clk_max_hz - 2 ) / 2;
+        if( core_clk / ( 2 + 2 * clk_div ) > p_cfg->clk_max_hz )
+        {
+            clk_div += 1;
+        }
+    }
+
+    spi_set_enable( p_spi, true );
+    spi_output_enable( p_spi, true );
+    spi_set_configopts( p_spi, p_cfg->csid,
+                        spi_create_configopts( (spi_configopts_t){
+                            .clkdiv     = clk_div,
+                            .csnidle    = 0xF,
+                            .csntrail   = 0xF,
+                            .csnlead    = 0xF,
+                            .fullcyc    = false,
+                            .cpha       = 0,
+                            .cpol       = 0
+                        } ) );
+    spi_set_csid( p_spi, p_cfg->csid );
+
+    /* Received as the mode bits of a continuous read, which end it. */
+    spi_write_word( p_spi, 0xFFFFFFFF );
+    flash_segment( p_flash, 4, false, kSpiDirTxOnly, kSpiSpeedStandard );
+    spi_flash_power_up( p_flash );
+
+    if( p_cfg->read_mode != SPI_FLASH_READ_STANDARD && p_cfg->poll_status )
+    {
+        return flash_quad_enable( p_flash );
+    }
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_read_async( spi_flash_t    *p_flash,
+                                         uint32_t       p_addr,
+                                         void           *p_data,
+                                         uint32_t       p_len,
+                                         spi_flash_cb_t p_cb )
+{
+    spi_flash_result_t res = flash_check( p_flash, p_addr, p_data, p_len );
+    if( res != SPI_FLASH_OK )
+    {
+        return res;
+    }
+
+    uint8_t *data = (uint8_t*) p_data;
+    p_flash->op = SPI_FLASH_OP_READ;
+    p_flash->cb = p_cb;
+
+    if( ( (uintptr_t)data & 3 ) == 0 && p_len >= SPI_FLASH_DMA_THRESHOLD_B )
+    {
+        res = flash_dma( p_flash, data, p_len >> 2, false );
+        if( res != SPI_FLASH_OK )
+        {
+            p_flash->op = SPI_FLASH_OP_NONE;
+            return res;
+        }
+        /* The DMA waits for the RX FIFO. The last partial word is pushed at
+         * the end of the segment, once the DMA is done. */
+        dma_launch( &p_flash->trans );
+        p_flash->tail   = p_len & 3;
+        p_flash->data   = data + p_len - p_flash->tail;
+        p_flash->stage  = STAGE_DATA;
+        flash_read_header( p_flash, p_addr, p_len );
+        return SPI_FLASH_OK;
+    }
+
+    /* Short or unaligned: the CPU drains the RX FIFO as it fills. */
+    flash_read_header( p_flash, p_addr, p_len );
+    for( uint32_t i = 0; i < p_len; i += 4 )
+    {
+        uint32_t word;
+        while( spi_get_rx_queue_depth( p_flash->spi ) == 0 );
+        spi_read_word( p_flash->spi, &word );
+        memcpy( &data[ i ], &word, ( p_len - i < 4 ) ? p_len - i : 4 );
+    }
+    p_flash->stage = STAGE_DONE;
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_program_async( spi_flash_t    *p_flash,
+                                            uint32_t       p_addr,
+                                            const void     *p_data,
+                                            uint32_t       p_len,
+                                            spi_flash_cb_t p_cb )
+{
+    spi_flash_result_t res = flash_check( p_flash, p_addr, p_data, p_len );
+    if( res != SPI_FLASH_OK )
+    {
+        return res;
+    }
+
+    p_flash->op         = SPI_FLASH_OP_PROGRAM;
+    p_flash->cb         = p_cb;
+    p_flash->addr       = p_addr;
+    p_flash->data       = (uint8_t*) p_data;
+    p_flash->remaining  = p_len;
+
+    res = flash_page( p_flash );
+    if( res != SPI_FLASH_OK )
+    {
+        p_flash->op = SPI_FLASH_OP_NONE;
+    }
+    return res;
+}
+
+spi_flash_result_t spi_flash_program_pbuf_async( spi_flash_t    *p_flash,
+                                                 uint32_t       p_addr,
+                                                 pbuf_t         *p_pbuf,
+                                                 spi_flash_cb_t p_cb )
+{
+    spi_flash_result_t res = flash_check( p_flash, p_addr, p_pbuf,
+                                          pbuf_total_len( p_pbuf ) );
+    if( res != SPI_FLASH_OK )
+    {
+        return res;
+    }
+
+    /* The packet has bytes, so one of its buffers is not empty. */
+    pbuf_t *seg = p_pbuf;
+    while( seg->len == 0 )
+    {
+        seg = seg->next;
+    }
+    res = spi_flash_program_async( p_flash, p_addr, seg->payload, seg->len, p_cb );
+    if( res == SPI_FLASH_OK )
+    {
+        p_flash->pbuf = p_pbuf;
+        p_flash->seg  = seg;
+    }
+    return res;
+}
+
+spi_flash_result_t spi_flash_erase_async( spi_flash_t       *p_flash,
+                                          spi_flash_erase_t p_erase,
+                                          uint32_t          p_addr,
+                                          spi_flash_cb_t    p_cb )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    if( p_addr > SPI_FLASH_MAX_ADDR )
+    {
+        return SPI_FLASH_ERROR;
+    }
+
+    p_flash->op     = SPI_FLASH_OP_ERASE;
+    p_flash->cb     = p_cb;
+    p_flash->stage  = STAGE_BUSY;
+
+    flash_command( p_flash, SPI_FLASH_CMD_WRITE_ENABLE );
+    if( p_erase == SPI_FLASH_ERASE_CHIP )
+    {
+        flash_command( p_flash, p_erase );
+    }
+    else
+    {
+        spi_write_word( p_flash->spi, SPI_FLASH_HEADER( p_erase, p_addr ) );
+        flash_segment( p_flash, 4, false, kSpiDirTxOnly, kSpiSpeedStandard );
+    }
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_poll( spi_flash_t *p_flash )
+{
+    if( p_flash->op == SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_OK;
+    }
+
+    if( p_flash->stage == STAGE_DATA )
+    {
+        if( !dma_is_ready( p_flash->cfg.dma_ch ) )
+        {
+            return SPI_FLASH_BUSY;
+        }
+        if( p_flash->tail > 0 )
+        {
+            uint32_t word = 0;
+            if( p_flash->op == SPI_FLASH_OP_READ )
+            {
+                while( spi_get_rx_queue_depth( p_flash->spi ) == 0 );
+                spi_read_word( p_flash->spi, &word );
+                memcpy( p_flash->data, &word, p_flash->tail );
+            }
+            else
+            {
+                memcpy( &word, p_flash->data, p_flash->tail );
+                spi_write_word( p_flash->spi, word );
+            }
+            p_flash->data += p_flash->tail;
+        }
+        p_flash->stage = ( p_flash->op == SPI_FLASH_OP_READ ) ? STAGE_DONE
+                                                              : STAGE_BUSY;
+    }
+
+    if( p_flash->stage == STAGE_BUSY )
+    {
+        if( flash_busy( p_flash ) )
+        {
+            return SPI_FLASH_BUSY;
+        }
+        if( p_flash->op == SPI_FLASH_OP_PROGRAM
+            && ( p_flash->remaining > 0 || flash_next_seg( p_flash ) ) )
+        {
+            spi_flash_result_t res = flash_page( p_flash );
+            return ( res == SPI_FLASH_OK ) ? SPI_FLASH_BUSY
+                                           : flash_finish( p_flash, res );
+        }
+    }
+
+    return flash_finish( p_flash, SPI_FLASH_OK );
+}
+
+spi_flash_result_t spi_flash_wait( spi_flash_t *p_flash )
+{
+    spi_flash_result_t res;
+    while( ( res = spi_flash_poll( p_flash ) ) == SPI_FLASH_BUSY );
+    return res;
+}
+
+spi_flash_result_t spi_flash_read( spi_flash_t *p_flash,
+                                   uint32_t    p_addr,
+                                   void        *p_data,
+                                   uint32_t    p_len )
+{
+    spi_flash_result_t res = spi_flash_read_async( p_flash, p_addr, p_data,
+                                                   p_len, NULL );
+    return ( res == SPI_FLASH_OK ) ? spi_flash_wait( p_flash ) : res;
+}
+
+spi_flash_result_t spi_flash_program( spi_flash_t *p_flash,
+                                      uint32_t    p_addr,
+                                      const void  *p_data,
+                                      uint32_t    p_len )
+{
+    spi_flash_result_t res = spi_flash_program_async( p_flash, p_addr, p_data,
+                                                      p_len, NULL );
+    return ( res == SPI_FLASH_OK ) ? spi_flash_wait( p_flash ) : res;
+}
+
+spi_flash_result_t spi_flash_erase( spi_flash_t       *p_flash,
+                                    spi_flash_erase_t p_erase,
+                                    uint32_t          p_addr )
+{
+    spi_flash_result_t res = spi_flash_erase_async( p_flash, p_erase, p_addr,
+                                                    NULL );
+    return ( res == SPI_FLASH_OK ) ? spi_flash_wait( p_flash ) : res;
+}
+
+spi_flash_result_t spi_flash_read_status( spi_flash_t *p_flash,
+                                          uint8_t     p_cmd,
+                                          uint8_t     *p_value )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    *p_value = flash_read_reg( p_flash, p_cmd );
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_write_status( spi_flash_t *p_flash,
+                                           uint8_t     p_cmd,
+                                           uint8_t     p_value )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    flash_command( p_flash, SPI_FLASH_CMD_WRITE_ENABLE );
+    spi_write_word( p_flash->spi, p_cmd | ( (uint32_t)p_value << 8 ) );
+    flash_segment( p_flash, 2, false, kSpiDirTxOnly, kSpiSpeedStandard );
+    while( flash_busy( p_flash ) );
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_power_down( spi_flash_t *p_flash )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    flash_command( p_flash, SPI_FLASH_CMD_POWER_DOWN );
+    while( flash_spi_busy( p_flash ) );
+    return SPI_FLASH_OK;
+}
+
+spi_flash_result_t spi_flash_power_up( spi_flash_t *p_flash )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    flash_command( p_flash, SPI_FLASH_CMD_RELEASE_POWER_DOWN );
+    while( flash_spi_busy( p_flash ) );
+    return SPI_FLASH_OK;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void flash_segment( spi_flash_t *p_flash,
+                           uint32_t    p_len,
+                           bool        p_csaat,
+                           spi_dir_e   p_dir,
+                           spi_speed_e p_speed )
+{
+    /* Only waits for a free slot in the command FIFO, not for the end of
+     * the previous segments. */
+    spi_wait_for_ready( p_flash->spi );
+    spi_set_command( p_flash->spi, spi_create_command( (spi_command_t){
+        .len        = p_len - 1,
+        .csaat      = p_csaat,
+        .speed      = p_speed,
+        .direction  = p_dir
+    } ) );
+}
+
+static void flash_header( spi_flash_t *p_flash,
+                          uint8_t     p_cmd,
+                          uint32_t    p_addr )
+{
+    spi_write_word( p_flash->spi, SPI_FLASH_HEADER( p_cmd, p_addr ) );
+    flash_segment( p_flash, 4, true, kSpiDirTxOnly, kSpiSpeedStandard );
+}
+
+static void flash_read_header( spi_flash_t *p_flash,
+                               uint32_t    p_addr,
+                               uint32_t    p_len )
+{
+    uint8_t dummy = p_flash->cfg.dummy_cycles;
+    switch( p_flash->cfg.read_mode )
+    {
+    case SPI_FLASH_READ_QUAD_OUTPUT:
+        flash_header( p_flash, SPI_FLASH_CMD_READ_QUAD_OUTPUT, p_addr );
+        dummy = ( dummy != 0 ) ? dummy : SPI_FLASH_DUMMY_QUAD_OUTPUT;
+        break;
+    case SPI_FLASH_READ_QUAD_IO:
+        /* The address then the mode bits on the four lines, 0xFF so the
+         * flash does not stay in continuous read. */
+        spi_write_word( p_flash->spi, SPI_FLASH_CMD_READ_QUAD_IO );
+        flash_segment( p_flash, 1, true, kSpiDirTxOnly, kSpiSpeedStandard );
+        spi_write_word( p_flash->spi,
+                        ( SPI_FLASH_HEADER( 0, p_addr ) >> 8 ) | 0xFF000000 );
+        flash_segment( p_flash, 4, true, kSpiDirTxOnly, kSpiSpeedQuad );
+        dummy = ( dummy != 0 ) ? dummy : SPI_FLASH_DUMMY_QUAD_IO;
+        break;
+    default:
+        flash_header( p_flash, SPI_FLASH_CMD_READ, p_addr );
+        flash_segment( p_flash, p_len, false, kSpiDirRxOnly,
+                       kSpiSpeedStandard );
+        return;
+    }
+    /* The length of a dummy segment is in clock cycles. */
+    flash_segment( p_flash, dummy, true, kSpiDirDummy, kSpiSpeedQuad );
+    flash_segment( p_flash, p_len, false, kSpiDirRxOnly, kSpiSpeedQuad );
+}
+
+static spi_flash_result_t flash_quad_enable( spi_flash_t *p_flash )
+{
+    uint8_t sr2 = flash_read_reg( p_flash, SPI_FLASH_CMD_READ_STATUS_2 );
+    if( sr2 & SPI_FLASH_STATUS_2_QE )
+    {
+        return SPI_FLASH_OK;
+    }
+
+    flash_command( p_flash, SPI_FLASH_CMD_VOLATILE_SR_WRITE_ENABLE );
+    spi_write_word( p_flash->spi, SPI_FLASH_CMD_WRITE_STATUS_2
+                    | ( (uint32_t)( sr2 | SPI_FLASH_STATUS_2_QE ) << 8 ) );
+    flash_segment( p_flash, 2, false, kSpiDirTxOnly, kSpiSpeedStandard );
+    while( flash_busy( p_flash ) );
+
+    sr2 = flash_read_reg( p_flash, SPI_FLASH_CMD_READ_STATUS_2 );
+    return ( sr2 & SPI_FLASH_STATUS_2_QE ) ? SPI_FLASH_OK : SPI_FLASH_ERROR;
+}
+
+static void flash_command( spi_flash_t *p_flash, uint8_t p_cmd )
+{
+    spi_write_word( p_flash->spi, p_cmd );
+    flash_segment( p_flash, 1, false, kSpiDirTxOnly, kSpiSpeedStandard );
+}
+
+static uint8_t flash_read_reg( spi_flash_t *p_flash, uint8_t p_cmd )
+{
+    uint32_t value;
+    spi_write_word( p_flash->spi, p_cmd );
+    flash_segment( p_flash, 1, true, kSpiDirTxOnly, kSpiSpeedStandard );
+    flash_segment( p_flash, 1, false, kSpiDirRxOnly, kSpiSpeedStandard );
+    while( spi_get_rx_queue_depth( p_flash->spi ) == 0 );
+    spi_read_word( p_flash->spi, &value );
+    return (uint8_t) value;
+}
+
+static bool flash_spi_busy( spi_flash_t *p_flash )
+{
+    uint32_t status = spi_get_status( p_flash->spi );
+    return bitfield_bit32_read( status, SPI_HOST_STATUS_ACTIVE_BIT )
+        || bitfield_field32_read( status, SPI_HOST_STATUS_CMDQD_FIELD ) != 0;
+}
+
+static bool flash_busy( spi_flash_t *p_flash )
+{
+    if( flash_spi_busy( p_flash ) )
+    {
+        return true;
+    }
+    if( !p_flash->cfg.poll_status )
+    {
+        return false;
+    }
+    return ( flash_read_reg( p_flash, SPI_FLASH_CMD_READ_STATUS_1 )
+             & SPI_FLASH_STATUS_1_BUSY ) != 0;
+}
+
+static spi_flash_result_t flash_dma( spi_flash_t *p_flash,
+                                     uint8_t     *p_data,
+                                     uint32_t    p_words,
+                                     bool        p_to_flash )
+{
+    uint32_t offset = p_to_flash ? SPI_HOST_TXDATA_REG_OFFSET
+                                 : SPI_HOST_RXDATA_REG_OFFSET;
+
+    p_flash->mem = (dma_target_t){
+        .ptr        = p_data,
+        .inc_du     = 1,
+        .size_du    = p_words,
+        .type       = DMA_DATA_TYPE_WORD,
+        .trig       = DMA_TRIG_MEMORY,
+    };
+    p_flash->fifo = (dma_target_t){
+        .ptr        = (uint8_t*)p_flash->spi->base_addr.base + offset,
+        .inc_du     = 0,
+        .size_du    = p_words,
+        .type       = DMA_DATA_TYPE_WORD,
+        .trig       = p_to_flash ? p_flash->tx_slot : p_flash->rx_slot,
+    };
+    p_flash->trans = (dma_trans_t){
+        .src        = p_to_flash ? &p_flash->mem : &p_flash->fifo,
+        .dst        = p_to_flash ? &p_flash->fifo : &p_flash->mem,
+        .mode       = DMA_TRANS_MODE_SINGLE,
+        .win_du     = 0,
+        .end        = p_flash->cfg.dma_intr ? DMA_TRANS_END_INTR
+                                            : DMA_TRANS_END_POLLING,
+        .channel    = p_flash->cfg.dma_ch,
+    };
+
+    dma_config_flags_t flags;
+    flags = dma_validate_transaction( &p_flash->trans,
+                                      DMA_DO_NOT_ENABLE_REALIGN,
+                                      DMA_PERFORM_CHECKS_INTEGRITY );
+    if(     !dma_is_ready( p_flash->cfg.dma_ch )
+        ||  ( flags & DMA_CONFIG_CRITICAL_ERROR )
+        ||  dma_load_transaction( &p_flash->trans ) != DMA_CONFIG_OK )
+    {
+        return SPI_FLASH_ERROR_DMA;
+    }
+    return SPI_FLASH_OK;
+}
+
+static spi_flash_result_t flash_page( spi_flash_t *p_flash )
+{
+    uint32_t len = SPI_FLASH_PAGE_SIZE - ( p_flash->addr % SPI_FLASH_PAGE_SIZE );
+    if( len > p_flash->remaining )
+    {
+        len = p_flash->remaining;
+    }
+    uint8_t *data = p_flash->data;
+    bool dma = ( (uintptr_t)data & 3 ) == 0 && len >= SPI_FLASH_DMA_THRESHOLD_B;
+
+    if( dma )
+    {
+        /* Loaded before the flash is told to expect data. */
+        spi_flash_result_t res = flash_dma( p_flash, data, len >> 2, true );
+        if( res != SPI_FLASH_OK )
+        {
+            return res;
+        }
+    }
+
+    /* The write enable, the header and the data are queued back to back:
+     * the command FIFO holds the three segments. */
+    flash_command( p_flash, SPI_FLASH_CMD_WRITE_ENABLE );
+    flash_header( p_flash, SPI_FLASH_CMD_PAGE_PROGRAM, p_flash->addr );
+
+    if( dma )
+    {
+        p_flash->tail   = len & 3;
+        p_flash->data   = data + len - p_flash->tail;
+        p_flash->stage  = STAGE_DATA;
+        dma_launch( &p_flash->trans );
+    }
+    else
+    {
+        /* A page and its header fit in the TX FIFO. */
+        for( uint32_t i = 0; i < len; i += 4 )
+        {
+            uint32_t word = 0;
+            memcpy( &word, &data[ i ], ( len - i < 4 ) ? len - i : 4 );
+            spi_wait_for_tx_not_full( p_flash->spi );
+            spi_write_word( p_flash->spi, word );
+        }
+        p_flash->tail   = 0;
+        p_flash->data   = data + len;
+        p_flash->stage  = STAGE_BUSY;
+    }
+    /* The SPI host stalls until the DMA fills the TX FIFO. */
+    flash_segment( p_flash, len, false, kSpiDirTxOnly, kSpiSpeedStandard );
+
+    p_flash->addr       += len;
+    p_flash->remaining  -= len;
+    return SPI_FLASH_OK;
+}
+
+static spi_flash_result_t flash_finish( spi_flash_t        *p_flash,
+                                        spi_flash_result_t p_res )
+{
+    spi_flash_cb_t cb   = p_flash->cb;
+    pbuf_t         *pbuf = p_flash->pbuf;
+    p_flash->pbuf = NULL;
+    p_flash->seg  = NULL;
+    p_flash->op   = SPI_FLASH_OP_NONE;
+    pbuf_free( pbuf );
+    if( cb != NULL )
+    {
+        cb( p_flash, p_res );
+    }
+    return p_res;
+}
+
+static bool flash_next_seg( spi_flash_t *p_flash )
+{
+    if( p_flash->seg == NULL )
+    {
+        return false;
+    }
+    do
+    {
+        p_flash->seg = p_flash->seg->next;
+    } while( p_flash->seg != NULL && p_flash->seg->len == 0 );
+
+    if( p_flash->seg == NULL )
+    {
+        return false;
+    }
+    p_flash->data      = p_flash->seg->payload;
+    p_flash->remaining = p_flash->seg->len;
+    return true;
+}
+
+static spi_flash_result_t flash_check( spi_flash_t *p_flash,
+                                       uint32_t    p_addr,
+                                       const void  *p_data,
+                                       uint32_t    p_len )
+{
+    if( p_flash->op != SPI_FLASH_OP_NONE )
+    {
+        return SPI_FLASH_BUSY;
+    }
+    if( p_data == NULL || p_len == 0 || p_addr > SPI_FLASH_MAX_ADDR
+        || p_len > SPI_FLASH_MAX_ADDR + 1 - p_addr )
+    {
+        return SPI_FLASH_ERROR;
+    }
+    return SPI_FLASH_OK;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,378 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : spi_flash.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   spi_flash.h
+* @date   14/10/26
+* @brief  Driver for the SPI NOR flash memories connected to a SPI host.
+*
+* It uses the commands shared by the common SPI NOR flashes (W25Q, MX25,
+* IS25...) with 24-bit addresses: read, page program, erase and status
+* registers. The reads can also use the quad commands, whose data is received
+* on the four lines: Fast Read Quad Output (0x6B) sends the command and the
+* address on one line, Fast Read Quad I/O (0xEB) only the command. They need
+* the flash to be in quad mode, which is set by spi_flash_init with the QE bit
+* of the status register 2 as on the W25Q.
+*
+* Each operation is queued as a whole in the command FIFO of the SPI host,
+* without waiting for the end of each segment, and the data is moved by a DMA
+* channel when it is large and word aligned. The operations are asynchronous:
+* they are started by a spi_flash_*_async function and advanced by
+* spi_flash_poll, which returns SPI_FLASH_BUSY until they are done and then
+* calls their callback. A program is split in pages: the next page is sent as
+* soon as the status register reports the end of the previous one. The
+* blocking functions are the asynchronous ones followed by spi_flash_wait.
+*
+* A packet of buffers (pbuf.h) is programmed with
+* spi_flash_program_pbuf_async, straight from its buffers, and freed at the
+* end. A packet is filled by reading in the payload of each buffer, which is
+* word aligned for the DMA.
+*
+* The application has to call dma_init before spi_flash_init, and to select
+* the SPI host if the flash is also connected to the memory mapped SPI.
+*/
+
+#ifndef _SPI_FLASH_H_
+#define _SPI_FLASH_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spi_host.h"
+#include "dma.h"
+#include "pbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The commands of the flash.
+ */
+#define SPI_FLASH_CMD_WRITE_ENABLE      0x06
+#define SPI_FLASH_CMD_READ              0x03
+#define SPI_FLASH_CMD_READ_QUAD_OUTPUT  0x6B
+#define SPI_FLASH_CMD_READ_QUAD_IO      0xEB
+#define SPI_FLASH_CMD_PAGE_PROGRAM      0x02
+#define SPI_FLASH_CMD_READ_STATUS_1     0x05
+#define SPI_FLASH_CMD_READ_STATUS_2     0x35
+#define SPI_FLASH_CMD_READ_STATUS_3     0x15
+#define SPI_FLASH_CMD_WRITE_STATUS_1    0x01
+#define SPI_FLASH_CMD_WRITE_STATUS_2    0x31
+#define SPI_FLASH_CMD_WRITE_STATUS_3    0x11
+#define SPI_FLASH_CMD_VOLATILE_SR_WRITE_ENABLE 0x50
+#define SPI_FLASH_CMD_POWER_DOWN        0xB9
+#define SPI_FLASH_CMD_RELEASE_POWER_DOWN 0xAB
+
+/**
+ * The busy bit of the status register 1, set during a program or an erase.
+ */
+#define SPI_FLASH_STATUS_1_BUSY         0x01
+
+/**
+ * The quad enable bit of the status register 2.
+ */
+#define SPI_FLASH_STATUS_2_QE           0x02
+
+/**
+ * The default dummy cycles of the quad reads, after the address (and the mode
+ * byte of Fast Read Quad I/O).
+ */
+#define SPI_FLASH_DUMMY_QUAD_OUTPUT     8
+#define SPI_FLASH_DUMMY_QUAD_IO         4
+
+/**
+ * The size of a page, the largest block that can be programmed at once.
+ */
+#define SPI_FLASH_PAGE_SIZE             256
+
+/**
+ * The highest address of a 24-bit flash.
+ */
+#define SPI_FLASH_MAX_ADDR              0x00FFFFFF
+
+/**
+ * The transfers from this size are done by the DMA, the smaller ones by the
+ * CPU.
+ */
+#define SPI_FLASH_DMA_THRESHOLD_B       64
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The results of the functions.
+ */
+typedef enum
+{
+    SPI_FLASH_OK        = 0,    /*!< The operation is done. */
+    SPI_FLASH_BUSY      = 1,    /*!< The operation is ongoing, or another
+    one already was. */
+    SPI_FLASH_ERROR     = 2,    /*!< Wrong parameters. */
+    SPI_FLASH_ERROR_DMA = 3,    /*!< The DMA refused the transaction. */
+} spi_flash_result_t;
+
+/**
+ * The erase commands, whose value is their opcode.
+ */
+typedef enum
+{
+    SPI_FLASH_ERASE_4K      = 0x20,
+    SPI_FLASH_ERASE_32K     = 0x52,
+    SPI_FLASH_ERASE_64K     = 0xD8,
+    SPI_FLASH_ERASE_CHIP    = 0xC7,
+} spi_flash_erase_t;
+
+/**
+ * The read commands.
+ */
+typedef enum
+{
+    SPI_FLASH_READ_STANDARD,    /*!< Read (0x03), one line. */
+    SPI_FLASH_READ_QUAD_OUTPUT, /*!< Fast Read Quad Output (0x6B). */
+    SPI_FLASH_READ_QUAD_IO,     /*!< Fast Read Quad I/O (0xEB). */
+} spi_flash_read_mode_t;
+
+/**
+ * The operations.
+ */
+typedef enum
+{
+    SPI_FLASH_OP_NONE,
+    SPI_FLASH_OP_READ,
+    SPI_FLASH_OP_PROGRAM,
+    SPI_FLASH_OP_ERASE,
+} spi_flash_op_t;
+
+struct spi_flash;
+
+/**
+ * Called from spi_flash_poll at the end of an asynchronous operation.
+ */
+typedef void (*spi_flash_cb_t)( struct spi_flash *p_flash,
+                                spi_flash_result_t p_res );
+
+/**
+ * The configuration of a flash.
+ */
+typedef struct
+{
+    uint32_t    clk_max_hz;     /*!< The maximum SPI clock of the flash. */
+    uint8_t     csid;           /*!< The chip select of the flash. */
+    uint8_t     dma_ch;         /*!< The DMA channel of the transfers. */
+    bool        dma_intr;       /*!< Whether the DMA raises its interrupt at
+    the end of each transfer, e.g. to wake up the CPU. */
+    bool        poll_status;    /*!< Whether the status register is read to
+    know when a program or an erase is done. It must be false on the flash
+    models that do not have one: these operations are then done at the end of
+    their SPI transfer, and the QE bit is not set. */
+    spi_flash_read_mode_t read_mode; /*!< The command of the reads. */
+    uint8_t     dummy_cycles;   /*!< The dummy cycles of the quad reads, or 0
+    for the default of the command, e.g. 8 for the simulation models of Fast
+    Read Quad I/O. */
+} spi_flash_cfg_t;
+
+/**
+ * A flash. Its fields are managed by the functions below.
+ */
+typedef struct spi_flash
+{
+    const spi_host_t            *spi;
+    spi_flash_cfg_t             cfg;
+    dma_trigger_slot_mask_t     rx_slot;    /*!< The triggers of the FIFOs of
+    the SPI host. */
+    dma_trigger_slot_mask_t     tx_slot;
+    dma_target_t                mem;
+    dma_target_t                fifo;
+    dma_trans_t                 trans;
+    volatile spi_flash_op_t     op;         /*!< The ongoing operation. */
+    uint8_t                     stage;      /*!< Its progress. */
+    uint32_t                    addr;       /*!< Its next address. */
+    uint8_t                     *data;      /*!< Its next data. */
+    uint32_t                    remaining;  /*!< Its size left, in bytes. */
+    uint32_t                    tail;       /*!< The bytes after the DMA
+    transfer, read or written by the CPU. */
+    spi_flash_cb_t              cb;
+    pbuf_t                      *pbuf;      /*!< The packet programmed,
+    freed at the end, or NULL. */
+    pbuf_t                      *seg;       /*!< Its buffer being
+    programmed. */
+} spi_flash_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Enables the SPI host, configures its chip select and wakes up the
+ * flash, also from a continuous read left by the boot. With a quad read mode
+ * and status polling, it also sets the QE bit, in the volatile status
+ * register 2 so the non-volatile one is not rewritten at each init.
+ * @param p_flash The flash, it must stay in memory while it is used.
+ * @param p_spi The SPI host of the flash.
+ * @param p_cfg The configuration, copied.
+ * @return SPI_FLASH_OK, or SPI_FLASH_ERROR if the configuration is wrong or
+ * the QE bit could not be set.
+ */
+spi_flash_result_t spi_flash_init( spi_flash_t           *p_flash,
+                                   const spi_host_t      *p_spi,
+                                   const spi_flash_cfg_t *p_cfg );
+
+/**
+ * @brief Starts reading from the flash.
+ * @param p_addr The address in the flash.
+ * @param p_data The buffer. It is filled by the DMA if it is word aligned.
+ * @param p_len The number of bytes.
+ * @param p_cb Called at the end, it may be NULL.
+ * @return SPI_FLASH_OK once started, SPI_FLASH_BUSY if another operation is
+ * ongoing, or an error.
+ */
+spi_flash_result_t spi_flash_read_async( spi_flash_t    *p_flash,
+                                         uint32_t       p_addr,
+                                         void           *p_data,
+                                         uint32_t       p_len,
+                                         spi_flash_cb_t p_cb );
+
+/**
+ * @brief Starts programming the flash, page by page. The bytes must have
+ * been erased.
+ * @param p_data The data, it must stay in memory until the end. It is sent
+ * by the DMA if it is word aligned.
+ * @return SPI_FLASH_OK once started, SPI_FLASH_BUSY if another operation is
+ * ongoing, or an error.
+ */
+spi_flash_result_t spi_flash_program_async( spi_flash_t    *p_flash,
+                                            uint32_t       p_addr,
+                                            const void     *p_data,
+                                            uint32_t       p_len,
+                                            spi_flash_cb_t p_cb );
+
+/**
+ * @brief Starts programming the flash with a packet, its buffers one after
+ * the other at consecutive addresses. The bytes must have been erased.
+ * @param p_pbuf The packet. Its reference is taken over once started, and
+ * freed at the end of the operation, before the callback.
+ * @return SPI_FLASH_OK once started, SPI_FLASH_BUSY if another operation is
+ * ongoing, or an error. The packet is not taken on an error.
+ */
+spi_flash_result_t spi_flash_program_pbuf_async( spi_flash_t    *p_flash,
+                                                 uint32_t       p_addr,
+                                                 pbuf_t         *p_pbuf,
+                                                 spi_flash_cb_t p_cb );
+
+/**
+ * @brief Starts erasing a sector, a block or the whole flash.
+ * @param p_addr An address in the sector or block, ignored for the chip.
+ * @return SPI_FLASH_OK once started, SPI_FLASH_BUSY if another operation is
+ * ongoing, or an error.
+ */
+spi_flash_result_t spi_flash_erase_async( spi_flash_t       *p_flash,
+                                          spi_flash_erase_t p_erase,
+                                          uint32_t          p_addr,
+                                          spi_flash_cb_t    p_cb );
+
+/**
+ * @brief Advances the ongoing operation without blocking.
+ * @return SPI_FLASH_BUSY while it is ongoing, then its result, which is
+ * also given to its callback. SPI_FLASH_OK if there is none.
+ */
+spi_flash_result_t spi_flash_poll( spi_flash_t *p_flash );
+
+/**
+ * @brief Polls the ongoing operation until it is done.
+ * @return Its result.
+ */
+spi_flash_result_t spi_flash_wait( spi_flash_t *p_flash );
+
+/**
+ * @brief Blocking versions of the operations above.
+ */
+spi_flash_result_t spi_flash_read( spi_flash_t *p_flash,
+                                   uint32_t    p_addr,
+                                   void        *p_data,
+                                   uint32_t    p_len );
+spi_flash_result_t spi_flash_program( spi_flash_t *p_flash,
+                                      uint32_t    p_addr,
+                                      const void  *p_data,
+                                      uint32_t    p_len );
+spi_flash_result_t spi_flash_erase( spi_flash_t       *p_flash,
+                                    spi_flash_erase_t p_erase,
+                                    uint32_t          p_addr );
+
+/**
+ * @brief Reads a status register.
+ * @param p_cmd Its read command, e.g. SPI_FLASH_CMD_READ_STATUS_1.
+ * @return SPI_FLASH_OK, or SPI_FLASH_BUSY if an operation is ongoing.
+ */
+spi_flash_result_t spi_flash_read_status( spi_flash_t *p_flash,
+                                          uint8_t     p_cmd,
+                                          uint8_t     *p_value );
+
+/**
+ * @brief Writes a status register, after a write enable, and waits for the
+ * end of the write.
+ * @param p_cmd Its write command, e.g. SPI_FLASH_CMD_WRITE_STATUS_2.
+ * @return SPI_FLASH_OK, or SPI_FLASH_BUSY if an operation is ongoing.
+ */
+spi_flash_result_t spi_flash_write_status( spi_flash_t *p_flash,
+                                           uint8_t     p_cmd,
+                                           uint8_t     p_value );
+
+/**
+ * @brief Puts the flash in power-down. Only spi_flash_power_up is accepted
+ * afterwards.
+ * @return SPI_FLASH_OK, or SPI_FLASH_BUSY if an operation is ongoing.
+ */
+spi_flash_result_t spi_flash_power_down( spi_flash_t *p_flash );
+
+/**
+ * @brief Wakes up the flash from power-down.
+ * @return SPI_FLASH_OK, or SPI_FLASH_BUSY if an operation is ongoing.
+ */
+spi_flash_result_t spi_flash_power_up( spi_flash_t *p_flash );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _SPI_FLASH_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -6,6 +6,7 @@
 
 #include "mmio.h"
 #include "bitfield.h"
+#include "clock_gate.h"
 
 // SPI get functions
 
@@ -54,9 +55,20 @@ void spi_sw_reset(const spi_host_t *spi) {
 }
 
 void spi_set_enable(const spi_host_t *spi, bool enable) {
+    uint32_t domain = clock_gate_domain_of((uintptr_t)spi->base_addr.base);
+    // The clock is needed to read the register, one reference is kept while
+    // the host is enabled
+    clock_gate_acquire(domain);
     volatile uint32_t ctrl_reg = mmio_region_read32(spi->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
+    bool was_enabled = bitfield_bit32_read(ctrl_reg, SPI_HOST_CONTROL_SPIEN_BIT);
     ctrl_reg = bitfield_bit32_write(ctrl_reg, SPI_HOST_CONTROL_SPIEN_BIT, enable);
     mmio_region_write32(spi->base_addr, SPI_HOST_CONTROL_REG_OFFSET, ctrl_reg);
+    if (!enable && was_enabled) {
+        clock_gate_release(domain);
+    }
+    if (!enable || was_enabled) {
+        clock_gate_release(domain);
+    }
 }
 
 void spi_set_tx_watermark(const spi_host_t *spi, uint8_t watermark) {
@@ -91,6 +103,25 @@ void spi_read_word(const spi_host_t *spi, uint32_t* dst) {
     *dst = mmio_region_read32(spi->base_addr, SPI_HOST_RXDATA_REG_OFFSET);
 }
 
+void spi_issue_segments(const spi_host_t *spi, const spi_segment_t *segments, uint32_t n_segments) {
+    for (uint32_t i = 0; i < n_segments; i++) {
+        const spi_segment_t *seg = &segments[i];
+        // Only waits for a free slot in the command FIFO, not for the end of
+        // the previous segments
+        spi_wait_for_ready(spi);
+        spi_set_command(spi, spi_create_command(seg->command));
+        // The data follows its command, so that a segment larger than the
+        // TX FIFO does not block it: the SPI host stalls until the data arrives
+        if (seg->txdata != NULL && seg->command.direction != kSpiDirRxOnly
+            && seg->command.direction != kSpiDirDummy) {
+            for (uint32_t w = 0; w <= (seg->command.len >> 2); w++) {
+                spi_wait_for_tx_not_full(spi);
+                spi_write_word(spi, seg->txdata[w]);
+            }
+        }
+    }
+}
+
 void spi_enable_evt_intr(const spi_host_t *spi, bool enable) {
     volatile uint32_t intr_enable_reg = mmio_region_read32(spi->base_addr, SPI_HOST_INTR_ENABLE_REG_OFFSET);
     intr_enable_reg = bitfield_bit32_write(intr_enable_reg, SPI_HOST_INTR_ENABLE_SPI_EVENT_BIT, enable);
@@ -115,6 +146,16 @@ void spi_enable_txempty_intr(const spi_host_t *spi, bool enable) {
     mmio_region_write32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET, intr_enable_reg);
 }
 
+void spi_enable_idle_intr(const spi_host_t *spi, bool enable) {
+    volatile uint32_t intr_enable_reg = mmio_region_read32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET);
+    intr_enable_reg = bitfield_bit32_write(intr_enable_reg, SPI_HOST_EVENT_ENABLE_IDLE_BIT, enable);
+    mmio_region_write32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET, intr_enable_reg);
+}
+
+void spi_clear_evt_intr(const spi_host_t *spi) {
+    mmio_region_write32(spi->base_addr, SPI_HOST_INTR_STATE_REG_OFFSET, 1 << SPI_HOST_INTR_STATE_SPI_EVENT_BIT);
+}
+
 void spi_output_enable(const spi_host_t *spi, bool enable){
     volatile uint32_t output_enable_reg = mmio_region_read32(spi->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
     output_enable_reg = bitfield_bit32_write(output_enable_reg, SPI_HOST_CONTROL_OUTPUT_EN_BIT, enable);
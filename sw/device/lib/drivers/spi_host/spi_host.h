@@ -80,6 +80,14 @@ typedef struct spi_command {
     spi_dir_e   direction   : 2;
 } spi_command_t;
 
+/**
+* SPI segment descriptor, for spi_issue_segments()
+*/
+typedef struct spi_segment {
+    spi_command_t   command;    // Segment command, len is in bytes - 1 (cycles - 1 for dummy segments)
+    const uint32_t *txdata;     // Words to send for TX and bidir segments, NULL if the TX FIFO is filled otherwise (e.g., by the DMA)
+} spi_segment_t;
+
 // SPI registers access functions
 
 /**
@@ -132,6 +140,9 @@ void spi_sw_reset(const spi_host_t *spi);
 /**
  * Enable the SPI host.
  *
+ * A SPI host of the peripheral domain holds its clock (clock_gate.h) while it
+ * is enabled: with clock gating, it must be enabled before any other access.
+ *
  * @param spi Pointer to spi_host_t representing the target SPI.
  * @param enable SPI enable register value.
  */
@@ -194,6 +205,22 @@ void spi_write_word(const spi_host_t *spi, uint32_t wdata);
  */
 void spi_read_word(const spi_host_t *spi, uint32_t* dst);
 
+/**
+ * Queue several segments back to back.
+ * Each command is written as soon as the command FIFO has room for it, so
+ * the SPI host goes from one segment to the next without waiting for the
+ * CPU. The function returns once the last command and its TX data are
+ * queued: the end of the transfer can be signaled by the idle event interrupt
+ * (see spi_enable_idle_intr()). The RX data is left in the RX FIFO; the
+ * segments that receive more than it can hold need the DMA, or the SPI host
+ * stalls.
+ *
+ * @param spi Pointer to spi_host_t representing the target SPI.
+ * @param segments Array of segment descriptors, in the order to send them.
+ * @param n_segments Number of segments.
+ */
+void spi_issue_segments(const spi_host_t *spi, const spi_segment_t *segments, uint32_t n_segments);
+
 /**
  * Enable SPI event interrupt
  *
@@ -226,6 +253,22 @@ void spi_enable_rxwm_intr(const spi_host_t *spi, bool enable);
  */
 void spi_enable_txempty_intr(const spi_host_t *spi, bool enable);
 
+/**
+ * Enable SPI idle event interrupt. The SPI event interrupt is raised when the
+ * SPI host has executed all the queued segments.
+ *
+ * @param spi Pointer to spi_host_t representing the target SPI.
+ * @param enable SPI idle interrupt bit value.
+ */
+void spi_enable_idle_intr(const spi_host_t *spi, bool enable);
+
+/**
+ * Clear the SPI event interrupt, to be called by its handler.
+ *
+ * @param spi Pointer to spi_host_t representing the target SPI.
+ */
+void spi_clear_evt_intr(const spi_host_t *spi);
+
 /**
  * Enable SPI output
  *
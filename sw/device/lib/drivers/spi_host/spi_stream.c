@@ -0,0 +1,232 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spi_stream.h"
+
+#include "mmio.h"
+#include "bitfield.h"
+#include "core_v_mini_mcu.h"
+
+// Static functions
+
+static void stream_set_events(const spi_stream_t *stream, uint32_t events) {
+    mmio_region_write32(stream->spi.base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET, events);
+}
+
+// Reads the RX FIFO until it is empty, so that it crosses its watermark again
+static void stream_drain(spi_stream_t *stream) {
+    while (stream->rx_left > 0
+           && !mmio_region_get_bit32(stream->spi.base_addr, SPI_HOST_STATUS_REG_OFFSET, SPI_HOST_STATUS_RXEMPTY_BIT)) {
+        spi_read_word(&stream->spi, stream->rx++);
+        stream->rx_left--;
+    }
+}
+
+// Writes the TX FIFO until it is full, so that it crosses its watermark again
+static void stream_fill(spi_stream_t *stream) {
+    while (stream->tx_left > 0
+           && !mmio_region_get_bit32(stream->spi.base_addr, SPI_HOST_STATUS_REG_OFFSET, SPI_HOST_STATUS_TXFULL_BIT)) {
+        spi_write_word(&stream->spi, *stream->tx++);
+        stream->tx_left--;
+    }
+}
+
+static spi_stream_result_e stream_dma(spi_stream_t *stream, dma_target_t *mem, dma_target_t *fifo,
+                                      dma_trans_t *trans, void *data, uint32_t words, bool to_spi) {
+    uint32_t offset = to_spi ? SPI_HOST_TXDATA_REG_OFFSET : SPI_HOST_RXDATA_REG_OFFSET;
+    uint8_t ch = to_spi ? stream->cfg.dma_tx_ch : stream->cfg.dma_rx_ch;
+
+    *mem = (dma_target_t){
+        .ptr     = data,
+        .inc_du  = 1,
+        .size_du = words,
+        .type    = DMA_DATA_TYPE_WORD,
+        .trig    = DMA_TRIG_MEMORY,
+    };
+    *fifo = (dma_target_t){
+        .ptr     = (uint8_t *)stream->spi.base_addr.base + offset,
+        .inc_du  = 0,
+        .size_du = words,
+        .type    = DMA_DATA_TYPE_WORD,
+        .trig    = to_spi ? stream->tx_slot : stream->rx_slot,
+    };
+    *trans = (dma_trans_t){
+        .src     = to_spi ? mem : fifo,
+        .dst     = to_spi ? fifo : mem,
+        .mode    = DMA_TRANS_MODE_SINGLE,
+        .win_du  = 0,
+        .end     = DMA_TRANS_END_POLLING,
+        .channel = ch,
+    };
+
+    dma_config_flags_t flags = dma_validate_transaction(trans, DMA_DO_NOT_ENABLE_REALIGN,
+                                                        DMA_PERFORM_CHECKS_INTEGRITY);
+    if (!dma_is_ready(ch) || (flags & DMA_CONFIG_CRITICAL_ERROR)
+        || dma_load_transaction(trans) != DMA_CONFIG_OK) {
+        return kSpiStreamError;
+    }
+    return kSpiStreamOk;
+}
+
+static void stream_finish(spi_stream_t *stream) {
+    stream_set_events(stream, 0);
+    spi_enable_evt_intr(&stream->spi, false);
+    spi_clear_evt_intr(&stream->spi);
+    stream->busy = false;
+    if (stream->cfg.cb != NULL) {
+        stream->cfg.cb(stream);
+    }
+}
+
+// Exported functions
+
+spi_stream_result_e spi_stream_init(spi_stream_t *stream, const spi_host_t *spi,
+                                    const spi_stream_cfg_t *cfg) {
+    if (cfg->csid >= SPI_HOST_PARAM_NUM_C_S || cfg->speed > kSpiSpeedQuad) {
+        return kSpiStreamError;
+    }
+    uintptr_t base = (uintptr_t)spi->base_addr.base;
+    if (cfg->mode == kSpiStreamModeDma) {
+        // SPI host and SPI flash are the same IP, but with their own triggers
+        if (base == SPI_HOST_START_ADDRESS) {
+            stream->tx_slot = DMA_TRIG_SLOT_SPI_TX;
+            stream->rx_slot = DMA_TRIG_SLOT_SPI_RX;
+        } else if (base == SPI_FLASH_START_ADDRESS) {
+            stream->tx_slot = DMA_TRIG_SLOT_SPI_FLASH_TX;
+            stream->rx_slot = DMA_TRIG_SLOT_SPI_FLASH_RX;
+        } else {
+            return kSpiStreamError;
+        }
+        if (cfg->dma_tx_ch >= DMA_CH_NUM || cfg->dma_rx_ch >= DMA_CH_NUM) {
+            return kSpiStreamError;
+        }
+    } else if (cfg->mode == kSpiStreamModeIntr) {
+        if (cfg->tx_watermark == 0 || cfg->tx_watermark > SPI_HOST_PARAM_TX_DEPTH
+            || cfg->rx_watermark == 0 || cfg->rx_watermark > SPI_HOST_PARAM_RX_DEPTH) {
+            return kSpiStreamError;
+        }
+    } else {
+        return kSpiStreamError;
+    }
+
+    stream->spi = *spi;
+    stream->cfg = *cfg;
+    stream->tx = NULL;
+    stream->rx = NULL;
+    stream->tx_left = 0;
+    stream->rx_left = 0;
+    stream->busy = false;
+    return kSpiStreamOk;
+}
+
+spi_stream_result_e spi_stream_transfer(spi_stream_t *stream, const uint32_t *tx,
+                                        uint32_t *rx, uint32_t words, bool keep_cs) {
+    if (stream->busy) {
+        return kSpiStreamBusy;
+    }
+    if ((tx == NULL && rx == NULL) || words == 0 || words > SPI_STREAM_MAX_WORDS
+        || (tx != NULL && rx != NULL && stream->cfg.speed != kSpiSpeedStandard)
+        || (tx != NULL && rx != NULL && stream->cfg.mode == kSpiStreamModeDma
+            && stream->cfg.dma_tx_ch == stream->cfg.dma_rx_ch)) {
+        return kSpiStreamError;
+    }
+
+    spi_dir_e direction = tx == NULL ? kSpiDirRxOnly : rx == NULL ? kSpiDirTxOnly : kSpiDirBidir;
+    // The end of the transfer is the rising edge of idle
+    uint32_t events = 1 << SPI_HOST_EVENT_ENABLE_IDLE_BIT;
+
+    stream->tx = tx;
+    stream->rx = rx;
+    stream->tx_left = tx != NULL ? words : 0;
+    stream->rx_left = rx != NULL ? words : 0;
+
+    // Waits for room in the command FIFO
+    spi_wait_for_ready(&stream->spi);
+    spi_set_csid(&stream->spi, stream->cfg.csid);
+
+    if (stream->cfg.mode == kSpiStreamModeDma) {
+        // The RX channel first, so that it is waiting for the first word
+        if (rx != NULL && stream_dma(stream, &stream->mem_rx, &stream->fifo_rx, &stream->trans_rx,
+                                     rx, words, false) != kSpiStreamOk) {
+            return kSpiStreamError;
+        }
+        if (tx != NULL && stream_dma(stream, &stream->mem_tx, &stream->fifo_tx, &stream->trans_tx,
+                                     (void *)tx, words, true) != kSpiStreamOk) {
+            return kSpiStreamError;
+        }
+        if (rx != NULL) {
+            dma_launch(&stream->trans_rx);
+        }
+        if (tx != NULL) {
+            dma_launch(&stream->trans_tx);
+        }
+        stream->tx_left = 0;
+        stream->rx_left = 0;
+    } else {
+        spi_set_tx_watermark(&stream->spi, stream->cfg.tx_watermark);
+        spi_set_rx_watermark(&stream->spi, stream->cfg.rx_watermark);
+        // Filled before the command, so that the SPI host does not stall on
+        // the first word
+        stream_fill(stream);
+        if (stream->tx_left > 0) {
+            events |= 1 << SPI_HOST_EVENT_ENABLE_TXWM_BIT;
+        }
+        if (stream->rx_left > 0) {
+            events |= 1 << SPI_HOST_EVENT_ENABLE_RXWM_BIT;
+        }
+    }
+
+    stream->busy = true;
+    spi_clear_evt_intr(&stream->spi);
+    stream_set_events(stream, events);
+    spi_enable_evt_intr(&stream->spi, true);
+
+    const spi_command_t command = {
+        .len       = words * 4 - 1,
+        .csaat     = keep_cs,
+        .speed     = stream->cfg.speed,
+        .direction = direction
+    };
+    spi_set_command(&stream->spi, spi_create_command(command));
+    return kSpiStreamOk;
+}
+
+void spi_stream_irq_handler(spi_stream_t *stream) {
+    // Cleared first, so that the events raised while the FIFOs are served
+    // call the handler again
+    spi_clear_evt_intr(&stream->spi);
+    if (!stream->busy) {
+        return;
+    }
+
+    if (stream->cfg.mode == kSpiStreamModeIntr) {
+        stream_drain(stream);
+        stream_fill(stream);
+        if (stream->tx_left == 0) {
+            uint32_t events = mmio_region_read32(stream->spi.base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET);
+            stream_set_events(stream, bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_TXWM_BIT, false));
+        }
+    }
+
+    // The command is not done, or not started yet
+    uint32_t status = spi_get_status(&stream->spi);
+    if (bitfield_bit32_read(status, SPI_HOST_STATUS_ACTIVE_BIT)
+        || bitfield_field32_read(status, SPI_HOST_STATUS_CMDQD_FIELD) != 0) {
+        return;
+    }
+
+    // The command is done: the last words are below the RX watermark, or
+    // still in the DMA
+    if (stream->cfg.mode == kSpiStreamModeIntr) {
+        stream_drain(stream);
+    } else {
+        if (stream->rx != NULL) {
+            while (!dma_is_ready(stream->cfg.dma_rx_ch));
+        }
+        if (stream->tx != NULL) {
+            while (!dma_is_ready(stream->cfg.dma_tx_ch));
+        }
+    }
+    stream_finish(stream);
+}
@@ -0,0 +1,164 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Streaming transfers of the opentitan SPI host
+//
+// A transfer is a single command of the SPI host, full duplex or in one
+// direction, whose data is moved while it runs so that the FIFOs neither
+// empty nor fill up: the SPI clock runs with no gap as long as the data
+// keeps up.
+//
+// - kSpiStreamModeIntr: the SPI event interrupt tops the TX FIFO up when
+//   it falls below its watermark and drains the RX FIFO when it reaches its
+//   watermark. The CPU only runs for a burst of words per watermark.
+// - kSpiStreamModeDma: two DMA channels move the data, triggered by the TX
+//   and RX slots of the SPI host, and the CPU only runs at the end. Only the
+//   SPI host and the SPI flash have DMA slots, dma_init must be called before.
+//
+// In both modes the end of the transfer is the idle event, and the callback
+// is called from the interrupt. The application routes the SPI event
+// interrupt of the host to spi_stream_irq_handler(): fic_irq_spi() for the
+// SPI host, fic_irq_spi_flash() for the SPI flash or the PLIC handler of
+// SPI2_INTR_EVENT for SPI2. The host must be enabled and configured
+// (spi_set_configopts(), spi_output_enable()) before.
+
+#ifndef _DRIVERS_SPI_STREAM_H_
+#define _DRIVERS_SPI_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spi_host.h"
+#include "dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Words of a transfer at most, the 24-bit length of a command in bytes.
+ */
+#define SPI_STREAM_MAX_WORDS (1 << 22)
+
+/**
+ * SPI stream results
+ */
+typedef enum {
+    kSpiStreamOk    = 0,
+    kSpiStreamBusy  = 1,
+    kSpiStreamError = 2
+} spi_stream_result_e;
+
+/**
+ * Who moves the data of the FIFOs
+ */
+typedef enum {
+    kSpiStreamModeIntr = 0,
+    kSpiStreamModeDma  = 1
+} spi_stream_mode_e;
+
+struct spi_stream;
+
+/**
+ * Called from the SPI event interrupt at the end of a transfer.
+ */
+typedef void (*spi_stream_cb_t)(struct spi_stream *stream);
+
+/**
+ * SPI stream configuration structure
+ */
+typedef struct spi_stream_cfg {
+    spi_stream_mode_e mode;
+    uint32_t          csid;         // Chip select of the device
+    spi_speed_e       speed;        // kSpiSpeedStandard for the full duplex transfers
+    uint8_t           tx_watermark; // Interrupt mode: words in the TX FIFO below which it is topped up
+    uint8_t           rx_watermark; // Interrupt mode: words in the RX FIFO from which it is drained
+    uint8_t           dma_tx_ch;    // DMA mode: channel of the TX data
+    uint8_t           dma_rx_ch;    // DMA mode: channel of the RX data, not dma_tx_ch for the full duplex transfers
+    spi_stream_cb_t   cb;           // End of transfer callback, it may be NULL
+    void             *ctx;          // User context, not used by the driver
+} spi_stream_cfg_t;
+
+/**
+ * A stream. Its fields are managed by the functions below.
+ */
+typedef struct spi_stream {
+    spi_host_t        spi;
+    spi_stream_cfg_t  cfg;
+    const uint32_t   *tx;
+    uint32_t         *rx;
+    uint32_t          tx_left;      // Words still to write to the TX FIFO
+    uint32_t          rx_left;      // Words still to read from the RX FIFO
+    volatile bool     busy;
+    uint8_t           tx_slot;
+    uint8_t           rx_slot;
+    dma_target_t      mem_tx;
+    dma_target_t      fifo_tx;
+    dma_target_t      mem_rx;
+    dma_target_t      fifo_rx;
+    dma_trans_t       trans_tx;
+    dma_trans_t       trans_rx;
+} spi_stream_t;
+
+/**
+ * Initialize a stream on a SPI host.
+ *
+ * @param stream Stream to initialize, it must be a static variable.
+ * @param spi Pointer to spi_host_t representing the target SPI, copied.
+ * @param cfg Configuration, copied.
+ * @return kSpiStreamError if the configuration is not valid, or the DMA mode
+ * is asked for a host without DMA slots.
+ */
+spi_stream_result_e spi_stream_init(spi_stream_t *stream, const spi_host_t *spi,
+                                    const spi_stream_cfg_t *cfg);
+
+/**
+ * Start a transfer. With both buffers it is full duplex: tx[i] is sent while
+ * rx[i] is received. With one of them NULL it is TX or RX only. The bytes of
+ * a word are sent and received from the LSB.
+ *
+ * @param stream The stream.
+ * @param tx Words to send, NULL for a RX only transfer.
+ * @param rx Words received, NULL for a TX only transfer.
+ * @param words Words of the transfer, from 1 to SPI_STREAM_MAX_WORDS.
+ * @param keep_cs Keep the chip select active at the end, so that the next
+ * transfer continues the same SPI transaction.
+ * @return kSpiStreamBusy if a transfer is running, kSpiStreamError if the
+ * parameters are not valid or the DMA refuses the transactions. A full
+ * duplex transfer needs the standard speed and, in DMA mode, two channels.
+ */
+spi_stream_result_e spi_stream_transfer(spi_stream_t *stream, const uint32_t *tx,
+                                        uint32_t *rx, uint32_t words, bool keep_cs);
+
+/**
+ * Move the data of a transfer and end it, to be called by the handler of
+ * the SPI event interrupt of the host.
+ *
+ * @param stream The stream.
+ */
+void spi_stream_irq_handler(spi_stream_t *stream);
+
+/**
+ * Tell whether a transfer is running.
+ *
+ * @param stream The stream.
+ */
+static inline __attribute__((always_inline)) bool spi_stream_busy(const spi_stream_t *stream) {
+    return stream->busy;
+}
+
+/**
+ * Wait for the end of the running transfer, if any.
+ *
+ * @param stream The stream.
+ */
+static inline __attribute__((always_inline)) void spi_stream_wait(const spi_stream_t *stream) {
+    while (stream->busy);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_SPI_STREAM_H_
@@ -0,0 +1,120 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spi_memio.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mmio.h"
+#include "bitfield.h"
+
+#include "spi_memio_regs.h"  // Generated.
+
+// Fields of CFG_SPIMEM, the configuration register of spimemio.v
+#define SPI_MEMIO_CFG_EN_BIT 31
+#define SPI_MEMIO_CFG_MODE_FIELD ((bitfield_field32_t){.mask = 0x3, .index = 21})
+#define SPI_MEMIO_CFG_CONT_BIT 20
+#define SPI_MEMIO_CFG_DUMMY_FIELD ((bitfield_field32_t){.mask = 0xf, .index = 16})
+#define SPI_MEMIO_CFG_OE_FIELD ((bitfield_field32_t){.mask = 0xf, .index = 8})
+#define SPI_MEMIO_CFG_CSB_BIT 5
+#define SPI_MEMIO_CFG_CLK_BIT 4
+#define SPI_MEMIO_CFG_DO_FIELD ((bitfield_field32_t){.mask = 0xf, .index = 0})
+
+static void spi_memio_write_cfg(const spi_memio_t *spi_memio, uint32_t cfg) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET), cfg);
+}
+
+void spi_memio_set_config(const spi_memio_t *spi_memio, const spi_memio_cfg_t *cfg) {
+  uint32_t reg = 0;
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_EN_BIT, true);
+  reg = bitfield_field32_write(reg, SPI_MEMIO_CFG_MODE_FIELD, cfg->mode);
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_CONT_BIT, cfg->continuous && cfg->mode != SPI_MEMIO_MODE_STANDARD);
+  reg = bitfield_field32_write(reg, SPI_MEMIO_CFG_DUMMY_FIELD, cfg->dummy_cycles);
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_CSB_BIT, true);
+  spi_memio_write_cfg(spi_memio, reg);
+}
+
+void spi_memio_get_config(const spi_memio_t *spi_memio, spi_memio_cfg_t *cfg) {
+  uint32_t reg = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET));
+  cfg->mode = (spi_memio_mode_t)bitfield_field32_read(reg, SPI_MEMIO_CFG_MODE_FIELD);
+  cfg->continuous = bitfield_bit32_read(reg, SPI_MEMIO_CFG_CONT_BIT);
+  cfg->dummy_cycles = bitfield_field32_read(reg, SPI_MEMIO_CFG_DUMMY_FIELD);
+}
+
+void spi_memio_select(const spi_memio_t *spi_memio, const soc_ctrl_t *soc_ctrl, const spi_memio_cfg_t *cfg) {
+  soc_ctrl_select_spi_memio(soc_ctrl);
+  spi_memio_set_config(spi_memio, cfg);
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_START_SPIMEM_REG_OFFSET),
+                      1 << OBI_SPIMEMIO_START_SPIMEM_START_SPIMEM_BIT);
+  spi_memio_cache_flush(spi_memio);
+}
+
+void spi_memio_release(const spi_memio_t *spi_memio, const soc_ctrl_t *soc_ctrl) {
+  // Bit-banged mode: the transfers stop, chip select high
+  uint32_t reg = 0;
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_CSB_BIT, true);
+  spi_memio_write_cfg(spi_memio, reg);
+
+  // Continuous read mode reset: 8 clocks with all the IOs high, which in a
+  // continuous read are mode bits other than 0xAx
+  reg = bitfield_field32_write(reg, SPI_MEMIO_CFG_OE_FIELD, 0xf);
+  reg = bitfield_field32_write(reg, SPI_MEMIO_CFG_DO_FIELD, 0xf);
+  spi_memio_write_cfg(spi_memio, reg);
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_CSB_BIT, false);
+  spi_memio_write_cfg(spi_memio, reg);
+  for (int i = 0; i < 8; i++) {
+    spi_memio_write_cfg(spi_memio, bitfield_bit32_write(reg, SPI_MEMIO_CFG_CLK_BIT, true));
+    spi_memio_write_cfg(spi_memio, reg);
+  }
+  reg = bitfield_bit32_write(reg, SPI_MEMIO_CFG_CSB_BIT, true);
+  spi_memio_write_cfg(spi_memio, reg);
+  reg = bitfield_field32_write(reg, SPI_MEMIO_CFG_OE_FIELD, 0);
+  spi_memio_write_cfg(spi_memio, reg);
+
+  soc_ctrl_select_spi_host(soc_ctrl);
+}
+
+void spi_memio_arbiter_enable(const spi_memio_t *spi_memio, bool enable) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_ARBITER_CTRL_REG_OFFSET),
+                      (uint32_t)enable << OBI_SPIMEMIO_ARBITER_CTRL_ENABLE_BIT);
+}
+
+void spi_memio_cache_enable(const spi_memio_t *spi_memio, bool enable, bool prefetch) {
+  uint32_t ctrl = 0;
+  ctrl = bitfield_bit32_write(ctrl, OBI_SPIMEMIO_CACHE_CTRL_ENABLE_BIT, enable);
+  ctrl = bitfield_bit32_write(ctrl, OBI_SPIMEMIO_CACHE_CTRL_PREFETCH_BIT, prefetch);
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_CTRL_REG_OFFSET), ctrl);
+}
+
+void spi_memio_cache_flush(const spi_memio_t *spi_memio) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_FLUSH_REG_OFFSET),
+                      1 << OBI_SPIMEMIO_CACHE_FLUSH_CACHE_FLUSH_BIT);
+}
+
+void spi_memio_cache_get_stats(const spi_memio_t *spi_memio, uint32_t *hits, uint32_t *misses) {
+  *hits = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_HITS_REG_OFFSET));
+  *misses = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_MISSES_REG_OFFSET));
+}
+
+void spi_memio_cache_clear_stats(const spi_memio_t *spi_memio) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_HITS_REG_OFFSET), 0);
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_MISSES_REG_OFFSET), 0);
+}
+
+const void *spi_memio_load_async(void *scratch, const void *table, size_t len, dma_copy_token_t *token) {
+  if (!spi_memio_is_mapped(table)) {
+    *token = DMA_COPY_TOKEN_CPU;
+    return table;
+  }
+  *token = dma_memcpy_async(scratch, table, len);
+  return scratch;
+}
+
+const void *spi_memio_load(void *scratch, const void *table, size_t len) {
+  dma_copy_token_t token;
+  const void *data = spi_memio_load_async(scratch, table, len, &token);
+  dma_copy_wait(token);
+  return data;
+}
@@ -2,20 +2,85 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
-// Basic device functions for opentitan SPI host
+// Basic device functions for the YosysHQ SPI MEMIO, which maps the flash at
+// FLASH_MEM_START_ADDRESS, and for its read cache when FLASH_CACHE_WAYS > 0.
+//
+// The read command of the SPI MEMIO is set by spi_memio_set_config. The quad
+// modes need the QE bit of the flash, which spi_flash_init sets with a quad
+// read mode. The flash pins are shared with the SPI host: spi_memio_release
+// hands them over to it, and spi_memio_select takes them back. Neither can be
+// called from code executed in place from the flash.
+// With spi_memio_arbiter_enable the SPI host also uses the flash while the
+// SPI MEMIO is selected: the hardware interleaves its chip select sessions
+// with the reads of the SPI MEMIO, so that code executed in place keeps
+// running while data is written or read by the SPI host and the DMA. The
+// COMMAND segments of one session must be written from code that does not
+// read the flash in between, e.g. XHEEP_SECTION_FAST_TEXT (bank_sections.h).
+// The cache is enabled with prefetch at reset. It does not see the writes to
+// the flash through the SPI host, so it has to be flushed after them.
+//
+// Large constant tables (filter coefficients, network weights...) declared
+// with FLASH_RODATA are linked in .rodata_flash, which stays in the flash with
+// the flash_exec and flash_load linkers, instead of using the RAM. They are
+// read in place while the SPI MEMIO is selected (soc_ctrl_select_spi_memio),
+// or copied to a RAM scratch buffer by the DMA with spi_memio_load before a
+// compute loop. With the on_chip linker they are in the RAM and used in place.
 
 #ifndef _DRIVERS_SPI_MEMIO_H_
 #define _DRIVERS_SPI_MEMIO_H_
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "core_v_mini_mcu.h"
+#include "dma_memcpy.h"
 #include "mmio.h"
-#include "spimem_regs.h"
+#include "soc_ctrl.h"
+#include "spi_memio_regs.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Places a constant in the .rodata_flash section, e.g.
+ * `FLASH_RODATA const int16_t coeffs[1024] = {...};`
+ */
+#define FLASH_RODATA __attribute__((section(".rodata_flash"), aligned(4)))
+
+/**
+ * The read commands of the SPI MEMIO.
+ */
+typedef enum spi_memio_mode {
+  SPI_MEMIO_MODE_STANDARD = 0,  // Read (0x03), one line.
+  SPI_MEMIO_MODE_QUAD_IO = 1,   // Fast Read Quad I/O (0xEB).
+  SPI_MEMIO_MODE_DUAL_IO = 2,   // Fast Read Dual I/O (0xBB).
+  SPI_MEMIO_MODE_QUAD_DTR = 3,  // DTR Fast Read Quad I/O (0xED).
+} spi_memio_mode_t;
+
+/**
+ * The configuration of the reads of the SPI MEMIO.
+ */
+typedef struct spi_memio_cfg {
+  /**
+   * The read command.
+   */
+  spi_memio_mode_t mode;
+  /**
+   * Leaves the flash in continuous read mode (mode bits 0xA5) between the
+   * reads, so that the next one skips the command byte. Dual and quad modes
+   * only.
+   */
+  bool continuous;
+  /**
+   * The dummy cycles after the mode bits, up to 15, as required by the flash
+   * for the command and the clock, e.g. 4 for Fast Read Quad I/O on the
+   * W25Q128JW. Ignored by the standard read.
+   */
+  uint8_t dummy_cycles;
+} spi_memio_cfg_t;
+
 /**
  * Initialization parameters for SPI MEMIO.
  *
@@ -27,6 +92,106 @@ typedef struct spi_memio {
     mmio_region_t base_addr;
 } spi_memio_t;
 
+/**
+ * Sets the read command. The SPI MEMIO restarts, taking the flash out of
+ * its continuous read mode first.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param cfg The configuration.
+ */
+void spi_memio_set_config(const spi_memio_t *spi_memio, const spi_memio_cfg_t *cfg);
+
+/**
+ * Reads the current read command.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param cfg The configuration.
+ */
+void spi_memio_get_config(const spi_memio_t *spi_memio, spi_memio_cfg_t *cfg);
+
+/**
+ * Gives the flash to the SPI MEMIO, with the read command of cfg, and
+ * invalidates the read cache, as the flash may have been written.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the SOC CTRL.
+ * @param cfg The configuration.
+ */
+void spi_memio_select(const spi_memio_t *spi_memio, const soc_ctrl_t *soc_ctrl, const spi_memio_cfg_t *cfg);
+
+/**
+ * Gives the flash to the SPI host. The SPI MEMIO first takes the flash out
+ * of its continuous read mode, so that it decodes the commands of the SPI
+ * host, then stops driving its pins. The flash must not be read through the
+ * SPI MEMIO, by the CPU or the DMA, until spi_memio_select.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the SOC CTRL.
+ */
+void spi_memio_release(const spi_memio_t *spi_memio, const soc_ctrl_t *soc_ctrl);
+
+/**
+ * Enables or disables the sharing of the flash with the SPI host while the
+ * SPI MEMIO is selected. Each write to COMMAND of the SPI host waits for the
+ * end of the read of the SPI MEMIO in progress, then the SPI host keeps the
+ * flash until the chip select rises with no command left. The read cache
+ * does not see the writes to the flash, flush the lines written.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param enable Share the flash.
+ */
+void spi_memio_arbiter_enable(const spi_memio_t *spi_memio, bool enable);
+
+/**
+ * Enables or disables the read cache. Disabling it also invalidates it.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param enable Serve the reads from the cache.
+ * @param prefetch Fetch the next line after each miss.
+ */
+void spi_memio_cache_enable(const spi_memio_t *spi_memio, bool enable, bool prefetch);
+
+/**
+ * Invalidates all the lines of the read cache.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ */
+void spi_memio_cache_flush(const spi_memio_t *spi_memio);
+
+/**
+ * Reads the counters of the read cache.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ * @param hits Reads served by the cache.
+ * @param misses Reads that fetched their line from the flash.
+ */
+void spi_memio_cache_get_stats(const spi_memio_t *spi_memio, uint32_t *hits, uint32_t *misses);
+
+/**
+ * Clears the counters of the read cache.
+ * @param spi_memio Pointer to spi_memio_t represting the target SPI MEMIO.
+ */
+void spi_memio_cache_clear_stats(const spi_memio_t *spi_memio);
+
+/**
+ * Tells whether an address is in the flash mapped by the SPI MEMIO.
+ * @param addr The address.
+ */
+static inline bool spi_memio_is_mapped(const void *addr) {
+  return (uintptr_t)addr >= FLASH_MEM_START_ADDRESS && (uintptr_t)addr < FLASH_MEM_END_ADDRESS;
+}
+
+/**
+ * Starts copying a table from the flash to a RAM buffer with the DMA
+ * (dma_memcpy_async, which needs dma_init). A table that is not in the flash
+ * is not copied.
+ * @param scratch The RAM buffer, of at least len bytes.
+ * @param table The table, e.g. declared with FLASH_RODATA.
+ * @param len Its size in bytes.
+ * @param token The completion token of the copy, to wait for with
+ * dma_copy_wait() before reading the returned pointer.
+ * @return The copy of the table in scratch, or the table itself when it is
+ * not in the flash.
+ */
+const void *spi_memio_load_async(void *scratch, const void *table, size_t len, dma_copy_token_t *token);
+
+/**
+ * Same as spi_memio_load_async(), returns when the copy is done.
+ */
+const void *spi_memio_load(void *scratch, const void *table, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
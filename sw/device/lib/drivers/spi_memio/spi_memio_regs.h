@@ -23,6 +23,25 @@ extern "C" {
 // Cfg SPIMEM
 #define OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET 0x4
 
+// Control of the read cache in front of SPIMEM
+#define OBI_SPIMEMIO_CACHE_CTRL_REG_OFFSET 0x8
+#define OBI_SPIMEMIO_CACHE_CTRL_ENABLE_BIT 0
+#define OBI_SPIMEMIO_CACHE_CTRL_PREFETCH_BIT 1
+
+// Flush of the read cache
+#define OBI_SPIMEMIO_CACHE_FLUSH_REG_OFFSET 0xc
+#define OBI_SPIMEMIO_CACHE_FLUSH_CACHE_FLUSH_BIT 0
+
+// Number of reads served by the cache, can be written
+#define OBI_SPIMEMIO_CACHE_HITS_REG_OFFSET 0x10
+
+// Number of reads that fetched their line from the flash, can be written
+#define OBI_SPIMEMIO_CACHE_MISSES_REG_OFFSET 0x14
+
+// Sharing of the flash with the SPI host while SPIMEM is selected
+#define OBI_SPIMEMIO_ARBITER_CTRL_REG_OFFSET 0x18
+#define OBI_SPIMEMIO_ARBITER_CTRL_ENABLE_BIT 0
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
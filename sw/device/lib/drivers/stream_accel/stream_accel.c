@@ -0,0 +1,200 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : stream_accel.c                                               **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   stream_accel.c
+* @date   14/10/2026
+* @brief  Tiled streaming to an external accelerator with the DMA
+*
+*/
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "stream_accel.h"
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "hart.h"
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Callback of the pull of a tile in the submission queue of the DMA, calls the
+ * tile callback
+ */
+static void stream_accel_pull_done(dma_queue_entry_t *entry);
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+stream_accel_result_t stream_accel_init(stream_accel_t *accel, const stream_accel_cfg_t *cfg)
+{
+  if (cfg->tx_ch >= DMA_CH_NUM || cfg->rx_ch >= DMA_CH_NUM) {
+    return kStreamAccelError;
+  }
+  accel->cfg = *cfg;
+  accel->submitted = 0;
+  accel->completed = 0;
+  return kStreamAccelOk;
+}
+
+stream_accel_result_t stream_accel_submit(stream_accel_t *accel, stream_accel_tile_t *tile,
+                                          const uint32_t *in, size_t in_len,
+                                          uint32_t *out, size_t out_len,
+                                          stream_accel_cb_t cb)
+{
+  if (in == NULL || out == NULL || in_len == 0 || out_len == 0
+      || ((uintptr_t) in & 3) || ((uintptr_t) out & 3)) {
+    return kStreamAccelError;
+  }
+
+  tile->accel = accel;
+  tile->cb = cb;
+  tile->done = false;
+
+  // push: the DMA writes to the input while the accelerator accepts words
+  tile->in_src = (dma_target_t) {
+    .ptr     = (uint8_t *) in,
+    .inc_du  = 1,
+    .size_du = in_len,
+    .trig    = DMA_TRIG_MEMORY,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  tile->in_dst = (dma_target_t) {
+    .ptr     = (uint8_t *) (uintptr_t) accel->cfg.in_addr,
+    .inc_du  = 0,
+    .trig    = accel->cfg.in_slot,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  tile->push = (dma_trans_t) {
+    .src     = &tile->in_src,
+    .dst     = &tile->in_dst,
+    .channel = accel->cfg.tx_ch,
+  };
+
+  // pull: the DMA reads from the output while results are available
+  tile->out_src = (dma_target_t) {
+    .ptr     = (uint8_t *) (uintptr_t) accel->cfg.out_addr,
+    .inc_du  = 0,
+    .size_du = out_len,
+    .trig    = accel->cfg.out_slot,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  tile->out_dst = (dma_target_t) {
+    .ptr     = (uint8_t *) out,
+    .inc_du  = 1,
+    .trig    = DMA_TRIG_MEMORY,
+    .type    = DMA_DATA_TYPE_WORD,
+  };
+  tile->pull = (dma_trans_t) {
+    .src     = &tile->out_src,
+    .dst     = &tile->out_dst,
+    .channel = accel->cfg.rx_ch,
+  };
+
+  if ((dma_validate_transaction(&tile->push, DMA_DO_NOT_ENABLE_REALIGN,
+                                DMA_PERFORM_CHECKS_INTEGRITY) & DMA_CONFIG_CRITICAL_ERROR)
+      || (dma_validate_transaction(&tile->pull, DMA_DO_NOT_ENABLE_REALIGN,
+                                   DMA_PERFORM_CHECKS_INTEGRITY) & DMA_CONFIG_CRITICAL_ERROR)) {
+    return kStreamAccelError;
+  }
+
+  tile->push_entry = (dma_queue_entry_t) {
+    .trans = &tile->push,
+    .cb    = NULL,
+    .ctx   = tile,
+  };
+  tile->pull_entry = (dma_queue_entry_t) {
+    .trans = &tile->pull,
+    .cb    = stream_accel_pull_done,
+    .ctx   = tile,
+  };
+
+  // both are queued at once: on two channels, the results of a tile are
+  // drained while it is pushed, so it can be larger than the FIFOs
+  accel->submitted++;
+  if (dma_submit(&tile->push_entry) != DMA_CONFIG_OK) {
+    accel->submitted--;
+    return kStreamAccelError;
+  }
+  if (dma_submit(&tile->pull_entry) != DMA_CONFIG_OK) {
+    // the push is running and cannot be cancelled: the tile will never be
+    // done, the stream has to be reinitialized
+    return kStreamAccelError;
+  }
+  return kStreamAccelOk;
+}
+
+stream_accel_result_t stream_accel_tile_status(const stream_accel_tile_t *tile)
+{
+  return tile->done ? kStreamAccelOk : kStreamAccelBusy;
+}
+
+void stream_accel_wait(stream_accel_t *accel)
+{
+  // interrupts are disabled between the check and the wfi so that the end of
+  // the last tile cannot be missed
+  while (accel->completed != accel->submitted) {
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    if (accel->completed != accel->submitted) {
+      wait_for_interrupt();
+    }
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void stream_accel_pull_done(dma_queue_entry_t *entry)
+{
+  stream_accel_tile_t *tile = entry->ctx;
+  tile->done = true;
+  tile->accel->completed++;
+  if (tile->cb != NULL) {
+    tile->cb(tile);
+  }
+}
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,234 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : stream_accel.h                                               **
+** date     : 14/10/2026                                                   **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+** Copyright (c) EPFL contributors.                                        **
+** All rights reserved.                                                    **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   stream_accel.h
+* @date   14/10/2026
+* @brief  Tiled streaming to an external accelerator with the DMA
+*
+* The accelerator is an external peripheral with an input and an output
+* register in front of FIFOs, which raise a DMA trigger slot while they can be
+* written and read, as hw/ip_examples/iffifo does (see
+* docs/source/How_to/StreamingAccelerators.md). It is described by a
+* stream_accel_cfg_t.
+*
+* The CPU enqueues tiles: the input words of a tile and the buffer of its
+* results. Each tile is a push on the TX channel of the DMA and a pull on the
+* RX channel, queued with dma_submit, so the DMA pushes the next tiles while
+* the accelerator computes the current one and its results stream back. The
+* tiles are processed in order, and the callback of a tile is called from the
+* DMA interrupt once all its results are in memory.
+*
+* With the same channel for both directions, the pushes and the pulls are
+* performed one after the other: a tile must then fit in the FIFOs of the
+* accelerator, and nothing overlaps.
+*
+* dma_init() must be called before, and the handler of the transaction done
+* interrupt of the DMA must not be overridden.
+*/
+
+#ifndef _DRIVERS_STREAM_ACCEL_H_
+#define _DRIVERS_STREAM_ACCEL_H_
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dma.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The result of a stream_accel operation.
+ */
+typedef enum stream_accel_result {
+  /**
+   * Indicates that the operation succeeded.
+   */
+  kStreamAccelOk = 0,
+  /**
+   * The tile is still queued or running.
+   */
+  kStreamAccelBusy = 1,
+  /**
+   * A parameter is not valid, or the DMA rejected the tile.
+   */
+  kStreamAccelError = 2,
+} stream_accel_result_t;
+
+
+/**
+ * The interface of an accelerator.
+ */
+typedef struct stream_accel_cfg {
+  /**
+   * Address of the input register, written by the DMA.
+   */
+  uint32_t in_addr;
+  /**
+   * Address of the output register, read by the DMA.
+   */
+  uint32_t out_addr;
+  /**
+   * Slot raised while the input can be written.
+   */
+  dma_trigger_slot_mask_t in_slot;
+  /**
+   * Slot raised while the output can be read.
+   */
+  dma_trigger_slot_mask_t out_slot;
+  /**
+   * DMA channels of the pushes and of the pulls.
+   */
+  uint8_t tx_ch;
+  uint8_t rx_ch;
+} stream_accel_cfg_t;
+
+
+/**
+ * A stream to an accelerator. Its fields are managed by the functions below.
+ */
+typedef struct stream_accel {
+  stream_accel_cfg_t cfg;
+  /**
+   * Tiles submitted since the initialization.
+   */
+  volatile uint32_t submitted;
+  /**
+   * Tiles whose results are all in memory.
+   */
+  volatile uint32_t completed;
+} stream_accel_t;
+
+
+struct stream_accel_tile;
+
+/**
+ * Called from the DMA interrupt when the results of a tile are in memory. It
+ * may submit new tiles.
+ *
+ * @param tile the tile
+ */
+typedef void (*stream_accel_cb_t)(struct stream_accel_tile *tile);
+
+
+/**
+ * A tile. Its fields are managed by the functions below, except ctx.
+ */
+typedef struct stream_accel_tile {
+  stream_accel_t *accel;
+  dma_target_t in_src;
+  dma_target_t in_dst;
+  dma_target_t out_src;
+  dma_target_t out_dst;
+  dma_trans_t push;
+  dma_trans_t pull;
+  dma_queue_entry_t push_entry;
+  dma_queue_entry_t pull_entry;
+  stream_accel_cb_t cb;
+  /**
+   * User context, not used by the driver.
+   */
+  void *ctx;
+  volatile bool done;
+} stream_accel_tile_t;
+
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Initializes a stream
+ *
+ * @param accel the stream, it must be a static variable
+ * @param cfg the interface of the accelerator, copied
+ *
+ * @return kStreamAccelOk success
+ * @return kStreamAccelError a channel is not valid
+ */
+stream_accel_result_t stream_accel_init(stream_accel_t *accel, const stream_accel_cfg_t *cfg);
+
+/**
+ * Enqueues a tile
+ *
+ * @param accel the stream
+ * @param tile the tile, it must be a static variable and not be modified
+ * until it is done
+ * @param in the input words, word aligned
+ * @param in_len the input words, at least 1
+ * @param out the buffer of the results, word aligned
+ * @param out_len the results the accelerator produces from the input, at
+ * least 1
+ * @param cb called when the results are in memory, it may be NULL
+ *
+ * @return kStreamAccelOk success
+ * @return kStreamAccelError wrong parameters, or a transaction that was not
+ * queued runs on a channel
+ */
+stream_accel_result_t stream_accel_submit(stream_accel_t *accel, stream_accel_tile_t *tile,
+                                          const uint32_t *in, size_t in_len,
+                                          uint32_t *out, size_t out_len,
+                                          stream_accel_cb_t cb);
+
+/**
+ * @return kStreamAccelOk the results of the tile are in memory
+ * @return kStreamAccelBusy the tile is queued or running
+ */
+stream_accel_result_t stream_accel_tile_status(const stream_accel_tile_t *tile);
+
+/**
+ * Waits for all the submitted tiles to be done, with the core asleep in the
+ * meantime
+ */
+void stream_accel_wait(stream_accel_t *accel);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_STREAM_ACCEL_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
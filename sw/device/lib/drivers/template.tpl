@@ -22,11 +22,22 @@
 * This file contains the structs of the registes of the peripheral.
 * Each structure has the various bit fields that can be accessed
 * independently.
+*
+* Each field <FIELD> of a register <REG> also has forced-inline accessors
+* with the mask and shift known at compile time:
+* - <REG>_<FIELD>_FMASK, the bits of the field in the register, and
+*   <REG>_<FIELD>_FVAL(v), v placed in the field, prefixed by the name of
+*   the peripheral in upper case;
+* - <reg>_<field>_get() and <reg>_<field>_set(), a load and a load and a
+*   store, prefixed by the name of the peripheral in lower case. The fields
+*   of a multireg take the index of the copy.
+* Several fields of a register are written with a single read-modify-write
+* by structs_write_fields() with the FMASK and FVAL of the fields |-ed.
 * 
 */
 
 #ifndef _${peripheral_name_upper}_STRUCTS_H
-#define ${peripheral_name_upper}_STRUCTS
+#define _${peripheral_name_upper}_STRUCTS_H
 
 /****************************************************************************/
 /**                                                                        **/
@@ -80,6 +91,24 @@ ${structures_definitions}
 /**                                                                        **/
 /****************************************************************************/
 
+#ifndef _STRUCTS_WRITE_FIELDS
+#define _STRUCTS_WRITE_FIELDS
+
+/**
+ * @brief Writes several fields of a register in one store, leaving the others
+ * unchanged.
+ * @param p_reg The register.
+ * @param mask The FMASK of the fields.
+ * @param bits The FVAL of the fields.
+ */
+static inline __attribute__((always_inline)) void structs_write_fields(volatile uint32_t *p_reg, uint32_t mask, uint32_t bits)
+{
+  *p_reg = (*p_reg & ~mask) | bits;
+}
+
+#endif  /* _STRUCTS_WRITE_FIELDS */
+
+${inline_functions}
 
 
 #endif /* _${peripheral_name_upper}_STRUCTS_H */
@@ -0,0 +1,71 @@
+/*
+                              *******************
+******************************* H SOURCE FILE *******************************
+**                            *******************                          **
+**                                                                         **
+** project  : x-heep                                                       **
+** filename : ${peripheral_name}_regs.hpp                                  **
+** date     : ${date}                                                      **
+**                                                                         **
+*****************************************************************************
+**                                                                         **
+**                                                                         **
+*****************************************************************************
+
+*/
+
+/**
+* @file   ${peripheral_name}_regs.hpp
+* @date   ${date}
+* @brief  Contains the C++ types of every register
+*
+* This file contains the types of the registers of the peripheral, with the
+* types of their fields inside, for the C++ code. Their addresses, masks and
+* shifts are template parameters, see hal.hpp.
+*
+*/
+
+#ifndef _${peripheral_name_upper}_REGS_HPP
+#define _${peripheral_name_upper}_REGS_HPP
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+#include "core_v_mini_mcu.h"
+#include "hal.hpp"
+
+namespace xheep {
+namespace ${peripheral_name} {
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The registers of a ${peripheral_name} at Base.
+ */
+template <uintptr_t Base>
+struct block {
+${registers_definitions}
+};
+
+/**
+ * The ${peripheral_name} of the MCU.
+ */
+typedef block<${peripheral_name_upper}_START_ADDRESS> periph;
+
+}  // namespace ${peripheral_name}
+}  // namespace xheep
+
+#endif /* _${peripheral_name_upper}_REGS_HPP */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
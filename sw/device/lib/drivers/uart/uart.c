@@ -35,6 +35,18 @@ static void uart_reset(const uart_t *uart) {
   mmio_region_write32(uart->base_addr, UART_INTR_STATE_REG_OFFSET, UINT32_MAX);
 }
 
+static bool uart_compute_nco(uint32_t baudrate, uint32_t clk_freq_hz, uint32_t *nco_out) {
+  // Calculation formula: NCO = 16 * 2^nco_width * baud / fclk.
+  // NCO creates 16x of baudrate. So, in addition to the nco_width,
+  // 2^4 should be multiplied.
+  uint64_t nco =
+      ((uint64_t)baudrate << (NCO_WIDTH + 4)) / clk_freq_hz;
+  *nco_out = nco & UART_CTRL_NCO_MASK;
+
+  // Requested baudrate is too high for the given clock frequency.
+  return nco == *nco_out;
+}
+
 system_error_t uart_init(const uart_t *uart) {
   if (uart == NULL) {
     return kErrorUartInvalidArgument;
@@ -44,15 +56,8 @@ system_error_t uart_init(const uart_t *uart) {
     return kErrorUartInvalidArgument;
   }
 
-  // Calculation formula: NCO = 16 * 2^nco_width * baud / fclk.
-  // NCO creates 16x of baudrate. So, in addition to the nco_width,
-  // 2^4 should be multiplied.
-  uint64_t nco =
-      ((uint64_t)uart->baudrate << (NCO_WIDTH + 4)) / uart->clk_freq_hz;
-  uint32_t nco_masked = nco & UART_CTRL_NCO_MASK;
-
-  // Requested baudrate is too high for the given clock frequency.
-  if (nco != nco_masked) {
+  uint32_t nco_masked;
+  if (!uart_compute_nco(uart->baudrate, uart->clk_freq_hz, &nco_masked)) {
     return kErrorUartBadBaudRate;
   }
 
@@ -72,6 +77,37 @@ system_error_t uart_init(const uart_t *uart) {
   return kErrorOk;
 }
 
+static bool uart_tx_idle(const uart_t *uart);
+
+system_error_t uart_set_clock(uart_t *uart, uint32_t clk_freq_hz) {
+  if (uart == NULL || clk_freq_hz == 0) {
+    return kErrorUartInvalidArgument;
+  }
+
+  uint32_t nco;
+  if (!uart_compute_nco(uart->baudrate, clk_freq_hz, &nco)) {
+    return kErrorUartBadBaudRate;
+  }
+
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_CTRL_REG_OFFSET);
+  reg = bitfield_field32_write(reg, UART_CTRL_NCO_FIELD, nco);
+  mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, reg);
+  uart->clk_freq_hz = clk_freq_hz;
+  return kErrorOk;
+}
+
+void uart_clock_notifier(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz, void *ctx) {
+  uart_t *uart = ctx;
+
+  if (event == kSocClockPreChange_e) {
+    // a character on the line would be garbled by the change of the divisor
+    while (!uart_tx_idle(uart)) {
+    }
+  } else {
+    uart_set_clock(uart, new_hz);
+  }
+}
+
 static bool uart_tx_full(const uart_t *uart) {
   uint32_t reg = mmio_region_read32(uart->base_addr, UART_STATUS_REG_OFFSET);
   return bitfield_bit32_read(reg, UART_STATUS_TXFULL_BIT);
@@ -127,6 +163,64 @@ size_t uart_write(const uart_t *uart, const uint8_t *data, size_t len) {
   return total;
 }
 
+size_t uart_write_nonblocking(const uart_t *uart, const uint8_t *data, size_t len) {
+  size_t sent = 0;
+  while (sent < len && !uart_tx_full(uart)) {
+    uint32_t reg = bitfield_field32_write(0, UART_WDATA_WDATA_FIELD, data[sent]);
+    mmio_region_write32(uart->base_addr, UART_WDATA_REG_OFFSET, reg);
+    sent++;
+  }
+  return sent;
+}
+
+void uart_wait_tx_done(const uart_t *uart) {
+  // The FIFO is empty once idle, TXIDLE covers both.
+  while (!uart_tx_idle(uart)) {
+  }
+}
+
+size_t uart_read_nonblocking(const uart_t *uart, uint8_t *data, size_t len) {
+  size_t received = 0;
+  while (received < len && !uart_rx_empty(uart)) {
+    data[received] = uart_rx_fifo_read(uart);
+    received++;
+  }
+  return received;
+}
+
+uint32_t uart_tx_fifo_level(const uart_t *uart) {
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
+  return bitfield_field32_read(reg, UART_FIFO_STATUS_TXLVL_FIELD);
+}
+
+static void uart_set_fifo_ctrl_field(const uart_t *uart, bitfield_field32_t field, uint32_t value) {
+  // The reset bits are written as 0, which does not reset the FIFOs.
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_RXRST_BIT, false);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_TXRST_BIT, false);
+  reg = bitfield_field32_write(reg, field, value);
+  mmio_region_write32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET, reg);
+}
+
+void uart_set_tx_watermark(const uart_t *uart, uint32_t level) {
+  uart_set_fifo_ctrl_field(uart, UART_FIFO_CTRL_TXILVL_FIELD, level);
+}
+
+void uart_set_rx_watermark(const uart_t *uart, uint32_t level) {
+  uart_set_fifo_ctrl_field(uart, UART_FIFO_CTRL_RXILVL_FIELD, level);
+}
+
+void uart_irq_set_enabled(const uart_t *uart, uint32_t irq, bool enable) {
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, irq, enable);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+}
+
+void uart_irq_clear(const uart_t *uart, uint32_t irq) {
+  // Write-one-to-clear.
+  mmio_region_write32(uart->base_addr, UART_INTR_STATE_REG_OFFSET, 1u << irq);
+}
+
 /**
  * Read `len` bytes from the UART RX FIFO.
  */
@@ -8,16 +8,24 @@
 #ifndef _DRIVERS_UART_H_
 #define _DRIVERS_UART_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include "mmio.h"
 #include "error.h"
+#include "soc_ctrl_clock.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Depth of the TX and RX FIFOs of the UART, in bytes.
+ */
+#define UART_TX_FIFO_DEPTH 32
+#define UART_RX_FIFO_DEPTH 32
+
 /**
  * Initialization parameters for UART.
  *
@@ -45,6 +53,25 @@ typedef struct uart {
  */
 system_error_t uart_init(const uart_t *uart);
 
+/**
+ * Reprogram the baudrate divisor of an initialized UART for a new peripheral
+ * clock frequency, without resetting its FIFOs.
+ *
+ * @param uart Pointer to uart_t represting the target UART, its clk_freq_hz
+ * is updated.
+ * @param clk_freq_hz New peripheral clock frequency.
+ * @return kErrorOk if successful, kErrorUartBadBaudRate if the baudrate
+ * cannot be reached at this frequency (the divisor is then not changed).
+ */
+system_error_t uart_set_clock(uart_t *uart, uint32_t clk_freq_hz);
+
+/**
+ * soc_clock notifier of a UART (soc_ctrl_clock.h), ctx is the uart_t: before
+ * the change it waits for the end of the transmission, after it calls
+ * uart_set_clock().
+ */
+void uart_clock_notifier(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz, void *ctx);
+
 /**
  * Write a single byte to the UART.
  *
@@ -77,6 +104,84 @@ size_t uart_write(const uart_t *uart, const uint8_t *data, size_t len);
  * @return Number of bytes written.
  */
 
+/**
+ * Write a buffer to the UART TX FIFO without waiting.
+ *
+ * Pushes bytes until the FIFO is full and returns without waiting for their
+ * transmission.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param data Pointer to buffer to write.
+ * @param len Length of the buffer to write.
+ * @return Number of bytes pushed, less than len if the FIFO got full.
+ */
+size_t uart_write_nonblocking(const uart_t *uart, const uint8_t *data, size_t len);
+
+/**
+ * Wait until the TX FIFO is empty and the last byte has been sent.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ */
+void uart_wait_tx_done(const uart_t *uart);
+
+/**
+ * Read the bytes available in the UART RX FIFO without waiting.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param data Pointer to buffer to read to.
+ * @param len Size of the buffer.
+ * @return Number of bytes read, less than len if the FIFO got empty.
+ */
+size_t uart_read_nonblocking(const uart_t *uart, uint8_t *data, size_t len);
+
+/**
+ * Get the number of bytes in the TX FIFO.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @return The level of the TX FIFO, at most UART_TX_FIFO_DEPTH.
+ */
+uint32_t uart_tx_fifo_level(const uart_t *uart);
+
+/**
+ * Set the level of the TX watermark interrupt.
+ *
+ * The interrupt is raised when the TX FIFO drops below the level.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param level One of the UART_FIFO_CTRL_TXILVL_VALUE_* of uart_regs.h.
+ */
+void uart_set_tx_watermark(const uart_t *uart, uint32_t level);
+
+/**
+ * Set the level of the RX watermark interrupt.
+ *
+ * The interrupt is raised when the RX FIFO reaches the level.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param level One of the UART_FIFO_CTRL_RXILVL_VALUE_* of uart_regs.h.
+ */
+void uart_set_rx_watermark(const uart_t *uart, uint32_t level);
+
+/**
+ * Enable or disable an interrupt of the UART.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param irq One of the UART_INTR_ENABLE_*_BIT of uart_regs.h.
+ * @param enable True to enable the interrupt.
+ */
+void uart_irq_set_enabled(const uart_t *uart, uint32_t irq, bool enable);
+
+/**
+ * Clear a pending interrupt of the UART.
+ *
+ * The interrupts are events: they stay pending until cleared, even if
+ * their condition is gone.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param irq One of the UART_INTR_STATE_*_BIT of uart_regs.h.
+ */
+void uart_irq_clear(const uart_t *uart, uint32_t irq);
+
 size_t uart_getchar(const uart_t *uart, uint8_t *data);
 
 size_t uart_read(const uart_t *uart, const uint8_t *data, size_t len);
@@ -86,8 +191,10 @@ size_t uart_sink(void *uart, const char *data, size_t len);
 
 /**
  * @brief Attends the plic interrupt.
+ * `uart.c` provides a weak definition of this symbol, which can be overridden
+ * at link-time by providing an additional non-weak definition.
  */
-__attribute__((weak, optimize("O0"))) void handler_irq_uart(uint32_t id);
+void handler_irq_uart(uint32_t id);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,404 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : uart_buffered.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   uart_buffered.c
+* @date   14/10/26
+* @brief  Interrupt-driven mode of the UART driver, with TX and RX ring
+* buffers.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "uart_buffered.h"
+
+#include "uart_regs.h"
+#include "rv_plic.h"
+#include "csr.h"
+#include "irq.h"
+#include "core_v_mini_mcu.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Moves the TX ring to the FIFO, with the CPU or by launching a DMA
+ * transaction, and enables the TX watermark interrupt while bytes are left.
+ * It must be called with the interrupts disabled, or from a handler.
+ */
+static void tx_pump( uart_buffered_t *p_ub );
+
+/**
+ * @brief Gives the next contiguous bytes to send: the ring bytes written
+ * before the first packet, or the rest of the buffer of the packet.
+ * @return Whether they are in the packet.
+ */
+static bool tx_next( uart_buffered_t *p_ub, uint8_t **p_ptr, uint32_t *p_len );
+
+/**
+ * @brief Counts bytes of the first packet as sent, and frees it once they all
+ * are. It skips the empty buffers, also with p_sent at 0.
+ */
+static void tx_pbuf_sent( uart_buffered_t *p_ub, uint32_t p_sent );
+
+/**
+ * @brief Callback of the DMA transactions of the TX.
+ */
+static void tx_dma_done( dma_queue_entry_t *p_entry );
+
+/**
+ * @brief Moves the RX FIFO to the RX ring.
+ */
+static void rx_pump( uart_buffered_t *p_ub );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+system_error_t uart_buffered_init( uart_buffered_t *p_ub,
+                                   const uart_t    *p_uart,
+                                   uint8_t         *p_tx_buf,
+                                   size_t          p_tx_size_b,
+                                   uint8_t         *p_rx_buf,
+                                   size_t          p_rx_size_b,
+                                   uint8_t         p_dma_ch )
+{
+    if(     ( p_ub == NULL )
+        ||  ( p_dma_ch != UART_BUFFERED_NO_DMA && p_dma_ch >= DMA_CH_NUM ) )
+    {
+        return kErrorUartInvalidArgument;
+    }
+
+    /* A missing ring is empty and full. */
+    p_ub->tx = (ring_t){ 0 };
+    p_ub->rx = (ring_t){ 0 };
+    p_ub->tx_pkts    = (pbuf_queue_t){ 0 };
+    p_ub->tx_seg     = NULL;
+    p_ub->tx_seg_off = 0;
+    if(     ( p_tx_buf && !ring_init( &p_ub->tx, p_tx_buf, p_tx_size_b ) )
+        ||  ( p_rx_buf && !ring_init( &p_ub->rx, p_rx_buf, p_rx_size_b ) ) )
+    {
+        return kErrorUartInvalidArgument;
+    }
+
+    p_ub->uart = *p_uart;
+    system_error_t err = uart_init( &p_ub->uart );
+    if( err != kErrorOk )
+    {
+        return err;
+    }
+
+    p_ub->rx_dropped = 0;
+    p_ub->dma_ch     = p_dma_ch;
+    p_ub->dma_len_b  = 0;
+    p_ub->dma_pkt    = false;
+
+    /*
+     * The parts of the DMA transaction that do not change: bytes from the
+     * ring to the data register of the UART.
+     */
+    p_ub->dma_src.env          = NULL;
+    p_ub->dma_src.inc_du       = 1;
+    p_ub->dma_src.stride_d2_du = 0;
+    p_ub->dma_src.type         = DMA_DATA_TYPE_BYTE;
+    p_ub->dma_src.trig         = DMA_TRIG_MEMORY;
+    p_ub->dma_dst.env          = NULL;
+    p_ub->dma_dst.ptr          = (uint8_t*) p_ub->uart.base_addr.base + UART_WDATA_REG_OFFSET;
+    p_ub->dma_dst.inc_du       = 0;
+    p_ub->dma_dst.size_du      = 0;
+    p_ub->dma_dst.stride_d2_du = 0;
+    p_ub->dma_dst.type         = DMA_DATA_TYPE_BYTE;
+    p_ub->dma_dst.trig         = DMA_TRIG_SLOT_UART_TX;
+    p_ub->dma_trans.src        = &p_ub->dma_src;
+    p_ub->dma_trans.dst        = &p_ub->dma_dst;
+    p_ub->dma_trans.src_addr   = NULL;
+    p_ub->dma_trans.mode       = DMA_TRANS_MODE_SINGLE;
+    p_ub->dma_trans.win_du     = 0;
+    p_ub->dma_trans.end        = DMA_TRANS_END_INTR;
+    p_ub->dma_trans.channel    = p_dma_ch;
+    p_ub->dma_trans.size_d2    = 0;
+    p_ub->dma_trans.conv       = DMA_TYPE_CONV_NONE;
+    p_ub->dma_entry.trans      = &p_ub->dma_trans;
+    p_ub->dma_entry.cb         = tx_dma_done;
+    p_ub->dma_entry.ctx        = p_ub;
+
+    /*
+     * The TX watermark interrupt is enabled in the UART only while the TX
+     * ring has bytes. The RX one is raised when a byte arrives in the
+     * empty FIFO: the handler empties it, so every byte is seen.
+     */
+    uart_set_tx_watermark( &p_ub->uart, UART_FIFO_CTRL_TXILVL_VALUE_TXLVL16 );
+    uart_set_rx_watermark( &p_ub->uart, UART_FIFO_CTRL_RXILVL_VALUE_RXLVL1 );
+    uart_irq_clear( &p_ub->uart, UART_INTR_STATE_TX_WATERMARK_BIT );
+    uart_irq_clear( &p_ub->uart, UART_INTR_STATE_RX_WATERMARK_BIT );
+    uart_irq_set_enabled( &p_ub->uart, UART_INTR_ENABLE_RX_WATERMARK_BIT, p_rx_buf != NULL );
+
+    plic_irq_set_priority( UART_INTR_TX_WATERMARK, 1 );
+    plic_irq_set_enabled( UART_INTR_TX_WATERMARK, kPlicToggleEnabled );
+    plic_irq_set_priority( UART_INTR_RX_WATERMARK, 1 );
+    plic_irq_set_enabled( UART_INTR_RX_WATERMARK, kPlicToggleEnabled );
+
+    return kErrorOk;
+}
+
+size_t uart_buffered_write_nonblocking( uart_buffered_t *p_ub,
+                                        const uint8_t   *p_data,
+                                        size_t          p_len )
+{
+    /* The interrupts are disabled for tx_pump, the other consumer of the ring. */
+    uint32_t mstatus = irq_save();
+    size_t   done    = ring_push( &p_ub->tx, p_data, p_len );
+
+    tx_pump( p_ub );
+    irq_restore( mstatus );
+    return done;
+}
+
+size_t uart_buffered_write( uart_buffered_t *p_ub,
+                            const uint8_t   *p_data,
+                            size_t          p_len )
+{
+    size_t done = 0;
+
+    while( done < p_len )
+    {
+        done += uart_buffered_write_nonblocking( p_ub, p_data + done, p_len - done );
+        if( done < p_len && p_ub->dma_ch == UART_BUFFERED_NO_DMA )
+        {
+            /* Works with the interrupts disabled too. */
+            uint32_t mstatus = irq_save();
+            tx_pump( p_ub );
+            irq_restore( mstatus );
+        }
+    }
+    return p_len;
+}
+
+void uart_buffered_write_pbuf( uart_buffered_t *p_ub, pbuf_t *p_pbuf )
+{
+    uint32_t mstatus = irq_save();
+
+    p_pbuf->tag = p_ub->tx.head;
+    pbuf_queue_push( &p_ub->tx_pkts, p_pbuf );
+    if( p_ub->tx_seg == NULL )
+    {
+        p_ub->tx_seg     = p_pbuf;
+        p_ub->tx_seg_off = 0;
+        tx_pbuf_sent( p_ub, 0 );
+    }
+    tx_pump( p_ub );
+    irq_restore( mstatus );
+}
+
+size_t uart_buffered_read( uart_buffered_t *p_ub,
+                           uint8_t         *p_data,
+                           size_t          p_len )
+{
+    /* The tail is only moved here, no need to disable the interrupts. */
+    return ring_pop( &p_ub->rx, p_data, p_len );
+}
+
+void uart_buffered_flush( uart_buffered_t *p_ub )
+{
+    while( !ring_empty( &p_ub->tx ) || p_ub->tx_seg != NULL )
+    {
+        if( p_ub->dma_ch == UART_BUFFERED_NO_DMA )
+        {
+            uint32_t mstatus = irq_save();
+            tx_pump( p_ub );
+            irq_restore( mstatus );
+        }
+    }
+    uart_wait_tx_done( &p_ub->uart );
+}
+
+void uart_buffered_irq_handler( uart_buffered_t *p_ub, uint32_t p_id )
+{
+    if( p_id == UART_INTR_TX_WATERMARK )
+    {
+        uart_irq_clear( &p_ub->uart, UART_INTR_STATE_TX_WATERMARK_BIT );
+        tx_pump( p_ub );
+    }
+    else if( p_id == UART_INTR_RX_WATERMARK )
+    {
+        /* Cleared first: a byte arriving after the FIFO is emptied raises it again. */
+        uart_irq_clear( &p_ub->uart, UART_INTR_STATE_RX_WATERMARK_BIT );
+        rx_pump( p_ub );
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void tx_pump( uart_buffered_t *p_ub )
+{
+    uint8_t *ptr;
+    uint32_t n;
+    bool     pkt;
+
+    /* A running transaction continues the TX from its callback. */
+    if( p_ub->dma_len_b != 0 )
+    {
+        return;
+    }
+
+    while( pkt = tx_next( p_ub, &ptr, &n ), n != 0 )
+    {
+        if( p_ub->dma_ch != UART_BUFFERED_NO_DMA )
+        {
+            /* The trigger slot paces the DMA on the FIFO. */
+            p_ub->dma_src.ptr     = ptr;
+            p_ub->dma_src.size_du = n;
+            p_ub->dma_len_b       = n;
+            p_ub->dma_pkt         = pkt;
+            dma_config_flags_t flags;
+            flags  = dma_validate_transaction( &p_ub->dma_trans,
+                                               DMA_DO_NOT_ENABLE_REALIGN,
+                                               DMA_PERFORM_CHECKS_ONLY_SANITY );
+            flags |= dma_submit( &p_ub->dma_entry );
+            if( ( flags & ( DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE ) ) == 0 )
+            {
+                break;
+            }
+            /* The channel cannot be used, the CPU takes over. */
+            p_ub->dma_len_b = 0;
+            p_ub->dma_ch    = UART_BUFFERED_NO_DMA;
+        }
+
+        size_t sent = uart_write_nonblocking( &p_ub->uart, ptr, n );
+        if( pkt )
+        {
+            tx_pbuf_sent( p_ub, sent );
+        }
+        else
+        {
+            ring_release( &p_ub->tx, sent );
+        }
+        if( sent < n )
+        {
+            break;
+        }
+    }
+
+    /*
+     * With bytes left, the FIFO was filled above the watermark, so the level
+     * will cross it. A running transaction ends with its callback instead.
+     */
+    uart_irq_set_enabled( &p_ub->uart,
+                          UART_INTR_ENABLE_TX_WATERMARK_BIT,
+                          n != 0 && p_ub->dma_len_b == 0 );
+}
+
+static bool tx_next( uart_buffered_t *p_ub, uint8_t **p_ptr, uint32_t *p_len )
+{
+    pbuf_t   *pkt = pbuf_queue_peek( &p_ub->tx_pkts );
+    uint32_t n    = ring_peek( &p_ub->tx, (void**) p_ptr );
+
+    if( pkt != NULL )
+    {
+        /* The ring bytes written before the packet go first. */
+        uint32_t before = pkt->tag - p_ub->tx.tail;
+        if( before == 0 )
+        {
+            *p_ptr = p_ub->tx_seg->payload + p_ub->tx_seg_off;
+            *p_len = p_ub->tx_seg->len - p_ub->tx_seg_off;
+            return true;
+        }
+        if( n > before )
+        {
+            n = before;
+        }
+    }
+    *p_len = n;
+    return false;
+}
+
+static void tx_pbuf_sent( uart_buffered_t *p_ub, uint32_t p_sent )
+{
+    p_ub->tx_seg_off += p_sent;
+    while( p_ub->tx_seg != NULL && p_ub->tx_seg_off == p_ub->tx_seg->len )
+    {
+        p_ub->tx_seg     = p_ub->tx_seg->next;
+        p_ub->tx_seg_off = 0;
+        if( p_ub->tx_seg == NULL )
+        {
+            pbuf_free( pbuf_queue_pop( &p_ub->tx_pkts ) );
+            p_ub->tx_seg = pbuf_queue_peek( &p_ub->tx_pkts );
+        }
+    }
+}
+
+static void tx_dma_done( dma_queue_entry_t *p_entry )
+{
+    uart_buffered_t *ub = (uart_buffered_t*) p_entry->ctx;
+
+    if( p_entry->trans->flags & DMA_CONFIG_CRITICAL_ERROR )
+    {
+        /* Not sent, the CPU sends it again. */
+        ub->dma_ch = UART_BUFFERED_NO_DMA;
+    }
+    else if( ub->dma_pkt )
+    {
+        tx_pbuf_sent( ub, ub->dma_len_b );
+    }
+    else
+    {
+        ring_release( &ub->tx, ub->dma_len_b );
+    }
+    ub->dma_len_b = 0;
+    tx_pump( ub );
+}
+
+static void rx_pump( uart_buffered_t *p_ub )
+{
+    uint8_t byte;
+
+    while( uart_read_nonblocking( &p_ub->uart, &byte, 1 ) )
+    {
+        if( ring_push( &p_ub->rx, &byte, 1 ) == 0 )
+        {
+            p_ub->rx_dropped++;
+        }
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,221 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : uart_buffered.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   uart_buffered.h
+* @date   14/10/26
+* @brief  Interrupt-driven mode of the UART driver, with TX and RX ring
+* buffers.
+*
+* Writes are copied to the TX ring and return; the TX watermark interrupt
+* moves the ring to the TX FIFO in the background, either with the CPU or with
+* a DMA channel. The RX watermark interrupt moves each received byte to the RX
+* ring, where reads find them.
+*
+* The DMA follows the TX FIFO through its UART TX trigger slot: each
+* transaction moves the whole contiguous part of the ring, and the next one
+* starts from the callback of the previous one. The CPU is then only
+* interrupted once per transaction, at most twice per lap of the ring, and
+* never polls the FIFO.
+*
+* Packets (pbuf.h) can also be queued with uart_buffered_write_pbuf: they are
+* sent from their own buffers, after the bytes written before them, and
+* freed once sent, without being copied to the TX ring.
+*
+* The application has to:
+* - call uart_buffered_init after plic_Init, and dma_init if a DMA channel is
+*   used;
+* - call uart_buffered_irq_handler from its handler_irq_uart;
+* - enable the machine external interrupts (mstatus.MIE and mie.MEIE).
+* Only one instance can be used, the SoC has a single UART.
+*/
+
+#ifndef _UART_BUFFERED_H_
+#define _UART_BUFFERED_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uart.h"
+#include "dma.h"
+#include "ring.h"
+#include "pbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Value of the DMA channel to move the TX ring with the CPU.
+ */
+#define UART_BUFFERED_NO_DMA 0xFF
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A buffered UART. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    uart_t            uart;
+    ring_t            tx;
+    ring_t            rx;
+    pbuf_queue_t      tx_pkts;      /*!< Packets to send. The tag of each one is
+    the head of the TX ring when it was queued, where it is sent. */
+    pbuf_t            *tx_seg;      /*!< Buffer of the first packet being sent. */
+    uint32_t          tx_seg_off;   /*!< Its bytes sent. */
+    volatile uint32_t rx_dropped;   /*!< Bytes received with the RX ring full. */
+    uint8_t           dma_ch;       /*!< Channel of the TX, or UART_BUFFERED_NO_DMA. */
+    volatile uint32_t dma_len_b;    /*!< Bytes of the running DMA transaction. */
+    bool              dma_pkt;      /*!< Whether it sends from tx_seg. */
+    dma_target_t      dma_src;
+    dma_target_t      dma_dst;
+    dma_trans_t       dma_trans;
+    dma_queue_entry_t dma_entry;
+} uart_buffered_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes the UART and the buffered mode, and enables the
+ * watermark interrupts in the PLIC.
+ * @param p_ub The buffered UART.
+ * @param p_uart The parameters of the UART, see uart_init.
+ * @param p_tx_buf The TX ring, NULL if the UART is only read.
+ * @param p_tx_size_b Size of the TX ring, a power of 2.
+ * @param p_rx_buf The RX ring, NULL if the UART is only written.
+ * @param p_rx_size_b Size of the RX ring, a power of 2.
+ * @param p_dma_ch The DMA channel of the TX, or UART_BUFFERED_NO_DMA. It must
+ * not be used by anything else.
+ * @return kErrorOk if successful, else an error code.
+ */
+system_error_t uart_buffered_init( uart_buffered_t *p_ub,
+                                   const uart_t    *p_uart,
+                                   uint8_t         *p_tx_buf,
+                                   size_t          p_tx_size_b,
+                                   uint8_t         *p_rx_buf,
+                                   size_t          p_rx_size_b,
+                                   uint8_t         p_dma_ch );
+
+/**
+ * @brief Copies as much of a buffer as fits in the TX ring.
+ * @return The number of bytes copied.
+ */
+size_t uart_buffered_write_nonblocking( uart_buffered_t *p_ub,
+                                        const uint8_t   *p_data,
+                                        size_t          p_len );
+
+/**
+ * @brief Copies a buffer to the TX ring, waiting for room if it is full.
+ * With a DMA channel, the room is made by the interrupts: it must not be
+ * called with the interrupts disabled, e.g. in a handler.
+ * @return p_len.
+ */
+size_t uart_buffered_write( uart_buffered_t *p_ub,
+                            const uint8_t   *p_data,
+                            size_t          p_len );
+
+/**
+ * @brief Queues a packet, sent after the bytes already written, and freed
+ * once sent. Its reference is taken over: take another one with pbuf_ref to
+ * keep it. It can be called with the interrupts disabled, and works without
+ * a TX ring too.
+ * @param p_ub The buffered UART.
+ * @param p_pbuf The packet.
+ */
+void uart_buffered_write_pbuf( uart_buffered_t *p_ub, pbuf_t *p_pbuf );
+
+/**
+ * @brief Reads the received bytes, without waiting.
+ * @return The number of bytes read, at most p_len.
+ */
+size_t uart_buffered_read( uart_buffered_t *p_ub,
+                           uint8_t         *p_data,
+                           size_t          p_len );
+
+/**
+ * @brief Returns the number of received bytes waiting to be read.
+ */
+static inline size_t uart_buffered_rx_available( const uart_buffered_t *p_ub )
+{
+    return ring_used( &p_ub->rx );
+}
+
+/**
+ * @brief Returns the free space of the TX ring.
+ */
+static inline size_t uart_buffered_tx_free( const uart_buffered_t *p_ub )
+{
+    return ring_free( &p_ub->tx );
+}
+
+/**
+ * @brief Returns the number of packets queued and not sent yet.
+ */
+static inline uint32_t uart_buffered_tx_pbufs( const uart_buffered_t *p_ub )
+{
+    return p_ub->tx_pkts.count;
+}
+
+/**
+ * @brief Waits until everything written has been sent. Same restriction as
+ * uart_buffered_write.
+ */
+void uart_buffered_flush( uart_buffered_t *p_ub );
+
+/**
+ * @brief Serves the watermark interrupts, call it from handler_irq_uart.
+ * @param p_ub The buffered UART.
+ * @param p_id The id of the interrupt, the argument of handler_irq_uart.
+ */
+void uart_buffered_irq_handler( uart_buffered_t *p_ub, uint32_t p_id );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _UART_BUFFERED_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,240 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : xif_coproc.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   xif_coproc.h
+* @date   14/10/26
+* @brief  Intrinsics of the custom instructions of xif_coproc.
+*
+* xif_coproc (hw/ip_examples/xif_coproc) is the template of a coprocessor of
+* the eXtension interface of the cv32e40x and cv32e40px, the coprocessor of
+* the testbench with X_EXT=1 and X_COPROC=1. Its instructions are R-type
+* instructions of the custom-0 opcode, emitted with the .insn directive of the
+* assembler: no toolchain change is needed, and the core offloads them since
+* it does not decode them itself. Without the coprocessor they are illegal.
+*
+* Each intrinsic is one instruction. The MAC ones add the dot product of the
+* signed lanes of two words to the accumulator of the coprocessor and return
+* it; the z variants restart it from 0. The accumulator is state of the
+* coprocessor, not saved by the interrupt handlers: a handler using the MAC
+* intrinsics breaks the accumulation of the code it interrupts. The l variants
+* take the first word from memory, at an address aligned to 4 bytes.
+*/
+
+#ifndef _XIF_COPROC_H_
+#define _XIF_COPROC_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * funct3 of the groups of instructions, see xif_coproc_pkg.sv.
+ */
+#define XIF_COPROC_F3_BIT   0
+#define XIF_COPROC_F3_MAC   1
+#define XIF_COPROC_F3_LMAC  2
+
+/**
+ * funct7 of the MAC instructions, as flags.
+ */
+#define XIF_COPROC_MAC_16   1   /*!< Halfword lanes instead of bytes. */
+#define XIF_COPROC_MAC_Z    2   /*!< The accumulator restarted from 0. */
+
+/**
+ * An instruction of a register rs1, with x0 as rs2.
+ */
+#define XIF_COPROC_R1( f3, f7, rd, rs1 ) \
+    asm volatile( ".insn r CUSTOM_0, %1, %2, %0, %3, x0" \
+                  : "=r"( rd ) : "i"( f3 ), "i"( f7 ), "r"( rs1 ) )
+
+/**
+ * An instruction of two registers. asm volatile keeps the order of the MAC
+ * on the accumulator.
+ */
+#define XIF_COPROC_R2( f3, f7, rd, rs1, rs2 ) \
+    asm volatile( ".insn r CUSTOM_0, %1, %2, %0, %3, %4" \
+                  : "=r"( rd ) : "i"( f3 ), "i"( f7 ), "r"( rs1 ), "r"( rs2 ) )
+
+/**
+ * An instruction loading the word at the address rs1.
+ */
+#define XIF_COPROC_L2( f3, f7, rd, p, rs2 ) \
+    asm volatile( ".insn r CUSTOM_0, %1, %2, %0, %3, %4" \
+                  : "=r"( rd ) : "i"( f3 ), "i"( f7 ), "r"( p ), "r"( rs2 ), \
+                    "m"( *(const uint32_t *)( p ) ) )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          INLINE FUNCTIONS                              **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The ones of x.
+ */
+static inline uint32_t cx_popcnt( uint32_t x )
+{
+    uint32_t r;
+    XIF_COPROC_R1( XIF_COPROC_F3_BIT, 0, r, x );
+    return r;
+}
+
+/**
+ * @brief The leading zeros of x, 32 for 0.
+ */
+static inline uint32_t cx_clz( uint32_t x )
+{
+    uint32_t r;
+    XIF_COPROC_R1( XIF_COPROC_F3_BIT, 1, r, x );
+    return r;
+}
+
+/**
+ * @brief The bits of x reversed.
+ */
+static inline uint32_t cx_brev( uint32_t x )
+{
+    uint32_t r;
+    XIF_COPROC_R1( XIF_COPROC_F3_BIT, 2, r, x );
+    return r;
+}
+
+/**
+ * @brief The len bits of x from the bit pos, zero-extended.
+ * @param pos 0 to 31.
+ * @param len 1 to 32.
+ */
+static inline uint32_t cx_bext( uint32_t x, uint32_t pos, uint32_t len )
+{
+    uint32_t r;
+    XIF_COPROC_R2( XIF_COPROC_F3_BIT, 3, r, x, ( pos & 0x1f ) | ( ( len - 1 ) & 0x1f ) << 5 );
+    return r;
+}
+
+/**
+ * @brief Adds the 4 products of the signed bytes of a and b to the
+ * accumulator.
+ * @return The accumulator.
+ */
+static inline int32_t cx_mac8( uint32_t a, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_R2( XIF_COPROC_F3_MAC, 0, r, a, b );
+    return r;
+}
+
+/**
+ * @brief Adds the 2 products of the signed halfwords of a and b to the
+ * accumulator.
+ * @return The accumulator.
+ */
+static inline int32_t cx_mac16( uint32_t a, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_R2( XIF_COPROC_F3_MAC, XIF_COPROC_MAC_16, r, a, b );
+    return r;
+}
+
+/**
+ * @brief cx_mac8 from an accumulator of 0.
+ */
+static inline int32_t cx_macz8( uint32_t a, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_R2( XIF_COPROC_F3_MAC, XIF_COPROC_MAC_Z, r, a, b );
+    return r;
+}
+
+/**
+ * @brief cx_mac16 from an accumulator of 0.
+ */
+static inline int32_t cx_macz16( uint32_t a, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_R2( XIF_COPROC_F3_MAC, XIF_COPROC_MAC_Z | XIF_COPROC_MAC_16, r, a, b );
+    return r;
+}
+
+/**
+ * @brief cx_mac8 of the word at p, loaded by the coprocessor.
+ */
+static inline int32_t cx_lmac8( const void *p, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_L2( XIF_COPROC_F3_LMAC, 0, r, p, b );
+    return r;
+}
+
+/**
+ * @brief cx_mac16 of the word at p, loaded by the coprocessor.
+ */
+static inline int32_t cx_lmac16( const void *p, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_L2( XIF_COPROC_F3_LMAC, XIF_COPROC_MAC_16, r, p, b );
+    return r;
+}
+
+/**
+ * @brief cx_lmac8 from an accumulator of 0.
+ */
+static inline int32_t cx_lmacz8( const void *p, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_L2( XIF_COPROC_F3_LMAC, XIF_COPROC_MAC_Z, r, p, b );
+    return r;
+}
+
+/**
+ * @brief cx_lmac16 from an accumulator of 0.
+ */
+static inline int32_t cx_lmacz16( const void *p, uint32_t b )
+{
+    int32_t r;
+    XIF_COPROC_L2( XIF_COPROC_F3_LMAC, XIF_COPROC_MAC_Z | XIF_COPROC_MAC_16, r, p, b );
+    return r;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _XIF_COPROC_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,247 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp.c
+* @date   14/10/26
+* @brief  Basic vector kernels, with Xpulp versions for the cv32e40px.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp.h"
+#include "dsp_xpulp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Elements of each type in a word.
+ */
+#define DSP_I16_PER_W   2
+#define DSP_I8_PER_W    4
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void dsp_copy_w( uint32_t *p_dst, const uint32_t *p_src, size_t p_n )
+{
+#if DSP_XPULP
+    /* Two words per iteration, so that the second load hides the first one. */
+    for( size_t i = 0; i < p_n / 2; i++ )
+    {
+        uint32_t w0, w1;
+        LOAD_PI( w0, p_src );
+        LOAD_PI( w1, p_src );
+        STORE_PI( w0, p_dst );
+        STORE_PI( w1, p_dst );
+    }
+    if( p_n & 1 )
+    {
+        *p_dst = *p_src;
+    }
+#else
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = p_src[i];
+    }
+#endif
+}
+
+void dsp_fill_w( uint32_t *p_dst, uint32_t p_value, size_t p_n )
+{
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        STORE_PI( p_value, p_dst );
+    }
+#else
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = p_value;
+    }
+#endif
+}
+
+void dsp_add_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c, size_t p_n )
+{
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        int32_t x, y;
+        LOAD_PI( x, p_a );
+        LOAD_PI( y, p_b );
+        STORE_PI( x + y, p_c );
+    }
+#else
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] + p_b[i];
+    }
+#endif
+}
+
+void dsp_add_i16( const int16_t *p_a, const int16_t *p_b, int16_t *p_c, size_t p_n )
+{
+    size_t i = 0;
+#if DSP_XPULP
+    SIMD_LOOP( "cv.add.h", p_a, p_b, p_c, p_n / DSP_I16_PER_W );
+    p_n %= DSP_I16_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] + p_b[i];
+    }
+}
+
+void dsp_add_i8( const int8_t *p_a, const int8_t *p_b, int8_t *p_c, size_t p_n )
+{
+    size_t i = 0;
+#if DSP_XPULP
+    SIMD_LOOP( "cv.add.b", p_a, p_b, p_c, p_n / DSP_I8_PER_W );
+    p_n %= DSP_I8_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] + p_b[i];
+    }
+}
+
+void dsp_sub_i16( const int16_t *p_a, const int16_t *p_b, int16_t *p_c, size_t p_n )
+{
+    size_t i = 0;
+#if DSP_XPULP
+    SIMD_LOOP( "cv.sub.h", p_a, p_b, p_c, p_n / DSP_I16_PER_W );
+    p_n %= DSP_I16_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] - p_b[i];
+    }
+}
+
+void dsp_sub_i8( const int8_t *p_a, const int8_t *p_b, int8_t *p_c, size_t p_n )
+{
+    size_t i = 0;
+#if DSP_XPULP
+    SIMD_LOOP( "cv.sub.b", p_a, p_b, p_c, p_n / DSP_I8_PER_W );
+    p_n %= DSP_I8_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] - p_b[i];
+    }
+}
+
+void dsp_mul_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c, size_t p_n )
+{
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        int32_t x, y;
+        LOAD_PI( x, p_a );
+        LOAD_PI( y, p_b );
+        STORE_PI( x * y, p_c );
+    }
+#else
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_c[i] = p_a[i] * p_b[i];
+    }
+#endif
+}
+
+int32_t dsp_dot_i32( const int32_t *p_a, const int32_t *p_b, size_t p_n )
+{
+    int32_t acc = 0;
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        int32_t x, y;
+        LOAD_PI( x, p_a );
+        LOAD_PI( y, p_b );
+        SIMD_ACC( "cv.mac", acc, x, y );
+    }
+#else
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        acc += p_a[i] * p_b[i];
+    }
+#endif
+    return acc;
+}
+
+int32_t dsp_dot_i16( const int16_t *p_a, const int16_t *p_b, size_t p_n )
+{
+    int32_t acc = 0;
+    size_t i = 0;
+#if DSP_XPULP
+    for( size_t w = 0; w < p_n / DSP_I16_PER_W; w++ )
+    {
+        uint32_t x, y;
+        LOAD_PI( x, p_a );
+        LOAD_PI( y, p_b );
+        SIMD_ACC( "cv.sdotsp.h", acc, x, y );
+    }
+    p_n %= DSP_I16_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        acc += p_a[i] * p_b[i];
+    }
+    return acc;
+}
+
+int32_t dsp_dot_i8( const int8_t *p_a, const int8_t *p_b, size_t p_n )
+{
+    int32_t acc = 0;
+    size_t i = 0;
+#if DSP_XPULP
+    for( size_t w = 0; w < p_n / DSP_I8_PER_W; w++ )
+    {
+        uint32_t x, y;
+        LOAD_PI( x, p_a );
+        LOAD_PI( y, p_b );
+        SIMD_ACC( "cv.sdotsp.b", acc, x, y );
+    }
+    p_n %= DSP_I8_PER_W;
+#endif
+    for( ; i < p_n; i++ )
+    {
+        acc += p_a[i] * p_b[i];
+    }
+    return acc;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,129 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp.h
+* @date   14/10/26
+* @brief  Basic vector kernels: word copies and fills, element-wise addition,
+* subtraction and multiplication and dot products of 32, 16 and 8-bit integers.
+*
+* When X-HEEP is generated with the cv32e40px core, or the cv32e40p with
+* COREV_PULP=1, and the software is built for its Xpulp extensions (XPULP=1,
+* or e.g. ARCH=rv32imc_zicsr_xcvmem_xcvsimd_xcvmac_xcvhwlp, with the CORE-V
+* toolchain), the kernels use post-increment memory
+* accesses and the packed-SIMD instructions, which process two 16-bit or four
+* 8-bit elements at once. Otherwise the portable C versions are built.
+* The choice is made at compile time, DSP_XPULP tells which one was taken.
+*
+* The 16 and 8-bit vectors must be word aligned, so that their elements can be
+* loaded in packs of a word. The elements that do not fill a last word are
+* processed one by one.
+*/
+
+#ifndef _DSP_H
+#define _DSP_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * 1 if the kernels use the Xpulp instructions of the cv32e40p(x), 0 if they are
+ * the portable C versions.
+ */
+#if (defined(CPU_TYPE_CV32E40PX) || defined(CPU_TYPE_CV32E40P)) && defined(__riscv_xcvmem) && defined(__riscv_xcvsimd) && defined(__riscv_xcvmac)
+#define DSP_XPULP 1
+#else
+#define DSP_XPULP 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Copies p_n words from p_src to p_dst. The regions must not overlap.
+ */
+void dsp_copy_w( uint32_t *p_dst, const uint32_t *p_src, size_t p_n );
+
+/**
+ * @brief Fills p_n words of p_dst with p_value.
+ */
+void dsp_fill_w( uint32_t *p_dst, uint32_t p_value, size_t p_n );
+
+/**
+ * @brief Element-wise addition p_c[i] = p_a[i] + p_b[i] of p_n elements. The
+ * result wraps around on overflow.
+ */
+void dsp_add_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c, size_t p_n );
+void dsp_add_i16( const int16_t *p_a, const int16_t *p_b, int16_t *p_c, size_t p_n );
+void dsp_add_i8(  const int8_t  *p_a, const int8_t  *p_b, int8_t  *p_c, size_t p_n );
+
+/**
+ * @brief Element-wise subtraction p_c[i] = p_a[i] - p_b[i] of p_n elements.
+ * The result wraps around on overflow.
+ */
+void dsp_sub_i16( const int16_t *p_a, const int16_t *p_b, int16_t *p_c, size_t p_n );
+void dsp_sub_i8(  const int8_t  *p_a, const int8_t  *p_b, int8_t  *p_c, size_t p_n );
+
+/**
+ * @brief Element-wise multiplication p_c[i] = p_a[i] * p_b[i] of p_n
+ * elements, keeping the lower bits of the products.
+ */
+void dsp_mul_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c, size_t p_n );
+
+/**
+ * @brief Dot product of two vectors of p_n elements, accumulated in 32 bits.
+ * @return The sum of p_a[i] * p_b[i].
+ */
+int32_t dsp_dot_i32( const int32_t *p_a, const int32_t *p_b, size_t p_n );
+int32_t dsp_dot_i16( const int16_t *p_a, const int16_t *p_b, size_t p_n );
+int32_t dsp_dot_i8(  const int8_t  *p_a, const int8_t  *p_b, size_t p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
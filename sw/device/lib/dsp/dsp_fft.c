@@ -0,0 +1,515 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_fft.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_fft.c
+* @date   14/10/26
+* @brief  Fixed-point radix-2 FFTs and magnitudes, with Xpulp versions of the
+* Q15 butterflies and magnitudes for the cv32e40px.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_fft.h"
+#include "dsp_xpulp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The entries of the sine table, for a quarter of a period.
+ */
+#define DSP_SIN_QUARTER     ( DSP_FFT_MAX_LEN / 4 )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The sine and the cosine of p_i * 2 * pi / DSP_FFT_MAX_LEN.
+ */
+static inline int32_t sin_q15( size_t p_i );
+static inline int32_t cos_q15( size_t p_i );
+static inline int32_t sin_q31( size_t p_i );
+static inline int32_t cos_q31( size_t p_i );
+
+/**
+ * @brief true if p_n is a power of 2 from p_min to DSP_FFT_MAX_LEN.
+ */
+static bool fft_len_valid( size_t p_n, size_t p_min );
+
+/**
+ * @brief Puts p_n elements of p_size words in bit-reversed order.
+ */
+static void bit_reverse( uint32_t *p_buf, size_t p_n, size_t p_size );
+
+/**
+ * @brief The complex FFTs, of a valid length.
+ */
+static void cfft_q15( int16_t *p_buf, size_t p_n );
+static void cfft_q31( int32_t *p_buf, size_t p_n );
+
+/**
+ * @brief Floor of the square roots.
+ */
+static uint32_t isqrt32( uint32_t p_v );
+static uint32_t isqrt64( uint64_t p_v );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           GLOBAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * sin( i * 2 * pi / DSP_FFT_MAX_LEN ), for i from 0 to DSP_SIN_QUARTER.
+ */
+static const int16_t sin_table_q15[DSP_SIN_QUARTER + 1] =
+{
+         0,    201,    402,    603,    804,   1005,   1206,   1407,   1608,   1809,
+      2009,   2210,   2411,   2611,   2811,   3012,   3212,   3412,   3612,   3812,
+      4011,   4211,   4410,   4609,   4808,   5007,   5205,   5404,   5602,   5800,
+      5998,   6195,   6393,   6590,   6787,   6983,   7180,   7376,   7571,   7767,
+      7962,   8157,   8351,   8546,   8740,   8933,   9127,   9319,   9512,   9704,
+      9896,  10088,  10279,  10469,  10660,  10850,  11039,  11228,  11417,  11605,
+     11793,  11980,  12167,  12354,  12540,  12725,  12910,  13095,  13279,  13463,
+     13646,  13828,  14010,  14192,  14373,  14553,  14733,  14912,  15091,  15269,
+     15447,  15624,  15800,  15976,  16151,  16326,  16500,  16673,  16846,  17018,
+     17190,  17361,  17531,  17700,  17869,  18037,  18205,  18372,  18538,  18703,
+     18868,  19032,  19195,  19358,  19520,  19681,  19841,  20001,  20160,  20318,
+     20475,  20632,  20788,  20943,  21097,  21251,  21403,  21555,  21706,  21856,
+     22006,  22154,  22302,  22449,  22595,  22740,  22884,  23028,  23170,  23312,
+     23453,  23593,  23732,  23870,  24008,  24144,  24279,  24414,  24548,  24680,
+     24812,  24943,  25073,  25202,  25330,  25457,  25583,  25708,  25833,  25956,
+     26078,  26199,  26320,  26439,  26557,  26674,  26791,  26906,  27020,  27133,
+     27246,  27357,  27467,  27576,  27684,  27791,  27897,  28002,  28106,  28209,
+     28311,  28411,  28511,  28610,  28707,  28803,  28899,  28993,  29086,  29178,
+     29269,  29359,  29448,  29535,  29622,  29707,  29792,  29875,  29957,  30038,
+     30118,  30196,  30274,  30350,  30425,  30499,  30572,  30644,  30715,  30784,
+     30853,  30920,  30986,  31050,  31114,  31177,  31238,  31298,  31357,  31415,
+     31471,  31527,  31581,  31634,  31686,  31737,  31786,  31834,  31881,  31927,
+     31972,  32015,  32058,  32099,  32138,  32177,  32214,  32251,  32286,  32319,
+     32352,  32383,  32413,  32442,  32470,  32496,  32522,  32546,  32568,  32590,
+     32610,  32629,  32647,  32664,  32679,  32693,  32706,  32718,  32729,  32738,
+     32746,  32753,  32758,  32762,  32766,  32767,  32767,
+};
+
+static const int32_t sin_table_q31[DSP_SIN_QUARTER + 1] =
+{
+              0,    13176712,    26352928,    39528151,    52701887,    65873638,
+       79042909,    92209205,   105372028,   118530885,   131685278,   144834714,
+      157978697,   171116733,   184248325,   197372981,   210490206,   223599506,
+      236700388,   249792358,   262874923,   275947592,   289009871,   302061269,
+      315101295,   328129457,   341145265,   354148230,   367137861,   380113669,
+      393075166,   406021865,   418953276,   431868915,   444768294,   457650927,
+      470516330,   483364019,   496193509,   509004318,   521795963,   534567963,
+      547319836,   560051104,   572761285,   585449903,   598116479,   610760536,
+      623381598,   635979190,   648552838,   661102068,   673626408,   686125387,
+      698598533,   711045377,   723465451,   735858287,   748223418,   760560380,
+      772868706,   785147934,   797397602,   809617249,   821806413,   833964638,
+      846091463,   858186435,   870249095,   882278992,   894275671,   906238681,
+      918167572,   930061894,   941921200,   953745043,   965532978,   977284562,
+      988999351,  1000676905,  1012316784,  1023918550,  1035481766,  1047005996,
+     1058490808,  1069935768,  1081340445,  1092704411,  1104027237,  1115308496,
+     1126547765,  1137744621,  1148898640,  1160009405,  1171076495,  1182099496,
+     1193077991,  1204011567,  1214899813,  1225742318,  1236538675,  1247288478,
+     1257991320,  1268646800,  1279254516,  1289814068,  1300325060,  1310787095,
+     1321199781,  1331562723,  1341875533,  1352137822,  1362349204,  1372509294,
+     1382617710,  1392674072,  1402678000,  1412629117,  1422527051,  1432371426,
+     1442161874,  1451898025,  1461579514,  1471205974,  1480777044,  1490292364,
+     1499751576,  1509154322,  1518500250,  1527789007,  1537020244,  1546193612,
+     1555308768,  1564365367,  1573363068,  1582301533,  1591180426,  1599999411,
+     1608758157,  1617456335,  1626093616,  1634669676,  1643184191,  1651636841,
+     1660027308,  1668355276,  1676620432,  1684822463,  1692961062,  1701035922,
+     1709046739,  1716993211,  1724875040,  1732691928,  1740443581,  1748129707,
+     1755750017,  1763304224,  1770792044,  1778213194,  1785567396,  1792854372,
+     1800073849,  1807225553,  1814309216,  1821324572,  1828271356,  1835149306,
+     1841958164,  1848697674,  1855367581,  1861967634,  1868497586,  1874957189,
+     1881346202,  1887664383,  1893911494,  1900087301,  1906191570,  1912224073,
+     1918184581,  1924072871,  1929888720,  1935631910,  1941302225,  1946899451,
+     1952423377,  1957873796,  1963250501,  1968553292,  1973781967,  1978936331,
+     1984016189,  1989021350,  1993951625,  1998806829,  2003586779,  2008291295,
+     2012920201,  2017473321,  2021950484,  2026351522,  2030676269,  2034924562,
+     2039096241,  2043191150,  2047209133,  2051150040,  2055013723,  2058800036,
+     2062508835,  2066139983,  2069693342,  2073168777,  2076566160,  2079885360,
+     2083126254,  2086288720,  2089372638,  2092377892,  2095304370,  2098151960,
+     2100920556,  2103610054,  2106220352,  2108751352,  2111202959,  2113575080,
+     2115867626,  2118080511,  2120213651,  2122266967,  2124240380,  2126133817,
+     2127947206,  2129680480,  2131333572,  2132906420,  2134398966,  2135811153,
+     2137142927,  2138394240,  2139565043,  2140655293,  2141664948,  2142593971,
+     2143442326,  2144209982,  2144896910,  2145503083,  2146028480,  2146473080,
+     2146836866,  2147119825,  2147321946,  2147443222,  2147483647,
+};
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+bool dsp_cfft_q15( int16_t *p_buf, size_t p_n )
+{
+    if( !fft_len_valid( p_n, 2 ) )
+    {
+        return false;
+    }
+    cfft_q15( p_buf, p_n );
+    return true;
+}
+
+bool dsp_cfft_q31( int32_t *p_buf, size_t p_n )
+{
+    if( !fft_len_valid( p_n, 2 ) )
+    {
+        return false;
+    }
+    cfft_q31( p_buf, p_n );
+    return true;
+}
+
+bool dsp_rfft_q15( int16_t *p_buf, size_t p_n )
+{
+    if( !fft_len_valid( p_n, 4 ) )
+    {
+        return false;
+    }
+
+    /* The even samples are the real parts, the odd ones the imaginary parts. */
+    size_t m = p_n / 2;
+    size_t step = DSP_FFT_MAX_LEN / p_n;
+    cfft_q15( p_buf, m );
+
+    int32_t zr = p_buf[0];
+    int32_t zi = p_buf[1];
+    p_buf[0] = ( zr + zi ) >> 1;
+    p_buf[1] = ( zr - zi ) >> 1;
+
+    /* The bins k and m - k are built from the same two points: the spectra of
+     * the even samples E and of the odd ones O, then E + W^k O. */
+    for( size_t k = 1; k <= m / 2; k++ )
+    {
+        int16_t *a = &p_buf[2 * k];
+        int16_t *b = &p_buf[2 * ( m - k )];
+        int32_t er  = ( a[0] + b[0] ) >> 1;
+        int32_t ei  = ( a[1] - b[1] ) >> 1;
+        int32_t or_ = ( a[1] + b[1] ) >> 1;
+        int32_t oi  = ( b[0] - a[0] ) >> 1;
+        int32_t c   = cos_q15( k * step );
+        int32_t s   = sin_q15( k * step );
+        int32_t wor = ( c * or_ + s * oi ) >> 15;
+        int32_t woi = ( c * oi - s * or_ ) >> 15;
+
+        a[0] = ( er + wor ) >> 1;
+        a[1] = ( ei + woi ) >> 1;
+        if( a != b )
+        {
+            b[0] = ( er - wor ) >> 1;
+            b[1] = ( woi - ei ) >> 1;
+        }
+    }
+    return true;
+}
+
+bool dsp_rfft_q31( int32_t *p_buf, size_t p_n )
+{
+    if( !fft_len_valid( p_n, 4 ) )
+    {
+        return false;
+    }
+
+    size_t m = p_n / 2;
+    size_t step = DSP_FFT_MAX_LEN / p_n;
+    cfft_q31( p_buf, m );
+
+    int64_t zr = p_buf[0];
+    int64_t zi = p_buf[1];
+    p_buf[0] = ( zr + zi ) >> 1;
+    p_buf[1] = ( zr - zi ) >> 1;
+
+    for( size_t k = 1; k <= m / 2; k++ )
+    {
+        int32_t *a = &p_buf[2 * k];
+        int32_t *b = &p_buf[2 * ( m - k )];
+        int64_t er  = ( (int64_t)a[0] + b[0] ) >> 1;
+        int64_t ei  = ( (int64_t)a[1] - b[1] ) >> 1;
+        int64_t or_ = ( (int64_t)a[1] + b[1] ) >> 1;
+        int64_t oi  = ( (int64_t)b[0] - a[0] ) >> 1;
+        int64_t c   = cos_q31( k * step );
+        int64_t s   = sin_q31( k * step );
+        int64_t wor = ( c * or_ + s * oi ) >> 31;
+        int64_t woi = ( c * oi - s * or_ ) >> 31;
+
+        a[0] = ( er + wor ) >> 1;
+        a[1] = ( ei + woi ) >> 1;
+        if( a != b )
+        {
+            b[0] = ( er - wor ) >> 1;
+            b[1] = ( woi - ei ) >> 1;
+        }
+    }
+    return true;
+}
+
+void dsp_cmplx_mag_q15( const int16_t *p_in, int16_t *p_out, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        uint32_t sq;
+#if DSP_XPULP
+        uint32_t x;
+        LOAD_PI( x, p_in );
+        SIMD_OP( "cv.dotsp.h", sq, x, x );
+#else
+        int32_t re = p_in[2 * i];
+        int32_t im = p_in[2 * i + 1];
+        sq = (uint32_t)( re * re ) + (uint32_t)( im * im );
+#endif
+        uint32_t mag = isqrt32( sq );
+        p_out[i] = mag > INT16_MAX ? INT16_MAX : mag;
+    }
+}
+
+void dsp_cmplx_mag_sq_q15( const int16_t *p_in, uint32_t *p_out, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+#if DSP_XPULP
+        uint32_t x, sq;
+        LOAD_PI( x, p_in );
+        SIMD_OP( "cv.dotsp.h", sq, x, x );
+        STORE_PI( sq, p_out );
+#else
+        int32_t re = p_in[2 * i];
+        int32_t im = p_in[2 * i + 1];
+        p_out[i] = (uint32_t)( re * re ) + (uint32_t)( im * im );
+#endif
+    }
+}
+
+void dsp_cmplx_mag_q31( const int32_t *p_in, int32_t *p_out, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        int64_t re = p_in[2 * i];
+        int64_t im = p_in[2 * i + 1];
+        uint32_t mag = isqrt64( (uint64_t)( re * re ) + (uint64_t)( im * im ) );
+        p_out[i] = mag > INT32_MAX ? INT32_MAX : mag;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline int32_t sin_q15( size_t p_i )
+{
+    size_t r = p_i % DSP_SIN_QUARTER;
+    size_t q = ( p_i / DSP_SIN_QUARTER ) % 4;
+    int32_t v = ( q & 1 ) ? sin_table_q15[DSP_SIN_QUARTER - r] : sin_table_q15[r];
+    return ( q & 2 ) ? -v : v;
+}
+
+static inline int32_t cos_q15( size_t p_i )
+{
+    return sin_q15( p_i + DSP_SIN_QUARTER );
+}
+
+static inline int32_t sin_q31( size_t p_i )
+{
+    size_t r = p_i % DSP_SIN_QUARTER;
+    size_t q = ( p_i / DSP_SIN_QUARTER ) % 4;
+    int32_t v = ( q & 1 ) ? sin_table_q31[DSP_SIN_QUARTER - r] : sin_table_q31[r];
+    return ( q & 2 ) ? -v : v;
+}
+
+static inline int32_t cos_q31( size_t p_i )
+{
+    return sin_q31( p_i + DSP_SIN_QUARTER );
+}
+
+static bool fft_len_valid( size_t p_n, size_t p_min )
+{
+    return p_n >= p_min && p_n <= DSP_FFT_MAX_LEN && ( p_n & ( p_n - 1 ) ) == 0;
+}
+
+static void bit_reverse( uint32_t *p_buf, size_t p_n, size_t p_size )
+{
+    size_t j = 0;
+    for( size_t i = 0; i < p_n - 1; i++ )
+    {
+        if( i < j )
+        {
+            for( size_t w = 0; w < p_size; w++ )
+            {
+                uint32_t t = p_buf[i * p_size + w];
+                p_buf[i * p_size + w] = p_buf[j * p_size + w];
+                p_buf[j * p_size + w] = t;
+            }
+        }
+        size_t bit = p_n >> 1;
+        while( j & bit )
+        {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+static void cfft_q15( int16_t *p_buf, size_t p_n )
+{
+    bit_reverse( (uint32_t *)p_buf, p_n, 1 );
+
+    /* Decimation in time: each butterfly is a' = a / 2 + W b / 2 and
+     * b' = a / 2 - W b / 2, with W = cos - j sin. */
+    for( size_t len = 2; len <= p_n; len <<= 1 )
+    {
+        size_t half = len / 2;
+        size_t step = DSP_FFT_MAX_LEN / len;
+        for( size_t k = 0; k < half; k++ )
+        {
+            int32_t wr = cos_q15( k * step );
+            int32_t wi = -sin_q15( k * step );
+#if DSP_XPULP
+            uint32_t *z = (uint32_t *)p_buf;
+            uint32_t w = ( (uint32_t)wi << 16 ) | ( (uint32_t)wr & 0xFFFF );
+            uint32_t one = 0x00010001;
+            for( size_t i = k; i < p_n; i += len )
+            {
+                uint32_t a = z[i];
+                uint32_t b = z[i + half];
+                uint32_t t = 0, ah;
+                CPLX_MUL_DIV2( t, b, w );
+                SIMD_OP( "cv.sra.h", ah, a, one );
+                SIMD_OP( "cv.add.h", z[i], ah, t );
+                SIMD_OP( "cv.sub.h", z[i + half], ah, t );
+            }
+#else
+            for( size_t i = k; i < p_n; i += len )
+            {
+                int16_t *a = &p_buf[2 * i];
+                int16_t *b = &p_buf[2 * ( i + half )];
+                int16_t tr = ( b[0] * wr - b[1] * wi ) >> 16;
+                int16_t ti = ( b[0] * wi + b[1] * wr ) >> 16;
+                int16_t ar = a[0] >> 1;
+                int16_t ai = a[1] >> 1;
+                a[0] = ar + tr;
+                a[1] = ai + ti;
+                b[0] = ar - tr;
+                b[1] = ai - ti;
+            }
+#endif
+        }
+    }
+}
+
+static void cfft_q31( int32_t *p_buf, size_t p_n )
+{
+    bit_reverse( (uint32_t *)p_buf, p_n, 2 );
+
+    for( size_t len = 2; len <= p_n; len <<= 1 )
+    {
+        size_t half = len / 2;
+        size_t step = DSP_FFT_MAX_LEN / len;
+        for( size_t k = 0; k < half; k++ )
+        {
+            int64_t wr = cos_q31( k * step );
+            int64_t wi = -(int64_t)sin_q31( k * step );
+            for( size_t i = k; i < p_n; i += len )
+            {
+                int32_t *a = &p_buf[2 * i];
+                int32_t *b = &p_buf[2 * ( i + half )];
+                int32_t tr = ( b[0] * wr - b[1] * wi ) >> 32;
+                int32_t ti = ( b[0] * wi + b[1] * wr ) >> 32;
+                int32_t ar = a[0] >> 1;
+                int32_t ai = a[1] >> 1;
+                a[0] = ar + tr;
+                a[1] = ai + ti;
+                b[0] = ar - tr;
+                b[1] = ai - ti;
+            }
+        }
+    }
+}
+
+static uint32_t isqrt32( uint32_t p_v )
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+    while( bit > p_v )
+    {
+        bit >>= 2;
+    }
+    while( bit )
+    {
+        if( p_v >= res + bit )
+        {
+            p_v -= res + bit;
+            res = ( res >> 1 ) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static uint32_t isqrt64( uint64_t p_v )
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+    while( bit > p_v )
+    {
+        bit >>= 2;
+    }
+    while( bit )
+    {
+        if( p_v >= res + bit )
+        {
+            p_v -= res + bit;
+            res = ( res >> 1 ) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
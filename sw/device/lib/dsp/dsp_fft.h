@@ -0,0 +1,129 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_fft.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_fft.h
+* @date   14/10/26
+* @brief  Fixed-point radix-2 FFTs of complex and real signals, in place, in
+* Q15 and Q31, and magnitudes of complex vectors.
+*
+* The complex numbers are stored as {real, imaginary} pairs. Every stage of
+* the FFTs halves its results, so that they cannot overflow: the result of an
+* FFT of N points is its spectrum divided by N. The complex moduli of the
+* input must be at most 1.0, which is always the case for the real FFT of the
+* samples in [-0.7, 0.7] and of a complex FFT of real samples.
+*
+* The real FFT of N samples runs a complex FFT of N/2 points on the samples
+* taken in pairs, then splits its result into the N/2 + 1 bins of the
+* spectrum. These are stored in place of the samples: p_buf[0] is the real
+* DC bin, p_buf[1] the real bin at the Nyquist frequency and the bins 1 to
+* N/2 - 1 follow as complex numbers.
+*
+* The twiddle factors come from a table of a quarter of a sine wave, which
+* sets the largest FFT to DSP_FFT_MAX_LEN points.
+*
+* With the Xpulp extensions (see dsp.h), the Q15 butterflies work on complex
+* numbers packed in a word, with cv.cplxmul and the packed-SIMD additions,
+* and the Q15 magnitudes use cv.dotsp.h. The results are the same as with the
+* portable versions. The Q31 kernels are the portable ones.
+*/
+
+#ifndef _DSP_FFT_H
+#define _DSP_FFT_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The largest FFT, in complex points or real samples.
+ */
+#define DSP_FFT_MAX_LEN     1024
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Complex FFT, in place, scaled by 1/p_n.
+ * @param p_buf p_n complex numbers, word aligned.
+ * @param p_n A power of 2 from 2 to DSP_FFT_MAX_LEN.
+ * @return false if p_n is not valid, the buffer is left as it was.
+ */
+bool dsp_cfft_q15( int16_t *p_buf, size_t p_n );
+bool dsp_cfft_q31( int32_t *p_buf, size_t p_n );
+
+/**
+ * @brief Real FFT, in place, scaled by 1/p_n.
+ * @param p_buf p_n real samples, word aligned, replaced by the spectrum as
+ * described above.
+ * @param p_n A power of 2 from 4 to DSP_FFT_MAX_LEN.
+ * @return false if p_n is not valid, the buffer is left as it was.
+ */
+bool dsp_rfft_q15( int16_t *p_buf, size_t p_n );
+bool dsp_rfft_q31( int32_t *p_buf, size_t p_n );
+
+/**
+ * @brief Magnitudes of complex numbers, saturated to 1.0.
+ * @param p_in p_n complex numbers, word aligned.
+ * @param p_out p_n magnitudes.
+ */
+void dsp_cmplx_mag_q15( const int16_t *p_in, int16_t *p_out, size_t p_n );
+void dsp_cmplx_mag_q31( const int32_t *p_in, int32_t *p_out, size_t p_n );
+
+/**
+ * @brief Squared magnitudes of Q15 complex numbers, in Q30, without the
+ * square roots.
+ * @param p_in p_n complex numbers, word aligned.
+ * @param p_out p_n squared magnitudes.
+ */
+void dsp_cmplx_mag_sq_q15( const int16_t *p_in, uint32_t *p_out, size_t p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_FFT_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,295 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_filter.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_filter.c
+* @date   14/10/26
+* @brief  Fixed-point FIR filters and cascades of biquads, with Xpulp versions
+* of the Q15 kernels for the cv32e40px.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_filter.h"
+#include "dsp_xpulp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Saturates a value to 16 bits.
+ */
+static inline int16_t sat_q15( int32_t p_val );
+
+/**
+ * @brief Saturates a value to 32 bits.
+ */
+static inline int32_t sat_q31( int64_t p_val );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void dsp_fir_init_q15( dsp_fir_q15_t *p_fir, const int16_t *p_coeffs,
+                       uint16_t p_n_taps, int16_t *p_state, uint16_t p_block )
+{
+    p_fir->coeffs   = p_coeffs;
+    p_fir->state    = p_state;
+    p_fir->n_taps   = p_n_taps;
+    p_fir->block    = p_block;
+    for( size_t i = 0; i < DSP_FIR_STATE_LEN( p_n_taps, p_block ); i++ )
+    {
+        p_state[i] = 0;
+    }
+}
+
+void dsp_fir_init_q31( dsp_fir_q31_t *p_fir, const int32_t *p_coeffs,
+                       uint16_t p_n_taps, int32_t *p_state, uint16_t p_block )
+{
+    p_fir->coeffs   = p_coeffs;
+    p_fir->state    = p_state;
+    p_fir->n_taps   = p_n_taps;
+    p_fir->block    = p_block;
+    for( size_t i = 0; i < DSP_FIR_STATE_LEN( p_n_taps, p_block ); i++ )
+    {
+        p_state[i] = 0;
+    }
+}
+
+void dsp_fir_q15( dsp_fir_q15_t *p_fir, const int16_t *p_in, int16_t *p_out, size_t p_n )
+{
+    size_t n_taps = p_fir->n_taps;
+    int16_t *state = p_fir->state;
+
+    /* The new samples follow the last n_taps - 1 ones in the state, so each
+     * output is the dot product of a window of the state with the taps. */
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        state[n_taps - 1 + i] = p_in[i];
+    }
+
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        const int16_t *x = &state[i];
+        const int16_t *h = p_fir->coeffs;
+        int32_t acc = 0;
+#if DSP_XPULP
+        /* Every other window is not word aligned: the core splits its loads. */
+        for( size_t w = 0; w < n_taps / 2; w++ )
+        {
+            uint32_t xw, hw;
+            LOAD_PI( xw, x );
+            LOAD_PI( hw, h );
+            SIMD_ACC( "cv.sdotsp.h", acc, xw, hw );
+        }
+        if( n_taps & 1 )
+        {
+            acc += x[0] * h[0];
+        }
+        int32_t res;
+        CLIP( res, acc >> 15, 16 );
+        p_out[i] = res;
+#else
+        for( size_t k = 0; k < n_taps; k++ )
+        {
+            acc += x[k] * h[k];
+        }
+        p_out[i] = sat_q15( acc >> 15 );
+#endif
+    }
+
+    for( size_t k = 0; k < n_taps - 1; k++ )
+    {
+        state[k] = state[p_n + k];
+    }
+}
+
+void dsp_fir_q31( dsp_fir_q31_t *p_fir, const int32_t *p_in, int32_t *p_out, size_t p_n )
+{
+    size_t n_taps = p_fir->n_taps;
+    int32_t *state = p_fir->state;
+
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        state[n_taps - 1 + i] = p_in[i];
+    }
+
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        const int32_t *x = &state[i];
+        const int32_t *h = p_fir->coeffs;
+        int64_t acc = 0;
+        for( size_t k = 0; k < n_taps; k++ )
+        {
+            acc += (int64_t)x[k] * h[k];
+        }
+        p_out[i] = sat_q31( acc >> 31 );
+    }
+
+    for( size_t k = 0; k < n_taps - 1; k++ )
+    {
+        state[k] = state[p_n + k];
+    }
+}
+
+void dsp_biquad_init_q15( dsp_biquad_q15_t *p_bq, const int16_t *p_coeffs,
+                          int16_t *p_state, uint8_t p_n_stages )
+{
+    p_bq->coeffs    = p_coeffs;
+    p_bq->state     = p_state;
+    p_bq->n_stages  = p_n_stages;
+    for( size_t i = 0; i < p_n_stages * DSP_BIQUAD_STATE; i++ )
+    {
+        p_state[i] = 0;
+    }
+}
+
+void dsp_biquad_init_q31( dsp_biquad_q31_t *p_bq, const int32_t *p_coeffs,
+                          int32_t *p_state, uint8_t p_n_stages )
+{
+    p_bq->coeffs    = p_coeffs;
+    p_bq->state     = p_state;
+    p_bq->n_stages  = p_n_stages;
+    for( size_t i = 0; i < p_n_stages * DSP_BIQUAD_STATE; i++ )
+    {
+        p_state[i] = 0;
+    }
+}
+
+void dsp_biquad_q15( dsp_biquad_q15_t *p_bq, const int16_t *p_in, int16_t *p_out, size_t p_n )
+{
+    const int16_t *in = p_in;
+
+    for( size_t s = 0; s < p_bq->n_stages; s++ )
+    {
+        const int16_t *c = &p_bq->coeffs[s * DSP_BIQUAD_COEFFS];
+        int16_t *st = &p_bq->state[s * DSP_BIQUAD_STATE];
+        int32_t b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        int32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+        for( size_t i = 0; i < p_n; i++ )
+        {
+            int32_t x0 = in[i];
+            int32_t y0;
+#if DSP_XPULP
+            int32_t acc = b0 * x0;
+            SIMD_ACC( "cv.mac", acc, b1, x1 );
+            SIMD_ACC( "cv.mac", acc, b2, x2 );
+            SIMD_ACC( "cv.mac", acc, a1, y1 );
+            SIMD_ACC( "cv.mac", acc, a2, y2 );
+            CLIP( y0, acc >> 14, 16 );
+#else
+            int32_t acc = b0 * x0 + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+            y0 = sat_q15( acc >> 14 );
+#endif
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            p_out[i] = y0;
+        }
+
+        st[0] = x1;
+        st[1] = x2;
+        st[2] = y1;
+        st[3] = y2;
+        /* The next stages filter the output of the previous one in place. */
+        in = p_out;
+    }
+}
+
+void dsp_biquad_q31( dsp_biquad_q31_t *p_bq, const int32_t *p_in, int32_t *p_out, size_t p_n )
+{
+    const int32_t *in = p_in;
+
+    for( size_t s = 0; s < p_bq->n_stages; s++ )
+    {
+        const int32_t *c = &p_bq->coeffs[s * DSP_BIQUAD_COEFFS];
+        int32_t *st = &p_bq->state[s * DSP_BIQUAD_STATE];
+        int32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+        for( size_t i = 0; i < p_n; i++ )
+        {
+            int32_t x0 = in[i];
+            int64_t acc = (int64_t)c[0] * x0 + (int64_t)c[1] * x1
+                        + (int64_t)c[2] * x2 + (int64_t)c[3] * y1
+                        + (int64_t)c[4] * y2;
+            int32_t y0 = sat_q31( acc >> 30 );
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            p_out[i] = y0;
+        }
+
+        st[0] = x1;
+        st[1] = x2;
+        st[2] = y1;
+        st[3] = y2;
+        in = p_out;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline int16_t sat_q15( int32_t p_val )
+{
+    if( p_val > INT16_MAX )
+    {
+        return INT16_MAX;
+    }
+    if( p_val < INT16_MIN )
+    {
+        return INT16_MIN;
+    }
+    return p_val;
+}
+
+static inline int32_t sat_q31( int64_t p_val )
+{
+    if( p_val > INT32_MAX )
+    {
+        return INT32_MAX;
+    }
+    if( p_val < INT32_MIN )
+    {
+        return INT32_MIN;
+    }
+    return p_val;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
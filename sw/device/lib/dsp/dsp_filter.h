@@ -0,0 +1,197 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_filter.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_filter.h
+* @date   14/10/26
+* @brief  Fixed-point FIR filters and cascades of biquads, on blocks of
+* samples, in Q15 and Q31.
+*
+* A filter keeps its state between the blocks, so a stream is filtered block
+* by block, e.g. frame by frame from i2s_capture or pdm2pcm_capture. The
+* results are rounded down and saturated.
+*
+* The Q15 FIR accumulates in 32 bits: it cannot overflow as long as the sum of
+* the absolute values of its coefficients is below 2.0. The Q15 biquads do so
+* as well, with Q14 coefficients (in [-2.0, 2.0)) whose absolute values sum
+* to below 4.0 in each stage, which holds for the usual stable designs. The
+* Q31 kernels accumulate in 64 bits.
+*
+* With the Xpulp extensions (see dsp.h), the Q15 FIR runs two taps per
+* cv.sdotsp.h and the saturations use cv.clip. The results are the same as
+* with the portable versions. The Q31 kernels are the portable ones: the
+* compiler already emits the post-increment accesses and hardware loops, and
+* the cv32e40px has no 64-bit accumulation.
+*/
+
+#ifndef _DSP_FILTER_H
+#define _DSP_FILTER_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The coefficients of a biquad: b0, b1, b2, a1, a2, where
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+ * (a1 and a2 are the opposite of the usual denominator coefficients).
+ */
+#define DSP_BIQUAD_COEFFS   5
+
+/**
+ * The state of a biquad: x[n-1], x[n-2], y[n-1], y[n-2].
+ */
+#define DSP_BIQUAD_STATE    4
+
+/**
+ * The number of samples of the state of a FIR filter.
+ */
+#define DSP_FIR_STATE_LEN( n_taps, block )  ( ( n_taps ) + ( block ) - 1 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A Q15 FIR filter. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    const int16_t   *coeffs;    /*!< The taps, in time-reversed order. */
+    int16_t         *state;     /*!< DSP_FIR_STATE_LEN samples. */
+    uint16_t        n_taps;
+    uint16_t        block;      /*!< The largest block of samples. */
+} dsp_fir_q15_t;
+
+/**
+ * A Q31 FIR filter. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    const int32_t   *coeffs;    /*!< The taps, in time-reversed order. */
+    int32_t         *state;     /*!< DSP_FIR_STATE_LEN samples. */
+    uint16_t        n_taps;
+    uint16_t        block;      /*!< The largest block of samples. */
+} dsp_fir_q31_t;
+
+/**
+ * A cascade of Q15 biquads (direct form I). Its fields are managed by the
+ * functions below.
+ */
+typedef struct
+{
+    const int16_t   *coeffs;    /*!< DSP_BIQUAD_COEFFS Q14 coefficients per
+    stage. */
+    int16_t         *state;     /*!< DSP_BIQUAD_STATE samples per stage. */
+    uint8_t         n_stages;
+} dsp_biquad_q15_t;
+
+/**
+ * A cascade of Q31 biquads (direct form I). Its fields are managed by the
+ * functions below.
+ */
+typedef struct
+{
+    const int32_t   *coeffs;    /*!< DSP_BIQUAD_COEFFS Q30 coefficients per
+    stage. */
+    int32_t         *state;     /*!< DSP_BIQUAD_STATE samples per stage. */
+    uint8_t         n_stages;
+} dsp_biquad_q31_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes a FIR filter and clears its state.
+ * @param p_coeffs The p_n_taps taps, in time-reversed order (p_coeffs[0] is
+ * the coefficient of the oldest sample), word aligned. They must stay in
+ * memory.
+ * @param p_n_taps The number of taps, at least 1.
+ * @param p_state DSP_FIR_STATE_LEN( p_n_taps, p_block ) samples, word aligned.
+ * @param p_block The largest block that will be filtered.
+ */
+void dsp_fir_init_q15( dsp_fir_q15_t *p_fir, const int16_t *p_coeffs,
+                       uint16_t p_n_taps, int16_t *p_state, uint16_t p_block );
+void dsp_fir_init_q31( dsp_fir_q31_t *p_fir, const int32_t *p_coeffs,
+                       uint16_t p_n_taps, int32_t *p_state, uint16_t p_block );
+
+/**
+ * @brief Filters a block of samples.
+ * @param p_in The input samples.
+ * @param p_out The output samples, it may be p_in.
+ * @param p_n The number of samples, up to the block of the filter.
+ */
+void dsp_fir_q15( dsp_fir_q15_t *p_fir, const int16_t *p_in, int16_t *p_out, size_t p_n );
+void dsp_fir_q31( dsp_fir_q31_t *p_fir, const int32_t *p_in, int32_t *p_out, size_t p_n );
+
+/**
+ * @brief Initializes a cascade of biquads and clears its state.
+ * @param p_coeffs DSP_BIQUAD_COEFFS coefficients per stage, one stage after
+ * the other. They must stay in memory.
+ * @param p_state DSP_BIQUAD_STATE samples per stage.
+ * @param p_n_stages The number of stages.
+ */
+void dsp_biquad_init_q15( dsp_biquad_q15_t *p_bq, const int16_t *p_coeffs,
+                          int16_t *p_state, uint8_t p_n_stages );
+void dsp_biquad_init_q31( dsp_biquad_q31_t *p_bq, const int32_t *p_coeffs,
+                          int32_t *p_state, uint8_t p_n_stages );
+
+/**
+ * @brief Filters a block of samples through all the stages.
+ * @param p_in The input samples.
+ * @param p_out The output samples, it may be p_in.
+ * @param p_n The number of samples.
+ */
+void dsp_biquad_q15( dsp_biquad_q15_t *p_bq, const int16_t *p_in, int16_t *p_out, size_t p_n );
+void dsp_biquad_q31( dsp_biquad_q31_t *p_bq, const int32_t *p_in, int32_t *p_out, size_t p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_FILTER_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
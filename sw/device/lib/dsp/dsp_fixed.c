@@ -0,0 +1,565 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_fixed.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_fixed.c
+* @date   14/10/26
+* @brief  Fixed-point math with integer instructions only: tables and
+* polynomials for the fast variants, CORDIC and Newton-Raphson iterations for
+* the accurate ones.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_fixed.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The sine table has SIN_STEPS intervals over a quarter of a period, i.e.
+ * the 2^14 angles of a quarter are split in 14 - SIN_FRAC_BITS bits of index
+ * and SIN_FRAC_BITS bits of interpolation.
+ */
+#define SIN_STEPS           128
+#define SIN_FRAC_BITS       7
+
+/**
+ * CORDIC iterations, and the inverse of the gain of as many iterations,
+ * prod( 1 / sqrt( 1 + 2^-2i ) ), in Q30.
+ */
+#define CORDIC_ITERS        30
+#define CORDIC_INV_GAIN     652032874
+
+/**
+ * Coefficients of atan(z) / z as a polynomial of z^2 over [0, 1], in Q15,
+ * from the highest degree.
+ */
+#define ATAN_C9             683
+#define ATAN_C7             -2790
+#define ATAN_C5             5903
+#define ATAN_C3             -10823
+#define ATAN_C1             32764
+
+/**
+ * Binary angles per radian in Q15, 2^16 / ( 2 * pi ) * 2^16 / 2^15, shifted
+ * by 16.
+ */
+#define ATAN_RAD_TO_Q15     20861
+
+/**
+ * Coefficients of 2^x over [-0.5, 0.5], ln(2)^k / k! in Q30.
+ */
+#define EXP2_C0             1073741824
+#define EXP2_C1             744261118
+#define EXP2_C2             257941248
+#define EXP2_C3             59597083
+#define EXP2_C4             10327387
+#define EXP2_C5             1431680
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief atan( p_z ) in Q15 binary angles, for p_z in [0, 1] in Q15.
+ */
+static inline int32_t atan_poly_q15( int32_t p_z );
+
+/**
+ * @brief Converts a Q30 to Q31, saturated.
+ */
+static inline int32_t q30_to_q31( int32_t p_x );
+
+/**
+ * @brief Integer square root, rounded to nearest.
+ */
+static uint32_t isqrt32( uint32_t p_v );
+
+/**
+ * @brief Inverse square root of a mantissa.
+ * @param p_m The mantissa in Q30, in [1, 4).
+ * @return 1 / sqrt( p_m ) in Q31, in (0.5, 1].
+ */
+static uint32_t rsqrt_mant( uint32_t p_m );
+
+/**
+ * @brief Normalizes a non-zero value to a mantissa in [1, 4) in Q30 and an
+ * even exponent.
+ * @param p_x The value.
+ * @param p_exp Exponent of bit 31 of p_x, which is updated to the exponent
+ * of the mantissa.
+ * @return The mantissa.
+ */
+static inline uint32_t normalize_even( uint32_t p_x, int32_t *p_exp );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           GLOBAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * sin( i * pi / 2 / SIN_STEPS ) in Q15, for i from 0 to SIN_STEPS.
+ */
+static const int16_t sin_table[SIN_STEPS + 1] =
+{
+         0,    402,    804,   1206,   1608,   2009,   2411,   2811,   3212,   3612,
+      4011,   4410,   4808,   5205,   5602,   5998,   6393,   6787,   7180,   7571,
+      7962,   8351,   8740,   9127,   9512,   9896,  10279,  10660,  11039,  11417,
+     11793,  12167,  12540,  12910,  13279,  13646,  14010,  14373,  14733,  15091,
+     15447,  15800,  16151,  16500,  16846,  17190,  17531,  17869,  18205,  18538,
+     18868,  19195,  19520,  19841,  20160,  20475,  20788,  21097,  21403,  21706,
+     22006,  22302,  22595,  22884,  23170,  23453,  23732,  24008,  24279,  24548,
+     24812,  25073,  25330,  25583,  25833,  26078,  26320,  26557,  26791,  27020,
+     27246,  27467,  27684,  27897,  28106,  28311,  28511,  28707,  28899,  29086,
+     29269,  29448,  29622,  29792,  29957,  30118,  30274,  30425,  30572,  30715,
+     30853,  30986,  31114,  31238,  31357,  31471,  31581,  31686,  31786,  31881,
+     31972,  32058,  32138,  32214,  32286,  32352,  32413,  32470,  32522,  32568,
+     32610,  32647,  32679,  32706,  32729,  32746,  32758,  32766,  32767,
+};
+
+/**
+ * atan( 2^-i ) in Q31 binary angles, for the CORDIC iterations.
+ */
+static const int32_t cordic_atan[CORDIC_ITERS] =
+{
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838,
+    5340245, 2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+    10430, 5215, 2608, 1304, 652, 326, 163, 81, 41, 20, 10, 5, 3, 1,
+};
+
+/**
+ * Seeds of the inverse square root: 1 / sqrt( m ) in Q15 at the middle of
+ * the intervals of 1/16 of m in [1, 4).
+ */
+static const uint16_t rsqrt_seed[48] =
+{
+    32268, 31332, 30474, 29682, 28949, 28268, 27632, 27038, 26481, 25956,
+    25462, 24994, 24552, 24132, 23733, 23354, 22992, 22646, 22315, 21999,
+    21695, 21404, 21124, 20855, 20596, 20346, 20106, 19873, 19649, 19431,
+    19221, 19018, 18821, 18630, 18444, 18264, 18090, 17920, 17755, 17594,
+    17438, 17285, 17137, 16992, 16851, 16714, 16579, 16448,
+};
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void dsp_f32_to_q15_vec( const float *p_src, int16_t *p_dst, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = dsp_f32_to_q15( p_src[i] );
+    }
+}
+
+void dsp_f32_to_q31_vec( const float *p_src, int32_t *p_dst, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = dsp_f32_to_q31( p_src[i] );
+    }
+}
+
+void dsp_q15_to_f32_vec( const int16_t *p_src, float *p_dst, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = dsp_q15_to_f32( p_src[i] );
+    }
+}
+
+void dsp_q31_to_f32_vec( const int32_t *p_src, float *p_dst, size_t p_n )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_dst[i] = dsp_q31_to_f32( p_src[i] );
+    }
+}
+
+int16_t dsp_sin_q15( uint16_t p_angle )
+{
+    uint32_t q = p_angle >> 14;
+    uint32_t x = p_angle & 0x3fff;
+
+    /* The second and fourth quarters are read backwards, up to the peak. */
+    if( q & 1 )
+    {
+        x = 0x4000 - x;
+    }
+
+    uint32_t i = x >> SIN_FRAC_BITS;
+    uint32_t f = x & ( ( 1 << SIN_FRAC_BITS ) - 1 );
+    int32_t v = sin_table[i];
+    if( f )
+    {
+        v += ( ( sin_table[i + 1] - v ) * (int32_t)f + ( 1 << ( SIN_FRAC_BITS - 1 ) ) ) >> SIN_FRAC_BITS;
+    }
+
+    return ( q & 2 ) ? -v : v;
+}
+
+int16_t dsp_cos_q15( uint16_t p_angle )
+{
+    return dsp_sin_q15( p_angle + 0x4000 );
+}
+
+void dsp_sincos_q31( uint32_t p_angle, int32_t *p_sin, int32_t *p_cos )
+{
+    int32_t z = (int32_t)p_angle;
+    int32_t neg = 0;
+
+    /* The rotations converge within +-pi/2, the other half turn is rotated
+     * by pi. */
+    if( z > ( 1 << 30 ) || z < -( 1 << 30 ) )
+    {
+        z = (int32_t)( p_angle + 0x80000000u );
+        neg = 1;
+    }
+
+    /* In Q30, the vector of length 1 does not overflow. */
+    int32_t x = CORDIC_INV_GAIN;
+    int32_t y = 0;
+    for( int i = 0; i < CORDIC_ITERS; i++ )
+    {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+        if( z >= 0 )
+        {
+            x -= dx;
+            y += dy;
+            z -= cordic_atan[i];
+        }
+        else
+        {
+            x += dx;
+            y -= dy;
+            z += cordic_atan[i];
+        }
+    }
+
+    if( neg )
+    {
+        x = -x;
+        y = -y;
+    }
+    if( p_sin != NULL ) *p_sin = q30_to_q31( y );
+    if( p_cos != NULL ) *p_cos = q30_to_q31( x );
+}
+
+int16_t dsp_atan2_q15( int16_t p_y, int16_t p_x )
+{
+    int32_t ax = p_x < 0 ? -(int32_t)p_x : p_x;
+    int32_t ay = p_y < 0 ? -(int32_t)p_y : p_y;
+    int32_t a;
+
+    if( ax == 0 && ay == 0 )
+    {
+        return 0;
+    }
+
+    /* The first octant, and its mirror around pi/4. */
+    if( ay <= ax )
+    {
+        a = atan_poly_q15( ( ( ay << 15 ) + ( ax >> 1 ) ) / ax );
+    }
+    else
+    {
+        a = 0x4000 - atan_poly_q15( ( ( ax << 15 ) + ( ay >> 1 ) ) / ay );
+    }
+
+    if( p_x < 0 ) a = 0x8000 - a;
+    if( p_y < 0 ) a = -a;
+
+    /* pi wraps around to -pi. */
+    return (int16_t)a;
+}
+
+int32_t dsp_atan2_q31( int32_t p_y, int32_t p_x )
+{
+    uint32_t ax = p_x < 0 ? -(uint32_t)p_x : (uint32_t)p_x;
+    uint32_t ay = p_y < 0 ? -(uint32_t)p_y : (uint32_t)p_y;
+    uint32_t offset = 0;
+    int64_t x, y;
+    int32_t z = 0;
+
+    if( ( ax | ay ) == 0 )
+    {
+        return 0;
+    }
+
+    /* The largest coordinate is brought to [2^60, 2^61), so that the gain of
+     * the iterations cannot overflow and the truncations of the shifts stay
+     * far below the last angle of the table. */
+    int s = __builtin_clz( ax | ay ) + 29;
+    x = (int64_t)p_x * ( (int64_t)1 << s );
+    y = (int64_t)p_y * ( (int64_t)1 << s );
+
+    /* The left half plane is rotated by pi. */
+    if( x < 0 )
+    {
+        x = -x;
+        y = -y;
+        offset = 0x80000000u;
+    }
+
+    for( int i = 0; i < CORDIC_ITERS; i++ )
+    {
+        int64_t dx = y >> i;
+        int64_t dy = x >> i;
+        if( y > 0 )
+        {
+            x += dx;
+            y -= dy;
+            z += cordic_atan[i];
+        }
+        else
+        {
+            x -= dx;
+            y += dy;
+            z -= cordic_atan[i];
+        }
+    }
+
+    return (int32_t)( (uint32_t)z + offset );
+}
+
+int16_t dsp_sqrt_q15( int16_t p_x )
+{
+    if( p_x <= 0 )
+    {
+        return 0;
+    }
+
+    uint32_t r = isqrt32( (uint32_t)p_x << 15 );
+    return r > INT16_MAX ? INT16_MAX : (int16_t)r;
+}
+
+int32_t dsp_sqrt_q31( int32_t p_x )
+{
+    if( p_x <= 0 )
+    {
+        return 0;
+    }
+
+    /* p_x / 2^31 = m * 2^e, and sqrt( m ) = m / sqrt( m ). */
+    int32_t e = 0;
+    uint32_t m = normalize_even( (uint32_t)p_x, &e );
+    uint32_t s = ( (uint64_t)m * rsqrt_mant( m ) ) >> 31;
+
+    /* s is sqrt( m ) in Q30, the result is s * 2^( e / 2 ) in Q31. */
+    int32_t sh = -e / 2 - 1;
+    if( sh > 0 )
+    {
+        s = ( s + ( 1u << ( sh - 1 ) ) ) >> sh;
+    }
+
+    /* The estimate is within a few LSBs, it is moved to the nearest integer
+     * of sqrt( p_x * 2^31 ): r is rounded to it when
+     * r^2 - r < p_x * 2^31 <= r^2 + r. */
+    uint64_t v = (uint64_t)p_x << 31;
+    uint64_t r = s;
+    while( v > r * r + r )
+    {
+        r++;
+    }
+    while( v <= r * r - r )
+    {
+        r--;
+    }
+    return r > INT32_MAX ? INT32_MAX : (int32_t)r;
+}
+
+uint32_t dsp_rsqrt_q16( uint32_t p_x )
+{
+    if( p_x == 0 )
+    {
+        return UINT32_MAX;
+    }
+
+    /* p_x / 2^16 = m * 2^e, the result is 2^( -e / 2 ) / sqrt( m ). */
+    int32_t e = 15;
+    uint32_t m = normalize_even( p_x, &e );
+    uint32_t r = rsqrt_mant( m );
+    int32_t sh = 15 + e / 2;
+
+    return ( r + ( 1u << ( sh - 1 ) ) ) >> sh;
+}
+
+int32_t dsp_log2_q16( uint32_t p_x )
+{
+    if( p_x == 0 )
+    {
+        return INT32_MIN;
+    }
+
+    int32_t n = __builtin_clz( p_x );
+    uint32_t m = ( p_x << n ) >> 1;
+    uint32_t frac = 0;
+
+    /* The mantissa in [1, 2) is squared at each step: the square is above 2
+     * when the next bit of its logarithm is 1. One more bit is computed for
+     * the rounding. */
+    for( int i = 0; i < 17; i++ )
+    {
+        m = ( (uint64_t)m * m + ( 1u << 29 ) ) >> 30;
+        frac <<= 1;
+        if( m >= ( 1u << 31 ) )
+        {
+            m >>= 1;
+            frac |= 1;
+        }
+    }
+
+    return ( 15 - n ) * 65536 + (int32_t)( ( frac + 1 ) >> 1 );
+}
+
+uint32_t dsp_exp2_q16( int32_t p_x )
+{
+    if( p_x >= 16 * 65536 )
+    {
+        return UINT32_MAX;
+    }
+    if( p_x < -17 * 65536 )
+    {
+        return 0;
+    }
+
+    /* 2^x = 2^k * 2^f, with k the nearest integer and f in [-0.5, 0.5]. */
+    int32_t k = ( p_x + 0x8000 ) >> 16;
+    int32_t f = ( p_x - k * 65536 ) * ( 1 << 14 );
+    int32_t p = EXP2_C5;
+    p = EXP2_C4 + (int32_t)( ( (int64_t)p * f ) >> 30 );
+    p = EXP2_C3 + (int32_t)( ( (int64_t)p * f ) >> 30 );
+    p = EXP2_C2 + (int32_t)( ( (int64_t)p * f ) >> 30 );
+    p = EXP2_C1 + (int32_t)( ( (int64_t)p * f ) >> 30 );
+    p = EXP2_C0 + (int32_t)( ( (int64_t)p * f ) >> 30 );
+
+    /* p is in Q30, the result in Q16. */
+    int32_t sh = 14 - k;
+    if( sh > 0 )
+    {
+        return ( (uint32_t)p + ( 1u << ( sh - 1 ) ) ) >> sh;
+    }
+    uint64_t v = (uint64_t)(uint32_t)p << -sh;
+    return v > UINT32_MAX ? UINT32_MAX : (uint32_t)v;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline int32_t atan_poly_q15( int32_t p_z )
+{
+    int32_t z2 = ( p_z * p_z + ( 1 << 14 ) ) >> 15;
+    int32_t p = ATAN_C9;
+    p = ATAN_C7 + ( ( p * z2 + ( 1 << 14 ) ) >> 15 );
+    p = ATAN_C5 + ( ( p * z2 + ( 1 << 14 ) ) >> 15 );
+    p = ATAN_C3 + ( ( p * z2 + ( 1 << 14 ) ) >> 15 );
+    p = ATAN_C1 + ( ( p * z2 + ( 1 << 14 ) ) >> 15 );
+
+    /* The angle in radians in Q15, then in binary angles. */
+    int32_t r = ( p * p_z + ( 1 << 14 ) ) >> 15;
+    return ( r * ATAN_RAD_TO_Q15 + ( 1 << 15 ) ) >> 16;
+}
+
+static inline int32_t q30_to_q31( int32_t p_x )
+{
+    if( p_x >= ( 1 << 30 ) ) return INT32_MAX;
+    if( p_x < -( 1 << 30 ) ) return INT32_MIN;
+    return p_x * 2;
+}
+
+static uint32_t isqrt32( uint32_t p_v )
+{
+    uint32_t r = 0;
+    uint32_t b = 1u << 30;
+
+    while( b > p_v )
+    {
+        b >>= 2;
+    }
+    while( b != 0 )
+    {
+        if( p_v >= r + b )
+        {
+            p_v -= r + b;
+            r = ( r >> 1 ) + b;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+
+    /* p_v is the remainder of the floor, it is rounded up past r + 1/2. */
+    return p_v > r ? r + 1 : r;
+}
+
+static uint32_t rsqrt_mant( uint32_t p_m )
+{
+    uint32_t r = (uint32_t)rsqrt_seed[( p_m >> 26 ) - 16] << 16;
+
+    /* r = r * ( 3 - m * r^2 ) / 2, each iteration doubles the correct bits
+     * from the 6 of the seed. */
+    for( int i = 0; i < 3; i++ )
+    {
+        uint32_t r2 = ( (uint64_t)r * r ) >> 32;
+        uint32_t t = ( (uint64_t)p_m * r2 ) >> 30;
+        r = ( (uint64_t)r * ( ( 3u << 30 ) - t ) ) >> 31;
+    }
+    return r;
+}
+
+static inline uint32_t normalize_even( uint32_t p_x, int32_t *p_exp )
+{
+    int32_t n = __builtin_clz( p_x );
+    uint32_t m = p_x << n;
+
+    *p_exp -= n;
+    /* An odd exponent is moved to the mantissa, which is then in [2, 4). */
+    if( *p_exp & 1 )
+    {
+        *p_exp -= 1;
+        return m;
+    }
+    return m >> 1;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
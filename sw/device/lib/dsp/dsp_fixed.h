@@ -0,0 +1,232 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_fixed.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_fixed.h
+* @date   14/10/26
+* @brief  Fixed-point math for the cores without an FPU: conversions between
+* floats and Q15/Q31, fractional products, sine and cosine, atan2, square
+* roots, inverse square roots, log2 and exp2.
+*
+* Without F extension every float operation is a soft-float call of tens to
+* hundreds of cycles. These functions only use integer instructions, and the
+* multiplications of the M extension.
+*
+* Most functions come in two variants:
+* - a fast Q15 one, from a table or a polynomial, within a couple of LSBs;
+* - an accurate Q31 one, with CORDIC or Newton-Raphson iterations, more
+*   accurate than a float.
+*
+* The angles are binary: a full turn is 2^16 in Q15 and 2^32 in Q31, so that
+* they wrap around like the integers. The angles of atan2 are signed, from
+* -pi included to pi excluded. DSP_RAD_TO_Q15 and DSP_RAD_TO_Q31 convert
+* radians.
+*
+* log2, exp2 and the inverse square root are in Q16.16, whose range
+* covers their results.
+*/
+
+#ifndef _DSP_FIXED_H
+#define _DSP_FIXED_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Binary angles of an angle in radians, for the constants.
+ */
+#define DSP_RAD_TO_Q15( p_rad ) ( (int16_t)(int32_t)( (p_rad) * 10430.378350470453 ) )
+#define DSP_RAD_TO_Q31( p_rad ) ( (int32_t)(int64_t)( (p_rad) * 683565275.5764316 ) )
+
+/**
+ * 1.0 in Q16.16.
+ */
+#define DSP_Q16_ONE         ( 1u << 16 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Converts a float to Q15 or Q31, rounded to nearest and saturated
+ * to [-1, 1).
+ */
+static inline int16_t dsp_f32_to_q15( float p_x )
+{
+    p_x *= 32768.0f;
+    if( p_x >= 32767.0f ) return INT16_MAX;
+    if( p_x <= -32768.0f ) return INT16_MIN;
+    return (int16_t)( p_x >= 0.0f ? p_x + 0.5f : p_x - 0.5f );
+}
+
+static inline int32_t dsp_f32_to_q31( float p_x )
+{
+    p_x *= 2147483648.0f;
+    if( p_x >= 2147483648.0f ) return INT32_MAX;
+    if( p_x <= -2147483648.0f ) return INT32_MIN;
+    return (int32_t)( p_x >= 0.0f ? p_x + 0.5f : p_x - 0.5f );
+}
+
+/**
+ * @brief Converts Q15 or Q31 to a float.
+ */
+static inline float dsp_q15_to_f32( int16_t p_x )
+{
+    return (float)p_x * ( 1.0f / 32768.0f );
+}
+
+static inline float dsp_q31_to_f32( int32_t p_x )
+{
+    return (float)p_x * ( 1.0f / 2147483648.0f );
+}
+
+/**
+ * @brief Converts between Q15 and Q31, rounded to nearest and saturated.
+ */
+static inline int32_t dsp_q15_to_q31( int16_t p_x )
+{
+    return (int32_t)p_x << 16;
+}
+
+static inline int16_t dsp_q31_to_q15( int32_t p_x )
+{
+    int32_t v = ( p_x >> 16 ) + ( ( p_x >> 15 ) & 1 );
+    return v > INT16_MAX ? INT16_MAX : (int16_t)v;
+}
+
+/**
+ * @brief Product of two Q15 or Q31, rounded to nearest. -1 * -1 saturates
+ * to the largest value.
+ */
+static inline int16_t dsp_mul_q15( int16_t p_a, int16_t p_b )
+{
+    int32_t v = ( (int32_t)p_a * p_b + ( 1 << 14 ) ) >> 15;
+    return v > INT16_MAX ? INT16_MAX : (int16_t)v;
+}
+
+static inline int32_t dsp_mul_q31( int32_t p_a, int32_t p_b )
+{
+    int64_t v = ( (int64_t)p_a * p_b + ( 1 << 30 ) ) >> 31;
+    return v > INT32_MAX ? INT32_MAX : (int32_t)v;
+}
+
+/**
+ * @brief Converts p_n elements between floats and Q15 or Q31, as the scalar
+ * conversions.
+ */
+void dsp_f32_to_q15_vec( const float *p_src, int16_t *p_dst, size_t p_n );
+void dsp_f32_to_q31_vec( const float *p_src, int32_t *p_dst, size_t p_n );
+void dsp_q15_to_f32_vec( const int16_t *p_src, float *p_dst, size_t p_n );
+void dsp_q31_to_f32_vec( const int32_t *p_src, float *p_dst, size_t p_n );
+
+/**
+ * @brief Fast sine and cosine, by linear interpolation in a table of a
+ * quarter of a period. Within 2 LSBs.
+ * @param p_angle The angle, a full turn is 2^16.
+ */
+int16_t dsp_sin_q15( uint16_t p_angle );
+int16_t dsp_cos_q15( uint16_t p_angle );
+
+/**
+ * @brief Accurate sine and cosine, with 30 CORDIC iterations and no table
+ * look-up. Within 64 LSBs of Q31, i.e. 3e-8.
+ * @param p_angle The angle, a full turn is 2^32.
+ * @param p_sin The sine, may be NULL.
+ * @param p_cos The cosine, may be NULL.
+ */
+void dsp_sincos_q31( uint32_t p_angle, int32_t *p_sin, int32_t *p_cos );
+
+/**
+ * @brief Fast angle of the point (p_x, p_y), with a polynomial of degree 9
+ * and a division. Within 2 LSBs. It is 0 at (0, 0).
+ * @return The angle, from -2^15 (-pi) to 2^15 - 1.
+ */
+int16_t dsp_atan2_q15( int16_t p_y, int16_t p_x );
+
+/**
+ * @brief Accurate angle of the point (p_x, p_y), with 30 CORDIC iterations
+ * on 64 bits and no division. Within 8 LSBs of Q31, the rounding of the
+ * table of the angles and the angle left after the last iteration. It is 0
+ * at (0, 0).
+ * @return The angle, from -2^31 (-pi) to 2^31 - 1.
+ */
+int32_t dsp_atan2_q31( int32_t p_y, int32_t p_x );
+
+/**
+ * @brief Square root of a Q15 or Q31, 0 for the negative inputs. Both are
+ * rounded to the nearest: the Q15 one bit by bit, the Q31 one from the
+ * inverse square root and a correction of its last LSBs.
+ */
+int16_t dsp_sqrt_q15( int16_t p_x );
+int32_t dsp_sqrt_q31( int32_t p_x );
+
+/**
+ * @brief Inverse square root 1 / sqrt(p_x) with Newton-Raphson iterations
+ * from a table. Within 1 LSB.
+ * @param p_x The input in Q16.16, UINT32_MAX is returned for 0.
+ * @return The result in Q16.16, up to 256.
+ */
+uint32_t dsp_rsqrt_q16( uint32_t p_x );
+
+/**
+ * @brief Base 2 logarithm, bit by bit. Within 1 LSB.
+ * @param p_x The input in Q16.16, INT32_MIN is returned for 0.
+ * @return The result in signed Q16.16, from -16 to 16.
+ */
+int32_t dsp_log2_q16( uint32_t p_x );
+
+/**
+ * @brief Base 2 exponential, with a polynomial of degree 5. Within 1 LSB,
+ * or a few millionths of the result above 1.
+ * @param p_x The input in signed Q16.16.
+ * @return The result in Q16.16. It saturates to UINT32_MAX from 16 up, and
+ * is 0 below -17.
+ */
+uint32_t dsp_exp2_q16( int32_t p_x );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_FIXED_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,294 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_float.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_float.c
+* @date   14/10/26
+* @brief  Single precision float kernels, with independent accumulations to
+* fill the pipeline of the floating-point unit.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_float.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * acc += x * y, fused when the target has it.
+ */
+#if DSP_FMA
+#define MAC( acc, x, y )    ( acc ) = __builtin_fmaf( ( x ), ( y ), ( acc ) )
+#else
+#define MAC( acc, x, y )    ( acc ) += ( x ) * ( y )
+#endif
+
+/**
+ * Bounds of the inputs of the exponential with a normal result.
+ */
+#define EXP_MIN_X       -87.33654f
+#define EXP_MAX_X       88.72283f
+
+/**
+ * log2(e), and ln(2) split in a high part with a short mantissa, so that
+ * k * EXP_LN2_HI is exact, and the rest.
+ */
+#define EXP_LOG2E       1.44269504f
+#define EXP_LN2_HI      0.693145751953125f
+#define EXP_LN2_LO      1.42860677e-06f
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief One element of a matrix product: the dot product of a row of p_a
+ * with a column of p_b, p_stride elements apart.
+ */
+static float gemm_one( const float *p_a, const float *p_b, size_t p_inner, size_t p_stride );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+float dsp_dot_f32( const float *p_a, const float *p_b, size_t p_n )
+{
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    size_t i = 0;
+
+    /* Four partial sums, each waits for its previous result 4 operations
+     * later. */
+    for( ; i + 3 < p_n; i += 4 )
+    {
+        MAC( acc0, p_a[i],     p_b[i] );
+        MAC( acc1, p_a[i + 1], p_b[i + 1] );
+        MAC( acc2, p_a[i + 2], p_b[i + 2] );
+        MAC( acc3, p_a[i + 3], p_b[i + 3] );
+    }
+    for( ; i < p_n; i++ )
+    {
+        MAC( acc0, p_a[i], p_b[i] );
+    }
+
+    return ( acc0 + acc1 ) + ( acc2 + acc3 );
+}
+
+void dsp_axpy_f32( float p_alpha, const float *p_x, float *p_y, size_t p_n )
+{
+    size_t i = 0;
+
+    for( ; i + 3 < p_n; i += 4 )
+    {
+        /* All the loads first, then the independent operations. */
+        float x0 = p_x[i],     x1 = p_x[i + 1], x2 = p_x[i + 2], x3 = p_x[i + 3];
+        float y0 = p_y[i],     y1 = p_y[i + 1], y2 = p_y[i + 2], y3 = p_y[i + 3];
+        MAC( y0, p_alpha, x0 );
+        MAC( y1, p_alpha, x1 );
+        MAC( y2, p_alpha, x2 );
+        MAC( y3, p_alpha, x3 );
+        p_y[i]     = y0;
+        p_y[i + 1] = y1;
+        p_y[i + 2] = y2;
+        p_y[i + 3] = y3;
+    }
+    for( ; i < p_n; i++ )
+    {
+        MAC( p_y[i], p_alpha, p_x[i] );
+    }
+}
+
+void dsp_gemm_f32( const float *p_a, const float *p_b, float *p_c,
+                   size_t p_rows, size_t p_inner, size_t p_cols )
+{
+    size_t i = 0;
+
+    /* Blocks of 2 x 2 results: four independent accumulations, and each
+     * element loaded is used twice. */
+    for( ; i + 1 < p_rows; i += 2 )
+    {
+        const float *a0 = p_a + i * p_inner;
+        const float *a1 = a0 + p_inner;
+        float *c0 = p_c + i * p_cols;
+        float *c1 = c0 + p_cols;
+        size_t j = 0;
+
+        for( ; j + 1 < p_cols; j += 2 )
+        {
+            const float *pb = p_b + j;
+            float acc00 = 0.0f, acc01 = 0.0f, acc10 = 0.0f, acc11 = 0.0f;
+
+            for( size_t k = 0; k < p_inner; k++ )
+            {
+                float x0 = a0[k], x1 = a1[k];
+                float y0 = pb[0], y1 = pb[1];
+                MAC( acc00, x0, y0 );
+                MAC( acc01, x0, y1 );
+                MAC( acc10, x1, y0 );
+                MAC( acc11, x1, y1 );
+                pb += p_cols;
+            }
+            c0[j]     = acc00;
+            c0[j + 1] = acc01;
+            c1[j]     = acc10;
+            c1[j + 1] = acc11;
+        }
+        if( j < p_cols )
+        {
+            c0[j] = gemm_one( a0, p_b + j, p_inner, p_cols );
+            c1[j] = gemm_one( a1, p_b + j, p_inner, p_cols );
+        }
+    }
+
+    /* The last row of an odd number of rows. */
+    if( i < p_rows )
+    {
+        for( size_t j = 0; j < p_cols; j++ )
+        {
+            p_c[i * p_cols + j] = gemm_one( p_a + i * p_inner, p_b + j, p_inner, p_cols );
+        }
+    }
+}
+
+float dsp_exp_f32( float p_x )
+{
+    union
+    {
+        float       f;
+        uint32_t    u;
+    } scale;
+    float t, r, p;
+    int32_t k;
+
+    if( p_x < EXP_MIN_X )
+    {
+        return 0.0f;
+    }
+    if( p_x > EXP_MAX_X )
+    {
+        return __builtin_inff();
+    }
+
+    /* exp(x) = 2^k * exp(r), with k the nearest integer of x / ln(2) and
+     * |r| <= ln(2) / 2. */
+    t = p_x * EXP_LOG2E;
+    k = ( int32_t )( t + ( t >= 0.0f ? 0.5f : -0.5f ) );
+    r = ( p_x - ( float )k * EXP_LN2_HI ) - ( float )k * EXP_LN2_LO;
+
+    /* Taylor polynomial of degree 6, below an ulp on this range. */
+    p = 1.0f / 720.0f;
+    p = p * r + 1.0f / 120.0f;
+    p = p * r + 1.0f / 24.0f;
+    p = p * r + 1.0f / 6.0f;
+    p = p * r + 0.5f;
+    p = p * r + 1.0f;
+    p = p * r + 1.0f;
+
+    /* 2^128 is not a float, the last factor 2 goes to p. */
+    if( k > 127 )
+    {
+        p *= 2.0f;
+        k--;
+    }
+    scale.u = ( uint32_t )( k + 127 ) << 23;
+
+    return p * scale.f;
+}
+
+void dsp_softmax_f32( const float *p_x, float *p_y, size_t p_n )
+{
+    float max = p_x[0];
+    float sum0 = 0.0f, sum1 = 0.0f;
+    float inv;
+    size_t i;
+
+    for( i = 1; i < p_n; i++ )
+    {
+        if( p_x[i] > max )
+        {
+            max = p_x[i];
+        }
+    }
+
+    /* Two partial sums of the exponentials. */
+    for( i = 0; i + 1 < p_n; i += 2 )
+    {
+        float e0 = dsp_exp_f32( p_x[i] - max );
+        float e1 = dsp_exp_f32( p_x[i + 1] - max );
+        p_y[i]     = e0;
+        p_y[i + 1] = e1;
+        sum0 += e0;
+        sum1 += e1;
+    }
+    if( i < p_n )
+    {
+        p_y[i] = dsp_exp_f32( p_x[i] - max );
+        sum0 += p_y[i];
+    }
+
+    /* The largest exponential is 1, so the sum is at least 1. */
+    inv = 1.0f / ( sum0 + sum1 );
+    for( i = 0; i < p_n; i++ )
+    {
+        p_y[i] *= inv;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static float gemm_one( const float *p_a, const float *p_b, size_t p_inner, size_t p_stride )
+{
+    float acc0 = 0.0f, acc1 = 0.0f;
+    size_t k = 0;
+
+    for( ; k + 1 < p_inner; k += 2 )
+    {
+        MAC( acc0, p_a[k],     p_b[0] );
+        MAC( acc1, p_a[k + 1], p_b[p_stride] );
+        p_b += 2 * p_stride;
+    }
+    if( k < p_inner )
+    {
+        MAC( acc0, p_a[k], p_b[0] );
+    }
+
+    return acc0 + acc1;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
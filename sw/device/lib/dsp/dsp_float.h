@@ -0,0 +1,129 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_float.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_float.h
+* @date   14/10/26
+* @brief  Single precision float kernels: dot product, AXPY, matrix
+* multiplication (GEMM), exponential and softmax.
+*
+* The floating-point unit is pipelined: in the cv32e40p with FPU=1 when its
+* latency parameters are not 0, and in the fpu_ss behind the eXtension
+* interface of the cv32e40x (X_EXT=1), where each instruction also goes
+* through the offload handshake. A loop accumulating in a single register
+* waits for each result before the next operation. These kernels keep
+* several independent accumulations in flight instead: 4 partial sums in the
+* dot product, block of 2 x 2 results in the GEMM, 4 elements per iteration in
+* the AXPY, whose loads are issued before the operations.
+*
+* The products are accumulated with fused multiply-adds when the compiler
+* has them for the target (__FP_FAST_FMAF, e.g. ARCH=rv32imfc), which are
+* rounded once. The sums are in a different order than a plain loop, so the
+* results differ from it by a few rounding errors.
+*
+* Without F extension (ARCH without f) the same code runs with the soft-float
+* routines of the compiler. With it, the FPU must be enabled first (FS field
+* of mstatus).
+*/
+
+#ifndef _DSP_FLOAT_H
+#define _DSP_FLOAT_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * 1 if the kernels use fused multiply-adds, 0 if they multiply and add.
+ */
+#if defined(__FP_FAST_FMAF)
+#define DSP_FMA 1
+#else
+#define DSP_FMA 0
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Dot product of two vectors of p_n elements.
+ * @return The sum of p_a[i] * p_b[i].
+ */
+float dsp_dot_f32( const float *p_a, const float *p_b, size_t p_n );
+
+/**
+ * @brief AXPY: p_y[i] += p_alpha * p_x[i] for p_n elements.
+ */
+void dsp_axpy_f32( float p_alpha, const float *p_x, float *p_y, size_t p_n );
+
+/**
+ * @brief Matrix multiplication p_c = p_a * p_b of dense matrices stored row
+ * by row.
+ * @param p_a The left matrix, p_rows x p_inner.
+ * @param p_b The right matrix, p_inner x p_cols.
+ * @param p_c The result, p_rows x p_cols. It must not overlap the others.
+ */
+void dsp_gemm_f32( const float *p_a, const float *p_b, float *p_c,
+                   size_t p_rows, size_t p_inner, size_t p_cols );
+
+/**
+ * @brief Exponential, within a few units in the last place of expf over the
+ * inputs whose result is a normal float. It is 0 below about -87.3 and
+ * infinite above about 88.7.
+ */
+float dsp_exp_f32( float p_x );
+
+/**
+ * @brief Softmax: p_y[i] = exp(p_x[i]) / sum of exp(p_x[j]), computed with
+ * the maximum of p_x subtracted so that it cannot overflow.
+ * @param p_x The inputs, p_n > 0 elements.
+ * @param p_y The outputs, may be p_x.
+ */
+void dsp_softmax_f32( const float *p_x, float *p_y, size_t p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_FLOAT_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,168 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_matrix.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_matrix.c
+* @date   14/10/26
+* @brief  Matrix kernels, with Xpulp versions of the integer ones for the
+* cv32e40p(x).
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_matrix.h"
+#include "dsp_xpulp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void dsp_mat_add_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c,
+                      size_t p_rows, size_t p_cols )
+{
+    /* The matrices are dense, the rows follow each other. */
+    dsp_add_i32( p_a, p_b, p_c, p_rows * p_cols );
+}
+
+void dsp_mat_add_f32( const float *p_a, const float *p_b, float *p_c,
+                      size_t p_rows, size_t p_cols )
+{
+    size_t n = p_rows * p_cols;
+
+    /* Two elements per iteration, so that the loads of the second hide the
+     * latency of the first ones. */
+    for( size_t i = 0; i < n / 2; i++ )
+    {
+        float a0 = *p_a++;
+        float a1 = *p_a++;
+        float b0 = *p_b++;
+        float b1 = *p_b++;
+        *p_c++ = a0 + b0;
+        *p_c++ = a1 + b1;
+    }
+    if( n & 1 )
+    {
+        *p_c = *p_a + *p_b;
+    }
+}
+
+void dsp_mat_mul_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c,
+                      size_t p_rows, size_t p_inner, size_t p_cols )
+{
+#if DSP_XPULP
+    uint32_t stride = p_cols * sizeof( int32_t );
+#endif
+
+    for( size_t r = 0; r < p_rows; r++ )
+    {
+        const int32_t *a_row = p_a + r * p_inner;
+        size_t j = 0;
+
+        /* Two columns at once, each element of the row is loaded once. */
+        for( ; j + 1 < p_cols; j += 2 )
+        {
+            const int32_t *pa = a_row;
+            const int32_t *pb = p_b + j;
+            int32_t acc0 = 0;
+            int32_t acc1 = 0;
+
+            for( size_t k = 0; k < p_inner; k++ )
+            {
+#if DSP_XPULP
+                int32_t x, y0, y1;
+                LOAD_PI( x, pa );
+                y1 = pb[1];
+                LOAD_PI_STRIDE( y0, pb, stride );
+                SIMD_ACC( "cv.mac", acc0, x, y0 );
+                SIMD_ACC( "cv.mac", acc1, x, y1 );
+#else
+                int32_t x = *pa++;
+                acc0 += x * pb[0];
+                acc1 += x * pb[1];
+                pb += p_cols;
+#endif
+            }
+            *p_c++ = acc0;
+            *p_c++ = acc1;
+        }
+
+        /* The last column of an odd number of columns. */
+        if( j < p_cols )
+        {
+            const int32_t *pa = a_row;
+            const int32_t *pb = p_b + j;
+            int32_t acc = 0;
+
+            for( size_t k = 0; k < p_inner; k++ )
+            {
+                acc += *pa++ * *pb;
+                pb += p_cols;
+            }
+            *p_c++ = acc;
+        }
+    }
+}
+
+void dsp_conv2d_i32( const int32_t *p_in, size_t p_rows, size_t p_cols,
+                     const int32_t *p_kernel, size_t p_k_rows, size_t p_k_cols,
+                     int32_t *p_out )
+{
+    size_t out_rows = p_rows - p_k_rows + 1;
+    size_t out_cols = p_cols - p_k_cols + 1;
+
+    for( size_t i = 0; i < out_rows; i++ )
+    {
+        for( size_t j = 0; j < out_cols; j++ )
+        {
+            const int32_t *pk = p_kernel;
+            int32_t acc = 0;
+
+            for( size_t u = 0; u < p_k_rows; u++ )
+            {
+                const int32_t *pi = p_in + ( i + u ) * p_cols + j;
+
+                for( size_t v = 0; v < p_k_cols; v++ )
+                {
+#if DSP_XPULP
+                    int32_t x, w;
+                    LOAD_PI( x, pi );
+                    LOAD_PI( w, pk );
+                    SIMD_ACC( "cv.mac", acc, x, w );
+#else
+                    acc += *pi++ * *pk++;
+#endif
+                }
+            }
+            *p_out++ = acc;
+        }
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,104 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_matrix.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_matrix.h
+* @date   14/10/26
+* @brief  Matrix kernels: addition of 32-bit integer and float matrices,
+* multiplication and 2D convolution of 32-bit integer matrices.
+*
+* The matrices are dense and stored row by row. The kernels walk them with
+* pointers instead of computing i * cols + j at each element, and the
+* multiplication computes two columns of the result at once, so that each
+* element of the left matrix is loaded once for both.
+*
+* With the Xpulp extensions (see dsp.h), the integer kernels use the
+* post-increment load/stores (with an immediate or, down the columns, a
+* register increment) and cv.mac. The float addition is the same portable
+* code in both cases: the compiler emits its hardware loop. The results are
+* the same as with the portable versions: the integer ones wrap around on
+* overflow.
+*/
+
+#ifndef _DSP_MATRIX_H
+#define _DSP_MATRIX_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Matrix addition p_c = p_a + p_b of p_rows x p_cols matrices.
+ */
+void dsp_mat_add_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c,
+                      size_t p_rows, size_t p_cols );
+void dsp_mat_add_f32( const float *p_a, const float *p_b, float *p_c,
+                      size_t p_rows, size_t p_cols );
+
+/**
+ * @brief Matrix multiplication p_c = p_a * p_b.
+ * @param p_a The left matrix, p_rows x p_inner.
+ * @param p_b The right matrix, p_inner x p_cols.
+ * @param p_c The result, p_rows x p_cols. It must not overlap the others.
+ */
+void dsp_mat_mul_i32( const int32_t *p_a, const int32_t *p_b, int32_t *p_c,
+                      size_t p_rows, size_t p_inner, size_t p_cols );
+
+/**
+ * @brief 2D convolution of a matrix with a kernel, without padding nor
+ * flipping the kernel (i.e. a correlation, as in the CNNs):
+ * p_out[i][j] = sum of p_in[i + u][j + v] * p_kernel[u][v].
+ * @param p_in The input, p_rows x p_cols.
+ * @param p_kernel The kernel, p_k_rows x p_k_cols, at most the input.
+ * @param p_out The result, (p_rows - p_k_rows + 1) x (p_cols - p_k_cols + 1).
+ * It must not overlap the others.
+ */
+void dsp_conv2d_i32( const int32_t *p_in, size_t p_rows, size_t p_cols,
+                     const int32_t *p_kernel, size_t p_k_rows, size_t p_k_cols,
+                     int32_t *p_out );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_MATRIX_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
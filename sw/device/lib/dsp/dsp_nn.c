@@ -0,0 +1,471 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_nn.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dsp_nn.c
+* @date   14/10/26
+* @brief  8-bit integer neural network kernels, with Xpulp versions of the
+* dot products and of the max pooling for the cv32e40p(x).
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp_nn.h"
+#include "dsp_xpulp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define NN_I8_PER_W     4
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Adds the dot products of p_x with p_w0 and with p_w1, p_n elements,
+ * to *p_acc0 and *p_acc1.
+ */
+static inline void dot2( const int8_t *p_x, const int8_t *p_w0, const int8_t *p_w1,
+                         size_t p_n, int32_t *p_acc0, int32_t *p_acc1 );
+
+/**
+ * @brief Adds the dot product of p_x with p_w, p_n elements, to *p_acc.
+ */
+static inline void dot1( const int8_t *p_x, const int8_t *p_w, size_t p_n, int32_t *p_acc );
+
+/**
+ * @brief The taps [*p_lo, *p_hi) of a window of p_k taps starting at p_start
+ * that are inside an input of p_size.
+ */
+static inline void clip_window( int32_t p_start, size_t p_k, size_t p_size,
+                                size_t *p_lo, size_t *p_hi );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void dsp_nn_quant_init( dsp_nn_quant_t *p_q, float p_scale,
+                        int32_t p_act_min, int32_t p_act_max )
+{
+    int32_t shift = 0;
+
+    /* scale = m * 2^-shift with m in [0.5, 1), without frexpf. */
+    while( p_scale < 0.5f && shift < 31 )
+    {
+        p_scale *= 2.0f;
+        shift++;
+    }
+
+    if( p_scale >= 1.0f )
+    {
+        /* Saturated to the largest scale. */
+        p_q->multiplier = INT32_MAX;
+    }
+    else
+    {
+        int64_t m = ( int64_t )( p_scale * 2147483648.0f + 0.5f );
+        if( m > INT32_MAX )
+        {
+            m = INT32_MAX;
+        }
+        p_q->multiplier = ( int32_t )m;
+    }
+    p_q->shift   = shift;
+    p_q->act_min = p_act_min;
+    p_q->act_max = p_act_max;
+}
+
+int8_t dsp_nn_requant( int32_t p_acc, const dsp_nn_quant_t *p_q )
+{
+    int32_t s = 31 + p_q->shift;
+    int64_t prod = ( int64_t )p_acc * p_q->multiplier;
+    int32_t res = ( int32_t )( ( prod + ( ( int64_t )1 << ( s - 1 ) ) ) >> s );
+
+    if( res < p_q->act_min )
+    {
+        res = p_q->act_min;
+    }
+    if( res > p_q->act_max )
+    {
+        res = p_q->act_max;
+    }
+    return ( int8_t )res;
+}
+
+void dsp_nn_requant_i8( const int32_t *p_acc, int8_t *p_out, size_t p_n,
+                        const dsp_nn_quant_t *p_q )
+{
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        p_out[i] = dsp_nn_requant( p_acc[i], p_q );
+    }
+}
+
+void dsp_nn_conv2d_i8( const dsp_nn_conv_t *p_cfg, const int8_t *p_in,
+                       const int8_t *p_w, const int32_t *p_bias,
+                       const dsp_nn_quant_t *p_q, int8_t *p_out )
+{
+    size_t in_c  = p_cfg->in_c;
+    size_t out_c = p_cfg->out_c;
+    size_t out_h = ( p_cfg->in_h + 2 * p_cfg->pad - p_cfg->k_h ) / p_cfg->stride + 1;
+    size_t out_w = ( p_cfg->in_w + 2 * p_cfg->pad - p_cfg->k_w ) / p_cfg->stride + 1;
+    size_t in_row = p_cfg->in_w * in_c;         /* Bytes of an input row. */
+    size_t k_row  = p_cfg->k_w * in_c;          /* Bytes of a filter row. */
+    size_t k_size = p_cfg->k_h * k_row;         /* Bytes of a filter. */
+
+    for( size_t oy = 0; oy < out_h; oy++ )
+    {
+        int32_t iy = ( int32_t )( oy * p_cfg->stride ) - p_cfg->pad;
+        size_t ky_lo, ky_hi;
+        clip_window( iy, p_cfg->k_h, p_cfg->in_h, &ky_lo, &ky_hi );
+
+        for( size_t ox = 0; ox < out_w; ox++ )
+        {
+            int32_t ix = ( int32_t )( ox * p_cfg->stride ) - p_cfg->pad;
+            size_t kx_lo, kx_hi;
+            clip_window( ix, p_cfg->k_w, p_cfg->in_w, &kx_lo, &kx_hi );
+
+            /* A row of the receptive field: contiguous in the input and in
+             * the filter. */
+            size_t n = ( kx_hi - kx_lo ) * in_c;
+            const int8_t *x = p_in + ( ( iy + ( int32_t )ky_lo ) * p_cfg->in_w
+                                       + ix + ( int32_t )kx_lo ) * in_c;
+            const int8_t *w = p_w + ky_lo * k_row + kx_lo * in_c;
+            size_t oc = 0;
+
+            for( ; oc + 1 < out_c; oc += 2 )
+            {
+                int32_t acc0 = p_bias ? p_bias[oc]     : 0;
+                int32_t acc1 = p_bias ? p_bias[oc + 1] : 0;
+                const int8_t *w0 = w + oc * k_size;
+
+                for( size_t ky = ky_lo; ky < ky_hi; ky++ )
+                {
+                    size_t r = ky - ky_lo;
+                    dot2( x + r * in_row, w0 + r * k_row, w0 + k_size + r * k_row, n,
+                          &acc0, &acc1 );
+                }
+                p_out[oc]     = dsp_nn_requant( acc0, p_q );
+                p_out[oc + 1] = dsp_nn_requant( acc1, p_q );
+            }
+
+            /* The last channel of an odd number of channels. */
+            if( oc < out_c )
+            {
+                int32_t acc = p_bias ? p_bias[oc] : 0;
+                const int8_t *w0 = w + oc * k_size;
+
+                for( size_t ky = ky_lo; ky < ky_hi; ky++ )
+                {
+                    size_t r = ky - ky_lo;
+                    dot1( x + r * in_row, w0 + r * k_row, n, &acc );
+                }
+                p_out[oc] = dsp_nn_requant( acc, p_q );
+            }
+            p_out += out_c;
+        }
+    }
+}
+
+void dsp_nn_dwconv2d_i8( const dsp_nn_conv_t *p_cfg, const int8_t *p_in,
+                         const int8_t *p_w, const int32_t *p_bias,
+                         const dsp_nn_quant_t *p_q, int8_t *p_out )
+{
+    size_t c_n   = p_cfg->in_c;
+    size_t out_h = ( p_cfg->in_h + 2 * p_cfg->pad - p_cfg->k_h ) / p_cfg->stride + 1;
+    size_t out_w = ( p_cfg->in_w + 2 * p_cfg->pad - p_cfg->k_w ) / p_cfg->stride + 1;
+    size_t in_row = p_cfg->in_w * c_n;
+    size_t k_row  = p_cfg->k_w * c_n;
+
+    for( size_t oy = 0; oy < out_h; oy++ )
+    {
+        int32_t iy = ( int32_t )( oy * p_cfg->stride ) - p_cfg->pad;
+        size_t ky_lo, ky_hi;
+        clip_window( iy, p_cfg->k_h, p_cfg->in_h, &ky_lo, &ky_hi );
+
+        for( size_t ox = 0; ox < out_w; ox++ )
+        {
+            int32_t ix = ( int32_t )( ox * p_cfg->stride ) - p_cfg->pad;
+            size_t kx_lo, kx_hi;
+            clip_window( ix, p_cfg->k_w, p_cfg->in_w, &kx_lo, &kx_hi );
+
+            const int8_t *x = p_in + ( ( iy + ( int32_t )ky_lo ) * p_cfg->in_w
+                                       + ix + ( int32_t )kx_lo ) * c_n;
+            const int8_t *w = p_w + ky_lo * k_row + kx_lo * c_n;
+
+            /* The taps of a channel are c_n bytes apart, there is no dot
+             * product to pack: one accumulation per channel. */
+            for( size_t c = 0; c < c_n; c++ )
+            {
+                int32_t acc = p_bias ? p_bias[c] : 0;
+
+                for( size_t ky = ky_lo; ky < ky_hi; ky++ )
+                {
+                    const int8_t *px = x + ( ky - ky_lo ) * in_row + c;
+                    const int8_t *pw = w + ( ky - ky_lo ) * k_row + c;
+
+                    for( size_t kx = kx_lo; kx < kx_hi; kx++ )
+                    {
+                        acc += *px * *pw;
+                        px += c_n;
+                        pw += c_n;
+                    }
+                }
+                p_out[c] = dsp_nn_requant( acc, p_q );
+            }
+            p_out += c_n;
+        }
+    }
+}
+
+void dsp_nn_fc_i8( const int8_t *p_in, size_t p_n_in, const int8_t *p_w,
+                   const int32_t *p_bias, size_t p_n_out,
+                   const dsp_nn_quant_t *p_q, int8_t *p_out )
+{
+    size_t o = 0;
+
+    /* Two outputs at once, each input is loaded once for both. */
+    for( ; o + 1 < p_n_out; o += 2 )
+    {
+        int32_t acc0 = p_bias ? p_bias[o]     : 0;
+        int32_t acc1 = p_bias ? p_bias[o + 1] : 0;
+        const int8_t *w0 = p_w + o * p_n_in;
+
+        dot2( p_in, w0, w0 + p_n_in, p_n_in, &acc0, &acc1 );
+        p_out[o]     = dsp_nn_requant( acc0, p_q );
+        p_out[o + 1] = dsp_nn_requant( acc1, p_q );
+    }
+    if( o < p_n_out )
+    {
+        int32_t acc = p_bias ? p_bias[o] : 0;
+
+        dot1( p_in, p_w + o * p_n_in, p_n_in, &acc );
+        p_out[o] = dsp_nn_requant( acc, p_q );
+    }
+}
+
+void dsp_nn_maxpool_i8( const dsp_nn_pool_t *p_cfg, const int8_t *p_in, int8_t *p_out )
+{
+    size_t c_n   = p_cfg->c;
+    size_t out_h = ( p_cfg->in_h - p_cfg->k ) / p_cfg->stride + 1;
+    size_t out_w = ( p_cfg->in_w - p_cfg->k ) / p_cfg->stride + 1;
+    size_t in_row = p_cfg->in_w * c_n;
+#if DSP_XPULP
+    /* Four channels per word when all the pixels are word aligned. */
+    uint32_t packed = ( c_n % NN_I8_PER_W ) == 0
+                      && ( ( ( uintptr_t )p_in | ( uintptr_t )p_out ) % NN_I8_PER_W ) == 0;
+#endif
+
+    for( size_t oy = 0; oy < out_h; oy++ )
+    {
+        for( size_t ox = 0; ox < out_w; ox++ )
+        {
+            const int8_t *x = p_in + oy * p_cfg->stride * in_row + ox * p_cfg->stride * c_n;
+            size_t c = 0;
+
+#if DSP_XPULP
+            if( packed )
+            {
+                for( ; c < c_n; c += NN_I8_PER_W )
+                {
+                    uint32_t m = *( const uint32_t * )( x + c );
+
+                    for( size_t ky = 0; ky < p_cfg->k; ky++ )
+                    {
+                        const int8_t *px = x + ky * in_row + c;
+
+                        for( size_t kx = 0; kx < p_cfg->k; kx++ )
+                        {
+                            uint32_t v = *( const uint32_t * )px;
+                            SIMD_OP( "cv.max.b", m, m, v );
+                            px += c_n;
+                        }
+                    }
+                    *( uint32_t * )( p_out + c ) = m;
+                }
+            }
+#endif
+            for( ; c < c_n; c++ )
+            {
+                int8_t m = x[c];
+
+                for( size_t ky = 0; ky < p_cfg->k; ky++ )
+                {
+                    const int8_t *px = x + ky * in_row + c;
+
+                    for( size_t kx = 0; kx < p_cfg->k; kx++ )
+                    {
+                        if( *px > m )
+                        {
+                            m = *px;
+                        }
+                        px += c_n;
+                    }
+                }
+                p_out[c] = m;
+            }
+            p_out += c_n;
+        }
+    }
+}
+
+void dsp_nn_avgpool_i8( const dsp_nn_pool_t *p_cfg, const int8_t *p_in, int8_t *p_out )
+{
+    size_t c_n   = p_cfg->c;
+    size_t out_h = ( p_cfg->in_h - p_cfg->k ) / p_cfg->stride + 1;
+    size_t out_w = ( p_cfg->in_w - p_cfg->k ) / p_cfg->stride + 1;
+    size_t in_row = p_cfg->in_w * c_n;
+    int32_t taps = p_cfg->k * p_cfg->k;
+
+    for( size_t oy = 0; oy < out_h; oy++ )
+    {
+        for( size_t ox = 0; ox < out_w; ox++ )
+        {
+            const int8_t *x = p_in + oy * p_cfg->stride * in_row + ox * p_cfg->stride * c_n;
+
+            for( size_t c = 0; c < c_n; c++ )
+            {
+                int32_t sum = 0;
+
+                for( size_t ky = 0; ky < p_cfg->k; ky++ )
+                {
+                    const int8_t *px = x + ky * in_row + c;
+
+                    for( size_t kx = 0; kx < p_cfg->k; kx++ )
+                    {
+                        sum += *px;
+                        px += c_n;
+                    }
+                }
+                /* Rounded half away from zero. */
+                p_out[c] = ( int8_t )( sum >= 0 ? ( sum + taps / 2 ) / taps
+                                                : -( ( -sum + taps / 2 ) / taps ) );
+            }
+            p_out += c_n;
+        }
+    }
+}
+
+size_t dsp_nn_argmax_i8( const int8_t *p_x, size_t p_n )
+{
+    size_t best = 0;
+
+    for( size_t i = 1; i < p_n; i++ )
+    {
+        if( p_x[i] > p_x[best] )
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static inline void dot2( const int8_t *p_x, const int8_t *p_w0, const int8_t *p_w1,
+                         size_t p_n, int32_t *p_acc0, int32_t *p_acc1 )
+{
+    int32_t acc0 = *p_acc0;
+    int32_t acc1 = *p_acc1;
+
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n / NN_I8_PER_W; i++ )
+    {
+        uint32_t x, w0, w1;
+        LOAD_PI( x, p_x );
+        LOAD_PI( w0, p_w0 );
+        LOAD_PI( w1, p_w1 );
+        SIMD_ACC( "cv.sdotsp.b", acc0, x, w0 );
+        SIMD_ACC( "cv.sdotsp.b", acc1, x, w1 );
+    }
+    p_n %= NN_I8_PER_W;
+#endif
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        int32_t x = p_x[i];
+        acc0 += x * p_w0[i];
+        acc1 += x * p_w1[i];
+    }
+
+    *p_acc0 = acc0;
+    *p_acc1 = acc1;
+}
+
+static inline void dot1( const int8_t *p_x, const int8_t *p_w, size_t p_n, int32_t *p_acc )
+{
+    int32_t acc = *p_acc;
+
+#if DSP_XPULP
+    for( size_t i = 0; i < p_n / NN_I8_PER_W; i++ )
+    {
+        uint32_t x, w;
+        LOAD_PI( x, p_x );
+        LOAD_PI( w, p_w );
+        SIMD_ACC( "cv.sdotsp.b", acc, x, w );
+    }
+    p_n %= NN_I8_PER_W;
+#endif
+    for( size_t i = 0; i < p_n; i++ )
+    {
+        acc += p_x[i] * p_w[i];
+    }
+
+    *p_acc = acc;
+}
+
+static inline void clip_window( int32_t p_start, size_t p_k, size_t p_size,
+                                size_t *p_lo, size_t *p_hi )
+{
+    int32_t lo = p_start < 0 ? -p_start : 0;
+    int32_t hi = ( int32_t )p_size - p_start;
+
+    if( hi > ( int32_t )p_k )
+    {
+        hi = ( int32_t )p_k;
+    }
+    if( hi < lo )
+    {
+        hi = lo;
+    }
+    *p_lo = ( size_t )lo;
+    *p_hi = ( size_t )hi;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,207 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_nn.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_nn.h
+* @date   14/10/26
+* @brief  8-bit integer neural network kernels: 2D convolution, depthwise
+* convolution, fully connected layer, max and average pooling, and the
+* requantization of their 32-bit accumulations.
+*
+* The quantization is symmetric: the activations and the weights are int8
+* with a zero point of 0, the biases are int32 in the scale of the
+* accumulations (input scale * weight scale). Each layer brings its
+* accumulations back to int8 with a dsp_nn_quant_t: a Q31 multiplier and a
+* right shift, rounded to nearest, then clamped to the range of the activation
+* (e.g. 0..127 for a ReLU).
+*
+* The feature maps are stored height x width x channels (HWC): the channels of
+* a pixel follow each other. The convolution filters are out_c x k_h x k_w x
+* in_c, so that a row of the receptive field of an output is contiguous in
+* both the input and the filter. The convolution computes these rows as dot
+* products in place, without copying the receptive fields to a buffer
+* (im2col), and two output channels at once, so that the input is loaded once
+* for both. The zero padding is not stored: the taps outside of the input are
+* skipped.
+*
+* With the Xpulp extensions (see dsp.h) the dot products take four int8 pairs
+* per instruction (cv.sdotsp.b) and the max pooling four channels (cv.max.b).
+* The rows are word aligned when in_c is a multiple of 4 and the buffers are
+* word aligned, otherwise the loads are split by the core and slower. The
+* results are the same as with the portable versions.
+*/
+
+#ifndef _DSP_NN_H
+#define _DSP_NN_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Requantization of the accumulations of a layer:
+ * out = clamp( round( acc * multiplier / 2^(31 + shift) ), act_min, act_max ).
+ */
+typedef struct
+{
+    int32_t multiplier; /*!< Q31 fraction of the scale, in [2^30, 2^31). */
+    int32_t shift;      /*!< Right shift of the scale, 0 to 31. */
+    int32_t act_min;    /*!< Range of the output, within -128..127. */
+    int32_t act_max;
+} dsp_nn_quant_t;
+
+/**
+ * A convolution. The output is out_h x out_w x out_c with
+ * out_h = ( in_h + 2 * pad - k_h ) / stride + 1, and the same for out_w.
+ */
+typedef struct
+{
+    uint16_t    in_h;
+    uint16_t    in_w;
+    uint16_t    in_c;
+    uint16_t    out_c;      /*!< Equal to in_c for a depthwise convolution. */
+    uint8_t     k_h;
+    uint8_t     k_w;
+    uint8_t     stride;
+    uint8_t     pad;        /*!< Zero padding on each side. */
+} dsp_nn_conv_t;
+
+/**
+ * A pooling over k x k windows, without padding. The output is
+ * out_h x out_w x c with out_h = ( in_h - k ) / stride + 1.
+ */
+typedef struct
+{
+    uint16_t    in_h;
+    uint16_t    in_w;
+    uint16_t    c;
+    uint8_t     k;
+    uint8_t     stride;
+} dsp_nn_pool_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Computes the multiplier and shift of a scale.
+ * @param p_q The requantization to fill.
+ * @param p_scale The scale from the accumulations to the output,
+ * input scale * weight scale / output scale, in (2^-31, 1).
+ * @param p_act_min Range of the output, e.g. -128 and 127, or 0 and 127 for
+ * a ReLU.
+ * @param p_act_max
+ */
+void dsp_nn_quant_init( dsp_nn_quant_t *p_q, float p_scale,
+                        int32_t p_act_min, int32_t p_act_max );
+
+/**
+ * @brief Requantizes one accumulation.
+ */
+int8_t dsp_nn_requant( int32_t p_acc, const dsp_nn_quant_t *p_q );
+
+/**
+ * @brief Requantizes p_n accumulations to p_out.
+ */
+void dsp_nn_requant_i8( const int32_t *p_acc, int8_t *p_out, size_t p_n,
+                        const dsp_nn_quant_t *p_q );
+
+/**
+ * @brief 2D convolution of an HWC feature map.
+ * @param p_cfg The dimensions.
+ * @param p_in The input, in_h x in_w x in_c.
+ * @param p_w The filters, out_c x k_h x k_w x in_c.
+ * @param p_bias The out_c biases, or NULL.
+ * @param p_q The requantization of the output.
+ * @param p_out The output, out_h x out_w x out_c. It must not overlap the
+ * input.
+ */
+void dsp_nn_conv2d_i8( const dsp_nn_conv_t *p_cfg, const int8_t *p_in,
+                       const int8_t *p_w, const int32_t *p_bias,
+                       const dsp_nn_quant_t *p_q, int8_t *p_out );
+
+/**
+ * @brief Depthwise 2D convolution of an HWC feature map: each channel is
+ * convolved with its own filter (out_c is ignored, it is in_c).
+ * @param p_w The filters, k_h x k_w x in_c.
+ * @param p_bias The in_c biases, or NULL.
+ * The other parameters are those of dsp_nn_conv2d_i8().
+ */
+void dsp_nn_dwconv2d_i8( const dsp_nn_conv_t *p_cfg, const int8_t *p_in,
+                         const int8_t *p_w, const int32_t *p_bias,
+                         const dsp_nn_quant_t *p_q, int8_t *p_out );
+
+/**
+ * @brief Fully connected layer: p_out[o] = requant( bias[o] + the dot product
+ * of p_in with the row o of p_w ).
+ * @param p_in The p_n_in inputs, e.g. a flattened HWC feature map.
+ * @param p_w The weights, p_n_out x p_n_in.
+ * @param p_bias The p_n_out biases, or NULL.
+ */
+void dsp_nn_fc_i8( const int8_t *p_in, size_t p_n_in, const int8_t *p_w,
+                   const int32_t *p_bias, size_t p_n_out,
+                   const dsp_nn_quant_t *p_q, int8_t *p_out );
+
+/**
+ * @brief Max pooling of an HWC feature map.
+ */
+void dsp_nn_maxpool_i8( const dsp_nn_pool_t *p_cfg, const int8_t *p_in, int8_t *p_out );
+
+/**
+ * @brief Average pooling of an HWC feature map, rounded to nearest. A window
+ * over the whole input (k = in_h = in_w) is a global average pooling.
+ */
+void dsp_nn_avgpool_i8( const dsp_nn_pool_t *p_cfg, const int8_t *p_in, int8_t *p_out );
+
+/**
+ * @brief Index of the largest of p_n > 0 values, the first one on a tie.
+ */
+size_t dsp_nn_argmax_i8( const int8_t *p_x, size_t p_n );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DSP_NN_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,117 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dsp_xpulp.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dsp_xpulp.h
+* @date   14/10/26
+* @brief  Inline assembly of the Xpulp instructions used by the kernels of the
+* DSP library. Only included by its sources.
+*/
+
+#ifndef _DSP_XPULP_H
+#define _DSP_XPULP_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dsp.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+#if DSP_XPULP
+
+/**
+ * Loads a word and moves the pointer to the next one (cv.lw post-increment).
+ */
+#define LOAD_PI( val, ptr ) \
+    asm volatile( "cv.lw %0, (%1), 4" : "=r"( val ), "+r"( ptr ) : : "memory" )
+
+/**
+ * Stores a word and moves the pointer to the next one (cv.sw post-increment).
+ */
+#define STORE_PI( val, ptr ) \
+    asm volatile( "cv.sw %1, (%0), 4" : "+r"( ptr ) : "r"( val ) : "memory" )
+
+/**
+ * Loads a word and moves the pointer by stride bytes (cv.lw register
+ * post-increment), e.g. down a column of a matrix.
+ */
+#define LOAD_PI_STRIDE( val, ptr, stride ) \
+    asm volatile( "cv.lw %0, (%1), %2" : "=r"( val ), "+r"( ptr ) : "r"( stride ) : "memory" )
+
+/**
+ * Packed-SIMD operation res = x op y, on two half words or four bytes.
+ */
+#define SIMD_OP( op, res, x, y ) \
+    asm( op " %0, %1, %2" : "=r"( res ) : "r"( x ), "r"( y ) )
+
+/**
+ * Accumulating operation acc += x op y (cv.mac and the dot products).
+ */
+#define SIMD_ACC( op, acc, x, y ) \
+    asm( op " %0, %1, %2" : "+r"( acc ) : "r"( x ), "r"( y ) )
+
+/**
+ * Applies a packed-SIMD operation to p_n_w words of the a and b vectors and
+ * stores the results in c. The pointers are left after the last word.
+ */
+#define SIMD_LOOP( op, a, b, c, p_n_w )         \
+    for( size_t w = 0; w < ( p_n_w ); w++ )     \
+    {                                           \
+        uint32_t x, y, res;                     \
+        LOAD_PI( x, a );                        \
+        LOAD_PI( y, b );                        \
+        SIMD_OP( op, res, x, y );               \
+        STORE_PI( res, c );                     \
+    }
+
+/**
+ * Complex multiplication res = x * y / 2 of two Q15 complex numbers packed
+ * as {real, imaginary} in the low and high half words.
+ */
+#define CPLX_MUL_DIV2( res, x, y )                                              \
+    do                                                                          \
+    {                                                                           \
+        asm( "cv.cplxmul.r.div2 %0, %1, %2" : "+r"( res ) : "r"( x ), "r"( y ) );\
+        asm( "cv.cplxmul.i.div2 %0, %1, %2" : "+r"( res ) : "r"( x ), "r"( y ) );\
+    } while( 0 )
+
+/**
+ * Saturates val to a signed integer of bits bits (cv.clip).
+ */
+#define CLIP( res, val, bits ) \
+    asm( "cv.clip %0, %1, %2" : "=r"( res ) : "r"( val ), "i"( bits ) )
+
+#endif // DSP_XPULP
+
+#endif /* _DSP_XPULP_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
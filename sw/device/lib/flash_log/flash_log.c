@@ -0,0 +1,498 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : flash_log.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   flash_log.c
+* @date   14/10/26
+* @brief  Append-only log of records in a region of a SPI NOR flash.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "flash_log.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define PAGES_PER_SECTOR    ( FLASH_LOG_SECTOR_SIZE / SPI_FLASH_PAGE_SIZE )
+
+/**
+ * Keeps the writes to a page before the one of the counter that hands it
+ * over to flash_log_poll, which may run in another context.
+ */
+#define LOG_BARRIER()       asm volatile( "" ::: "memory" )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Completes the ongoing flash operation of the log, if any.
+ * @param p_wait Whether to wait for it.
+ */
+static flash_log_result_t log_complete( flash_log_t *p_log, bool p_wait );
+
+/**
+ * @brief Hands the page being filled over to flash_log_poll.
+ */
+static void log_close_page( flash_log_t *p_log );
+
+/**
+ * @brief Reads the header of a page.
+ * @return Whether the page holds records.
+ */
+static bool log_read_header( flash_log_t          *p_log,
+                             uint32_t             p_addr,
+                             flash_log_page_hdr_t *p_hdr );
+
+/**
+ * @brief Finds the last page of a sector, from its first one, holding
+ * records that start at p_number or before.
+ * @return The address of the page.
+ */
+static uint32_t log_find_page( flash_log_t *p_log,
+                               uint32_t    p_sector,
+                               uint32_t    p_number );
+
+/**
+ * @brief Wraps an address around the end of the region.
+ */
+static uint32_t log_wrap( flash_log_t *p_log, uint32_t p_addr );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+flash_log_result_t flash_log_init( flash_log_t           *p_log,
+                                   spi_flash_t           *p_flash,
+                                   const flash_log_cfg_t *p_cfg )
+{
+    if( p_cfg->base % FLASH_LOG_SECTOR_SIZE != 0
+        || p_cfg->size % FLASH_LOG_SECTOR_SIZE != 0
+        || p_cfg->size < 2 * FLASH_LOG_SECTOR_SIZE
+        || p_cfg->size > SPI_FLASH_MAX_ADDR + 1 - p_cfg->base
+        || p_cfg->pages == NULL || ( (uint32_t)p_cfg->pages & 3 ) != 0
+        || p_cfg->n_pages < 2 || p_cfg->index == NULL )
+    {
+        return FLASH_LOG_ERROR;
+    }
+
+    memset( p_log, 0, sizeof( flash_log_t ) );
+    p_log->flash     = p_flash;
+    p_log->cfg       = *p_cfg;
+    p_log->n_sectors = p_cfg->size / FLASH_LOG_SECTOR_SIZE;
+    p_log->op        = SPI_FLASH_OP_NONE;
+
+    /* The written sector of the newest page is the head of the log. */
+    flash_log_page_hdr_t hdr;
+    uint32_t head = p_log->n_sectors;
+    uint32_t head_seq = 0;
+    for( uint32_t s = 0; s < p_log->n_sectors; s++ )
+    {
+        uint32_t addr = p_cfg->base + s * FLASH_LOG_SECTOR_SIZE;
+        if( spi_flash_read( p_flash, addr, &hdr, sizeof( hdr ) )
+            != SPI_FLASH_OK )
+        {
+            return FLASH_LOG_ERROR_FLASH;
+        }
+        p_cfg->index[ s ] = FLASH_LOG_NO_RECORD;
+        if( hdr.magic == FLASH_LOG_MAGIC )
+        {
+            p_cfg->index[ s ] = hdr.first;
+            if( head == p_log->n_sectors || hdr.seq > head_seq )
+            {
+                head = s;
+                head_seq = hdr.seq;
+            }
+        }
+    }
+
+    if( head == p_log->n_sectors )
+    {
+        /* Nothing is known to be erased, poll starts with an erase. */
+        p_log->write_addr = p_cfg->base;
+        return FLASH_LOG_OK;
+    }
+
+    uint32_t addr = log_find_page( p_log, head, FLASH_LOG_NO_RECORD - 1 );
+    if( !log_read_header( p_log, addr, &hdr ) )
+    {
+        return FLASH_LOG_ERROR_FLASH;
+    }
+    p_log->next_record = hdr.first + hdr.count;
+    p_log->end_record  = p_log->next_record;
+    p_log->next_seq    = hdr.seq + 1;
+
+    /* The pages after the newest one in its sector were left erased. */
+    addr += SPI_FLASH_PAGE_SIZE;
+    p_log->erased = FLASH_LOG_SECTOR_SIZE - addr % FLASH_LOG_SECTOR_SIZE;
+    if( p_log->erased == FLASH_LOG_SECTOR_SIZE )
+    {
+        p_log->erased = 0;
+    }
+    p_log->write_addr = log_wrap( p_log, addr );
+
+    return FLASH_LOG_OK;
+}
+
+flash_log_result_t flash_log_format( flash_log_t *p_log )
+{
+    log_complete( p_log, true );
+
+    for( uint32_t s = 0; s < p_log->n_sectors; s++ )
+    {
+        p_log->cfg.index[ s ] = FLASH_LOG_NO_RECORD;
+        if( spi_flash_erase( p_log->flash, SPI_FLASH_ERASE_4K,
+                             p_log->cfg.base + s * FLASH_LOG_SECTOR_SIZE )
+            != SPI_FLASH_OK )
+        {
+            p_log->erased = 0;
+            return FLASH_LOG_ERROR_FLASH;
+        }
+    }
+
+    p_log->fill_page   = 0;
+    p_log->fill        = 0;
+    p_log->next_record = 0;
+    p_log->next_seq    = 0;
+    p_log->closed      = 0;
+    p_log->dropped     = 0;
+    p_log->prog_page   = 0;
+    p_log->programmed  = 0;
+    p_log->write_addr  = p_log->cfg.base;
+    p_log->erased      = p_log->cfg.size;
+    p_log->end_record  = 0;
+
+    return FLASH_LOG_OK;
+}
+
+flash_log_result_t flash_log_append( flash_log_t *p_log,
+                                     const void  *p_data,
+                                     uint16_t    p_len,
+                                     uint32_t    *p_number )
+{
+    if( p_len > FLASH_LOG_RECORD_MAX )
+    {
+        return FLASH_LOG_ERROR;
+    }
+
+    if( p_log->fill + 2 + p_len > FLASH_LOG_PAGE_DATA )
+    {
+        log_close_page( p_log );
+    }
+
+    flash_log_page_t *page = &p_log->cfg.pages[ p_log->fill_page ];
+    if( p_log->fill == 0 )
+    {
+        if( p_log->closed - p_log->programmed >= p_log->cfg.n_pages )
+        {
+            p_log->dropped++;
+            return FLASH_LOG_FULL;
+        }
+        page->hdr.count = 0;
+        page->hdr.first = p_log->next_record;
+    }
+
+    memcpy( &page->data[ p_log->fill ], &p_len, 2 );
+    memcpy( &page->data[ p_log->fill + 2 ], p_data, p_len );
+    p_log->fill += 2 + p_len;
+    page->hdr.count++;
+    if( p_number != NULL )
+    {
+        *p_number = p_log->next_record;
+    }
+    p_log->next_record++;
+
+    return FLASH_LOG_OK;
+}
+
+flash_log_result_t flash_log_poll( flash_log_t *p_log )
+{
+    flash_log_result_t res = log_complete( p_log, false );
+    if( res != FLASH_LOG_OK )
+    {
+        return res;
+    }
+
+    bool pending = p_log->closed != p_log->programmed;
+    spi_flash_result_t flash_res = SPI_FLASH_OK;
+
+    if( pending && p_log->erased >= SPI_FLASH_PAGE_SIZE )
+    {
+        flash_res = spi_flash_program_async( p_log->flash, p_log->write_addr,
+                                             &p_log->cfg.pages[ p_log->prog_page ],
+                                             SPI_FLASH_PAGE_SIZE, NULL );
+        p_log->op = SPI_FLASH_OP_PROGRAM;
+    }
+    /* The next sector is erased as soon as the current one is being
+     * written, when the flash has no page to program, so that the erases
+     * mostly happen in the gaps of the capture. It holds the oldest
+     * records. */
+    else if( p_log->erased < FLASH_LOG_SECTOR_SIZE )
+    {
+        uint32_t addr = log_wrap( p_log, p_log->write_addr + p_log->erased );
+        p_log->cfg.index[ ( addr - p_log->cfg.base )
+                          / FLASH_LOG_SECTOR_SIZE ] = FLASH_LOG_NO_RECORD;
+        flash_res = spi_flash_erase_async( p_log->flash, SPI_FLASH_ERASE_4K,
+                                           addr, NULL );
+        p_log->op = SPI_FLASH_OP_ERASE;
+    }
+    else
+    {
+        return FLASH_LOG_OK;
+    }
+
+    if( flash_res != SPI_FLASH_OK )
+    {
+        p_log->op = SPI_FLASH_OP_NONE;
+        return FLASH_LOG_ERROR_FLASH;
+    }
+    return FLASH_LOG_BUSY;
+}
+
+flash_log_result_t flash_log_flush( flash_log_t *p_log )
+{
+    if( p_log->fill > 0 )
+    {
+        log_close_page( p_log );
+    }
+
+    flash_log_result_t res;
+    while( ( res = flash_log_poll( p_log ) ) == FLASH_LOG_BUSY );
+    return res;
+}
+
+flash_log_result_t flash_log_read( flash_log_t *p_log,
+                                   uint32_t    p_number,
+                                   void        *p_data,
+                                   uint16_t    p_size,
+                                   uint16_t    *p_len )
+{
+    if( log_complete( p_log, true ) != FLASH_LOG_OK )
+    {
+        return FLASH_LOG_ERROR_FLASH;
+    }
+    if( p_number >= p_log->end_record )
+    {
+        return FLASH_LOG_NOT_FOUND;
+    }
+
+    /* The sector that starts with the closest record before p_number. */
+    uint32_t sector = p_log->n_sectors;
+    for( uint32_t s = 0; s < p_log->n_sectors; s++ )
+    {
+        uint32_t first = p_log->cfg.index[ s ];
+        if( first != FLASH_LOG_NO_RECORD && first <= p_number
+            && ( sector == p_log->n_sectors
+                 || first > p_log->cfg.index[ sector ] ) )
+        {
+            sector = s;
+        }
+    }
+    if( sector == p_log->n_sectors )
+    {
+        return FLASH_LOG_NOT_FOUND;
+    }
+
+    flash_log_page_t page;
+    uint32_t addr = log_find_page( p_log, sector, p_number );
+    if( spi_flash_read( p_log->flash, addr, &page, sizeof( page ) )
+        != SPI_FLASH_OK )
+    {
+        return FLASH_LOG_ERROR_FLASH;
+    }
+    if( page.hdr.magic != FLASH_LOG_MAGIC
+        || p_number - page.hdr.first >= page.hdr.count )
+    {
+        return FLASH_LOG_NOT_FOUND;
+    }
+
+    uint32_t offset = 0;
+    uint16_t len;
+    for( uint32_t r = page.hdr.first; ; r++ )
+    {
+        memcpy( &len, &page.data[ offset ], 2 );
+        if( len > FLASH_LOG_PAGE_DATA - 2 - offset )
+        {
+            return FLASH_LOG_NOT_FOUND;
+        }
+        if( r == p_number )
+        {
+            break;
+        }
+        offset += 2 + len;
+    }
+
+    memcpy( p_data, &page.data[ offset + 2 ], ( len < p_size ) ? len : p_size );
+    if( p_len != NULL )
+    {
+        *p_len = len;
+    }
+    return FLASH_LOG_OK;
+}
+
+void flash_log_range( flash_log_t *p_log,
+                      uint32_t    *p_first,
+                      uint32_t    *p_end )
+{
+    uint32_t first = p_log->end_record;
+    for( uint32_t s = 0; s < p_log->n_sectors; s++ )
+    {
+        if( p_log->cfg.index[ s ] < first )
+        {
+            first = p_log->cfg.index[ s ];
+        }
+    }
+    *p_first = first;
+    *p_end   = p_log->end_record;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static flash_log_result_t log_complete( flash_log_t *p_log, bool p_wait )
+{
+    if( p_log->op == SPI_FLASH_OP_NONE )
+    {
+        return FLASH_LOG_OK;
+    }
+
+    spi_flash_result_t res = p_wait ? spi_flash_wait( p_log->flash )
+                                    : spi_flash_poll( p_log->flash );
+    if( res == SPI_FLASH_BUSY )
+    {
+        return FLASH_LOG_BUSY;
+    }
+
+    spi_flash_op_t op = p_log->op;
+    p_log->op = SPI_FLASH_OP_NONE;
+    if( res != SPI_FLASH_OK )
+    {
+        /* The page is programmed again, or the sector erased again. */
+        return FLASH_LOG_ERROR_FLASH;
+    }
+
+    if( op == SPI_FLASH_OP_ERASE )
+    {
+        p_log->erased += FLASH_LOG_SECTOR_SIZE;
+        return FLASH_LOG_OK;
+    }
+
+    flash_log_page_t *page = &p_log->cfg.pages[ p_log->prog_page ];
+    if( p_log->write_addr % FLASH_LOG_SECTOR_SIZE == 0 )
+    {
+        p_log->cfg.index[ ( p_log->write_addr - p_log->cfg.base )
+                          / FLASH_LOG_SECTOR_SIZE ] = page->hdr.first;
+    }
+    p_log->end_record = page->hdr.first + page->hdr.count;
+    p_log->write_addr = log_wrap( p_log,
+                                  p_log->write_addr + SPI_FLASH_PAGE_SIZE );
+    p_log->erased -= SPI_FLASH_PAGE_SIZE;
+
+    p_log->prog_page = ( p_log->prog_page + 1 == p_log->cfg.n_pages )
+                       ? 0 : p_log->prog_page + 1;
+    LOG_BARRIER();
+    p_log->programmed++;
+
+    return FLASH_LOG_OK;
+}
+
+static void log_close_page( flash_log_t *p_log )
+{
+    flash_log_page_t *page = &p_log->cfg.pages[ p_log->fill_page ];
+    page->hdr.magic = FLASH_LOG_MAGIC;
+    page->hdr.seq   = p_log->next_seq++;
+    /* The rest of the page stays erased in flash. */
+    memset( &page->data[ p_log->fill ], 0xFF,
+            FLASH_LOG_PAGE_DATA - p_log->fill );
+
+    p_log->fill = 0;
+    p_log->fill_page = ( p_log->fill_page + 1 == p_log->cfg.n_pages )
+                       ? 0 : p_log->fill_page + 1;
+    LOG_BARRIER();
+    p_log->closed++;
+}
+
+static bool log_read_header( flash_log_t          *p_log,
+                             uint32_t             p_addr,
+                             flash_log_page_hdr_t *p_hdr )
+{
+    if( spi_flash_read( p_log->flash, p_addr, p_hdr, sizeof( *p_hdr ) )
+        != SPI_FLASH_OK )
+    {
+        return false;
+    }
+    return p_hdr->magic == FLASH_LOG_MAGIC;
+}
+
+static uint32_t log_find_page( flash_log_t *p_log,
+                               uint32_t    p_sector,
+                               uint32_t    p_number )
+{
+    /* The pages of a sector are written in order, so the ones that match
+     * come first. The first page is known to match. */
+    uint32_t base = p_log->cfg.base + p_sector * FLASH_LOG_SECTOR_SIZE;
+    uint32_t lo = 0;
+    uint32_t hi = PAGES_PER_SECTOR;
+    flash_log_page_hdr_t hdr;
+    while( hi - lo > 1 )
+    {
+        uint32_t mid = ( lo + hi ) / 2;
+        if( log_read_header( p_log, base + mid * SPI_FLASH_PAGE_SIZE, &hdr )
+            && hdr.first <= p_number )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return base + lo * SPI_FLASH_PAGE_SIZE;
+}
+
+static uint32_t log_wrap( flash_log_t *p_log, uint32_t p_addr )
+{
+    return ( p_addr >= p_log->cfg.base + p_log->cfg.size )
+           ? p_addr - p_log->cfg.size : p_addr;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,272 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : flash_log.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   flash_log.h
+* @date   14/10/26
+* @brief  Append-only log of records in a region of a SPI NOR flash.
+*
+* The records are numbered from 0 in the order they are appended. They are
+* packed in RAM pages, which are programmed whole by spi_flash_program_async
+* once full, so that the capture only copies the records: flash_log_append
+* never waits for the flash and can be called from an interrupt handler (or
+* a DMA callback), while flash_log_poll, called from the main loop, programs
+* the full pages and erases the sectors ahead of them. There is one producer
+* and one consumer of the pages, so they need no lock. When all the pages are
+* full, the new records are dropped and counted. The more pages, the longer
+* the erase of a sector (tens of ms) that the capture can outlast.
+*
+* The region is used as a ring of 4KB sectors: when it is full, the sector of
+* the oldest records is erased before being written again, so all the sectors
+* wear at the same rate and each is erased once per turn. Every page starts
+* with a header holding the number of its first record, so the log is
+* rebuilt from the flash by flash_log_init, and a record is found by
+* flash_log_read from the first record number of each sector, kept in a RAM
+* index of one word per sector, then by a binary search among the pages of
+* the sector.
+*
+* A record does not span two pages: it is at most FLASH_LOG_RECORD_MAX bytes.
+*/
+
+#ifndef _FLASH_LOG_H_
+#define _FLASH_LOG_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spi_flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The unit of the erases, and of the ring.
+ */
+#define FLASH_LOG_SECTOR_SIZE       4096
+
+/**
+ * The bytes of a page after its header.
+ */
+#define FLASH_LOG_PAGE_DATA         ( SPI_FLASH_PAGE_SIZE \
+                                      - sizeof( flash_log_page_hdr_t ) )
+
+/**
+ * The largest record, after its 2-byte length.
+ */
+#define FLASH_LOG_RECORD_MAX        ( FLASH_LOG_PAGE_DATA - 2 )
+
+/**
+ * The first half-word of the written pages.
+ */
+#define FLASH_LOG_MAGIC             0x4C47
+
+/**
+ * The entries of the index for the sectors that hold no record.
+ */
+#define FLASH_LOG_NO_RECORD         0xFFFFFFFF
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The results of the functions.
+ */
+typedef enum
+{
+    FLASH_LOG_OK            = 0,    /*!< Done. */
+    FLASH_LOG_BUSY          = 1,    /*!< Pages are still to be programmed. */
+    FLASH_LOG_FULL          = 2,    /*!< All the RAM pages are full, the
+    record is dropped. */
+    FLASH_LOG_NOT_FOUND     = 3,    /*!< The record was overwritten or is
+    not programmed yet. */
+    FLASH_LOG_ERROR         = 4,    /*!< Wrong parameters. */
+    FLASH_LOG_ERROR_FLASH   = 5,    /*!< The flash driver failed. */
+} flash_log_result_t;
+
+/**
+ * The header of a page in flash.
+ */
+typedef struct
+{
+    uint16_t    magic;      /*!< FLASH_LOG_MAGIC, 0xFFFF if erased. */
+    uint16_t    count;      /*!< The number of records in the page. */
+    uint32_t    seq;        /*!< The number of the page since the format. */
+    uint32_t    first;      /*!< The number of its first record. */
+} flash_log_page_hdr_t;
+
+/**
+ * A page, as in flash.
+ */
+typedef struct
+{
+    flash_log_page_hdr_t    hdr;
+    uint8_t                 data[ SPI_FLASH_PAGE_SIZE
+                                  - sizeof( flash_log_page_hdr_t ) ];
+} flash_log_page_t;
+
+/**
+ * The configuration of a log.
+ */
+typedef struct
+{
+    uint32_t            base;       /*!< The first address of the region, at
+    a sector boundary. */
+    uint32_t            size;       /*!< The size of the region, a multiple of
+    FLASH_LOG_SECTOR_SIZE, of at least two sectors. */
+    flash_log_page_t    *pages;     /*!< The RAM pages, word aligned for the
+    DMA. */
+    uint8_t             n_pages;    /*!< Their number, at least 2. */
+    uint32_t            *index;     /*!< One word per sector of the region. */
+} flash_log_cfg_t;
+
+/**
+ * A log. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    spi_flash_t         *flash;
+    flash_log_cfg_t     cfg;
+    uint32_t            n_sectors;
+    /* Producer side, flash_log_append. */
+    uint8_t             fill_page;  /*!< The page being filled. */
+    uint16_t            fill;       /*!< Its bytes of records. */
+    uint32_t            next_record;
+    uint32_t            next_seq;
+    volatile uint32_t   closed;     /*!< The pages completed so far. */
+    volatile uint32_t   dropped;    /*!< The records dropped so far. */
+    /* Consumer side, flash_log_poll. */
+    uint8_t             prog_page;  /*!< The next page to program. */
+    volatile uint32_t   programmed; /*!< The pages programmed so far. */
+    uint32_t            write_addr; /*!< The address of the next page. */
+    uint32_t            erased;     /*!< The bytes known to be erased from
+    write_addr on. */
+    uint32_t            end_record; /*!< The first record not in flash. */
+    spi_flash_op_t      op;         /*!< The ongoing flash operation. */
+} flash_log_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Opens the log of a region, finding its records from the page
+ * headers. The pages of a region that is not a log (or was never erased)
+ * are taken as empty, and overwritten as the log grows.
+ * @param p_log The log, it must stay in memory while it is used.
+ * @param p_flash The flash, initialized by spi_flash_init.
+ * @param p_cfg The configuration, copied. The pages and the index must stay
+ * in memory.
+ * @return FLASH_LOG_OK, FLASH_LOG_ERROR if the configuration is wrong, or
+ * FLASH_LOG_ERROR_FLASH.
+ */
+flash_log_result_t flash_log_init( flash_log_t           *p_log,
+                                   spi_flash_t           *p_flash,
+                                   const flash_log_cfg_t *p_cfg );
+
+/**
+ * @brief Erases the whole region, blocking, and empties the log.
+ * @return FLASH_LOG_OK or FLASH_LOG_ERROR_FLASH.
+ */
+flash_log_result_t flash_log_format( flash_log_t *p_log );
+
+/**
+ * @brief Appends a record to the RAM page being filled, without accessing
+ * the flash.
+ * @param p_data The record.
+ * @param p_len Its size, up to FLASH_LOG_RECORD_MAX.
+ * @param p_number Its number, if not NULL.
+ * @return FLASH_LOG_OK, FLASH_LOG_FULL if there is no free page, or
+ * FLASH_LOG_ERROR if the record is too large.
+ */
+flash_log_result_t flash_log_append( flash_log_t *p_log,
+                                     const void  *p_data,
+                                     uint16_t    p_len,
+                                     uint32_t    *p_number );
+
+/**
+ * @brief Advances the programming of the full pages and the erases ahead of
+ * them, without blocking.
+ * @return FLASH_LOG_BUSY while there are full pages or a flash operation,
+ * FLASH_LOG_OK otherwise, or FLASH_LOG_ERROR_FLASH if the flash driver
+ * refused an operation, which is tried again at the next call.
+ */
+flash_log_result_t flash_log_poll( flash_log_t *p_log );
+
+/**
+ * @brief Closes the page being filled, even if not full, and programs all
+ * the pages, blocking. It must not run at the same time as
+ * flash_log_append.
+ * @return FLASH_LOG_OK or FLASH_LOG_ERROR_FLASH.
+ */
+flash_log_result_t flash_log_flush( flash_log_t *p_log );
+
+/**
+ * @brief Reads a record back from the flash, blocking. The ongoing flash
+ * operation of the log is completed first.
+ * @param p_number The number of the record.
+ * @param p_data The buffer.
+ * @param p_size Its size: the end of a longer record is not copied.
+ * @param p_len The size of the record, if not NULL.
+ * @return FLASH_LOG_OK, FLASH_LOG_NOT_FOUND, or FLASH_LOG_ERROR_FLASH.
+ */
+flash_log_result_t flash_log_read( flash_log_t *p_log,
+                                   uint32_t    p_number,
+                                   void        *p_data,
+                                   uint16_t    p_size,
+                                   uint16_t    *p_len );
+
+/**
+ * @brief Gives the numbers of the records that can be read back.
+ * @param p_first The oldest record in flash.
+ * @param p_end The record after the newest one in flash.
+ */
+void flash_log_range( flash_log_t *p_log,
+                      uint32_t    *p_first,
+                      uint32_t    *p_end );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _FLASH_LOG_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,580 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : fmt.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   fmt.c
+* @date   14/10/26
+* @brief  Compact printf-style formatting of integers, characters and
+* strings.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "fmt.h"
+
+#include <unistd.h>
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define STDOUT_FILENO_      1
+
+/**
+ * The flags of a conversion.
+ */
+#define FLAG_LEFT           0x01
+#define FLAG_ZERO           0x02
+#define FLAG_PLUS           0x04
+#define FLAG_SPACE          0x08
+#define FLAG_ALT            0x10
+
+/**
+ * The digits of the largest integer in octal, and a prefix.
+ */
+#define NUM_BUF_B           24
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        TYPEDEFS AND STRUCTURES                           */
+/**                                                                        **/
+/****************************************************************************/
+
+#if FMT_LONG_LONG
+typedef uint64_t fmt_uint_t;
+typedef int64_t  fmt_int_t;
+#else
+typedef uint32_t fmt_uint_t;
+typedef int32_t  fmt_int_t;
+#endif
+
+/**
+ * The length modifiers.
+ */
+typedef enum
+{
+    LEN_INT,
+    LEN_CHAR,
+    LEN_SHORT,
+    LEN_LONG,
+    LEN_LLONG,
+    LEN_SIZE,
+    LEN_PTRDIFF,
+    LEN_INTMAX,
+} fmt_len_t;
+
+/**
+ * The sink of fmt_snprintf.
+ */
+typedef struct
+{
+    char    *buf;
+    size_t  size;
+    size_t  len;
+} buf_sink_t;
+
+/**
+ * The sink of fmt_printf.
+ */
+typedef struct
+{
+    char    buf[FMT_PRINTF_BUF_B];
+    size_t  len;
+} stdout_sink_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The formatter of all the functions.
+ */
+static int format( fmt_out_t p_out, void *p_ctx, const char *p_fmt, fmt_args_t *p_args );
+
+/**
+ * @brief The next word of an array of arguments.
+ */
+static uint32_t arg_word( fmt_args_t *p_args );
+
+/**
+ * @brief The next argument, as an int, a signed or an unsigned integer of a
+ * length, or a pointer.
+ */
+static int        arg_int( fmt_args_t *p_args );
+static fmt_int_t  arg_signed( fmt_args_t *p_args, fmt_len_t p_len );
+static fmt_uint_t arg_unsigned( fmt_args_t *p_args, fmt_len_t p_len );
+static uintptr_t  arg_ptr( fmt_args_t *p_args );
+
+/**
+ * @brief Writes p_n times the character p_c.
+ */
+static void out_pad( fmt_out_t p_out, void *p_ctx, char p_c, int p_n );
+
+/**
+ * @brief The sinks of fmt_snprintf and fmt_printf.
+ */
+static void buf_out( void *p_ctx, const char *p_s, size_t p_n );
+static void stdout_out( void *p_ctx, const char *p_s, size_t p_n );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+int fmt_format( fmt_out_t p_out, void *p_ctx, const char *p_fmt, ... )
+{
+    va_list ap;
+    va_start( ap, p_fmt );
+    int n = fmt_vformat( p_out, p_ctx, p_fmt, ap );
+    va_end( ap );
+    return n;
+}
+
+int fmt_vformat( fmt_out_t p_out, void *p_ctx, const char *p_fmt, va_list p_ap )
+{
+    va_list ap;
+    va_copy( ap, p_ap );
+    fmt_args_t args = { .ap = &ap };
+    int n = format( p_out, p_ctx, p_fmt, &args );
+    va_end( ap );
+    return n;
+}
+
+int fmt_format_args( fmt_out_t p_out, void *p_ctx, const char *p_fmt, fmt_args_t *p_args )
+{
+    return format( p_out, p_ctx, p_fmt, p_args );
+}
+
+int fmt_snprintf( char *p_buf, size_t p_size, const char *p_fmt, ... )
+{
+    va_list ap;
+    va_start( ap, p_fmt );
+    int n = fmt_vsnprintf( p_buf, p_size, p_fmt, ap );
+    va_end( ap );
+    return n;
+}
+
+int fmt_vsnprintf( char *p_buf, size_t p_size, const char *p_fmt, va_list p_ap )
+{
+    buf_sink_t sink = { .buf = p_buf, .size = p_size, .len = 0 };
+    int n = fmt_vformat( buf_out, &sink, p_fmt, p_ap );
+
+    if( p_size != 0 )
+    {
+        p_buf[sink.len] = '\0';
+    }
+    return n;
+}
+
+int fmt_printf( const char *p_fmt, ... )
+{
+    va_list ap;
+    va_start( ap, p_fmt );
+    int n = fmt_vprintf( p_fmt, ap );
+    va_end( ap );
+    return n;
+}
+
+int fmt_vprintf( const char *p_fmt, va_list p_ap )
+{
+    stdout_sink_t sink;
+    sink.len = 0;
+
+    int n = fmt_vformat( stdout_out, &sink, p_fmt, p_ap );
+    if( sink.len != 0 )
+    {
+        write( STDOUT_FILENO_, sink.buf, sink.len );
+    }
+    return n;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static int format( fmt_out_t p_out, void *p_ctx, const char *p_fmt, fmt_args_t *p_args )
+{
+    int count = 0;
+
+    while( *p_fmt != '\0' )
+    {
+        /* The text up to the next conversion. */
+        const char *p = p_fmt;
+        while( *p != '\0' && *p != '%' )
+        {
+            p++;
+        }
+        if( p != p_fmt )
+        {
+            p_out( p_ctx, p_fmt, p - p_fmt );
+            count += p - p_fmt;
+            p_fmt = p;
+        }
+        if( *p_fmt == '\0' )
+        {
+            break;
+        }
+
+        const char *spec = p_fmt++;
+        uint32_t flags = 0;
+        int width = 0;
+        int prec = -1;
+        fmt_len_t len = LEN_INT;
+
+        for( ;; p_fmt++ )
+        {
+            if( *p_fmt == '-' )      flags |= FLAG_LEFT;
+            else if( *p_fmt == '0' ) flags |= FLAG_ZERO;
+            else if( *p_fmt == '+' ) flags |= FLAG_PLUS;
+            else if( *p_fmt == ' ' ) flags |= FLAG_SPACE;
+            else if( *p_fmt == '#' ) flags |= FLAG_ALT;
+            else break;
+        }
+
+        if( *p_fmt == '*' )
+        {
+            width = arg_int( p_args );
+            if( width < 0 )
+            {
+                flags |= FLAG_LEFT;
+                width = -width;
+            }
+            p_fmt++;
+        }
+        while( *p_fmt >= '0' && *p_fmt <= '9' )
+        {
+            width = width * 10 + ( *p_fmt++ - '0' );
+        }
+
+        if( *p_fmt == '.' )
+        {
+            p_fmt++;
+            prec = 0;
+            if( *p_fmt == '*' )
+            {
+                prec = arg_int( p_args );
+                p_fmt++;
+            }
+            while( *p_fmt >= '0' && *p_fmt <= '9' )
+            {
+                prec = prec * 10 + ( *p_fmt++ - '0' );
+            }
+        }
+
+        switch( *p_fmt )
+        {
+            case 'h':
+                len = LEN_SHORT;
+                if( *++p_fmt == 'h' ) { len = LEN_CHAR; p_fmt++; }
+                break;
+            case 'l':
+                len = LEN_LONG;
+                if( *++p_fmt == 'l' ) { len = LEN_LLONG; p_fmt++; }
+                break;
+            case 'z': len = LEN_SIZE;    p_fmt++; break;
+            case 't': len = LEN_PTRDIFF; p_fmt++; break;
+            case 'j': len = LEN_INTMAX;  p_fmt++; break;
+            default: break;
+        }
+
+        char conv = *p_fmt;
+        if( conv == '\0' )
+        {
+            /* A conversion cut by the end of the format is written as it
+             * is. */
+            p_out( p_ctx, spec, p_fmt - spec );
+            count += p_fmt - spec;
+            break;
+        }
+        p_fmt++;
+
+        if( conv == '%' )
+        {
+            p_out( p_ctx, "%", 1 );
+            count++;
+            continue;
+        }
+
+        if( conv == 'c' || conv == 's' )
+        {
+            char c;
+            const char *s;
+            int n;
+
+            if( conv == 'c' )
+            {
+                c = (char)arg_int( p_args );
+                s = &c;
+                n = 1;
+            }
+            else
+            {
+                s = (const char *)arg_ptr( p_args );
+                if( s == NULL )
+                {
+                    s = "(null)";
+                }
+                for( n = 0; s[n] != '\0' && ( prec < 0 || n < prec ); n++ );
+            }
+
+            if( !( flags & FLAG_LEFT ) ) out_pad( p_out, p_ctx, ' ', width - n );
+            p_out( p_ctx, s, n );
+            if( flags & FLAG_LEFT ) out_pad( p_out, p_ctx, ' ', width - n );
+            count += width > n ? width : n;
+            continue;
+        }
+
+        fmt_uint_t v;
+        uint32_t base = 10;
+        const char *digits = "0123456789abcdef";
+        char prefix[2];
+        int n_prefix = 0;
+
+        switch( conv )
+        {
+            case 'd':
+            case 'i':
+            {
+                fmt_int_t sv = arg_signed( p_args, len );
+                v = sv < 0 ? -(fmt_uint_t)sv : (fmt_uint_t)sv;
+                if( sv < 0 )                    prefix[n_prefix++] = '-';
+                else if( flags & FLAG_PLUS )    prefix[n_prefix++] = '+';
+                else if( flags & FLAG_SPACE )   prefix[n_prefix++] = ' ';
+                break;
+            }
+            case 'u':
+                v = arg_unsigned( p_args, len );
+                break;
+            case 'o':
+                v = arg_unsigned( p_args, len );
+                base = 8;
+                break;
+            case 'X':
+                digits = "0123456789ABCDEF";
+                /* fall through */
+            case 'x':
+                v = arg_unsigned( p_args, len );
+                base = 16;
+                if( ( flags & FLAG_ALT ) && v != 0 )
+                {
+                    prefix[n_prefix++] = '0';
+                    prefix[n_prefix++] = conv;
+                }
+                break;
+            case 'p':
+                v = arg_ptr( p_args );
+                base = 16;
+                prefix[n_prefix++] = '0';
+                prefix[n_prefix++] = 'x';
+                break;
+            default:
+                /* Not supported, e.g. the floats: the argument is not
+                 * consumed. */
+                p_out( p_ctx, spec, p_fmt - spec );
+                count += p_fmt - spec;
+                continue;
+        }
+
+        /* The digits, from the last one. */
+        char buf[NUM_BUF_B];
+        int n = 0;
+        while( v != 0 )
+        {
+            buf[NUM_BUF_B - ++n] = digits[v % base];
+            v /= base;
+        }
+
+        /* A precision gives the least digits, and none for a 0 with a
+         * precision of 0, else a 0 has a digit. */
+        int n_zeros = 0;
+        if( prec >= 0 )
+        {
+            flags &= ~FLAG_ZERO;
+            n_zeros = prec > n ? prec - n : 0;
+        }
+        else if( n == 0 )
+        {
+            n_zeros = 1;
+        }
+        if( base == 8 && ( flags & FLAG_ALT ) && n_zeros == 0 )
+        {
+            n_zeros = 1;
+        }
+
+        int total = n_prefix + n_zeros + n;
+        int pad = width > total ? width - total : 0;
+        if( flags & FLAG_ZERO && !( flags & FLAG_LEFT ) )
+        {
+            n_zeros += pad;
+            pad = 0;
+        }
+
+        if( !( flags & FLAG_LEFT ) ) out_pad( p_out, p_ctx, ' ', pad );
+        p_out( p_ctx, prefix, n_prefix );
+        out_pad( p_out, p_ctx, '0', n_zeros );
+        p_out( p_ctx, &buf[NUM_BUF_B - n], n );
+        if( flags & FLAG_LEFT ) out_pad( p_out, p_ctx, ' ', pad );
+        count += n_prefix + n_zeros + n + pad;
+    }
+
+    return count;
+}
+
+static uint32_t arg_word( fmt_args_t *p_args )
+{
+    if( p_args->n_words == 0 )
+    {
+        return 0;
+    }
+    p_args->n_words--;
+    return *p_args->words++;
+}
+
+static int arg_int( fmt_args_t *p_args )
+{
+    if( p_args->ap != NULL )
+    {
+        return va_arg( *p_args->ap, int );
+    }
+    return (int32_t)arg_word( p_args );
+}
+
+static fmt_int_t arg_signed( fmt_args_t *p_args, fmt_len_t p_len )
+{
+    if( p_args->ap == NULL )
+    {
+        uint32_t w = arg_word( p_args );
+        if( p_len == LEN_CHAR )  return (signed char)w;
+        if( p_len == LEN_SHORT ) return (short)w;
+        return (int32_t)w;
+    }
+
+    switch( p_len )
+    {
+        case LEN_CHAR:      return (signed char)va_arg( *p_args->ap, int );
+        case LEN_SHORT:     return (short)va_arg( *p_args->ap, int );
+        case LEN_LONG:      return (fmt_int_t)va_arg( *p_args->ap, long );
+        case LEN_LLONG:     return (fmt_int_t)va_arg( *p_args->ap, long long );
+        case LEN_SIZE:      return (fmt_int_t)va_arg( *p_args->ap, size_t );
+        case LEN_PTRDIFF:   return (fmt_int_t)va_arg( *p_args->ap, ptrdiff_t );
+        case LEN_INTMAX:    return (fmt_int_t)va_arg( *p_args->ap, intmax_t );
+        default:            return va_arg( *p_args->ap, int );
+    }
+}
+
+static fmt_uint_t arg_unsigned( fmt_args_t *p_args, fmt_len_t p_len )
+{
+    if( p_args->ap == NULL )
+    {
+        uint32_t w = arg_word( p_args );
+        if( p_len == LEN_CHAR )  return (unsigned char)w;
+        if( p_len == LEN_SHORT ) return (unsigned short)w;
+        return w;
+    }
+
+    switch( p_len )
+    {
+        case LEN_CHAR:      return (unsigned char)va_arg( *p_args->ap, unsigned int );
+        case LEN_SHORT:     return (unsigned short)va_arg( *p_args->ap, unsigned int );
+        case LEN_LONG:      return (fmt_uint_t)va_arg( *p_args->ap, unsigned long );
+        case LEN_LLONG:     return (fmt_uint_t)va_arg( *p_args->ap, unsigned long long );
+        case LEN_SIZE:      return (fmt_uint_t)va_arg( *p_args->ap, size_t );
+        case LEN_PTRDIFF:   return (fmt_uint_t)va_arg( *p_args->ap, ptrdiff_t );
+        case LEN_INTMAX:    return (fmt_uint_t)va_arg( *p_args->ap, uintmax_t );
+        default:            return va_arg( *p_args->ap, unsigned int );
+    }
+}
+
+static uintptr_t arg_ptr( fmt_args_t *p_args )
+{
+    if( p_args->ap != NULL )
+    {
+        return (uintptr_t)va_arg( *p_args->ap, void * );
+    }
+    return arg_word( p_args );
+}
+
+static void out_pad( fmt_out_t p_out, void *p_ctx, char p_c, int p_n )
+{
+    static const char spaces[8] = { ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ' };
+    static const char zeros[8]  = { '0', '0', '0', '0', '0', '0', '0', '0' };
+    const char *s = p_c == '0' ? zeros : spaces;
+
+    while( p_n > 0 )
+    {
+        int n = p_n < 8 ? p_n : 8;
+        p_out( p_ctx, s, n );
+        p_n -= n;
+    }
+}
+
+static void buf_out( void *p_ctx, const char *p_s, size_t p_n )
+{
+    buf_sink_t *sink = (buf_sink_t *)p_ctx;
+
+    /* The last byte is kept for the terminating 0. */
+    for( size_t i = 0; i < p_n && sink->len + 1 < sink->size; i++ )
+    {
+        sink->buf[sink->len++] = p_s[i];
+    }
+}
+
+static void stdout_out( void *p_ctx, const char *p_s, size_t p_n )
+{
+    stdout_sink_t *sink = (stdout_sink_t *)p_ctx;
+
+    while( p_n > 0 )
+    {
+        if( sink->len == FMT_PRINTF_BUF_B )
+        {
+            write( STDOUT_FILENO_, sink->buf, sink->len );
+            sink->len = 0;
+        }
+        size_t n = FMT_PRINTF_BUF_B - sink->len;
+        if( n > p_n )
+        {
+            n = p_n;
+        }
+        for( size_t i = 0; i < n; i++ )
+        {
+            sink->buf[sink->len + i] = p_s[i];
+        }
+        sink->len += n;
+        p_s += n;
+        p_n -= n;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,153 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : fmt.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   fmt.h
+* @date   14/10/26
+* @brief  Compact printf-style formatting, without heap nor global state.
+*
+* The printf of newlib pulls in its whole stdio: the FILE buffers are
+* allocated by malloc on the first call (through _sbrk), and the formatter
+* handles floats, wide characters and locales. These functions only format
+* integers, characters and strings into a sink, a function called with each
+* piece of the output. They keep no state between calls, so they can be used
+* from interrupt handlers and by several harts.
+*
+* The conversions are d, i, u, x, X, o, c, s, p and %, with the flags -, 0,
+* +, space and #, a width and a precision (also given as *), and the length
+* modifiers hh, h, l, ll, z, j and t. The other conversions, e.g. the floats,
+* are written as they are in the format.
+*
+* fmt_printf writes to the standard output through _write, from a buffer of
+* FMT_PRINTF_BUF_B bytes on the stack.
+*/
+
+#ifndef _FMT_H
+#define _FMT_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Bytes of the stack buffer of fmt_printf, written at once to the output.
+ */
+#ifndef FMT_PRINTF_BUF_B
+#define FMT_PRINTF_BUF_B    64
+#endif
+
+/**
+ * 1 to format the 64-bit integers (ll and j), which pulls in the 64-bit
+ * divisions of libgcc.
+ */
+#ifndef FMT_LONG_LONG
+#define FMT_LONG_LONG       1
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A sink of the output.
+ * @param p_ctx The context given with it.
+ * @param p_s The characters, not terminated.
+ * @param p_n Their number.
+ */
+typedef void (*fmt_out_t)( void *p_ctx, const char *p_s, size_t p_n );
+
+/**
+ * The source of the arguments: a va_list, or an array of words. Used by the
+ * deferred log, see fmt_log.h.
+ */
+typedef struct
+{
+    va_list         *ap;        /*!< The arguments, if not NULL. */
+    const uint32_t  *words;     /*!< Otherwise, one word per argument. */
+    uint32_t        n_words;    /*!< The words, 0 is given past them. */
+} fmt_args_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Formats to a sink.
+ * @param p_out The sink.
+ * @param p_ctx Its context.
+ * @param p_fmt The format.
+ * @return The characters written.
+ */
+int fmt_format( fmt_out_t p_out, void *p_ctx, const char *p_fmt, ... );
+int fmt_vformat( fmt_out_t p_out, void *p_ctx, const char *p_fmt, va_list p_ap );
+
+/**
+ * @brief Formats to a sink, with arguments from a fmt_args_t.
+ */
+int fmt_format_args( fmt_out_t p_out, void *p_ctx, const char *p_fmt, fmt_args_t *p_args );
+
+/**
+ * @brief Formats to a buffer, as snprintf.
+ * @param p_buf The buffer, always terminated if p_size is not 0.
+ * @param p_size Its size.
+ * @return The characters of the whole output, without the terminating 0:
+ * it was truncated if they are p_size or more.
+ */
+int fmt_snprintf( char *p_buf, size_t p_size, const char *p_fmt, ... );
+int fmt_vsnprintf( char *p_buf, size_t p_size, const char *p_fmt, va_list p_ap );
+
+/**
+ * @brief Formats to the standard output, as printf.
+ * @return The characters written.
+ */
+int fmt_printf( const char *p_fmt, ... );
+int fmt_vprintf( const char *p_fmt, va_list p_ap );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _FMT_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
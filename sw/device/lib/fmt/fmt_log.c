@@ -0,0 +1,155 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : fmt_log.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   fmt_log.c
+* @date   14/10/26
+* @brief  Deferred log of formats and arguments, formatted on the chip or
+* dumped for the host.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "fmt_log.h"
+#include "fmt.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+_Static_assert( sizeof( fmt_log_rec_t ) == FMT_LOG_REC_B, "a record is FMT_LOG_REC_B bytes" );
+
+/**
+ * The sink of the formatted records, the standard output.
+ */
+#define LOG_OUT     fmt_printf
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The oldest record of a log.
+ * @return NULL if the log is empty.
+ */
+static const fmt_log_rec_t *log_oldest( fmt_log_t *p_log );
+
+/**
+ * @brief Writes to the buffer of fmt_log_print.
+ */
+static void line_out( void *p_ctx, const char *p_s, size_t p_n );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+bool fmt_log_init( fmt_log_t *p_log, fmt_log_rec_t *p_buf, uint32_t p_size_b )
+{
+    if( p_size_b < FMT_LOG_REC_B )
+    {
+        return false;
+    }
+    p_log->dropped = 0;
+    return ring_init( &p_log->ring, p_buf, p_size_b );
+}
+
+uint32_t fmt_log_print( fmt_log_t *p_log, uint32_t p_max )
+{
+    const fmt_log_rec_t *rec;
+    uint32_t n = 0;
+
+    while( n < p_max && ( rec = log_oldest( p_log ) ) != NULL )
+    {
+        /* The record is formatted to a line, so that it is written at once
+         * and it is freed before the output waits. */
+        char line[FMT_PRINTF_BUF_B];
+        size_t len = 0;
+        void *ctx[2] = { line, &len };
+        fmt_args_t args = { .ap = NULL, .words = rec->arg, .n_words = FMT_LOG_MAX_ARGS };
+
+        fmt_format_args( line_out, ctx, rec->fmt, &args );
+        ring_release( &p_log->ring, FMT_LOG_REC_B );
+        LOG_OUT( "%.*s\n", (int)len, line );
+        n++;
+    }
+    return n;
+}
+
+uint32_t fmt_log_dump( fmt_log_t *p_log, uint32_t p_max )
+{
+    const fmt_log_rec_t *rec;
+    uint32_t n = 0;
+
+    while( n < p_max && ( rec = log_oldest( p_log ) ) != NULL )
+    {
+        fmt_log_rec_t r = *rec;
+        ring_release( &p_log->ring, FMT_LOG_REC_B );
+        LOG_OUT( FMT_LOG_DUMP_TAG " %08x %08x %x %x %x %x %x %x\n", (uint32_t)(uintptr_t)r.fmt,
+                 r.cycle, r.arg[0], r.arg[1], r.arg[2], r.arg[3], r.arg[4], r.arg[5] );
+        n++;
+    }
+    LOG_OUT( FMT_LOG_DUMP_TAG " dropped %u\n", p_log->dropped );
+    return n;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static const fmt_log_rec_t *log_oldest( fmt_log_t *p_log )
+{
+    void *ptr;
+
+    if( ring_peek( &p_log->ring, &ptr ) < FMT_LOG_REC_B )
+    {
+        return NULL;
+    }
+    return (const fmt_log_rec_t *)ptr;
+}
+
+static void line_out( void *p_ctx, const char *p_s, size_t p_n )
+{
+    char *line = ( (char **)p_ctx )[0];
+    size_t *len = ( (size_t **)p_ctx )[1];
+
+    /* The end of a line longer than the buffer is cut. */
+    for( size_t i = 0; i < p_n && *len < FMT_PRINTF_BUF_B; i++ )
+    {
+        line[( *len )++] = p_s[i];
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,226 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : fmt_log.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   fmt_log.h
+* @date   14/10/26
+* @brief  Deferred log: the records hold the address of their format and
+* their arguments, and are formatted later, at idle or on the host.
+*
+* FMT_LOG( &log, "fmt", args... ) stores a record of FMT_LOG_REC_B bytes in
+* a ring (base/ring.h): the address of the format, the cycle counter and up
+* to FMT_LOG_MAX_ARGS arguments, i.e. a few stores instead of the thousands
+* of cycles of a printf. When the ring is full, the record is dropped and
+* counted.
+*
+* The records are then either formatted on the chip by fmt_log_print, with
+* the formatter of fmt.h, e.g. from the idle loop, or dumped by fmt_log_dump
+* as lines of hex words, which util/fmt_log_decode.py formats on the host
+* with the format strings of the ELF. The formats of FMT_LOG are placed in
+* the .rodata.fmt_log section, so the decoder finds them.
+*
+* Each argument is one word: integers up to 32 bits, characters and
+* pointers. The strings of %s must still be in memory when formatted on the
+* chip, and be constants of the ELF for the host. The 64-bit integers and
+* the floats are not supported.
+*
+* A log has one producer: an interrupt handler and the main loop use a log
+* each.
+*/
+
+#ifndef _FMT_LOG_H
+#define _FMT_LOG_H
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+
+#include "csr.h"
+#include "ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The arguments of a record, and its size.
+ */
+#define FMT_LOG_MAX_ARGS    6
+#define FMT_LOG_REC_B       32
+
+/**
+ * The prefix of the lines of fmt_log_dump.
+ */
+#define FMT_LOG_DUMP_TAG    "FMTLOG"
+
+/**
+ * The number of arguments of FMT_LOG, from 0 to FMT_LOG_MAX_ARGS.
+ */
+#define FMT_LOG_NARGS( ... ) FMT_LOG_NARGS_( 0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0 )
+#define FMT_LOG_NARGS_( _0, _1, _2, _3, _4, _5, _6, N, ... ) N
+
+#define FMT_LOG_CAT( a, b )  FMT_LOG_CAT_( a, b )
+#define FMT_LOG_CAT_( a, b ) a##b
+
+/**
+ * The arguments as words, padded with zeros.
+ */
+#define FMT_LOG_W( a )                      (uint32_t)(uintptr_t)( a )
+#define FMT_LOG_ARGS0()                     0, 0, 0, 0, 0, 0
+#define FMT_LOG_ARGS1( a )                  FMT_LOG_W( a ), 0, 0, 0, 0, 0
+#define FMT_LOG_ARGS2( a, b )               FMT_LOG_W( a ), FMT_LOG_W( b ), 0, 0, 0, 0
+#define FMT_LOG_ARGS3( a, b, c )            FMT_LOG_W( a ), FMT_LOG_W( b ), FMT_LOG_W( c ), 0, 0, 0
+#define FMT_LOG_ARGS4( a, b, c, d )         FMT_LOG_W( a ), FMT_LOG_W( b ), FMT_LOG_W( c ), \
+                                            FMT_LOG_W( d ), 0, 0
+#define FMT_LOG_ARGS5( a, b, c, d, e )      FMT_LOG_W( a ), FMT_LOG_W( b ), FMT_LOG_W( c ), \
+                                            FMT_LOG_W( d ), FMT_LOG_W( e ), 0
+#define FMT_LOG_ARGS6( a, b, c, d, e, f )   FMT_LOG_W( a ), FMT_LOG_W( b ), FMT_LOG_W( c ), \
+                                            FMT_LOG_W( d ), FMT_LOG_W( e ), FMT_LOG_W( f )
+
+/**
+ * Logs a record.
+ * @param p_log The log.
+ * @param p_fmt The format, a string literal.
+ */
+#define FMT_LOG( p_log, p_fmt, ... )                                            \
+    do {                                                                        \
+        static const char fmt_log_str_[]                                        \
+            __attribute__((section(".rodata.fmt_log"))) = p_fmt;               \
+        fmt_log_write( ( p_log ), fmt_log_str_, FMT_LOG_NARGS( __VA_ARGS__ ),   \
+            FMT_LOG_CAT( FMT_LOG_ARGS, FMT_LOG_NARGS( __VA_ARGS__ ) )( __VA_ARGS__ ) ); \
+    } while( 0 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A record.
+ */
+typedef struct
+{
+    const char  *fmt;                       /*!< The format. */
+    uint32_t    cycle;                      /*!< mcycle when logged. */
+    uint32_t    arg[FMT_LOG_MAX_ARGS];      /*!< The arguments. */
+} fmt_log_rec_t;
+
+/**
+ * A log. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    ring_t              ring;
+    volatile uint32_t   dropped;    /*!< The records dropped so far. */
+} fmt_log_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Initializes an empty log.
+ * @param p_log The log.
+ * @param p_buf The ring of records, word aligned.
+ * @param p_size_b Its size, a power of 2 of at least FMT_LOG_REC_B.
+ * @return false if the size is wrong.
+ */
+bool fmt_log_init( fmt_log_t *p_log, fmt_log_rec_t *p_buf, uint32_t p_size_b );
+
+/**
+ * @brief Stores a record, called by FMT_LOG. The stores of the arguments
+ * past p_n are removed once inlined.
+ */
+static inline void fmt_log_write( fmt_log_t *p_log, const char *p_fmt, uint32_t p_n,
+                                  uint32_t p_a0, uint32_t p_a1, uint32_t p_a2,
+                                  uint32_t p_a3, uint32_t p_a4, uint32_t p_a5 )
+{
+    fmt_log_rec_t *rec;
+
+    /* The records are a power of 2, so they are never split by the end of
+     * the ring. */
+    if( ring_reserve( &p_log->ring, (void **)&rec ) < FMT_LOG_REC_B )
+    {
+        p_log->dropped = p_log->dropped + 1;
+        return;
+    }
+    rec->fmt = p_fmt;
+    CSR_READ( CSR_REG_MCYCLE, &rec->cycle );
+    if( p_n > 0 ) rec->arg[0] = p_a0;
+    if( p_n > 1 ) rec->arg[1] = p_a1;
+    if( p_n > 2 ) rec->arg[2] = p_a2;
+    if( p_n > 3 ) rec->arg[3] = p_a3;
+    if( p_n > 4 ) rec->arg[4] = p_a4;
+    if( p_n > 5 ) rec->arg[5] = p_a5;
+    ring_commit( &p_log->ring, FMT_LOG_REC_B );
+}
+
+/**
+ * @brief Formats the oldest records to the standard output, each followed
+ * by a new line, and frees them.
+ * @param p_log The log.
+ * @param p_max The most records to format.
+ * @return The records formatted.
+ */
+uint32_t fmt_log_print( fmt_log_t *p_log, uint32_t p_max );
+
+/**
+ * @brief Writes the oldest records to the standard output as lines of hex
+ * words for util/fmt_log_decode.py, and frees them: FMT_LOG_DUMP_TAG, the
+ * address of the format, the cycle and the arguments. A last line gives the
+ * records dropped so far.
+ * @param p_log The log.
+ * @param p_max The most records to write.
+ * @return The records written.
+ */
+uint32_t fmt_log_dump( fmt_log_t *p_log, uint32_t p_max );
+
+/**
+ * @brief The records waiting in a log.
+ */
+static inline uint32_t fmt_log_pending( const fmt_log_t *p_log )
+{
+    return ring_used( &p_log->ring ) / FMT_LOG_REC_B;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _FMT_LOG_H */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,471 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef XHEEP_SW_DEVICE_LIB_RUNTIME_ASYNC_HPP_
+#define XHEEP_SW_DEVICE_LIB_RUNTIME_ASYNC_HPP_
+
+/**
+ * @file
+ * @brief C++20 coroutines awaiting the DMA, the SPI host and the AO timer.
+ *
+ * A function returning `xheep::async::task` is a coroutine, which waits for
+ * the peripherals with `co_await` instead of polling them or splitting the
+ * code in callbacks:
+ *
+ *   xheep::async::task pipeline() {
+ *     for (int i = 0; i < n; i++) {
+ *       co_await xheep::async::dma_transfer(&trans);    // Transfer done.
+ *       co_await xheep::async::delay(1000);              // 1000 cycles later.
+ *       co_await xheep::async::spi_idle(&spi);           // Segments done.
+ *     }
+ *   }
+ *
+ *   int main() {
+ *     xheep::async::timer_init();
+ *     xheep::async::task t = pipeline();
+ *     xheep::async::run();
+ *   }
+ *
+ * A task starts right away when it is called, and runs until its first wait.
+ * The waits are completed by the interrupt handlers: the callback of
+ * `dma_submit()`, called from `dma_intr_handler_trans_done`, `fic_irq_spi`
+ * and `fic_irq_timer_1`. The handlers only append the coroutine to the ready
+ * queue, and `run()` resumes the ready ones in thread context, so that no
+ * application code runs in the handlers. It sleeps in wfi while the queue is
+ * empty, and returns when all the tasks are done. A task can `co_await`
+ * another task, and continues when that one is done.
+ *
+ * The coroutine frames are taken from a static pool of
+ * `XHEEP_ASYNC_FRAMES_N` frames of `XHEEP_ASYNC_FRAME_B` bytes, both
+ * overridable with `-D`: there is no heap. A task whose frame does not fit
+ * is not started and is false. Each frame must stay in the pool until its
+ * task is done, so a task must not be destroyed while it waits.
+ *
+ * `XHEEP_ASYNC_DEFINE_HOOKS()` defines `fic_irq_spi` and `fic_irq_timer_1`,
+ * and must be placed once in one C++ file of the application, which then
+ * cannot define them itself. A single SPI wait and one timer are used.
+ *
+ * The header needs `-std=c++20` (`make app CXX_STD=c++20`, with gcc) and
+ * uses no exceptions and RTTI, so it is built with `-fno-exceptions`.
+ */
+
+#if __cplusplus < 202002L || !defined(__cpp_impl_coroutine)
+#error "async.hpp needs C++20 coroutines, build the application with CXX_STD=c++20"
+#endif
+
+#include <coroutine>
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "fast_intr_ctrl.h"
+#include "hart.h"
+#include "irq.h"
+#include "rv_timer.h"
+#include "spi_host.h"
+}
+
+#ifndef XHEEP_ASYNC_FRAMES_N
+#define XHEEP_ASYNC_FRAMES_N 4
+#endif
+
+#ifndef XHEEP_ASYNC_FRAME_B
+#define XHEEP_ASYNC_FRAME_B 256
+#endif
+
+namespace xheep {
+namespace async {
+
+namespace detail {
+
+static_assert(XHEEP_ASYNC_FRAMES_N >= 1 && XHEEP_ASYNC_FRAMES_N <= 32,
+              "the frames are tracked in a 32-bit word");
+
+// A coroutine waiting for a handler, living in its frame.
+struct waiter {
+  waiter *next = nullptr;
+  std::coroutine_handle<> handle;
+  uint64_t deadline = 0;  // Of the timer waits only.
+};
+
+// The ready queue, appended to by the handlers.
+inline waiter *ready_head;
+inline waiter *ready_tail;
+
+// The tasks started and not done yet.
+inline uint32_t running_n;
+
+// The pool of the coroutine frames.
+alignas(8) inline uint8_t frames[XHEEP_ASYNC_FRAMES_N][XHEEP_ASYNC_FRAME_B];
+inline uint32_t frames_used;
+
+inline void *frame_alloc(size_t size) {
+  if (size > XHEEP_ASYNC_FRAME_B) return nullptr;
+  void *frame = nullptr;
+  uint32_t mstatus = irq_save();
+  for (uint32_t i = 0; i < XHEEP_ASYNC_FRAMES_N; i++) {
+    if (!(frames_used & (1u << i))) {
+      frames_used |= 1u << i;
+      frame = frames[i];
+      break;
+    }
+  }
+  irq_restore(mstatus);
+  return frame;
+}
+
+inline void frame_free(void *frame) {
+  uint32_t i = (uint32_t)((uint8_t *)frame - &frames[0][0]) / XHEEP_ASYNC_FRAME_B;
+  uint32_t mstatus = irq_save();
+  frames_used &= ~(1u << i);
+  irq_restore(mstatus);
+}
+
+// Makes a waiter ready, from a handler or from thread context.
+inline void make_ready(waiter *w) {
+  uint32_t mstatus = irq_save();
+  w->next = nullptr;
+  if (ready_tail != nullptr) {
+    ready_tail->next = w;
+  } else {
+    ready_head = w;
+  }
+  ready_tail = w;
+  irq_restore(mstatus);
+}
+
+// The timer waits, sorted by deadline, and their timer.
+inline waiter *timer_head;
+inline rv_timer_t timer;
+constexpr uint32_t timer_hart = 1;
+constexpr uint32_t timer_cmp = 0;
+
+inline uint64_t timer_now() {
+  uint64_t now = 0;
+  rv_timer_counter_read(&timer, timer_hart, &now);
+  return now;
+}
+
+// Arms the comparator for the first wait, or disarms it. It must be called
+// with the interrupts disabled.
+inline void timer_rearm() {
+  rv_timer_arm(&timer, timer_hart, timer_cmp,
+               timer_head != nullptr ? timer_head->deadline : UINT64_MAX);
+}
+
+// The SPI wait.
+inline waiter *spi_waiter;
+inline const spi_host_t *spi_waited;
+
+}  // namespace detail
+
+/**
+ * A coroutine, started when it is called. It can be awaited by another one,
+ * and owns its frame, given back to the pool when the task is destroyed.
+ */
+class task {
+ public:
+  struct promise_type {
+    std::coroutine_handle<> continuation;
+
+    static void *operator new(size_t size) noexcept {
+      return detail::frame_alloc(size);
+    }
+    static void operator delete(void *frame) noexcept {
+      detail::frame_free(frame);
+    }
+    static task get_return_object_on_allocation_failure() noexcept {
+      return task();
+    }
+
+    task get_return_object() noexcept {
+      return task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+      detail::running_n++;
+      return {};
+    }
+
+    // Suspends the done task, so that its owner destroys it, and continues
+    // the task awaiting it if any.
+    struct final_awaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<promise_type> h) noexcept {
+        detail::running_n--;
+        std::coroutine_handle<> next = h.promise().continuation;
+        return next ? next : std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+    };
+    final_awaiter final_suspend() noexcept { return {}; }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {}
+  };
+
+  task() = default;
+  task(const task &) = delete;
+  task &operator=(const task &) = delete;
+  task(task &&other) noexcept : handle_(other.handle_) { other.handle_ = {}; }
+  ~task() {
+    if (handle_) handle_.destroy();
+  }
+
+  /** Whether the task was started, i.e. its frame fit in the pool. */
+  explicit operator bool() const { return (bool)handle_; }
+
+  /** Whether the task is done, or was not started. */
+  bool done() const { return !handle_ || handle_.done(); }
+
+  bool await_ready() const noexcept { return done(); }
+  void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle_.promise().continuation = awaiting;
+  }
+  void await_resume() noexcept {}
+
+ private:
+  explicit task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Resumes the ready tasks, and sleeps in wfi while there are none, until all
+ * the tasks are done. The interrupts of the waits must be enabled in mie:
+ * mstatus.MIE is set after each wfi, to take the interrupt that woke the core
+ * up, and left as it was for the tasks.
+ */
+inline void run() {
+  for (;;) {
+    uint32_t mstatus = irq_save();
+    detail::waiter *w = detail::ready_head;
+
+    if (w != nullptr) {
+      detail::ready_head = w->next;
+      if (detail::ready_head == nullptr) detail::ready_tail = nullptr;
+      irq_restore(mstatus);
+      w->handle.resume();
+      continue;
+    }
+
+    if (detail::running_n == 0) {
+      irq_restore(mstatus);
+      return;
+    }
+
+    // The queue was found empty with the interrupts disabled, so the
+    // interrupt making a task ready wakes the core up from the wfi.
+    wait_for_interrupt();
+    CSR_SET_BITS(CSR_REG_MSTATUS, IRQ_MSTATUS_MIE);
+    irq_restore(mstatus);
+  }
+}
+
+/**
+ * Lets the other ready tasks run, and continues after them.
+ */
+class yield {
+ public:
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) noexcept {
+    waiter_.handle = h;
+    detail::make_ready(&waiter_);
+  }
+  void await_resume() noexcept {}
+
+ private:
+  detail::waiter waiter_;
+};
+
+/**
+ * Submits a DMA transaction to the queue of its channel, and waits until it
+ * is done. The transaction is validated first; it must not be modified until
+ * the wait is over.
+ *
+ * The result of `co_await` is the flags of the validation and the submission,
+ * with `DMA_CONFIG_CRITICAL_ERROR` if the transaction could not be performed
+ * or ended with an error.
+ */
+class dma_transfer {
+ public:
+  explicit dma_transfer(dma_trans_t *trans) : trans_(trans) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  // Does not suspend if the transaction was not submitted.
+  bool await_suspend(std::coroutine_handle<> h) noexcept {
+    waiter_.handle = h;
+    entry_.trans   = trans_;
+    entry_.cb      = &dma_transfer::done;
+    entry_.ctx     = this;
+
+    flags_ = dma_validate_transaction(trans_, DMA_ENABLE_REALIGN,
+                                      DMA_PERFORM_CHECKS_INTEGRITY);
+    if (flags_ & DMA_CONFIG_CRITICAL_ERROR) return false;
+    flags_ = (dma_config_flags_t)(flags_ | dma_submit(&entry_));
+    if (flags_ & (DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE)) {
+      flags_ = (dma_config_flags_t)(flags_ | DMA_CONFIG_CRITICAL_ERROR);
+      return false;
+    }
+    return true;
+  }
+
+  dma_config_flags_t await_resume() const noexcept { return flags_; }
+
+ private:
+  static void done(dma_queue_entry_t *entry) {
+    dma_transfer *self = (dma_transfer *)entry->ctx;
+    if (entry->trans->flags & DMA_CONFIG_CRITICAL_ERROR) {
+      self->flags_ = (dma_config_flags_t)(self->flags_ | DMA_CONFIG_CRITICAL_ERROR);
+    }
+    detail::make_ready(&self->waiter_);
+  }
+
+  dma_trans_t *trans_;
+  dma_queue_entry_t entry_ = {};
+  dma_config_flags_t flags_ = DMA_CONFIG_OK;
+  detail::waiter waiter_;
+};
+
+/**
+ * Waits until the SPI host has executed all its queued segments, with its
+ * idle event interrupt, whose fast interrupt it enables. The event
+ * interrupts of the SPI host are left disabled when the wait is over. A single task can wait for the SPI host.
+ */
+class spi_idle {
+ public:
+  explicit spi_idle(const spi_host_t *spi) : spi_(spi) {}
+
+  bool await_ready() const noexcept { return !spi_get_active(spi_); }
+
+  bool await_suspend(std::coroutine_handle<> h) noexcept {
+    waiter_.handle = h;
+    irq_set_enabled(IRQ_SRC_FAST(kSpi_fic_e), true);
+    uint32_t mstatus = irq_save();
+    detail::spi_waiter = &waiter_;
+    detail::spi_waited = spi_;
+    spi_enable_idle_intr(spi_, true);
+    spi_enable_evt_intr(spi_, true);
+    // It may have gone idle before the interrupt was enabled
+    bool active = spi_get_active(spi_);
+    if (!active) {
+      spi_enable_evt_intr(spi_, false);
+      spi_enable_idle_intr(spi_, false);
+      detail::spi_waiter = nullptr;
+    }
+    irq_restore(mstatus);
+    return active;
+  }
+
+  void await_resume() noexcept {}
+
+ private:
+  const spi_host_t *spi_;
+  detail::waiter waiter_;
+};
+
+/**
+ * Sets up the timer of the waits: the counter of the hart 1 of the AO timer
+ * counts the cycles, and its fast interrupt is enabled. It must be called
+ * before the first `delay`, and the interrupts enabled in mstatus for `run()`
+ * to take them.
+ */
+inline void timer_init() {
+  rv_timer_config_t config = {};
+  config.hart_count = 2;
+  config.comparator_count = 1;
+  rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS), config,
+                &detail::timer);
+
+  rv_timer_tick_params_t tick = {};
+  tick.prescale = 0;
+  tick.tick_step = 1;
+  rv_timer_set_tick_params(&detail::timer, detail::timer_hart, tick);
+
+  rv_timer_arm(&detail::timer, detail::timer_hart, detail::timer_cmp, UINT64_MAX);
+  rv_timer_irq_enable(&detail::timer, detail::timer_hart, detail::timer_cmp,
+                      kRvTimerEnabled);
+  irq_set_enabled(IRQ_SRC_FAST(kTimer_1_fic_e), true);
+  rv_timer_counter_set_enabled(&detail::timer, detail::timer_hart,
+                               kRvTimerEnabled);
+}
+
+/**
+ * Waits for a number of cycles of the AO timer, at least. The waits of
+ * several tasks share the timer: its comparator is armed for the first one.
+ */
+class delay {
+ public:
+  explicit delay(uint64_t cycles) : cycles_(cycles) {}
+
+  bool await_ready() const noexcept { return cycles_ == 0; }
+
+  void await_suspend(std::coroutine_handle<> h) noexcept {
+    waiter_.handle = h;
+    uint32_t mstatus = irq_save();
+    waiter_.deadline = detail::timer_now() + cycles_;
+
+    detail::waiter **link = &detail::timer_head;
+    while (*link != nullptr && (*link)->deadline <= waiter_.deadline) {
+      link = &(*link)->next;
+    }
+    waiter_.next = *link;
+    *link = &waiter_;
+    if (detail::timer_head == &waiter_) detail::timer_rearm();
+    irq_restore(mstatus);
+  }
+
+  void await_resume() noexcept {}
+
+ private:
+  uint64_t cycles_;
+  detail::waiter waiter_;
+};
+
+/**
+ * The handler of the SPI host event interrupt, called by `fic_irq_spi`.
+ */
+inline void spi_irq() {
+  if (detail::spi_waited == nullptr) return;
+  spi_clear_evt_intr(detail::spi_waited);
+  if (detail::spi_waiter != nullptr && !spi_get_active(detail::spi_waited)) {
+    spi_enable_evt_intr(detail::spi_waited, false);
+    spi_enable_idle_intr(detail::spi_waited, false);
+    detail::waiter *w = detail::spi_waiter;
+    detail::spi_waiter = nullptr;
+    detail::make_ready(w);
+  }
+}
+
+/**
+ * The handler of the timer interrupt, called by `fic_irq_timer_1`: the waits
+ * that are over are made ready.
+ */
+inline void timer_irq() {
+  rv_timer_irq_clear(&detail::timer, detail::timer_hart, detail::timer_cmp);
+  uint64_t now = detail::timer_now();
+  while (detail::timer_head != nullptr && detail::timer_head->deadline <= now) {
+    detail::waiter *w = detail::timer_head;
+    detail::timer_head = w->next;
+    detail::make_ready(w);
+  }
+  detail::timer_rearm();
+}
+
+}  // namespace async
+}  // namespace xheep
+
+/**
+ * Defines the fast interrupt handlers of the waits, once per application.
+ */
+#define XHEEP_ASYNC_DEFINE_HOOKS()                                 \
+  extern "C" void fic_irq_spi(void) { xheep::async::spi_irq(); }   \
+  extern "C" void fic_irq_timer_1(void) { xheep::async::timer_irq(); }
+
+#endif  // XHEEP_SW_DEVICE_LIB_RUNTIME_ASYNC_HPP_
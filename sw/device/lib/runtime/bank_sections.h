@@ -0,0 +1,91 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BANK_SECTIONS_H_
+#define BANK_SECTIONS_H_
+
+#include "core_v_mini_mcu.h"
+
+/*
+ * Placement of data in the RAM banks.
+ *
+ * Each bank is a slave port of the system crossbar. With the NtoM bus, masters
+ * accessing different banks are served in the same cycle and masters
+ * accessing the same bank wait for each other; with the onetoM bus they
+ * always wait for each other and the placement does not matter.
+ *
+ * XHEEP_SECTION_BANK(n) pins an object in the contiguous bank n: the linker
+ * scripts have a section .xheep_bank<n> in each of them, after the code or
+ * after the stack that share the bank, and the link fails if it does not
+ * fit. These sections are neither loaded nor zeroed, they are for buffers
+ * written at run time. n must be a number, not an expression.
+ *
+ * XHEEP_SECTION_INTERLEAVED pins an object in the interleaved banks, where
+ * consecutive words are in consecutive banks. The section is loaded and only
+ * exists in the on-chip linker script, with both contiguous and interleaved
+ * banks (MEMORY_BANKS_IL).
+ *
+ * XHEEP_SECTION_TCM pins an object in the private scratchpad of the core
+ * (tcm of mcu_cfg.hjson, TCM_SIZE), in front of the system crossbar: its
+ * accesses take a cycle and never wait for the other masters. Only the data
+ * port of the core reaches it, not the DMA, the debugger or the instruction
+ * port, so it is for the hot data of the CPU, e.g. the state of a control
+ * loop. The section is neither loaded nor zeroed; without scratchpad it
+ * stays in the RAM, after the stack.
+ *
+ * XHEEP_SECTION_FAST_TEXT and XHEEP_SECTION_FAST_DATA place the hot code
+ * (ISRs, inner loops) and its data in the bank fast_bank of mcu_cfg.hjson,
+ * at its start, with nothing else of the program: their fetches and accesses
+ * do not wait for the DMA working on the buffers of the other banks. They
+ * are loaded like the rest of the code and data; with the flash_exec linker
+ * script, crt0 copies them from the flash to the RAM, so the hot code does
+ * not wait for the flash either. Without fast_bank they stay with the rest
+ * of the code and data, in the RAM with all the linker scripts. Functions
+ * called from the hot code keep their own sections unless marked too.
+ *
+ * XHEEP_SECTION_EXT(name) pins an object in the external slave name of the
+ * ext_slaves entry of mcu_cfg.hjson (NAME_START_ADDRESS), e.g.
+ * XHEEP_SECTION_EXT(slow_memory). The linker scripts have a section
+ * .xheep_ext_<name> in each slave, neither loaded nor zeroed, and the link
+ * fails if it does not fit. Slow slaves (NAME_IS_SLOW) suit buffers moved
+ * by the DMA rather than data the CPU accesses often.
+ *
+ * XHEEP_SECTION_OVERLAY(n) places rarely used code in the overlay n, which
+ * overlays of mcu_cfg.hjson leaves in the flash with the flash linker
+ * scripts: overlay_load of overlay.h copies it to the RAM window shared by
+ * all the overlays before its functions are called. Without overlays, and
+ * with the on-chip linker script, it stays with the rest of the code. n must
+ * be a number, not an expression.
+ *
+ * When the CPU and the DMA run at the same time (see example_bank_conflicts):
+ * - the buffers of the DMA go to contiguous banks holding neither the code
+ *   nor the data of the CPU, e.g. the source and the destination of a copy
+ *   each in a bank of its own;
+ * - the interleaved banks suit several masters streaming through large
+ *   buffers: the accesses spread over the banks and two masters only meet
+ *   in the same bank for a fraction of them, without choosing the banks.
+ */
+#define XHEEP_SECTION_BANK( n )         __attribute__( ( section( XHEEP_SECTION_BANK_NAME( n ) ), aligned( 4 ) ) )
+
+#define XHEEP_SECTION_INTERLEAVED       __attribute__( ( section( ".xheep_data_interleaved" ), aligned( 4 ) ) )
+
+#define XHEEP_SECTION_TCM               __attribute__( ( section( ".tcm" ), aligned( 4 ) ) )
+
+#define XHEEP_SECTION_FAST_TEXT         __attribute__( ( section( ".xheep_text_fast" ), noinline ) )
+
+#define XHEEP_SECTION_FAST_DATA         __attribute__( ( section( ".xheep_data_fast" ), aligned( 4 ) ) )
+
+#define XHEEP_SECTION_EXT( name )       __attribute__( ( section( XHEEP_SECTION_EXT_NAME( name ) ), aligned( 4 ) ) )
+
+#define XHEEP_SECTION_OVERLAY( n )      __attribute__( ( section( XHEEP_SECTION_OVERLAY_NAME( n ) ), noinline ) )
+
+/* The interleaved banks follow the contiguous ones. */
+#define MEMORY_BANKS_IL                 ( MEMORY_BANKS - MEMORY_BANKS_CONT )
+
+#define XHEEP_SECTION_BANK_NAME( n )    XHEEP_SECTION_STRING( .xheep_bank##n )
+#define XHEEP_SECTION_EXT_NAME( name ) XHEEP_SECTION_STRING( .xheep_ext_##name )
+#define XHEEP_SECTION_OVERLAY_NAME( n ) XHEEP_SECTION_STRING( .xheep_overlay##n )
+#define XHEEP_SECTION_STRING( s )       #s
+
+#endif  // BANK_SECTIONS_H_
@@ -9,8 +9,46 @@
 extern "C" {
 #endif  // __cplusplus
 
+#define CPU_TYPE_${cpu_type.upper()}
+
+//cores sharing the system crossbar, hart 0 starts the others through the mailbox
+#define CPU_NUM ${cpu_num}
+
+//event counters of the core, mhpmcounter3 to mhpmcounter(2 + HPM_COUNTERS), with
+//the counter of each event and the mhpmevent of each counter (0 if fixed) for hpm_init
+#define HPM_COUNTERS ${num_mhpmcounters}
+% for name, counter, event in hpm_events:
+#define HPM_COUNTER_${name.upper()} ${counter}
+% endfor
+#define HPM_EVENTS { ${", ".join("0x{:08X}".format(event) for name, counter, event in hpm_events)} }
+
+#define BUS_TYPE_${bus_type.upper()}
+
 #define MEMORY_BANKS ${ram_numbanks}
 
+//RAM banks, the contiguous ones come first, the interleaved ones share the
+//addresses of their region
+#define MEMORY_BANKS_CONT ${ram_numbanks_cont}
+% for bank, (start, size) in enumerate(ram_banks):
+#define MEMORY_BANK${bank}_START_ADDRESS 0x${'{:08X}'.format(start)}
+#define MEMORY_BANK${bank}_SIZE 0x${'{:08X}'.format(size)}
+% endfor
+% if len(set(size for start, size in ram_banks)) == 1:
+//all the banks have this size
+#define MEMORY_BANK_SIZE 0x${'{:08X}'.format(ram_banks[0][1])}
+% endif
+
+#define RAM_START_ADDRESS 0x${ram_start_address}
+#define RAM_SIZE 0x${ram_size_address}
+#define RAM_END_ADDRESS (RAM_START_ADDRESS + RAM_SIZE)
+
+//interleaved banks, at the end of the RAM
+#define RAM_IL_START_ADDRESS 0x${'{:08X}'.format(ram_il_start)}
+#define RAM_IL_SIZE 0x${'{:08X}'.format(ram_il_size)}
+
+//heap of the linker script (heap_size of mcu_cfg.hjson)
+#define HEAP_SIZE 0x${heap_size}
+
 #define EXTERNAL_DOMAINS ${external_domains}
 
 #define DEBUG_START_ADDRESS 0x${debug_start_address}
@@ -29,6 +67,12 @@ extern "C" {
 
 %endfor
 
+//dma channels, each one has DMA_CH_SIZE bytes of registers from DMA_START_ADDRESS
+#define DMA_CH_NUM ${dma_ch_count}
+#define DMA_CH_SIZE 0x${dma_ch_size}
+//channels sharing each copy of dma_memcpy.h, at most one per interleaved bank
+#define DMA_MEMCPY_CHANNELS ${min(dma_memcpy_channels, max(int(ram_numbanks_il), 1))}
+
 //switch-on/off peripherals
 #define PERIPHERAL_START_ADDRESS 0x${peripheral_start_address}
 #define PERIPHERAL_SIZE 0x${peripheral_size_address}
@@ -50,10 +94,74 @@ extern "C" {
 #define EXT_SLAVE_SIZE 0x${ext_slave_size_address}
 #define EXT_SLAVE_END_ADDRESS (EXT_SLAVE_START_ADDRESS + EXT_SLAVE_SIZE)
 
+//slaves of the external crossbar, each with a .xheep_ext_<name> section
+#define EXT_NSLAVE ${len(ext_slaves)}
+% for name, slave in ext_slaves.items():
+#define ${name.upper()}_START_ADDRESS (EXT_SLAVE_START_ADDRESS + 0x${slave['offset']})
+#define ${name.upper()}_SIZE 0x${slave['length']}
+#define ${name.upper()}_END_ADDRESS (${name.upper()}_START_ADDRESS + ${name.upper()}_SIZE)
+% if slave['slow']:
+#define ${name.upper()}_IS_SLOW
+% endif
+% if slave['cacheable']:
+#define ${name.upper()}_IS_CACHEABLE
+% endif
+
+% endfor
+//masters of the external crossbar
+#define EXT_NMASTER ${len(ext_masters)}
+
 #define FLASH_MEM_START_ADDRESS 0x${flash_mem_start_address}
 #define FLASH_MEM_SIZE 0x${flash_mem_size_address}
 #define FLASH_MEM_END_ADDRESS (FLASH_MEM_START_ADDRESS + FLASH_MEM_SIZE)
 
+//read cache of the flash, no cache if 0 ways
+#define FLASH_CACHE_WAYS ${flash_cache_ways}
+#define FLASH_CACHE_SETS ${flash_cache_sets}
+#define FLASH_CACHE_LINE_WORDS ${flash_cache_line_words}
+
+//instruction cache of the core, no cache if 0 ways
+#define ICACHE_WAYS ${icache_ways}
+#define ICACHE_SETS ${icache_sets}
+#define ICACHE_LINE_WORDS ${icache_line_words}
+
+//write-back data cache of the core for a region of the external memory, no cache if 0 ways
+#define DCACHE_WAYS ${dcache_ways}
+#define DCACHE_SETS ${dcache_sets}
+#define DCACHE_LINE_WORDS ${dcache_line_words}
+#define DCACHE_START_ADDRESS 0x${dcache_start_address}
+#define DCACHE_SIZE 0x${dcache_size_address}
+#define DCACHE_END_ADDRESS (DCACHE_START_ADDRESS + DCACHE_SIZE)
+
+//scratchpad private to the data port of the core, none if 0 bytes
+#define TCM_START_ADDRESS 0x${tcm_start_address}
+#define TCM_SIZE 0x${tcm_size_address}
+#define TCM_END_ADDRESS (TCM_START_ADDRESS + TCM_SIZE)
+#define TCM_STACK ${1 if tcm_stack else 0}
+
+//ports of the system crossbar, in the order of the counters of the bus monitor
+#define BUS_MONITOR_COUNTERS ${1 if bus_monitor_counters else 0}
+#define BUS_MONITOR_CORE_INSTR_IDX 0
+#define BUS_MONITOR_CORE_DATA_IDX 1
+#define BUS_MONITOR_DEBUG_MASTER_IDX 2
+#define BUS_MONITOR_DMA_READ_IDX(ch) (3 + 3 * (ch))
+#define BUS_MONITOR_DMA_WRITE_IDX(ch) (4 + 3 * (ch))
+#define BUS_MONITOR_DMA_ADDR_IDX(ch) (5 + 3 * (ch))
+#define BUS_MONITOR_HART_INSTR_IDX(hart) (1 + 3 * DMA_CH_NUM + 2 * (hart))
+#define BUS_MONITOR_HART_DATA_IDX(hart) (2 + 3 * DMA_CH_NUM + 2 * (hart))
+#define SPI_SLAVE ${1 if spi_slave else 0}
+#define BUS_MONITOR_SPI_SLAVE_IDX (1 + 3 * DMA_CH_NUM + 2 * CPU_NUM)
+#define BUS_MONITOR_EXT_MASTER_IDX(i) (1 + 3 * DMA_CH_NUM + 2 * CPU_NUM + SPI_SLAVE + (i))
+#define BUS_MONITOR_ERROR_IDX 0
+#define BUS_MONITOR_RAM_IDX(bank) (1 + (bank))
+#define BUS_MONITOR_DEBUG_IDX ${int(ram_numbanks) + 1}
+#define BUS_MONITOR_AO_PERIPHERAL_IDX ${int(ram_numbanks) + 2}
+#define BUS_MONITOR_PERIPHERAL_IDX ${int(ram_numbanks) + 3}
+#define BUS_MONITOR_FLASH_MEM_IDX ${int(ram_numbanks) + 4}
+
+//entries of the ring of the event trace unit
+#define EVENT_TRACE_DEPTH ${event_trace_depth}
+
 #define QTY_INTR ${len(interrupts)}
 % for key, value in interrupts.items():
 #define ${key.upper()} ${value}
@@ -0,0 +1,216 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_sleep.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   dma_sleep.c
+* @date   14/10/26
+* @brief  Keeps the core asleep, clock-gated or power-gated, while the DMA
+* moves the data.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "dma_sleep.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "hart.h"
+#include "irq.h"
+#include "fast_intr_ctrl.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Wait for the end of the transaction rather than for a window count.
+ */
+#define DMA_SLEEP_NO_WINDOWS    0xFFFFFFFFu
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Enables the wake-up interrupt and sleeps until the channel is done
+ * or has written p_windows windows.
+ * @param p_cfg How to sleep.
+ * @param p_ch The channel to wait for.
+ * @param p_windows The window count, or DMA_SLEEP_NO_WINDOWS.
+ */
+static dma_sleep_result_t sleep_until( const dma_sleep_cfg_t *p_cfg,
+                                       uint8_t               p_ch,
+                                       uint32_t              p_windows );
+
+/**
+ * @brief Whether the DMA has got where sleep_until waits for.
+ */
+static inline bool dma_reached( uint8_t p_ch, uint32_t p_windows );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+dma_sleep_result_t dma_sleep_launch( const dma_sleep_cfg_t *p_cfg,
+                                     dma_trans_t           *p_trans )
+{
+    if( p_trans == NULL || p_trans->channel >= DMA_CH_NUM )
+    {
+        return DMA_SLEEP_BAD_ARG;
+    }
+
+    /* The DMA must raise its interrupt, without dma_launch waiting for it. */
+    p_trans->end = DMA_TRANS_END_INTR;
+    if(     dma_load_transaction( p_trans ) != DMA_CONFIG_OK
+        ||  dma_launch( p_trans ) != DMA_CONFIG_OK )
+    {
+        return DMA_SLEEP_DMA_ERROR;
+    }
+
+    return sleep_until( p_cfg, p_trans->channel, DMA_SLEEP_NO_WINDOWS );
+}
+
+dma_sleep_result_t dma_sleep_launch_chain( const dma_sleep_cfg_t *p_cfg,
+                                           uint8_t               p_ch,
+                                           dma_desc_t            *p_first )
+{
+    if( p_ch >= DMA_CH_NUM )
+    {
+        return DMA_SLEEP_BAD_ARG;
+    }
+
+    if( dma_launch_chain( p_ch, p_first, DMA_TRANS_END_INTR ) != DMA_CONFIG_OK )
+    {
+        return DMA_SLEEP_DMA_ERROR;
+    }
+
+    return sleep_until( p_cfg, p_ch, DMA_SLEEP_NO_WINDOWS );
+}
+
+dma_sleep_result_t dma_sleep_until_done( const dma_sleep_cfg_t *p_cfg,
+                                         uint8_t               p_ch )
+{
+    if( p_ch >= DMA_CH_NUM )
+    {
+        return DMA_SLEEP_BAD_ARG;
+    }
+
+    return sleep_until( p_cfg, p_ch, DMA_SLEEP_NO_WINDOWS );
+}
+
+dma_sleep_result_t dma_sleep_until_windows( const dma_sleep_cfg_t *p_cfg,
+                                            uint8_t               p_ch,
+                                            uint32_t              p_windows )
+{
+    if( p_ch >= DMA_CH_NUM || p_windows == DMA_SLEEP_NO_WINDOWS )
+    {
+        return DMA_SLEEP_BAD_ARG;
+    }
+
+    return sleep_until( p_cfg, p_ch, p_windows );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static dma_sleep_result_t sleep_until( const dma_sleep_cfg_t *p_cfg,
+                                       uint8_t               p_ch,
+                                       uint32_t              p_windows )
+{
+    if(     ( p_cfg == NULL )
+        ||  ( p_cfg->mode == DMA_SLEEP_POWER_GATE
+              && ( p_cfg->power_manager == NULL || p_cfg->cpu_counters == NULL ) ) )
+    {
+        return DMA_SLEEP_BAD_ARG;
+    }
+
+    /*
+     * The transaction done interrupt is a fast interrupt, the window done
+     * interrupt goes through the PLIC. Either must be enabled in mie for the
+     * wfi to end, mstatus.MIE does not matter.
+     */
+    power_manager_sel_intr_t wake;
+    if( p_windows == DMA_SLEEP_NO_WINDOWS )
+    {
+        irq_set_enabled( IRQ_SRC_FAST( kDma_fic_e ), true );
+        wake = kDma_pm_e;
+    }
+    else
+    {
+        irq_set_enabled( IRQ_SRC_PLIC( DMA_WINDOW_INTR ), true );
+        wake = kPlic_pm_e;
+    }
+
+    dma_sleep_result_t res = DMA_SLEEP_OK;
+    uint32_t mstatus = irq_save();
+    while( !dma_reached( p_ch, p_windows ) )
+    {
+        if( p_cfg->mode == DMA_SLEEP_POWER_GATE )
+        {
+            if( power_gate_core( p_cfg->power_manager, wake, p_cfg->cpu_counters ) != kPowerManagerOk_e )
+            {
+                res = DMA_SLEEP_POWER_ERROR;
+                break;
+            }
+        }
+        else
+        {
+            wait_for_interrupt();
+        }
+        /* The interrupt that woke the core up is taken here. */
+        CSR_SET_BITS( CSR_REG_MSTATUS, IRQ_MSTATUS_MIE );
+        CSR_CLEAR_BITS( CSR_REG_MSTATUS, IRQ_MSTATUS_MIE );
+    }
+
+    irq_restore( mstatus );
+    return res;
+}
+
+static inline bool dma_reached( uint8_t p_ch, uint32_t p_windows )
+{
+    if( dma_is_ready( p_ch ) )
+    {
+        return true;
+    }
+    return p_windows != DMA_SLEEP_NO_WINDOWS
+        && dma_get_window_count( p_ch ) >= p_windows;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,177 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : dma_sleep.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   dma_sleep.h
+* @date   14/10/26
+* @brief  Keeps the core asleep, clock-gated or power-gated, while the DMA
+* moves the data.
+*
+* The functions below launch a DMA transaction or chain, or take one already
+* running, e.g. a read of spi_flash_read_async, and put the core to sleep
+* until it is done, or until a number of its windows are. They enable the
+* interrupt that ends the sleep themselves: the transaction done fast
+* interrupt, or the window done interrupt of the PLIC, which must then be
+* initialized (plic_Init) and DMA_WINDOW_INTR given a priority above the
+* threshold. With DMA_SLEEP_POWER_GATE, the same interrupt is the wake-up
+* source of the power manager.
+*
+* The interrupts are disabled (mstatus.MIE) between the check of the DMA and
+* the sleep, so the last one cannot be missed, and enabled after each
+* wake-up, so their handlers run as usual, e.g. the callbacks of the other
+* channels or of the timers, which may end the sleep early: the DMA is checked
+* again and the core goes back to sleep until it is done. mstatus.MIE is
+* restored on return.
+*
+* With DMA_SLEEP_POWER_GATE, the core only wakes up for the DMA: the other
+* interrupts are taken once the DMA is done. The window done interrupt
+* reaches the core through the PLIC, in the peripheral domain, which must not
+* be clock-gated meanwhile (clock_gate.h).
+*/
+
+#ifndef _DMA_SLEEP_H_
+#define _DMA_SLEEP_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+
+#include "dma.h"
+#include "power_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * How the core sleeps.
+ */
+typedef enum
+{
+    DMA_SLEEP_WFI           = 0, /*!< wfi: the core stops and its clock is
+    gated until an enabled interrupt arrives. */
+    DMA_SLEEP_POWER_GATE    = 1, /*!< The core is power-gated by the power
+    manager, its state kept in memory, until the DMA interrupt. */
+} dma_sleep_mode_t;
+
+/**
+ * Results of the dma_sleep functions.
+ */
+typedef enum
+{
+    DMA_SLEEP_OK            = 0, /*!< The DMA is done. */
+    DMA_SLEEP_BAD_ARG       = 1, /*!< Bad channel, or configuration without
+    power manager for DMA_SLEEP_POWER_GATE. */
+    DMA_SLEEP_DMA_ERROR     = 2, /*!< The transaction could not be launched. */
+    DMA_SLEEP_POWER_ERROR   = 3, /*!< The power manager refused to gate the
+    core. */
+} dma_sleep_result_t;
+
+/**
+ * How to sleep. The configuration is only read during the calls.
+ */
+typedef struct
+{
+    dma_sleep_mode_t            mode;
+    const power_manager_t       *power_manager; /*!< Used with
+    DMA_SLEEP_POWER_GATE, ignored otherwise. */
+    power_manager_counters_t    *cpu_counters;  /*!< The counters of the
+    CPU domain (power_gate_counters_init), with DMA_SLEEP_POWER_GATE. */
+} dma_sleep_cfg_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Loads and launches a transaction, and sleeps until it is done.
+ * @param p_cfg How to sleep.
+ * @param p_trans A transaction validated with dma_validate_transaction().
+ * Its end event is set to DMA_TRANS_END_INTR. Its window done interrupts, if
+ * enabled, are handled on the way with DMA_SLEEP_WFI, and after the
+ * transaction with DMA_SLEEP_POWER_GATE.
+ * @return DMA_SLEEP_OK once the transaction is done, or the error.
+ */
+dma_sleep_result_t dma_sleep_launch( const dma_sleep_cfg_t *p_cfg,
+                                     dma_trans_t           *p_trans );
+
+/**
+ * @brief Launches a chain of descriptors (dma_launch_chain), and sleeps
+ * until the whole chain is done. The flagged descriptors wake the core up
+ * on the way, for their interrupts to be handled.
+ * @param p_cfg How to sleep.
+ * @param p_ch The channel that performs the chain.
+ * @param p_first The first descriptor of the chain.
+ * @return DMA_SLEEP_OK once the chain is done, or the error.
+ */
+dma_sleep_result_t dma_sleep_launch_chain( const dma_sleep_cfg_t *p_cfg,
+                                           uint8_t               p_ch,
+                                           dma_desc_t            *p_first );
+
+/**
+ * @brief Sleeps until the transaction or chain running in a channel is done.
+ * It must have been launched with an interrupt end event. Returns at once if
+ * the channel is idle.
+ * @param p_cfg How to sleep.
+ * @param p_ch The channel to wait for.
+ * @return DMA_SLEEP_OK once the channel is idle, or the error.
+ */
+dma_sleep_result_t dma_sleep_until_done( const dma_sleep_cfg_t *p_cfg,
+                                         uint8_t               p_ch );
+
+/**
+ * @brief Sleeps until the transaction running in a channel has written a
+ * number of windows (dma_get_window_count), or is done. It must have been
+ * launched with an interrupt end event and a window. With
+ * DMA_SLEEP_POWER_GATE, only the window done interrupt wakes the core up, so
+ * the size of the transaction must be a multiple of its window.
+ * @param p_cfg How to sleep.
+ * @param p_ch The channel to wait for.
+ * @param p_windows The window count to wait for, from the start of the
+ * transaction.
+ * @return DMA_SLEEP_OK once the windows are written, or the error.
+ */
+dma_sleep_result_t dma_sleep_until_windows( const dma_sleep_cfg_t *p_cfg,
+                                            uint8_t               p_ch,
+                                            uint32_t              p_windows );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _DMA_SLEEP_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,182 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : exec.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   exec.c
+* @date   14/10/26
+* @brief  Cooperative executor of stackless tasks.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stddef.h>
+
+#include "exec.h"
+
+#include "csr.h"
+#include "irq.h"
+#include "hart.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Appends a task to the ready queue. It must be called with the
+ * interrupts disabled.
+ */
+static void exec_ready( exec_task_t *p_task );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            GLOBAL VARIABLES                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The ready queue, appended to by the handlers.
+ */
+static exec_task_t *exec_head;
+static exec_task_t *exec_tail;
+
+/**
+ * The tasks started and not done yet.
+ */
+static uint32_t exec_active_n;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void exec_start( exec_task_t *p_task, exec_fn_t p_fn, void *p_ctx )
+{
+    p_task->fn     = p_fn;
+    p_task->ctx    = p_ctx;
+    p_task->events = 0;
+    p_task->wait   = 0;
+    p_task->got    = 0;
+    p_task->resume = 0;
+    p_task->done   = false;
+
+    uint32_t mstatus = irq_save();
+    exec_active_n++;
+    exec_ready( p_task );
+    irq_restore( mstatus );
+}
+
+void exec_post( exec_task_t *p_task, uint32_t p_events )
+{
+    uint32_t mstatus = irq_save();
+    p_task->events |= p_events;
+    if( ( p_task->events & p_task->wait ) && !p_task->ready && !p_task->done )
+    {
+        exec_ready( p_task );
+    }
+    irq_restore( mstatus );
+}
+
+void exec_run( void )
+{
+    for( ;; )
+    {
+        uint32_t    mstatus = irq_save();
+        exec_task_t *task   = exec_head;
+
+        if( task != NULL )
+        {
+            exec_head = task->next;
+            if( exec_head == NULL ) exec_tail = NULL;
+            task->ready = false;
+            irq_restore( mstatus );
+
+            if( task->fn( task ) == EXEC_DONE )
+            {
+                task->done = true;
+                task->wait = 0;
+                mstatus = irq_save();
+                exec_active_n--;
+                irq_restore( mstatus );
+            }
+            continue;
+        }
+
+        if( exec_active_n == 0 )
+        {
+            irq_restore( mstatus );
+            return;
+        }
+
+        /*
+         * The queue was found empty with the interrupts disabled, so the
+         * interrupt making a task ready wakes the core up from the wfi, and
+         * is taken once they are enabled.
+         */
+        wait_for_interrupt();
+        CSR_SET_BITS( CSR_REG_MSTATUS, IRQ_MSTATUS_MIE );
+        irq_restore( mstatus );
+    }
+}
+
+bool exec_take( exec_task_t *p_task )
+{
+    uint32_t mstatus = irq_save();
+    p_task->got     = p_task->events & p_task->wait;
+    p_task->events &= ~p_task->got;
+    irq_restore( mstatus );
+
+    if( p_task->got == 0 ) return false;
+    p_task->wait = 0;
+    return true;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void exec_ready( exec_task_t *p_task )
+{
+    p_task->next  = NULL;
+    p_task->ready = true;
+    if( exec_tail != NULL ) exec_tail->next = p_task;
+    else                    exec_head       = p_task;
+    exec_tail = p_task;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
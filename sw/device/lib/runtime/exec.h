@@ -0,0 +1,220 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : exec.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   exec.h
+* @date   14/10/26
+* @brief  Cooperative executor of stackless tasks, driven by the events that
+* the interrupt handlers post.
+*
+* A task is a function that is called again each time it is resumed, and
+* wrapped in EXEC_BEGIN and EXEC_END. In between, EXEC_WAIT returns from the
+* function until one of the events it waits for is posted, and the next call
+* continues right after it: the task runs as a thread without a stack of its
+* own. Its local variables are lost at each wait, the ones that must survive
+* go in a structure of the application, reached through the ctx of the task.
+* The waits are switch cases, so they cannot be inside another switch of
+* the task.
+*
+* The events of a task are the bits of a word, posted with exec_post from the
+* handlers, e.g. from dma_intr_handler_trans_done, the callback of a
+* dma_submit, fic_irq_spi, fic_irq_gpio_* or fic_irq_timer_*, or by the other
+* tasks. A task that is posted an event it waits for is appended to the
+* ready queue. exec_run calls the ready tasks one after the other, and sleeps
+* in wfi while the queue is empty, until all the tasks are done.
+*
+* Each task takes sizeof( exec_task_t ) bytes, the executor a few words, and
+* all the tasks share the stack of main. A single executor runs, on one hart.
+*/
+
+#ifndef _EXEC_H_
+#define _EXEC_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The event posted by EXEC_YIELD, not to be used by the application.
+ */
+#define EXEC_EVENT_YIELD    0x80000000u
+
+/**
+ * Starts the body of a task function.
+ */
+#define EXEC_BEGIN( p_task )                                                \
+    switch( (p_task)->resume )                                              \
+    {                                                                       \
+        case 0:
+
+/**
+ * Ends the body of a task function: the task is done.
+ */
+#define EXEC_END( p_task )                                                  \
+    }                                                                       \
+    return EXEC_DONE
+
+/**
+ * Waits until one of the events of p_mask is posted. The events received
+ * are in the got field of the task, and are no longer pending. It does not
+ * wait if one was posted before.
+ */
+#define EXEC_WAIT( p_task, p_mask )                                         \
+    do                                                                      \
+    {                                                                       \
+        (p_task)->wait   = (p_mask);                                        \
+        (p_task)->resume = __LINE__;                                        \
+        case __LINE__:                                                      \
+        if( !exec_take( p_task ) ) return EXEC_WAITING;                     \
+    } while( 0 )
+
+/**
+ * Waits until a condition holds, checking it each time one of the events of
+ * p_mask is posted.
+ */
+#define EXEC_WAIT_UNTIL( p_task, p_mask, p_cond )                           \
+    do                                                                      \
+    {                                                                       \
+        while( !( p_cond ) ) EXEC_WAIT( p_task, p_mask );                   \
+    } while( 0 )
+
+/**
+ * Lets the other ready tasks run, and continues after them.
+ */
+#define EXEC_YIELD( p_task )                                                \
+    do                                                                      \
+    {                                                                       \
+        (p_task)->wait   = EXEC_EVENT_YIELD;                                \
+        (p_task)->resume = __LINE__;                                        \
+        exec_post( (p_task), EXEC_EVENT_YIELD );                            \
+        return EXEC_WAITING;                                                \
+        case __LINE__:                                                      \
+        exec_take( p_task );                                                \
+    } while( 0 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * What a task function returns.
+ */
+typedef enum
+{
+    EXEC_WAITING    = 0,    /*!< The task waits for an event. */
+    EXEC_DONE       = 1,    /*!< The task is done. */
+} exec_state_t;
+
+struct exec_task;
+
+/**
+ * A task function, given its task.
+ */
+typedef exec_state_t (*exec_fn_t)( struct exec_task *p_task );
+
+/**
+ * A task. Its fields are managed by the executor and the macros above, but
+ * got and ctx, which the task reads.
+ */
+typedef struct exec_task
+{
+    struct exec_task    *next;      /*!< Next task of the ready queue. */
+    exec_fn_t           fn;
+    void                *ctx;       /*!< Context of the application. */
+    volatile uint32_t   events;     /*!< Events posted and not received. */
+    uint32_t            wait;       /*!< Events waited for. */
+    uint32_t            got;        /*!< Events received by the last wait. */
+    uint16_t            resume;     /*!< Line of the wait to resume, 0 at the
+    start. */
+    volatile bool       ready;      /*!< Whether the task is in the ready
+    queue. */
+    bool                done;
+} exec_task_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts a task: it is appended to the ready queue.
+ * @param p_task The task, it must stay in memory until it is done.
+ * @param p_fn Its function.
+ * @param p_ctx Its context, given in p_task->ctx.
+ */
+void exec_start( exec_task_t *p_task, exec_fn_t p_fn, void *p_ctx );
+
+/**
+ * @brief Posts events to a task, from a handler or from a task. The task is
+ * made ready if it waits for one of them, else they stay pending.
+ */
+void exec_post( exec_task_t *p_task, uint32_t p_events );
+
+/**
+ * @brief Runs the ready tasks, and sleeps while there are none, until all
+ * the tasks started are done. The interrupts of the events must be enabled
+ * in mie: mstatus.MIE is set after each wfi, to take the interrupt that woke
+ * the core up, and left as it was for the tasks.
+ */
+void exec_run( void );
+
+/**
+ * @brief Receives the waited events of a task, used by EXEC_WAIT.
+ * @return Whether there was one.
+ */
+bool exec_take( exec_task_t *p_task );
+
+/**
+ * @brief Returns whether a task is done.
+ */
+static inline bool exec_done( const exec_task_t *p_task )
+{
+    return p_task->done;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _EXEC_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
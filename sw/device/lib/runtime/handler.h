@@ -32,7 +32,14 @@ typedef enum exc_id {
 // You only need to use this ABI for handlers that are the first function called
 // in an interrupt handler. Subsequent functions can just use the regular RISC-V
 // calling convention.
-#define INTERRUPT_HANDLER_ABI __attribute__((aligned(4), interrupt))
+//
+// The handlers go to the section .xheep_isr, with the vector table: in the
+// RAM with all the linker scripts, copied there by crt0 with the flash_exec
+// one, where the rest of the code runs from the flash. The functions they
+// call stay in the flash unless marked with XHEEP_SECTION_FAST_TEXT of
+// bank_sections.h.
+#define INTERRUPT_HANDLER_ABI \
+  __attribute__((aligned(4), interrupt, section(".xheep_isr")))
 
 // The following `handler_*` functions have weak definitions, provided by
 // `handler.c`. This weak definition can be overriden at link-time by providing
@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_RUNTIME_HART_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdnoreturn.h>
 
 #include "stdasm.h"
@@ -24,4 +25,24 @@
  */
 inline void wait_for_interrupt(void) { asm volatile("wfi"); }
 
+/**
+ * Returns the ID of the calling hart (mhartid): 0 for the hart running main,
+ * 1 to CPU_NUM - 1 for the secondary harts of a multi-core X-HEEP.
+ */
+inline uint32_t hart_get_id(void) {
+  uint32_t hart_id;
+  asm volatile("csrr %0, mhartid" : "=r"(hart_id));
+  return hart_id;
+}
+
+/**
+ * Entry point of the secondary harts, called by crt0 with their own stack
+ * once hart 0 starts them with mailbox_hart_start(). The weak default of
+ * crt0 waits for interrupts forever, as the secondary harts do when it
+ * returns.
+ *
+ * @param hart_id ID of the hart, from 1 to CPU_NUM - 1.
+ */
+void hart_main(uint32_t hart_id);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_RUNTIME_HART_H_
@@ -0,0 +1,197 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : hpm.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   hpm.c
+* @date   14/10/26
+* @brief  Event counters of the core, mhpmcounter3 on.
+*
+* The CSRs are encoded in the instructions, so each access dispatches the
+* counter to the instruction of its CSR.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "hpm.h"
+
+#include "csr.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The inhibit bits of the event counters in mcountinhibit.
+ */
+#define HPM_INHIBIT_MASK    ( ( ( 1u << HPM_COUNTERS ) - 1 ) << HPM_FIRST_COUNTER )
+
+/**
+ * Applies X to the numbers of the event counters.
+ */
+#define HPM_FOR_EACH_COUNTER( X )                                           \
+    X( 3 )  X( 4 )  X( 5 )  X( 6 )  X( 7 )  X( 8 )  X( 9 )  X( 10 )         \
+    X( 11 ) X( 12 ) X( 13 ) X( 14 ) X( 15 ) X( 16 ) X( 17 ) X( 18 )         \
+    X( 19 ) X( 20 ) X( 21 ) X( 22 ) X( 23 ) X( 24 ) X( 25 ) X( 26 )         \
+    X( 27 ) X( 28 ) X( 29 ) X( 30 ) X( 31 )
+
+/**
+ * Reads a 64-bit counter, the high half again if the low half wrapped.
+ */
+#define HPM_READ_CASE( n )                                                  \
+    case n:                                                                 \
+    {                                                                       \
+        uint32_t high_, low_, high_again_;                                  \
+        do                                                                  \
+        {                                                                   \
+            CSR_READ( CSR_REG_MHPMCOUNTER##n##H, &high_ );                  \
+            CSR_READ( CSR_REG_MHPMCOUNTER##n, &low_ );                      \
+            CSR_READ( CSR_REG_MHPMCOUNTER##n##H, &high_again_ );            \
+        } while( high_ != high_again_ );                                    \
+        return ( (uint64_t) high_ << 32 ) | low_;                           \
+    }
+
+#define HPM_CLEAR_CASE( n )                                                 \
+    case n:                                                                 \
+        CSR_WRITE( CSR_REG_MHPMCOUNTER##n, 0 );                             \
+        CSR_WRITE( CSR_REG_MHPMCOUNTER##n##H, 0 );                          \
+        break;
+
+#define HPM_EVENT_CASE( n )                                                 \
+    case n:                                                                 \
+        CSR_WRITE( CSR_REG_MHPMEVENT##n, p_event );                         \
+        break;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+static void hpm_clear_counter( uint32_t p_counter );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           LOCAL VARIABLES                                */
+/**                                                                        **/
+/****************************************************************************/
+
+#if HPM_COUNTERS > 0
+static const uint32_t hpm_events[ HPM_COUNTERS ] = HPM_EVENTS;
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+void hpm_init( void )
+{
+    hpm_enable( false );
+#if HPM_COUNTERS > 0
+    for( uint32_t i = 0; i < HPM_COUNTERS; i++ )
+    {
+        hpm_set_event( HPM_FIRST_COUNTER + i, hpm_events[ i ] );
+    }
+#endif
+    hpm_clear();
+    hpm_enable( true );
+}
+
+void hpm_set_event( uint32_t p_counter, uint32_t p_event )
+{
+#if defined(CPU_TYPE_CV32E20)
+    (void) p_counter;
+    (void) p_event;
+#else
+    switch( p_counter )
+    {
+        HPM_FOR_EACH_COUNTER( HPM_EVENT_CASE )
+        default:
+            break;
+    }
+#endif
+}
+
+void hpm_enable( bool p_enable )
+{
+    if( p_enable )
+    {
+        CSR_CLEAR_BITS( CSR_REG_MCOUNTINHIBIT, HPM_INHIBIT_MASK );
+    }
+    else
+    {
+        CSR_SET_BITS( CSR_REG_MCOUNTINHIBIT, HPM_INHIBIT_MASK );
+    }
+}
+
+void hpm_clear( void )
+{
+    for( uint32_t i = 0; i < HPM_COUNTERS; i++ )
+    {
+        hpm_clear_counter( HPM_FIRST_COUNTER + i );
+    }
+}
+
+uint64_t hpm_read( uint32_t p_counter )
+{
+    switch( p_counter )
+    {
+        HPM_FOR_EACH_COUNTER( HPM_READ_CASE )
+        default:
+            return 0;
+    }
+}
+
+void hpm_read_all( uint64_t *p_values )
+{
+    for( uint32_t i = 0; i < HPM_COUNTERS; i++ )
+    {
+        p_values[ i ] = hpm_read( HPM_FIRST_COUNTER + i );
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void hpm_clear_counter( uint32_t p_counter )
+{
+    switch( p_counter )
+    {
+        HPM_FOR_EACH_COUNTER( HPM_CLEAR_CASE )
+        default:
+            break;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,120 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : hpm.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   hpm.h
+* @date   14/10/26
+* @brief  Event counters of the core, mhpmcounter3 on.
+*
+* The core has HPM_COUNTERS event counters, set by hpm_events in
+* mcu_cfg.hjson, and core_v_mini_mcu.h gives the counter of each configured
+* event, e.g. HPM_COUNTER_LOAD_STALL. hpm_init selects the configured events
+* and starts the counters, which then run freely: the counts of a piece of
+* code are the differences of two hpm_read_all.
+*
+* The counters of the cv32e20 count fixed events, in the order of
+* mcu_cfg.hjson. Those of the cv32e40p(x) and cv32e40x can count any event of
+* their core (the PERF_EVENT_* of perf.h) with hpm_set_event. perf.h uses
+* mhpmcounter3 for its regions.
+*/
+
+#ifndef _HPM_H_
+#define _HPM_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The first event counter.
+ */
+#define HPM_FIRST_COUNTER   3
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Selects the events of mcu_cfg.hjson, clears the counters and starts
+ * them.
+ */
+void hpm_init( void );
+
+/**
+ * @brief Selects the event of a counter, ignored on the cv32e20.
+ * @param p_counter The counter, from HPM_FIRST_COUNTER to
+ * HPM_FIRST_COUNTER + HPM_COUNTERS - 1.
+ * @param p_event A PERF_EVENT_* of perf.h, or several of them or-ed.
+ */
+void hpm_set_event( uint32_t p_counter, uint32_t p_event );
+
+/**
+ * @brief Starts or stops all the event counters.
+ */
+void hpm_enable( bool p_enable );
+
+/**
+ * @brief Clears all the event counters.
+ */
+void hpm_clear( void );
+
+/**
+ * @brief Reads a counter.
+ * @param p_counter The counter, e.g. HPM_COUNTER_LOAD_STALL.
+ * @return Its count, 0 for a counter the core does not have.
+ */
+uint64_t hpm_read( uint32_t p_counter );
+
+/**
+ * @brief Reads all the event counters.
+ * @param p_values HPM_COUNTERS values, that of mhpmcounter3 first.
+ */
+void hpm_read_all( uint64_t *p_values );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _HPM_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
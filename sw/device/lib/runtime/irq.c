@@ -0,0 +1,140 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : irq.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   irq.c
+* @date   14/10/26
+* @brief  A single API to register the handlers of the PLIC and fast
+* interrupts.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "irq.h"
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "fast_intr_ctrl.h"
+#include "rv_plic.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The machine external interrupt bit of mie.
+ */
+#define IRQ_MIE_MEIE        ( 1u << 11 )
+
+/**
+ * The bit of the first fast interrupt in mie.
+ */
+#define IRQ_MIE_FAST_FIRST  16
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+irq_result_t irq_register( uint32_t p_src, irq_handler_t p_handler )
+{
+    if( p_src & IRQ_SRC_FAST_FLAG )
+    {
+        fast_intr_ctrl_result_t res = fic_assign_irq_handler(
+            (fast_intr_ctrl_fast_interrupt_t)( p_src & ~IRQ_SRC_FAST_FLAG ),
+            p_handler );
+        return res == kFastIntrCtrlOk_e ? IRQ_OK : IRQ_BAD_SRC;
+    }
+
+    return plic_assign_irq_handler( p_src, p_handler ) == kPlicOk ? IRQ_OK
+                                                                : IRQ_BAD_SRC;
+}
+
+irq_result_t irq_set_enabled( uint32_t p_src, bool p_enable )
+{
+    if( p_src & IRQ_SRC_FAST_FLAG )
+    {
+        uint32_t fic = p_src & ~IRQ_SRC_FAST_FLAG;
+        if( fic >= FAST_INTR_CTRL_IRQ_N )
+        {
+            return IRQ_BAD_SRC;
+        }
+        enable_fast_interrupt( (fast_intr_ctrl_fast_interrupt_t)fic, p_enable );
+        if( p_enable )
+        {
+            CSR_SET_BITS( CSR_REG_MIE, 1u << ( IRQ_MIE_FAST_FIRST + fic ) );
+        }
+        else
+        {
+            CSR_CLEAR_BITS( CSR_REG_MIE, 1u << ( IRQ_MIE_FAST_FIRST + fic ) );
+        }
+        return IRQ_OK;
+    }
+
+    if( p_src == NULL_INTR
+        || plic_irq_set_enabled( p_src, p_enable ? kPlicToggleEnabled
+                                                 : kPlicToggleDisabled )
+           != kPlicOk )
+    {
+        return IRQ_BAD_SRC;
+    }
+    // mie.MEIE is shared by all the PLIC sources, it is only set
+    if( p_enable )
+    {
+        CSR_SET_BITS( CSR_REG_MIE, IRQ_MIE_MEIE );
+    }
+    return IRQ_OK;
+}
+
+irq_result_t irq_set_priority( uint32_t p_src, uint32_t p_priority )
+{
+    if( p_src & IRQ_SRC_FAST_FLAG )
+    {
+        if( p_priority > UINT8_MAX )
+        {
+            return IRQ_BAD_SRC;
+        }
+        fast_intr_ctrl_result_t res = fic_set_priority(
+            (fast_intr_ctrl_fast_interrupt_t)( p_src & ~IRQ_SRC_FAST_FLAG ),
+            (uint8_t)p_priority );
+        return res == kFastIntrCtrlOk_e ? IRQ_OK : IRQ_BAD_SRC;
+    }
+
+    return plic_irq_set_priority( p_src, p_priority ) == kPlicOk ? IRQ_OK
+                                                                : IRQ_BAD_SRC;
+}
+
+void irq_set_nesting( bool p_enable )
+{
+    plic_set_nested_irq( p_enable );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,181 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : irq.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   irq.h
+* @date   14/10/26
+* @brief  A single API to register the handlers of the PLIC and fast
+* interrupts.
+*
+* The vector table jumps straight to one entry per interrupt of the core:
+* handler_irq_external for the PLIC, which claims the source and calls the
+* handler of its ID, and handler_irq_fast_* for each fast interrupt, which
+* clears it and calls its handler. irq_register sets the handler in either
+* table, the handler gets the PLIC ID or the fast interrupt as argument.
+*
+* The handlers registered here run behind an entry that saves all the
+* caller-saved registers. For the lowest latency, an application can instead
+* define the vector entry itself, see fic_assign_irq_handler.
+*/
+
+#ifndef _IRQ_H_
+#define _IRQ_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "csr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Flag of the fast interrupt sources.
+ */
+#define IRQ_SRC_FAST_FLAG   ( 1u << 16 )
+
+/**
+ * The source of a PLIC interrupt, from its ID in core_v_mini_mcu.h.
+ */
+#define IRQ_SRC_PLIC( id )  ( (uint32_t)( id ) )
+
+/**
+ * The source of a fast interrupt, from its fast_intr_ctrl_fast_interrupt_t.
+ */
+#define IRQ_SRC_FAST( fic ) ( IRQ_SRC_FAST_FLAG | (uint32_t)( fic ) )
+
+/**
+ * The machine interrupt enable bit of mstatus.
+ */
+#define IRQ_MSTATUS_MIE     0x8
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * An interrupt handler. It receives the PLIC ID or the fast interrupt that
+ * called it.
+ */
+typedef void (*irq_handler_t)( uint32_t p_id );
+
+/**
+ * Results of the irq functions.
+ */
+typedef enum
+{
+    IRQ_OK      = 0,    /*!< Done. */
+    IRQ_BAD_SRC = 1,    /*!< The source does not exist. */
+} irq_result_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Registers the handler of an interrupt source. plic_Init resets the
+ * PLIC handlers, so they must be registered after it.
+ * @param p_src IRQ_SRC_PLIC(id) or IRQ_SRC_FAST(fic).
+ * @param p_handler The handler, NULL to restore the pre-set one.
+ * @return IRQ_OK, or IRQ_BAD_SRC.
+ */
+irq_result_t irq_register( uint32_t p_src, irq_handler_t p_handler );
+
+/**
+ * @brief Enables or disables an interrupt source: in the PLIC or FIC, and in
+ * the mie register when enabling. mstatus.MIE is left to the application, as
+ * the PLIC priority of the source.
+ * @param p_src IRQ_SRC_PLIC(id) or IRQ_SRC_FAST(fic).
+ * @param p_enable true to enable the source, false to disable it.
+ * @return IRQ_OK, or IRQ_BAD_SRC.
+ */
+irq_result_t irq_set_enabled( uint32_t p_src, bool p_enable );
+
+/**
+ * @brief Sets the priority of an interrupt source: plic_irq_set_priority or
+ * fic_set_priority. With the nesting enabled, a handler is preempted by the
+ * sources of a higher priority of the same kind, and the PLIC handlers by the
+ * fast interrupts.
+ * @param p_src IRQ_SRC_PLIC(id) or IRQ_SRC_FAST(fic).
+ * @param p_priority The priority, 0 to plicMaxPriority for the PLIC (0 never
+ * raises the interrupt), 0 for a fast interrupt that is not preempted.
+ * @return IRQ_OK, or IRQ_BAD_SRC if the source or priority is not valid.
+ */
+irq_result_t irq_set_priority( uint32_t p_src, uint32_t p_priority );
+
+/**
+ * @brief Enables the nesting of the PLIC interrupts, see plic_set_nested_irq.
+ * The fast interrupts are nested as soon as they have a priority.
+ * @param p_enable true to nest the PLIC interrupts.
+ */
+void irq_set_nesting( bool p_enable );
+
+/**
+ * @brief Disables the interrupts of the core for a critical section, which
+ * may be entered with the interrupts already disabled, e.g. from a handler or
+ * a callback.
+ * @return The previous mstatus, for irq_restore.
+ */
+static inline uint32_t irq_save( void )
+{
+    uint32_t mstatus;
+    CSR_READ( CSR_REG_MSTATUS, &mstatus );
+    CSR_CLEAR_BITS( CSR_REG_MSTATUS, IRQ_MSTATUS_MIE );
+    return mstatus;
+}
+
+/**
+ * @brief Ends a critical section: enables the interrupts again only if they
+ * were enabled in p_mstatus.
+ * @param p_mstatus The value returned by irq_save.
+ */
+static inline void irq_restore( uint32_t p_mstatus )
+{
+    CSR_SET_BITS( CSR_REG_MSTATUS, p_mstatus & IRQ_MSTATUS_MIE );
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _IRQ_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,150 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : mem_usage.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   mem_usage.c
+* @date   14/10/26
+* @brief  High-water marks of the stack and of the heap.
+*
+* The regions come from the linker scripts. The scans only go over the words
+* still painted, from the word found by the previous call, since a word
+* changed never counts as painted again.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "mem_usage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "syscalls.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Prints the line of a region.
+ */
+static void mem_usage_print( const char *p_name, const mem_usage_region_t *p_region );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           GLOBAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+/* Provided by the linker scripts */
+extern uint32_t __stack_start[], __stack_end[];
+extern uint32_t __heap_start[], __heap_end[];
+
+#ifdef CRT0_PAINT
+/* The lowest word of the stack and the word past the highest one of the heap
+ * changed so far */
+static uint32_t *stack_low = __stack_end;
+static uint32_t *heap_high = __heap_start;
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+void mem_usage_get( mem_usage_t *p_usage )
+{
+    p_usage->stack.size = (uint32_t)( (char *)__stack_end - (char *)__stack_start );
+    p_usage->heap.size  = (uint32_t)( (char *)__heap_end - (char *)__heap_start );
+    p_usage->sbrk.size  = p_usage->heap.size;
+    p_usage->sbrk.used  = (uint32_t)( (char *)heap_high_water() - (char *)__heap_start );
+
+#ifdef CRT0_PAINT
+    uint32_t *word;
+
+    /* The stack grows down: the words below the lowest one changed are
+     * scanned up from the start. */
+    for( word = __stack_start; word < stack_low && *word == MEM_USAGE_PAINT; word++ );
+    stack_low = word;
+
+    /* The heap grows up, but the blocks freed keep their content: the words
+     * above the highest one changed are scanned down from the end. */
+    for( word = __heap_end; word > heap_high && word[-1] == MEM_USAGE_PAINT; word-- );
+    heap_high = word;
+
+    p_usage->painted    = true;
+    p_usage->stack.used = (uint32_t)( (char *)__stack_end - (char *)stack_low );
+    p_usage->heap.used  = (uint32_t)( (char *)heap_high - (char *)__heap_start );
+#else
+    p_usage->painted    = false;
+    p_usage->stack.used = 0;
+    p_usage->heap.used  = p_usage->sbrk.used;
+#endif
+}
+
+void mem_usage_dump( void )
+{
+    mem_usage_t usage;
+
+    mem_usage_get( &usage );
+
+    printf( "MEM,region,size,used,free\n\r" );
+    if( usage.painted )
+    {
+        mem_usage_print( "stack", &usage.stack );
+        mem_usage_print( "heap", &usage.heap );
+    }
+    mem_usage_print( "sbrk", &usage.sbrk );
+}
+
+void mem_usage_dump_at_exit( void )
+{
+    static bool registered = false;
+
+    if( !registered )
+    {
+        registered = atexit( mem_usage_dump ) == 0;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void mem_usage_print( const char *p_name, const mem_usage_region_t *p_region )
+{
+    printf( "MEM,%s,%u,%u,%u\n\r", p_name, (unsigned int) p_region->size,
+            (unsigned int) p_region->used,
+            (unsigned int) ( p_region->size - p_region->used ) );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
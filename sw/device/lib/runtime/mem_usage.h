@@ -0,0 +1,130 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : mem_usage.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   mem_usage.h
+* @date   14/10/26
+* @brief  High-water marks of the stack and of the heap.
+*
+* Built with CRT_PAINT=1 (CRT0_PAINT), crt0 writes MEM_USAGE_PAINT to the
+* words of the stack of hart 0 below its initial pointer and to the words
+* of the heap, before the bss is cleared. The high-water mark of a region is
+* then the extent of the words written since: from the end of the stack down
+* to its lowest word changed, from the start of the heap up to its highest
+* word changed. A program writing the pattern itself is measured short by
+* those words. Without CRT_PAINT only the heap given by _sbrk is known.
+*
+* mem_usage_dump prints one line per region, in CSV, after a header line:
+*
+*     MEM,region,size,used,free
+*
+* for the regions stack and heap (when painted) and sbrk, the high-water
+* mark of _sbrk. util/mem_fit.py reads them from the output of a run to fit
+* stack_size and heap_size of mcu_cfg.hjson to the program.
+* mem_usage_dump_at_exit prints them when main returns or exit is called.
+*/
+
+#ifndef _MEM_USAGE_H_
+#define _MEM_USAGE_H_
+
+/**
+ * The pattern painted by crt0.
+ */
+#define MEM_USAGE_PAINT     0xA5A5C3C3
+
+#ifndef __ASSEMBLER__
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The use of a region.
+ */
+typedef struct
+{
+    uint32_t    size;       /*!< Bytes of the region. */
+    uint32_t    used;       /*!< Bytes used at most so far. */
+} mem_usage_region_t;
+
+/**
+ * The use of the stack and of the heap.
+ */
+typedef struct
+{
+    bool                painted;    /*!< Built with CRT_PAINT, the stack and
+heap fields are measured. */
+    mem_usage_region_t  stack;      /*!< The stack of hart 0, used all over
+if it overflowed. */
+    mem_usage_region_t  heap;       /*!< The heap, by malloc or directly. */
+    mem_usage_region_t  sbrk;       /*!< The heap given by _sbrk. */
+} mem_usage_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Measures the high-water marks. The painted words are scanned, from
+ * the ends of the regions not used so far.
+ * @param p_usage The use of the regions.
+ */
+void mem_usage_get( mem_usage_t *p_usage );
+
+/**
+ * @brief Prints the high-water marks with printf, in CSV.
+ */
+void mem_usage_dump( void );
+
+/**
+ * @brief Makes exit call mem_usage_dump.
+ */
+void mem_usage_dump_at_exit( void );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _MEM_USAGE_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,51 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPTIMIZE_H_
+#define OPTIMIZE_H_
+
+/*
+ * Optimization of single functions and loops, beyond the PROFILE of the
+ * build (see the app target of the Makefile).
+ *
+ * The profiles apply to the whole program: speed (-O3 and unrolling), size
+ * (-Os) and balanced (-O2) are built with LTO, and XHEEP_PROFILE_SPEED,
+ * XHEEP_PROFILE_SIZE or XHEEP_PROFILE_BALANCED is defined. A size build
+ * usually wants its few kernels fast, and a speed build its start-up and
+ * error paths small:
+ *
+ * XHEEP_HOT marks a hot function, e.g. a kernel or an ISR: gcc optimizes it
+ * for speed (-O3) whatever the profile and gathers it in .text.hot. Its
+ * callees keep the optimization of the profile unless marked too, or inlined.
+ *
+ * XHEEP_COLD marks a function rarely called, e.g. the error handling: it is
+ * optimized for size, gathered in .text.unlikely and the branches to it are
+ * predicted not taken.
+ *
+ * XHEEP_OPT_SPEED and XHEEP_OPT_SIZE only change the optimization level of a
+ * function, without the hints of XHEEP_HOT and XHEEP_COLD.
+ *
+ * XHEEP_UNROLL( n ) before a loop unrolls it n times, also in a size build.
+ * n must be a number, not an expression.
+ *
+ * clang has no per-function optimization level: XHEEP_HOT and XHEEP_COLD
+ * keep their hints and XHEEP_OPT_SPEED and XHEEP_OPT_SIZE are empty.
+ */
+#if defined( __clang__ )
+#define XHEEP_OPT_SPEED
+#define XHEEP_OPT_SIZE
+#define XHEEP_HOT                       __attribute__( ( hot ) )
+#define XHEEP_COLD                      __attribute__( ( cold ) )
+#define XHEEP_UNROLL( n )               _Pragma( XHEEP_OPTIMIZE_STRING( unroll n ) )
+#else
+#define XHEEP_OPT_SPEED                 __attribute__( ( optimize( "O3" ) ) )
+#define XHEEP_OPT_SIZE                  __attribute__( ( optimize( "Os" ) ) )
+#define XHEEP_HOT                       __attribute__( ( hot, optimize( "O3" ) ) )
+#define XHEEP_COLD                      __attribute__( ( cold ) )
+#define XHEEP_UNROLL( n )               _Pragma( XHEEP_OPTIMIZE_STRING( GCC unroll n ) )
+#endif
+
+#define XHEEP_OPTIMIZE_STRING( s )      #s
+
+#endif  // OPTIMIZE_H_
@@ -0,0 +1,124 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : overlay.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   overlay.c
+* @date   14/10/26
+* @brief  Code overlays, loaded on demand from the flash into a window of the
+* RAM.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "overlay.h"
+
+#include "spi_memio.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                       TYPEDEFS AND STRUCTURES                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * An entry of the table of the linker script: where an overlay is in the
+ * flash.
+ */
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;
+} overlay_entry_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            GLOBAL VARIABLES                              */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The window and the table of the linker script, all 0 without window.
+ */
+extern uint8_t __overlay_start[];
+extern uint8_t __overlay_end[];
+extern const overlay_entry_t __overlay_table_start[];
+extern const overlay_entry_t __overlay_table_end[];
+
+/**
+ * The overlay in the window.
+ */
+static uint32_t overlay_current = OVERLAY_NONE;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+bool overlay_load( uint32_t p_id )
+{
+    uint32_t count = overlay_count();
+
+    /* Without window, the overlays are linked with the code. */
+    if( count == 0 ) return true;
+    if( p_id >= count ) return false;
+    if( p_id == overlay_current ) return true;
+
+    const overlay_entry_t *entry = &__overlay_table_start[ p_id ];
+
+    overlay_current = OVERLAY_NONE;
+    if( entry->end > entry->start )
+    {
+        spi_memio_load( __overlay_start, (const void *)entry->start, entry->end - entry->start );
+    }
+    /*
+     * fence.i, so that the core does not run instructions fetched from the
+     * previous overlay. It is encoded as a word so that it builds without
+     * _zifencei in the -march.
+     */
+    asm volatile( ".word 0x0000100f" ::: "memory" );
+    overlay_current = p_id;
+    return true;
+}
+
+uint32_t overlay_resident( void )
+{
+    return overlay_current;
+}
+
+uint32_t overlay_count( void )
+{
+    return (uint32_t)( __overlay_table_end - __overlay_table_start );
+}
+
+uint32_t overlay_window_size( void )
+{
+    return (uint32_t)( __overlay_end - __overlay_start );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,125 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : overlay.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   overlay.h
+* @date   14/10/26
+* @brief  Code overlays, loaded on demand from the flash into a window of the
+* RAM.
+*
+* The rarely used code (calibration, error recovery, configuration commands)
+* is placed in overlays with XHEEP_SECTION_OVERLAY(n) of bank_sections.h.
+* With overlays > n in the linker_script of mcu_cfg.hjson, the flash_load and
+* flash_exec linker scripts leave the overlays in the flash, after _edata so
+* that crt0 does not copy them, and link them all at the same address: a
+* window of the RAM as large as the largest of them. overlay_load copies an
+* overlay into the window with the DMA through the SPI MEMIO, unless it is
+* already there, and its functions can then be called until another one is
+* loaded. OVERLAY_CALL does both.
+*
+* The code of an overlay must not call the code of another one, which the
+* link refuses (NOCROSSREFS), nor be running when another one is loaded: the
+* overlays are loaded by the main program, not from the interrupt handlers.
+* Its constants go in its section too if they must not take RAM, e.g. with
+* __attribute__((section(".xheep_overlay0.rodata"))).
+*
+* Without overlays, and with the on-chip linker script, the overlays are
+* linked with the rest of the code and overlay_load does nothing.
+*/
+
+#ifndef _OVERLAY_H_
+#define _OVERLAY_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bank_sections.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Returned by overlay_resident when no overlay is in the window.
+ */
+#define OVERLAY_NONE    0xFFFFFFFFu
+
+/**
+ * Loads the overlay p_id and calls p_fn, one of its functions, with the
+ * arguments that follow. The overlay must exist.
+ */
+#define OVERLAY_CALL( p_id, p_fn, ... )                                     \
+    ( overlay_load( p_id ), p_fn( __VA_ARGS__ ) )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Loads an overlay into the window, unless it is there already, and
+ * waits for the copy. The DMA must be initialized (dma_init) and the SPI
+ * MEMIO selected (soc_ctrl_select_spi_memio); the copy uses the channel of
+ * dma_memcpy.
+ * @param p_id The number of the overlay, from 0.
+ * @return false if there is no such overlay, true once it can be called.
+ */
+bool overlay_load( uint32_t p_id );
+
+/**
+ * @brief Returns the overlay in the window, or OVERLAY_NONE.
+ */
+uint32_t overlay_resident( void );
+
+/**
+ * @brief Returns the number of overlays linked apart from the code, 0
+ * without window.
+ */
+uint32_t overlay_count( void );
+
+/**
+ * @brief Returns the size of the window in bytes.
+ */
+uint32_t overlay_window_size( void );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _OVERLAY_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,348 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : perf.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   perf.c
+* @date   14/10/26
+* @brief  Profiling of named code regions with the performance counters of
+* the core.
+*
+* The counters run freely from perf_init on and a region keeps the 64-bit
+* values read when it was opened: nothing is written to the counters, so
+* the regions can nest.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "perf.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csr.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The inhibit bits of mcycle, minstret and mhpmcounter3 in mcountinhibit.
+ */
+#define PERF_INHIBIT_MASK   0xD
+
+/**
+ * The empty regions measured by perf_init, the cost is the least of them.
+ */
+#define PERF_CALIBRATION    4
+
+/**
+ * Reads a 64-bit counter, the high half again if the low half wrapped.
+ */
+#define PERF_READ64( lo, hi, p_value )                              \
+    do                                                              \
+    {                                                               \
+        uint32_t high_, low_, high_again_;                          \
+        do                                                          \
+        {                                                           \
+            CSR_READ( hi, &high_ );                                 \
+            CSR_READ( lo, &low_ );                                  \
+            CSR_READ( hi, &high_again_ );                           \
+        } while( high_ != high_again_ );                            \
+        *( p_value ) = ( (uint64_t) high_ << 32 ) | low_;           \
+    } while( 0 )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                       TYPEDEFS AND STRUCTURES                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The values of the counters.
+ */
+typedef struct
+{
+    uint64_t    cycles;
+    uint64_t    instr;
+    uint64_t    event;
+} perf_sample_t;
+
+/**
+ * An open region.
+ */
+typedef struct
+{
+    int32_t         id;
+    perf_sample_t   start;
+} perf_open_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Adds a run to the statistics of a counter, less the cost of the
+ * measure.
+ */
+static void perf_stat_add( perf_stat_t *p_stat, uint64_t p_start,
+                           uint64_t p_end, uint64_t p_cost );
+
+static void perf_stat_clear( perf_stat_t *p_stat );
+
+/**
+ * @brief Prints a statistic as min,max,avg. newlib nano has no 64-bit
+ * printf conversions.
+ */
+static void perf_print_stat( const perf_stat_t *p_stat, uint32_t p_count );
+
+static void perf_print_u64( uint64_t p_value );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           LOCAL VARIABLES                                */
+/**                                                                        **/
+/****************************************************************************/
+
+static perf_region_t    perf_regions[ PERF_MAX_REGIONS ];
+static uint32_t         perf_num_regions;
+static perf_open_t      perf_stack[ PERF_MAX_DEPTH ];
+static uint32_t         perf_depth;
+static perf_sample_t    perf_cost;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+void perf_init( uint32_t p_event )
+{
+    perf_sample_t cost = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+
+#if defined(CPU_TYPE_CV32E20)
+    (void) p_event;
+#else
+    CSR_WRITE( CSR_REG_MHPMEVENT3, p_event );
+#endif
+    CSR_CLEAR_BITS( CSR_REG_MCOUNTINHIBIT, PERF_INHIBIT_MASK );
+
+    perf_num_regions   = 0;
+    perf_depth         = 0;
+    perf_cost          = (perf_sample_t){ 0, 0, 0 };
+
+    for( uint32_t i = 0; i < PERF_CALIBRATION; i++ )
+    {
+        perf_end( perf_begin( "" ) );
+        if( perf_regions[ 0 ].cycles.min < cost.cycles ) cost.cycles = perf_regions[ 0 ].cycles.min;
+        if( perf_regions[ 0 ].instr.min  < cost.instr  ) cost.instr  = perf_regions[ 0 ].instr.min;
+        if( perf_regions[ 0 ].event.min  < cost.event  ) cost.event  = perf_regions[ 0 ].event.min;
+    }
+
+    perf_num_regions = 0;
+    perf_cost        = cost;
+}
+
+int32_t perf_begin( const char *p_name )
+{
+    int32_t         id;
+    perf_open_t     *open;
+
+    if( perf_depth == PERF_MAX_DEPTH )
+    {
+        return -1;
+    }
+
+    for( id = 0; id < (int32_t) perf_num_regions; id++ )
+    {
+        if( perf_regions[ id ].name == p_name
+            || strcmp( perf_regions[ id ].name, p_name ) == 0 )
+        {
+            break;
+        }
+    }
+
+    if( id == (int32_t) perf_num_regions )
+    {
+        if( perf_num_regions == PERF_MAX_REGIONS )
+        {
+            return -1;
+        }
+        perf_num_regions++;
+        perf_regions[ id ].name   = p_name;
+        perf_regions[ id ].parent = perf_depth > 0 ? perf_stack[ perf_depth - 1 ].id : -1;
+        perf_regions[ id ].count  = 0;
+        perf_stat_clear( &perf_regions[ id ].cycles );
+        perf_stat_clear( &perf_regions[ id ].instr );
+        perf_stat_clear( &perf_regions[ id ].event );
+    }
+
+    open = &perf_stack[ perf_depth++ ];
+    open->id = id;
+
+    /* mcycle last, as it is first in perf_end. */
+    PERF_READ64( CSR_REG_MHPMCOUNTER3, CSR_REG_MHPMCOUNTER3H, &open->start.event );
+    PERF_READ64( CSR_REG_MINSTRET, CSR_REG_MINSTRETH, &open->start.instr );
+    PERF_READ64( CSR_REG_MCYCLE, CSR_REG_MCYCLEH, &open->start.cycles );
+
+    return id;
+}
+
+void perf_end( int32_t p_id )
+{
+    perf_sample_t   end;
+    perf_region_t   *region;
+    perf_open_t     *open;
+
+    PERF_READ64( CSR_REG_MCYCLE, CSR_REG_MCYCLEH, &end.cycles );
+    PERF_READ64( CSR_REG_MINSTRET, CSR_REG_MINSTRETH, &end.instr );
+    PERF_READ64( CSR_REG_MHPMCOUNTER3, CSR_REG_MHPMCOUNTER3H, &end.event );
+
+    if( perf_depth == 0 || perf_stack[ perf_depth - 1 ].id != p_id )
+    {
+        return;
+    }
+
+    open   = &perf_stack[ --perf_depth ];
+    region = &perf_regions[ p_id ];
+
+    region->count++;
+    perf_stat_add( &region->cycles, open->start.cycles, end.cycles, perf_cost.cycles );
+    perf_stat_add( &region->instr, open->start.instr, end.instr, perf_cost.instr );
+    perf_stat_add( &region->event, open->start.event, end.event, perf_cost.event );
+}
+
+const perf_region_t *perf_get( const char *p_name )
+{
+    for( uint32_t id = 0; id < perf_num_regions; id++ )
+    {
+        if( strcmp( perf_regions[ id ].name, p_name ) == 0 )
+        {
+            return &perf_regions[ id ];
+        }
+    }
+    return NULL;
+}
+
+void perf_reset( void )
+{
+    for( uint32_t id = 0; id < perf_num_regions; id++ )
+    {
+        perf_regions[ id ].count = 0;
+        perf_stat_clear( &perf_regions[ id ].cycles );
+        perf_stat_clear( &perf_regions[ id ].instr );
+        perf_stat_clear( &perf_regions[ id ].event );
+    }
+}
+
+void perf_dump( void )
+{
+    printf( "PERF,region,parent,count,cycles_min,cycles_max,cycles_avg,"
+            "instr_min,instr_max,instr_avg,event_min,event_max,event_avg\n\r" );
+
+    for( uint32_t id = 0; id < perf_num_regions; id++ )
+    {
+        const perf_region_t *region = &perf_regions[ id ];
+
+        printf( "PERF,%s,%s,%u", region->name,
+                region->parent >= 0 ? perf_regions[ region->parent ].name : "",
+                (unsigned int) region->count );
+        perf_print_stat( &region->cycles, region->count );
+        perf_print_stat( &region->instr, region->count );
+        perf_print_stat( &region->event, region->count );
+        printf( "\n\r" );
+    }
+}
+
+void perf_dump_at_exit( void )
+{
+    static bool registered = false;
+
+    if( !registered )
+    {
+        registered = atexit( perf_dump ) == 0;
+    }
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void perf_stat_add( perf_stat_t *p_stat, uint64_t p_start,
+                           uint64_t p_end, uint64_t p_cost )
+{
+    uint64_t value = p_end - p_start;
+
+    value = value > p_cost ? value - p_cost : 0;
+
+    if( value < p_stat->min ) p_stat->min = value;
+    if( value > p_stat->max ) p_stat->max = value;
+    p_stat->total += value;
+}
+
+static void perf_stat_clear( perf_stat_t *p_stat )
+{
+    p_stat->min   = UINT64_MAX;
+    p_stat->max   = 0;
+    p_stat->total = 0;
+}
+
+static void perf_print_stat( const perf_stat_t *p_stat, uint32_t p_count )
+{
+    printf( "," );
+    perf_print_u64( p_count ? p_stat->min : 0 );
+    printf( "," );
+    perf_print_u64( p_stat->max );
+    printf( "," );
+    perf_print_u64( p_count ? p_stat->total / p_count : 0 );
+}
+
+static void perf_print_u64( uint64_t p_value )
+{
+    char    digits[ 21 ];
+    char    *p = &digits[ sizeof( digits ) - 1 ];
+
+    *p = '\0';
+    do
+    {
+        *--p = '0' + ( p_value % 10 );
+        p_value /= 10;
+    } while( p_value != 0 );
+
+    printf( "%s", p );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,215 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : perf.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   perf.h
+* @date   14/10/26
+* @brief  Profiling of named code regions with the performance counters of
+* the core.
+*
+* A region is measured between perf_begin and perf_end, which read mcycle,
+* minstret and mhpmcounter3, the first event counter of the core (see hpm.h
+* for the others).
+* The regions may nest: the counts of a region include those of the regions
+* it encloses, and the dump gives the enclosing region of each. The cost of
+* perf_begin and perf_end themselves is measured by perf_init and removed.
+*
+* perf_dump prints one line per region, in CSV, after a header line:
+*
+*     PERF,region,parent,count,cycles_min,cycles_max,cycles_avg,instr_min,...
+*
+* so that the lines starting with "PERF," can be extracted from the output
+* of a run and compared between runs. perf_dump_at_exit prints it when main
+* returns or exit is called.
+*
+* Not for interrupt handlers: the regions of a handler would nest in the
+* region it interrupts.
+*/
+
+#ifndef _PERF_H_
+#define _PERF_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The number of regions, and of regions open at once.
+ */
+#ifndef PERF_MAX_REGIONS
+#define PERF_MAX_REGIONS    16
+#endif
+
+#ifndef PERF_MAX_DEPTH
+#define PERF_MAX_DEPTH      8
+#endif
+
+/**
+ * The events mhpmcounter3 can count, for perf_init. They depend on the core;
+ * the counter of the cv32e20 always counts the cycles waiting for the data
+ * memory and ignores the event.
+ */
+#if defined(CPU_TYPE_CV32E40P) || defined(CPU_TYPE_CV32E40PX)
+#define PERF_EVENT_LOAD_STALL   ( 1u << 2 )     /*!< Load-use hazards. */
+#define PERF_EVENT_JUMP_STALL   ( 1u << 3 )     /*!< Jump register hazards. */
+#define PERF_EVENT_IMISS        ( 1u << 4 )     /*!< Cycles waiting for the
+instructions. */
+#define PERF_EVENT_LOAD         ( 1u << 5 )
+#define PERF_EVENT_STORE        ( 1u << 6 )
+#define PERF_EVENT_JUMP         ( 1u << 7 )
+#define PERF_EVENT_BRANCH       ( 1u << 8 )
+#define PERF_EVENT_BRANCH_TAKEN ( 1u << 9 )
+#define PERF_EVENT_COMPRESSED   ( 1u << 10 )
+#define PERF_EVENT_DEFAULT      PERF_EVENT_LOAD_STALL
+#elif defined(CPU_TYPE_CV32E40X)
+#define PERF_EVENT_COMPRESSED   ( 1u << 2 )
+#define PERF_EVENT_JUMP         ( 1u << 3 )
+#define PERF_EVENT_BRANCH       ( 1u << 4 )
+#define PERF_EVENT_BRANCH_TAKEN ( 1u << 5 )
+#define PERF_EVENT_LOAD         ( 1u << 7 )
+#define PERF_EVENT_STORE        ( 1u << 8 )
+#define PERF_EVENT_IMISS        ( 1u << 9 )     /*!< Cycles without a valid
+instruction in the fetch stage. */
+#define PERF_EVENT_LOAD_STALL   ( 1u << 13 )
+#define PERF_EVENT_JUMP_STALL   ( 1u << 14 )
+#define PERF_EVENT_DEFAULT      PERF_EVENT_LOAD_STALL
+#else
+#define PERF_EVENT_DSIDE_WAIT   0               /*!< Cycles waiting for the
+data memory. */
+#define PERF_EVENT_DEFAULT      PERF_EVENT_DSIDE_WAIT
+#endif
+
+/**
+ * Measures a block as a region, e.g.
+ *
+ *     PERF_REGION( "matadd" ) { matrixAdd( A, B, C, N, M ); }
+ *
+ * The block must not be left with break, return or goto.
+ */
+#define PERF_REGION( name )                                                 \
+    for( int32_t perf_id_ = perf_begin( name ); perf_id_ >= 0;              \
+         perf_end( perf_id_ ), perf_id_ = -1 )
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The statistics of one counter over the runs of a region.
+ */
+typedef struct
+{
+    uint64_t    min;
+    uint64_t    max;
+    uint64_t    total;
+} perf_stat_t;
+
+/**
+ * A region. util/ps_loader.py reads the regions of a program run from the
+ * Zynq PS (perf_regions and perf_num_regions in perf.c) with this layout.
+ */
+typedef struct
+{
+    const char  *name;
+    int32_t     parent;     /*!< The region it was first opened in, or -1. */
+    uint32_t    count;      /*!< The number of runs. */
+    perf_stat_t cycles;
+    perf_stat_t instr;
+    perf_stat_t event;      /*!< mhpmcounter3. */
+} perf_region_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts the counters, clears the regions and measures the cost of the
+ * measure.
+ * @param p_event What mhpmcounter3 counts, a PERF_EVENT_* or several of them
+ * or-ed on the cv32e40p(x) and cv32e40x.
+ */
+void perf_init( uint32_t p_event );
+
+/**
+ * @brief Opens a region.
+ * @param p_name Its name, the regions are told apart by their name string.
+ * @return The ID of the region, for perf_end, or -1 if there are too many
+ * regions or too many open.
+ */
+int32_t perf_begin( const char *p_name );
+
+/**
+ * @brief Closes the last open region and adds the counts since perf_begin.
+ * @param p_id Its ID. Nothing is done for another region or -1.
+ */
+void perf_end( int32_t p_id );
+
+/**
+ * @brief Gives a region.
+ * @return The region, or NULL if it has never been opened.
+ */
+const perf_region_t *perf_get( const char *p_name );
+
+/**
+ * @brief Clears the statistics of all the regions.
+ */
+void perf_reset( void );
+
+/**
+ * @brief Prints the statistics of the regions with printf, in CSV.
+ */
+void perf_dump( void );
+
+/**
+ * @brief Makes exit call perf_dump.
+ */
+void perf_dump_at_exit( void );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _PERF_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,163 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : reg_script.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   reg_script.c
+* @date   14/10/26
+* @brief  Applies register scripts with the DMA.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "reg_script.h"
+
+#include <stddef.h>
+
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "dma_sleep.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      TYPEDEFS AND STRUCTURES                             */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The transaction of a channel and its targets, which the DMA driver uses
+ * until the transaction is done.
+ */
+typedef struct
+{
+    dma_target_t    values;
+    dma_target_t    regs;
+    dma_target_t    offsets;
+    dma_trans_t     trans;
+} reg_script_ch_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL VARIABLES                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static reg_script_ch_t reg_script_ch[ DMA_CH_NUM ];
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           EXPORTED FUNCTIONS                             */
+/**                                                                        **/
+/****************************************************************************/
+
+reg_script_result_t reg_script_start( uint8_t                    p_ch,
+                                      mmio_region_t              p_base,
+                                      const mmio_region_script_t *p_script )
+{
+    uintptr_t base = (uintptr_t)p_base.base;
+    uintptr_t ch_regs = DMA_START_ADDRESS + p_ch * DMA_CH_SIZE;
+
+    if(     ( p_ch >= DMA_CH_NUM )
+        ||  ( p_script == NULL )
+        ||  ( p_script->count == 0 )
+        ||  ( base >= ch_regs && base < ch_regs + DMA_CH_SIZE ) )
+    {
+        return REG_SCRIPT_BAD_ARG;
+    }
+
+    if( !dma_is_ready( p_ch ) )
+    {
+        return REG_SCRIPT_BUSY;
+    }
+
+    /*
+     * A word of the values per entry of the table of offsets, which are
+     * added to the base as they are (scatter, no shift).
+     */
+    reg_script_ch_t *ch = &reg_script_ch[ p_ch ];
+    ch->values = (dma_target_t) {
+        .ptr        = (uint8_t *)p_script->values,
+        .inc_du     = 1,
+        .size_du    = p_script->count,
+        .type       = DMA_DATA_TYPE_WORD,
+        .trig       = DMA_TRIG_MEMORY,
+    };
+    /* The increment of a memory target, unused with the offsets. */
+    ch->regs = (dma_target_t) {
+        .ptr        = (uint8_t *)base,
+        .inc_du     = 1,
+        .type       = DMA_DATA_TYPE_WORD,
+        .trig       = DMA_TRIG_MEMORY,
+    };
+    ch->offsets = (dma_target_t) {
+        .ptr        = (uint8_t *)p_script->offsets,
+        .inc_du     = 1,
+        .type       = DMA_DATA_TYPE_WORD,
+        .trig       = DMA_TRIG_MEMORY,
+    };
+    ch->trans = (dma_trans_t) {
+        .src        = &ch->values,
+        .dst        = &ch->regs,
+        .src_addr   = &ch->offsets,
+        .mode       = DMA_TRANS_MODE_ADDRESS,
+        .addr_table = DMA_ADDR_TABLE_DST_OFFSETS,
+        .addr_shift = 0,
+        .end        = DMA_TRANS_END_INTR,
+        .channel    = p_ch,
+    };
+
+    if(     ( dma_validate_transaction( &ch->trans,
+                                        DMA_ENABLE_REALIGN,
+                                        DMA_PERFORM_CHECKS_INTEGRITY )
+              & DMA_CONFIG_CRITICAL_ERROR )
+        ||  dma_load_transaction( &ch->trans ) != DMA_CONFIG_OK
+        ||  dma_launch( &ch->trans ) != DMA_CONFIG_OK )
+    {
+        return REG_SCRIPT_DMA_ERROR;
+    }
+
+    return REG_SCRIPT_OK;
+}
+
+reg_script_result_t reg_script_apply( uint8_t                    p_ch,
+                                      mmio_region_t              p_base,
+                                      const mmio_region_script_t *p_script )
+{
+    static const dma_sleep_cfg_t wfi = { .mode = DMA_SLEEP_WFI };
+
+    reg_script_result_t res = reg_script_start( p_ch, p_base, p_script );
+    if( res != REG_SCRIPT_OK )
+    {
+        return res;
+    }
+
+    return dma_sleep_until_done( &wfi, p_ch ) == DMA_SLEEP_OK
+           ? REG_SCRIPT_OK
+           : REG_SCRIPT_DMA_ERROR;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,130 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : reg_script.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   reg_script.h
+* @date   14/10/26
+* @brief  Applies register scripts with the DMA.
+*
+* A register script (mmio_region_script_t of mmio.h) is a const table of
+* offsets and one of values, e.g. the whole configuration of a peripheral or
+* the switch between two of its modes. The DMA writes them in address mode,
+* the offsets added to the base of the region (DMA_ADDR_TABLE_DST_OFFSETS),
+* in the order of the tables and at the speed of the bus, while the CPU goes
+* on (reg_script_start) or sleeps (reg_script_apply).
+* mmio_region_write_script32 applies the same script with the CPU.
+*
+* The DMA must have been initialized (dma_init). The tables must be in memory
+* the DMA can read and stay there until the script is done. The DMA does not
+* read the registers back: a field shared with other bits is written as a
+* whole. The region cannot be the registers of the channel applying the
+* script, another channel can reprogram it.
+*/
+
+#ifndef _REG_SCRIPT_H_
+#define _REG_SCRIPT_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdint.h>
+
+#include "mmio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Initializer of a mmio_region_script_t from two arrays of the same length.
+ */
+#define REG_SCRIPT_INIT( p_offsets, p_values )                          \
+    { .offsets = (p_offsets), .values = (p_values),                     \
+      .count = sizeof( p_offsets ) / sizeof( ( p_offsets )[0] ) }
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * Results of the reg_script functions.
+ */
+typedef enum
+{
+    REG_SCRIPT_OK           = 0, /*!< The script is started, or done. */
+    REG_SCRIPT_BAD_ARG      = 1, /*!< Bad channel, empty script, or region of
+    the registers of the channel. */
+    REG_SCRIPT_BUSY         = 2, /*!< The channel is running a transaction. */
+    REG_SCRIPT_DMA_ERROR    = 3, /*!< The DMA refused the transaction. */
+} reg_script_result_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts the writes of a script by a channel of the DMA and returns.
+ * The end can be waited for with dma_is_ready() or dma_sleep_until_done(),
+ * the transaction done interrupt of the channel is raised.
+ * @param p_ch The channel that applies the script.
+ * @param p_base The MMIO region of the registers.
+ * @param p_script The script, which must stay in memory until it is done.
+ * @return REG_SCRIPT_OK once the DMA is started, or the error.
+ */
+reg_script_result_t reg_script_start( uint8_t                    p_ch,
+                                      mmio_region_t              p_base,
+                                      const mmio_region_script_t *p_script );
+
+/**
+ * @brief Applies a script with a channel of the DMA, the core in wfi until
+ * it is done (dma_sleep_until_done with DMA_SLEEP_WFI).
+ * @param p_ch The channel that applies the script.
+ * @param p_base The MMIO region of the registers.
+ * @param p_script The script.
+ * @return REG_SCRIPT_OK once all the registers are written, or the error.
+ */
+reg_script_result_t reg_script_apply( uint8_t                    p_ch,
+                                      mmio_region_t              p_base,
+                                      const mmio_region_script_t *p_script );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _REG_SCRIPT_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
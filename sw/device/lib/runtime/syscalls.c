@@ -18,14 +18,24 @@
  */
 
 #include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
 #include <newlib.h>
 #include <unistd.h>
 #include <errno.h>
+#include <string.h>
 #include "uart.h"
 #include "soc_ctrl.h"
 #include "core_v_mini_mcu.h"
 #include "error.h"
 #include "x-heep.h"
+#include "syscalls.h"
+#include "timekeeping.h"
+#if STDOUT_IRQ
+#include "uart_buffered.h"
+#include "rv_plic.h"
+#include "csr.h"
+#endif
 
 #undef errno
 extern int errno;
@@ -51,10 +61,28 @@ void unimplemented_syscall()
     _write(STDOUT_FILENO, p, strlen(p));
 }
 
+/* nanosleep and gettimeofday need the timekeeping service, started by the
+ * application with timekeeping_init(). */
 int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
 {
-    errno = ENOSYS;
-    return -1;
+    if (rqtp == NULL || rqtp->tv_sec < 0 || rqtp->tv_nsec < 0 || rqtp->tv_nsec >= 1000000000)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (timekeeping_sleep_ns((uint64_t)rqtp->tv_sec * 1000000000 + rqtp->tv_nsec) != TIMEKEEPING_OK)
+    {
+        errno = ENOSYS;
+        return -1;
+    }
+
+    if (rmtp != NULL)
+    {
+        rmtp->tv_sec = 0;
+        rmtp->tv_nsec = 0;
+    }
+    return 0;
 }
 
 int _access(const char *file, int mode)
@@ -94,6 +122,8 @@ int _execve(const char *name, char *const argv[], char *const env[])
 
 void _exit(int exit_status)
 {
+    stdout_flush();
+
     soc_ctrl_t soc_ctrl;
     soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
     soc_ctrl_set_exit_value(&soc_ctrl, exit_status);
@@ -147,8 +177,21 @@ int _getpid()
 
 int _gettimeofday(struct timeval *tp, void *tzp)
 {
-    errno = -ENOSYS;
-    return -1;
+    uint64_t us;
+
+    if (!timekeeping_initialized())
+    {
+        errno = ENOSYS;
+        return -1;
+    }
+
+    if (tp != NULL)
+    {
+        us = timekeeping_us();
+        tp->tv_sec = us / 1000000;
+        tp->tv_usec = us % 1000000;
+    }
+    return 0;
 }
 
 int _isatty(int file)
@@ -232,11 +275,55 @@ int _wait(int *status)
     return -1;
 }
 
-ssize_t _write(int file, const void *ptr, size_t len)
+#if TARGET_SIM && SIM_CONSOLE
+/* Simulation console of the testharness (tb/sim_console.sv): each store
+ * prints the bytes it writes, so the output is sent 4 characters at a time
+ * without any UART configuration nor bit-level transfer.
+ */
+#define SIM_CONSOLE_START_ADDRESS (EXT_PERIPHERAL_START_ADDRESS + 0x3000)
+
+static ssize_t sim_console_write(const uint8_t *ptr, size_t len)
 {
-    if (file != STDOUT_FILENO) {
-        errno = ENOSYS;
-        return -1;
+    volatile uint8_t  *console_b = (volatile uint8_t *)SIM_CONSOLE_START_ADDRESS;
+    volatile uint32_t *console_w = (volatile uint32_t *)SIM_CONSOLE_START_ADDRESS;
+    size_t i = 0;
+
+    for (; i < len && ((uintptr_t)(ptr + i) & 0x3); i++) {
+        *console_b = ptr[i];
+    }
+    for (; i + 4 <= len; i += 4) {
+        *console_w = *(const uint32_t *)(ptr + i);
+    }
+    for (; i < len; i++) {
+        *console_b = ptr[i];
+    }
+    return len;
+}
+#endif
+
+#if STDOUT_IRQ
+static uint8_t stdout_buf[STDOUT_BUF_B];
+static uart_buffered_t stdout_ub;
+#else
+static uart_t stdout_uart;
+#endif
+static bool stdout_ready = false;
+static soc_clock_notifier_t stdout_clock;
+
+// The console follows the changes of the system clock, its buffer is drained
+// before the divisor changes
+static void stdout_clock_notifier(soc_clock_event_t event, uint32_t old_hz, uint32_t new_hz, void *ctx)
+{
+    if (event == kSocClockPreChange_e) {
+        stdout_flush();
+    }
+    uart_clock_notifier(event, old_hz, new_hz, ctx);
+}
+
+static int stdout_init(void)
+{
+    if (stdout_ready) {
+        return 0;
     }
 
     soc_ctrl_t soc_ctrl;
@@ -247,37 +334,126 @@ ssize_t _write(int file, const void *ptr, size_t len)
     uart.baudrate    = UART_BAUDRATE;
     uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
 
-    if (uart_init(&uart) != kErrorOk) {
+#if STDOUT_IRQ
+    // The TX is done by the CPU, the DMA channels are left to the application
+    if (uart_buffered_init(&stdout_ub, &uart, stdout_buf, STDOUT_BUF_B, NULL, 0,
+                           UART_BUFFERED_NO_DMA) != kErrorOk) {
+        return -1;
+    }
+    soc_clock_register(&stdout_clock, stdout_clock_notifier, &stdout_ub.uart);
+#else
+    stdout_uart = uart;
+    if (uart_init(&stdout_uart) != kErrorOk) {
+        return -1;
+    }
+    soc_clock_register(&stdout_clock, stdout_clock_notifier, &stdout_uart);
+#endif
+    stdout_ready = true;
+    return 0;
+}
+
+#if STDOUT_IRQ
+static ssize_t stdout_write(const uint8_t *ptr, size_t len)
+{
+    return uart_buffered_write(&stdout_ub, ptr, len);
+}
+
+void handler_irq_uart(uint32_t id)
+{
+    uart_buffered_irq_handler(&stdout_ub, id);
+}
+
+void stdout_irq_init(void)
+{
+    // uart_buffered_init sets the PLIC up, it is done again after plic_Init
+    if (stdout_ready) {
+        plic_irq_set_priority(UART_INTR_TX_WATERMARK, 1);
+        plic_irq_set_enabled(UART_INTR_TX_WATERMARK, kPlicToggleEnabled);
+    } else {
+        stdout_init();
+    }
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    // Set mie.MEIE bit to one to enable machine-level external interrupts
+    CSR_SET_BITS(CSR_REG_MIE, 1 << 11);
+}
+#else
+static ssize_t stdout_write(const uint8_t *ptr, size_t len)
+{
+    size_t done = 0;
+
+    while (done < len) {
+        done += uart_write_nonblocking(&stdout_uart, ptr + done, len - done);
+    }
+    return len;
+}
+#endif
+
+void stdout_flush(void)
+{
+    if (!stdout_ready) {
+        return;
+    }
+#if STDOUT_IRQ
+    uart_buffered_flush(&stdout_ub);
+#else
+    uart_wait_tx_done(&stdout_uart);
+#endif
+}
+
+ssize_t _write(int file, const void *ptr, size_t len)
+{
+    if (file != STDOUT_FILENO) {
         errno = ENOSYS;
         return -1;
     }
 
-    return uart_write(&uart,(uint8_t *)ptr,len);
+#if TARGET_SIM && SIM_CONSOLE
+    return sim_console_write((const uint8_t *)ptr, len);
+#endif
 
+    if (stdout_init() != 0) {
+        errno = ENOSYS;
+        return -1;
+    }
+
+    return stdout_write((const uint8_t *)ptr, len);
 }
 
 extern char __heap_start[];
 extern char __heap_end[];
 static char *brk = __heap_start;
+static char *brk_max = __heap_start;
 
 int _brk(void *addr)
 {
     brk = addr;
+    if (brk > brk_max) {
+        brk_max = brk;
+    }
     return 0;
 }
 
+/* The heap of newlib malloc. Buffers with a known lifetime are better kept
+ * out of it, in the arenas and pools of sw/device/lib/alloc.
+ */
 void *_sbrk(ptrdiff_t incr)
 {
     char *old_brk = brk;
 
-    if (__heap_start == __heap_end) {
-        return NULL;
+    if (incr > __heap_end - brk || incr < __heap_start - brk) {
+        errno = ENOMEM;
+        return (void *)-1;
     }
 
-    if ((brk += incr) < __heap_end) {
-        brk += incr;
-    } else {
-        brk = __heap_end;
+    brk += incr;
+    if (brk > brk_max) {
+        brk_max = brk;
     }
     return old_brk;
 }
+
+void *heap_high_water(void)
+{
+    return brk_max;
+}
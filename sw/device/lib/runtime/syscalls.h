@@ -0,0 +1,54 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _RUNTIME_SYSCALLS_H_
+#define _RUNTIME_SYSCALLS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The standard output (printf) goes to the UART, initialized on the first
+// write. By default _write pushes the characters to the TX FIFO of the UART and
+// only waits when the FIFO is full.
+//
+// With STDOUT_IRQ set to 1, the output goes through the buffered mode of the
+// UART driver (uart_buffered.h): it is copied to a ring buffer of
+// STDOUT_BUF_B bytes, which the TX watermark interrupt of the UART drains in
+// the background: a printf costs a copy as long as the buffer does not fill
+// up. stdout_irq_init must then be called after plic_Init, and the runtime
+// provides handler_irq_uart, so the application must not define it.
+
+#ifndef STDOUT_IRQ
+#define STDOUT_IRQ 0
+#endif
+
+// Size of the ring buffer of STDOUT_IRQ, a power of 2.
+#ifndef STDOUT_BUF_B
+#define STDOUT_BUF_B 512
+#endif
+
+/**
+ * Wait until all the output written so far has been sent by the UART.
+ * _exit calls it, so that the output is complete when the simulation ends.
+ */
+void stdout_flush(void);
+
+// Highest address the heap of malloc has reached, from __heap_start to
+// __heap_end. The banks above it are not used by the heap (ram_banks.h).
+void *heap_high_water(void);
+
+#if STDOUT_IRQ
+/**
+ * Enable the UART TX watermark interrupt in the PLIC and the external
+ * interrupts of the core. Before it, the buffer is only drained by _write.
+ */
+void stdout_irq_init(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _RUNTIME_SYSCALLS_H_
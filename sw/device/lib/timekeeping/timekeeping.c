@@ -0,0 +1,302 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : timekeeping.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   timekeeping.c
+* @date   14/10/26
+* @brief  Monotonic time, software timers and sleeps on the always-on
+* rv_timer.
+*
+* The wheel counts in ticks of the counter. It is shared by the application
+* and the interrupt handler, so it is only changed with mstatus.MIE cleared.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "timekeeping.h"
+
+#include <stddef.h>
+
+#include "csr.h"
+#include "fast_intr_ctrl.h"
+#include "irq.h"
+#include "soc_ctrl_clock.h"
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief The handler of the fast interrupt of timer 1: advances the wheel to
+ * the counter and programs the comparator to its next event.
+ */
+static void tk_irq( uint32_t p_id );
+
+/**
+ * @brief Programs the comparator to the next event of the wheel. A passed
+ * event raises the interrupt at once.
+ */
+static void tk_arm( void );
+
+/**
+ * @brief x * p_num / p_den without overflow for p_num and p_den up to 1e9,
+ * rounded down or up.
+ */
+static uint64_t tk_scale( uint64_t p_x, uint64_t p_num, uint64_t p_den,
+                          bool p_up );
+
+/**
+ * @brief The callback of the timer of the sleeps: the interrupt only wakes
+ * the core up.
+ */
+static void tk_wake( timer_wheel_timer_t *p_timer, void *p_ctx );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                           LOCAL VARIABLES                                */
+/**                                                                        **/
+/****************************************************************************/
+
+static rv_timer_t           *tk_timer = NULL;
+static rv_timer_clock_t     tk_clock;
+static soc_clock_notifier_t tk_notifier;
+static timer_wheel_t        tk_wheel;
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+timekeeping_result_t timekeeping_init( rv_timer_t *p_timer )
+{
+    rv_timer_tick_params_t params;
+    uint64_t now;
+
+    if( p_timer == NULL
+        || rv_timer_approximate_tick_params( soc_clock_get_frequency(),
+                                             TIMEKEEPING_TICK_HZ, &params )
+           != kRvTimerApproximateTickParamsOk
+        || rv_timer_counter_set_enabled( p_timer, TIMEKEEPING_HART,
+                                         kRvTimerDisabled ) != kRvTimerOk )
+    {
+        return TIMEKEEPING_ERROR;
+    }
+
+    rv_timer_set_tick_params( p_timer, TIMEKEEPING_HART, params );
+    rv_timer_arm( p_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP, TIMER_WHEEL_NEVER );
+    rv_timer_irq_clear( p_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP );
+    rv_timer_irq_enable( p_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP,
+                         kRvTimerEnabled );
+
+    rv_timer_counter_read( p_timer, TIMEKEEPING_HART, &now );
+    timer_wheel_init( &tk_wheel, now );
+    tk_timer = p_timer;
+
+    /* The counter keeps its rate when the system clock changes. */
+    tk_clock.timer   = p_timer;
+    tk_clock.hart_id = TIMEKEEPING_HART;
+    tk_clock.tick_hz = TIMEKEEPING_TICK_HZ;
+    soc_clock_register( &tk_notifier, rv_timer_clock_notifier, &tk_clock );
+
+    irq_register( IRQ_SRC_FAST( kTimer_1_fic_e ), tk_irq );
+    irq_set_enabled( IRQ_SRC_FAST( kTimer_1_fic_e ), true );
+
+    rv_timer_counter_set_enabled( p_timer, TIMEKEEPING_HART, kRvTimerEnabled );
+
+    return TIMEKEEPING_OK;
+}
+
+bool timekeeping_initialized( void )
+{
+    return tk_timer != NULL;
+}
+
+uint64_t timekeeping_ticks( void )
+{
+    uint64_t now = 0;
+
+    if( tk_timer != NULL )
+    {
+        rv_timer_counter_read( tk_timer, TIMEKEEPING_HART, &now );
+    }
+    return now;
+}
+
+uint64_t timekeeping_us( void )
+{
+    return tk_scale( timekeeping_ticks(), 1000000, TIMEKEEPING_TICK_HZ, false );
+}
+
+uint64_t timekeeping_ns( void )
+{
+    return tk_scale( timekeeping_ticks(), 1000000000, TIMEKEEPING_TICK_HZ, false );
+}
+
+timekeeping_result_t timekeeping_sleep_us( uint64_t p_us )
+{
+    return timekeeping_sleep_ns( p_us <= UINT64_MAX / 1000 ? p_us * 1000
+                                                           : UINT64_MAX );
+}
+
+timekeeping_result_t timekeeping_sleep_ns( uint64_t p_ns )
+{
+    timer_wheel_timer_t wake;
+    uint64_t deadline;
+    uint32_t mstatus;
+
+    if( tk_timer == NULL )
+    {
+        return TIMEKEEPING_ERROR;
+    }
+
+    deadline = timekeeping_ticks()
+               + tk_scale( p_ns, TIMEKEEPING_TICK_HZ, 1000000000, true );
+
+    timer_wheel_timer_init( &wake, tk_wake, NULL );
+    mstatus = irq_save();
+    timer_wheel_add( &tk_wheel, &wake, deadline, 0 );
+    tk_arm();
+    irq_restore( mstatus );
+
+    /* wfi returns on a pending interrupt even with mstatus.MIE cleared, so
+       the deadline is checked and the core sleeps without a race. */
+    for( ;; )
+    {
+        mstatus = irq_save();
+        if( timekeeping_ticks() >= deadline )
+        {
+            break;
+        }
+        asm volatile( "wfi" );
+        irq_restore( mstatus );
+    }
+
+    timer_wheel_remove( &tk_wheel, &wake );
+    irq_restore( mstatus );
+
+    return TIMEKEEPING_OK;
+}
+
+void timekeeping_timer_init( timekeeping_timer_t *p_timer,
+                             timekeeping_cb_t    p_cb,
+                             void                *p_ctx )
+{
+    timer_wheel_timer_init( p_timer, p_cb, p_ctx );
+}
+
+timekeeping_result_t timekeeping_timer_start( timekeeping_timer_t *p_timer,
+                                              uint64_t            p_delay_us,
+                                              uint64_t            p_period_us )
+{
+    uint64_t expiry;
+    uint32_t mstatus;
+
+    if( tk_timer == NULL )
+    {
+        return TIMEKEEPING_ERROR;
+    }
+
+    expiry = timekeeping_ticks()
+             + tk_scale( p_delay_us, TIMEKEEPING_TICK_HZ, 1000000, true );
+
+    mstatus = irq_save();
+    timer_wheel_add( &tk_wheel, p_timer, expiry,
+                     tk_scale( p_period_us, TIMEKEEPING_TICK_HZ, 1000000, true ) );
+    tk_arm();
+    irq_restore( mstatus );
+
+    return TIMEKEEPING_OK;
+}
+
+void timekeeping_timer_stop( timekeeping_timer_t *p_timer )
+{
+    uint32_t mstatus = irq_save();
+
+    /* The comparator may still go off for it, the wheel then has nothing to
+       do. */
+    timer_wheel_remove( &tk_wheel, p_timer );
+    irq_restore( mstatus );
+}
+
+bool timekeeping_timer_running( const timekeeping_timer_t *p_timer )
+{
+    return timer_wheel_pending( p_timer );
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void tk_irq( uint32_t p_id )
+{
+    uint64_t now;
+
+    (void) p_id;
+
+    /* The interrupt of the rv_timer stays raised while the counter is past
+       the comparator. */
+    rv_timer_arm( tk_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP, TIMER_WHEEL_NEVER );
+    rv_timer_irq_clear( tk_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP );
+
+    rv_timer_counter_read( tk_timer, TIMEKEEPING_HART, &now );
+    timer_wheel_advance( &tk_wheel, now );
+    tk_arm();
+}
+
+static void tk_arm( void )
+{
+    rv_timer_arm( tk_timer, TIMEKEEPING_HART, TIMEKEEPING_COMP,
+                  timer_wheel_next( &tk_wheel ) );
+}
+
+static uint64_t tk_scale( uint64_t p_x, uint64_t p_num, uint64_t p_den,
+                          bool p_up )
+{
+    uint64_t rest = ( p_x % p_den ) * p_num;
+
+    return ( p_x / p_den ) * p_num + ( rest + ( p_up ? p_den - 1 : 0 ) ) / p_den;
+}
+
+static void tk_wake( timer_wheel_timer_t *p_timer, void *p_ctx )
+{
+    (void) p_timer;
+    (void) p_ctx;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,190 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : timekeeping.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   timekeeping.h
+* @date   14/10/26
+* @brief  Monotonic 64-bit time, software timers and sleeps on a single
+* comparator of the always-on rv_timer.
+*
+* The counter of the timer 1 (hart 1) of the always-on rv_timer ticks at
+* TIMEKEEPING_TICK_HZ and is the time base: it does not wrap, and it keeps
+* its rate across the changes of the system clock (soc_ctrl_clock.h). The
+* software timers are kept in a timer wheel (timer_wheel.h) and comparator 0
+* is programmed to its next event, so any number of timers costs one fast
+* interrupt per event and nothing in between. Their callbacks run in that
+* interrupt handler.
+*
+* timekeeping_sleep_us sleeps in wfi until its deadline, other interrupts
+* are served meanwhile. nanosleep and gettimeofday use this service once it
+* is initialized; gettimeofday gives the time since the counter was reset.
+*
+* The timer 0 of the always-on rv_timer stays free for the power policy
+* (power_policy.h) or the tick of FreeRTOS.
+*/
+
+#ifndef _TIMEKEEPING_H_
+#define _TIMEKEEPING_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rv_timer.h"
+#include "timer_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The rate of the counter, the resolution of the time and of the timers. It
+ * must be reachable by rv_timer_approximate_tick_params at every system
+ * clock frequency used.
+ */
+#ifndef TIMEKEEPING_TICK_HZ
+#define TIMEKEEPING_TICK_HZ     1000000
+#endif
+
+/**
+ * The counter and the comparator of the always-on rv_timer that are used.
+ */
+#define TIMEKEEPING_HART        1
+#define TIMEKEEPING_COMP        0
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * A software timer, allocated by the caller.
+ */
+typedef timer_wheel_timer_t timekeeping_timer_t;
+
+/**
+ * The callback of a timer, called from the interrupt handler.
+ */
+typedef timer_wheel_cb_t timekeeping_cb_t;
+
+/**
+ * The results of the functions.
+ */
+typedef enum
+{
+    TIMEKEEPING_OK      = 0,    /*!< Done. */
+    TIMEKEEPING_ERROR   = 1,    /*!< Not initialized, or the tick rate is
+    not reachable at the system clock frequency. */
+} timekeeping_result_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Starts the counter of hart 1 at TIMEKEEPING_TICK_HZ, registers the
+ * fast interrupt of timer 1 (irq.h) and re-times the counter on the clock
+ * changes. mstatus.MIE is left to the application: without it, the timers
+ * do not fire and the sleeps do not save power.
+ * @param p_timer The always-on rv_timer, initialized by rv_timer_init with
+ * two harts. It must stay in memory.
+ * @return TIMEKEEPING_OK or TIMEKEEPING_ERROR.
+ */
+timekeeping_result_t timekeeping_init( rv_timer_t *p_timer );
+
+/**
+ * @brief Whether timekeeping_init succeeded.
+ */
+bool timekeeping_initialized( void );
+
+/**
+ * @brief The value of the counter, in ticks of TIMEKEEPING_TICK_HZ.
+ */
+uint64_t timekeeping_ticks( void );
+
+/**
+ * @brief The time of the counter, in microseconds and nanoseconds.
+ */
+uint64_t timekeeping_us( void );
+uint64_t timekeeping_ns( void );
+
+/**
+ * @brief Sleeps in wfi for at least a duration, rounded up to the ticks.
+ * Not for FreeRTOS tasks, which use vTaskDelay.
+ * @return TIMEKEEPING_OK, or TIMEKEEPING_ERROR if not initialized.
+ */
+timekeeping_result_t timekeeping_sleep_us( uint64_t p_us );
+timekeeping_result_t timekeeping_sleep_ns( uint64_t p_ns );
+
+/**
+ * @brief Initializes a timer, not running.
+ * @param p_cb Its callback, called from the interrupt handler.
+ * @param p_ctx Passed to the callback.
+ */
+void timekeeping_timer_init( timekeeping_timer_t *p_timer,
+                             timekeeping_cb_t    p_cb,
+                             void                *p_ctx );
+
+/**
+ * @brief Starts a timer, or restarts it if it is running. It may be called
+ * from a callback.
+ * @param p_delay_us The delay before it fires.
+ * @param p_period_us The period it fires again with, 0 for once.
+ * @return TIMEKEEPING_OK, or TIMEKEEPING_ERROR if not initialized.
+ */
+timekeeping_result_t timekeeping_timer_start( timekeeping_timer_t *p_timer,
+                                              uint64_t            p_delay_us,
+                                              uint64_t            p_period_us );
+
+/**
+ * @brief Stops a timer. Nothing is done if it is not running.
+ */
+void timekeeping_timer_stop( timekeeping_timer_t *p_timer );
+
+/**
+ * @brief Whether a timer is running.
+ */
+bool timekeeping_timer_running( const timekeeping_timer_t *p_timer );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _TIMEKEEPING_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
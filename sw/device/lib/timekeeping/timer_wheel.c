@@ -0,0 +1,360 @@
+/*
+                              *******************
+******************************* C SOURCE FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : timer_wheel.c
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+/**
+* @file   timer_wheel.c
+* @date   14/10/26
+* @brief  Hierarchical timer wheel.
+*
+* Every timer in level l has the digits above l of the time of the wheel, and
+* a digit l above that of the time of the wheel (or equal in level 0, for
+* the timers that expire now). So the next event of a level is its first
+* occupied slot, and when the time of the wheel reaches it, the slot is in
+* the digit of the time of the wheel.
+*/
+
+/****************************************************************************/
+/**                                                                        **/
+/*                             MODULES USED                                 */
+/**                                                                        **/
+/****************************************************************************/
+
+#include "timer_wheel.h"
+
+#include <stddef.h>
+
+/****************************************************************************/
+/**                                                                        **/
+/*                        DEFINITIONS AND MACROS                            */
+/**                                                                        **/
+/****************************************************************************/
+
+#define WHEEL_SLOT_MASK     ( TIMER_WHEEL_SLOTS - 1u )
+
+/**
+ * The position of the digit of a level in the time.
+ */
+#define WHEEL_SHIFT( l )    ( ( l ) * TIMER_WHEEL_SLOT_BITS )
+
+/**
+ * The bits of the time covered by the levels.
+ */
+#define WHEEL_BITS          WHEEL_SHIFT( TIMER_WHEEL_LEVELS )
+
+/****************************************************************************/
+/**                                                                        **/
+/*                      PROTOTYPES OF LOCAL FUNCTIONS                       */
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Puts a timer in the level and slot of its expiry.
+ */
+static void wheel_insert( timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer );
+
+/**
+ * @brief Adds a timer at the head of a list.
+ */
+static void wheel_link( timer_wheel_timer_t **p_head,
+                        timer_wheel_timer_t *p_timer );
+
+/**
+ * @brief Takes a whole list out of its slot, so the timers added while it is
+ * processed go to the slot again.
+ * @return The head of the list, whose first pprev still points to the slot.
+ */
+static timer_wheel_timer_t *wheel_detach( timer_wheel_t *p_wheel,
+                                          uint32_t      p_level,
+                                          uint32_t      p_slot );
+
+/**
+ * @brief Moves the timers of a list down, from the time of the wheel.
+ */
+static void wheel_cascade( timer_wheel_t       *p_wheel,
+                           timer_wheel_timer_t *p_list );
+
+/**
+ * @brief Calls the timers of the slot of the time of the wheel in level 0.
+ * @param p_now The time timer_wheel_advance goes to, the periodic timers
+ * skip the periods before it.
+ * @return The number of callbacks called.
+ */
+static uint32_t wheel_fire( timer_wheel_t *p_wheel, uint64_t p_now );
+
+/****************************************************************************/
+/**                                                                        **/
+/*                          EXPORTED FUNCTIONS                              */
+/**                                                                        **/
+/****************************************************************************/
+
+void timer_wheel_init( timer_wheel_t *p_wheel, uint64_t p_now )
+{
+    p_wheel->now = p_now;
+    p_wheel->far = NULL;
+    for( uint32_t l = 0; l < TIMER_WHEEL_LEVELS; l++ )
+    {
+        p_wheel->occupied[ l ] = 0;
+        for( uint32_t s = 0; s < TIMER_WHEEL_SLOTS; s++ )
+        {
+            p_wheel->slots[ l ][ s ] = NULL;
+        }
+    }
+}
+
+void timer_wheel_timer_init( timer_wheel_timer_t *p_timer,
+                             timer_wheel_cb_t    p_cb,
+                             void                *p_ctx )
+{
+    p_timer->next   = NULL;
+    p_timer->pprev  = NULL;
+    p_timer->expiry = 0;
+    p_timer->period = 0;
+    p_timer->cb     = p_cb;
+    p_timer->ctx    = p_ctx;
+}
+
+void timer_wheel_add( timer_wheel_t       *p_wheel,
+                      timer_wheel_timer_t *p_timer,
+                      uint64_t            p_expiry,
+                      uint64_t            p_period )
+{
+    timer_wheel_remove( p_wheel, p_timer );
+    p_timer->expiry = p_expiry;
+    p_timer->period = p_period;
+    wheel_insert( p_wheel, p_timer );
+}
+
+void timer_wheel_remove( timer_wheel_t       *p_wheel,
+                         timer_wheel_timer_t *p_timer )
+{
+    if( p_timer->pprev == NULL )
+    {
+        return;
+    }
+
+    *p_timer->pprev = p_timer->next;
+    if( p_timer->next != NULL )
+    {
+        p_timer->next->pprev = p_timer->pprev;
+    }
+    p_timer->pprev = NULL;
+
+    if( p_timer->level < TIMER_WHEEL_LEVELS
+        && p_wheel->slots[ p_timer->level ][ p_timer->slot ] == NULL )
+    {
+        p_wheel->occupied[ p_timer->level ] &= ~( 1ull << p_timer->slot );
+    }
+}
+
+bool timer_wheel_pending( const timer_wheel_timer_t *p_timer )
+{
+    return p_timer->pprev != NULL;
+}
+
+uint64_t timer_wheel_next( const timer_wheel_t *p_wheel )
+{
+    uint64_t next = TIMER_WHEEL_NEVER;
+
+    for( uint32_t l = 0; l < TIMER_WHEEL_LEVELS; l++ )
+    {
+        if( p_wheel->occupied[ l ] != 0 )
+        {
+            uint32_t slot = __builtin_ctzll( p_wheel->occupied[ l ] );
+            uint64_t at   = ( p_wheel->now >> WHEEL_SHIFT( l + 1 ) << WHEEL_SHIFT( l + 1 ) )
+                            | ( (uint64_t) slot << WHEEL_SHIFT( l ) );
+            if( at < next ) next = at;
+        }
+    }
+
+    if( p_wheel->far != NULL )
+    {
+        /* The far timers are moved down when the last level turns. */
+        uint64_t at = ( ( p_wheel->now >> WHEEL_BITS ) + 1 ) << WHEEL_BITS;
+        if( at < next ) next = at;
+    }
+
+    return next;
+}
+
+uint32_t timer_wheel_advance( timer_wheel_t *p_wheel, uint64_t p_now )
+{
+    uint32_t fired = 0;
+    bool     fired_now = false;
+    uint64_t next;
+
+    while( ( next = timer_wheel_next( p_wheel ) ) <= p_now
+           && next != TIMER_WHEEL_NEVER )
+    {
+        uint64_t prev = p_wheel->now;
+
+        /* The next event is the time of the wheel only for the timers added
+           by the callbacks with a passed expiry, they fire at the next call. */
+        if( next == prev && fired_now )
+        {
+            break;
+        }
+        p_wheel->now = next;
+
+        if( p_wheel->far != NULL && ( next >> WHEEL_BITS ) != ( prev >> WHEEL_BITS ) )
+        {
+            timer_wheel_timer_t *list = p_wheel->far;
+            p_wheel->far = NULL;
+            wheel_cascade( p_wheel, list );
+        }
+
+        /* The slots reached by the time of the wheel, from the top: their
+           timers go to the levels below. */
+        for( uint32_t l = TIMER_WHEEL_LEVELS - 1; l > 0; l-- )
+        {
+            uint32_t slot = ( next >> WHEEL_SHIFT( l ) ) & WHEEL_SLOT_MASK;
+            if( p_wheel->occupied[ l ] & ( 1ull << slot ) )
+            {
+                wheel_cascade( p_wheel, wheel_detach( p_wheel, l, slot ) );
+            }
+        }
+
+        fired += wheel_fire( p_wheel, p_now );
+        fired_now = true;
+    }
+
+    /* Unless timers wait in the slot of the time of the wheel. */
+    if( next > p_now && p_now > p_wheel->now )
+    {
+        p_wheel->now = p_now;
+    }
+
+    return fired;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                            LOCAL FUNCTIONS                               */
+/**                                                                        **/
+/****************************************************************************/
+
+static void wheel_insert( timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer )
+{
+    uint64_t expiry = p_timer->expiry > p_wheel->now ? p_timer->expiry
+                                                     : p_wheel->now;
+    uint64_t diff   = expiry ^ p_wheel->now;
+    uint32_t level  = 0;
+
+    if( diff >> WHEEL_BITS )
+    {
+        p_timer->level = TIMER_WHEEL_LEVELS;
+        wheel_link( &p_wheel->far, p_timer );
+        return;
+    }
+
+    /* The highest digit that differs from the time of the wheel. */
+    while( diff >> WHEEL_SHIFT( level + 1 ) )
+    {
+        level++;
+    }
+
+    p_timer->level = level;
+    p_timer->slot  = ( expiry >> WHEEL_SHIFT( level ) ) & WHEEL_SLOT_MASK;
+    wheel_link( &p_wheel->slots[ level ][ p_timer->slot ], p_timer );
+    p_wheel->occupied[ level ] |= 1ull << p_timer->slot;
+}
+
+static void wheel_link( timer_wheel_timer_t **p_head,
+                        timer_wheel_timer_t *p_timer )
+{
+    p_timer->next = *p_head;
+    if( *p_head != NULL )
+    {
+        ( *p_head )->pprev = &p_timer->next;
+    }
+    *p_head = p_timer;
+    p_timer->pprev = p_head;
+}
+
+static timer_wheel_timer_t *wheel_detach( timer_wheel_t *p_wheel,
+                                          uint32_t      p_level,
+                                          uint32_t      p_slot )
+{
+    timer_wheel_timer_t *list = p_wheel->slots[ p_level ][ p_slot ];
+
+    p_wheel->slots[ p_level ][ p_slot ] = NULL;
+    p_wheel->occupied[ p_level ] &= ~( 1ull << p_slot );
+    return list;
+}
+
+static void wheel_cascade( timer_wheel_t       *p_wheel,
+                           timer_wheel_timer_t *p_list )
+{
+    while( p_list != NULL )
+    {
+        timer_wheel_timer_t *timer = p_list;
+        p_list = timer->next;
+        wheel_insert( p_wheel, timer );
+    }
+}
+
+static uint32_t wheel_fire( timer_wheel_t *p_wheel, uint64_t p_now )
+{
+    uint32_t            fired = 0;
+    timer_wheel_timer_t *list = wheel_detach( p_wheel, 0,
+                                              p_wheel->now & WHEEL_SLOT_MASK );
+
+    if( list != NULL )
+    {
+        list->pprev = &list;
+    }
+
+    while( list != NULL )
+    {
+        timer_wheel_timer_t *timer = list;
+
+        /* Unlinked from the local list, so the callback may add it again. */
+        list = timer->next;
+        if( list != NULL )
+        {
+            list->pprev = &list;
+        }
+        timer->pprev = NULL;
+
+        if( timer->period != 0 )
+        {
+            /* The first period not before p_now, it fires in this call if
+               it is p_now. */
+            uint64_t expiry = timer->expiry + timer->period;
+            if( expiry < p_now )
+            {
+                expiry += ( ( p_now - expiry + timer->period - 1 )
+                            / timer->period ) * timer->period;
+            }
+            timer->expiry = expiry;
+            wheel_insert( p_wheel, timer );
+        }
+
+        timer->cb( timer, timer->ctx );
+        fired++;
+    }
+
+    return fired;
+}
+
+/****************************************************************************/
+/**                                                                        **/
+/*                                 EOF                                      */
+/**                                                                        **/
+/****************************************************************************/
@@ -0,0 +1,196 @@
+/*
+                              *******************
+******************************* H HEADER FILE *****************************
+**                            *******************
+**
+** project  : X-HEEP
+** filename : timer_wheel.h
+** version  : 1
+** date     : 14/10/26
+**
+***************************************************************************
+**
+** Copyright (c) EPFL contributors.
+** All rights reserved.
+**
+***************************************************************************
+*/
+
+/***************************************************************************/
+/***************************************************************************/
+
+/**
+* @file   timer_wheel.h
+* @date   14/10/26
+* @brief  Hierarchical timer wheel: many software timers behind a single
+* deadline, that of the next event of the wheel.
+*
+* The time is a 64-bit count of units, e.g. the ticks of a counter. The wheel
+* has TIMER_WHEEL_LEVELS levels of TIMER_WHEEL_SLOTS slots; a slot of level l
+* spans TIMER_WHEEL_SLOTS^l units. A timer is in the level of the highest
+* digit (of TIMER_WHEEL_SLOT_BITS bits) in which its expiry differs from the
+* time of the wheel, in the slot of that digit, and is moved down a level
+* when the time of the wheel reaches the start of its slot: so it fires at
+* its exact expiry. The timers beyond the last level wait in a list until the
+* last level turns.
+*
+* Adding and removing a timer is O(1), as finding the next event, from a
+* bitmap of the occupied slots per level. timer_wheel_advance jumps from an
+* event to the next one, so its cost does not depend on the elapsed time.
+*
+* The wheel does not lock: the caller runs it with the interrupts disabled
+* when it is shared with a handler, see timekeeping.h.
+*/
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+/****************************************************************************/
+/**                                                                        **/
+/**                            MODULES USED                                **/
+/**                                                                        **/
+/****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       DEFINITIONS AND MACROS                           **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * The bits of the time per level, for a 64-bit bitmap of the slots.
+ */
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       ( 1u << TIMER_WHEEL_SLOT_BITS )
+
+/**
+ * The levels: 2^24 units in the wheel, 16.7 s at 1 MHz.
+ */
+#define TIMER_WHEEL_LEVELS      4
+
+/**
+ * The next event of an empty wheel.
+ */
+#define TIMER_WHEEL_NEVER       UINT64_MAX
+
+/****************************************************************************/
+/**                                                                        **/
+/**                       TYPEDEFS AND STRUCTURES                          **/
+/**                                                                        **/
+/****************************************************************************/
+
+struct timer_wheel_timer;
+
+/**
+ * The callback of a timer, called by timer_wheel_advance. It may add or
+ * remove any timer, including its own.
+ */
+typedef void (*timer_wheel_cb_t)( struct timer_wheel_timer *p_timer,
+                                  void                     *p_ctx );
+
+/**
+ * A timer, allocated by the caller. Its fields are managed by the functions
+ * below.
+ */
+typedef struct timer_wheel_timer
+{
+    struct timer_wheel_timer    *next;
+    struct timer_wheel_timer    **pprev;    /*!< NULL when not pending. */
+    uint64_t                    expiry;
+    uint64_t                    period;     /*!< 0 for a one-shot timer. */
+    timer_wheel_cb_t            cb;
+    void                        *ctx;
+    uint8_t                     level;      /*!< TIMER_WHEEL_LEVELS for the
+    list of the far timers. */
+    uint8_t                     slot;
+} timer_wheel_timer_t;
+
+/**
+ * A wheel. Its fields are managed by the functions below.
+ */
+typedef struct
+{
+    uint64_t            now;    /*!< The time the wheel is advanced to. */
+    uint64_t            occupied[ TIMER_WHEEL_LEVELS ];
+    timer_wheel_timer_t *slots[ TIMER_WHEEL_LEVELS ][ TIMER_WHEEL_SLOTS ];
+    timer_wheel_timer_t *far;   /*!< The timers beyond the last level. */
+} timer_wheel_t;
+
+/****************************************************************************/
+/**                                                                        **/
+/**                          EXPORTED FUNCTIONS                            **/
+/**                                                                        **/
+/****************************************************************************/
+
+/**
+ * @brief Empties a wheel.
+ * @param p_now The current time.
+ */
+void timer_wheel_init( timer_wheel_t *p_wheel, uint64_t p_now );
+
+/**
+ * @brief Initializes a timer, not pending.
+ * @param p_cb Its callback.
+ * @param p_ctx Passed to the callback.
+ */
+void timer_wheel_timer_init( timer_wheel_timer_t *p_timer,
+                             timer_wheel_cb_t    p_cb,
+                             void                *p_ctx );
+
+/**
+ * @brief Starts a timer, after removing it if it is pending.
+ * @param p_expiry The time it fires at. A time already passed fires at the
+ * next timer_wheel_advance.
+ * @param p_period The period it fires again with, 0 for once. The periods
+ * missed by a late timer_wheel_advance are skipped.
+ */
+void timer_wheel_add( timer_wheel_t       *p_wheel,
+                      timer_wheel_timer_t *p_timer,
+                      uint64_t            p_expiry,
+                      uint64_t            p_period );
+
+/**
+ * @brief Stops a timer. Nothing is done if it is not pending.
+ */
+void timer_wheel_remove( timer_wheel_t       *p_wheel,
+                         timer_wheel_timer_t *p_timer );
+
+/**
+ * @brief Whether a timer is pending.
+ */
+bool timer_wheel_pending( const timer_wheel_timer_t *p_timer );
+
+/**
+ * @brief Gives the time at which timer_wheel_advance must be called next:
+ * the expiry of the earliest timer, or before it when a level must be moved
+ * down. The callers program their comparator to it.
+ * @return The time, not before the time of the wheel, or TIMER_WHEEL_NEVER.
+ */
+uint64_t timer_wheel_next( const timer_wheel_t *p_wheel );
+
+/**
+ * @brief Advances the wheel to a time and calls the callbacks of the timers
+ * that expired, in the order of their expiries.
+ * @param p_now The current time. An earlier time than the time of the wheel
+ * does nothing.
+ * @return The number of callbacks called.
+ */
+uint32_t timer_wheel_advance( timer_wheel_t *p_wheel, uint64_t p_now );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _TIMER_WHEEL_H_ */
+/****************************************************************************/
+/**                                                                        **/
+/**                                EOF                                     **/
+/**                                                                        **/
+/****************************************************************************/
@@ -16,6 +16,15 @@ extern "C" {
 #define UART_BAUDRATE 256000
 #define TARGET_SIM 1
 
+/**
+ * Print the standard output through the simulation console of the testharness
+ * (tb/sim_console.sv) instead of the UART. The console needs the external
+ * peripherals of the testharness (USE_EXTERNAL_DEVICE_EXAMPLE, on by default).
+ */
+#ifndef SIM_CONSOLE
+#define SIM_CONSOLE 0
+#endif
+
 /**
  * As the hw is configurable, we can have setups with different number of
  * Gpio pins
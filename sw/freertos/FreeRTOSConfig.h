@@ -74,11 +74,26 @@
 #define configMAX_PRIORITIES	 (5)
 /* Can be as low as 60 but some of the demo tasks that use this constant require it to be higher. */
 #define configMINIMAL_STACK_SIZE ((unsigned short)80)
-/* we want to put the heap into special section */
+/* Static allocation profile: the kernel objects may be given their memory
+(xTaskCreateStatic() and the like), placed in chosen RAM banks with the
+sections of port_sections.h, and the idle and timer tasks are static, see
+port_memory.c. The kernel heap is then only used by the objects left dynamic
+and is sized from heap_size of mcu_cfg.hjson. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+/* we want to put the heap into special section, rtosSECTION_HEAP */
 #define configAPPLICATION_ALLOCATED_HEAP 1
-#define configTOTAL_HEAP_SIZE		 ((size_t)(6 * 1024))
+#ifndef configTOTAL_HEAP_SIZE
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		#define configTOTAL_HEAP_SIZE	 ((size_t)HEAP_SIZE)
+	#else
+		#define configTOTAL_HEAP_SIZE	 ((size_t)(6 * 1024))
+	#endif
+#endif
 #define configMAX_TASK_NAME_LEN		 (12)
-#define configUSE_TRACE_FACILITY	 0 /* TODO: 0 */
+#define configUSE_TRACE_FACILITY	 1
 #define configUSE_16_BIT_TICKS		 0
 #define configIDLE_SHOULD_YIELD		 0
 #define configUSE_MUTEXES		 1
@@ -88,7 +103,9 @@
 #define configUSE_MALLOC_FAILED_HOOK	 1
 #define configUSE_APPLICATION_TASK_TAG	 0
 #define configUSE_COUNTING_SEMAPHORES	 1
-#define configGENERATE_RUN_TIME_STATS	 0
+#ifndef configGENERATE_RUN_TIME_STATS
+	#define configGENERATE_RUN_TIME_STATS	 1
+#endif
 #define configUSE_QUEUE_SETS                        1
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES       3
 
@@ -109,6 +126,12 @@
     #define uartPRIMARY_PRIORITY                    ( configMAX_PRIORITIES - 3 )
 #endif
 
+/* Index of the task notifications given by the interrupts of the rtos_*
+drivers, index 0 is left to the application and the stream buffers. */
+#ifndef rtosDRIVER_NOTIFY_INDEX
+    #define rtosDRIVER_NOTIFY_INDEX                 1
+#endif
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet                    1
@@ -123,6 +146,8 @@ to exclude the API function. */
 #define INCLUDE_xTaskAbortDelay                     1
 #define INCLUDE_xTaskGetHandle                      1
 #define INCLUDE_xSemaphoreGetMutexHolder            1
+#define INCLUDE_xTaskGetCurrentTaskHandle           1
+#define INCLUDE_uxTaskGetStackHighWaterMark         1
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
@@ -136,5 +161,38 @@ header file. */
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #define configKERNEL_INTERRUPT_PRIORITY 7
 
+/* Tickless idle: the tick is stopped while the idle task runs, see
+port_tickless.c. vPortTicklessSetPolicy() selects the low-power states. */
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 1
+#endif
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+
+#if ( configUSE_TICKLESS_IDLE == 1 ) && !defined( __ASSEMBLER__ )
+	/* TickType_t is 32-bit, configUSE_16_BIT_TICKS is 0. */
+	void vPortSuppressTicksAndSleep( uint32_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Run-time stats counted in core cycles (mcycle), and an optional trace of
+the context switches in a ring of rtosTRACE_ENTRIES records, see
+port_stats.c. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && !defined( __ASSEMBLER__ )
+	#define configRUN_TIME_COUNTER_TYPE uint64_t
+	void vPortRunTimeStatsInit( void );
+	uint64_t ullPortGetRunTimeCounter( void );
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vPortRunTimeStatsInit()
+	#define portGET_RUN_TIME_COUNTER_VALUE() ullPortGetRunTimeCounter()
+#endif
+
+#ifndef rtosTRACE_ENTRIES
+	#define rtosTRACE_ENTRIES 0
+#endif
+
+#if ( rtosTRACE_ENTRIES > 0 ) && !defined( __ASSEMBLER__ )
+	/* Expanded in tasks.c, uxTCBNumber is the number of the task. */
+	void vPortTraceSwitchedIn( uint32_t ulTaskNumber );
+	#define traceTASK_SWITCHED_IN() vPortTraceSwitchedIn( ( uint32_t ) pxCurrentTCB->uxTCBNumber )
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,183 @@
+/*
+ * Copyright EPFL contributors.
+ * Licensed under the Apache License, Version 2.0, see LICENSE for details.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The chip specific extensions of the RISC-V port of FreeRTOS for X-HEEP, in
+ * place of RISCV_MTIME_CLINT_no_extensions of the kernel (sw/CMakeLists.txt
+ * puts this directory first in the includes of the port). The tick is the
+ * machine timer of the always-on timer, see configMTIME_BASE_ADDRESS.
+ *
+ * With an FPU (F extension, __riscv_flen), the context of a task may hold
+ * f0-f31 and fcsr, after the 30 words of the port: rtosFPU_CONTEXT selects
+ * how.
+ *
+ *  0   not saved, as the port without extensions: the tasks must not use the
+ *      FPU, or only one of them.
+ *  1   lazy (default with an FPU): saved only for the tasks whose mstatus.FS
+ *      is Clean or Dirty, i.e. that executed an FP instruction, and restored
+ *      only for them. The tasks whose FS stays Off or Initial, all of them
+ *      without FP code, pay a few instructions per switch; those in Initial
+ *      get the default fcsr back.
+ *  2   always saved and restored, for a comparison with the lazy context
+ *      (example_freertos_bench).
+ *
+ * The words are in the frame even when not saved, so the stack of each task
+ * grows by 34 words with an FPU. The FS of a task is that of mstatus when it
+ * is created: the FPU must be on (FS Initial) before the tasks using it are
+ * created.
+ *
+ * The option is given to the port and to the app alike, e.g.
+ * make app PROJECT=example_freertos_bench APP_CFLAGS=-DrtosFPU_CONTEXT=2
+ */
+
+#ifndef __FREERTOS_RISC_V_EXTENSIONS_H__
+#define __FREERTOS_RISC_V_EXTENSIONS_H__
+
+#define portasmHAS_SIFIVE_CLINT         0
+#define portasmHAS_MTIME                1
+
+#ifndef rtosFPU_CONTEXT
+    #ifdef __riscv_flen
+        #define rtosFPU_CONTEXT         1
+    #else
+        #define rtosFPU_CONTEXT         0
+    #endif
+#endif
+
+#if ( rtosFPU_CONTEXT != 0 )
+    #if !defined( __riscv_flen ) || ( __riscv_flen != 32 )
+        #error "rtosFPU_CONTEXT needs the F extension of RV32, without D"
+    #endif
+    /* f0-f31 in the words 1 to 32 of the frame, fcsr in the word 33. The word
+    0 is the return address of the port. Must be an even number of words on
+    32-bit cores. */
+    #define portasmADDITIONAL_CONTEXT_SIZE  34
+#else
+    #define portasmADDITIONAL_CONTEXT_SIZE  0
+#endif
+
+/* The FS field of mstatus, and its bit set in the states Clean and Dirty */
+#define rtosMSTATUS_FS_INITIAL          0x2000
+#define rtosMSTATUS_FS_USED_BIT         14
+
+#ifdef __ASSEMBLER__
+
+/* Called with the 30 words of the port saved, t0 and t1 free. */
+.macro portasmSAVE_ADDITIONAL_REGISTERS
+#if ( rtosFPU_CONTEXT != 0 )
+    addi sp, sp, -( portasmADDITIONAL_CONTEXT_SIZE * portWORD_SIZE )
+#if ( rtosFPU_CONTEXT == 1 )
+    csrr t0, mstatus
+    srli t0, t0, rtosMSTATUS_FS_USED_BIT
+    andi t0, t0, 1
+    beqz t0, 91f
+#else
+    li t0, rtosMSTATUS_FS_INITIAL
+    csrs mstatus, t0
+#endif
+    fsw f0, 1 * portWORD_SIZE( sp )
+    fsw f1, 2 * portWORD_SIZE( sp )
+    fsw f2, 3 * portWORD_SIZE( sp )
+    fsw f3, 4 * portWORD_SIZE( sp )
+    fsw f4, 5 * portWORD_SIZE( sp )
+    fsw f5, 6 * portWORD_SIZE( sp )
+    fsw f6, 7 * portWORD_SIZE( sp )
+    fsw f7, 8 * portWORD_SIZE( sp )
+    fsw f8, 9 * portWORD_SIZE( sp )
+    fsw f9, 10 * portWORD_SIZE( sp )
+    fsw f10, 11 * portWORD_SIZE( sp )
+    fsw f11, 12 * portWORD_SIZE( sp )
+    fsw f12, 13 * portWORD_SIZE( sp )
+    fsw f13, 14 * portWORD_SIZE( sp )
+    fsw f14, 15 * portWORD_SIZE( sp )
+    fsw f15, 16 * portWORD_SIZE( sp )
+    fsw f16, 17 * portWORD_SIZE( sp )
+    fsw f17, 18 * portWORD_SIZE( sp )
+    fsw f18, 19 * portWORD_SIZE( sp )
+    fsw f19, 20 * portWORD_SIZE( sp )
+    fsw f20, 21 * portWORD_SIZE( sp )
+    fsw f21, 22 * portWORD_SIZE( sp )
+    fsw f22, 23 * portWORD_SIZE( sp )
+    fsw f23, 24 * portWORD_SIZE( sp )
+    fsw f24, 25 * portWORD_SIZE( sp )
+    fsw f25, 26 * portWORD_SIZE( sp )
+    fsw f26, 27 * portWORD_SIZE( sp )
+    fsw f27, 28 * portWORD_SIZE( sp )
+    fsw f28, 29 * portWORD_SIZE( sp )
+    fsw f29, 30 * portWORD_SIZE( sp )
+    fsw f30, 31 * portWORD_SIZE( sp )
+    fsw f31, 32 * portWORD_SIZE( sp )
+    frcsr t0
+    sw t0, 33 * portWORD_SIZE( sp )
+91:
+#endif
+    .endm
+
+/* Called with sp on the words of the extensions, the mstatus of the task
+above them, and only t0 and t1 free: x1 is already loaded when the first
+task starts. The mstatus of the task is written back by the port after. */
+.macro portasmRESTORE_ADDITIONAL_REGISTERS
+#if ( rtosFPU_CONTEXT != 0 )
+#if ( rtosFPU_CONTEXT == 1 )
+    lw t0, ( portasmADDITIONAL_CONTEXT_SIZE + 29 ) * portWORD_SIZE( sp )
+    srli t0, t0, rtosMSTATUS_FS_USED_BIT - 1
+    andi t0, t0, 3
+    /* FS Off: the task has no FPU */
+    beqz t0, 92f
+    li t1, rtosMSTATUS_FS_INITIAL
+    csrs mstatus, t1
+    andi t0, t0, 2
+    bnez t0, 91f
+    /* FS Initial: the registers are left, fcsr is the default one */
+    fscsr x0
+    j 92f
+91:
+#else
+    li t0, rtosMSTATUS_FS_INITIAL
+    csrs mstatus, t0
+#endif
+    flw f0, 1 * portWORD_SIZE( sp )
+    flw f1, 2 * portWORD_SIZE( sp )
+    flw f2, 3 * portWORD_SIZE( sp )
+    flw f3, 4 * portWORD_SIZE( sp )
+    flw f4, 5 * portWORD_SIZE( sp )
+    flw f5, 6 * portWORD_SIZE( sp )
+    flw f6, 7 * portWORD_SIZE( sp )
+    flw f7, 8 * portWORD_SIZE( sp )
+    flw f8, 9 * portWORD_SIZE( sp )
+    flw f9, 10 * portWORD_SIZE( sp )
+    flw f10, 11 * portWORD_SIZE( sp )
+    flw f11, 12 * portWORD_SIZE( sp )
+    flw f12, 13 * portWORD_SIZE( sp )
+    flw f13, 14 * portWORD_SIZE( sp )
+    flw f14, 15 * portWORD_SIZE( sp )
+    flw f15, 16 * portWORD_SIZE( sp )
+    flw f16, 17 * portWORD_SIZE( sp )
+    flw f17, 18 * portWORD_SIZE( sp )
+    flw f18, 19 * portWORD_SIZE( sp )
+    flw f19, 20 * portWORD_SIZE( sp )
+    flw f20, 21 * portWORD_SIZE( sp )
+    flw f21, 22 * portWORD_SIZE( sp )
+    flw f22, 23 * portWORD_SIZE( sp )
+    flw f23, 24 * portWORD_SIZE( sp )
+    flw f24, 25 * portWORD_SIZE( sp )
+    flw f25, 26 * portWORD_SIZE( sp )
+    flw f26, 27 * portWORD_SIZE( sp )
+    flw f27, 28 * portWORD_SIZE( sp )
+    flw f28, 29 * portWORD_SIZE( sp )
+    flw f29, 30 * portWORD_SIZE( sp )
+    flw f30, 31 * portWORD_SIZE( sp )
+    flw f31, 32 * portWORD_SIZE( sp )
+    lw t0, 33 * portWORD_SIZE( sp )
+    fscsr t0
+92:
+    addi sp, sp, ( portasmADDITIONAL_CONTEXT_SIZE * portWORD_SIZE )
+#endif
+    .endm
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* __FREERTOS_RISC_V_EXTENSIONS_H__ */
@@ -0,0 +1,53 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Interrupts of the X-HEEP peripherals under FreeRTOS.
+ *
+ * vectors_freertos.S sends the external and the fast interrupts to
+ * freertos_risc_v_trap_handler, which saves the context of the task, switches
+ * to the ISR stack and calls freertos_risc_v_application_interrupt_handler()
+ * with mcause. It is dispatched here to the same handlers as without FreeRTOS:
+ * handler_irq_external() for the PLIC and fic_irq_dispatch() for the fast
+ * interrupts, so the drivers and their weak handlers are unchanged.
+ *
+ * The handlers run with the interrupts disabled and may call the FromISR
+ * functions of the kernel; portYIELD_FROM_ISR() switches the task once the
+ * handler returns. Their time is accounted by port_stats.c.
+ */
+
+#include "FreeRTOS.h"
+
+#include <stdint.h>
+
+#include "rv_plic.h"
+#include "fast_intr_ctrl.h"
+
+#include "port_stats.h"
+
+#define portIRQ_CODE_MASK           ( 0x7fffffffUL )
+#define portIRQ_MACHINE_EXTERNAL    ( 11UL )
+#define portIRQ_FAST_FIRST          ( 16UL )
+#define portIRQ_FAST_LAST           ( portIRQ_FAST_FIRST + FAST_INTR_CTRL_IRQ_N - 1UL )
+
+/*-----------------------------------------------------------*/
+
+void freertos_risc_v_application_interrupt_handler( uint32_t mcause )
+{
+    uint32_t ulCode = mcause & portIRQ_CODE_MASK;
+
+    vPortIsrEnter( ulCode );
+
+    if( ulCode == portIRQ_MACHINE_EXTERNAL )
+    {
+        handler_irq_external();
+    }
+    else if( ( ulCode >= portIRQ_FAST_FIRST ) && ( ulCode <= portIRQ_FAST_LAST ) )
+    {
+        fic_irq_dispatch( ( fast_intr_ctrl_fast_interrupt_t ) ( ulCode - portIRQ_FAST_FIRST ) );
+    }
+
+    vPortIsrExit( ulCode );
+}
+/*-----------------------------------------------------------*/
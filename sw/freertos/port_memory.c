@@ -0,0 +1,67 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Memory of the kernel.
+ *
+ * ucHeap is the heap of heap_4.c (configAPPLICATION_ALLOCATED_HEAP), in the
+ * section of rtosSECTION_HEAP, so the applications do not define it.
+ *
+ * With configSUPPORT_STATIC_ALLOCATION, the kernel asks the application for
+ * the stacks and the TCBs of the tasks it creates itself. They are static
+ * here, so they are not taken from the heap when the scheduler starts. With
+ * rtosKERNEL_BANK defined, they are placed in that RAM bank, see
+ * port_sections.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "port_sections.h"
+
+uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] rtosSECTION_HEAP;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    #ifdef rtosKERNEL_BANK
+        #define portKERNEL_SECTION      rtosSECTION_BANK( rtosKERNEL_BANK )
+    #else
+        #define portKERNEL_SECTION
+    #endif
+
+    static StaticTask_t xIdleTaskTCB portKERNEL_SECTION;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ] portKERNEL_SECTION;
+
+    #if ( configUSE_TIMERS == 1 )
+        static StaticTask_t xTimerTaskTCB portKERNEL_SECTION;
+        static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ] portKERNEL_SECTION;
+    #endif
+
+    /*-----------------------------------------------------------*/
+
+    void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer,
+                                        StackType_t **ppxIdleTaskStackBuffer,
+                                        uint32_t *pulIdleTaskStackSize )
+    {
+        *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+        *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+        *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+    }
+    /*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+
+        void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
+                                             StackType_t **ppxTimerTaskStackBuffer,
+                                             uint32_t *pulTimerTaskStackSize )
+        {
+            *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+            *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+            *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* configUSE_TIMERS */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -0,0 +1,46 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PORT_SECTIONS_H
+#define PORT_SECTIONS_H
+
+/*
+ * Placement of the memory of the kernel objects in the RAM banks.
+ *
+ * The linker scripts of sw/linker have a section .xheep_bank<n> for each
+ * contiguous bank n of MEMORY_BANK<n>_SIZE bytes. The banks of the code get
+ * their objects after the code, the other banks after the stack, and the link
+ * fails if they do not fit in the bank. A task whose stack is in the bank of
+ * its code, and its queue storage next to them, runs from a single bank, so
+ * the others can be power gated or retained with ram_banks.h.
+ *
+ * These sections are neither loaded nor zeroed: they are for the stacks, the
+ * StaticTask_t and StaticQueue_t buffers and the storage of the queues, which
+ * the kernel initializes. e.g. with configSUPPORT_STATIC_ALLOCATION:
+ *
+ *     static StackType_t uxStack[ 256 ] rtosSECTION_BANK( 0 );
+ *     static StaticTask_t xTask rtosSECTION_BANK( 0 );
+ *
+ *     xTaskCreateStatic( prvTask, "Hot", 256, NULL, 2, uxStack, &xTask );
+ */
+#define rtosSECTION_BANK( n )       __attribute__( ( section( portSECTION_BANK_NAME( n ) ), aligned( 16 ) ) )
+
+/*
+ * The kernel heap, ucHeap of the application with configAPPLICATION_ALLOCATED_HEAP.
+ * It is in the .heap section after the heap of the C library, or in the bank
+ * rtosHEAP_BANK if defined:
+ *
+ *     uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] rtosSECTION_HEAP;
+ */
+#ifdef rtosHEAP_BANK
+    #define rtosSECTION_HEAP        rtosSECTION_BANK( rtosHEAP_BANK )
+#else
+    #define rtosSECTION_HEAP        __attribute__( ( section( ".xheep_rtos_heap" ), aligned( 8 ) ) )
+#endif
+
+/* The bank is expanded before it is made a string, it can be a macro. */
+#define portSECTION_BANK_NAME( n )  portSECTION_STRING( .xheep_bank##n )
+#define portSECTION_STRING( s )     #s
+
+#endif /* PORT_SECTIONS_H */
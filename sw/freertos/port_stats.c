@@ -0,0 +1,234 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Run-time statistics and trace of the X-HEEP FreeRTOS port.
+ *
+ * The run-time counter of the kernel (configGENERATE_RUN_TIME_STATS) is
+ * mcycle, the cycles of the core: no timer is used and the counter does not
+ * wrap. The core clock is gated by wfi, so the cycles of the idle task are
+ * the awake ones and the shares are of the awake time.
+ *
+ * The time of the peripheral interrupt handlers is measured by port_irq.c.
+ * With rtosTRACE_ENTRIES > 0, the context switches and the interrupts are
+ * also recorded in the ring xPortTrace, 8 bytes a record.
+ */
+
+#include "port_stats.h"
+
+#include <stdio.h>
+
+#include "task.h"
+
+#include "csr.h"
+
+/* The CY bit of mcountinhibit. */
+#define portMCOUNTINHIBIT_CY        ( 0x1U )
+
+static uint64_t ullIsrCycles = 0;
+static uint32_t ulIsrCount = 0;
+static uint32_t ulIsrStart;
+
+#if ( rtosTRACE_ENTRIES > 0 )
+    PortTrace_t xPortTrace = { .cMagic = "XHRTOS", .ulEntries = rtosTRACE_ENTRIES };
+
+    /* The records are dropped while the trace is dumped. */
+    static volatile BaseType_t xTracePaused = pdFALSE;
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( rtosTRACE_ENTRIES > 0 )
+
+    /* Called with the interrupts disabled: from vTaskSwitchContext() or a
+       handler. */
+    static void prvTraceRecord( uint8_t ucEvent, uint8_t ucId )
+    {
+        PortTraceRecord_t *pxRecord;
+        uint32_t ulHead = xPortTrace.ulHead;
+
+        if( xTracePaused != pdFALSE )
+        {
+            return;
+        }
+
+        pxRecord = &xPortTrace.xRecords[ ulHead % rtosTRACE_ENTRIES ];
+        CSR_READ( CSR_REG_MCYCLE, &pxRecord->ulCycle );
+        pxRecord->ucEvent = ucEvent;
+        pxRecord->ucId = ucId;
+        pxRecord->usReserved = 0;
+        xPortTrace.ulHead = ulHead + 1;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortTraceSwitchedIn( uint32_t ulTaskNumber )
+    {
+        prvTraceRecord( portTRACE_SWITCHED_IN, ( uint8_t ) ulTaskNumber );
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* rtosTRACE_ENTRIES */
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    void vPortRunTimeStatsInit( void )
+    {
+        CSR_CLEAR_BITS( CSR_REG_MCOUNTINHIBIT, portMCOUNTINHIBIT_CY );
+    }
+    /*-----------------------------------------------------------*/
+
+    uint64_t ullPortGetRunTimeCounter( void )
+    {
+        uint32_t ulHigh, ulLow, ulHighAgain;
+
+        do
+        {
+            CSR_READ( CSR_REG_MCYCLEH, &ulHigh );
+            CSR_READ( CSR_REG_MCYCLE, &ulLow );
+            CSR_READ( CSR_REG_MCYCLEH, &ulHighAgain );
+        } while( ulHigh != ulHighAgain );
+
+        return ( ( uint64_t ) ulHigh << 32 ) | ulLow;
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+void vPortIsrEnter( uint32_t ulCode )
+{
+    CSR_READ( CSR_REG_MCYCLE, &ulIsrStart );
+
+    #if ( rtosTRACE_ENTRIES > 0 )
+        prvTraceRecord( portTRACE_ISR_ENTER, ( uint8_t ) ulCode );
+    #else
+        ( void ) ulCode;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortIsrExit( uint32_t ulCode )
+{
+    uint32_t ulNow;
+
+    #if ( rtosTRACE_ENTRIES > 0 )
+        prvTraceRecord( portTRACE_ISR_EXIT, ( uint8_t ) ulCode );
+    #else
+        ( void ) ulCode;
+    #endif
+
+    /* The handlers do not nest, the low word is enough. */
+    CSR_READ( CSR_REG_MCYCLE, &ulNow );
+    ullIsrCycles += ulNow - ulIsrStart;
+    ulIsrCount++;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetIsrCycles( void )
+{
+    uint64_t ullCycles;
+
+    taskENTER_CRITICAL();
+    ullCycles = ullIsrCycles;
+    taskEXIT_CRITICAL();
+
+    return ullCycles;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetIsrCount( void )
+{
+    return ulIsrCount;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    /* newlib-nano prints no 64-bit integers, the cycles are printed in
+       thousands. */
+    static uint32_t prvKiloCycles( uint64_t ullCycles )
+    {
+        return ( uint32_t ) ( ullCycles / 1000U );
+    }
+    /*-----------------------------------------------------------*/
+
+    static uint32_t prvPercent( uint64_t ullCycles, uint64_t ullTotal )
+    {
+        return ( ullTotal != 0 ) ? ( uint32_t ) ( ( ullCycles * 100U ) / ullTotal ) : 0;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortPrintRunTimeStats( void )
+    {
+        static const char cStates[] = { 'X', 'R', 'B', 'S', 'D', '?' };
+        UBaseType_t uxCount = uxTaskGetNumberOfTasks();
+        TaskStatus_t *pxStatus = pvPortMalloc( uxCount * sizeof( TaskStatus_t ) );
+        configRUN_TIME_COUNTER_TYPE ullTotal;
+        uint64_t ullIsr = ullPortGetIsrCycles();
+
+        if( pxStatus == NULL )
+        {
+            printf( "stats: no heap\n\r" );
+            return;
+        }
+
+        uxCount = uxTaskGetSystemState( pxStatus, uxCount, &ullTotal );
+
+        printf( "%-11s %10s %4s %5s %5s\n\r", "task", "kcycles", "%", "state", "stack" );
+        for( UBaseType_t i = 0; i < uxCount; i++ )
+        {
+            eTaskState eState = pxStatus[ i ].eCurrentState;
+            printf( "%-11s %10u %3u%% %5c %5u\n\r",
+                    pxStatus[ i ].pcTaskName,
+                    prvKiloCycles( pxStatus[ i ].ulRunTimeCounter ),
+                    prvPercent( pxStatus[ i ].ulRunTimeCounter, ullTotal ),
+                    cStates[ eState <= eDeleted ? eState : eInvalid ],
+                    ( uint32_t ) pxStatus[ i ].usStackHighWaterMark );
+        }
+        printf( "%-11s %10u %3u%% %u calls\n\r", "(isr)", prvKiloCycles( ullIsr ), prvPercent( ullIsr, ullTotal ), ulPortGetIsrCount() );
+
+        vPortFree( pxStatus );
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+void vPortTraceDump( void )
+{
+    #if ( rtosTRACE_ENTRIES > 0 )
+        UBaseType_t uxCount = uxTaskGetNumberOfTasks();
+        TaskStatus_t *pxStatus = pvPortMalloc( uxCount * sizeof( TaskStatus_t ) );
+        uint32_t ulHead, ulFirst;
+
+        xTracePaused = pdTRUE;
+        ulHead = xPortTrace.ulHead;
+        ulFirst = ( ulHead > rtosTRACE_ENTRIES ) ? ulHead - rtosTRACE_ENTRIES : 0;
+
+        printf( "RTOS_TRACE %u %u %u\n\r", ( uint32_t ) rtosTRACE_ENTRIES, ulHead, ( uint32_t ) configCPU_CLOCK_HZ );
+
+        if( pxStatus != NULL )
+        {
+            uxCount = uxTaskGetSystemState( pxStatus, uxCount, NULL );
+            for( UBaseType_t i = 0; i < uxCount; i++ )
+            {
+                printf( "T %u %s\n\r", ( uint32_t ) pxStatus[ i ].xTaskNumber, pxStatus[ i ].pcTaskName );
+            }
+            vPortFree( pxStatus );
+        }
+
+        for( uint32_t i = ulFirst; i < ulHead; i++ )
+        {
+            const PortTraceRecord_t *pxRecord = &xPortTrace.xRecords[ i % rtosTRACE_ENTRIES ];
+            printf( "R %08x %u %u\n\r", pxRecord->ulCycle, pxRecord->ucEvent, pxRecord->ucId );
+        }
+
+        printf( "RTOS_TRACE_END\n\r" );
+
+        /* Restarts the trace after the dump. */
+        xPortTrace.ulHead = 0;
+        xTracePaused = pdFALSE;
+    #else
+        printf( "RTOS_TRACE 0 0 0\n\rRTOS_TRACE_END\n\r" );
+    #endif
+}
+/*-----------------------------------------------------------*/
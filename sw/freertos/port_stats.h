@@ -0,0 +1,73 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PORT_STATS_H
+#define PORT_STATS_H
+
+#include "FreeRTOS.h"
+
+#include <stdint.h>
+
+/*
+ * Events of the trace records.
+ */
+#define portTRACE_SWITCHED_IN       ( 1U )  /* ucId is the task number. */
+#define portTRACE_ISR_ENTER         ( 2U )  /* ucId is the code of mcause. */
+#define portTRACE_ISR_EXIT          ( 3U )
+
+/*
+ * A record of the trace, the cycle is the low word of mcycle.
+ */
+typedef struct
+{
+    uint32_t ulCycle;
+    uint8_t  ucEvent;
+    uint8_t  ucId;
+    uint16_t usReserved;
+} PortTraceRecord_t;
+
+/*
+ * The trace in memory, at the symbol xPortTrace, so a debugger can read it.
+ * ulHead counts all the records, the last rtosTRACE_ENTRIES are kept.
+ */
+typedef struct
+{
+    char              cMagic[ 8 ];  /* "XHRTOS" */
+    uint32_t          ulEntries;
+    volatile uint32_t ulHead;
+    PortTraceRecord_t xRecords[ rtosTRACE_ENTRIES > 0 ? rtosTRACE_ENTRIES : 1 ];
+} PortTrace_t;
+
+/*
+ * Time spent in the peripheral interrupt handlers dispatched by port_irq.c,
+ * in cycles. The tick interrupt is not counted.
+ */
+uint64_t ullPortGetIsrCycles( void );
+
+uint32_t ulPortGetIsrCount( void );
+
+/*
+ * Called by port_irq.c around the handlers.
+ */
+void vPortIsrEnter( uint32_t ulCode );
+
+void vPortIsrExit( uint32_t ulCode );
+
+/*
+ * Prints a line per task with its cycles, its share of the total, its state
+ * and the high-water mark of its stack, in words, then the time in the
+ * interrupt handlers. The cycles of a task include the handlers that
+ * interrupted it. Allocates an array of TaskStatus_t on the heap.
+ */
+void vPortPrintRunTimeStats( void );
+
+/*
+ * Prints the trace as text on stdout, which the Verilator testbench logs in
+ * uart0.log: a header, the task names and the records, decoded by
+ * util/freertos_trace_decode.py. Called by a task; the events are not
+ * recorded while it prints and the trace restarts empty after.
+ */
+void vPortTraceDump( void );
+
+#endif /* PORT_STATS_H */
@@ -0,0 +1,144 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Tickless idle of the X-HEEP FreeRTOS port (configUSE_TICKLESS_IDLE).
+ *
+ * The tick of the GCC RISC-V port is the comparator 0 of hart 0 of the
+ * always-on rv_timer (configMTIMECMP_BASE_ADDRESS), reprogrammed by the tick
+ * interrupt to ullNextTime, one tick ahead. When the idle task expects to
+ * be idle for several ticks, the comparator is moved to the tick boundary of
+ * the next deadline and the core sleeps until then; on wake-up the tick count
+ * is stepped by the whole ticks that elapsed and the tick is realigned on its
+ * boundaries, so the ticks do not drift.
+ *
+ * Without a policy the core sleeps with wfi. With a power policy
+ * (power_policy.h, registered with vPortTicklessSetPolicy()), it enters the
+ * deepest state worth entering for the idle period, e.g. power_gate_core()
+ * for the long ones, and wakes up early by the measured wake-up latency. The
+ * policy must use the same rv_timer and hart 0, so its ticks are the ticks of
+ * mtime.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdint.h>
+
+#include "csr.h"
+#include "power_policy.h"
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/* Defined by the GCC RISC-V port (port.c). */
+extern uint64_t ullNextTime;
+extern const size_t uxTimerIncrementsForOneTick;
+
+static power_policy_t *pxTicklessPolicy = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vPortTicklessSetPolicy( power_policy_t *pxPolicy )
+{
+    pxTicklessPolicy = pxPolicy;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvReadMtime( void )
+{
+    volatile uint32_t * const pulMtime = ( volatile uint32_t * ) configMTIME_BASE_ADDRESS;
+    uint32_t ulHigh, ulLow;
+
+    do
+    {
+        ulHigh = pulMtime[ 1 ];
+        ulLow = pulMtime[ 0 ];
+    } while( ulHigh != pulMtime[ 1 ] );
+
+    return ( ( uint64_t ) ulHigh << 32 ) | ulLow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteMtimecmp( uint64_t ullCompare )
+{
+    volatile uint32_t * const pulMtimecmp = ( volatile uint32_t * ) configMTIMECMP_BASE_ADDRESS;
+
+    /* No spurious match while the two halves are written. */
+    pulMtimecmp[ 1 ] = UINT32_MAX;
+    pulMtimecmp[ 0 ] = ( uint32_t ) ullCompare;
+    pulMtimecmp[ 1 ] = ( uint32_t ) ( ullCompare >> 32 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    const uint64_t ullIncrement = uxTimerIncrementsForOneTick;
+    /* The policy counts the idle period on 32 bits. */
+    const TickType_t xMaximumSuppressedTicks = ( TickType_t ) ( UINT32_MAX / ullIncrement );
+    uint64_t ullTickCompare, ullWakeCompare, ullNow;
+    TickType_t xCompleteTicks;
+
+    if( xExpectedIdleTime > xMaximumSuppressedTicks )
+    {
+        xExpectedIdleTime = xMaximumSuppressedTicks;
+    }
+
+    /* wfi still wakes up on a pending interrupt enabled in mie. */
+    CSR_CLEAR_BITS( CSR_REG_MSTATUS, 0x8 );
+
+    /* The comparator of the next tick. */
+    ullTickCompare = ullNextTime - ullIncrement;
+    ullNow = prvReadMtime();
+
+    if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( ullNow >= ullTickCompare ) )
+    {
+        /* A task is ready or the tick is pending, let it run. */
+        CSR_SET_BITS( CSR_REG_MSTATUS, 0x8 );
+        return;
+    }
+
+    /* Wake up on the tick boundary of the deadline, whose interrupt then
+       completes the last tick as usual. */
+    ullWakeCompare = ullTickCompare + ( uint64_t ) ( xExpectedIdleTime - 1 ) * ullIncrement;
+    ullNextTime = ullWakeCompare + ullIncrement;
+
+    if( pxTicklessPolicy != NULL )
+    {
+        /* The policy uses the comparator and disables its interrupt on
+           return. */
+        power_policy_idle( pxTicklessPolicy, ( uint32_t ) ( ullWakeCompare - ullNow ) );
+        rv_timer_irq_enable( pxTicklessPolicy->cfg.timer, 0, 0, kRvTimerEnabled );
+    }
+    else
+    {
+        prvWriteMtimecmp( ullWakeCompare );
+        __asm volatile( "wfi" );
+    }
+
+    ullNow = prvReadMtime();
+
+    if( ullNow >= ullWakeCompare )
+    {
+        /* Woken up by the tick: its interrupt is taken once enabled, and
+           catches up with the ticks of a late wake-up one by one. */
+        xCompleteTicks = xExpectedIdleTime - 1;
+        prvWriteMtimecmp( ullWakeCompare );
+    }
+    else
+    {
+        /* Woken up by another interrupt, or early by the policy: realign the
+           tick on the next boundary. */
+        xCompleteTicks = ( ullNow >= ullTickCompare ) ? ( TickType_t ) ( ( ullNow - ullTickCompare ) / ullIncrement ) + 1 : 0;
+        ullTickCompare += ( uint64_t ) xCompleteTicks * ullIncrement;
+        ullNextTime = ullTickCompare + ullIncrement;
+        prvWriteMtimecmp( ullTickCompare );
+    }
+
+    vTaskStepTick( xCompleteTicks );
+
+    CSR_SET_BITS( CSR_REG_MSTATUS, 0x8 );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
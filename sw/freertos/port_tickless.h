@@ -0,0 +1,18 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PORT_TICKLESS_H
+#define PORT_TICKLESS_H
+
+#include "power_policy.h"
+
+/*
+ * Sleeps in the states of a power policy during the tickless idle periods
+ * instead of wfi, or with wfi again if NULL. The policy uses the always-on
+ * rv_timer of the tick, hart 0, comparator 0, with the tick params of the
+ * port (configCPU_CLOCK_HZ / configTICK_RATE_HZ increments per tick).
+ */
+void vPortTicklessSetPolicy( power_policy_t *pxPolicy );
+
+#endif /* PORT_TICKLESS_H */
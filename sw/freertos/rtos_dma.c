@@ -0,0 +1,93 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rtos_dma.h"
+
+#include "task.h"
+#include "semphr.h"
+
+#include "core_v_mini_mcu.h"
+
+typedef struct
+{
+    SemaphoreHandle_t xMutex;
+    TaskHandle_t      xTask;    /* The task waiting for the transfer. */
+    dma_queue_entry_t xEntry;
+} RtosDmaChannel_t;
+
+static RtosDmaChannel_t xChannels[ DMA_CH_NUM ];
+
+/*-----------------------------------------------------------*/
+
+static void prvTransferDone( dma_queue_entry_t *pxEntry )
+{
+    RtosDmaChannel_t *pxChannel = ( RtosDmaChannel_t * ) pxEntry->ctx;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveIndexedFromISR( pxChannel->xTask, rtosDRIVER_NOTIFY_INDEX, &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosDmaInit( void )
+{
+    for( uint32_t i = 0; i < DMA_CH_NUM; i++ )
+    {
+        if( xChannels[ i ].xMutex == NULL )
+        {
+            xChannels[ i ].xMutex = xSemaphoreCreateRecursiveMutex();
+            if( xChannels[ i ].xMutex == NULL )
+            {
+                return pdFAIL;
+            }
+        }
+        xChannels[ i ].xEntry.cb = prvTransferDone;
+        xChannels[ i ].xEntry.ctx = &xChannels[ i ];
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosDmaTakeChannel( uint8_t ucChannel, TickType_t xTicksToWait )
+{
+    configASSERT( ucChannel < DMA_CH_NUM );
+    return xSemaphoreTakeRecursive( xChannels[ ucChannel ].xMutex, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+void vRtosDmaGiveChannel( uint8_t ucChannel )
+{
+    configASSERT( ucChannel < DMA_CH_NUM );
+    xSemaphoreGiveRecursive( xChannels[ ucChannel ].xMutex );
+}
+/*-----------------------------------------------------------*/
+
+dma_config_flags_t xRtosDmaTransfer( dma_trans_t *pxTrans, TickType_t xTicksToWait )
+{
+    RtosDmaChannel_t *pxChannel;
+    dma_config_flags_t xFlags;
+
+    configASSERT( pxTrans->channel < DMA_CH_NUM );
+    pxChannel = &xChannels[ pxTrans->channel ];
+
+    if( xSemaphoreTakeRecursive( pxChannel->xMutex, xTicksToWait ) != pdPASS )
+    {
+        return DMA_CONFIG_TRANS_OVERRIDE;
+    }
+
+    pxChannel->xTask = xTaskGetCurrentTaskHandle();
+    pxChannel->xEntry.trans = pxTrans;
+    xFlags = dma_submit( &pxChannel->xEntry );
+
+    if( ( xFlags & ( DMA_CONFIG_CRITICAL_ERROR | DMA_CONFIG_TRANS_OVERRIDE ) ) == 0 )
+    {
+        ( void ) ulTaskNotifyTakeIndexed( rtosDRIVER_NOTIFY_INDEX, pdTRUE, portMAX_DELAY );
+    }
+
+    xSemaphoreGiveRecursive( pxChannel->xMutex );
+
+    return xFlags;
+}
+/*-----------------------------------------------------------*/
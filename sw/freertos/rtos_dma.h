@@ -0,0 +1,46 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RTOS_DMA_H
+#define RTOS_DMA_H
+
+#include "FreeRTOS.h"
+
+#include "dma.h"
+
+/*
+ * DMA transfers that block the calling task instead of polling, so the other
+ * tasks run during the transfer.
+ *
+ * Each channel has a mutex: the transfers of the tasks on the same channel
+ * are done one after the other. The transfer is submitted to the queue of the
+ * channel (dma_submit()) and its callback, called from the transaction done
+ * interrupt, notifies the task (rtosDRIVER_NOTIFY_INDEX).
+ */
+
+/*
+ * Creates the mutexes of the channels, once, after dma_init().
+ * Returns pdFAIL if the heap is too small.
+ */
+BaseType_t xRtosDmaInit( void );
+
+/*
+ * Takes a channel for the calling task, e.g. for a stream or the DMA of a
+ * driver that uses the channel by itself. Waits at most xTicksToWait.
+ */
+BaseType_t xRtosDmaTakeChannel( uint8_t ucChannel, TickType_t xTicksToWait );
+
+void vRtosDmaGiveChannel( uint8_t ucChannel );
+
+/*
+ * Performs a transaction validated with dma_validate_transaction() on its
+ * channel and blocks until it is done. xTicksToWait bounds the wait for the
+ * channel only: once submitted, the transaction cannot be withdrawn, so the
+ * task waits for its end. May be called with the channel taken by the task.
+ * Returns DMA_CONFIG_TRANS_OVERRIDE if the channel was not free in time, the
+ * flags of dma_submit() otherwise.
+ */
+dma_config_flags_t xRtosDmaTransfer( dma_trans_t *pxTrans, TickType_t xTicksToWait );
+
+#endif /* RTOS_DMA_H */
@@ -0,0 +1,114 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rtos_i2s.h"
+
+#include "semphr.h"
+
+#include "rtos_dma.h"
+
+static SemaphoreHandle_t xI2sMutex = NULL;
+
+/*-----------------------------------------------------------*/
+
+static void prvFrameDone( i2s_capture_t *pxCapture, const void *pvFrame )
+{
+    RtosI2s_t *pxI2s = ( RtosI2s_t * ) pxCapture;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if( pxI2s->xCallback != NULL )
+    {
+        pxI2s->xCallback( pxCapture, pvFrame );
+    }
+
+    if( pxI2s->xTask != NULL )
+    {
+        vTaskNotifyGiveIndexedFromISR( pxI2s->xTask, rtosDRIVER_NOTIFY_INDEX, &xHigherPriorityTaskWoken );
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosI2sInit( void )
+{
+    if( xI2sMutex == NULL )
+    {
+        xI2sMutex = xSemaphoreCreateMutex();
+    }
+
+    return ( xI2sMutex != NULL ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+i2s_result_t xRtosI2sStart( RtosI2s_t *pxI2s, const i2s_capture_cfg_t *pxCfg, TickType_t xTicksToWait )
+{
+    i2s_capture_cfg_t xCfg = *pxCfg;
+    i2s_result_t xResult;
+
+    if( xSemaphoreTake( xI2sMutex, xTicksToWait ) != pdPASS )
+    {
+        return kI2sError;
+    }
+    if( xRtosDmaTakeChannel( xCfg.dma_ch, xTicksToWait ) != pdPASS )
+    {
+        xSemaphoreGive( xI2sMutex );
+        return kI2sError;
+    }
+
+    pxI2s->xCallback = xCfg.cb;
+    pxI2s->xTask = NULL;
+    xCfg.cb = prvFrameDone;
+
+    xResult = i2s_capture_start( &pxI2s->xCapture, &xCfg );
+    if( xResult != kI2sOk )
+    {
+        vRtosDmaGiveChannel( xCfg.dma_ch );
+        xSemaphoreGive( xI2sMutex );
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+const void *pvRtosI2sReadFrame( RtosI2s_t *pxI2s, TickType_t xTicksToWait )
+{
+    const void *pvFrame;
+
+    ( void ) ulTaskNotifyValueClearIndexed( NULL, rtosDRIVER_NOTIFY_INDEX, UINT32_MAX );
+
+    /* Registered before the peek, so a frame filled in between is not
+       missed. */
+    pxI2s->xTask = xTaskGetCurrentTaskHandle();
+
+    while( ( pvFrame = i2s_capture_peek( &pxI2s->xCapture ) ) == NULL )
+    {
+        if( ulTaskNotifyTakeIndexed( rtosDRIVER_NOTIFY_INDEX, pdTRUE, xTicksToWait ) == 0 )
+        {
+            break;
+        }
+    }
+
+    pxI2s->xTask = NULL;
+
+    return pvFrame;
+}
+/*-----------------------------------------------------------*/
+
+void vRtosI2sRelease( RtosI2s_t *pxI2s )
+{
+    i2s_capture_release( &pxI2s->xCapture );
+}
+/*-----------------------------------------------------------*/
+
+i2s_result_t xRtosI2sStop( RtosI2s_t *pxI2s )
+{
+    i2s_result_t xResult = i2s_capture_stop( &pxI2s->xCapture );
+
+    vRtosDmaGiveChannel( pxI2s->xCapture.cfg.dma_ch );
+    xSemaphoreGive( xI2sMutex );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
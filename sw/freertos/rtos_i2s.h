@@ -0,0 +1,55 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RTOS_I2S_H
+#define RTOS_I2S_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "i2s_capture.h"
+
+/*
+ * I2S capture (i2s_capture.h) read by a task that blocks until a frame is
+ * filled, notified by the frame callback from the DMA interrupt.
+ *
+ * The I2S is owned by one capture at a time: xRtosI2sStart() waits for the
+ * mutex of the I2S and for the DMA channel of the capture (rtos_dma.h, after
+ * xRtosDmaInit()), xRtosI2sStop() gives them back.
+ */
+
+typedef struct
+{
+    i2s_capture_t         xCapture; /* First, the callback gets the capture. */
+    i2s_capture_cb_t      xCallback;
+    volatile TaskHandle_t xTask;    /* The task waiting for a frame. */
+} RtosI2s_t;
+
+/*
+ * Creates the mutex of the I2S, once.
+ */
+BaseType_t xRtosI2sInit( void );
+
+/*
+ * Starts a capture, see i2s_capture_start(). The callback of the
+ * configuration is still called, before the task is notified.
+ * Returns kI2sError if the I2S or the DMA channel was not free in time.
+ */
+i2s_result_t xRtosI2sStart( RtosI2s_t *pxI2s, const i2s_capture_cfg_t *pxCfg, TickType_t xTicksToWait );
+
+/*
+ * Returns the oldest filled frame, waiting at most xTicksToWait for one, or
+ * NULL. It is released with vRtosI2sRelease().
+ */
+const void *pvRtosI2sReadFrame( RtosI2s_t *pxI2s, TickType_t xTicksToWait );
+
+void vRtosI2sRelease( RtosI2s_t *pxI2s );
+
+/*
+ * Stops the capture, see i2s_capture_stop(), and frees the I2S. Called by
+ * the task that started it, which owns the mutex.
+ */
+i2s_result_t xRtosI2sStop( RtosI2s_t *pxI2s );
+
+#endif /* RTOS_I2S_H */
@@ -0,0 +1,86 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rtos_spi.h"
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosSpiInit( RtosSpi_t *pxSpi, const spi_host_t *pxHost )
+{
+    pxSpi->xSpi = *pxHost;
+    pxSpi->xTask = NULL;
+    /* Recursive, so that a task holding the SPI host can transfer. */
+    pxSpi->xMutex = xSemaphoreCreateRecursiveMutex();
+
+    return ( pxSpi->xMutex != NULL ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosSpiTake( RtosSpi_t *pxSpi, TickType_t xTicksToWait )
+{
+    return xSemaphoreTakeRecursive( pxSpi->xMutex, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+void vRtosSpiGive( RtosSpi_t *pxSpi )
+{
+    xSemaphoreGiveRecursive( pxSpi->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosSpiTransfer( RtosSpi_t *pxSpi,
+                             const spi_segment_t *pxSegments,
+                             uint32_t ulSegments,
+                             TickType_t xTicksToWait )
+{
+    BaseType_t xResult = pdPASS;
+
+    if( xSemaphoreTakeRecursive( pxSpi->xMutex, xTicksToWait ) != pdPASS )
+    {
+        return pdFAIL;
+    }
+
+    /* The notification of a transfer that timed out is stale. */
+    ( void ) ulTaskNotifyValueClearIndexed( NULL, rtosDRIVER_NOTIFY_INDEX, UINT32_MAX );
+    pxSpi->xTask = xTaskGetCurrentTaskHandle();
+
+    spi_clear_evt_intr( &pxSpi->xSpi );
+    spi_enable_idle_intr( &pxSpi->xSpi, true );
+    spi_enable_evt_intr( &pxSpi->xSpi, true );
+    spi_issue_segments( &pxSpi->xSpi, pxSegments, ulSegments );
+
+    if( ulTaskNotifyTakeIndexed( rtosDRIVER_NOTIFY_INDEX, pdTRUE, xTicksToWait ) == 0 )
+    {
+        taskENTER_CRITICAL();
+        spi_enable_evt_intr( &pxSpi->xSpi, false );
+        spi_enable_idle_intr( &pxSpi->xSpi, false );
+        pxSpi->xTask = NULL;
+        taskEXIT_CRITICAL();
+        xResult = pdFAIL;
+    }
+
+    xSemaphoreGiveRecursive( pxSpi->xMutex );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+void vRtosSpiIrqHandler( RtosSpi_t *pxSpi )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* The idle event stays asserted while idle, it is enabled per transfer. */
+    spi_enable_evt_intr( &pxSpi->xSpi, false );
+    spi_enable_idle_intr( &pxSpi->xSpi, false );
+    spi_clear_evt_intr( &pxSpi->xSpi );
+
+    if( pxSpi->xTask != NULL )
+    {
+        vTaskNotifyGiveIndexedFromISR( pxSpi->xTask, rtosDRIVER_NOTIFY_INDEX, &xHigherPriorityTaskWoken );
+        pxSpi->xTask = NULL;
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,62 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RTOS_SPI_H
+#define RTOS_SPI_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "spi_host.h"
+
+/*
+ * SPI host transfers that block the calling task until the SPI host is idle,
+ * notified by its event interrupt, instead of spi_wait_for_ready().
+ *
+ * The transfers of the tasks are serialized by the mutex of the SPI host. The
+ * SPI event interrupt must be routed to vRtosSpiIrqHandler(): fic_irq_spi()
+ * for SPI_HOST, fic_irq_spi_flash() for the flash SPI and the PLIC handler of
+ * SPI2.
+ */
+
+typedef struct
+{
+    spi_host_t            xSpi;
+    SemaphoreHandle_t     xMutex;
+    volatile TaskHandle_t xTask;    /* The task waiting for the idle event. */
+} RtosSpi_t;
+
+/*
+ * Creates the mutex. The SPI host must already be enabled and configured.
+ */
+BaseType_t xRtosSpiInit( RtosSpi_t *pxSpi, const spi_host_t *pxHost );
+
+/*
+ * Takes the SPI host for several transfers, e.g. to change the chip select
+ * or the configuration options in between.
+ */
+BaseType_t xRtosSpiTake( RtosSpi_t *pxSpi, TickType_t xTicksToWait );
+
+void vRtosSpiGive( RtosSpi_t *pxSpi );
+
+/*
+ * Issues segments (spi_issue_segments()) and blocks until the SPI host has
+ * executed them. The TX data is written by the caller or a DMA transaction,
+ * the RX data is left in the RX FIFO. May be called with the SPI host taken
+ * by the task.
+ * Returns pdFAIL if the SPI host was not free or not idle within
+ * xTicksToWait: it must then be reset with spi_sw_reset().
+ */
+BaseType_t xRtosSpiTransfer( RtosSpi_t *pxSpi,
+                             const spi_segment_t *pxSegments,
+                             uint32_t ulSegments,
+                             TickType_t xTicksToWait );
+
+/*
+ * Serves the SPI event interrupt, from an interrupt handler only.
+ */
+void vRtosSpiIrqHandler( RtosSpi_t *pxSpi );
+
+#endif /* RTOS_SPI_H */
@@ -0,0 +1,106 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rtos_uart.h"
+
+#include "core_v_mini_mcu.h"
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xRtosUartInit( RtosUart_t *pxUart,
+                          const uart_t *pxParams,
+                          uint8_t *pucTxBuf,
+                          size_t xTxSize,
+                          uint8_t *pucRxBuf,
+                          size_t xRxSize,
+                          uint8_t ucDmaChannel )
+{
+    pxUart->xTask = NULL;
+    pxUart->xMutex = xSemaphoreCreateMutex();
+    if( pxUart->xMutex == NULL )
+    {
+        return pdFAIL;
+    }
+
+    if( uart_buffered_init( &pxUart->xUart, pxParams, pucTxBuf, xTxSize, pucRxBuf, xRxSize, ucDmaChannel ) != kErrorOk )
+    {
+        vSemaphoreDelete( pxUart->xMutex );
+        pxUart->xMutex = NULL;
+        return pdFAIL;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+/* Waits for the TX ring to move, with the mutex held. */
+static void prvWaitTx( void )
+{
+    ( void ) ulTaskNotifyTakeIndexed( rtosDRIVER_NOTIFY_INDEX, pdTRUE, rtosUART_POLL_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+size_t xRtosUartWrite( RtosUart_t *pxUart, const uint8_t *pucData, size_t xLen, TickType_t xTicksToWait )
+{
+    size_t xDone = 0;
+
+    if( xSemaphoreTake( pxUart->xMutex, xTicksToWait ) != pdPASS )
+    {
+        return 0;
+    }
+
+    /* Registered before the ring is checked, so room made in between is not
+       missed. */
+    pxUart->xTask = xTaskGetCurrentTaskHandle();
+
+    for( ;; )
+    {
+        xDone += uart_buffered_write_nonblocking( &pxUart->xUart, pucData + xDone, xLen - xDone );
+        if( xDone == xLen )
+        {
+            break;
+        }
+        prvWaitTx();
+    }
+
+    pxUart->xTask = NULL;
+    xSemaphoreGive( pxUart->xMutex );
+
+    return xDone;
+}
+/*-----------------------------------------------------------*/
+
+void vRtosUartFlush( RtosUart_t *pxUart )
+{
+    ( void ) xSemaphoreTake( pxUart->xMutex, portMAX_DELAY );
+
+    pxUart->xTask = xTaskGetCurrentTaskHandle();
+    while( pxUart->xUart.tx.head != pxUart->xUart.tx.tail )
+    {
+        prvWaitTx();
+    }
+    pxUart->xTask = NULL;
+
+    /* At most a FIFO left. */
+    uart_wait_tx_done( &pxUart->xUart.uart );
+
+    xSemaphoreGive( pxUart->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+void vRtosUartIrqHandler( RtosUart_t *pxUart, uint32_t ulId )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    TaskHandle_t xTask = pxUart->xTask;
+
+    uart_buffered_irq_handler( &pxUart->xUart, ulId );
+
+    if( ( ulId == UART_INTR_TX_WATERMARK ) && ( xTask != NULL ) )
+    {
+        vTaskNotifyGiveIndexedFromISR( xTask, rtosDRIVER_NOTIFY_INDEX, &xHigherPriorityTaskWoken );
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
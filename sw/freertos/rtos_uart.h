@@ -0,0 +1,64 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RTOS_UART_H
+#define RTOS_UART_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "uart_buffered.h"
+
+/*
+ * Buffered UART (uart_buffered.h) shared by the tasks. A writer blocks while
+ * the TX ring is full instead of spinning, and the writes of the tasks are
+ * not interleaved: each one holds the mutex of the UART.
+ *
+ * handler_irq_uart() must call vRtosUartIrqHandler(), which notifies the
+ * waiting task once the watermark interrupt has made room. With a DMA
+ * channel, the last bytes are moved by the DMA interrupt: the waits are also
+ * bounded by rtosUART_POLL_TICKS.
+ */
+
+#ifndef rtosUART_POLL_TICKS
+    #define rtosUART_POLL_TICKS     ( ( TickType_t ) 1 )
+#endif
+
+typedef struct
+{
+    uart_buffered_t       xUart;
+    SemaphoreHandle_t     xMutex;
+    volatile TaskHandle_t xTask;    /* The task waiting for room. */
+} RtosUart_t;
+
+/*
+ * Creates the mutex and initializes the buffered UART, see
+ * uart_buffered_init(). Returns pdFAIL on error.
+ */
+BaseType_t xRtosUartInit( RtosUart_t *pxUart,
+                          const uart_t *pxParams,
+                          uint8_t *pucTxBuf,
+                          size_t xTxSize,
+                          uint8_t *pucRxBuf,
+                          size_t xRxSize,
+                          uint8_t ucDmaChannel );
+
+/*
+ * Writes a buffer, blocking while the TX ring is full. Returns the number of
+ * bytes written, less than xLen if the UART was not free within xTicksToWait.
+ */
+size_t xRtosUartWrite( RtosUart_t *pxUart, const uint8_t *pucData, size_t xLen, TickType_t xTicksToWait );
+
+/*
+ * Blocks until everything written has been sent.
+ */
+void vRtosUartFlush( RtosUart_t *pxUart );
+
+/*
+ * Serves the UART interrupts, call it from handler_irq_uart().
+ */
+void vRtosUartIrqHandler( RtosUart_t *pxUart, uint32_t ulId );
+
+#endif /* RTOS_UART_H */
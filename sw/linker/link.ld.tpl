@@ -25,6 +25,12 @@ MEMORY
 % if ram_numbanks_cont > 1 and ram_numbanks_il > 0:
   ram_il (rwxai) : ORIGIN = 0x${linker_onchip_il_start_address}, LENGTH = 0x${linker_onchip_il_size_address}
 % endif  
+% if int(tcm_size_address, 16) > 0:
+  tcm (rw) : ORIGIN = 0x${tcm_start_address}, LENGTH = 0x${tcm_size_address}
+% endif
+% for name, slave in ext_slaves.items():
+  ext_${name} (rw) : ORIGIN = 0x${'{:08X}'.format(slave['start'])}, LENGTH = 0x${slave['length']}
+% endfor
 }
 
 /*
@@ -41,6 +47,7 @@ SECTIONS
   __stack_size = DEFINED(__stack_size) ? __stack_size : 0x${stack_size};
   PROVIDE(__stack_size = __stack_size);
   __heap_size = DEFINED(__heap_size) ? __heap_size : 0x${heap_size};
+  __arena_size = DEFINED(__arena_size) ? __arena_size : 0x${arena_size};
 
   /* Read-only sections, merged into text segment: */
   PROVIDE (__executable_start = SEGMENT_START("text-segment", 0x10000)); . = SEGMENT_START("text-segment", 0x10000) + SIZEOF_HEADERS;
@@ -83,6 +90,11 @@ SECTIONS
     }
 */
 
+  /* RAM used by the program, which the banks of the power manager hold
+     (ram_banks.h): code in ram0, static data in ram1 */
+  PROVIDE(__ram_code_start = ORIGIN(ram0));
+  PROVIDE(__ram_data_start = ORIGIN(ram1));
+
   /* interrupt vectors */
   .vectors (ORIGIN(ram0)):
   {
@@ -111,6 +123,13 @@ SECTIONS
     *(.text.startup .text.startup.*)
     *(.text.hot .text.hot.*)
     *(.text .stub .text.* .gnu.linkonce.t.*)
+    /* interrupt handlers (INTERRUPT_HANDLER_ABI of handler.h) */
+    *(.xheep_isr .xheep_isr.*)
+% if fast_bank is None:
+    *(.xheep_text_fast .xheep_text_fast.*)
+% endif
+    /* code overlays, resident in the RAM with this linker script */
+    *(.xheep_overlay*)
     /* .gnu.warning sections are handled specially by elf32.em.  */
     *(.gnu.warning)
   } >ram0
@@ -127,6 +146,40 @@ SECTIONS
     KEEP (*(SORT_NONE(.fini)))
   } >ram0
 
+  /* Task stacks, queues and buffers pinned to a RAM bank (rtosSECTION_BANK
+     of sw/freertos/port_sections.h), for the banks of the code: after the
+     code that shares their bank. They are not loaded nor zeroed */
+<%
+  data_start = int(linker_onchip_data_start_address, 16)
+  banks = [(n, start, start + size) for n, (start, size) in enumerate(ram_banks[:ram_numbanks_cont])]
+  code_banks = [b for b in banks if b[2] <= data_start]
+  data_banks = [b for b in banks if b[2] > data_start]
+%>\
+% for n, start, end in code_banks:
+% if n == fast_bank:
+  /* hot code and data (XHEEP_SECTION_FAST_TEXT/DATA of bank_sections.h) at
+     the start of bank ${n}, which the rest of the code must not reach: their
+     accesses do not wait for the DMA working on the buffers of other banks */
+  .fast MAX(., 0x${'{:08X}'.format(start)}) : ALIGN(4)
+  {
+   PROVIDE(__fast_start = .);
+   *(.xheep_text_fast .xheep_text_fast.*)
+   *(.xheep_data_fast .xheep_data_fast.*)
+   . = ALIGN(4);
+   PROVIDE(__fast_end = .);
+  } >ram0
+  ASSERT(__fast_start == 0x${'{:08X}'.format(start)}, "the code reaches bank ${n} of the hot code and data")
+  ASSERT(__fast_end <= 0x${'{:08X}'.format(end)}, "the hot code and data do not fit in bank ${n}")
+% endif
+  .xheep_bank${n} MAX(., 0x${'{:08X}'.format(start)}) (NOLOAD) :
+  {
+   PROVIDE(__xheep_bank${n}_start = .);
+   KEEP(*(.xheep_bank${n} .xheep_bank${n}.*))
+   PROVIDE(__xheep_bank${n}_end = .);
+  } >ram0
+  ASSERT(__xheep_bank${n}_start == __xheep_bank${n}_end || __xheep_bank${n}_end <= 0x${'{:08X}'.format(end)}, "the objects of .xheep_bank${n} do not fit in bank ${n} after the code")
+% endfor
+
   PROVIDE (__etext = .);
   PROVIDE (_etext = .);
   PROVIDE (etext = .);
@@ -141,6 +194,17 @@ SECTIONS
     *(.rodata1)
   } >ram1
 
+  /* Large constant tables (FLASH_RODATA in spi_memio.h). There is no flash
+     image with this linker, so they stay in the RAM with the rest of the
+     program */
+  .rodata_flash   : ALIGN(4)
+  {
+    PROVIDE(__rodata_flash_start = .);
+    KEEP(*(.rodata_flash .rodata_flash.*))
+    . = ALIGN(4);
+    PROVIDE(__rodata_flash_end = .);
+  } >ram1
+
   /* second level sbss and sdata, I don't think we need this */
   /* .sdata2         : {*(.sdata2 .sdata2.* .gnu.linkonce.s2.*)} */
   /* .sbss2          : { *(.sbss2 .sbss2.* .gnu.linkonce.sb2.*) } */
@@ -261,6 +325,9 @@ SECTIONS
   {
     __DATA_BEGIN__ = .;
     *(.data .data.* .gnu.linkonce.d.*)
+% if fast_bank is None:
+    *(.xheep_data_fast .xheep_data_fast.*)
+% endif
     SORT(CONSTRUCTORS)
   } >ram1
   .data1          :
@@ -322,8 +389,21 @@ SECTIONS
    PROVIDE(__heap_start = .);
    . = __heap_size;
    PROVIDE(__heap_end = .);
+   /* kernel heap of FreeRTOS (rtosSECTION_HEAP of sw/freertos/port_sections.h) */
+   PROVIDE(__rtos_heap_start = .);
+   *(.xheep_rtos_heap .heap)
+   PROVIDE(__rtos_heap_end = .);
+  } >ram1
+
+  /* region of the arena and pool allocators (sw/device/lib/alloc) */
+  .arena         : ALIGN(8)
+  {
+   PROVIDE(__arena_start = .);
+   . = __arena_size;
+   PROVIDE(__arena_end = .);
   } >ram1
 
+% if not tcm_stack:
   /* stack: we should consider putting this further to the top of the address
     space */
   .stack         : ALIGN(16) /* this is a requirement of the ABI(?) */
@@ -334,13 +414,110 @@ SECTIONS
    PROVIDE(__stack_end = .);
    PROVIDE(__freertos_irq_stack_top = .);
   } >ram1
+% endif
+
+% if cpu_num > 1:
+  /* stacks of the secondary harts, __stack_size each, always in the RAM as
+     the TCM is only reached by hart 0 */
+  .stack_harts (NOLOAD) : ALIGN(16)
+  {
+   PROVIDE(__stack_harts_start = .);
+   . = __stack_size * ${cpu_num - 1};
+   PROVIDE(__stack_harts_end = .);
+  } >ram1
+% endif
+
+  /* objects pinned to the banks of the data, after the stack */
+% for n, start, end in data_banks:
+% if n == fast_bank:
+  /* hot code and data (XHEEP_SECTION_FAST_TEXT/DATA of bank_sections.h) at
+     the start of bank ${n}, which the rest of the data must not reach: their
+     accesses do not wait for the DMA working on the buffers of other banks */
+  .fast MAX(., 0x${'{:08X}'.format(start)}) : ALIGN(4)
+  {
+   PROVIDE(__fast_start = .);
+   *(.xheep_text_fast .xheep_text_fast.*)
+   *(.xheep_data_fast .xheep_data_fast.*)
+   . = ALIGN(4);
+   PROVIDE(__fast_end = .);
+  } >ram1
+  ASSERT(__fast_start == 0x${'{:08X}'.format(start)}, "the data reaches bank ${n} of the hot code and data")
+  ASSERT(__fast_end <= 0x${'{:08X}'.format(end)}, "the hot code and data do not fit in bank ${n}")
+% endif
+  .xheep_bank${n} MAX(., 0x${'{:08X}'.format(start)}) (NOLOAD) :
+  {
+   PROVIDE(__xheep_bank${n}_start = .);
+   KEEP(*(.xheep_bank${n} .xheep_bank${n}.*))
+   PROVIDE(__xheep_bank${n}_end = .);
+  } >ram1
+  ASSERT(__xheep_bank${n}_start == __xheep_bank${n}_end || __xheep_bank${n}_end <= 0x${'{:08X}'.format(end)}, "the objects of .xheep_bank${n} do not fit in bank ${n} after the data")
+% endfor
+
+% if fast_bank is None:
+  PROVIDE(__fast_start = 0);
+  PROVIDE(__fast_end = 0);
+% endif
+
+  /* no overlay window: overlay_load (overlay.h) finds an empty table */
+  PROVIDE(__overlay_start = 0);
+  PROVIDE(__overlay_end = 0);
+  PROVIDE(__overlay_table_start = 0);
+  PROVIDE(__overlay_table_end = 0);
 
 % if ram_numbanks_cont > 1 and ram_numbanks_il > 0:
   .data_interleaved :
   {
+   PROVIDE(__ram_il_start = .);
+   *(.xheep_data_interleaved)
+   PROVIDE(__ram_il_end = .);
   } >ram_il
+% else:
+  PROVIDE(__ram_il_start = 0);
+  PROVIDE(__ram_il_end = 0);
 % endif
 
+  /* private scratchpad of the core (XHEEP_SECTION_TCM of bank_sections.h),
+     which only the core reaches: the stack if it goes there, then the
+     objects of .tcm, neither loaded nor zeroed. Without scratchpad they stay
+     in ram1 */
+% if tcm_stack:
+  .stack (NOLOAD) : ALIGN(16)
+  {
+   PROVIDE(__stack_start = .);
+   . = __stack_size;
+   PROVIDE(_sp = .);
+   PROVIDE(__stack_end = .);
+   PROVIDE(__freertos_irq_stack_top = .);
+  } >tcm
+% endif
+  .tcm (NOLOAD) : ALIGN(4)
+  {
+   PROVIDE(__tcm_start = .);
+   KEEP(*(.tcm .tcm.*))
+   PROVIDE(__tcm_end = .);
+  } >${'tcm' if int(tcm_size_address, 16) > 0 else 'ram1'}
+
+  /* objects of the external slaves (XHEEP_SECTION_EXT of bank_sections.h),
+     neither loaded nor zeroed */
+% for name in ext_slaves:
+  .xheep_ext_${name} (NOLOAD) : ALIGN(4)
+  {
+   PROVIDE(__ext_${name}_start = .);
+   KEEP(*(.xheep_ext_${name} .xheep_ext_${name}.*))
+   PROVIDE(__ext_${name}_end = .);
+  } >ext_${name}
+% endfor
+
+  /* end of the sections placed in ram0 and ram1 */
+  .ram0_end (NOLOAD) :
+  {
+   PROVIDE(__ram_code_end = .);
+  } >ram0
+  .ram1_end (NOLOAD) :
+  {
+   PROVIDE(__ram_data_end = .);
+  } >ram1
+
   /* Stabs debugging sections.  */
   .stab          0 : { *(.stab) }
   .stabstr       0 : { *(.stabstr) }
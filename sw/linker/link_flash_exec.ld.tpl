@@ -9,6 +9,12 @@ MEMORY
 {
     FLASH (rx)      : ORIGIN = 0x${flash_mem_start_address}, LENGTH = 0x${flash_mem_size_address}
     RAM (xrw)       : ORIGIN = 0x${'{:08X}'.format(int(ram_start_address,16) + 4)}, LENGTH = 0x${'{:08X}'.format(int(ram_size_address,16) - 4)}
+% if int(tcm_size_address, 16) > 0:
+    TCM (rw)        : ORIGIN = 0x${tcm_start_address}, LENGTH = 0x${tcm_size_address}
+% endif
+% for name, slave in ext_slaves.items():
+    EXT_${name.upper()} (rw) : ORIGIN = 0x${'{:08X}'.format(slave['start'])}, LENGTH = 0x${slave['length']}
+% endfor
 }
 
 SECTIONS {
@@ -20,13 +26,7 @@ SECTIONS {
     __stack_size = DEFINED(__stack_size) ? __stack_size : 0x${stack_size};
     PROVIDE(__stack_size = __stack_size);
     __heap_size = DEFINED(__heap_size) ? __heap_size : 0x${heap_size};
-
-    /* interrupt vectors */
-    .vectors (ORIGIN(FLASH)):
-    {
-      PROVIDE(__vector_start = .);
-      KEEP(*(.vectors));
-    } >FLASH
+    __arena_size = DEFINED(__arena_size) ? __arena_size : 0x${arena_size};
 
     /* crt0 init code */
     .init (__boot_address):
@@ -35,20 +35,52 @@ SECTIONS {
 	KEEP (*(.text.start))
     } >FLASH
 
+    /* interrupt vectors and the code they jump to, copied from the flash to
+    the RAM by crt0 so that taking an interrupt does not wait for the flash:
+    the table, its default handlers (.text.vecs of vectors.S), the handlers
+    defined with INTERRUPT_HANDLER_ABI of handler.h and the trap handler of
+    FreeRTOS. The jumps of the table only reach 1MiB, so all of them are in
+    the RAM. mtvec needs the table aligned on 256 bytes. Before .text, whose
+    patterns would take the sections first */
+    .vectors : ALIGN(256)
+    {
+      _sivectors = LOADADDR(.vectors);
+      PROVIDE(__vector_start = .);
+      KEEP(*(.vectors));
+      *(.text.vecs)
+      *(.xheep_isr .xheep_isr.*)
+      *portASM.S.obj(.text .text.*)
+      . = ALIGN(4);
+      PROVIDE(__vector_end = .);
+    } >RAM AT >FLASH
+
     /* The program code and other data goes into FLASH */
     .text :
     {
         . = ALIGN(4);
         *(.text)           /* .text sections (code) */
         *(.text*)          /* .text* sections (code) */
+% if overlays == 0:
+        *(.xheep_overlay*) /* code overlays, linked with the rest without overlays */
+% endif
         *(.rodata)         /* .rodata sections (constants, strings, etc.) */
-        *(.rodata*)        /* .rodata* sections (constants, strings, etc.) */
+        *(.rodata.*)       /* .rodata.* sections (constants, strings, etc.) */
         *(.srodata)        /* .rodata sections (constants, strings, etc.) */
         *(.srodata*)       /* .rodata* sections (constants, strings, etc.) */
         . = ALIGN(4);
         _etext = .;        /* define a global symbol at end of code */
     } >FLASH
 
+    /* Large constant tables (FLASH_RODATA in spi_memio.h), read in place
+    through the SPI MEMIO like the rest of .rodata */
+    .rodata_flash : ALIGN(4)
+    {
+        PROVIDE(__rodata_flash_start = .);
+        KEEP(*(.rodata_flash .rodata_flash.*))
+        . = ALIGN(4);
+        PROVIDE(__rodata_flash_end = .);
+    } >FLASH
+
     /* This is the initialized data section
     The program executes knowing that the data is in the RAM
     but the loader puts the initial values in the FLASH (inidata).
@@ -66,10 +98,61 @@ SECTIONS {
         __SDATA_BEGIN__ = .;
         *(.sdata)           /* .sdata sections */
         *(.sdata*)          /* .sdata* sections */
+% if overlays > 0:
+        /* table of the code overlays, the start and the end of each one in
+        the flash, for overlay.h */
+        . = ALIGN(4);
+        PROVIDE(__overlay_table_start = .);
+% for n in range(overlays):
+        LONG(__load_start_xheep_overlay${n}) LONG(__load_stop_xheep_overlay${n})
+% endfor
+        PROVIDE(__overlay_table_end = .);
+% endif
         . = ALIGN(4);
         _edata = .;        /* define a global symbol at data end; used by startup code in order to initialise the .data section in RAM */
     } >RAM AT >FLASH
 
+% if fast_bank is None:
+    /* hot code and data (XHEEP_SECTION_FAST_TEXT/DATA of bank_sections.h),
+    copied from the flash to the RAM by the startup so that they do not wait
+    for the flash */
+    .fast : ALIGN(4)
+    {
+        _sifast = LOADADDR(.fast);
+        PROVIDE(__fast_start = .);
+        *(.xheep_text_fast .xheep_text_fast.*)
+        *(.xheep_data_fast .xheep_data_fast.*)
+        . = ALIGN(4);
+        PROVIDE(__fast_end = .);
+    } >RAM AT >FLASH
+% endif
+
+% if overlays > 0:
+    /* code overlays (XHEEP_SECTION_OVERLAY of bank_sections.h), left in the
+    flash after _edata and loaded on demand by overlay_load (overlay.h) in a
+    window of the RAM that they share, as large as the largest of them. The
+    NOLOAD section reserves their place in the flash for the sections that
+    follow. They must not call each other */
+    .xheep_overlay_load (NOLOAD) : ALIGN(4)
+    {
+        __overlay_load_start = .;
+        . += ${' + '.join('SIZEOF(.xheep_overlay{})'.format(n) for n in range(overlays))};
+    } >FLASH
+    OVERLAY : NOCROSSREFS AT(__overlay_load_start)
+    {
+% for n in range(overlays):
+        .xheep_overlay${n} { KEEP(*(.xheep_overlay${n} .xheep_overlay${n}.*)) . = ALIGN(4); }
+% endfor
+    } >RAM
+    PROVIDE(__overlay_start = ADDR(.xheep_overlay0));
+    PROVIDE(__overlay_end = .);
+% else:
+    PROVIDE(__overlay_start = 0);
+    PROVIDE(__overlay_end = 0);
+    PROVIDE(__overlay_table_start = 0);
+    PROVIDE(__overlay_table_end = 0);
+% endif
+
     .power_manager : ALIGN(4096)
     {
        PROVIDE(__power_manager_start = .);
@@ -103,8 +186,21 @@ SECTIONS {
      PROVIDE(__heap_start = .);
     . = __heap_size;
     PROVIDE(__heap_end = .);
+    /* kernel heap of FreeRTOS (rtosSECTION_HEAP of sw/freertos/port_sections.h) */
+    PROVIDE(__rtos_heap_start = .);
+    *(.xheep_rtos_heap .heap)
+    PROVIDE(__rtos_heap_end = .);
+    } >RAM
+
+    /* region of the arena and pool allocators (sw/device/lib/alloc) */
+    .arena         : ALIGN(8)
+    {
+        PROVIDE(__arena_start = .);
+        . = __arena_size;
+        PROVIDE(__arena_end = .);
     } >RAM
 
+% if not tcm_stack:
     /* stack: we should consider putting this further to the top of the address
     space */
   .stack         : ALIGN(16) /* this is a requirement of the ABI(?) */
@@ -115,4 +211,87 @@ SECTIONS {
    PROVIDE(__stack_end = .);
    PROVIDE(__freertos_irq_stack_top = .);
   } >RAM
+% endif
+
+% if cpu_num > 1:
+  /* stacks of the secondary harts, __stack_size each, always in the RAM as
+     the TCM is only reached by hart 0 */
+  .stack_harts (NOLOAD) : ALIGN(16)
+  {
+   PROVIDE(__stack_harts_start = .);
+   . = __stack_size * ${cpu_num - 1};
+   PROVIDE(__stack_harts_end = .);
+  } >RAM
+% endif
+
+    /* task stacks, queues and buffers pinned to a RAM bank (rtosSECTION_BANK
+    of sw/freertos/port_sections.h), after the stack. They are not loaded nor
+    zeroed */
+% for n in range(ram_numbanks_cont):
+% if n == fast_bank:
+    /* hot code and data (XHEEP_SECTION_FAST_TEXT/DATA of bank_sections.h),
+    copied from the flash by the startup to the start of bank ${n}, which the
+    rest of the RAM must not reach */
+    .fast MAX(., 0x${'{:08X}'.format(ram_banks[n][0])}) : ALIGN(4)
+    {
+        _sifast = LOADADDR(.fast);
+        PROVIDE(__fast_start = .);
+        *(.xheep_text_fast .xheep_text_fast.*)
+        *(.xheep_data_fast .xheep_data_fast.*)
+        . = ALIGN(4);
+        PROVIDE(__fast_end = .);
+    } >RAM AT >FLASH
+    ASSERT(__fast_start == 0x${'{:08X}'.format(ram_banks[n][0])}, "the RAM used by the program reaches bank ${n} of the hot code and data")
+    ASSERT(__fast_end <= 0x${'{:08X}'.format(ram_banks[n][0] + ram_banks[n][1])}, "the hot code and data do not fit in bank ${n}")
+% endif
+    .xheep_bank${n} MAX(., 0x${'{:08X}'.format(ram_banks[n][0])}) (NOLOAD) :
+    {
+        PROVIDE(__xheep_bank${n}_start = .);
+        KEEP(*(.xheep_bank${n} .xheep_bank${n}.*))
+        PROVIDE(__xheep_bank${n}_end = .);
+    } >RAM
+    ASSERT(__xheep_bank${n}_start == __xheep_bank${n}_end || __xheep_bank${n}_end <= 0x${'{:08X}'.format(ram_banks[n][0] + ram_banks[n][1])}, "the objects of .xheep_bank${n} do not fit in bank ${n}")
+% endfor
+
+    /* private scratchpad of the core (XHEEP_SECTION_TCM of bank_sections.h),
+    which only the core reaches: the stack if it goes there, then the objects
+    of .tcm, neither loaded nor zeroed. Without scratchpad they stay in RAM */
+% if tcm_stack:
+    .stack (NOLOAD) : ALIGN(16)
+    {
+        PROVIDE(__stack_start = .);
+        . = __stack_size;
+        PROVIDE(_sp = .);
+        PROVIDE(__stack_end = .);
+        PROVIDE(__freertos_irq_stack_top = .);
+    } >TCM
+% endif
+    .tcm (NOLOAD) : ALIGN(4)
+    {
+        PROVIDE(__tcm_start = .);
+        KEEP(*(.tcm .tcm.*))
+        PROVIDE(__tcm_end = .);
+    } >${'TCM' if int(tcm_size_address, 16) > 0 else 'RAM'}
+
+    /* objects of the external slaves (XHEEP_SECTION_EXT of bank_sections.h),
+    neither loaded nor zeroed */
+% for name in ext_slaves:
+    .xheep_ext_${name} (NOLOAD) : ALIGN(4)
+    {
+        PROVIDE(__ext_${name}_start = .);
+        KEEP(*(.xheep_ext_${name} .xheep_ext_${name}.*))
+        PROVIDE(__ext_${name}_end = .);
+    } >EXT_${name.upper()}
+% endfor
+
+    /* RAM used by the program, which the banks of the power manager hold
+    (ram_banks.h): the vectors and the interrupt handlers and the static
+    data, the rest of the code runs from the flash. The heap, the arena, the
+    stack and the hot code and data have their own symbols */
+    PROVIDE(__ram_code_start = __vector_start);
+    PROVIDE(__ram_code_end = __vector_end);
+    PROVIDE(__ram_data_start = _sdata);
+    PROVIDE(__ram_data_end = __bss_end);
+    PROVIDE(__ram_il_start = 0);
+    PROVIDE(__ram_il_end = 0);
 }
@@ -9,6 +9,12 @@ MEMORY
 {
     FLASH (rx)      : ORIGIN = 0x${flash_mem_start_address}, LENGTH = 0x${flash_mem_size_address}
     RAM (xrw)       : ORIGIN = 0x${'{:08X}'.format(int(ram_start_address,16))}, LENGTH = 0x${'{:08X}'.format(int(ram_size_address,16) - 4)}
+% if int(tcm_size_address, 16) > 0:
+    TCM (rw)        : ORIGIN = 0x${tcm_start_address}, LENGTH = 0x${tcm_size_address}
+% endif
+% for name, slave in ext_slaves.items():
+    EXT_${name.upper()} (rw) : ORIGIN = 0x${'{:08X}'.format(slave['start'])}, LENGTH = 0x${slave['length']}
+% endfor
 }
 
 SECTIONS {
@@ -20,6 +26,7 @@ SECTIONS {
     __stack_size = DEFINED(__stack_size) ? __stack_size : 0x${stack_size};
     PROVIDE(__stack_size = __stack_size);
     __heap_size = DEFINED(__heap_size) ? __heap_size : 0x${heap_size};
+    __arena_size = DEFINED(__arena_size) ? __arena_size : 0x${arena_size};
 
     /* interrupt vectors */
     .vectors (ORIGIN(RAM)):
@@ -29,19 +36,36 @@ SECTIONS {
         __VECTORS_AT = .;
     } >RAM AT >FLASH
 
-    /* Fill memory up to __boot_address */
+    /* Fill memory up to the boot header */
     .fill :
     {
         FILL(0xDEADBEEF);
-        . = ORIGIN(RAM) + (__boot_address) - 1;
+        . = ORIGIN(RAM) + (__boot_address) - 16 - 1;
         BYTE(0xEE)
     } >RAM AT >FLASH
 
+    /* Boot header, just below __boot_address: the boot rom copies the first
+       __boot_image_size bytes of the flash with the SPI clock divider and the
+       reads of __boot_spi_cfg, see hw/ip/boot_rom/README.md. The four words
+       add up to 0 */
+    __boot_image_size = _edata - ORIGIN(RAM);
+    __boot_spi_cfg = ${boot_spi_clkdiv} | (${1 if boot_spi_quad else 0} << 16);
+    .boot_header (ORIGIN(RAM) + (__boot_address) - 16):
+    {
+        PROVIDE(__boot_header = .);
+        LONG(0x48424858)
+        LONG(__boot_image_size)
+        LONG(__boot_spi_cfg)
+        LONG(0 - (0x48424858 + __boot_image_size + __boot_spi_cfg))
+    } >RAM AT >FLASH
+
     /* crt0 init code */
     .init (__boot_address):
     {
         KEEP (*(SORT_NONE(.init)))
         KEEP (*(.text.start))
+        /* the boot rom only copies the first 1KiB, crt0 copies the rest */
+        ASSERT(. <= ORIGIN(RAM) + 0x400, "crt0 does not fit in the 1KiB copied by the boot rom");
     } >RAM AT >FLASH
 
     /* The program code and other data goes into FLASH */
@@ -50,8 +74,13 @@ SECTIONS {
         . = ALIGN(4);
         *(.text)           /* .text sections (code) */
         *(.text*)          /* .text* sections (code) */
+        *(.xheep_isr .xheep_isr.*) /* interrupt handlers (INTERRUPT_HANDLER_ABI of handler.h) */
+        *(.xheep_text_fast .xheep_text_fast.*) /* hot code, with the rest as all the program is copied to the RAM */
+% if overlays == 0:
+        *(.xheep_overlay*) /* code overlays, linked with the rest without overlays */
+% endif
         *(.rodata)         /* .rodata sections (constants, strings, etc.) */
-        *(.rodata*)        /* .rodata* sections (constants, strings, etc.) */
+        *(.rodata.*)       /* .rodata.* sections (constants, strings, etc.) */
         *(.srodata)        /* .rodata sections (constants, strings, etc.) */
         *(.srodata*)       /* .rodata* sections (constants, strings, etc.) */
         . = ALIGN(4);
@@ -72,13 +101,61 @@ SECTIONS {
         __DATA_BEGIN__ = .;
         *(.data)           /* .data sections */
         *(.data*)          /* .data* sections */
+        *(.xheep_data_fast .xheep_data_fast.*) /* hot data */
         __SDATA_BEGIN__ = .;
         *(.sdata)           /* .sdata sections */
         *(.sdata*)          /* .sdata* sections */
+% if overlays > 0:
+        /* table of the code overlays, the start and the end of each one in
+        the flash, for overlay.h */
+        . = ALIGN(4);
+        PROVIDE(__overlay_table_start = .);
+% for n in range(overlays):
+        LONG(__load_start_xheep_overlay${n}) LONG(__load_stop_xheep_overlay${n})
+% endfor
+        PROVIDE(__overlay_table_end = .);
+% endif
         . = ALIGN(4);
         _edata = .;        /* define a global symbol at data end; used by startup code in order to initialise the .data section in RAM */
     } >RAM AT >FLASH
 
+    /* Large constant tables (FLASH_RODATA in spi_memio.h). They come after
+    _edata, so they are not copied to the RAM at boot and are read in place
+    through the SPI MEMIO */
+    .rodata_flash : ALIGN(4)
+    {
+        PROVIDE(__rodata_flash_start = .);
+        KEEP(*(.rodata_flash .rodata_flash.*))
+        . = ALIGN(4);
+        PROVIDE(__rodata_flash_end = .);
+    } >FLASH
+
+% if overlays > 0:
+    /* code overlays (XHEEP_SECTION_OVERLAY of bank_sections.h), left in the
+    flash after _edata and loaded on demand by overlay_load (overlay.h) in a
+    window of the RAM that they share, as large as the largest of them. The
+    NOLOAD section reserves their place in the flash for the sections that
+    follow. They must not call each other */
+    .xheep_overlay_load (NOLOAD) : ALIGN(4)
+    {
+        __overlay_load_start = .;
+        . += ${' + '.join('SIZEOF(.xheep_overlay{})'.format(n) for n in range(overlays))};
+    } >FLASH
+    OVERLAY : NOCROSSREFS AT(__overlay_load_start)
+    {
+% for n in range(overlays):
+        .xheep_overlay${n} { KEEP(*(.xheep_overlay${n} .xheep_overlay${n}.*)) . = ALIGN(4); }
+% endfor
+    } >RAM
+    PROVIDE(__overlay_start = ADDR(.xheep_overlay0));
+    PROVIDE(__overlay_end = .);
+% else:
+    PROVIDE(__overlay_start = 0);
+    PROVIDE(__overlay_end = 0);
+    PROVIDE(__overlay_table_start = 0);
+    PROVIDE(__overlay_table_end = 0);
+% endif
+
     .power_manager : ALIGN(4096)
     {
        PROVIDE(__power_manager_start = .);
@@ -112,8 +189,21 @@ SECTIONS {
         PROVIDE(__heap_start = .);
         . = __heap_size;
         PROVIDE(__heap_end = .);
+        /* kernel heap of FreeRTOS (rtosSECTION_HEAP of sw/freertos/port_sections.h) */
+        PROVIDE(__rtos_heap_start = .);
+        *(.xheep_rtos_heap .heap)
+        PROVIDE(__rtos_heap_end = .);
+    } >RAM
+
+    /* region of the arena and pool allocators (sw/device/lib/alloc) */
+    .arena         : ALIGN(8)
+    {
+        PROVIDE(__arena_start = .);
+        . = __arena_size;
+        PROVIDE(__arena_end = .);
     } >RAM
 
+% if not tcm_stack:
     /* stack: we should consider putting this further to the top of the address
     space */
     .stack         : ALIGN(16) /* this is a requirement of the ABI(?) */
@@ -124,4 +214,72 @@ SECTIONS {
        PROVIDE(__stack_end = .);
        PROVIDE(__freertos_irq_stack_top = .);
     } >RAM
+% endif
+
+% if cpu_num > 1:
+    /* stacks of the secondary harts, __stack_size each, always in the RAM as
+       the TCM is only reached by hart 0 */
+    .stack_harts (NOLOAD) : ALIGN(16)
+    {
+       PROVIDE(__stack_harts_start = .);
+       . = __stack_size * ${cpu_num - 1};
+       PROVIDE(__stack_harts_end = .);
+    } >RAM
+% endif
+
+    /* task stacks, queues and buffers pinned to a RAM bank (rtosSECTION_BANK
+    of sw/freertos/port_sections.h), after the stack. They are not loaded nor
+    zeroed */
+% for n in range(ram_numbanks_cont):
+    .xheep_bank${n} MAX(., 0x${'{:08X}'.format(ram_banks[n][0])}) (NOLOAD) :
+    {
+        PROVIDE(__xheep_bank${n}_start = .);
+        KEEP(*(.xheep_bank${n} .xheep_bank${n}.*))
+        PROVIDE(__xheep_bank${n}_end = .);
+    } >RAM
+    ASSERT(__xheep_bank${n}_start == __xheep_bank${n}_end || __xheep_bank${n}_end <= 0x${'{:08X}'.format(ram_banks[n][0] + ram_banks[n][1])}, "the objects of .xheep_bank${n} do not fit in bank ${n}")
+% endfor
+
+    /* private scratchpad of the core (XHEEP_SECTION_TCM of bank_sections.h),
+    which only the core reaches: the stack if it goes there, then the objects
+    of .tcm, neither loaded nor zeroed. Without scratchpad they stay in RAM */
+% if tcm_stack:
+    .stack (NOLOAD) : ALIGN(16)
+    {
+        PROVIDE(__stack_start = .);
+        . = __stack_size;
+        PROVIDE(_sp = .);
+        PROVIDE(__stack_end = .);
+        PROVIDE(__freertos_irq_stack_top = .);
+    } >TCM
+% endif
+    .tcm (NOLOAD) : ALIGN(4)
+    {
+        PROVIDE(__tcm_start = .);
+        KEEP(*(.tcm .tcm.*))
+        PROVIDE(__tcm_end = .);
+    } >${'TCM' if int(tcm_size_address, 16) > 0 else 'RAM'}
+
+    /* objects of the external slaves (XHEEP_SECTION_EXT of bank_sections.h),
+    neither loaded nor zeroed */
+% for name in ext_slaves:
+    .xheep_ext_${name} (NOLOAD) : ALIGN(4)
+    {
+        PROVIDE(__ext_${name}_start = .);
+        KEEP(*(.xheep_ext_${name} .xheep_ext_${name}.*))
+        PROVIDE(__ext_${name}_end = .);
+    } >EXT_${name.upper()}
+% endfor
+
+    /* RAM used by the program, which the banks of the power manager hold
+    (ram_banks.h): code and static data. The heap, the
+    arena and the stack have their own symbols */
+    PROVIDE(__ram_code_start = ORIGIN(RAM));
+    PROVIDE(__ram_code_end = _etext);
+    PROVIDE(__ram_data_start = _sdata);
+    PROVIDE(__ram_data_end = __bss_end);
+    PROVIDE(__ram_il_start = 0);
+    PROVIDE(__ram_il_end = 0);
+    PROVIDE(__fast_start = 0);
+    PROVIDE(__fast_end = 0);
 }
@@ -0,0 +1,53 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Verilator replacement of dmi_jtag (TB_DMI_DPI): OpenOCD connects with
+// remote_bitbang to a C++ model of the JTAG TAP and of the DTM (tb/tb_dmi.cpp),
+// which only drives the DMI of the debug module, on every rising edge of clk_i.
+module dmi_dpi #(
+    parameter logic [31:0] IdcodeValue = 32'h00000001,
+    parameter int unsigned Port = 4567
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    output dm::dmi_req_t  dmi_req_o,
+    output logic          dmi_req_valid_o,
+    input  logic          dmi_req_ready_i,
+    input  dm::dmi_resp_t dmi_resp_i,
+    output logic          dmi_resp_ready_o,
+    input  logic          dmi_resp_valid_i
+);
+
+  import "DPI-C" function void dmi_dpi_tick(
+    input int rst_n,
+    input int port,
+    input int idcode,
+    input int req_ready,
+    input int resp_valid,
+    input int resp_data,
+    output int req_valid,
+    output int req_addr,
+    output int req_op,
+    output int req_data
+  );
+
+  int req_valid = 0;
+  int req_addr = 0;
+  int req_op = 0;
+  int req_data = 0;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    dmi_dpi_tick(int'(rst_ni), int'(Port), int'(IdcodeValue), int'(dmi_req_ready_i),
+                 int'(dmi_resp_valid_i), int'(dmi_resp_i.data), req_valid, req_addr, req_op,
+                 req_data);
+  end
+
+  assign dmi_req_valid_o = req_valid[0];
+  assign dmi_req_o.addr = req_addr[6:0];
+  assign dmi_req_o.op = dm::dtm_op_e'(req_op[1:0]);
+  assign dmi_req_o.data = req_data;
+  assign dmi_resp_ready_o = 1'b1;
+
+endmodule
@@ -34,14 +34,14 @@ module ext_bus #(
     input  obi_pkg::obi_req_t  heep_debug_master_req_i,
     output obi_pkg::obi_resp_t heep_debug_master_resp_o,
 
-    input  obi_pkg::obi_req_t  heep_dma_read_ch0_req_i,
-    output obi_pkg::obi_resp_t heep_dma_read_ch0_resp_o,
+    input  obi_pkg::obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_read_req_i,
+    output obi_pkg::obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_read_resp_o,
 
-    input  obi_pkg::obi_req_t  heep_dma_write_ch0_req_i,
-    output obi_pkg::obi_resp_t heep_dma_write_ch0_resp_o,
+    input  obi_pkg::obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_write_req_i,
+    output obi_pkg::obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_write_resp_o,
 
-    input  obi_pkg::obi_req_t  heep_dma_addr_ch0_req_i,
-    output obi_pkg::obi_resp_t heep_dma_addr_ch0_resp_o,
+    input  obi_pkg::obi_req_t  [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_addr_req_i,
+    output obi_pkg::obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_addr_resp_o,
 
     // External master ports
     input  obi_pkg::obi_req_t  [EXT_XBAR_NMASTER_RND-1:0] ext_master_req_i,
@@ -80,10 +80,16 @@ module ext_bus #(
   assign master_req[CORE_INSTR_IDX] = heep_core_instr_req_i;
   assign master_req[CORE_DATA_IDX] = heep_core_data_req_i;
   assign master_req[DEBUG_MASTER_IDX] = heep_debug_master_req_i;
-  assign master_req[DMA_READ_CH0_IDX] = heep_dma_read_ch0_req_i;
-  assign master_req[DMA_WRITE_CH0_IDX] = heep_dma_write_ch0_req_i;
-  assign master_req[DMA_ADDR_CH0_IDX] = heep_dma_addr_ch0_req_i;
   generate
+    for (genvar i = 0; i < DMA_CH_NUM; i++) begin : gen_dma_master_req_map
+      assign master_req[DMA_READ_CH0_IDX+i*DMA_CH_MASTER_PORTS] = heep_dma_read_req_i[i];
+      assign master_req[DMA_WRITE_CH0_IDX+i*DMA_CH_MASTER_PORTS] = heep_dma_write_req_i[i];
+      assign master_req[DMA_ADDR_CH0_IDX+i*DMA_CH_MASTER_PORTS] = heep_dma_addr_req_i[i];
+    end
+    // The secondary cores of X-HEEP do not access the external slaves
+    for (genvar i = SYSTEM_XBAR_NMASTER_DEMUX; i < SYSTEM_XBAR_NMASTER; i++) begin : gen_hart_master_req_map
+      assign master_req[i] = '0;
+    end
     for (genvar i = 0; i < EXT_XBAR_NMASTER; i++) begin : gen_ext_master_req_map
       assign master_req[SYSTEM_XBAR_NMASTER+i] = demux_xbar_req[i][DEMUX_XBAR_EXT_SLAVE_IDX];
     end
@@ -93,9 +99,13 @@ module ext_bus #(
   assign heep_core_instr_resp_o = master_resp[CORE_INSTR_IDX];
   assign heep_core_data_resp_o = master_resp[CORE_DATA_IDX];
   assign heep_debug_master_resp_o = master_resp[DEBUG_MASTER_IDX];
-  assign heep_dma_read_ch0_resp_o = master_resp[DMA_READ_CH0_IDX];
-  assign heep_dma_write_ch0_resp_o = master_resp[DMA_WRITE_CH0_IDX];
-  assign heep_dma_addr_ch0_resp_o = master_resp[DMA_ADDR_CH0_IDX];
+  generate
+    for (genvar i = 0; i < DMA_CH_NUM; i++) begin : gen_dma_master_resp_map
+      assign heep_dma_read_resp_o[i] = master_resp[DMA_READ_CH0_IDX+i*DMA_CH_MASTER_PORTS];
+      assign heep_dma_write_resp_o[i] = master_resp[DMA_WRITE_CH0_IDX+i*DMA_CH_MASTER_PORTS];
+      assign heep_dma_addr_resp_o[i] = master_resp[DMA_ADDR_CH0_IDX+i*DMA_CH_MASTER_PORTS];
+    end
+  endgenerate
 
   // X-HEEP slave requests
   generate
@@ -134,8 +144,9 @@ module ext_bus #(
   generate
     for (genvar i = 0; unsigned'(i) < EXT_XBAR_NMASTER; i++) begin : gen_demux_xbar
       xbar_varlat_one_to_n #(
-          .XBAR_NSLAVE(32'd2),  // internal crossbar + external crossbar
-          .NUM_RULES  (32'd1)   // only the external address space is defined
+          .XBAR_NSLAVE    (32'd2),  // internal crossbar + external crossbar
+          .NUM_RULES      (32'd1),  // only the external address space is defined
+          .MAX_OUTSTANDING(core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
       ) demux_xbar_i (
           .clk_i        (clk_i),
           .rst_ni       (rst_ni),
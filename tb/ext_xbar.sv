@@ -123,7 +123,8 @@ module ext_xbar #(
     end else begin : gen_xbar_1toM
       // N-to-1 crossbar
       xbar_varlat_n_to_one #(
-          .XBAR_NMASTER(XBAR_NMASTER)
+          .XBAR_NMASTER   (XBAR_NMASTER),
+          .MAX_OUTSTANDING(core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
       ) i_xbar_master (
           .clk_i        (clk_i),
           .rst_ni       (rst_ni),
@@ -135,8 +136,9 @@ module ext_xbar #(
 
       // 1-to-N crossbar
       xbar_varlat_one_to_n #(
-          .XBAR_NSLAVE   (XBAR_NSLAVE),
-          .AGGREGATE_GNT (32'd0) // the neck request is aggregating all the input masters
+          .XBAR_NSLAVE    (XBAR_NSLAVE),
+          .AGGREGATE_GNT  (32'd0), // the neck request is aggregating all the input masters
+          .MAX_OUTSTANDING(core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
       ) i_xbar_slave (
           .clk_i        (clk_i),
           .rst_ni       (rst_ni),
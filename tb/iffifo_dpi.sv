@@ -0,0 +1,108 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Verilator replacement of the iffifo example (TB_IP_MODELS): the FIFO and the
+// register values are implemented in C++ (tb/tb_ip_models.cpp) and evaluated
+// on every rising edge of clk_i. The register interface is decoded with the
+// offsets of iffifo_reg_pkg and answers as the regtool generated one.
+module iffifo_dpi #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    // Minimum cycles between two words read by the DMA, to model the
+    // throughput of an accelerator behind the FIFO (1: a word per cycle)
+    parameter int unsigned OUT_INTERVAL = 1
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // DMA slots
+    output logic iffifo_in_ready_o,
+    output logic iffifo_out_valid_o,
+
+    // Interrupt lines
+    output logic iffifo_int_o
+);
+
+  import iffifo_reg_pkg::*;
+
+  import "DPI-C" function void iffifo_dpi_posedge(
+    input int rst_n,
+    input int out_interval,
+    input int re,
+    input int we,
+    input int reg_idx,
+    input int wdata,
+    output int fifo_out,
+    output int fifo_in,
+    output int status,
+    output int occupancy,
+    output int watermark,
+    output int interrupts,
+    output int in_ready,
+    output int out_valid,
+    output int intr
+  );
+
+  // Register index of the C++ model, in the order of iffifo_reg_pkg
+  int reg_idx;
+  logic reg_re, reg_we, wr_err;
+  logic [31:0] reg_rdata;
+
+  int fifo_out = 1;
+  int fifo_in = 0;
+  int status = 0;
+  int occupancy = 0;
+  int watermark = 0;
+  int interrupts = 0;
+  int in_ready = 1;
+  int out_valid = 0;
+  int intr = 0;
+
+  always_comb begin
+    unique case (reg_req_i.addr[BlockAw-1:0])
+      IFFIFO_FIFO_OUT_OFFSET:   reg_idx = 0;
+      IFFIFO_FIFO_IN_OFFSET:    reg_idx = 1;
+      IFFIFO_STATUS_OFFSET:     reg_idx = 2;
+      IFFIFO_OCCUPANCY_OFFSET:  reg_idx = 3;
+      IFFIFO_WATERMARK_OFFSET:  reg_idx = 4;
+      IFFIFO_INTERRUPTS_OFFSET: reg_idx = 5;
+      default:                  reg_idx = -1;
+    endcase
+  end
+
+  always_comb begin
+    unique case (reg_idx)
+      0: reg_rdata = fifo_out;
+      1: reg_rdata = fifo_in;
+      2: reg_rdata = status;
+      3: reg_rdata = occupancy;
+      4: reg_rdata = watermark;
+      5: reg_rdata = interrupts;
+      default: reg_rdata = '0;
+    endcase
+  end
+
+  // A write missing a byte of the register is an error and is ignored
+  assign wr_err = reg_req_i.valid & reg_req_i.write & (reg_idx >= 0) &
+                  (|(IFFIFO_PERMIT[reg_idx[2:0]] & ~reg_req_i.wstrb));
+  assign reg_re = reg_req_i.valid & ~reg_req_i.write & (reg_idx >= 0);
+  assign reg_we = reg_req_i.valid & reg_req_i.write & (reg_idx >= 0) & ~wr_err;
+
+  assign reg_rsp_o.ready = 1'b1;
+  assign reg_rsp_o.rdata = reg_rdata;
+  assign reg_rsp_o.error = wr_err;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    iffifo_dpi_posedge(int'(rst_ni), int'(OUT_INTERVAL), int'(reg_re), int'(reg_we), reg_idx,
+                       int'(reg_req_i.wdata), fifo_out, fifo_in, status, occupancy, watermark,
+                       interrupts, in_ready, out_valid, intr);
+  end
+
+  assign iffifo_in_ready_o = in_ready[0];
+  assign iffifo_out_valid_o = out_valid[0];
+  assign iffifo_int_o = intr[0];
+
+endmodule : iffifo_dpi
@@ -0,0 +1,41 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Verilator replacement of the pdm2pcm_dummy example (TB_IP_MODELS): the PDM
+// file is read once by the C++ model (tb/tb_ip_models.cpp), which is evaluated
+// on every rising edge of clk_i.
+module pdm2pcm_dummy_dpi #(
+    parameter string filepath = "../../../hw/ip/pdm2pcm/tb/signals/pdm.txt"
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // input ports
+    input logic pdm_clk_i,
+
+    // output ports
+    output logic pdm_data_o
+);
+
+  import "DPI-C" function void pdm2pcm_dummy_dpi_posedge(
+    input int rst_n,
+    input string filepath,
+    input int pdm_clk,
+    inout int pdm_data,
+    output int stop
+  );
+
+  int pdm_data = 0;
+  int stop = 0;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    pdm2pcm_dummy_dpi_posedge(int'(rst_ni), filepath, int'(pdm_clk_i), pdm_data, stop);
+    if (stop != 0) begin
+      $stop;
+    end
+  end
+
+  assign pdm_data_o = pdm_data[0];
+
+endmodule
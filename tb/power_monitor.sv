@@ -0,0 +1,199 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Power transition monitor of a domain: logs in LOG_FILE, in clock cycles, each
+// edge of the switch, isolation, reset and retention signals of the power
+// manager and the latency of each transition:
+// - entry: from the first signal of the off sequence (START_I for the CPU, the
+//   core going to sleep) to the acknowledge of the switch turning off,
+// - exit: from the switch turning on to the last of the isolation and the reset
+//   being released.
+// All the signals are active low: 1 means on, not isolated, out of reset and
+// not retentive. Tie the unused ones to 1.
+module power_domain_monitor #(
+    parameter string NAME = "domain",
+    // appended to NAME if positive, e.g. for the memory banks
+    parameter int INDEX = -1,
+    parameter string LOG_FILE = "power_monitor.log"
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input int unsigned cycle_i,
+
+    input logic start_i,
+    input logic switch_ni,
+    input logic switch_ack_ni,
+    input logic iso_ni,
+    input logic rst_domain_ni,
+    input logic retentive_ni
+);
+
+  int log_fd;
+  string name;
+
+  logic switch_q, switch_ack_q, iso_q, rst_q, retentive_q, start_q;
+  logic entering, exiting;
+  int unsigned entry_start, exit_start;
+
+  initial begin
+    name = INDEX < 0 ? NAME : $sformatf("%s%0d", NAME, INDEX);
+    log_fd = $fopen(LOG_FILE, "a");
+  end
+
+  final begin
+    if (log_fd != 0) $fclose(log_fd);
+  end
+
+  function automatic void log_edge(string signal, logic value);
+    $fdisplay(log_fd, "%0d %s %s %0d", cycle_i, name, signal, value);
+  endfunction
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      switch_q     <= 1'b1;
+      switch_ack_q <= 1'b1;
+      iso_q        <= 1'b1;
+      rst_q        <= 1'b1;
+      retentive_q  <= 1'b1;
+      start_q      <= 1'b0;
+      entering     <= 1'b0;
+      exiting      <= 1'b0;
+      entry_start  <= '0;
+      exit_start   <= '0;
+    end else begin
+      switch_q     <= switch_ni;
+      switch_ack_q <= switch_ack_ni;
+      iso_q        <= iso_ni;
+      rst_q        <= rst_domain_ni;
+      retentive_q  <= retentive_ni;
+      start_q      <= start_i;
+
+      if (start_i != start_q) log_edge("start", start_i);
+      if (switch_ni != switch_q) log_edge("switch", switch_ni);
+      if (switch_ack_ni != switch_ack_q) log_edge("switch_ack", switch_ack_ni);
+      if (iso_ni != iso_q) log_edge("iso", iso_ni);
+      if (rst_domain_ni != rst_q) log_edge("rst", rst_domain_ni);
+      if (retentive_ni != retentive_q) log_edge("retentive", retentive_ni);
+
+      // entry: from the first edge of the sequence to the switch acknowledge,
+      // cancelled if START_I falls before the switch turns off (a plain wfi)
+      if (!entering && switch_ack_ni &&
+          ((start_i && !start_q) || (!iso_ni && iso_q) || (!rst_domain_ni && rst_q) ||
+           (!switch_ni && switch_q))) begin
+        entering    <= 1'b1;
+        entry_start <= cycle_i;
+      end else if (entering && !start_i && start_q && switch_ni) begin
+        entering <= 1'b0;
+      end
+      if (entering && !switch_ack_ni && switch_ack_q) begin
+        entering <= 1'b0;
+        $fdisplay(log_fd, "%0d %s entry %0d cycles", cycle_i, name, cycle_i - entry_start);
+      end
+
+      // exit: from the switch turning on to the isolation and reset release
+      if (switch_ni && !switch_q) begin
+        exiting    <= 1'b1;
+        exit_start <= cycle_i;
+      end
+      if (exiting && iso_ni && rst_domain_ni && (!iso_q || !rst_q)) begin
+        exiting <= 1'b0;
+        $fdisplay(log_fd, "%0d %s exit %0d cycles", cycle_i, name, cycle_i - exit_start);
+      end
+    end
+  end
+
+endmodule
+
+
+// Power transition monitor of the CPU, the peripheral domain and the memory
+// banks of x_heep_system, see power_domain_monitor. power_monitor.log is
+// written from cycle 0 of the simulation.
+module power_monitor #(
+    parameter int unsigned NUM_BANKS = 1,
+    parameter string LOG_FILE = "power_monitor.log"
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input logic core_sleep_i,
+
+    input logic cpu_switch_ni,
+    input logic cpu_switch_ack_ni,
+    input logic cpu_iso_ni,
+    input logic cpu_rst_ni,
+
+    input logic periph_switch_ni,
+    input logic periph_switch_ack_ni,
+    input logic periph_iso_ni,
+    input logic periph_rst_ni,
+
+    input logic [NUM_BANKS-1:0] ram_switch_ni,
+    input logic [NUM_BANKS-1:0] ram_switch_ack_ni,
+    input logic [NUM_BANKS-1:0] ram_iso_ni,
+    input logic [NUM_BANKS-1:0] ram_retentive_ni
+);
+
+  int unsigned cycle;
+  int log_fd;
+
+  initial begin
+    log_fd = $fopen(LOG_FILE, "w");
+    $fdisplay(log_fd, "# cycle domain signal value | cycle domain entry|exit latency");
+    $fclose(log_fd);
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) cycle <= '0;
+    else cycle <= cycle + 1;
+  end
+
+  power_domain_monitor #(
+      .NAME("cpu"),
+      .LOG_FILE(LOG_FILE)
+  ) cpu_monitor_i (
+      .clk_i,
+      .rst_ni,
+      .cycle_i(cycle),
+      .start_i(core_sleep_i),
+      .switch_ni(cpu_switch_ni),
+      .switch_ack_ni(cpu_switch_ack_ni),
+      .iso_ni(cpu_iso_ni),
+      .rst_domain_ni(cpu_rst_ni),
+      .retentive_ni(1'b1)
+  );
+
+  power_domain_monitor #(
+      .NAME("periph"),
+      .LOG_FILE(LOG_FILE)
+  ) periph_monitor_i (
+      .clk_i,
+      .rst_ni,
+      .cycle_i(cycle),
+      .start_i(1'b0),
+      .switch_ni(periph_switch_ni),
+      .switch_ack_ni(periph_switch_ack_ni),
+      .iso_ni(periph_iso_ni),
+      .rst_domain_ni(periph_rst_ni),
+      .retentive_ni(1'b1)
+  );
+
+  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_ram_monitor
+    power_domain_monitor #(
+        .NAME("ram"),
+        .INDEX(i),
+        .LOG_FILE(LOG_FILE)
+    ) ram_monitor_i (
+        .clk_i,
+        .rst_ni,
+        .cycle_i(cycle),
+        .start_i(1'b0),
+        .switch_ni(ram_switch_ni[i]),
+        .switch_ack_ni(ram_switch_ack_ni[i]),
+        .iso_ni(ram_iso_ni[i]),
+        .rst_domain_ni(1'b1),
+        .retentive_ni(ram_retentive_ni[i])
+    );
+  end
+
+endmodule
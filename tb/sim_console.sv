@@ -0,0 +1,49 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Simulation console: the bytes written to its register are printed on the
+// standard output of the simulator and logged in sim_console.log, without
+// going through the UART. Each write prints the bytes selected by the byte
+// enables, lowest address first, so a word store prints 4 characters.
+module sim_console #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic,
+    parameter string LOG_FILE = "sim_console.log"
+) (
+    input logic clk_i,
+    input logic rst_ni,
+    input reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o
+);
+
+  int log_fd;
+
+  initial begin
+    log_fd = $fopen(LOG_FILE, "w");
+  end
+
+  final begin
+    if (log_fd != 0) $fclose(log_fd);
+  end
+
+  assign reg_rsp_o.ready = 1'b1;
+  assign reg_rsp_o.error = 1'b0;
+  assign reg_rsp_o.rdata = '0;
+
+  always_ff @(posedge clk_i) begin : proc_console
+    if (rst_ni && reg_req_i.valid && reg_req_i.write) begin
+      for (int i = 0; i < 4; i++) begin
+        if (reg_req_i.wstrb[i]) begin
+          $write("%c", reg_req_i.wdata[8*i+:8]);
+          if (log_fd != 0) $fwrite(log_fd, "%c", reg_req_i.wdata[8*i+:8]);
+          if (reg_req_i.wdata[8*i+:8] == 8'h0a) begin
+            $fflush();
+            if (log_fd != 0) $fflush(log_fd);
+          end
+        end
+      end
+    end
+  end
+
+endmodule : sim_console
@@ -0,0 +1,61 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Verilator replacement of the slow_memory example (TB_IP_MODELS): the memory
+// array, the random grant and the latency are implemented in C++
+// (tb/tb_ip_models.cpp) and evaluated on every rising edge of clk_i.
+module slow_memory_dpi #(
+    parameter int unsigned NumWords = 32'd1024,  // Number of Words in data array
+    parameter int unsigned DataWidth = 32'd32,  // Data signal width
+    // DEPENDENT PARAMETERS, DO NOT OVERWRITE!
+    parameter int unsigned AddrWidth = (NumWords > 32'd1) ? $clog2(NumWords) : 32'd1
+) (
+    input  logic                 clk_i,    // Clock
+    input  logic                 rst_ni,   // Asynchronous reset active low
+    // input ports
+    input  logic                 req_i,    // request
+    input  logic                 we_i,     // write enable
+    input  logic [AddrWidth-1:0] addr_i,   // request address
+    input  logic [         31:0] wdata_i,  // write data
+    input  logic [          3:0] be_i,     // write byte enable
+    // output ports
+    output logic                 gnt_o,    // memory is ready
+    output logic [         31:0] rdata_o,  // read data
+    output logic                 rvalid_o  // read data is valid
+);
+
+  import "DPI-C" function void slow_memory_dpi_init(input int num_words);
+
+  import "DPI-C" function void slow_memory_dpi_posedge(
+    input int rst_n,
+    input int gnt,
+    input int we,
+    input int addr,
+    input int wdata,
+    input int be,
+    output int ready,
+    output int offer,
+    output int rvalid,
+    output int rdata
+  );
+
+  int ready = 1;
+  int offer = 0;
+  int rvalid = 0;
+  int rdata = 0;
+
+  initial begin
+    slow_memory_dpi_init(int'(NumWords));
+  end
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    slow_memory_dpi_posedge(int'(rst_ni), int'(gnt_o), int'(we_i), int'(addr_i), int'(wdata_i),
+                            int'(be_i), ready, offer, rvalid, rdata);
+  end
+
+  assign gnt_o = req_i & ready[0] & offer[0];
+  assign rdata_o = rdata;
+  assign rvalid_o = rvalid[0];
+
+endmodule
@@ -0,0 +1,36 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Verilator replacement of the spiflash model: the flash is implemented in C++
+// (tb/tb_spi_flash.cpp) and evaluated on every edge of csb and clk.
+module spi_flash_dpi (
+    input logic csb,
+    input logic clk,
+    inout wire  io0,  // MOSI
+    inout wire  io1,  // MISO
+    inout wire  io2,
+    inout wire  io3
+);
+
+  import "DPI-C" function void spi_flash_dpi_edge(
+    input int csb,
+    input int clk,
+    input int sd_i,
+    output int sd_o,
+    output int sd_oe
+  );
+
+  int sd_o = 0;
+  int sd_oe = 0;
+
+  always @(posedge csb or negedge csb or posedge clk or negedge clk) begin
+    spi_flash_dpi_edge(int'(csb), int'(clk), int'({io3, io2, io1, io0}), sd_o, sd_oe);
+  end
+
+  assign io0 = sd_oe[0] ? sd_o[0] : 1'bz;
+  assign io1 = sd_oe[1] ? sd_o[1] : 1'bz;
+  assign io2 = sd_oe[2] ? sd_o[2] : 1'bz;
+  assign io3 = sd_oe[3] ? sd_o[3] : 1'bz;
+
+endmodule
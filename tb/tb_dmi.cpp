@@ -0,0 +1,332 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_dmi.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <iostream>
+
+// JTAG instructions of dmi_jtag_tap
+#define TB_DMI_IR_LENGTH  5
+#define TB_DMI_IR_CAPTURE 0x05
+#define TB_DMI_IR_IDCODE  0x01
+#define TB_DMI_IR_DTMCS   0x10
+#define TB_DMI_IR_DMI     0x11
+
+// DMI register: {address[6:0], data[31:0], op[1:0]}
+#define TB_DMI_ABITS      7
+#define TB_DMI_DR_LENGTH  (TB_DMI_ABITS + 32 + 2)
+
+#define TB_DMI_OP_NOP     0
+#define TB_DMI_OP_READ    1
+#define TB_DMI_OP_WRITE   2
+
+#define TB_DMI_NO_ERROR   0
+
+// DTMCS fields
+#define TB_DMI_DTMCS_VERSION      1
+#define TB_DMI_DTMCS_IDLE         1
+#define TB_DMI_DTMCS_DMIRESET     (1u << 16)
+#define TB_DMI_DTMCS_DMIHARDRESET (1u << 17)
+
+// Cycles between two polls of an idle socket, a system call per cycle would
+// slow down the simulation while OpenOCD is not talking
+#define TB_DMI_POLL_CYCLES 64
+
+TbDmi& tbDmi()
+{
+  static TbDmi dmi;
+  return dmi;
+}
+
+TbDmi::TbDmi()
+  : idcode_(0), server_fd_(-1), client_fd_(-1), backoff_(0), in_pos_(0), tck_(false),
+    ir_(TB_DMI_IR_IDCODE), ir_shift_(0), dr_shift_(0), error_(TB_DMI_NO_ERROR), address_(0), data_(0),
+    dmi_state_(DMI_IDLE)
+{
+  req_.valid = false;
+  req_.addr  = 0;
+  req_.op    = TB_DMI_OP_NOP;
+  req_.data  = 0;
+  tapReset();
+}
+
+TbDmi::~TbDmi()
+{
+  disconnect();
+  if(server_fd_ >= 0) close(server_fd_);
+}
+
+bool TbDmi::open(int port)
+{
+  struct sockaddr_in addr;
+  int reuseaddr = 1;
+
+  server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if(server_fd_ < 0) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot create the DMI server socket: "<<strerror(errno)<<std::endl;
+    return false;
+  }
+  fcntl(server_fd_, F_SETFL, O_NONBLOCK);
+  setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &reuseaddr, sizeof(reuseaddr));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port        = htons(port);
+  if(bind(server_fd_, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(server_fd_, 1) < 0) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot listen on port "<<port<<" for OpenOCD: "<<strerror(errno)<<std::endl;
+    close(server_fd_);
+    server_fd_ = -1;
+    return false;
+  }
+  std::cout<<"[TESTBENCH]: DMI remote bitbang server listening on port "<<port<<std::endl;
+  return true;
+}
+
+void TbDmi::accept()
+{
+  client_fd_ = ::accept(server_fd_, NULL, NULL);
+  if(client_fd_ < 0) return;
+  fcntl(client_fd_, F_SETFL, O_NONBLOCK);
+  in_.clear();
+  in_pos_ = 0;
+  std::cout<<"[TESTBENCH]: OpenOCD connected to the DMI server"<<std::endl;
+}
+
+void TbDmi::disconnect()
+{
+  if(client_fd_ < 0) return;
+  flush();
+  close(client_fd_);
+  client_fd_ = -1;
+  in_.clear();
+  in_pos_ = 0;
+}
+
+// Returns false when there is nothing to execute
+bool TbDmi::receive()
+{
+  char buf[4096];
+  ssize_t n;
+
+  if(in_pos_ < in_.size()) return true;
+  in_.clear();
+  in_pos_ = 0;
+
+  n = read(client_fd_, buf, sizeof(buf));
+  if(n > 0) {
+    in_.assign(buf, n);
+    return true;
+  }
+  if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+    std::cout<<"[TESTBENCH]: OpenOCD disconnected from the DMI server"<<std::endl;
+    disconnect();
+  }
+  return false;
+}
+
+void TbDmi::flush()
+{
+  size_t pos = 0;
+  while(pos < out_.size()) {
+    ssize_t n = write(client_fd_, out_.data() + pos, out_.size() - pos);
+    if(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) break;
+    if(n > 0) pos += n;
+  }
+  out_.clear();
+}
+
+// remote_bitbang commands of OpenOCD
+void TbDmi::command(char c)
+{
+  switch(c) {
+    case '0': case '1': case '2': case '3':
+    case '4': case '5': case '6': case '7': {
+      bool tck = (c - '0') & 4;
+      if(tck && !tck_) tckRise((c - '0') & 2, (c - '0') & 1);
+      tck_ = tck;
+      break;
+    }
+    case 'R':
+      out_ += tdo() ? '1' : '0';
+      break;
+    // Resets: TRST is the only one connected, as with SimJTAG
+    case 't': case 'u':
+      tapReset();
+      break;
+    case 'Q':
+      disconnect();
+      break;
+    default:
+      // Blink (B, b), sleeps (Z, z) and the resets without TRST (r, s)
+      break;
+  }
+}
+
+void TbDmi::tapReset()
+{
+  state_ = TEST_LOGIC_RESET;
+  ir_    = TB_DMI_IR_IDCODE;
+  // Test-Logic-Reset clears the DMI registers, as jtag_dmi_clear in dmi_jtag
+  error_   = TB_DMI_NO_ERROR;
+  address_ = 0;
+  data_    = 0;
+}
+
+unsigned int TbDmi::drLength() const
+{
+  switch(ir_) {
+    case TB_DMI_IR_IDCODE:
+    case TB_DMI_IR_DTMCS: return 32;
+    case TB_DMI_IR_DMI:   return TB_DMI_DR_LENGTH;
+    default:              return 1;  // BYPASS
+  }
+}
+
+void TbDmi::captureDr()
+{
+  switch(ir_) {
+    case TB_DMI_IR_IDCODE:
+      dr_shift_ = idcode_;
+      break;
+    case TB_DMI_IR_DTMCS:
+      dr_shift_ = (TB_DMI_DTMCS_IDLE << 12) | ((uint32_t)error_ << 10) | (TB_DMI_ABITS << 4) | TB_DMI_DTMCS_VERSION;
+      break;
+    case TB_DMI_IR_DMI:
+      dr_shift_ = ((uint64_t)address_ << 34) | ((uint64_t)data_ << 2) | error_;
+      break;
+    default:
+      dr_shift_ = 0;
+      break;
+  }
+}
+
+void TbDmi::updateDr()
+{
+  if(ir_ == TB_DMI_IR_DTMCS) {
+    if(dr_shift_ & TB_DMI_DTMCS_DMIHARDRESET) {
+      address_   = 0;
+      data_      = 0;
+      dmi_state_ = DMI_IDLE;
+      req_.valid = false;
+    }
+    if(dr_shift_ & (TB_DMI_DTMCS_DMIRESET | TB_DMI_DTMCS_DMIHARDRESET)) error_ = TB_DMI_NO_ERROR;
+    return;
+  }
+
+  if(ir_ != TB_DMI_IR_DMI || error_ != TB_DMI_NO_ERROR) return;
+  address_ = (dr_shift_ >> 34) & ((1 << TB_DMI_ABITS) - 1);
+  data_    = (dr_shift_ >> 2) & 0xffffffff;
+  if((dr_shift_ & 3) == TB_DMI_OP_READ || (dr_shift_ & 3) == TB_DMI_OP_WRITE) {
+    req_.valid = true;
+    req_.addr  = address_;
+    req_.op    = dr_shift_ & 3;
+    req_.data  = data_;
+    dmi_state_ = DMI_REQ;
+  }
+}
+
+void TbDmi::tckRise(bool tms, bool tdi)
+{
+  // Actions of the current state, then the transition
+  switch(state_) {
+    case CAPTURE_DR: captureDr(); break;
+    case SHIFT_DR:
+      dr_shift_ = (dr_shift_ >> 1) | ((uint64_t)tdi << (drLength() - 1));
+      break;
+    case UPDATE_DR: updateDr(); break;
+    case CAPTURE_IR: ir_shift_ = TB_DMI_IR_CAPTURE; break;
+    case SHIFT_IR:
+      ir_shift_ = (ir_shift_ >> 1) | (tdi << (TB_DMI_IR_LENGTH - 1));
+      break;
+    case UPDATE_IR: ir_ = ir_shift_; break;
+    default: break;
+  }
+
+  switch(state_) {
+    case TEST_LOGIC_RESET: state_ = tms ? TEST_LOGIC_RESET : RUN_TEST_IDLE; break;
+    case RUN_TEST_IDLE:    state_ = tms ? SELECT_DR : RUN_TEST_IDLE; break;
+    case SELECT_DR:        state_ = tms ? SELECT_IR : CAPTURE_DR; break;
+    case CAPTURE_DR:       state_ = tms ? EXIT1_DR : SHIFT_DR; break;
+    case SHIFT_DR:         state_ = tms ? EXIT1_DR : SHIFT_DR; break;
+    case EXIT1_DR:         state_ = tms ? UPDATE_DR : PAUSE_DR; break;
+    case PAUSE_DR:         state_ = tms ? EXIT2_DR : PAUSE_DR; break;
+    case EXIT2_DR:         state_ = tms ? UPDATE_DR : SHIFT_DR; break;
+    case UPDATE_DR:        state_ = tms ? SELECT_DR : RUN_TEST_IDLE; break;
+    case SELECT_IR:        state_ = tms ? TEST_LOGIC_RESET : CAPTURE_IR; break;
+    case CAPTURE_IR:       state_ = tms ? EXIT1_IR : SHIFT_IR; break;
+    case SHIFT_IR:         state_ = tms ? EXIT1_IR : SHIFT_IR; break;
+    case EXIT1_IR:         state_ = tms ? UPDATE_IR : PAUSE_IR; break;
+    case PAUSE_IR:         state_ = tms ? EXIT2_IR : PAUSE_IR; break;
+    case EXIT2_IR:         state_ = tms ? UPDATE_IR : SHIFT_IR; break;
+    case UPDATE_IR:        state_ = tms ? SELECT_DR : RUN_TEST_IDLE; break;
+  }
+
+  if(state_ == TEST_LOGIC_RESET) tapReset();
+}
+
+bool TbDmi::tdo() const
+{
+  if(state_ == SHIFT_IR) return ir_shift_ & 1;
+  return dr_shift_ & 1;
+}
+
+void TbDmi::tick(int port, uint32_t idcode, bool req_ready, bool resp_valid, uint32_t resp_data, tb_dmi_req_t& req)
+{
+  idcode_ = idcode;
+
+  // DMI access in flight, the commands wait for its end
+  if(dmi_state_ == DMI_REQ) {
+    if(req_ready) {
+      req_.valid = false;
+      dmi_state_ = DMI_WAIT_RESP;
+    }
+  } else if(dmi_state_ == DMI_WAIT_RESP) {
+    if(resp_valid) {
+      if(req_.op == TB_DMI_OP_READ) data_ = resp_data;
+      dmi_state_ = DMI_IDLE;
+    }
+  }
+
+  if(dmi_state_ == DMI_IDLE) {
+    if(backoff_ != 0) {
+      backoff_--;
+    } else if(server_fd_ < 0 && !open(port)) {
+      backoff_ = ~0u;  // do not retry
+    } else if(client_fd_ < 0) {
+      accept();
+      if(client_fd_ < 0) backoff_ = TB_DMI_POLL_CYCLES;
+    } else if(!receive()) {
+      backoff_ = TB_DMI_POLL_CYCLES;
+    } else {
+      while(client_fd_ >= 0 && in_pos_ < in_.size() && dmi_state_ == DMI_IDLE)
+        command(in_[in_pos_++]);
+      if(client_fd_ >= 0) flush();
+    }
+  }
+
+  req = req_;
+}
+
+// DPI import of tb/dmi_dpi.sv
+extern "C" void dmi_dpi_tick(int rst_n, int port, int idcode, int req_ready, int resp_valid, int resp_data,
+                             int *req_valid, int *req_addr, int *req_op, int *req_data)
+{
+  tb_dmi_req_t req;
+  if(!rst_n) {
+    *req_valid = 0;
+    return;
+  }
+  tbDmi().tick(port, idcode, req_ready != 0, resp_valid != 0, resp_data, req);
+  *req_valid = req.valid;
+  *req_addr  = req.addr;
+  *req_op    = req.op;
+  *req_data  = req.data;
+}
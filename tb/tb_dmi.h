@@ -0,0 +1,85 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Debug transport of the Verilator model built with VERILATOR_DMI=1: a
+// remote_bitbang server for OpenOCD whose JTAG TAP and DTM registers are
+// implemented in C++ with the behaviour of dmi_jtag (riscv-dbg). The bit
+// shifting costs no simulated cycle, only the DMI accesses reach the RTL,
+// through tb/dmi_dpi.sv which replaces dmi_jtag in the debug_subsystem.
+//
+// The commands are executed as soon as they are received and the server stops
+// reading them while a DMI access is in flight, so OpenOCD never sees a busy
+// DMI and the same configuration (tb/core-v-mini-mcu.cfg) is used.
+
+#ifndef TB_DMI_H_
+#define TB_DMI_H_
+
+#include <stdint.h>
+#include <string>
+
+typedef struct tb_dmi_req {
+  bool valid;
+  uint8_t addr;
+  uint8_t op;
+  uint32_t data;
+} tb_dmi_req_t;
+
+class TbDmi {
+ public:
+  TbDmi();
+  ~TbDmi();
+
+  // Rising edge of the system clock with the DMI handshake of the ending
+  // cycle, req returns the request driven in the next cycle
+  void tick(int port, uint32_t idcode, bool req_ready, bool resp_valid, uint32_t resp_data, tb_dmi_req_t& req);
+
+ private:
+  enum tap_state_t {
+    TEST_LOGIC_RESET, RUN_TEST_IDLE,
+    SELECT_DR, CAPTURE_DR, SHIFT_DR, EXIT1_DR, PAUSE_DR, EXIT2_DR, UPDATE_DR,
+    SELECT_IR, CAPTURE_IR, SHIFT_IR, EXIT1_IR, PAUSE_IR, EXIT2_IR, UPDATE_IR
+  };
+  enum dmi_state_t { DMI_IDLE, DMI_REQ, DMI_WAIT_RESP };
+
+  bool open(int port);
+  void accept();
+  void disconnect();
+  bool receive();
+  void flush();
+  void command(char c);
+
+  void tapReset();
+  void tckRise(bool tms, bool tdi);
+  bool tdo() const;
+  unsigned int drLength() const;
+  void captureDr();
+  void updateDr();
+
+  uint32_t idcode_;
+  int server_fd_;
+  int client_fd_;
+  // Cycles to wait before polling the socket again when it had nothing
+  unsigned int backoff_;
+  std::string in_;
+  size_t in_pos_;
+  std::string out_;
+
+  // TAP
+  tap_state_t state_;
+  bool tck_;
+  uint8_t ir_;
+  uint8_t ir_shift_;
+  uint64_t dr_shift_;
+
+  // DTM
+  uint8_t error_;
+  uint8_t address_;
+  uint32_t data_;
+  dmi_state_t dmi_state_;
+  tb_dmi_req_t req_;
+};
+
+TbDmi& tbDmi();
+
+#endif  // TB_DMI_H_
@@ -0,0 +1,139 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_elf.h"
+
+#include <elf.h>
+#include <string.h>
+#include <fstream>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+bool TbElf::isElf(const std::string& file)
+{
+  std::ifstream in(file.c_str(), std::ios::binary);
+  char magic[SELFMAG];
+  if(!in.read(magic, SELFMAG))
+    return false;
+  return memcmp(magic, ELFMAG, SELFMAG) == 0;
+}
+
+bool TbElf::open(const std::string& file)
+{
+  std::ifstream in(file.c_str(), std::ios::binary);
+  std::vector<uint8_t> img((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  segments_.clear();
+  symbols_.clear();
+
+  if(img.size() < sizeof(Elf32_Ehdr) || memcmp(&img[0], ELFMAG, SELFMAG) != 0) {
+    std::cout<<"[TESTBENCH]: ERROR: "<<file<<" is not an ELF file"<<std::endl;
+    return false;
+  }
+
+  const Elf32_Ehdr *ehdr = (const Elf32_Ehdr *)&img[0];
+  if(ehdr->e_ident[EI_CLASS] != ELFCLASS32 || ehdr->e_ident[EI_DATA] != ELFDATA2LSB) {
+    std::cout<<"[TESTBENCH]: ERROR: "<<file<<" is not a 32-bit little-endian ELF"<<std::endl;
+    return false;
+  }
+  entry_ = ehdr->e_entry;
+
+  if(ehdr->e_phoff + (size_t)ehdr->e_phnum * sizeof(Elf32_Phdr) > img.size()) {
+    std::cout<<"[TESTBENCH]: ERROR: "<<file<<" has truncated program headers"<<std::endl;
+    return false;
+  }
+
+  // Loadable segments carry the populated sections at their load address
+  const Elf32_Phdr *phdr = (const Elf32_Phdr *)&img[ehdr->e_phoff];
+  for(int i = 0; i < ehdr->e_phnum; i++) {
+    if(phdr[i].p_type != PT_LOAD || phdr[i].p_filesz == 0)
+      continue;
+    if(phdr[i].p_offset + (size_t)phdr[i].p_filesz > img.size()) {
+      std::cout<<"[TESTBENCH]: ERROR: "<<file<<" has a truncated segment"<<std::endl;
+      return false;
+    }
+    tb_elf_segment_t seg;
+    seg.addr  = phdr[i].p_paddr;
+    seg.vaddr = phdr[i].p_vaddr;
+    seg.data.assign(img.begin() + phdr[i].p_offset, img.begin() + phdr[i].p_offset + phdr[i].p_filesz);
+    segments_.push_back(seg);
+  }
+
+  parseSymbols(img);
+
+  return true;
+}
+
+static bool symbolLess(const tb_elf_symbol_t& a, const tb_elf_symbol_t& b)
+{
+  return a.addr < b.addr;
+}
+
+void TbElf::parseSymbols(const std::vector<uint8_t>& img)
+{
+  const Elf32_Ehdr *ehdr = (const Elf32_Ehdr *)&img[0];
+  if(ehdr->e_shoff == 0 || ehdr->e_shoff + (size_t)ehdr->e_shnum * sizeof(Elf32_Shdr) > img.size())
+    return;
+
+  const Elf32_Shdr *shdr = (const Elf32_Shdr *)&img[ehdr->e_shoff];
+  for(int i = 0; i < ehdr->e_shnum; i++) {
+    if(shdr[i].sh_type != SHT_SYMTAB || shdr[i].sh_link >= ehdr->e_shnum)
+      continue;
+    const Elf32_Shdr& strtab = shdr[shdr[i].sh_link];
+    if(shdr[i].sh_offset + (size_t)shdr[i].sh_size > img.size() || strtab.sh_offset + (size_t)strtab.sh_size > img.size())
+      continue;
+
+    const Elf32_Sym *sym = (const Elf32_Sym *)&img[shdr[i].sh_offset];
+    for(size_t j = 0; j < shdr[i].sh_size / sizeof(Elf32_Sym); j++) {
+      // Functions, plus the untyped labels of the assembly startup code
+      int type = ELF32_ST_TYPE(sym[j].st_info);
+      if(sym[j].st_name == 0 || sym[j].st_name >= strtab.sh_size || sym[j].st_shndx == SHN_UNDEF || sym[j].st_shndx >= ehdr->e_shnum)
+        continue;
+      if(type != STT_FUNC && !(type == STT_NOTYPE && (shdr[sym[j].st_shndx].sh_flags & SHF_EXECINSTR)))
+        continue;
+      tb_elf_symbol_t s;
+      s.addr = sym[j].st_value;
+      s.size = sym[j].st_size;
+      s.name = (const char *)&img[strtab.sh_offset + sym[j].st_name];
+      // Skip the local labels of the assembler and the RISC-V mapping symbols
+      if(s.name[0] == '.' || s.name[0] == '$')
+        continue;
+      symbols_.push_back(s);
+    }
+  }
+
+  std::stable_sort(symbols_.begin(), symbols_.end(), symbolLess);
+}
+
+const tb_elf_symbol_t *TbElf::symbolize(uint32_t addr) const
+{
+  tb_elf_symbol_t key;
+  key.addr = addr;
+  std::vector<tb_elf_symbol_t>::const_iterator it = std::upper_bound(symbols_.begin(), symbols_.end(), key, symbolLess);
+  if(it == symbols_.begin())
+    return NULL;
+  --it;
+  // Prefer a sized symbol at the same address (e.g. a function over a label)
+  std::vector<tb_elf_symbol_t>::const_iterator sized = it;
+  while(sized->size == 0 && sized != symbols_.begin() && (sized - 1)->addr == it->addr)
+    --sized;
+  if(sized->size != 0)
+    it = sized;
+  if(it->size != 0 && addr >= it->addr + it->size)
+    return NULL;
+  return &*it;
+}
+
+bool TbElf::readHalf(uint32_t addr, uint16_t& half) const
+{
+  for(size_t i = 0; i < segments_.size(); i++) {
+    const tb_elf_segment_t& seg = segments_[i];
+    if(addr >= seg.vaddr && addr + 2 <= seg.vaddr + seg.data.size()) {
+      half = seg.data[addr - seg.vaddr] | (seg.data[addr - seg.vaddr + 1] << 8);
+      return true;
+    }
+  }
+  return false;
+}
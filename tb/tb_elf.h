@@ -0,0 +1,55 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Minimal reader for the 32-bit little-endian RISC-V ELF files produced by
+// the sw/ build flow. Only what the Verilator testbench needs is parsed.
+
+#ifndef TB_ELF_H_
+#define TB_ELF_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+typedef struct tb_elf_segment {
+  uint32_t             addr;   // physical (load) address
+  uint32_t             vaddr;  // virtual (execution) address
+  std::vector<uint8_t> data;   // file content only, .bss is not included
+} tb_elf_segment_t;
+
+typedef struct tb_elf_symbol {
+  uint32_t    addr;
+  uint32_t    size;
+  std::string name;
+} tb_elf_symbol_t;
+
+class TbElf {
+ public:
+  // Returns true if file starts with the ELF magic number
+  static bool isElf(const std::string& file);
+
+  // Parses file, returns false (and prints the reason) on error
+  bool open(const std::string& file);
+
+  const std::vector<tb_elf_segment_t>& segments() const { return segments_; }
+  uint32_t entry() const { return entry_; }
+
+  // Function symbols sorted by address
+  const std::vector<tb_elf_symbol_t>& symbols() const { return symbols_; }
+
+  // Returns the function symbol containing addr, NULL if there is none
+  const tb_elf_symbol_t *symbolize(uint32_t addr) const;
+
+  // Reads the 16-bit parcel at the execution address addr, false if not in a segment
+  bool readHalf(uint32_t addr, uint16_t& half) const;
+
+ private:
+  void parseSymbols(const std::vector<uint8_t>& img);
+
+  std::vector<tb_elf_segment_t> segments_;
+  std::vector<tb_elf_symbol_t> symbols_;
+  uint32_t entry_;
+};
+
+#endif  // TB_ELF_H_
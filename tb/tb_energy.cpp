@@ -0,0 +1,134 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_energy.h"
+
+#include <ctype.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Names of the states in the events of the table, the CPU sleeps in WFI
+// instead of being clock-gated and has no retentive state, nor the periph
+static const char *cpu_states[TB_ENERGY_NSTATES]    = {"active", "sleep", "off", NULL};
+static const char *periph_states[TB_ENERGY_NSTATES] = {"active", "clkgate", "off", NULL};
+static const char *ram_states[TB_ENERGY_NSTATES]    = {"active", "clkgate", "off", "retentive"};
+
+static bool isState(const char *const states[], const std::string& name)
+{
+  for(int s = 0; s < TB_ENERGY_NSTATES; s++)
+    if(states[s] != NULL && name == states[s]) return true;
+  return false;
+}
+
+// cpu_*, periph_*, ram_*, ram<i>_* and dma_beat
+static bool validEvent(const std::string& event)
+{
+  size_t sep = event.find('_');
+  if(sep == std::string::npos) return false;
+  std::string domain = event.substr(0, sep);
+  std::string name   = event.substr(sep + 1);
+
+  if(domain == "cpu") return isState(cpu_states, name);
+  if(domain == "periph") return isState(periph_states, name);
+  if(domain == "dma") return name == "beat";
+  if(domain.compare(0, 3, "ram") != 0) return false;
+  for(size_t i = 3; i < domain.size(); i++)
+    if(!isdigit((unsigned char)domain[i])) return false;
+  return isState(ram_states, name) || name == "access";
+}
+
+bool TbEnergy::open(const std::string& table_file)
+{
+  std::ifstream in(table_file.c_str());
+  if(!in) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot read the energy table "<<table_file<<std::endl;
+    return false;
+  }
+
+  std::string line;
+  unsigned int line_num = 0;
+  while(std::getline(in, line)) {
+    line_num++;
+    size_t comment = line.find('#');
+    if(comment != std::string::npos) line.erase(comment);
+    std::istringstream fields(line);
+    std::string event;
+    double value;
+    if(!(fields>>event)) continue;
+    if(!(fields>>value) || !validEvent(event)) {
+      std::cout<<"[TESTBENCH]: ERROR: "<<table_file<<":"<<line_num<<": expected '<event> <energy>', got '"<<line<<"'"<<std::endl;
+      return false;
+    }
+    table_[event] = value;
+  }
+  return true;
+}
+
+double TbEnergy::energy(const std::string& domain, const std::string& event) const
+{
+  std::map<std::string, double>::const_iterator it = table_.find(domain + "_" + event);
+  return it == table_.end() ? 0.0 : it->second;
+}
+
+double TbEnergy::ramEnergy(unsigned int bank, const std::string& event) const
+{
+  std::map<std::string, double>::const_iterator it = table_.find("ram" + std::to_string(bank) + "_" + event);
+  return it == table_.end() ? energy("ram", event) : it->second;
+}
+
+void TbEnergy::report(const tb_energy_activity_t& activity, const std::string& report_file) const
+{
+  double cpu = 0, periph = 0, dma = 0, total;
+  std::vector<double> ram(activity.ram_accesses.size(), 0.0);
+
+  for(int s = 0; s < TB_ENERGY_NSTATES; s++) {
+    if(cpu_states[s] != NULL) cpu += activity.cpu_cycles[s] * energy("cpu", cpu_states[s]);
+    if(periph_states[s] != NULL) periph += activity.periph_cycles[s] * energy("periph", periph_states[s]);
+  }
+  for(unsigned int b = 0; b < ram.size(); b++) {
+    for(int s = 0; s < TB_ENERGY_NSTATES; s++)
+      ram[b] += activity.ram_cycles[b][s] * ramEnergy(b, ram_states[s]);
+    ram[b] += activity.ram_accesses[b] * ramEnergy(b, "access");
+  }
+  dma   = activity.dma_beats * energy("dma", "beat");
+  total = cpu + periph + dma;
+  for(unsigned int b = 0; b < ram.size(); b++) total += ram[b];
+
+  std::cout<<"[TESTBENCH]: Energy report"<<std::endl;
+  std::cout<<"[TESTBENCH]:   cpu     "<<cpu<<" (cycles active "<<activity.cpu_cycles[0]<<", sleep "
+           <<activity.cpu_cycles[1]<<", off "<<activity.cpu_cycles[2]<<")"<<std::endl;
+  std::cout<<"[TESTBENCH]:   periph  "<<periph<<" (cycles active "<<activity.periph_cycles[0]<<", clkgate "
+           <<activity.periph_cycles[1]<<", off "<<activity.periph_cycles[2]<<")"<<std::endl;
+  for(unsigned int b = 0; b < ram.size(); b++) {
+    std::cout<<"[TESTBENCH]:   ram"<<b<<"    "<<ram[b]<<" (accesses "<<activity.ram_accesses[b]<<", cycles active "
+             <<activity.ram_cycles[b][0]<<", clkgate "<<activity.ram_cycles[b][1]<<", off "<<activity.ram_cycles[b][2]
+             <<", retentive "<<activity.ram_cycles[b][3]<<")"<<std::endl;
+  }
+  std::cout<<"[TESTBENCH]:   dma     "<<dma<<" (beats "<<activity.dma_beats<<")"<<std::endl;
+  std::cout<<"[TESTBENCH]:   total   "<<total<<std::endl;
+
+  if(report_file.empty())
+    return;
+  std::ofstream out(report_file.c_str());
+  if(!out) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot write energy report "<<report_file<<std::endl;
+    return;
+  }
+  out<<"{\n  \"total\": "<<total<<",\n  \"cpu\": {\"energy\": "<<cpu;
+  for(int s = 0; s < TB_ENERGY_NSTATES; s++)
+    if(cpu_states[s] != NULL) out<<", \""<<cpu_states[s]<<"_cycles\": "<<activity.cpu_cycles[s];
+  out<<"},\n  \"periph\": {\"energy\": "<<periph;
+  for(int s = 0; s < TB_ENERGY_NSTATES; s++)
+    if(periph_states[s] != NULL) out<<", \""<<periph_states[s]<<"_cycles\": "<<activity.periph_cycles[s];
+  out<<"},\n  \"ram\": [";
+  for(unsigned int b = 0; b < ram.size(); b++) {
+    out<<(b ? ",\n    " : "\n    ")<<"{\"energy\": "<<ram[b]<<", \"accesses\": "<<activity.ram_accesses[b];
+    for(int s = 0; s < TB_ENERGY_NSTATES; s++)
+      out<<", \""<<ram_states[s]<<"_cycles\": "<<activity.ram_cycles[b][s];
+    out<<"}";
+  }
+  out<<"\n  ],\n  \"dma\": {\"energy\": "<<dma<<", \"beats\": "<<activity.dma_beats<<"}\n}\n";
+  std::cout<<"[TESTBENCH]: Energy report written to "<<report_file<<std::endl;
+}
@@ -0,0 +1,55 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Activity-based energy estimation of the Verilator testbench. tb/tb_util.svh
+// tallies the cycles each power domain spends in each state, the accesses to
+// the RAM banks and the DMA beats; the report weights them with the energy of
+// each event given by the user in a table, one event per line:
+//   <event> <energy>
+// ('#' starts a comment). The events are
+//   cpu_active, cpu_sleep, cpu_off                     per cycle
+//   periph_active, periph_clkgate, periph_off          per cycle
+//   ram_active, ram_clkgate, ram_off, ram_retentive    per cycle and bank
+//   ram_access                                         per access
+//   dma_beat                                           per word written by the DMA
+// ram<i>_<event> overrides ram_<event> for the bank i, e.g. for banks of
+// different sizes. Missing events count for 0 and the report is in the unit of
+// the table, e.g. pJ.
+
+#ifndef TB_ENERGY_H_
+#define TB_ENERGY_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// States of a domain, as indexed by tb/tb_util.svh
+#define TB_ENERGY_NSTATES 4
+
+typedef struct tb_energy_activity {
+  uint64_t cpu_cycles[TB_ENERGY_NSTATES];
+  uint64_t periph_cycles[TB_ENERGY_NSTATES];
+  std::vector<std::vector<uint64_t> > ram_cycles; // [bank][state]
+  std::vector<uint64_t> ram_accesses;
+  uint64_t dma_beats;
+} tb_energy_activity_t;
+
+class TbEnergy {
+ public:
+  // Reads the energy table, returns false on error or on an unknown event
+  bool open(const std::string& table_file);
+
+  // Prints the energy of each domain and writes it as JSON to report_file if
+  // not empty
+  void report(const tb_energy_activity_t& activity, const std::string& report_file) const;
+
+ private:
+  double energy(const std::string& domain, const std::string& event) const;
+  double ramEnergy(unsigned int bank, const std::string& event) const;
+
+  std::map<std::string, double> table_;
+};
+
+#endif  // TB_ENERGY_H_
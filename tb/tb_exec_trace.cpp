@@ -0,0 +1,148 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_exec_trace.h"
+
+#include <iostream>
+
+// The records are buffered and written in blocks
+#define TB_EXEC_TRACE_BUFFER_SIZE (1 << 20)
+
+TbExecTrace& tbExecTrace()
+{
+  static TbExecTrace trace;
+  return trace;
+}
+
+bool TbExecTrace::open(const std::string& file, unsigned int nmaster)
+{
+  close();
+  out_ = fopen(file.c_str(), "wb");
+  if(out_ == NULL) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot write the execution trace "<<file<<std::endl;
+    return false;
+  }
+  buf_.reserve(TB_EXEC_TRACE_BUFFER_SIZE + 64);
+  const char magic[8] = {'X', 'H', 'T', 'R', 'A', 'C', 'E', '\0'};
+  buf_.insert(buf_.end(), magic, magic + sizeof(magic));
+  put8(TB_EXEC_TRACE_VERSION);
+  put8(nmaster);
+  last_cycle_ = 0;
+  last_pc_    = 0;
+  records_    = 0;
+  return true;
+}
+
+void TbExecTrace::close()
+{
+  if(out_ == NULL)
+    return;
+  flush();
+  fclose(out_);
+  out_ = NULL;
+}
+
+void TbExecTrace::flush()
+{
+  if(!buf_.empty())
+    fwrite(&buf_[0], 1, buf_.size(), out_);
+  buf_.clear();
+}
+
+void TbExecTrace::put16(uint16_t value)
+{
+  put8(value);
+  put8(value >> 8);
+}
+
+void TbExecTrace::put32(uint32_t value)
+{
+  put16(value);
+  put16(value >> 16);
+}
+
+void TbExecTrace::putUleb(uint64_t value)
+{
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    put8(value ? (byte | 0x80) : byte);
+  } while(value);
+}
+
+void TbExecTrace::putSleb(int64_t value)
+{
+  bool more = true;
+  while(more) {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    more = !((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)));
+    put8(more ? (byte | 0x80) : byte);
+  }
+}
+
+void TbExecTrace::record(uint8_t type, uint64_t cycle)
+{
+  if(buf_.size() >= TB_EXEC_TRACE_BUFFER_SIZE)
+    flush();
+  put8(type);
+  // Records of the same cycle can be reported out of order by the bus monitor
+  putUleb(cycle >= last_cycle_ ? cycle - last_cycle_ : 0);
+  if(cycle > last_cycle_)
+    last_cycle_ = cycle;
+  records_++;
+}
+
+void TbExecTrace::instr(uint64_t cycle, uint32_t pc, uint32_t instr)
+{
+  if(out_ == NULL)
+    return;
+  record(TB_EXEC_TRACE_INSTR, cycle);
+  putSleb((int64_t)pc - (int64_t)last_pc_);
+  last_pc_ = pc;
+  if((instr & 0x3) == 0x3)
+    put32(instr);
+  else
+    put16(instr);
+}
+
+void TbExecTrace::reg(uint64_t cycle, uint8_t rd, uint32_t value)
+{
+  if(out_ == NULL)
+    return;
+  record(TB_EXEC_TRACE_REG, cycle);
+  put8(rd);
+  put32(value);
+}
+
+void TbExecTrace::bus(uint64_t cycle, uint8_t master, bool we, uint8_t be, uint32_t addr, uint32_t data,
+                      uint32_t stall_cycles, uint32_t latency_cycles)
+{
+  if(out_ == NULL)
+    return;
+  record(TB_EXEC_TRACE_BUS, cycle);
+  put8((master & 0x7f) | (we ? 0x80 : 0));
+  put8(be);
+  put32(addr);
+  put32(data);
+  putUleb(stall_cycles);
+  putUleb(latency_cycles);
+}
+
+// DPI imports of tb/tb_util.svh
+extern "C" void tb_exec_trace_instr(long long cycle, int pc, int instr)
+{
+  tbExecTrace().instr(cycle, pc, instr);
+}
+
+extern "C" void tb_exec_trace_reg(long long cycle, int rd, int value)
+{
+  tbExecTrace().reg(cycle, rd, value);
+}
+
+extern "C" void tb_exec_trace_bus(long long cycle, int master, int addr, int we, int be, int data,
+                                  int stall_cycles, int latency_cycles)
+{
+  tbExecTrace().bus(cycle, master, we != 0, be, addr, data, stall_cycles, latency_cycles);
+}
@@ -0,0 +1,78 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Execution trace of the Verilator testbench: retired instructions, register
+// file writes and the OBI transactions of the system crossbar masters, as
+// reported by the DPI imports of tb/tb_util.svh, are streamed to a compact
+// binary file decoded by util/tb_exec_trace_decode.py.
+//
+// File format (little endian):
+//   header  "XHTRACE" 8 bytes magic, u8 version, u8 number of bus masters
+//   records u8 type, uleb128 cycles since the previous record, then
+//     TB_EXEC_TRACE_INSTR  sleb128 pc delta from the previous instruction,
+//                          instruction (2 bytes if compressed, else 4)
+//     TB_EXEC_TRACE_REG    u8 rd, u32 value
+//     TB_EXEC_TRACE_BUS    u8 master | write << 7, u8 byte enable, u32 address,
+//                          u32 data, uleb128 grant wait, uleb128 latency
+//
+// The cycles of the bus records are the cycles of the response, the grant
+// wait and latency are counted from the request.
+
+#ifndef TB_EXEC_TRACE_H_
+#define TB_EXEC_TRACE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#define TB_EXEC_TRACE_VERSION 1
+
+enum tb_exec_trace_record_t {
+  TB_EXEC_TRACE_INSTR = 1,
+  TB_EXEC_TRACE_REG   = 2,
+  TB_EXEC_TRACE_BUS   = 3
+};
+
+// Streams of the trace, as passed to tb_set_exec_trace
+#define TB_EXEC_TRACE_EN_INSTR 0x1
+#define TB_EXEC_TRACE_EN_BUS   0x2
+
+class TbExecTrace {
+ public:
+  TbExecTrace() : out_(NULL), last_cycle_(0), last_pc_(0), records_(0) {}
+  ~TbExecTrace() { close(); }
+
+  // Creates file and writes the header, returns false on error
+  bool open(const std::string& file, unsigned int nmaster);
+  // Flushes and closes the file
+  void close();
+  bool isOpen() const { return out_ != NULL; }
+  uint64_t records() const { return records_; }
+
+  void instr(uint64_t cycle, uint32_t pc, uint32_t instr);
+  void reg(uint64_t cycle, uint8_t rd, uint32_t value);
+  void bus(uint64_t cycle, uint8_t master, bool we, uint8_t be, uint32_t addr, uint32_t data,
+           uint32_t stall_cycles, uint32_t latency_cycles);
+
+ private:
+  void record(uint8_t type, uint64_t cycle);
+  void put8(uint8_t value) { buf_.push_back(value); }
+  void put16(uint16_t value);
+  void put32(uint32_t value);
+  void putUleb(uint64_t value);
+  void putSleb(int64_t value);
+  void flush();
+
+  FILE *out_;
+  std::vector<uint8_t> buf_;
+  uint64_t last_cycle_;
+  uint32_t last_pc_;
+  uint64_t records_;
+};
+
+// Instance used by the DPI imports of tb/tb_util.svh
+TbExecTrace& tbExecTrace();
+
+#endif  // TB_EXEC_TRACE_H_
@@ -0,0 +1,297 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_ip_models.h"
+
+#include <fstream>
+#include <iostream>
+
+// Lines streamed by pdm2pcm_dummy before it stops the simulation
+#define TB_PDM_SOURCE_LINES 65536
+
+TbSlowMemory& tbSlowMemory()
+{
+  static TbSlowMemory memory;
+  return memory;
+}
+
+TbIffifo& tbIffifo()
+{
+  static TbIffifo fifo;
+  return fifo;
+}
+
+TbPdmSource& tbPdmSource()
+{
+  static TbPdmSource source;
+  return source;
+}
+
+//
+// slow_memory
+//
+
+TbSlowMemory::TbSlowMemory()
+  : mem_(1, 0), lfsr_(1), busy_(false), counter_(0), we_q_(false), addr_q_(0), wdata_q_(0), be_q_(0), rdata_(0)
+{
+}
+
+void TbSlowMemory::init(uint32_t num_words)
+{
+  mem_.assign(num_words ? num_words : 1, 0);
+}
+
+// The memory content is kept over the resets, as the one of tc_sram
+void TbSlowMemory::reset()
+{
+  busy_    = false;
+  counter_ = 0;
+}
+
+// 32 bits Galois LFSR, the grant and the latency only have to be irregular
+uint32_t TbSlowMemory::random()
+{
+  lfsr_ = (lfsr_ >> 1) ^ (-(lfsr_ & 1u) & 0xd0000001u);
+  return lfsr_;
+}
+
+void TbSlowMemory::posedge(bool gnt, bool we, uint32_t addr, uint32_t wdata, uint8_t be,
+                           bool& ready, bool& offer, bool& rvalid, uint32_t& rdata)
+{
+  rvalid = false;
+
+  if(busy_) {
+    // The access is done in the last cycle of the latency, the response is
+    // valid in the next one
+    if(counter_ == 1) {
+      uint32_t& word = mem_[addr_q_ % mem_.size()];
+      if(we_q_) {
+        for(int b = 0; b < 4; b++)
+          if(be_q_ & (1 << b)) word = (word & ~(0xffu << 8 * b)) | (wdata_q_ & (0xffu << 8 * b));
+      } else {
+        rdata_ = word;
+      }
+      busy_  = false;
+      rvalid = true;
+    } else {
+      counter_--;
+    }
+  } else if(gnt) {
+    busy_    = true;
+    counter_ = (random() & 0x1f) + 1;
+    we_q_    = we;
+    addr_q_  = addr;
+    wdata_q_ = wdata;
+    be_q_    = be;
+  }
+
+  ready = !busy_;
+  offer = random() & 1;
+  rdata = rdata_;
+}
+
+//
+// iffifo
+//
+
+TbIffifo::TbIffifo()
+{
+  reset(1);
+}
+
+void TbIffifo::reset(uint32_t out_interval)
+{
+  out_interval_ = out_interval;
+  for(unsigned int i = 0; i < depth_; i++) storage_[i] = 0;
+  rptr_         = 0;
+  count_        = 0;
+  fifo_in_q_    = 0;
+  watermark_q_  = 0;
+  interrupts_q_ = false;
+  status_q_     = 0;
+  occupancy_q_  = 0;
+  interval_q_   = 0;
+  intr_         = false;
+}
+
+// STATUS fields: EMPTY, AVAILABLE, REACHED, FULL
+uint32_t TbIffifo::status() const
+{
+  bool reached = count_ >= watermark_q_;
+  return (count_ == 0 ? 0x1 : 0x2) | (reached ? 0x4 : 0) | (count_ == depth_ ? 0x8 : 0);
+}
+
+void TbIffifo::posedge(bool re, bool we, int reg, uint32_t wdata, uint32_t regs[TB_IFFIFO_NREGS],
+                       bool& in_ready, bool& out_valid, bool& intr)
+{
+  bool pop  = re && reg == TB_IFFIFO_FIFO_OUT;
+  bool push = we && reg == TB_IFFIFO_FIFO_IN && count_ < depth_;
+
+  // STATUS and OCCUPANCY are registers written by the hardware every cycle,
+  // they are read one cycle late
+  status_q_    = status();
+  occupancy_q_ = count_;
+
+  // The interrupt fires while the watermark is reached, a write clears it
+  if((status() & 0x4) && interrupts_q_) intr_ = true;
+  if(we && reg == TB_IFFIFO_INTERRUPTS) intr_ = false;
+
+  if(pop) {
+    interval_q_ = (out_interval_ - 1) & 0xffff;
+  } else if(interval_q_ != 0) {
+    interval_q_--;
+  }
+
+  if(pop && count_ != 0) {
+    rptr_ = (rptr_ + 1) % depth_;
+    count_--;
+  }
+  if(push) {
+    storage_[(rptr_ + count_) % depth_] = wdata;
+    count_++;
+  }
+
+  if(we && reg == TB_IFFIFO_FIFO_IN) fifo_in_q_ = wdata;
+  if(we && reg == TB_IFFIFO_WATERMARK) watermark_q_ = wdata;
+  if(we && reg == TB_IFFIFO_INTERRUPTS) interrupts_q_ = wdata & 1;
+
+  outputs(regs, in_ready, out_valid, intr);
+}
+
+void TbIffifo::outputs(uint32_t regs[TB_IFFIFO_NREGS], bool& in_ready, bool& out_valid, bool& intr) const
+{
+  // The FIFO output is read with 1 added, as by the RTL
+  regs[TB_IFFIFO_FIFO_OUT]   = storage_[rptr_] + 1;
+  regs[TB_IFFIFO_FIFO_IN]    = fifo_in_q_;
+  regs[TB_IFFIFO_STATUS]     = status_q_;
+  regs[TB_IFFIFO_OCCUPANCY]  = occupancy_q_;
+  regs[TB_IFFIFO_WATERMARK]  = watermark_q_;
+  regs[TB_IFFIFO_INTERRUPTS] = interrupts_q_;
+
+  in_ready  = count_ < depth_;
+  out_valid = count_ != 0 && interval_q_ == 0;
+  intr      = intr_;
+}
+
+//
+// pdm2pcm_dummy
+//
+
+TbPdmSource::TbPdmSource()
+  : loaded_(false), init_(false), pdm_clk_q_(false), line_(0)
+{
+}
+
+void TbPdmSource::reset()
+{
+  init_ = false;
+  line_ = 0;
+}
+
+// The file is read once, instead of a line per PDM clock cycle
+bool TbPdmSource::open(const std::string& file)
+{
+  std::ifstream in(file.c_str());
+  if(!in) {
+    std::cout<<"Failed to open PDM file."<<std::endl;
+    std::cout<<" > Please check if this the simulation was launched using"<<std::endl;
+    std::cout<<"   `make *-sim` or `make run-pdm2pcm`."<<std::endl;
+    return false;
+  }
+  std::string line;
+  samples_.clear();
+  while(samples_.size() <= TB_PDM_SOURCE_LINES && std::getline(in, line))
+    samples_.push_back(!line.empty() && line[0] == '1');
+  return true;
+}
+
+void TbPdmSource::posedge(const std::string& file, bool pdm_clk, bool& pdm_data, bool& stop)
+{
+  stop = false;
+
+  if(!init_) {
+    if(!loaded_) {
+      open(file);
+      loaded_ = true;
+    }
+    init_      = true;
+    line_      = 0;
+    pdm_data   = sample(0);
+    pdm_clk_q_ = false;
+  }
+
+  if(pdm_clk && !pdm_clk_q_) {
+    line_++;
+    pdm_data = sample(line_);
+  }
+  pdm_clk_q_ = pdm_clk;
+
+  if(line_ >= TB_PDM_SOURCE_LINES) stop = true;
+}
+
+//
+// DPI imports of the shims
+//
+
+extern "C" void slow_memory_dpi_init(int num_words)
+{
+  tbSlowMemory().init(num_words);
+}
+
+extern "C" void slow_memory_dpi_posedge(int rst_n, int gnt, int we, int addr, int wdata, int be,
+                                        int *ready, int *offer, int *rvalid, int *rdata)
+{
+  bool ready_b, offer_b, rvalid_b;
+  uint32_t rdata_w;
+  if(!rst_n) {
+    tbSlowMemory().reset();
+    *ready  = 1;
+    *offer  = 0;
+    *rvalid = 0;
+    return;
+  }
+  tbSlowMemory().posedge(gnt != 0, we != 0, addr, wdata, be, ready_b, offer_b, rvalid_b, rdata_w);
+  *ready  = ready_b;
+  *offer  = offer_b;
+  *rvalid = rvalid_b;
+  *rdata  = rdata_w;
+}
+
+extern "C" void iffifo_dpi_posedge(int rst_n, int out_interval, int re, int we, int reg, int wdata,
+                                   int *fifo_out, int *fifo_in, int *status, int *occupancy,
+                                   int *watermark, int *interrupts, int *in_ready, int *out_valid,
+                                   int *intr)
+{
+  uint32_t regs[TB_IFFIFO_NREGS];
+  bool in_ready_b, out_valid_b, intr_b;
+  if(!rst_n) {
+    tbIffifo().reset(out_interval);
+    tbIffifo().outputs(regs, in_ready_b, out_valid_b, intr_b);
+  } else {
+    tbIffifo().posedge(re != 0, we != 0, reg, wdata, regs, in_ready_b, out_valid_b, intr_b);
+  }
+  *fifo_out   = regs[TB_IFFIFO_FIFO_OUT];
+  *fifo_in    = regs[TB_IFFIFO_FIFO_IN];
+  *status     = regs[TB_IFFIFO_STATUS];
+  *occupancy  = regs[TB_IFFIFO_OCCUPANCY];
+  *watermark  = regs[TB_IFFIFO_WATERMARK];
+  *interrupts = regs[TB_IFFIFO_INTERRUPTS];
+  *in_ready   = in_ready_b;
+  *out_valid  = out_valid_b;
+  *intr       = intr_b;
+}
+
+extern "C" void pdm2pcm_dummy_dpi_posedge(int rst_n, const char *filepath, int pdm_clk, int *pdm_data, int *stop)
+{
+  bool data = *pdm_data != 0, end;
+  if(!rst_n) {
+    tbPdmSource().reset();
+    *pdm_data = 0;
+    *stop     = 0;
+    return;
+  }
+  tbPdmSource().posedge(filepath, pdm_clk != 0, data, end);
+  *pdm_data = data;
+  *stop     = end;
+}
@@ -0,0 +1,118 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// C++ models of the example IPs of the testharness (hw/ip_examples), used by
+// the Verilator model built with VERILATOR_IP_MODELS=1 in place of their RTL.
+// Each model is driven once per rising edge of the clock by its shim in tb/
+// (slow_memory_dpi.sv, iffifo_dpi.sv, pdm2pcm_dummy_dpi.sv), which keeps the
+// ports and the cycle behaviour of the RTL: the shims register the outputs
+// returned by the models and only do the combinational glue (grant, register
+// decoding) in SystemVerilog.
+
+#ifndef TB_IP_MODELS_H_
+#define TB_IP_MODELS_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// hw/ip_examples/slow_memory: random grant, then 2 to 33 cycles of latency
+class TbSlowMemory {
+ public:
+  TbSlowMemory();
+
+  void init(uint32_t num_words);
+  void reset();
+
+  // Rising edge of the clock, gnt is the grant given in the ending cycle;
+  // outputs the grant offered and the response for the next cycle
+  void posedge(bool gnt, bool we, uint32_t addr, uint32_t wdata, uint8_t be,
+               bool& ready, bool& offer, bool& rvalid, uint32_t& rdata);
+
+ private:
+  uint32_t random();
+
+  std::vector<uint32_t> mem_;
+  uint32_t lfsr_;
+  bool busy_;
+  uint32_t counter_;
+  bool we_q_;
+  uint32_t addr_q_;
+  uint32_t wdata_q_;
+  uint8_t be_q_;
+  uint32_t rdata_;
+};
+
+// Registers of hw/ip_examples/iffifo, in the order of iffifo_reg_pkg
+enum tb_iffifo_reg_t {
+  TB_IFFIFO_FIFO_OUT,
+  TB_IFFIFO_FIFO_IN,
+  TB_IFFIFO_STATUS,
+  TB_IFFIFO_OCCUPANCY,
+  TB_IFFIFO_WATERMARK,
+  TB_IFFIFO_INTERRUPTS,
+  TB_IFFIFO_NREGS
+};
+
+// hw/ip_examples/iffifo: 4 words FIFO behind the registers, with the DMA
+// slots, the output pacing and the watermark interrupt
+class TbIffifo {
+ public:
+  TbIffifo();
+
+  void reset(uint32_t out_interval);
+
+  // Rising edge of the clock with the register access of the ending cycle
+  // (reg < 0 for none), regs returns the values read in the next cycle
+  void posedge(bool re, bool we, int reg, uint32_t wdata, uint32_t regs[TB_IFFIFO_NREGS],
+               bool& in_ready, bool& out_valid, bool& intr);
+  // Outputs of the current state, as returned by posedge()
+  void outputs(uint32_t regs[TB_IFFIFO_NREGS], bool& in_ready, bool& out_valid, bool& intr) const;
+
+ private:
+  static const unsigned int depth_ = 4;
+
+  uint32_t status() const;
+
+  uint32_t out_interval_;
+  uint32_t storage_[depth_];
+  unsigned int rptr_;
+  unsigned int count_;
+  uint32_t fifo_in_q_;
+  uint32_t watermark_q_;
+  bool interrupts_q_;
+  uint32_t status_q_;
+  uint32_t occupancy_q_;
+  uint32_t interval_q_;
+  bool intr_;
+};
+
+// hw/ip_examples/pdm2pcm_dummy: streams the first character of each line of
+// a text file on the PDM data line, a line per rising edge of the PDM clock
+class TbPdmSource {
+ public:
+  TbPdmSource();
+
+  void reset();
+
+  // Rising edge of the system clock, returns the PDM data for the next cycle
+  // and stop when the end of the stream is reached
+  void posedge(const std::string& file, bool pdm_clk, bool& pdm_data, bool& stop);
+
+ private:
+  bool open(const std::string& file);
+  bool sample(size_t line) const { return line < samples_.size() && samples_[line]; }
+
+  std::vector<bool> samples_;
+  bool loaded_;
+  bool init_;
+  bool pdm_clk_q_;
+  size_t line_;
+};
+
+TbSlowMemory& tbSlowMemory();
+TbIffifo& tbIffifo();
+TbPdmSource& tbPdmSource();
+
+#endif  // TB_IP_MODELS_H_
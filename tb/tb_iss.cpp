@@ -0,0 +1,480 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_iss.h"
+
+#include <iostream>
+#include <sstream>
+
+// Machine-mode CSRs used by the model
+#define CSR_MSTATUS   0x300
+#define CSR_MISA      0x301
+#define CSR_MIE       0x304
+#define CSR_MTVEC     0x305
+#define CSR_MSCRATCH  0x340
+#define CSR_MEPC      0x341
+#define CSR_MCAUSE    0x342
+#define CSR_MTVAL     0x343
+#define CSR_MCYCLE    0xB00
+#define CSR_MINSTRET  0xB02
+#define CSR_MCYCLEH   0xB80
+#define CSR_MINSTRETH 0xB82
+#define CSR_CYCLE     0xC00
+#define CSR_INSTRET   0xC02
+#define CSR_CYCLEH    0xC80
+#define CSR_INSTRETH  0xC82
+
+#define MSTATUS_MIE  (1u << 3)
+#define MSTATUS_MPIE (1u << 7)
+#define MSTATUS_MPP  (3u << 11)
+
+#define CAUSE_ECALL_M 11
+
+// A firmware reading the same device word this many times in a row is
+// waiting for a device that is not modelled
+#define TB_ISS_POLL_LIMIT 1000000
+
+// Trap CSRs restored by the resume stub, mstatus first as the interrupts are
+// only enabled at the end
+static const uint32_t stub_csrs[] = {CSR_MSTATUS, CSR_MIE, CSR_MTVEC, CSR_MEPC, CSR_MCAUSE, CSR_MSCRATCH};
+
+static inline uint32_t bits(uint32_t v, int hi, int lo) { return (v >> lo) & ((1u << (hi - lo + 1)) - 1); }
+static inline int32_t sext(uint32_t v, int width) { return (int32_t)(v << (32 - width)) >> (32 - width); }
+
+// Encoders of the 32-bit formats, used to expand the compressed instructions
+// and to assemble the resume stub
+static uint32_t encR(uint32_t op, uint32_t rd, uint32_t f3, uint32_t rs1, uint32_t rs2, uint32_t f7) {
+  return f7 << 25 | rs2 << 20 | rs1 << 15 | f3 << 12 | rd << 7 | op;
+}
+static uint32_t encI(uint32_t op, uint32_t rd, uint32_t f3, uint32_t rs1, int32_t imm) {
+  return ((uint32_t)imm & 0xfff) << 20 | rs1 << 15 | f3 << 12 | rd << 7 | op;
+}
+static uint32_t encS(uint32_t op, uint32_t f3, uint32_t rs1, uint32_t rs2, int32_t imm) {
+  return bits(imm, 11, 5) << 25 | rs2 << 20 | rs1 << 15 | f3 << 12 | bits(imm, 4, 0) << 7 | op;
+}
+static uint32_t encB(uint32_t f3, uint32_t rs1, uint32_t rs2, int32_t imm) {
+  return bits(imm, 12, 12) << 31 | bits(imm, 10, 5) << 25 | rs2 << 20 | rs1 << 15 | f3 << 12 |
+         bits(imm, 4, 1) << 8 | bits(imm, 11, 11) << 7 | 0x63;
+}
+static uint32_t encJ(uint32_t rd, int32_t imm) {
+  return bits(imm, 20, 20) << 31 | bits(imm, 10, 1) << 21 | bits(imm, 11, 11) << 20 | bits(imm, 19, 12) << 12 |
+         rd << 7 | 0x6f;
+}
+static uint32_t encU(uint32_t op, uint32_t rd, uint32_t imm) { return (imm & 0xfffff000) | rd << 7 | op; }
+
+TbIss::TbIss(std::vector<uint8_t>& mem, const tb_iss_map_t& map)
+  : mem_(mem), map_(map), pc_(0), instret_(0), exited_(false), exit_value_(0),
+    written_(mem.size() / 4, false), poll_addr_(0), poll_count_(0)
+{
+  for(int r = 0; r < 32; r++) x_[r] = 0;
+  csrs_[CSR_MISA] = 0x40001104; // RV32IMC
+}
+
+tb_iss_stop_t TbIss::run(uint32_t pc, uint32_t marker_pc, uint64_t max_instr)
+{
+  pc_ = pc;
+  while(true) {
+    if(pc_ == marker_pc) return TB_ISS_STOP_MARKER;
+    if(instret_ >= max_instr) return TB_ISS_STOP_INSTR;
+    if(!step()) return TB_ISS_STOP_ERROR;
+    if(exited_) return TB_ISS_STOP_EXIT;
+  }
+}
+
+bool TbIss::fail(const std::string& reason)
+{
+  std::ostringstream msg;
+  msg<<reason<<" at pc 0x"<<std::hex<<pc_<<std::dec<<" after "<<instret_<<" instructions";
+  error_ = msg.str();
+  return false;
+}
+
+uint32_t TbIss::csr(uint32_t addr) const
+{
+  switch(addr) {
+    // Without timing, the cycles are the retired instructions
+    case CSR_MCYCLE: case CSR_MINSTRET: case CSR_CYCLE: case CSR_INSTRET:
+      return (uint32_t)instret_;
+    case CSR_MCYCLEH: case CSR_MINSTRETH: case CSR_CYCLEH: case CSR_INSTRETH:
+      return (uint32_t)(instret_ >> 32);
+  }
+  std::map<uint32_t, uint32_t>::const_iterator it = csrs_.find(addr);
+  return it == csrs_.end() ? 0 : it->second;
+}
+
+void TbIss::writeCsr(uint32_t addr, uint32_t value)
+{
+  // The counters and the read-only CSRs keep their value
+  if(bits(addr, 11, 10) == 3 || addr == CSR_MISA) return;
+  if(addr == CSR_MCYCLE || addr == CSR_MINSTRET) { instret_ = (instret_ & ~0xffffffffull) | value; return; }
+  if(addr == CSR_MCYCLEH || addr == CSR_MINSTRETH) { instret_ = (instret_ & 0xffffffffull) | (uint64_t)value << 32; return; }
+  csrs_[addr] = value;
+}
+
+void TbIss::trap(uint32_t cause, uint32_t tval, uint32_t& next_pc)
+{
+  uint32_t mstatus = csr(CSR_MSTATUS);
+  mstatus = (mstatus & ~(MSTATUS_MPIE | MSTATUS_MIE)) | ((mstatus & MSTATUS_MIE) ? MSTATUS_MPIE : 0) | MSTATUS_MPP;
+  csrs_[CSR_MSTATUS] = mstatus;
+  csrs_[CSR_MEPC]    = pc_;
+  csrs_[CSR_MCAUSE]  = cause;
+  csrs_[CSR_MTVAL]   = tval;
+  // The exceptions go to the base in both the direct and the vectored modes
+  next_pc = csr(CSR_MTVEC) & ~3u;
+}
+
+bool TbIss::fetch(uint32_t addr, uint16_t& half)
+{
+  if((uint64_t)addr + 2 > mem_.size()) return fail("Instruction fetch outside of the SRAM");
+  half = mem_[addr] | mem_[addr + 1] << 8;
+  return true;
+}
+
+bool TbIss::load(uint32_t addr, unsigned int size, uint32_t& value)
+{
+  value = 0;
+  if((uint64_t)addr + size <= mem_.size()) {
+    for(unsigned int b = 0; b < size; b++) value |= (uint32_t)mem_[addr + b] << (8 * b);
+    return true;
+  }
+
+  uint32_t word = addr & ~3u;
+  std::map<uint32_t, uint32_t>::const_iterator it = devices_.find(word);
+  uint32_t data = it == devices_.end() ? 0 : it->second;
+  value = data >> (8 * (addr & 3));
+  if(size < 4) value &= (1u << (8 * size)) - 1;
+
+  poll_count_ = word == poll_addr_ ? poll_count_ + 1 : 1;
+  poll_addr_  = word;
+  if(poll_count_ > TB_ISS_POLL_LIMIT) {
+    std::ostringstream msg;
+    msg<<"Polling the device word 0x"<<std::hex<<word<<" that is not modelled";
+    return fail(msg.str());
+  }
+  return true;
+}
+
+bool TbIss::store(uint32_t addr, unsigned int size, uint32_t value)
+{
+  if((uint64_t)addr + size <= mem_.size()) {
+    for(unsigned int b = 0; b < size; b++) {
+      mem_[addr + b] = value >> (8 * b);
+      written_[(addr + b) >> 2] = true;
+    }
+    return true;
+  }
+
+  uint32_t word  = addr & ~3u;
+  uint32_t shift = 8 * (addr & 3);
+  uint32_t mask  = (size < 4 ? (1u << (8 * size)) - 1 : ~0u) << shift;
+  uint32_t data  = (devices_[word] & ~mask) | ((value << shift) & mask);
+  devices_[word] = data;
+  poll_count_    = 0;
+
+  if(word == map_.uart_wdata) {
+    char c = data & 0xff;
+    if(c == '\n') {
+      std::cout<<"[FAST-FORWARD]: uart: "<<uart_line_<<std::endl;
+      uart_line_.clear();
+    } else if(c != '\r') {
+      uart_line_ += c;
+    }
+  } else if(word == map_.exit_value) {
+    exit_value_ = data;
+  } else if(word == map_.exit_valid) {
+    exited_ = data & 1;
+  } else {
+    device_writes_[word] = data;
+  }
+  return true;
+}
+
+// Returns the 32-bit instruction equivalent to a compressed one, 0 if illegal
+uint32_t TbIss::expandCompressed(uint16_t c)
+{
+  uint32_t rd   = bits(c, 11, 7);
+  uint32_t rs2  = bits(c, 6, 2);
+  uint32_t rdp  = bits(c, 4, 2) + 8; // rd' and rs2'
+  uint32_t rs1p = bits(c, 9, 7) + 8; // rs1' and rd'
+  int32_t  imm6 = sext(bits(c, 12, 12) << 5 | bits(c, 6, 2), 6);
+  uint32_t f3   = bits(c, 15, 13);
+
+  switch(bits(c, 1, 0) << 3 | f3) {
+    case 0x00: { // c.addi4spn
+      uint32_t imm = bits(c, 10, 7) << 6 | bits(c, 12, 11) << 4 | bits(c, 5, 5) << 3 | bits(c, 6, 6) << 2;
+      return imm == 0 ? 0 : encI(0x13, rdp, 0, 2, imm);
+    }
+    case 0x02: // c.lw
+      return encI(0x03, rdp, 2, rs1p, bits(c, 12, 10) << 3 | bits(c, 6, 6) << 2 | bits(c, 5, 5) << 6);
+    case 0x06: // c.sw
+      return encS(0x23, 2, rs1p, rdp, bits(c, 12, 10) << 3 | bits(c, 6, 6) << 2 | bits(c, 5, 5) << 6);
+    case 0x08: // c.addi
+      return encI(0x13, rd, 0, rd, imm6);
+    case 0x09: case 0x0d: { // c.jal, c.j
+      int32_t imm = sext(bits(c, 12, 12) << 11 | bits(c, 8, 8) << 10 | bits(c, 10, 9) << 8 | bits(c, 6, 6) << 7 |
+                         bits(c, 7, 7) << 6 | bits(c, 2, 2) << 5 | bits(c, 11, 11) << 4 | bits(c, 5, 3) << 1, 12);
+      return encJ(f3 == 1 ? 1 : 0, imm);
+    }
+    case 0x0a: // c.li
+      return encI(0x13, rd, 0, 0, imm6);
+    case 0x0b:
+      if(rd == 2) { // c.addi16sp
+        int32_t imm = sext(bits(c, 12, 12) << 9 | bits(c, 4, 3) << 7 | bits(c, 5, 5) << 6 | bits(c, 2, 2) << 5 |
+                           bits(c, 6, 6) << 4, 10);
+        return imm == 0 ? 0 : encI(0x13, 2, 0, 2, imm);
+      }
+      return imm6 == 0 ? 0 : encU(0x37, rd, (uint32_t)imm6 << 12); // c.lui
+    case 0x0c:
+      switch(bits(c, 11, 10)) {
+        case 0: return bits(c, 12, 12) ? 0 : encR(0x13, rs1p, 5, rs1p, rs2, 0x00); // c.srli
+        case 1: return bits(c, 12, 12) ? 0 : encR(0x13, rs1p, 5, rs1p, rs2, 0x20); // c.srai
+        case 2: return encI(0x13, rs1p, 7, rs1p, imm6);                             // c.andi
+        default:
+          if(bits(c, 12, 12)) return 0;
+          switch(bits(c, 6, 5)) {
+            case 0:  return encR(0x33, rs1p, 0, rs1p, rdp, 0x20); // c.sub
+            case 1:  return encR(0x33, rs1p, 4, rs1p, rdp, 0x00); // c.xor
+            case 2:  return encR(0x33, rs1p, 6, rs1p, rdp, 0x00); // c.or
+            default: return encR(0x33, rs1p, 7, rs1p, rdp, 0x00); // c.and
+          }
+      }
+    case 0x0e: case 0x0f: { // c.beqz, c.bnez
+      int32_t imm = sext(bits(c, 12, 12) << 8 | bits(c, 6, 5) << 6 | bits(c, 2, 2) << 5 | bits(c, 11, 10) << 3 |
+                         bits(c, 4, 3) << 1, 9);
+      return encB(f3 == 6 ? 0 : 1, rs1p, 0, imm);
+    }
+    case 0x10: // c.slli
+      return bits(c, 12, 12) ? 0 : encR(0x13, rd, 1, rd, rs2, 0x00);
+    case 0x12: // c.lwsp
+      return rd == 0 ? 0 : encI(0x03, rd, 2, 2, bits(c, 12, 12) << 5 | bits(c, 6, 4) << 2 | bits(c, 3, 2) << 6);
+    case 0x14:
+      if(!bits(c, 12, 12)) {
+        if(rs2 == 0) return rd == 0 ? 0 : encI(0x67, 0, 0, rd, 0); // c.jr
+        return encR(0x33, rd, 0, 0, rs2, 0x00);                     // c.mv
+      }
+      if(rs2 == 0) return rd == 0 ? 0x00100073 : encI(0x67, 1, 0, rd, 0); // c.ebreak, c.jalr
+      return encR(0x33, rd, 0, rd, rs2, 0x00);                              // c.add
+    case 0x16: // c.swsp
+      return encS(0x23, 2, 2, rs2, bits(c, 12, 9) << 2 | bits(c, 8, 7) << 6);
+  }
+  return 0;
+}
+
+bool TbIss::execCsr(uint32_t instr, uint32_t& rd_value)
+{
+  uint32_t addr = bits(instr, 31, 20);
+  uint32_t f3   = bits(instr, 14, 12);
+  uint32_t rs1  = bits(instr, 19, 15);
+  uint32_t src  = (f3 & 4) ? rs1 : x_[rs1];
+
+  rd_value = csr(addr);
+  switch(f3 & 3) {
+    case 1: writeCsr(addr, src); break;
+    case 2: if(rs1 != 0) writeCsr(addr, rd_value | src); break;
+    case 3: if(rs1 != 0) writeCsr(addr, rd_value & ~src); break;
+    default: return fail("Illegal instruction");
+  }
+  return true;
+}
+
+bool TbIss::step()
+{
+  uint16_t lo, hi;
+  uint32_t instr, len;
+  if(!fetch(pc_, lo)) return false;
+  if((lo & 3) != 3) {
+    instr = expandCompressed(lo);
+    len   = 2;
+    if(instr == 0) return fail("Illegal compressed instruction");
+  } else {
+    if(!fetch(pc_ + 2, hi)) return false;
+    instr = lo | (uint32_t)hi << 16;
+    len   = 4;
+  }
+
+  uint32_t next_pc = pc_ + len;
+  uint32_t rd  = bits(instr, 11, 7);
+  uint32_t f3  = bits(instr, 14, 12);
+  uint32_t f7  = bits(instr, 31, 25);
+  uint32_t a   = x_[bits(instr, 19, 15)];
+  uint32_t b   = x_[bits(instr, 24, 20)];
+  int32_t immI = sext(bits(instr, 31, 20), 12);
+  int32_t immS = sext(bits(instr, 31, 25) << 5 | bits(instr, 11, 7), 12);
+  int32_t immB = sext(bits(instr, 31, 31) << 12 | bits(instr, 7, 7) << 11 | bits(instr, 30, 25) << 5 |
+                      bits(instr, 11, 8) << 1, 13);
+  int32_t immJ = sext(bits(instr, 31, 31) << 20 | bits(instr, 19, 12) << 12 | bits(instr, 20, 20) << 11 |
+                      bits(instr, 30, 21) << 1, 21);
+  uint32_t value;
+
+  switch(bits(instr, 6, 0)) {
+    case 0x37: setReg(rd, instr & 0xfffff000); break;        // lui
+    case 0x17: setReg(rd, pc_ + (instr & 0xfffff000)); break; // auipc
+    case 0x6f: setReg(rd, pc_ + len); next_pc = pc_ + immJ; break;
+    case 0x67:
+      if(f3 != 0) return fail("Illegal instruction");
+      next_pc = (a + immI) & ~1u;
+      setReg(rd, pc_ + len);
+      break;
+    case 0x63: {
+      bool taken;
+      switch(f3) {
+        case 0: taken = a == b; break;
+        case 1: taken = a != b; break;
+        case 4: taken = (int32_t)a < (int32_t)b; break;
+        case 5: taken = (int32_t)a >= (int32_t)b; break;
+        case 6: taken = a < b; break;
+        case 7: taken = a >= b; break;
+        default: return fail("Illegal instruction");
+      }
+      if(taken) next_pc = pc_ + immB;
+      break;
+    }
+    case 0x03:
+      switch(f3) {
+        case 0: if(!load(a + immI, 1, value)) return false; setReg(rd, sext(value, 8)); break;
+        case 1: if(!load(a + immI, 2, value)) return false; setReg(rd, sext(value, 16)); break;
+        case 2: if(!load(a + immI, 4, value)) return false; setReg(rd, value); break;
+        case 4: if(!load(a + immI, 1, value)) return false; setReg(rd, value); break;
+        case 5: if(!load(a + immI, 2, value)) return false; setReg(rd, value); break;
+        default: return fail("Illegal instruction");
+      }
+      break;
+    case 0x23:
+      if(f3 > 2) return fail("Illegal instruction");
+      if(!store(a + immS, 1u << f3, b)) return false;
+      break;
+    case 0x13:
+      switch(f3) {
+        case 0: setReg(rd, a + immI); break;
+        case 1: setReg(rd, a << (immI & 31)); break;
+        case 2: setReg(rd, (int32_t)a < immI); break;
+        case 3: setReg(rd, a < (uint32_t)immI); break;
+        case 4: setReg(rd, a ^ immI); break;
+        case 5: setReg(rd, (f7 & 0x20) ? (uint32_t)((int32_t)a >> (immI & 31)) : a >> (immI & 31)); break;
+        case 6: setReg(rd, a | immI); break;
+        case 7: setReg(rd, a & immI); break;
+      }
+      break;
+    case 0x33:
+      if(f7 == 0x01) {
+        int64_t sa = (int32_t)a, sb = (int32_t)b;
+        switch(f3) {
+          case 0: setReg(rd, a * b); break;
+          case 1: setReg(rd, (uint32_t)((sa * sb) >> 32)); break;
+          case 2: setReg(rd, (uint32_t)((sa * (int64_t)(uint64_t)b) >> 32)); break;
+          case 3: setReg(rd, (uint32_t)(((uint64_t)a * b) >> 32)); break;
+          case 4: setReg(rd, b == 0 ? ~0u : (a == 0x80000000 && b == ~0u) ? a : (uint32_t)((int32_t)a / (int32_t)b)); break;
+          case 5: setReg(rd, b == 0 ? ~0u : a / b); break;
+          case 6: setReg(rd, b == 0 ? a : (a == 0x80000000 && b == ~0u) ? 0 : (uint32_t)((int32_t)a % (int32_t)b)); break;
+          case 7: setReg(rd, b == 0 ? a : a % b); break;
+        }
+        break;
+      }
+      if(f7 != 0x00 && !(f7 == 0x20 && (f3 == 0 || f3 == 5))) return fail("Illegal instruction");
+      switch(f3) {
+        case 0: setReg(rd, f7 ? a - b : a + b); break;
+        case 1: setReg(rd, a << (b & 31)); break;
+        case 2: setReg(rd, (int32_t)a < (int32_t)b); break;
+        case 3: setReg(rd, a < b); break;
+        case 4: setReg(rd, a ^ b); break;
+        case 5: setReg(rd, f7 ? (uint32_t)((int32_t)a >> (b & 31)) : a >> (b & 31)); break;
+        case 6: setReg(rd, a | b); break;
+        case 7: setReg(rd, a & b); break;
+      }
+      break;
+    case 0x0f: // fence, fence.i: the model has no caches nor buffers
+      break;
+    case 0x73:
+      if(f3 != 0) {
+        if(!execCsr(instr, value)) return false;
+        setReg(rd, value);
+        break;
+      }
+      switch(instr) {
+        case 0x00000073: // ecall
+          trap(CAUSE_ECALL_M, 0, next_pc);
+          break;
+        case 0x30200073: { // mret
+          uint32_t mstatus = csr(CSR_MSTATUS);
+          mstatus = (mstatus & ~MSTATUS_MIE) | ((mstatus & MSTATUS_MPIE) ? MSTATUS_MIE : 0) | MSTATUS_MPIE;
+          csrs_[CSR_MSTATUS] = mstatus;
+          next_pc = csr(CSR_MEPC);
+          break;
+        }
+        case 0x00100073:
+          return fail("ebreak");
+        case 0x10500073:
+          return fail("wfi, the interrupts are not modelled,");
+        default:
+          return fail("Illegal instruction");
+      }
+      break;
+    default:
+      return fail("Illegal instruction");
+  }
+
+  instret_++;
+  pc_ = next_pc;
+  return true;
+}
+
+// Code: auipc, 3 instructions per replay word and 2 per CSR, 31 loads,
+// csrsi if the interrupts are enabled and the jump
+static unsigned int stubCodeWords(size_t nreplay, bool mie)
+{
+  return 1 + 3 * nreplay + 2 * (sizeof(stub_csrs) / sizeof(stub_csrs[0])) + 31 + (mie ? 1 : 0) + 1;
+}
+
+uint32_t TbIss::resumeStubSize(size_t nreplay) const
+{
+  unsigned int ndata = 2 * nreplay + sizeof(stub_csrs) / sizeof(stub_csrs[0]) + 31;
+  return 4 * (stubCodeWords(nreplay, csr(CSR_MSTATUS) & MSTATUS_MIE) + ndata);
+}
+
+bool TbIss::resumeStub(uint32_t stub_addr, const std::map<uint32_t, uint32_t>& replay, std::vector<uint32_t>& words) const
+{
+  const unsigned int ncsrs = sizeof(stub_csrs) / sizeof(stub_csrs[0]);
+  bool mie = csr(CSR_MSTATUS) & MSTATUS_MIE;
+  unsigned int ncode = stubCodeWords(replay.size(), mie);
+
+  // The data is addressed from the start of the stub with 12-bit offsets
+  if(resumeStubSize(replay.size()) > 2048) return false;
+  int32_t jump = pc_ - (stub_addr + (ncode - 1) * 4);
+  if(jump < -(1 << 20) || jump >= (1 << 20)) return false;
+
+  words.clear();
+  std::vector<uint32_t> data;
+  int32_t off = ncode * 4;
+
+  words.push_back(encU(0x17, 31, 0)); // auipc x31, 0
+  for(std::map<uint32_t, uint32_t>::const_iterator it = replay.begin(); it != replay.end(); ++it) {
+    words.push_back(encI(0x03, 1, 2, 31, off + 4 * data.size()));     // lw x1, addr
+    data.push_back(it->first);
+    words.push_back(encI(0x03, 2, 2, 31, off + 4 * data.size()));     // lw x2, value
+    data.push_back(it->second);
+    words.push_back(encS(0x23, 2, 1, 2, 0));                          // sw x2, 0(x1)
+  }
+  for(unsigned int c = 0; c < ncsrs; c++) {
+    words.push_back(encI(0x03, 1, 2, 31, off + 4 * data.size()));     // lw x1, value
+    data.push_back(stub_csrs[c] == CSR_MSTATUS ? csr(CSR_MSTATUS) & ~MSTATUS_MIE : csr(stub_csrs[c]));
+    words.push_back(encI(0x73, 0, 1, 1, stub_csrs[c]));               // csrw csr, x1
+  }
+  for(unsigned int r = 1; r < 32; r++) {
+    words.push_back(encI(0x03, r, 2, 31, off + 4 * data.size()));     // lw xr, value
+    data.push_back(x_[r]);
+  }
+  if(mie) words.push_back(encI(0x73, 0, 6, MSTATUS_MIE, CSR_MSTATUS)); // csrsi mstatus, MIE
+  words.push_back(encJ(0, jump));                                      // j pc
+
+  words.insert(words.end(), data.begin(), data.end());
+  return true;
+}
+
+void TbIss::farJump(uint32_t target, std::vector<uint32_t>& words)
+{
+  uint32_t hi = (target + 0x800) & 0xfffff000;
+  words.clear();
+  words.push_back(encU(0x37, 5, hi));                         // lui t0, %hi(target)
+  words.push_back(encI(0x67, 0, 0, 5, (int32_t)(target - hi))); // jalr x0, %lo(target)(t0)
+}
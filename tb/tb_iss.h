@@ -0,0 +1,105 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Functional RV32IMC + Zicsr instruction-set model used by the Verilator
+// testbench to fast-forward the firmware to a marker before switching over to
+// the RTL (+fast_forward, tb/tb_top.cpp).
+//
+// The model executes from the same SRAM image as the RTL, one instruction per
+// step and without timing. Everything outside of the SRAM is a device: the
+// writes are recorded (the last value of each word) and the reads return the
+// last value written, or the value preset with presetDevice(). On top of it,
+// the model knows the exit registers of soc_ctrl and the TX of the UART.
+// Interrupts, the DMA and the other peripherals are not modelled: the model
+// stops on wfi and when the firmware keeps polling a device register.
+
+#ifndef TB_ISS_H_
+#define TB_ISS_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// Addresses of the devices known by the model, from tb_getFastForwardMap
+typedef struct tb_iss_map {
+  uint32_t exit_valid;
+  uint32_t exit_value;
+  uint32_t uart_wdata;
+} tb_iss_map_t;
+
+enum tb_iss_stop_t {
+  TB_ISS_STOP_MARKER, // the next instruction is at the marker PC
+  TB_ISS_STOP_INSTR,  // the instruction budget is spent
+  TB_ISS_STOP_EXIT,   // the firmware wrote EXIT_VALID
+  TB_ISS_STOP_ERROR   // illegal instruction, wfi, polling, see error()
+};
+
+class TbIss {
+ public:
+  // mem is the SRAM image, starting at address 0, executed in place
+  TbIss(std::vector<uint8_t>& mem, const tb_iss_map_t& map);
+
+  // Value read from a device word until the firmware writes it
+  void presetDevice(uint32_t addr, uint32_t value) { devices_[addr & ~3u] = value; }
+
+  // Runs from pc until the instruction at marker_pc is next (~0 for none) or
+  // max_instr instructions retired
+  tb_iss_stop_t run(uint32_t pc, uint32_t marker_pc, uint64_t max_instr);
+
+  uint32_t pc() const { return pc_; }
+  uint32_t reg(unsigned int r) const { return x_[r]; }
+  uint32_t csr(uint32_t addr) const;
+  uint64_t instret() const { return instret_; }
+  uint32_t exitValue() const { return exit_value_; }
+  const std::string& error() const { return error_; }
+
+  // Words of the SRAM written by the firmware, indexed by address / 4
+  const std::vector<bool>& written() const { return written_; }
+  // Last value written to each device word, except the exit and UART TX registers
+  const std::map<uint32_t, uint32_t>& deviceWrites() const { return device_writes_; }
+
+  // Code that restores the state of the model on the RTL core when placed at
+  // stub_addr and jumped to: it writes the replay words to the devices, then
+  // restores the trap CSRs and the registers and jumps to pc(), enabling the
+  // interrupts last. Returns false if the stub would not fit in 2 KB or pc() is
+  // out of reach of a jal.
+  bool resumeStub(uint32_t stub_addr, const std::map<uint32_t, uint32_t>& replay, std::vector<uint32_t>& words) const;
+  // Size in bytes of the resume stub replaying nreplay device words
+  uint32_t resumeStubSize(size_t nreplay) const;
+
+  // Code jumping to target from anywhere, clobbering t0 (lui, jalr)
+  static void farJump(uint32_t target, std::vector<uint32_t>& words);
+
+ private:
+  bool step();
+  static uint32_t expandCompressed(uint16_t instr);
+  bool execCsr(uint32_t instr, uint32_t& rd_value);
+  void writeCsr(uint32_t addr, uint32_t value);
+  void trap(uint32_t cause, uint32_t tval, uint32_t& next_pc);
+  bool load(uint32_t addr, unsigned int size, uint32_t& value);
+  bool store(uint32_t addr, unsigned int size, uint32_t value);
+  bool fetch(uint32_t addr, uint16_t& half);
+  void setReg(unsigned int r, uint32_t value) { if(r != 0) x_[r] = value; }
+  bool fail(const std::string& reason);
+
+  std::vector<uint8_t>& mem_;
+  tb_iss_map_t map_;
+  uint32_t x_[32];
+  uint32_t pc_;
+  std::map<uint32_t, uint32_t> csrs_;
+  uint64_t instret_;
+  bool exited_;
+  uint32_t exit_value_;
+  std::string error_;
+  std::string uart_line_;
+  std::vector<bool> written_;
+  std::map<uint32_t, uint32_t> devices_;
+  std::map<uint32_t, uint32_t> device_writes_;
+  // Consecutive reads of the same device word, to detect the polling loops
+  uint32_t poll_addr_;
+  uint64_t poll_count_;
+};
+
+#endif  // TB_ISS_H_
@@ -0,0 +1,145 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_profiler.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+// Deeper stacks are most likely a missed return, stop tracking them
+#define TB_PROFILER_MAX_DEPTH 256
+
+bool TbProfiler::open(const std::string& elf_file, unsigned int interval)
+{
+  if(!TbElf::isElf(elf_file)) {
+    std::cout<<"[TESTBENCH]: ERROR: Profiling needs the ELF of the firmware, "<<elf_file<<" is not an ELF file"<<std::endl;
+    return false;
+  }
+  if(!elf_.open(elf_file))
+    return false;
+  if(elf_.symbols().empty()) {
+    std::cout<<"[TESTBENCH]: ERROR: "<<elf_file<<" has no function symbols"<<std::endl;
+    return false;
+  }
+  interval_  = interval ? interval : 1;
+  countdown_ = interval_;
+  return true;
+}
+
+// Returns the length of the call instruction at pc (jal/jalr writing ra or t0,
+// also compressed), 0 if it is not a call
+static unsigned int callLength(const TbElf& elf, uint32_t pc)
+{
+  uint16_t lo, hi;
+  if(!elf.readHalf(pc, lo))
+    return 0;
+  if((lo & 0x3) == 0x3) {
+    if(!elf.readHalf(pc + 2, hi))
+      return 0;
+    uint32_t instr = lo | ((uint32_t)hi << 16);
+    uint32_t opcode = instr & 0x7f;
+    uint32_t rd = (instr >> 7) & 0x1f;
+    return ((opcode == 0x6f || opcode == 0x67) && (rd == 1 || rd == 5)) ? 4 : 0;
+  }
+  // c.jal (RV32 only)
+  if((lo & 0x3) == 0x1 && (lo >> 13) == 0x1)
+    return 2;
+  // c.jalr
+  if((lo & 0x3) == 0x2 && (lo >> 12) == 0x9 && ((lo >> 7) & 0x1f) != 0 && ((lo >> 2) & 0x1f) == 0)
+    return 2;
+  return 0;
+}
+
+void TbProfiler::step(uint32_t prev_pc, uint32_t pc)
+{
+  // Returning to one of the pending return addresses unwinds up to it, which
+  // also covers tail calls and exceptions skipping frames
+  for(size_t i = stack_.size(); i > 0; i--) {
+    if(stack_[i - 1].return_addr == pc) {
+      stack_.resize(i - 1);
+      return;
+    }
+  }
+
+  // Calls jump to the entry of a function; this also filters the
+  // instructions fetched after a taken branch and then flushed
+  unsigned int len = callLength(elf_, prev_pc);
+  if(len == 0 || pc == prev_pc + len || stack_.size() >= TB_PROFILER_MAX_DEPTH)
+    return;
+  const tb_elf_symbol_t *func = elf_.symbolize(pc);
+  if(func == NULL || func->addr != pc)
+    return;
+  tb_profiler_frame_t frame = {prev_pc + len, func};
+  stack_.push_back(frame);
+}
+
+std::string TbProfiler::funcName(const tb_elf_symbol_t *func) const
+{
+  return func ? func->name : "[unknown]";
+}
+
+void TbProfiler::sample(uint32_t pc)
+{
+  std::string leaf = funcName(elf_.symbolize(pc));
+  std::string folded;
+  std::set<std::string> seen;
+
+  for(size_t i = 0; i < stack_.size(); i++) {
+    folded += (i ? ";" : "") + stack_[i].func->name;
+    seen.insert(stack_[i].func->name);
+  }
+  // The leaf is the top of the stack unless the PC left the called function
+  // with a plain jump (tail call or startup code)
+  if(stack_.empty() || stack_.back().func->name != leaf)
+    folded += (stack_.empty() ? "" : ";") + leaf;
+  seen.insert(leaf);
+
+  samples_++;
+  self_[leaf]++;
+  folded_[folded]++;
+  for(std::set<std::string>::const_iterator it = seen.begin(); it != seen.end(); ++it)
+    total_[*it]++;
+}
+
+static bool countGreater(const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b)
+{
+  return a.second > b.second;
+}
+
+void TbProfiler::report(const std::string& prefix, unsigned int top) const
+{
+  std::vector<std::pair<std::string, uint64_t> > flat(self_.begin(), self_.end());
+  std::stable_sort(flat.begin(), flat.end(), countGreater);
+
+  std::string flat_file = prefix + ".txt";
+  std::string folded_file = prefix + ".folded";
+  FILE *out = fopen(flat_file.c_str(), "w");
+  if(out == NULL) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot write the profile "<<flat_file<<std::endl;
+    return;
+  }
+  fprintf(out, "# %llu samples, one every %u cycles\n", (unsigned long long)samples_, interval_);
+  fprintf(out, "#   self%%   total%%      self     total  function\n");
+  for(size_t i = 0; i < flat.size(); i++) {
+    uint64_t total = total_.find(flat[i].first)->second;
+    fprintf(out, "%8.2f %8.2f %9llu %9llu  %s\n", 100.0 * flat[i].second / samples_, 100.0 * total / samples_,
+            (unsigned long long)flat[i].second, (unsigned long long)total, flat[i].first.c_str());
+  }
+  fclose(out);
+
+  std::ofstream folded(folded_file.c_str());
+  for(std::map<std::string, uint64_t>::const_iterator it = folded_.begin(); it != folded_.end(); ++it)
+    folded<<it->first<<" "<<it->second<<"\n";
+  folded.close();
+
+  std::cout<<"[TESTBENCH]: Profile of "<<samples_<<" samples written to "<<flat_file<<" and "<<folded_file<<std::endl;
+  for(size_t i = 0; i < flat.size() && i < top; i++) {
+    char line[64];
+    snprintf(line, sizeof(line), "%6.2f%%", 100.0 * flat[i].second / samples_);
+    std::cout<<"[TESTBENCH]:   "<<line<<"  "<<flat[i].first<<std::endl;
+  }
+}
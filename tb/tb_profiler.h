@@ -0,0 +1,67 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// PC-sampling profiler of the Verilator testbench. The testbench gives the PC
+// of the retiring instruction every cycle, the profiler keeps a shadow call
+// stack from the calls and returns seen in the PC flow, samples it every N
+// cycles and symbolizes the samples against the firmware ELF.
+
+#ifndef TB_PROFILER_H_
+#define TB_PROFILER_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tb_elf.h"
+
+typedef struct tb_profiler_frame {
+  uint32_t               return_addr;
+  const tb_elf_symbol_t *func;
+} tb_profiler_frame_t;
+
+class TbProfiler {
+ public:
+  TbProfiler() : interval_(100), countdown_(100), last_pc_(0), last_pc_valid_(false), samples_(0) {}
+
+  // Loads the symbols of elf_file, returns false on error
+  bool open(const std::string& elf_file, unsigned int interval);
+
+  // Called once per clock cycle with the PC of the retiring instruction
+  void cycle(uint32_t pc)
+  {
+    if(!last_pc_valid_ || pc != last_pc_) {
+      if(last_pc_valid_) step(last_pc_, pc);
+      last_pc_       = pc;
+      last_pc_valid_ = true;
+    }
+    if(--countdown_ == 0) {
+      countdown_ = interval_;
+      sample(pc);
+    }
+  }
+
+  // Writes the flat profile to <prefix>.txt and the folded stacks (input of
+  // flamegraph.pl or speedscope) to <prefix>.folded, prints the hot spots
+  void report(const std::string& prefix, unsigned int top) const;
+
+ private:
+  void step(uint32_t prev_pc, uint32_t pc);
+  void sample(uint32_t pc);
+  std::string funcName(const tb_elf_symbol_t *func) const;
+
+  TbElf elf_;
+  unsigned int interval_;
+  unsigned int countdown_;
+  uint32_t last_pc_;
+  bool last_pc_valid_;
+  uint64_t samples_;
+  std::vector<tb_profiler_frame_t> stack_;
+  std::map<std::string, uint64_t> self_;
+  std::map<std::string, uint64_t> total_;
+  std::map<std::string, uint64_t> folded_;
+};
+
+#endif  // TB_PROFILER_H_
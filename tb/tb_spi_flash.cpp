@@ -0,0 +1,325 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+#include "tb_spi_flash.h"
+
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+#include "tb_elf.h"
+
+// 16 MB (128 Mb) flash, addressed with 24 bits
+#define TB_SPI_FLASH_SIZE      (16 * 1024 * 1024)
+#define TB_SPI_FLASH_ADDR_MASK (TB_SPI_FLASH_SIZE - 1)
+#define TB_SPI_FLASH_PAGE_SIZE 256
+
+// Dummy cycles of the fast reads, as in spiflash.v (DUMMY_CLOCKS_SIM in w25q128jw.h)
+#define TB_SPI_FLASH_LATENCY   8
+
+// Status register bits
+#define TB_SPI_FLASH_SR1_WEL   0x02
+#define TB_SPI_FLASH_SR2_QE    0x02
+
+TbSpiFlash& tbSpiFlash()
+{
+  static TbSpiFlash flash;
+  return flash;
+}
+
+TbSpiFlash::TbSpiFlash()
+  : mem_(TB_SPI_FLASH_SIZE, 0xff), powered_up_(true), write_enable_(false),
+    csb_q_(true), sck_q_(false), mode_(IO_SPI), buffer_(0), bitcount_(0), bytecount_(0), dummycount_(0),
+    cmd_(0), xip_cmd_(0), addr_(0), erase_size_(0), clear_wel_(false), out_(0), oe_(0)
+{
+  status_[0] = 0;
+  status_[1] = TB_SPI_FLASH_SR2_QE;
+  status_[2] = 0;
+}
+
+bool TbSpiFlash::loadHex(const std::string& file)
+{
+  std::ifstream in(file.c_str());
+  if(!in) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot open flash image "<<file<<std::endl;
+    return false;
+  }
+  std::string token;
+  uint32_t addr = 0;
+  while(in >> token) {
+    if(token[0] == '@') {
+      addr = std::stoul(token.substr(1), nullptr, 16);
+    } else {
+      mem_[addr & TB_SPI_FLASH_ADDR_MASK] = std::stoul(token, nullptr, 16);
+      addr++;
+    }
+  }
+  return true;
+}
+
+bool TbSpiFlash::load(const std::string& file)
+{
+  if(TbElf::isElf(file)) {
+    TbElf elf;
+    if(!elf.open(file))
+      return false;
+    // The flash is mapped at FLASH_MEM_START_ADDRESS, only the offset reaches the flash
+    for(size_t s = 0; s < elf.segments().size(); s++) {
+      const tb_elf_segment_t& seg = elf.segments()[s];
+      for(size_t i = 0; i < seg.data.size(); i++)
+        mem_[(seg.addr + i) & TB_SPI_FLASH_ADDR_MASK] = seg.data[i];
+    }
+  } else if(file.size() > 4 && file.compare(file.size() - 4, 4, ".bin") == 0) {
+    std::ifstream in(file.c_str(), std::ios::binary);
+    if(!in) {
+      std::cout<<"[TESTBENCH]: ERROR: Cannot open flash image "<<file<<std::endl;
+      return false;
+    }
+    std::vector<uint8_t> img((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if(img.size() > mem_.size()) {
+      std::cout<<"[TESTBENCH]: ERROR: "<<file<<" does not fit in the flash"<<std::endl;
+      return false;
+    }
+    memcpy(&mem_[0], &img[0], img.size());
+  } else if(!loadHex(file)) {
+    return false;
+  }
+  std::cout<<"[TESTBENCH]: Flash loaded with "<<file<<std::endl;
+  return true;
+}
+
+void TbSpiFlash::edge(bool csb, bool sck, uint8_t sd_i, uint8_t& sd_o, uint8_t& sd_oe)
+{
+  if(csb && !csb_q_)
+    endTransaction();
+  else if(!csb && csb_q_)
+    startTransaction();
+
+  if(!csb) {
+    if(sck && !sck_q_)
+      sample(sd_i);
+    else if(!sck && (sck_q_ || csb_q_))
+      drive();
+  }
+
+  csb_q_ = csb;
+  sck_q_ = sck;
+  sd_o   = out_;
+  sd_oe  = oe_;
+}
+
+void TbSpiFlash::startTransaction()
+{
+  buffer_     = 0;
+  bitcount_   = 0;
+  bytecount_  = 0;
+  dummycount_ = 0;
+  mode_       = IO_SPI;
+  // In continuous read mode the command byte is skipped
+  if(xip_cmd_) {
+    buffer_    = xip_cmd_;
+    bytecount_ = 1;
+    byteDone();
+  }
+}
+
+void TbSpiFlash::endTransaction()
+{
+  if(erase_size_ != 0) {
+    uint32_t base = addr_ & ~(erase_size_ - 1) & TB_SPI_FLASH_ADDR_MASK;
+    memset(&mem_[base], 0xff, erase_size_);
+    erase_size_ = 0;
+  }
+  if(clear_wel_) {
+    write_enable_ = false;
+    clear_wel_    = false;
+  }
+  mode_ = IO_SPI;
+  oe_   = 0;
+}
+
+void TbSpiFlash::sample(uint8_t sd_i)
+{
+  if(dummycount_ > 0) {
+    dummycount_--;
+    return;
+  }
+  switch(mode_) {
+    case IO_SPI:
+      buffer_ = (buffer_ << 1) | (sd_i & 0x1);
+      bitcount_ += 1;
+      break;
+    case IO_DUAL_IN:
+    case IO_DUAL_OUT:
+      buffer_ = (buffer_ << 2) | (sd_i & 0x3);
+      bitcount_ += 2;
+      break;
+    case IO_QUAD_IN:
+    case IO_QUAD_OUT:
+      buffer_ = (buffer_ << 4) | (sd_i & 0xf);
+      bitcount_ += 4;
+      break;
+  }
+  if(bitcount_ == 8) {
+    bitcount_ = 0;
+    bytecount_++;
+    byteDone();
+  }
+}
+
+void TbSpiFlash::drive()
+{
+  oe_ = 0;
+  if(dummycount_ > 0)
+    return;
+  switch(mode_) {
+    case IO_SPI:
+      // MISO is always driven in standard mode
+      oe_  = 0x2;
+      out_ = (buffer_ >> 6) & 0x2;
+      break;
+    case IO_DUAL_OUT:
+      oe_  = 0x3;
+      out_ = buffer_ >> 6;
+      break;
+    case IO_QUAD_OUT:
+      oe_  = 0xf;
+      out_ = buffer_ >> 4;
+      break;
+    default:
+      break;
+  }
+}
+
+// Called when a full byte has been received in buffer_, which is then
+// replaced by the next byte to send
+void TbSpiFlash::byteDone()
+{
+  uint8_t in = buffer_;
+
+  if(bytecount_ == 1) {
+    cmd_ = in;
+    switch(cmd_) {
+      case 0xab: powered_up_ = true; break;           // release power-down
+      case 0xb9: powered_up_ = false; break;          // power-down
+      case 0xff: xip_cmd_ = 0; break;                 // exit continuous read mode
+      case 0x06: write_enable_ = true; break;         // write enable
+      case 0x04: write_enable_ = false; break;        // write disable
+      case 0xbb: mode_ = IO_DUAL_IN; break;           // fast read dual I/O
+      case 0xeb: mode_ = IO_QUAD_IN; break;           // fast read quad I/O
+      default: break;
+    }
+  }
+
+  // The address is sent MSB first in bytes 2 to 4
+  if(bytecount_ >= 2 && bytecount_ <= 4)
+    addr_ = ((addr_ << 8) | in) & TB_SPI_FLASH_ADDR_MASK;
+
+  if(!powered_up_ && cmd_ != 0xab)
+    return;
+
+  status_[0] = write_enable_ ? (status_[0] | TB_SPI_FLASH_SR1_WEL) : (status_[0] & ~TB_SPI_FLASH_SR1_WEL);
+
+  switch(cmd_) {
+    case 0x03:  // read
+    case 0x0b:  // fast read
+    case 0x3b:  // fast read dual output
+    case 0x6b:  // fast read quad output
+      if(bytecount_ == 4 && cmd_ != 0x03) {
+        dummycount_ = TB_SPI_FLASH_LATENCY;
+        mode_ = cmd_ == 0x3b ? IO_DUAL_OUT : cmd_ == 0x6b ? IO_QUAD_OUT : IO_SPI;
+      }
+      if(bytecount_ >= 4)
+        buffer_ = mem_[addr_++ & TB_SPI_FLASH_ADDR_MASK];
+      break;
+
+    case 0xbb:  // fast read dual I/O
+    case 0xeb:  // fast read quad I/O
+      // Byte 5 holds the mode bits, M5-4 = 10 enables the continuous read mode
+      if(bytecount_ == 5) {
+        xip_cmd_    = ((in & 0x30) == 0x20) ? cmd_ : 0;
+        mode_       = cmd_ == 0xbb ? IO_DUAL_OUT : IO_QUAD_OUT;
+        dummycount_ = TB_SPI_FLASH_LATENCY;
+      }
+      if(bytecount_ >= 5)
+        buffer_ = mem_[addr_++ & TB_SPI_FLASH_ADDR_MASK];
+      break;
+
+    case 0x02:  // page program
+    case 0x32:  // quad input page program
+      if(!write_enable_)
+        break;
+      clear_wel_ = true;
+      if(bytecount_ == 4 && cmd_ == 0x32)
+        mode_ = IO_QUAD_IN;
+      if(bytecount_ >= 5) {
+        // Programming only clears bits and wraps around in the page
+        mem_[addr_] &= in;
+        addr_ = (addr_ & ~(TB_SPI_FLASH_PAGE_SIZE - 1)) | ((addr_ + 1) & (TB_SPI_FLASH_PAGE_SIZE - 1));
+      }
+      break;
+
+    case 0x20:  // sector erase 4 KB
+    case 0x52:  // block erase 32 KB
+    case 0xd8:  // block erase 64 KB
+      if(write_enable_ && bytecount_ == 4) {
+        erase_size_ = cmd_ == 0x20 ? 4 * 1024 : cmd_ == 0x52 ? 32 * 1024 : 64 * 1024;
+        clear_wel_  = true;
+      }
+      break;
+
+    case 0xc7:  // chip erase
+    case 0x60:
+      if(write_enable_ && bytecount_ == 1) {
+        addr_       = 0;
+        erase_size_ = TB_SPI_FLASH_SIZE;
+        clear_wel_  = true;
+      }
+      break;
+
+    case 0x05:  // read status register 1
+    case 0x35:  // read status register 2
+    case 0x15:  // read status register 3
+      buffer_ = status_[cmd_ == 0x05 ? 0 : cmd_ == 0x35 ? 1 : 2];
+      break;
+
+    case 0x01:  // write status register 1
+    case 0x31:  // write status register 2
+    case 0x11:  // write status register 3
+      if(bytecount_ == 2) {
+        status_[cmd_ == 0x01 ? 0 : cmd_ == 0x31 ? 1 : 2] = in & ~TB_SPI_FLASH_SR1_WEL;
+        clear_wel_ = true;
+      }
+      break;
+
+    case 0x9f:  // JEDEC ID of the W25Q128JW
+      if(bytecount_ <= 3)
+        buffer_ = bytecount_ == 1 ? 0xef : bytecount_ == 2 ? 0x60 : 0x18;
+      break;
+
+    case 0x90:  // manufacturer and device ID, after 3 address bytes
+      if(bytecount_ >= 4)
+        buffer_ = (bytecount_ & 1) ? 0x17 : 0xef;
+      break;
+
+    case 0xab:  // device ID, after 3 dummy bytes
+      if(bytecount_ >= 4)
+        buffer_ = 0x17;
+      break;
+
+    default:
+      break;
+  }
+}
+
+// DPI import of tb/spi_flash_dpi.sv
+extern "C" void spi_flash_dpi_edge(int csb, int clk, int sd_i, int *sd_o, int *sd_oe)
+{
+  uint8_t out, oe;
+  tbSpiFlash().edge(csb != 0, clk != 0, sd_i, out, oe);
+  *sd_o  = out;
+  *sd_oe = oe;
+}
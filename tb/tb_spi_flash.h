@@ -0,0 +1,65 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// C++ model of the boot SPI flash for the Verilator testbench, connected to
+// the spi_flash pins of the testharness by tb/spi_flash_dpi.sv. It follows the
+// timing of the picosoc spiflash.v model used with the other simulators
+// (input sampled on the rising edge of SCK, output changed on the falling
+// edge, 8 dummy cycles for the fast reads) and implements the subset of the
+// W25Q128JW commands used by the boot ROM, spimemio and sw/device/bsp/w25q.
+
+#ifndef TB_SPI_FLASH_H_
+#define TB_SPI_FLASH_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class TbSpiFlash {
+ public:
+  TbSpiFlash();
+
+  // Preloads the flash: ELF segments at the lower 24 bits of their load
+  // address, raw binaries (.bin) and Verilog hex files from offset 0
+  bool load(const std::string& file);
+
+  // Called on every edge of csb and sck with the value of the 4 data lines,
+  // returns the lines driven by the flash in sd_o/sd_oe
+  void edge(bool csb, bool sck, uint8_t sd_i, uint8_t& sd_o, uint8_t& sd_oe);
+
+ private:
+  enum io_mode_t { IO_SPI, IO_DUAL_IN, IO_DUAL_OUT, IO_QUAD_IN, IO_QUAD_OUT };
+
+  void startTransaction();
+  void endTransaction();
+  void sample(uint8_t sd_i);
+  void drive();
+  void byteDone();
+  bool loadHex(const std::string& file);
+
+  std::vector<uint8_t> mem_;
+  bool powered_up_;
+  bool write_enable_;
+  uint8_t status_[3];
+
+  // Transaction state
+  bool csb_q_, sck_q_;
+  io_mode_t mode_;
+  uint8_t buffer_;
+  unsigned int bitcount_;
+  unsigned int bytecount_;
+  unsigned int dummycount_;
+  uint8_t cmd_;
+  uint8_t xip_cmd_;  // command repeated in continuous read mode
+  uint32_t addr_;
+  uint32_t erase_size_;  // erase done when the transaction ends, 0 if none
+  bool clear_wel_;       // write enable cleared when the transaction ends
+  uint8_t out_;          // lines driven by the flash
+  uint8_t oe_;
+};
+
+// Instance used by the DPI functions of tb/spi_flash_dpi.sv
+TbSpiFlash& tbSpiFlash();
+
+#endif  // TB_SPI_FLASH_H_
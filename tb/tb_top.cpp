@@ -4,15 +4,81 @@
 
 #include "verilated.h"
 #include "verilated_fst_c.h"
+#ifdef TB_SAVABLE
+#include "verilated_save.h"
+#endif
 #include "Vtestharness.h"
 #include "Vtestharness__Syms.h"
+#include "Vtestharness__Dpi.h"
 
+#include "tb_elf.h"
+#include "tb_energy.h"
+#include "tb_exec_trace.h"
+#include "tb_iss.h"
+#include "tb_profiler.h"
+#include "tb_spi_flash.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 
 vluint64_t sim_time = 0;
 
+// Waveform tracing modes selected with +trace=<mode>
+enum trace_mode_t {
+  TRACE_OFF,    // no waveform is dumped (default)
+  TRACE_FULL,   // the whole simulation is dumped
+  TRACE_WINDOW, // cycles in [+trace_start, +trace_end) are dumped
+  TRACE_PC,     // dumping starts when the core fetches +trace_pc
+  TRACE_EXIT,   // dumping starts when the firmware writes +trace_exit_value to EXIT_VALUE
+  TRACE_FLIGHT  // the last +trace_last cycles are kept, and only written out when the run fails
+};
+
+// The flight recorder dumps in segments of +trace_last cycles, the current
+// one and the previous one: the last +trace_last to 2 * +trace_last cycles
+#define TRACE_FILE      "waveform.vcd"
+#define TRACE_FILE_PREV "waveform_prev.vcd"
+
+
+typedef struct trace_ctrl {
+  trace_mode_t mode;
+  vluint64_t   start_cycle;
+  vluint64_t   end_cycle;
+  unsigned int trigger_pc;
+  unsigned int trigger_exit_value;
+  bool         triggered;
+  vluint64_t   segment_cycles;
+} trace_ctrl_t;
+
+trace_ctrl_t trace_ctrl = {TRACE_OFF, 0, 0, 0, 0, false, 0};
+
+// Checkpoint requested with +save_checkpoint=<file>@<cycle>, saved when sim_time reaches save_time
+std::string checkpoint_file;
+vluint64_t checkpoint_save_time = 0;
+bool checkpoint_pending = false;
+
+// PC-sampling profiler, enabled with +profile=<elf>
+TbProfiler *profiler = NULL;
+
+// Switch-over from the fast-forward, pending until the core reaches ff_pc.
+// The words overwritten by the resume stub are then put back.
+bool ff_pending = false;
+uint32_t ff_pc = 0;
+std::vector<std::pair<int, uint32_t> > ff_restore;
+
 
 std::string getCmdOption(int argc, char* argv[], const std::string& option)
 {
@@ -30,34 +96,687 @@ std::string getCmdOption(int argc, char* argv[], const std::string& option)
      return cmd;
 }
 
+vluint64_t getNumOption(int argc, char* argv[], const std::string& option, vluint64_t default_val)
+{
+  std::string arg = getCmdOption(argc, argv, option);
+  if(arg.empty())
+    return default_val;
+  // base 0 accepts both decimal and 0x-prefixed hexadecimal values
+  return std::stoull(arg, nullptr, 0);
+}
+
+// Returns true when the current half-cycle has to be dumped
+bool traceEnabled(Vtestharness *dut){
+  vluint64_t cycle = sim_time >> 1;
+
+  switch(trace_ctrl.mode) {
+    case TRACE_OFF:
+      return false;
+    case TRACE_FULL:
+    case TRACE_FLIGHT:
+      return true;
+    case TRACE_WINDOW:
+      return cycle >= trace_ctrl.start_cycle && cycle < trace_ctrl.end_cycle;
+    case TRACE_PC:
+      if(!trace_ctrl.triggered && (unsigned int)tb_get_fetch_addr() == trace_ctrl.trigger_pc) {
+        std::cout<<"[TESTBENCH]: Trace triggered by PC 0x"<<std::hex<<trace_ctrl.trigger_pc<<std::dec<<" at cycle "<<cycle<<std::endl;
+        trace_ctrl.triggered  = true;
+        trace_ctrl.end_cycle += cycle;
+      }
+      return trace_ctrl.triggered && cycle < trace_ctrl.end_cycle;
+    case TRACE_EXIT:
+      if(!trace_ctrl.triggered && dut->exit_value_o == trace_ctrl.trigger_exit_value) {
+        std::cout<<"[TESTBENCH]: Trace triggered by exit value "<<trace_ctrl.trigger_exit_value<<" at cycle "<<cycle<<std::endl;
+        trace_ctrl.triggered  = true;
+        trace_ctrl.end_cycle += cycle;
+      }
+      return trace_ctrl.triggered && cycle < trace_ctrl.end_cycle;
+  }
+  return false;
+}
+
+// Closes the segment of the flight recorder and starts the next one once
+// end_cycle is reached. The segments are short, so closing the current one
+// before the previous is overwritten bounds the disk usage to two of them.
+void rotateFlightTrace(VerilatedFstC *m_trace){
+  vluint64_t cycle = sim_time >> 1;
+  if(cycle < trace_ctrl.end_cycle)
+    return;
+  m_trace->close();
+  if(rename(TRACE_FILE, TRACE_FILE_PREV) != 0)
+    perror("[TESTBENCH]: flight recorder");
+  m_trace->open(TRACE_FILE);
+  trace_ctrl.end_cycle = cycle + trace_ctrl.segment_cycles;
+}
+
+inline void dumpTrace(Vtestharness *dut, VerilatedFstC *m_trace){
+  if(m_trace == NULL || !traceEnabled(dut))
+    return;
+  if(trace_ctrl.mode == TRACE_FLIGHT) rotateFlightTrace(m_trace);
+  m_trace->dump(sim_time);
+}
+
+#ifdef TB_SAVABLE
+void saveCheckpoint(Vtestharness *dut){
+  VerilatedSave os;
+  os.open(checkpoint_file.c_str());
+  os << sim_time;
+  os << trace_ctrl.triggered;
+  os << trace_ctrl.end_cycle;
+  os << *dut;
+  os.close();
+  std::cout<<"[TESTBENCH]: Checkpoint saved in "<<checkpoint_file<<" at cycle "<<(sim_time >> 1)<<std::endl;
+}
+
+void restoreCheckpoint(Vtestharness *dut, const std::string& file){
+  VerilatedRestore os;
+  os.open(file.c_str());
+  os >> sim_time;
+  os >> trace_ctrl.triggered;
+  os >> trace_ctrl.end_cycle;
+  os >> *dut;
+  os.close();
+  std::cout<<"[TESTBENCH]: Checkpoint "<<file<<" restored at cycle "<<(sim_time >> 1)<<std::endl;
+}
+#endif
+
+void writeSram(int addr, uint32_t word);
+
+// Called before every half cycle while the switch-over is pending
+void checkFastForward(){
+  if((uint32_t)tb_get_retire_pc() != ff_pc)
+    return;
+  for(size_t w = 0; w < ff_restore.size(); w++)
+    writeSram(ff_restore[w].first, ff_restore[w].second);
+  ff_pending = false;
+  std::cout<<"[TESTBENCH]: Switched over to the RTL at pc 0x"<<std::hex<<ff_pc<<std::dec<<" at cycle "<<(sim_time >> 1)<<std::endl;
+}
+
+// Called before every half cycle when a checkpoint is pending
+inline void checkCheckpoint(Vtestharness *dut){
+#ifdef TB_SAVABLE
+  if(sim_time == checkpoint_save_time) {
+    saveCheckpoint(dut);
+    checkpoint_pending = false;
+  }
+#endif
+}
+
+// Every half cycle needs its own eval() as the design has negedge-triggered
+// logic (e.g. uartdpi, power switch models). Without tracing and profiling
+// the loop only toggles the clock and evaluates.
 void runCycles(unsigned int ncycles, Vtestharness *dut, VerilatedFstC *m_trace){
+  if(m_trace == NULL && profiler == NULL) {
+    for(unsigned int i = 0; i < ncycles; i++) {
+      if(checkpoint_pending) checkCheckpoint(dut);
+      if(ff_pending) checkFastForward();
+      dut->clk_i ^= 1;
+      dut->eval();
+      sim_time++;
+    }
+    return;
+  }
   for(unsigned int i = 0; i < ncycles; i++) {
+    if(checkpoint_pending) checkCheckpoint(dut);
+    if(ff_pending) checkFastForward();
     dut->clk_i ^= 1;
     dut->eval();
-    m_trace->dump(sim_time);
+    dumpTrace(dut, m_trace);
+    if(profiler != NULL && dut->clk_i) profiler->cycle(tb_get_retire_pc());
     sim_time++;
   }
 }
 
+// Firmware loading
+// ----------------
+// ELF files and raw binaries (.bin, loaded at address 0) are written directly
+// into the SRAM banks, skipping $readmemh and the words that are not populated.
+// Any other file is considered a Verilog hex file and loaded with tb_loadHEX.
+bool isImageFile(const std::string& firmware){
+  return TbElf::isElf(firmware) || (firmware.size() > 4 && firmware.compare(firmware.size() - 4, 4, ".bin") == 0);
+}
+
+// Reads an ELF file or a raw binary into an image of the whole SRAM
+bool readFirmwareImage(const std::string& firmware, std::vector<uint8_t>& image, std::vector<bool>& populated){
+  int mem_size, num_banks_cont, num_banks_il, cont_size;
+  tb_getMemBanks(&mem_size, &num_banks_cont, &num_banks_il, &cont_size);
+  image.assign(mem_size, 0);
+  populated.assign(mem_size / 4, false);
+
+  if(TbElf::isElf(firmware)) {
+    TbElf elf;
+    if(!elf.open(firmware))
+      return false;
+    for(size_t s = 0; s < elf.segments().size(); s++) {
+      const tb_elf_segment_t& seg = elf.segments()[s];
+      if((uint64_t)seg.addr + seg.data.size() > (uint64_t)mem_size) {
+        std::cout<<"[TESTBENCH]: WARNING: Skipping segment at 0x"<<std::hex<<seg.addr<<std::dec<<" outside of the SRAM"<<std::endl;
+        continue;
+      }
+      for(size_t b = 0; b < seg.data.size(); b++) {
+        image[seg.addr + b] = seg.data[b];
+        populated[(seg.addr + b) >> 2] = true;
+      }
+    }
+  } else {
+    std::ifstream in(firmware.c_str(), std::ios::binary);
+    std::vector<uint8_t> bin((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if(bin.size() > (size_t)mem_size) {
+      std::cout<<"[TESTBENCH]: ERROR: "<<firmware<<" does not fit in the SRAM"<<std::endl;
+      return false;
+    }
+    for(size_t b = 0; b < bin.size(); b++) {
+      image[b] = bin[b];
+      populated[b >> 2] = true;
+    }
+  }
+  return true;
+}
+
+// Writes the word at the byte address addr of the SRAM. Contiguous banks are
+// filled one after the other, interleaved banks (placed after the contiguous
+// ones) get consecutive words.
+void writeSram(int addr, uint32_t word){
+  static std::vector<int> bank_start;
+  static int num_banks_cont, num_banks_il, cont_size;
+  if(bank_start.empty()) {
+    // The contiguous banks may have different sizes
+    int mem_size;
+    tb_getMemBanks(&mem_size, &num_banks_cont, &num_banks_il, &cont_size);
+    bank_start.resize(num_banks_cont + 1);
+    for(int b = 0; b < num_banks_cont; b++)
+      bank_start[b] = tb_getMemBankStart(b);
+    bank_start[num_banks_cont] = cont_size;
+  }
+
+  if(addr < cont_size) {
+    int bank = 0;
+    while(addr >= bank_start[bank + 1])
+      bank++;
+    tb_writeSramWord(bank, (addr - bank_start[bank]) >> 2, word);
+  } else {
+    int il_word = (addr - cont_size) >> 2;
+    tb_writeSramWord(num_banks_cont + il_word % num_banks_il, il_word / num_banks_il, word);
+  }
+}
+
+uint32_t imageWord(const std::vector<uint8_t>& image, int addr){
+  return image[addr] | (image[addr+1] << 8) | (image[addr+2] << 16) | ((uint32_t)image[addr+3] << 24);
+}
+
+bool loadFirmware(Vtestharness *dut, const std::string& firmware){
+  if(!isImageFile(firmware)) {
+    dut->tb_loadHEX(firmware.c_str());
+    return true;
+  }
+
+  std::vector<uint8_t> image;
+  std::vector<bool> populated;
+  if(!readFirmwareImage(firmware, image, populated))
+    return false;
+  for(size_t w = 0; w < populated.size(); w++)
+    if(populated[w]) writeSram(w << 2, imageWord(image, w << 2));
+  return true;
+}
+
+// Fast-forward
+// ------------
+// +fast_forward=<pc|function> and/or +fast_forward_instr=<n> run the firmware
+// in the instruction-set model of tb/tb_iss.h instead of the RTL, until the
+// next instruction is at the marker or n instructions retired. The SRAM
+// written by the model is then loaded in the RTL with a resume stub, placed
+// below the stack pointer of the firmware. The boot ROM jumps to the stub,
+// which writes the last value of the device words selected with
+// +fast_forward_replay=<base>:<size>[,<base>:<size>...] (e.g. the setup of a
+// timer), restores the trap CSRs and the registers and jumps to the marker.
+// The words of the stub and of the jump to it are restored when the core
+// reaches the marker, from where the simulation is cycle-accurate.
+#define TB_FF_STUB_GAP 256
+
+bool parseReplayRanges(const std::string& arg, std::vector<std::pair<uint32_t, uint32_t> >& ranges){
+  std::istringstream fields(arg);
+  std::string range;
+  while(std::getline(fields, range, ',')) {
+    size_t colon = range.find(':');
+    if(colon == std::string::npos) {
+      std::cout<<"[TESTBENCH]: ERROR: Wrong replay range "<<range<<", expected <base>:<size>"<<std::endl;
+      return false;
+    }
+    ranges.push_back(std::make_pair((uint32_t)std::stoul(range.substr(0, colon), nullptr, 0),
+                                    (uint32_t)std::stoul(range.substr(colon + 1), nullptr, 0)));
+  }
+  return true;
+}
+
+bool fastForward(const std::string& firmware, const std::string& marker, vluint64_t max_instr, const std::string& replay_arg){
+  if(!isImageFile(firmware)) {
+    std::cout<<"[TESTBENCH]: ERROR: The fast-forward needs an ELF or .bin firmware"<<std::endl;
+    return false;
+  }
+  std::vector<uint8_t> image;
+  std::vector<bool> populated;
+  if(!readFirmwareImage(firmware, image, populated))
+    return false;
+
+  uint32_t marker_pc = ~0u;
+  if(!marker.empty()) {
+    if(isdigit((unsigned char)marker[0])) {
+      marker_pc = std::stoul(marker, nullptr, 0);
+    } else {
+      TbElf elf;
+      if(!TbElf::isElf(firmware) || !elf.open(firmware)) {
+        std::cout<<"[TESTBENCH]: ERROR: The fast-forward marker "<<marker<<" needs an ELF firmware"<<std::endl;
+        return false;
+      }
+      for(size_t f = 0; f < elf.symbols().size() && marker_pc == ~0u; f++)
+        if(elf.symbols()[f].name == marker) marker_pc = elf.symbols()[f].addr;
+      if(marker_pc == ~0u) {
+        std::cout<<"[TESTBENCH]: ERROR: No function "<<marker<<" in "<<firmware<<std::endl;
+        return false;
+      }
+    }
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t> > ranges;
+  if(!parseReplayRanges(replay_arg, ranges))
+    return false;
+
+  int exit_valid, exit_value, uart_wdata, uart_status, boot_address;
+  tb_getFastForwardMap(&exit_valid, &exit_value, &uart_wdata, &uart_status, &boot_address);
+  tb_iss_map_t map = {(uint32_t)exit_valid, (uint32_t)exit_value, (uint32_t)uart_wdata};
+  TbIss iss(image, map);
+  // The UART is always done sending
+  iss.presetDevice(uart_status, 0x3c);
+
+  std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+  tb_iss_stop_t stop = iss.run(boot_address, marker_pc, max_instr);
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  if(stop == TB_ISS_STOP_ERROR) {
+    std::cout<<"[TESTBENCH]: ERROR: Fast-forward stopped: "<<iss.error()<<std::endl;
+    return false;
+  }
+  if(stop == TB_ISS_STOP_EXIT) {
+    std::cout<<"[TESTBENCH]: ERROR: The firmware exited with value "<<iss.exitValue()<<" before the fast-forward marker"<<std::endl;
+    return false;
+  }
+  if(iss.instret() == 0) {
+    std::cout<<"[TESTBENCH]: ERROR: The fast-forward marker is the first instruction"<<std::endl;
+    return false;
+  }
+  std::cout<<"[TESTBENCH]: Fast-forwarded "<<iss.instret()<<" instructions in "<<wall_s<<" s to pc 0x"<<std::hex<<iss.pc()<<std::dec<<std::endl;
+
+  std::map<uint32_t, uint32_t> replay;
+  const std::map<uint32_t, uint32_t>& writes = iss.deviceWrites();
+  for(std::map<uint32_t, uint32_t>::const_iterator it = writes.begin(); it != writes.end(); ++it)
+    for(size_t r = 0; r < ranges.size(); r++)
+      if(it->first >= ranges[r].first && it->first - ranges[r].first < ranges[r].second) replay[it->first] = it->second;
+
+  // The stack below the stack pointer is free at any point of the firmware.
+  // The gap keeps the stub clear of the stores of the first instructions
+  // after the marker, e.g. a function prologue, which may execute before the
+  // switch-over is seen on the cores that report the PC late in the pipeline.
+  std::vector<uint32_t> stub, jump;
+  uint32_t sp = iss.reg(2);
+  uint32_t stub_size = iss.resumeStubSize(replay.size());
+  uint32_t stub_addr = (sp - TB_FF_STUB_GAP - stub_size) & ~3u;
+  if(sp > image.size() || sp < TB_FF_STUB_GAP + stub_size + (uint32_t)boot_address + 8) {
+    std::cout<<"[TESTBENCH]: ERROR: No stack at the fast-forward marker (sp = 0x"<<std::hex<<sp<<std::dec<<") for the resume stub"<<std::endl;
+    return false;
+  }
+  if(!iss.resumeStub(stub_addr, replay, stub)) {
+    std::cout<<"[TESTBENCH]: ERROR: The resume stub does not fit, replay fewer device words ("<<replay.size()<<")"<<std::endl;
+    return false;
+  }
+  TbIss::farJump(stub_addr, jump);
+
+  // Load the state of the model, then the stub and the jump to it
+  for(size_t w = 0; w < populated.size(); w++)
+    if(populated[w] || iss.written()[w]) writeSram(w << 2, imageWord(image, w << 2));
+  ff_restore.clear();
+  for(size_t w = 0; w < stub.size(); w++) {
+    ff_restore.push_back(std::make_pair(stub_addr + 4 * w, imageWord(image, stub_addr + 4 * w)));
+    writeSram(stub_addr + 4 * w, stub[w]);
+  }
+  for(size_t w = 0; w < jump.size(); w++) {
+    ff_restore.push_back(std::make_pair(boot_address + 4 * w, imageWord(image, boot_address + 4 * w)));
+    writeSram(boot_address + 4 * w, jump[w]);
+  }
+  ff_pc      = iss.pc();
+  ff_pending = true;
+  std::cout<<"[TESTBENCH]: Resume stub at 0x"<<std::hex<<stub_addr<<std::dec<<", replaying "<<replay.size()<<" device words"<<std::endl;
+  return true;
+}
+
+// Performance report
+// ------------------
+// The counters live in tb_util.svh and stop when the firmware sets exit_valid_o.
+// Names follow the master indexes of core_v_mini_mcu_pkg.
+
+const char *xbar_master_names[] = {"core_instr", "core_data", "debug_master"};
+// Each DMA channel then has a read, a write and an address master
+const char *xbar_dma_master_names[] = {"dma_read", "dma_write", "dma_addr"};
+
+std::string xbarMasterName(int master){
+  if(master < 3)
+    return xbar_master_names[master];
+  return std::string(xbar_dma_master_names[(master - 3) % 3]) + "_ch" + std::to_string((master - 3) / 3);
+}
+
+// Prints the progress of the run, every +progress seconds of wall time
+void progressReport(vluint64_t sim_cycles, double wall_s, vluint64_t last_cycles, double last_wall_s){
+  double interval_s = wall_s - last_wall_s;
+  std::cout<<"[TESTBENCH]: Progress: cycle "<<sim_cycles<<", "<<wall_s<<" s, "
+           <<(wall_s > 0 ? sim_cycles / wall_s / 1000 : 0)<<" kHz ("
+           <<(interval_s > 0 ? (sim_cycles - last_cycles) / interval_s / 1000 : 0)<<" kHz last "<<interval_s<<" s), pc 0x"
+           <<std::hex<<tb_get_retire_pc()<<std::dec<<std::endl;
+}
+
+// The cycles and wall time are those of the whole run, reset and loading
+// included, to compare the simulation speed across hosts and builds
+void perfReport(const std::string& report_file, vluint64_t sim_cycles, double wall_s){
+  long long cycles, instret, sleep_cycles, dma_busy_cycles;
+  int xbar_nmaster;
+  tb_getPerfCounters(&cycles, &instret, &sleep_cycles, &dma_busy_cycles, &xbar_nmaster);
+
+  std::cout<<"[TESTBENCH]: Performance report"<<std::endl;
+  std::cout<<"[TESTBENCH]:   cycles            "<<cycles<<std::endl;
+  std::cout<<"[TESTBENCH]:   instret           "<<instret<<std::endl;
+  if(instret > 0)
+    std::cout<<"[TESTBENCH]:   CPI               "<<(double)cycles / instret<<std::endl;
+  std::cout<<"[TESTBENCH]:   sleep (WFI)       "<<sleep_cycles<<std::endl;
+  std::cout<<"[TESTBENCH]:   DMA busy          "<<dma_busy_cycles<<std::endl;
+  for(int i = 0; i < xbar_nmaster; i++) {
+    std::string name = xbarMasterName(i);
+    std::cout<<"[TESTBENCH]:   xbar stall "<<name<<std::string(name.size() < 15 ? 15 - name.size() : 1, ' ')<<tb_getXbarStallCycles(i)<<std::endl;
+  }
+
+  if(report_file.empty())
+    return;
+  std::ofstream out(report_file.c_str());
+  if(!out) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot write performance report "<<report_file<<std::endl;
+    return;
+  }
+  out<<"{\n  \"cycles\": "<<cycles<<",\n  \"instret\": "<<instret<<",\n  \"sleep_cycles\": "<<sleep_cycles
+     <<",\n  \"dma_busy_cycles\": "<<dma_busy_cycles<<",\n  \"xbar_stall_cycles\": {";
+  for(int i = 0; i < xbar_nmaster; i++) {
+    std::string name = xbarMasterName(i);
+    out<<(i ? ", " : "")<<"\""<<name<<"\": "<<tb_getXbarStallCycles(i);
+  }
+  out<<"},\n  \"sim_cycles\": "<<sim_cycles<<",\n  \"wall_time_s\": "<<wall_s
+     <<",\n  \"sim_cycles_per_s\": "<<(wall_s > 0 ? sim_cycles / wall_s : 0)<<"\n}\n";
+  std::cout<<"[TESTBENCH]: Performance report written to "<<report_file<<std::endl;
+}
+
+// Collects the activity tallied by tb/tb_util.svh since +energy enabled it
+void energyReport(const TbEnergy& energy, const std::string& report_file){
+  tb_energy_activity_t activity;
+  int mem_size, num_banks_cont, num_banks_il, cont_size;
+  tb_getMemBanks(&mem_size, &num_banks_cont, &num_banks_il, &cont_size);
+  unsigned int num_banks = num_banks_cont + num_banks_il;
+
+  activity.ram_cycles.assign(num_banks, std::vector<uint64_t>(TB_ENERGY_NSTATES, 0));
+  activity.ram_accesses.assign(num_banks, 0);
+  for(int s = 0; s < TB_ENERGY_NSTATES; s++) {
+    activity.cpu_cycles[s]    = tb_getEnergyCycles(0, s);
+    activity.periph_cycles[s] = tb_getEnergyCycles(1, s);
+    for(unsigned int b = 0; b < num_banks; b++)
+      activity.ram_cycles[b][s] = tb_getEnergyCycles(2 + b, s);
+  }
+  for(unsigned int b = 0; b < num_banks; b++)
+    activity.ram_accesses[b] = tb_getEnergyRamAccesses(b);
+  activity.dma_beats = tb_getEnergyDmaBeats();
+
+  energy.report(activity, report_file);
+}
+
+// Batch regression
+// ----------------
+// +batch=<manifest> runs every firmware listed in the manifest with the same
+// model binary. Each manifest line is
+//   <firmware> [max_sim_time] [expected exit value]
+// ('#' starts a comment, max_sim_time 0 means run until exit, the expected
+// exit value defaults to 0). Up to +batch_jobs workers (default: number of
+// host cores) are forked, each one with its own model and its own directory
+// (batch/<index>_<firmware name>) for uart0.log and waveforms. The results
+// are written as JSON to +batch_report (default: batch_report.json).
+
+typedef struct batch_job {
+  std::string  firmware;
+  unsigned int max_sim_time;
+  unsigned int expected_exit_value;
+  std::string  dir;
+  pid_t        pid;
+  int          result_fd;
+  std::string  result;
+} batch_job_t;
+
+// Write end of the pipe towards the batch parent, -1 when not a batch worker
+int batch_result_fd = -1;
+
+// Arguments of the worker, kept alive for Verilated::commandArgs
+std::vector<std::string> batch_worker_args;
+std::vector<char *>      batch_worker_argv;
+
+std::string jsonEscape(const std::string& str){
+  std::string out;
+  for(size_t i = 0; i < str.size(); i++) {
+    if(str[i] == '"' || str[i] == '\\') out += '\\';
+    out += str[i];
+  }
+  return out;
+}
+
+bool parseBatchManifest(const std::string& manifest, std::vector<batch_job_t>& jobs){
+  std::ifstream in(manifest.c_str());
+  if(!in) {
+    std::cout<<"[TESTBENCH]: ERROR: Cannot open batch manifest "<<manifest<<std::endl;
+    return false;
+  }
+  std::string line;
+  while(std::getline(in, line)) {
+    size_t comment = line.find('#');
+    if(comment != std::string::npos)
+      line = line.substr(0, comment);
+    std::istringstream fields(line);
+    std::string firmware, max_sim_time, exit_value;
+    if(!(fields >> firmware))
+      continue;
+    fields >> max_sim_time >> exit_value;
+
+    batch_job_t job;
+    char abs_path[PATH_MAX];
+    job.firmware            = realpath(firmware.c_str(), abs_path) ? abs_path : firmware;
+    job.max_sim_time        = max_sim_time.empty() ? 0 : std::stoul(max_sim_time, nullptr, 0);
+    job.expected_exit_value = exit_value.empty() ? 0 : std::stoul(exit_value, nullptr, 0);
+    job.pid                 = -1;
+    job.result_fd           = -1;
+    std::ostringstream dir;
+    dir<<"batch/"<<jobs.size()<<"_"<<firmware.substr(firmware.find_last_of('/') + 1);
+    job.dir = dir.str();
+    jobs.push_back(job);
+  }
+  return true;
+}
+
+// Forks the batch workers. Returns only in the workers, which continue as a
+// normal single-firmware simulation with the arguments in argc/argv.
+void runBatch(int& argc, char**& argv, const std::string& manifest){
+  std::vector<batch_job_t> jobs;
+  if(!parseBatchManifest(manifest, jobs))
+    exit(EXIT_FAILURE);
+
+  unsigned int max_jobs = getNumOption(argc, argv, "+batch_jobs=", std::thread::hardware_concurrency());
+  if(max_jobs == 0) max_jobs = 1;
+  std::string report = getCmdOption(argc, argv, "+batch_report=");
+  if(report.empty()) report = "batch_report.json";
+
+  std::cout<<"[TESTBENCH]: Batch of "<<jobs.size()<<" firmware images with "<<max_jobs<<" workers"<<std::endl;
+  mkdir("batch", 0755);
+
+  std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+  size_t next = 0, running = 0;
+  while(next < jobs.size() || running > 0) {
+    if(next < jobs.size() && running < max_jobs) {
+      batch_job_t& job = jobs[next];
+      int fds[2];
+      if(pipe(fds) != 0) {
+        perror("[TESTBENCH]: pipe");
+        exit(EXIT_FAILURE);
+      }
+      mkdir(job.dir.c_str(), 0755);
+      fflush(stdout);
+      std::cout.flush();
+      pid_t pid = fork();
+      if(pid == 0) {
+        close(fds[0]);
+        if(chdir(job.dir.c_str()) != 0 || freopen("sim.log", "w", stdout) == NULL) {
+          perror("[TESTBENCH]: batch worker");
+          _exit(EXIT_FAILURE);
+        }
+        batch_result_fd = fds[1];
+        // The last occurrence of an option wins in getCmdOption
+        for(int i = 0; i < argc; i++) {
+          std::string arg = argv[i];
+          if(arg.find("+batch") != 0) batch_worker_args.push_back(arg);
+        }
+        batch_worker_args.push_back("+firmware=" + job.firmware);
+        if(job.max_sim_time != 0) {
+          std::ostringstream max_sim_time;
+          max_sim_time<<"+max_sim_time="<<job.max_sim_time;
+          batch_worker_args.push_back(max_sim_time.str());
+        }
+        for(size_t i = 0; i < batch_worker_args.size(); i++)
+          batch_worker_argv.push_back((char *)batch_worker_args[i].c_str());
+        batch_worker_argv.push_back(NULL);
+        argc = batch_worker_args.size();
+        argv = &batch_worker_argv[0];
+        return;
+      }
+      close(fds[1]);
+      job.pid       = pid;
+      job.result_fd = fds[0];
+      next++;
+      running++;
+      continue;
+    }
+
+    // Wait for any worker to finish and collect its result line
+    int status;
+    pid_t pid = wait(&status);
+    if(pid < 0)
+      break;
+    for(size_t i = 0; i < jobs.size(); i++) {
+      if(jobs[i].pid != pid)
+        continue;
+      char buf[256];
+      ssize_t n = read(jobs[i].result_fd, buf, sizeof(buf) - 1);
+      jobs[i].result = n > 0 ? std::string(buf, n) : "";
+      close(jobs[i].result_fd);
+      running--;
+    }
+  }
+
+  // Each worker reports "<exit valid> <exit value> <cycles> <wall time> <hang>"
+  unsigned int passed = 0;
+  std::ofstream out(report.c_str());
+  out<<"{\n  \"manifest\": \""<<jsonEscape(manifest)<<"\",\n  \"workers\": "<<max_jobs<<",\n  \"results\": [\n";
+  for(size_t i = 0; i < jobs.size(); i++) {
+    std::istringstream fields(jobs[i].result);
+    int exit_valid = -1, hang = 0;
+    unsigned int exit_value = 0;
+    vluint64_t cycles = 0;
+    double wall_s = 0;
+    std::string status;
+    if(!(fields >> exit_valid >> exit_value >> cycles >> wall_s >> hang)) status = "error";
+    else if(hang) status = "hang";
+    else if(exit_valid != 1) status = "timeout";
+    else if(exit_value != jobs[i].expected_exit_value) status = "fail";
+    else status = "pass";
+    if(status == "pass") passed++;
+
+    std::cout<<"[TESTBENCH]: "<<status<<"\t"<<cycles<<" cycles\t"<<jobs[i].firmware<<std::endl;
+    out<<"    {\"firmware\": \""<<jsonEscape(jobs[i].firmware)<<"\", \"status\": \""<<status
+       <<"\", \"exit_value\": "<<exit_value<<", \"expected_exit_value\": "<<jobs[i].expected_exit_value
+       <<", \"cycles\": "<<cycles<<", \"wall_time_s\": "<<wall_s<<", \"dir\": \""<<jsonEscape(jobs[i].dir)<<"\"}"
+       <<(i + 1 < jobs.size() ? ",\n" : "\n");
+  }
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  out<<"  ],\n  \"passed\": "<<passed<<",\n  \"failed\": "<<jobs.size() - passed<<",\n  \"wall_time_s\": "<<wall_s<<"\n}\n";
+  out.close();
+
+  std::cout<<"[TESTBENCH]: Batch finished: "<<passed<<"/"<<jobs.size()<<" passed in "<<wall_s<<" s, report in "<<report<<std::endl;
+  exit(passed == jobs.size() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 int main (int argc, char * argv[])
 {
 
   unsigned int SRAM_SIZE;
-  std::string firmware, arg_max_sim_time, arg_openocd, arg_boot_sel, arg_execute_from_flash;
+  std::string firmware, arg_max_sim_time, arg_openocd, arg_boot_sel, arg_execute_from_flash, arg_trace;
+  std::string arg_save_checkpoint, arg_restore_checkpoint, arg_perf_report, arg_profile, arg_profile_out;
+  std::string arg_exec_trace, arg_energy, arg_fast_forward;
+  vluint64_t arg_fast_forward_instr;
   unsigned int max_sim_time;
+  int trace_depth;
   bool use_openocd;
   bool run_all = false;
+  bool hang_detected = false;
   int i,j, exit_val, boot_sel, execute_from_flash;
+
+  std::string arg_batch = getCmdOption(argc, argv, "+batch=");
+  if(!arg_batch.empty())
+    runBatch(argc, argv, arg_batch);
+
   Verilated::commandArgs(argc, argv);
 
   // Instantiate the model
   Vtestharness *dut = new Vtestharness;
 
-  // Open VCD
-  Verilated::traceEverOn (true);
-  VerilatedFstC *m_trace = new VerilatedFstC;
-  dut->trace (m_trace, 99);
-  m_trace->open ("waveform.vcd");
+  arg_trace = getCmdOption(argc, argv, "+trace=");
+  if(arg_trace.empty() || arg_trace.compare("off") == 0) {
+    trace_ctrl.mode = TRACE_OFF;
+  } else if(arg_trace.compare("full") == 0) {
+    trace_ctrl.mode = TRACE_FULL;
+  } else if(arg_trace.compare("window") == 0) {
+    trace_ctrl.mode = TRACE_WINDOW;
+  } else if(arg_trace.compare("pc") == 0) {
+    trace_ctrl.mode = TRACE_PC;
+  } else if(arg_trace.compare("exit") == 0) {
+    trace_ctrl.mode = TRACE_EXIT;
+  } else if(arg_trace.compare("flight") == 0) {
+    trace_ctrl.mode = TRACE_FLIGHT;
+  } else {
+    std::cout<<"[TESTBENCH]: Wrong Trace Option specified (off, full, window, pc, exit, flight) - using off"<<std::endl;
+    trace_ctrl.mode = TRACE_OFF;
+  }
+
+  // For the window mode start/end are absolute cycles, for the triggered modes
+  // the end is relative to the trigger cycle
+  trace_ctrl.start_cycle        = getNumOption(argc, argv, "+trace_start=", 0);
+  trace_ctrl.end_cycle          = getNumOption(argc, argv, "+trace_end=", ~(vluint64_t)0 >> 1);
+  trace_ctrl.trigger_pc         = getNumOption(argc, argv, "+trace_pc=", 0);
+  trace_ctrl.trigger_exit_value = getNumOption(argc, argv, "+trace_exit_value=", 0);
+  trace_depth                   = getNumOption(argc, argv, "+trace_depth=", 99);
+  // For the flight recorder end_cycle is the end of the current segment
+  if(trace_ctrl.mode == TRACE_FLIGHT) {
+    trace_ctrl.segment_cycles = getNumOption(argc, argv, "+trace_last=", 10000);
+    if(trace_ctrl.segment_cycles == 0) trace_ctrl.segment_cycles = 1;
+    trace_ctrl.end_cycle = trace_ctrl.segment_cycles;
+  }
+
+  VerilatedFstC *m_trace = NULL;
+  if(trace_ctrl.mode != TRACE_OFF) {
+    std::cout<<"[TESTBENCH]: Tracing ("<<arg_trace<<") with depth "<<trace_depth<<" in waveform.vcd"<<std::endl;
+    // Open VCD
+    Verilated::traceEverOn (true);
+    m_trace = new VerilatedFstC;
+    dut->trace (m_trace, trace_depth);
+    unlink(TRACE_FILE_PREV);
+    m_trace->open (TRACE_FILE);
+  } else {
+    std::cout<<"[TESTBENCH]: No Trace is dumped (use +trace=full|window|pc|exit|flight)"<<std::endl;
+  }
 
   arg_openocd = getCmdOption(argc, argv, "+openOCD=");
   use_openocd = false;
@@ -68,10 +787,30 @@ int main (int argc, char * argv[])
     use_openocd = true;
   }
 
+  arg_save_checkpoint    = getCmdOption(argc, argv, "+save_checkpoint=");
+  arg_restore_checkpoint = getCmdOption(argc, argv, "+restore_checkpoint=");
+#ifndef TB_SAVABLE
+  if(!arg_save_checkpoint.empty() || !arg_restore_checkpoint.empty()) {
+    std::cout<<"[TESTBENCH]: ERROR: Checkpoints need a model built with --savable (make verilator-sim-savable)"<<std::endl;
+    exit(EXIT_FAILURE);
+  }
+#endif
+  if(!arg_save_checkpoint.empty()) {
+    size_t at = arg_save_checkpoint.rfind('@');
+    if(at == std::string::npos) {
+      std::cout<<"[TESTBENCH]: ERROR: Wrong checkpoint option, expected +save_checkpoint=<file>@<cycle>"<<std::endl;
+      exit(EXIT_FAILURE);
+    }
+    checkpoint_file      = arg_save_checkpoint.substr(0, at);
+    checkpoint_save_time = std::stoull(arg_save_checkpoint.substr(at + 1), nullptr, 0) << 1;
+    checkpoint_pending   = true;
+    std::cout<<"[TESTBENCH]: Checkpoint will be saved in "<<checkpoint_file<<" at cycle "<<(checkpoint_save_time >> 1)<<std::endl;
+  }
+
   firmware = getCmdOption(argc, argv, "+firmware=");
   if(firmware.empty()){
     std::cout<<"[TESTBENCH]: No firmware  specified"<<std::endl;
-    if(use_openocd==false)
+    if(use_openocd==false && arg_restore_checkpoint.empty())
       exit(EXIT_FAILURE);
   } else {
     std::cout<<"[TESTBENCH]: loading firmware  "<<firmware<<std::endl;
@@ -105,13 +844,29 @@ int main (int argc, char * argv[])
     }
   }
 
-  arg_boot_sel = getCmdOption(argc, argv, "+execute_from_flash=");
-  execute_from_flash = 1;
-
+  execute_from_flash = 0;
   if(boot_sel == 1) {
-    std::cout<<"[TESTBENCH]: ERROR: Executing from SPI is not supported (yet) in Verilator"<<std::endl;
-    std::cout<<"exit simulation..."<<std::endl;
-    return -1;
+    arg_execute_from_flash = getCmdOption(argc, argv, "+execute_from_flash=");
+    if(arg_execute_from_flash.empty()) {
+      std::cout<<"[TESTBENCH]: No SPI Option specified, using execute from flash (execute_from_flash=1)"<<std::endl;
+      execute_from_flash = 1;
+    } else if(arg_execute_from_flash.compare("1") == 0) {
+      std::cout<<"[TESTBENCH]: Executing from flash"<<std::endl;
+      execute_from_flash = 1;
+    } else if(arg_execute_from_flash.compare("0") == 0) {
+      std::cout<<"[TESTBENCH]: Loading flash in-memory"<<std::endl;
+      execute_from_flash = 0;
+    } else {
+      std::cout<<"[TESTBENCH]: Wrong SPI Option specified (execute from flash, load flash in-memory) - using execute from flash (execute_from_flash=1)"<<std::endl;
+      execute_from_flash = 1;
+    }
+  }
+
+  arg_fast_forward       = getCmdOption(argc, argv, "+fast_forward=");
+  arg_fast_forward_instr = getNumOption(argc, argv, "+fast_forward_instr=", 0);
+  if((!arg_fast_forward.empty() || arg_fast_forward_instr != 0) && (boot_sel != 0 || use_openocd || !arg_restore_checkpoint.empty())) {
+    std::cout<<"[TESTBENCH]: ERROR: The fast-forward needs the firmware loaded by the testbench (no flash boot, OpenOCD or checkpoint)"<<std::endl;
+    exit(EXIT_FAILURE);
   }
 
   svSetScope(svGetScopeFromName("TOP.testharness"));
@@ -130,47 +885,184 @@ int main (int argc, char * argv[])
   dut->execute_from_flash_i = execute_from_flash;
   dut->boot_select_i        = boot_sel;
 
-  dut->eval();
-  m_trace->dump(sim_time);
-  sim_time++;
+  std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+  vluint64_t sim_time_start = sim_time;
 
-  dut->rst_ni               = 1;
-  //this creates the negedge
-  runCycles(50, dut, m_trace);
-  dut->rst_ni               = 0;
-  runCycles(50, dut, m_trace);
+  // The boot ROM reads the firmware from the C++ flash model. The flash is not
+  // part of the model state, so it is also reloaded after restoring a checkpoint.
+  if(boot_sel == 1 && !firmware.empty()) {
+    if(!tbSpiFlash().load(firmware))
+      exit(EXIT_FAILURE);
+  }
 
+  bool restored = false;
+#ifdef TB_SAVABLE
+  if(!arg_restore_checkpoint.empty()) {
+    // The restored model already went through reset and firmware loading
+    restoreCheckpoint(dut, arg_restore_checkpoint);
+    dut->tb_reopen_uart();
+    if(checkpoint_pending && checkpoint_save_time < sim_time) {
+      std::cout<<"[TESTBENCH]: WARNING: Checkpoint cycle is before the restored cycle, not saving"<<std::endl;
+      checkpoint_pending = false;
+    }
+    restored = true;
+  }
+#endif
 
-  dut->rst_ni = 1;
-  runCycles(20, dut, m_trace);
-  std::cout<<"Reset Released"<< std::endl;
+  if(!restored) {
+    dut->eval();
+    dumpTrace(dut, m_trace);
+    sim_time++;
 
-  //dont need to exit from boot loop if using OpenOCD or Boot from Flash
-  if(use_openocd==false || boot_sel == 1) {
-    dut->tb_loadHEX(firmware.c_str());
-    runCycles(1, dut, m_trace);
-    dut->tb_set_exit_loop();
-    std::cout<<"Set Exit Loop"<< std::endl;
-    runCycles(1, dut, m_trace);
-    std::cout<<"Memory Loaded"<< std::endl;
-  } else {
-    std::cout<<"Waiting for GDB"<< std::endl;
+    dut->rst_ni               = 1;
+    //this creates the negedge
+    runCycles(50, dut, m_trace);
+    dut->rst_ni               = 0;
+    runCycles(50, dut, m_trace);
+
+
+    dut->rst_ni = 1;
+    runCycles(20, dut, m_trace);
+    std::cout<<"Reset Released"<< std::endl;
+
+    //dont need to exit from boot loop if using OpenOCD or Boot from Flash
+    if(boot_sel == 0 && use_openocd==false) {
+      if(!arg_fast_forward.empty() || arg_fast_forward_instr != 0) {
+        if(!fastForward(firmware, arg_fast_forward, arg_fast_forward_instr ? arg_fast_forward_instr : ~(vluint64_t)0,
+                        getCmdOption(argc, argv, "+fast_forward_replay=")))
+          exit(EXIT_FAILURE);
+      } else if(!loadFirmware(dut, firmware))
+        exit(EXIT_FAILURE);
+      runCycles(1, dut, m_trace);
+      dut->tb_set_exit_loop();
+      std::cout<<"Set Exit Loop"<< std::endl;
+      runCycles(1, dut, m_trace);
+      std::cout<<"Memory Loaded"<< std::endl;
+    } else if(boot_sel == 1) {
+      std::cout<<"Booting from Flash"<< std::endl;
+    } else {
+      std::cout<<"Waiting for GDB"<< std::endl;
+    }
   }
 
-  if(run_all==false) {
-    runCycles(max_sim_time, dut, m_trace);
-  } else {
-    while(dut->exit_valid_o!=1) {
-      runCycles(500, dut, m_trace);
+  // Profile the firmware only, not the reset and the loading
+  arg_profile = getCmdOption(argc, argv, "+profile=");
+  if(!arg_profile.empty()) {
+    profiler = new TbProfiler;
+    if(!profiler->open(arg_profile, getNumOption(argc, argv, "+profile_interval=", 100)))
+      exit(EXIT_FAILURE);
+    std::cout<<"[TESTBENCH]: Profiling "<<arg_profile<<std::endl;
+  }
+
+  arg_exec_trace = getCmdOption(argc, argv, "+exec_trace=");
+  if(!arg_exec_trace.empty()) {
+    long long cycles, instret, sleep_cycles, dma_busy_cycles;
+    int xbar_nmaster;
+    tb_getPerfCounters(&cycles, &instret, &sleep_cycles, &dma_busy_cycles, &xbar_nmaster);
+    if(!tbExecTrace().open(arg_exec_trace, xbar_nmaster))
+      exit(EXIT_FAILURE);
+    int streams = TB_EXEC_TRACE_EN_INSTR;
+    if(getNumOption(argc, argv, "+exec_trace_bus=", 1) != 0) streams |= TB_EXEC_TRACE_EN_BUS;
+    tb_set_exec_trace(streams);
+    std::cout<<"[TESTBENCH]: Writing the execution trace to "<<arg_exec_trace<<std::endl;
+  }
+
+  // Energy estimation, the activity is tallied from here on
+  TbEnergy *energy = NULL;
+  arg_energy = getCmdOption(argc, argv, "+energy=");
+  if(!arg_energy.empty()) {
+    energy = new TbEnergy;
+    if(!energy->open(arg_energy))
+      exit(EXIT_FAILURE);
+    tb_set_energy(1);
+    std::cout<<"[TESTBENCH]: Estimating the energy with "<<arg_energy<<std::endl;
+  }
+
+  // Run in chunks of +exit_check_interval cycles, stopping as soon as the
+  // firmware exits, the budget of +max_sim_time edges is spent or the hang
+  // detector fires
+  vluint64_t exit_check_interval = getNumOption(argc, argv, "+exit_check_interval=", 250);
+  vluint64_t hang_cycles         = getNumOption(argc, argv, "+hang_cycles=", 0);
+  vluint64_t remaining           = max_sim_time;
+  double progress_s              = getNumOption(argc, argv, "+progress=", 0);
+  double progress_last_s         = 0;
+  vluint64_t progress_last       = 0;
+  if(exit_check_interval == 0) exit_check_interval = 1;
+  while(dut->exit_valid_o != 1 && (run_all || remaining > 0)) {
+    vluint64_t chunk = 2 * exit_check_interval;
+    if(!run_all && chunk > remaining) chunk = remaining;
+    runCycles(chunk, dut, m_trace);
+    remaining -= run_all ? 0 : chunk;
+    if(progress_s > 0) {
+      double now_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+      if(now_s - progress_last_s >= progress_s) {
+        vluint64_t cycles = (sim_time - sim_time_start) >> 1;
+        progressReport(cycles, now_s, progress_last, progress_last_s);
+        progress_last   = cycles;
+        progress_last_s = now_s;
+      }
+    }
+    if(hang_cycles != 0 && tb_get_pc_stable_cycles() >= hang_cycles) {
+      std::cout<<"[TESTBENCH]: ERROR: Hang detected, the PC stayed at 0x"<<std::hex<<tb_get_retire_pc()<<std::dec
+               <<" for "<<tb_get_pc_stable_cycles()<<" cycles"<<std::endl;
+      hang_detected = true;
+      break;
     }
   }
+  if(dut->exit_valid_o != 1 && !hang_detected)
+    std::cout<<"[TESTBENCH]: Reached the end of the simulation time without exit"<<std::endl;
+
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  vluint64_t sim_cycles = (sim_time - sim_time_start) >> 1;
+  std::cout<<"[TESTBENCH]: Simulated "<<sim_cycles<<" cycles in "<<wall_s<<" s ("<<(wall_s > 0 ? sim_cycles / wall_s : 0)<<" cycles/s)"<<std::endl;
+
+  arg_perf_report = getCmdOption(argc, argv, "+perf_report=");
+  perfReport(arg_perf_report, sim_cycles, wall_s);
+
+  if(energy != NULL) {
+    energyReport(*energy, getCmdOption(argc, argv, "+energy_report="));
+    delete energy;
+  }
+
+  if(profiler != NULL) {
+    arg_profile_out = getCmdOption(argc, argv, "+profile_out=");
+    profiler->report(arg_profile_out.empty() ? "profile" : arg_profile_out, 10);
+    delete profiler;
+  }
+
+  if(tbExecTrace().isOpen()) {
+    std::cout<<"[TESTBENCH]: Execution trace of "<<tbExecTrace().records()<<" records written to "<<arg_exec_trace<<std::endl;
+    tbExecTrace().close();
+  }
+
+  if(batch_result_fd >= 0) {
+    std::ostringstream result;
+    result<<(int)dut->exit_valid_o<<" "<<dut->exit_value_o<<" "<<sim_cycles<<" "<<wall_s<<" "<<hang_detected<<std::endl;
+    if(write(batch_result_fd, result.str().c_str(), result.str().size()) < 0)
+      perror("[TESTBENCH]: batch result");
+    close(batch_result_fd);
+  }
 
   if(dut->exit_valid_o==1) {
     std::cout<<"Program Finished with value "<<dut->exit_value_o<<std::endl;
     exit_val = EXIT_SUCCESS;
   } else exit_val = EXIT_FAILURE;
 
-  m_trace->close();
+  if(m_trace != NULL) {
+    m_trace->close();
+    delete m_trace;
+    // The flight recorder is only kept for the runs that did not exit with 0
+    if(trace_ctrl.mode == TRACE_FLIGHT) {
+      if(dut->exit_valid_o == 1 && dut->exit_value_o == 0 && !hang_detected) {
+        unlink(TRACE_FILE);
+        unlink(TRACE_FILE_PREV);
+        std::cout<<"[TESTBENCH]: Passed, flight recorder discarded"<<std::endl;
+      } else {
+        std::cout<<"[TESTBENCH]: Failed, the last "<<trace_ctrl.segment_cycles<<" cycles or more are in "
+                 <<TRACE_FILE_PREV<<" and "<<TRACE_FILE<<std::endl;
+      }
+    }
+  }
   delete dut;
 
   exit(exit_val);
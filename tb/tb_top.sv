@@ -8,6 +8,7 @@ module tb_top #(
     parameter ZFINX                       = 0,
     parameter JTAG_DPI                    = 0,
     parameter X_EXT                       = 0,
+    parameter X_COPROC                    = 0,
     parameter USE_EXTERNAL_DEVICE_EXAMPLE = 1
 );
 
@@ -195,6 +196,7 @@ module tb_top #(
       .FPU                        (FPU),
       .ZFINX                      (ZFINX),
       .X_EXT                      (X_EXT),
+      .X_COPROC                   (X_COPROC),
       .JTAG_DPI                   (JTAG_DPI),
       .USE_EXTERNAL_DEVICE_EXAMPLE(USE_EXTERNAL_DEVICE_EXAMPLE),
       .CLK_FREQUENCY              (CLK_FREQUENCY_KHz)
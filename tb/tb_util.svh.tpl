@@ -10,7 +10,24 @@ export "DPI-C" task tb_loadHEX;
 export "DPI-C" task tb_writetoSram${bank};
 % endfor
 export "DPI-C" task tb_getMemSize;
+export "DPI-C" function tb_getMemBanks;
+export "DPI-C" function tb_getMemBankStart;
+export "DPI-C" function tb_writeSramWord;
 export "DPI-C" task tb_set_exit_loop;
+export "DPI-C" function tb_get_fetch_addr;
+export "DPI-C" function tb_get_retire_pc;
+export "DPI-C" function tb_get_pc_stable_cycles;
+export "DPI-C" function tb_getPerfCounters;
+export "DPI-C" function tb_getXbarStallCycles;
+export "DPI-C" function tb_set_exec_trace;
+export "DPI-C" function tb_set_energy;
+export "DPI-C" function tb_getEnergyCycles;
+export "DPI-C" function tb_getEnergyRamAccesses;
+export "DPI-C" function tb_getEnergyDmaBeats;
+export "DPI-C" function tb_getFastForwardMap;
+`ifdef VERILATOR
+export "DPI-C" task tb_reopen_uart;
+`endif
 
 import core_v_mini_mcu_pkg::*;
 
@@ -21,6 +38,41 @@ task tb_getMemSize;
   num_banks = core_v_mini_mcu_pkg::NUM_BANKS;
 endtask
 
+function void tb_getMemBanks;
+  output int mem_size;
+  output int num_banks_cont;
+  output int num_banks_il;
+  output int cont_size;
+  mem_size       = core_v_mini_mcu_pkg::MEM_SIZE;
+  num_banks_cont = ${ram_numbanks_cont};
+  num_banks_il   = ${ram_numbanks_il};
+  cont_size      = 32'h${'{:08X}'.format(ram_il_start - int(ram_start_address, 16))};
+endfunction
+
+// First address of a bank, that of the interleaved region for the interleaved banks
+function int tb_getMemBankStart;
+  input int bank;
+  case (bank)
+% for bank, (start, size) in enumerate(ram_banks):
+    ${bank}: return 32'h${'{:08X}'.format(start)};
+% endfor
+    default: return core_v_mini_mcu_pkg::MEM_SIZE;
+  endcase
+endfunction
+
+// Used by the C++ firmware loader to write the banks without going through $readmemh
+function void tb_writeSramWord;
+  input int bank;
+  input int addr;
+  input int data;
+  case (bank)
+% for bank in range(ram_numbanks):
+    ${bank}: x_heep_system_i.core_v_mini_mcu_i.memory_subsystem_i.gen_sram[${bank}].ram_i.tc_ram_i.sram[addr] = data;
+% endfor
+    default: ;
+  endcase
+endfunction
+
 task tb_readHEX;
   input string file;
   output logic [7:0] stimuli[core_v_mini_mcu_pkg::MEM_SIZE];
@@ -74,14 +126,14 @@ task tb_loadHEX;
 
   stimuli_counter = 0;
 % for bank in range(ram_numbanks_cont):
-  for (i = 0; i < NumBytes / NumBanks; i = i + 4) begin
+  for (i = 0; i < ${ram_banks[bank][1]}; i = i + 4) begin
     tb_writetoSram${bank}(i / 4, stimuli[stimuli_counter+3], stimuli[stimuli_counter+2],
                    stimuli[stimuli_counter+1], stimuli[stimuli_counter]);
     stimuli_counter = stimuli_counter + 4;
   end
 % endfor
 % if ram_numbanks_il != 0:
-  for (i = 0; i < NumBytes / NumBanks; i = i + 4) begin
+  for (i = 0; i < ${ram_banks[-1][1]}; i = i + 4) begin
 % for bank in range(ram_numbanks_il):
     tb_writetoSram${int(ram_numbanks_cont) + bank}(i / 4, stimuli[stimuli_counter+3], stimuli[stimuli_counter+2],
                     stimuli[stimuli_counter+1], stimuli[stimuli_counter]);
@@ -115,6 +167,350 @@ endtask
 
 % endfor
 
+// Address of the instruction fetch granted in the current cycle, all ones otherwise
+function int tb_get_fetch_addr();
+  if (x_heep_system_i.core_v_mini_mcu_i.core_instr_req.req && x_heep_system_i.core_v_mini_mcu_i.core_instr_resp.gnt)
+    return x_heep_system_i.core_v_mini_mcu_i.core_instr_req.addr;
+  else return '1;
+endfunction
+
+// PC of the instruction leaving the last stage that can still stall it
+logic [31:0] tb_retire_pc;
+% if cpu_type == "cv32e20":
+assign tb_retire_pc = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.pc_id;
+% elif cpu_type == "cv32e40x":
+assign tb_retire_pc = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.ex_wb_pipe.pc;
+% elif cpu_type == "cv32e40px":
+assign tb_retire_pc = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40px.cv32e40px_top_i.core_i.pc_id;
+% else:
+assign tb_retire_pc = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40p.cv32e40p_top_i.core_i.pc_id;
+% endif
+
+// Used by the profiler
+function int tb_get_retire_pc();
+  return tb_retire_pc;
+endfunction
+
+// Cycles since tb_retire_pc last changed, used by the hang detector. Cycles in
+// WFI are not counted, as waiting for an interrupt is not a hang.
+logic [31:0] tb_retire_pc_q;
+int unsigned tb_pc_stable_cycles;
+
+always_ff @(posedge x_heep_system_i.core_v_mini_mcu_i.clk_i or negedge x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin : proc_tb_pc_stable
+  if (!x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin
+    tb_retire_pc_q      <= '0;
+    tb_pc_stable_cycles <= '0;
+  end else begin
+    tb_retire_pc_q <= tb_retire_pc;
+    if (tb_retire_pc != tb_retire_pc_q) tb_pc_stable_cycles <= '0;
+    else if (!x_heep_system_i.core_v_mini_mcu_i.core_sleep && tb_pc_stable_cycles != '1)
+      tb_pc_stable_cycles <= tb_pc_stable_cycles + 1;
+  end
+end
+
+function int unsigned tb_get_pc_stable_cycles();
+  return tb_pc_stable_cycles;
+endfunction
+
+`ifdef VERILATOR
+import "DPI-C" function chandle uartdpi_create(
+  input string name,
+  input string log_file_path
+);
+
+// Re-create the UART DPI context after restoring a checkpoint, as the restored
+// chandle points to the memory of the process that saved the checkpoint
+task tb_reopen_uart;
+  i_uart0.ctx = uartdpi_create("uart0", i_uart0.log_file_path);
+endtask
+`endif
+
+// Performance counters, read by the C++ testbench when the simulation ends.
+// They count from the end of the reset until the firmware sets exit_valid_o.
+longint unsigned tb_perf_cycles;
+longint unsigned tb_perf_instret;
+longint unsigned tb_perf_sleep_cycles;
+longint unsigned tb_perf_dma_busy_cycles;
+longint unsigned tb_perf_xbar_stall_cycles[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER];
+logic tb_perf_instr_retired;
+
+% if cpu_type == "cv32e20":
+assign tb_perf_instr_retired = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.perf_instr_ret_wb;
+% elif cpu_type == "cv32e40x":
+assign tb_perf_instr_retired = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.cs_registers_i.hpm_events_raw[1];
+% elif cpu_type == "cv32e40px":
+assign tb_perf_instr_retired = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40px.cv32e40px_top_i.core_i.cs_registers_i.mhpmevent_minstret_i;
+% else:
+assign tb_perf_instr_retired = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40p.cv32e40p_top_i.core_i.cs_registers_i.mhpmevent_minstret_i;
+% endif
+
+always_ff @(posedge x_heep_system_i.core_v_mini_mcu_i.clk_i or negedge x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin : proc_tb_perf
+  if (!x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin
+    tb_perf_cycles            <= '0;
+    tb_perf_instret           <= '0;
+    tb_perf_sleep_cycles      <= '0;
+    tb_perf_dma_busy_cycles   <= '0;
+    tb_perf_xbar_stall_cycles <= '{default: '0};
+  end else if (exit_valid_o !== 1'b1) begin
+    tb_perf_cycles <= tb_perf_cycles + 1;
+    if (tb_perf_instr_retired) tb_perf_instret <= tb_perf_instret + 1;
+    if (x_heep_system_i.core_v_mini_mcu_i.core_sleep)
+      tb_perf_sleep_cycles <= tb_perf_sleep_cycles + 1;
+    if (${" || ".join("!x_heep_system_i.core_v_mini_mcu_i.ao_peripheral_subsystem_i.gen_dma_ch[%d].dma_i.hw2reg.status.ready.d" % ch for ch in range(dma_ch_count))})
+      tb_perf_dma_busy_cycles <= tb_perf_dma_busy_cycles + 1;
+    for (int i = 0; i < core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER; i++) begin
+      if (x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_req_i[i].req &&
+          !x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_resp_o[i].gnt)
+        tb_perf_xbar_stall_cycles[i] <= tb_perf_xbar_stall_cycles[i] + 1;
+    end
+  end
+end
+
+function void tb_getPerfCounters;
+  output longint cycles;
+  output longint instret;
+  output longint sleep_cycles;
+  output longint dma_busy_cycles;
+  output int xbar_nmaster;
+  cycles          = tb_perf_cycles;
+  instret         = tb_perf_instret;
+  sleep_cycles    = tb_perf_sleep_cycles;
+  dma_busy_cycles = tb_perf_dma_busy_cycles;
+  xbar_nmaster    = core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER;
+endfunction
+
+// Cycles the system crossbar master (see core_v_mini_mcu_pkg::*_IDX) requested without a grant
+function longint tb_getXbarStallCycles;
+  input int master;
+  return tb_perf_xbar_stall_cycles[master];
+endfunction
+
+// Energy estimation
+// -----------------
+// Activity of the power domains, tallied while enabled by the C++ testbench
+// (+energy=<table>) and until the firmware sets exit_valid_o, and weighted
+// there with the energy of each event. The states are indexed as the
+// residency counters of the power manager: 0 active, 1 clock-gated (the core
+// sleeping in wfi), 2 power-gated, 3 retentive.
+localparam int unsigned TB_ENERGY_NSTATES = 4;
+
+bit tb_energy_en;
+longint unsigned tb_energy_cpu_cycles[TB_ENERGY_NSTATES];
+longint unsigned tb_energy_periph_cycles[TB_ENERGY_NSTATES];
+longint unsigned tb_energy_ram_cycles[core_v_mini_mcu_pkg::NUM_BANKS][TB_ENERGY_NSTATES];
+longint unsigned tb_energy_ram_accesses[core_v_mini_mcu_pkg::NUM_BANKS];
+longint unsigned tb_energy_dma_beats;
+
+function automatic int tb_energy_state(logic switch_n, logic retentive_n, logic clkgate_en_n);
+  if (!switch_n) return 2;
+  if (!retentive_n) return 3;
+  if (!clkgate_en_n) return 1;
+  return 0;
+endfunction
+
+int tb_energy_cpu_state;
+int tb_energy_periph_state;
+int tb_energy_ram_state[core_v_mini_mcu_pkg::NUM_BANKS];
+
+always_comb begin
+  tb_energy_cpu_state = tb_energy_state(x_heep_system_i.cpu_subsystem_powergate_switch_n, 1'b1,
+                                        !x_heep_system_i.core_v_mini_mcu_i.core_sleep);
+  tb_energy_periph_state = tb_energy_state(x_heep_system_i.peripheral_subsystem_powergate_switch_n, 1'b1,
+                                           x_heep_system_i.core_v_mini_mcu_i.peripheral_subsystem_clkgate_en_n);
+  for (int i = 0; i < core_v_mini_mcu_pkg::NUM_BANKS; i++)
+    tb_energy_ram_state[i] = tb_energy_state(x_heep_system_i.memory_subsystem_banks_powergate_switch_n[i],
+                                             x_heep_system_i.core_v_mini_mcu_i.memory_subsystem_banks_set_retentive_n[i],
+                                             x_heep_system_i.core_v_mini_mcu_i.memory_subsystem_clkgate_en_n[i]);
+end
+
+always_ff @(posedge x_heep_system_i.core_v_mini_mcu_i.clk_i or negedge x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin : proc_tb_energy
+  if (!x_heep_system_i.core_v_mini_mcu_i.rst_ni) begin
+    tb_energy_cpu_cycles    <= '{default: '0};
+    tb_energy_periph_cycles <= '{default: '0};
+    tb_energy_ram_cycles    <= '{default: '{default: '0}};
+    tb_energy_ram_accesses  <= '{default: '0};
+    tb_energy_dma_beats     <= '0;
+  end else if (tb_energy_en && exit_valid_o !== 1'b1) begin
+    tb_energy_cpu_cycles[tb_energy_cpu_state] <= tb_energy_cpu_cycles[tb_energy_cpu_state] + 1;
+    tb_energy_periph_cycles[tb_energy_periph_state] <= tb_energy_periph_cycles[tb_energy_periph_state] + 1;
+    for (int i = 0; i < core_v_mini_mcu_pkg::NUM_BANKS; i++) begin
+      tb_energy_ram_cycles[i][tb_energy_ram_state[i]] <= tb_energy_ram_cycles[i][tb_energy_ram_state[i]] + 1;
+      // the banks grant every request
+      if (x_heep_system_i.core_v_mini_mcu_i.ram_slave_req[i].req)
+        tb_energy_ram_accesses[i] <= tb_energy_ram_accesses[i] + 1;
+    end
+    // one beat per granted write of a channel
+    tb_energy_dma_beats <= tb_energy_dma_beats
+% for ch in range(dma_ch_count):
+        + (x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_req_i[core_v_mini_mcu_pkg::DMA_WRITE_CH${ch}_IDX].req &&
+           x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_resp_o[core_v_mini_mcu_pkg::DMA_WRITE_CH${ch}_IDX].gnt)
+% endfor
+        ;
+  end
+end
+
+function void tb_set_energy;
+  input bit enable;
+  tb_energy_en = enable;
+endfunction
+
+// Cycles of a domain in a state: domain 0 is the CPU, 1 the peripheral
+// subsystem, 2 + i the RAM bank i
+function longint tb_getEnergyCycles;
+  input int domain;
+  input int state;
+  if (domain == 0) return tb_energy_cpu_cycles[state];
+  if (domain == 1) return tb_energy_periph_cycles[state];
+  return tb_energy_ram_cycles[domain-2][state];
+endfunction
+
+function longint tb_getEnergyRamAccesses;
+  input int bank;
+  return tb_energy_ram_accesses[bank];
+endfunction
+
+function longint tb_getEnergyDmaBeats;
+  return tb_energy_dma_beats;
+endfunction
+
+// Fast-forward
+// ------------
+// Addresses of the registers known by the instruction-set model of
+// tb/tb_iss.cpp and the address the boot ROM jumps to (+fast_forward)
+function void tb_getFastForwardMap;
+  output int exit_valid;
+  output int exit_value;
+  output int uart_wdata;
+  output int uart_status;
+  output int boot_address;
+  exit_valid   = core_v_mini_mcu_pkg::SOC_CTRL_START_ADDRESS + 32'(soc_ctrl_reg_pkg::SOC_CTRL_EXIT_VALID_OFFSET);
+  exit_value   = core_v_mini_mcu_pkg::SOC_CTRL_START_ADDRESS + 32'(soc_ctrl_reg_pkg::SOC_CTRL_EXIT_VALUE_OFFSET);
+  uart_wdata   = core_v_mini_mcu_pkg::UART_START_ADDRESS + 32'(uart_reg_pkg::UART_WDATA_OFFSET);
+  uart_status  = core_v_mini_mcu_pkg::UART_START_ADDRESS + 32'(uart_reg_pkg::UART_STATUS_OFFSET);
+  boot_address = x_heep_system_i.core_v_mini_mcu_i.ao_peripheral_subsystem_i.soc_ctrl_i.reg2hw.boot_address.q;
+endfunction
+
+// Execution trace
+// ---------------
+// Retired instructions, register file writes and OBI transactions of the
+// system crossbar masters, streamed to tb/tb_exec_trace.cpp when enabled by
+// the C++ testbench (+exec_trace=<file>).
+localparam int unsigned TB_TRACE_OUTSTANDING = 4;
+
+import "DPI-C" function void tb_exec_trace_instr(
+  input longint cycle,
+  input int pc,
+  input int instr
+);
+import "DPI-C" function void tb_exec_trace_reg(
+  input longint cycle,
+  input int rd,
+  input int value
+);
+import "DPI-C" function void tb_exec_trace_bus(
+  input longint cycle,
+  input int master,
+  input int addr,
+  input int we,
+  input int be,
+  input int data,
+  input int stall_cycles,
+  input int latency_cycles
+);
+
+// Bit 0: instructions and register writes, bit 1: bus transactions
+bit [1:0] tb_exec_trace_en = '0;
+
+function void tb_set_exec_trace;
+  input int enable;
+  tb_exec_trace_en = enable[1:0];
+endfunction
+
+logic [31:0] tb_retire_instr;
+logic [ 1:0] tb_rf_we;
+logic [ 1:0][ 4:0] tb_rf_waddr;
+logic [ 1:0][31:0] tb_rf_wdata;
+
+% if cpu_type == "cv32e20":
+assign tb_retire_instr = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.instr_rdata_id;
+assign tb_rf_we        = {1'b0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.rf_we_wb};
+assign tb_rf_waddr     = {5'h0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.rf_waddr_wb};
+assign tb_rf_wdata     = {32'h0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e20.cv32e20_i.u_cve2_core.rf_wdata_wb};
+% elif cpu_type == "cv32e40x":
+assign tb_retire_instr = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.ex_wb_pipe.instr.bus_resp.rdata;
+assign tb_rf_we        = {1'b0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.rf_we_wb};
+assign tb_rf_waddr     = {5'h0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.rf_waddr_wb};
+assign tb_rf_wdata     = {32'h0, x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.gen_cv32e40x.cv32e40x_core_i.rf_wdata_wb};
+% else:
+<% core = "gen_cv32e40px.cv32e40px_top_i.core_i" if cpu_type == "cv32e40px" else "gen_cv32e40p.cv32e40p_top_i.core_i" %>
+// Port 0 is the write-back of the LSU, port 1 the forwarded result of the ALU
+// (only the integer registers, the upper half of the addresses is the FP register file)
+assign tb_retire_instr = x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.instr_rdata_id;
+assign tb_rf_we = {
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_alu_we_fw && !x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_alu_waddr_fw[5],
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_we_wb && !x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_waddr_fw_wb_o[5]
+};
+assign tb_rf_waddr = {
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_alu_waddr_fw[4:0],
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_waddr_fw_wb_o[4:0]
+};
+assign tb_rf_wdata = {
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_alu_wdata_fw,
+  x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_i.${core}.regfile_wdata
+};
+% endif
+
+// Outstanding transactions of each master, in order: the OBI responses come back in order
+logic [31:0] tb_trace_bus_addr [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER][TB_TRACE_OUTSTANDING];
+logic [31:0] tb_trace_bus_wdata[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER][TB_TRACE_OUTSTANDING];
+logic [ 4:0] tb_trace_bus_we_be[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER][TB_TRACE_OUTSTANDING];
+longint      tb_trace_bus_start[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER][TB_TRACE_OUTSTANDING];
+int          tb_trace_bus_stall[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER][TB_TRACE_OUTSTANDING];
+int          tb_trace_bus_wr_ptr[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER];
+int          tb_trace_bus_rd_ptr[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER];
+longint      tb_trace_bus_req_start[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER];
+bit          tb_trace_bus_req_pending[core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER];
+
+always @(posedge x_heep_system_i.core_v_mini_mcu_i.clk_i) begin : proc_tb_exec_trace
+  if (tb_exec_trace_en[0]) begin
+    if (tb_perf_instr_retired) tb_exec_trace_instr(tb_perf_cycles, tb_retire_pc, tb_retire_instr);
+    for (int i = 0; i < 2; i++) begin
+      if (tb_rf_we[i] && tb_rf_waddr[i] != 0) tb_exec_trace_reg(tb_perf_cycles, tb_rf_waddr[i], tb_rf_wdata[i]);
+    end
+  end
+
+  if (tb_exec_trace_en[1]) begin
+    for (int m = 0; m < core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER; m++) begin
+      automatic obi_req_t req = x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_req_i[m];
+      automatic obi_resp_t resp = x_heep_system_i.core_v_mini_mcu_i.system_bus_i.system_xbar_i.master_resp_o[m];
+      automatic int rd = tb_trace_bus_rd_ptr[m] % TB_TRACE_OUTSTANDING;
+      automatic int wr = tb_trace_bus_wr_ptr[m] % TB_TRACE_OUTSTANDING;
+
+      if (resp.rvalid && tb_trace_bus_rd_ptr[m] != tb_trace_bus_wr_ptr[m]) begin
+        tb_exec_trace_bus(tb_perf_cycles, m, tb_trace_bus_addr[m][rd], tb_trace_bus_we_be[m][rd][4],
+                          tb_trace_bus_we_be[m][rd][3:0],
+                          tb_trace_bus_we_be[m][rd][4] ? tb_trace_bus_wdata[m][rd] : resp.rdata,
+                          tb_trace_bus_stall[m][rd], int'(tb_perf_cycles - tb_trace_bus_start[m][rd]));
+        tb_trace_bus_rd_ptr[m]++;
+      end
+
+      if (req.req && !tb_trace_bus_req_pending[m]) begin
+        tb_trace_bus_req_pending[m] = 1'b1;
+        tb_trace_bus_req_start[m]   = tb_perf_cycles;
+      end
+      if (req.req && resp.gnt && tb_trace_bus_wr_ptr[m] - tb_trace_bus_rd_ptr[m] < TB_TRACE_OUTSTANDING) begin
+        tb_trace_bus_addr[m][wr]  = req.addr;
+        tb_trace_bus_wdata[m][wr] = req.wdata;
+        tb_trace_bus_we_be[m][wr] = {req.we, req.be};
+        tb_trace_bus_start[m][wr] = tb_trace_bus_req_start[m];
+        tb_trace_bus_stall[m][wr] = int'(tb_perf_cycles - tb_trace_bus_req_start[m]);
+        tb_trace_bus_req_pending[m] = 1'b0;
+        tb_trace_bus_wr_ptr[m]++;
+      end
+    end
+  end
+end
+
 task tb_set_exit_loop;
 `ifdef VCS
   force x_heep_system_i.core_v_mini_mcu_i.ao_peripheral_subsystem_i.soc_ctrl_i.testbench_set_exit_loop[0] = 1'b1;
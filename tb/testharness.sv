@@ -11,6 +11,7 @@ module testharness #(
     parameter FPU                         = 0,
     parameter ZFINX                       = 0,
     parameter X_EXT                       = 0,         // eXtension interface in cv32e40x
+    parameter X_COPROC                    = 0,         // Its coprocessor: 0 fpu_ss, 1 xif_coproc
     parameter JTAG_DPI                    = 0,
     parameter USE_EXTERNAL_DEVICE_EXAMPLE = 1,
     parameter CLK_FREQUENCY               = 'd100_000  //KHz
@@ -76,6 +77,7 @@ module testharness #(
 
   logic iffifo_in_ready, iffifo_out_valid;
   logic iffifo_int_o;
+  logic ams_sample_valid, ams_intr;
 
   // External xbar master/slave and peripheral ports
   obi_req_t [EXT_XBAR_NMASTER_RND-1:0] ext_master_req;
@@ -88,12 +90,12 @@ module testharness #(
   obi_resp_t heep_core_data_resp;
   obi_req_t heep_debug_master_req;
   obi_resp_t heep_debug_master_resp;
-  obi_req_t heep_dma_read_ch0_req;
-  obi_resp_t heep_dma_read_ch0_resp;
-  obi_req_t heep_dma_write_ch0_req;
-  obi_resp_t heep_dma_write_ch0_resp;
-  obi_req_t heep_dma_addr_ch0_req;
-  obi_resp_t heep_dma_addr_ch0_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_read_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_read_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_write_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_write_resp;
+  obi_req_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_addr_req;
+  obi_resp_t [core_v_mini_mcu_pkg::DMA_CH_NUM-1:0] heep_dma_addr_resp;
   obi_req_t [EXT_XBAR_NSLAVE-1:0] ext_slave_req;
   obi_resp_t [EXT_XBAR_NSLAVE-1:0] ext_slave_resp;
   reg_req_t periph_slave_req;
@@ -136,6 +138,7 @@ module testharness #(
     // Re-assign the interrupt lines used here
     intr_vector_ext[0] = memcopy_intr;
     intr_vector_ext[1] = iffifo_int_o;
+    intr_vector_ext[2] = ams_intr;
   end
 
   //log parameters
@@ -144,6 +147,7 @@ module testharness #(
     $display("%t: the parameter FPU is %x", $time, FPU);
     $display("%t: the parameter ZFINX is %x", $time, ZFINX);
     $display("%t: the parameter X_EXT is %x", $time, X_EXT);
+    $display("%t: the parameter X_COPROC is %x", $time, X_COPROC);
     $display("%t: the parameter ZFINX is %x", $time, ZFINX);
     $display("%t: the parameter JTAG_DPI is %x", $time, JTAG_DPI);
     $display("%t: the parameter USE_EXTERNAL_DEVICE_EXAMPLE is %x", $time,
@@ -240,12 +244,12 @@ module testharness #(
       .ext_core_data_resp_i(heep_core_data_resp),
       .ext_debug_master_req_o(heep_debug_master_req),
       .ext_debug_master_resp_i(heep_debug_master_resp),
-      .ext_dma_read_ch0_req_o(heep_dma_read_ch0_req),
-      .ext_dma_read_ch0_resp_i(heep_dma_read_ch0_resp),
-      .ext_dma_write_ch0_req_o(heep_dma_write_ch0_req),
-      .ext_dma_write_ch0_resp_i(heep_dma_write_ch0_resp),
-      .ext_dma_addr_ch0_req_o(heep_dma_addr_ch0_req),
-      .ext_dma_addr_ch0_resp_i(heep_dma_addr_ch0_resp),
+      .ext_dma_read_req_o(heep_dma_read_req),
+      .ext_dma_read_resp_i(heep_dma_read_resp),
+      .ext_dma_write_req_o(heep_dma_write_req),
+      .ext_dma_write_resp_i(heep_dma_write_resp),
+      .ext_dma_addr_req_o(heep_dma_addr_req),
+      .ext_dma_addr_resp_i(heep_dma_addr_resp),
       .ext_peripheral_slave_req_o(periph_slave_req),
       .ext_peripheral_slave_resp_i(periph_slave_rsp),
       .external_subsystem_powergate_switch_no(external_subsystem_powergate_switch_n),
@@ -255,7 +259,9 @@ module testharness #(
       .external_ram_banks_set_retentive_no(external_ram_banks_set_retentive_n),
       .external_subsystem_clkgate_en_no(external_subsystem_clkgate_en_n),
       .ext_dma_slot_tx_i(iffifo_in_ready),
-      .ext_dma_slot_rx_i(iffifo_out_valid)
+      // the IFFIFO output and the AMS samples share the external RX slot,
+      // the AMS only sets it while its periodic sampling is enabled
+      .ext_dma_slot_rx_i(iffifo_out_valid | ams_sample_valid)
   );
 
   // Testbench external bus
@@ -276,12 +282,12 @@ module testharness #(
       .heep_core_data_resp_o    (heep_core_data_resp),
       .heep_debug_master_req_i  (heep_debug_master_req),
       .heep_debug_master_resp_o (heep_debug_master_resp),
-      .heep_dma_read_ch0_req_i  (heep_dma_read_ch0_req),
-      .heep_dma_read_ch0_resp_o (heep_dma_read_ch0_resp),
-      .heep_dma_write_ch0_req_i (heep_dma_write_ch0_req),
-      .heep_dma_write_ch0_resp_o(heep_dma_write_ch0_resp),
-      .heep_dma_addr_ch0_req_i  (heep_dma_addr_ch0_req),
-      .heep_dma_addr_ch0_resp_o (heep_dma_addr_ch0_resp),
+      .heep_dma_read_req_i      (heep_dma_read_req),
+      .heep_dma_read_resp_o     (heep_dma_read_resp),
+      .heep_dma_write_req_i     (heep_dma_write_req),
+      .heep_dma_write_resp_o    (heep_dma_write_resp),
+      .heep_dma_addr_req_i      (heep_dma_addr_req),
+      .heep_dma_addr_resp_o     (heep_dma_addr_resp),
       .ext_master_req_i         (ext_master_req),
       .ext_master_resp_o        (ext_master_resp),
       .heep_slave_req_o         (heep_slave_req),
@@ -336,6 +342,27 @@ module testharness #(
 `endif
   end
 
+  // cycle-accurate log of the power transitions, in power_monitor.log
+  power_monitor #(
+      .NUM_BANKS(core_v_mini_mcu_pkg::NUM_BANKS)
+  ) power_monitor_i (
+      .clk_i,
+      .rst_ni,
+      .core_sleep_i(x_heep_system_i.core_v_mini_mcu_i.core_sleep),
+      .cpu_switch_ni(x_heep_system_i.cpu_subsystem_powergate_switch_n),
+      .cpu_switch_ack_ni(delayed_tb_cpu_subsystem_powergate_switch_ack_n),
+      .cpu_iso_ni(x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_powergate_iso_n),
+      .cpu_rst_ni(x_heep_system_i.core_v_mini_mcu_i.cpu_subsystem_rst_n),
+      .periph_switch_ni(x_heep_system_i.peripheral_subsystem_powergate_switch_n),
+      .periph_switch_ack_ni(delayed_tb_peripheral_subsystem_powergate_switch_ack_n),
+      .periph_iso_ni(x_heep_system_i.core_v_mini_mcu_i.peripheral_subsystem_powergate_iso_n),
+      .periph_rst_ni(x_heep_system_i.core_v_mini_mcu_i.peripheral_subsystem_rst_n),
+      .ram_switch_ni(x_heep_system_i.memory_subsystem_banks_powergate_switch_n),
+      .ram_switch_ack_ni(delayed_tb_memory_subsystem_banks_powergate_switch_ack_n),
+      .ram_iso_ni(x_heep_system_i.core_v_mini_mcu_i.memory_subsystem_banks_powergate_iso_n),
+      .ram_retentive_ni(x_heep_system_i.core_v_mini_mcu_i.memory_subsystem_banks_set_retentive_n)
+  );
+
 
   uartdpi #(
       .BAUD('d256000),
@@ -383,8 +410,11 @@ module testharness #(
       obi_pkg::obi_req_t  slave_fifoout_req;
       obi_pkg::obi_resp_t slave_fifoout_resp;
 
-      //this FIFO makes the slow memory even more slower in terms of latency
-      obi_fifo obi_fifo_i (
+      //this FIFO makes the slow memory even more slower in terms of latency,
+      //but grants the next requests while the slow memory is busy
+      obi_fifo #(
+          .DEPTH(core_v_mini_mcu_pkg::BUS_MAX_OUTSTANDING)
+      ) obi_fifo_i (
           .clk_i,
           .rst_ni,
           .producer_req_i (slow_ram_slave_req),
@@ -394,15 +424,20 @@ module testharness #(
       );
 
       // External xbar slave memory example
+`ifndef TB_IP_MODELS
       slow_memory #(
-          .NumWords (128),
+`else
+      // modelled in C++ (tb/tb_ip_models.cpp)
+      slow_memory_dpi #(
+`endif
+          .NumWords (SLOW_MEMORY_NUM_WORDS),
           .DataWidth(32'd32)
       ) slow_ram_i (
           .clk_i,
           .rst_ni,
           .req_i(slave_fifoout_req.req),
           .we_i(slave_fifoout_req.we),
-          .addr_i(slave_fifoout_req.addr[8:2]),
+          .addr_i(slave_fifoout_req.addr[SLOW_MEMORY_ADDR_WIDTH+1:2]),
           .wdata_i(slave_fifoout_req.wdata),
           .be_i(slave_fifoout_req.be),
           // output ports
@@ -432,6 +467,7 @@ module testharness #(
           .dma_addr_ch0_req_o(),
           .dma_addr_ch0_resp_i('0),
           .trigger_slot_i('0),
+          .gpio_i('0),
           .dma_done_intr_o(memcopy_intr),
           .dma_window_intr_o()
       );
@@ -444,11 +480,18 @@ module testharness #(
           .clk_i,
           .rst_ni,
           .reg_req_i(ext_periph_slv_req[testharness_pkg::AMS_IDX]),
-          .reg_rsp_o(ext_periph_slv_rsp[testharness_pkg::AMS_IDX])
+          .reg_rsp_o(ext_periph_slv_rsp[testharness_pkg::AMS_IDX]),
+          .ams_sample_valid_o(ams_sample_valid),
+          .ams_intr_o(ams_intr)
       );
 
       // InterFaced FIFO (IFFIFO) external peripheral
+`ifndef TB_IP_MODELS
       iffifo #(
+`else
+      // modelled in C++ (tb/tb_ip_models.cpp)
+      iffifo_dpi #(
+`endif
           .reg_req_t(reg_pkg::reg_req_t),
           .reg_rsp_t(reg_pkg::reg_rsp_t)
       ) iffifo_i (
@@ -463,6 +506,17 @@ module testharness #(
           .iffifo_int_o(iffifo_int_o)
       );
 
+      // Simulation console, used by the firmware built with SIM_CONSOLE=1
+      sim_console #(
+          .reg_req_t(reg_pkg::reg_req_t),
+          .reg_rsp_t(reg_pkg::reg_rsp_t)
+      ) sim_console_i (
+          .clk_i,
+          .rst_ni,
+          .reg_req_i(ext_periph_slv_req[testharness_pkg::SIM_CONSOLE_IDX]),
+          .reg_rsp_o(ext_periph_slv_rsp[testharness_pkg::SIM_CONSOLE_IDX])
+      );
+
       addr_decode #(
           .NoIndices(testharness_pkg::EXT_NPERIPHERALS),
           .NoRules(testharness_pkg::EXT_NPERIPHERALS),
@@ -502,7 +556,12 @@ module testharness #(
           .gpio_o(gpio[31])
       );
 
+`ifndef TB_IP_MODELS
       pdm2pcm_dummy pdm2pcm_dummy_i (
+`else
+      // modelled in C++ (tb/tb_ip_models.cpp)
+      pdm2pcm_dummy_dpi pdm2pcm_dummy_i (
+`endif
           .clk_i,
           .rst_ni,
           .pdm_data_o(gpio[18]),
@@ -527,6 +586,16 @@ module testharness #(
           .io2(spi_flash_sd_io[2]),
           .io3(spi_flash_sd_io[3])
       );
+`else
+      // Flash used for booting, modelled in C++ (tb/tb_spi_flash.cpp)
+      spi_flash_dpi flash_boot_i (
+          .csb(spi_flash_csb[0]),
+          .clk(spi_flash_sck),
+          .io0(spi_flash_sd_io[0]),  // MOSI
+          .io1(spi_flash_sd_io[1]),  // MISO
+          .io2(spi_flash_sd_io[2]),
+          .io3(spi_flash_sd_io[3])
+      );
 `endif
 
 `ifndef VERILATOR
@@ -541,7 +610,7 @@ module testharness #(
       );
 `endif
 
-      if ((core_v_mini_mcu_pkg::CpuType == cv32e40x || core_v_mini_mcu_pkg::CpuType == cv32e40px) && X_EXT != 0) begin: gen_fpu_ss_wrapper
+      if ((core_v_mini_mcu_pkg::CpuType == cv32e40x || core_v_mini_mcu_pkg::CpuType == cv32e40px) && X_EXT != 0 && X_COPROC == 0) begin: gen_fpu_ss_wrapper
         fpu_ss_wrapper #(
             .PULP_ZFINX(ZFINX),
             .INPUT_BUFFER_DEPTH(1),
@@ -554,6 +623,24 @@ module testharness #(
             .clk_i,
             .rst_ni,
 
+            // eXtension Interface
+            .xif_compressed_if(ext_if),
+            .xif_issue_if(ext_if),
+            .xif_commit_if(ext_if),
+            .xif_mem_if(ext_if),
+            .xif_mem_result_if(ext_if),
+            .xif_result_if(ext_if)
+        );
+      end else if ((core_v_mini_mcu_pkg::CpuType == cv32e40x || core_v_mini_mcu_pkg::CpuType == cv32e40px) && X_EXT != 0) begin: gen_xif_coproc
+        xif_coproc #(
+            .X_ID_WIDTH(fpu_ss_pkg::X_ID_WIDTH),
+            .EXEC_CYCLES(0),
+            .MEM_EN(1'b1)
+        ) xif_coproc_i (
+            // Clock and reset
+            .clk_i,
+            .rst_ni,
+
             // eXtension Interface
             .xif_compressed_if(ext_if),
             .xif_issue_if(ext_if),
@@ -7,29 +7,23 @@ package testharness_pkg;
   import addr_map_rule_pkg::*;
   import core_v_mini_mcu_pkg::*;
 
-  localparam EXT_XBAR_NMASTER = 2;
-  localparam EXT_XBAR_NSLAVE = 1;
+  // External crossbar, generated from the ext_slaves entry of mcu_cfg.hjson
+  localparam EXT_XBAR_NMASTER = core_v_mini_mcu_pkg::EXT_NMASTER;
+  localparam EXT_XBAR_NSLAVE = core_v_mini_mcu_pkg::EXT_NSLAVE;
 
   //master idx
-  localparam logic [31:0] EXT_MASTER0_IDX = 0;
-  localparam logic [31:0] EXT_MASTER1_IDX = 1;
+  localparam logic [31:0] EXT_MASTER0_IDX = core_v_mini_mcu_pkg::EXT_MASTER_MEMCOPY_READ_IDX;
+  localparam logic [31:0] EXT_MASTER1_IDX = core_v_mini_mcu_pkg::EXT_MASTER_MEMCOPY_WRITE_IDX;
 
   //slave mmap and idx
-  localparam logic [31:0] SLOW_MEMORY_START_ADDRESS = core_v_mini_mcu_pkg::EXT_SLAVE_START_ADDRESS;
-  localparam logic [31:0] SLOW_MEMORY_SIZE = 32'h200;
-  localparam logic [31:0] SLOW_MEMORY_END_ADDRESS = SLOW_MEMORY_START_ADDRESS + SLOW_MEMORY_SIZE;
-  localparam logic [31:0] SLOW_MEMORY_IDX = 32'd0;
+  localparam logic [31:0] SLOW_MEMORY_IDX = core_v_mini_mcu_pkg::SLOW_MEMORY_IDX;
+  localparam int unsigned SLOW_MEMORY_NUM_WORDS = core_v_mini_mcu_pkg::SLOW_MEMORY_SIZE / 4;
+  localparam int unsigned SLOW_MEMORY_ADDR_WIDTH = $clog2(SLOW_MEMORY_NUM_WORDS);
 
-  localparam addr_map_rule_t [EXT_XBAR_NSLAVE-1:0] EXT_XBAR_ADDR_RULES = '{
-      '{
-          idx: SLOW_MEMORY_IDX,
-          start_addr: SLOW_MEMORY_START_ADDRESS,
-          end_addr: SLOW_MEMORY_END_ADDRESS
-      }
-  };
+  localparam addr_map_rule_t [EXT_XBAR_NSLAVE-1:0] EXT_XBAR_ADDR_RULES = core_v_mini_mcu_pkg::EXT_SLAVE_ADDR_RULES;
 
   //slave encoder
-  localparam EXT_NPERIPHERALS = 3;
+  localparam EXT_NPERIPHERALS = 4;
 
   // Memcopy controller (external peripheral example)
   localparam logic [31:0] MEMCOPY_CTRL_START_ADDRESS = core_v_mini_mcu_pkg::EXT_PERIPHERAL_START_ADDRESS + 32'h0;
@@ -49,6 +43,12 @@ package testharness_pkg;
   localparam logic [31:0] IFFIFO_END_ADDRESS = IFFIFO_START_ADDRESS + IFFIFO_SIZE;
   localparam logic [31:0] IFFIFO_IDX = 32'd2;
 
+  // Simulation console, printing on the simulator stdout without the UART
+  localparam logic [31:0] SIM_CONSOLE_START_ADDRESS = core_v_mini_mcu_pkg::EXT_PERIPHERAL_START_ADDRESS + 32'h003000;
+  localparam logic [31:0] SIM_CONSOLE_SIZE = 32'h10;
+  localparam logic [31:0] SIM_CONSOLE_END_ADDRESS = SIM_CONSOLE_START_ADDRESS + SIM_CONSOLE_SIZE;
+  localparam logic [31:0] SIM_CONSOLE_IDX = 32'd3;
+
 
   localparam addr_map_rule_t [EXT_NPERIPHERALS-1:0] EXT_PERIPHERALS_ADDR_RULES = '{
       '{
@@ -57,7 +57,12 @@ package testharness_pkg;
           end_addr: MEMCOPY_CTRL_END_ADDRESS
       },
       '{idx: AMS_IDX, start_addr: AMS_START_ADDRESS, end_addr: AMS_END_ADDRESS},
-      '{idx: IFFIFO_IDX, start_addr: IFFIFO_START_ADDRESS, end_addr: IFFIFO_END_ADDRESS}
+      '{idx: IFFIFO_IDX, start_addr: IFFIFO_START_ADDRESS, end_addr: IFFIFO_END_ADDRESS},
+      '{
+          idx: SIM_CONSOLE_IDX,
+          start_addr: SIM_CONSOLE_START_ADDRESS,
+          end_addr: SIM_CONSOLE_END_ADDRESS
+      }
   };
 
   localparam int unsigned EXT_PERIPHERALS_PORT_SEL_WIDTH = EXT_NPERIPHERALS > 1 ? $clog2(
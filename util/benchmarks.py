@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+# Copyright 2026 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Runs the coremark and embench apps in Verilator for each core and compiler
+# and reports their scores and code sizes. CoreMark and Embench-IoT must be
+# vendored first:
+#
+#   util/vendor.py sw/vendor/eembc_coremark.vendor.hjson
+#   util/vendor.py sw/vendor/embench_iot.vendor.hjson
+#
+# For each core the MCU is generated and the model built, then each
+# benchmark is built with each compiler and run. The scores are per MHz, from
+# the cycles of the timed parts:
+#
+#   CoreMark/MHz = Iterations * 10^6 / Total ticks
+#   Embench speed = baseline ms * 1000 / cycles (relative to the baseline
+#                   core of Embench at 1 MHz), and their geometric mean
+#
+# The code size of each run is the text and data of main.elf: it includes the
+# runtime and the drivers linked with the benchmark, so it tracks the changes
+# of the compilers rather than compares with published numbers.
+#
+# Usage, from the root of the repository:
+#   util/benchmarks.py [--cpus cv32e20 cv32e40p] [--compilers gcc clang]
+#                      [--embench crc32 edn] [--max-sim-time N]
+
+import argparse
+import csv
+import json
+import math
+import os
+import shutil
+import subprocess
+import sys
+
+SIM_DIR = "build/openhwgroup.org_systems_core-v-mini-mcu_0/sim-verilator"
+BENCH_DIR = "build/benchmarks"
+EMBENCH_DIR = "sw/vendor/embench_iot"
+CORE_TYPES = ("cv32e20", "cv32e40p", "cv32e40x", "cv32e40px")
+COMPILERS = ("gcc", "clang")
+# The subset of Embench-IoT built by the embench app
+EMBENCH = ("aha-mont64", "crc32", "edn", "huffbench", "matmult-int", "nettle-aes",
+           "nettle-sha256", "nsichneu", "sglib-combined", "slre", "statemate", "ud")
+
+
+def run(cmd, **kwargs):
+    print("+ " + " ".join(cmd), flush=True)
+    subprocess.run(cmd, check=True, **kwargs)
+
+
+def run_app(project, compiler, cflags, name, args):
+    make = ["make", "--no-print-directory", "-s"]
+    run(make + ["app", "PROJECT=" + project, "COMPILER=" + compiler, "APP_CFLAGS=" + cflags])
+    size = code_size()
+    run(["./Vtestharness", "+firmware=../../../sw/build/main.hex",
+         "+max_sim_time=%d" % args.max_sim_time],
+        cwd=SIM_DIR, stdout=subprocess.DEVNULL)
+    log = os.path.join(BENCH_DIR, name + ".log")
+    shutil.copy(os.path.join(SIM_DIR, "uart0.log"), log)
+    return log, size
+
+
+def code_size():
+    riscv = os.environ.get("RISCV", "")
+    prefix = os.environ.get("COMPILER_PREFIX", "riscv32-unknown-")
+    out = subprocess.run([os.path.join(riscv, "bin", prefix + "elf-size"), "sw/build/main.elf"],
+                         check=True, capture_output=True, text=True).stdout
+    text, data = out.splitlines()[1].split()[0:2]
+    return int(text), int(data)
+
+
+def parse_coremark(path):
+    iterations = ticks = None
+    errors = []
+    with open(path) as f:
+        for line in f:
+            key, _, value = line.partition(":")
+            if key.strip() == "Iterations":
+                iterations = int(value)
+            elif key.strip() == "Total ticks":
+                ticks = int(value)
+            # The runs are shorter than the 10 s of the run rules, only the
+            # errors of the CRCs invalidate the results
+            elif "ERROR!" in line and "10 secs" not in line:
+                errors.append(line.strip())
+    if iterations is None or ticks is None:
+        sys.exit("No CoreMark result in " + path)
+    return iterations, ticks, not errors
+
+
+def parse_embench(path):
+    with open(path) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if fields[0] == "EMBENCH":
+                return int(fields[2]), fields[3] == "1"
+    sys.exit("No EMBENCH result in " + path)
+
+
+def embench_baselines():
+    # The baseline times in ms of each benchmark, wherever they are nested
+    with open(os.path.join(EMBENCH_DIR, "baseline-data", "speed.json")) as f:
+        data = json.load(f)
+    todo = [data]
+    while todo:
+        d = todo.pop()
+        if all(b in d for b in EMBENCH):
+            return {b: float(d[b]) for b in EMBENCH}
+        todo += [v for v in d.values() if isinstance(v, dict)]
+    sys.exit("No baseline of the Embench benchmarks in " + EMBENCH_DIR)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run CoreMark and Embench-IoT on each core.")
+    parser.add_argument("--cfg", default="mcu_cfg.hjson", help="MCU configuration")
+    parser.add_argument("--cpus", nargs="+", default=CORE_TYPES, choices=CORE_TYPES,
+                        help="cores to benchmark")
+    parser.add_argument("--compilers", nargs="+", default=COMPILERS, choices=COMPILERS,
+                        help="compilers of the benchmarks")
+    parser.add_argument("--embench", nargs="+", default=EMBENCH, choices=EMBENCH,
+                        help="benchmarks of Embench-IoT to run")
+    parser.add_argument("--max-sim-time", type=int, default=100000000,
+                        help="clock edges simulated at most per run")
+    args = parser.parse_args()
+
+    os.makedirs(BENCH_DIR, exist_ok=True)
+    baselines = embench_baselines()
+
+    rows = []
+    make = ["make", "--no-print-directory", "-s"]
+    for cpu in args.cpus:
+        run(make + ["mcu-gen", "CPU=" + cpu, "MCU_CFG=" + args.cfg])
+        run(make + ["verilator-sim-cached"], stdout=subprocess.DEVNULL)
+        for compiler in args.compilers:
+            log, size = run_app("coremark", compiler, "", "%s-%s-coremark" % (cpu, compiler), args)
+            iterations, ticks, correct = parse_coremark(log)
+            rows.append({"cpu": cpu, "compiler": compiler, "benchmark": "coremark",
+                         "cycles": ticks, "score": iterations * 1e6 / ticks,
+                         "correct": correct, "text": size[0], "data": size[1]})
+            for bench in args.embench:
+                define = "-DEMBENCH_" + bench.upper().replace("-", "_")
+                log, size = run_app("embench", compiler, define,
+                                    "%s-%s-%s" % (cpu, compiler, bench), args)
+                cycles, correct = parse_embench(log)
+                rows.append({"cpu": cpu, "compiler": compiler, "benchmark": bench,
+                             "cycles": cycles, "score": baselines[bench] * 1000 / cycles,
+                             "correct": correct, "text": size[0], "data": size[1]})
+
+    with open(os.path.join(BENCH_DIR, "results.csv"), "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+
+    lines = ["| Core | Compiler | Benchmark | Cycles | Score/MHz | Correct | Text (B) | Data (B) |",
+             "| ---- | -------- | --------- | ------ | --------- | ------- | -------- | -------- |"]
+    for r in rows:
+        lines.append("| %s | %s | %s | %d | %.3f | %s | %d | %d |" % (
+            r["cpu"], r["compiler"], r["benchmark"], r["cycles"], r["score"],
+            "yes" if r["correct"] else "NO", r["text"], r["data"]))
+
+    lines.append("")
+    lines.append("| Core | Compiler | CoreMark/MHz | Embench speed/MHz (geometric mean) |")
+    lines.append("| ---- | -------- | ------------ | ---------------------------------- |")
+    for cpu in args.cpus:
+        for compiler in args.compilers:
+            runs = [r for r in rows if r["cpu"] == cpu and r["compiler"] == compiler]
+            coremark = [r["score"] for r in runs if r["benchmark"] == "coremark"][0]
+            speeds = [r["score"] for r in runs if r["benchmark"] != "coremark"]
+            mean = math.exp(sum(map(math.log, speeds)) / len(speeds)) if speeds else 0
+            lines.append("| %s | %s | %.3f | %.3f |" % (cpu, compiler, coremark, mean))
+
+    report = "\n".join(lines)
+    print("\n" + report)
+    with open(os.path.join(BENCH_DIR, "report.md"), "w") as f:
+        f.write(report + "\n")
+
+    if not all(r["correct"] for r in rows):
+        sys.exit("Some benchmarks failed their checks")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# Copyright 2026 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Runs example_bus_bench in Verilator with the onetoM and the NtoM bus types
+# and recommends one of them. For each bus type the MCU is generated, the
+# model built and the app run; the BUS_BENCH lines of uart0.log give, for
+# each phase (CPU streaming, DMA copy, external master copy and their
+# combinations), the cycles, the throughput and the wait cycles and average
+# latency of the masters.
+#
+# The area of the system crossbar is estimated from its structure, not
+# synthesized: the request multiplexers of the arbiters (69 bits: we, be,
+# addr, wdata), the response multiplexers (32 bits of rdata) and the address
+# comparators of the decoders, with a 2-input multiplexer counted as 2 gate
+# equivalents (GE) and a comparator bit as 1 GE. It only compares the two
+# topologies; synthesize the design (make asic) for absolute numbers.
+#
+# NtoM is recommended when it shortens the phases with concurrent masters
+# by at least --min-gain on average.
+#
+# Usage, from the root of the repository:
+#   util/bus_bench.py [--banks 6] [--min-gain 0.1] [--max-sim-time N]
+
+import argparse
+import math
+import os
+import shutil
+import subprocess
+import sys
+
+import hjson
+
+SIM_DIR = "build/openhwgroup.org_systems_core-v-mini-mcu_0/sim-verilator"
+BENCH_DIR = "build/bus_bench"
+BUS_TYPES = ("onetoM", "NtoM")
+
+REQ_WIDTH = 1 + 4 + 32 + 32
+RESP_WIDTH = 32
+ADDR_WIDTH = 32
+MUX2_GE = 2
+# Masters of the testbench on ext_xbar (the memcopy controller)
+EXT_MASTERS = 2
+
+FIELDS = ("cycles", "bytes", "cpu_waits", "cpu_latency", "dma_waits",
+          "dma_latency", "ext_waits", "ext_latency")
+
+
+def run(cmd, **kwargs):
+    print("+ " + " ".join(cmd), flush=True)
+    subprocess.run(cmd, check=True, **kwargs)
+
+
+def run_bus(bus, args):
+    make = ["make", "--no-print-directory", "-s"]
+    run(make + ["mcu-gen", "BUS=" + bus, "MCU_CFG=" + args.cfg,
+                "MEMORY_BANKS=%d" % args.banks, "MEMORY_BANKS_IL=0"])
+    run(make + ["verilator-sim-cached"], stdout=subprocess.DEVNULL)
+    run(make + ["app", "PROJECT=example_bus_bench"])
+    run(["./Vtestharness", "+firmware=../../../sw/build/main.hex",
+         "+max_sim_time=%d" % args.max_sim_time],
+        cwd=SIM_DIR, stdout=subprocess.DEVNULL)
+    log = os.path.join(BENCH_DIR, bus + ".log")
+    shutil.copy(os.path.join(SIM_DIR, "uart0.log"), log)
+    return parse_log(log)
+
+
+def parse_log(path):
+    phases = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if fields[0] != "BUS_BENCH" or fields[1] == "phase":
+                continue
+            phases[fields[1]] = dict(zip(FIELDS, map(int, fields[2:])))
+    if not phases:
+        sys.exit("No BUS_BENCH result in " + path)
+    return phases
+
+
+def crossbar_area(bus, masters, slaves):
+    decoders = masters if bus == "NtoM" else 1
+    if bus == "NtoM":
+        # An arbiter per slave and a response multiplexer per master
+        mux2 = slaves * (masters - 1) * REQ_WIDTH + masters * (slaves - 1) * RESP_WIDTH
+    else:
+        # A single arbiter, then a demultiplexer to the slaves
+        mux2 = (masters - 1) * REQ_WIDTH + (slaves - 1) * RESP_WIDTH
+    comparators = decoders * slaves * 2 * ADDR_WIDTH
+    return mux2 * MUX2_GE + comparators
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the onetoM and NtoM bus types.")
+    parser.add_argument("--cfg", default="mcu_cfg.hjson", help="MCU configuration")
+    parser.add_argument("--banks", type=int, default=6,
+                        help="contiguous memory banks, at least 6 to give each master its banks")
+    parser.add_argument("--min-gain", type=float, default=0.1,
+                        help="fraction of cycles NtoM must save on the concurrent phases")
+    parser.add_argument("--max-sim-time", type=int, default=20000000,
+                        help="clock edges simulated at most")
+    args = parser.parse_args()
+
+    os.makedirs(BENCH_DIR, exist_ok=True)
+
+    with open(args.cfg) as f:
+        cfg = hjson.load(f)
+    dma_channels = int(str(cfg["ao_peripherals"]["dma"]["num_channels"]), 0)
+    masters = 3 + 3 * dma_channels + EXT_MASTERS
+    slaves = args.banks + 5
+
+    results = {bus: run_bus(bus, args) for bus in BUS_TYPES}
+    area = {bus: crossbar_area(bus, masters, slaves) for bus in BUS_TYPES}
+
+    lines = ["| Phase | Bus | Cycles | B/cycle | CPU waits | CPU latency | DMA waits | DMA latency | Ext waits | Ext latency |",
+             "| ----- | --- | ------ | ------- | --------- | ----------- | --------- | ----------- | --------- | ----------- |"]
+    for phase in results[BUS_TYPES[0]]:
+        for bus in BUS_TYPES:
+            r = results[bus].get(phase)
+            if r is None:
+                continue
+            lines.append("| %s | %s | %d | %.2f | %d | %.2f | %d | %.2f | %d | %.2f |" % (
+                phase, bus, r["cycles"], r["bytes"] / max(r["cycles"], 1),
+                r["cpu_waits"], r["cpu_latency"] / 100, r["dma_waits"], r["dma_latency"] / 100,
+                r["ext_waits"], r["ext_latency"] / 100))
+
+    # Geometric mean of the cycles saved on the phases with several masters
+    ratios = [results["NtoM"][p]["cycles"] / results["onetoM"][p]["cycles"]
+              for p in results["onetoM"] if "+" in p and p in results["NtoM"]]
+    gain = 1 - math.exp(sum(map(math.log, ratios)) / len(ratios)) if ratios else 0
+
+    lines.append("")
+    lines.append("Crossbar of %d masters and %d slaves, estimated area: %s" % (
+        masters, slaves, ", ".join("%s %.1f kGE" % (bus, area[bus] / 1000) for bus in BUS_TYPES)))
+    lines.append("NtoM saves %.1f%% of the cycles of the concurrent phases for %.1fx the crossbar area" % (
+        100 * gain, area["NtoM"] / area["onetoM"]))
+    lines.append("Recommended bus_type: %s" % ("NtoM" if gain >= args.min_gain else "onetoM"))
+
+    report = "\n".join(lines)
+    print("\n" + report)
+    with open(os.path.join(BENCH_DIR, "report.md"), "w") as f:
+        f.write(report + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+# Copyright 2026 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Design-space exploration over the configurations of the MCU: every point of
+# the grid of cores, bus types, contiguous banks and interleaved banks is
+# generated with make mcu-gen, its model built through the cache of models
+# (make verilator-sim-cached) and the apps built against its header and
+# linker scripts. The generated files are shared by all the points, so the
+# points are prepared one after the other, each in build/dse/<point> with its
+# model and firmware; the runs of the apps are then independent and run in
+# parallel (--jobs), while the next points are prepared.
+#
+# Each run gives the cycles and the instructions of the performance report of
+# the testbench (+perf_report), and with --energy <table> the total energy of
+# the energy report (+energy, see tb/tb_energy.h). The area is only a proxy:
+# the estimate of the crossbar of util/bus_bench.py, the bytes of RAM of the
+# point from its core_v_mini_mcu.h and, with --core-area <table>, the area of
+# the core from a table of '<cpu> <area>' lines, e.g. in kGE from synthesis.
+# All of them land in build/dse/results.csv and build/dse/report.md.
+#
+# Usage, from the root of the repository (make dse):
+#   util/dse_sweep.py --apps hello_world example_matadd [--cpus cv32e20 cv32e40p]
+#                     [--buses onetoM NtoM] [--banks 2 4] [--banks-il 0 4]
+#                     [--energy energy.txt] [--core-area area.txt] [--jobs N]
+
+import argparse
+import concurrent.futures
+import csv
+import itertools
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+import hjson
+
+from bus_bench import EXT_MASTERS, crossbar_area
+from size_report import load_regions
+
+SIM_DIR = "build/openhwgroup.org_systems_core-v-mini-mcu_0/sim-verilator"
+DSE_DIR = "build/dse"
+MCU_HEADER = "sw/device/lib/runtime/core_v_mini_mcu.h"
+MODEL = "Vtestharness"
+CORE_TYPES = ("cv32e20", "cv32e40p", "cv32e40x", "cv32e40px")
+BUS_TYPES = ("onetoM", "NtoM")
+MAX_BANKS = 16
+IL_BANKS = (0, 2, 4, 8)
+# Slaves of the system crossbar besides the banks
+OTHER_SLAVES = 5
+
+
+class SweepError(Exception):
+    pass
+
+
+def run(cmd, **kwargs):
+    print("+ " + " ".join(cmd), flush=True)
+    if subprocess.run(cmd, **kwargs).returncode != 0:
+        raise SweepError("failed: " + " ".join(cmd))
+
+
+def load_table(path):
+    table = {}
+    with open(path) as f:
+        for num, line in enumerate(f, 1):
+            fields = line.split("#")[0].split()
+            if not fields:
+                continue
+            if len(fields) != 2:
+                raise SweepError("{}:{}: expected '<name> <value>'".format(path, num))
+            table[fields[0]] = float(fields[1])
+    return table
+
+
+def point_name(cpu, bus, banks, banks_il):
+    return "{}-{}-b{}-il{}".format(cpu, bus, banks, banks_il)
+
+
+def prepare(point, apps, args):
+    """Generates the MCU of a point, builds its model and apps, and returns its RAM bytes."""
+    cpu, bus, banks, banks_il = point
+    out = os.path.join(DSE_DIR, point_name(*point))
+    os.makedirs(out, exist_ok=True)
+    make = ["make", "--no-print-directory", "-s"]
+    run(make + ["mcu-gen", "CPU=" + cpu, "BUS=" + bus, "MCU_CFG=" + args.cfg,
+                "MEMORY_BANKS=%d" % banks, "MEMORY_BANKS_IL=%d" % banks_il],
+        stdout=subprocess.DEVNULL)
+    run(make + ["verilator-sim-cached"], stdout=subprocess.DEVNULL)
+    shutil.copy2(os.path.join(SIM_DIR, MODEL), os.path.join(out, MODEL))
+    for app in apps:
+        run(make + ["app", "PROJECT=" + app], stdout=subprocess.DEVNULL)
+        shutil.copy2("sw/build/main.hex", os.path.join(out, app + ".hex"))
+    ram = [r for r in load_regions(MCU_HEADER) if r[0].startswith("bank") or r[0] == "interleaved"]
+    return sum(size for _, _, size in ram)
+
+
+def simulate(point, app, args):
+    """Runs an app on the model of a point, in a directory of its own."""
+    root = os.path.abspath(os.path.join(DSE_DIR, point_name(*point)))
+    cwd = os.path.join(root, app)
+    os.makedirs(cwd, exist_ok=True)
+    cmd = [os.path.join(root, MODEL), "+firmware=" + os.path.join(root, app + ".hex"),
+           "+max_sim_time=%d" % args.max_sim_time, "+perf_report=perf.json"]
+    if args.energy:
+        cmd += ["+energy=" + os.path.abspath(args.energy), "+energy_report=energy.json"]
+    with open(os.path.join(cwd, "sim.log"), "w") as log:
+        returncode = subprocess.run(cmd, cwd=cwd, stdout=log, stderr=subprocess.STDOUT).returncode
+
+    result = {"exit": None, "cycles": None, "instret": None, "energy": None}
+    with open(os.path.join(cwd, "sim.log"), errors="replace") as f:
+        m = re.search(r"Program Finished with value (\d+)", f.read())
+    if returncode == 0 and m:
+        result["exit"] = int(m.group(1))
+    try:
+        with open(os.path.join(cwd, "perf.json")) as f:
+            perf = json.load(f)
+        result["cycles"], result["instret"] = int(perf["cycles"]), int(perf["instret"])
+        if args.energy:
+            with open(os.path.join(cwd, "energy.json")) as f:
+                result["energy"] = float(json.load(f)["total"])
+    except (OSError, ValueError, KeyError):
+        pass
+    return result
+
+
+def grid(args):
+    points = []
+    for point in itertools.product(args.cpus, args.buses, args.banks, args.banks_il):
+        _, _, banks, banks_il = point
+        if banks < 1 or banks_il not in IL_BANKS or banks + banks_il > MAX_BANKS:
+            print("dse_sweep: skipping {}, at most {} banks with 0, 2, 4 or 8 interleaved".format(
+                point_name(*point), MAX_BANKS))
+            continue
+        points.append(point)
+    return points
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sweep the configurations of the MCU over a set of apps.")
+    parser.add_argument("--cfg", default="mcu_cfg.hjson", help="MCU configuration of the other parameters")
+    parser.add_argument("--apps", nargs="+", required=True, help="apps of sw/applications to run at each point")
+    parser.add_argument("--cpus", nargs="+", default=["cv32e20"], choices=CORE_TYPES, help="cores")
+    parser.add_argument("--buses", nargs="+", default=["onetoM"], choices=BUS_TYPES, help="bus types")
+    parser.add_argument("--banks", nargs="+", type=int, default=[2], help="contiguous memory banks")
+    parser.add_argument("--banks-il", nargs="+", type=int, default=[0], help="interleaved memory banks")
+    parser.add_argument("--energy", help="energy table of the testbench (+energy), to report the energy")
+    parser.add_argument("--core-area", help="table of '<cpu> <area>' lines, to add the area of the cores")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="parallel runs (default: host cores)")
+    parser.add_argument("--max-sim-time", type=int, default=100000000,
+                        help="clock edges simulated at most per run")
+    args = parser.parse_args()
+
+    try:
+        core_area = load_table(args.core_area) if args.core_area else {}
+        with open(args.cfg) as f:
+            cfg = hjson.load(f)
+        dma_channels = int(str(cfg["ao_peripherals"]["dma"]["num_channels"]), 0)
+        masters = 3 + 3 * dma_channels + EXT_MASTERS
+        points = grid(args)
+        if not points:
+            raise SweepError("no valid point in the grid")
+        os.makedirs(DSE_DIR, exist_ok=True)
+
+        # The runs of a point go to the pool as soon as it is prepared
+        rows = []
+        with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+            runs = []
+            for point in points:
+                cpu, bus, banks, banks_il = point
+                ram = prepare(point, args.apps, args)
+                area = {"xbar_kge": crossbar_area(bus, masters, banks + banks_il + OTHER_SLAVES) / 1000,
+                        "ram_bytes": ram, "core_area": core_area.get(cpu)}
+                for app in args.apps:
+                    runs.append((point, app, area, pool.submit(simulate, point, app, args)))
+            for point, app, area, future in runs:
+                cpu, bus, banks, banks_il = point
+                rows.append(dict({"cpu": cpu, "bus": bus, "banks": banks, "banks_il": banks_il,
+                                  "app": app}, **future.result(), **area))
+    except (SweepError, OSError, KeyError, ValueError) as e:
+        sys.exit("dse_sweep: {}".format(e))
+
+    with open(os.path.join(DSE_DIR, "results.csv"), "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+
+    def cell(value, fmt):
+        return fmt % value if value is not None else "-"
+
+    lines = ["| Core | Bus | Banks | Interleaved | App | Exit | Cycles | CPI | Energy | Xbar (kGE) | RAM (KiB) | Core area |",
+             "| ---- | --- | ----- | ----------- | --- | ---- | ------ | --- | ------ | ---------- | --------- | --------- |"]
+    for r in rows:
+        cpi = r["cycles"] / r["instret"] if r["cycles"] is not None and r["instret"] else None
+        lines.append("| %s | %s | %d | %d | %s | %s | %s | %s | %s | %.1f | %d | %s |" % (
+            r["cpu"], r["bus"], r["banks"], r["banks_il"], r["app"], cell(r["exit"], "%d"),
+            cell(r["cycles"], "%d"), cell(cpi, "%.2f"), cell(r["energy"], "%.4g"),
+            r["xbar_kge"], r["ram_bytes"] // 1024, cell(r["core_area"], "%g")))
+
+    report = "\n".join(lines)
+    print("\n" + report)
+    with open(os.path.join(DSE_DIR, "report.md"), "w") as f:
+        f.write(report + "\n")
+
+    if not all(r["exit"] == 0 for r in rows):
+        sys.exit("dse_sweep: some runs did not exit with 0, see their sim.log in " + DSE_DIR)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# Copyright 2026 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Packs a flash_load binary into the compressed flash image expanded by crt0
+# when the app is built with COMPRESS=lz4:
+#
+#   0x000  first 1KiB of the binary, copied as is by the boot ROM: the image
+#          length of its boot header is set to 1KiB
+#   0x400  size in bytes of the LZ4 block, a multiple of 4
+#   0x404  rest of the binary as a single LZ4 block, padded with zeros
+#
+# The .rodata_flash section, read in place from the flash, and the code
+# overlays, loaded from the flash by overlay_load, are not compressed: they are
+# kept at their offset in the binary, after the block.
+#
+# The block follows the LZ4 block format
+# (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), crt0 stops
+# decoding when the output reaches _edata.
+
+import argparse
+import struct
+import sys
+
+BOOT_ROM_COPY_SIZE = 1024
+# Boot header of link_flash_load.ld.tpl, the four words add up to 0
+BOOT_HEADER_OFFSET = 0x170
+BOOT_HEADER_MAGIC = 0x48424858
+
+MIN_MATCH = 4
+# The last match starts at least 12 bytes before the end of the block and
+# the last 5 bytes are literals
+MF_LIMIT = 12
+LAST_LITERALS = 5
+MAX_OFFSET = 0xFFFF
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def write_sequence(out, literals, match_len, offset):
+    lit_len = len(literals)
+    token = min(lit_len, 15) << 4
+    if match_len:
+        token |= min(match_len - MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        write_length(out, lit_len - 15)
+    out += literals
+    if match_len:
+        out += struct.pack("<H", offset)
+        if match_len - MIN_MATCH >= 15:
+            write_length(out, match_len - MIN_MATCH - 15)
+
+
+def compress(data):
+    out = bytearray()
+    last_pos = {}
+    anchor = 0
+    pos = 0
+    match_limit = len(data) - MF_LIMIT
+    while pos < match_limit:
+        key = data[pos : pos + MIN_MATCH]
+        ref = last_pos.get(key)
+        last_pos[key] = pos
+        if ref is None or pos - ref > MAX_OFFSET:
+            pos += 1
+            continue
+        match_len = MIN_MATCH
+        while (
+            pos + match_len < len(data) - LAST_LITERALS
+            and data[ref + match_len] == data[pos + match_len]
+        ):
+            match_len += 1
+        write_sequence(out, data[anchor:pos], match_len, pos - ref)
+        for i in range(pos + 1, min(pos + match_len, match_limit)):
+            last_pos[data[i : i + MIN_MATCH]] = i
+        pos += match_len
+        anchor = pos
+    write_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def read_length(block, pos, length):
+    if length == 15:
+        while True:
+            byte = block[pos]
+            pos += 1
+            length += byte
+            if byte != 255:
+                break
+    return length, pos
+
+
+# Reference decoder, mirrors the one in crt0.S
+def decompress(block, size):
+    out = bytearray()
+    pos = 0
+    while True:
+        token = block[pos]
+        pos += 1
+        lit_len, pos = read_length(block, pos, token >> 4)
+        out += block[pos : pos + lit_len]
+        pos += lit_len
+        if len(out) >= size:
+            return bytes(out)
+        offset = block[pos] | (block[pos + 1] << 8)
+        pos += 2
+        match_len, pos = read_length(block, pos, token & 15)
+        for _ in range(match_len + MIN_MATCH):
+            out.append(out[-offset])
+
+
+# Offset of a section in the binary of size bin_size, None if the section is
+# missing or empty. The binary ends with the highest loaded byte.
+def section_offset(elf, name, bin_size):
+    if elf[:4] != b"\x7fELF" or elf[4] != 1:
+        sys.exit("error: not an ELF32 file")
+    e_phoff, e_shoff = struct.unpack_from("<II", elf, 0x1C)
+    e_phentsize, e_phnum, e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHHHH", elf, 0x2A)
+    top = 0
+    for i in range(e_phnum):
+        p_type, _, _, p_paddr, p_filesz = struct.unpack_from("<IIIII", elf, e_phoff + i * e_phentsize)
+        if p_type == 1 and p_filesz > 0:  # PT_LOAD
+            top = max(top, p_paddr + p_filesz)
+    strtab = struct.unpack_from("<I", elf, e_shoff + e_shstrndx * e_shentsize + 0x10)[0]
+    for i in range(e_shnum):
+        sh_name, _, _, sh_addr, _, sh_size = struct.unpack_from("<IIIIII", elf, e_shoff + i * e_shentsize)
+        end = elf.index(b"\0", strtab + sh_name)
+        if elf[strtab + sh_name : end].decode() == name and sh_size > 0:
+            return bin_size - (top - sh_addr)
+    return None
+
+
+# The boot ROM only copies the uncompressed head, crt0 expands the rest
+def set_boot_length(head, length):
+    magic, _, cfg, _ = struct.unpack_from("<4I", head, BOOT_HEADER_OFFSET)
+    if magic != BOOT_HEADER_MAGIC:
+        return
+    check = -(magic + length + cfg) & 0xFFFFFFFF
+    struct.pack_into("<4I", head, BOOT_HEADER_OFFSET, magic, length, cfg, check)
+
+
+def write_verilog_hex(f, image):
+    f.write("@00000000\n")
+    for i in range(0, len(image), 16):
+        f.write(" ".join("{:02X}".format(b) for b in image[i : i + 16]) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compress a flash_load binary for crt0 to decompress at boot"
+    )
+    parser.add_argument("--bin", required=True, help="binary of the app (objcopy -O binary)")
+    parser.add_argument("--hex", required=True, help="flash image to write (objcopy -O verilog format)")
+    parser.add_argument("--elf", help="ELF of the app, to keep its .rodata_flash section and overlays uncompressed")
+    args = parser.parse_args()
+
+    with open(args.bin, "rb") as f:
+        data = f.read()
+
+    raw_offset = None
+    if args.elf:
+        with open(args.elf, "rb") as f:
+            elf = f.read()
+        # .xheep_overlay_load reserves the place of the overlays in the flash
+        offsets = [section_offset(elf, name, len(data)) for name in (".rodata_flash", ".xheep_overlay_load")]
+        offsets = [o for o in offsets if o is not None]
+        raw_offset = min(offsets) if offsets else None
+    if raw_offset is None:
+        raw_offset = len(data)
+
+    head = data[:BOOT_ROM_COPY_SIZE]
+    rest = data[BOOT_ROM_COPY_SIZE:raw_offset]
+    image = bytearray(head)
+    if rest:
+        set_boot_length(image, BOOT_ROM_COPY_SIZE)
+        block = compress(rest)
+        if decompress(block, len(rest)) != rest:
+            sys.exit("error: the LZ4 block does not decompress to the binary")
+        block += bytes(-len(block) % 4)
+        image += struct.pack("<I", len(block)) + block
+        print(
+            "flash_lz4: {} bytes compressed to {} bytes ({:.1f}%)".format(
+                len(rest), len(block), 100.0 * len(block) / len(rest)
+            )
+        )
+    if raw_offset < len(data):
+        if len(image) > raw_offset:
+            sys.exit("error: the compressed image overlaps .rodata_flash or the overlays")
+        image += bytes(raw_offset - len(image)) + data[raw_offset:]
+
+    with open(args.hex, "w") as f:
+        write_verilog_hex(f, image)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Decoder of the deferred log dumped by fmt_log_dump() (sw/device/lib/fmt/fmt_log.h),
+# e.g. in the uart0.log of the Verilator testbench. The records hold the address
+# of their format: the formats, and the constant strings of %s, are read from the
+# ELF of the application, e.g. sw/build/main.elf.
+
+import argparse
+import re
+import struct
+import sys
+
+TAG = 'FMTLOG'
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t)?(.)')
+
+
+class LogError(Exception):
+    pass
+
+
+def load_sections(path):
+    """Returns (address, bytes) of the sections of an ELF32 placed in memory."""
+    with open(path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[4] != 1:
+        raise LogError('{} is not an ELF32 file'.format(path))
+    e_shoff = struct.unpack_from('<I', elf, 0x20)[0]
+    e_shentsize, e_shnum = struct.unpack_from('<HH', elf, 0x2E)
+    sections = []
+    for i in range(e_shnum):
+        _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(
+            '<IIIIII', elf, e_shoff + i * e_shentsize)
+        if sh_flags & SHF_ALLOC and sh_type != SHT_NOBITS and sh_size:
+            sections.append((sh_addr, elf[sh_offset:sh_offset + sh_size]))
+    return sections
+
+
+def read_string(sections, addr):
+    for base, data in sections:
+        if base <= addr < base + len(data):
+            end = data.find(b'\0', addr - base)
+            return data[addr - base:end if end >= 0 else len(data)].decode(errors='replace')
+    return None
+
+
+def format_int(value, conv, flags, width, prec):
+    """Formats a 32-bit argument as the C formatter of fmt.c."""
+    sign = ''
+    if conv in 'di':
+        value = value - (1 << 32) if value & 0x80000000 else value
+        if value < 0:
+            sign, value = '-', -value
+        elif '+' in flags:
+            sign = '+'
+        elif ' ' in flags:
+            sign = ' '
+    base = {'o': 8, 'x': 16, 'X': 16, 'p': 16}.get(conv, 10)
+    digits = '' if value == 0 and prec == 0 else ('{:o}', '{:d}', '{:x}')[(base > 8) + (base > 10)].format(value)
+    if conv == 'X':
+        digits = digits.upper()
+    prefix = sign
+    if conv == 'p' or ('#' in flags and conv in 'xX' and value != 0):
+        prefix += '0X' if conv == 'X' else '0x'
+    if prec is not None:
+        digits = digits.rjust(prec, '0')
+    if conv == 'o' and '#' in flags and not digits.startswith('0'):
+        digits = '0' + digits
+    if '0' in flags and '-' not in flags and prec is None:
+        digits = digits.rjust(width - len(prefix), '0')
+    return prefix + digits
+
+
+def format_record(fmt, args, sections):
+    """Formats a record, as fmt_log_print() does on the chip."""
+    args = list(args)
+
+    def arg():
+        return args.pop(0) if args else 0
+
+    def conversion(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = arg()
+            width = width - (1 << 32) if width & 0x80000000 else width
+            if width < 0:
+                flags += '-'
+                width = -width
+        width = int(width) if width else 0
+        if prec == '*':
+            prec = arg()
+            prec = None if prec & 0x80000000 else prec
+        elif prec is not None:
+            prec = int(prec) if prec else 0
+        if conv in 'diuoxXp':
+            text = format_int(arg(), conv, flags, width, prec)
+        elif conv == 'c':
+            text = chr(arg() & 0xff)
+        elif conv == 's':
+            addr = arg()
+            text = read_string(sections, addr)
+            if text is None:
+                text = '<0x{:08x}>'.format(addr)
+            if prec is not None:
+                text = text[:prec]
+        else:
+            # Not supported by fmt.c, written as it is
+            return m.group(0)
+        return text.ljust(width) if '-' in flags else text.rjust(width)
+
+    return SPEC.sub(conversion, fmt)
+
+
+def parse(lines):
+    """Yields the records of the log, (format address, cycle, args), and the dropped counts."""
+    for line in lines:
+        # The lines printed through the UART end with \n\r
+        fields = line.strip().split()
+        if not fields or fields[0] != TAG:
+            continue
+        if len(fields) == 3 and fields[1] == 'dropped':
+            yield 'dropped', int(fields[2])
+        elif len(fields) == 9:
+            yield 'record', [int(x, 16) for x in fields[1:]]
+        else:
+            raise LogError('bad record: {}'.format(line.strip()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the deferred log dumped by fmt_log_dump()')
+    parser.add_argument('elf', help='ELF of the application, e.g. sw/build/main.elf')
+    parser.add_argument('log', help='log of the UART, e.g. uart0.log of the Verilator testbench')
+    parser.add_argument('--relative', action='store_true', help='print the cycles from the first record')
+    args = parser.parse_args()
+
+    try:
+        sections = load_sections(args.elf)
+        first = None
+        base = 0
+        last = None
+        with open(args.log, errors='replace') as f:
+            for kind, value in parse(f):
+                if kind == 'dropped':
+                    if value:
+                        print('({} records dropped)'.format(value))
+                    continue
+                addr, cycle, words = value[0], value[1], value[2:]
+                # The cycles are unwrapped from 32 bits
+                if last is not None and cycle < last:
+                    base += 1 << 32
+                last = cycle
+                cycle += base
+                first = cycle if first is None else first
+                fmt = read_string(sections, addr)
+                text = format_record(fmt, words, sections) if fmt is not None \
+                    else '<unknown format 0x{:08x}>'.format(addr)
+                print('{:>12} {}'.format(cycle - first if args.relative else cycle, text))
+    except (LogError, OSError) as e:
+        sys.exit('fmt_log_decode: {}'.format(e))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Decoder of the FreeRTOS trace printed by vPortTraceDump() (sw/freertos/port_stats.c),
+# e.g. in the uart0.log of the Verilator testbench. Prints the time of each task
+# between its context switches, without the interrupt handlers, or the timeline.
+
+import argparse
+import sys
+
+TRACE_SWITCHED_IN = 1
+TRACE_ISR_ENTER = 2
+TRACE_ISR_EXIT = 3
+
+END = 'RTOS_TRACE_END'
+
+
+class TraceError(Exception):
+    pass
+
+
+def parse(lines):
+    """Returns the dumps of the log, each a dict of the tasks and the records."""
+    dumps = []
+    dump = None
+    for line in lines:
+        # The lines printed through the UART end with \n\r
+        line = line.strip()
+        if line.startswith('RTOS_TRACE '):
+            fields = line.split()
+            if len(fields) != 4:
+                raise TraceError('bad header: {}'.format(line))
+            dump = {'entries': int(fields[1]), 'count': int(fields[2]), 'hz': int(fields[3]),
+                    'tasks': {}, 'records': []}
+        elif dump is None:
+            continue
+        elif line == END:
+            dumps.append(dump)
+            dump = None
+        elif line.startswith('T '):
+            fields = line.split(maxsplit=2)
+            dump['tasks'][int(fields[1])] = fields[2] if len(fields) > 2 else ''
+        elif line.startswith('R '):
+            fields = line.split()
+            if len(fields) != 4:
+                raise TraceError('bad record: {}'.format(line))
+            dump['records'].append((int(fields[1], 16), int(fields[2]), int(fields[3])))
+    if dump is not None:
+        raise TraceError('truncated dump, no {}'.format(END))
+    return dumps
+
+
+def timeline(records):
+    """Yields (cycle, event, id) with the cycles unwrapped from 32 bits."""
+    base = 0
+    last = None
+    for cycle, event, ident in records:
+        if last is not None and cycle < last:
+            base += 1 << 32
+        last = cycle
+        yield base + cycle, event, ident
+
+
+def usage(dump):
+    """Cycles per task between its switches, and in the handlers."""
+    tasks = {}
+    isr = 0
+    current = None
+    start = None
+    isr_start = None
+    # The handlers are not the time of the task they interrupted
+    task_isr = 0
+    for cycle, event, ident in timeline(dump['records']):
+        if event == TRACE_SWITCHED_IN:
+            if current is not None:
+                tasks[current] = tasks.get(current, 0) + cycle - start - task_isr
+            current = ident
+            start = cycle
+            task_isr = 0
+        elif event == TRACE_ISR_ENTER:
+            isr_start = cycle
+        elif event == TRACE_ISR_EXIT and isr_start is not None:
+            isr += cycle - isr_start
+            task_isr += cycle - isr_start
+            isr_start = None
+    return tasks, isr
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the FreeRTOS trace printed by vPortTraceDump()')
+    parser.add_argument('log', help='log of the UART, e.g. uart0.log of the Verilator testbench')
+    parser.add_argument('--timeline', action='store_true', help='print the records instead of the usage')
+    args = parser.parse_args()
+
+    with open(args.log, errors='replace') as f:
+        try:
+            dumps = parse(f)
+        except TraceError as e:
+            sys.exit('freertos_trace_decode: {}'.format(e))
+
+    if not dumps:
+        sys.exit('freertos_trace_decode: no trace in {}'.format(args.log))
+
+    for n, dump in enumerate(dumps):
+        names = dump['tasks']
+        lost = dump['count'] - len(dump['records'])
+        print('dump {}: {} records{}'.format(n, len(dump['records']),
+                                             ', {} older ones lost'.format(lost) if lost > 0 else ''))
+        if args.timeline:
+            first = None
+            for cycle, event, ident in timeline(dump['records']):
+                first = cycle if first is None else first
+                if event == TRACE_SWITCHED_IN:
+                    what = 'switch to {}'.format(names.get(ident, '#{}'.format(ident)))
+                elif event == TRACE_ISR_ENTER:
+                    what = 'isr {} enter'.format(ident)
+                else:
+                    what = 'isr {} exit'.format(ident)
+                print('{:>12} {}'.format(cycle - first, what))
+            continue
+
+        tasks, isr = usage(dump)
+        total = sum(tasks.values()) + isr
+        for ident, cycles in sorted(tasks.items(), key=lambda t: -t[1]):
+            name = names.get(ident, '#{}'.format(ident))
+            print('{:<12} {:>12} cycles {:>6.2f}%'.format(name, cycles, 100.0 * cycles / total if total else 0))
+        print('{:<12} {:>12} cycles {:>6.2f}%'.format('(isr)', isr, 100.0 * isr / total if total else 0))
+
+
+if __name__ == '__main__':
+    main()
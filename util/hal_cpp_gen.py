@@ -0,0 +1,353 @@
+import hjson
+import string
+import argparse
+import sys
+from datetime import date
+
+############################################################
+#  This module generates the C++ register types of a       #
+#  peripheral (see sw/device/lib/base/hal.hpp) and writes  #
+#  them into a file formatted using a template.            #
+############################################################
+
+
+# Tab definition as 2 blank spaces #
+tab_spaces = "  "
+
+# Software accesses that are not plain read and write #
+ro_access = ["ro", "rc"]
+wo_access = ["wo", "r0w1c"]
+w1_access = ["rw1c", "rw1s", "rw0c"]
+
+# Suffix of the fields named as their register, a C++ class cannot have a
+# member with its own name
+field_suffix = "_FIELD"
+
+
+def read_json(json_file):
+    """
+    Opens the json file taken as input and returns its content
+    """
+    # Open the hjson file #
+    f = open(json_file)
+    j_data = hjson.load(f)
+    f.close()
+    return j_data
+
+
+def write_template(tpl, registers, peripheral_name):
+    """
+    Opens a given template and substitutes the registers.
+    Returns a string with the content of the updated template
+    """
+
+    today = date.today()
+    today = today.strftime("%d/%m/%Y")
+
+    with open(tpl) as t:
+        template = string.Template(t.read())
+
+    return template.substitute(registers_definitions=registers,
+                               peripheral_name=peripheral_name.lower(),
+                               peripheral_name_upper=peripheral_name.upper(),
+                               date=today)
+
+
+def write_output(out_file, out_string):
+    """
+    Writes the final out_string into the specified out_file
+    """
+
+    with open(out_file, "w") as f:
+        f.write(out_string)
+
+
+def to_int(value):
+    """
+    Converts a number of the hjson, that can be a string in decimal or
+    hexadecimal, to int
+    """
+    if isinstance(value, int):
+        return value
+    return int(str(value), 0)
+
+
+def to_bool(value):
+    """
+    Converts a boolean of the hjson, that can be a string, to bool
+    """
+    if isinstance(value, bool):
+        return value
+    return str(value).lower() in ["true", "1"]
+
+
+def bits_range(bits):
+    """
+    Returns the lsb and the width of a "msb:lsb" or "bit" string
+    """
+    bits = str(bits)
+    if bits.find(":") != -1:
+        msb, lsb = [int(b) for b in bits.split(":")]
+        return lsb, msb - lsb + 1
+    return int(bits), 1
+
+
+def as_define(name):
+    """
+    Returns a name in upper case with the non alphanumeric characters replaced
+    by '_', as in the C headers of reggen
+    """
+    return "".join(c if c.isalnum() else "_" for c in name.upper())
+
+
+def comment(desc, indent):
+    """
+    Returns a doxygen comment with the first line of a description
+    """
+    if not desc:
+        return ""
+    line = desc.strip().split("\n")[0].strip().replace("*/", "* /")
+    return indent + "/** " + line + " */\n"
+
+
+def param_value(peripheral_json, name):
+    """
+    Returns the default value of a parameter, or the value itself if it is a
+    number
+    """
+    for p in peripheral_json.get("param_list", []):
+        if p["name"] == name:
+            return to_int(p["default"])
+    return to_int(name)
+
+
+def access_of(swaccess):
+    """
+    Returns the hal::access of a swaccess of the hjson
+    """
+    if swaccess in ro_access:
+        return "hal::access::ro"
+    if swaccess in wo_access:
+        return "hal::access::wo"
+    if swaccess in w1_access:
+        return "hal::access::w1"
+    return "hal::access::rw"
+
+
+def make_reg(name, desc, offset, swaccess, fields):
+    """
+    Returns the description of a register: fields is a list of
+    (name, desc, lsb, width, enum) in the register
+    """
+    return {"name": as_define(name), "desc": desc, "offset": offset,
+            "swaccess": swaccess, "fields": fields}
+
+
+def reg_fields(reg_json):
+    """
+    Returns the fields of a register of the hjson. A single field without
+    name takes the name of the register, as reggen does
+    """
+    fields = []
+    for f in reg_json["fields"]:
+        lsb, width = bits_range(f["bits"])
+        name = f.get("name", reg_json["name"])
+        fields.append((name, f.get("desc", ""), lsb, width, f.get("enum")))
+    return fields
+
+
+def intr_alert_regs(signals, offset, names):
+    """
+    Returns the registers generated for an interrupt or alert list, one field
+    per signal from bit 0 on
+    """
+    fields = []
+    lsb = 0
+    for s in signals:
+        width = to_int(s.get("width", 1))
+        fields.append((s["name"], s.get("desc", ""), lsb, width, None))
+        lsb += width
+
+    regs = []
+    for name, desc, swaccess in names:
+        regs.append(make_reg(name, desc, offset, swaccess, fields))
+        offset += 4
+    return regs, offset
+
+
+def multi_regs(peripheral_json, multireg, offset, reg_width):
+    """
+    Returns the registers a multireg expands into. As in reggen, a multireg
+    with a single field is compacted by default, each register holding as
+    many copies of the field as fit, and the registers and fields are
+    suffixed with their index
+    """
+    count = param_value(peripheral_json, multireg["count"])
+    fields = reg_fields(multireg)
+    compact = to_bool(multireg.get("compact", len(fields) == 1))
+
+    if compact:
+        lsb, width = fields[0][2], fields[0][3]
+        per_reg = reg_width // (lsb + width)
+    else:
+        per_reg = 1
+    n_regs = (count + per_reg - 1) // per_reg
+
+    regs = []
+    for r in range(n_regs):
+        name = multireg["name"] + ("_{}".format(r) if n_regs > 1 else "")
+        first = r * per_reg
+        last = min(first + per_reg, count)
+        if compact:
+            f_name, f_desc, lsb, width, enum = fields[0]
+            new_fields = [("{}_{}".format(f_name, i), f_desc,
+                           lsb + (lsb + width) * (i - first), width, enum)
+                          for i in range(first, last)]
+        else:
+            new_fields = [("{}_{}".format(f[0], r),) + f[1:] for f in fields]
+        regs.append(make_reg(name, multireg["desc"], offset,
+                             multireg.get("swaccess", "rw"), new_fields))
+        offset += 4
+    return regs, offset
+
+
+def add_registers(peripheral_json):
+    """
+    Reads the json description of a peripheral and computes the offset and
+    fields of every register, and the offset of every window, as reggen does.
+
+    :param peripheral_json: the json-like description of the registers of a peripheral
+    :return: the list of registers and the list of windows
+    """
+
+    reg_width = to_int(peripheral_json.get("regwidth", 32))
+    regs = []
+    windows = []
+    offset = 0
+
+    # To handle INTR specific registers #
+    if "interrupt_list" in peripheral_json and \
+            not to_bool(peripheral_json.get("no_auto_intr_regs", False)):
+        new_regs, offset = intr_alert_regs(peripheral_json["interrupt_list"], offset,
+                                           [("INTR_STATE", "Interrupt State Register", "rw1c"),
+                                            ("INTR_ENABLE", "Interrupt Enable Register", "rw"),
+                                            ("INTR_TEST", "Interrupt Test Register", "wo")])
+        regs += new_regs
+
+    # To handle the ALERT registers #
+    if "alert_list" in peripheral_json and \
+            not to_bool(peripheral_json.get("no_auto_alert_regs", False)):
+        new_regs, offset = intr_alert_regs(peripheral_json["alert_list"], offset,
+                                           [("ALERT_TEST", "Alert Test Register", "wo")])
+        regs += new_regs
+
+    for elem in peripheral_json["registers"]:
+
+        if "multireg" in elem:
+            new_regs, offset = multi_regs(peripheral_json, elem["multireg"], offset, reg_width)
+            regs += new_regs
+
+        elif "window" in elem:
+            window = elem["window"]
+            items = to_int(window["items"])
+
+            # the window is aligned to its size rounded up to a power of 2
+            size = 1 << (items * 4 - 1).bit_length()
+            if offset & (size - 1):
+                offset = (offset | (size - 1)) + 1
+            windows.append({"name": as_define(window["name"]), "desc": window.get("desc", ""),
+                            "offset": offset, "items": items})
+            offset += items * 4
+
+        elif "skipto" in elem:
+            offset = to_int(elem["skipto"])
+
+        elif "reserved" in elem:
+            offset += to_int(elem["reserved"]) * 4
+
+        elif "name" in elem:
+            regs.append(make_reg(elem["name"], elem.get("desc", ""), offset,
+                                 elem.get("swaccess", "rw"), reg_fields(elem)))
+            offset += 4
+
+    return regs, windows
+
+
+def gen_field(reg_name, field, indent):
+    """
+    Returns the C++ type of a field, with the values of its enum if any,
+    prefixed with VALUE_ as in the C headers
+    """
+    name, desc, lsb, width, enum = field
+    name = as_define(name)
+    if name == reg_name:
+        name += field_suffix
+
+    res = comment(desc, indent)
+    base = "hal::field<{}, {}, {}>".format(reg_name, lsb, width)
+    if not enum:
+        return res + indent + "struct {} : {} {{}};\n".format(name, base)
+
+    res += indent + "struct {} : {} {{\n".format(name, base)
+    res += indent + tab_spaces + "enum : uint32_t {\n"
+    for e in enum:
+        res += indent + 2 * tab_spaces + "VALUE_{} = {},\n".format(as_define(e["name"]), hex(to_int(e["value"])))
+    res += indent + tab_spaces + "};\n"
+    res += indent + "};\n"
+    return res
+
+
+def gen_registers(regs, windows):
+    """
+    Returns the C++ types of the registers and windows, sorted by offset
+    """
+    res = ""
+    indent = tab_spaces
+
+    elems = [("reg", r) for r in regs] + [("window", w) for w in windows]
+    for kind, e in sorted(elems, key=lambda x: x[1]["offset"]):
+        res += "\n" + comment(e["desc"], indent)
+        if kind == "window":
+            res += indent + "struct {} : hal::window<Base + {}, {}> {{}};\n".format(
+                e["name"], hex(e["offset"]), e["items"])
+            continue
+
+        res += indent + "struct {} : hal::reg<{}, Base + {}, {}> {{\n".format(
+            e["name"], e["name"], hex(e["offset"]), access_of(e["swaccess"]))
+        for f in e["fields"]:
+            res += gen_field(e["name"], f, indent + tab_spaces)
+        res += indent + "};\n"
+
+    return res
+
+
+def main(arg_vect):
+
+    parser = argparse.ArgumentParser(prog="C++ HAL generator",
+                                     description="Given a template and a json file as input, it generates "
+                                                 "the C++ types of the registers and fields of a peripheral and "
+                                                 "prints them into a file, following the structure provided by "
+                                                 "the template.")
+    parser.add_argument("--template_filename",
+                        help="filename of the template for the final file generation")
+    parser.add_argument("--peripheral_name",
+                        help="name of the peripheral in core_v_mini_mcu.h, by default the one of the json")
+    parser.add_argument("--json_filename",
+                        help="filename of the input json basing on which the registers will be generated")
+    parser.add_argument("--output_filename",
+                        help="name of the file in which to write the final formatted template with the "
+                             "registers generated")
+
+    args = parser.parse_args(arg_vect)
+
+    data = read_json(args.json_filename)
+    peripheral_name = args.peripheral_name if args.peripheral_name else data["name"]
+
+    regs, windows = add_registers(data)
+
+    final_output = write_template(args.template_filename, gen_registers(regs, windows), peripheral_name)
+    write_output(args.output_filename, final_output)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -221,6 +221,8 @@ class Pad:
     self.keep_internal     = []
 
     self.is_muxed = False
+    # Reset value of the pad mux register
+    self.mux_resval = 0
 
     self.is_driven_manually = pad_driven_manually
     self.do_skip_declaration = pad_skip_declaration
@@ -261,12 +263,35 @@ class Pad:
     self.pad_ring_bonding_bonding = ''
     self.x_heep_system_interface = ''
 
+# Events of the mhpmcounters of each core, with the bit of mhpmevent that
+# selects them. The counters of the cv32e20 have fixed events: mhpmcounter3 + i
+# counts the i-th one, so that counting an event builds the counters before it.
+HPM_EVENTS_FIXED = {
+    'cv32e20'  : ['dside_wait', 'iside_wait', 'load', 'store', 'jump', 'branch', 'branch_taken',
+                  'compressed', 'wfi_wait', 'div_wait'],
+}
+HPM_EVENTS_SELECTABLE = {
+    'cv32e40p' : {'load_stall': 2, 'jump_stall': 3, 'imiss': 4, 'load': 5, 'store': 6, 'jump': 7,
+                  'branch': 8, 'branch_taken': 9, 'compressed': 10, 'apu_type': 12,
+                  'apu_contention': 13, 'apu_dep': 14, 'apu_wb': 15},
+    'cv32e40x' : {'compressed': 2, 'jump': 3, 'branch': 4, 'branch_taken': 5, 'intr_taken': 6,
+                  'load': 7, 'store': 8, 'imiss': 9, 'id_invalid': 10, 'ex_invalid': 11,
+                  'wb_invalid': 12, 'load_stall': 13, 'jump_stall': 14, 'wb_data_stall': 15},
+}
+HPM_EVENTS_SELECTABLE['cv32e40px'] = HPM_EVENTS_SELECTABLE['cv32e40p']
+
 # Compile a regex to trim trailing whitespaces on lines.
 re_trailws = re.compile(r'[ \t\r]+$', re.MULTILINE)
 
 def string2int(hex_json_string):
     return (hex_json_string.split('x')[1]).split(',')[0]
 
+def cfg2int(value):
+    # hjson numbers are ints, 0x... values are strings up to the end of the line
+    if isinstance(value, int):
+        return value
+    return int(str(value).split(',')[0].split('#')[0].strip(), 0)
+
 def write_template(tpl_path, outdir, outfile, **kwargs):
     if tpl_path:
         tpl_path = pathlib.Path(tpl_path).absolute()
@@ -329,7 +354,7 @@ def main():
                         metavar="from 2 to 16",
                         nargs='?',
                         default="",
-                        help="Number of 32KB Banks (default value from cfg file)")
+                        help="Number of contiguous banks (default value from cfg file)")
 
     parser.add_argument("--memorybanks_il",
                         metavar="0, 2, 4 or 8",
@@ -409,6 +434,38 @@ def main():
     else:
         cpu_type = obj['cpu_type']
 
+    # Cores sharing the system crossbar, the secondary ones are started by hart 0 through the mailbox
+    cpu_num = cfg2int(obj.get('cpu_num', 1))
+    if cpu_num < 1 or cpu_num > 4:
+        exit("cpu_num must be between 1 and 4 instead of " + str(cpu_num))
+
+    # SPI slave master of the system crossbar, on the spi_slave options of the pad muxes
+    spi_slave = obj.get('spi_slave', 'no') == 'yes'
+
+    # Event counters of the cores, from mhpmcounter3, as (name, counter, mhpmevent) with mhpmevent
+    # 0 for the fixed events
+    hpm_events_cfg = obj.get('hpm_events', {}).get(cpu_type)
+    if hpm_events_cfg == None:
+        hpm_events_cfg = [HPM_EVENTS_FIXED[cpu_type][0]] if cpu_type in HPM_EVENTS_FIXED else ['load_stall']
+    hpm_events_cfg = [str(e) for e in hpm_events_cfg]
+    hpm_events = []
+    if cpu_type in HPM_EVENTS_FIXED:
+        for e in hpm_events_cfg:
+            if e not in HPM_EVENTS_FIXED[cpu_type]:
+                exit("hpm_events: " + cpu_type + " has no " + e + " event, only " + ", ".join(HPM_EVENTS_FIXED[cpu_type]))
+        num_mhpmcounters = max([HPM_EVENTS_FIXED[cpu_type].index(e) + 1 for e in hpm_events_cfg], default=0)
+        hpm_events = [(e, 3 + i, 0) for i, e in enumerate(HPM_EVENTS_FIXED[cpu_type][:num_mhpmcounters])]
+    else:
+        for e in hpm_events_cfg:
+            if e not in HPM_EVENTS_SELECTABLE[cpu_type]:
+                exit("hpm_events: " + cpu_type + " has no " + e + " event, only " + ", ".join(HPM_EVENTS_SELECTABLE[cpu_type]))
+        if len(set(hpm_events_cfg)) != len(hpm_events_cfg):
+            exit("hpm_events: each event must be counted once")
+        num_mhpmcounters = len(hpm_events_cfg)
+        hpm_events = [(e, 3 + i, 1 << HPM_EVENTS_SELECTABLE[cpu_type][e]) for i, e in enumerate(hpm_events_cfg)]
+    if num_mhpmcounters > 29:
+        exit("hpm_events: the cores have at most 29 event counters instead of " + str(num_mhpmcounters))
+
     if args.bus != None and args.bus != '':
         bus_type = args.bus
     else:
@@ -432,10 +489,17 @@ def main():
     else:
         log_ram_numbanks_il = 0
 
+    # Transactions in flight on the onetoM bus, the NtoM bus routes the responses of one per slave
+    bus_max_outstanding = int(string2int(obj['bus_max_outstanding']), 16) if 'bus_max_outstanding' in obj else 1
+    if bus_max_outstanding < 1 or bus_max_outstanding > 8:
+        exit("bus_max_outstanding must be between 1 and 8 instead of " + str(bus_max_outstanding))
+    if bus_type == 'NtoM':
+        bus_max_outstanding = 1
+
     if ram_numbanks_il != 0 and bus_type == 'onetoM':
         exit("bus type must be 'NtoM' instead 'onetoM' to access the interleaved memory banks in parallel" + str(args.bus))
 
-    if ram_numbanks_cont + ram_numbanks_il < 2 and ram_numbanks_cont + ram_numbanks_il > 16:
+    if ram_numbanks_cont + ram_numbanks_il < 2 or ram_numbanks_cont + ram_numbanks_il > 16:
         exit("ram numbanks must be between 2 and 16 instead of " + str(ram_numbanks_cont + ram_numbanks_il))
     else:
         ram_numbanks = ram_numbanks_cont + ram_numbanks_il
@@ -444,7 +508,32 @@ def main():
     if int(ram_start_address,16) != 0:
         exit("ram start address must be 0 instead of " + str(ram_start_address))
 
-    ram_size_address = '{:08X}'.format(ram_numbanks*32*1024)
+    # Bytes of each bank: bank_size for all of them, or bank_sizes for each
+    # contiguous one. The interleaved banks are all bank_size bytes.
+    ram_bank_size = cfg2int(obj['ram']['bank_size']) if 'bank_size' in obj['ram'] else 32*1024
+    if 'bank_sizes' in obj['ram']:
+        ram_bank_sizes_cont = [cfg2int(size) for size in obj['ram']['bank_sizes']]
+        if len(ram_bank_sizes_cont) != ram_numbanks_cont:
+            exit("ram bank_sizes must have one entry for each of the " + str(ram_numbanks_cont) + " contiguous banks instead of " + str(len(ram_bank_sizes_cont)))
+    else:
+        ram_bank_sizes_cont = [ram_bank_size] * ram_numbanks_cont
+
+    for size in ram_bank_sizes_cont + [ram_bank_size]:
+        if size < 0x400 or size > 0x100000 or not log2(size).is_integer():
+            exit("ram bank sizes must be powers of 2 from 1KiB to 1MiB instead of " + hex(size))
+
+    # (start address, bytes) of each bank, the interleaved banks share the
+    # addresses of their region, which follows the contiguous banks
+    ram_banks = []
+    ram_bank_start = int(ram_start_address, 16)
+    for size in ram_bank_sizes_cont:
+        ram_banks.append((ram_bank_start, size))
+        ram_bank_start += size
+    ram_il_start = ram_bank_start
+    ram_il_size = ram_numbanks_il * ram_bank_size
+    ram_banks += [(ram_il_start, ram_bank_size)] * ram_numbanks_il
+
+    ram_size_address = '{:08X}'.format(ram_il_start + ram_il_size - int(ram_start_address, 16))
 
     if args.external_domains != None and args.external_domains != '':
         external_domains = int(args.external_domains)
@@ -458,6 +547,9 @@ def main():
     if int(debug_start_address, 16) < int('10000', 16):
         exit("debug start address must be greater than 0x10000")
 
+    if int(ram_start_address, 16) + int(ram_size_address, 16) > int(debug_start_address, 16):
+        exit("the ram banks must end before the debug start address instead of at 0x" + '{:08X}'.format(int(ram_start_address, 16) + int(ram_size_address, 16)))
+
     debug_size_address = string2int(obj['debug']['length'])
 
     ao_peripheral_start_address = string2int(obj['ao_peripherals']['address'])
@@ -486,7 +578,7 @@ def main():
         new = {}
         for k,v in peripherals.items():
             if isinstance(v, dict):
-                new[k] = {key:val for key,val in v.items() if key not in ("path")}
+                new[k] = {key:val for key,val in v.items() if key not in ("path", "ch_length", "num_channels", "fifo_depth", "max_outstanding", "memcpy_channels", "counters", "bytes_per_cycle", "depth")}
             else:
                 new[k] = v
         return new
@@ -504,6 +596,35 @@ def main():
     ao_peripherals = extract_peripherals(discard_path(obj['ao_peripherals']))
     ao_peripherals_count = len(ao_peripherals)
 
+    bus_monitor_counters = obj['ao_peripherals']['bus_monitor'].get('counters', 'no') == 'yes'
+
+    event_trace_depth = int(string2int(obj['ao_peripherals']['event_trace'].get('depth', '0x40')), 16)
+    if event_trace_depth < 16 or event_trace_depth > 1024 or event_trace_depth & (event_trace_depth - 1) != 0:
+        exit("event_trace depth must be a power of 2 between 16 and 1024 instead of " + str(event_trace_depth))
+
+    dma_ch_count = int(string2int(obj['ao_peripherals']['dma']['num_channels']), 16)
+    if dma_ch_count < 1 or dma_ch_count > 16:
+        exit("dma num_channels must be between 1 and 16 instead of " + str(dma_ch_count))
+
+    dma_ch_size = string2int(obj['ao_peripherals']['dma']['ch_length'])
+    if not log2(int(dma_ch_size, 16)).is_integer() or int(dma_ch_size, 16) < 0x80:
+        exit("dma ch_length must be a power of 2 of at least 0x80 instead of 0x" + str(dma_ch_size))
+
+    if dma_ch_count * int(dma_ch_size, 16) > int(ao_peripherals['dma']['length'], 16):
+        exit("the dma channels must fit in the dma region, instead they take 0x" + '{:08X}'.format(dma_ch_count * int(dma_ch_size, 16)))
+
+    dma_fifo_depth = int(string2int(obj['ao_peripherals']['dma']['fifo_depth']), 16)
+    if dma_fifo_depth < 2:
+        exit("dma fifo_depth must be at least 2 instead of " + str(dma_fifo_depth))
+
+    dma_max_outstanding = int(string2int(obj['ao_peripherals']['dma']['max_outstanding']), 16)
+    if dma_max_outstanding < 1 or dma_max_outstanding >= dma_fifo_depth:
+        exit("dma max_outstanding must be between 1 and fifo_depth - 1 instead of " + str(dma_max_outstanding))
+
+    dma_memcpy_channels = int(string2int(obj['ao_peripherals']['dma'].get('memcpy_channels', '1')), 16)
+    if dma_memcpy_channels < 1 or dma_memcpy_channels > dma_ch_count or dma_memcpy_channels & (dma_memcpy_channels - 1) != 0:
+        exit("dma memcpy_channels must be a power of 2 between 1 and num_channels instead of " + str(dma_memcpy_channels))
+
 
     peripheral_start_address = string2int(obj['peripherals']['address'])
     if int(peripheral_start_address, 16) < int('10000', 16):
@@ -513,12 +634,126 @@ def main():
     peripherals = extract_peripherals(discard_path(obj['peripherals']))
     peripherals_count = len(peripherals)
 
+    crc_bytes_per_cycle = int(string2int(obj['peripherals']['crc'].get('bytes_per_cycle', '4')), 16)
+    if crc_bytes_per_cycle not in (1, 2, 4):
+        exit("crc bytes_per_cycle must be 1, 2 or 4 instead of " + str(crc_bytes_per_cycle))
+
+    if cpu_num > 1 and ('mailbox' not in obj['peripherals'] or obj['peripherals']['mailbox']['is_included'] != "yes"):
+        exit("the mailbox peripheral must be included to start the " + str(cpu_num - 1) + " secondary cores")
+
     ext_slave_start_address = string2int(obj['ext_slaves']['address'])
     ext_slave_size_address = string2int(obj['ext_slaves']['length'])
 
+    # Slaves of the external crossbar, in the ext_slaves region, and masters
+    # with a slave port on the system bus. The default ones are those of the
+    # testbench
+    ext_slave_start = int(ext_slave_start_address, 16)
+    ext_slave_end = ext_slave_start + int(ext_slave_size_address, 16)
+    ext_slaves = {}
+    for name, info in obj['ext_slaves'].get('slaves', {'slow_memory': {'offset': '0x0', 'length': '0x200'}}).items():
+        start = ext_slave_start + cfg2int(info['offset'])
+        size = cfg2int(info['length'])
+        if size == 0 or start + size > ext_slave_end:
+            exit("the ext_slaves slave " + name + " must be a non-empty part of the ext_slaves region")
+        for other, o in ext_slaves.items():
+            if start < o['end'] and start + size > o['start']:
+                exit("the ext_slaves slaves " + other + " and " + name + " overlap")
+        latency = str(info.get('latency', 'slow')).split(',')[0].strip()
+        if latency not in ("fast", "slow"):
+            exit("the latency of the ext_slaves slave " + name + " must be fast or slow instead of " + latency)
+        ext_slaves[name] = {
+            'start': start,
+            'end': start + size,
+            'offset': '{:08X}'.format(start - ext_slave_start),
+            'length': '{:08X}'.format(size),
+            'slow': latency == "slow",
+            'cacheable': "yes" in str(info.get('cacheable', 'no')),
+        }
+
+    if len(ext_slaves) == 0:
+        exit("ext_slaves must have at least one slave")
+
+    ext_masters = [str(m).split(',')[0].strip() for m in obj['ext_slaves'].get('masters', ['memcopy_read', 'memcopy_write'])]
+
     flash_mem_start_address  = string2int(obj['flash_mem']['address'])
     flash_mem_size_address  = string2int(obj['flash_mem']['length'])
 
+    # Read cache of the flash, optional
+    flash_cache = obj['flash_mem']['cache'] if 'cache' in obj['flash_mem'] else {'ways': '0x0', 'sets': '0x2', 'line_words': '0x2'}
+    flash_cache_ways = int(string2int(flash_cache['ways']), 16)
+    if flash_cache_ways > 2:
+        exit("flash_mem cache ways must be 0, 1 or 2 instead of " + str(flash_cache_ways))
+
+    flash_cache_sets = int(string2int(flash_cache['sets']), 16)
+    if flash_cache_sets < 2 or not log2(flash_cache_sets).is_integer():
+        exit("flash_mem cache sets must be a power of 2 of at least 2 instead of " + str(flash_cache_sets))
+
+    flash_cache_line_words = int(string2int(flash_cache['line_words']), 16)
+    if flash_cache_line_words < 2 or not log2(flash_cache_line_words).is_integer():
+        exit("flash_mem cache line_words must be a power of 2 of at least 2 instead of " + str(flash_cache_line_words))
+
+    # Instruction cache of the core, optional
+    icache = obj['icache'] if 'icache' in obj else {'ways': '0x0', 'sets': '0x2', 'line_words': '0x2'}
+    icache_ways = int(string2int(icache['ways']), 16)
+    if icache_ways > 2:
+        exit("icache ways must be 0, 1 or 2 instead of " + str(icache_ways))
+
+    icache_sets = int(string2int(icache['sets']), 16)
+    if icache_sets < 2 or not log2(icache_sets).is_integer():
+        exit("icache sets must be a power of 2 of at least 2 instead of " + str(icache_sets))
+
+    icache_line_words = int(string2int(icache['line_words']), 16)
+    if icache_line_words < 2 or not log2(icache_line_words).is_integer():
+        exit("icache line_words must be a power of 2 of at least 2 instead of " + str(icache_line_words))
+
+    # Data cache of the core for the external memory, optional
+    dcache = obj['dcache'] if 'dcache' in obj else {'ways': '0x0', 'sets': '0x2', 'line_words': '0x2',
+                                                    'address': obj['ext_slaves']['address'], 'length': '0x0'}
+    dcache_ways = int(string2int(dcache['ways']), 16)
+    if dcache_ways > 2:
+        exit("dcache ways must be 0, 1 or 2 instead of " + str(dcache_ways))
+
+    dcache_sets = int(string2int(dcache['sets']), 16)
+    if dcache_sets < 2 or not log2(dcache_sets).is_integer():
+        exit("dcache sets must be a power of 2 of at least 2 instead of " + str(dcache_sets))
+
+    dcache_line_words = int(string2int(dcache['line_words']), 16)
+    if dcache_line_words < 2 or not log2(dcache_line_words).is_integer():
+        exit("dcache line_words must be a power of 2 of at least 2 instead of " + str(dcache_line_words))
+
+    dcache_start_address = string2int(dcache['address'])
+    dcache_size_address = string2int(dcache['length'])
+    if int(dcache_start_address, 16) < int(ext_slave_start_address, 16) or \
+       int(dcache_start_address, 16) + int(dcache_size_address, 16) > int(ext_slave_start_address, 16) + int(ext_slave_size_address, 16):
+        exit("the dcache region must be in the ext_slaves region")
+
+    dcache_start = int(dcache_start_address, 16)
+    dcache_end = dcache_start + int(dcache_size_address, 16)
+    for name, s in ext_slaves.items():
+        if dcache_ways > 0 and not s['cacheable'] and dcache_start < s['end'] and dcache_end > s['start']:
+            exit("the dcache region covers the ext_slaves slave " + name + ", which is not cacheable")
+
+    # Scratchpad private to the data port of the core, optional, outside the
+    # regions of the system bus
+    tcm = obj['tcm'] if 'tcm' in obj else {'address': '0x50000000', 'length': '0x0', 'stack': 'no'}
+    tcm_start_address = string2int(tcm['address'])
+    tcm_size_address = string2int(tcm['length'])
+    tcm_size = int(tcm_size_address, 16)
+    if tcm_size != 0 and (tcm_size < 1024 or not log2(tcm_size).is_integer()):
+        exit("tcm length must be 0 or a power of 2 of at least 1KiB instead of " + str(tcm_size))
+
+    tcm_start = int(tcm_start_address, 16)
+    for name, start, size in [('ram', ram_start_address, ram_size_address),
+                              ('debug', debug_start_address, debug_size_address),
+                              ('ao_peripherals', ao_peripheral_start_address, ao_peripheral_size_address),
+                              ('peripherals', peripheral_start_address, peripheral_size_address),
+                              ('flash_mem', flash_mem_start_address, flash_mem_size_address),
+                              ('ext_slaves', ext_slave_start_address, ext_slave_size_address)]:
+        if tcm_size != 0 and tcm_start < int(start, 16) + int(size, 16) and tcm_start + tcm_size > int(start, 16):
+            exit("the tcm region overlaps the " + name + " region")
+
+    tcm_stack = tcm_size != 0 and tcm.get('stack', 'no') == 'yes'
+
     linker_onchip_code_start_address  = string2int(obj['linker_script']['onchip_ls']['code']['address'])
     linker_onchip_code_size_address  = string2int(obj['linker_script']['onchip_ls']['code']['lenght'])
 
@@ -530,24 +765,57 @@ def main():
         if ram_numbanks_il == 0 or (ram_numbanks_cont == 1 and ram_numbanks_il > 0):
             linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16)))
         else:
-            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16) - ram_numbanks_il*32*1024))
+            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16) - ram_il_size))
     else:
         if ram_numbanks_il == 0 or (ram_numbanks_cont == 1 and ram_numbanks_il > 0):
             linker_onchip_data_size_address  = string2int(obj['linker_script']['onchip_ls']['data']['lenght'])
         else:
-            linker_onchip_data_size_address  = str('{:08X}'.format(int(string2int(obj['linker_script']['onchip_ls']['data']['lenght']),16) - ram_numbanks_il*32*1024))
+            linker_onchip_data_size_address  = str('{:08X}'.format(int(string2int(obj['linker_script']['onchip_ls']['data']['lenght']),16) - ram_il_size))
 
     linker_onchip_il_start_address = str('{:08X}'.format(int(linker_onchip_data_start_address,16) + int(linker_onchip_data_size_address,16)))
-    linker_onchip_il_size_address = str('{:08X}'.format(ram_numbanks_il*32*1024))
+    linker_onchip_il_size_address = str('{:08X}'.format(ram_il_size))
 
     stack_size  = string2int(obj['linker_script']['stack_size'])
     heap_size  = string2int(obj['linker_script']['heap_size'])
+    # Region of the arena and pool allocators, optional
+    arena_size = string2int(obj['linker_script']['arena_size']) if 'arena_size' in obj['linker_script'] else '0'
+
+    # Contiguous bank of the hot code and data (.xheep_text_fast/.xheep_data_fast),
+    # optional. In the on-chip linker script it must lie entirely in the code
+    # or data region, so that the rest of the program can stay out of it
+    fast_bank = obj['linker_script'].get('fast_bank', 'no')
+    if str(fast_bank).split(',')[0].split('#')[0].strip() == 'no':
+        fast_bank = None
+    else:
+        fast_bank = cfg2int(fast_bank)
+        if fast_bank < 0 or fast_bank >= ram_numbanks_cont:
+            exit("fast_bank must be one of the " + str(ram_numbanks_cont) + " contiguous banks instead of " + str(fast_bank))
+        fast_start, fast_size = ram_banks[fast_bank]
+        code_start = int(linker_onchip_code_start_address,16)
+        data_start = int(linker_onchip_data_start_address,16)
+        if not ((fast_start >= code_start and fast_start + fast_size <= code_start + int(linker_onchip_code_size_address,16)) or
+                (fast_start >= data_start and fast_start + fast_size <= data_start + int(linker_onchip_data_size_address,16))):
+            exit("fast_bank " + str(fast_bank) + " must lie entirely in the code or data region of onchip_ls")
+
+    # Number of code overlays (.xheep_overlay<n>) sharing an SRAM window with
+    # the flash linker scripts, optional
+    overlays = cfg2int(obj['linker_script'].get('overlays', 0))
+    if overlays < 0 or overlays > 16:
+        exit("overlays must be between 0 and 16 instead of " + str(overlays))
+
+    # Boot header of the flash_load images, read by the boot ROM: divider of
+    # the SPI clock and quad reads of the copy, optional
+    boot_spi_clkdiv = cfg2int(obj['linker_script'].get('boot_spi_clkdiv', 1))
+    if boot_spi_clkdiv < 0 or boot_spi_clkdiv > 0xFFFF:
+        exit("boot_spi_clkdiv must be between 0 and 65535 instead of " + str(boot_spi_clkdiv))
+    boot_spi_quad = obj['linker_script'].get('boot_spi_quad', 'no') == 'yes'
 
     if ((int(linker_onchip_data_size_address,16) + int(linker_onchip_code_size_address,16)) > int(ram_size_address,16)):
         exit("The code and data section must fit in the RAM size, instead they takes " + str(linker_onchip_data_size_address + linker_onchip_code_size_address))
     
-    if ((int(stack_size,16) + int(heap_size,16)) > int(ram_size_address,16)):
-        exit("The stack and heap section must fit in the RAM size, instead they takes " + str(stack_size + heap_size))
+    # one stack per hart
+    if ((int(stack_size,16) * cpu_num + int(heap_size,16) + int(arena_size,16)) > int(ram_size_address,16)):
+        exit("The stacks, heap and arena sections must fit in the RAM size, instead they takes " + hex(int(stack_size,16) * cpu_num + int(heap_size,16) + int(arena_size,16)))
 
 
     plic_used_n_interrupts = len(obj['interrupts']['list'])
@@ -819,6 +1087,17 @@ def main():
 
     total_pad_muxed = len(pad_muxed_list)
 
+    # The pads of the SPI slave select it at reset, so that a host can boot X-HEEP through it
+    spi_slave_pads = 0
+    if spi_slave:
+        for pad in pad_muxed_list:
+            for i, pad_mux in enumerate(pad.pad_mux_list):
+                if pad_mux.name.startswith('spi_slave_'):
+                    pad.mux_resval = i
+                    spi_slave_pads += 1
+        if spi_slave_pads == 0:
+            exit("spi_slave needs the spi_slave_* options in the pad muxes of " + args.pads_cfg.name)
+
     ##remove comma from last PAD io_interface
     last_pad = total_pad_list.pop()
     last_pad.remove_comma_io_interface()
@@ -826,12 +1105,20 @@ def main():
 
     kwargs = {
         "cpu_type"                         : cpu_type,
+        "cpu_num"                          : cpu_num,
+        "spi_slave"                        : spi_slave,
+        "num_mhpmcounters"                 : num_mhpmcounters,
+        "hpm_events"                       : hpm_events,
         "bus_type"                         : bus_type,
+        "bus_max_outstanding"              : bus_max_outstanding,
         "ram_start_address"                : ram_start_address,
         "ram_numbanks"                     : ram_numbanks,
         "ram_numbanks_cont"                : ram_numbanks_cont,
         "ram_numbanks_il"                  : ram_numbanks_il,
         "log_ram_numbanks_il"              : log_ram_numbanks_il,
+        "ram_banks"                        : ram_banks,
+        "ram_il_start"                     : ram_il_start,
+        "ram_il_size"                      : ram_il_size,
         "external_domains"                 : external_domains,
         "ram_size_address"                 : ram_size_address,
         "debug_start_address"              : debug_start_address,
@@ -840,14 +1127,42 @@ def main():
         "ao_peripheral_size_address"       : ao_peripheral_size_address,
         "ao_peripherals"                   : ao_peripherals,
         "ao_peripherals_count"             : ao_peripherals_count,
+        "dma_ch_count"                     : dma_ch_count,
+        "dma_ch_size"                      : dma_ch_size,
+        "dma_fifo_depth"                   : dma_fifo_depth,
+        "dma_max_outstanding"              : dma_max_outstanding,
         "peripheral_start_address"         : peripheral_start_address,
         "peripheral_size_address"          : peripheral_size_address,
         "peripherals"                      : peripherals,
         "peripherals_count"                : peripherals_count,
+        "crc_bytes_per_cycle"              : crc_bytes_per_cycle,
         "ext_slave_start_address"          : ext_slave_start_address,
         "ext_slave_size_address"           : ext_slave_size_address,
+        "ext_slaves"                       : ext_slaves,
+        "ext_masters"                      : ext_masters,
         "flash_mem_start_address"          : flash_mem_start_address,
         "flash_mem_size_address"           : flash_mem_size_address,
+        "flash_cache_ways"                 : flash_cache_ways,
+        "flash_cache_sets"                 : flash_cache_sets,
+        "flash_cache_line_words"           : flash_cache_line_words,
+        "dma_memcpy_channels"              : dma_memcpy_channels,
+        "bus_monitor_counters"             : bus_monitor_counters,
+        "event_trace_depth"                : event_trace_depth,
+        "icache_ways"                      : icache_ways,
+        "icache_sets"                      : icache_sets,
+        "icache_line_words"                : icache_line_words,
+        "dcache_ways"                      : dcache_ways,
+        "dcache_sets"                      : dcache_sets,
+        "dcache_line_words"                : dcache_line_words,
+        "dcache_start_address"             : dcache_start_address,
+        "dcache_size_address"              : dcache_size_address,
+        "tcm_start_address"                : tcm_start_address,
+        "tcm_size_address"                 : tcm_size_address,
+        "tcm_stack"                        : tcm_stack,
+        "fast_bank"                        : fast_bank,
+        "overlays"                         : overlays,
+        "boot_spi_clkdiv"                  : boot_spi_clkdiv,
+        "boot_spi_quad"                    : boot_spi_quad,
         "linker_onchip_code_start_address" : linker_onchip_code_start_address,
         "linker_onchip_code_size_address"  : linker_onchip_code_size_address,
         "linker_onchip_data_start_address" : linker_onchip_data_start_address,
@@ -856,6 +1171,7 @@ def main():
         "linker_onchip_il_size_address"    : linker_onchip_il_size_address,
         "stack_size"                       : stack_size,
         "heap_size"                        : heap_size,
+        "arena_size"                       : arena_size,
         "plic_used_n_interrupts"           : plic_used_n_interrupts,
         "plit_n_interrupts"                : plit_n_interrupts,
         "interrupts"                       : interrupts,
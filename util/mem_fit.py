@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Fits stack_size and heap_size of mcu_cfg.hjson to the high-water marks
+# measured by a program built with CRT_PAINT=1 and printed by mem_usage_dump()
+# (sw/device/lib/runtime/mem_usage.h), e.g. in the uart0.log of the Verilator
+# testbench. With several logs, e.g. of the test cases of the program, the
+# highest marks are kept. The sizes get a margin and are rounded up to 16
+# bytes, the alignment of the stack.
+#
+# The stack and the heap follow the static data in the data region of the
+# linker scripts: the bytes freed are left to the data, and the banks the
+# region no longer reaches are found unused by ram_banks_unused() and can be
+# switched off (ram_banks.h). Regenerate with the fitted configuration:
+#
+#   util/mem_fit.py uart0.log --cfg mcu_cfg.hjson -o build/mcu_cfg_fit.hjson
+#   make mcu-gen MCU_CFG=build/mcu_cfg_fit.hjson
+
+import argparse
+import re
+import sys
+
+ALIGN = 16
+
+
+class FitError(Exception):
+    pass
+
+
+def parse(paths):
+    """Returns the highest bytes used of each region in the MEM lines of the logs."""
+    used = {}
+    for path in paths:
+        header = None
+        with open(path, errors='replace') as f:
+            for line in f:
+                # The lines printed through the UART end with \n\r
+                fields = line.strip().split(',')
+                if fields[0] != 'MEM':
+                    continue
+                if fields[1] == 'region':
+                    header = fields[1:]
+                elif header is not None and len(fields) == len(header) + 1:
+                    row = dict(zip(header, fields[1:]))
+                    used[row['region']] = max(used.get(row['region'], 0), int(row['used']))
+    return used
+
+
+def fit(used, margin, minimum):
+    size = int(used * (1 + margin / 100.0)) + minimum
+    return (size + ALIGN - 1) // ALIGN * ALIGN
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Fit stack_size and heap_size of mcu_cfg.hjson to a program')
+    parser.add_argument('logs', nargs='+', help='output of runs with the MEM lines of mem_usage_dump()')
+    parser.add_argument('--cfg', default='mcu_cfg.hjson', help='configuration of the MCU (default: mcu_cfg.hjson)')
+    parser.add_argument('-o', '--output', help='fitted configuration (default: only print the sizes)')
+    parser.add_argument('--margin', type=float, default=25, help='margin over the marks, in %% (default: 25)')
+    parser.add_argument('--min', type=lambda s: int(s, 0), default=64,
+                        help='bytes added to the margin, e.g. for the interrupts (default: 64)')
+    args = parser.parse_args()
+
+    try:
+        used = parse(args.logs)
+        if not used:
+            raise FitError('no MEM lines in the logs')
+        with open(args.cfg) as f:
+            cfg = f.read()
+
+        marks = {}
+        if 'stack' in used:
+            marks['stack_size'] = used['stack']
+        else:
+            print('mem_fit: the stack was not measured, build with CRT_PAINT=1; stack_size is kept')
+        marks['heap_size'] = max(used.get('heap', 0), used.get('sbrk', 0))
+
+        freed = 0
+        for key, mark in marks.items():
+            size = fit(mark, args.margin, args.min)
+            pattern = re.compile(r'(\b{}\s*:\s*)(0x[0-9A-Fa-f]+|\d+)'.format(key))
+            m = pattern.search(cfg)
+            if m is None:
+                raise FitError('no {} in {}'.format(key, args.cfg))
+            old = int(m.group(2), 0)
+            print('{}: {} -> {} bytes ({} used)'.format(key, old, size, mark))
+            freed += old - size
+            cfg = pattern.sub(lambda m: m.group(1) + '0x{:X}'.format(size), cfg, count=1)
+        print('{} bytes {}'.format(abs(freed), 'freed' if freed >= 0 else 'added'))
+
+        if args.output:
+            with open(args.output, 'w') as f:
+                f.write(cfg)
+    except (FitError, OSError) as e:
+        sys.exit('mem_fit: {}'.format(e))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# Copyright 2026 EPFL
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Runs an X-HEEP program from the Zynq PS of the pynq-z2-ps-ddr target, as
+# root on the Linux of the board:
+#
+#   1. holds X-HEEP in reset with the EMIO GPIO 0 and releases it, the boot
+#      ROM then waits in its JTAG loop (boot_select_i must be 0)
+#   2. writes the loadable segments of the ELF (built with LINKER=on_chip)
+#      through the M_AXI_GP0 window, where X-HEEP is seen from 0x40000000
+#   3. writes BOOT_ADDRESS and BOOT_EXIT_LOOP of soc_ctrl, as OpenOCD or
+#      tb_set_exit_loop in simulation
+#   4. waits for EXIT_VALID and prints EXIT_VALUE, and the regions of
+#      runtime/perf.h as perf_dump ("PERF," lines) if the program uses them
+#
+# The exit status is 0 if the program returned 0.
+
+import argparse
+import mmap
+import os
+import struct
+import sys
+import time
+
+# M_AXI_GP0 window (hw/fpga/scripts/pynq-z2/xilinx_generate_ps_ddr.tcl) and
+# address of soc_ctrl in mcu_cfg.hjson
+WINDOW_BASE = 0x40000000
+SOC_CTRL_START_ADDRESS = 0x20000000
+
+# sw/device/lib/drivers/soc_ctrl/soc_ctrl_regs.h
+SOC_CTRL_EXIT_VALID = 0x00
+SOC_CTRL_EXIT_VALUE = 0x04
+SOC_CTRL_BOOT_EXIT_LOOP = 0x0C
+SOC_CTRL_BOOT_ADDRESS = 0x10
+
+# Zynq GPIO controller, the EMIO pins are the bank 2
+PS_GPIO_BASE = 0xE000A000
+PS_GPIO_DATA_2 = 0x048
+PS_GPIO_DIRM_2 = 0x284
+PS_GPIO_OEN_2 = 0x288
+
+# perf_region_t of sw/device/lib/runtime/perf.h
+PERF_REGION = struct.Struct("<IiI4x9Q")
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError(f"{path}: not a 32-bit little-endian ELF")
+        (self.entry, phoff, shoff, _, _, phentsize, phnum, shentsize, shnum, _) = (
+            struct.unpack_from("<IIIIHHHHHH", self.data, 24)
+        )
+
+        # (address, content) of the PT_LOAD segments, at their load address
+        self.segments = []
+        for i in range(phnum):
+            p_type, p_offset, _, p_paddr, p_filesz, p_memsz, _, _ = struct.unpack_from(
+                "<8I", self.data, phoff + i * phentsize
+            )
+            if p_type == 1 and p_memsz:
+                content = self.data[p_offset : p_offset + p_filesz]
+                self.segments.append((p_paddr, content + bytes(p_memsz - p_filesz)))
+
+        # name -> address, the static variables included
+        self.symbols = {}
+        sections = [
+            struct.unpack_from("<10I", self.data, shoff + i * shentsize) for i in range(shnum)
+        ]
+        for sh in sections:
+            if sh[1] != 2:  # SHT_SYMTAB
+                continue
+            strtab = sections[sh[6]]
+            for off in range(sh[4], sh[4] + sh[5], 16):
+                st_name, st_value = struct.unpack_from("<II", self.data, off)
+                end = self.data.index(b"\0", strtab[4] + st_name)
+                self.symbols[self.data[strtab[4] + st_name : end].decode()] = st_value
+
+    def string(self, address):
+        for base, content in self.segments:
+            if base <= address < base + len(content):
+                end = content.find(b"\0", address - base)
+                return content[address - base : end].decode(errors="replace")
+        return f"0x{address:08x}"
+
+
+class Window:
+    """A part of X-HEEP seen by the PS, from the X-HEEP address start, with
+    32-bit accesses only."""
+
+    def __init__(self, fd, start, size):
+        size = (size + mmap.PAGESIZE - 1) & ~(mmap.PAGESIZE - 1)
+        self.start = start
+        self.mem = mmap.mmap(
+            fd, size, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE, offset=WINDOW_BASE + start
+        )
+        self.words = memoryview(self.mem).cast("I")
+
+    def read32(self, address):
+        return self.words[(address - self.start) >> 2]
+
+    def write32(self, address, value):
+        self.words[(address - self.start) >> 2] = value & 0xFFFFFFFF
+
+    def write(self, address, content):
+        # The partial words at the ends are read, modified and written back
+        head = address & 3
+        if head:
+            address -= head
+            content = self.read32(address).to_bytes(4, "little")[:head] + content
+        tail = len(content) & 3
+        if tail:
+            last = self.read32(address + len(content) - tail).to_bytes(4, "little")
+            content += last[tail:]
+        words = memoryview(bytearray(content)).cast("I")
+        index = (address - self.start) >> 2
+        self.words[index : index + len(words)] = words
+
+
+def ps_reset(fd, hold):
+    page = mmap.mmap(fd, mmap.PAGESIZE, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE, offset=PS_GPIO_BASE)
+    regs = memoryview(page).cast("I")
+    regs[PS_GPIO_DIRM_2 >> 2] |= 1
+    regs[PS_GPIO_OEN_2 >> 2] |= 1
+    if hold:
+        regs[PS_GPIO_DATA_2 >> 2] |= 1
+    else:
+        regs[PS_GPIO_DATA_2 >> 2] &= ~1 & 0xFFFFFFFF
+    regs.release()
+    page.close()
+
+
+def dump_perf(elf, window):
+    if "perf_regions" not in elf.symbols or "perf_num_regions" not in elf.symbols:
+        return
+    regions = []
+    for i in range(window.read32(elf.symbols["perf_num_regions"])):
+        address = elf.symbols["perf_regions"] + i * PERF_REGION.size
+        raw = b"".join(
+            window.read32(address + off).to_bytes(4, "little") for off in range(0, PERF_REGION.size, 4)
+        )
+        regions.append(PERF_REGION.unpack(raw))
+
+    print(
+        "PERF,region,parent,count,cycles_min,cycles_max,cycles_avg,"
+        "instr_min,instr_max,instr_avg,event_min,event_max,event_avg"
+    )
+    for name, parent, count, *stats in regions:
+        line = [elf.string(name), elf.string(regions[parent][0]) if parent >= 0 else "", str(count)]
+        for s_min, s_max, s_total in zip(stats[0::3], stats[1::3], stats[2::3]):
+            line += [str(s_min if count else 0), str(s_max), str(s_total // count if count else 0)]
+        print("PERF," + ",".join(line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load and run an X-HEEP program from the Zynq PS")
+    parser.add_argument("elf", help="main.elf of the program, built with LINKER=on_chip")
+    parser.add_argument("--timeout", type=float, default=60.0, help="seconds to wait for the exit, 0 for ever")
+    parser.add_argument("--no-reset", action="store_true", help="do not reset X-HEEP before loading")
+    parser.add_argument("--no-perf", action="store_true", help="do not print the perf.h regions")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    fd = os.open("/dev/mem", os.O_RDWR | os.O_SYNC)
+    # Only the RAM used by the program and soc_ctrl are mapped
+    window = Window(fd, 0, max(address + len(content) for address, content in elf.segments))
+    soc_ctrl = Window(fd, SOC_CTRL_START_ADDRESS, mmap.PAGESIZE)
+
+    if not args.no_reset:
+        ps_reset(fd, True)
+        time.sleep(0.001)
+        ps_reset(fd, False)
+
+    start = time.monotonic()
+    for address, content in elf.segments:
+        window.write(address, content)
+    loaded = time.monotonic()
+
+    soc_ctrl.write32(SOC_CTRL_START_ADDRESS + SOC_CTRL_BOOT_ADDRESS, elf.entry)
+    soc_ctrl.write32(SOC_CTRL_START_ADDRESS + SOC_CTRL_BOOT_EXIT_LOOP, 1)
+
+    while not soc_ctrl.read32(SOC_CTRL_START_ADDRESS + SOC_CTRL_EXIT_VALID) & 1:
+        if args.timeout and time.monotonic() - loaded > args.timeout:
+            print(f"Timeout after {args.timeout} s", file=sys.stderr)
+            return 2
+        time.sleep(0.0001)
+    done = time.monotonic()
+
+    exit_value = soc_ctrl.read32(SOC_CTRL_START_ADDRESS + SOC_CTRL_EXIT_VALUE)
+    size = sum(len(content) for _, content in elf.segments)
+    print(f"Loaded {size} bytes in {loaded - start:.3f} s, ran in {done - loaded:.3f} s")
+    print(f"Program Finished with value {exit_value}")
+    if not args.no_perf:
+        dump_perf(elf, window)
+
+    return 0 if exit_value == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
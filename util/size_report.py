@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Post-link report of an application: the bytes of each section in each RAM
+# bank, the TCM and the flash, from the ELF and the memory map of
+# core_v_mini_mcu.h, and optionally the cycle counts of the regions of perf.h
+# (the PERF lines of perf_dump) from the output of a run, e.g. its uart0.log.
+# The sections are placed by their run address, so with LINKER=flash_load the
+# loaded ones are counted in the RAM. The build writes the report in
+# sw/build/main.size.md; to add the cycles of a run:
+#
+#   util/size_report.py sw/build/main.elf --mcu-header sw/device/lib/runtime/core_v_mini_mcu.h \
+#                       --log build/.../sim-verilator/uart0.log
+
+import argparse
+import csv
+import re
+import struct
+import sys
+
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+SHT_NOBITS = 8
+
+DEFINE = re.compile(r'#define\s+(\w+)\s+(0x[0-9A-Fa-f]+|\d+)\s*$')
+
+
+class ReportError(Exception):
+    pass
+
+
+def load_sections(path):
+    """Returns (name, address, size, kind) of the sections of an ELF32 placed in memory."""
+    with open(path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[4] != 1:
+        raise ReportError('{} is not an ELF32 file'.format(path))
+    e_shoff = struct.unpack_from('<I', elf, 0x20)[0]
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+    strtab = struct.unpack_from('<I', elf, e_shoff + e_shstrndx * e_shentsize + 0x10)[0]
+    sections = []
+    for i in range(e_shnum):
+        sh_name, sh_type, sh_flags, sh_addr, _, sh_size = struct.unpack_from(
+            '<IIIIII', elf, e_shoff + i * e_shentsize)
+        if not sh_flags & SHF_ALLOC or not sh_size:
+            continue
+        name = elf[strtab + sh_name:elf.index(b'\0', strtab + sh_name)].decode()
+        if sh_type == SHT_NOBITS:
+            kind = 'bss'
+        elif sh_flags & SHF_EXECINSTR:
+            kind = 'text'
+        elif sh_flags & SHF_WRITE:
+            kind = 'data'
+        else:
+            kind = 'rodata'
+        sections.append((name, sh_addr, sh_size, kind))
+    return sections
+
+
+def load_regions(path):
+    """Returns (name, start, size) of the memories of core_v_mini_mcu.h."""
+    defines = {}
+    with open(path) as f:
+        for line in f:
+            m = DEFINE.match(line.strip())
+            if m:
+                defines[m.group(1)] = int(m.group(2), 0)
+    if 'MEMORY_BANKS' not in defines:
+        raise ReportError('no MEMORY_BANKS in {}'.format(path))
+    regions = []
+    cont = defines.get('MEMORY_BANKS_CONT', defines['MEMORY_BANKS'])
+    for n in range(cont):
+        regions.append(('bank{}'.format(n), defines['MEMORY_BANK{}_START_ADDRESS'.format(n)],
+                        defines['MEMORY_BANK{}_SIZE'.format(n)]))
+    # The interleaved banks share their addresses, they are one region
+    if defines.get('RAM_IL_SIZE'):
+        regions.append(('interleaved', defines['RAM_IL_START_ADDRESS'], defines['RAM_IL_SIZE']))
+    if defines.get('TCM_SIZE'):
+        regions.append(('tcm', defines['TCM_START_ADDRESS'], defines['TCM_SIZE']))
+    if defines.get('FLASH_MEM_SIZE'):
+        regions.append(('flash', defines['FLASH_MEM_START_ADDRESS'], defines['FLASH_MEM_SIZE']))
+    return regions
+
+
+def place(sections, regions):
+    """Returns the bytes of each section in each region, split where a section spans banks."""
+    usage = {name: [] for name, _, _ in regions}
+    usage['other'] = []
+    for name, addr, size, kind in sections:
+        left = size
+        for region, start, length in regions:
+            lo, hi = max(addr, start), min(addr + size, start + length)
+            if lo < hi:
+                usage[region].append((name, hi - lo, kind))
+                left -= hi - lo
+        if left > 0:
+            usage['other'].append((name, left, kind))
+    return usage
+
+
+def parse_perf(path):
+    """Returns the rows of the PERF lines of a log, as dicts."""
+    header = None
+    rows = []
+    with open(path, errors='replace') as f:
+        for line in f:
+            # The lines printed through the UART end with \n\r
+            line = line.strip()
+            if not line.startswith('PERF,'):
+                continue
+            fields = next(csv.reader([line]))[1:]
+            if fields[0] == 'region':
+                header = fields
+                rows = []
+            elif header is not None and len(fields) == len(header):
+                rows.append(dict(zip(header, fields)))
+    return rows
+
+
+def report(out, elf, sections, regions, perf):
+    usage = place(sections, regions)
+    sizes = {name: length for name, _, length in regions}
+    kinds = ('text', 'rodata', 'data', 'bss')
+
+    out.write('# Size report of {}\n\n'.format(elf))
+    out.write('| memory | size | used | free | use | text | rodata | data | bss |\n')
+    out.write('| --- | ---: | ---: | ---: | ---: | ---: | ---: | ---: | ---: |\n')
+    for region in list(sizes) + ['other']:
+        used = sum(size for _, size, _ in usage[region])
+        if region == 'other' and not used:
+            continue
+        by_kind = [sum(size for _, size, k in usage[region] if k == kind) for kind in kinds]
+        length = sizes.get(region)
+        out.write('| {} | {} | {} | {} | {} | {} |\n'.format(
+            region, length if length is not None else '', used,
+            length - used if length is not None else '',
+            '{:.1f}%'.format(100.0 * used / length) if length else '',
+            ' | '.join(str(n) for n in by_kind)))
+
+    out.write('\n## Sections\n\n')
+    out.write('| memory | section | bytes | kind |\n')
+    out.write('| --- | --- | ---: | --- |\n')
+    for region in list(sizes) + ['other']:
+        for name, size, kind in sorted(usage[region], key=lambda s: -s[1]):
+            out.write('| {} | {} | {} | {} |\n'.format(region, name, size, kind))
+
+    if perf is not None:
+        out.write('\n## Regions of perf.h\n\n')
+        if not perf:
+            out.write('No PERF lines in the log.\n')
+            return
+        out.write('| region | parent | count | cycles avg | cycles min | cycles max | instr avg |\n')
+        out.write('| --- | --- | ---: | ---: | ---: | ---: | ---: |\n')
+        for row in perf:
+            out.write('| {} | {} | {} | {} | {} | {} | {} |\n'.format(
+                row['region'], row['parent'], row['count'], row['cycles_avg'],
+                row['cycles_min'], row['cycles_max'], row['instr_avg']))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Report the sizes of an application per RAM bank')
+    parser.add_argument('elf', help='ELF of the application, e.g. sw/build/main.elf')
+    parser.add_argument('--mcu-header', required=True,
+                        help='memory map, sw/device/lib/runtime/core_v_mini_mcu.h')
+    parser.add_argument('--log', help='output of a run with the PERF lines of perf_dump(), e.g. uart0.log')
+    parser.add_argument('-o', '--output', help='file of the report, in markdown (default: standard output)')
+    args = parser.parse_args()
+
+    try:
+        sections = load_sections(args.elf)
+        regions = load_regions(args.mcu_header)
+        perf = parse_perf(args.log) if args.log else None
+        if args.output:
+            with open(args.output, 'w') as out:
+                report(out, args.elf, sections, regions, perf)
+        else:
+            report(sys.stdout, args.elf, sections, regions, perf)
+    except (ReportError, OSError) as e:
+        sys.exit('size_report: {}'.format(e))
+
+
+if __name__ == '__main__':
+    main()
@@ -41,6 +41,14 @@ line_comment_end = "*/"
 struct_comment = "Structure used for bit access"
 word_comment = "Type used for word access"
 
+# Field accessors definitions #
+inline_fn = "static inline __attribute__((always_inline)) {} {}({})\n{{\n" + tab_spaces + "{}\n}}\n"
+
+# Software accesses without reads, without writes, and with writes that have side effects #
+ro_access = ["ro", "rc"]
+wo_access = ["wo", "r0w1c"]
+w1_access = ["rw1c", "rw1s", "rw0c"]
+
 
 def read_json(json_file):
     """
@@ -53,9 +61,9 @@ def read_json(json_file):
     return j_data
 
 
-def write_template(tpl, structs, enums, struct_name):
+def write_template(tpl, structs, enums, struct_name, inline_functions=""):
     """
-    Opens a given template and substitutes the structs and enums fields.
+    Opens a given template and substitutes the structs, enums and inline functions fields.
     Returns a string with the content of the updated template
     """
 
@@ -75,7 +83,8 @@ def write_template(tpl, structs, enums, struct_name):
                                 peripheral_name=struct_name, 
                                 peripheral_name_upper=upper_case_name, 
                                 date=today,
-                                start_address_define=start_addr_def)
+                                start_address_define=start_addr_def,
+                                inline_functions=inline_functions)
 
 
 def write_output(out_file, out_string):
@@ -138,6 +147,17 @@ def count_bits(bits_range):
         return 1
 
 
+def field_range(bits_range):
+    """
+    Returns the index of the first bit and the amount of bits of a field, whose
+    "bits_range" is formatted as in count_bits()
+    """
+    if bits_range.find(":") != -1:
+        return int(bits_range.split(":")[1]), count_bits(bits_range)
+    else:
+        return int(bits_range), 1
+
+
 def select_type(amount_of_bits):
     """
     Used to select the C type to give to a specific bit field. The type depends on the amount of bits
@@ -258,6 +278,11 @@ def add_registers(peripheral_json):
     reg_struct = "\n"
     reg_enum = ""
 
+    # registers for which the field accessors are generated: the json of the
+    # register, the name of its (first) member and, for multiregs, the number
+    # of fields per register (0 for one register per copy)
+    reg_accessors = []
+
     # number of "reserved" fields. Used to name them with a progressive ID
     num_of_reserved = 0 
 
@@ -287,17 +312,27 @@ def add_registers(peripheral_json):
 
             # search the multireg count default value
             # This is the number of bitfields needed
-            for p in peripheral_json["param_list"]:
+            count = None
+            for p in peripheral_json.get("param_list", []):
                 if count_var == p["name"]:
                     count = int(p["default"])
-            
-            # counts the bits needed by the multireg register
-            n_bits = 0
-            for f in multireg["fields"]:
-                n_bits += count_bits(f["bits"])
+            if count is None:
+                count = int(count_var)
+
+            # As in reggen, a multireg with a single field is compacted by default:
+            # each register packs as many copies of the field as fit.
+            # Otherwise there is one register per copy.
+            compact = multireg.get("compact", len(multireg["fields"]) == 1)
+            compact = str(compact).lower() in ["true", "1"]
+            if compact:
+                f = multireg["fields"][0]
+                field_lsb, field_bits = field_range(f["bits"])
+                fields_per_reg = int(peripheral_json["regwidth"]) // (field_lsb + field_bits)
+            else:
+                fields_per_reg = 1
 
             # computes the number of registers needed to pack all the bit fields needed
-            n_multireg = int((count * n_bits) /  int(peripheral_json["regwidth"]))
+            n_multireg = (count + fields_per_reg - 1) // fields_per_reg
             
             # generate the multiregisters
             for r in range(n_multireg):
@@ -307,16 +342,23 @@ def add_registers(peripheral_json):
                 reg_struct += line.ljust(comment_align_space) + reg_comment
                 bytes_offset += 4   # one register is 4 bytes
 
+            reg_accessors.append((multireg, multireg["name"] + "0", fields_per_reg if compact else 0))
+
         # check and handle the "window" case
         elif "window" in elem:
             
             window = elem["window"]
             
             validbits = int(window["validbits"])
+            items = int(window["items"])
 
-            line = tab_spaces + "{} {};".format(select_type(validbits), window["name"])
+            if items > 1:
+                line = tab_spaces + "uint32_t {}[{}];".format(window["name"], items)
+            else:
+                line = tab_spaces + "{} {};".format(select_type(validbits), window["name"])
             reg_comment = line_comment_start + window["desc"].replace("\n", " ") + line_comment_end + "\n\n"
             reg_struct += line.ljust(comment_align_space) + reg_comment
+            bytes_offset += 4 * items
             
 
         # if no multireg or window, just generate the reg
@@ -327,6 +369,8 @@ def add_registers(peripheral_json):
             reg_struct += line.ljust(comment_align_space) + reg_comment
             bytes_offset += 4       # in order to properly generate subsequent "multireg cases"
 
+            reg_accessors.append((elem, elem["name"], None))
+
         if "skipto" in elem:
             new_address = elem["skipto"]
 
@@ -362,7 +406,88 @@ def add_registers(peripheral_json):
 
             # reg_struct += union_end.format(elem["name"])
     
-    return reg_struct, reg_enum
+    return reg_struct, reg_enum, reg_accessors
+
+
+def is_reserved(field_name):
+    """
+    Returns True for the fields that only document unused bits
+    """
+    return field_name.lower().lstrip("_").startswith("reserved")
+
+
+def gen_field_accessors(struct_name, reg_json, member, fields_per_reg):
+    """
+    Generates the masks and forced-inline getter and setter of each field of a
+    register, so that a field access is one load (and one store) with the mask
+    and shift folded by the compiler. The fields of a multireg are accessed by
+    their index, in the register that holds them.
+
+    :param struct_name: the name of the peripheral structure
+    :param reg_json: the json-like description of the register (or multireg)
+    :param member: the name of the (first) structure member of the register
+    :param fields_per_reg: None for a register, else the number of copies of the
+    field in each register of a compacted multireg, or 0 with one register per copy
+    :return: the string of the defines and functions of the fields
+    """
+    res = ""
+    prefix = struct_name.lower() + "_" + reg_json["name"].lower()
+    def_prefix = struct_name.upper() + "_" + reg_json["name"].upper()
+    reg_swaccess = reg_json.get("swaccess", "rw")
+    ptr = "volatile {} *p_peri".format(struct_name)
+
+    for field in reg_json["fields"]:
+        field_name = field.get("name", reg_json["name"])
+        if is_reserved(field_name):
+            continue
+        swaccess = field.get("swaccess", reg_swaccess)
+        readable = swaccess not in wo_access
+        writable = swaccess not in ro_access
+        # a read-modify-write would clear or set the other bits
+        rmw = readable and swaccess not in w1_access
+
+        lsb, n_bits = field_range(field["bits"])
+        mask = (0xffffffff if n_bits == 32 else (1 << n_bits) - 1)
+        name = prefix + "_" + field_name.lower()
+        def_name = def_prefix + "_" + field_name.upper()
+        desc = field.get("desc", reg_json.get("desc", "")).strip().split("\n")[0].strip().replace("*/", "* /")
+
+        res += "/* {}.{}: {} */\n".format(reg_json["name"], field_name, desc)
+
+        # compacted multireg: the field of index idx is in the register idx / fields_per_reg
+        if fields_per_reg:
+            reg = "(&p_peri->{})[idx / {}]".format(member, fields_per_reg)
+            shift = "({}u + (idx % {}u) * {}u)".format(lsb, fields_per_reg, lsb + n_bits)
+            if readable:
+                res += inline_fn.format("uint32_t", name + "_get", ptr + ", uint32_t idx",
+                                        "return ({} >> {}) & {}u;".format(reg, shift, hex(mask)))
+            if writable and rmw:
+                res += inline_fn.format("void", name + "_set", ptr + ", uint32_t idx, uint32_t v",
+                                        "volatile uint32_t *reg = &{};\n".format(reg) + tab_spaces +
+                                        "uint32_t shift = {};\n".format(shift) + tab_spaces +
+                                        "*reg = (*reg & ~({}u << shift)) | ((v & {}u) << shift);".format(hex(mask), hex(mask)))
+            res += "\n"
+            continue
+
+        res += "#define {}_FMASK {}u\n".format(def_name, hex(mask << lsb))
+        res += "#define {}_FVAL(v) ((((uint32_t)(v)) << {}) & {}_FMASK)\n".format(def_name, lsb, def_name)
+
+        # one register per copy of a multireg, the copy of index idx is in the register idx
+        if fields_per_reg == 0:
+            reg = "(&p_peri->{})[idx]".format(member)
+            args = ptr + ", uint32_t idx"
+        else:
+            reg = "p_peri->{}".format(member)
+            args = ptr
+        if readable:
+            res += inline_fn.format("uint32_t", name + "_get", args,
+                                    "return ({} & {}_FMASK) >> {};".format(reg, def_name, lsb))
+        if writable and rmw:
+            res += inline_fn.format("void", name + "_set", args + ", uint32_t v",
+                                    "{} = ({} & ~{}_FMASK) | {}_FVAL(v);".format(reg, reg, def_name, def_name))
+        res += "\n"
+
+    return res
 
 
 # def gen(input_template, input_hjson_file):
@@ -398,13 +523,18 @@ def main(arg_vect):
 
     # START OF THE GENERATION #
 
-    reg_structs, reg_enums = add_registers(data)
+    reg_structs, reg_enums, reg_accessors = add_registers(data)
     structs_definitions += reg_structs
     enums_definitions += reg_enums
 
     structs_definitions += "}} {};".format(data["name"])
 
-    final_output = write_template(input_template, structs_definitions, enums_definitions, data["name"])
+    inline_functions = ""                           # used to store the field accessors
+    for reg_json, member, fields_per_reg in reg_accessors:
+        inline_functions += gen_field_accessors(data["name"], reg_json, member, fields_per_reg)
+
+    final_output = write_template(input_template, structs_definitions, enums_definitions, data["name"],
+                                  inline_functions)
     write_output(output_filename, final_output)
 
 
@@ -1,5 +1,6 @@
 import hjson
 import structs_gen
+import hal_cpp_gen
 
 # Path to the header_structs template
 template_path = "./sw/device/lib/drivers/template.tpl"
@@ -11,9 +12,14 @@ mcu_cfg_file = "./mcu_cfg.hjson"
 # the name of the peripheral
 out_files_base_path = "./sw/device/lib/drivers/{}/{}_structs.h" 
 
+# Path to the template and the files of the C++ registers, in the same folders
+hal_template_path = "./sw/device/lib/drivers/template_hal.tpl"
+hal_out_files_base_path = "./sw/device/lib/drivers/{}/{}_regs.hpp"
+
 
 JSON_FILES = []         # list of the peripherals' json files
 OUTPUT_FILES = []       # list of the output filenames
+HAL_OUTPUT_FILES = []   # list of the C++ output filenames
 PERIPHERAL_NAMES = []   # list of the peripherals' names
 
 
@@ -25,7 +31,8 @@ PERIPHERAL_NAMES = []   # list of the peripherals' names
 def add_peripheral(name, path):
     JSON_FILES.append(path)
     OUTPUT_FILES.append(out_files_base_path.format(name, name))
-    # PERIPHERAL_NAMES.append(name)
+    HAL_OUTPUT_FILES.append(hal_out_files_base_path.format(name, name))
+    PERIPHERAL_NAMES.append(name)
 
 
 """
@@ -64,4 +71,9 @@ if __name__ == "__main__":
                                 # "--peripheral_name", PERIPHERAL_NAMES[i],
                                 "--json_filename", JSON_FILES[i], 
                                 "--output_filename", OUTPUT_FILES[i]]
-                            )
\ No newline at end of file
+                            )
+        hal_cpp_gen.main([ "--template_filename", hal_template_path,
+                                "--peripheral_name", PERIPHERAL_NAMES[i],
+                                "--json_filename", JSON_FILES[i],
+                                "--output_filename", HAL_OUTPUT_FILES[i]]
+                            )
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+# Copyright 2022 OpenHW Group
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# Decoder of the execution trace written by the Verilator testbench with
+# +exec_trace=<file>, the format is described in tb/tb_exec_trace.h
+
+import argparse
+import csv
+import struct
+import sys
+
+TB_EXEC_TRACE_MAGIC = b'XHTRACE\0'
+TB_EXEC_TRACE_VERSION = 1
+
+TB_EXEC_TRACE_INSTR = 1
+TB_EXEC_TRACE_REG = 2
+TB_EXEC_TRACE_BUS = 3
+
+# Order of the system crossbar masters in core_v_mini_mcu_pkg
+XBAR_MASTER_NAMES = ['core_instr', 'core_data', 'debug']
+# Each DMA channel then has a read, a write and an address master
+DMA_MASTER_NAMES = ['dma_read', 'dma_write', 'dma_addr']
+
+
+class TraceError(Exception):
+    pass
+
+
+class Reader:
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def eof(self):
+        return self.pos >= len(self.data)
+
+    def bytes(self, n):
+        if self.pos + n > len(self.data):
+            raise TraceError('truncated record at offset {}'.format(self.pos))
+        value = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return value
+
+    def u8(self):
+        return self.bytes(1)[0]
+
+    def u16(self):
+        return struct.unpack('<H', self.bytes(2))[0]
+
+    def u32(self):
+        return struct.unpack('<I', self.bytes(4))[0]
+
+    def uleb(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.u8()
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def sleb(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.u8()
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                if byte & 0x40:
+                    value -= 1 << shift
+                return value
+
+
+def master_name(master):
+    if master < len(XBAR_MASTER_NAMES):
+        return XBAR_MASTER_NAMES[master]
+    ch, port = divmod(master - len(XBAR_MASTER_NAMES), len(DMA_MASTER_NAMES))
+    return '{}_ch{}'.format(DMA_MASTER_NAMES[port], ch)
+
+
+def decode(data):
+    """Yields the records of the trace as dictionaries"""
+    rd = Reader(data)
+    if rd.bytes(len(TB_EXEC_TRACE_MAGIC)) != TB_EXEC_TRACE_MAGIC:
+        raise TraceError('not an execution trace')
+    version = rd.u8()
+    if version != TB_EXEC_TRACE_VERSION:
+        raise TraceError('unsupported version {}'.format(version))
+    rd.u8()  # number of masters
+
+    cycle = 0
+    pc = 0
+    while not rd.eof():
+        kind = rd.u8()
+        cycle += rd.uleb()
+        if kind == TB_EXEC_TRACE_INSTR:
+            pc = (pc + rd.sleb()) & 0xffffffff
+            instr = rd.u16()
+            if instr & 0x3 == 0x3:
+                instr |= rd.u16() << 16
+            yield {'cycle': cycle, 'type': 'instr', 'pc': pc, 'instr': instr}
+        elif kind == TB_EXEC_TRACE_REG:
+            yield {'cycle': cycle, 'type': 'reg', 'rd': rd.u8(), 'value': rd.u32()}
+        elif kind == TB_EXEC_TRACE_BUS:
+            master = rd.u8()
+            yield {
+                'cycle': cycle,
+                'type': 'bus',
+                'master': master_name(master & 0x7f),
+                'we': master >> 7,
+                'be': rd.u8(),
+                'addr': rd.u32(),
+                'data': rd.u32(),
+                'stall': rd.uleb(),
+                'latency': rd.uleb()
+            }
+        else:
+            raise TraceError('unknown record type {} at offset {}'.format(kind, rd.pos - 1))
+
+
+def format_text(rec):
+    if rec['type'] == 'instr':
+        width = 8 if rec['instr'] & 0x3 == 0x3 else 4
+        return '{:>10} I {:08x} {:0{w}x}'.format(rec['cycle'], rec['pc'], rec['instr'], w=width)
+    if rec['type'] == 'reg':
+        return '{:>10} R x{:<2} = {:08x}'.format(rec['cycle'], rec['rd'], rec['value'])
+    return '{:>10} B {:<10} {} {:08x} be={:x} data={:08x} stall={} latency={}'.format(
+        rec['cycle'], rec['master'], 'W' if rec['we'] else 'R', rec['addr'], rec['be'], rec['data'],
+        rec['stall'], rec['latency'])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the execution trace of the Verilator testbench')
+    parser.add_argument('trace', help='trace written with +exec_trace=<file>')
+    parser.add_argument('--format', choices=['text', 'csv'], default='text', help='output format')
+    parser.add_argument('--output', '-o', help='output file, stdout if omitted')
+    parser.add_argument('--type', choices=['instr', 'reg', 'bus'], action='append',
+                        help='only print these record types (can be repeated)')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+    out = open(args.output, 'w', newline='') if args.output else sys.stdout
+
+    fields = ['cycle', 'type', 'pc', 'instr', 'rd', 'value', 'master', 'we', 'be', 'addr', 'data', 'stall', 'latency']
+    writer = None
+    if args.format == 'csv':
+        writer = csv.DictWriter(out, fieldnames=fields)
+        writer.writeheader()
+
+    try:
+        for rec in decode(data):
+            if args.type and rec['type'] not in args.type:
+                continue
+            if writer:
+                for key in ('pc', 'instr', 'value', 'addr', 'data'):
+                    if key in rec:
+                        rec[key] = '0x{:08x}'.format(rec[key])
+                writer.writerow(rec)
+            else:
+                out.write(format_text(rec) + '\n')
+    except TraceError as e:
+        sys.exit('tb_exec_trace_decode: {}'.format(e))
+
+
+if __name__ == '__main__':
+    main()
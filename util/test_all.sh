@@ -162,7 +162,7 @@ SKIPPED=''
 # List of applications that will not be simulated (skipped)
 # This list is a temporary solution. Apps should report by themselves
 # whether their simulation should be skipped or not.
-declare -a BLACKLIST=( "example_virtual_flash" )
+declare -a BLACKLIST=( "example_virtual_flash" "coremark" "embench" "example_xif_coproc" )
 
 # List of possible compilers. The last compiler will be used for simulation.
 declare -a COMPILERS=( )
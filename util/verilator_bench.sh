@@ -0,0 +1,53 @@
+#!/usr/bin/bash -e
+
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# Measures the simulation speed (simulated cycles per second) of the Verilator
+# model for several thread counts. Usage:
+#   util/verilator_bench.sh [thread counts]        (default: 1 2 4 8)
+# The MCU must have been generated already (make mcu-gen).
+# BENCH_APPS and BENCH_MAX_SIM_TIME can be overwritten from the environment.
+
+THREADS=${@:-1 2 4 8}
+APPS=${BENCH_APPS:-"hello_world example_matadd example_freertos_blinky"}
+# Clock edges simulated per app, so apps that never exit are bounded too
+MAX_SIM_TIME=${BENCH_MAX_SIM_TIME:-4000000}
+
+SIM_DIR=./build/openhwgroup.org_systems_core-v-mini-mcu_0/sim-verilator
+BENCH_DIR=./build/verilator_bench
+
+mkdir -p $BENCH_DIR
+
+# Build the firmware once, the images do not depend on the model
+for APP in $APPS
+do
+	make --no-print-directory -s app PROJECT=$APP
+	cp sw/build/main.elf $BENCH_DIR/$APP.elf
+done
+
+REPORT="| Threads |"
+SEPARATOR="| ------- |"
+for APP in $APPS
+do
+	REPORT="$REPORT $APP |"
+	SEPARATOR="$SEPARATOR ----- |"
+done
+REPORT="$REPORT\n$SEPARATOR"
+
+for T in $THREADS
+do
+	make --no-print-directory -s verilator-sim-cached VERILATOR_THREADS=$T
+	LINE="| $T |"
+	for APP in $APPS
+	do
+		out=$(cd $SIM_DIR; ./Vtestharness +firmware=../../verilator_bench/$APP.elf +max_sim_time=$MAX_SIM_TIME)
+		rate=$(echo "$out" | grep "cycles/s" | sed 's/.*(\([0-9.e+]*\) cycles\/s).*/\1/')
+		LINE="$LINE $rate |"
+	done
+	REPORT="$REPORT\n$LINE"
+done
+
+echo -e "\nSimulated cycles per second ($(nproc) host cores):\n"
+echo -e "$REPORT" | tee $BENCH_DIR/report.md
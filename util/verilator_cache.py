@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+# Copyright EPFL contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Cache of Verilator models (Vtestharness) keyed by the configuration of the
+# MCU. The key hashes the content of the sources of the model, the generated
+# ones included (the output of make mcu-gen, e.g. core_v_mini_mcu_pkg.sv and
+# tb_util.svh), the FuseSoC and Verilator flags and the version of Verilator:
+# a model already built for the same key is copied to the simulation
+# directory instead of being rebuilt. Otherwise the build command is run and
+# its model stored in the cache, whose oldest entries are dropped beyond
+# --max models.
+#
+# Only the executable is kept, not the objects, so the directory of the
+# simulation is emptied before a model is restored: the next build without
+# the cache starts from scratch instead of linking the objects of another
+# configuration.
+#
+# Usage, from the root of the repository (make verilator-sim-cached):
+#   util/verilator_cache.py [--max 8] [--flags "..."] -- make verilator-sim
+
+import argparse
+import hashlib
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+SIM_DIR = "build/openhwgroup.org_systems_core-v-mini-mcu_0/sim-verilator"
+CACHE_DIR = "build/verilator_cache"
+MODEL = "Vtestharness"
+# The sources of the model: the RTL, the testbench and the cores of FuseSoC
+SOURCES = ("hw", "tb")
+SKIP_DIRS = ("__pycache__", ".git")
+
+
+def source_files():
+    files = [f for f in os.listdir(".") if f.endswith(".core")]
+    for top in SOURCES:
+        for root, dirs, names in os.walk(top):
+            dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+            files += [os.path.join(root, name) for name in names]
+    return sorted(files)
+
+
+def verilator_version():
+    try:
+        return subprocess.run(["verilator", "--version"], capture_output=True, text=True).stdout
+    except OSError:
+        return ""
+
+
+def cache_key(flags):
+    h = hashlib.sha256()
+    h.update(flags.encode())
+    h.update(verilator_version().encode())
+    for path in source_files():
+        h.update(path.encode() + b"\0")
+        with open(path, "rb") as f:
+            h.update(hashlib.sha256(f.read()).digest())
+    return h.hexdigest()[:16]
+
+
+def trim(max_models):
+    entries = [os.path.join(CACHE_DIR, e) for e in os.listdir(CACHE_DIR)]
+    entries = sorted((e for e in entries if os.path.isfile(os.path.join(e, MODEL))),
+                     key=lambda e: os.path.getmtime(os.path.join(e, MODEL)))
+    for entry in entries[:max(len(entries) - max_models, 0)]:
+        print("verilator_cache: dropping " + os.path.basename(entry))
+        shutil.rmtree(entry)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the Verilator model through a cache keyed by the configuration")
+    parser.add_argument("--max", type=int, default=8, help="models kept in the cache (default: 8)")
+    parser.add_argument("--flags", default="", help="flags of FuseSoC and Verilator, part of the key")
+    parser.add_argument("build", nargs=argparse.REMAINDER, help="build command of the model, after --")
+    args = parser.parse_args()
+
+    build = args.build[1:] if args.build[:1] == ["--"] else args.build
+    if not build:
+        sys.exit("verilator_cache: no build command")
+
+    start = time.time()
+    key = cache_key(" ".join(args.flags.split()))
+    entry = os.path.join(CACHE_DIR, key)
+    cached = os.path.join(entry, MODEL)
+
+    if os.path.isfile(cached):
+        shutil.rmtree(SIM_DIR, ignore_errors=True)
+        os.makedirs(SIM_DIR)
+        shutil.copy2(cached, os.path.join(SIM_DIR, MODEL))
+        # The most recently used models are the last dropped
+        os.utime(cached)
+        print("verilator_cache: model {} restored in {:.1f} s".format(key, time.time() - start))
+        return
+
+    print("verilator_cache: model {} not in the cache, building it".format(key), flush=True)
+    if subprocess.run(build).returncode != 0:
+        sys.exit("verilator_cache: build failed")
+    built = os.path.join(SIM_DIR, MODEL)
+    if not os.path.isfile(built):
+        sys.exit("verilator_cache: no {} after the build".format(built))
+
+    os.makedirs(entry, exist_ok=True)
+    shutil.copy2(built, cached + ".tmp")
+    os.replace(cached + ".tmp", cached)
+    trim(args.max)
+    print("verilator_cache: model {} stored".format(key))
+
+
+if __name__ == "__main__":
+    main()